@@ -10,6 +10,7 @@ import android.content.ClipData;
 import android.content.Context;
 import android.content.DialogInterface;
 import android.content.Intent;
+import android.content.IntentFilter;
 import android.content.pm.ActivityInfo;
 import android.content.pm.ApplicationInfo;
 import android.content.pm.PackageManager;
@@ -20,6 +21,7 @@ import android.graphics.PorterDuff;
 import android.graphics.drawable.Drawable;
 import android.hardware.Sensor;
 import android.net.Uri;
+import android.os.BatteryManager;
 import android.os.Build;
 import android.os.Bundle;
 import android.os.Handler;
@@ -1792,6 +1794,31 @@ public class SDLActivity extends Activity implements View.OnSystemUiVisibilityCh
         }
     }
 
+    /**
+     * This method is called by SDL using JNI.
+     * Returns { plugged, status, present, level, scale } from the sticky battery
+     * intent, or null if it isn't available.
+     */
+    public static int[] getPowerInfo() {
+        Intent intent;
+        try {
+            intent = getContext().registerReceiver(null, new IntentFilter(Intent.ACTION_BATTERY_CHANGED));
+        } catch (Exception e) {
+            return null;
+        }
+        if (intent == null) {
+            return null;
+        }
+
+        int[] info = new int[5];
+        info[0] = intent.getIntExtra(BatteryManager.EXTRA_PLUGGED, -1);
+        info[1] = intent.getIntExtra(BatteryManager.EXTRA_STATUS, -1);
+        info[2] = intent.getBooleanExtra(BatteryManager.EXTRA_PRESENT, false) ? 1 : 0;
+        info[3] = intent.getIntExtra(BatteryManager.EXTRA_LEVEL, -1);
+        info[4] = intent.getIntExtra(BatteryManager.EXTRA_SCALE, -1);
+        return info;
+    }
+
     /**
      * This method is called by SDL using JNI.
      */
@@ -0,0 +1,295 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Stress test for the audio mixing pipeline.
+
+   Binds a growing number of audio streams with different formats, rates,
+   channel counts and channel maps to one playback device, and reports how
+   long the device thread takes per buffer at each stream count, using
+   SDL_GetAudioDeviceStats(). It stops once the device can't keep up.
+
+   The dummy audio driver is used unless another one is picked with --audio;
+   "--audio disk" also writes the mix to a file. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct StreamSource
+{
+    Uint8 *data;
+    int len;
+    int pos;
+} StreamSource;
+
+typedef struct LevelResult
+{
+    int streams;
+    Uint64 iterations;
+    Uint64 period_ns;
+    Uint64 iterate_ns;
+    Uint64 mix_ns;
+    Uint64 convert_ns;
+    Uint64 late_iterations;
+} LevelResult;
+
+static const struct
+{
+    SDL_AudioSpec spec;
+    bool swap_channels;
+    float gain;
+    float ratio;
+} stream_cases[] = {
+    { { SDL_AUDIO_S16, 2, 44100 }, false, 1.0f, 1.0f },
+    { { SDL_AUDIO_F32, 2, 48000 }, false, 1.0f, 1.0f },
+    { { SDL_AUDIO_S16, 1, 22050 }, false, 0.5f, 1.0f },
+    { { SDL_AUDIO_F32, 6, 48000 }, false, 1.0f, 1.0f },
+    { { SDL_AUDIO_S32, 2, 96000 }, false, 1.0f, 1.0f },
+    { { SDL_AUDIO_U8, 1, 11025 }, false, 1.0f, 1.0f },
+    { { SDL_AUDIO_F32, 8, 48000 }, false, 1.0f, 1.01f },
+    { { SDL_AUDIO_S16, 2, 48000 }, true, 0.8f, 1.0f },
+};
+
+static StreamSource sources[SDL_arraysize(stream_cases)];
+
+static void SDLCALL FeedStream(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    StreamSource *source = (StreamSource *)userdata;
+
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, source->len - source->pos);
+        SDL_PutAudioStreamData(stream, source->data + source->pos, len);
+        source->pos = (source->pos + len) % source->len;
+        additional_amount -= len;
+    }
+}
+
+// One second of a sine tone per channel, converted to the format the stream takes
+static bool CreateSource(StreamSource *source, const SDL_AudioSpec *spec)
+{
+    const SDL_AudioSpec float_spec = { SDL_AUDIO_F32, spec->channels, spec->freq };
+    float *samples;
+    int frame, channel;
+    bool result;
+
+    samples = (float *)SDL_malloc((size_t)spec->freq * spec->channels * sizeof(float));
+    if (!samples) {
+        return false;
+    }
+    for (frame = 0; frame < spec->freq; ++frame) {
+        for (channel = 0; channel < spec->channels; ++channel) {
+            const float hz = 220.0f * (float)(channel + 1);
+            samples[frame * spec->channels + channel] = 0.25f * SDL_sinf(2.0f * SDL_PI_F * hz * (float)frame / (float)spec->freq);
+        }
+    }
+
+    result = SDL_ConvertAudioSamples(&float_spec, (const Uint8 *)samples, spec->freq * spec->channels * (int)sizeof(float),
+                                     spec, &source->data, &source->len);
+    SDL_free(samples);
+    source->pos = 0;
+    return result;
+}
+
+static SDL_AudioStream *CreateStream(SDL_AudioDeviceID device, int index)
+{
+    const int which = index % SDL_arraysize(stream_cases);
+    const SDL_AudioSpec *spec = &stream_cases[which].spec;
+    SDL_AudioStream *stream;
+
+    stream = SDL_CreateAudioStream(spec, NULL);
+    if (!stream) {
+        return NULL;
+    }
+    if (stream_cases[which].swap_channels) {
+        static const int swapped[] = { 1, 0 };
+        SDL_SetAudioStreamInputChannelMap(stream, swapped, SDL_arraysize(swapped));
+    }
+    SDL_SetAudioStreamGain(stream, stream_cases[which].gain);
+    SDL_SetAudioStreamFrequencyRatio(stream, stream_cases[which].ratio);
+    SDL_SetAudioStreamGetCallback(stream, FeedStream, &sources[which]);
+
+    if (!SDL_BindAudioStream(device, stream)) {
+        SDL_DestroyAudioStream(stream);
+        return NULL;
+    }
+    return stream;
+}
+
+static bool MeasureLevel(SDL_AudioDeviceID device, int streams, double seconds, LevelResult *result)
+{
+    SDL_AudioDeviceStats before, after;
+
+    // Let the device settle after adding streams, then sample a window
+    SDL_Delay(100);
+    if (!SDL_GetAudioDeviceStats(device, &before)) {
+        return false;
+    }
+    SDL_Delay((Uint32)(seconds * 1000.0));
+    if (!SDL_GetAudioDeviceStats(device, &after)) {
+        return false;
+    }
+
+    SDL_zerop(result);
+    result->streams = streams;
+    result->iterations = after.iterations - before.iterations;
+    result->period_ns = after.period_ns;
+    result->late_iterations = after.late_iterations - before.late_iterations;
+    if (result->iterations > 0) {
+        result->iterate_ns = (after.iterate_ns_total - before.iterate_ns_total) / result->iterations;
+        result->mix_ns = (after.mix_ns_total - before.mix_ns_total) / result->iterations;
+        result->convert_ns = (after.convert_ns_total - before.convert_ns_total) / result->iterations;
+    }
+    return true;
+}
+
+static bool WriteJSON(const char *path, const LevelResult *results, int num_results)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path, "w");
+    int i;
+
+    if (!io) {
+        return false;
+    }
+
+    SDL_IOprintf(io, "{\n  \"sdl_version\": \"%d.%d.%d\",\n  \"platform\": \"%s\",\n  \"audio_driver\": \"%s\",\n  \"results\": [\n",
+                 SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+                 SDL_GetPlatform(), SDL_GetCurrentAudioDriver());
+    for (i = 0; i < num_results; ++i) {
+        const LevelResult *result = &results[i];
+        SDL_IOprintf(io, "    { \"streams\": %d, \"iterations\": %" SDL_PRIu64 ", \"period_ns\": %" SDL_PRIu64
+                         ", \"iterate_ns\": %" SDL_PRIu64 ", \"mix_ns\": %" SDL_PRIu64 ", \"convert_ns\": %" SDL_PRIu64
+                         ", \"late_iterations\": %" SDL_PRIu64 " }%s\n",
+                     result->streams, result->iterations, result->period_ns, result->iterate_ns,
+                     result->mix_ns, result->convert_ns, result->late_iterations, (i + 1 < num_results) ? "," : "");
+    }
+    SDL_IOprintf(io, "  ]\n}\n");
+    return SDL_CloseIO(io);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *options[] = { "[--max-streams N]", "[--time SECONDS]", "[--json FILE]", NULL };
+    SDLTest_CommonState *state;
+    SDL_AudioStream **streams = NULL;
+    LevelResult *results = NULL;
+    int num_streams = 0, num_results = 0;
+    int max_streams = 1024;
+    double seconds = 1.0;
+    const char *json_path = NULL;
+    int count, i;
+    int exit_code = 0;
+
+    // Unlike real hardware, the dummy driver never glitches on its own
+    SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+
+    state = SDLTest_CommonCreateState(argv, SDL_INIT_AUDIO);
+    if (!state) {
+        return 1;
+    }
+    state->audio_format = SDL_AUDIO_F32;
+    state->audio_channels = 2;
+    state->audio_freq = 48000;
+
+    for (i = 1; i < argc;) {
+        int consumed = SDLTest_CommonArg(state, i);
+        if (consumed == 0) {
+            if (SDL_strcmp(argv[i], "--max-streams") == 0 && argv[i + 1]) {
+                max_streams = SDL_atoi(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--time") == 0 && argv[i + 1]) {
+                seconds = SDL_atof(argv[i + 1]);
+                consumed = 2;
+            } else if (SDL_strcmp(argv[i], "--json") == 0 && argv[i + 1]) {
+                json_path = argv[i + 1];
+                consumed = 2;
+            }
+        }
+        if (consumed <= 0) {
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            SDLTest_CommonDestroyState(state);
+            return 1;
+        }
+        i += consumed;
+    }
+
+    if (!SDLTest_CommonInit(state)) {
+        SDLTest_CommonQuit(state);
+        return 1;
+    }
+
+    for (i = 0; i < SDL_arraysize(stream_cases); ++i) {
+        if (!CreateSource(&sources[i], &stream_cases[i].spec)) {
+            SDL_Log("Couldn't create audio data: %s", SDL_GetError());
+            exit_code = 1;
+            goto done;
+        }
+    }
+
+    streams = (SDL_AudioStream **)SDL_calloc(max_streams, sizeof(*streams));
+    results = (LevelResult *)SDL_calloc(max_streams, sizeof(*results));
+    if (!streams || !results) {
+        exit_code = 1;
+        goto done;
+    }
+
+    SDL_Log("Audio driver %s, %d Hz %s %d channels", SDL_GetCurrentAudioDriver(),
+            state->audio_freq, SDL_GetAudioFormatName(state->audio_format), state->audio_channels);
+    SDL_Log("%8s %12s %12s %12s %12s %8s %6s", "streams", "iterate ns", "mix ns", "convert ns", "period ns", "load", "late");
+
+    for (count = 1; count <= max_streams; count *= 2) {
+        LevelResult *result = &results[num_results];
+        double load;
+
+        while (num_streams < count) {
+            streams[num_streams] = CreateStream(state->audio_id, num_streams);
+            if (!streams[num_streams]) {
+                SDL_Log("Couldn't create audio stream: %s", SDL_GetError());
+                exit_code = 1;
+                goto done;
+            }
+            ++num_streams;
+        }
+
+        if (!MeasureLevel(state->audio_id, num_streams, seconds, result)) {
+            SDL_Log("Couldn't get audio device stats: %s", SDL_GetError());
+            exit_code = 1;
+            goto done;
+        }
+        ++num_results;
+
+        load = (result->period_ns > 0) ? (100.0 * (double)result->iterate_ns / (double)result->period_ns) : 0.0;
+        SDL_Log("%8d %12" SDL_PRIu64 " %12" SDL_PRIu64 " %12" SDL_PRIu64 " %12" SDL_PRIu64 " %7.1f%% %6" SDL_PRIu64,
+                result->streams, result->iterate_ns, result->mix_ns, result->convert_ns, result->period_ns, load, result->late_iterations);
+
+        if (load >= 100.0) {
+            SDL_Log("The device can't keep up with %d streams", num_streams);
+            break;
+        }
+    }
+
+    if (json_path && !WriteJSON(json_path, results, num_results)) {
+        SDL_Log("Couldn't write %s: %s", json_path, SDL_GetError());
+        exit_code = 1;
+    }
+
+done:
+    for (i = 0; i < num_streams; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_free(streams);
+    SDL_free(results);
+    for (i = 0; i < SDL_arraysize(sources); ++i) {
+        SDL_free(sources[i].data);
+    }
+    SDLTest_CommonQuit(state);
+    return exit_code;
+}
@@ -0,0 +1,459 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Microbenchmarks for the software blitters, pixel and audio converters.
+
+   Usage: benchconvert [--cpu-mask MASK] [--filter SUBSTRING] [--time SECONDS] [--json FILE]
+
+   --cpu-mask sets SDL_HINT_CPU_FEATURE_MASK before SDL picks its code paths,
+   so "--cpu-mask -all" measures the scalar fallbacks. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#define MIN_ITERATIONS 10
+#define MAX_ITERATIONS 100000
+
+typedef struct BenchResult
+{
+    char name[128];
+    const char *unit;
+    double throughput;
+    Uint64 iterations;
+    Uint64 p50_ns;
+    Uint64 p90_ns;
+    Uint64 p99_ns;
+} BenchResult;
+
+typedef bool (SDLCALL *BenchFunc)(void *userdata);
+
+static const char *filter = NULL;
+static double min_seconds = 0.25;
+static BenchResult *results = NULL;
+static int num_results = 0;
+
+static int SDLCALL CompareU64(const void *a, const void *b)
+{
+    const Uint64 x = *(const Uint64 *)a;
+    const Uint64 y = *(const Uint64 *)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/* Runs func until min_seconds have passed and records latency percentiles.
+   units is the number of pixels or samples one call processes. */
+static void RunBenchmark(const char *name, const char *unit, double units, BenchFunc func, void *userdata)
+{
+    Uint64 *times;
+    Uint64 start, total = 0;
+    Uint64 n = 0;
+    BenchResult *result;
+    int i;
+
+    if (filter && !SDL_strstr(name, filter)) {
+        return;
+    }
+
+    times = (Uint64 *)SDL_malloc(MAX_ITERATIONS * sizeof(*times));
+    if (!times) {
+        return;
+    }
+
+    // Warm up caches and lazily built blit maps
+    for (i = 0; i < 3; ++i) {
+        if (!func(userdata)) {
+            SDL_Log("%s: %s", name, SDL_GetError());
+            SDL_free(times);
+            return;
+        }
+    }
+
+    while (n < MAX_ITERATIONS && (n < MIN_ITERATIONS || total < (Uint64)(min_seconds * SDL_NS_PER_SECOND))) {
+        start = SDL_GetTicksNS();
+        func(userdata);
+        times[n] = SDL_GetTicksNS() - start;
+        total += times[n];
+        ++n;
+    }
+    SDL_qsort(times, (size_t)n, sizeof(*times), CompareU64);
+
+    result = (BenchResult *)SDL_realloc(results, (num_results + 1) * sizeof(*results));
+    if (!result) {
+        SDL_free(times);
+        return;
+    }
+    results = result;
+    result = &results[num_results++];
+    SDL_strlcpy(result->name, name, sizeof(result->name));
+    result->unit = unit;
+    result->iterations = n;
+    result->p50_ns = times[n / 2];
+    result->p90_ns = times[(n * 9) / 10];
+    result->p99_ns = times[(n * 99) / 100];
+    result->throughput = (result->p50_ns > 0) ? (units / 1000000.0) / ((double)result->p50_ns / SDL_NS_PER_SECOND) : 0.0;
+    SDL_free(times);
+
+    SDL_Log("%-56s %10.1f %-10s p50 %8" SDL_PRIu64 " ns  p90 %8" SDL_PRIu64 " ns  p99 %8" SDL_PRIu64 " ns",
+            result->name, result->throughput, result->unit, result->p50_ns, result->p90_ns, result->p99_ns);
+}
+
+// Surfaces filled with a deterministic pattern so every run blits the same data
+static SDL_Surface *CreatePatternSurface(int w, int h, SDL_PixelFormat format)
+{
+    SDL_Surface *surface = SDL_CreateSurface(w, h, format);
+    Uint64 seed = 1;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+        SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
+        if (palette) {
+            for (x = 0; x < palette->ncolors; ++x) {
+                palette->colors[x].r = (Uint8)x;
+                palette->colors[x].g = (Uint8)(x * 3);
+                palette->colors[x].b = (Uint8)(x * 7);
+                palette->colors[x].a = 0xFF;
+            }
+        }
+    }
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        for (x = 0; x < surface->pitch; ++x) {
+            row[x] = (Uint8)(SDL_rand_bits_r(&seed) >> 24);
+        }
+    }
+    return surface;
+}
+
+typedef struct SurfaceBench
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_ScaleMode scale_mode;
+    bool stretch;
+} SurfaceBench;
+
+static bool SDLCALL BenchBlit(void *userdata)
+{
+    SurfaceBench *bench = (SurfaceBench *)userdata;
+    if (bench->stretch) {
+        return SDL_StretchSurface(bench->src, NULL, bench->dst, NULL, bench->scale_mode);
+    }
+    return SDL_BlitSurface(bench->src, NULL, bench->dst, NULL);
+}
+
+static const SDL_Point sizes[] = {
+    { 64, 64 },
+    { 512, 512 },
+    { 1920, 1080 }
+};
+
+static void BenchBlits(void)
+{
+    static const struct
+    {
+        SDL_PixelFormat src;
+        SDL_PixelFormat dst;
+        SDL_BlendMode blend;
+    } cases[] = {
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_BLEND },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE },
+        { SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888, SDL_BLENDMODE_BLEND },
+        { SDL_PIXELFORMAT_RGB565, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565, SDL_BLENDMODE_NONE },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE },
+        { SDL_PIXELFORMAT_INDEX8, SDL_PIXELFORMAT_XRGB8888, SDL_BLENDMODE_NONE },
+    };
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        for (j = 0; j < SDL_arraysize(sizes); ++j) {
+            SurfaceBench bench;
+            char name[128];
+
+            SDL_zero(bench);
+            bench.src = CreatePatternSurface(sizes[j].x, sizes[j].y, cases[i].src);
+            bench.dst = CreatePatternSurface(sizes[j].x, sizes[j].y, cases[i].dst);
+            if (bench.src && bench.dst) {
+                SDL_SetSurfaceBlendMode(bench.src, cases[i].blend);
+                SDL_snprintf(name, sizeof(name), "blit/%s->%s/%s/%dx%d",
+                             SDL_GetPixelFormatName(cases[i].src) + 16,
+                             SDL_GetPixelFormatName(cases[i].dst) + 16,
+                             cases[i].blend == SDL_BLENDMODE_NONE ? "none" : "blend",
+                             sizes[j].x, sizes[j].y);
+                RunBenchmark(name, "Mpix/s", (double)sizes[j].x * sizes[j].y, BenchBlit, &bench);
+            }
+            SDL_DestroySurface(bench.src);
+            SDL_DestroySurface(bench.dst);
+        }
+    }
+}
+
+static void BenchStretches(void)
+{
+    static const struct
+    {
+        SDL_Point src;
+        SDL_Point dst;
+    } cases[] = {
+        { { 640, 360 }, { 1920, 1080 } },
+        { { 1920, 1080 }, { 640, 360 } },
+    };
+    int i, mode;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        for (mode = 0; mode < 2; ++mode) {
+            SurfaceBench bench;
+            char name[128];
+
+            SDL_zero(bench);
+            bench.stretch = true;
+            bench.scale_mode = mode ? SDL_SCALEMODE_LINEAR : SDL_SCALEMODE_NEAREST;
+            bench.src = CreatePatternSurface(cases[i].src.x, cases[i].src.y, SDL_PIXELFORMAT_XRGB8888);
+            bench.dst = CreatePatternSurface(cases[i].dst.x, cases[i].dst.y, SDL_PIXELFORMAT_XRGB8888);
+            if (bench.src && bench.dst) {
+                SDL_snprintf(name, sizeof(name), "stretch/XRGB8888/%s/%dx%d->%dx%d",
+                             mode ? "linear" : "nearest",
+                             cases[i].src.x, cases[i].src.y, cases[i].dst.x, cases[i].dst.y);
+                RunBenchmark(name, "Mpix/s", (double)cases[i].dst.x * cases[i].dst.y, BenchBlit, &bench);
+            }
+            SDL_DestroySurface(bench.src);
+            SDL_DestroySurface(bench.dst);
+        }
+    }
+}
+
+typedef struct ConvertBench
+{
+    int w, h;
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    void *src;
+    int src_pitch;
+    void *dst;
+    int dst_pitch;
+} ConvertBench;
+
+static bool SDLCALL BenchConvertPixels(void *userdata)
+{
+    ConvertBench *bench = (ConvertBench *)userdata;
+    return SDL_ConvertPixels(bench->w, bench->h, bench->src_format, bench->src, bench->src_pitch,
+                             bench->dst_format, bench->dst, bench->dst_pitch);
+}
+
+static int CalculatePitch(SDL_PixelFormat format, int w)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(format)) {
+        // Planar formats are addressed through their luma plane pitch
+        return (format == SDL_PIXELFORMAT_YUY2 || format == SDL_PIXELFORMAT_UYVY) ? w * 2 : w;
+    }
+    return w * SDL_BYTESPERPIXEL(format);
+}
+
+static void BenchConversions(void)
+{
+    static const struct
+    {
+        SDL_PixelFormat src;
+        SDL_PixelFormat dst;
+    } cases[] = {
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_RGB565 },
+        { SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA64_FLOAT },
+        { SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_YUY2, SDL_PIXELFORMAT_XRGB8888 },
+        { SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_NV12 },
+    };
+    int i, j;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        for (j = 0; j < SDL_arraysize(sizes); ++j) {
+            ConvertBench bench;
+            Uint64 seed = 1;
+            size_t len, k;
+            char name[128];
+
+            SDL_zero(bench);
+            bench.w = sizes[j].x;
+            bench.h = sizes[j].y;
+            bench.src_format = cases[i].src;
+            bench.dst_format = cases[i].dst;
+            bench.src_pitch = CalculatePitch(cases[i].src, bench.w);
+            bench.dst_pitch = CalculatePitch(cases[i].dst, bench.w);
+
+            // Room for the chroma planes of the planar formats, too
+            len = (size_t)bench.src_pitch * bench.h * 2;
+            bench.src = SDL_malloc(len);
+            bench.dst = SDL_malloc((size_t)bench.dst_pitch * bench.h * 2);
+            if (bench.src && bench.dst) {
+                for (k = 0; k < len; ++k) {
+                    ((Uint8 *)bench.src)[k] = (Uint8)(SDL_rand_bits_r(&seed) >> 24);
+                }
+                SDL_snprintf(name, sizeof(name), "convert/%s->%s/%dx%d",
+                             SDL_GetPixelFormatName(cases[i].src) + 16,
+                             SDL_GetPixelFormatName(cases[i].dst) + 16,
+                             bench.w, bench.h);
+                RunBenchmark(name, "Mpix/s", (double)bench.w * bench.h, BenchConvertPixels, &bench);
+            }
+            SDL_free(bench.src);
+            SDL_free(bench.dst);
+        }
+    }
+}
+
+typedef struct AudioBench
+{
+    SDL_AudioSpec src_spec;
+    SDL_AudioSpec dst_spec;
+    Uint8 *src;
+    int src_len;
+} AudioBench;
+
+static bool SDLCALL BenchConvertAudio(void *userdata)
+{
+    AudioBench *bench = (AudioBench *)userdata;
+    Uint8 *dst = NULL;
+    int dst_len = 0;
+
+    if (!SDL_ConvertAudioSamples(&bench->src_spec, bench->src, bench->src_len, &bench->dst_spec, &dst, &dst_len)) {
+        return false;
+    }
+    SDL_free(dst);
+    return true;
+}
+
+static void BenchAudio(void)
+{
+    static const struct
+    {
+        SDL_AudioSpec src;
+        SDL_AudioSpec dst;
+    } cases[] = {
+        { { SDL_AUDIO_S16, 2, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+        { { SDL_AUDIO_F32, 2, 48000 }, { SDL_AUDIO_S16, 2, 48000 } },
+        { { SDL_AUDIO_S16, 1, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+        { { SDL_AUDIO_F32, 6, 48000 }, { SDL_AUDIO_F32, 2, 48000 } },
+        { { SDL_AUDIO_S16, 2, 44100 }, { SDL_AUDIO_F32, 2, 48000 } },
+        { { SDL_AUDIO_F32, 2, 48000 }, { SDL_AUDIO_F32, 2, 44100 } },
+        { { SDL_AUDIO_F32, 2, 22050 }, { SDL_AUDIO_F32, 2, 48000 } },
+    };
+    int i;
+
+    for (i = 0; i < SDL_arraysize(cases); ++i) {
+        AudioBench bench;
+        Uint64 seed = 1;
+        int frames = cases[i].src.freq / 10; // 100 ms per call
+        int k;
+        char name[128];
+
+        SDL_zero(bench);
+        bench.src_spec = cases[i].src;
+        bench.dst_spec = cases[i].dst;
+        bench.src_len = frames * SDL_AUDIO_FRAMESIZE(bench.src_spec);
+        bench.src = (Uint8 *)SDL_malloc(bench.src_len);
+        if (!bench.src) {
+            continue;
+        }
+
+        // Keep float samples in range so the clamping paths aren't all that's measured
+        if (SDL_AUDIO_ISFLOAT(bench.src_spec.format)) {
+            float *samples = (float *)bench.src;
+            for (k = 0; k < bench.src_len / (int)sizeof(float); ++k) {
+                samples[k] = SDL_randf_r(&seed) * 2.0f - 1.0f;
+            }
+        } else {
+            for (k = 0; k < bench.src_len; ++k) {
+                bench.src[k] = (Uint8)(SDL_rand_bits_r(&seed) >> 24);
+            }
+        }
+
+        SDL_snprintf(name, sizeof(name), "audio/%s:%d:%d->%s:%d:%d",
+                     SDL_GetAudioFormatName(bench.src_spec.format) + 10, bench.src_spec.channels, bench.src_spec.freq,
+                     SDL_GetAudioFormatName(bench.dst_spec.format) + 10, bench.dst_spec.channels, bench.dst_spec.freq);
+        RunBenchmark(name, "Msamples/s", (double)frames * bench.src_spec.channels, BenchConvertAudio, &bench);
+        SDL_free(bench.src);
+    }
+}
+
+static bool WriteJSON(const char *path, const char *cpu_mask)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path, "w");
+    int i;
+
+    if (!io) {
+        return false;
+    }
+
+    SDL_IOprintf(io, "{\n  \"sdl_version\": \"%d.%d.%d\",\n  \"platform\": \"%s\",\n  \"cpu_mask\": \"%s\",\n  \"results\": [\n",
+                 SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+                 SDL_GetPlatform(), cpu_mask ? cpu_mask : "");
+    for (i = 0; i < num_results; ++i) {
+        const BenchResult *result = &results[i];
+        SDL_IOprintf(io, "    { \"name\": \"%s\", \"unit\": \"%s\", \"throughput\": %.3f, \"iterations\": %" SDL_PRIu64
+                         ", \"p50_ns\": %" SDL_PRIu64 ", \"p90_ns\": %" SDL_PRIu64 ", \"p99_ns\": %" SDL_PRIu64 " }%s\n",
+                     result->name, result->unit, result->throughput, result->iterations,
+                     result->p50_ns, result->p90_ns, result->p99_ns, (i + 1 < num_results) ? "," : "");
+    }
+    SDL_IOprintf(io, "  ]\n}\n");
+    return SDL_CloseIO(io);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *cpu_mask = NULL;
+    const char *json_path = NULL;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--cpu-mask") == 0 && i + 1 < argc) {
+            cpu_mask = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            min_seconds = SDL_atof(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            SDL_Log("Usage: %s [--cpu-mask MASK] [--filter SUBSTRING] [--time SECONDS] [--json FILE]", argv[0]);
+            return 1;
+        }
+    }
+
+    // This has to happen before anything queries CPU features, they're only detected once
+    if (cpu_mask) {
+        SDL_SetHint(SDL_HINT_CPU_FEATURE_MASK, cpu_mask);
+    }
+
+    SDL_Log("SDL %d.%d.%d on %s, %d logical CPUs, SIMD: %s%s%s%s%s",
+            SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+            SDL_GetPlatform(), SDL_GetNumLogicalCPUCores(),
+            SDL_HasSSE2() ? "SSE2 " : "", SDL_HasSSE41() ? "SSE4.1 " : "", SDL_HasAVX2() ? "AVX2 " : "",
+            SDL_HasNEON() ? "NEON " : "", SDL_HasLSX() ? "LSX " : "");
+
+    BenchBlits();
+    BenchStretches();
+    BenchConversions();
+    BenchAudio();
+
+    if (json_path && !WriteJSON(json_path, cpu_mask)) {
+        SDL_Log("Couldn't write %s: %s", json_path, SDL_GetError());
+        SDL_free(results);
+        return 1;
+    }
+
+    SDL_free(results);
+    SDL_Quit();
+    return 0;
+}
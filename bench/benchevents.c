@@ -0,0 +1,302 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Throughput and latency of the event queue.
+
+   Usage: benchevents [--producers N] [--events N] [--json FILE]
+
+   Producer threads push user events with SDL_PushEvent() while the main
+   thread drains them with SDL_PollEvent() or SDL_PeepEvents(), with and
+   without an event filter and watcher installed. Queue latency is the time
+   from SDL_PushEvent() stamping an event to the main thread receiving it.
+   The time producers spend inside SDL_PushEvent() shows lock contention:
+   it grows with the number of producers when they serialize on the queue. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#define PEEP_BATCH 256
+#define PUSH_SAMPLE_INTERVAL 16
+
+typedef struct BenchResult
+{
+    char name[128];
+    double events_per_second;
+    Uint64 latency_p50_ns;
+    Uint64 latency_p99_ns;
+    Uint64 push_p50_ns;
+    Uint64 push_p99_ns;
+    Uint64 queue_full;
+} BenchResult;
+
+typedef struct Producer
+{
+    SDL_Thread *thread;
+    int index;
+    int num_events;
+    Uint64 *push_times;
+    int num_push_times;
+    Uint64 queue_full;
+} Producer;
+
+static Uint32 bench_event_type;
+static SDL_AtomicInt start_flag;
+static BenchResult *results = NULL;
+static int num_results = 0;
+
+static int SDLCALL CompareU64(const void *a, const void *b)
+{
+    const Uint64 x = *(const Uint64 *)a;
+    const Uint64 y = *(const Uint64 *)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+static int SDLCALL ProducerThread(void *data)
+{
+    Producer *producer = (Producer *)data;
+    SDL_Event event;
+    int i;
+
+    // Start all producers together so they actually contend
+    while (!SDL_GetAtomicInt(&start_flag)) {
+        SDL_CPUPauseInstruction();
+    }
+
+    SDL_zero(event);
+    event.type = bench_event_type;
+    event.user.code = producer->index;
+
+    for (i = 0; i < producer->num_events; ++i) {
+        const bool sample = (i % PUSH_SAMPLE_INTERVAL) == 0;
+        Uint64 start = 0;
+
+        event.common.timestamp = 0; // let SDL_PushEvent() stamp it
+        if (sample) {
+            start = SDL_GetTicksNS();
+        }
+        while (!SDL_PushEvent(&event)) {
+            // The queue is full, wait for the main thread to catch up
+            ++producer->queue_full;
+            SDL_Delay(0);
+        }
+        if (sample) {
+            producer->push_times[producer->num_push_times++] = SDL_GetTicksNS() - start;
+        }
+    }
+    return 0;
+}
+
+static bool SDLCALL PassFilter(void *userdata, SDL_Event *event)
+{
+    return event->type != SDL_EVENT_LAST;
+}
+
+static bool SDLCALL CountWatch(void *userdata, SDL_Event *event)
+{
+    SDL_AddAtomicInt((SDL_AtomicInt *)userdata, 1);
+    return true;
+}
+
+static void RunBenchmark(int num_producers, int events_per_producer, bool peep, bool watched)
+{
+    Producer *producers;
+    Uint64 *latencies = NULL;
+    Uint64 *push_times = NULL;
+    Uint64 start, elapsed;
+    SDL_AtomicInt watched_count;
+    BenchResult *result;
+    int total = 0, received = 0, num_push_times = 0;
+    int i;
+
+    producers = (Producer *)SDL_calloc(num_producers, sizeof(*producers));
+    latencies = (Uint64 *)SDL_malloc((size_t)num_producers * events_per_producer * sizeof(*latencies));
+    push_times = (Uint64 *)SDL_malloc((size_t)num_producers * ((events_per_producer / PUSH_SAMPLE_INTERVAL) + 1) * sizeof(*push_times));
+    if (!producers || !latencies || !push_times) {
+        goto done;
+    }
+
+    SDL_SetAtomicInt(&watched_count, 0);
+    if (watched) {
+        SDL_SetEventFilter(PassFilter, NULL);
+        SDL_AddEventWatch(CountWatch, &watched_count);
+    }
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetAtomicInt(&start_flag, 0);
+    for (i = 0; i < num_producers; ++i) {
+        producers[i].index = i;
+        producers[i].num_events = events_per_producer;
+        producers[i].push_times = push_times + num_push_times;
+        num_push_times += (events_per_producer / PUSH_SAMPLE_INTERVAL) + 1;
+        producers[i].thread = SDL_CreateThread(ProducerThread, "benchevents producer", &producers[i]);
+        if (producers[i].thread) {
+            total += events_per_producer;
+        } else {
+            SDL_Log("Couldn't create producer thread: %s", SDL_GetError());
+        }
+    }
+
+    start = SDL_GetTicksNS();
+    SDL_SetAtomicInt(&start_flag, 1);
+
+    while (received < total) {
+        SDL_Event events[PEEP_BATCH];
+        int count;
+
+        if (peep) {
+            SDL_PumpEvents();
+            count = SDL_PeepEvents(events, PEEP_BATCH, SDL_GETEVENT, bench_event_type, bench_event_type);
+        } else {
+            count = SDL_PollEvent(&events[0]) ? 1 : 0;
+        }
+
+        if (count > 0) {
+            const Uint64 now = SDL_GetTicksNS();
+            for (i = 0; i < count; ++i) {
+                if (events[i].type == bench_event_type && received < total) {
+                    latencies[received++] = now - events[i].common.timestamp;
+                }
+            }
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    num_push_times = 0;
+    for (i = 0; i < num_producers; ++i) {
+        SDL_WaitThread(producers[i].thread, NULL);
+        // Gather the samples of all producers into one list
+        SDL_memmove(push_times + num_push_times, producers[i].push_times, producers[i].num_push_times * sizeof(*push_times));
+        num_push_times += producers[i].num_push_times;
+    }
+
+    if (watched) {
+        SDL_RemoveEventWatch(CountWatch, &watched_count);
+        SDL_SetEventFilter(NULL, NULL);
+    }
+
+    if (total == 0) {
+        goto done;
+    }
+
+    result = (BenchResult *)SDL_realloc(results, (num_results + 1) * sizeof(*results));
+    if (!result) {
+        goto done;
+    }
+    results = result;
+    result = &results[num_results++];
+    SDL_zerop(result);
+
+    SDL_qsort(latencies, (size_t)total, sizeof(*latencies), CompareU64);
+    SDL_qsort(push_times, (size_t)num_push_times, sizeof(*push_times), CompareU64);
+
+    SDL_snprintf(result->name, sizeof(result->name), "events/%s/%s/producers=%d",
+                 peep ? "peep" : "poll", watched ? "watched" : "plain", num_producers);
+    result->events_per_second = (elapsed > 0) ? ((double)total * SDL_NS_PER_SECOND / (double)elapsed) : 0.0;
+    result->latency_p50_ns = latencies[total / 2];
+    result->latency_p99_ns = latencies[((Uint64)total * 99) / 100];
+    if (num_push_times > 0) {
+        result->push_p50_ns = push_times[num_push_times / 2];
+        result->push_p99_ns = push_times[((Uint64)num_push_times * 99) / 100];
+    }
+    for (i = 0; i < num_producers; ++i) {
+        result->queue_full += producers[i].queue_full;
+    }
+
+    SDL_Log("%-40s %12.0f events/s  latency p50 %9" SDL_PRIu64 " ns p99 %9" SDL_PRIu64 " ns  push p50 %6" SDL_PRIu64 " ns p99 %7" SDL_PRIu64 " ns  full %" SDL_PRIu64,
+            result->name, result->events_per_second, result->latency_p50_ns, result->latency_p99_ns,
+            result->push_p50_ns, result->push_p99_ns, result->queue_full);
+
+done:
+    SDL_free(producers);
+    SDL_free(latencies);
+    SDL_free(push_times);
+}
+
+static bool WriteJSON(const char *path)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path, "w");
+    int i;
+
+    if (!io) {
+        return false;
+    }
+
+    SDL_IOprintf(io, "{\n  \"sdl_version\": \"%d.%d.%d\",\n  \"platform\": \"%s\",\n  \"cpus\": %d,\n  \"results\": [\n",
+                 SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+                 SDL_GetPlatform(), SDL_GetNumLogicalCPUCores());
+    for (i = 0; i < num_results; ++i) {
+        const BenchResult *result = &results[i];
+        SDL_IOprintf(io, "    { \"name\": \"%s\", \"events_per_second\": %.1f, \"latency_p50_ns\": %" SDL_PRIu64 ", \"latency_p99_ns\": %" SDL_PRIu64
+                         ", \"push_p50_ns\": %" SDL_PRIu64 ", \"push_p99_ns\": %" SDL_PRIu64 ", \"queue_full\": %" SDL_PRIu64 " }%s\n",
+                     result->name, result->events_per_second, result->latency_p50_ns, result->latency_p99_ns,
+                     result->push_p50_ns, result->push_p99_ns, result->queue_full, (i + 1 < num_results) ? "," : "");
+    }
+    SDL_IOprintf(io, "  ]\n}\n");
+    return SDL_CloseIO(io);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *json_path = NULL;
+    int max_producers = 8;
+    int events_per_producer = 100000;
+    int producers, peep, watched;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--producers") == 0 && i + 1 < argc) {
+            max_producers = SDL_max(1, SDL_atoi(argv[++i]));
+        } else if (SDL_strcmp(argv[i], "--events") == 0 && i + 1 < argc) {
+            events_per_producer = SDL_max(1, SDL_atoi(argv[++i]));
+        } else if (SDL_strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            SDL_Log("Usage: %s [--producers N] [--events N] [--json FILE]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!SDL_Init(SDL_INIT_EVENTS)) {
+        SDL_Log("Couldn't initialize events: %s", SDL_GetError());
+        return 1;
+    }
+
+    bench_event_type = SDL_RegisterEvents(1);
+    if (!bench_event_type) {
+        SDL_Log("Couldn't register an event type: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_Log("SDL %d.%d.%d on %s, %d logical CPUs",
+            SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+            SDL_GetPlatform(), SDL_GetNumLogicalCPUCores());
+
+    for (peep = 0; peep < 2; ++peep) {
+        for (watched = 0; watched < 2; ++watched) {
+            for (producers = 1; producers <= max_producers; producers *= 2) {
+                RunBenchmark(producers, events_per_producer, peep != 0, watched != 0);
+            }
+        }
+    }
+
+    if (json_path && !WriteJSON(json_path)) {
+        SDL_Log("Couldn't write %s: %s", json_path, SDL_GetError());
+        SDL_free(results);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_free(results);
+    SDL_Quit();
+    return 0;
+}
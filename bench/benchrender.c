@@ -0,0 +1,410 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Throughput benchmarks for every 2D render driver built into SDL.
+
+   Usage: benchrender [--driver NAME] [--filter SUBSTRING] [--time SECONDS] [--json FILE]
+
+   Each iteration is a whole frame: clear, draw the workload and present, with
+   vsync off. The "sync" case reads back a pixel before presenting, which waits
+   for the GPU and so measures the full submit-to-completion latency. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 720
+#define NUM_SPRITES 10000
+#define NUM_RECTS 10000
+#define NUM_TRIANGLES 20000
+#define SPRITE_SIZE 32
+#define STREAMING_SIZE 1024
+#define MIN_ITERATIONS 10
+#define MAX_ITERATIONS 100000
+
+typedef struct BenchResult
+{
+    char name[128];
+    const char *unit;
+    double throughput;
+    Uint64 iterations;
+    Uint64 p50_ns;
+    Uint64 p90_ns;
+    Uint64 p99_ns;
+} BenchResult;
+
+typedef bool (SDLCALL *BenchFunc)(void *userdata);
+
+typedef struct RenderBench
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *sprite;
+    SDL_Texture *streaming;
+    SDL_FRect *rects;
+    SDL_Vertex *vertices;
+    Uint32 *pixels;
+    Uint8 frame;
+} RenderBench;
+
+static const char *filter = NULL;
+static double min_seconds = 1.0;
+static BenchResult *results = NULL;
+static int num_results = 0;
+static bool quit = false;
+
+static int SDLCALL CompareU64(const void *a, const void *b)
+{
+    const Uint64 x = *(const Uint64 *)a;
+    const Uint64 y = *(const Uint64 *)b;
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/* Runs func until min_seconds have passed and records latency percentiles.
+   units is the number of sprites, rects, triangles or megabytes one frame processes. */
+static void RunBenchmark(const char *name, const char *unit, double units, BenchFunc func, void *userdata)
+{
+    Uint64 *times;
+    Uint64 start, total = 0;
+    Uint64 n = 0;
+    BenchResult *result;
+    int i;
+
+    if (quit || (filter && !SDL_strstr(name, filter))) {
+        return;
+    }
+
+    times = (Uint64 *)SDL_malloc(MAX_ITERATIONS * sizeof(*times));
+    if (!times) {
+        return;
+    }
+
+    // Warm up the pipeline cache and let the swapchain settle
+    for (i = 0; i < 10; ++i) {
+        if (!func(userdata)) {
+            SDL_Log("%s: %s", name, SDL_GetError());
+            SDL_free(times);
+            return;
+        }
+    }
+
+    while (!quit && n < MAX_ITERATIONS && (n < MIN_ITERATIONS || total < (Uint64)(min_seconds * SDL_NS_PER_SECOND))) {
+        SDL_Event event;
+
+        // Keep the window responsive without counting event handling
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_QUIT) {
+                quit = true;
+            }
+        }
+
+        start = SDL_GetTicksNS();
+        func(userdata);
+        times[n] = SDL_GetTicksNS() - start;
+        total += times[n];
+        ++n;
+    }
+    if (n == 0) {
+        SDL_free(times);
+        return;
+    }
+    SDL_qsort(times, (size_t)n, sizeof(*times), CompareU64);
+
+    result = (BenchResult *)SDL_realloc(results, (num_results + 1) * sizeof(*results));
+    if (!result) {
+        SDL_free(times);
+        return;
+    }
+    results = result;
+    result = &results[num_results++];
+    SDL_strlcpy(result->name, name, sizeof(result->name));
+    result->unit = unit;
+    result->iterations = n;
+    result->p50_ns = times[n / 2];
+    result->p90_ns = times[(n * 9) / 10];
+    result->p99_ns = times[(n * 99) / 100];
+    result->throughput = (result->p50_ns > 0) ? units / ((double)result->p50_ns / SDL_NS_PER_SECOND) : 0.0;
+    SDL_free(times);
+
+    SDL_Log("%-40s %12.1f %-12s p50 %9" SDL_PRIu64 " ns  p90 %9" SDL_PRIu64 " ns  p99 %9" SDL_PRIu64 " ns",
+            result->name, result->throughput, result->unit, result->p50_ns, result->p90_ns, result->p99_ns);
+}
+
+static bool BeginFrame(RenderBench *bench)
+{
+    // Vary the clear color so no driver can skip the frame as redundant
+    ++bench->frame;
+    SDL_SetRenderDrawColor(bench->renderer, bench->frame, 0x40, 0x80, 0xFF);
+    return SDL_RenderClear(bench->renderer);
+}
+
+static bool SDLCALL BenchPresent(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+    return BeginFrame(bench) && SDL_RenderPresent(bench->renderer);
+}
+
+static bool SDLCALL BenchPresentSync(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+    SDL_Rect rect = { 0, 0, 1, 1 };
+    SDL_Surface *surface;
+
+    if (!BeginFrame(bench)) {
+        return false;
+    }
+    surface = SDL_RenderReadPixels(bench->renderer, &rect);
+    if (!surface) {
+        return false;
+    }
+    SDL_DestroySurface(surface);
+    return SDL_RenderPresent(bench->renderer);
+}
+
+static bool SDLCALL BenchSprites(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+    int i;
+
+    if (!BeginFrame(bench)) {
+        return false;
+    }
+    // One call per sprite, so this is mostly a measure of command batching
+    for (i = 0; i < NUM_SPRITES; ++i) {
+        SDL_RenderTexture(bench->renderer, bench->sprite, NULL, &bench->rects[i]);
+    }
+    return SDL_RenderPresent(bench->renderer);
+}
+
+static bool SDLCALL BenchRects(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+    int i;
+
+    if (!BeginFrame(bench)) {
+        return false;
+    }
+    for (i = 0; i < NUM_RECTS; ++i) {
+        SDL_SetRenderDrawColor(bench->renderer, (Uint8)i, (Uint8)(i >> 3), 0x80, 0xFF);
+        SDL_RenderFillRect(bench->renderer, &bench->rects[i]);
+    }
+    return SDL_RenderPresent(bench->renderer);
+}
+
+static bool SDLCALL BenchGeometry(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+
+    return BeginFrame(bench) &&
+           SDL_RenderGeometry(bench->renderer, bench->sprite, bench->vertices, NUM_TRIANGLES * 3, NULL, 0) &&
+           SDL_RenderPresent(bench->renderer);
+}
+
+static bool SDLCALL BenchTextureUpdate(void *userdata)
+{
+    RenderBench *bench = (RenderBench *)userdata;
+
+    return BeginFrame(bench) &&
+           SDL_UpdateTexture(bench->streaming, NULL, bench->pixels, STREAMING_SIZE * sizeof(Uint32)) &&
+           SDL_RenderTexture(bench->renderer, bench->streaming, NULL, NULL) &&
+           SDL_RenderPresent(bench->renderer);
+}
+
+static bool CreateResources(RenderBench *bench)
+{
+    SDL_Surface *surface;
+    Uint64 seed = 1;
+    int i, x, y;
+
+    surface = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface) {
+        return false;
+    }
+    for (y = 0; y < SPRITE_SIZE; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < SPRITE_SIZE; ++x) {
+            row[x] = ((x ^ y) & 8) ? 0xFFFFFFFF : 0x80FF8000;
+        }
+    }
+    bench->sprite = SDL_CreateTextureFromSurface(bench->renderer, surface);
+    SDL_DestroySurface(surface);
+    if (!bench->sprite) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(bench->sprite, SDL_BLENDMODE_BLEND);
+
+    bench->streaming = SDL_CreateTexture(bench->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, STREAMING_SIZE, STREAMING_SIZE);
+    if (!bench->streaming) {
+        return false;
+    }
+
+    bench->rects = (SDL_FRect *)SDL_malloc(SDL_max(NUM_SPRITES, NUM_RECTS) * sizeof(*bench->rects));
+    bench->vertices = (SDL_Vertex *)SDL_malloc(NUM_TRIANGLES * 3 * sizeof(*bench->vertices));
+    bench->pixels = (Uint32 *)SDL_malloc(STREAMING_SIZE * STREAMING_SIZE * sizeof(*bench->pixels));
+    if (!bench->rects || !bench->vertices || !bench->pixels) {
+        return false;
+    }
+
+    // Positions are generated up front so only the renderer is being timed
+    for (i = 0; i < SDL_max(NUM_SPRITES, NUM_RECTS); ++i) {
+        bench->rects[i].x = (float)SDL_rand_r(&seed, WINDOW_WIDTH - SPRITE_SIZE);
+        bench->rects[i].y = (float)SDL_rand_r(&seed, WINDOW_HEIGHT - SPRITE_SIZE);
+        bench->rects[i].w = SPRITE_SIZE;
+        bench->rects[i].h = SPRITE_SIZE;
+    }
+    for (i = 0; i < NUM_TRIANGLES * 3; ++i) {
+        SDL_Vertex *vertex = &bench->vertices[i];
+        vertex->position.x = (float)SDL_rand_r(&seed, WINDOW_WIDTH);
+        vertex->position.y = (float)SDL_rand_r(&seed, WINDOW_HEIGHT);
+        vertex->color.r = SDL_randf_r(&seed);
+        vertex->color.g = SDL_randf_r(&seed);
+        vertex->color.b = SDL_randf_r(&seed);
+        vertex->color.a = 1.0f;
+        vertex->tex_coord.x = (float)(i % 3 == 1);
+        vertex->tex_coord.y = (float)(i % 3 == 2);
+    }
+    for (i = 0; i < STREAMING_SIZE * STREAMING_SIZE; ++i) {
+        bench->pixels[i] = SDL_rand_bits_r(&seed) | 0xFF000000;
+    }
+    return true;
+}
+
+static void DestroyResources(RenderBench *bench)
+{
+    SDL_DestroyTexture(bench->sprite);
+    SDL_DestroyTexture(bench->streaming);
+    SDL_free(bench->rects);
+    SDL_free(bench->vertices);
+    SDL_free(bench->pixels);
+}
+
+static void BenchDriver(const char *driver)
+{
+    RenderBench bench;
+    SDL_Window *window;
+    SDL_PropertiesID props;
+    char name[128];
+
+    SDL_zero(bench);
+
+    // A fresh window per driver, since some drivers recreate it with their own flags
+    window = SDL_CreateWindow(driver, WINDOW_WIDTH, WINDOW_HEIGHT, 0);
+    if (!window) {
+        SDL_Log("%s: couldn't create window: %s", driver, SDL_GetError());
+        return;
+    }
+
+    props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_RENDERER_CREATE_NAME_STRING, driver);
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, window);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_CREATE_PRESENT_VSYNC_NUMBER, 0);
+    bench.renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    if (!bench.renderer) {
+        SDL_Log("%s: not available: %s", driver, SDL_GetError());
+        SDL_DestroyWindow(window);
+        return;
+    }
+
+    if (CreateResources(&bench)) {
+        SDL_snprintf(name, sizeof(name), "render/%s/present", driver);
+        RunBenchmark(name, "frames/s", 1.0, BenchPresent, &bench);
+        SDL_snprintf(name, sizeof(name), "render/%s/present_sync", driver);
+        RunBenchmark(name, "frames/s", 1.0, BenchPresentSync, &bench);
+        SDL_snprintf(name, sizeof(name), "render/%s/sprites", driver);
+        RunBenchmark(name, "sprites/s", NUM_SPRITES, BenchSprites, &bench);
+        SDL_snprintf(name, sizeof(name), "render/%s/rects", driver);
+        RunBenchmark(name, "rects/s", NUM_RECTS, BenchRects, &bench);
+        SDL_snprintf(name, sizeof(name), "render/%s/geometry", driver);
+        RunBenchmark(name, "triangles/s", NUM_TRIANGLES, BenchGeometry, &bench);
+        SDL_snprintf(name, sizeof(name), "render/%s/texture_update", driver);
+        RunBenchmark(name, "MB/s", (STREAMING_SIZE * STREAMING_SIZE * sizeof(Uint32)) / (1024.0 * 1024.0), BenchTextureUpdate, &bench);
+    } else {
+        SDL_Log("%s: couldn't create resources: %s", driver, SDL_GetError());
+    }
+
+    DestroyResources(&bench);
+    SDL_DestroyRenderer(bench.renderer);
+    SDL_DestroyWindow(window);
+}
+
+static bool WriteJSON(const char *path)
+{
+    SDL_IOStream *io = SDL_IOFromFile(path, "w");
+    int i;
+
+    if (!io) {
+        return false;
+    }
+
+    SDL_IOprintf(io, "{\n  \"sdl_version\": \"%d.%d.%d\",\n  \"platform\": \"%s\",\n  \"video_driver\": \"%s\",\n  \"results\": [\n",
+                 SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+                 SDL_GetPlatform(), SDL_GetCurrentVideoDriver());
+    for (i = 0; i < num_results; ++i) {
+        const BenchResult *result = &results[i];
+        SDL_IOprintf(io, "    { \"name\": \"%s\", \"unit\": \"%s\", \"throughput\": %.3f, \"iterations\": %" SDL_PRIu64
+                         ", \"p50_ns\": %" SDL_PRIu64 ", \"p90_ns\": %" SDL_PRIu64 ", \"p99_ns\": %" SDL_PRIu64 " }%s\n",
+                     result->name, result->unit, result->throughput, result->iterations,
+                     result->p50_ns, result->p90_ns, result->p99_ns, (i + 1 < num_results) ? "," : "");
+    }
+    SDL_IOprintf(io, "  ]\n}\n");
+    return SDL_CloseIO(io);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *driver = NULL;
+    const char *json_path = NULL;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--driver") == 0 && i + 1 < argc) {
+            driver = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (SDL_strcmp(argv[i], "--time") == 0 && i + 1 < argc) {
+            min_seconds = SDL_atof(argv[++i]);
+        } else if (SDL_strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else {
+            SDL_Log("Usage: %s [--driver NAME] [--filter SUBSTRING] [--time SECONDS] [--json FILE]", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_Log("Couldn't initialize video: %s", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Log("SDL %d.%d.%d on %s, video driver %s",
+            SDL_VERSIONNUM_MAJOR(SDL_GetVersion()), SDL_VERSIONNUM_MINOR(SDL_GetVersion()), SDL_VERSIONNUM_MICRO(SDL_GetVersion()),
+            SDL_GetPlatform(), SDL_GetCurrentVideoDriver());
+
+    if (driver) {
+        BenchDriver(driver);
+    } else {
+        for (i = 0; i < SDL_GetNumRenderDrivers() && !quit; ++i) {
+            BenchDriver(SDL_GetRenderDriver(i));
+        }
+    }
+
+    if (json_path && !WriteJSON(json_path)) {
+        SDL_Log("Couldn't write %s: %s", json_path, SDL_GetError());
+        SDL_free(results);
+        SDL_Quit();
+        return 1;
+    }
+
+    SDL_free(results);
+    SDL_Quit();
+    return 0;
+}
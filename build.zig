@@ -46,6 +46,26 @@ pub fn build(b: *std.Build) !void {
         "install_build_config_h",
         "Additionally install 'SDL_build_config.h' when installing SDL (default: false)",
     ) orelse false;
+    const profiler = b.option(
+        bool,
+        "profiler",
+        "Compile in trace zones for SDL_StartTraceCapture() and SDL_SetTraceCallback() (default: false)",
+    ) orelse false;
+    const gpu_backend = b.option(
+        GpuBackend,
+        "gpu_backend",
+        "Build only this SDL_GPU backend and call its per-draw functions directly (default: all available)",
+    );
+    const gpu_validation = b.option(
+        bool,
+        "gpu_validation",
+        "Compile in the SDL_GPU debug mode checks (default: true)",
+    ) orelse true;
+    const dynapi = b.option(
+        bool,
+        "dynapi",
+        "Route public calls through the dynamic API jump table, which lets SDL_DYNAMIC_API replace the library at run time (default: true)",
+    ) orelse true;
 
     var windows = false;
     var linux = false;
@@ -110,6 +130,19 @@ pub fn build(b: *std.Build) !void {
         else => {},
     }
 
+    if (gpu_backend) |backend| {
+        const available = switch (backend) {
+            .vulkan => windows or linux or macos or android or ios,
+            .d3d12 => windows,
+            .metal => macos or ios,
+        };
+        if (!available) {
+            std.log.err("the '{s}' GPU backend is not available for this target", .{@tagName(backend)});
+            std.process.exit(1);
+        }
+    }
+    const gpu_all = gpu_backend == null;
+
     const build_config_h: *std.Build.Step.ConfigHeader = build_config_h: {
         const cpu = target.result.cpu;
         const x86 = cpu.arch.isX86();
@@ -157,6 +190,7 @@ pub fn build(b: *std.Build) !void {
             .HAVE_MEMCPY = windows or linux or macos or emscripten or android or ios,
             .HAVE_MEMMOVE = windows or linux or macos or emscripten or android or ios,
             .HAVE_MEMCMP = windows or linux or macos or emscripten or android or ios,
+            .HAVE_MEMCHR = windows or linux or macos or emscripten or android or ios,
             .HAVE_WCSLEN = windows or linux or macos or emscripten or android or ios,
             .HAVE_WCSNLEN = windows or linux or macos or emscripten or android or ios,
             .HAVE_WCSLCPY = macos or ios,
@@ -471,10 +505,10 @@ pub fn build(b: *std.Build) !void {
             .SDL_VIDEO_OPENGL_EGL = windows or linux or macos or emscripten or android,
             .SDL_VIDEO_VULKAN = windows or linux or macos or android or ios,
             .SDL_VIDEO_METAL = macos or ios,
-            .SDL_GPU_D3D11 = windows,
-            .SDL_GPU_D3D12 = windows,
-            .SDL_GPU_VULKAN = windows or linux or macos or android or ios,
-            .SDL_GPU_METAL = macos or ios,
+            .SDL_GPU_D3D11 = windows and gpu_all,
+            .SDL_GPU_D3D12 = windows and (gpu_all or gpu_backend.? == .d3d12),
+            .SDL_GPU_VULKAN = (windows or linux or macos or android or ios) and (gpu_all or gpu_backend.? == .vulkan),
+            .SDL_GPU_METAL = (macos or ios) and (gpu_all or gpu_backend.? == .metal),
             .SDL_POWER_ANDROID = android,
             .SDL_POWER_LINUX = linux,
             .SDL_POWER_WINDOWS = windows,
@@ -584,6 +618,14 @@ pub fn build(b: *std.Build) !void {
     sdl_mod.addCMacro("SDL_BUILD_MAJOR_VERSION", std.fmt.comptimePrint("{d}", .{version.major}));
     sdl_mod.addCMacro("SDL_BUILD_MINOR_VERSION", std.fmt.comptimePrint("{d}", .{version.minor}));
     sdl_mod.addCMacro("SDL_BUILD_MICRO_VERSION", std.fmt.comptimePrint("{d}", .{version.patch}));
+    if (profiler) sdl_mod.addCMacro("SDL_PROFILER", "1");
+    if (gpu_backend) |backend| sdl_mod.addCMacro("SDL_GPU_STATIC_BACKEND", switch (backend) {
+        .vulkan => "VULKAN",
+        .d3d12 => "D3D12",
+        .metal => "METAL",
+    });
+    if (!gpu_validation) sdl_mod.addCMacro("SDL_GPU_NO_VALIDATION", "1");
+    if (!dynapi) sdl_mod.addCMacro("SDL_DISABLE_DYNAMIC_API", "1");
     switch (sdl_lib.linkage.?) {
         .static => {
             sdl_mod.addCMacro("SDL_STATIC_LIB", "1");
@@ -664,7 +706,9 @@ pub fn build(b: *std.Build) !void {
             "src/SDL_hints.c",
             "src/SDL_list.c",
             "src/SDL_log.c",
+            "src/SDL_memoryusage.c",
             "src/SDL_properties.c",
+            "src/SDL_trace.c",
             "src/SDL_utils.c",
             "src/atomic/SDL_atomic.c",
             "src/atomic/SDL_spinlock.c",
@@ -703,6 +747,7 @@ pub fn build(b: *std.Build) !void {
             "src/hidapi/SDL_hidapi.c",
             "src/io/SDL_asyncio.c",
             "src/io/SDL_iostream.c",
+            "src/io/SDL_iostream_lz4.c",
             "src/io/generic/SDL_asyncio_generic.c",
             "src/joystick/SDL_gamepad.c",
             "src/joystick/SDL_joystick.c",
@@ -751,6 +796,7 @@ pub fn build(b: *std.Build) !void {
             "src/stdlib/SDL_getenv.c",
             "src/stdlib/SDL_iconv.c",
             "src/stdlib/SDL_malloc.c",
+            "src/stdlib/SDL_mathbatch.c",
             "src/stdlib/SDL_memcpy.c",
             "src/stdlib/SDL_memmove.c",
             "src/stdlib/SDL_memset.c",
@@ -762,6 +808,8 @@ pub fn build(b: *std.Build) !void {
             "src/stdlib/SDL_string.c",
             "src/stdlib/SDL_strtokr.c",
             "src/storage/SDL_storage.c",
+            "src/storage/archive/SDL_archivestorage.c",
+            "src/thread/SDL_jobs.c",
             "src/thread/SDL_thread.c",
             "src/time/SDL_time.c",
             "src/timer/SDL_timer.c",
@@ -783,11 +831,14 @@ pub fn build(b: *std.Build) !void {
             "src/video/SDL_stb.c",
             "src/video/SDL_stretch.c",
             "src/video/SDL_surface.c",
+            "src/video/SDL_surfacepool.c",
             "src/video/SDL_video.c",
             "src/video/SDL_video_unsupported.c",
             "src/video/SDL_vulkan_utils.c",
             "src/video/SDL_yuv.c",
+            "src/video/yuv2rgb/yuv_rgb_avx2.c",
             "src/video/yuv2rgb/yuv_rgb_lsx.c",
+            "src/video/yuv2rgb/yuv_rgb_neon.c",
             "src/video/yuv2rgb/yuv_rgb_sse.c",
             "src/video/yuv2rgb/yuv_rgb_std.c",
             "src/dialog/SDL_dialog.c",
@@ -1029,6 +1080,7 @@ pub fn build(b: *std.Build) !void {
                 "src/video/wayland/SDL_waylandcolor.c",
                 "src/video/wayland/SDL_waylanddatamanager.c",
                 "src/video/wayland/SDL_waylanddyn.c",
+                "src/video/wayland/SDL_waylandframebuffer.c",
                 "src/video/wayland/SDL_waylandevents.c",
                 "src/video/wayland/SDL_waylandkeyboard.c",
                 "src/video/wayland/SDL_waylandmessagebox.c",
@@ -1594,8 +1646,56 @@ pub fn build(b: *std.Build) !void {
     install_sdl_test.dependOn(&install_sdl_test_lib.step);
 
     b.getInstallStep().dependOn(&install_sdl_test_lib.step);
+
+    const bench = b.step("bench", "Build and run the blitter, pixel and audio conversion benchmarks");
+    const bench_render = b.step("bench_render", "Build and run the renderer benchmarks for every render driver");
+    const bench_audio = b.step("bench_audio", "Build and run the audio mixing stress test");
+    const bench_events = b.step("bench_events", "Build and run the event queue throughput and latency benchmark");
+
+    for ([_]struct { []const u8, *std.Build.Step, bool }{
+        .{ "benchconvert", bench, false },
+        .{ "benchrender", bench_render, false },
+        .{ "benchaudio", bench_audio, true },
+        .{ "benchevents", bench_events, false },
+    }) |entry| {
+        const name, const step, const uses_sdl_test = entry;
+
+        const bench_mod = b.createModule(.{
+            .target = target,
+            .optimize = optimize,
+            .link_libc = true,
+            .strip = strip,
+            .sanitize_c = sanitize_c,
+            .pic = pic,
+        });
+        const bench_exe = b.addExecutable(.{
+            .name = name,
+            .root_module = bench_mod,
+            .use_llvm = if (emscripten) true else null,
+        });
+        bench_exe.lto = lto;
+
+        bench_mod.addIncludePath(b.path("include"));
+        bench_mod.addCSourceFiles(.{
+            .flags = &common_c_flags,
+            .files = &.{
+                b.fmt("bench/{s}.c", .{name}),
+            },
+        });
+        if (uses_sdl_test) bench_mod.linkLibrary(sdl_test_lib);
+        bench_mod.linkLibrary(sdl_lib);
+
+        // Arguments after '--' are passed on, e.g. 'zig build bench -Doptimize=ReleaseFast -- --json out.json'
+        const run_bench = b.addRunArtifact(bench_exe);
+        if (b.args) |args| {
+            run_bench.addArgs(args);
+        }
+        step.dependOn(&run_bench.step);
+    }
 }
 
+const GpuBackend = enum { vulkan, d3d12, metal };
+
 const LinuxDepsValues = struct {
     dependency: *std.Build.Dependency,
     wayland_client_soname: []const u8,
@@ -104,6 +104,7 @@
 #define SDL_asyncio_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -132,7 +133,8 @@ typedef enum SDL_AsyncIOTaskType
 {
     SDL_ASYNCIO_TASK_READ,   /**< A read operation. */
     SDL_ASYNCIO_TASK_WRITE,  /**< A write operation. */
-    SDL_ASYNCIO_TASK_CLOSE   /**< A close operation. */
+    SDL_ASYNCIO_TASK_CLOSE,  /**< A close operation. */
+    SDL_ASYNCIO_TASK_BATCH   /**< A group of operations started by SDL_SubmitAsyncIOBatch(). (since SDL 3.4.0) */
 } SDL_AsyncIOTaskType;
 
 /**
@@ -164,6 +166,61 @@ typedef struct SDL_AsyncIOOutcome
     void *userdata;    /**< pointer provided by the app when starting the task */
 } SDL_AsyncIOOutcome;
 
+/**
+ * One piece of memory in a vectored asynchronous I/O request.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadAsyncIOSegments
+ * \sa SDL_WriteAsyncIOSegments
+ */
+typedef struct SDL_AsyncIOSegment
+{
+    void *buffer;   /**< where this piece of the data is read to or written from. */
+    Uint64 size;    /**< the number of bytes in this piece. */
+} SDL_AsyncIOSegment;
+
+/**
+ * One operation in a batch started by SDL_SubmitAsyncIOBatch().
+ *
+ * The app fills in everything up to `size`. SDL fills in `result` and
+ * `bytes_transferred` before reporting the batch as complete.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitAsyncIOBatch
+ */
+typedef struct SDL_AsyncIORequest
+{
+    SDL_AsyncIO *asyncio;       /**< the file to read from or write to. */
+    SDL_AsyncIOTaskType type;   /**< SDL_ASYNCIO_TASK_READ or SDL_ASYNCIO_TASK_WRITE. */
+    void *buffer;               /**< buffer to read data into or write data from. */
+    Uint64 offset;              /**< offset in the SDL_AsyncIO to read/write at. */
+    Uint64 size;                /**< number of bytes to read/write. */
+    SDL_AsyncIOResult result;   /**< the result of this operation, filled in by SDL. */
+    Uint64 bytes_transferred;   /**< actual number of bytes that were read/written, filled in by SDL. */
+} SDL_AsyncIORequest;
+
+/**
+ * Hints about how an app is going to access a file.
+ *
+ * These let the operating system tune its read-ahead and caching for a file.
+ * They are only advice; the system is free to ignore them, and some
+ * platforms can't act on some or all of them.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_AdviseAsyncIO
+ */
+typedef enum SDL_AsyncIOAdvice
+{
+    SDL_ASYNCIO_ADVICE_NORMAL,      /**< No particular access pattern; this is the default. */
+    SDL_ASYNCIO_ADVICE_SEQUENTIAL,  /**< Data will be read from start to end, so read further ahead. */
+    SDL_ASYNCIO_ADVICE_RANDOM,      /**< Data will be accessed in no particular order, so don't read ahead. */
+    SDL_ASYNCIO_ADVICE_WILLNEED,    /**< The range will be needed soon, so start loading it into the cache now. */
+    SDL_ASYNCIO_ADVICE_DONTNEED     /**< The range won't be needed again soon, so drop it from the cache. */
+} SDL_AsyncIOAdvice;
+
 /**
  * A queue of completed asynchronous I/O tasks.
  *
@@ -221,6 +278,95 @@ typedef struct SDL_AsyncIOQueue SDL_AsyncIOQueue;
  */
 extern SDL_DECLSPEC SDL_AsyncIO * SDLCALL SDL_AsyncIOFromFile(const char *file, const char *mode);
 
+/**
+ * Create a new SDL_AsyncIO object for a named file, with the specified
+ * properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_ASYNCIO_CREATE_FILENAME_STRING`: a UTF-8 string representing
+ *   the filename to open. This property is required.
+ * - `SDL_PROP_ASYNCIO_CREATE_MODE_STRING`: the mode to open the file in, as
+ *   in SDL_AsyncIOFromFile(). Defaults to "r".
+ * - `SDL_PROP_ASYNCIO_CREATE_UNBUFFERED_BOOLEAN`: true if reads and writes
+ *   should bypass the operating system's file cache (O_DIRECT on Linux,
+ *   F_NOCACHE on Apple platforms, FILE_FLAG_NO_BUFFERING on Windows). This
+ *   keeps streaming very large files from pushing everything else out of the
+ *   cache, but usually adds requirements on the alignment of buffers,
+ *   offsets and sizes; see SDL_GetAsyncIOAlignment(). If the platform or
+ *   filesystem can't do this, the file is opened with normal caching.
+ *   Defaults to false.
+ * - `SDL_PROP_ASYNCIO_CREATE_ADVICE_NUMBER`: an SDL_AsyncIOAdvice value that
+ *   applies to the whole file, as if SDL_AdviseAsyncIO() were called on it
+ *   right after opening. Defaults to `SDL_ASYNCIO_ADVICE_NORMAL`.
+ *
+ * This call is _not_ asynchronous, just like SDL_AsyncIOFromFile().
+ *
+ * \param props the properties to use.
+ * \returns a pointer to the SDL_AsyncIO structure that is created or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AsyncIOFromFile
+ * \sa SDL_GetAsyncIOAlignment
+ * \sa SDL_AdviseAsyncIO
+ * \sa SDL_CloseAsyncIO
+ */
+extern SDL_DECLSPEC SDL_AsyncIO * SDLCALL SDL_AsyncIOFromFileWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_ASYNCIO_CREATE_FILENAME_STRING      "SDL.asyncio.create.filename"
+#define SDL_PROP_ASYNCIO_CREATE_MODE_STRING          "SDL.asyncio.create.mode"
+#define SDL_PROP_ASYNCIO_CREATE_UNBUFFERED_BOOLEAN   "SDL.asyncio.create.unbuffered"
+#define SDL_PROP_ASYNCIO_CREATE_ADVICE_NUMBER        "SDL.asyncio.create.advice"
+
+/**
+ * Get the alignment that reads and writes on an SDL_AsyncIO must follow.
+ *
+ * Files opened with `SDL_PROP_ASYNCIO_CREATE_UNBUFFERED_BOOLEAN` usually
+ * move data straight between the device and the app's memory, which means
+ * every buffer address, file offset and size has to be a multiple of this
+ * value. Reads and writes that aren't will fail right away. Buffers can be
+ * allocated with SDL_aligned_alloc() using this alignment.
+ *
+ * For normal files this returns 1, meaning there are no requirements.
+ *
+ * \param asyncio the SDL_AsyncIO to query.
+ * \returns the required alignment in bytes, or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AsyncIOFromFileWithProperties
+ * \sa SDL_aligned_alloc
+ */
+extern SDL_DECLSPEC size_t SDLCALL SDL_GetAsyncIOAlignment(SDL_AsyncIO *asyncio);
+
+/**
+ * Tell the operating system how a range of a file is going to be used.
+ *
+ * This is only a hint, and it happens right away rather than as a task. On
+ * platforms that can't act on a particular hint, this does nothing and
+ * still returns true.
+ *
+ * \param asyncio the SDL_AsyncIO the hint applies to.
+ * \param offset the start of the range in the file.
+ * \param size the number of bytes in the range, or 0 for everything up to
+ *             the end of the file.
+ * \param advice how the range is going to be accessed.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AsyncIOFromFileWithProperties
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AdviseAsyncIO(SDL_AsyncIO *asyncio, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice);
+
 /**
  * Use this function to get the size of the data stream in an SDL_AsyncIO.
  *
@@ -313,6 +459,115 @@ extern SDL_DECLSPEC bool SDLCALL SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata);
 
+/**
+ * Start an async read into several pieces of memory.
+ *
+ * This reads one contiguous range of the data source, starting at `offset`,
+ * and scatters it across `segments` in order, filling each one completely
+ * before moving on to the next. Where the platform supports it (like
+ * `preadv` through io_uring on Linux), this is a single request to the OS.
+ *
+ * The task's outcome reports the first segment's buffer, and the total size
+ * of all the segments as `bytes_requested`. Reading past the end of the data
+ * is not an error; `bytes_transferred` will be smaller, and the remaining
+ * segments are left untouched.
+ *
+ * The memory in each segment must remain available until the work is done,
+ * just like the buffer given to SDL_ReadAsyncIO(). The `segments` array
+ * itself is copied and may be discarded once this returns.
+ *
+ * \param asyncio a pointer to an SDL_AsyncIO structure.
+ * \param segments an array of the pieces of memory to read into.
+ * \param num_segments the number of entries in `segments`.
+ * \param offset the position to start reading in the data source.
+ * \param queue a queue to add the new SDL_AsyncIO to.
+ * \param userdata an app-defined pointer that will be provided with the task
+ *                 results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WriteAsyncIOSegments
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadAsyncIOSegments(SDL_AsyncIO *asyncio, const SDL_AsyncIOSegment *segments, int num_segments, Uint64 offset, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Start an async write from several pieces of memory.
+ *
+ * This gathers `segments`, in order, into one contiguous range of the data
+ * source starting at `offset`. Where the platform supports it (like
+ * `pwritev` through io_uring on Linux), this is a single request to the OS.
+ *
+ * The task's outcome reports the first segment's buffer, and the total size
+ * of all the segments as `bytes_requested`.
+ *
+ * The memory in each segment must remain available until the work is done,
+ * just like the buffer given to SDL_WriteAsyncIO(). The `segments` array
+ * itself is copied and may be discarded once this returns.
+ *
+ * \param asyncio a pointer to an SDL_AsyncIO structure.
+ * \param segments an array of the pieces of memory to write from.
+ * \param num_segments the number of entries in `segments`.
+ * \param offset the position to start writing to the data source.
+ * \param queue a queue to add the new SDL_AsyncIO to.
+ * \param userdata an app-defined pointer that will be provided with the task
+ *                 results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_WriteAsyncIO
+ * \sa SDL_ReadAsyncIOSegments
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WriteAsyncIOSegments(SDL_AsyncIO *asyncio, const SDL_AsyncIOSegment *segments, int num_segments, Uint64 offset, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Start a group of async reads and writes that complete together.
+ *
+ * Every request is checked and set up before any of them begin, so bad
+ * parameters, a closing SDL_AsyncIO or running out of memory make this
+ * return false without starting anything. If the OS refuses a request after
+ * others in the batch have already started, this still returns true and that
+ * request is reported as failed in the batch's results. Requests are handed
+ * to the OS together where the platform allows it, so a batch costs far fewer
+ * round trips than starting each one separately. The requests may use
+ * different SDL_AsyncIO objects.
+ *
+ * Instead of one outcome per request, `queue` gets a single outcome with a
+ * type of `SDL_ASYNCIO_TASK_BATCH` once every request in the batch has
+ * finished. Its `buffer` is `requests`, `bytes_requested` and
+ * `bytes_transferred` are the totals over all the requests, and `result` is
+ * `SDL_ASYNCIO_FAILURE` if any request failed, otherwise
+ * `SDL_ASYNCIO_CANCELED` if any was canceled. Each request's own `result`
+ * and `bytes_transferred` fields are filled in by then.
+ *
+ * `requests`, and the buffer of every request, must remain available until
+ * the batch is done. Do not allocate them on the stack!
+ *
+ * \param requests an array of operations to start.
+ * \param num_requests the number of entries in `requests`.
+ * \param queue a queue to add the batch's outcome to.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 batch's results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReadAsyncIO
+ * \sa SDL_WriteAsyncIO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubmitAsyncIOBatch(SDL_AsyncIORequest *requests, int num_requests, SDL_AsyncIOQueue *queue, void *userdata);
+
 /**
  * Close and free any allocated resources for an async I/O object.
  *
@@ -534,9 +789,126 @@ extern SDL_DECLSPEC void SDLCALL SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
  * \since This function is available since SDL 3.2.0.
  *
  * \sa SDL_LoadFile_IO
+ * \sa SDL_LoadFileAsyncWithProperties
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata);
 
+/**
+ * A callback that reports how far along a load from
+ * SDL_LoadFileAsyncWithProperties() is.
+ *
+ * This is called as each chunk of the file finishes, from whichever thread
+ * gets results from the SDL_AsyncIOQueue (SDL_GetAsyncIOResult() or
+ * SDL_WaitAsyncIOResult()), so it can safely touch the same state as the code
+ * that handles the final outcome.
+ *
+ * \param userdata what was passed as
+ *                 `SDL_PROP_ASYNCIO_LOAD_PROGRESS_USERDATA_POINTER`.
+ * \param bytes_done the number of bytes read so far.
+ * \param bytes_total the number of bytes being loaded.
+ * \returns true to keep loading, false to cancel the load.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadFileAsyncWithProperties
+ */
+typedef bool (SDLCALL *SDL_AsyncIOProgressCallback)(void *userdata, Uint64 bytes_done, Uint64 bytes_total);
+
+/**
+ * A callback that provides the memory for a load from
+ * SDL_LoadFileAsyncWithProperties().
+ *
+ * This lets an app hand out memory from its own pool instead of having SDL
+ * allocate it. It is called once, before any reading starts, on the thread
+ * that called SDL_LoadFileAsyncWithProperties().
+ *
+ * \param userdata what was passed as
+ *                 `SDL_PROP_ASYNCIO_LOAD_ALLOCATE_USERDATA_POINTER`.
+ * \param size the number of bytes needed.
+ * \returns a pointer to at least `size` bytes, or NULL to fail the load.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadFileAsyncWithProperties
+ */
+typedef void *(SDLCALL *SDL_AsyncIOAllocateCallback)(void *userdata, Uint64 size);
+
+/**
+ * Load all the data from a file path asynchronously, with the specified
+ * properties.
+ *
+ * Where SDL_LoadFileAsync() reads the whole file with one request, this
+ * splits it into chunks and keeps several of them in flight at once, which
+ * keeps the device busy on very large files and lets the app track or cancel
+ * the load while it runs. When everything is done, a single
+ * SDL_ASYNCIO_TASK_READ outcome for the whole file is added to the queue, as
+ * with SDL_LoadFileAsync(), with a NULL `asyncio` field.
+ *
+ * The next chunks are started as earlier ones are collected from the queue,
+ * so the app has to keep calling SDL_GetAsyncIOResult() or
+ * SDL_WaitAsyncIOResult() for the load to progress; the chunks themselves are
+ * never reported on their own.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_ASYNCIO_LOAD_FILENAME_STRING`: a UTF-8 string representing the
+ *   file to load. This property is required.
+ * - `SDL_PROP_ASYNCIO_LOAD_BUFFER_POINTER`: memory to load the file into.
+ *   If this is set, `SDL_PROP_ASYNCIO_LOAD_BUFFER_SIZE_NUMBER` must be too,
+ *   and the load fails right away if the file doesn't fit.
+ * - `SDL_PROP_ASYNCIO_LOAD_BUFFER_SIZE_NUMBER`: the size of
+ *   `SDL_PROP_ASYNCIO_LOAD_BUFFER_POINTER`, in bytes.
+ * - `SDL_PROP_ASYNCIO_LOAD_ALLOCATE_CALLBACK_POINTER`: an
+ *   SDL_AsyncIOAllocateCallback to get the memory from, if no buffer was
+ *   given.
+ * - `SDL_PROP_ASYNCIO_LOAD_ALLOCATE_USERDATA_POINTER`: the userdata for that
+ *   callback.
+ * - `SDL_PROP_ASYNCIO_LOAD_SIZE_HINT_NUMBER`: the expected size of the file,
+ *   used if the file's size can't be queried. The load then stops at the end
+ *   of the file or at this size, whichever is first.
+ * - `SDL_PROP_ASYNCIO_LOAD_CHUNK_SIZE_NUMBER`: the size of each read, in
+ *   bytes. Defaults to 4 megabytes.
+ * - `SDL_PROP_ASYNCIO_LOAD_MAX_INFLIGHT_NUMBER`: how many reads may be in
+ *   flight at once. Defaults to 4.
+ * - `SDL_PROP_ASYNCIO_LOAD_PROGRESS_CALLBACK_POINTER`: an
+ *   SDL_AsyncIOProgressCallback to call as chunks finish. Returning false
+ *   from it cancels the load: no more chunks are started, and the outcome is
+ *   reported as SDL_ASYNCIO_CANCELED once the ones in flight are done.
+ * - `SDL_PROP_ASYNCIO_LOAD_PROGRESS_USERDATA_POINTER`: the userdata for that
+ *   callback.
+ *
+ * If neither a buffer nor an allocation callback is given, SDL allocates the
+ * buffer with a zero byte at the end, just like SDL_LoadFileAsync(), and it
+ * must be deallocated with SDL_free(). Otherwise the app's memory is
+ * returned in SDL_AsyncIOOutcome's buffer field whether the load succeeded
+ * or not, so it can go back to wherever it came from; SDL never frees it.
+ *
+ * \param props the properties to use.
+ * \param queue a queue to add the final outcome to.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 results.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_LoadFileAsync
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_LoadFileAsyncWithProperties(SDL_PropertiesID props, SDL_AsyncIOQueue *queue, void *userdata);
+
+#define SDL_PROP_ASYNCIO_LOAD_FILENAME_STRING            "SDL.asyncio.load.filename"
+#define SDL_PROP_ASYNCIO_LOAD_BUFFER_POINTER             "SDL.asyncio.load.buffer"
+#define SDL_PROP_ASYNCIO_LOAD_BUFFER_SIZE_NUMBER         "SDL.asyncio.load.buffer_size"
+#define SDL_PROP_ASYNCIO_LOAD_ALLOCATE_CALLBACK_POINTER  "SDL.asyncio.load.allocate_callback"
+#define SDL_PROP_ASYNCIO_LOAD_ALLOCATE_USERDATA_POINTER  "SDL.asyncio.load.allocate_userdata"
+#define SDL_PROP_ASYNCIO_LOAD_SIZE_HINT_NUMBER           "SDL.asyncio.load.size_hint"
+#define SDL_PROP_ASYNCIO_LOAD_CHUNK_SIZE_NUMBER          "SDL.asyncio.load.chunk_size"
+#define SDL_PROP_ASYNCIO_LOAD_MAX_INFLIGHT_NUMBER        "SDL.asyncio.load.max_inflight"
+#define SDL_PROP_ASYNCIO_LOAD_PROGRESS_CALLBACK_POINTER  "SDL.asyncio.load.progress_callback"
+#define SDL_PROP_ASYNCIO_LOAD_PROGRESS_USERDATA_POINTER  "SDL.asyncio.load.progress_userdata"
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -654,6 +654,102 @@ extern SDL_DECLSPEC void * SDLCALL SDL_SetAtomicPointer(void **a, void *v);
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_GetAtomicPointer(void **a);
 
+/**
+ * A bounded queue that threads can push to and pop from without locking.
+ *
+ * The queue holds a fixed number of fixed-size items, which are copied in
+ * and out. Pushing fails when the queue is full and popping fails when it's
+ * empty; neither ever blocks.
+ *
+ * By default any number of threads may push and pop at the same time. If
+ * only one thread will ever push, or only one will ever pop, say so with
+ * SDL_ATOMIC_QUEUE_SINGLE_PRODUCER or SDL_ATOMIC_QUEUE_SINGLE_CONSUMER when
+ * creating the queue; with both, the queue becomes a simple ring buffer that
+ * needs no atomic read-modify-write operations at all.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAtomicQueue
+ */
+typedef struct SDL_AtomicQueue SDL_AtomicQueue;
+
+/**
+ * Flags for SDL_CreateAtomicQueue().
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ */
+typedef Uint32 SDL_AtomicQueueFlags;
+
+#define SDL_ATOMIC_QUEUE_SINGLE_PRODUCER    0x00000001u /**< Only one thread at a time will push to the queue */
+#define SDL_ATOMIC_QUEUE_SINGLE_CONSUMER    0x00000002u /**< Only one thread at a time will pop from the queue */
+
+/**
+ * Create a bounded lock-free queue.
+ *
+ * \param capacity the number of items the queue can hold, rounded up to a
+ *                 power of two.
+ * \param item_size the size of each item, in bytes.
+ * \param flags a combination of SDL_AtomicQueueFlags, or 0.
+ * \returns a new queue or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyAtomicQueue
+ * \sa SDL_PopAtomicQueue
+ * \sa SDL_PushAtomicQueue
+ */
+extern SDL_DECLSPEC SDL_AtomicQueue * SDLCALL SDL_CreateAtomicQueue(int capacity, size_t item_size, SDL_AtomicQueueFlags flags);
+
+/**
+ * Copy an item onto the end of a lock-free queue.
+ *
+ * \param queue the queue to push to.
+ * \param item a pointer to the item to copy, `item_size` bytes long.
+ * \returns true if the item was queued, false if the queue was full.
+ *
+ * \threadsafety It is safe to call this function from any thread, unless the
+ *               queue was created with SDL_ATOMIC_QUEUE_SINGLE_PRODUCER.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PopAtomicQueue
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_PushAtomicQueue(SDL_AtomicQueue *queue, const void *item);
+
+/**
+ * Copy the item at the front of a lock-free queue out and remove it.
+ *
+ * \param queue the queue to pop from.
+ * \param item a pointer filled in with the item, `item_size` bytes long.
+ * \returns true if an item was removed, false if the queue was empty.
+ *
+ * \threadsafety It is safe to call this function from any thread, unless the
+ *               queue was created with SDL_ATOMIC_QUEUE_SINGLE_CONSUMER.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PushAtomicQueue
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_PopAtomicQueue(SDL_AtomicQueue *queue, void *item);
+
+/**
+ * Destroy a lock-free queue.
+ *
+ * Any items still in the queue are discarded.
+ *
+ * \param queue the queue to destroy, may be NULL.
+ *
+ * \threadsafety No other thread may be using the queue when it's destroyed.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAtomicQueue
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyAtomicQueue(SDL_AtomicQueue *queue);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -648,6 +648,68 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devi
  */
 extern SDL_DECLSPEC int * SDLCALL SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count);
 
+/**
+ * The number of buckets in SDL_AudioDeviceStats::iterate_histogram.
+ *
+ * \since This macro is available since SDL 3.4.0.
+ */
+#define SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS 8
+
+/**
+ * Timing statistics for an opened audio device.
+ *
+ * All times are in nanoseconds. An "iteration" is one pass of SDL's audio
+ * device thread: for playback, getting data from the bound streams, mixing
+ * and converting it, and handing one buffer to the device; for recording,
+ * reading one buffer and putting it into the bound streams.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioDeviceStats
+ */
+typedef struct SDL_AudioDeviceStats
+{
+    Uint64 iterations;          /**< The number of buffers the device thread has processed. */
+    Uint64 period_ns;           /**< The duration of one device buffer at the current format. */
+    Uint64 iterate_ns_last;     /**< The time the last iteration took. */
+    Uint64 iterate_ns_max;      /**< The longest time an iteration took. */
+    Uint64 iterate_ns_total;    /**< The total time of all iterations; divide by `iterations` for the average. */
+    Uint64 mix_ns_total;        /**< The total time spent getting data from bound streams and mixing it. Playback only. */
+    Uint64 convert_ns_total;    /**< The total time spent converting the final mix to the device format. Playback only. */
+    Uint64 late_iterations;     /**< The number of iterations that took longer than `period_ns`. */
+    Uint64 xruns;               /**< The number of underruns (playback) or overruns (recording) reported by the audio driver. */
+    Uint64 queued_frames;       /**< The number of sample frames waiting in the bound streams after the last iteration. */
+    Uint64 jitter_ns_max;       /**< The largest difference between the time from one iteration to the next and `period_ns`. */
+    Uint64 jitter_ns_total;     /**< The total of those differences; divide by `iterations` - 1 for the average. */
+    Uint64 iterate_histogram[SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS]; /**< Iterations by time taken, in eighths of `period_ns`. The last bucket also counts everything slower. */
+} SDL_AudioDeviceStats;
+
+/**
+ * Get timing statistics for an opened audio device.
+ *
+ * This reports how long SDL's audio thread takes to produce each buffer
+ * compared to the device's buffer duration, and how often the audio driver
+ * ran out of data. Iterations that come close to `period_ns` or exceed it
+ * are likely to be heard as glitches. The statistics start over whenever
+ * the physical device is opened.
+ *
+ * Underruns are currently reported by the ALSA, PulseAudio and WASAPI
+ * drivers; `xruns` stays at zero for the others.
+ *
+ * \param devid the instance ID of a physical or logical device. Logical
+ *              devices report the statistics of their physical device.
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAudioDeviceFormat
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats);
+
 /**
  * Open a specific audio device.
  *
@@ -1066,6 +1128,15 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
 /**
  * Get the properties associated with an audio stream.
  *
+ * The following read-write properties are recognized by SDL:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_LINEAR_RESAMPLING_BOOLEAN`: true to resample with
+ *   simple linear interpolation instead of the default bandlimited filter.
+ *   This costs much less CPU time but aliases audibly, so it's best kept for
+ *   things like voice chat. It may be changed at any time, and takes effect
+ *   the next time the stream converts data. Defaults to false. (since SDL
+ *   3.4.0)
+ *
  * \param stream the SDL_AudioStream to query.
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -1076,6 +1147,8 @@ extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateAudioStream(const SDL_Au
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetAudioStreamProperties(SDL_AudioStream *stream);
 
+#define SDL_PROP_AUDIOSTREAM_LINEAR_RESAMPLING_BOOLEAN "SDL.audiostream.linear_resampling"
+
 /**
  * Query the current format of an audio stream.
  *
@@ -1387,6 +1460,52 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamInputChannelMap(SDL_AudioStre
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamOutputChannelMap(SDL_AudioStream *stream, const int *chmap, int count);
 
+/**
+ * Set the matrix an audio stream uses to mix its input channels into its
+ * output channels.
+ *
+ * When the input and output of a stream have a different number of channels,
+ * SDL up- or downmixes them with gains that suit the [standard
+ * layouts](CategoryAudio#channel-layouts). A mix matrix replaces those gains
+ * with your own, which is useful for custom speaker layouts or downmix
+ * preferences, and it applies even if the channel counts are the same, so it
+ * can also be used to blend channels together.
+ *
+ * The matrix has `dst_channels` rows of `src_channels` gains each, so output
+ * channel `i` is the sum of each input channel `j` multiplied by
+ * `matrix[i * src_channels + j]`. The channels are in SDL's standard order:
+ * after the input channel map is applied, and before the output channel map
+ * is applied.
+ *
+ * SDL will copy the matrix; the caller does not have to save this array
+ * after this call. Passing a NULL matrix is legal, and returns to the default
+ * mixing.
+ *
+ * If `src_channels` and `dst_channels` are not equal to the current number
+ * of channels in the input and output formats of the stream, this will fail.
+ * The matrix is reset to the default whenever either of those channel counts
+ * changes, including when a stream bound to a device has its output format
+ * changed by the device.
+ *
+ * \param stream the SDL_AudioStream to change.
+ * \param matrix the gains to mix with, NULL to reset to default.
+ * \param src_channels the number of input channels in the matrix.
+ * \param dst_channels the number of output channels in the matrix.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as it holds
+ *               a stream-specific mutex while running. Don't change the
+ *               stream's format to have a different number of channels from a
+ *               a different thread at the same time, though!
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetAudioStreamInputChannelMap
+ * \sa SDL_SetAudioStreamOutputChannelMap
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamMixMatrix(SDL_AudioStream *stream, const float *matrix, int src_channels, int dst_channels);
+
 /**
  * Add data to the stream.
  *
@@ -1417,6 +1536,130 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamOutputChannelMap(SDL_AudioStr
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len);
 
+/**
+ * A callback that fires for completed SDL_PutAudioStreamDataNoCopy() data.
+ *
+ * When using SDL_PutAudioStreamDataNoCopy() to provide data to an
+ * SDL_AudioStream, it's not safe to dispose of the data until the stream has
+ * completely consumed it. Often times it's difficult to know exactly when
+ * this has happened.
+ *
+ * This callback fires once when the stream no longer needs the buffer,
+ * allowing the app to easily free or reuse it. This happens once the stream
+ * has read past the end of the buffer, or when the stream is cleared or
+ * destroyed, whichever comes first.
+ *
+ * \param userdata an opaque pointer provided by the app for their personal
+ *                 use.
+ * \param buf the pointer provided to SDL_PutAudioStreamDataNoCopy().
+ * \param buflen the size of buffer, in bytes, provided to
+ *               SDL_PutAudioStreamDataNoCopy().
+ *
+ * \threadsafety This callback may run from any thread. The stream's lock is
+ *               held while it runs, so it must not try to use the stream
+ *               from another thread and wait on the result.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_PutAudioStreamDataNoCopy
+ */
+typedef void (SDLCALL *SDL_AudioStreamDataCompleteCallback)(void *userdata, const void *buf, int buflen);
+
+/**
+ * Add external data to an audio stream without copying it.
+ *
+ * Unlike SDL_PutAudioStreamData(), this function does not make a copy of the
+ * provided data, instead storing the provided pointer. This means that the
+ * put operation does not need to allocate and copy the data, but the
+ * original data must remain available until the stream is done with it,
+ * either by being read from the stream in its entirety, or a call to
+ * SDL_ClearAudioStream() or SDL_DestroyAudioStream().
+ *
+ * The data must match the format/channels/samplerate specified in the latest
+ * call to SDL_SetAudioStreamFormat, or the format specified when creating the
+ * stream if it hasn't been changed.
+ *
+ * An optional callback may be provided, which is called when the stream no
+ * longer needs the data. Once this callback fires, the stream will not
+ * access the data again. This callback will fire for any reason the data is
+ * no longer needed, including clearing or destroying the stream.
+ *
+ * When the stream is bound to a playback device and its input format already
+ * matches the device's format, the data is copied straight from this buffer
+ * into the device's buffer, without any intermediate conversion.
+ *
+ * Note that there is still an allocation to store tracking information, so
+ * this function is more efficient for larger blocks of data. If you're
+ * planning to put a few samples at a time, it will be more efficient to use
+ * SDL_PutAudioStreamData(), which allocates and buffers in blocks.
+ *
+ * \param stream the stream the audio data is being added to.
+ * \param buf a pointer to the audio data to add.
+ * \param len the number of bytes to add to the stream.
+ * \param callback the callback function to call when the data is no longer
+ *                 needed by the stream. May be NULL.
+ * \param userdata an opaque pointer provided to the callback for its own
+ *                 personal use.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information. If this function fails, the callback is not called.
+ *
+ * \threadsafety It is safe to call this function from any thread, but if the
+ *               stream has a callback set, the caller might need to manage
+ *               extra locking.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ClearAudioStream
+ * \sa SDL_FlushAudioStream
+ * \sa SDL_GetAudioStreamData
+ * \sa SDL_GetAudioStreamQueued
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata);
+
+/**
+ * Give an audio stream a lock-free buffer for a single producer.
+ *
+ * Normally, SDL_PutAudioStreamData() and SDL_GetAudioStreamData() both hold
+ * the stream's lock while they work, so a thread adding data and an audio
+ * device pulling it out can block each other. With a lock-free buffer,
+ * SDL_PutAudioStreamData() copies the data into a ring buffer without
+ * taking the lock. The data moves on to the stream's regular queue the next
+ * time something that holds the lock needs it, such as
+ * SDL_GetAudioStreamData() on the audio device thread.
+ *
+ * This is meant for real-time producers with a fixed input format, like a
+ * synthesizer feeding a low-latency device. Only one thread may put data
+ * into the stream while the buffer is in use. The input format can still be
+ * changed by that thread with SDL_SetAudioStreamFormat(); data already put
+ * keeps the format it was put in.
+ *
+ * SDL_PutAudioStreamData() falls back to the normal, locked path if the
+ * buffer doesn't have room for the data or if the stream has a put callback,
+ * so data is never dropped. SDL_PutAudioStreamDataNoCopy() always uses the
+ * locked path. Make the buffer larger than the amount of data that will be
+ * queued at once to stay on the lock-free path.
+ *
+ * The stream must have a source format before calling this function. The
+ * ring buffer holds at least `num_frames` sample frames in the current
+ * source format. Any data in a previous buffer is moved to the stream's
+ * queue first. Set `num_frames` to zero to remove the buffer.
+ *
+ * \param stream the audio stream to change.
+ * \param num_frames the minimum number of sample frames the buffer holds, or
+ *                   zero to go back to the locked path for every call.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, but not
+ *               while another thread is putting data into the stream.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ * \sa SDL_GetAudioStreamData
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioStreamLockFreeBuffer(SDL_AudioStream *stream, int num_frames);
+
 /**
  * Get converted/resampled data from the stream.
  *
@@ -1981,6 +2224,67 @@ typedef void (SDLCALL *SDL_AudioPostmixCallback)(void *userdata, const SDL_Audio
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallback callback, void *userdata);
 
+/**
+ * A callback that receives each buffer captured by a recording device.
+ *
+ * This is useful for consumers that want the raw capture (a level meter,
+ * voice activity detection, or a network encoder) without paying for a copy
+ * into an SDL_AudioStream's queue.
+ *
+ * `buffer` is a read-only view of the device's own buffer, in the device's
+ * native format as described by `spec`, which may not match what the app
+ * requested when opening the device. It is only valid for the duration of
+ * the callback; copy anything you need to keep.
+ *
+ * This callback should run as quickly as possible and not block for any
+ * significant time, as it delays delivery of data to bound audio streams and
+ * the next read from the device.
+ *
+ * \param userdata a pointer provided by the app through
+ *                 SDL_SetAudioRecordingCallback, for its own use.
+ * \param spec the current format of `buffer`.
+ * \param buffer the captured audio samples. This must not be modified.
+ * \param buflen the size of `buffer` in bytes.
+ *
+ * \threadsafety This will run from a background thread owned by SDL. The
+ *               application is responsible for locking resources the callback
+ *               touches that need to be protected.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetAudioRecordingCallback
+ */
+typedef void (SDLCALL *SDL_AudioRecordingCallback)(void *userdata, const SDL_AudioSpec *spec, const void *buffer, int buflen);
+
+/**
+ * Set a callback that fires with each buffer captured by a recording device.
+ *
+ * The callback is handed the whole buffer read from the hardware in one call,
+ * before any gain, postmix callback or format conversion is applied and before
+ * the data is queued to the logical device's bound audio streams. Nothing is
+ * copied to produce it. The callback will not fire while the logical device
+ * is paused.
+ *
+ * This function will block until the audio device is in between iterations,
+ * so any existing callback that might be running will finish before this
+ * function sets the new callback and returns.
+ *
+ * Setting a NULL callback function disables any previously-set callback.
+ *
+ * \param devid the ID of an opened recording device.
+ * \param callback a callback function to be called. Can be NULL.
+ * \param userdata app-controlled pointer passed to callback. Can be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AudioRecordingCallback
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetAudioRecordingCallback(SDL_AudioDeviceID devid, SDL_AudioRecordingCallback callback, void *userdata);
+
 
 /**
  * Load the audio data of a WAVE file into memory.
@@ -2098,6 +2402,104 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV_IO(SDL_IOStream *src, bool closeio,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len);
 
+/**
+ * Create an audio stream that decodes a WAVE file as data is pulled from it.
+ *
+ * Unlike SDL_LoadWAV_IO(), this does not read and decode the whole data chunk
+ * up front. The headers are parsed right away, then the audio stream decodes
+ * one block of audio at a time from `src` whenever more data is requested
+ * from it, for example by an audio device the stream is bound to. Only a
+ * single block is kept in memory by the decoder, so playback can start
+ * immediately and memory use doesn't depend on the length of the file.
+ *
+ * The same encodings as SDL_LoadWAV_IO() are supported, and the output
+ * format of each is the same as well. The stream is flushed when the end of
+ * the data is reached. The SDL_HINT_WAVE_RIFF_CHUNK_SIZE,
+ * SDL_HINT_WAVE_TRUNCATION, SDL_HINT_WAVE_FACT_CHUNK and
+ * SDL_HINT_WAVE_CHUNK_LIMIT hints are respected; with a strict truncation
+ * hint, a truncated file ends the stream early instead of failing up front.
+ *
+ * The returned stream's source and destination formats are both set to the
+ * WAVE data's format (also returned in `spec`); change the output format
+ * with SDL_SetAudioStreamFormat() as needed. The stream uses its get
+ * callback to decode data, so don't call SDL_SetAudioStreamGetCallback() on
+ * it. Use SDL_SeekWAVAudioStream() to change the playback position.
+ *
+ * The stream's properties also contain:
+ *
+ * - `SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER`: the number of sample frames in
+ *   the WAVE data.
+ *
+ * `src` must stay valid until the stream is destroyed, and it must support
+ * seeking for SDL_SeekWAVAudioStream() to work.
+ *
+ * \param src the data source for the WAVE data.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when the stream is
+ *                destroyed, or before returning if this function fails.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's format details on successful return. May be NULL.
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateWAVAudioStream
+ * \sa SDL_DestroyAudioStream
+ * \sa SDL_LoadWAV_IO
+ * \sa SDL_SeekWAVAudioStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateWAVAudioStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec);
+
+#define SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER      "SDL.audiostream.wav.frames"
+
+/**
+ * Create an audio stream that decodes a WAVE file from a file path as data
+ * is pulled from it.
+ *
+ * This is a convenience function that is effectively the same as:
+ *
+ * ```c
+ * SDL_CreateWAVAudioStream_IO(SDL_IOFromFile(path, "rb"), true, spec);
+ * ```
+ *
+ * \param path the file path of the WAV file to open.
+ * \param spec a pointer to an SDL_AudioSpec that will be set to the WAVE
+ *             data's format details on successful return. May be NULL.
+ * \returns a new audio stream on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateWAVAudioStream_IO
+ * \sa SDL_SeekWAVAudioStream
+ */
+extern SDL_DECLSPEC SDL_AudioStream * SDLCALL SDL_CreateWAVAudioStream(const char *path, SDL_AudioSpec *spec);
+
+/**
+ * Change the playback position of a WAVE audio stream.
+ *
+ * Any data already queued in the stream is cleared, and decoding resumes
+ * from the block containing `frame`. Frames before `frame` in that block are
+ * discarded, so the position is exact even with compressed formats. Seeking
+ * past the end positions the stream at the end of the data.
+ *
+ * \param stream an audio stream created with SDL_CreateWAVAudioStream_IO().
+ * \param frame the sample frame to continue playback from.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateWAVAudioStream_IO
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SeekWAVAudioStream(SDL_AudioStream *stream, Uint64 frame);
+
 /**
  * Mix audio data in a specified format.
  *
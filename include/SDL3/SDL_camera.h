@@ -305,6 +305,10 @@ extern SDL_DECLSPEC SDL_CameraPosition SDLCALL SDL_GetCameraPosition(SDL_CameraI
  * a NULL spec here. You can see the exact specs a device can support without
  * conversion with SDL_GetCameraSupportedFormats().
  *
+ * If you plan to convert frames on the GPU, set
+ * SDL_HINT_CAMERA_DEFER_CONVERSION before opening the camera and SDL will
+ * hand over frames in the camera's own format without converting them.
+ *
  * SDL will not attempt to emulate framerate; it will try to set the hardware
  * to the rate closest to the requested speed, but it won't attempt to limit
  * or duplicate frames artificially; call SDL_GetCameraFormat() to see the
@@ -388,6 +392,18 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
 /**
  * Get the properties associated with an opened camera.
  *
+ * The following read-only properties are updated as the camera runs:
+ *
+ * - `SDL_PROP_CAMERA_FRAMES_CAPTURED_NUMBER`: the number of frames the camera
+ *   has delivered to SDL.
+ * - `SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER`: the number of frames thrown away
+ *   because the app didn't acquire or release frames fast enough. See
+ *   SDL_HINT_CAMERA_FRAME_POOL_SIZE and SDL_HINT_CAMERA_FRAME_DROP_POLICY.
+ * - `SDL_PROP_CAMERA_FRAMES_CONVERTED_NUMBER`: the number of frames SDL had
+ *   to convert or scale to the format requested by the app.
+ * - `SDL_PROP_CAMERA_CONVERSION_TIME_NUMBER`: the total time spent
+ *   converting and scaling frames, in nanoseconds.
+ *
  * \param camera the SDL_Camera obtained from SDL_OpenCamera().
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -398,6 +414,11 @@ extern SDL_DECLSPEC SDL_CameraID SDLCALL SDL_GetCameraID(SDL_Camera *camera);
  */
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetCameraProperties(SDL_Camera *camera);
 
+#define SDL_PROP_CAMERA_FRAMES_CAPTURED_NUMBER     "SDL.camera.frames.captured"
+#define SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER      "SDL.camera.frames.dropped"
+#define SDL_PROP_CAMERA_FRAMES_CONVERTED_NUMBER    "SDL.camera.frames.converted"
+#define SDL_PROP_CAMERA_CONVERSION_TIME_NUMBER     "SDL.camera.conversion_time"
+
 /**
  * Get the spec that a camera is using when generating images.
  *
@@ -453,6 +474,24 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Cam
  * SDL_EVENT_CAMERA_DEVICE_DENIED) event, or poll
  * SDL_GetCameraPermissionState() occasionally until it returns non-zero.
  *
+ * On platforms where the camera hands SDL its frames in DMA buffers, frames
+ * that didn't need to be converted or scaled on the CPU have these properties,
+ * available through SDL_GetSurfaceProperties(), so the frame can be imported
+ * by a graphics API without copying the pixels:
+ *
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER`: the dma-buf file descriptor
+ *   containing the frame. SDL owns this file descriptor, it is valid until
+ *   the frame is released and must not be closed by the application; use
+ *   dup() if it needs to live longer than the frame.
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER`: the offset in bytes of the
+ *   frame within the dma-buf.
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER`: the distance in bytes between
+ *   rows of the frame.
+ * - `SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER`: the DRM format modifier
+ *   of the frame, 0 (DRM_FORMAT_MOD_LINEAR) if the frame isn't tiled.
+ *
+ * These are currently available with the V4L2 and PipeWire camera drivers.
+ *
  * \param camera opened camera device.
  * \param timestampNS a pointer filled in with the frame's timestamp, or 0 on
  *                    error. Can be NULL.
@@ -467,6 +506,11 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetCameraFormat(SDL_Camera *camera, SDL_Cam
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_AcquireCameraFrame(SDL_Camera *camera, Uint64 *timestampNS);
 
+#define SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER          "SDL.camera.frame.dmabuf.fd"
+#define SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER      "SDL.camera.frame.dmabuf.offset"
+#define SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER       "SDL.camera.frame.dmabuf.pitch"
+#define SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER    "SDL.camera.frame.dmabuf.modifier"
+
 /**
  * Release a frame of video acquired from a camera.
  *
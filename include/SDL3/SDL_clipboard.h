@@ -78,6 +78,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_iostream.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -289,6 +290,37 @@ extern SDL_DECLSPEC bool SDLCALL SDL_ClearClipboardData(void);
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_GetClipboardData(const char *mime_type, size_t *size);
 
+/**
+ * Open a stream that reads the data from the clipboard for a given mime type.
+ *
+ * Unlike SDL_GetClipboardData(), this doesn't need to hold the whole payload
+ * in memory at once, which matters for large images or files. Where the
+ * platform transfers clipboard data over a pipe the stream reads from it
+ * directly, and clipboard data set by this application with
+ * SDL_SetClipboardData() is read without being copied. On other platforms
+ * the data is retrieved up front and the stream reads from that buffer.
+ *
+ * The stream is read-only. It may not be seekable and its size may not be
+ * known; SDL_GetIOSize() returns -1 in that case. If the data isn't available
+ * yet, SDL_ReadIO() returns 0 and SDL_GetIOStatus() returns
+ * SDL_IO_STATUS_NOT_READY, and you can try again later without blocking.
+ *
+ * The stream should be closed with SDL_CloseIO() before the clipboard
+ * contents are changed.
+ *
+ * \param mime_type the mime type to read from the clipboard.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetClipboardData
+ * \sa SDL_HasClipboardData
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_OpenClipboardDataIO(const char *mime_type);
+
 /**
  * Query whether there is data in the clipboard for the provided mime type.
  *
@@ -72,6 +72,65 @@ extern "C" {
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetNumLogicalCPUCores(void);
 
+/**
+ * The kinds of CPU core that hybrid processors mix together.
+ *
+ * Processors like Intel's hybrid designs and ARM big.LITTLE parts combine
+ * fast, power-hungry cores with slower, more frugal ones. On systems where
+ * every core is the same, all cores are reported as performance cores.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetNumCPUCoresOfType
+ * \sa SDL_GetCPUCoreMask
+ * \sa SDL_SetCurrentThreadCoreType
+ */
+typedef enum SDL_CPUCoreType
+{
+    SDL_CPU_CORE_ANY,           /**< Any core; no preference. */
+    SDL_CPU_CORE_PERFORMANCE,   /**< A high-performance ("big", "P") core. */
+    SDL_CPU_CORE_EFFICIENCY     /**< A power-efficient ("LITTLE", "E") core. */
+} SDL_CPUCoreType;
+
+/**
+ * Get the number of logical CPU cores of a given type.
+ *
+ * `SDL_CPU_CORE_ANY` returns the same value as SDL_GetNumLogicalCPUCores().
+ *
+ * \param type the kind of core to count.
+ * \returns the number of logical cores of that type, which may be 0 (for
+ *          example, there are no efficiency cores on most desktop CPUs).
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUCoreMask
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetNumCPUCoresOfType(SDL_CPUCoreType type);
+
+/**
+ * Get the set of logical CPUs of a given type, as a bitmask.
+ *
+ * Bit N of the result is set if logical CPU N is of the requested type. Only
+ * the first 64 logical CPUs can be represented. The result is suitable for
+ * SDL_SetCurrentThreadAffinity() and `SDL_PROP_THREAD_CREATE_AFFINITY_NUMBER`.
+ *
+ * Some platforms (Apple's, notably) report how many cores of each type exist
+ * but not which CPU numbers they are; there this returns 0 for
+ * `SDL_CPU_CORE_PERFORMANCE` and `SDL_CPU_CORE_EFFICIENCY`.
+ *
+ * \param type the kind of core to look up.
+ * \returns a bitmask of logical CPUs, or 0 if none are known.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetNumCPUCoresOfType
+ */
+extern SDL_DECLSPEC Uint64 SDLCALL SDL_GetCPUCoreMask(SDL_CPUCoreType type);
+
 /**
  * Determine the L1 cache line size of the CPU.
  *
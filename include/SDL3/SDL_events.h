@@ -213,6 +213,7 @@ typedef enum SDL_EventType
     SDL_EVENT_FINGER_UP,
     SDL_EVENT_FINGER_MOTION,
     SDL_EVENT_FINGER_CANCELED,
+    SDL_EVENT_FINGER_FRAME,    /**< All fingers of a touch device after a frame of changes, if SDL_HINT_TOUCH_FRAME_EVENTS is enabled */
 
     /* 0x800, 0x801, and 0x802 were the Gesture events from SDL2. Do not reuse these values! sdl2-compat needs them! */
 
@@ -243,6 +244,7 @@ typedef enum SDL_EventType
     SDL_EVENT_PEN_BUTTON_UP,              /**< Pressure-sensitive pen button released */
     SDL_EVENT_PEN_MOTION,                 /**< Pressure-sensitive pen is moving on the tablet */
     SDL_EVENT_PEN_AXIS,                   /**< Pressure-sensitive pen angle/pressure/etc changed */
+    SDL_EVENT_PEN_FRAME,                  /**< Pressure-sensitive pen position and axes after a frame of changes, if SDL_HINT_PEN_FRAME_EVENTS is enabled */
 
     /* Camera hotplug events */
     SDL_EVENT_CAMERA_DEVICE_ADDED = 0x1400,  /**< A new camera device is available */
@@ -436,6 +438,28 @@ typedef struct SDL_MouseDeviceEvent
     SDL_MouseID which;  /**< The mouse instance id */
 } SDL_MouseDeviceEvent;
 
+/**
+ * A single motion sample merged into a coalesced motion event.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is enabled, consecutive mouse, pen or
+ * finger motion events for the same device and window are merged into one
+ * queued event, and the individual samples are made available through the
+ * event's `history` array, oldest first.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+typedef struct SDL_MotionSample
+{
+    Uint64 timestamp;   /**< In nanoseconds, populated using SDL_GetTicksNS() */
+    float x;            /**< X coordinate, in the same space as the event's `x` */
+    float y;            /**< Y coordinate, in the same space as the event's `y` */
+    float xrel;         /**< The relative motion in the X direction, 0 for pens */
+    float yrel;         /**< The relative motion in the Y direction, 0 for pens */
+    float pressure;     /**< Normalized in the range 0...1 for fingers, 0 otherwise */
+} SDL_MotionSample;
+
 /**
  * Mouse motion event structure (event.motion.*)
  *
@@ -453,6 +477,8 @@ typedef struct SDL_MouseMotionEvent
     float y;            /**< Y coordinate, relative to window */
     float xrel;         /**< The relative motion in the X direction */
     float yrel;         /**< The relative motion in the Y direction */
+    int num_history;    /**< The number of samples in `history`, 0 if this event wasn't coalesced */
+    const SDL_MotionSample *history; /**< The samples merged into this event, oldest first, or NULL. This memory is owned by SDL, like SDL_TextInputEvent::text. */
 } SDL_MouseMotionEvent;
 
 /**
@@ -778,8 +804,37 @@ typedef struct SDL_TouchFingerEvent
     float dy;           /**< Normalized in the range -1...1 */
     float pressure;     /**< Normalized in the range 0...1 */
     SDL_WindowID windowID; /**< The window underneath the finger, if any */
+    int num_history;    /**< The number of samples in `history`, 0 if this event wasn't coalesced */
+    const SDL_MotionSample *history; /**< The samples merged into this event, oldest first, or NULL. This memory is owned by SDL, like SDL_TextInputEvent::text. */
 } SDL_TouchFingerEvent;
 
+/**
+ * Touch frame event structure (event.tframe.*)
+ *
+ * When SDL_HINT_TOUCH_FRAME_EVENTS is enabled, SDL sends one of these per
+ * touch device each time events are pumped, if any finger on that device went
+ * down, moved, or was lifted since the last one. It carries every finger that
+ * is still touching, so an app tracking multi-finger gestures can handle a
+ * single event per device per frame instead of one per finger.
+ *
+ * The per-finger SDL_EVENT_FINGER_* events are still sent; apps that only
+ * want frames can turn off SDL_EVENT_FINGER_MOTION with
+ * SDL_SetEventEnabled(). Coordinates are normalized the same way as in
+ * SDL_TouchFingerEvent.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ */
+typedef struct SDL_TouchFrameEvent
+{
+    SDL_EventType type; /**< SDL_EVENT_FINGER_FRAME */
+    Uint32 reserved;
+    Uint64 timestamp;   /**< In nanoseconds, the timestamp of the most recent change in this frame */
+    SDL_TouchID touchID; /**< The touch device id */
+    SDL_WindowID windowID; /**< The window underneath the most recently changed finger, if any */
+    int num_fingers;    /**< The number of fingers in `fingers`, 0 if the last finger was lifted */
+    const SDL_Finger *fingers; /**< The fingers currently touching, or NULL. This memory is owned by SDL, like SDL_TextInputEvent::text. */
+} SDL_TouchFrameEvent;
+
 /**
  * Pressure-sensitive pen proximity event structure (event.pmotion.*)
  *
@@ -825,6 +880,8 @@ typedef struct SDL_PenMotionEvent
     SDL_PenInputFlags pen_state;   /**< Complete pen input state at time of event */
     float x;                /**< X coordinate, relative to window */
     float y;                /**< Y coordinate, relative to window */
+    int num_history;        /**< The number of samples in `history`, 0 if this event wasn't coalesced */
+    const SDL_MotionSample *history; /**< The samples merged into this event, oldest first, or NULL. This memory is owned by SDL, like SDL_TextInputEvent::text. */
 } SDL_PenMotionEvent;
 
 /**
@@ -893,6 +950,32 @@ typedef struct SDL_PenAxisEvent
     float value;            /**< New value of axis */
 } SDL_PenAxisEvent;
 
+/**
+ * Pressure-sensitive pen frame event structure (event.pframe.*)
+ *
+ * When SDL_HINT_PEN_FRAME_EVENTS is enabled, SDL sends one of these per pen
+ * each time events are pumped, if the pen moved or any of its axes changed
+ * since the last one. It carries the complete pen state, so an app can handle
+ * a single event per pen per frame instead of one per axis.
+ *
+ * The SDL_EVENT_PEN_MOTION and SDL_EVENT_PEN_AXIS events are still sent;
+ * apps that only want frames can turn those off with SDL_SetEventEnabled().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ */
+typedef struct SDL_PenFrameEvent
+{
+    SDL_EventType type;     /**< SDL_EVENT_PEN_FRAME */
+    Uint32 reserved;
+    Uint64 timestamp;       /**< In nanoseconds, the timestamp of the most recent change in this frame */
+    SDL_WindowID windowID;  /**< The window with pen focus, if any */
+    SDL_PenID which;        /**< The pen instance id */
+    SDL_PenInputFlags pen_state;   /**< Complete pen input state at time of event */
+    float x;                /**< X coordinate, relative to window */
+    float y;                /**< Y coordinate, relative to window */
+    float axes[SDL_PEN_AXIS_COUNT]; /**< The value of every axis, indexed by SDL_PenAxis */
+} SDL_PenFrameEvent;
+
 /**
  * An event used to drop text or request a file open by the system
  * (event.drop.*)
@@ -1017,11 +1100,13 @@ typedef union SDL_Event
     SDL_QuitEvent quit;                     /**< Quit request event data */
     SDL_UserEvent user;                     /**< Custom event data */
     SDL_TouchFingerEvent tfinger;           /**< Touch finger event data */
+    SDL_TouchFrameEvent tframe;             /**< Touch frame event data */
     SDL_PenProximityEvent pproximity;       /**< Pen proximity event data */
     SDL_PenTouchEvent ptouch;               /**< Pen tip touching event data */
     SDL_PenMotionEvent pmotion;             /**< Pen motion event data */
     SDL_PenButtonEvent pbutton;             /**< Pen button event data */
     SDL_PenAxisEvent paxis;                 /**< Pen axis event data */
+    SDL_PenFrameEvent pframe;               /**< Pen frame event data */
     SDL_RenderEvent render;                 /**< Render event data */
     SDL_DropEvent drop;                     /**< Drag and drop event data */
     SDL_ClipboardEvent clipboard;           /**< Clipboard event data */
@@ -1269,6 +1354,47 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType)
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for several currently pending events at once.
+ *
+ * This behaves like calling SDL_PollEvent() repeatedly, but pumps events at
+ * most once and removes up to `numevents` events from the queue while
+ * holding the queue lock only once, which is much cheaper when a frame has
+ * many events to drain.
+ *
+ * Like SDL_PollEvent(), this stops at the end of a poll cycle: once every
+ * event that was pending when events were last pumped has been returned, the
+ * next call returns 0, and the call after that pumps events again. This
+ * means the usual loop works unchanged:
+ *
+ * ```c
+ * SDL_Event events[64];
+ * int count;
+ * while ((count = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+ *     for (int i = 0; i < count; ++i) {
+ *         // decide what to do with events[i].
+ *     }
+ * }
+ * ```
+ *
+ * As this function may implicitly call SDL_PumpEvents(), you can only call
+ * this function in the thread that set the video mode.
+ *
+ * \param events an array of SDL_Event structures to be filled with events
+ *               from the queue, oldest first.
+ * \param numevents the maximum number of events to store in `events`.
+ * \returns the number of events stored in `events`, 0 if there are none
+ *          available, or -1 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PollEvent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -1470,11 +1596,44 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetEventFilter(SDL_EventFilter *filter, voi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_AddEventWatch(SDL_EventFilter filter, void *userdata);
 
+/**
+ * Add a callback to be triggered when an event in a range of types is added
+ * to the event queue.
+ *
+ * This works like SDL_AddEventWatch(), except `filter` is only called for
+ * events whose type is between `minType` and `maxType`, inclusive. SDL skips
+ * watchers that don't care about an event without calling them, and doesn't
+ * take the watch list lock at all when no watcher is interested, so
+ * registering a narrow range is much cheaper than filtering on the event
+ * type inside the callback when high rate events like mouse motion are
+ * flowing.
+ *
+ * The callback is removed with SDL_RemoveEventWatch().
+ *
+ * \param minType the lowest event type to watch; see SDL_EventType for
+ *                details.
+ * \param maxType the highest event type to watch; see SDL_EventType for
+ *                details.
+ * \param filter an SDL_EventFilter function to call when an event happens.
+ * \param userdata a pointer that is passed to `filter`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddEventWatch
+ * \sa SDL_RemoveEventWatch
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AddEventWatchRange(Uint32 minType, Uint32 maxType, SDL_EventFilter filter, void *userdata);
+
 /**
  * Remove an event watch callback added with SDL_AddEventWatch().
  *
  * This function takes the same input as SDL_AddEventWatch() to identify and
- * delete the corresponding callback.
+ * delete the corresponding callback. It also removes callbacks added with
+ * SDL_AddEventWatchRange().
  *
  * \param filter the function originally passed to SDL_AddEventWatch().
  * \param userdata the pointer originally passed to SDL_AddEventWatch().
@@ -1567,6 +1726,110 @@ extern SDL_DECLSPEC Uint32 SDLCALL SDL_RegisterEvents(int numevents);
  */
 extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowFromEvent(const SDL_Event *event);
 
+/**
+ * The number of buckets in each SDL_EventLatencyStats histogram.
+ *
+ * Bucket 0 counts events that took less than 125 microseconds, and each
+ * following bucket doubles the limit (250us, 500us, 1ms, ...); the last
+ * bucket counts everything slower.
+ *
+ * \since This macro is available since SDL 3.4.0.
+ */
+#define SDL_EVENT_LATENCY_HISTOGRAM_BUCKETS 10
+
+/**
+ * Latency statistics for a group of related event types.
+ *
+ * Two stages of each delivered event's life are measured: from its
+ * timestamp, which backends take from the OS where it's available, until SDL
+ * put it in the queue ("source"), and from then until the app took it out
+ * ("queue"). What the app does afterwards is up to the app to measure, by
+ * comparing its own clock against the event timestamp.
+ *
+ * Coalesced motion events (see SDL_HINT_EVENT_COALESCE_MOTION) are counted
+ * once, with the queue time of their first sample.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventLatencyStats
+ */
+typedef struct SDL_EventLatencyStats
+{
+    Uint64 count;           /**< Events delivered to the app */
+    Uint64 source_ns_total; /**< Total time from event timestamps until they were queued, in nanoseconds */
+    Uint64 source_ns_max;   /**< Longest time from an event timestamp until it was queued, in nanoseconds */
+    Uint64 queue_ns_total;  /**< Total time events spent in the queue, in nanoseconds */
+    Uint64 queue_ns_max;    /**< Longest time an event spent in the queue, in nanoseconds */
+    Uint64 source_histogram[SDL_EVENT_LATENCY_HISTOGRAM_BUCKETS]; /**< Distribution of source times */
+    Uint64 queue_histogram[SDL_EVENT_LATENCY_HISTOGRAM_BUCKETS];  /**< Distribution of queue times */
+} SDL_EventLatencyStats;
+
+/**
+ * Get event latency statistics for the group an event type belongs to.
+ *
+ * Statistics are only collected while SDL_HINT_EVENT_LATENCY_STATS is
+ * enabled. They are kept per group of event types that share an event
+ * structure, so asking for SDL_EVENT_KEY_DOWN reports on all key events,
+ * SDL_EVENT_USER on all user events, and so on.
+ *
+ * \param type an event type in the group to query; see SDL_EventType for
+ *             details.
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ResetEventLatencyStats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetEventLatencyStats(Uint32 type, SDL_EventLatencyStats *stats);
+
+/**
+ * Clear all event latency statistics.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventLatencyStats
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetEventLatencyStats(void);
+
+/**
+ * Memory usage statistics for the event queue.
+ *
+ * Queued events are stored in entries that SDL allocates in blocks. Blocks
+ * are kept while events are queued, and the ones beyond a small reserve are
+ * released once the queue empties.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetEventQueueStats
+ */
+typedef struct SDL_EventQueueStats
+{
+    int num_events;           /**< Events currently in the queue */
+    int max_events_seen;      /**< Most events that were in the queue at once since the event subsystem was initialized */
+    int num_entries;          /**< Event entries currently allocated, queued or free */
+    Uint64 block_allocations; /**< Blocks of event entries allocated since the event subsystem was initialized */
+    Uint64 block_releases;    /**< Blocks of event entries released since the event subsystem was initialized */
+} SDL_EventQueueStats;
+
+/**
+ * Get memory usage statistics for the event queue.
+ *
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetEventQueueStats(SDL_EventQueueStats *stats);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -350,6 +350,38 @@ typedef SDL_EnumerationResult (SDLCALL *SDL_EnumerateDirectoryCallback)(void *us
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata);
 
+/**
+ * Enumerate a directory and everything below it through a callback
+ * function.
+ *
+ * This works like SDL_EnumerateDirectory(), but also walks into every
+ * subdirectory it finds. Several directories are read at once on SDL's
+ * worker threads, which makes walking large trees much faster, so the
+ * callback can be called from several threads at the same time and must be
+ * thread-safe. Entries are not provided in any particular order, but a
+ * directory is always provided before anything inside it.
+ *
+ * Returning SDL_ENUM_CONTINUE from the callback for a directory lets the
+ * walk descend into it. SDL_ENUM_SUCCESS and SDL_ENUM_FAILURE stop the whole
+ * walk as soon as the threads notice, so a few more entries may still be
+ * provided after the callback asks to stop.
+ *
+ * \param path the path of the directory to enumerate.
+ * \param callback a function that is called for each entry in the tree.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety The callback may be called from any thread, several at a
+ *               time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EnumerateDirectory
+ * \sa SDL_GlobDirectory
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_EnumerateDirectoryRecursive(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata);
+
 /**
  * Remove a file or an empty directory.
  *
@@ -1377,6 +1377,45 @@ extern SDL_DECLSPEC float SDLCALL SDL_GetGamepadSensorDataRate(SDL_Gamepad *game
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *data, int num_values);
 
+/**
+ * Get the sensor samples received since the last call.
+ *
+ * Controllers like the DualSense and Switch Pro report gyro and accelerometer
+ * data at hundreds of samples per second, which is more than an application
+ * usually wants to handle as individual events. This function returns every
+ * sample that arrived since the last call, oldest first, so an application
+ * can process full rate motion data once per frame. This works whether or not
+ * SDL_EVENT_GAMEPAD_SENSOR_UPDATE is enabled, so an application that uses this
+ * can disable those events with SDL_SetEventEnabled().
+ *
+ * SDL starts keeping samples the first time this is called for a sensor, so
+ * the first call returns 0. Samples are kept until the sensor is disabled,
+ * and if the application doesn't read them for a while only the most recent
+ * samples are kept.
+ *
+ * Each sample is written to `data` as `num_values` floats, so `data` must have
+ * room for `max_samples * num_values` values. The interpretation of the data
+ * is the same as for SDL_GetGamepadSensorData().
+ *
+ * \param gamepad the gamepad to query.
+ * \param type the type of sensor to query.
+ * \param data a pointer filled with the sensor samples.
+ * \param num_values the number of values to write to data for each sample.
+ * \param timestamps a pointer filled with the sensor timestamp of each
+ *                   sample, in nanoseconds, may be NULL.
+ * \param max_samples the maximum number of samples to return.
+ * \returns the number of samples written, or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGamepadSensorData
+ * \sa SDL_SetGamepadSensorEnabled
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetGamepadSensorSamples(SDL_Gamepad *gamepad, SDL_SensorType type, float *data, int num_values, Uint64 *timestamps, int max_samples);
+
 /**
  * Start a rumble effect on a gamepad.
  *
@@ -514,6 +514,19 @@ typedef struct SDL_GPUCopyPass SDL_GPUCopyPass;
  */
 typedef struct SDL_GPUFence SDL_GPUFence;
 
+/**
+ * An opaque handle representing a pool of GPU queries.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUQueryPool
+ * \sa SDL_WriteGPUTimestamp
+ * \sa SDL_BeginGPUQuery
+ * \sa SDL_GetGPUQueryResults
+ * \sa SDL_ReleaseGPUQueryPool
+ */
+typedef struct SDL_GPUQueryPool SDL_GPUQueryPool;
+
 /**
  * Specifies the primitive topology of a graphics pipeline.
  *
@@ -814,6 +827,15 @@ typedef enum SDL_GPUTextureFormat
  * within a compute pass. Note that SIMULTANEOUS usage is only supported by a
  * limited number of texture formats.
  *
+ * TRANSIENT_ATTACHMENT marks a color or depth-stencil target whose contents
+ * only need to exist during a render pass, such as a depth buffer or a
+ * multisample target that is resolved at the end of the pass. On tile-based
+ * GPUs the driver can then keep the texture in tile memory without backing
+ * it with real memory. Such a texture can only be combined with COLOR_TARGET
+ * or DEPTH_STENCIL_TARGET, must be a 2D texture with a single mip level, and
+ * must never be loaded or stored by a render pass, uploaded to, downloaded
+ * from, copied or blitted.
+ *
  * \since This datatype is available since SDL 3.2.0.
  *
  * \sa SDL_CreateGPUTexture
@@ -827,6 +849,7 @@ typedef Uint32 SDL_GPUTextureUsageFlags;
 #define SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ                    (1u << 4) /**< Texture supports storage reads in the compute stage. */
 #define SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE                   (1u << 5) /**< Texture supports storage writes in the compute stage. */
 #define SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE (1u << 6) /**< Texture supports reads and writes in the same compute shader. This is NOT equivalent to READ | WRITE. */
+#define SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT                    (1u << 7) /**< Texture contents only live for the duration of a render pass. Available since SDL 3.4.0. */
 
 /**
  * Specifies the type of a texture.
@@ -926,6 +949,9 @@ typedef enum SDL_GPUTransferBufferUsage
 /**
  * Specifies which stage a shader program corresponds to.
  *
+ * Task and mesh shaders are only usable on a device created with
+ * `SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN`.
+ *
  * \since This enum is available since SDL 3.2.0.
  *
  * \sa SDL_CreateGPUShader
@@ -933,7 +959,9 @@ typedef enum SDL_GPUTransferBufferUsage
 typedef enum SDL_GPUShaderStage
 {
     SDL_GPU_SHADERSTAGE_VERTEX,
-    SDL_GPU_SHADERSTAGE_FRAGMENT
+    SDL_GPU_SHADERSTAGE_FRAGMENT,
+    SDL_GPU_SHADERSTAGE_TASK,     /**< Available since SDL 3.4.0. */
+    SDL_GPU_SHADERSTAGE_MESH      /**< Available since SDL 3.4.0. */
 } SDL_GPUShaderStage;
 
 /**
@@ -1225,20 +1253,33 @@ typedef enum SDL_GPUSamplerAddressMode
  * Specifies the timing that will be used to present swapchain textures to the
  * OS.
  *
- * VSYNC mode will always be supported. IMMEDIATE and MAILBOX modes may not be
- * supported on certain systems.
+ * VSYNC mode will always be supported. IMMEDIATE, MAILBOX and VSYNC_RELAXED
+ * modes may not be supported on certain systems.
  *
  * It is recommended to query SDL_WindowSupportsGPUPresentMode after claiming
- * the window if you wish to change the present mode to IMMEDIATE or MAILBOX.
+ * the window if you wish to change the present mode to IMMEDIATE, MAILBOX or
+ * VSYNC_RELAXED.
  *
  * - VSYNC: Waits for vblank before presenting. No tearing is possible. If
  *   there is a pending image to present, the new image is enqueued for
  *   presentation. Disallows tearing at the cost of visual latency.
  * - IMMEDIATE: Immediately presents. Lowest latency option, but tearing may
- *   occur.
+ *   occur. Where the platform distinguishes between them, this requests a
+ *   tearing-allowed present, which is also what lets a variable refresh rate
+ *   display follow the application's frame rate without waiting for vblank.
  * - MAILBOX: Waits for vblank before presenting. No tearing is possible. If
  *   there is a pending image to present, the pending image is replaced by the
  *   new image. Similar to VSYNC, but with reduced visual latency.
+ * - VSYNC_RELAXED: Waits for vblank before presenting, like VSYNC, but if the
+ *   previous vblank was missed the image is presented immediately and tearing
+ *   may occur. This avoids stalling a whole refresh interval when the frame
+ *   rate drops slightly below the refresh rate. (Since SDL 3.4.0)
+ *
+ * On displays with variable refresh rate enabled, VSYNC presents as soon as
+ * the display can start a new refresh, so the refresh rate follows the
+ * application's frame rate within the display's supported range. See
+ * `SDL_PROP_DISPLAY_VRR_CAPABLE_BOOLEAN` in SDL_GetDisplayProperties(), and
+ * SDL_HINT_GPU_FRAME_RATE_LIMIT to keep the frame rate inside that range.
  *
  * \since This enum is available since SDL 3.2.0.
  *
@@ -1250,7 +1291,8 @@ typedef enum SDL_GPUPresentMode
 {
     SDL_GPU_PRESENTMODE_VSYNC,
     SDL_GPU_PRESENTMODE_IMMEDIATE,
-    SDL_GPU_PRESENTMODE_MAILBOX
+    SDL_GPU_PRESENTMODE_MAILBOX,
+    SDL_GPU_PRESENTMODE_VSYNC_RELAXED
 } SDL_GPUPresentMode;
 
 /**
@@ -1287,6 +1329,52 @@ typedef enum SDL_GPUSwapchainComposition
     SDL_GPU_SWAPCHAINCOMPOSITION_HDR10_ST2084
 } SDL_GPUSwapchainComposition;
 
+/**
+ * Specifies what a query pool measures.
+ *
+ * - TIMESTAMP: each query records the GPU time, in nanoseconds, at which all
+ *   previously recorded work in the command buffer completed. Written with
+ *   SDL_WriteGPUTimestamp(). Subtract two timestamps to time the passes
+ *   recorded between them.
+ * - PIPELINE_STATISTICS: each query counts the work done between
+ *   SDL_BeginGPUQuery() and SDL_EndGPUQuery(), as an
+ *   SDL_GPUPipelineStatistics.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+typedef enum SDL_GPUQueryType
+{
+    SDL_GPU_QUERYTYPE_TIMESTAMP,
+    SDL_GPU_QUERYTYPE_PIPELINE_STATISTICS
+} SDL_GPUQueryType;
+
+/**
+ * Specifies which hardware queue a command buffer is submitted to.
+ *
+ * - GRAPHICS: the default queue. Supports every kind of pass.
+ * - COMPUTE: an asynchronous compute queue. Supports compute and copy passes,
+ *   but not render passes, blits, mipmap generation or swapchain textures.
+ * - TRANSFER: a dedicated transfer queue. Supports copy passes only. Texture
+ *   copies must not involve depth-stencil textures, and transfer buffer
+ *   offsets used with textures must be a multiple of 4.
+ *
+ * Work on different queues may run concurrently. Use
+ * SDL_AddGPUCommandBufferWaitFence() to order work between queues.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUCommandBufferForQueue
+ * \sa SDL_GPUSupportsDedicatedQueue
+ */
+typedef enum SDL_GPUQueueType
+{
+    SDL_GPU_QUEUETYPE_GRAPHICS,
+    SDL_GPU_QUEUETYPE_COMPUTE,
+    SDL_GPU_QUEUETYPE_TRANSFER
+} SDL_GPUQueueType;
+
 /* Structures */
 
 /**
@@ -1491,6 +1579,70 @@ typedef struct SDL_GPUIndirectDispatchCommand
     Uint32 groupcount_z;  /**< The number of local workgroups to dispatch in the Z dimension. */
 } SDL_GPUIndirectDispatchCommand;
 
+/**
+ * A structure containing the result of a pipeline statistics query.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGPUQueryResults
+ */
+typedef struct SDL_GPUPipelineStatistics
+{
+    Uint64 input_assembly_vertices;    /**< The number of vertices read by the input assembler. */
+    Uint64 input_assembly_primitives;  /**< The number of primitives read by the input assembler. */
+    Uint64 vertex_shader_invocations;  /**< The number of vertex shader invocations. */
+    Uint64 clipping_invocations;       /**< The number of primitives sent to the clipper. */
+    Uint64 clipping_primitives;        /**< The number of primitives output by the clipper. */
+    Uint64 fragment_shader_invocations; /**< The number of fragment shader invocations. */
+    Uint64 compute_shader_invocations; /**< The number of compute shader invocations. */
+} SDL_GPUPipelineStatistics;
+
+/**
+ * A structure containing counts of the work recorded into a device's command
+ * buffers.
+ *
+ * The counts are totals over every command buffer submitted since the device
+ * was created, so per-frame numbers are the difference between two calls to
+ * SDL_GetGPUDeviceStats().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGPUDeviceStats
+ */
+typedef struct SDL_GPUDeviceStats
+{
+    Uint64 command_buffers;  /**< The number of command buffers submitted. */
+    Uint64 draw_calls;       /**< The number of draw calls, including indirect and mesh task draws. */
+    Uint64 dispatches;       /**< The number of compute dispatches. */
+    Uint64 pipeline_binds;   /**< The number of graphics and compute pipeline binds. */
+    Uint64 resource_binds;   /**< The number of calls binding vertex or index buffers, samplers, storage textures or storage buffers. */
+    Uint64 uniform_bytes;    /**< The number of bytes of uniform data pushed. */
+    Uint64 upload_bytes;     /**< The number of bytes uploaded to buffers and textures in copy passes. */
+} SDL_GPUDeviceStats;
+
+/**
+ * A structure containing memory statistics for one of the device's memory
+ * heaps.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGPUMemoryHeapStats
+ */
+typedef struct SDL_GPUMemoryHeapStats
+{
+    Uint64 size;              /**< The total size of the heap in bytes. */
+    Uint64 budget;            /**< The number of bytes the process can use from the heap without degrading performance, or the heap size if the driver does not report a budget. */
+    Uint64 usage;             /**< The number of bytes of the heap used by the process, or the value of allocated if the driver does not report it. */
+    Uint64 allocated;         /**< The number of bytes of device memory SDL has allocated from the heap. */
+    Uint64 used;              /**< The number of allocated bytes occupied by resources. */
+    Uint64 fragmented;        /**< The number of free allocated bytes outside the largest free range of each allocation. */
+    Uint32 allocation_count;  /**< The number of device memory allocations SDL has made from the heap. */
+    bool device_local;        /**< true if the heap is local to the GPU. */
+    Uint8 padding1;
+    Uint8 padding2;
+    Uint8 padding3;
+} SDL_GPUMemoryHeapStats;
+
 /* State structures */
 
 /**
@@ -2142,6 +2294,11 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDevice(
  *   energy efficiency over maximum GPU performance, defaults to false.
  * - `SDL_PROP_GPU_DEVICE_CREATE_NAME_STRING`: the name of the GPU driver to
  *   use, if a specific one is desired.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_THREADS_NUMBER`: the number of
+ *   worker threads used by SDL_CreateGPUGraphicsPipelineAsync() and
+ *   SDL_CreateGPUComputePipelineAsync(), defaults to one less than the
+ *   number of logical CPU cores, at most 4. The threads are only started
+ *   when the first asynchronous pipeline is requested.
  *
  * These are the current shader format properties:
  *
@@ -2163,6 +2320,33 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDevice(
  * - `SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING`: the prefix to
  *   use for all vertex semantics, default is "TEXCOORD".
  *
+ * With the Vulkan renderer:
+ *
+ * - `SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_DATA_POINTER`: a blob
+ *   previously returned by SDL_GetGPUPipelineCacheData() to seed the
+ *   device's pipeline cache with. Data that was produced by a different
+ *   driver or physical device is silently ignored. The data is only read
+ *   during this call and may be freed afterwards.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_SIZE_NUMBER`: the size in
+ *   bytes of the pipeline cache data.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEDICATED_QUEUES_BOOLEAN`: enable to
+ *   create dedicated compute and transfer queues where the hardware has them,
+ *   for use with SDL_AcquireGPUCommandBufferForQueue(). Resources are then
+ *   shared between queue families, which can disable some driver
+ *   optimizations such as framebuffer compression, so this defaults to
+ *   false.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_NUMBER`: the maximum
+ *   number of bytes of resources moved by memory defragmentation per
+ *   command buffer submission. Defragmentation continues over later
+ *   submissions once the budget is used up. The default, 0, moves all
+ *   resources of one fragmented allocation per submission.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN`: enable to
+ *   require task and mesh shader support, for use with
+ *   SDL_DrawGPUMeshTasks(). Device creation fails if no backend supports
+ *   them; this is available on Vulkan (VK_EXT_mesh_shader) and D3D12, but not
+ *   Metal. Defaults to false. Use SDL_GPUSupportsProperties() to check
+ *   beforehand.
+ *
  * \param props the properties to use.
  * \returns a GPU context on success or NULL on failure; call SDL_GetError()
  *          for more information.
@@ -2173,6 +2357,7 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDevice(
  * \sa SDL_GetGPUDeviceDriver
  * \sa SDL_DestroyGPUDevice
  * \sa SDL_GPUSupportsProperties
+ * \sa SDL_GetGPUPipelineCacheData
  */
 extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDeviceWithProperties(
     SDL_PropertiesID props);
@@ -2180,6 +2365,7 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDeviceWithProperties(
 #define SDL_PROP_GPU_DEVICE_CREATE_DEBUGMODE_BOOLEAN          "SDL.gpu.device.create.debugmode"
 #define SDL_PROP_GPU_DEVICE_CREATE_PREFERLOWPOWER_BOOLEAN     "SDL.gpu.device.create.preferlowpower"
 #define SDL_PROP_GPU_DEVICE_CREATE_NAME_STRING                "SDL.gpu.device.create.name"
+#define SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_THREADS_NUMBER    "SDL.gpu.device.create.pipelinethreads"
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_PRIVATE_BOOLEAN    "SDL.gpu.device.create.shaders.private"
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_SPIRV_BOOLEAN      "SDL.gpu.device.create.shaders.spirv"
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_DXBC_BOOLEAN       "SDL.gpu.device.create.shaders.dxbc"
@@ -2187,6 +2373,11 @@ extern SDL_DECLSPEC SDL_GPUDevice * SDLCALL SDL_CreateGPUDeviceWithProperties(
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_MSL_BOOLEAN        "SDL.gpu.device.create.shaders.msl"
 #define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_METALLIB_BOOLEAN   "SDL.gpu.device.create.shaders.metallib"
 #define SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING "SDL.gpu.device.create.d3d12.semantic"
+#define SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_DATA_POINTER "SDL.gpu.device.create.pipelinecache.data"
+#define SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_SIZE_NUMBER "SDL.gpu.device.create.pipelinecache.size"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEDICATED_QUEUES_BOOLEAN "SDL.gpu.device.create.vulkan.dedicatedqueues"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_NUMBER "SDL.gpu.device.create.vulkan.defragbudget"
+#define SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN "SDL.gpu.device.create.feature.meshshaders"
 
 /**
  * Destroys a GPU context previously returned by SDL_CreateGPUDevice.
@@ -2250,6 +2441,77 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetGPUDeviceDriver(SDL_GPUDevice *d
  */
 extern SDL_DECLSPEC SDL_GPUShaderFormat SDLCALL SDL_GetGPUShaderFormats(SDL_GPUDevice *device);
 
+/**
+ * Retrieves the contents of the device's pipeline cache.
+ *
+ * The returned blob contains the driver's compiled form of every graphics
+ * and compute pipeline created so far. It can be written to disk and passed
+ * back through `SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_DATA_POINTER` on
+ * the next launch to avoid recompiling those pipelines.
+ *
+ * The data is opaque and only valid for the same driver version and
+ * physical device that produced it; incompatible data is ignored when the
+ * device is created.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param device a GPU context to query.
+ * \param size a pointer filled in with the number of bytes returned, may be
+ *             NULL.
+ * \returns the pipeline cache data, or NULL on failure; call SDL_GetError()
+ *          for more information. This should be freed with SDL_free() when
+ *          it is no longer needed.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUDeviceWithProperties
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_GetGPUPipelineCacheData(SDL_GPUDevice *device, size_t *size);
+
+/**
+ * Retrieves memory statistics for each of the device's memory heaps.
+ *
+ * Comparing `usage` against `budget` shows how close the process is to
+ * running out of memory on a heap, and `fragmented` shows how much
+ * allocated memory is unusable for large resources until it is
+ * defragmented.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param device a GPU context to query.
+ * \param count a pointer filled in with the number of heaps returned, may be
+ *              NULL.
+ * \returns an array of heap statistics, or NULL on failure; call
+ *          SDL_GetError() for more information. This should be freed with
+ *          SDL_free() when it is no longer needed.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC SDL_GPUMemoryHeapStats * SDLCALL SDL_GetGPUMemoryHeapStats(SDL_GPUDevice *device, int *count);
+
+/**
+ * Retrieves counts of the work submitted to a device.
+ *
+ * This is meant for performance overlays and telemetry, for example to notice
+ * when the number of draw calls or pipeline binds per frame jumps because
+ * batching broke down. Work is counted when its command buffer is submitted;
+ * cancelled command buffers are not counted.
+ *
+ * \param device a GPU context to query.
+ * \param stats a pointer filled in with the device's statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetGPUDeviceStats(SDL_GPUDevice *device, SDL_GPUDeviceStats *stats);
+
 /* State Creation */
 
 /**
@@ -2311,6 +2573,18 @@ extern SDL_DECLSPEC SDL_GPUComputePipeline * SDLCALL SDL_CreateGPUComputePipelin
  *
  * - `SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_NAME_STRING`: a name that can be
  *   displayed in debugging tools.
+ * - `SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER`: an
+ *   SDL_GPUShader of stage SDL_GPU_SHADERSTAGE_MESH that replaces the vertex
+ *   stage. `vertex_shader` must be NULL, and `vertex_input_state` and
+ *   `primitive_type` are ignored. Requires a device created with
+ *   `SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN`.
+ * - `SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_TASK_SHADER_POINTER`: an optional
+ *   SDL_GPUShader of stage SDL_GPU_SHADERSTAGE_TASK that runs before the
+ *   mesh shader.
+ *
+ * Task and mesh shaders share the vertex stage's resource bindings, so their
+ * resources are bound with the SDL_BindGPUVertex* functions and
+ * SDL_PushGPUVertexUniformData().
  *
  * \param device a GPU Context.
  * \param createinfo a struct describing the state of the graphics pipeline to
@@ -2328,7 +2602,116 @@ extern SDL_DECLSPEC SDL_GPUGraphicsPipeline * SDLCALL SDL_CreateGPUGraphicsPipel
     SDL_GPUDevice *device,
     const SDL_GPUGraphicsPipelineCreateInfo *createinfo);
 
-#define SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_NAME_STRING "SDL.gpu.graphicspipeline.create.name"
+#define SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_NAME_STRING        "SDL.gpu.graphicspipeline.create.name"
+#define SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER "SDL.gpu.graphicspipeline.create.meshshader"
+#define SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_TASK_SHADER_POINTER "SDL.gpu.graphicspipeline.create.taskshader"
+
+/**
+ * A callback used with SDL_CreateGPUGraphicsPipelineAsync().
+ *
+ * \param userdata the pointer passed to SDL_CreateGPUGraphicsPipelineAsync().
+ * \param pipeline the new graphics pipeline, or NULL on failure; call
+ *                 SDL_GetError() from the callback for more information.
+ *
+ * \threadsafety This callback is called from one of the device's pipeline
+ *               worker threads.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUGraphicsPipelineAsync
+ */
+typedef void (SDLCALL *SDL_GPUGraphicsPipelineCallback)(void *userdata, SDL_GPUGraphicsPipeline *pipeline);
+
+/**
+ * A callback used with SDL_CreateGPUComputePipelineAsync().
+ *
+ * \param userdata the pointer passed to SDL_CreateGPUComputePipelineAsync().
+ * \param pipeline the new compute pipeline, or NULL on failure; call
+ *                 SDL_GetError() from the callback for more information.
+ *
+ * \threadsafety This callback is called from one of the device's pipeline
+ *               worker threads.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUComputePipelineAsync
+ */
+typedef void (SDLCALL *SDL_GPUComputePipelineCallback)(void *userdata, SDL_GPUComputePipeline *pipeline);
+
+/**
+ * Creates a graphics pipeline on a background thread.
+ *
+ * The pipeline is created exactly as SDL_CreateGPUGraphicsPipeline() would,
+ * but the backend's shader compilation happens on one of the device's
+ * pipeline worker threads, so it can be done during a loading screen
+ * instead of causing a hitch at first use. When the pipeline is ready,
+ * `callback` is called on the worker thread with the result, and the
+ * pipeline belongs to the caller from then on.
+ *
+ * The create info, including its arrays and properties, is copied, so it
+ * does not need to outlive this call. The shaders it references must not be
+ * released until the callback has been called.
+ *
+ * \param device a GPU Context.
+ * \param createinfo a struct describing the state of the graphics pipeline to
+ *                   create.
+ * \param callback a function to call when the pipeline has been created.
+ * \param userdata a pointer to pass to the callback.
+ * \returns true if the request was queued or false on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUGraphicsPipeline
+ * \sa SDL_WaitForGPUPipelines
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CreateGPUGraphicsPipelineAsync(
+    SDL_GPUDevice *device,
+    const SDL_GPUGraphicsPipelineCreateInfo *createinfo,
+    SDL_GPUGraphicsPipelineCallback callback,
+    void *userdata);
+
+/**
+ * Creates a compute pipeline on a background thread.
+ *
+ * This is the compute counterpart of SDL_CreateGPUGraphicsPipelineAsync().
+ * The create info, including the shader code, entrypoint and properties, is
+ * copied, so it does not need to outlive this call.
+ *
+ * \param device a GPU Context.
+ * \param createinfo a struct describing the state of the compute pipeline to
+ *                   create.
+ * \param callback a function to call when the pipeline has been created.
+ * \param userdata a pointer to pass to the callback.
+ * \returns true if the request was queued or false on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUComputePipeline
+ * \sa SDL_WaitForGPUPipelines
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CreateGPUComputePipelineAsync(
+    SDL_GPUDevice *device,
+    const SDL_GPUComputePipelineCreateInfo *createinfo,
+    SDL_GPUComputePipelineCallback callback,
+    void *userdata);
+
+/**
+ * Blocks until every asynchronous pipeline request has completed.
+ *
+ * When this returns, the callbacks of all previously queued requests have
+ * returned.
+ *
+ * \param device a GPU Context.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUGraphicsPipelineAsync
+ * \sa SDL_CreateGPUComputePipelineAsync
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WaitForGPUPipelines(
+    SDL_GPUDevice *device);
 
 /**
  * Creates a sampler object to be used when binding textures in a graphics
@@ -2472,6 +2855,15 @@ extern SDL_DECLSPEC SDL_GPUShader * SDLCALL SDL_CreateGPUShader(
  *   clear the texture to a stencil of this Uint8 value. Defaults to zero.
  * - `SDL_PROP_GPU_TEXTURE_CREATE_NAME_STRING`: a name that can be displayed
  *   in debugging tools.
+ * - `SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN`: create the texture without
+ *   backing memory, except for its mip tail. Tiles are then made resident
+ *   with SDL_CommitGPUTextureTiles(). Check SDL_GPUTextureSupportsSparse()
+ *   first. Sparse textures are never cycled. Defaults to false.
+ * - `SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_MAX_TILES_NUMBER`: (Metal only) the
+ *   number of tiles reserved for a sparse texture when it is created, which
+ *   bounds how many tiles can be resident at once. Other backends allocate
+ *   tiles as they are committed. Defaults to enough tiles for the whole
+ *   texture.
  *
  * \param device a GPU Context.
  * \param createinfo a struct describing the state of the texture to create.
@@ -2502,6 +2894,8 @@ extern SDL_DECLSPEC SDL_GPUTexture * SDLCALL SDL_CreateGPUTexture(
 #define SDL_PROP_GPU_TEXTURE_CREATE_D3D12_CLEAR_DEPTH_FLOAT     "SDL.gpu.texture.create.d3d12.clear.depth"
 #define SDL_PROP_GPU_TEXTURE_CREATE_D3D12_CLEAR_STENCIL_NUMBER  "SDL.gpu.texture.create.d3d12.clear.stencil"
 #define SDL_PROP_GPU_TEXTURE_CREATE_NAME_STRING                 "SDL.gpu.texture.create.name"
+#define SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN              "SDL.gpu.texture.create.sparse"
+#define SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_MAX_TILES_NUMBER     "SDL.gpu.texture.create.sparse.maxtiles"
 
 /**
  * Creates a buffer object to be used in graphics or compute workflows.
@@ -2811,6 +3205,61 @@ extern SDL_DECLSPEC void SDLCALL SDL_ReleaseGPUGraphicsPipeline(
 extern SDL_DECLSPEC SDL_GPUCommandBuffer * SDLCALL SDL_AcquireGPUCommandBuffer(
     SDL_GPUDevice *device);
 
+/**
+ * Acquire a command buffer that is submitted to a specific queue.
+ *
+ * This behaves like SDL_AcquireGPUCommandBuffer(), except that the command
+ * buffer is submitted to the given queue. Copy passes on a transfer queue and
+ * compute passes on a compute queue can then overlap rendering on the
+ * graphics queue.
+ *
+ * If the device has no dedicated queue of the requested type, the command
+ * buffer is submitted to the graphics queue instead. The usage restrictions
+ * of the requested queue type still apply, so the same code runs correctly
+ * on devices with and without dedicated queues.
+ *
+ * Resources may be used on any queue, but nothing orders work on one queue
+ * against work on another. Submit the producing command buffer with
+ * SDL_SubmitGPUCommandBufferAndAcquireFence() and pass the fence to
+ * SDL_AddGPUCommandBufferWaitFence() on the consuming command buffer.
+ *
+ * \param device a GPU context.
+ * \param queue_type the queue the command buffer is submitted to.
+ * \returns a command buffer, or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUCommandBuffer
+ * \sa SDL_GPUSupportsDedicatedQueue
+ * \sa SDL_AddGPUCommandBufferWaitFence
+ */
+extern SDL_DECLSPEC SDL_GPUCommandBuffer * SDLCALL SDL_AcquireGPUCommandBufferForQueue(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type);
+
+/**
+ * Determines whether a device has a dedicated hardware queue of a given type.
+ *
+ * Command buffers for a queue type without a dedicated queue are submitted to
+ * the graphics queue, where they cannot overlap rendering.
+ *
+ * Dedicated compute and transfer queues are currently exposed by the Vulkan
+ * backend only, when the device is created with
+ * `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEDICATED_QUEUES_BOOLEAN`.
+ *
+ * \param device a GPU context.
+ * \param queue_type the queue type to check.
+ * \returns true if work for queue_type runs on its own hardware queue.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUCommandBufferForQueue
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GPUSupportsDedicatedQueue(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type);
+
 /* Uniform Data */
 
 /**
@@ -3261,6 +3710,145 @@ extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUIndexedPrimitivesIndirect(
     Uint32 offset,
     Uint32 draw_count);
 
+/**
+ * Determines whether a device can read indirect draw counts from a buffer.
+ *
+ * This is supported by the Vulkan backend when the device exposes
+ * VK_KHR_draw_indirect_count and multiDrawIndirect, and always by the D3D12
+ * backend. The Metal backend does not support it.
+ *
+ * \param device a GPU context.
+ * \returns true if SDL_DrawGPUPrimitivesIndirectCount() and
+ *          SDL_DrawGPUIndexedPrimitivesIndirectCount() are supported.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DrawGPUPrimitivesIndirectCount
+ * \sa SDL_DrawGPUIndexedPrimitivesIndirectCount
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GPUSupportsIndirectCount(
+    SDL_GPUDevice *device);
+
+/**
+ * Draws data using bound graphics state and with draw parameters and the
+ * draw count set from buffers.
+ *
+ * The buffer must consist of tightly-packed draw parameter sets that each
+ * match the layout of SDL_GPUIndirectDrawCommand. The number of draws is read
+ * as a Uint32 from count_buffer at count_offset when the command executes,
+ * and is clamped to max_draw_count. This lets a compute pass cull and compact
+ * draws without a round trip to the CPU.
+ *
+ * Both buffers must have been created with SDL_GPU_BUFFERUSAGE_INDIRECT, and
+ * both offsets must be multiples of 4. You must not call this function before
+ * binding a graphics pipeline, or if SDL_GPUSupportsIndirectCount() returns
+ * false.
+ *
+ * \param render_pass a render pass handle.
+ * \param buffer a buffer containing draw parameters.
+ * \param offset the offset to start reading from the draw buffer.
+ * \param count_buffer a buffer containing the draw count.
+ * \param count_offset the offset of the draw count in count_buffer.
+ * \param max_draw_count the maximum number of draw parameter sets that
+ *                       should be read from the draw buffer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GPUSupportsIndirectCount
+ * \sa SDL_DrawGPUPrimitivesIndirect
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUPrimitivesIndirectCount(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *count_buffer,
+    Uint32 count_offset,
+    Uint32 max_draw_count);
+
+/**
+ * Draws data using bound graphics state with an index buffer enabled and with
+ * draw parameters and the draw count set from buffers.
+ *
+ * The buffer must consist of tightly-packed draw parameter sets that each
+ * match the layout of SDL_GPUIndexedIndirectDrawCommand. The number of draws
+ * is read as a Uint32 from count_buffer at count_offset when the command
+ * executes, and is clamped to max_draw_count.
+ *
+ * Both buffers must have been created with SDL_GPU_BUFFERUSAGE_INDIRECT, and
+ * both offsets must be multiples of 4. You must not call this function before
+ * binding a graphics pipeline, or if SDL_GPUSupportsIndirectCount() returns
+ * false.
+ *
+ * \param render_pass a render pass handle.
+ * \param buffer a buffer containing draw parameters.
+ * \param offset the offset to start reading from the draw buffer.
+ * \param count_buffer a buffer containing the draw count.
+ * \param count_offset the offset of the draw count in count_buffer.
+ * \param max_draw_count the maximum number of draw parameter sets that
+ *                       should be read from the draw buffer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GPUSupportsIndirectCount
+ * \sa SDL_DrawGPUIndexedPrimitivesIndirect
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUIndexedPrimitivesIndirectCount(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *count_buffer,
+    Uint32 count_offset,
+    Uint32 max_draw_count);
+
+/**
+ * Draws data using a bound mesh pipeline.
+ *
+ * Launches groupcount_x * groupcount_y * groupcount_z workgroups of the task
+ * shader, or of the mesh shader when the pipeline has no task shader. You
+ * must not call this function before binding a graphics pipeline created
+ * with `SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER`.
+ *
+ * \param render_pass a render pass handle.
+ * \param groupcount_x number of workgroups to launch on the X dimension.
+ * \param groupcount_y number of workgroups to launch on the Y dimension.
+ * \param groupcount_z number of workgroups to launch on the Z dimension.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUGraphicsPipeline
+ * \sa SDL_DrawGPUMeshTasksIndirect
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUMeshTasks(
+    SDL_GPURenderPass *render_pass,
+    Uint32 groupcount_x,
+    Uint32 groupcount_y,
+    Uint32 groupcount_z);
+
+/**
+ * Draws data using a bound mesh pipeline with workgroup counts set from a
+ * buffer.
+ *
+ * The buffer must consist of tightly-packed workgroup counts that each match
+ * the layout of SDL_GPUIndirectDispatchCommand, must have been created with
+ * SDL_GPU_BUFFERUSAGE_INDIRECT, and offset must be a multiple of 4. You must
+ * not call this function before binding a mesh pipeline.
+ *
+ * \param render_pass a render pass handle.
+ * \param buffer a buffer containing workgroup counts.
+ * \param offset the offset to start reading from the buffer.
+ * \param draw_count the number of workgroup count sets that should be read
+ *                   from the buffer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DrawGPUMeshTasks
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUMeshTasksIndirect(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    Uint32 draw_count);
+
 /**
  * Ends the given render pass.
  *
@@ -3501,6 +4089,70 @@ extern SDL_DECLSPEC void SDLCALL SDL_UnmapGPUTransferBuffer(
     SDL_GPUDevice *device,
     SDL_GPUTransferBuffer *transfer_buffer);
 
+/* Transient Allocation */
+
+/**
+ * Allocates a region of a buffer that lives as long as a command buffer.
+ *
+ * Transient regions are sub-allocated from large buffers that the device
+ * keeps for this purpose. Once the command buffer is submitted and has
+ * completed, the region is recycled for later command buffers, so there is
+ * nothing to release. This is intended for vertex, index and indirect data
+ * that is regenerated every frame, without creating buffers or managing
+ * cycling by hand.
+ *
+ * The contents of the region are undefined. Upload to it in a copy pass on
+ * the same command buffer before using it, and do not cycle the buffer; the
+ * region shares its buffer with other transient regions. The offset is
+ * aligned to 16 bytes.
+ *
+ * \param command_buffer a command buffer.
+ * \param usage how the region will be used; only
+ *              SDL_GPU_BUFFERUSAGE_VERTEX, SDL_GPU_BUFFERUSAGE_INDEX and
+ *              SDL_GPU_BUFFERUSAGE_INDIRECT are allowed.
+ * \param size the size of the region in bytes.
+ * \param region filled with the buffer, offset and size of the region.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUTransientTransferBuffer
+ * \sa SDL_UploadToGPUBuffer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AcquireGPUTransientBuffer(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUBufferUsageFlags usage,
+    Uint32 size,
+    SDL_GPUBufferRegion *region);
+
+/**
+ * Allocates upload memory that lives as long as a command buffer.
+ *
+ * This works like SDL_AcquireGPUTransientBuffer() for upload transfer
+ * buffers. The returned memory is already mapped. Write to it, then use the
+ * location as the source of an upload on the same command buffer. The
+ * memory can be written until the command buffer is submitted. Do not map,
+ * unmap or cycle the transfer buffer. The offset is aligned to 16 bytes.
+ *
+ * \param command_buffer a command buffer.
+ * \param size the number of bytes to allocate.
+ * \param location filled with the transfer buffer and offset of the
+ *                 allocation.
+ * \returns the address of the allocated memory, or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUTransientBuffer
+ * \sa SDL_UploadToGPUBuffer
+ * \sa SDL_UploadToGPUTexture
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_AcquireGPUTransientTransferBuffer(
+    SDL_GPUCommandBuffer *command_buffer,
+    Uint32 size,
+    SDL_GPUTransferBufferLocation *location);
+
 /* Copy Pass */
 
 /**
@@ -3668,6 +4320,64 @@ extern SDL_DECLSPEC void SDLCALL SDL_GenerateMipmapsForGPUTexture(
     SDL_GPUCommandBuffer *command_buffer,
     SDL_GPUTexture *texture);
 
+/**
+ * Uploads a surface to a texture, converting it to the texture's format.
+ *
+ * The surface pixels are converted while they're written to upload memory
+ * allocated from the command buffer, as with
+ * SDL_AcquireGPUTransientTransferBuffer(), so there's no intermediate surface
+ * or transfer buffer to manage. Paletted, 24-bit and YUV surfaces are
+ * supported; YUV data with separate planes can be wrapped with
+ * SDL_CreateSurfaceFrom() as long as the planes are laid out one after the
+ * other.
+ *
+ * The texture must be one of the 8-bit RGBA or BGRA formats (including the
+ * sRGB variants), SDL_GPU_TEXTUREFORMAT_B5G6R5_UNORM,
+ * SDL_GPU_TEXTUREFORMAT_B5G5R5A1_UNORM, SDL_GPU_TEXTUREFORMAT_B4G4R4A4_UNORM,
+ * SDL_GPU_TEXTUREFORMAT_R10G10B10A2_UNORM,
+ * SDL_GPU_TEXTUREFORMAT_R16G16B16A16_UNORM,
+ * SDL_GPU_TEXTUREFORMAT_R16G16B16A16_FLOAT or
+ * SDL_GPU_TEXTUREFORMAT_R32G32B32A32_FLOAT.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_GPU_UPLOAD_SURFACE_PREMULTIPLY_ALPHA_BOOLEAN`: true to
+ *   premultiply the color channels by alpha while converting, defaults to
+ *   false.
+ * - `SDL_PROP_GPU_UPLOAD_SURFACE_GENERATE_MIPMAPS_BOOLEAN`: true to generate
+ *   the rest of the mip chain after uploading to mip level 0, defaults to
+ *   false. The texture needs the usage flags required by
+ *   SDL_GenerateMipmapsForGPUTexture().
+ * - `SDL_PROP_GPU_UPLOAD_SURFACE_CYCLE_BOOLEAN`: true to cycle the texture
+ *   if it's bound, defaults to false.
+ *
+ * This records its own copy pass, so it must not be called inside of any
+ * pass.
+ *
+ * \param command_buffer a command buffer.
+ * \param surface the surface to upload.
+ * \param destination the destination texture region, which must be the
+ *                    size of the surface.
+ * \param props the properties to use, or 0 for the defaults.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUTransientTransferBuffer
+ * \sa SDL_GenerateMipmapsForGPUTexture
+ * \sa SDL_UploadToGPUTexture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_UploadSurfaceToGPUTexture(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_Surface *surface,
+    const SDL_GPUTextureRegion *destination,
+    SDL_PropertiesID props);
+
+#define SDL_PROP_GPU_UPLOAD_SURFACE_PREMULTIPLY_ALPHA_BOOLEAN "SDL.gpu.upload_surface.premultiply_alpha"
+#define SDL_PROP_GPU_UPLOAD_SURFACE_GENERATE_MIPMAPS_BOOLEAN  "SDL.gpu.upload_surface.generate_mipmaps"
+#define SDL_PROP_GPU_UPLOAD_SURFACE_CYCLE_BOOLEAN             "SDL.gpu.upload_surface.cycle"
+
 /**
  * Blits from a source texture region to a destination texture region.
  *
@@ -3682,6 +4392,34 @@ extern SDL_DECLSPEC void SDLCALL SDL_BlitGPUTexture(
     SDL_GPUCommandBuffer *command_buffer,
     const SDL_GPUBlitInfo *info);
 
+/**
+ * Performs several blits in one call.
+ *
+ * This is equivalent to calling SDL_BlitGPUTexture for each element of
+ * `infos` in order, but consecutive blits that write to the same destination
+ * subresource are recorded into a single render pass on backends that
+ * implement blits with draws. A blit starts a new pass if its `load_op` is
+ * SDL_GPU_LOADOP_CLEAR or its `cycle` flag is set, so for best results only
+ * set these on the first blit to each destination.
+ *
+ * The destination regions of blits to the same subresource must not be read
+ * by later blits in the same call.
+ *
+ * This function must not be called inside of any pass.
+ *
+ * \param command_buffer a command buffer.
+ * \param infos an array of blit info structs containing the blit parameters.
+ * \param num_infos the number of elements in `infos`.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BlitGPUTexture
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_BlitGPUTextures(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUBlitInfo *infos,
+    Uint32 num_infos);
+
 /* Submission/Presentation */
 
 /**
@@ -3896,6 +4634,13 @@ extern SDL_DECLSPEC bool SDLCALL SDL_AcquireGPUSwapchainTexture(
 /**
  * Blocks the thread until a swapchain texture is available to be acquired.
  *
+ * Where the platform can report it, this also waits until fewer than the
+ * allowed number of frames in flight are still queued for presentation, so
+ * it returns when the display is ready for a new frame. Calling this right
+ * before polling input and recording a frame keeps input latency low. This
+ * uses the frame latency waitable object on Direct3D 12 and
+ * VK_KHR_present_wait on Vulkan, where supported.
+ *
  * \param device a GPU context.
  * \param window a window that has been claimed.
  * \returns true on success, false on failure; call SDL_GetError() for more
@@ -4014,6 +4759,32 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SubmitGPUCommandBuffer(
 extern SDL_DECLSPEC SDL_GPUFence * SDLCALL SDL_SubmitGPUCommandBufferAndAcquireFence(
     SDL_GPUCommandBuffer *command_buffer);
 
+/**
+ * Makes the GPU wait for a fence before it executes a command buffer.
+ *
+ * This orders work across queues without blocking the CPU. The fence must
+ * come from SDL_SubmitGPUCommandBufferAndAcquireFence(), and it must have been
+ * submitted before command_buffer is submitted. All writes made by the fenced
+ * command buffer are visible to command_buffer.
+ *
+ * Each fence can be waited on with this function by at most one command
+ * buffer. The fence must still be released with SDL_ReleaseGPUFence(); that
+ * may happen before command_buffer completes.
+ *
+ * \param command_buffer a command buffer.
+ * \param fence a fence from another submitted command buffer.
+ * \returns true on success, false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AcquireGPUCommandBufferForQueue
+ * \sa SDL_SubmitGPUCommandBufferAndAcquireFence
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AddGPUCommandBufferWaitFence(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUFence *fence);
+
 /**
  * Cancels a command buffer.
  *
@@ -4106,6 +4877,136 @@ extern SDL_DECLSPEC void SDLCALL SDL_ReleaseGPUFence(
     SDL_GPUDevice *device,
     SDL_GPUFence *fence);
 
+/* Queries */
+
+/**
+ * Creates a pool of GPU queries.
+ *
+ * Query pools are supported by the Vulkan and D3D12 backends.
+ *
+ * \param device a GPU context.
+ * \param type what the queries in the pool measure.
+ * \param num_queries the number of queries in the pool.
+ * \returns a query pool on success, or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_WriteGPUTimestamp
+ * \sa SDL_BeginGPUQuery
+ * \sa SDL_EndGPUQuery
+ * \sa SDL_GetGPUQueryResults
+ * \sa SDL_ReleaseGPUQueryPool
+ */
+extern SDL_DECLSPEC SDL_GPUQueryPool * SDLCALL SDL_CreateGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryType type,
+    Uint32 num_queries);
+
+/**
+ * Writes a GPU timestamp into a query.
+ *
+ * The timestamp is written once all previously recorded work in the command
+ * buffer has completed. This must not be called while a pass is in progress,
+ * so bracket the passes you want to measure with timestamps. Queries are
+ * only supported on graphics queue command buffers.
+ *
+ * \param command_buffer a command buffer.
+ * \param query_pool a query pool created with SDL_GPU_QUERYTYPE_TIMESTAMP.
+ * \param index the index of the query to write.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGPUQueryResults
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WriteGPUTimestamp(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index);
+
+/**
+ * Begins a pipeline statistics query.
+ *
+ * This must not be called while a pass is in progress; the query counts the
+ * work of all passes recorded until the matching SDL_EndGPUQuery() call.
+ * Queries are only supported on graphics queue command buffers.
+ *
+ * \param command_buffer a command buffer.
+ * \param query_pool a query pool created with
+ *                   SDL_GPU_QUERYTYPE_PIPELINE_STATISTICS.
+ * \param index the index of the query to begin.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndGPUQuery
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_BeginGPUQuery(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index);
+
+/**
+ * Ends a pipeline statistics query.
+ *
+ * \param command_buffer the command buffer SDL_BeginGPUQuery() was called
+ *                       with.
+ * \param query_pool the query pool SDL_BeginGPUQuery() was called with.
+ * \param index the index SDL_BeginGPUQuery() was called with.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BeginGPUQuery
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_EndGPUQuery(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index);
+
+/**
+ * Reads back the results of GPU queries.
+ *
+ * This does not wait for the GPU. Call it once the fence of the command
+ * buffer that wrote the queries has signaled, for example by polling
+ * SDL_QueryGPUFence() on later frames.
+ *
+ * For timestamp queries, `data` receives one Uint64 per query, in
+ * nanoseconds. For pipeline statistics queries, `data` receives one
+ * SDL_GPUPipelineStatistics per query.
+ *
+ * \param device a GPU context.
+ * \param query_pool a query pool.
+ * \param first_query the index of the first query to read.
+ * \param num_queries the number of queries to read.
+ * \param data a pointer filled in with the results.
+ * \returns true on success or false if the results aren't available yet or
+ *          on failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetGPUQueryResults(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 first_query,
+    Uint32 num_queries,
+    void *data);
+
+/**
+ * Frees the given query pool.
+ *
+ * This waits for the GPU to finish any work that may use the pool, so avoid
+ * calling it every frame.
+ *
+ * \param device a GPU context.
+ * \param query_pool a query pool to be destroyed.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ReleaseGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool);
+
 /* Format Info */
 
 /**
@@ -4154,6 +5055,92 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GPUTextureSupportsSampleCount(
     SDL_GPUTextureFormat format,
     SDL_GPUSampleCount sample_count);
 
+/**
+ * Determines whether a texture format can be used for sparse textures.
+ *
+ * Sparse textures must use a single sample and a color format. Vulkan needs
+ * sparse residency support on the graphics queue, D3D12 needs tiled
+ * resources (tier 3 for 3D textures), and Metal needs an Apple GPU family 6
+ * device.
+ *
+ * \param device a GPU context.
+ * \param format the texture format to check.
+ * \param type the type of texture (2D, 3D, Cube).
+ * \param usage a bitmask of all usage scenarios to check.
+ * \returns whether sparse textures of this format, type and usage can be
+ *          created.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateGPUTexture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GPUTextureSupportsSparse(
+    SDL_GPUDevice *device,
+    SDL_GPUTextureFormat format,
+    SDL_GPUTextureType type,
+    SDL_GPUTextureUsageFlags usage);
+
+/**
+ * Gets the tile layout of a sparse texture.
+ *
+ * Mip levels from num_tiled_levels onward are smaller than a tile and form
+ * the mip tail, which is always resident.
+ *
+ * \param device a GPU context.
+ * \param texture a texture created with
+ *                `SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN`.
+ * \param tile_width a pointer filled in with the tile width in texels, may
+ *                   be NULL.
+ * \param tile_height a pointer filled in with the tile height in texels, may
+ *                    be NULL.
+ * \param tile_depth a pointer filled in with the tile depth in texels, may
+ *                   be NULL.
+ * \param num_tiled_levels a pointer filled in with the number of mip levels
+ *                         that are split into tiles, may be NULL.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CommitGPUTextureTiles
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetGPUSparseTextureInfo(
+    SDL_GPUDevice *device,
+    SDL_GPUTexture *texture,
+    Uint32 *tile_width,
+    Uint32 *tile_height,
+    Uint32 *tile_depth,
+    Uint32 *num_tiled_levels);
+
+/**
+ * Makes the tiles of a sparse texture resident or non-resident.
+ *
+ * Every tile that overlaps the region is affected. Committed tiles have
+ * undefined contents until they are written. Reading a non-resident tile
+ * returns undefined values, and writes to it are discarded.
+ *
+ * The change is complete when this function returns, and applies to command
+ * buffers submitted afterwards. Tiles must not be decommitted while a
+ * submitted command buffer that uses them is still in flight. Regions in the
+ * mip tail are ignored, as it is always resident.
+ *
+ * \param device a GPU context.
+ * \param region the texture region to commit or decommit.
+ * \param commit true to make the tiles resident, false to release them.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetGPUSparseTextureInfo
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CommitGPUTextureTiles(
+    SDL_GPUDevice *device,
+    const SDL_GPUTextureRegion *region,
+    bool commit);
+
 /**
  * Calculate the size in bytes of a texture format with dimensions.
  *
@@ -4171,6 +5158,49 @@ extern SDL_DECLSPEC Uint32 SDLCALL SDL_CalculateGPUTextureFormatSize(
     Uint32 height,
     Uint32 depth_or_layer_count);
 
+/**
+ * Compress RGBA pixel data into a block-compressed texture format.
+ *
+ * This is a fast, real-time quality encoder intended for content that is
+ * generated or modified at runtime, such as render target readbacks or
+ * procedurally generated textures. Offline tools will produce higher quality
+ * results for static assets.
+ *
+ * The supported destination formats are SDL_GPU_TEXTUREFORMAT_BC1_RGBA_UNORM,
+ * SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM and their _SRGB variants. The source
+ * pixels are always 8 bits per channel in R, G, B, A byte order
+ * (SDL_PIXELFORMAT_RGBA32). Dimensions that are not a multiple of 4 are
+ * handled by repeating the edge pixels of partial blocks.
+ *
+ * The destination buffer must be at least
+ * `SDL_CalculateGPUTextureFormatSize(format, width, height, 1)` bytes.
+ *
+ * \param format the block-compressed format to encode to.
+ * \param width the width of the image in pixels.
+ * \param height the height of the image in pixels.
+ * \param src the source RGBA pixels.
+ * \param src_pitch the number of bytes between rows of source pixels.
+ * \param dst the buffer to write the compressed blocks to.
+ * \param dst_size the size of the destination buffer in bytes.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CalculateGPUTextureFormatSize
+ * \sa SDL_UploadToGPUTexture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_CompressGPUTextureData(
+    SDL_GPUTextureFormat format,
+    Uint32 width,
+    Uint32 height,
+    const void *src,
+    int src_pitch,
+    void *dst,
+    size_t dst_size);
+
 #ifdef SDL_PLATFORM_GDK
 
 /**
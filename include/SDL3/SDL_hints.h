@@ -212,6 +212,31 @@ extern "C" {
  */
 #define SDL_HINT_APPLE_TV_REMOTE_ALLOW_ROTATION "SDL_APPLE_TV_REMOTE_ALLOW_ROTATION"
 
+/**
+ * A variable controlling whether async i/o requests are submitted to the
+ * operating system in batches.
+ *
+ * Some async i/o backends (currently io_uring on Linux) can hand many
+ * requests to the kernel with a single system call. When batching is
+ * enabled, requests queued with SDL_ReadAsyncIO(), SDL_WriteAsyncIO(),
+ * etc. are held until SDL_GetAsyncIOResult() or SDL_WaitAsyncIOResult() is
+ * called on their queue, so an app that starts loading thousands of files
+ * at once pays for one submission instead of thousands. Requests don't start
+ * until the queue is checked for results, so apps that use this should poll
+ * their queue regularly.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Each request is submitted as soon as it is queued. (default)
+ * - "1": Requests are batched until the queue is checked for results.
+ *
+ * This hint should be set before an async i/o queue is created, and applies
+ * to queues created afterwards.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_ASYNCIO_DEFER_SUBMIT "SDL_ASYNCIO_DEFER_SUBMIT"
+
 /**
  * Specify the default ALSA audio device name.
  *
@@ -322,6 +347,32 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_APP_ICON_NAME "SDL_AUDIO_DEVICE_APP_ICON_NAME"
 
+/**
+ * A variable controlling whether bound audio streams are converted in
+ * parallel.
+ *
+ * When a playback device has many audio streams bound to it, each one has to
+ * be converted and resampled before it is mixed, and all of that normally
+ * happens on the device's thread. When this is enabled, devices with several
+ * bound streams hand that work to SDL's job threads (see SDL_SubmitJob()) and
+ * only do the final mix themselves. The streams are still mixed in the same
+ * order, so the output is identical either way.
+ *
+ * Audio stream callbacks will be called on the job threads while this is
+ * enabled, and they must not call functions that lock the audio device, such
+ * as binding or unbinding streams, or they will deadlock.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Bound streams are converted on the device thread. (default)
+ * - "1": Bound streams may be converted on the job threads.
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_DEVICE_PARALLEL_MIX "SDL_AUDIO_DEVICE_PARALLEL_MIX"
+
 /**
  * A variable controlling device buffer size.
  *
@@ -522,6 +573,29 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_INCLUDE_MONITORS "SDL_AUDIO_INCLUDE_MONITORS"
 
+/**
+ * A variable controlling whether the PipeWire audio driver runs in low
+ * latency mode.
+ *
+ * In low latency mode the stream asks PipeWire for the smallest quantum it
+ * allows (unless SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES is set), only mixes as
+ * many sample frames as the graph wants each cycle, and runs the device
+ * thread work inside PipeWire's realtime data loop. That means audio stream
+ * callbacks and postmix callbacks run on a realtime thread, so they must not
+ * block, allocate memory or do file I/O, and the app should avoid holding
+ * audio streams locked for long.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use the normal PipeWire buffering. (default)
+ * - "1": Use low latency mode.
+ *
+ * This hint should be set before an audio device is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_AUDIO_PIPEWIRE_LOW_LATENCY "SDL_AUDIO_PIPEWIRE_LOW_LATENCY"
+
 /**
  * A variable controlling whether SDL updates joystick state when getting
  * input events.
@@ -591,6 +665,86 @@ extern "C" {
  */
 #define SDL_HINT_CAMERA_DRIVER "SDL_CAMERA_DRIVER"
 
+/**
+ * A variable controlling whether cameras convert frames on the CPU.
+ *
+ * When the format or size requested with SDL_OpenCamera() differs from what
+ * the camera produces, SDL normally converts and scales each frame on the
+ * camera thread. Applications that draw frames with the renderer or SDL_GPU
+ * can skip that work and let the GPU convert the raw YUV or RGB data, for
+ * example by uploading frames to a streaming texture in the camera's format.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Frames are converted to the requested format and size. (default)
+ * - "1": Frames are delivered in the format and size that the camera
+ *   produces, and SDL_GetCameraFormat() reports that format, colorspace and
+ *   size. Cameras that produce MJPG are still decoded to the requested
+ *   format, since that isn't a texture format.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_CAMERA_DEFER_CONVERSION "SDL_CAMERA_DEFER_CONVERSION"
+
+/**
+ * A variable controlling whether cameras should minimize capture latency.
+ *
+ * This is useful for things like AR tracking, where a recent frame is worth
+ * more than a smooth stream of frames. When enabled, SDL asks the camera
+ * driver to keep as few frames in flight as it can, backends skip ahead to
+ * the newest frame available, and SDL_HINT_CAMERA_FRAME_DROP_POLICY defaults
+ * to "oldest".
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Cameras buffer frames normally. (default)
+ * - "1": Cameras minimize latency, possibly dropping frames.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_CAMERA_LOW_LATENCY "SDL_CAMERA_LOW_LATENCY"
+
+/**
+ * A variable controlling what a camera does with new frames when the app
+ * hasn't claimed the ones already waiting.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "newest": The new frame is dropped, so the app sees a gap after the
+ *   frames it was already behind on. (default, unless
+ *   SDL_HINT_CAMERA_LOW_LATENCY is enabled)
+ * - "oldest": The oldest frame that the app hasn't acquired yet is dropped
+ *   to make room, so the app always gets the most recent frames.
+ *
+ * Dropped frames are counted in SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_CAMERA_FRAME_DROP_POLICY "SDL_CAMERA_FRAME_DROP_POLICY"
+
+/**
+ * A variable controlling how many frames a camera can buffer for the app.
+ *
+ * SDL allocates this many frame surfaces when a camera is opened, and they
+ * are shared between frames waiting to be acquired and frames the app is
+ * holding. More frames smooth over an app that is occasionally slow to
+ * release them, at the cost of memory and, with SDL_HINT_CAMERA_FRAME_DROP_POLICY
+ * set to "newest", latency.
+ *
+ * The value can be between 1 and 32, and defaults to 8.
+ *
+ * This hint should be set before a camera is opened.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_CAMERA_FRAME_POOL_SIZE "SDL_CAMERA_FRAME_POOL_SIZE"
+
 /**
  * A variable that limits what CPU features are available.
  *
@@ -612,9 +766,12 @@ extern "C" {
  * - "sse42"
  * - "avx"
  * - "avx2"
+ * - "fma" (since SDL 3.4.0)
+ * - "pclmul" (since SDL 3.4.0)
  * - "avx512f"
  * - "arm-simd"
  * - "neon"
+ * - "arm-crc32" (since SDL 3.4.0)
  * - "lsx"
  * - "lasx"
  *
@@ -624,6 +781,35 @@ extern "C" {
  */
 #define SDL_HINT_CPU_FEATURE_MASK "SDL_CPU_FEATURE_MASK"
 
+/**
+ * A variable controlling whether slow device probes are moved off the
+ * thread that initializes SDL.
+ *
+ * Initializing the audio and joystick subsystems enumerates devices, and on
+ * Linux SDL connects to D-Bus, which can add noticeable time before the
+ * first frame. With this hint enabled these probes run on background
+ * threads instead, so the app can put up a loading screen right away:
+ *
+ * - Audio device enumeration. Functions that need the device list, like
+ *   SDL_GetAudioPlaybackDevices() and SDL_OpenAudioDevice(), wait for it to
+ *   finish.
+ * - The HIDAPI controller scan. Controllers that are found are reported
+ *   with SDL_EVENT_JOYSTICK_ADDED events, just like hotplugged ones.
+ * - Connecting to D-Bus. Anything that needs D-Bus waits for it.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Probe for devices while initializing. (default)
+ * - "1": Probe for devices on background threads.
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSubSystemInitTimeNS
+ */
+#define SDL_HINT_DEFERRED_INIT "SDL_DEFERRED_INIT"
+
 /**
  * A variable controlling whether DirectInput should be used for controllers.
  *
@@ -774,6 +960,47 @@ extern "C" {
  */
 #define SDL_HINT_EVDEV_DEVICES "SDL_EVDEV_DEVICES"
 
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * High rate mice, pens and touchscreens can deliver hundreds of motion events
+ * per frame. When this is enabled, a mouse, pen or finger motion event that
+ * would be queued directly behind another motion event of the same type for
+ * the same device, window and button or pen state is merged into it instead:
+ * the queued event takes the newer position and timestamp and accumulates the
+ * relative motion. Every merged sample stays available, oldest first, in the
+ * event's `history` array (see SDL_MotionSample).
+ *
+ * Event watchers and the event filter still see every sample individually.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Queue every motion event separately. (default)
+ * - "1": Merge consecutive motion events.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
+/**
+ * A variable controlling whether SDL measures how long events take to reach
+ * and leave the event queue.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Don't collect event latency statistics. (default)
+ * - "1": Collect statistics, available through SDL_GetEventLatencyStats().
+ *
+ * Only events queued while this is enabled are measured. This hint can be
+ * set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_LATENCY_STATS "SDL_EVENT_LATENCY_STATS"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -839,6 +1066,77 @@ extern "C" {
  */
 #define SDL_HINT_FRAMEBUFFER_ACCELERATION "SDL_FRAMEBUFFER_ACCELERATION"
 
+/**
+ * A variable controlling the precision of the SDL screen surface.
+ *
+ * Higher precision surfaces let applications that composite in HDR write
+ * their output directly, without converting down to 8 bits per channel
+ * first. They are presented through a 3D accelerated renderer with linear
+ * output, so values beyond the SDR range are shown on HDR displays where the
+ * platform supports it.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "8bit": The surface uses an 8 bits per channel format. (default)
+ * - "10bit": The surface uses a 10 bits per channel format, such as
+ *   SDL_PIXELFORMAT_XRGB2101010, in the SDL_COLORSPACE_HDR10 colorspace.
+ * - "float": The surface uses a floating point format, such as
+ *   SDL_PIXELFORMAT_RGBA64_FLOAT, in the SDL_COLORSPACE_SRGB_LINEAR
+ *   colorspace.
+ *
+ * If the renderer doesn't support the requested format, the surface falls
+ * back to 8 bits per channel, so check the format of the surface returned by
+ * SDL_GetWindowSurface(). Setting this to anything other than "8bit"
+ * implies SDL_HINT_FRAMEBUFFER_ACCELERATION, unless that is set explicitly.
+ *
+ * This hint should be set before calling SDL_GetWindowSurface()
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_FRAMEBUFFER_PRECISION "SDL_FRAMEBUFFER_PRECISION"
+
+/**
+ * A variable controlling how much larger than the window the SDL screen
+ * surface's memory is allocated after a resize.
+ *
+ * When the window is resized, its surface normally has to be reallocated, and
+ * the platform resources behind it with it. With this set, the memory is
+ * rounded up to the next multiple of this many pixels in each direction, and
+ * later sizes that still fit reuse it, with the surface covering just the
+ * window's part of it. This avoids reallocating for every step of an
+ * interactive resize. The window's first surface is always allocated at its
+ * exact size.
+ *
+ * This is only supported by the windows and x11 video drivers and by
+ * accelerated framebuffers, see SDL_HINT_FRAMEBUFFER_ACCELERATION. The
+ * variable is a number of pixels, "0" disables it. The default is "256".
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_FRAMEBUFFER_RESIZE_BUCKET "SDL_FRAMEBUFFER_RESIZE_BUCKET"
+
+/**
+ * A variable controlling whether reallocating the SDL screen surface for a
+ * resize is limited to once per frame.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every SDL_GetWindowSurface() call after the window is resized
+ *   returns a surface of the new size. (default)
+ * - "1": Once the surface has been reallocated for a resize, further resizes
+ *   are picked up after the next SDL_UpdateWindowSurface() or
+ *   SDL_UpdateWindowSurfaceRects() call. Until then SDL_GetWindowSurface()
+ *   keeps returning the current surface, which may be a frame behind the
+ *   window's size.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_FRAMEBUFFER_RESIZE_COALESCE "SDL_FRAMEBUFFER_RESIZE_COALESCE"
+
 /**
  * A variable that lets you manually hint extra gamecontroller db entries.
  *
@@ -1083,6 +1381,27 @@ extern "C" {
  */
 #define SDL_HINT_GPU_DRIVER "SDL_GPU_DRIVER"
 
+/**
+ * A variable setting a frame rate limit for GPU swapchain presentation, in
+ * frames per second.
+ *
+ * When set to a positive number, SDL_AcquireGPUSwapchainTexture() and
+ * SDL_WaitAndAcquireGPUSwapchainTexture() sleep as needed so that swapchain
+ * textures are acquired no faster than this rate. The limit applies to each
+ * GPU device as a whole, not to each window.
+ *
+ * This is mostly useful with variable refresh rate displays, where keeping
+ * the frame rate just below the display's maximum refresh rate avoids both
+ * tearing and the added latency of waiting on vsync.
+ *
+ * The default is "0", which disables the limit.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_GPU_FRAME_RATE_LIMIT "SDL_GPU_FRAME_RATE_LIMIT"
+
 /**
  * A variable to control whether SDL_hid_enumerate() enumerates all HID
  * devices or only controllers.
@@ -1774,6 +2093,27 @@ extern "C" {
  */
 #define SDL_HINT_JOYSTICK_HIDAPI_SWITCH_PLAYER_LED "SDL_JOYSTICK_HIDAPI_SWITCH_PLAYER_LED"
 
+/**
+ * A variable controlling whether HIDAPI devices get their own threads for
+ * reading input reports.
+ *
+ * With this enabled, each device's input is read on a separate thread as it
+ * arrives and queued, so SDL_UpdateJoysticks() only has to process the
+ * reports that are waiting instead of going to the operating system for
+ * each one, and reports aren't left sitting in the OS queue while the app is
+ * busy. This costs a thread per controller.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Input reports are read when joysticks are updated. (default)
+ * - "1": Each HIDAPI device reads input reports on its own thread.
+ *
+ * This hint should be set before opening a controller.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_JOYSTICK_HIDAPI_THREADS "SDL_JOYSTICK_HIDAPI_THREADS"
+
 /**
  * A variable controlling whether Nintendo Switch Joy-Con controllers will be
  * in vertical mode when using the HIDAPI driver.
@@ -2120,6 +2460,32 @@ extern "C" {
  */
 #define SDL_HINT_JOYSTICK_THROTTLE_DEVICES_EXCLUDED "SDL_JOYSTICK_THROTTLE_DEVICES_EXCLUDED"
 
+/**
+ * A variable controlling whether joysticks are updated from a background
+ * thread, and how often.
+ *
+ * By default joystick state is updated when events are pumped, so it is only
+ * as fresh as the application's event loop. If this is set to a positive
+ * number, SDL will start a thread that updates joysticks that many times per
+ * second, so functions like SDL_GetGamepadAxis() see new input without
+ * waiting for the next call to SDL_PumpEvents(). Joystick events are still
+ * delivered through the event queue.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Joysticks are updated when events are pumped. (default)
+ * - A positive number: Joysticks are updated this many times per second from
+ *   a background thread, up to 8000.
+ *
+ * This hint is ignored on Apple platforms, Android, and Emscripten, where
+ * joystick drivers must be updated on the main thread.
+ *
+ * This hint should be set before the joystick subsystem is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_JOYSTICK_UPDATE_THREAD_RATE "SDL_JOYSTICK_UPDATE_THREAD_RATE"
+
 /**
  * A variable controlling whether Windows.Gaming.Input should be used for
  * controller handling.
@@ -2247,6 +2613,25 @@ extern "C" {
  */
 #define SDL_HINT_KEYCODE_OPTIONS "SDL_KEYCODE_OPTIONS"
 
+/**
+ * A variable controlling whether the KMSDRM backend uses atomic modesetting.
+ *
+ * With atomic modesetting, frames are presented with non-blocking atomic
+ * commits on the display's primary plane, and SDL only waits for the
+ * previous frame to reach the screen right before committing the next one,
+ * so the GPU can render into a third buffer while a flip is pending.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": SDL uses legacy modesetting and page flips. (default)
+ * - "1": SDL uses atomic modesetting if the driver supports it.
+ *
+ * This hint should be set before creating a window.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_KMSDRM_ATOMIC "SDL_KMSDRM_ATOMIC"
+
 /**
  * A variable that controls what KMSDRM device to use.
  *
@@ -2315,6 +2700,30 @@ extern "C" {
  */
 #define SDL_HINT_LOGGING "SDL_LOGGING"
 
+/**
+ * A variable controlling whether log messages are written out on a
+ * background thread.
+ *
+ * When this is enabled, SDL_LogMessageV() formats the message into a
+ * lock-free queue and returns, and a background thread passes it to the log
+ * output function. This keeps logging from threads like the audio thread
+ * from blocking on console or debugger output. Messages longer than 511
+ * bytes are truncated, and when the queue is full messages are dropped and a
+ * warning with the number of dropped messages is logged later. Messages still
+ * in the queue are lost if the program crashes.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Log messages are written out on the thread that logs them.
+ *   (default)
+ * - "1": Log messages are written out on a background thread.
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_LOGGING_ASYNC "SDL_LOGGING_ASYNC"
+
 /**
  * A variable controlling whether to force the application to become the
  * foreground process when launched on macOS.
@@ -2664,6 +3073,23 @@ extern "C" {
  */
 #define SDL_HINT_MUTE_CONSOLE_KEYBOARD "SDL_MUTE_CONSOLE_KEYBOARD"
 
+/**
+ * A variable controlling whether SDL records lock contention for named
+ * mutexes.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Don't record contention. (default)
+ * - "1": Record how often named mutexes are contended and how long threads
+ *   wait for them, available through SDL_GetMutexContentionStats().
+ *
+ * This hint is checked when each mutex is created, so it should be set
+ * before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_MUTEX_PROFILING "SDL_MUTEX_PROFILING"
+
 /**
  * Tell SDL not to catch the SIGINT or SIGTERM signals on POSIX platforms.
  *
@@ -2873,6 +3299,27 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_VULKAN_DEBUG "SDL_RENDER_VULKAN_DEBUG"
 
+/**
+ * A variable controlling whether the Vulkan renderer creates the pipelines
+ * for common draw states when it is created.
+ *
+ * Otherwise each pipeline is created the first time its combination of
+ * shader, blend mode and primitive type is drawn, which can cause a hitch in
+ * the middle of a frame.
+ *
+ * This variable can be set to the following values:
+ *
+ * - "0": Create pipelines when they are first used. (default)
+ * - "1": Create the common pipelines while creating the renderer.
+ * - "thread": Compile the common pipelines on a background thread, so the
+ *   driver has them cached when they are first used.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_VULKAN_PIPELINE_WARMUP "SDL_RENDER_VULKAN_PIPELINE_WARMUP"
+
 /**
  * A variable controlling whether to create the GPU device in debug mode.
  *
@@ -2968,6 +3415,51 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling whether the renderer may reorder draws to batch
+ * them.
+ *
+ * When enabled, geometry draws (including SDL_RenderTexture() and
+ * SDL_RenderFillRect() on most render drivers) that don't overlap each
+ * other may be moved next to earlier draws with the same texture, blend
+ * mode, scale mode and texture address mode, so the render driver can
+ * combine them into a single draw call. Draws that overlap are never
+ * reordered relative to each other, so the rendered result is the same.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Draws are submitted in the order they were made. (default)
+ * - "1": Independent draws may be reordered to reduce draw calls.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_REORDER_DRAWS "SDL_RENDER_REORDER_DRAWS"
+
+/**
+ * A variable controlling whether the software renderer draws in parallel.
+ *
+ * When enabled, the software renderer splits its target into bands of rows
+ * and renders each band on one of SDL's job threads, see SDL_SubmitJob().
+ * Draws are kept in order within each band, so the rendered result is the
+ * same. Draws that can't be split exactly, like rotated textures, are run
+ * on the rendering thread once the draws before them have finished. This
+ * can make rendering to large targets much faster on machines with several
+ * cores. Small and palettized targets are always rendered on the rendering
+ * thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Draws are rendered on the rendering thread. (default)
+ * - "1": Draws are split across the job threads.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_TILED "SDL_RENDER_SOFTWARE_TILED"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -3122,6 +3614,54 @@ extern "C" {
  */
 #define SDL_HINT_STORAGE_USER_DRIVER "SDL_STORAGE_USER_DRIVER"
 
+/**
+ * A variable controlling whether large software surface blits are split up
+ * and run on multiple threads.
+ *
+ * When enabled, unscaled blits covering a large enough area are divided into
+ * bands of rows that are blitted in parallel on SDL's job threads, see
+ * SDL_SubmitJob(). This can make compositing very large surfaces much faster
+ * on machines with several cores, at the cost of keeping those cores busy.
+ * Small blits, scaled blits, and blits to palettized surfaces always run on
+ * the calling thread. Large conversions between YUV and RGB formats in
+ * SDL_ConvertPixelsAndColorspace() are split up the same way, as is decoding
+ * large MJPG images that contain restart markers. Very large fills with
+ * SDL_FillSurfaceRects(), including the ones done by SDL_ClearSurface() and
+ * the software renderer, are split up as well.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Blits and conversions are always done on the calling thread.
+ *   (default)
+ * - "1": Large blits and conversions are split across the job threads.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_PARALLEL_BLIT "SDL_SURFACE_PARALLEL_BLIT"
+
+/**
+ * A variable controlling whether surface pixels are allocated from a pool.
+ *
+ * When enabled, SDL_CreateSurface() takes pixel memory from a pool of
+ * buffers bucketed by size, and SDL_DestroySurface() returns it there, with
+ * a small cache of recently freed buffers on each thread. This avoids
+ * allocating and freeing memory for the intermediate surfaces created by
+ * conversion and scaling, at the cost of keeping some freed memory around,
+ * see SDL_GetSurfacePoolStats(). The memory is released by SDL_Quit().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Surface pixels are allocated and freed directly. (default)
+ * - "1": Surface pixels are allocated from the pool.
+ *
+ * This hint can be set anytime, and affects surfaces created afterwards.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_SURFACE_POOL "SDL_SURFACE_POOL"
+
 /**
  * Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as
  * realtime.
@@ -3194,6 +3734,24 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ * A variable controlling whether SDL_EVENT_FINGER_FRAME events are sent.
+ *
+ * When enabled, SDL sends one SDL_EVENT_FINGER_FRAME event per touch device
+ * each time events are pumped, carrying all of the device's active fingers,
+ * if any of them went down, moved, or was lifted.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Touch frame events are not sent. (default)
+ * - "1": Touch frame events are sent.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_TOUCH_FRAME_EVENTS "SDL_TOUCH_FRAME_EVENTS"
+
 /**
  * A variable controlling whether touch events should generate synthetic mouse
  * events.
@@ -3484,6 +4042,28 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_WAYLAND_ALLOW_LIBDECOR "SDL_VIDEO_WAYLAND_ALLOW_LIBDECOR"
 
+/**
+ * A variable controlling whether a background thread reads Wayland input.
+ *
+ * Normally the Wayland connection is only read when the app pumps events,
+ * so a slow frame delays input and lets high rate relative pointer motion
+ * back up in the connection. When this is enabled, a dedicated thread keeps
+ * reading the connection and delivers relative pointer motion to the event
+ * queue as it arrives, with the compositor's timestamps. Everything else,
+ * including all window management, is still dispatched on the main thread
+ * when events are pumped.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Wayland input is read when events are pumped. (default)
+ * - "1": A background thread reads Wayland input.
+ *
+ * This hint should be set before SDL is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_WAYLAND_INPUT_THREAD "SDL_VIDEO_WAYLAND_INPUT_THREAD"
+
 /**
  * A variable controlling whether video mode emulation is enabled under
  * Wayland.
@@ -3623,6 +4203,27 @@ extern "C" {
  */
 #define SDL_HINT_VIDEO_X11_EXTERNAL_WINDOW_INPUT "SDL_VIDEO_X11_EXTERNAL_WINDOW_INPUT"
 
+/**
+ * A variable controlling whether X11 window surfaces are presented
+ * asynchronously.
+ *
+ * By default SDL_UpdateWindowSurface() waits for the X server to finish
+ * drawing before returning. When this is enabled, window surfaces are
+ * double-buffered in MIT-SHM segments and each update returns as soon as its
+ * request is sent; SDL only waits if the server still hasn't finished with
+ * both segments. This only has an effect on local X servers with MIT-SHM.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Window surface updates wait for the X server. (default)
+ * - "1": Window surface updates are pipelined with the X server.
+ *
+ * This hint should be set before calling SDL_GetWindowSurface().
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_VIDEO_X11_FRAMEBUFFER_ASYNC "SDL_VIDEO_X11_FRAMEBUFFER_ASYNC"
+
 /**
  * A variable controlling whether the X11 _NET_WM_BYPASS_COMPOSITOR hint
  * should be used.
@@ -4055,6 +4656,27 @@ extern "C" {
  */
 #define SDL_HINT_WINDOWS_ENABLE_MESSAGELOOP "SDL_WINDOWS_ENABLE_MESSAGELOOP"
 
+/**
+ * A variable controlling whether window surfaces on Windows are presented
+ * with a DXGI flip-model swapchain instead of GDI.
+ *
+ * The flip-model path uploads only the rectangles passed to
+ * SDL_UpdateWindowSurfaceRects() and presents them as dirty rectangles,
+ * which avoids DWM redirection and is much cheaper than BitBlt() on large
+ * high-DPI windows. If Direct3D 11 isn't available, SDL falls back to GDI.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Window surfaces are presented with GDI. (default)
+ * - "1": Window surfaces are presented with a DXGI flip-model swapchain, if
+ *   available.
+ *
+ * This hint should be set before calling SDL_GetWindowSurface().
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_WINDOWS_FRAMEBUFFER_FLIP_MODEL "SDL_WINDOWS_FRAMEBUFFER_FLIP_MODEL"
+
 /**
  * A variable controlling whether GameInput is used for raw keyboard and mouse
  * on Windows.
@@ -4257,6 +4879,24 @@ extern "C" {
  */
 #define SDL_HINT_ASSERT "SDL_ASSERT"
 
+/**
+ * A variable controlling whether SDL_EVENT_PEN_FRAME events are sent.
+ *
+ * When enabled, SDL sends one SDL_EVENT_PEN_FRAME event per pen each time
+ * events are pumped, carrying the pen's position and all of its axes, if any
+ * of them changed.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Pen frame events are not sent. (default)
+ * - "1": Pen frame events are sent.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_PEN_FRAME_EVENTS "SDL_PEN_FRAME_EVENTS"
+
 /**
  * A variable controlling whether pen events should generate synthetic mouse
  * events.
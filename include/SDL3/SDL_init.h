@@ -281,6 +281,29 @@ extern SDL_DECLSPEC void SDLCALL SDL_QuitSubSystem(SDL_InitFlags flags);
  */
 extern SDL_DECLSPEC SDL_InitFlags SDLCALL SDL_WasInit(SDL_InitFlags flags);
 
+/**
+ * Get how long SDL took to initialize the specified subsystems.
+ *
+ * This is the time SDL_Init() or SDL_InitSubSystem() spent initializing each
+ * subsystem the last time it was initialized, which helps find out what
+ * slows down app startup. A subsystem that is initialized as a dependency of
+ * another, like events for video, is counted on its own and not as part of
+ * the one that needed it. Probes that were moved to background threads with
+ * SDL_HINT_DEFERRED_INIT are not included.
+ *
+ * \param flags any of the flags used by SDL_Init(); see SDL_Init for details.
+ * \returns the total time in nanoseconds spent initializing the specified
+ *          subsystems, or 0 if none of them have been initialized.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_Init
+ * \sa SDL_InitSubSystem
+ */
+extern SDL_DECLSPEC Uint64 SDLCALL SDL_GetSubSystemInitTimeNS(SDL_InitFlags flags);
+
 /**
  * Clean up all initialized subsystems.
  *
@@ -254,6 +254,17 @@ typedef struct SDL_IOStream SDL_IOStream;
  *   the filesystem. If SDL used some other method to access the filesystem,
  *   this property will not be set.
  *
+ * The following properties can be set by the app after the stream is
+ * created, but before the first read, write or seek:
+ *
+ * - `SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER`: the size in bytes of the
+ *   user-space buffer used for read-ahead and for coalescing small writes, or
+ *   0 to disable buffering. Seeking correctly accounts for and invalidates
+ *   buffered data. Files opened with the C runtime use its buffering
+ *   (setvbuf()), Win32 handles use this as the read-ahead size (1024 bytes by
+ *   default), and file descriptors are unbuffered unless this is set. Only
+ *   regular files are buffered.
+ *
  * \param file a UTF-8 string representing the filename to open.
  * \param mode an ASCII string representing the mode to be used for opening
  *             the file.
@@ -277,6 +288,7 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromFile(const char *file, cons
 #define SDL_PROP_IOSTREAM_STDIO_FILE_POINTER        "SDL.iostream.stdio.file"
 #define SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER    "SDL.iostream.file_descriptor"
 #define SDL_PROP_IOSTREAM_ANDROID_AASSET_POINTER    "SDL.iostream.android.aasset"
+#define SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER        "SDL.iostream.buffer_size"
 
 /**
  * Use this function to prepare a read-write memory buffer for use with
@@ -363,6 +375,45 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMem(void *mem, size_t size)
  */
 extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromConstMem(const void *mem, size_t size);
 
+/**
+ * Use this function to create a read-only SDL_IOStream that maps a file into
+ * memory.
+ *
+ * On platforms that support it, the file is memory-mapped (mmap() on POSIX,
+ * CreateFileMapping() on Windows) instead of being read, so opening even a
+ * very large file is cheap and pages are only loaded as they are used. Files
+ * that can't be mapped, such as empty files, pipes or Android assets, are
+ * loaded into memory with SDL_LoadFile() instead, so this function works
+ * everywhere SDL_IOFromFile() does.
+ *
+ * The contents of the file are directly accessible through the stream's
+ * properties, allowing callers to parse the data in place without copying
+ * it. The memory stays valid until the stream is closed, and must not be
+ * written to. Writing to this SDL_IOStream will report an error.
+ *
+ * The following properties will be set at creation time by SDL:
+ *
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: a pointer to the contents of the
+ *   file.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: the size of the file, in bytes.
+ *
+ * \param file a UTF-8 string representing the filename to open.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_IOFromFile
+ * \sa SDL_IOFromConstMem
+ * \sa SDL_CloseIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_TellIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromMappedFile(const char *file);
+
 /**
  * Use this function to create an SDL_IOStream that is backed by dynamically
  * allocated memory.
@@ -377,6 +428,18 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromConstMem(const void *mem, s
  *   SDL_CloseIO().
  * - `SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER`: memory will be allocated in
  *   multiples of this size, defaulting to 1024.
+ * - `SDL_PROP_IOSTREAM_DYNAMIC_RESERVE_NUMBER` (since SDL 3.4.0): the
+ *   smallest number of bytes to allocate when the stream needs memory. Set
+ *   this before writing to a stream whose final size is roughly known, so
+ *   it's allocated once.
+ * - `SDL_PROP_IOSTREAM_DYNAMIC_GROWTH_FLOAT` (since SDL 3.4.0): when the
+ *   stream runs out of memory, it grows to at least this many times its
+ *   current size, so writing a large stream doesn't copy it over and over.
+ *   This defaults to 1.5, and values of 1.0 or less grow the stream by only
+ *   as many chunks as the write needs.
+ *
+ * SDL_DetachDynamicMemIO() is a simpler way to take the memory from the
+ * stream.
  *
  * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
  *          SDL_GetError() for more information.
@@ -386,6 +449,7 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromConstMem(const void *mem, s
  * \since This function is available since SDL 3.2.0.
  *
  * \sa SDL_CloseIO
+ * \sa SDL_DetachDynamicMemIO
  * \sa SDL_ReadIO
  * \sa SDL_SeekIO
  * \sa SDL_TellIO
@@ -395,6 +459,70 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromDynamicMem(void);
 
 #define SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER    "SDL.iostream.dynamic.memory"
 #define SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER  "SDL.iostream.dynamic.chunksize"
+#define SDL_PROP_IOSTREAM_DYNAMIC_RESERVE_NUMBER    "SDL.iostream.dynamic.reserve"
+#define SDL_PROP_IOSTREAM_DYNAMIC_GROWTH_FLOAT      "SDL.iostream.dynamic.growth"
+
+/**
+ * Take the memory written to a stream from SDL_IOFromDynamicMem().
+ *
+ * This hands over the stream's memory as it is, without copying it. The data
+ * is followed by a null terminator that isn't counted in its size, so text
+ * can be used as a string directly.
+ *
+ * The stream is left empty and can still be used; writing to it again
+ * allocates new memory.
+ *
+ * \param context a stream created by SDL_IOFromDynamicMem().
+ * \param datasize a pointer filled in with the number of bytes of data, may
+ *                 be NULL.
+ * \returns the data, which the caller should free with SDL_free(), or NULL on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety Do not use the same SDL_IOStream from two threads at once.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_IOFromDynamicMem
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_DetachDynamicMemIO(SDL_IOStream *context, size_t *datasize);
+
+/**
+ * Use this function to create a read-only SDL_IOStream that decompresses LZ4
+ * frames from another stream.
+ *
+ * This lets compressed assets be read directly by anything that takes an
+ * SDL_IOStream, like SDL_LoadBMP_IO() or SDL_LoadWAV_IO(), without
+ * decompressing the whole file up front. Concatenated frames are read as one
+ * stream, and skippable frames are skipped. Frames that need a dictionary
+ * aren't supported, and checksums in the frames aren't verified.
+ *
+ * Opening the stream reads the frame and block headers to build an index of
+ * the compressed blocks, so seeking only decodes the block that's seeked to.
+ * In frames with independent blocks (which the `lz4` command line tool writes
+ * by default), reads decode several blocks ahead at once on SDL's job
+ * threads. Blocks in linked frames are decoded one at a time, and seeking
+ * backwards in one decodes it again from the start of the frame.
+ *
+ * If any frame doesn't record its content size, SDL_GetIOSize() and seeking
+ * relative to the end have to decode the whole stream first.
+ *
+ * \param src the stream holding the compressed data. It must be seekable, and
+ *            must not be used by anything else while this stream is open.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when this stream is
+ *                closed, even in the case of an error.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_TellIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromLZ4(SDL_IOStream *src, bool closeio);
 
 /* @} *//* IOFrom functions */
 
@@ -628,6 +628,97 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetJoystickVirtualTouchpad(SDL_Joystick *jo
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SendJoystickVirtualSensorData(SDL_Joystick *joystick, SDL_SensorType type, Uint64 sensor_timestamp, const float *data, int num_values);
 
+/**
+ * The state of one touchpad finger, as set by SDL_SetJoystickVirtualState().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_VirtualJoystickState
+ */
+typedef struct SDL_VirtualJoystickFingerState
+{
+    int touchpad;       /**< the index of the touchpad */
+    int finger;         /**< the index of the finger on the touchpad */
+    bool down;          /**< true if the finger is touching the touchpad */
+    float x;            /**< the x coordinate of the finger, 0 is left, 1 is right */
+    float y;            /**< the y coordinate of the finger, 0 is top, 1 is bottom */
+    float pressure;     /**< the pressure of the finger */
+} SDL_VirtualJoystickFingerState;
+
+/**
+ * One sensor reading, as sent by SDL_SetJoystickVirtualState().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_VirtualJoystickState
+ */
+typedef struct SDL_VirtualJoystickSensorEvent
+{
+    SDL_SensorType type;        /**< the type of the sensor */
+    Uint64 sensor_timestamp;    /**< a 64-bit timestamp in nanoseconds associated with the reading */
+    const float *data;          /**< the data associated with the reading */
+    int num_values;             /**< the number of values pointed to by `data` */
+} SDL_VirtualJoystickSensorEvent;
+
+/**
+ * A batch of state changes for a virtual joystick.
+ *
+ * The `axes`, `buttons` and `hats` arrays set the first `naxes`, `nbuttons`
+ * and `nhats` controls of the joystick. Any of the counts can be 0 to leave
+ * those controls alone.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetJoystickVirtualState
+ */
+typedef struct SDL_VirtualJoystickState
+{
+    int naxes;                  /**< the number of values in `axes` */
+    const Sint16 *axes;         /**< the new axis values, see SDL_SetJoystickVirtualAxis() */
+    int nbuttons;               /**< the number of values in `buttons` */
+    const bool *buttons;        /**< the new button states, true means pressed */
+    int nhats;                  /**< the number of values in `hats` */
+    const Uint8 *hats;          /**< the new hat positions, see SDL_SetJoystickVirtualHat() */
+    int nfingers;               /**< the number of values in `fingers` */
+    const SDL_VirtualJoystickFingerState *fingers;  /**< touchpad fingers to update */
+    int nsensor_events;         /**< the number of values in `sensor_events` */
+    const SDL_VirtualJoystickSensorEvent *sensor_events;    /**< sensor readings to send */
+} SDL_VirtualJoystickState;
+
+/**
+ * Set many controls of an opened virtual joystick at once.
+ *
+ * This has the same effect as calling SDL_SetJoystickVirtualAxis(),
+ * SDL_SetJoystickVirtualButton(), SDL_SetJoystickVirtualHat(),
+ * SDL_SetJoystickVirtualTouchpad() and SDL_SendJoystickVirtualSensorData()
+ * for each value in `state`, but the joystick lock is only taken once, and
+ * either all of the changes are applied or, if any of them is invalid, none
+ * of them are. To update several virtual joysticks in one go, call this
+ * between SDL_LockJoysticks() and SDL_UnlockJoysticks().
+ *
+ * Please note that values set here will not be applied until the next call to
+ * SDL_UpdateJoysticks, which can either be called directly, or can be called
+ * indirectly through various other SDL APIs, including, but not limited to
+ * the following: SDL_PollEvent, SDL_PumpEvents, SDL_WaitEventTimeout,
+ * SDL_WaitEvent.
+ *
+ * \param joystick the virtual joystick on which to set state.
+ * \param state the changes to make.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetJoystickVirtualAxis
+ * \sa SDL_SetJoystickVirtualButton
+ * \sa SDL_SetJoystickVirtualHat
+ * \sa SDL_SetJoystickVirtualTouchpad
+ * \sa SDL_SendJoystickVirtualSensorData
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetJoystickVirtualState(SDL_Joystick *joystick, const SDL_VirtualJoystickState *state);
+
 /**
  * Get the properties associated with a joystick.
  *
@@ -317,6 +317,82 @@ typedef struct SDL_Mutex SDL_Mutex;
  */
 extern SDL_DECLSPEC SDL_Mutex * SDLCALL SDL_CreateMutex(void);
 
+/**
+ * Flags that change how a mutex behaves, used with SDL_CreateNamedMutex().
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ */
+typedef Uint32 SDL_MutexFlags;
+
+#define SDL_MUTEX_NONRECURSIVE  0x00000001u /**< The mutex will not be locked again by the thread that holds it, and may spin briefly before sleeping */
+
+/**
+ * Create a new mutex with a name and options.
+ *
+ * This works like SDL_CreateMutex(), but the mutex can be created with
+ * SDL_MUTEX_NONRECURSIVE. Non-recursive mutexes are cheaper to lock on some
+ * platforms, and threads that find one locked spin briefly before sleeping,
+ * since it's usually released soon. Locking a non-recursive mutex again on
+ * the thread that holds it will deadlock.
+ *
+ * If the SDL_HINT_MUTEX_PROFILING hint is enabled when the mutex is created,
+ * SDL records how long threads wait to lock it, under `name`. Mutexes with
+ * the same name share their statistics.
+ *
+ * \param name a name used for contention statistics, may be NULL.
+ * \param flags a combination of SDL_MutexFlags, or 0.
+ * \returns the initialized and unlocked mutex or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateMutex
+ * \sa SDL_GetMutexContentionStats
+ */
+extern SDL_DECLSPEC SDL_Mutex * SDLCALL SDL_CreateNamedMutex(const char *name, SDL_MutexFlags flags);
+
+/**
+ * Lock contention statistics for named mutexes.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMutexContentionStats
+ */
+typedef struct SDL_MutexContentionStats
+{
+    Uint64 num_locks;       /**< Number of times mutexes with this name were locked with SDL_LockMutex() */
+    Uint64 num_contended;   /**< Number of those times the mutex was held by another thread */
+    Uint64 total_wait_ns;   /**< Total time spent waiting for the mutex, in nanoseconds */
+    Uint64 max_wait_ns;     /**< The longest wait for the mutex, in nanoseconds */
+} SDL_MutexContentionStats;
+
+/**
+ * Get the lock contention statistics for mutexes with a given name.
+ *
+ * Statistics are only recorded for mutexes created with
+ * SDL_CreateNamedMutex() while the SDL_HINT_MUTEX_PROFILING hint is enabled.
+ * They accumulate until the program exits, including for mutexes that have
+ * been destroyed. The mutexes SDL uses internally are named "SDL_" followed
+ * by the subsystem, like "SDL_timers".
+ *
+ * SDL records statistics for up to 64 different names. Later names aren't
+ * recorded.
+ *
+ * \param name the name the mutexes were created with.
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false if nothing was recorded for `name`; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateNamedMutex
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetMutexContentionStats(const char *name, SDL_MutexContentionStats *stats);
+
 /**
  * Lock the mutex.
  *
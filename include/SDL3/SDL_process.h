@@ -402,6 +402,75 @@ extern SDL_DECLSPEC bool SDLCALL SDL_KillProcess(SDL_Process *process, bool forc
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_WaitProcess(SDL_Process *process, bool block, int *exitcode);
 
+/**
+ * Things about a process that SDL_WaitProcesses() can wait for.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_WaitProcesses
+ */
+typedef Uint32 SDL_ProcessEvents;
+
+#define SDL_PROCESS_EVENT_EXITED    0x01u   /**< the process has exited. */
+#define SDL_PROCESS_EVENT_STDIN     0x02u   /**< standard input can be written to without blocking. */
+#define SDL_PROCESS_EVENT_STDOUT    0x04u   /**< standard output has data to read, or has been closed. */
+#define SDL_PROCESS_EVENT_STDERR    0x08u   /**< standard error has data to read, or has been closed. */
+
+/**
+ * A process to wait for with SDL_WaitProcesses().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_WaitProcesses
+ */
+typedef struct SDL_ProcessWait
+{
+    SDL_Process *process;       /**< the process to wait for. */
+    SDL_ProcessEvents events;   /**< the events to wait for. */
+    SDL_ProcessEvents revents;  /**< filled in with the events that are ready. */
+} SDL_ProcessWait;
+
+/**
+ * Wait for something to happen to any of several processes.
+ *
+ * This lets one thread look after many processes at once, instead of
+ * needing a thread for each pipe. Each entry lists the events to wait for,
+ * and once this returns, `revents` says which of those are ready. The
+ * standard I/O events only apply to streams created with
+ * `SDL_PROCESS_STDIO_APP`, and are ignored for a stream that has been
+ * closed.
+ *
+ * When a process exits, it's reaped as if by SDL_WaitProcess(), so
+ * SDL_WaitProcess() can then get its exit code without blocking. A process
+ * that has already exited always reports `SDL_PROCESS_EVENT_EXITED` if asked
+ * for it.
+ *
+ * A stream that has been closed by the process keeps reporting that it's
+ * ready, so stop asking for it once reading it reaches the end.
+ *
+ * On Linux, processes are watched without polling with pidfds, and on Apple
+ * platforms and the BSDs, with kqueue. Elsewhere, and for background
+ * processes, exits are checked every few milliseconds while waiting. On
+ * Windows, pipes are checked every few milliseconds, and standard input
+ * always reports that it's ready.
+ *
+ * \param waits an array of processes and the events to wait for.
+ * \param count the number of entries in `waits`.
+ * \param timeoutMS the maximum time to wait, in milliseconds, or -1 to wait
+ *                  indefinitely.
+ * \returns the number of entries with events ready, 0 if the wait timed out,
+ *          or -1 on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety This function is not thread safe.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetProcessInput
+ * \sa SDL_GetProcessOutput
+ * \sa SDL_WaitProcess
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS);
+
 /**
  * Destroy a previously created process object.
  *
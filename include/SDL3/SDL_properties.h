@@ -80,6 +80,26 @@ typedef enum SDL_PropertyType
     SDL_PROPERTY_TYPE_BOOLEAN
 } SDL_PropertyType;
 
+/**
+ * A named, typed property value, as set by SDL_SetProperties().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetProperties
+ */
+typedef struct SDL_PropertyValue
+{
+    const char *name;           /**< The name of the property */
+    SDL_PropertyType type;      /**< The type of the property, selects the member of `value` that is used */
+    union {
+        void *pointer_value;        /**< The value of an SDL_PROPERTY_TYPE_POINTER property, NULL clears the property */
+        const char *string_value;   /**< The value of an SDL_PROPERTY_TYPE_STRING property, NULL clears the property */
+        Sint64 number_value;        /**< The value of an SDL_PROPERTY_TYPE_NUMBER property */
+        float float_value;          /**< The value of an SDL_PROPERTY_TYPE_FLOAT property */
+        bool boolean_value;         /**< The value of an SDL_PROPERTY_TYPE_BOOLEAN property */
+    } value;
+} SDL_PropertyValue;
+
 /**
  * Get the global SDL properties.
  *
@@ -125,6 +145,30 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_CreateProperties(void);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst);
 
+/**
+ * Create a read-only copy of a group of properties.
+ *
+ * The snapshot holds the properties of `src` as they are when this is
+ * called, with the exception of properties requiring cleanup (set using
+ * SDL_SetPointerPropertyWithCleanup()), which will not be copied. It can be
+ * read with the usual getter functions, and since it never changes, those
+ * don't need to lock it. Setting or clearing properties in a snapshot fails.
+ *
+ * This is useful for settings that are read often, from many threads.
+ *
+ * \param src the properties to copy.
+ * \returns an ID for the new read-only group of properties, or 0 on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CopyProperties
+ * \sa SDL_DestroyProperties
+ */
+extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_CreatePropertiesSnapshot(SDL_PropertiesID src);
+
 /**
  * Lock a group of properties.
  *
@@ -311,6 +355,34 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetFloatProperty(SDL_PropertiesID props, co
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, bool value);
 
+/**
+ * Set many properties in a group of properties at once.
+ *
+ * This sets each property the same way as the function for its type, such as
+ * SDL_SetNumberProperty() or SDL_SetStringProperty(), but the properties are
+ * only locked once and room for all of them is made up front. If several
+ * values have the same name, the last one is used.
+ *
+ * Pointer properties set this way have no cleanup function.
+ *
+ * \param props the properties to modify.
+ * \param values an array of property values to set.
+ * \param count the number of elements in `values`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetPointerProperty
+ * \sa SDL_SetStringProperty
+ * \sa SDL_SetNumberProperty
+ * \sa SDL_SetFloatProperty
+ * \sa SDL_SetBooleanProperty
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetProperties(SDL_PropertiesID props, const SDL_PropertyValue *values, int count);
+
 /**
  * Return whether a property exists in a group of properties.
  *
@@ -293,6 +293,32 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetRectEnclosingPoints(const SDL_Point *poi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetRectAndLineIntersection(const SDL_Rect *rect, int *X1, int *Y1, int *X2, int *Y2);
 
+/**
+ * Find the rectangles in an array that intersect a clipping rectangle.
+ *
+ * This is the same test as SDL_HasRectIntersection(), done for a whole array
+ * at once, which is useful for culling large numbers of sprites or dirty
+ * rectangles. It uses SIMD instructions where available.
+ *
+ * Rectangles with no area never intersect. The indices of the rectangles
+ * that do intersect `clip` are written to `indices` in increasing order.
+ *
+ * \param rects an array of SDL_Rect structures to test.
+ * \param count the number of structures in the `rects` array.
+ * \param clip an SDL_Rect structure representing the clipping rectangle.
+ * \param indices an array of at least `count` elements filled in with the
+ *                indices of the intersecting rectangles.
+ * eturns the number of intersecting rectangles or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * 	hreadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HasRectIntersection
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetIntersectingRects(const SDL_Rect *rects, int count, const SDL_Rect *clip, int *indices);
+
 
 /* SDL_FRect versions... */
 
@@ -498,6 +524,34 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetRectEnclosingPointsFloat(const SDL_FPoin
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetRectAndLineIntersectionFloat(const SDL_FRect *rect, float *X1, float *Y1, float *X2, float *Y2);
 
+/**
+ * Find the floating point rectangles in an array that intersect a clipping
+ * rectangle.
+ *
+ * This is the same test as SDL_HasRectIntersectionFloat(), done for a whole
+ * array at once, which is useful for culling large numbers of sprites or
+ * dirty rectangles. It uses SIMD instructions where available.
+ *
+ * Rectangles with negative width or height never intersect. The indices of
+ * the rectangles that do intersect `clip` are written to `indices` in
+ * increasing order.
+ *
+ * \param rects an array of SDL_FRect structures to test.
+ * \param count the number of structures in the `rects` array.
+ * \param clip an SDL_FRect structure representing the clipping rectangle.
+ * \param indices an array of at least `count` elements filled in with the
+ *                indices of the intersecting rectangles.
+ * \returns the number of intersecting rectangles or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HasRectIntersectionFloat
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetIntersectingRectsFloat(const SDL_FRect *rects, int count, const SDL_FRect *clip, int *indices);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
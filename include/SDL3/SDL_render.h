@@ -85,6 +85,21 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
+/**
+ * A copy of part of a texture, as drawn by SDL_RenderTextureInstances().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderTextureInstances
+ */
+typedef struct SDL_TextureInstance
+{
+    SDL_FRect srcrect;          /**< The area of the texture to copy, in pixels */
+    SDL_FRect dstrect;          /**< The destination rectangle, in SDL_Renderer coordinates */
+    SDL_FColor color;           /**< Color modulation, combined with the texture color and alpha modulation */
+    float angle;                /**< Rotation in degrees around the center of dstrect, clockwise */
+} SDL_TextureInstance;
+
 /**
  * The access pattern allowed for a texture.
  *
@@ -142,6 +157,41 @@ struct SDL_Texture
 
 typedef struct SDL_Texture SDL_Texture;
 
+/**
+ * A set of large textures that many small textures are packed into.
+ *
+ * Textures created from an atlas share the texture of their atlas page, so
+ * draws that use textures from the same page can be batched together.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ * \sa SDL_CreateAtlasTexture
+ * \sa SDL_DestroyTextureAtlas
+ */
+typedef struct SDL_TextureAtlas SDL_TextureAtlas;
+
+/**
+ * A list of draws recorded ahead of time, possibly on another thread.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ * \sa SDL_SubmitRenderCommandList
+ * \sa SDL_DestroyRenderCommandList
+ */
+typedef struct SDL_RenderCommandList SDL_RenderCommandList;
+
+/**
+ * A pending read of pixels from a rendering target.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ * \sa SDL_FinishRenderReadback
+ */
+typedef struct SDL_RenderReadback SDL_RenderReadback;
+
 /* Function prototypes */
 
 /**
@@ -281,6 +331,21 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  *   queue family index used for rendering.
  * - `SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER`: the
  *   queue family index used for presentation.
+ * - `SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_STRING`: the path of a
+ *   file where the VkPipelineCache is kept between runs, so pipelines that
+ *   were created before are fast to create again. Data from a different
+ *   device or driver is ignored. The file is written when the renderer is
+ *   destroyed. See also SDL_HINT_RENDER_VULKAN_PIPELINE_WARMUP.
+ *
+ * With the opengles2 renderer:
+ *
+ * - `SDL_PROP_RENDERER_CREATE_OPENGLES2_PROGRAM_CACHE_STRING`: the path of a
+ *   file where linked shader programs are cached between runs, if the driver
+ *   supports GL_OES_get_program_binary. Shaders are then only compiled when
+ *   a program isn't in the cache, which makes creating the renderer much
+ *   faster on mobile and embedded drivers. The cache is rebuilt when the
+ *   driver or SDL's shaders change, and written out when the renderer is
+ *   destroyed.
  *
  * \param props the properties to use.
  * \returns a valid rendering context or NULL if there was an error; call
@@ -309,6 +374,8 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRendererWithProperties(SDL_
 #define SDL_PROP_RENDERER_CREATE_VULKAN_DEVICE_POINTER                      "SDL.renderer.create.vulkan.device"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_GRAPHICS_QUEUE_FAMILY_INDEX_NUMBER  "SDL.renderer.create.vulkan.graphics_queue_family_index"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER   "SDL.renderer.create.vulkan.present_queue_family_index"
+#define SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_STRING               "SDL.renderer.create.vulkan.pipeline_cache"
+#define SDL_PROP_RENDERER_CREATE_OPENGLES2_PROGRAM_CACHE_STRING             "SDL.renderer.create.opengles2.program_cache"
 
 /**
  * Create a 2D software rendering context for a surface.
@@ -404,6 +471,36 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   that can be displayed, in terms of the SDR white point. When HDR is not
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_WINDOW_HDR_STATE_CHANGED is sent.
+ * - `SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER`: the number of render commands
+ *   queued during the last frame. This property is updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER`: the number of bytes of
+ *   vertex data queued during the last frame. This property is updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_ALLOCATIONS_NUMBER`: the number of times the
+ *   storage for render commands and vertex data had to grow during the last
+ *   frame. This settles to 0 once the amount of drawing per frame is steady.
+ *   This property is updated by SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_QUEUE_BYTES_NUMBER`: the number of bytes allocated
+ *   for render commands and vertex data. This property is updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER`: the number of draw commands
+ *   handed to the rendering backend during the last frame, after batching.
+ *   This property is updated by SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER`: the number of viewport,
+ *   clip rectangle, draw color, blend mode and texture sampling changes
+ *   handed to the rendering backend during the last frame. This property is
+ *   updated by SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_TEXTURE_BINDS_NUMBER`: the number of times a
+ *   draw used a different texture than the draw before it during the last
+ *   frame. This property is updated by SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER`: the number of bytes of
+ *   texture data uploaded during the last frame, by SDL_UpdateTexture() and
+ *   friends or by unlocking streaming textures. This property is updated by
+ *   SDL_RenderPresent().
+ * - `SDL_PROP_RENDERER_FRAME_QUEUE_TIME_NS_NUMBER`: the number of
+ *   nanoseconds the rendering backend spent processing render commands
+ *   during the last frame. This property is updated by SDL_RenderPresent().
  *
  * With the direct3d renderer:
  *
@@ -469,6 +566,15 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER                     "SDL.renderer.frame_commands"
+#define SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER                 "SDL.renderer.frame_vertex_bytes"
+#define SDL_PROP_RENDERER_FRAME_ALLOCATIONS_NUMBER                  "SDL.renderer.frame_allocations"
+#define SDL_PROP_RENDERER_QUEUE_BYTES_NUMBER                        "SDL.renderer.queue_bytes"
+#define SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER                   "SDL.renderer.frame_draw_calls"
+#define SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER                "SDL.renderer.frame_state_changes"
+#define SDL_PROP_RENDERER_FRAME_TEXTURE_BINDS_NUMBER                "SDL.renderer.frame_texture_binds"
+#define SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER                 "SDL.renderer.frame_upload_bytes"
+#define SDL_PROP_RENDERER_FRAME_QUEUE_TIME_NS_NUMBER                "SDL.renderer.frame_queue_time_ns"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -623,6 +729,10 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  * - `SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_V_POINTER`: the ID3D11Texture2D
  *   associated with the V plane of a YUV texture, if you want to wrap an
  *   existing texture.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER`: a DXGI shared
+ *   HANDLE for a texture created on another device, if you want to wrap it
+ *   without copying. Both NT handles and legacy shared handles are accepted,
+ *   and the handle remains owned by the application.
  *
  * With the direct3d12 renderer:
  *
@@ -634,12 +744,24 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  * - `SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_V_POINTER`: the ID3D12Resource
  *   associated with the V plane of a YUV texture, if you want to wrap an
  *   existing texture.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER`: a DXGI shared
+ *   HANDLE for a resource created on another device, if you want to wrap it
+ *   without copying. The handle remains owned by the application.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_POINTER`: an ID3D12Fence that the
+ *   producer of the texture contents signals, the renderer's queue will wait
+ *   for it to reach `SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_VALUE_NUMBER` before
+ *   it draws anything else.
+ * - `SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_VALUE_NUMBER`: the fence value to
+ *   wait for, defaults to 0.
  *
  * With the metal renderer:
  *
  * - `SDL_PROP_TEXTURE_CREATE_METAL_PIXELBUFFER_POINTER`: the CVPixelBufferRef
  *   associated with the texture, if you want to create a texture from an
  *   existing pixel buffer.
+ * - `SDL_PROP_TEXTURE_CREATE_METAL_IOSURFACE_POINTER`: the IOSurfaceRef
+ *   associated with the texture, if you want to create a texture from an
+ *   existing IOSurface, for example one shared by another process.
  *
  * With the opengl renderer:
  *
@@ -676,6 +798,23 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureFromSurface(SDL_Rende
  * - `SDL_PROP_TEXTURE_CREATE_VULKAN_TEXTURE_NUMBER`: the VkImage with layout
  *   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL associated with the texture, if
  *   you want to wrap an existing texture.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_FD_NUMBER`: a Linux dmabuf file
+ *   descriptor holding the texture contents, if you want to import it
+ *   without copying, for example from a VA-API or V4L2 decoder. The renderer
+ *   duplicates the file descriptor, so it remains owned by the application.
+ *   All planes of a YUV texture must be in this one dmabuf. The dmabuf's
+ *   implicit synchronization is used, so the producer must have finished
+ *   writing to it or attached its fence to it.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_MODIFIER_NUMBER`: the DRM format
+ *   modifier describing the dmabuf layout, defaults to DRM_FORMAT_MOD_LINEAR.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_OFFSET_NUMBER`: the offset in
+ *   bytes of the first plane in the dmabuf, defaults to 0.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_PITCH_NUMBER`: the pitch in bytes
+ *   of the first plane in the dmabuf, required.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_OFFSET_NUMBER`: the offset in
+ *   bytes of the UV plane of an NV12, NV21 or P010 texture in the dmabuf.
+ * - `SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_PITCH_NUMBER`: the pitch in
+ *   bytes of the UV plane of an NV12, NV21 or P010 texture in the dmabuf.
  *
  * \param renderer the rendering context.
  * \param props the properties to use.
@@ -705,10 +844,15 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER       "SDL.texture.create.d3d11.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_U_POINTER     "SDL.texture.create.d3d11.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_V_POINTER     "SDL.texture.create.d3d11.texture_v"
+#define SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER "SDL.texture.create.d3d11.shared_handle"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_POINTER       "SDL.texture.create.d3d12.texture"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_U_POINTER     "SDL.texture.create.d3d12.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_V_POINTER     "SDL.texture.create.d3d12.texture_v"
+#define SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER "SDL.texture.create.d3d12.shared_handle"
+#define SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_POINTER         "SDL.texture.create.d3d12.fence"
+#define SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_VALUE_NUMBER    "SDL.texture.create.d3d12.fence_value"
 #define SDL_PROP_TEXTURE_CREATE_METAL_PIXELBUFFER_POINTER   "SDL.texture.create.metal.pixelbuffer"
+#define SDL_PROP_TEXTURE_CREATE_METAL_IOSURFACE_POINTER     "SDL.texture.create.metal.iosurface"
 #define SDL_PROP_TEXTURE_CREATE_OPENGL_TEXTURE_NUMBER       "SDL.texture.create.opengl.texture"
 #define SDL_PROP_TEXTURE_CREATE_OPENGL_TEXTURE_UV_NUMBER    "SDL.texture.create.opengl.texture_uv"
 #define SDL_PROP_TEXTURE_CREATE_OPENGL_TEXTURE_U_NUMBER     "SDL.texture.create.opengl.texture_u"
@@ -718,6 +862,12 @@ extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateTextureWithProperties(SDL_Re
 #define SDL_PROP_TEXTURE_CREATE_OPENGLES2_TEXTURE_U_NUMBER  "SDL.texture.create.opengles2.texture_u"
 #define SDL_PROP_TEXTURE_CREATE_OPENGLES2_TEXTURE_V_NUMBER  "SDL.texture.create.opengles2.texture_v"
 #define SDL_PROP_TEXTURE_CREATE_VULKAN_TEXTURE_NUMBER       "SDL.texture.create.vulkan.texture"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_FD_NUMBER     "SDL.texture.create.vulkan.dmabuf.fd"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_MODIFIER_NUMBER "SDL.texture.create.vulkan.dmabuf.modifier"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_OFFSET_NUMBER "SDL.texture.create.vulkan.dmabuf.offset"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_PITCH_NUMBER  "SDL.texture.create.vulkan.dmabuf.pitch"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_OFFSET_NUMBER "SDL.texture.create.vulkan.dmabuf.uv_offset"
+#define SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_PITCH_NUMBER "SDL.texture.create.vulkan.dmabuf.uv_pitch"
 
 /**
  * Get the properties associated with a texture.
@@ -2234,6 +2384,32 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextureTiled(SDL_Renderer *renderer,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_RenderTexture9Grid(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float left_width, float right_width, float top_height, float bottom_height, float scale, const SDL_FRect *dstrect);
 
+/**
+ * Copy many portions of a texture to the current rendering target at once.
+ *
+ * This draws the same thing as calling SDL_RenderTextureRotated() for each
+ * instance, with the instance color applied on top of the texture color and
+ * alpha modulation, but queues a single draw for all of them. This is much
+ * faster when drawing large numbers of sprites or particles from one
+ * texture.
+ *
+ * \param renderer the renderer which should copy parts of a texture.
+ * \param texture the source texture.
+ * \param instances an array of SDL_TextureInstance structures describing each
+ *                  copy.
+ * \param count the number of instances.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_RenderTextureRotated
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextureInstances(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int count);
+
 /**
  * Render a list of triangles, optionally using a texture and indices into the
  * vertex array Color and alpha modulation is done per vertex
@@ -2296,6 +2472,164 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                                                int num_vertices,
                                                const void *indices, int num_indices, int size_indices);
 
+/**
+ * Create a list to record draws into, for later submission to a renderer.
+ *
+ * Command lists let draws be prepared on worker threads: each thread records
+ * into its own list, building the vertex data for its draws, and the thread
+ * that owns the renderer appends the lists to the render queue, in whatever
+ * order it wants, with SDL_SubmitRenderCommandList().
+ *
+ * \param renderer the renderer the recorded draws will be submitted to.
+ * \returns a new command list or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyRenderCommandList
+ * \sa SDL_RecordRenderTexture
+ * \sa SDL_RecordRenderTextureInstances
+ * \sa SDL_RecordRenderGeometry
+ * \sa SDL_SubmitRenderCommandList
+ */
+extern SDL_DECLSPEC SDL_RenderCommandList * SDLCALL SDL_CreateRenderCommandList(SDL_Renderer *renderer);
+
+/**
+ * Record a copy of a portion of a texture into a command list.
+ *
+ * This records the same draw as SDL_RenderTexture(), except that `dstrect`
+ * may not be NULL, because the size of the rendering target isn't known
+ * until the list is submitted.
+ *
+ * \param list the command list to record into.
+ * \param texture the source texture, created with the list's renderer.
+ * \param srcrect a pointer to the source rectangle, or NULL for the entire
+ *                texture.
+ * \param dstrect a pointer to the destination rectangle.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               only one thread records into a given list at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_RecordRenderTextureInstances
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RecordRenderTexture(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect);
+
+/**
+ * Record many copies of portions of a texture into a command list.
+ *
+ * This records the same draws as SDL_RenderTextureInstances(). The texture
+ * color and alpha modulation are applied when the list is submitted.
+ *
+ * \param list the command list to record into.
+ * \param texture the source texture, created with the list's renderer.
+ * \param instances an array of SDL_TextureInstance structures describing each
+ *                  copy.
+ * \param count the number of instances.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               only one thread records into a given list at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderTextureInstances
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RecordRenderTextureInstances(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_TextureInstance *instances, int count);
+
+/**
+ * Record a list of triangles into a command list.
+ *
+ * This records the same draw as SDL_RenderGeometry(). The vertex and index
+ * data is copied into the list.
+ *
+ * \param list the command list to record into.
+ * \param texture (optional) The SDL texture to use, created with the list's
+ *                renderer.
+ * \param vertices vertices.
+ * \param num_vertices number of vertices.
+ * \param indices (optional) An array of integer indices into the 'vertices'
+ *                array, if NULL all vertices will be rendered in sequential
+ *                order.
+ * \param num_indices number of indices.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               only one thread records into a given list at a time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderGeometry
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RecordRenderGeometry(SDL_RenderCommandList *list,
+                                               SDL_Texture *texture,
+                                               const SDL_Vertex *vertices, int num_vertices,
+                                               const int *indices, int num_indices);
+
+/**
+ * Append the draws recorded in a command list to the render queue.
+ *
+ * The draws are queued in the order they were recorded, using the render
+ * target, viewport, clip rectangle, scale and texture state that are current
+ * when this is called. Consecutive draws using the same texture are queued
+ * as a single draw. The list is not modified, so it can be submitted again.
+ *
+ * Every texture used by the list must still exist when it is submitted.
+ *
+ * \param renderer the renderer the list was created with.
+ * \param list the command list to submit.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread, and
+ *               no other thread may be recording into the list.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ * \sa SDL_ResetRenderCommandList
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubmitRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list);
+
+/**
+ * Remove all recorded draws from a command list.
+ *
+ * The memory used by the list is kept, so recording the next frame into it
+ * doesn't need to allocate.
+ *
+ * \param list the command list to reset.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               no other thread is using the list.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetRenderCommandList(SDL_RenderCommandList *list);
+
+/**
+ * Destroy a command list.
+ *
+ * \param list the command list to destroy.
+ *
+ * \threadsafety It is safe to call this function from any thread, as long as
+ *               no other thread is using the list.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRenderCommandList
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyRenderCommandList(SDL_RenderCommandList *list);
+
 /**
  * Read pixels from the current rendering target.
  *
@@ -2323,6 +2657,122 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderGeometryRaw(SDL_Renderer *renderer,
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect);
 
+/**
+ * Start reading pixels from the current rendering target, without waiting
+ * for the rendering to finish.
+ *
+ * This reads the same pixels as SDL_RenderReadPixels(), but returns as soon
+ * as the read has been queued, so rendering can continue while the GPU
+ * catches up. Call SDL_IsRenderReadbackComplete() to check whether the pixels
+ * are available, and SDL_FinishRenderReadback() to get them, a few frames
+ * later for instance.
+ *
+ * Renderers that can't read pixels asynchronously read them immediately, and
+ * the readback is complete as soon as this function returns.
+ *
+ * \param renderer the rendering context.
+ * \param rect an SDL_Rect structure representing the area to read, which will
+ *             be clipped to the current viewport, or NULL for the entire
+ *             viewport.
+ * \returns a pending readback on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CancelRenderReadback
+ * \sa SDL_FinishRenderReadback
+ * \sa SDL_IsRenderReadbackComplete
+ * \sa SDL_RenderReadPixels
+ */
+extern SDL_DECLSPEC SDL_RenderReadback * SDLCALL SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect);
+
+/**
+ * Check whether the pixels of a pending readback are available.
+ *
+ * \param readback the readback to check.
+ * \returns true if SDL_FinishRenderReadback() will return without waiting,
+ *          false otherwise.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FinishRenderReadback
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_IsRenderReadbackComplete(SDL_RenderReadback *readback);
+
+/**
+ * Get the pixels of a readback, waiting for them if necessary.
+ *
+ * The readback is freed by this function, whether it succeeds or not. The
+ * returned surface should be freed with SDL_DestroySurface().
+ *
+ * \param readback the readback to finish.
+ * \returns a new SDL_Surface on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_IsRenderReadbackComplete
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_FinishRenderReadback(SDL_RenderReadback *readback);
+
+/**
+ * Free a readback without getting its pixels.
+ *
+ * Pending readbacks are freed automatically when their renderer is destroyed.
+ *
+ * \param readback the readback to free.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderReadPixelsAsync
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_CancelRenderReadback(SDL_RenderReadback *readback);
+
+/**
+ * Tell the renderer which parts of the window changed before the next
+ * present.
+ *
+ * Renderers that keep the window contents between frames, like the
+ * software renderer, only send the changed parts of the window to the
+ * screen. By default they work out what changed from the drawing that was
+ * done since the previous present; an application that already knows what
+ * it changed can use this function to replace that estimate for the next
+ * call to SDL_RenderPresent().
+ *
+ * The rectangles are in pixels of the render output, as returned by
+ * SDL_GetCurrentRenderOutputSize(), and are not affected by the viewport,
+ * scale or logical presentation. Anything drawn outside of them might not
+ * reach the screen until a later present. Passing a count of 0 with a
+ * non-NULL `rects` means that nothing changed.
+ *
+ * Renderers that redraw the whole window every frame ignore this.
+ *
+ * \param renderer the rendering context.
+ * \param rects an array of SDL_Rect structures representing the changed
+ *              parts of the window, or NULL to go back to working them out
+ *              from the drawing.
+ * \param count the number of rectangles in `rects`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RenderPresent
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetRenderDamageRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count);
+
 /**
  * Update the screen with any rendering performed since the previous call.
  *
@@ -2368,6 +2818,7 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_RenderReadPixels(SDL_Renderer *ren
  * \sa SDL_RenderPoints
  * \sa SDL_RenderRect
  * \sa SDL_RenderRects
+ * \sa SDL_SetRenderDamageRects
  * \sa SDL_SetRenderDrawBlendMode
  * \sa SDL_SetRenderDrawColor
  */
@@ -2390,6 +2841,88 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderPresent(SDL_Renderer *renderer);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroyTexture(SDL_Texture *texture);
 
+/**
+ * Create a texture atlas for a rendering context.
+ *
+ * A texture atlas packs many small textures, such as glyphs, icons and UI
+ * elements, into a few large page textures. Textures created with
+ * SDL_CreateAtlasTexture() can be used like any other static texture, but
+ * textures on the same page are drawn from the same backend texture, so
+ * consecutive draws using them can be batched together by the renderer.
+ *
+ * New pages are added as needed when the existing pages are full. The space
+ * used by a texture is reclaimed once every texture on its page has been
+ * destroyed.
+ *
+ * \param renderer the rendering context.
+ * \param format one of the enumerated values in SDL_PixelFormat, or
+ *               SDL_PIXELFORMAT_UNKNOWN to use the preferred texture format.
+ *               FOURCC formats are not supported.
+ * \param page_width the width of each atlas page in pixels, or 0 to use a
+ *                   default size.
+ * \param page_height the height of each atlas page in pixels, or 0 to use a
+ *                    default size.
+ * \returns the created texture atlas or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateAtlasTexture
+ * \sa SDL_DestroyTextureAtlas
+ */
+extern SDL_DECLSPEC SDL_TextureAtlas * SDLCALL SDL_CreateTextureAtlas(SDL_Renderer *renderer, SDL_PixelFormat format, int page_width, int page_height);
+
+/**
+ * Create a texture in a texture atlas.
+ *
+ * The returned texture has SDL_TEXTUREACCESS_STATIC access and the format of
+ * the atlas. Its contents are undefined until it is updated with
+ * SDL_UpdateTexture(). It can be drawn with any of the texture rendering
+ * functions and has its own color, alpha, blend and scale modes. Texture
+ * coordinates outside the texture aren't supported with SDL_RenderGeometry()
+ * and SDL_RenderGeometryRaw(), since the texture can't be wrapped within its
+ * page.
+ *
+ * Each texture is surrounded by one pixel of transparent padding on its page,
+ * so linear filtering doesn't bleed in neighboring textures.
+ *
+ * Destroy the texture with SDL_DestroyTexture() when it's no longer needed.
+ *
+ * \param atlas the texture atlas to allocate the texture in.
+ * \param w the width of the texture in pixels, at most the page width.
+ * \param h the height of the texture in pixels, at most the page height.
+ * \returns the created texture or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ * \sa SDL_DestroyTexture
+ * \sa SDL_UpdateTexture
+ */
+extern SDL_DECLSPEC SDL_Texture * SDLCALL SDL_CreateAtlasTexture(SDL_TextureAtlas *atlas, int w, int h);
+
+/**
+ * Destroy a texture atlas.
+ *
+ * Any textures that are still allocated in the atlas are destroyed as well.
+ * Texture atlases are destroyed automatically when their renderer is
+ * destroyed.
+ *
+ * \param atlas the texture atlas to destroy.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateTextureAtlas
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyTextureAtlas(SDL_TextureAtlas *atlas);
+
 /**
  * Destroy the rendering context for a window and free all associated
  * textures.
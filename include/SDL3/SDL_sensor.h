@@ -287,6 +287,37 @@ extern SDL_DECLSPEC SDL_SensorID SDLCALL SDL_GetSensorID(SDL_Sensor *sensor);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetSensorData(SDL_Sensor *sensor, float *data, int num_values);
 
+/**
+ * Get the sensor samples received since the last call.
+ *
+ * This returns every sample that arrived since the last call, oldest first,
+ * so an application can process full rate sensor data without handling an
+ * SDL_EVENT_SENSOR_UPDATE event for each one.
+ *
+ * SDL starts keeping samples the first time this is called for a sensor, so
+ * the first call returns 0. If the application doesn't read samples for a
+ * while only the most recent samples are kept.
+ *
+ * Each sample is written to `data` as `num_values` floats, so `data` must have
+ * room for `max_samples * num_values` values.
+ *
+ * \param sensor the SDL_Sensor object to query.
+ * \param data a pointer filled with the sensor samples.
+ * \param num_values the number of values to write to data for each sample.
+ * \param timestamps a pointer filled with the sensor timestamp of each
+ *                   sample, in nanoseconds, may be NULL.
+ * \param max_samples the maximum number of samples to return.
+ * \returns the number of samples written, or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSensorData
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetSensorSamples(SDL_Sensor *sensor, float *data, int num_values, Uint64 *timestamps, int max_samples);
+
 /**
  * Close a sensor previously opened with SDL_OpenSensor().
  *
@@ -1612,6 +1612,157 @@ extern SDL_DECLSPEC void SDLCALL SDL_aligned_free(void *mem);
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetNumAllocations(void);
 
+/**
+ * The SDL subsystems that allocations can be attributed to.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryTag
+ */
+typedef enum SDL_MemoryTag
+{
+    SDL_MEMORY_TAG_OTHER,       /**< Not made on behalf of a particular subsystem */
+    SDL_MEMORY_TAG_AUDIO,       /**< Audio device processing */
+    SDL_MEMORY_TAG_VIDEO,       /**< Window management and window surfaces */
+    SDL_MEMORY_TAG_RENDER,      /**< The 2D rendering API */
+    SDL_MEMORY_TAG_GPU,         /**< The GPU API */
+    SDL_MEMORY_TAG_EVENTS,      /**< Event pumping */
+    SDL_MEMORY_TAG_JOYSTICK,    /**< Joystick and gamepad updates */
+    SDL_MEMORY_TAG_HIDAPI,      /**< HIDAPI device drivers */
+    SDL_MEMORY_TAG_COUNT        /**< The number of tags, not a valid tag */
+} SDL_MemoryTag;
+
+/**
+ * Get the SDL subsystem currently allocating memory on this thread.
+ *
+ * This is meant to be called from memory functions installed with
+ * SDL_SetMemoryFunctions(), to attribute allocations to the part of SDL that
+ * made them. SDL only keeps track of this while replacement memory functions
+ * are installed, otherwise this always returns SDL_MEMORY_TAG_OTHER.
+ *
+ * Allocations made by the application itself, and by parts of SDL that
+ * aren't tagged, are reported as SDL_MEMORY_TAG_OTHER.
+ *
+ * \returns the tag for allocations made on this thread right now.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryTagName
+ * \sa SDL_SetMemoryFunctions
+ */
+extern SDL_DECLSPEC SDL_MemoryTag SDLCALL SDL_GetMemoryTag(void);
+
+/**
+ * Get a human-readable name for a memory tag.
+ *
+ * \param tag the tag to query.
+ * \returns the name of the tag, like "audio", or NULL if the tag isn't valid.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryTag
+ */
+extern SDL_DECLSPEC const char * SDLCALL SDL_GetMemoryTagName(SDL_MemoryTag tag);
+
+/**
+ * The kinds of objects whose memory SDL keeps account of.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryUsage
+ */
+typedef enum SDL_MemoryObjectType
+{
+    SDL_MEMORY_OBJECT_SURFACE,              /**< Pixels that SDL allocated for an SDL_Surface */
+    SDL_MEMORY_OBJECT_TEXTURE,              /**< SDL_Texture objects of the 2D rendering API */
+    SDL_MEMORY_OBJECT_GPU_TEXTURE,          /**< SDL_GPUTexture objects */
+    SDL_MEMORY_OBJECT_GPU_BUFFER,           /**< SDL_GPUBuffer objects */
+    SDL_MEMORY_OBJECT_GPU_TRANSFER_BUFFER,  /**< SDL_GPUTransferBuffer objects */
+    SDL_MEMORY_OBJECT_CACHE,                /**< Vertex buffers, descriptor pools and other caches kept by the renderers and GPU backends */
+    SDL_MEMORY_OBJECT_COUNT                 /**< The number of object types, not a valid type */
+} SDL_MemoryObjectType;
+
+/**
+ * The memory used by a set of objects.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryUsage
+ * \sa SDL_GetMemoryUsageForOwner
+ */
+typedef struct SDL_MemoryUsage
+{
+    Uint64 count;       /**< The number of objects that exist right now */
+    Uint64 bytes;       /**< The memory they use, in bytes */
+    Uint64 peak_bytes;  /**< The most memory used at once since SDL started keeping account, in bytes */
+} SDL_MemoryUsage;
+
+/**
+ * The property that names the owner of an object in memory usage queries.
+ *
+ * For surfaces and textures, set this in the properties returned by
+ * SDL_GetSurfaceProperties() or SDL_GetTextureProperties(); it can be changed
+ * at any time. For GPU textures, buffers and transfer buffers, set it in the
+ * properties used to create them.
+ *
+ * The caches SDL keeps internally are owned by "SDL.render.vertex_buffer",
+ * "SDL.gpu.vulkan.descriptor_pools", "SDL.gpu.d3d12.staging_descriptors" and
+ * "SDL.gpu.d3d12.gpu_descriptors".
+ *
+ * \since This macro is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryUsageForOwner
+ */
+#define SDL_PROP_MEMORY_OWNER_STRING "SDL.memory.owner"
+
+/**
+ * Get the memory used by one type of object.
+ *
+ * The sizes of textures are estimated from their dimensions, format and mip
+ * levels, since the drivers don't report the memory they actually take.
+ * Textures that share a page of a texture atlas are accounted to the page,
+ * and sparse GPU textures are counted without any bytes.
+ *
+ * Accounting starts when the first object is created and is reset by
+ * SDL_Quit().
+ *
+ * \param type the type of object to query.
+ * \param usage filled in with the memory used by objects of that type.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryUsageForOwner
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetMemoryUsage(SDL_MemoryObjectType type, SDL_MemoryUsage *usage);
+
+/**
+ * Get the memory used by the objects with a given owner.
+ *
+ * This adds up objects of all types that have SDL_PROP_MEMORY_OWNER_STRING
+ * set to `owner`. The peak isn't tracked per owner, so `usage->peak_bytes` is
+ * the same as `usage->bytes`.
+ *
+ * \param owner the owner to query.
+ * \param usage filled in with the memory used by objects with that owner.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetMemoryUsage
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetMemoryUsageForOwner(const char *owner, SDL_MemoryUsage *usage);
+
 /**
  * A thread-safe set of environment variables
  *
@@ -2021,6 +2172,48 @@ typedef int (SDLCALL *SDL_CompareCallback_r)(void *userdata, const void *a, cons
  */
 extern SDL_DECLSPEC void SDLCALL SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
 
+/**
+ * Sort an array by an integer key stored in each element.
+ *
+ * Each element of the array has a Uint32 key `key_offset` bytes from its
+ * start, and the elements are put in increasing order of their keys. This
+ * doesn't call a compare function, so it's much faster than SDL_qsort() for
+ * large arrays, like sprites sorted by depth.
+ *
+ * Unlike SDL_qsort(), this sort is stable: elements with equal keys keep
+ * their original order.
+ *
+ * To sort by a signed key, flip its sign bit when storing it, like
+ * `(Uint32)depth ^ 0x80000000`. To sort in decreasing order, store the
+ * bitwise complement of the key.
+ *
+ * For example:
+ *
+ * ```c
+ * typedef struct {
+ *     Uint32 depth;
+ *     SDL_Texture *texture;
+ * } sprite;
+ *
+ * SDL_qsort_by_key(sprites, num_sprites, sizeof(sprites[0]), offsetof(sprite, depth));
+ * ```
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of the elements in the array.
+ * \param key_offset the offset of the key within each element, in bytes. It
+ *                   doesn't need to be aligned.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_qsort
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_qsort_by_key(void *base, size_t nmemb, size_t size, size_t key_offset);
+
 /**
  * Perform a binary search on a previously sorted array, passing a userdata
  * pointer to the compare function.
@@ -2661,6 +2854,26 @@ extern SDL_DECLSPEC void * SDLCALL SDL_memset4(void *dst, Uint32 val, size_t dwo
  */
 extern SDL_DECLSPEC int SDLCALL SDL_memcmp(const void *s1, const void *s2, size_t len);
 
+/**
+ * Search a buffer of memory for the first instance of a specific byte.
+ *
+ * Unlike SDL_strchr(), this doesn't stop at null bytes, it looks at exactly
+ * `len` bytes.
+ *
+ * \param buf the buffer to search. NULL is permitted if `len` is zero.
+ * \param c the byte value to search for.
+ * \param len the number of bytes to search.
+ * \returns a pointer to the first instance of `c` in the buffer, or NULL if
+ *          not found.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_strchr
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_memchr(const void *buf, int c, size_t len);
+
 /**
  * This works exactly like wcslen() but doesn't require access to a C runtime.
  *
@@ -4439,6 +4652,197 @@ extern SDL_DECLSPEC float SDLCALL SDL_randf_r(Uint64 *state);
  */
 extern SDL_DECLSPEC Uint32 SDLCALL SDL_rand_bits_r(Uint64 *state);
 
+/**
+ * Fill an array with pseudo-random numbers less than n for positive n.
+ *
+ * This produces the same values as calling SDL_rand() `count` times, but
+ * several steps of the generator are computed at once, which is much faster
+ * when you need a lot of random numbers.
+ *
+ * If you want reproducible output, be sure to initialize with SDL_srand()
+ * first.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param values an array to fill with random values in the range of
+ *               [0 .. n-1].
+ * \param count the number of values to generate.
+ * \param n the number of possible outcomes. n must be positive.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety All calls should be made from a single thread
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_rand
+ * \sa SDL_rand_fill_r
+ * \sa SDL_srand
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill(Sint32 *values, int count, Sint32 n);
+
+/**
+ * Fill an array with uniform pseudo-random floating point numbers less than
+ * 1.0.
+ *
+ * This produces the same values as calling SDL_randf() `count` times, but
+ * several steps of the generator are computed at once, which is much faster
+ * when you need a lot of random numbers.
+ *
+ * If you want reproducible output, be sure to initialize with SDL_srand()
+ * first.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param values an array to fill with random values in the range of
+ *               [0.0, 1.0).
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety All calls should be made from a single thread
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_randf
+ * \sa SDL_rand_fill_float_r
+ * \sa SDL_srand
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill_float(float *values, int count);
+
+/**
+ * Fill an array with pseudo-random bits.
+ *
+ * This produces the same values as calling SDL_rand_bits() `count` times,
+ * but several steps of the generator are computed at once, which is much
+ * faster when you need a lot of random numbers.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param values an array to fill with random values in the range of
+ *               [0-SDL_MAX_UINT32].
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety All calls should be made from a single thread
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_rand_bits
+ * \sa SDL_rand_fill_bits_r
+ * \sa SDL_srand
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill_bits(Uint32 *values, int count);
+
+/**
+ * Fill an array with pseudo-random numbers less than n for positive n, using
+ * an explicit state.
+ *
+ * This produces the same values as calling SDL_rand_r() `count` times with
+ * the same state, but several steps of the generator are computed at once,
+ * which is much faster when you need a lot of random numbers.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param state a pointer to the current random number state, this may not be
+ *              NULL.
+ * \param values an array to fill with random values in the range of
+ *               [0 .. n-1].
+ * \param count the number of values to generate.
+ * \param n the number of possible outcomes. n must be positive.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the state pointer
+ *               isn't shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_rand_fill
+ * \sa SDL_rand_r
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill_r(Uint64 *state, Sint32 *values, int count, Sint32 n);
+
+/**
+ * Fill an array with uniform pseudo-random floating point numbers less than
+ * 1.0, using an explicit state.
+ *
+ * This produces the same values as calling SDL_randf_r() `count` times with
+ * the same state, but several steps of the generator are computed at once,
+ * which is much faster when you need a lot of random numbers.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param state a pointer to the current random number state, this may not be
+ *              NULL.
+ * \param values an array to fill with random values in the range of
+ *               [0.0, 1.0).
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the state pointer
+ *               isn't shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_rand_fill_float
+ * \sa SDL_randf_r
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill_float_r(Uint64 *state, float *values, int count);
+
+/**
+ * Fill an array with pseudo-random bits, using an explicit state.
+ *
+ * This produces the same values as calling SDL_rand_bits_r() `count` times
+ * with the same state, but several steps of the generator are computed at
+ * once, which is much faster when you need a lot of random numbers.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos). There are many random number
+ * libraries available with different characteristics and you should pick one
+ * of those to meet any serious needs.
+ *
+ * \param state a pointer to the current random number state, this may not be
+ *              NULL.
+ * \param values an array to fill with random values in the range of
+ *               [0-SDL_MAX_UINT32].
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the state pointer
+ *               isn't shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_rand_bits_r
+ * \sa SDL_rand_fill_bits
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_rand_fill_bits_r(Uint64 *state, Uint32 *values, int count);
+
 #ifndef SDL_PI_D
 
 /**
@@ -6000,6 +6404,7 @@ char *strdup(const char *str);
 #define SDL_memset memset
 #endif
 #define SDL_memcmp memcmp
+#define SDL_memchr memchr
 #define SDL_strlcpy strlcpy
 #define SDL_strlcat strlcat
 #define SDL_strlen strlen
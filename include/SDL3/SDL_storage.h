@@ -244,8 +244,10 @@
 #define SDL_storage_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_asyncio.h>
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_filesystem.h>
+#include <SDL3/SDL_iostream.h>
 #include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
@@ -398,6 +400,52 @@ extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenUserStorage(const char *org, c
  */
 extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenFileStorage(const char *path);
 
+/**
+ * Opens up a read-only container backed by an SDL archive.
+ *
+ * An archive packs many files into one, so an app can ship its assets as a
+ * single file and open it once, instead of paying for a separate open for
+ * every asset. All reads from the container, including streams from
+ * SDL_OpenStorageFile(), share `src` and read from it at the offsets of the
+ * packed files.
+ *
+ * The archive is little-endian and laid out like this:
+ *
+ * - A 24 byte header: the 4 bytes "SDLA", a Uint32 version (1), a Uint32
+ *   entry count, a Uint32 name table size, and the Uint64 offset of the
+ *   directory.
+ * - The directory, at that offset: one 32 byte entry per file, sorted by
+ *   path (comparing bytes), followed by the name table. Each entry is the
+ *   Uint64 offset of the file's data, the Uint64 number of bytes stored, the
+ *   Uint64 size of the file, the Uint32 offset of its path in the name
+ *   table, a Uint16 path length, a Uint8 compression type, and a reserved
+ *   byte that must be zero.
+ * - Paths are relative, use '/' separators and aren't null-terminated.
+ *   Directories are implied by the paths of the files inside them.
+ * - The compression type is 0 for data stored as-is, or 1 for a single raw
+ *   LZ4 block (no LZ4 frame header).
+ *
+ * The whole directory is checked when the archive is opened, so a damaged
+ * or unsupported archive fails here rather than on a later read.
+ *
+ * \param src the archive to read from. It must be seekable, and must not be
+ *            used by anything else while the container is open.
+ * \param closeio if true, calls SDL_CloseIO() on `src` once the container
+ *                and any streams opened from it are closed, even in the case
+ *                of an error.
+ * \returns an archive storage container on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseStorage
+ * \sa SDL_OpenStorageFile
+ * \sa SDL_ReadStorageFile
+ */
+extern SDL_DECLSPEC SDL_Storage * SDLCALL SDL_OpenArchiveStorage(SDL_IOStream *src, bool closeio);
+
 /**
  * Opens up a container using a client-provided storage interface.
  *
@@ -499,6 +547,28 @@ extern SDL_DECLSPEC bool SDLCALL SDL_GetStorageFileSize(SDL_Storage *storage, co
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_ReadStorageFile(SDL_Storage *storage, const char *path, void *destination, Uint64 length);
 
+/**
+ * Open a file in a storage container as a read-only stream.
+ *
+ * This lets a file be read a piece at a time, for formats that are loaded
+ * through an SDL_IOStream. Containers that can't stream a file read all of it
+ * into memory here instead, and the stream reads from that.
+ *
+ * The stream may be used after the container is closed.
+ *
+ * \param storage a storage container to read from.
+ * \param path the relative path of the file to open.
+ * \returns a stream on success or NULL on failure; call SDL_GetError() for
+ *          more information. Close it with SDL_CloseIO().
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_OpenArchiveStorage
+ * \sa SDL_ReadStorageFile
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_OpenStorageFile(SDL_Storage *storage, const char *path);
+
 /**
  * Synchronously write a file from client memory into a storage container.
  *
@@ -517,6 +587,83 @@ extern SDL_DECLSPEC bool SDLCALL SDL_ReadStorageFile(SDL_Storage *storage, const
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_WriteStorageFile(SDL_Storage *storage, const char *path, const void *source, Uint64 length);
 
+/**
+ * Start reading a file from a storage container into a client-provided
+ * buffer, without blocking.
+ *
+ * This requests the same transfer as SDL_ReadStorageFile(), but returns
+ * right away and reports the outcome through `queue` once the data is in
+ * `destination`. The outcome has a type of `SDL_ASYNCIO_TASK_READ`, its
+ * `buffer` is `destination`, and its `asyncio` field is NULL. Check its
+ * `result` and `bytes_transferred` fields to see if the whole file was read.
+ *
+ * Storage backends that can do asynchronous I/O natively use it; for the
+ * rest, the transfer runs on one of SDL's worker threads. In that case, a
+ * custom SDL_StorageInterface must be safe to call from another thread.
+ *
+ * `destination` must remain available until the outcome is reported. Do not
+ * allocate it on the stack! SDL_CloseStorage() waits for any of these still
+ * running on `storage` to finish.
+ *
+ * \param storage a storage container to read from.
+ * \param path the relative path of the file to read.
+ * \param destination a client-provided buffer to read the file into.
+ * \param length the length of the destination buffer.
+ * \param queue a queue to report the outcome to.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 outcome.
+ * \returns true if the read was started or false on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_ReadStorageFile
+ * \sa SDL_WaitAsyncIOResult
+ * \sa SDL_WriteStorageFileAsync
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ReadStorageFileAsync(SDL_Storage *storage, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata);
+
+/**
+ * Start writing a file from client memory into a storage container, without
+ * blocking.
+ *
+ * This requests the same transfer as SDL_WriteStorageFile(), but returns
+ * right away and reports the outcome through `queue` once the data is
+ * written. The outcome has a type of `SDL_ASYNCIO_TASK_WRITE`, its `buffer`
+ * is `source`, and its `asyncio` field is NULL.
+ *
+ * Storage backends that can do asynchronous I/O natively use it; for the
+ * rest, the transfer runs on one of SDL's worker threads. In that case, a
+ * custom SDL_StorageInterface must be safe to call from another thread.
+ *
+ * `source` must remain available, and unchanged, until the outcome is
+ * reported. SDL_CloseStorage() waits for any of these still running on
+ * `storage` to finish.
+ *
+ * \param storage a storage container to write to.
+ * \param path the relative path of the file to write.
+ * \param source a client-provided buffer to write from.
+ * \param length the length of the source buffer.
+ * \param queue a queue to report the outcome to.
+ * \param userdata an app-defined pointer that will be provided with the
+ *                 outcome.
+ * \returns true if the write was started or false on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetAsyncIOResult
+ * \sa SDL_WaitAsyncIOResult
+ * \sa SDL_ReadStorageFileAsync
+ * \sa SDL_WriteStorageFile
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WriteStorageFileAsync(SDL_Storage *storage, const char *path, const void *source, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata);
+
 /**
  * Create a directory in a writable storage container.
  *
@@ -78,13 +78,19 @@ typedef Uint32 SDL_SurfaceFlags;
 /**
  * The scaling mode.
  *
+ * The bicubic, Lanczos and box modes are only available for surface scaling,
+ * textures only support SDL_SCALEMODE_NEAREST and SDL_SCALEMODE_LINEAR.
+ *
  * \since This enum is available since SDL 3.2.0.
  */
 typedef enum SDL_ScaleMode
 {
     SDL_SCALEMODE_INVALID = -1,
     SDL_SCALEMODE_NEAREST, /**< nearest pixel sampling */
-    SDL_SCALEMODE_LINEAR   /**< linear filtering */
+    SDL_SCALEMODE_LINEAR,  /**< linear filtering */
+    SDL_SCALEMODE_BICUBIC, /**< bicubic filtering, surfaces only */
+    SDL_SCALEMODE_LANCZOS, /**< Lanczos filtering with a 3 pixel radius, surfaces only */
+    SDL_SCALEMODE_BOX      /**< area averaging, best for large downscales, surfaces only */
 } SDL_ScaleMode;
 
 /**
@@ -212,6 +218,45 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_CreateSurfaceFrom(int width, int h
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DestroySurface(SDL_Surface *surface);
 
+/**
+ * Statistics about the surface pixel pool.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetSurfacePoolStats
+ */
+typedef struct SDL_SurfacePoolStats
+{
+    Uint64 allocations;                /**< The number of pixel buffers requested from the pool. */
+    Uint64 hits;                       /**< The number of requests satisfied by reusing a freed buffer. */
+    Uint64 bytes_allocated;            /**< The number of bytes of memory currently held by the pool, in use or cached. */
+    Uint64 bytes_allocated_high_water; /**< The largest value bytes_allocated has reached. */
+    Uint64 bytes_cached;               /**< The number of bytes of freed buffers kept for reuse. */
+} SDL_SurfacePoolStats;
+
+/**
+ * Get statistics about the surface pixel pool.
+ *
+ * When SDL_HINT_SURFACE_POOL is enabled, the pixels of new surfaces come from
+ * a pool of buffers bucketed by size, and the pixels of destroyed surfaces go
+ * back to it. `hits` divided by `allocations` gives the hit rate of the pool.
+ *
+ * The statistics include buffers cached by other threads, which may be in the
+ * middle of allocating, so they are only approximate while other threads are
+ * creating or destroying surfaces.
+ *
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_SURFACE_POOL
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetSurfacePoolStats(SDL_SurfacePoolStats *stats);
+
 /**
  * Get the properties associated with a surface.
  *
@@ -366,6 +411,11 @@ extern SDL_DECLSPEC SDL_Palette * SDLCALL SDL_GetSurfacePalette(SDL_Surface *sur
  * This function adds a reference to the alternate version, so you should call
  * SDL_DestroySurface() on the image after this call.
  *
+ * When no version matches a display scale, SDL scales the closest one and
+ * keeps the result for later use at that scale. It is regenerated if the
+ * version is changed with SDL functions, or after SDL_LockSurface(), so lock
+ * the version before writing to its pixels directly.
+ *
  * \param surface the SDL_Surface structure to update.
  * \param image a pointer to an alternate SDL_Surface to associate with this
  *              surface.
@@ -507,6 +557,40 @@ extern SDL_DECLSPEC void SDLCALL SDL_UnlockSurface(SDL_Surface *surface);
  */
 extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio);
 
+/**
+ * Load a BMP image from a seekable SDL data stream, with the specified
+ * properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_LOAD_BMP_FORMAT_NUMBER`: an SDL_PixelFormat value, the format
+ *   of the returned surface. Uncompressed RGB images are decoded row by row
+ *   straight into this format, without an intermediate surface in the
+ *   format of the file. Other images are converted after loading. If this is
+ *   not set, the surface has the format closest to the one in the file, as
+ *   with SDL_LoadBMP_IO().
+ *
+ * The new surface should be freed with SDL_DestroySurface(). Not doing so
+ * will result in a memory leak.
+ *
+ * \param src the data stream for the surface.
+ * \param closeio if true, calls SDL_CloseIO() on `src` before returning, even
+ *                in the case of an error.
+ * \param props the properties to use, or 0 for the defaults.
+ * \returns a pointer to a new SDL_Surface structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroySurface
+ * \sa SDL_LoadBMP_IO
+ */
+extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadBMPWithProperties(SDL_IOStream *src, bool closeio, SDL_PropertiesID props);
+
+#define SDL_PROP_LOAD_BMP_FORMAT_NUMBER "SDL.load_bmp.format"
+
 /**
  * Load a BMP image from a file.
  *
@@ -534,7 +618,9 @@ extern SDL_DECLSPEC SDL_Surface * SDLCALL SDL_LoadBMP(const char *file);
  * BMP directly. Other RGB formats with 8-bit or higher get converted to a
  * 24-bit surface or, if they have an alpha mask or a colorkey, to a 32-bit
  * surface before they are saved. YUV and paletted 1-bit and 4-bit formats are
- * not supported.
+ * not supported. RGB surfaces without a colorkey are converted a batch of
+ * rows at a time as they are written, so no full size copy of the surface is
+ * made.
  *
  * \param surface the SDL_Surface structure containing the image to be saved.
  * \param dst a data stream to save to.
@@ -559,7 +645,9 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStre
  * BMP directly. Other RGB formats with 8-bit or higher get converted to a
  * 24-bit surface or, if they have an alpha mask or a colorkey, to a 32-bit
  * surface before they are saved. YUV and paletted 1-bit and 4-bit formats are
- * not supported.
+ * not supported. RGB surfaces without a colorkey are converted a batch of
+ * rows at a time as they are written, so no full size copy of the surface is
+ * made.
  *
  * \param surface the SDL_Surface structure containing the image to be saved.
  * \param file a file to save to.
@@ -1387,6 +1475,86 @@ extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurfaceTiledWithScale(SDL_Surface *src,
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_width, int right_width, int top_height, int bottom_height, float scale, SDL_ScaleMode scaleMode, SDL_Surface *dst, const SDL_Rect *dstrect);
 
+/**
+ * A 9-grid prepared for repeated drawing with SDL_BlitPrepared9Grid().
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_Prepare9Grid
+ */
+typedef struct SDL_Prepared9Grid SDL_Prepared9Grid;
+
+/**
+ * Prepare a 9-grid for drawing the same surface many times.
+ *
+ * This takes the same parameters as SDL_BlitSurface9Grid(), without the
+ * destination. The grid keeps the last size it was drawn at, so drawing it
+ * again at that size is a single unscaled blit instead of nine scaled ones.
+ * It's most useful when many panels of the same size are drawn every frame.
+ *
+ * The pixels of `src` are captured when the grid is first drawn at a new
+ * size. If they change, destroy the grid and prepare a new one. Changes to
+ * the blend mode, color and alpha modulation and colorkey of `src` are picked
+ * up on every draw.
+ *
+ * \param src the SDL_Surface structure to be copied from. A reference is
+ *            kept until the grid is destroyed.
+ * \param srcrect the SDL_Rect structure representing the rectangle to be used
+ *                for the 9-grid, or NULL to use the entire surface.
+ * \param left_width the width, in pixels, of the left corners in `srcrect`.
+ * \param right_width the width, in pixels, of the right corners in `srcrect`.
+ * \param top_height the height, in pixels, of the top corners in `srcrect`.
+ * \param bottom_height the height, in pixels, of the bottom corners in
+ *                      `srcrect`.
+ * \param scale the scale used to transform the corner of `srcrect` into the
+ *              corner of the destination rectangle, or 0.0f for an unscaled
+ *              blit.
+ * \param scaleMode scale algorithm to be used.
+ * \returns the prepared grid or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety Only one thread should be using the `src` surface and the
+ *               grid at any given time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BlitPrepared9Grid
+ * \sa SDL_DestroyPrepared9Grid
+ */
+extern SDL_DECLSPEC SDL_Prepared9Grid * SDLCALL SDL_Prepare9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_width, int right_width, int top_height, int bottom_height, float scale, SDL_ScaleMode scaleMode);
+
+/**
+ * Draw a prepared 9-grid to a destination surface.
+ *
+ * \param grid the grid to draw.
+ * \param dst the SDL_Surface structure that is the blit target.
+ * \param dstrect the SDL_Rect structure representing the target rectangle in
+ *                the destination surface, or NULL to fill the entire surface.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety Only one thread should be using the grid and the `dst`
+ *               surface at any given time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_Prepare9Grid
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_BlitPrepared9Grid(SDL_Prepared9Grid *grid, SDL_Surface *dst, const SDL_Rect *dstrect);
+
+/**
+ * Destroy a prepared 9-grid and release its reference to the source surface.
+ *
+ * \param grid the grid to destroy, may be NULL.
+ *
+ * \threadsafety Only one thread should be using the grid at any given time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_Prepare9Grid
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyPrepared9Grid(SDL_Prepared9Grid *grid);
+
 /**
  * Map an RGB triple to an opaque pixel value for a surface.
  *
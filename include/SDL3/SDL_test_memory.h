@@ -36,6 +36,19 @@
 extern "C" {
 #endif
 
+/**
+ * Allocation statistics for a single memory tag
+ *
+ * \sa SDLTest_GetAllocationStats
+ */
+typedef struct SDLTest_AllocationStats
+{
+    Uint64 current_bytes;       /**< Bytes currently allocated */
+    Uint64 peak_bytes;          /**< The most bytes allocated at any one time */
+    Uint64 num_allocations;     /**< Allocations made since tracking started, including reallocations */
+    Uint64 num_frees;           /**< Allocations freed since tracking started */
+} SDLTest_AllocationStats;
+
 /**
  * Start tracking SDL memory allocations
  *
@@ -57,6 +70,22 @@ void SDLCALL SDLTest_RandFillAllocations(void);
  */
 void SDLCALL SDLTest_LogAllocations(void);
 
+/**
+ * Get the allocation statistics for an SDL subsystem
+ *
+ * \param tag the subsystem to query, see SDL_GetMemoryTag()
+ * \param stats filled in with the statistics for that subsystem
+ * \returns true on success or false if allocations aren't being tracked; call SDL_GetError() for more information.
+ */
+bool SDLCALL SDLTest_GetAllocationStats(SDL_MemoryTag tag, SDLTest_AllocationStats *stats);
+
+/**
+ * Print a summary of allocations by subsystem, with the allocation rate since tracking started
+ *
+ * \param max_call_sites the number of busiest call sites to print, or 0 to skip them
+ */
+void SDLCALL SDLTest_LogAllocationStats(int max_call_sites);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -41,6 +41,7 @@
  */
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_cpuinfo.h>
 #include <SDL3/SDL_error.h>
 #include <SDL3/SDL_properties.h>
 
@@ -229,6 +230,12 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThread(SDL_ThreadFunction fn,
  *   only parameter. Optional, defaults to NULL.
  * - `SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER`: the size, in bytes, of the new
  *   thread's stack. Optional, defaults to 0 (system-defined default).
+ * - `SDL_PROP_THREAD_CREATE_AFFINITY_NUMBER`: a bitmask of the logical CPUs
+ *   the new thread may run on, as described for
+ *   SDL_SetCurrentThreadAffinity(). Optional, defaults to 0 (no restriction).
+ * - `SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER`: an SDL_CPUCoreType the new
+ *   thread should prefer, as described for SDL_SetCurrentThreadCoreType().
+ *   Optional, defaults to `SDL_CPU_CORE_ANY`. (since SDL 3.4.0)
  *
  * SDL makes an attempt to report `SDL_PROP_THREAD_CREATE_NAME_STRING` to the
  * system, so that debuggers can display it. Not all platforms support this.
@@ -284,6 +291,8 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithProperties(SDL_Prop
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "SDL.thread.create.name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "SDL.thread.create.userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "SDL.thread.create.stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_NUMBER                         "SDL.thread.create.affinity"
+#define SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER                        "SDL.thread.create.core_type"
 
 /* end wiki documentation for macros that are meant to look like functions. */
 #endif
@@ -352,6 +361,8 @@ extern SDL_DECLSPEC SDL_Thread * SDLCALL SDL_CreateThreadWithPropertiesRuntime(S
 #define SDL_PROP_THREAD_CREATE_NAME_STRING                             "SDL.thread.create.name"
 #define SDL_PROP_THREAD_CREATE_USERDATA_POINTER                        "SDL.thread.create.userdata"
 #define SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER                        "SDL.thread.create.stacksize"
+#define SDL_PROP_THREAD_CREATE_AFFINITY_NUMBER                         "SDL.thread.create.affinity"
+#define SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER                        "SDL.thread.create.core_type"
 #endif
 
 
@@ -416,6 +427,59 @@ extern SDL_DECLSPEC SDL_ThreadID SDLCALL SDL_GetThreadID(SDL_Thread *thread);
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_SetCurrentThreadPriority(SDL_ThreadPriority priority);
 
+/**
+ * Restrict the current thread to a set of logical CPUs.
+ *
+ * Bit N of `mask` allows the thread to run on logical CPU N, so only the
+ * first 64 logical CPUs can be named. SDL_GetCPUCoreMask() returns masks
+ * for each kind of core.
+ *
+ * Pinning threads is usually worse than letting the OS schedule them; it's
+ * meant for cases like keeping a latency-sensitive audio thread off of cores
+ * that are busy with other work. Some platforms (Apple's, for example) have
+ * no way to do this and will fail.
+ *
+ * \param mask a bitmask of allowed logical CPUs, must not be 0.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetCPUCoreMask
+ * \sa SDL_SetCurrentThreadCoreType
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetCurrentThreadAffinity(Uint64 mask);
+
+/**
+ * Ask for the current thread to be scheduled on a particular kind of core.
+ *
+ * On hybrid CPUs this keeps deadline-sensitive threads (audio, rendering) on
+ * performance cores, or background work on efficiency cores. Each platform
+ * does this its own way:
+ *
+ * - Windows: the thread's selected CPU sets, which the scheduler treats as a
+ *   strong preference rather than a hard restriction.
+ * - Apple platforms: the thread's quality-of-service class
+ *   (`QOS_CLASS_USER_INTERACTIVE` for performance, `QOS_CLASS_UTILITY` for
+ *   efficiency). This fails if the thread's scheduling policy was already
+ *   changed, for example by SDL_SetCurrentThreadPriority().
+ * - Linux and Android: the thread's CPU affinity, using the topology that
+ *   SDL_GetCPUCoreMask() reports.
+ *
+ * If the system has no cores of the requested type, this does nothing and
+ * returns true. `SDL_CPU_CORE_ANY` removes any earlier preference.
+ *
+ * \param type the SDL_CPUCoreType to prefer.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetNumCPUCoresOfType
+ * \sa SDL_SetCurrentThreadAffinity
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetCurrentThreadCoreType(SDL_CPUCoreType type);
+
 /**
  * Wait for a thread to finish.
  *
@@ -569,6 +633,128 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetTLS(SDL_TLSID *id, const void *value, SD
  */
 extern SDL_DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+/**
+ * The function passed to SDL_SubmitJob() that will be run on a worker thread.
+ *
+ * \param userdata what was passed as `userdata` to SDL_SubmitJob().
+ *
+ * \threadsafety This will run on one of SDL's worker threads.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * Run a function asynchronously on SDL's shared pool of worker threads.
+ *
+ * SDL keeps one pool of worker threads, sized to the number of CPU cores,
+ * that is shared by SDL's own background work (such as the generic
+ * SDL_AsyncIO backend) and the app. Using it instead of creating your own
+ * threads keeps the app and SDL from competing for the same cores.
+ *
+ * Jobs are meant to be short pieces of work; a job that blocks for a long
+ * time holds up a worker thread that other jobs could have used. Jobs can
+ * submit more jobs, which will preferably run on the same worker. The order
+ * in which jobs run is not defined, so use your own synchronization (for
+ * example, an SDL_AtomicInt or SDL_Semaphore) to find out when a job has
+ * finished.
+ *
+ * The worker threads are started the first time this function is called. On
+ * platforms without thread support, the job runs immediately, before this
+ * function returns. Jobs that haven't run yet when SDL_Quit() is called are
+ * run before it returns.
+ *
+ * \param callback the function to run.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SubmitJob(SDL_JobFunction callback, void *userdata);
+
+/**
+ * The function passed to SDL_ParallelFor() to process part of a range.
+ *
+ * \param userdata what was passed as `userdata` to SDL_ParallelFor().
+ * \param start the first index of this piece of the range.
+ * \param end one past the last index of this piece of the range.
+ *
+ * \threadsafety This may run on any of SDL's worker threads, or the thread
+ *               that called SDL_ParallelFor(), several at a time.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_ParallelFor
+ */
+typedef void (SDLCALL *SDL_ParallelForCallback)(void *userdata, int start, int end);
+
+/**
+ * Process a range of indices in parallel on SDL's worker threads.
+ *
+ * The range from `start` up to (but not including) `end` is cut into pieces
+ * of `grain_size` indices, and `callback` is called once for each piece,
+ * spread across SDL's job workers (see SDL_SubmitJob()) and the calling
+ * thread. Pieces are handed out as threads become free, so uneven amounts of
+ * work per index still balance out. This function returns once every piece
+ * has been processed.
+ *
+ * Pick a grain size that makes each piece worth at least a few microseconds
+ * of work; pass 0 to let SDL split the range into a few pieces per worker.
+ *
+ * It is safe to call this from inside a job or another SDL_ParallelFor()
+ * callback; the waiting thread runs queued work instead of blocking.
+ *
+ * \param start the first index to process.
+ * \param end one past the last index to process.
+ * \param grain_size the number of indices per call to `callback`, or 0 to
+ *                   choose automatically.
+ * \param callback the function to call for each piece of the range.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ParallelSort
+ * \sa SDL_SubmitJob
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ParallelFor(int start, int end, int grain_size, SDL_ParallelForCallback callback, void *userdata);
+
+/**
+ * Sort an array using SDL's worker threads.
+ *
+ * This sorts the same way as SDL_qsort_r(), but large arrays are split into
+ * pieces that are sorted on SDL's job workers and then merged, also in
+ * parallel. Small arrays, or systems with a single worker, are simply
+ * sorted with SDL_qsort_r() on the calling thread.
+ *
+ * The sort is not stable. Merging needs a scratch buffer the size of the
+ * array; if that can't be allocated, the array is sorted on the calling
+ * thread instead.
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of the elements in the array.
+ * \param compare a function used to compare elements in the array. It is
+ *                called from several threads at once.
+ * \param userdata a pointer to pass to the compare function.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_qsort_r
+ * \sa SDL_ParallelFor
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
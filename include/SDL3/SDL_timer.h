@@ -43,6 +43,7 @@
 
 #include <SDL3/SDL_stdinc.h>
 #include <SDL3/SDL_error.h>
+#include <SDL3/SDL_properties.h>
 
 #include <SDL3/SDL_begin_code.h>
 /* Set up for C function definitions, even when using C++ */
@@ -440,6 +441,232 @@ extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ * Create a timer with the specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_TIMER_CREATE_INTERVAL_NS_NUMBER`: the timer delay, in
+ *   nanoseconds, passed to the callback. Required.
+ * - `SDL_PROP_TIMER_CREATE_CALLBACK_POINTER`: an SDL_TimerCallback to call
+ *   when the timer fires, with the interval converted to milliseconds.
+ * - `SDL_PROP_TIMER_CREATE_NS_CALLBACK_POINTER`: an SDL_NSTimerCallback to
+ *   call when the timer fires. Exactly one of the two callbacks is required.
+ * - `SDL_PROP_TIMER_CREATE_USERDATA_POINTER`: a pointer that is passed to the
+ *   callback. Optional, defaults to NULL.
+ * - `SDL_PROP_TIMER_CREATE_JOB_WORKER_BOOLEAN`: true if the callback should
+ *   run on SDL's job workers (see SDL_SubmitJob()) instead of the timer
+ *   thread. Optional, defaults to false.
+ *
+ * All timers normally run one after another on a single thread, so a
+ * callback that takes a long time delays every other timer. Timers that do
+ * a lot of work should be created with
+ * `SDL_PROP_TIMER_CREATE_JOB_WORKER_BOOLEAN`, which keeps them out of the
+ * way of the rest. Such a timer still never runs more than one callback at a
+ * time; its next interval starts once the callback that returned it was
+ * called.
+ *
+ * \param props the properties to use.
+ * \returns a timer ID or 0 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_AddTimerNS
+ * \sa SDL_GetTimerStats
+ * \sa SDL_RemoveTimer
+ */
+extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_TIMER_CREATE_INTERVAL_NS_NUMBER    "SDL.timer.create.interval_ns"
+#define SDL_PROP_TIMER_CREATE_CALLBACK_POINTER      "SDL.timer.create.callback"
+#define SDL_PROP_TIMER_CREATE_NS_CALLBACK_POINTER   "SDL.timer.create.ns_callback"
+#define SDL_PROP_TIMER_CREATE_USERDATA_POINTER      "SDL.timer.create.userdata"
+#define SDL_PROP_TIMER_CREATE_JOB_WORKER_BOOLEAN    "SDL.timer.create.job_worker"
+
+/**
+ * Timing statistics collected for a timer.
+ *
+ * Lateness is how long after its scheduled time a callback actually started,
+ * which grows when other timers' callbacks on the same thread run long.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetTimerStats
+ */
+typedef struct SDL_TimerStats
+{
+    Uint64 num_calls;           /**< Number of times the callback has been called */
+    Uint64 total_callback_ns;   /**< Sum of how long each call to the callback took, in nanoseconds */
+    Uint64 max_callback_ns;     /**< The longest any call to the callback has taken, in nanoseconds */
+    Uint64 total_lateness_ns;   /**< Sum of how late each call started, in nanoseconds */
+    Uint64 max_lateness_ns;     /**< The latest any call has started, in nanoseconds */
+} SDL_TimerStats;
+
+/**
+ * Get the timing statistics of a timer.
+ *
+ * The statistics of a timer that stopped by returning 0 from its callback
+ * may stop being available once a new timer is created.
+ *
+ * \param id the ID of the timer to query.
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddTimerWithProperties
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats);
+
+/**
+ * An object that paces a loop to a fixed period, such as one frame.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateFramePacer
+ */
+typedef struct SDL_FramePacer SDL_FramePacer;
+
+/**
+ * Timing statistics collected by a frame pacer.
+ *
+ * A deadline is missed when SDL_WaitFramePacer() is called after the time it
+ * should have returned at, in which case it returns immediately and the next
+ * deadline is measured from that point.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetFramePacerStats
+ */
+typedef struct SDL_FramePacerStats
+{
+    Uint64 num_frames;          /**< Number of calls to SDL_WaitFramePacer() */
+    Uint64 missed_deadlines;    /**< Number of frames where the deadline had already passed */
+    Uint64 total_lateness_ns;   /**< Sum of how late each frame was, in nanoseconds */
+    Uint64 max_lateness_ns;     /**< The latest any frame has been, in nanoseconds */
+    Uint64 spin_ns;             /**< How long SDL currently busy-waits at the end of each frame, in nanoseconds */
+} SDL_FramePacerStats;
+
+/**
+ * Create an object that paces a loop to a fixed period.
+ *
+ * Call SDL_WaitFramePacer() once per iteration of the loop, and it will
+ * return at regular intervals of `period_ns`, much like calling
+ * SDL_DelayPrecise() with the time remaining in each frame, but measured
+ * against fixed deadlines so that errors don't accumulate.
+ *
+ * The pacer sleeps until shortly before each deadline and busy-waits for the
+ * rest. It measures how far the system overshoots its sleeps and adjusts
+ * how long it busy-waits to match, so it uses little CPU on systems with
+ * precise sleeps.
+ *
+ * \param period_ns the time between deadlines, in nanoseconds.
+ * \returns a new frame pacer or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyFramePacer
+ * \sa SDL_WaitFramePacer
+ */
+extern SDL_DECLSPEC SDL_FramePacer * SDLCALL SDL_CreateFramePacer(Uint64 period_ns);
+
+/**
+ * Change the period of a frame pacer.
+ *
+ * The new period takes effect from the next call to SDL_WaitFramePacer().
+ *
+ * \param pacer the frame pacer to change.
+ * \param period_ns the time between deadlines, in nanoseconds.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should be called on the thread that uses the
+ *               frame pacer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateFramePacer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetFramePacerPeriod(SDL_FramePacer *pacer, Uint64 period_ns);
+
+/**
+ * Wait until the next deadline of a frame pacer.
+ *
+ * The first call returns one period after the pacer was created or last
+ * reset with SDL_ResetFramePacer(). If a deadline has already passed, this
+ * returns immediately and counts it as missed.
+ *
+ * \param pacer the frame pacer to wait on.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should be called on the thread that uses the
+ *               frame pacer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateFramePacer
+ * \sa SDL_GetFramePacerStats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WaitFramePacer(SDL_FramePacer *pacer);
+
+/**
+ * Restart a frame pacer's deadlines from the current time and clear its
+ * statistics.
+ *
+ * This is useful after a pause, like loading a level, so that the first
+ * frame afterwards isn't counted as missed.
+ *
+ * \param pacer the frame pacer to reset.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should be called on the thread that uses the
+ *               frame pacer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_ResetFramePacer(SDL_FramePacer *pacer);
+
+/**
+ * Get the timing statistics of a frame pacer.
+ *
+ * \param pacer the frame pacer to query.
+ * \param stats a pointer filled in with the statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should be called on the thread that uses the
+ *               frame pacer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetFramePacerStats(SDL_FramePacer *pacer, SDL_FramePacerStats *stats);
+
+/**
+ * Destroy a frame pacer.
+ *
+ * \param pacer the frame pacer to destroy, may be NULL.
+ *
+ * \threadsafety This function should be called on the thread that uses the
+ *               frame pacer.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateFramePacer
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyFramePacer(SDL_FramePacer *pacer);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -0,0 +1,221 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/**
+ * # CategoryTrace
+ *
+ * SDL can report what it is doing internally as a stream of trace events:
+ * named zones that begin and end on a thread, counters, and thread names.
+ * SDL emits zones around expensive internal work, such as flushing the
+ * render command queue, pumping events, mixing audio and submitting GPU
+ * command buffers, and apps can add their own zones to the same stream.
+ *
+ * Events can be delivered to a callback, for forwarding to a profiler like
+ * Tracy or Perfetto, or recorded into a ring buffer and saved in the Chrome
+ * trace event format, which can be opened with https://ui.perfetto.dev or
+ * chrome://tracing.
+ *
+ * Tracing is only compiled into SDL when it is built with `-Dprofiler=true`.
+ * Otherwise these functions do nothing, and SDL_StartTraceCapture() and
+ * SDL_SetTraceCallback() report that tracing is unsupported.
+ */
+
+#ifndef SDL_trace_h_
+#define SDL_trace_h_
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_error.h>
+#include <SDL3/SDL_thread.h>
+
+#include <SDL3/SDL_begin_code.h>
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The types of trace events.
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_TraceEvent
+ */
+typedef enum SDL_TraceEventType
+{
+    SDL_TRACE_EVENT_ZONE_BEGIN,   /**< A zone started on the calling thread. */
+    SDL_TRACE_EVENT_ZONE_END,     /**< The innermost zone on the calling thread ended. */
+    SDL_TRACE_EVENT_COUNTER,      /**< A counter was set to a new value. */
+    SDL_TRACE_EVENT_THREAD_NAME   /**< The calling thread was given a name. */
+} SDL_TraceEventType;
+
+/**
+ * A single trace event.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_TraceCallback
+ */
+typedef struct SDL_TraceEvent
+{
+    SDL_TraceEventType type;    /**< the type of event. */
+    const char *name;           /**< the zone, counter or thread name. */
+    SDL_ThreadID thread;        /**< the thread the event happened on. */
+    Uint64 timestamp;           /**< the time of the event, in SDL_GetTicksNS() time. */
+    double value;               /**< the counter value, for SDL_TRACE_EVENT_COUNTER. */
+} SDL_TraceEvent;
+
+/**
+ * A callback that receives trace events.
+ *
+ * \param userdata what was passed as `userdata` to SDL_SetTraceCallback().
+ * \param event the trace event. The pointer and the name are only valid
+ *              during the callback, except that zone and counter names from
+ *              SDL itself are always string literals.
+ *
+ * \threadsafety This callback is called on whichever thread the event
+ *               happened on, possibly several at once, and must be
+ *               thread-safe. It should be fast, since it runs inside the
+ *               code being traced.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetTraceCallback
+ */
+typedef void (SDLCALL *SDL_TraceCallback)(void *userdata, const SDL_TraceEvent *event);
+
+/**
+ * Set a callback that receives every trace event.
+ *
+ * This is the way to forward SDL's zones to an external profiler. It can be
+ * used at the same time as a capture started with SDL_StartTraceCapture().
+ *
+ * \param callback the function to call for each event, or NULL to stop.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure, e.g. if SDL was built without
+ *          tracing; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread. When it
+ *               returns, the previous callback is no longer being called.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetTraceCallback(SDL_TraceCallback callback, void *userdata);
+
+/**
+ * Start recording trace events into a ring buffer.
+ *
+ * Once the buffer is full the oldest events are overwritten, so the capture
+ * always holds the most recent `max_events` events. Any capture that was
+ * already running is discarded.
+ *
+ * \param max_events the number of events to keep, or 0 for a default of one
+ *                   million.
+ * \returns true on success or false on failure, e.g. if SDL was built without
+ *          tracing; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_StopTraceCapture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_StartTraceCapture(int max_events);
+
+/**
+ * Stop recording trace events and save them in the Chrome trace event format.
+ *
+ * \param file the file to write the JSON trace to, or NULL to discard the
+ *             capture.
+ * \returns true on success or false on failure, e.g. if no capture was
+ *          running; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_StartTraceCapture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_StopTraceCapture(const char *file);
+
+/**
+ * Begin a zone on the calling thread.
+ *
+ * Zones nest, and must be ended on the thread they began on with
+ * SDL_EndTraceZone(). This is cheap when nothing is tracing.
+ *
+ * \param name the name of the zone. The string must stay valid until any
+ *             running capture has been stopped, so a string literal is best.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_EndTraceZone
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_BeginTraceZone(const char *name);
+
+/**
+ * End the innermost zone on the calling thread.
+ *
+ * \param name the name of the zone, the same as was passed to
+ *             SDL_BeginTraceZone().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_BeginTraceZone
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_EndTraceZone(const char *name);
+
+/**
+ * Record a new value for a counter.
+ *
+ * \param name the name of the counter. The string must stay valid until any
+ *             running capture has been stopped, so a string literal is best.
+ * \param value the new value.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_SetTraceCounter(const char *name, double value);
+
+/**
+ * Name the calling thread in traces.
+ *
+ * Threads created with SDL_CreateThread() are named automatically.
+ *
+ * \param name the name of the thread. The string is copied.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_SetTraceThreadName(const char *name);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include <SDL3/SDL_close_code.h>
+
+#endif /* SDL_trace_h_ */
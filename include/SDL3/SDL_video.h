@@ -608,6 +608,13 @@ extern SDL_DECLSPEC SDL_DisplayID SDLCALL SDL_GetPrimaryDisplay(void);
  *   headroom above the SDR white point. This is for informational and
  *   diagnostic purposes only, as not all platforms provide this information
  *   at the display level.
+ * - `SDL_PROP_DISPLAY_VRR_CAPABLE_BOOLEAN`: true if the display supports
+ *   variable refresh rate (adaptive sync). (Since SDL 3.4.0)
+ * - `SDL_PROP_DISPLAY_VRR_ENABLED_BOOLEAN`: true if variable refresh rate is
+ *   currently enabled for the display. (Since SDL 3.4.0)
+ *
+ * These are only set on platforms that can detect variable refresh rate
+ * support, currently KMS/DRM and macOS 12 or later.
  *
  * On KMS/DRM:
  *
@@ -628,6 +635,8 @@ extern SDL_DECLSPEC SDL_DisplayID SDLCALL SDL_GetPrimaryDisplay(void);
 extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetDisplayProperties(SDL_DisplayID displayID);
 
 #define SDL_PROP_DISPLAY_HDR_ENABLED_BOOLEAN             "SDL.display.HDR_enabled"
+#define SDL_PROP_DISPLAY_VRR_CAPABLE_BOOLEAN             "SDL.display.VRR_capable"
+#define SDL_PROP_DISPLAY_VRR_ENABLED_BOOLEAN             "SDL.display.VRR_enabled"
 #define SDL_PROP_DISPLAY_KMSDRM_PANEL_ORIENTATION_NUMBER "SDL.display.KMSDRM.panel_orientation"
 
 /**
@@ -2421,6 +2430,93 @@ extern SDL_DECLSPEC bool SDLCALL SDL_UpdateWindowSurfaceRects(SDL_Window *window
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_DestroyWindowSurface(SDL_Window *window);
 
+/**
+ * A callback that receives each frame presented by an offscreen window.
+ *
+ * `frame` is the window surface itself, not a copy, so it's only valid for
+ * the duration of the callback and must not be modified or freed.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetOffscreenFrameCallback().
+ * \param window the window that presented the frame.
+ * \param frame the window surface holding the presented frame.
+ * \param rects the areas of the surface that changed, in pixels.
+ * \param numrects the number of rectangles.
+ *
+ * \threadsafety This callback is called on the thread that called
+ *               SDL_UpdateWindowSurface() or SDL_UpdateWindowSurfaceRects().
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetOffscreenFrameCallback
+ */
+typedef void (SDLCALL *SDL_OffscreenFrameCallback)(void *userdata, SDL_Window *window, SDL_Surface *frame, const SDL_Rect *rects, int numrects);
+
+/**
+ * Set a callback to receive the frames presented by an offscreen window.
+ *
+ * This lets headless apps pull frames out of the "offscreen" video driver
+ * without going through files: every SDL_UpdateWindowSurface() or
+ * SDL_UpdateWindowSurfaceRects() call hands the window surface, and the
+ * areas that changed, to the callback.
+ *
+ * This only works with the window surface API; frames rendered with OpenGL,
+ * Vulkan or the GPU API are not delivered.
+ *
+ * \param window the window to receive frames from.
+ * \param callback the function to call for each frame, or NULL to stop.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information. This fails if the current video driver isn't
+ *          "offscreen".
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetWindowSurface
+ * \sa SDL_UpdateWindowSurfaceRects
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetOffscreenFrameCallback(SDL_Window *window, SDL_OffscreenFrameCallback callback, void *userdata);
+
+/**
+ * Information about when a window's frames actually reached the screen.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetWindowPresentationFeedback
+ */
+typedef struct SDL_PresentationFeedback
+{
+    Uint64 frames;          /**< the number of frames shown since the feedback started */
+    Uint64 present_ns;      /**< when the last frame was shown, in SDL_GetTicksNS() time */
+    Uint64 refresh_ns;      /**< the display refresh interval, in nanoseconds, or 0 if unknown */
+    Uint64 missed_vblanks;  /**< the total number of vblanks that passed without a new frame being shown when one was expected */
+} SDL_PresentationFeedback;
+
+/**
+ * Get feedback about when a window's frames were actually presented.
+ *
+ * This reports the hardware or compositor timestamp of the last frame that
+ * reached the screen, which is more accurate than timing the calls to present
+ * and can be used for frame pacing and latency measurements.
+ *
+ * Feedback is available on KMSDRM, and on Windows for window surfaces
+ * presented with SDL_HINT_WINDOWS_FRAMEBUFFER_FLIP_MODEL. Frames presented
+ * with OpenGL on KMSDRM, including with SDL_Renderer, are covered.
+ *
+ * \param window the window to query.
+ * \param feedback a pointer filled in with the presentation feedback.
+ * \returns true on success or false on failure, e.g. if the platform doesn't
+ *          provide presentation feedback or nothing has been presented yet;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetWindowPresentationFeedback(SDL_Window *window, SDL_PresentationFeedback *feedback);
+
 /**
  * Set a window's keyboard grab mode.
  *
@@ -78,6 +78,7 @@
 #cmakedefine HAVE_MEMCPY 1
 #cmakedefine HAVE_MEMMOVE 1
 #cmakedefine HAVE_MEMCMP 1
+#cmakedefine HAVE_MEMCHR 1
 #cmakedefine HAVE_WCSLEN 1
 #cmakedefine HAVE_WCSNLEN 1
 #cmakedefine HAVE_WCSLCPY 1
@@ -137,6 +137,7 @@ typedef unsigned int uintptr_t;
 #define HAVE_MEMCPY 1
 #define HAVE_MEMMOVE 1
 #define HAVE_MEMCMP 1
+#define HAVE_MEMCHR 1
 #define HAVE_STRLEN 1
 #define HAVE__STRREV 1
 #define HAVE_STRCHR 1
@@ -78,6 +78,7 @@
 #define HAVE_MEMCPY 1
 #define HAVE_MEMMOVE 1
 #define HAVE_MEMCMP 1
+#define HAVE_MEMCHR 1
 #define HAVE_STRLEN 1
 #define HAVE__STRREV 1
 #define HAVE_STRCHR 1
@@ -39,7 +39,9 @@
 #include "SDL_assert_c.h"
 #include "SDL_hints_c.h"
 #include "SDL_log_c.h"
+#include "SDL_memoryusage_c.h"
 #include "SDL_properties_c.h"
+#include "SDL_trace_c.h"
 #include "audio/SDL_sysaudio.h"
 #include "camera/SDL_camera_c.h"
 #include "cpuinfo/SDL_cpuinfo_c.h"
@@ -50,6 +52,7 @@
 #include "render/SDL_sysrender.h"
 #include "sensor/SDL_sensor_c.h"
 #include "stdlib/SDL_getenv_c.h"
+#include "thread/SDL_jobs_c.h"
 #include "thread/SDL_thread_c.h"
 #include "tray/SDL_tray_utils.h"
 #include "video/SDL_pixels_c.h"
@@ -187,6 +190,10 @@ static bool SDL_MainIsReady = true;
 static SDL_ThreadID SDL_MainThreadID = 0;
 static bool SDL_bInMainQuit = false;
 static Uint8 SDL_SubsystemRefCount[32];
+static Uint64 SDL_SubsystemInitTime[32];
+#ifdef SDL_USE_LIBDBUS
+static SDL_Thread *SDL_DBusInitThread = NULL;
+#endif
 
 // Private helper to increment a subsystem's ref counter.
 static void SDL_IncrementSubsystemRefCount(Uint32 subsystem)
@@ -211,6 +218,15 @@ static void SDL_DecrementSubsystemRefCount(Uint32 subsystem)
     }
 }
 
+// Private helper to record how long a subsystem took to initialize, not counting the subsystems it depends on.
+static void SDL_SetSubsystemInitTime(Uint32 subsystem, Uint64 start)
+{
+    const int subsystem_index = SDL_MostSignificantBitIndex32(subsystem);
+    if (subsystem_index >= 0) {
+        SDL_SubsystemInitTime[subsystem_index] = SDL_GetTicksNS() - start;
+    }
+}
+
 // Private helper to check if a system needs init.
 static bool SDL_ShouldInitSubsystem(Uint32 subsystem)
 {
@@ -303,6 +319,16 @@ static void SDL_QuitMainThread(void)
     SDL_QuitTLSData();
 }
 
+#ifdef SDL_USE_LIBDBUS
+static int SDLCALL SDL_DBusInitThreadFunc(void *data)
+{
+    SDL_TRACE_BEGIN("SDL_DBus_Init");
+    SDL_DBus_Init();
+    SDL_TRACE_END("SDL_DBus_Init");
+    return 0;
+}
+#endif
+
 bool SDL_InitSubSystem(SDL_InitFlags flags)
 {
     Uint32 flags_initialized = 0;
@@ -314,7 +340,17 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
     SDL_InitMainThread();
 
 #ifdef SDL_USE_LIBDBUS
-    SDL_DBus_Init();
+    if (SDL_GetHintBoolean(SDL_HINT_DEFERRED_INIT, false)) {
+        // Connecting to the session and system bus can take a while, anything that needs it will wait
+        if (!SDL_DBusInitThread) {
+            SDL_DBusInitThread = SDL_CreateThread(SDL_DBusInitThreadFunc, "SDLDBusInit", NULL);
+        }
+        if (!SDL_DBusInitThread) {
+            SDL_DBus_Init();
+        }
+    } else {
+        SDL_DBus_Init();
+    }
 #endif
 
 #ifdef SDL_PLATFORM_WINDOWS
@@ -328,11 +364,13 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
     // Initialize the event subsystem
     if (flags & SDL_INIT_EVENTS) {
         if (SDL_ShouldInitSubsystem(SDL_INIT_EVENTS)) {
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_EVENTS);
             if (!SDL_InitEvents()) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_EVENTS);
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_EVENTS, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_EVENTS);
         }
@@ -353,6 +391,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
             // On other platforms, this is the definition.
             SDL_MainThreadID = SDL_GetCurrentThreadID();
 
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_VIDEO);
             if (!SDL_VideoInit(NULL)) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_VIDEO);
@@ -361,6 +400,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 SDL_PopError();
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_VIDEO, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_VIDEO);
         }
@@ -380,6 +420,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 goto quit_and_error;
             }
 
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_AUDIO);
             if (!SDL_InitAudio(NULL)) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_AUDIO);
@@ -388,6 +429,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 SDL_PopError();
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_AUDIO, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_AUDIO);
         }
@@ -407,6 +449,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 goto quit_and_error;
             }
 
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_JOYSTICK);
             if (!SDL_InitJoysticks()) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_JOYSTICK);
@@ -415,6 +458,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 SDL_PopError();
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_JOYSTICK, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_JOYSTICK);
         }
@@ -433,6 +477,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 goto quit_and_error;
             }
 
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_GAMEPAD);
             if (!SDL_InitGamepads()) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_GAMEPAD);
@@ -441,6 +486,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 SDL_PopError();
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_GAMEPAD, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_GAMEPAD);
         }
@@ -455,11 +501,13 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
     if (flags & SDL_INIT_HAPTIC) {
 #ifndef SDL_HAPTIC_DISABLED
         if (SDL_ShouldInitSubsystem(SDL_INIT_HAPTIC)) {
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_HAPTIC);
             if (!SDL_InitHaptics()) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_HAPTIC);
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_HAPTIC, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_HAPTIC);
         }
@@ -474,11 +522,13 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
     if (flags & SDL_INIT_SENSOR) {
 #ifndef SDL_SENSOR_DISABLED
         if (SDL_ShouldInitSubsystem(SDL_INIT_SENSOR)) {
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_SENSOR);
             if (!SDL_InitSensors()) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_SENSOR);
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_SENSOR, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_SENSOR);
         }
@@ -498,6 +548,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 goto quit_and_error;
             }
 
+            const Uint64 start = SDL_GetTicksNS();
             SDL_IncrementSubsystemRefCount(SDL_INIT_CAMERA);
             if (!SDL_CameraInit(NULL)) {
                 SDL_DecrementSubsystemRefCount(SDL_INIT_CAMERA);
@@ -506,6 +557,7 @@ bool SDL_InitSubSystem(SDL_InitFlags flags)
                 SDL_PopError();
                 goto quit_and_error;
             }
+            SDL_SetSubsystemInitTime(SDL_INIT_CAMERA, start);
         } else {
             SDL_IncrementSubsystemRefCount(SDL_INIT_CAMERA);
         }
@@ -534,6 +586,19 @@ bool SDL_Init(SDL_InitFlags flags)
     return SDL_InitSubSystem(flags);
 }
 
+Uint64 SDL_GetSubSystemInitTimeNS(SDL_InitFlags flags)
+{
+    Uint64 result = 0;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(SDL_SubsystemInitTime); ++i) {
+        if (flags & (1u << i)) {
+            result += SDL_SubsystemInitTime[i];
+        }
+    }
+    return result;
+}
+
 void SDL_QuitSubSystem(SDL_InitFlags flags)
 {
     // Shut down requested initialized subsystems
@@ -660,16 +725,23 @@ void SDL_Quit(void)
     SDL_CleanupTrays();
 
 #ifdef SDL_USE_LIBDBUS
+    if (SDL_DBusInitThread) {
+        SDL_WaitThread(SDL_DBusInitThread, NULL);
+        SDL_DBusInitThread = NULL;
+    }
     SDL_DBus_Quit();
 #endif
 
     SDL_QuitTimers();
     SDL_QuitAsyncIO();
+    SDL_QuitJobs();
 
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
 
     SDL_QuitPixelFormatDetails();
+    SDL_QuitStretch();
+    SDL_QuitSurfacePool();
 
     SDL_QuitCPUInfo();
 
@@ -678,6 +750,8 @@ void SDL_Quit(void)
      */
     SDL_memset(SDL_SubsystemRefCount, 0x0, sizeof(SDL_SubsystemRefCount));
 
+    SDL_QuitTrace();
+    SDL_QuitMemoryUsage();
     SDL_QuitLog();
     SDL_QuitHints();
     SDL_QuitProperties();
@@ -20,50 +20,185 @@
 */
 #include "SDL_internal.h"
 
-typedef struct SDL_HashItem
-{
-    // TODO: Splitting off values into a separate array might be more cache-friendly
-    const void *key;
-    const void *value;
-    Uint32 hash;
-    Uint32 probe_len : 31;
-    Uint32 live : 1;
-} SDL_HashItem;
+/* This is a Swiss table: one control byte per slot, holding either EMPTY, DELETED, or the top 7
+   bits of the slot's hash, with keys, values and full hashes kept in parallel arrays. Lookups scan
+   the control bytes a group at a time, and only touch a key when its control byte already matches,
+   so a probe usually costs a single SIMD compare and one key comparison.
+ */
+#define GROUP_WIDTH 16u
 
-// Must be a power of 2 >= sizeof(SDL_HashItem)
-#define MAX_HASHITEM_SIZEOF 32u
-SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
+#define CTRL_EMPTY   ((Uint8)0x80)
+#define CTRL_DELETED ((Uint8)0xFE)
 
 // Anything larger than this will cause integer overflows
-#define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
+#define MAX_HASHTABLE_SIZE (0x80000000u / 32u)
+
+typedef struct SDL_HashBuckets
+{
+    struct SDL_HashBuckets *retired;  // older buckets, kept alive for lock-free readers until the table is destroyed
+    Uint32 hash_mask;
+    const void **keys;
+    const void **values;
+    Uint32 *hashes;
+    Uint8 *ctrl;  // hash_mask + 1 + GROUP_WIDTH control bytes, the last GROUP_WIDTH mirror the first ones
+} SDL_HashBuckets;
 
 struct SDL_HashTable
 {
     SDL_RWLock *lock;  // NULL if not created threadsafe
-    SDL_HashItem *table;
+    SDL_HashBuckets *buckets;
     SDL_HashCallback hash;
     SDL_HashKeyMatchCallback keymatch;
     SDL_HashDestroyCallback destroy;
     void *userdata;
-    Uint32 hash_mask;
-    Uint32 max_probe_len;
     Uint32 num_occupied_slots;
+    Uint32 growth_left;  // empty slots we can fill before we need to resize
+    bool lockfree_reads;
+    SDL_AtomicU32 sequence;  // odd while a writer is changing the buckets, if lockfree_reads is set
 };
 
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HASHTABLE_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define HASHTABLE_NEON
+#endif
+
+// Each of these returns a mask with bit N set if control byte N of the group matches
+#ifdef HASHTABLE_SSE2
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 h2)
+{
+    const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)h2)));
+}
+
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)CTRL_EMPTY)));
+}
+
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    // EMPTY and DELETED are the only control bytes with the high bit set
+    return (Uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
+#elif defined(HASHTABLE_NEON)
+static SDL_INLINE Uint32 neon_bitmask(uint8x16_t matches)
+{
+    static const Uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t masked = vandq_u8(matches, vld1q_u8(bits));
+    return (Uint32)vaddv_u8(vget_low_u8(masked)) | ((Uint32)vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 h2)
+{
+    return neon_bitmask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(h2)));
+}
+
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    return neon_bitmask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(CTRL_EMPTY)));
+}
+
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    // EMPTY and DELETED are the only control bytes with the high bit set
+    return neon_bitmask(vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(group)), vdupq_n_s8(0)));
+}
+#else
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 h2)
+{
+    Uint32 result = 0;
+    for (Uint32 i = 0; i < GROUP_WIDTH; ++i) {
+        if (group[i] == h2) {
+            result |= (1u << i);
+        }
+    }
+    return result;
+}
+
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    return group_match(group, CTRL_EMPTY);
+}
+
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    Uint32 result = 0;
+    for (Uint32 i = 0; i < GROUP_WIDTH; ++i) {
+        if (group[i] & 0x80) {
+            result |= (1u << i);
+        }
+    }
+    return result;
+}
+#endif
+
+static SDL_INLINE Uint32 lowest_bit_index(Uint32 mask)
+{
+    SDL_assert(mask != 0);
+#if defined(__GNUC__) || defined(__clang__)
+    return (Uint32)__builtin_ctz(mask);
+#else
+    Uint32 index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+static SDL_INLINE bool ctrl_is_full(Uint8 ctrl)
+{
+    return (ctrl & 0x80) == 0;
+}
+
+static SDL_INLINE Uint8 hash_h2(Uint32 hash)
+{
+    return (Uint8)(hash >> 25);
+}
+
+static SDL_INLINE Uint32 capacity_to_growth(Uint32 capacity)
+{
+    // Keep the load factor at 7/8, so every probe sequence reaches an empty slot
+    return capacity - (capacity / 8);
+}
 
 static Uint32 CalculateHashBucketsFromEstimate(int estimated_capacity)
 {
     if (estimated_capacity <= 0) {
-        return 4;  // start small, grow as necessary.
+        return GROUP_WIDTH;  // start small, grow as necessary.
+    }
+
+    const Uint32 estimated32 = (Uint32) SDL_min(estimated_capacity, (int)capacity_to_growth(MAX_HASHTABLE_SIZE));
+    Uint32 buckets = GROUP_WIDTH;
+    while (capacity_to_growth(buckets) < estimated32) {
+        buckets <<= 1;
     }
 
-    const Uint32 estimated32 = (Uint32) estimated_capacity;
-    Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(estimated32);
-    if (!SDL_HasExactlyOneBitSet32(estimated32)) {
-        buckets <<= 1;  // need next power of two up to fit overflow capacity bits.
+    return buckets;
+}
+
+static SDL_HashBuckets *allocate_buckets(Uint32 num_buckets)
+{
+    const size_t pointers_size = num_buckets * sizeof(void *);
+    const size_t hashes_size = num_buckets * sizeof(Uint32);
+    const size_t ctrl_size = num_buckets + GROUP_WIDTH;
+    SDL_HashBuckets *buckets = (SDL_HashBuckets *)SDL_malloc(sizeof(*buckets) + (pointers_size * 2) + hashes_size + ctrl_size);
+    if (!buckets) {
+        return NULL;
     }
 
-    return SDL_min(buckets, MAX_HASHTABLE_SIZE);
+    Uint8 *mem = (Uint8 *)(buckets + 1);
+    buckets->retired = NULL;
+    buckets->hash_mask = num_buckets - 1;
+    buckets->keys = (const void **)mem;
+    buckets->values = (const void **)(mem + pointers_size);
+    buckets->hashes = (Uint32 *)(mem + (pointers_size * 2));
+    buckets->ctrl = mem + (pointers_size * 2) + hashes_size;
+    SDL_memset(buckets->ctrl, CTRL_EMPTY, ctrl_size);
+    return buckets;
 }
 
 SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_HashCallback hash,
@@ -82,15 +217,21 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
             SDL_DestroyHashTable(table);
             return NULL;
         }
+
+        /* Tables whose keys are compared by value never dereference a stored key, so lookups can
+           run against buckets a writer is changing and simply retry, instead of taking the lock. */
+        if (keymatch == SDL_KeyMatchID || keymatch == SDL_KeyMatchPointer) {
+            table->lockfree_reads = true;
+        }
     }
 
-    table->table = (SDL_HashItem *)SDL_calloc(num_buckets, sizeof(SDL_HashItem));
-    if (!table->table) {
+    table->buckets = allocate_buckets(num_buckets);
+    if (!table->buckets) {
         SDL_DestroyHashTable(table);
         return NULL;
     }
 
-    table->hash_mask = num_buckets - 1;
+    table->growth_left = capacity_to_growth(num_buckets);
     table->userdata = userdata;
     table->hash = hash;
     table->keymatch = keymatch;
@@ -98,196 +239,189 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
     return table;
 }
 
-static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
+static SDL_INLINE Uint32 mix_hash(Uint32 hash)
 {
     const Uint32 BitMixer = 0x9E3779B1u;
-    return table->hash(table->userdata, key) * BitMixer;
+    return hash * BitMixer;
 }
 
-static SDL_INLINE Uint32 get_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    // returns the probe sequence length from zero_idx to actual_idx
-    if (actual_idx < zero_idx) {
-        return num_buckets - zero_idx + actual_idx;
-    }
-
-    return actual_idx - zero_idx;
+    return mix_hash(table->hash(table->userdata, key));
 }
 
-static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+// Writers call these around any change to the buckets, with the table locked for writing
+static SDL_INLINE void begin_write(SDL_HashTable *ht)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    Uint32 max_probe_len = ht->max_probe_len;
-
-    SDL_HashItem *table = ht->table;
-
-    while (true) {
-        SDL_HashItem *item = table + *i;
-        Uint32 item_hash = item->hash;
-
-        if (!item->live) {
-            return NULL;
-        }
-
-        if (item_hash == hash && ht->keymatch(ht->userdata, item->key, key)) {
-            return item;
-        }
-
-        Uint32 item_probe_len = item->probe_len;
-        SDL_assert(item_probe_len == get_probe_length(item_hash & hash_mask, (Uint32)(item - table), hash_mask + 1));
-
-        if (*probe_len > item_probe_len) {
-            return NULL;
-        }
-
-        if (++*probe_len > max_probe_len) {
-            return NULL;
-        }
-
-        *i = (*i + 1) & hash_mask;
+    if (ht->lockfree_reads) {
+        SDL_SetAtomicU32(&ht->sequence, SDL_GetAtomicU32(&ht->sequence) + 1);
+        SDL_MemoryBarrierRelease();
     }
 }
 
-static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+static SDL_INLINE void end_write(SDL_HashTable *ht)
 {
-    Uint32 i = hash & ht->hash_mask;
-    Uint32 probe_len = 0;
-    return find_item(ht, key, hash, &i, &probe_len);
+    if (ht->lockfree_reads) {
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicU32(&ht->sequence, SDL_GetAtomicU32(&ht->sequence) + 1);
+    }
 }
 
-static SDL_HashItem *insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
+static SDL_INLINE void set_ctrl(SDL_HashBuckets *b, Uint32 i, Uint8 ctrl)
 {
-    const Uint32 num_buckets = hash_mask + 1;
-    Uint32 idx = item_to_insert->hash & hash_mask;
-    SDL_HashItem *target = NULL;
-    SDL_HashItem temp_item;
-
-    while (true) {
-        SDL_HashItem *candidate = table + idx;
-
-        if (!candidate->live) {
-            // Found an empty slot. Put it here and we're done.
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            const Uint32 probe_len = get_probe_length(candidate->hash & hash_mask, idx, num_buckets);
-            candidate->probe_len = probe_len;
+    b->ctrl[i] = ctrl;
+    if (i < GROUP_WIDTH) {
+        // Keep the mirrored bytes in sync so groups can be loaded past the end of the table
+        b->ctrl[b->hash_mask + 1 + i] = ctrl;
+    }
+}
 
-            if (*max_probe_len_ptr < probe_len) {
-                *max_probe_len_ptr = probe_len;
+/* Returns the slot holding key, or a value greater than hash_mask if it isn't in the table.
+   This gives up after visiting every group, so lock-free readers looking at buckets in the
+   middle of a change can't loop forever. */
+static Uint32 find_item(const SDL_HashTable *ht, const SDL_HashBuckets *b, const void *key, Uint32 hash)
+{
+    const Uint32 hash_mask = b->hash_mask;
+    const Uint8 h2 = hash_h2(hash);
+    Uint32 pos = hash & hash_mask;
+    Uint32 stride = 0;
+
+    while (stride <= hash_mask) {
+        const Uint8 *group = b->ctrl + pos;
+
+        for (Uint32 matches = group_match(group, h2); matches; matches &= (matches - 1)) {
+            const Uint32 i = (pos + lowest_bit_index(matches)) & hash_mask;
+            if (b->hashes[i] == hash && ht->keymatch(ht->userdata, b->keys[i], key)) {
+                return i;
             }
+        }
 
+        if (group_match_empty(group)) {
             break;
         }
 
-        const Uint32 candidate_probe_len = candidate->probe_len;
-        SDL_assert(candidate_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-        const Uint32 new_probe_len = get_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
-
-        if (candidate_probe_len < new_probe_len) {
-            // Robin Hood hashing: the item at idx has a better probe length than our item would at this position.
-            // Evict it and put our item in its place, then continue looking for a new spot for the displaced item.
-            // This algorithm significantly reduces clustering in the table, making lookups take very few probes.
-
-            temp_item = *candidate;
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            *item_to_insert = temp_item;
+        // Triangular probing over groups visits every group of a power of two table
+        stride += GROUP_WIDTH;
+        pos = (pos + stride) & hash_mask;
+    }
+    return hash_mask + 1;
+}
 
-            SDL_assert(new_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-            candidate->probe_len = new_probe_len;
+static Uint32 find_insert_slot(const SDL_HashBuckets *b, Uint32 hash)
+{
+    const Uint32 hash_mask = b->hash_mask;
+    Uint32 pos = hash & hash_mask;
+    Uint32 stride = 0;
 
-            if (*max_probe_len_ptr < new_probe_len) {
-                *max_probe_len_ptr = new_probe_len;
-            }
+    while (true) {
+        const Uint32 matches = group_match_empty_or_deleted(b->ctrl + pos);
+        if (matches) {
+            return (pos + lowest_bit_index(matches)) & hash_mask;
         }
 
-        idx = (idx + 1) & hash_mask;
+        stride += GROUP_WIDTH;
+        pos = (pos + stride) & hash_mask;
     }
+}
 
-    return target;
+// Returns true if an empty slot was used up
+static bool insert_item(SDL_HashBuckets *b, const void *key, const void *value, Uint32 hash)
+{
+    const Uint32 i = find_insert_slot(b, hash);
+    const bool was_empty = (b->ctrl[i] == CTRL_EMPTY);
+
+    b->keys[i] = key;
+    b->values[i] = value;
+    b->hashes[i] = hash;
+    set_ctrl(b, i, hash_h2(hash));
+    return was_empty;
 }
 
-static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+static void delete_item(SDL_HashTable *ht, Uint32 i)
 {
-    const Uint32 hash_mask = ht->hash_mask;
-    SDL_HashItem *table = ht->table;
+    SDL_HashBuckets *b = ht->buckets;
+    const Uint32 hash_mask = b->hash_mask;
 
     if (ht->destroy) {
-        ht->destroy(ht->userdata, item->key, item->value);
+        ht->destroy(ht->userdata, b->keys[i], b->values[i]);
     }
 
     SDL_assert(ht->num_occupied_slots > 0);
     ht->num_occupied_slots--;
 
-    Uint32 idx = (Uint32)(item - ht->table);
-
-    while (true) {
-        idx = (idx + 1) & hash_mask;
-        SDL_HashItem *next_item = table + idx;
-
-        if (next_item->probe_len < 1) {
-            SDL_zerop(item);
-            return;
-        }
-
-        *item = *next_item;
-        item->probe_len -= 1;
-        SDL_assert(item->probe_len < ht->max_probe_len);
-        item = next_item;
+    begin_write(ht);
+
+    /* If every group that covers this slot also has an empty slot in it, no probe sequence
+       ever walked past here looking for something else, so the slot can go back to EMPTY.
+       Otherwise leave a tombstone so lookups keep probing past it. */
+    const Uint32 empty_before = group_match_empty(b->ctrl + ((i - GROUP_WIDTH) & hash_mask));
+    const Uint32 empty_after = group_match_empty(b->ctrl + i);
+    if (empty_before && empty_after &&
+        ((GROUP_WIDTH - 1 - (Uint32)SDL_MostSignificantBitIndex32(empty_before)) + lowest_bit_index(empty_after)) < GROUP_WIDTH) {
+        set_ctrl(b, i, CTRL_EMPTY);
+        ht->growth_left++;
+    } else {
+        set_ctrl(b, i, CTRL_DELETED);
     }
+
+    end_write(ht);
 }
 
 static bool resize(SDL_HashTable *ht, Uint32 new_size)
 {
-    const Uint32 new_hash_mask = new_size - 1;
-    SDL_HashItem *new_table = SDL_calloc(new_size, sizeof(*new_table));
+    SDL_HashBuckets *old_buckets = ht->buckets;
+    const Uint32 old_size = old_buckets->hash_mask + 1;
+    SDL_HashBuckets *new_buckets = allocate_buckets(new_size);
 
-    if (!new_table) {
+    if (!new_buckets) {
         return false;
     }
 
-    SDL_HashItem *old_table = ht->table;
-    const Uint32 old_size = ht->hash_mask + 1;
-
-    ht->max_probe_len = 0;
-    ht->hash_mask = new_hash_mask;
-    ht->table = new_table;
-
+    Uint32 growth_left = capacity_to_growth(new_size);
     for (Uint32 i = 0; i < old_size; ++i) {
-        SDL_HashItem *item = old_table + i;
-        if (item->live) {
-            insert_item(item, new_table, new_hash_mask, &ht->max_probe_len);
+        if (ctrl_is_full(old_buckets->ctrl[i])) {
+            insert_item(new_buckets, old_buckets->keys[i], old_buckets->values[i], old_buckets->hashes[i]);
+            growth_left--;
         }
     }
-
-    SDL_free(old_table);
+    ht->growth_left = growth_left;
+
+    if (!ht->lockfree_reads) {
+        ht->buckets = new_buckets;
+        SDL_free(old_buckets);
+    } else if (new_size == old_size) {
+        // Rehash in place, so readers never see memory go away and retired buckets don't pile up
+        begin_write(ht);
+        SDL_memcpy(old_buckets + 1, new_buckets + 1, (size_t)((new_buckets->ctrl + new_size + GROUP_WIDTH) - (Uint8 *)(new_buckets + 1)));
+        end_write(ht);
+        SDL_free(new_buckets);
+    } else {
+        // Readers may still be looking at the old buckets, keep them until the table is destroyed
+        new_buckets->retired = old_buckets;
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicPointer((void **)&ht->buckets, new_buckets);
+    }
     return true;
 }
 
 static bool maybe_resize(SDL_HashTable *ht)
 {
-    const Uint32 capacity = ht->hash_mask + 1;
-
-    if (capacity >= MAX_HASHTABLE_SIZE) {
-        return false;
+    if (ht->growth_left > 0) {
+        return true;
     }
 
-    const Uint32 max_load_factor = 217; // range: 0-255; 217 is roughly 85%
-    const Uint32 resize_threshold = (Uint32)((max_load_factor * (Uint64)capacity) >> 8);
+    const Uint32 capacity = ht->buckets->hash_mask + 1;
 
-    if (ht->num_occupied_slots > resize_threshold) {
-        return resize(ht, capacity * 2);
+    if (ht->num_occupied_slots < capacity_to_growth(capacity) / 2) {
+        // Mostly tombstones, clean them up without growing
+        return resize(ht, capacity);
     }
 
-    return true;
+    if (capacity >= MAX_HASHTABLE_SIZE) {
+        return false;
+    }
+
+    return resize(ht, capacity * 2);
 }
 
 bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value, bool replace)
@@ -301,34 +435,55 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
     SDL_LockRWLockForWriting(table->lock);
 
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
+    const Uint32 i = find_item(table, table->buckets, key, hash);
     bool do_insert = true;
 
-    if (item) {
+    if (i <= table->buckets->hash_mask) {
         if (replace) {
-            delete_item(table, item);
+            delete_item(table, i);
         } else {
             SDL_SetError("key already exists and replace is disabled");
             do_insert = false;
         }
     }
 
-    if (do_insert) {
-        SDL_HashItem new_item;
-        new_item.key = key;
-        new_item.value = value;
-        new_item.hash = hash;
-        new_item.live = true;
-        new_item.probe_len = 0;
-
+    if (do_insert && maybe_resize(table)) {
+        begin_write(table);
+        if (insert_item(table->buckets, key, value, hash)) {
+            SDL_assert(table->growth_left > 0);
+            table->growth_left--;
+        }
         table->num_occupied_slots++;
+        end_write(table);
+        result = true;
+    }
 
-        if (!maybe_resize(table)) {
-            table->num_occupied_slots--;
-        } else {
-            // This never returns NULL
-            insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
-            result = true;
+    SDL_UnlockRWLock(table->lock);
+    return result;
+}
+
+bool SDL_ReserveHashTable(SDL_HashTable *table, int count)
+{
+    if (!table) {
+        return SDL_InvalidParamError("table");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    bool result = true;
+
+    SDL_LockRWLockForWriting(table->lock);
+
+    if ((Uint32)count > table->growth_left) {
+        const Uint32 capacity = table->buckets->hash_mask + 1;
+        const Sint64 wanted = (Sint64)table->num_occupied_slots + count;
+        const Uint32 new_size = CalculateHashBucketsFromEstimate((int)SDL_min(wanted, SDL_MAX_SINT32));
+
+        // If the table is already big enough, this just clears out the tombstones
+        result = resize(table, SDL_max(new_size, capacity));
+        if (result && (Uint32)count > table->growth_left) {
+            result = SDL_SetError("hash table is full");
         }
     }
 
@@ -336,23 +491,48 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
     return result;
 }
 
-bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value)
+static bool find_lockfree(const SDL_HashTable *table, const void *key, Uint32 hash, const void **value)
 {
-    if (!table) {
-        if (value) {
-            *value = NULL;
+    SDL_AtomicU32 *sequence = (SDL_AtomicU32 *)&table->sequence;
+
+    // If a writer keeps getting in the way, give up and let the caller wait on the lock
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        const Uint32 start = SDL_GetAtomicU32(sequence);
+        if (start & 1) {
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        const SDL_HashBuckets *b = (const SDL_HashBuckets *)SDL_GetAtomicPointer((void **)&table->buckets);
+        const Uint32 i = find_item(table, b, key, hash);
+        const bool found = (i <= b->hash_mask);
+        const void *found_value = found ? b->values[i] : NULL;
+
+        SDL_MemoryBarrierAcquire();
+        if (SDL_GetAtomicU32(sequence) == start) {
+            if (value && found) {
+                *value = found_value;
+            }
+            return found;
         }
-        return SDL_InvalidParamError("table");
+    }
+    return false;
+}
+
+static bool find_with_hash(const SDL_HashTable *table, const void *key, Uint32 hash, const void **value)
+{
+    if (table->lockfree_reads && find_lockfree(table, key, hash, value)) {
+        return true;
     }
 
     SDL_LockRWLockForReading(table->lock);
 
     bool result = false;
-    const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *i = find_first_item(table, key, hash);
-    if (i) {
+    const Uint32 i = find_item(table, table->buckets, key, hash);
+    if (i <= table->buckets->hash_mask) {
         if (value) {
-            *value = i->value;
+            *value = table->buckets->values[i];
         }
         result = true;
     }
@@ -362,6 +542,30 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
     return result;
 }
 
+bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value)
+{
+    if (!table) {
+        if (value) {
+            *value = NULL;
+        }
+        return SDL_InvalidParamError("table");
+    }
+
+    return find_with_hash(table, key, calc_hash(table, key), value);
+}
+
+bool SDL_FindInHashTableWithHash(const SDL_HashTable *table, const void *key, Uint32 hash, const void **value)
+{
+    if (!table) {
+        if (value) {
+            *value = NULL;
+        }
+        return SDL_InvalidParamError("table");
+    }
+
+    return find_with_hash(table, key, mix_hash(hash), value);
+}
+
 bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
     if (!table) {
@@ -372,9 +576,9 @@ bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 
     bool result = false;
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    if (item) {
-        delete_item(table, item);
+    const Uint32 i = find_item(table, table->buckets, key, hash);
+    if (i <= table->buckets->hash_mask) {
+        delete_item(table, i);
         result = true;
     }
 
@@ -391,15 +595,15 @@ bool SDL_IterateHashTable(const SDL_HashTable *table, SDL_HashTableIterateCallba
     }
 
     SDL_LockRWLockForReading(table->lock);
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
+    const SDL_HashBuckets *b = table->buckets;
+    const Uint32 num_buckets = b->hash_mask + 1;
     Uint32 num_iterated = 0;
 
-    for (SDL_HashItem *item = table->table; item < end; item++) {
-        if (item->live) {
-            if (!callback(userdata, table, item->key, item->value)) {
+    for (Uint32 i = 0; i < num_buckets && num_iterated < table->num_occupied_slots; ++i) {
+        if (ctrl_is_full(b->ctrl[i])) {
+            ++num_iterated;
+            if (!callback(userdata, table, b->keys[i], b->values[i])) {
                 break;  // callback requested iteration stop.
-            } else if (++num_iterated >= table->num_occupied_slots) {
-                break;  // we can drop out early because we've seen all the live items.
             }
         }
     }
@@ -424,13 +628,16 @@ bool SDL_HashTableEmpty(SDL_HashTable *table)
 static void destroy_all(SDL_HashTable *table)
 {
     SDL_HashDestroyCallback destroy = table->destroy;
-    if (destroy) {
+    SDL_HashBuckets *b = table->buckets;
+    if (destroy && b) {
         void *userdata = table->userdata;
-        SDL_HashItem *end = table->table + (table->hash_mask + 1);
-        for (SDL_HashItem *i = table->table; i < end; ++i) {
-            if (i->live) {
-                i->live = false;
-                destroy(userdata, i->key, i->value);
+        const Uint32 num_buckets = b->hash_mask + 1;
+        for (Uint32 i = 0; i < num_buckets; ++i) {
+            if (ctrl_is_full(b->ctrl[i])) {
+                begin_write(table);
+                set_ctrl(b, i, CTRL_DELETED);
+                end_write(table);
+                destroy(userdata, b->keys[i], b->values[i]);
             }
         }
     }
@@ -441,9 +648,13 @@ void SDL_ClearHashTable(SDL_HashTable *table)
     if (table) {
         SDL_LockRWLockForWriting(table->lock);
         {
+            SDL_HashBuckets *b = table->buckets;
             destroy_all(table);
-            SDL_memset(table->table, 0, sizeof(*table->table) * (table->hash_mask + 1));
+            begin_write(table);
+            SDL_memset(b->ctrl, CTRL_EMPTY, b->hash_mask + 1 + GROUP_WIDTH);
+            end_write(table);
             table->num_occupied_slots = 0;
+            table->growth_left = capacity_to_growth(b->hash_mask + 1);
         }
         SDL_UnlockRWLock(table->lock);
     }
@@ -456,19 +667,45 @@ void SDL_DestroyHashTable(SDL_HashTable *table)
         if (table->lock) {
             SDL_DestroyRWLock(table->lock);
         }
-        SDL_free(table->table);
+        while (table->buckets) {
+            SDL_HashBuckets *retired = table->buckets->retired;
+            SDL_free(table->buckets);
+            table->buckets = retired;
+        }
         SDL_free(table);
     }
 }
 
-// this is djb's xor hashing function.
-static SDL_INLINE Uint32 hash_string_djbxor(const char *str, size_t len)
+/* Hashes a word at a time with a multiply-xor mix, then runs the result through
+   murmur3's 64-bit finalizer so that every input bit affects the low bits we use
+   to pick a bucket. This does one multiply per 8 bytes instead of a shift, add
+   and xor per byte. */
+static SDL_INLINE Uint32 hash_string_mix64(const char *str, size_t len)
 {
-    Uint32 hash = 5381;
-    while (len--) {
-        hash = ((hash << 5) + hash) ^ *(str++);
+    const Uint64 k = SDL_UINT64_C(0x9E3779B97F4A7C15);
+    Uint64 hash = k ^ len;
+    Uint64 word;
+
+    while (len >= sizeof(word)) {
+        SDL_memcpy(&word, str, sizeof(word));
+        hash = (hash ^ SDL_Swap64LE(word)) * k;
+        hash ^= hash >> 29;
+        str += sizeof(word);
+        len -= sizeof(word);
     }
-    return hash;
+    if (len > 0) {
+        word = 0;
+        SDL_memcpy(&word, str, len);
+        hash = (hash ^ SDL_Swap64LE(word)) * k;
+        hash ^= hash >> 29;
+    }
+
+    hash ^= hash >> 33;
+    hash *= SDL_UINT64_C(0xFF51AFD7ED558CCD);
+    hash ^= hash >> 33;
+    hash *= SDL_UINT64_C(0xC4CEB9FE1A85EC53);
+    hash ^= hash >> 33;
+    return (Uint32)(hash ^ (hash >> 32));
 }
 
 Uint32 SDL_HashPointer(void *unused, const void *key)
@@ -487,7 +724,7 @@ Uint32 SDL_HashString(void *unused, const void *key)
 {
     (void)unused;
     const char *str = (const char *)key;
-    return hash_string_djbxor(str, SDL_strlen(str));
+    return hash_string_mix64(str, SDL_strlen(str));
 }
 
 bool SDL_KeyMatchString(void *unused, const void *a, const void *b)
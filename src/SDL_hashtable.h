@@ -337,6 +337,25 @@ extern void SDL_DestroyHashTable(SDL_HashTable *table);
  */
 extern bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value, bool replace);
 
+/**
+ * Make room in a hash table for a number of new items.
+ *
+ * After this returns successfully, inserting up to `count` new items won't
+ * need to resize the table.
+ *
+ * \param table the hash table to grow.
+ * \param count the number of items that are about to be inserted.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_InsertIntoHashTable
+ */
+extern bool SDL_ReserveHashTable(SDL_HashTable *table, int count);
+
 /**
  * Look up an item in a hash table.
  *
@@ -360,6 +379,27 @@ extern bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const
  */
 extern bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value);
 
+/**
+ * Look up an item in a hash table, using a hash the caller already computed.
+ *
+ * This is SDL_FindInHashTable() for callers that look up the same key often
+ * and can cache its hash. `hash` must be the value the table's
+ * SDL_HashCallback returns for `key`, otherwise the lookup will fail.
+ *
+ * \param table the hash table to search.
+ * \param key the key to search for in the table.
+ * \param hash the hash of `key`.
+ * \param value the found value will be stored here. Can be NULL.
+ * \returns true if key exists in the table, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_FindInHashTable
+ */
+extern bool SDL_FindInHashTableWithHash(const SDL_HashTable *table, const void *key, Uint32 hash, const void **value);
+
 /**
  * Remove an item from a hash table.
  *
@@ -41,6 +41,7 @@ typedef struct SDL_Hint
 } SDL_Hint;
 
 static SDL_AtomicU32 SDL_hint_props;
+static SDL_AtomicInt SDL_hint_generation;  // bumped after any hint value changes
 
 
 void SDL_InitHints(void)
@@ -57,6 +58,7 @@ void SDL_QuitHints(void)
     if (props) {
         SDL_DestroyProperties(props);
     }
+    SDL_InvalidateCachedHints();
 }
 
 static SDL_PropertiesID GetHintProperties(bool create)
@@ -158,6 +160,8 @@ bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriori
     }
 #endif // SDL_PLATFORM_ANDROID
 
+    SDL_InvalidateCachedHints();
+
     SDL_UnlockProperties(hints);
 
     return result;
@@ -207,6 +211,8 @@ bool SDL_ResetHint(const char *name)
     }
 #endif // SDL_PLATFORM_ANDROID
 
+    SDL_InvalidateCachedHints();
+
     SDL_UnlockProperties(hints);
 
     return result;
@@ -232,6 +238,7 @@ static void SDLCALL ResetHintsCallback(void *userdata, SDL_PropertiesID hints, c
     SDL_free(hint->value);
     hint->value = NULL;
     hint->priority = SDL_HINT_DEFAULT;
+    SDL_InvalidateCachedHints();
 
 #ifdef SDL_PLATFORM_ANDROID
     if (SDL_strcmp(name, SDL_HINT_ANDROID_ALLOW_RECREATE_ACTIVITY) == 0) {
@@ -314,6 +321,24 @@ bool SDL_GetHintBoolean(const char *name, bool default_value)
     return SDL_GetStringBoolean(hint, default_value);
 }
 
+void SDL_InvalidateCachedHints(void)
+{
+    SDL_AddAtomicInt(&SDL_hint_generation, 1);
+}
+
+bool SDL_GetCachedHintBoolean(SDL_CachedHint *hint)
+{
+    // Read the generation first, so a change that races with the lookup below marks the result stale
+    const Uint32 generation = ((Uint32)SDL_GetAtomicInt(&SDL_hint_generation) << 2) | 0x2;
+    Uint32 cache = SDL_GetAtomicU32(&hint->cache);
+    if ((cache & ~0x1u) != generation) {
+        const bool value = SDL_GetHintBoolean(hint->name, hint->default_value);
+        cache = generation | (value ? 0x1 : 0x0);
+        SDL_SetAtomicU32(&hint->cache, cache);
+    }
+    return (cache & 0x1) != 0;
+}
+
 bool SDL_AddHintCallback(const char *name, SDL_HintCallback callback, void *userdata)
 {
     if (!name || !*name) {
@@ -30,4 +30,18 @@ extern bool SDL_GetStringBoolean(const char *value, bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
 extern void SDL_QuitHints(void);
 
+/* A boolean hint that's checked often, declared static with SDL_CACHED_HINT().
+   The value is looked up once and then reused until a hint or the SDL environment changes. */
+typedef struct SDL_CachedHint
+{
+    const char *name;
+    bool default_value;
+    SDL_AtomicU32 cache;  // generation << 2, 0x2 if valid, 0x1 for the value
+} SDL_CachedHint;
+
+#define SDL_CACHED_HINT(name, default_value) { name, default_value, { 0 } }
+
+extern bool SDL_GetCachedHintBoolean(SDL_CachedHint *hint);
+extern void SDL_InvalidateCachedHints(void);
+
 #endif // SDL_hints_c_h_
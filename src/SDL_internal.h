@@ -257,6 +257,20 @@
 #define SDL_MAIN_NOIMPL // don't drag in header-only implementation of SDL_main
 #include <SDL3/SDL_main.h>
 
+/* Native thread-local variables, for SDL's own hot per-thread state.
+   Anything using this needs a fallback (usually SDL_GetTLS()) for when it isn't defined. */
+#if !defined(SDL_THREAD_LOCAL) && !defined(SDL_THREADS_DISABLED) && \
+    (defined(SDL_PLATFORM_WINDOWS) || defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID) || \
+     defined(SDL_PLATFORM_APPLE) || defined(SDL_PLATFORM_FREEBSD) || defined(SDL_PLATFORM_NETBSD) || defined(SDL_PLATFORM_OPENBSD))
+#if defined(_MSC_VER)
+#define SDL_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define SDL_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_THREADS__)
+#define SDL_THREAD_LOCAL _Thread_local
+#endif
+#endif
+
 // Set up for C function definitions, even when using C++
 #ifdef __cplusplus
 extern "C" {
@@ -41,6 +41,12 @@
 // The size of the stack buffer to use for rendering log messages.
 #define SDL_MAX_LOG_MESSAGE_STACK 256
 
+// The number of messages that can wait for the log thread, must be a power of two
+#define SDL_LOG_QUEUE_SIZE 256
+
+// The longest message that can be queued, longer ones are truncated
+#define SDL_MAX_LOG_MESSAGE_QUEUED 512
+
 #define DEFAULT_CATEGORY -1
 
 typedef struct SDL_LogLevel
@@ -50,6 +56,14 @@ typedef struct SDL_LogLevel
     struct SDL_LogLevel *next;
 } SDL_LogLevel;
 
+typedef struct SDL_LogQueueEntry
+{
+    SDL_AtomicU32 sequence;
+    int category;
+    SDL_LogPriority priority;
+    char message[SDL_MAX_LOG_MESSAGE_QUEUED];
+} SDL_LogQueueEntry;
+
 
 // The default log output function
 static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message);
@@ -66,6 +80,20 @@ static SDL_LogPriority SDL_log_default_priority SDL_GUARDED_BY(SDL_log_lock);
 static SDL_LogOutputFunction SDL_log_function SDL_GUARDED_BY(SDL_log_function_lock) = SDL_LogOutput;
 static void *SDL_log_userdata SDL_GUARDED_BY(SDL_log_function_lock) = NULL;
 
+/* With SDL_HINT_LOGGING_ASYNC, messages are formatted into a bounded lock-free
+   queue and written out by SDL_log_thread. Like the trace capture, writers
+   announce themselves in SDL_log_queue_writers so the queue can be torn down
+   safely once SDL_log_queue_active is cleared. */
+static SDL_AtomicInt SDL_log_queue_active;
+static SDL_AtomicInt SDL_log_queue_writers;
+static SDL_AtomicInt SDL_log_queue_quit;
+static SDL_AtomicU32 SDL_log_queue_head;
+static Uint32 SDL_log_queue_tail;
+static SDL_AtomicInt SDL_log_queue_dropped;
+static SDL_LogQueueEntry *SDL_log_queue;
+static SDL_Semaphore *SDL_log_queue_sem;
+static SDL_Thread *SDL_log_thread;
+
 #ifdef HAVE_GCC_DIAGNOSTIC_PRAGMA
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -125,6 +153,161 @@ static void SDLCALL SDL_LoggingChanged(void *userdata, const char *name, const c
     SDL_ResetLogPriorities();
 }
 
+static void SDL_FlushLogQueue(void)
+{
+    for (;;) {
+        SDL_LogQueueEntry *entry = &SDL_log_queue[SDL_log_queue_tail & (SDL_LOG_QUEUE_SIZE - 1)];
+        if (SDL_GetAtomicU32(&entry->sequence) != SDL_log_queue_tail + 1) {
+            break; // empty, or the next message is still being written
+        }
+
+        SDL_LockMutex(SDL_log_function_lock);
+        if (SDL_log_function) {
+            SDL_log_function(SDL_log_userdata, entry->category, entry->priority, entry->message);
+        }
+        SDL_UnlockMutex(SDL_log_function_lock);
+
+        SDL_SetAtomicU32(&entry->sequence, SDL_log_queue_tail + SDL_LOG_QUEUE_SIZE);
+        ++SDL_log_queue_tail;
+    }
+
+    int dropped = SDL_GetAtomicInt(&SDL_log_queue_dropped);
+    while (dropped && !SDL_CompareAndSwapAtomicInt(&SDL_log_queue_dropped, dropped, 0)) {
+        dropped = SDL_GetAtomicInt(&SDL_log_queue_dropped);
+    }
+    if (dropped) {
+        char message[64];
+
+        (void)SDL_snprintf(message, sizeof(message), "%d log messages were dropped because the queue was full", dropped);
+        SDL_LockMutex(SDL_log_function_lock);
+        if (SDL_log_function) {
+            SDL_log_function(SDL_log_userdata, SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_WARN, message);
+        }
+        SDL_UnlockMutex(SDL_log_function_lock);
+    }
+}
+
+static int SDLCALL SDL_LogThread(void *data)
+{
+    while (!SDL_GetAtomicInt(&SDL_log_queue_quit)) {
+        SDL_WaitSemaphoreTimeout(SDL_log_queue_sem, 100);
+        SDL_FlushLogQueue();
+    }
+    SDL_FlushLogQueue();
+    return 0;
+}
+
+static void SDL_StartLogQueue(void)
+{
+    SDL_log_queue = (SDL_LogQueueEntry *)SDL_calloc(SDL_LOG_QUEUE_SIZE, sizeof(*SDL_log_queue));
+    SDL_log_queue_sem = SDL_CreateSemaphore(0);
+    if (!SDL_log_queue || !SDL_log_queue_sem) {
+        goto failed;
+    }
+
+    for (Uint32 i = 0; i < SDL_LOG_QUEUE_SIZE; ++i) {
+        SDL_SetAtomicU32(&SDL_log_queue[i].sequence, i);
+    }
+    SDL_SetAtomicU32(&SDL_log_queue_head, 0);
+    SDL_log_queue_tail = 0;
+    SDL_SetAtomicInt(&SDL_log_queue_dropped, 0);
+    SDL_SetAtomicInt(&SDL_log_queue_quit, 0);
+
+    SDL_log_thread = SDL_CreateThread(SDL_LogThread, "SDLLog", NULL);
+    if (!SDL_log_thread) {
+        goto failed;
+    }
+    SDL_SetAtomicInt(&SDL_log_queue_active, 1);
+    return;
+
+failed:
+    // Log synchronously instead
+    SDL_free(SDL_log_queue);
+    SDL_log_queue = NULL;
+    if (SDL_log_queue_sem) {
+        SDL_DestroySemaphore(SDL_log_queue_sem);
+        SDL_log_queue_sem = NULL;
+    }
+}
+
+static void SDL_StopLogQueue(void)
+{
+    if (!SDL_log_thread) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&SDL_log_queue_active, 0);
+    while (SDL_GetAtomicInt(&SDL_log_queue_writers) != 0) {
+        SDL_CPUPauseInstruction();
+    }
+
+    SDL_SetAtomicInt(&SDL_log_queue_quit, 1);
+    SDL_SignalSemaphore(SDL_log_queue_sem);
+    SDL_WaitThread(SDL_log_thread, NULL);
+    SDL_log_thread = NULL;
+
+    SDL_DestroySemaphore(SDL_log_queue_sem);
+    SDL_log_queue_sem = NULL;
+    SDL_free(SDL_log_queue);
+    SDL_log_queue = NULL;
+}
+
+// Returns false if the message should be written out synchronously instead
+static bool SDL_QueueLogMessage(int category, SDL_LogPriority priority, const char *fmt, va_list ap)
+{
+    bool queued = false;
+
+    SDL_AddAtomicInt(&SDL_log_queue_writers, 1);
+    if (SDL_GetAtomicInt(&SDL_log_queue_active)) {
+        SDL_LogQueueEntry *entry = NULL;
+        Uint32 pos = SDL_GetAtomicU32(&SDL_log_queue_head);
+
+        for (;;) {
+            SDL_LogQueueEntry *candidate = &SDL_log_queue[pos & (SDL_LOG_QUEUE_SIZE - 1)];
+            const Sint32 diff = (Sint32)(SDL_GetAtomicU32(&candidate->sequence) - pos);
+            if (diff == 0) {
+                if (SDL_CompareAndSwapAtomicU32(&SDL_log_queue_head, pos, pos + 1)) {
+                    entry = candidate;
+                    break;
+                }
+            } else if (diff < 0) {
+                break; // full
+            }
+            pos = SDL_GetAtomicU32(&SDL_log_queue_head);
+        }
+
+        if (entry) {
+            va_list aq;
+            int len;
+
+            va_copy(aq, ap);
+            len = SDL_vsnprintf(entry->message, sizeof(entry->message), fmt, aq);
+            va_end(aq);
+
+            len = SDL_clamp(len, 0, (int)sizeof(entry->message) - 1);
+            entry->message[len] = '\0';
+
+            // Chop off final endline.
+            if ((len > 0) && (entry->message[len - 1] == '\n')) {
+                entry->message[--len] = '\0';
+                if ((len > 0) && (entry->message[len - 1] == '\r')) { // catch "\r\n", too.
+                    entry->message[--len] = '\0';
+                }
+            }
+            entry->category = category;
+            entry->priority = priority;
+            SDL_SetAtomicU32(&entry->sequence, pos + 1);
+            SDL_SignalSemaphore(SDL_log_queue_sem);
+        } else {
+            SDL_AddAtomicInt(&SDL_log_queue_dropped, 1);
+        }
+        queued = true;
+    }
+    SDL_AddAtomicInt(&SDL_log_queue_writers, -1);
+
+    return queued;
+}
+
 void SDL_InitLog(void)
 {
     if (!SDL_ShouldInit(&SDL_log_init)) {
@@ -137,6 +320,10 @@ void SDL_InitLog(void)
 
     SDL_AddHintCallback(SDL_HINT_LOGGING, SDL_LoggingChanged, NULL);
 
+    if (SDL_GetHintBoolean(SDL_HINT_LOGGING_ASYNC, false)) {
+        SDL_StartLogQueue();
+    }
+
     SDL_SetInitialized(&SDL_log_init, true);
 }
 
@@ -146,6 +333,8 @@ void SDL_QuitLog(void)
         return;
     }
 
+    SDL_StopLogQueue();
+
     SDL_RemoveHintCallback(SDL_HINT_LOGGING, SDL_LoggingChanged, NULL);
 
     CleanupLogPriorities();
@@ -246,6 +435,11 @@ SDL_LogPriority SDL_GetLogPriority(int category)
         return SDL_log_priorities[category];
     }
 
+    // Likewise for custom categories while none of them have their own priority
+    if (!SDL_GetAtomicPointer((void **)&SDL_loglevels)) {
+        return SDL_log_default_priority;
+    }
+
     SDL_LockMutex(SDL_log_lock);
     {
         if (category >= 0 && category < SDL_arraysize(SDL_log_priorities)) {
@@ -587,6 +781,10 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
         return;
     }
 
+    if (SDL_GetAtomicInt(&SDL_log_queue_active) && SDL_QueueLogMessage(category, priority, fmt, ap)) {
+        return;
+    }
+
     // Render into stack buffer
     va_copy(aq, ap);
     len = SDL_vsnprintf(stack_buf, sizeof(stack_buf), fmt, aq);
@@ -0,0 +1,249 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_memoryusage_c.h"
+
+typedef struct SDL_MemoryObject
+{
+    SDL_MemoryObjectType type;
+    Uint64 bytes;
+    const SDL_PropertiesID *props;
+    char *owner;
+} SDL_MemoryObject;
+
+// An object whose owner is in its properties, looked up after SDL_memory_lock is released
+typedef struct SDL_MemoryOwnerCandidate
+{
+    SDL_PropertiesID props;
+    Uint64 bytes;
+} SDL_MemoryOwnerCandidate;
+
+typedef struct SDL_MemoryOwnerQuery
+{
+    const char *owner;
+    SDL_MemoryUsage *usage;
+    SDL_MemoryOwnerCandidate *candidates;
+    int num_candidates;
+    int max_candidates;
+    bool failed;
+} SDL_MemoryOwnerQuery;
+
+static SDL_InitState SDL_memory_init;
+static SDL_Mutex *SDL_memory_lock;
+static SDL_HashTable *SDL_memory_objects;
+static SDL_MemoryUsage SDL_memory_usage[SDL_MEMORY_OBJECT_COUNT];
+
+static void SDLCALL SDL_FreeMemoryObject(void *unused, const void *key, const void *value)
+{
+    SDL_MemoryObject *object = (SDL_MemoryObject *)value;
+
+    SDL_free(object->owner);
+    SDL_free(object);
+}
+
+static bool SDL_InitMemoryUsage(void)
+{
+    if (!SDL_ShouldInit(&SDL_memory_init)) {
+        return true;
+    }
+
+    SDL_memory_lock = SDL_CreateMutex();
+    SDL_memory_objects = SDL_CreateHashTable(0, false, SDL_HashPointer, SDL_KeyMatchPointer, SDL_FreeMemoryObject, NULL);
+    const bool initialized = (SDL_memory_lock && SDL_memory_objects);
+    if (!initialized) {
+        SDL_DestroyHashTable(SDL_memory_objects);
+        SDL_memory_objects = NULL;
+        SDL_DestroyMutex(SDL_memory_lock);
+        SDL_memory_lock = NULL;
+    }
+    SDL_SetInitialized(&SDL_memory_init, initialized);
+    return initialized;
+}
+
+static bool SDL_MemoryUsageInitialized(void)
+{
+    return SDL_GetAtomicInt(&SDL_memory_init.status) == SDL_INIT_STATUS_INITIALIZED;
+}
+
+void SDL_TrackMemoryObject(const void *object, SDL_MemoryObjectType type, Uint64 bytes, const SDL_PropertiesID *props, const char *owner)
+{
+    SDL_MemoryObject *entry;
+    SDL_MemoryUsage *usage;
+
+    if (!object || type < 0 || type >= SDL_MEMORY_OBJECT_COUNT || !SDL_InitMemoryUsage()) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_memory_lock);
+    if (SDL_FindInHashTable(SDL_memory_objects, object, (const void **)&entry)) {
+        SDL_memory_usage[entry->type].bytes -= entry->bytes;
+        SDL_memory_usage[entry->type].count -= 1;
+    } else {
+        entry = (SDL_MemoryObject *)SDL_calloc(1, sizeof(*entry));
+        if (entry) {
+            entry->props = props;
+            entry->owner = (owner && !props) ? SDL_strdup(owner) : NULL;
+            if (!SDL_InsertIntoHashTable(SDL_memory_objects, object, entry, false)) {
+                SDL_FreeMemoryObject(NULL, object, entry);
+                entry = NULL;
+            }
+        }
+    }
+
+    if (entry) {
+        entry->type = type;
+        entry->bytes = bytes;
+
+        usage = &SDL_memory_usage[type];
+        usage->count += 1;
+        usage->bytes += bytes;
+        if (usage->bytes > usage->peak_bytes) {
+            usage->peak_bytes = usage->bytes;
+        }
+    }
+    SDL_UnlockMutex(SDL_memory_lock);
+}
+
+void SDL_UntrackMemoryObject(const void *object)
+{
+    const SDL_MemoryObject *entry;
+
+    if (!object || !SDL_MemoryUsageInitialized()) {
+        return;
+    }
+
+    SDL_LockMutex(SDL_memory_lock);
+    if (SDL_FindInHashTable(SDL_memory_objects, object, (const void **)&entry)) {
+        SDL_memory_usage[entry->type].bytes -= entry->bytes;
+        SDL_memory_usage[entry->type].count -= 1;
+        SDL_RemoveFromHashTable(SDL_memory_objects, object);
+    }
+    SDL_UnlockMutex(SDL_memory_lock);
+}
+
+void SDL_QuitMemoryUsage(void)
+{
+    if (!SDL_ShouldQuit(&SDL_memory_init)) {
+        return;
+    }
+
+    SDL_DestroyHashTable(SDL_memory_objects);
+    SDL_memory_objects = NULL;
+    SDL_DestroyMutex(SDL_memory_lock);
+    SDL_memory_lock = NULL;
+    SDL_zeroa(SDL_memory_usage);
+
+    SDL_SetInitialized(&SDL_memory_init, false);
+}
+
+bool SDL_GetMemoryUsage(SDL_MemoryObjectType type, SDL_MemoryUsage *usage)
+{
+    if (type < 0 || type >= SDL_MEMORY_OBJECT_COUNT) {
+        return SDL_InvalidParamError("type");
+    }
+    if (!usage) {
+        return SDL_InvalidParamError("usage");
+    }
+
+    SDL_zerop(usage);
+    if (!SDL_MemoryUsageInitialized()) {
+        return true;
+    }
+
+    SDL_LockMutex(SDL_memory_lock);
+    *usage = SDL_memory_usage[type];
+    SDL_UnlockMutex(SDL_memory_lock);
+    return true;
+}
+
+static bool SDLCALL SDL_GatherOwnerUsage(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+{
+    SDL_MemoryOwnerQuery *query = (SDL_MemoryOwnerQuery *)userdata;
+    const SDL_MemoryObject *entry = (const SDL_MemoryObject *)value;
+
+    if (entry->props) {
+        // Reading the properties here would take their lock while we hold ours
+        const SDL_PropertiesID props = *entry->props;
+        if (props) {
+            if (query->num_candidates == query->max_candidates) {
+                const int max_candidates = query->max_candidates ? query->max_candidates * 2 : 64;
+                SDL_MemoryOwnerCandidate *candidates = (SDL_MemoryOwnerCandidate *)SDL_realloc(query->candidates, max_candidates * sizeof(*candidates));
+                if (!candidates) {
+                    query->failed = true;
+                    return false;
+                }
+                query->candidates = candidates;
+                query->max_candidates = max_candidates;
+            }
+            query->candidates[query->num_candidates].props = props;
+            query->candidates[query->num_candidates].bytes = entry->bytes;
+            ++query->num_candidates;
+        }
+    } else if (entry->owner && SDL_strcmp(entry->owner, query->owner) == 0) {
+        query->usage->count += 1;
+        query->usage->bytes += entry->bytes;
+    }
+    return true;
+}
+
+bool SDL_GetMemoryUsageForOwner(const char *owner, SDL_MemoryUsage *usage)
+{
+    SDL_MemoryOwnerQuery query;
+    int i;
+
+    if (!owner) {
+        return SDL_InvalidParamError("owner");
+    }
+    if (!usage) {
+        return SDL_InvalidParamError("usage");
+    }
+
+    SDL_zerop(usage);
+    if (!SDL_MemoryUsageInitialized()) {
+        return true;
+    }
+
+    SDL_zero(query);
+    query.owner = owner;
+    query.usage = usage;
+
+    SDL_LockMutex(SDL_memory_lock);
+    SDL_IterateHashTable(SDL_memory_objects, SDL_GatherOwnerUsage, &query);
+    SDL_UnlockMutex(SDL_memory_lock);
+
+    if (query.failed) {
+        SDL_free(query.candidates);
+        SDL_zerop(usage);
+        return false;
+    }
+
+    for (i = 0; i < query.num_candidates; ++i) {
+        const char *candidate_owner = SDL_GetStringProperty(query.candidates[i].props, SDL_PROP_MEMORY_OWNER_STRING, NULL);
+        if (candidate_owner && SDL_strcmp(candidate_owner, owner) == 0) {
+            usage->count += 1;
+            usage->bytes += query.candidates[i].bytes;
+        }
+    }
+    usage->peak_bytes = usage->bytes;
+    SDL_free(query.candidates);
+    return true;
+}
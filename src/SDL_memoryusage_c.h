@@ -0,0 +1,32 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_memoryusage_c_h_
+#define SDL_memoryusage_c_h_
+
+/* Start accounting for an object, or update the size of one already accounted for.
+   The owner is read from *props when usage is queried, or copied from owner if props is NULL. */
+extern void SDL_TrackMemoryObject(const void *object, SDL_MemoryObjectType type, Uint64 bytes, const SDL_PropertiesID *props, const char *owner);
+extern void SDL_UntrackMemoryObject(const void *object);
+extern void SDL_QuitMemoryUsage(void);
+
+#endif // SDL_memoryusage_c_h_
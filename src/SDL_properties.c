@@ -40,12 +40,15 @@ typedef struct
 
     SDL_CleanupPropertyCallback cleanup;
     void *userdata;
+
+    bool static_name;  // the key is the name of an SDL_PropertyKey, not a copy
 } SDL_Property;
 
 typedef struct
 {
     SDL_HashTable *props;
     SDL_Mutex *lock;
+    bool read_only;  // a snapshot, never changes so it's read without locking
 } SDL_Properties;
 
 static SDL_InitState SDL_properties_init;
@@ -57,6 +60,7 @@ static SDL_AtomicU32 SDL_global_properties;
 static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, bool cleanup)
 {
     SDL_Property *property = (SDL_Property *)value;
+    bool free_key = true;
     if (property) {
         switch (property->type) {
         case SDL_PROPERTY_TYPE_POINTER:
@@ -71,8 +75,11 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
             break;
         }
         SDL_free(property->string_storage);
+        free_key = !property->static_name;
+    }
+    if (free_key) {
+        SDL_free((void *)key);
     }
-    SDL_free((void *)key);
     SDL_free((void *)value);
 }
 
@@ -81,6 +88,20 @@ static void SDLCALL SDL_FreeProperty(void *data, const void *key, const void *va
     SDL_FreePropertyWithCleanup(key, value, data, true);
 }
 
+static void SDL_LockPropertiesForReading(SDL_Properties *properties)
+{
+    if (!properties->read_only) {
+        SDL_LockMutex(properties->lock);
+    }
+}
+
+static void SDL_UnlockPropertiesForReading(SDL_Properties *properties)
+{
+    if (!properties->read_only) {
+        SDL_UnlockMutex(properties->lock);
+    }
+}
+
 static void SDL_FreeProperties(SDL_Properties *properties)
 {
     if (properties) {
@@ -230,6 +251,8 @@ static bool SDLCALL CopyOneProperty(void *userdata, const SDL_HashTable *table,
     }
 
     SDL_copyp(dst_property, src_property);
+    dst_property->string_storage = NULL;
+    dst_property->static_name = false;
     if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
         dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
         if (!dst_property->value.string_value) {
@@ -268,9 +291,12 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
     if (!dst_properties) {
         return SDL_InvalidParamError("dst");
     }
+    if (dst_properties->read_only) {
+        return SDL_SetError("Properties are read-only");
+    }
 
     bool result = true;
-    SDL_LockMutex(src_properties->lock);
+    SDL_LockPropertiesForReading(src_properties);
     SDL_LockMutex(dst_properties->lock);
     {
         CopyOnePropertyData data = { dst_properties, true };
@@ -278,11 +304,60 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
         result = data.result;
     }
     SDL_UnlockMutex(dst_properties->lock);
-    SDL_UnlockMutex(src_properties->lock);
+    SDL_UnlockPropertiesForReading(src_properties);
 
     return result;
 }
 
+static bool SDLCALL PrepareSnapshotProperty(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+{
+    SDL_Property *property = (SDL_Property *)value;
+    bool *result = (bool *)userdata;
+
+    // SDL_GetStringProperty() formats numbers on demand, which a snapshot can't do without a lock
+    if (property->type == SDL_PROPERTY_TYPE_NUMBER) {
+        if (SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value) < 0) {
+            *result = false;
+        }
+    } else if (property->type == SDL_PROPERTY_TYPE_FLOAT) {
+        if (SDL_asprintf(&property->string_storage, "%f", property->value.float_value) < 0) {
+            *result = false;
+        }
+    }
+    return true;  // keep iterating.
+}
+
+SDL_PropertiesID SDL_CreatePropertiesSnapshot(SDL_PropertiesID src)
+{
+    SDL_PropertiesID props;
+    SDL_Properties *properties = NULL;
+    bool result = true;
+
+    props = SDL_CreateProperties();
+    if (!props) {
+        return 0;
+    }
+
+    if (!SDL_CopyProperties(src, props)) {
+        SDL_DestroyProperties(props);
+        return 0;
+    }
+
+    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    SDL_IterateHashTable(properties->props, PrepareSnapshotProperty, &result);
+    if (!result) {
+        SDL_DestroyProperties(props);
+        return 0;
+    }
+
+    // Make sure everything is written before another thread sees the snapshot as unlocked
+    SDL_LockMutex(properties->lock);
+    properties->read_only = true;
+    SDL_UnlockMutex(properties->lock);
+
+    return props;
+}
+
 bool SDL_LockProperties(SDL_PropertiesID props)
 {
     SDL_Properties *properties = NULL;
@@ -316,7 +391,7 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
     SDL_UnlockMutex(properties->lock);
 }
 
-static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
+static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, bool static_name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
     bool result = true;
@@ -335,12 +410,22 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
         SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
         return SDL_InvalidParamError("props");
     }
+    if (properties->read_only) {
+        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        return SDL_SetError("Properties are read-only");
+    }
 
     SDL_LockMutex(properties->lock);
     {
         SDL_RemoveFromHashTable(properties->props, name);
         if (property) {
-            char *key = SDL_strdup(name);
+            char *key;
+            if (static_name) {
+                key = (char *)name;
+                property->static_name = true;
+            } else {
+                key = SDL_strdup(name);
+            }
             if (!key || !SDL_InsertIntoHashTable(properties->props, key, property, false)) {
                 SDL_FreePropertyWithCleanup(key, property, NULL, true);
                 result = false;
@@ -352,7 +437,7 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
     return result;
 }
 
-bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata)
+static bool SDL_PrivateSetPointerProperty(SDL_PropertiesID props, const char *name, bool static_name, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata)
 {
     SDL_Property *property;
 
@@ -375,7 +460,12 @@ bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name,
     property->value.pointer_value = value;
     property->cleanup = cleanup;
     property->userdata = userdata;
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, static_name, property);
+}
+
+bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata)
+{
+    return SDL_PrivateSetPointerProperty(props, name, false, value, cleanup, userdata);
 }
 
 bool SDL_SetPointerProperty(SDL_PropertiesID props, const char *name, void *value)
@@ -392,7 +482,7 @@ bool SDL_SetPointerProperty(SDL_PropertiesID props, const char *name, void *valu
     }
     property->type = SDL_PROPERTY_TYPE_POINTER;
     property->value.pointer_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, false, property);
 }
 
 static void SDLCALL CleanupFreeableProperty(void *userdata, void *value)
@@ -435,7 +525,7 @@ bool SDL_SetStringProperty(SDL_PropertiesID props, const char *name, const char
         SDL_free(property);
         return false;
     }
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, false, property);
 }
 
 bool SDL_SetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 value)
@@ -446,7 +536,7 @@ bool SDL_SetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 valu
     }
     property->type = SDL_PROPERTY_TYPE_NUMBER;
     property->value.number_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, false, property);
 }
 
 bool SDL_SetFloatProperty(SDL_PropertiesID props, const char *name, float value)
@@ -457,7 +547,7 @@ bool SDL_SetFloatProperty(SDL_PropertiesID props, const char *name, float value)
     }
     property->type = SDL_PROPERTY_TYPE_FLOAT;
     property->value.float_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, false, property);
 }
 
 bool SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, bool value)
@@ -468,7 +558,158 @@ bool SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, bool value
     }
     property->type = SDL_PROPERTY_TYPE_BOOLEAN;
     property->value.boolean_value = value ? true : false;
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, false, property);
+}
+
+static SDL_Property *SDL_CreatePropertyFromValue(const SDL_PropertyValue *value, bool *valid)
+{
+    SDL_Property *property;
+
+    *valid = true;
+
+    switch (value->type) {
+    case SDL_PROPERTY_TYPE_POINTER:
+        if (!value->value.pointer_value) {
+            return NULL;
+        }
+        break;
+    case SDL_PROPERTY_TYPE_STRING:
+        if (!value->value.string_value) {
+            return NULL;
+        }
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+    case SDL_PROPERTY_TYPE_FLOAT:
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        break;
+    default:
+        SDL_SetError("Unknown property type for '%s'", value->name);
+        *valid = false;
+        return NULL;
+    }
+
+    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
+    if (!property) {
+        *valid = false;
+        return NULL;
+    }
+    property->type = value->type;
+
+    switch (value->type) {
+    case SDL_PROPERTY_TYPE_POINTER:
+        property->value.pointer_value = value->value.pointer_value;
+        break;
+    case SDL_PROPERTY_TYPE_STRING:
+        property->value.string_value = SDL_strdup(value->value.string_value);
+        if (!property->value.string_value) {
+            SDL_free(property);
+            *valid = false;
+            return NULL;
+        }
+        break;
+    case SDL_PROPERTY_TYPE_NUMBER:
+        property->value.number_value = value->value.number_value;
+        break;
+    case SDL_PROPERTY_TYPE_FLOAT:
+        property->value.float_value = value->value.float_value;
+        break;
+    case SDL_PROPERTY_TYPE_BOOLEAN:
+        property->value.boolean_value = value->value.boolean_value ? true : false;
+        break;
+    default:
+        break;
+    }
+    return property;
+}
+
+bool SDL_SetProperties(SDL_PropertiesID props, const SDL_PropertyValue *values, int count)
+{
+    SDL_Properties *properties = NULL;
+    SDL_Property **new_properties;
+    char **keys;
+    bool result = true;
+    int i;
+
+    if (!props) {
+        return SDL_InvalidParamError("props");
+    }
+    if (!values) {
+        return SDL_InvalidParamError("values");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    for (i = 0; i < count; ++i) {
+        if (!values[i].name || !*values[i].name) {
+            return SDL_InvalidParamError("name");
+        }
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    if (!properties) {
+        return SDL_InvalidParamError("props");
+    }
+    if (properties->read_only) {
+        return SDL_SetError("Properties are read-only");
+    }
+
+    // Do all the allocation before taking the lock
+    new_properties = (SDL_Property **)SDL_calloc(count, sizeof(*new_properties) + sizeof(*keys));
+    if (!new_properties) {
+        return false;
+    }
+    keys = (char **)(new_properties + count);
+
+    for (i = 0; i < count; ++i) {
+        bool valid;
+
+        new_properties[i] = SDL_CreatePropertyFromValue(&values[i], &valid);
+        if (!valid) {
+            result = false;
+            break;
+        }
+        if (new_properties[i]) {
+            keys[i] = SDL_strdup(values[i].name);
+            if (!keys[i]) {
+                result = false;
+                break;
+            }
+        }
+    }
+
+    if (result) {
+        SDL_LockMutex(properties->lock);
+        {
+            // Make room for everything at once, instead of growing the table along the way
+            SDL_ReserveHashTable(properties->props, count);
+
+            for (i = 0; i < count; ++i) {
+                SDL_RemoveFromHashTable(properties->props, values[i].name);
+                if (new_properties[i]) {
+                    if (SDL_InsertIntoHashTable(properties->props, keys[i], new_properties[i], false)) {
+                        new_properties[i] = NULL;
+                        keys[i] = NULL;
+                    } else {
+                        result = false;
+                    }
+                }
+            }
+        }
+        SDL_UnlockMutex(properties->lock);
+    }
+
+    // Free anything that wasn't inserted
+    for (i = 0; i < count; ++i) {
+        if (new_properties[i]) {
+            SDL_FreePropertyWithCleanup(keys[i], new_properties[i], NULL, false);
+        }
+    }
+    SDL_free(new_properties);
+
+    return result;
 }
 
 bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
@@ -493,30 +734,23 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
             type = property->type;
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return type;
 }
 
-void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+static void *SDL_PrivateGetPointerProperty(SDL_PropertiesID props, const char *name, Uint32 hash, void *default_value)
 {
     SDL_Properties *properties = NULL;
     void *value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
         return value;
@@ -525,20 +759,28 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
     // Note that taking the lock here only guarantees that we won't read the
     // hashtable while it's being modified. The value itself can easily be
     // freed from another thread after it is returned here.
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTableWithHash(properties->props, name, hash, (const void **)&property)) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
+void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    if (!props || !name || !*name) {
+        return default_value;
+    }
+    return SDL_PrivateGetPointerProperty(props, name, SDL_HashString(NULL, name), default_value);
+}
+
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
 {
     SDL_Properties *properties = NULL;
@@ -556,7 +798,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
         if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
@@ -592,32 +834,25 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
-Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+static Sint64 SDL_PrivateGetNumberProperty(SDL_PropertiesID props, const char *name, Uint32 hash, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
     Sint64 value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTableWithHash(properties->props, name, hash, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
@@ -636,32 +871,33 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
-float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+{
+    if (!props || !name || !*name) {
+        return default_value;
+    }
+    return SDL_PrivateGetNumberProperty(props, name, SDL_HashString(NULL, name), default_value);
+}
+
+static float SDL_PrivateGetFloatProperty(SDL_PropertiesID props, const char *name, Uint32 hash, float default_value)
 {
     SDL_Properties *properties = NULL;
     float value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTableWithHash(properties->props, name, hash, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -680,32 +916,33 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
-bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
+float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+{
+    if (!props || !name || !*name) {
+        return default_value;
+    }
+    return SDL_PrivateGetFloatProperty(props, name, SDL_HashString(NULL, name), default_value);
+}
+
+static bool SDL_PrivateGetBooleanProperty(SDL_PropertiesID props, const char *name, Uint32 hash, bool default_value)
 {
     SDL_Properties *properties = NULL;
     bool value = default_value ? true : false;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
     SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        if (SDL_FindInHashTableWithHash(properties->props, name, hash, (const void **)&property)) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -724,14 +961,108 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return value;
 }
 
+bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
+{
+    if (!props || !name || !*name) {
+        return (default_value ? true : false);
+    }
+    return SDL_PrivateGetBooleanProperty(props, name, SDL_HashString(NULL, name), default_value);
+}
+
 bool SDL_ClearProperty(SDL_PropertiesID props, const char *name)
 {
-    return SDL_PrivateSetProperty(props, name, NULL);
+    return SDL_PrivateSetProperty(props, name, false, NULL);
+}
+
+static Uint32 SDL_GetPropertyKeyHash(SDL_PropertyKey *key)
+{
+    Uint32 hash = SDL_GetAtomicU32(&key->hash);
+    if (!hash) {
+        // Racing threads all compute the same value, and a name that hashes to 0 is just rehashed every time
+        hash = SDL_HashString(NULL, key->name);
+        SDL_SetAtomicU32(&key->hash, hash);
+    }
+    return hash;
+}
+
+bool SDL_SetPointerPropertyWithCleanupByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata)
+{
+    return SDL_PrivateSetPointerProperty(props, key->name, true, value, cleanup, userdata);
+}
+
+bool SDL_SetPointerPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *value)
+{
+    return SDL_PrivateSetPointerProperty(props, key->name, true, value, NULL, NULL);
+}
+
+bool SDL_SetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 value)
+{
+    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
+    if (!property) {
+        return false;
+    }
+    property->type = SDL_PROPERTY_TYPE_NUMBER;
+    property->value.number_value = value;
+    return SDL_PrivateSetProperty(props, key->name, true, property);
+}
+
+bool SDL_SetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float value)
+{
+    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
+    if (!property) {
+        return false;
+    }
+    property->type = SDL_PROPERTY_TYPE_FLOAT;
+    property->value.float_value = value;
+    return SDL_PrivateSetProperty(props, key->name, true, property);
+}
+
+bool SDL_SetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, bool value)
+{
+    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
+    if (!property) {
+        return false;
+    }
+    property->type = SDL_PROPERTY_TYPE_BOOLEAN;
+    property->value.boolean_value = value ? true : false;
+    return SDL_PrivateSetProperty(props, key->name, true, property);
+}
+
+void *SDL_GetPointerPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *default_value)
+{
+    if (!props) {
+        return default_value;
+    }
+    return SDL_PrivateGetPointerProperty(props, key->name, SDL_GetPropertyKeyHash(key), default_value);
+}
+
+Sint64 SDL_GetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 default_value)
+{
+    if (!props) {
+        return default_value;
+    }
+    return SDL_PrivateGetNumberProperty(props, key->name, SDL_GetPropertyKeyHash(key), default_value);
+}
+
+float SDL_GetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float default_value)
+{
+    if (!props) {
+        return default_value;
+    }
+    return SDL_PrivateGetFloatProperty(props, key->name, SDL_GetPropertyKeyHash(key), default_value);
+}
+
+bool SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, bool default_value)
+{
+    if (!props) {
+        return (default_value ? true : false);
+    }
+    return SDL_PrivateGetBooleanProperty(props, key->name, SDL_GetPropertyKeyHash(key), default_value);
 }
 
 typedef struct EnumerateOnePropertyData
@@ -767,12 +1098,12 @@ bool SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCall
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForReading(properties);
     {
         EnumerateOnePropertyData data = { callback, userdata, props };
         SDL_IterateHashTable(properties->props, EnumerateOneProperty, &data);
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties);
 
     return true;
 }
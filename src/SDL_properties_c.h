@@ -24,3 +24,25 @@ extern bool SDL_SetFreeableProperty(SDL_PropertiesID props, const char *name, vo
 extern bool SDL_SetSurfaceProperty(SDL_PropertiesID props, const char *name, SDL_Surface *surface);
 extern bool SDL_DumpProperties(SDL_PropertiesID props);
 extern void SDL_QuitProperties(void);
+
+/* A property name with its hash cached, for properties that are looked up often.
+   Declare these static with SDL_PROPERTY_KEY(), the name must outlive any properties
+   it's set on. Properties set through a key store the key's name pointer instead of
+   a copy, so later lookups through the same key match without a string compare. */
+typedef struct SDL_PropertyKey
+{
+    const char *name;
+    SDL_AtomicU32 hash;  // 0 until first use
+} SDL_PropertyKey;
+
+#define SDL_PROPERTY_KEY(name) { name, { 0 } }
+
+extern bool SDL_SetPointerPropertyWithCleanupByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata);
+extern bool SDL_SetPointerPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *value);
+extern bool SDL_SetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 value);
+extern bool SDL_SetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float value);
+extern bool SDL_SetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, bool value);
+extern void *SDL_GetPointerPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, void *default_value);
+extern Sint64 SDL_GetNumberPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, Sint64 default_value);
+extern float SDL_GetFloatPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, float default_value);
+extern bool SDL_GetBooleanPropertyByKey(SDL_PropertiesID props, SDL_PropertyKey *key, bool default_value);
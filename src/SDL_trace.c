@@ -0,0 +1,357 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_trace_c.h"
+
+#ifdef SDL_PROFILER
+
+#define SDL_TRACE_DEFAULT_CAPTURE_SIZE (1024 * 1024)
+
+typedef struct SDL_TraceThreadName
+{
+    SDL_ThreadID thread;
+    char *name;
+} SDL_TraceThreadName;
+
+/* Events are emitted without taking a lock. Writers announce themselves in
+   SDL_trace_writers before looking at the sinks, and anything that changes
+   the sinks clears SDL_trace_active and waits for the writers to drain. */
+static SDL_AtomicInt SDL_trace_active;
+static SDL_AtomicInt SDL_trace_writers;
+static SDL_SpinLock SDL_trace_lock;
+
+static SDL_TraceCallback SDL_trace_callback;
+static void *SDL_trace_callback_userdata;
+
+static SDL_TraceEvent *SDL_trace_events;
+static Uint32 SDL_trace_capacity;
+static SDL_AtomicInt SDL_trace_next;
+
+static SDL_TraceThreadName *SDL_trace_thread_names;
+static int SDL_trace_num_thread_names;
+
+// Must be called with SDL_trace_lock held, and followed by SDL_ResumeTracing()
+static void SDL_PauseTracing(void)
+{
+    SDL_SetAtomicInt(&SDL_trace_active, 0);
+    while (SDL_GetAtomicInt(&SDL_trace_writers) != 0) {
+        SDL_CPUPauseInstruction();
+    }
+}
+
+static void SDL_ResumeTracing(void)
+{
+    SDL_SetAtomicInt(&SDL_trace_active, (SDL_trace_callback || SDL_trace_events) ? 1 : 0);
+}
+
+static void SDL_EmitTraceEvent(SDL_TraceEventType type, const char *name, double value)
+{
+    if (!SDL_GetAtomicInt(&SDL_trace_active)) {
+        return;
+    }
+
+    SDL_AddAtomicInt(&SDL_trace_writers, 1);
+    if (SDL_GetAtomicInt(&SDL_trace_active)) {
+        SDL_TraceEvent event;
+
+        event.type = type;
+        event.name = name;
+        event.thread = SDL_GetCurrentThreadID();
+        event.timestamp = SDL_GetTicksNS();
+        event.value = value;
+
+        if (SDL_trace_events) {
+            const Uint32 slot = (Uint32)SDL_AddAtomicInt(&SDL_trace_next, 1);
+            SDL_trace_events[slot & (SDL_trace_capacity - 1)] = event;
+        }
+        if (SDL_trace_callback) {
+            SDL_trace_callback(SDL_trace_callback_userdata, &event);
+        }
+    }
+    SDL_AddAtomicInt(&SDL_trace_writers, -1);
+}
+
+bool SDL_SetTraceCallback(SDL_TraceCallback callback, void *userdata)
+{
+    SDL_LockSpinlock(&SDL_trace_lock);
+    SDL_PauseTracing();
+    SDL_trace_callback = callback;
+    SDL_trace_callback_userdata = userdata;
+    SDL_ResumeTracing();
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+    return true;
+}
+
+bool SDL_StartTraceCapture(int max_events)
+{
+    SDL_TraceEvent *events;
+    Uint32 capacity = 1;
+
+    if (max_events < 0) {
+        return SDL_InvalidParamError("max_events");
+    } else if (max_events == 0) {
+        max_events = SDL_TRACE_DEFAULT_CAPTURE_SIZE;
+    }
+
+    // A power of two, so the ring index can simply wrap around
+    while (capacity < (Uint32)max_events && capacity < 0x80000000u) {
+        capacity <<= 1;
+    }
+
+    events = (SDL_TraceEvent *)SDL_malloc(capacity * sizeof(*events));
+    if (!events) {
+        return false;
+    }
+
+    SDL_LockSpinlock(&SDL_trace_lock);
+    SDL_PauseTracing();
+    SDL_free(SDL_trace_events);
+    SDL_trace_events = events;
+    SDL_trace_capacity = capacity;
+    SDL_SetAtomicInt(&SDL_trace_next, 0);
+    SDL_ResumeTracing();
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+    return true;
+}
+
+static void SDL_WriteTraceString(SDL_IOStream *io, const char *str)
+{
+    const char *start = str;
+
+    SDL_WriteIO(io, "\"", 1);
+    for (; *str; ++str) {
+        const unsigned char ch = (unsigned char)*str;
+        if (ch == '"' || ch == '\\' || ch < 0x20) {
+            SDL_WriteIO(io, start, (size_t)(str - start));
+            SDL_IOprintf(io, "\\u%04x", ch);
+            start = str + 1;
+        }
+    }
+    SDL_WriteIO(io, start, (size_t)(str - start));
+    SDL_WriteIO(io, "\"", 1);
+}
+
+static bool SDL_WriteTraceJSON(const char *file, const SDL_TraceEvent *events, Uint32 capacity, Uint32 next)
+{
+    SDL_IOStream *io;
+    Uint32 i, first;
+    bool comma = false;
+    int j;
+
+    io = SDL_IOFromFile(file, "w");
+    if (!io) {
+        return false;
+    }
+
+    SDL_IOprintf(io, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+
+    SDL_LockSpinlock(&SDL_trace_lock);
+    for (j = 0; j < SDL_trace_num_thread_names; ++j) {
+        const SDL_TraceThreadName *thread_name = &SDL_trace_thread_names[j];
+        SDL_IOprintf(io, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%" SDL_PRIu64 ",\"args\":{\"name\":",
+                     comma ? ",\n" : "", thread_name->thread);
+        SDL_WriteTraceString(io, thread_name->name);
+        SDL_IOprintf(io, "}}");
+        comma = true;
+    }
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+
+    // Once the ring has wrapped around, the oldest event is the one that would be overwritten next
+    first = (next > capacity) ? (next - capacity) : 0;
+    for (i = first; i != next; ++i) {
+        const SDL_TraceEvent *event = &events[i & (capacity - 1)];
+        const char *phase;
+
+        switch (event->type) {
+        case SDL_TRACE_EVENT_ZONE_BEGIN:
+            phase = "B";
+            break;
+        case SDL_TRACE_EVENT_ZONE_END:
+            phase = "E";
+            break;
+        case SDL_TRACE_EVENT_COUNTER:
+            phase = "C";
+            break;
+        default:
+            // Thread names were written up front as metadata
+            continue;
+        }
+
+        SDL_IOprintf(io, "%s{\"ph\":\"%s\",\"pid\":1,\"tid\":%" SDL_PRIu64 ",\"ts\":%.3f,\"name\":",
+                     comma ? ",\n" : "", phase, event->thread, (double)event->timestamp / 1000.0);
+        SDL_WriteTraceString(io, event->name ? event->name : "");
+        if (event->type == SDL_TRACE_EVENT_COUNTER) {
+            SDL_IOprintf(io, ",\"args\":{\"value\":%g}", event->value);
+        }
+        SDL_IOprintf(io, "}");
+        comma = true;
+    }
+
+    SDL_IOprintf(io, "\n]}\n");
+    return SDL_CloseIO(io);
+}
+
+bool SDL_StopTraceCapture(const char *file)
+{
+    SDL_TraceEvent *events;
+    Uint32 capacity, next;
+    bool result = true;
+
+    SDL_LockSpinlock(&SDL_trace_lock);
+    SDL_PauseTracing();
+    events = SDL_trace_events;
+    capacity = SDL_trace_capacity;
+    next = (Uint32)SDL_GetAtomicInt(&SDL_trace_next);
+    SDL_trace_events = NULL;
+    SDL_trace_capacity = 0;
+    SDL_ResumeTracing();
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+
+    if (!events) {
+        return SDL_SetError("No trace capture is running");
+    }
+
+    if (file) {
+        result = SDL_WriteTraceJSON(file, events, capacity, next);
+    }
+    SDL_free(events);
+    return result;
+}
+
+void SDL_BeginTraceZone(const char *name)
+{
+    SDL_EmitTraceEvent(SDL_TRACE_EVENT_ZONE_BEGIN, name, 0.0);
+}
+
+void SDL_EndTraceZone(const char *name)
+{
+    SDL_EmitTraceEvent(SDL_TRACE_EVENT_ZONE_END, name, 0.0);
+}
+
+void SDL_SetTraceCounter(const char *name, double value)
+{
+    SDL_EmitTraceEvent(SDL_TRACE_EVENT_COUNTER, name, value);
+}
+
+void SDL_SetTraceThreadName(const char *name)
+{
+    const SDL_ThreadID thread = SDL_GetCurrentThreadID();
+    SDL_TraceThreadName *thread_name = NULL;
+    char *copy;
+    int i;
+
+    if (!name) {
+        return;
+    }
+
+    copy = SDL_strdup(name);
+    if (!copy) {
+        return;
+    }
+
+    // Names are kept even when nothing is tracing, so threads started before a capture show up in it
+    SDL_LockSpinlock(&SDL_trace_lock);
+    for (i = 0; i < SDL_trace_num_thread_names; ++i) {
+        if (SDL_trace_thread_names[i].thread == thread) {
+            thread_name = &SDL_trace_thread_names[i];
+            SDL_free(thread_name->name);
+            break;
+        }
+    }
+    if (!thread_name) {
+        SDL_TraceThreadName *thread_names = (SDL_TraceThreadName *)SDL_realloc(SDL_trace_thread_names, (SDL_trace_num_thread_names + 1) * sizeof(*thread_names));
+        if (thread_names) {
+            SDL_trace_thread_names = thread_names;
+            thread_name = &SDL_trace_thread_names[SDL_trace_num_thread_names++];
+            thread_name->thread = thread;
+        }
+    }
+    if (thread_name) {
+        thread_name->name = copy;
+    } else {
+        SDL_free(copy);
+    }
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+
+    if (thread_name) {
+        SDL_EmitTraceEvent(SDL_TRACE_EVENT_THREAD_NAME, name, 0.0);
+    }
+}
+
+void SDL_QuitTrace(void)
+{
+    int i;
+
+    SDL_LockSpinlock(&SDL_trace_lock);
+    SDL_PauseTracing();
+    SDL_free(SDL_trace_events);
+    SDL_trace_events = NULL;
+    SDL_trace_capacity = 0;
+    SDL_trace_callback = NULL;
+    SDL_trace_callback_userdata = NULL;
+    for (i = 0; i < SDL_trace_num_thread_names; ++i) {
+        SDL_free(SDL_trace_thread_names[i].name);
+    }
+    SDL_free(SDL_trace_thread_names);
+    SDL_trace_thread_names = NULL;
+    SDL_trace_num_thread_names = 0;
+    SDL_UnlockSpinlock(&SDL_trace_lock);
+}
+
+#else
+
+bool SDL_SetTraceCallback(SDL_TraceCallback callback, void *userdata)
+{
+    return SDL_Unsupported();
+}
+
+bool SDL_StartTraceCapture(int max_events)
+{
+    return SDL_Unsupported();
+}
+
+bool SDL_StopTraceCapture(const char *file)
+{
+    return SDL_Unsupported();
+}
+
+void SDL_BeginTraceZone(const char *name)
+{
+}
+
+void SDL_EndTraceZone(const char *name)
+{
+}
+
+void SDL_SetTraceCounter(const char *name, double value)
+{
+}
+
+void SDL_SetTraceThreadName(const char *name)
+{
+}
+
+void SDL_QuitTrace(void)
+{
+}
+
+#endif // SDL_PROFILER
@@ -0,0 +1,41 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_trace_c_h_
+#define SDL_trace_c_h_
+
+// Internal trace points, which compile to nothing unless SDL is built with the profiler
+#ifdef SDL_PROFILER
+#define SDL_TRACE_BEGIN(name)           SDL_BeginTraceZone(name)
+#define SDL_TRACE_END(name)             SDL_EndTraceZone(name)
+#define SDL_TRACE_COUNTER(name, value)  SDL_SetTraceCounter(name, (double)(value))
+#define SDL_TRACE_THREAD_NAME(name)     SDL_SetTraceThreadName(name)
+#else
+#define SDL_TRACE_BEGIN(name)
+#define SDL_TRACE_END(name)
+#define SDL_TRACE_COUNTER(name, value)
+#define SDL_TRACE_THREAD_NAME(name)
+#endif
+
+extern void SDL_QuitTrace(void);
+
+#endif // SDL_trace_c_h_
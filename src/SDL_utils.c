@@ -143,17 +143,12 @@ static Uint32 SDLCALL SDL_HashObject(void *unused, const void *key)
     return (Uint32)(uintptr_t)key;
 }
 
-static bool SDL_KeyMatchObject(void *unused, const void *a, const void *b)
-{
-    return (a == b);
-}
-
 void SDL_SetObjectValid(void *object, SDL_ObjectType type, bool valid)
 {
     SDL_assert(object != NULL);
 
     if (SDL_ShouldInit(&SDL_objects_init)) {
-        SDL_objects = SDL_CreateHashTable(0, true, SDL_HashObject, SDL_KeyMatchObject, NULL, NULL);
+        SDL_objects = SDL_CreateHashTable(0, true, SDL_HashObject, SDL_KeyMatchPointer, NULL, NULL);
         const bool initialized = (SDL_objects != NULL);
         SDL_SetInitialized(&SDL_objects_init, initialized);
         if (!initialized) {
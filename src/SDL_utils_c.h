@@ -62,6 +62,8 @@ typedef enum
     SDL_OBJECT_TYPE_HIDAPI_JOYSTICK,
     SDL_OBJECT_TYPE_THREAD,
     SDL_OBJECT_TYPE_TRAY,
+    SDL_OBJECT_TYPE_TEXTURE_ATLAS,
+    SDL_OBJECT_TYPE_RENDER_READBACK,
 
 } SDL_ObjectType;
 
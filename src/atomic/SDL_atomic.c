@@ -380,3 +380,203 @@ void SDL_MemoryBarrierAcquireFunction(void)
 {
     SDL_MemoryBarrierAcquire();
 }
+
+/* Bounded lock-free queues.
+
+   The general case is Dmitry Vyukov's bounded MPMC queue: each slot carries a
+   sequence number that tells producers and consumers whose turn it is, so a
+   slot is claimed with one compare-and-swap on the shared position and then
+   published by bumping its sequence. A side that's declared single-threaded
+   claims slots with a plain store instead.
+
+   A queue that's both single producer and single consumer is a plain ring
+   buffer: each side owns its position and keeps a cached copy of the other's,
+   so it only reads the shared one when the cached copy says full or empty.
+
+   The positions for each side live on their own cache line, so producers and
+   consumers don't fight over the same line.
+ */
+
+#define SDL_ATOMIC_QUEUE_SLOT_HEADER 8 // the sequence number, padded so items stay 8-byte aligned
+
+struct SDL_AtomicQueue
+{
+    Uint32 mask;
+    size_t item_size;
+    size_t stride;
+    SDL_AtomicQueueFlags flags;
+    bool spsc;
+    Uint8 *slots;
+
+    char pad0[SDL_CACHELINE_SIZE];
+    SDL_AtomicU32 enqueue_pos;
+    Uint32 cached_dequeue_pos; // SPSC only, owned by the producer
+
+    char pad1[SDL_CACHELINE_SIZE];
+    SDL_AtomicU32 dequeue_pos;
+    Uint32 cached_enqueue_pos; // SPSC only, owned by the consumer
+
+    char pad2[SDL_CACHELINE_SIZE];
+};
+
+#define SDL_ATOMIC_QUEUE_SEQUENCE(queue, pos) ((SDL_AtomicU32 *)((queue)->slots + ((pos) & (queue)->mask) * (queue)->stride))
+#define SDL_ATOMIC_QUEUE_ITEM(queue, pos) ((queue)->slots + ((pos) & (queue)->mask) * (queue)->stride + ((queue)->spsc ? 0 : SDL_ATOMIC_QUEUE_SLOT_HEADER))
+
+SDL_AtomicQueue *SDL_CreateAtomicQueue(int capacity, size_t item_size, SDL_AtomicQueueFlags flags)
+{
+    SDL_AtomicQueue *queue;
+    Uint32 size = 2; // the sequence numbers can't tell full slots from free ones with a single slot
+    Uint32 i;
+
+    if (capacity <= 0 || capacity > (1 << 30)) {
+        SDL_InvalidParamError("capacity");
+        return NULL;
+    }
+    if (item_size == 0) {
+        SDL_InvalidParamError("item_size");
+        return NULL;
+    }
+
+    while (size < (Uint32)capacity) {
+        size <<= 1;
+    }
+
+    queue = (SDL_AtomicQueue *)SDL_calloc(1, sizeof(*queue));
+    if (!queue) {
+        return NULL;
+    }
+    queue->mask = size - 1;
+    queue->item_size = item_size;
+    queue->flags = flags;
+    queue->spsc = ((flags & (SDL_ATOMIC_QUEUE_SINGLE_PRODUCER | SDL_ATOMIC_QUEUE_SINGLE_CONSUMER)) ==
+                   (SDL_ATOMIC_QUEUE_SINGLE_PRODUCER | SDL_ATOMIC_QUEUE_SINGLE_CONSUMER));
+    queue->stride = (item_size + (queue->spsc ? 0 : SDL_ATOMIC_QUEUE_SLOT_HEADER) + 7) & ~(size_t)7;
+
+    if (queue->stride > SDL_SIZE_MAX / size) {
+        SDL_free(queue);
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    queue->slots = (Uint8 *)SDL_malloc(queue->stride * size);
+    if (!queue->slots) {
+        SDL_free(queue);
+        return NULL;
+    }
+
+    if (!queue->spsc) {
+        for (i = 0; i < size; ++i) {
+            SDL_SetAtomicU32(SDL_ATOMIC_QUEUE_SEQUENCE(queue, i), i);
+        }
+    }
+    return queue;
+}
+
+bool SDL_PushAtomicQueue(SDL_AtomicQueue *queue, const void *item)
+{
+    SDL_AtomicU32 *sequence;
+    Uint32 pos;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    if (queue->spsc) {
+        pos = SDL_GetAtomicU32(&queue->enqueue_pos);
+        if (pos - queue->cached_dequeue_pos > queue->mask) {
+            queue->cached_dequeue_pos = SDL_GetAtomicU32(&queue->dequeue_pos);
+            if (pos - queue->cached_dequeue_pos > queue->mask) {
+                return false; // full
+            }
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(SDL_ATOMIC_QUEUE_ITEM(queue, pos), item, queue->item_size);
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicU32(&queue->enqueue_pos, pos + 1);
+        return true;
+    }
+
+    pos = SDL_GetAtomicU32(&queue->enqueue_pos);
+    for (;;) {
+        sequence = SDL_ATOMIC_QUEUE_SEQUENCE(queue, pos);
+        const Sint32 diff = (Sint32)(SDL_GetAtomicU32(sequence) - pos);
+        if (diff == 0) {
+            if (queue->flags & SDL_ATOMIC_QUEUE_SINGLE_PRODUCER) {
+                SDL_SetAtomicU32(&queue->enqueue_pos, pos + 1);
+                break;
+            }
+            if (SDL_CompareAndSwapAtomicU32(&queue->enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // full, the slot hasn't been consumed since the last lap
+        }
+        pos = SDL_GetAtomicU32(&queue->enqueue_pos);
+    }
+    SDL_MemoryBarrierAcquire();
+
+    SDL_memcpy(SDL_ATOMIC_QUEUE_ITEM(queue, pos), item, queue->item_size);
+
+    // Publish the slot to consumers
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicU32(sequence, pos + 1);
+    return true;
+}
+
+bool SDL_PopAtomicQueue(SDL_AtomicQueue *queue, void *item)
+{
+    SDL_AtomicU32 *sequence;
+    Uint32 pos;
+
+    if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    if (queue->spsc) {
+        pos = SDL_GetAtomicU32(&queue->dequeue_pos);
+        if (pos == queue->cached_enqueue_pos) {
+            queue->cached_enqueue_pos = SDL_GetAtomicU32(&queue->enqueue_pos);
+            if (pos == queue->cached_enqueue_pos) {
+                return false; // empty
+            }
+        }
+        SDL_MemoryBarrierAcquire();
+        SDL_memcpy(item, SDL_ATOMIC_QUEUE_ITEM(queue, pos), queue->item_size);
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicU32(&queue->dequeue_pos, pos + 1);
+        return true;
+    }
+
+    pos = SDL_GetAtomicU32(&queue->dequeue_pos);
+    for (;;) {
+        sequence = SDL_ATOMIC_QUEUE_SEQUENCE(queue, pos);
+        const Sint32 diff = (Sint32)(SDL_GetAtomicU32(sequence) - (pos + 1));
+        if (diff == 0) {
+            if (queue->flags & SDL_ATOMIC_QUEUE_SINGLE_CONSUMER) {
+                SDL_SetAtomicU32(&queue->dequeue_pos, pos + 1);
+                break;
+            }
+            if (SDL_CompareAndSwapAtomicU32(&queue->dequeue_pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // empty, or the producer hasn't finished writing this slot yet
+        }
+        pos = SDL_GetAtomicU32(&queue->dequeue_pos);
+    }
+    SDL_MemoryBarrierAcquire();
+
+    SDL_memcpy(item, SDL_ATOMIC_QUEUE_ITEM(queue, pos), queue->item_size);
+
+    // Hand the slot back to producers for the next lap
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicU32(sequence, pos + queue->mask + 1);
+    return true;
+}
+
+void SDL_DestroyAtomicQueue(SDL_AtomicQueue *queue)
+{
+    if (queue) {
+        SDL_free(queue->slots);
+        SDL_free(queue);
+    }
+}
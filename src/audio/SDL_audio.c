@@ -23,6 +23,9 @@
 #include "SDL_audio_c.h"
 #include "SDL_sysaudio.h"
 #include "../thread/SDL_systhread.h"
+#include "../thread/SDL_jobs_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
+#include "../SDL_trace_c.h"
 
 // Available audio drivers
 static const AudioBootStrap *const bootstrap[] = {
@@ -265,6 +268,9 @@ static void UpdateAudioStreamFormatsPhysical(SDL_AudioDevice *device)
             SDL_AudioSpec *streamspec = recording ? &stream->src_spec : &stream->dst_spec;
             int **streamchmap = recording ? &stream->src_chmap : &stream->dst_chmap;
             SDL_LockMutex(stream->lock);
+            if (recording) {
+                SDL_DrainAudioStreamRingBuffer(stream);  // anything in there was recorded in the old format.
+            }
             SDL_copyp(streamspec, &spec);
             SetAudioStreamChannelMap(stream, streamspec, streamchmap, device->chmap, device->spec.channels, -1);  // this should be fast for normal cases, though!
             SDL_UnlockMutex(stream->lock);
@@ -346,6 +352,7 @@ static void ZombieFlushRecording(SDL_AudioDevice *device)
    They are _not_ destroyed because we are done using them (when we "close" a playing device).
 */
 static void ClosePhysicalAudioDevice(SDL_AudioDevice *device);
+static void WaitForAudioDeviceDetection(void);
 
 
 SDL_COMPILE_TIME_ASSERT(check_lowest_audio_default_value, SDL_AUDIO_DEVICE_DEFAULT_RECORDING < SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK);
@@ -475,6 +482,8 @@ static SDL_AudioDevice *ObtainPhysicalAudioDevice(SDL_AudioDeviceID devid)  // !
 
 static SDL_AudioDevice *ObtainPhysicalAudioDeviceDefaultAllowed(SDL_AudioDeviceID devid)  // !!! FIXME: SDL_ACQUIRE
 {
+    WaitForAudioDeviceDetection();
+
     const bool wants_default = ((devid == SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK) || (devid == SDL_AUDIO_DEVICE_DEFAULT_RECORDING));
     if (!wants_default) {
         return ObtainPhysicalAudioDevice(devid);
@@ -909,6 +918,65 @@ static Uint32 SDLCALL HashAudioDeviceID(void *userdata, const void *key)
     return ((Uint32) ((uintptr_t) key)) >> 2;
 }
 
+static void DetectAudioDevices(void)
+{
+    SDL_TRACE_BEGIN("DetectAudioDevices");
+
+    SDL_AudioDevice *default_playback = NULL;
+    SDL_AudioDevice *default_recording = NULL;
+    current_audio.impl.DetectDevices(&default_playback, &default_recording);
+
+    // If no default was _ever_ specified, just take the first device we see, if any.
+    if (!default_playback) {
+        default_playback = GetFirstAddedAudioDevice(/*recording=*/false);
+    }
+
+    if (!default_recording) {
+        default_recording = GetFirstAddedAudioDevice(/*recording=*/true);
+    }
+
+    // If this is running in the background, a hotplug thread might have already picked a default, so don't override it.
+    SDL_LockRWLockForWriting(current_audio.device_hash_lock);
+    if (default_playback && !current_audio.default_playback_device_id) {
+        current_audio.default_playback_device_id = default_playback->instance_id;
+        RefPhysicalAudioDevice(default_playback);  // extra ref on default devices.
+    }
+
+    if (default_recording && !current_audio.default_recording_device_id) {
+        current_audio.default_recording_device_id = default_recording->instance_id;
+        RefPhysicalAudioDevice(default_recording);  // extra ref on default devices.
+    }
+    SDL_UnlockRWLock(current_audio.device_hash_lock);
+
+    SDL_SetAtomicInt(&current_audio.detection_complete, 1);
+
+    SDL_TRACE_END("DetectAudioDevices");
+}
+
+static int SDLCALL AudioDetectionThread(void *data)
+{
+    DetectAudioDevices();
+    return 0;
+}
+
+// Blocks until the initial device list is available, if SDL_HINT_DEFERRED_INIT moved its detection to a background thread.
+static void WaitForAudioDeviceDetection(void)
+{
+    if (!current_audio.name || SDL_GetAtomicInt(&current_audio.detection_complete)) {
+        return;
+    }
+
+    SDL_Thread *thread = (SDL_Thread *) SDL_SetAtomicPointer((void **) &current_audio.detection_thread, NULL);
+    if (thread) {
+        SDL_WaitThread(thread, NULL);
+    } else {
+        // someone else is already waiting on the thread, wait for them.
+        while (!SDL_GetAtomicInt(&current_audio.detection_complete)) {
+            SDL_Delay(1);
+        }
+    }
+}
+
 // !!! FIXME: the video subsystem does SDL_VideoInit, not SDL_InitVideo. Make this match.
 bool SDL_InitAudio(const char *driver_name)
 {
@@ -921,6 +989,7 @@ bool SDL_InitAudio(const char *driver_name)
 
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
+    SDL_SetupAudioChannelMixer();
 
     SDL_RWLock *device_hash_lock = SDL_CreateRWLock();  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
     if (!device_hash_lock) {
@@ -1021,28 +1090,12 @@ bool SDL_InitAudio(const char *driver_name)
 
     CompleteAudioEntryPoints();
 
-    // Make sure we have a list of devices available at startup...
-    SDL_AudioDevice *default_playback = NULL;
-    SDL_AudioDevice *default_recording = NULL;
-    current_audio.impl.DetectDevices(&default_playback, &default_recording);
-
-    // If no default was _ever_ specified, just take the first device we see, if any.
-    if (!default_playback) {
-        default_playback = GetFirstAddedAudioDevice(/*recording=*/false);
-    }
-
-    if (!default_recording) {
-        default_recording = GetFirstAddedAudioDevice(/*recording=*/true);
+    // Make sure we have a list of devices available at startup, unless the app asked for that to happen in the background.
+    if (SDL_GetHintBoolean(SDL_HINT_DEFERRED_INIT, false)) {
+        current_audio.detection_thread = SDL_CreateThread(AudioDetectionThread, "SDLAudioDetect", NULL);
     }
-
-    if (default_playback) {
-        current_audio.default_playback_device_id = default_playback->instance_id;
-        RefPhysicalAudioDevice(default_playback);  // extra ref on default devices.
-    }
-
-    if (default_recording) {
-        current_audio.default_recording_device_id = default_recording->instance_id;
-        RefPhysicalAudioDevice(default_recording);  // extra ref on default devices.
+    if (!current_audio.detection_thread) {
+        DetectAudioDevices();
     }
 
     return true;
@@ -1068,6 +1121,12 @@ void SDL_QuitAudio(void)
         return;
     }
 
+    // Let a background device detection finish before tearing anything down.
+    SDL_Thread *detection_thread = (SDL_Thread *) SDL_SetAtomicPointer((void **) &current_audio.detection_thread, NULL);
+    if (detection_thread) {
+        SDL_WaitThread(detection_thread, NULL);
+    }
+
     current_audio.impl.DeinitializeStart();
 
     // Destroy any audio streams that still exist...
@@ -1115,6 +1174,170 @@ static void MixFloat32Audio(float *dst, const float *src, const int buffer_size)
 }
 
 
+// Get converted data from a bound stream, in the device's channel layout.
+static int GetBoundAudioStreamData(SDL_AudioDevice *device, SDL_AudioStream *stream, Uint8 *buffer, int buffer_size, float gain)
+{
+    const int br = SDL_GetAudioStreamDataAdjustGain(stream, buffer, buffer_size, gain);
+    if (br > 0) {
+        // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
+        if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
+            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), buffer, device->spec.format, device->spec.channels, NULL,
+                         buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+        }
+    }
+    return br;
+}
+
+/* When SDL_HINT_AUDIO_DEVICE_PARALLEL_MIX is enabled, devices with at least this many bound streams convert them on
+   the job threads into a buffer per stream, and then the device thread mixes those in the usual order. */
+#define SDL_AUDIO_PARALLEL_MIN_STREAMS  8
+#define SDL_AUDIO_PARALLEL_MAX_JOBS     16
+
+// A logical device (with a NULL stream) followed by one slot for each of its bound streams.
+typedef struct SDL_AudioMixSlot
+{
+    SDL_LogicalAudioDevice *logdev;
+    SDL_AudioStream *stream;
+    Uint8 *buffer;
+    int bytes;
+} SDL_AudioMixSlot;
+
+typedef struct SDL_AudioMixJob
+{
+    SDL_AudioDevice *device;
+    SDL_AudioMixSlot *slots;
+    int num_slots;
+    int buffer_size;
+} SDL_AudioMixJob;
+
+static void SDLCALL ConvertBoundAudioStreamsJob(void *userdata)
+{
+    SDL_AudioMixJob *job = (SDL_AudioMixJob *)userdata;
+
+    for (int i = 0; i < job->num_slots; ++i) {
+        SDL_AudioMixSlot *slot = &job->slots[i];
+        if (slot->stream) {
+            slot->bytes = GetBoundAudioStreamData(job->device, slot->stream, slot->buffer, job->buffer_size, slot->logdev->gain);
+        }
+    }
+}
+
+// Set up a slot for every unpaused logical device and bound stream, returning the number of slots, or 0 if this shouldn't run in parallel.
+static int PrepareParallelMix(SDL_AudioDevice *device, int work_buffer_size)
+{
+    int max_slots = 0;
+
+    if (!device->parallel_mix || (SDL_GetNumLogicalCPUCores() < 2)) {
+        return 0;
+    }
+
+    // the bindings can't change while we hold the device lock, but the paused flags can, so size for everything.
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        ++max_slots;
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            ++max_slots;
+        }
+    }
+    if (max_slots > device->parallel_slots_allocation) {
+        SDL_AudioMixSlot *slots = (SDL_AudioMixSlot *)SDL_realloc(device->parallel_slots, max_slots * sizeof(*slots));
+        if (!slots) {
+            return 0;
+        }
+        device->parallel_slots = slots;
+        device->parallel_slots_allocation = max_slots;
+    }
+
+    SDL_AudioMixSlot *slot = device->parallel_slots;
+    int num_streams = 0;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (SDL_GetAtomicInt(&logdev->paused)) {
+            continue;  // paused logical devices don't contribute output.
+        }
+        SDL_zerop(slot);
+        slot->logdev = logdev;
+        ++slot;
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            SDL_zerop(slot);
+            slot->logdev = logdev;
+            slot->stream = stream;
+            ++slot;
+            ++num_streams;
+        }
+    }
+    if (num_streams < SDL_AUDIO_PARALLEL_MIN_STREAMS) {
+        return 0;
+    }
+
+    // Give each stream its own SIMD aligned stretch of memory.
+    const size_t alignment = SDL_GetSIMDAlignment();
+    const size_t stride = ((size_t)work_buffer_size + alignment - 1) & ~(alignment - 1);
+    const size_t needed = stride * num_streams;
+    if (needed > device->parallel_buffer_allocation) {
+        Uint8 *buffer = (Uint8 *)SDL_aligned_alloc(alignment, needed);
+        if (!buffer) {
+            return 0;
+        }
+        SDL_aligned_free(device->parallel_buffer);
+        device->parallel_buffer = buffer;
+        device->parallel_buffer_allocation = needed;
+    }
+
+    const int num_slots = (int)(slot - device->parallel_slots);
+    Uint8 *buffer = device->parallel_buffer;
+    for (int i = 0; i < num_slots; ++i) {
+        if (device->parallel_slots[i].stream) {
+            device->parallel_slots[i].buffer = buffer;
+            buffer += stride;
+        }
+    }
+    return num_slots;
+}
+
+// Convert the streams in the slots on the job threads, then mix them into final_mix_buffer in order. Returns false if a stream failed.
+static bool MixBoundAudioStreamsParallel(SDL_AudioDevice *device, int num_slots, float *final_mix_buffer, int work_buffer_size, const SDL_AudioSpec *outspec)
+{
+    SDL_AudioMixJob jobs[SDL_AUDIO_PARALLEL_MAX_JOBS];
+    void *userdata[SDL_AUDIO_PARALLEL_MAX_JOBS];
+    SDL_AudioMixSlot *slots = device->parallel_slots;
+    int num_jobs = SDL_min(SDL_GetNumLogicalCPUCores(), SDL_AUDIO_PARALLEL_MAX_JOBS);
+    num_jobs = SDL_clamp(num_jobs, 1, num_slots);
+
+    for (int i = 0; i < num_jobs; ++i) {
+        const int first = (int)((Sint64)num_slots * i / num_jobs);
+        const int last = (int)((Sint64)num_slots * (i + 1) / num_jobs);
+        jobs[i].device = device;
+        jobs[i].slots = slots + first;
+        jobs[i].num_slots = last - first;
+        jobs[i].buffer_size = work_buffer_size;
+        userdata[i] = &jobs[i];
+    }
+    SDL_RunJobsAndWait(ConvertBoundAudioStreamsJob, userdata, num_jobs);
+
+    for (int i = 0; i < num_slots; ) {
+        SDL_LogicalAudioDevice *logdev = slots[i++].logdev;
+        const SDL_AudioPostmixCallback postmix = logdev->postmix;
+        float *mix_buffer = final_mix_buffer;
+        if (postmix) {
+            mix_buffer = device->postmix_buffer;
+            SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
+        }
+
+        for (; i < num_slots && slots[i].stream; ++i) {
+            if (slots[i].bytes < 0) {
+                return false;
+            } else if (slots[i].bytes > 0) {
+                MixFloat32Audio(mix_buffer, (float *) slots[i].buffer, slots[i].bytes);
+            }
+        }
+
+        if (postmix) {
+            postmix(logdev->postmix_userdata, outspec, mix_buffer, work_buffer_size);
+            MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size);
+        }
+    }
+    return true;
+}
+
 // Playback device thread. This is split into chunks, so backends that need to control this directly can use the pieces they need without duplicating effort.
 
 void SDL_PlaybackAudioThreadSetup(SDL_AudioDevice *device)
@@ -1123,7 +1346,67 @@ void SDL_PlaybackAudioThreadSetup(SDL_AudioDevice *device)
     current_audio.impl.ThreadInit(device);
 }
 
-bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
+// Called by the device thread, with the device lock held, after each iteration that processed a buffer.
+static void UpdateAudioDeviceStats(SDL_AudioDevice *device, Uint64 start, Uint64 mix_ns, Uint64 convert_ns)
+{
+    SDL_AudioDeviceStats *stats = &device->stats;
+    const Uint64 elapsed = SDL_GetTicksNS() - start;
+    const Uint64 period = (device->spec.freq > 0) ? ((((Uint64) device->sample_frames) * SDL_NS_PER_SECOND) / device->spec.freq) : 0;
+    Uint64 bucket = SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS - 1;
+    Uint64 queued = 0;
+
+    stats->iterations++;
+    stats->period_ns = period;
+    stats->iterate_ns_last = elapsed;
+    stats->iterate_ns_max = SDL_max(stats->iterate_ns_max, elapsed);
+    stats->iterate_ns_total += elapsed;
+    stats->mix_ns_total += mix_ns;
+    stats->convert_ns_total += convert_ns;
+    if (elapsed > period) {
+        stats->late_iterations++;
+    }
+    if (period > 0) {
+        bucket = SDL_min(bucket, (elapsed * SDL_AUDIO_DEVICE_STATS_HISTOGRAM_BUCKETS) / period);
+    }
+    stats->iterate_histogram[bucket]++;
+
+    if (device->last_iterate_ns) {
+        const Uint64 interval = start - device->last_iterate_ns;
+        const Uint64 jitter = (interval > period) ? (interval - period) : (period - interval);
+        stats->jitter_ns_max = SDL_max(stats->jitter_ns_max, jitter);
+        stats->jitter_ns_total += jitter;
+    }
+    device->last_iterate_ns = start;
+
+    // the binding lists can't change while we hold the device lock.
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            if (device->recording) {
+                const int framesize = SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+                const int available = SDL_GetAudioStreamAvailable(stream);
+                if ((framesize > 0) && (available > 0)) {
+                    queued += available / framesize;
+                }
+            } else {
+                const int framesize = SDL_AUDIO_FRAMESIZE(stream->src_spec);
+                const int queued_bytes = SDL_GetAudioStreamQueued(stream);
+                if ((framesize > 0) && (queued_bytes > 0)) {
+                    queued += queued_bytes / framesize;
+                }
+            }
+        }
+    }
+    stats->queued_frames = queued;
+}
+
+void SDL_AudioDeviceXrun(SDL_AudioDevice *device)
+{
+    if (device) {
+        SDL_AddAtomicInt(&device->xruns, 1);
+    }
+}
+
+static bool SDL_PlaybackAudioThreadIterateInternal(SDL_AudioDevice *device)
 {
     SDL_assert(!device->recording);
 
@@ -1134,6 +1417,9 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 iterate_start = SDL_GetTicksNS();
+    Uint64 mix_ns = 0;
+    Uint64 convert_ns = 0;
     bool failed = false;
     int buffer_size = device->buffer_size;
     Uint8 *device_buffer = device->GetDeviceBuf(device, &buffer_size);
@@ -1155,7 +1441,9 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
 
             SDL_assert(stream->src_spec.format != SDL_AUDIO_UNKNOWN);
 
+            const Uint64 mix_start = SDL_GetTicksNS();
             const int br = SDL_GetAtomicInt(&logdev->paused) ? 0 : SDL_GetAudioStreamDataAdjustGain(stream, device_buffer, buffer_size, logdev->gain);
+            mix_ns = SDL_GetTicksNS() - mix_start;
 
             if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
                 failed = true;
@@ -1168,6 +1456,7 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
             if ((br > 0) && (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap))) {
                 ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), device_buffer, device->spec.format, device->spec.channels, NULL,
                              device_buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+                convert_ns = SDL_GetTicksNS() - mix_start - mix_ns;
             }
         } else {  // need to actually mix (or silence the buffer)
             float *final_mix_buffer = (float *) ((device->spec.format == SDL_AUDIO_F32) ? device_buffer : device->mix_buffer);
@@ -1182,54 +1471,61 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
 
             SDL_memset(final_mix_buffer, '\0', work_buffer_size);  // start with silence.
 
-            for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
-                if (SDL_GetAtomicInt(&logdev->paused)) {
-                    continue;  // paused? Skip this logical device.
+            const Uint64 mix_start = SDL_GetTicksNS();
+            const int num_parallel_slots = PrepareParallelMix(device, work_buffer_size);
+            if (num_parallel_slots > 0) {
+                if (!MixBoundAudioStreamsParallel(device, num_parallel_slots, final_mix_buffer, work_buffer_size, &outspec)) {
+                    failed = true;
                 }
+            } else {
+                for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+                    if (SDL_GetAtomicInt(&logdev->paused)) {
+                        continue;  // paused? Skip this logical device.
+                    }
 
-                const SDL_AudioPostmixCallback postmix = logdev->postmix;
-                float *mix_buffer = final_mix_buffer;
-                if (postmix) {
-                    mix_buffer = device->postmix_buffer;
-                    SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
-                }
-
-                for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
-                    // We should have updated this elsewhere if the format changed!
-                    SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, NULL, NULL));
-
-                    SDL_assert(stream->src_spec.format != SDL_AUDIO_UNKNOWN);
+                    const SDL_AudioPostmixCallback postmix = logdev->postmix;
+                    float *mix_buffer = final_mix_buffer;
+                    if (postmix) {
+                        mix_buffer = device->postmix_buffer;
+                        SDL_memset(mix_buffer, '\0', work_buffer_size);  // start with silence.
+                    }
 
-                    /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
-                       for iterating here because the binding linked list can only change while the device lock is held.
-                       (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
-                       the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamDataAdjustGain(stream, device->work_buffer, work_buffer_size, logdev->gain);
-                    if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
-                        failed = true;
-                        break;
-                    } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to device layout.
-                        if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->dst_chmap, device->chmap)) {
-                            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), device->work_buffer, device->spec.format, device->spec.channels, NULL,
-                                         device->work_buffer, device->spec.format, device->spec.channels, device->chmap, NULL, 1.0f);
+                    for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+                        // We should have updated this elsewhere if the format changed!
+                        SDL_assert(SDL_AudioSpecsEqual(&stream->dst_spec, &outspec, NULL, NULL));
+
+                        SDL_assert(stream->src_spec.format != SDL_AUDIO_UNKNOWN);
+
+                        /* this will hold a lock on `stream` while getting. We don't explicitly lock the streams
+                           for iterating here because the binding linked list can only change while the device lock is held.
+                           (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
+                           the same stream to different devices at the same time, though.) */
+                        const int br = GetBoundAudioStreamData(device, stream, device->work_buffer, work_buffer_size, logdev->gain);
+                        if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
+                            failed = true;
+                            break;
+                        } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
+                            MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
                         }
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
                     }
-                }
 
-                if (postmix) {
-                    SDL_assert(mix_buffer == device->postmix_buffer);
-                    postmix(logdev->postmix_userdata, &outspec, mix_buffer, work_buffer_size);
-                    MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size);
+                    if (postmix) {
+                        SDL_assert(mix_buffer == device->postmix_buffer);
+                        postmix(logdev->postmix_userdata, &outspec, mix_buffer, work_buffer_size);
+                        MixFloat32Audio(final_mix_buffer, mix_buffer, work_buffer_size);
+                    }
                 }
             }
 
+            const Uint64 convert_start = SDL_GetTicksNS();
+            mix_ns = convert_start - mix_start;
+
             if (((Uint8 *) final_mix_buffer) != device_buffer) {
                 // !!! FIXME: we can't promise the device buf is aligned/padded for SIMD.
                 //ConvertAudio(needed_samples / device->spec.channels, final_mix_buffer, SDL_AUDIO_F32, device->spec.channels, NULL, device_buffer, device->spec.format, device->spec.channels, NULL, NULL, 1.0f);
                 ConvertAudio(needed_samples / device->spec.channels, final_mix_buffer, SDL_AUDIO_F32, device->spec.channels, NULL, device->work_buffer, device->spec.format, device->spec.channels, NULL, NULL, 1.0f);
                 SDL_memcpy(device_buffer, device->work_buffer, buffer_size);
+                convert_ns = SDL_GetTicksNS() - convert_start;
             }
         }
 
@@ -1237,6 +1533,8 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
         if (!device->PlayDevice(device, device_buffer, buffer_size)) {
             failed = true;
         }
+
+        UpdateAudioDeviceStats(device, iterate_start, mix_ns, convert_ns);
     }
 
     SDL_UnlockMutex(device->lock);
@@ -1248,6 +1546,16 @@ bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
     return true;  // always go on if not shutting down, even if device failed.
 }
 
+bool SDL_PlaybackAudioThreadIterate(SDL_AudioDevice *device)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_AUDIO);
+    SDL_TRACE_BEGIN("SDL_PlaybackAudioThreadIterate");
+    bool result = SDL_PlaybackAudioThreadIterateInternal(device);
+    SDL_TRACE_END("SDL_PlaybackAudioThreadIterate");
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 void SDL_PlaybackAudioThreadShutdown(SDL_AudioDevice *device)
 {
     SDL_assert(!device->recording);
@@ -1287,7 +1595,7 @@ void SDL_RecordingAudioThreadSetup(SDL_AudioDevice *device)
     current_audio.impl.ThreadInit(device);
 }
 
-bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
+static bool SDL_RecordingAudioThreadIterateInternal(SDL_AudioDevice *device)
 {
     SDL_assert(device->recording);
 
@@ -1298,6 +1606,7 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
         return false;  // we're done, shut it down.
     }
 
+    const Uint64 iterate_start = SDL_GetTicksNS();
     bool failed = false;
 
     if (!device->logical_devices) {
@@ -1313,7 +1622,15 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
                     continue;  // paused? Skip this logical device.
                 }
 
+                if (logdev->recording_callback) {
+                    logdev->recording_callback(logdev->recording_userdata, &device->spec, device->work_buffer, br);
+                }
+
                 void *output_buffer = device->work_buffer;
+                // the layout currently in mix_buffer, so streams wanting the same layout share one conversion.
+                int swizzled_chmap_storage[SDL_MAX_CHANNELMAP_CHANNELS];
+                const int *swizzled_chmap = NULL;
+                bool swizzled = false;
 
                 // I don't know why someone would want a postmix on a recording device, but we offer it for API consistency.
                 if (logdev->postmix || (logdev->gain != 1.0f)) {
@@ -1342,8 +1659,17 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
                     // generally channel maps will line up, but if the audio stream's chmap has been explicitly changed, do a final swizzle to stream layout.
                     if (!SDL_AudioChannelMapsEqual(device->spec.channels, stream->src_chmap, device->chmap)) {
                         final_buf = device->mix_buffer;  // this is otherwise unused on recording devices, so it makes convenient scratch space here.
-                        ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), output_buffer, device->spec.format, device->spec.channels, NULL,
-                                     final_buf, device->spec.format, device->spec.channels, stream->src_chmap, NULL, 1.0f);
+                        if (!swizzled || !SDL_AudioChannelMapsEqual(device->spec.channels, stream->src_chmap, swizzled_chmap)) {
+                            ConvertAudio(br / SDL_AUDIO_FRAMESIZE(device->spec), output_buffer, device->spec.format, device->spec.channels, NULL,
+                                         final_buf, device->spec.format, device->spec.channels, stream->src_chmap, NULL, 1.0f);
+                            if (stream->src_chmap) {
+                                SDL_memcpy(swizzled_chmap_storage, stream->src_chmap, sizeof (int) * device->spec.channels);
+                                swizzled_chmap = swizzled_chmap_storage;
+                            } else {
+                                swizzled_chmap = NULL;
+                            }
+                            swizzled = true;
+                        }
                     }
 
                     /* this will hold a lock on `stream` while putting. We don't explicitly lock the streams
@@ -1357,6 +1683,8 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
                     }
                 }
             }
+
+            UpdateAudioDeviceStats(device, iterate_start, 0, 0);
         }
     }
 
@@ -1369,6 +1697,16 @@ bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
     return true;  // always go on if not shutting down, even if device failed.
 }
 
+bool SDL_RecordingAudioThreadIterate(SDL_AudioDevice *device)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_AUDIO);
+    SDL_TRACE_BEGIN("SDL_RecordingAudioThreadIterate");
+    bool result = SDL_RecordingAudioThreadIterateInternal(device);
+    SDL_TRACE_END("SDL_RecordingAudioThreadIterate");
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 void SDL_RecordingAudioThreadShutdown(SDL_AudioDevice *device)
 {
     SDL_assert(device->recording);
@@ -1429,6 +1767,8 @@ static SDL_AudioDeviceID *GetAudioDevices(int *count, bool recording)
     SDL_AudioDeviceID *result = NULL;
     int num_devices = 0;
 
+    WaitForAudioDeviceDetection();
+
     if (SDL_GetCurrentAudioDriver()) {
         SDL_LockRWLockForReading(current_audio.device_hash_lock);
         {
@@ -1574,6 +1914,24 @@ bool SDL_GetAudioDeviceFormat(SDL_AudioDeviceID devid, SDL_AudioSpec *spec, int
     return result;
 }
 
+bool SDL_GetAudioDeviceStats(SDL_AudioDeviceID devid, SDL_AudioDeviceStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    bool result = false;
+    SDL_AudioDevice *device = ObtainPhysicalAudioDeviceDefaultAllowed(devid);
+    if (device) {
+        SDL_copyp(stats, &device->stats);
+        stats->xruns = (Uint64) SDL_GetAtomicInt(&device->xruns);
+        result = true;
+    }
+    ReleaseAudioDevice(device);
+
+    return result;
+}
+
 int *SDL_GetAudioDeviceChannelMap(SDL_AudioDeviceID devid, int *count)
 {
     int *result = NULL;
@@ -1642,6 +2000,14 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_aligned_free(device->postmix_buffer);
     device->postmix_buffer = NULL;
 
+    SDL_aligned_free(device->parallel_buffer);
+    device->parallel_buffer = NULL;
+    device->parallel_buffer_allocation = 0;
+
+    SDL_free(device->parallel_slots);
+    device->parallel_slots = NULL;
+    device->parallel_slots_allocation = 0;
+
     SDL_copyp(&device->spec, &device->default_spec);
     device->sample_frames = 0;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
@@ -1742,6 +2108,10 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
         return true;  // we're already good.
     }
 
+    SDL_zero(device->stats);
+    device->last_iterate_ns = 0;
+    SDL_SetAtomicInt(&device->xruns, 0);
+
     // Just pretend to open a zombie device. It can still collect logical devices on a default device under the assumption they will all migrate when the default device is officially changed.
     if (SDL_GetAtomicInt(&device->zombie)) {
         return true;  // Braaaaaaaaains.
@@ -1797,6 +2167,8 @@ static bool OpenPhysicalAudioDevice(SDL_AudioDevice *device, const SDL_AudioSpec
         }
     }
 
+    device->parallel_mix = !device->recording && SDL_GetHintBoolean(SDL_HINT_AUDIO_DEVICE_PARALLEL_MIX, false);
+
     // Start the audio thread if necessary
     if (!current_audio.impl.ProvidesOwnCallbackThread) {
         char threadname[64];
@@ -1958,6 +2330,24 @@ bool SDL_SetAudioPostmixCallback(SDL_AudioDeviceID devid, SDL_AudioPostmixCallba
     return result;
 }
 
+bool SDL_SetAudioRecordingCallback(SDL_AudioDeviceID devid, SDL_AudioRecordingCallback callback, void *userdata)
+{
+    SDL_AudioDevice *device = NULL;
+    SDL_LogicalAudioDevice *logdev = ObtainLogicalAudioDevice(devid, &device);
+    bool result = false;
+    if (logdev) {
+        if (!device->recording) {
+            SDL_SetError("Not a recording device");
+        } else {
+            logdev->recording_callback = callback;
+            logdev->recording_userdata = userdata;
+            result = true;
+        }
+    }
+    ReleaseAudioDevice(device);
+    return result;
+}
+
 bool SDL_BindAudioStreams(SDL_AudioDeviceID devid, SDL_AudioStream * const *streams, int num_streams)
 {
     const bool islogical = !(devid & (1<<1));
@@ -99,6 +99,203 @@ static void SDL_TARGETING("sse") SDL_ConvertMonoToStereo_SSE(float *dst, const f
 // Include the autogenerated channel converters...
 #include "SDL_audio_channel_converters.h"
 
+/* Channel mixing through a gain matrix. Matrices hold SDL_AUDIO_MIX_MATRIX_STRIDE gains for each source channel,
+   one per output channel, so a single SIMD register can hold everything a source channel contributes to a frame.
+   Like the generated converters, these sum the source channels in order, so the default matrices produce the same
+   results, and they work in-place: growing conversions run backwards, shrinking ones run forwards. */
+typedef void (*SDL_AudioChannelMixer)(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix);
+
+static float SDL_audio_mix_matrices[8][8][8 * SDL_AUDIO_MIX_MATRIX_STRIDE];  // [from][to], built from channel_converters.
+static SDL_AudioChannelMixer SDL_MixAudioChannels_SIMD = NULL;
+
+static void SDL_MixAudioChannels_Scalar(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    const bool forwards = (dst_channels <= src_channels);
+    const int src_step = forwards ? src_channels : -src_channels;
+    const int dst_step = forwards ? dst_channels : -dst_channels;
+    float frame[8];
+
+    LOG_DEBUG_AUDIO_CONVERT("channels", "channels (using mix matrix)");
+
+    if (!forwards) {  // convert backwards, since output is growing in-place.
+        src += (num_frames - 1) * src_channels;
+        dst += (num_frames - 1) * dst_channels;
+    }
+
+    for (int i = num_frames; i; i--, src += src_step, dst += dst_step) {
+        for (int ch = 0; ch < src_channels; ch++) {
+            frame[ch] = src[ch];
+        }
+        for (int ch = 0; ch < dst_channels; ch++) {
+            float sample = 0.0f;  // starting from +0 keeps unused outputs from becoming -0.
+            for (int s = 0; s < src_channels; s++) {
+                sample += frame[s] * matrix[(s * SDL_AUDIO_MIX_MATRIX_STRIDE) + ch];
+            }
+            dst[ch] = sample;
+        }
+    }
+}
+
+#ifdef SDL_AVX_INTRINSICS
+static void SDL_TARGETING("avx") SDL_MixAudioChannels_AVX(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    static const Sint32 store_mask_bits[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const __m256i store_mask = _mm256_loadu_si256((const __m256i *)(store_mask_bits + 8 - dst_channels));
+    const bool forwards = (dst_channels <= src_channels);
+    const int src_step = forwards ? src_channels : -src_channels;
+    const int dst_step = forwards ? dst_channels : -dst_channels;
+    __m256 gains[8];
+    int i = num_frames;
+
+    LOG_DEBUG_AUDIO_CONVERT("channels", "channels (using AVX mix matrix)");
+
+    for (int s = 0; s < src_channels; s++) {
+        gains[s] = _mm256_loadu_ps(matrix + (s * SDL_AUDIO_MIX_MATRIX_STRIDE));
+    }
+
+    if (!forwards) {  // convert backwards, since output is growing in-place.
+        src += (num_frames - 1) * src_channels;
+        dst += (num_frames - 1) * dst_channels;
+    }
+
+    /* Each frame's sum is one long chain of adds, so work on four frames at once to keep the adder busy. All four
+       source frames are read before any of the (masked) stores, so this is still safe when the buffers overlap. */
+    for (; i >= 4; i -= 4, src += src_step * 4, dst += dst_step * 4) {
+        __m256 frame0 = _mm256_setzero_ps();  // starting from +0 keeps unused outputs from becoming -0.
+        __m256 frame1 = _mm256_setzero_ps();
+        __m256 frame2 = _mm256_setzero_ps();
+        __m256 frame3 = _mm256_setzero_ps();
+        for (int s = 0; s < src_channels; s++) {
+            frame0 = _mm256_add_ps(frame0, _mm256_mul_ps(_mm256_broadcast_ss(&src[s]), gains[s]));
+            frame1 = _mm256_add_ps(frame1, _mm256_mul_ps(_mm256_broadcast_ss(&src[src_step + s]), gains[s]));
+            frame2 = _mm256_add_ps(frame2, _mm256_mul_ps(_mm256_broadcast_ss(&src[(src_step * 2) + s]), gains[s]));
+            frame3 = _mm256_add_ps(frame3, _mm256_mul_ps(_mm256_broadcast_ss(&src[(src_step * 3) + s]), gains[s]));
+        }
+        _mm256_maskstore_ps(dst, store_mask, frame0);
+        _mm256_maskstore_ps(dst + dst_step, store_mask, frame1);
+        _mm256_maskstore_ps(dst + (dst_step * 2), store_mask, frame2);
+        _mm256_maskstore_ps(dst + (dst_step * 3), store_mask, frame3);
+    }
+
+    // Finish off any leftovers one frame at a time.
+    for (; i; i--, src += src_step, dst += dst_step) {
+        __m256 frame = _mm256_setzero_ps();
+        for (int s = 0; s < src_channels; s++) {
+            frame = _mm256_add_ps(frame, _mm256_mul_ps(_mm256_broadcast_ss(&src[s]), gains[s]));
+        }
+        _mm256_maskstore_ps(dst, store_mask, frame);
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void SDL_MixAudioChannels_NEON(float *dst, const float *src, int num_frames, int src_channels, int dst_channels, const float *matrix)
+{
+    const bool forwards = (dst_channels <= src_channels);
+    const int src_step = forwards ? src_channels : -src_channels;
+    const int dst_step = forwards ? dst_channels : -dst_channels;
+    float32x4_t gains_lo[8], gains_hi[8];
+    float frame[8];
+
+    LOG_DEBUG_AUDIO_CONVERT("channels", "channels (using NEON mix matrix)");
+
+    for (int s = 0; s < src_channels; s++) {
+        gains_lo[s] = vld1q_f32(matrix + (s * SDL_AUDIO_MIX_MATRIX_STRIDE));
+        gains_hi[s] = vld1q_f32(matrix + (s * SDL_AUDIO_MIX_MATRIX_STRIDE) + 4);
+    }
+
+    if (!forwards) {  // convert backwards, since output is growing in-place.
+        src += (num_frames - 1) * src_channels;
+        dst += (num_frames - 1) * dst_channels;
+    }
+
+    for (int i = num_frames; i; i--, src += src_step, dst += dst_step) {
+        float32x4_t lo = vdupq_n_f32(0.0f);  // starting from +0 keeps unused outputs from becoming -0.
+        float32x4_t hi = vdupq_n_f32(0.0f);
+        for (int s = 0; s < src_channels; s++) {
+            lo = vaddq_f32(lo, vmulq_n_f32(gains_lo[s], src[s]));
+            hi = vaddq_f32(hi, vmulq_n_f32(gains_hi[s], src[s]));
+        }
+        if (dst_channels == 8) {
+            vst1q_f32(dst, lo);
+            vst1q_f32(dst + 4, hi);
+        } else {
+            vst1q_f32(frame, lo);
+            vst1q_f32(frame + 4, hi);
+            for (int ch = 0; ch < dst_channels; ch++) {
+                dst[ch] = frame[ch];
+            }
+        }
+    }
+}
+#endif
+
+void SDL_SetupAudioChannelMixer(void)
+{
+    static SDL_InitState init;
+
+    if (SDL_ShouldInit(&init)) {
+        // Recover the gains of each generated converter by running it over an impulse on every source channel.
+        float impulses[8 * 8];
+        float responses[8 * 8];
+        for (int src_channels = 1; src_channels <= 8; src_channels++) {
+            SDL_zeroa(impulses);
+            for (int s = 0; s < src_channels; s++) {
+                impulses[(s * src_channels) + s] = 1.0f;
+            }
+            for (int dst_channels = 1; dst_channels <= 8; dst_channels++) {
+                float *matrix = SDL_audio_mix_matrices[src_channels - 1][dst_channels - 1];
+                const SDL_AudioChannelConverter channel_converter = channel_converters[src_channels - 1][dst_channels - 1];
+                if (channel_converter) {
+                    channel_converter(responses, impulses, src_channels);
+                } else {
+                    SDL_memcpy(responses, impulses, sizeof (impulses));
+                }
+                for (int s = 0; s < src_channels; s++) {
+                    for (int ch = 0; ch < dst_channels; ch++) {
+                        matrix[(s * SDL_AUDIO_MIX_MATRIX_STRIDE) + ch] = responses[(s * dst_channels) + ch];
+                    }
+                }
+            }
+        }
+
+#ifdef SDL_AVX_INTRINSICS
+        if (SDL_HasAVX()) {
+            SDL_MixAudioChannels_SIMD = SDL_MixAudioChannels_AVX;
+        } else
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            SDL_MixAudioChannels_SIMD = SDL_MixAudioChannels_NEON;
+        } else
+#endif
+        {
+            SDL_MixAudioChannels_SIMD = NULL;  // the generated converters are faster than a scalar matrix.
+        }
+
+        SDL_SetInitialized(&init, true);
+    }
+}
+
+// Fold the channel maps around a mix into its matrix, so the swizzles don't need their own passes over the data.
+static void FoldChannelMapsIntoMixMatrix(float *folded, const float *matrix, int src_channels, const int *src_map, int dst_channels, const int *dst_map)
+{
+    SDL_memset(folded, 0, sizeof (float) * 8 * SDL_AUDIO_MIX_MATRIX_STRIDE);
+
+    for (int s = 0; s < src_channels; s++) {
+        const int src_ch = src_map ? src_map[s] : s;
+        if (src_ch == -1) {
+            continue;  // this channel is silence, so it contributes nothing.
+        }
+        for (int ch = 0; ch < dst_channels; ch++) {
+            const int dst_ch = dst_map ? dst_map[ch] : ch;
+            if (dst_ch != -1) {
+                folded[(src_ch * SDL_AUDIO_MIX_MATRIX_STRIDE) + ch] += matrix[(s * SDL_AUDIO_MIX_MATRIX_STRIDE) + dst_ch];
+            }
+        }
+    }
+}
+
 static bool SDL_IsSupportedAudioFormat(const SDL_AudioFormat fmt)
 {
     switch (fmt) {
@@ -234,10 +431,12 @@ static void SwizzleAudio(const int num_frames, void *dst, const void *src, int c
 // Since this is a convenient point that audio goes through even if it doesn't need format conversion,
 // we also handle gain adjustment here, so we don't have to make another pass over the data later.
 // Strictly speaking, this is also a "conversion".  :)
-void ConvertAudio(int num_frames,
-                  const void *src, SDL_AudioFormat src_format, int src_channels, const int *src_map,
-                  void *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
-                  void *scratch, float gain)
+//
+// If mix_matrix isn't NULL, it replaces the default up/downmixing (layout as SDL_audio_mix_matrices), even if the channel counts match.
+void ConvertAudioWithMixMatrix(int num_frames,
+                               const void *src, SDL_AudioFormat src_format, int src_channels, const int *src_map,
+                               void *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
+                               const float *mix_matrix, void *scratch, float gain)
 {
     SDL_assert(src != NULL);
     SDL_assert(dst != NULL);
@@ -258,10 +457,31 @@ void ConvertAudio(int num_frames,
     const int dst_sample_frame_size = (dst_bitsize / 8) * dst_channels;
 
     const bool chmaps_match = (src_channels == dst_channels) && SDL_AudioChannelMapsEqual(src_channels, src_map, dst_map);
-    if (chmaps_match) {
+    if (chmaps_match && !mix_matrix) {
         src_map = dst_map = NULL;  // NULL both these out so we don't do any unnecessary swizzling.
     }
 
+    const bool channelconvert = (src_channels != dst_channels) || (mix_matrix != NULL);
+
+    /* Mix the channels through a matrix if the app gave us one, or if there are channel maps to fold into it and we have
+       a SIMD mixer. Otherwise, the generated converters are at least as fast, since they skip all the zero gains. */
+    SDL_AudioChannelMixer channel_mixer = NULL;
+    float folded_matrix[8 * SDL_AUDIO_MIX_MATRIX_STRIDE];
+    if (channelconvert) {
+        if (mix_matrix) {
+            channel_mixer = SDL_MixAudioChannels_SIMD ? SDL_MixAudioChannels_SIMD : SDL_MixAudioChannels_Scalar;
+        } else if (SDL_MixAudioChannels_SIMD && (src_map || dst_map)) {
+            channel_mixer = SDL_MixAudioChannels_SIMD;
+            mix_matrix = SDL_audio_mix_matrices[src_channels - 1][dst_channels - 1];
+        }
+
+        if (channel_mixer && (src_map || dst_map)) {
+            FoldChannelMapsIntoMixMatrix(folded_matrix, mix_matrix, src_channels, src_map, dst_channels, dst_map);
+            mix_matrix = folded_matrix;
+            src_map = dst_map = NULL;
+        }
+    }
+
     /* Type conversion goes like this now:
         - swizzle through source channel map to "standard" layout.
         - byteswap to CPU native format first if necessary.
@@ -286,7 +506,7 @@ void ConvertAudio(int num_frames,
     }
 
     // see if we can skip float conversion entirely.
-    if ((src_channels == dst_channels) && (gain == 1.0f)) {
+    if (!channelconvert && (gain == 1.0f)) {
         if (src_format == dst_format) {
             // nothing to do, we're already in the right format, just copy it over if necessary.
             if (dst_map) {
@@ -313,7 +533,6 @@ void ConvertAudio(int num_frames,
     }
 
     const bool srcconvert = src_format != SDL_AUDIO_F32;
-    const bool channelconvert = src_channels != dst_channels;
     const bool dstconvert = dst_format != SDL_AUDIO_F32;
 
     // get us to float format.
@@ -342,7 +561,11 @@ void ConvertAudio(int num_frames,
 
     // Channel conversion
 
-    if (channelconvert) {
+    if (channel_mixer) {
+        void* buf = dstconvert ? scratch : dst;
+        channel_mixer((float *) buf, (const float *) src, num_frames, src_channels, dst_channels, mix_matrix);
+        src = buf;
+    } else if (channelconvert) {
         SDL_AudioChannelConverter channel_converter;
         SDL_AudioChannelConverter override = NULL;
 
@@ -388,6 +611,14 @@ void ConvertAudio(int num_frames,
     }
 }
 
+void ConvertAudio(int num_frames,
+                  const void *src, SDL_AudioFormat src_format, int src_channels, const int *src_map,
+                  void *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
+                  void *scratch, float gain)
+{
+    ConvertAudioWithMixMatrix(num_frames, src, src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, NULL, scratch, gain);
+}
+
 // Calculate the largest frame size needed to convert between the two formats.
 static int CalculateMaxFrameSize(SDL_AudioFormat src_format, int src_channels, SDL_AudioFormat dst_format, int dst_channels)
 {
@@ -399,9 +630,14 @@ static int CalculateMaxFrameSize(SDL_AudioFormat src_format, int src_channels, S
     return max_format_size * max_channels;
 }
 
+static int GetAudioStreamResampleFreq(SDL_AudioStream* stream, int src_freq)
+{
+    return (int)((float)src_freq * stream->freq_ratio);
+}
+
 static Sint64 GetAudioStreamResampleRate(SDL_AudioStream* stream, int src_freq, Sint64 resample_offset)
 {
-    src_freq = (int)((float)src_freq * stream->freq_ratio);
+    src_freq = GetAudioStreamResampleFreq(stream, src_freq);
 
     Sint64 resample_rate = SDL_GetResampleRate(src_freq, stream->dst_spec.freq);
 
@@ -440,6 +676,7 @@ SDL_AudioStream *SDL_CreateAudioStream(const SDL_AudioSpec *src_spec, const SDL_
 {
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
+    SDL_SetupAudioChannelMixer();
 
     SDL_AudioStream *result = (SDL_AudioStream *)SDL_calloc(1, sizeof(SDL_AudioStream));
     if (!result) {
@@ -594,9 +831,12 @@ bool SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_
     }
 
     if (src_spec) {
+        // anything still in the ring buffer was put in the old format.
+        SDL_DrainAudioStreamRingBuffer(stream);
         if (src_spec->channels != stream->src_spec.channels) {
             SDL_free(stream->src_chmap);
             stream->src_chmap = NULL;
+            stream->mix_matrix = NULL;
         }
         SDL_copyp(&stream->src_spec, src_spec);
     }
@@ -605,6 +845,7 @@ bool SDL_SetAudioStreamFormat(SDL_AudioStream *stream, const SDL_AudioSpec *src_
         if (dst_spec->channels != stream->dst_spec.channels) {
             SDL_free(stream->dst_chmap);
             stream->dst_chmap = NULL;
+            stream->mix_matrix = NULL;
         }
         SDL_copyp(&stream->dst_spec, dst_spec);
     }
@@ -664,6 +905,35 @@ bool SDL_SetAudioStreamOutputChannelMap(SDL_AudioStream *stream, const int *chma
     return SetAudioStreamChannelMap(stream, &stream->dst_spec, &stream->dst_chmap, chmap, channels, 0);
 }
 
+bool SDL_SetAudioStreamMixMatrix(SDL_AudioStream *stream, const float *matrix, int src_channels, int dst_channels)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    bool result = true;
+
+    SDL_LockMutex(stream->lock);
+
+    if ((src_channels != stream->src_spec.channels) || (dst_channels != stream->dst_spec.channels)) {
+        result = SDL_SetError("Wrong number of channels");
+    } else if (!matrix) {
+        stream->mix_matrix = NULL;  // back to the default up/downmix.
+    } else {
+        // the app gives us a row per output channel, but we keep a column per input channel, for the SIMD mixers.
+        SDL_zeroa(stream->mix_matrix_storage);
+        for (int ch = 0; ch < dst_channels; ch++) {
+            for (int s = 0; s < src_channels; s++) {
+                stream->mix_matrix_storage[(s * SDL_AUDIO_MIX_MATRIX_STRIDE) + ch] = matrix[(ch * src_channels) + s];
+            }
+        }
+        stream->mix_matrix = stream->mix_matrix_storage;
+    }
+
+    SDL_UnlockMutex(stream->lock);
+    return result;
+}
+
 int *SDL_GetAudioStreamInputChannelMap(SDL_AudioStream *stream, int *count)
 {
     int *result = NULL;
@@ -777,6 +1047,102 @@ static bool CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
     return true;
 }
 
+void SDL_DrainAudioStreamRingBuffer(SDL_AudioStream *stream)
+{
+    if (!stream->ring) {
+        return;
+    }
+
+    const Uint32 mask = stream->ring_size - 1;
+    const Uint32 head = SDL_GetAtomicU32(&stream->ring_head);
+    Uint32 tail = SDL_GetAtomicU32(&stream->ring_tail);
+
+    while (tail != head) {
+        const Uint32 pos = tail & mask;
+        const Uint32 len = SDL_min(head - tail, stream->ring_size - pos);
+        if (!SDL_WriteToAudioQueue(stream->queue, &stream->src_spec, stream->src_chmap, stream->ring + pos, len)) {
+            break;  // out of memory? Leave the rest for the next try.
+        }
+        tail += len;
+    }
+
+    SDL_SetAtomicU32(&stream->ring_tail, tail);
+}
+
+// Called by the producer without the stream lock. Returns false if the data has to take the locked path instead.
+static bool PutAudioStreamRingBuffer(SDL_AudioStream *stream, const void *buf, int len)
+{
+    if (stream->put_callback || (len % SDL_AUDIO_FRAMESIZE(stream->src_spec)) != 0) {
+        return false;  // callbacks need the lock, and the locked path reports the error for partial frames.
+    }
+
+    // only the producer moves the head, and the tail only moves forward, so the free space can't shrink while we copy.
+    const Uint32 head = SDL_GetAtomicU32(&stream->ring_head);
+    const Uint32 tail = SDL_GetAtomicU32(&stream->ring_tail);
+    if ((Uint32)len > stream->ring_size - (head - tail)) {
+        return false;  // full.
+    }
+
+    const Uint32 pos = head & (stream->ring_size - 1);
+    const Uint32 first = SDL_min((Uint32)len, stream->ring_size - pos);
+    SDL_memcpy(stream->ring + pos, buf, first);
+    SDL_memcpy(stream->ring, (const Uint8 *)buf + first, len - first);
+
+    // publish the data; this is a full memory barrier, so the consumer sees the bytes before the new head.
+    SDL_SetAtomicU32(&stream->ring_head, head + (Uint32)len);
+    return true;
+}
+
+bool SDL_SetAudioStreamLockFreeBuffer(SDL_AudioStream *stream, int num_frames)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (num_frames < 0) {
+        return SDL_InvalidParamError("num_frames");
+    }
+
+    Uint8 *ring = NULL;
+    Uint32 ring_size = 0;
+
+    SDL_LockMutex(stream->lock);
+
+    if (num_frames > 0) {
+        if (stream->src_spec.format == 0) {
+            SDL_UnlockMutex(stream->lock);
+            return SDL_SetError("Stream has no source format");
+        }
+
+        const Uint64 wanted = (Uint64)num_frames * SDL_AUDIO_FRAMESIZE(stream->src_spec);
+        if (wanted > 0x40000000) {
+            SDL_UnlockMutex(stream->lock);
+            return SDL_SetError("Lock-free buffer is too large");
+        }
+
+        // a power of two, so the byte counters can wrap around freely.
+        ring_size = 1;
+        while (ring_size < wanted) {
+            ring_size <<= 1;
+        }
+
+        ring = (Uint8 *)SDL_malloc(ring_size);
+        if (!ring) {
+            SDL_UnlockMutex(stream->lock);
+            return false;
+        }
+    }
+
+    SDL_DrainAudioStreamRingBuffer(stream);
+    SDL_free(stream->ring);
+    stream->ring = ring;
+    stream->ring_size = ring_size;
+    SDL_SetAtomicU32(&stream->ring_head, 0);
+    SDL_SetAtomicU32(&stream->ring_tail, 0);
+
+    SDL_UnlockMutex(stream->lock);
+
+    return true;
+}
+
 static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int len, SDL_ReleaseAudioBufferCallback callback, void* userdata)
 {
 #if DEBUG_AUDIOSTREAM
@@ -795,6 +1161,9 @@ static bool PutAudioStreamBuffer(SDL_AudioStream *stream, const void *buf, int l
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    // keep the data in order with anything that was put through the ring buffer.
+    SDL_DrainAudioStreamRingBuffer(stream);
+
     SDL_AudioTrack* track = NULL;
 
     if (callback) {
@@ -833,6 +1202,11 @@ static void SDLCALL FreeAllocatedAudioBuffer(void *userdata, const void *buf, in
     SDL_free((void*) buf);
 }
 
+static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
+{
+    // We don't own the buffer, but know it will outlive the stream
+}
+
 bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
 {
     if (!stream) {
@@ -843,6 +1217,8 @@ bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return SDL_InvalidParamError("len");
     } else if (len == 0) {
         return true; // nothing to do.
+    } else if (stream->ring && PutAudioStreamRingBuffer(stream, buf, len)) {
+        return true;
     }
 
     // When copying in large amounts of data, try and do as much work as possible
@@ -869,6 +1245,25 @@ bool SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
     return PutAudioStreamBuffer(stream, buf, len, NULL, NULL);
 }
 
+bool SDL_PutAudioStreamDataNoCopy(SDL_AudioStream *stream, const void *buf, int len, SDL_AudioStreamDataCompleteCallback callback, void *userdata)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    } else if (!buf) {
+        return SDL_InvalidParamError("buf");
+    } else if (len < 0) {
+        return SDL_InvalidParamError("len");
+    } else if (len == 0) {
+        if (callback) {
+            callback(userdata, buf, len);
+        }
+        return true; // nothing to do.
+    }
+
+    // The track is exactly as large as the app's buffer, so nothing else is ever written into it.
+    return PutAudioStreamBuffer(stream, buf, len, callback ? callback : DontFreeThisAudioBuffer, userdata);
+}
+
 bool SDL_FlushAudioStream(SDL_AudioStream *stream)
 {
     if (!stream) {
@@ -876,6 +1271,7 @@ bool SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    SDL_DrainAudioStreamRingBuffer(stream);
     SDL_FlushAudioQueue(stream->queue);
     SDL_UnlockMutex(stream->lock);
 
@@ -996,6 +1392,32 @@ static Sint64 GetAudioStreamHead(SDL_AudioStream* stream, SDL_AudioSpec* out_spe
 
 // You must hold stream->lock and validate your parameters before calling this!
 // Enough input data MUST be available!
+static void ResampleAudioStream(SDL_AudioStream *stream, int chans, const float *src, int inframes, float *dst, int outframes, int src_freq, Sint64 resample_rate)
+{
+    if (SDL_GetBooleanProperty(stream->props, SDL_PROP_AUDIOSTREAM_LINEAR_RESAMPLING_BOOLEAN, false)) {
+        SDL_ResampleAudioLinear(chans, src, inframes, dst, outframes, resample_rate, &stream->resample_offset);
+        return;
+    }
+
+    // Fixed ratios share precomputed filters between streams; hang on to them while the ratio stays the same.
+    src_freq = GetAudioStreamResampleFreq(stream, src_freq);
+
+    if (stream->resampler_phases && !SDL_ResamplerPhasesMatch(stream->resampler_phases, src_freq, stream->dst_spec.freq)) {
+        SDL_ReleaseResamplerPhases(stream->resampler_phases);
+        stream->resampler_phases = NULL;
+    }
+
+    if (!stream->resampler_phases) {
+        stream->resampler_phases = SDL_AcquireResamplerPhases(src_freq, stream->dst_spec.freq);
+    }
+
+    if (stream->resampler_phases) {
+        SDL_ResampleAudioPolyphase(chans, src, inframes, dst, outframes, stream->resampler_phases, &stream->resample_offset);
+    } else {
+        SDL_ResampleAudio(chans, src, inframes, dst, outframes, resample_rate, &stream->resample_offset);
+    }
+}
+
 static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int output_frames, float gain)
 {
     const SDL_AudioSpec* src_spec = &stream->input_spec;
@@ -1008,6 +1430,9 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     const int dst_channels = dst_spec->channels;
     const int *dst_map = stream->dst_chmap;
 
+    // a custom mix matrix only applies to data that was queued with the input channel count it was set for.
+    const float *mix_matrix = (stream->mix_matrix && (src_channels == stream->src_spec.channels)) ? stream->mix_matrix : NULL;
+
     const int max_frame_size = CalculateMaxFrameSize(src_format, src_channels, dst_format, dst_channels);
     const Sint64 resample_rate = GetAudioStreamResampleRate(stream, src_spec->freq, stream->resample_offset);
 
@@ -1022,7 +1447,7 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
         Uint8* work_buffer = NULL;
 
         // Ensure we have enough scratch space for any conversions
-        if ((src_format != dst_format) || (src_channels != dst_channels) || (gain != 1.0f)) {
+        if ((src_format != dst_format) || (src_channels != dst_channels) || mix_matrix || (gain != 1.0f)) {
             work_buffer = EnsureAudioStreamWorkBufferSize(stream, output_frames * max_frame_size);
 
             if (!work_buffer) {
@@ -1030,7 +1455,7 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
             }
         }
 
-        if (SDL_ReadFromAudioQueue(stream->queue, (Uint8 *)buf, dst_format, dst_channels, dst_map, 0, output_frames, 0, work_buffer, gain) != buf) {
+        if (SDL_ReadFromAudioQueue(stream->queue, (Uint8 *)buf, dst_format, dst_channels, dst_map, mix_matrix, 0, output_frames, 0, work_buffer, gain) != buf) {
             return SDL_SetError("Not enough data in queue");
         }
 
@@ -1054,6 +1479,10 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     // the resampled data.
     const int resample_channels = SDL_min(src_channels, dst_channels);
 
+    // A custom mix matrix is applied wherever the channel count changes (or before resampling if it doesn't).
+    const float *preresample_mix_matrix = (dst_channels <= src_channels) ? mix_matrix : NULL;
+    const float *postresample_mix_matrix = (dst_channels <= src_channels) ? NULL : mix_matrix;
+
     // The size of the frame used when resampling
     const int resample_frame_size = SDL_AUDIO_BYTESIZE(resample_format) * resample_channels;
 
@@ -1102,7 +1531,7 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
 
     // (dst channel map is NULL because we'll do the final swizzle on ConvertAudio after resample.)
     const Uint8* input_buffer = SDL_ReadFromAudioQueue(stream->queue,
-        NULL, resample_format, resample_channels, NULL,
+        NULL, resample_format, resample_channels, NULL, preresample_mix_matrix,
         padding_frames, input_frames, padding_frames, work_buffer, preresample_gain);
 
     if (!input_buffer) {
@@ -1114,13 +1543,13 @@ static bool GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int o
     // Decide where the resampled output goes
     void* resample_buffer = (resample_buffer_offset != -1) ? (work_buffer + resample_buffer_offset) : buf;
 
-    SDL_ResampleAudio(resample_channels,
+    ResampleAudioStream(stream, resample_channels,
                   (const float *) input_buffer, input_frames,
                   (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+                  src_spec->freq, resample_rate);
 
     // Convert to the final format, if necessary (src channel map is NULL because SDL_ReadFromAudioQueue already handled this).
-    ConvertAudio(output_frames, resample_buffer, resample_format, resample_channels, NULL, buf, dst_format, dst_channels, dst_map, work_buffer, postresample_gain);
+    ConvertAudioWithMixMatrix(output_frames, resample_buffer, resample_format, resample_channels, NULL, buf, dst_format, dst_channels, dst_map, postresample_mix_matrix, work_buffer, postresample_gain);
 
     return true;
 }
@@ -1159,6 +1588,8 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
 
     len -= len % dst_frame_size;  // chop off any fractional sample frame.
 
+    SDL_DrainAudioStreamRingBuffer(stream);
+
     // give the callback a chance to fill in more stream data if it wants.
     if (stream->get_callback) {
         Sint64 total_request = len / dst_frame_size;  // start with sample frames desired
@@ -1179,6 +1610,7 @@ int SDL_GetAudioStreamDataAdjustGain(SDL_AudioStream *stream, void *voidbuf, int
         total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
         stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+        SDL_DrainAudioStreamRingBuffer(stream);
     }
 
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
@@ -1253,6 +1685,8 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
         return 0;
     }
 
+    SDL_DrainAudioStreamRingBuffer(stream);
+
     Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
 
     // convert from sample frames to bytes in destination format.
@@ -1274,6 +1708,8 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    SDL_DrainAudioStreamRingBuffer(stream);
+
     size_t total = SDL_GetAudioQueueQueued(stream->queue);
 
     SDL_UnlockMutex(stream->lock);
@@ -1291,6 +1727,7 @@ bool SDL_ClearAudioStream(SDL_AudioStream *stream)
     SDL_LockMutex(stream->lock);
 
     SDL_ClearAudioQueue(stream->queue);
+    SDL_SetAtomicU32(&stream->ring_tail, SDL_GetAtomicU32(&stream->ring_head));
     SDL_zero(stream->input_spec);
     stream->input_chmap = NULL;
     stream->resample_offset = 0;
@@ -1319,6 +1756,8 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
         SDL_UnbindAudioStream(stream);
     }
 
+    SDL_ReleaseResamplerPhases(stream->resampler_phases);
+    SDL_free(stream->ring);
     SDL_aligned_free(stream->work_buffer);
     SDL_DestroyAudioQueue(stream->queue);
     SDL_DestroyMutex(stream->lock);
@@ -1326,11 +1765,6 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
     SDL_free(stream);
 }
 
-static void SDLCALL DontFreeThisAudioBuffer(void *userdata, const void *buf, int len)
-{
-    // We don't own the buffer, but know it will outlive the stream
-}
-
 bool SDL_ConvertAudioSamples(const SDL_AudioSpec *src_spec, const Uint8 *src_data, int src_len, const SDL_AudioSpec *dst_spec, Uint8 **dst_data, int *dst_len)
 {
     if (dst_data) {
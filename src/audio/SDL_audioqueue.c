@@ -523,7 +523,7 @@ static const Uint8 *PeekIntoAudioQueueFuture(SDL_AudioQueue *queue, Uint8 *data,
 }
 
 const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
-                                    Uint8 *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
+                                    Uint8 *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map, const float *mix_matrix,
                                     int past_frames, int present_frames, int future_frames,
                                     Uint8 *scratch, float gain)
 {
@@ -548,7 +548,7 @@ const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
     size_t dst_present_bytes = present_frames * dst_frame_size;
     size_t dst_future_bytes = future_frames * dst_frame_size;
 
-    const bool convert = (src_format != dst_format) || (src_channels != dst_channels) || (gain != 1.0f);
+    const bool convert = (src_format != dst_format) || (src_channels != dst_channels) || mix_matrix || (gain != 1.0f);
 
     if (convert && !dst) {
         // The user didn't ask for the data to be copied, but we need to convert it, so store it in the scratch buffer
@@ -562,8 +562,8 @@ const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
 
         // Do we still need to copy/convert the data?
         if (dst) {
-            ConvertAudio(past_frames + present_frames + future_frames, ptr,
-                         src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, scratch, gain);
+            ConvertAudioWithMixMatrix(past_frames + present_frames + future_frames, ptr,
+                                      src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, mix_matrix, scratch, gain);
             ptr = dst;
         }
 
@@ -581,19 +581,19 @@ const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
     Uint8 *ptr = dst;
 
     if (src_past_bytes) {
-        ConvertAudio(past_frames, PeekIntoAudioQueuePast(queue, scratch, src_past_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, scratch, gain);
+        ConvertAudioWithMixMatrix(past_frames, PeekIntoAudioQueuePast(queue, scratch, src_past_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, mix_matrix, scratch, gain);
         dst += dst_past_bytes;
         scratch += dst_past_bytes;
     }
 
     if (src_present_bytes) {
-        ConvertAudio(present_frames, ReadFromAudioQueue(queue, scratch, src_present_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, scratch, gain);
+        ConvertAudioWithMixMatrix(present_frames, ReadFromAudioQueue(queue, scratch, src_present_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, mix_matrix, scratch, gain);
         dst += dst_present_bytes;
         scratch += dst_present_bytes;
     }
 
     if (src_future_bytes) {
-        ConvertAudio(future_frames, PeekIntoAudioQueueFuture(queue, scratch, src_future_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, scratch, gain);
+        ConvertAudioWithMixMatrix(future_frames, PeekIntoAudioQueueFuture(queue, scratch, src_future_bytes), src_format, src_channels, src_map, dst, dst_format, dst_channels, dst_map, mix_matrix, scratch, gain);
         dst += dst_future_bytes;
         scratch += dst_future_bytes;
     }
@@ -67,7 +67,7 @@ extern void *SDL_BeginAudioQueueIter(SDL_AudioQueue *queue);
 extern size_t SDL_NextAudioQueueIter(SDL_AudioQueue *queue, void **inout_iter, SDL_AudioSpec *out_spec, int **out_chmap, bool *out_flushed);
 
 extern const Uint8 *SDL_ReadFromAudioQueue(SDL_AudioQueue *queue,
-                                           Uint8 *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
+                                           Uint8 *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map, const float *mix_matrix,
                                            int past_frames, int present_frames, int future_frames,
                                            Uint8 *scratch, float gain);
 
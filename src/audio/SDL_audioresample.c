@@ -23,6 +23,8 @@
 #include "SDL_sysaudio.h"
 
 #include "SDL_audioresample.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
 
 // SDL's resampler uses a "bandlimited interpolation" algorithm:
 //     https://ccrma.stanford.edu/~jos/resample/
@@ -68,6 +70,8 @@ typedef union Cubic
 
 } Cubic;
 
+static Cubic ResamplerFilter[RESAMPLER_SAMPLES_PER_ZERO_CROSSING][RESAMPLER_SAMPLES_PER_FRAME];
+
 static void ResampleFrame_Generic(const float *src, float *dst, const Cubic *filter, float frac, int chans)
 {
     const float frac2 = frac * frac;
@@ -130,38 +134,55 @@ static void ResampleFrame_Stereo(const float *src, float *dst, const Cubic *filt
     dst[1] = out1;
 }
 
-#ifdef SDL_SSE_INTRINSICS
-#define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // Not-so-fused multiply-add
-
-static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+// The polyphase kernels use a precomputed filter for each phase, skipping the interpolation entirely.
+static void PolyphaseFrame_Generic(const float *src, float *dst, const float *taps, int chans)
 {
-#if RESAMPLER_SAMPLES_PER_FRAME != 12
-#error Invalid samples per frame
-#endif
+    int i, chan;
 
-    __m128 f0, f1, f2;
+    for (chan = 0; chan < chans; ++chan) {
+        float out = 0.0f;
 
-    {
-        const __m128 frac1 = _mm_set1_ps(frac);
-        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
-        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+        for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+            out += src[i * chans + chan] * taps[i];
+        }
 
-// Transposed in SetupAudioResampler
-// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
-#define X(out)                                               \
-    out = _mm_load_ps(filter[0].v);                          \
-    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
-    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
-    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
-    filter += 4
+        dst[chan] = out;
+    }
+}
 
-        X(f0);
-        X(f1);
-        X(f2);
+static void PolyphaseFrame_Mono(const float *src, float *dst, const float *taps, int chans)
+{
+    int i;
+    float out = 0.0f;
 
-#undef X
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+        out += src[i] * taps[i];
+    }
+
+    dst[0] = out;
+}
+
+static void PolyphaseFrame_Stereo(const float *src, float *dst, const float *taps, int chans)
+{
+    int i;
+    float out0 = 0.0f;
+    float out1 = 0.0f;
+
+    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; ++i) {
+        out0 += src[i * 2 + 0] * taps[i];
+        out1 += src[i * 2 + 1] * taps[i];
     }
 
+    dst[0] = out0;
+    dst[1] = out1;
+}
+
+#ifdef SDL_SSE_INTRINSICS
+#define sdl_madd_ps(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // Not-so-fused multiply-add
+
+// Multiplies the (already interpolated) filter in f0..f2 with the input
+SDL_FORCE_INLINE void SDL_TARGETING("sse") ConvolveFrame_SSE(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
+{
     if (chans == 2) {
         // Duplicate each of the filter elements and multiply by the input
         // Use two accumulators to improve throughput
@@ -261,35 +282,275 @@ static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, flo
     }
 }
 
+static void SDL_TARGETING("sse") ResampleFrame_Generic_SSE(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+#if RESAMPLER_SAMPLES_PER_FRAME != 12
+#error Invalid samples per frame
+#endif
+
+    __m128 f0, f1, f2;
+
+    {
+        const __m128 frac1 = _mm_set1_ps(frac);
+        const __m128 frac2 = _mm_mul_ps(frac1, frac1);
+        const __m128 frac3 = _mm_mul_ps(frac1, frac2);
+
+// Transposed in SetupAudioResampler
+// Explicitly use _mm_load_ps to workaround ICE in GCC 4.9.4 accessing Cubic.v128
+#define X(out)                                               \
+    out = _mm_load_ps(filter[0].v);                          \
+    out = sdl_madd_ps(out, frac1, _mm_load_ps(filter[1].v)); \
+    out = sdl_madd_ps(out, frac2, _mm_load_ps(filter[2].v)); \
+    out = sdl_madd_ps(out, frac3, _mm_load_ps(filter[3].v)); \
+    filter += 4
+
+        X(f0);
+        X(f1);
+        X(f2);
+
+#undef X
+    }
+
+    ConvolveFrame_SSE(src, dst, f0, f1, f2, chans);
+}
+
+static void SDL_TARGETING("sse") PolyphaseFrame_SSE(const float *src, float *dst, const float *taps, int chans)
+{
+    ConvolveFrame_SSE(src, dst, _mm_load_ps(taps + 0), _mm_load_ps(taps + 4), _mm_load_ps(taps + 8), chans);
+}
+
 #undef sdl_madd_ps
 #endif
 
-#ifdef SDL_NEON_INTRINSICS
-static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+#ifdef SDL_AVX2_INTRINSICS
+// Multiplies the (already interpolated) filter in f0..f2 with the input, 8 channels at a time where possible
+SDL_FORCE_INLINE void SDL_TARGETING("avx2,fma") ConvolveFrame_AVX2(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
 {
 #if RESAMPLER_SAMPLES_PER_FRAME != 12
 #error Invalid samples per frame
 #endif
 
-    float32x4_t f0, f1, f2;
+    if (chans == 1) {
+        // Multiply the filter by the input
+        __m256 out8 = _mm256_mul_ps(_mm256_insertf128_ps(_mm256_castps128_ps256(f0), f1, 1), _mm256_loadu_ps(src));
+        __m128 out = _mm_add_ps(_mm256_castps256_ps128(out8), _mm256_extractf128_ps(out8, 1));
+        out = _mm_fmadd_ps(f2, _mm_loadu_ps(src + 8), out);
 
-    {
-        const float32x4_t frac1 = vdupq_n_f32(frac);
-        const float32x4_t frac2 = vmulq_f32(frac1, frac1);
-        const float32x4_t frac3 = vmulq_f32(frac1, frac2);
+        // Horizontal sum
+        out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+        out = _mm_add_ss(out, _mm_movehdup_ps(out));
 
-// Transposed in SetupAudioResampler
-#define X(out)                                                                                                                  \
-    out = vmlaq_f32(vmlaq_f32(vmlaq_f32(filter[0].v128, filter[1].v128, frac1), filter[2].v128, frac2), filter[3].v128, frac3); \
+        _mm_store_ss(dst, out);
+        return;
+    }
+
+    if (chans == 2) {
+        // Duplicate each of the filter elements and multiply by the input
+        const __m256i dup = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+        __m256 out0 = _mm256_mul_ps(_mm256_loadu_ps(src + 0), _mm256_permutevar8x32_ps(_mm256_castps128_ps256(f0), dup));
+        __m256 out1 = _mm256_mul_ps(_mm256_loadu_ps(src + 8), _mm256_permutevar8x32_ps(_mm256_castps128_ps256(f1), dup));
+        out0 = _mm256_fmadd_ps(_mm256_loadu_ps(src + 16), _mm256_permutevar8x32_ps(_mm256_castps128_ps256(f2), dup), out0);
+
+        // Add the accumulators together, then the lower and upper pairs
+        out0 = _mm256_add_ps(out0, out1);
+        __m128 out = _mm_add_ps(_mm256_castps256_ps128(out0), _mm256_extractf128_ps(out0, 1));
+        out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+
+        _mm_storel_pi((__m64 *)dst, out);
+        return;
+    }
+
+    int chan = 0;
+
+    // Process 8 channels at once
+    if (chans >= 8) {
+        const __m256 g0 = _mm256_insertf128_ps(_mm256_castps128_ps256(f0), f0, 1);
+        const __m256 g1 = _mm256_insertf128_ps(_mm256_castps128_ps256(f1), f1, 1);
+        const __m256 g2 = _mm256_insertf128_ps(_mm256_castps128_ps256(f2), f2, 1);
+
+        for (; chan + 8 <= chans; chan += 8) {
+            const float *in = &src[chan];
+            __m256 out0 = _mm256_setzero_ps();
+            __m256 out1 = _mm256_setzero_ps();
+
+#define X(a, b, out)                                                                                \
+    out = _mm256_fmadd_ps(_mm256_loadu_ps(in), _mm256_permute_ps(a, _MM_SHUFFLE(b, b, b, b)), out); \
+    in += chans
+
+#define Y(a)       \
+    X(a, 0, out0); \
+    X(a, 1, out1); \
+    X(a, 2, out0); \
+    X(a, 3, out1)
+
+            Y(g0);
+            Y(g1);
+            Y(g2);
+
+#undef X
+#undef Y
+
+            _mm256_storeu_ps(&dst[chan], _mm256_add_ps(out0, out1));
+        }
+    }
+
+    // Then 4 channels at once
+    for (; chan + 4 <= chans; chan += 4) {
+        const float *in = &src[chan];
+        __m128 out0 = _mm_setzero_ps();
+        __m128 out1 = _mm_setzero_ps();
+
+#define X(a, b, out)                                                                       \
+    out = _mm_fmadd_ps(_mm_loadu_ps(in), _mm_permute_ps(a, _MM_SHUFFLE(b, b, b, b)), out); \
+    in += chans
+
+#define Y(a)       \
+    X(a, 0, out0); \
+    X(a, 1, out1); \
+    X(a, 2, out0); \
+    X(a, 3, out1)
+
+        Y(f0);
+        Y(f1);
+        Y(f2);
+
+#undef X
+#undef Y
+
+        _mm_storeu_ps(&dst[chan], _mm_add_ps(out0, out1));
+    }
+
+    // Process the remaining channels one at a time, leaving 3,5,6,7 to deal with (looping 3,1,2,3 times).
+    // vgatherdps is available, but slower than just loading the 12 samples.
+    for (; chan < chans; ++chan) {
+        const float *in = &src[chan];
+        __m128 v0, v1, v2;
+
+#define X(x)                                                                         \
+    x = _mm_unpacklo_ps(_mm_load_ss(in), _mm_load_ss(in + chans));                   \
+    in += chans + chans;                                                             \
+    x = _mm_movelh_ps(x, _mm_unpacklo_ps(_mm_load_ss(in), _mm_load_ss(in + chans))); \
+    in += chans + chans
+
+        X(v0);
+        X(v1);
+        X(v2);
+
+#undef X
+
+        __m128 out = _mm_mul_ps(f0, v0);
+        out = _mm_fmadd_ps(f1, v1, out);
+        out = _mm_fmadd_ps(f2, v2, out);
+
+        // Horizontal sum
+        out = _mm_add_ps(out, _mm_movehl_ps(out, out));
+        out = _mm_add_ss(out, _mm_movehdup_ps(out));
+
+        _mm_store_ss(&dst[chan], out);
+    }
+}
+
+static void SDL_TARGETING("avx2,fma") ResampleFrame_Generic_AVX2(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+    const __m128 frac1 = _mm_set1_ps(frac);
+    __m128 f0, f1, f2;
+
+// Transposed in SetupAudioResampler, evaluated with Horner's method
+#define X(out)                                                                      \
+    out = _mm_fmadd_ps(_mm_load_ps(filter[3].v), frac1, _mm_load_ps(filter[2].v)); \
+    out = _mm_fmadd_ps(out, frac1, _mm_load_ps(filter[1].v));                      \
+    out = _mm_fmadd_ps(out, frac1, _mm_load_ps(filter[0].v));                      \
     filter += 4
 
+    X(f0);
+    X(f1);
+    X(f2);
+
+#undef X
+
+    ConvolveFrame_AVX2(src, dst, f0, f1, f2, chans);
+}
+
+static void SDL_TARGETING("avx2,fma") PolyphaseFrame_AVX2(const float *src, float *dst, const float *taps, int chans)
+{
+    ConvolveFrame_AVX2(src, dst, _mm_load_ps(taps + 0), _mm_load_ps(taps + 4), _mm_load_ps(taps + 8), chans);
+}
+
+// Resamples stereo two output frames at a time, interpolating both filters in the same registers.
+// Returns the number of frames processed, which is always even.
+static int SDL_TARGETING("avx2,fma") ResampleFrames_Stereo_AVX2(const float *src, int inframes, float *dst, int outframes,
+                                                                Sint64 resample_rate, Sint64 *inout_srcpos)
+{
+    const __m256i dup0 = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i dup1 = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+    const __m256i pack = _mm256_setr_epi32(0, 1, 4, 5, 0, 1, 4, 5);
+    Sint64 srcpos = *inout_srcpos;
+    int i;
+
+    for (i = 0; i + 2 <= outframes; i += 2) {
+        const int srcindex0 = (int)(Sint32)(srcpos >> 32);
+        const Uint32 srcfraction0 = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+        const int srcindex1 = (int)(Sint32)(srcpos >> 32);
+        const Uint32 srcfraction1 = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex0 >= -1 && srcindex1 < inframes);
+
+        const Cubic *filter0 = ResamplerFilter[srcfraction0 >> RESAMPLER_FILTER_INTERP_BITS];
+        const Cubic *filter1 = ResamplerFilter[srcfraction1 >> RESAMPLER_FILTER_INTERP_BITS];
+        const __m256 frac = _mm256_insertf128_ps(
+            _mm256_castps128_ps256(_mm_set1_ps((float)(srcfraction0 & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE))),
+            _mm_set1_ps((float)(srcfraction1 & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE)), 1);
+
+        __m256 f0, f1, f2;
+
+// Transposed in SetupAudioResampler, the first frame's filter goes in the lower half and the second's in the upper half
+#define L(j)   _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(filter0[j].v)), _mm_load_ps(filter1[j].v), 1)
+#define X(out)                               \
+    out = _mm256_fmadd_ps(L(3), frac, L(2)); \
+    out = _mm256_fmadd_ps(out, frac, L(1));  \
+    out = _mm256_fmadd_ps(out, frac, L(0));  \
+    filter0 += 4;                            \
+    filter1 += 4
+
         X(f0);
         X(f1);
         X(f2);
 
 #undef X
+#undef L
+
+        const float *frame0 = &src[srcindex0 * 2];
+        const float *frame1 = &src[srcindex1 * 2];
+
+        __m256 out0 = _mm256_mul_ps(_mm256_loadu_ps(frame0 + 0), _mm256_permutevar8x32_ps(f0, dup0));
+        __m256 out1 = _mm256_mul_ps(_mm256_loadu_ps(frame1 + 0), _mm256_permutevar8x32_ps(f0, dup1));
+        out0 = _mm256_fmadd_ps(_mm256_loadu_ps(frame0 + 8), _mm256_permutevar8x32_ps(f1, dup0), out0);
+        out1 = _mm256_fmadd_ps(_mm256_loadu_ps(frame1 + 8), _mm256_permutevar8x32_ps(f1, dup1), out1);
+        out0 = _mm256_fmadd_ps(_mm256_loadu_ps(frame0 + 16), _mm256_permutevar8x32_ps(f2, dup0), out0);
+        out1 = _mm256_fmadd_ps(_mm256_loadu_ps(frame1 + 16), _mm256_permutevar8x32_ps(f2, dup1), out1);
+
+        // Sum the halves of each frame: [out0.lo + out0.hi | out1.lo + out1.hi]
+        __m256 out = _mm256_add_ps(_mm256_permute2f128_ps(out0, out1, 0x20), _mm256_permute2f128_ps(out0, out1, 0x31));
+
+        // Add the lower and upper pairs together, then pack both frames into the lower half
+        out = _mm256_add_ps(out, _mm256_permute_ps(out, _MM_SHUFFLE(1, 0, 3, 2)));
+        out = _mm256_permutevar8x32_ps(out, pack);
+
+        _mm_storeu_ps(dst, _mm256_castps256_ps128(out));
+        dst += 4;
     }
 
+    *inout_srcpos = srcpos;
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+// Multiplies the (already interpolated) filter in f0..f2 with the input
+SDL_FORCE_INLINE void ConvolveFrame_NEON(const float *src, float *dst, float32x4_t f0, float32x4_t f1, float32x4_t f2, int chans)
+{
     if (chans == 2) {
         float32x4x2_t g0 = vzipq_f32(f0, f0);
         float32x4x2_t g1 = vzipq_f32(f1, f1);
@@ -393,6 +654,39 @@ static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic
         vst1_lane_f32(&dst[chan], sum, 0);
     }
 }
+
+static void ResampleFrame_Generic_NEON(const float *src, float *dst, const Cubic *filter, float frac, int chans)
+{
+#if RESAMPLER_SAMPLES_PER_FRAME != 12
+#error Invalid samples per frame
+#endif
+
+    float32x4_t f0, f1, f2;
+
+    {
+        const float32x4_t frac1 = vdupq_n_f32(frac);
+        const float32x4_t frac2 = vmulq_f32(frac1, frac1);
+        const float32x4_t frac3 = vmulq_f32(frac1, frac2);
+
+// Transposed in SetupAudioResampler
+#define X(out)                                                                                                                  \
+    out = vmlaq_f32(vmlaq_f32(vmlaq_f32(filter[0].v128, filter[1].v128, frac1), filter[2].v128, frac2), filter[3].v128, frac3); \
+    filter += 4
+
+        X(f0);
+        X(f1);
+        X(f2);
+
+#undef X
+    }
+
+    ConvolveFrame_NEON(src, dst, f0, f1, f2, chans);
+}
+
+static void PolyphaseFrame_NEON(const float *src, float *dst, const float *taps, int chans)
+{
+    ConvolveFrame_NEON(src, dst, vld1q_f32(taps + 0), vld1q_f32(taps + 4), vld1q_f32(taps + 8), chans);
+}
 #endif
 
 // Calculate the cubic equation which passes through all four points.
@@ -439,7 +733,13 @@ static void SincTable(float *table, int len)
     int i;
 
     for (i = 0; i < len; ++i) {
-        table[i] = SDL_sinf(i * (SDL_PI_F / len)) / SDL_PI_F;
+        table[i] = i * (SDL_PI_F / len);
+    }
+
+    SDL_sinf_array(table, table, len);
+
+    for (i = 0; i < len; ++i) {
+        table[i] /= SDL_PI_F;
     }
 }
 
@@ -451,8 +751,6 @@ static float Sinc(const float *table, int x, int y)
     return (s * y) / x;
 }
 
-static Cubic ResamplerFilter[RESAMPLER_SAMPLES_PER_ZERO_CROSSING][RESAMPLER_SAMPLES_PER_FRAME];
-
 static void GenerateResamplerFilter(void)
 {
     enum
@@ -479,8 +777,14 @@ static void GenerateResamplerFilter(void)
     float filter[TABLE_SIZE + 1];
     filter[0] = 1.0f;
 
+    // The window's square roots are done up front, all at once
     for (i = 1; i <= TABLE_SIZE; ++i) {
-        float b = BesselI0(beta * SDL_sqrtf((lensqr - (i * i)) / lensqr)) / bessel_beta;
+        filter[i] = (lensqr - (i * i)) / lensqr;
+    }
+    SDL_sqrtf_array(&filter[1], &filter[1], TABLE_SIZE);
+
+    for (i = 1; i <= TABLE_SIZE; ++i) {
+        float b = BesselI0(beta * filter[i]) / bessel_beta;
         float s = Sinc(sinc, i, TABLE_SAMPLES_PER_ZERO_CROSSING);
         filter[i] = b * s;
     }
@@ -516,6 +820,13 @@ static void GenerateResamplerFilter(void)
 typedef void (*ResampleFrameFunc)(const float *src, float *dst, const Cubic *filter, float frac, int chans);
 static ResampleFrameFunc ResampleFrame[8];
 
+// Optional kernels that handle several output frames per call, returning how many they did.
+typedef int (*ResampleFramesFunc)(const float *src, int inframes, float *dst, int outframes, Sint64 resample_rate, Sint64 *inout_srcpos);
+static ResampleFramesFunc ResampleFrames[8];
+
+typedef void (*PolyphaseFrameFunc)(const float *src, float *dst, const float *taps, int chans);
+static PolyphaseFrameFunc PolyphaseFrame[8];
+
 // Transpose 4x4 floats
 static void Transpose4x4(Cubic *data)
 {
@@ -537,10 +848,21 @@ static void SetupAudioResampler(void)
 
     GenerateResamplerFilter();
 
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2() && SDL_HasFMA()) {
+        for (i = 0; i < 8; ++i) {
+            ResampleFrame[i] = ResampleFrame_Generic_AVX2;
+            PolyphaseFrame[i] = PolyphaseFrame_AVX2;
+        }
+        ResampleFrames[1] = ResampleFrames_Stereo_AVX2;
+        transpose = true;
+    } else
+#endif
 #ifdef SDL_SSE_INTRINSICS
     if (SDL_HasSSE()) {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_SSE;
+            PolyphaseFrame[i] = PolyphaseFrame_SSE;
         }
         transpose = true;
     } else
@@ -549,6 +871,7 @@ static void SetupAudioResampler(void)
     if (SDL_HasNEON()) {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic_NEON;
+            PolyphaseFrame[i] = PolyphaseFrame_NEON;
         }
         transpose = true;
     } else
@@ -556,10 +879,13 @@ static void SetupAudioResampler(void)
     {
         for (i = 0; i < 8; ++i) {
             ResampleFrame[i] = ResampleFrame_Generic;
+            PolyphaseFrame[i] = PolyphaseFrame_Generic;
         }
 
         ResampleFrame[0] = ResampleFrame_Mono;
         ResampleFrame[1] = ResampleFrame_Stereo;
+        PolyphaseFrame[0] = PolyphaseFrame_Mono;
+        PolyphaseFrame[1] = PolyphaseFrame_Stereo;
     }
 
     if (transpose) {
@@ -681,12 +1007,19 @@ void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, in
     int i;
     Sint64 srcpos = *inout_resample_offset;
     ResampleFrameFunc resample_frame = ResampleFrame[chans - 1];
+    ResampleFramesFunc resample_frames = ResampleFrames[chans - 1];
 
     SDL_assert(resample_rate > 0);
 
     src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
 
-    for (i = 0; i < outframes; ++i) {
+    i = 0;
+    if (resample_frames) {
+        i = resample_frames(src, inframes, dst, outframes, resample_rate, &srcpos);
+        dst += i * chans;
+    }
+
+    for (; i < outframes; ++i) {
         int srcindex = (int)(Sint32)(srcpos >> 32);
         Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
         srcpos += resample_rate;
@@ -704,3 +1037,248 @@ void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, in
 
     *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
 }
+
+// If the reduced ratio needs more phases than this, the filters aren't worth precomputing.
+// Common conversions are well below this: 44100->48000 needs 160 phases, 48000->44100 needs 147.
+#define RESAMPLER_MAX_PHASES 1024
+
+// Precomputed filters for resampling by a rational ratio, shared by every stream using that ratio.
+// The filter for output phase k (the input position is k/dst_rate past a whole frame) is stored at taps[k * RESAMPLER_SAMPLES_PER_FRAME].
+struct SDL_ResamplerPhases
+{
+    int src_rate; // reduced, so the position advances src_rate/dst_rate input frames per output frame.
+    int dst_rate; // also the number of phases.
+    int refcount;
+    float *taps;
+    SDL_ResamplerPhases *next;
+};
+
+static SDL_ResamplerPhases *ResamplerPhasesCache;
+static SDL_SpinLock ResamplerPhasesLock;
+
+static void ReduceResampleRatio(int *src_rate, int *dst_rate)
+{
+    int a = *src_rate;
+    int b = *dst_rate;
+
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    *src_rate /= a;
+    *dst_rate /= a;
+}
+
+static SDL_ResamplerPhases *FindResamplerPhases(int src_rate, int dst_rate)
+{
+    SDL_ResamplerPhases *phases;
+
+    for (phases = ResamplerPhasesCache; phases; phases = phases->next) {
+        if ((phases->src_rate == src_rate) && (phases->dst_rate == dst_rate)) {
+            break;
+        }
+    }
+
+    return phases;
+}
+
+static SDL_ResamplerPhases *CreateResamplerPhases(int src_rate, int dst_rate)
+{
+    SDL_ResamplerPhases *phases = (SDL_ResamplerPhases *)SDL_calloc(1, sizeof(*phases));
+    if (!phases) {
+        return NULL;
+    }
+
+    phases->taps = (float *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), dst_rate * RESAMPLER_SAMPLES_PER_FRAME * sizeof(float));
+    if (!phases->taps) {
+        SDL_free(phases);
+        return NULL;
+    }
+
+    phases->src_rate = src_rate;
+    phases->dst_rate = dst_rate;
+    phases->refcount = 1;
+
+    // Run the regular (interpolating) mono kernel over an impulse at each tap, so the
+    // precomputed filters match SDL_ResampleAudio regardless of how ResamplerFilter is laid out.
+    float impulse[RESAMPLER_SAMPLES_PER_FRAME];
+    int i, j;
+
+    SDL_zeroa(impulse);
+
+    for (i = 0; i < dst_rate; ++i) {
+        const Uint32 srcfraction = (Uint32)(((Uint64)i << 32) / (Uint64)dst_rate);
+        const Cubic *filter = ResamplerFilter[srcfraction >> RESAMPLER_FILTER_INTERP_BITS];
+        const float frac = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+        float *taps = &phases->taps[i * RESAMPLER_SAMPLES_PER_FRAME];
+
+        for (j = 0; j < RESAMPLER_SAMPLES_PER_FRAME; ++j) {
+            impulse[j] = 1.0f;
+            ResampleFrame[0](impulse, &taps[j], filter, frac, 1);
+            impulse[j] = 0.0f;
+        }
+    }
+
+    return phases;
+}
+
+static void DestroyResamplerPhases(SDL_ResamplerPhases *phases)
+{
+    SDL_aligned_free(phases->taps);
+    SDL_free(phases);
+}
+
+SDL_ResamplerPhases *SDL_AcquireResamplerPhases(int src_rate, int dst_rate)
+{
+    SDL_assert(src_rate > 0);
+    SDL_assert(dst_rate > 0);
+
+    ReduceResampleRatio(&src_rate, &dst_rate);
+
+    // Not resampling (or stepping between frames at 1:1) isn't worth a table.
+    if ((dst_rate > RESAMPLER_MAX_PHASES) || (src_rate == dst_rate)) {
+        return NULL;
+    }
+
+    SDL_ResamplerPhases *phases;
+
+    SDL_LockSpinlock(&ResamplerPhasesLock);
+    phases = FindResamplerPhases(src_rate, dst_rate);
+    if (phases) {
+        ++phases->refcount;
+    }
+    SDL_UnlockSpinlock(&ResamplerPhasesLock);
+
+    if (phases) {
+        return phases;
+    }
+
+    // Build the table outside the lock, someone else might have beaten us to it by the time we're done.
+    SDL_ResamplerPhases *created = CreateResamplerPhases(src_rate, dst_rate);
+    if (!created) {
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&ResamplerPhasesLock);
+    phases = FindResamplerPhases(src_rate, dst_rate);
+    if (phases) {
+        ++phases->refcount;
+    } else {
+        created->next = ResamplerPhasesCache;
+        ResamplerPhasesCache = created;
+        phases = created;
+        created = NULL;
+    }
+    SDL_UnlockSpinlock(&ResamplerPhasesLock);
+
+    if (created) {
+        DestroyResamplerPhases(created);
+    }
+
+    return phases;
+}
+
+void SDL_ReleaseResamplerPhases(SDL_ResamplerPhases *phases)
+{
+    SDL_ResamplerPhases **prev;
+
+    if (!phases) {
+        return;
+    }
+
+    SDL_LockSpinlock(&ResamplerPhasesLock);
+    if (--phases->refcount > 0) {
+        phases = NULL;
+    } else {
+        for (prev = &ResamplerPhasesCache; *prev; prev = &(*prev)->next) {
+            if (*prev == phases) {
+                *prev = phases->next;
+                break;
+            }
+        }
+    }
+    SDL_UnlockSpinlock(&ResamplerPhasesLock);
+
+    if (phases) {
+        DestroyResamplerPhases(phases);
+    }
+}
+
+bool SDL_ResamplerPhasesMatch(const SDL_ResamplerPhases *phases, int src_rate, int dst_rate)
+{
+    ReduceResampleRatio(&src_rate, &dst_rate);
+
+    return (phases->src_rate == src_rate) && (phases->dst_rate == dst_rate);
+}
+
+void SDL_ResampleAudioPolyphase(int chans, const float *src, int inframes, float *dst, int outframes,
+                                const SDL_ResamplerPhases *phases, Sint64 *inout_resample_offset)
+{
+    int i;
+    const int num_phases = phases->dst_rate;
+    const int step_frames = phases->src_rate / num_phases;
+    const int step_phase = phases->src_rate % num_phases;
+    const float *taps = phases->taps;
+    PolyphaseFrameFunc polyphase_frame = PolyphaseFrame[chans - 1];
+    Sint64 srcpos = *inout_resample_offset;
+
+    // Track the position exactly, as a whole frame plus a phase.
+    // Rounding the phase down keeps us at or behind the 32:32 position, so we never
+    // need more input than SDL_GetResamplerInputFrames asked for.
+    int srcindex = (int)(Sint32)(srcpos >> 32);
+    int phase = (int)(((Uint64)(srcpos & 0xFFFFFFFF) * (Uint64)num_phases) >> 32);
+
+    src -= (RESAMPLER_ZERO_CROSSINGS - 1) * chans;
+
+    for (i = 0; i < outframes; ++i) {
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        const float *frame = &src[srcindex * chans];
+        polyphase_frame(frame, dst, &taps[phase * RESAMPLER_SAMPLES_PER_FRAME], chans);
+
+        srcindex += step_frames;
+        phase += step_phase;
+        if (phase >= num_phases) {
+            phase -= num_phases;
+            ++srcindex;
+        }
+
+        dst += chans;
+    }
+
+    // Round the phase up when converting back, so it comes out the same on the next call.
+    srcpos = ((Sint64)(srcindex - inframes) * 0x100000000) + (Sint64)((((Uint64)phase << 32) + (Uint64)(num_phases - 1)) / (Uint64)num_phases);
+
+    *inout_resample_offset = srcpos;
+}
+
+void SDL_ResampleAudioLinear(int chans, const float *src, int inframes, float *dst, int outframes,
+                             Sint64 resample_rate, Sint64 *inout_resample_offset)
+{
+    int i, chan;
+    Sint64 srcpos = *inout_resample_offset;
+
+    SDL_assert(resample_rate > 0);
+
+    for (i = 0; i < outframes; ++i) {
+        int srcindex = (int)(Sint32)(srcpos >> 32);
+        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+        srcpos += resample_rate;
+
+        SDL_assert(srcindex >= -1 && srcindex < inframes);
+
+        // Only the frames either side of the position are needed, which are always within the padding.
+        const float frac = (float)srcfraction * (1.0f / 4294967296.0f);
+        const float *frame = &src[srcindex * chans];
+
+        for (chan = 0; chan < chans; ++chan) {
+            dst[chan] = frame[chan] + ((frame[chan + chans] - frame[chan]) * frac);
+        }
+
+        dst += chans;
+    }
+
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+}
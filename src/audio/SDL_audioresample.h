@@ -40,4 +40,22 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
                        Sint64 resample_rate, Sint64 *inout_resample_offset);
 
+// Precomputed filters for resampling between two rates, shared between everything that uses the same (reduced) ratio.
+// Returns NULL if the ratio needs too many phases to be worth precomputing, in which case use SDL_ResampleAudio instead.
+typedef struct SDL_ResamplerPhases SDL_ResamplerPhases;
+
+SDL_ResamplerPhases *SDL_AcquireResamplerPhases(int src_rate, int dst_rate);
+void SDL_ReleaseResamplerPhases(SDL_ResamplerPhases *phases);
+bool SDL_ResamplerPhasesMatch(const SDL_ResamplerPhases *phases, int src_rate, int dst_rate);
+
+// Same as SDL_ResampleAudio, but uses the precomputed filters instead of interpolating one for every frame.
+// The phases must match the rates `resample_rate` was calculated from.
+void SDL_ResampleAudioPolyphase(int chans, const float *src, int inframes, float *dst, int outframes,
+                                const SDL_ResamplerPhases *phases, Sint64 *inout_resample_offset);
+
+// Same as SDL_ResampleAudio, but only interpolates linearly between the nearest two frames.
+// Much cheaper, but aliases noticeably; meant for things like voice chat.
+void SDL_ResampleAudioLinear(int chans, const float *src, int inframes, float *dst, int outframes,
+                             Sint64 resample_rate, Sint64 *inout_resample_offset);
+
 #endif // SDL_audioresample_h_
@@ -23,6 +23,7 @@
 // This provides the default mixing callback for the SDL audio routines
 
 #include "SDL_sysaudio.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
 
 /* This table is used to add two sound values together and pin
  * the value to avoid overflow.  (used with permission from ARDI)
@@ -82,10 +83,279 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / MIX_MAXVOLUME) + 128))
 
-// !!! FIXME: This needs some SIMD magic.
-// !!! FIXME: Add fast-path for volume = 1
 // !!! FIXME: Use larger scales for 16-bit/32-bit integers
 
+/* The SIMD kernels below give the same results as the scalar loops in
+ * SDL_MixAudio(): the scaled sample is truncated toward zero and then added
+ * to the destination with saturation. The integer kernels only handle
+ * volumes up to MIX_MAXVOLUME, larger volumes fall back to the scalar code.
+ * The FMA kernel for float data can differ from the scalar code by a
+ * rounding step. All of them return the number of samples that were mixed,
+ * the caller mixes the rest.
+ */
+
+#ifdef SDL_SSE2_INTRINSICS
+static size_t SDL_TARGETING("sse2") MixAudio_S16_SSE2(Sint16 *dst, const Sint16 *src, size_t num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16)volume);
+    const __m128i bias = _mm_set1_epi32(MIX_MAXVOLUME - 1);
+    size_t i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        if (volume != MIX_MAXVOLUME) {
+            const __m128i lo = _mm_mullo_epi16(s, vol);
+            const __m128i hi = _mm_mulhi_epi16(s, vol);
+            __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+            __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+            p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias)), 7);
+            p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias)), 7);
+            s = _mm_packs_epi32(p0, p1);
+        }
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_adds_epi16(_mm_loadu_si128((const __m128i *)&dst[i]), s));
+    }
+    return i;
+}
+
+static size_t SDL_TARGETING("sse2") MixAudio_F32_SSE2(float *dst, const float *src, size_t num_samples, float volume)
+{
+    const __m128 vol = _mm_set1_ps(volume);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minus_one = _mm_set1_ps(-1.0f);
+    size_t i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        __m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&src[i]), vol), _mm_loadu_ps(&dst[i]));
+        x = _mm_min_ps(one, _mm_max_ps(minus_one, x));  // Operand order keeps NaN like the scalar code.
+        _mm_storeu_ps(&dst[i], x);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_SSE4_1_INTRINSICS
+/* The product of a 32-bit sample and the volume doesn't fit in 32 bits, so
+ * the sample is split into s = q * 128 + r, which makes s * v / 128 equal
+ * to q * v + (r * v) / 128, rounded down. One is added back for negative
+ * samples with a remainder to round toward zero instead.
+ */
+static size_t SDL_TARGETING("sse4.1") MixAudio_S32_SSE41(Sint32 *dst, const Sint32 *src, size_t num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    const __m128i mask = _mm_set1_epi32(MIX_MAXVOLUME - 1);
+    const __m128i max = _mm_set1_epi32(SDL_MAX_SINT32);
+    size_t i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+        __m128i sum, overflow, saturated;
+
+        if (volume != MIX_MAXVOLUME) {
+            const __m128i rv = _mm_mullo_epi32(_mm_and_si128(s, mask), vol);
+            const __m128i inexact = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(rv, mask), _mm_setzero_si128()), _mm_srai_epi32(s, 31));
+            const __m128i floor = _mm_add_epi32(_mm_mullo_epi32(_mm_srai_epi32(s, 7), vol), _mm_srai_epi32(rv, 7));
+            s = _mm_sub_epi32(floor, inexact);
+        }
+
+        sum = _mm_add_epi32(s, d);
+        overflow = _mm_and_si128(_mm_xor_si128(s, sum), _mm_xor_si128(d, sum));
+        saturated = _mm_xor_si128(_mm_srai_epi32(d, 31), max);
+        sum = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(sum), _mm_castsi128_ps(saturated), _mm_castsi128_ps(overflow)));
+        _mm_storeu_si128((__m128i *)&dst[i], sum);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static size_t SDL_TARGETING("avx2") MixAudio_S16_AVX2(Sint16 *dst, const Sint16 *src, size_t num_samples, int volume)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+    const __m256i bias = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+    size_t i;
+
+    for (i = 0; i + 16 <= num_samples; i += 16) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        if (volume != MIX_MAXVOLUME) {
+            // The unpacks and the pack work within 128-bit lanes, so the sample order is kept.
+            const __m256i lo = _mm256_mullo_epi16(s, vol);
+            const __m256i hi = _mm256_mulhi_epi16(s, vol);
+            __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+            __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+            p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), bias)), 7);
+            p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), bias)), 7);
+            s = _mm256_packs_epi32(p0, p1);
+        }
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_adds_epi16(_mm256_loadu_si256((const __m256i *)&dst[i]), s));
+    }
+    return i;
+}
+
+// See MixAudio_S32_SSE41() for how the volume is applied.
+static size_t SDL_TARGETING("avx2") MixAudio_S32_AVX2(Sint32 *dst, const Sint32 *src, size_t num_samples, int volume)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i mask = _mm256_set1_epi32(MIX_MAXVOLUME - 1);
+    const __m256i max = _mm256_set1_epi32(SDL_MAX_SINT32);
+    size_t i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+        __m256i sum, overflow, saturated;
+
+        if (volume != MIX_MAXVOLUME) {
+            const __m256i rv = _mm256_mullo_epi32(_mm256_and_si256(s, mask), vol);
+            const __m256i inexact = _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(rv, mask), _mm256_setzero_si256()), _mm256_srai_epi32(s, 31));
+            const __m256i floor = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol), _mm256_srai_epi32(rv, 7));
+            s = _mm256_sub_epi32(floor, inexact);
+        }
+
+        sum = _mm256_add_epi32(s, d);
+        overflow = _mm256_and_si256(_mm256_xor_si256(s, sum), _mm256_xor_si256(d, sum));
+        saturated = _mm256_xor_si256(_mm256_srai_epi32(d, 31), max);
+        sum = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(sum), _mm256_castsi256_ps(saturated), _mm256_castsi256_ps(overflow)));
+        _mm256_storeu_si256((__m256i *)&dst[i], sum);
+    }
+    return i;
+}
+
+static size_t SDL_TARGETING("avx2,fma") MixAudio_F32_AVX2(float *dst, const float *src, size_t num_samples, float volume)
+{
+    const __m256 vol = _mm256_set1_ps(volume);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minus_one = _mm256_set1_ps(-1.0f);
+    size_t i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        __m256 x = _mm256_fmadd_ps(_mm256_loadu_ps(&src[i]), vol, _mm256_loadu_ps(&dst[i]));
+        x = _mm256_min_ps(one, _mm256_max_ps(minus_one, x));
+        _mm256_storeu_ps(&dst[i], x);
+    }
+    return i;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static size_t MixAudio_S16_NEON(Sint16 *dst, const Sint16 *src, size_t num_samples, int volume)
+{
+    const int16x4_t vol = vdup_n_s16((int16_t)volume);
+    const int32x4_t bias = vdupq_n_s32(MIX_MAXVOLUME - 1);
+    size_t i;
+
+    for (i = 0; i + 8 <= num_samples; i += 8) {
+        int16x8_t s = vld1q_s16(&src[i]);
+        if (volume != MIX_MAXVOLUME) {
+            int32x4_t p0 = vmull_s16(vget_low_s16(s), vol);
+            int32x4_t p1 = vmull_s16(vget_high_s16(s), vol);
+            p0 = vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), bias));
+            p1 = vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), bias));
+            s = vcombine_s16(vshrn_n_s32(p0, 7), vshrn_n_s32(p1, 7));
+        }
+        vst1q_s16(&dst[i], vqaddq_s16(vld1q_s16(&dst[i]), s));
+    }
+    return i;
+}
+
+static size_t MixAudio_S32_NEON(Sint32 *dst, const Sint32 *src, size_t num_samples, int volume)
+{
+    const int32x2_t vol = vdup_n_s32(volume);
+    const int64x2_t bias = vdupq_n_s64(MIX_MAXVOLUME - 1);
+    size_t i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+        int32x4_t s = vld1q_s32(&src[i]);
+        if (volume != MIX_MAXVOLUME) {
+            int64x2_t p0 = vmull_s32(vget_low_s32(s), vol);
+            int64x2_t p1 = vmull_s32(vget_high_s32(s), vol);
+            p0 = vaddq_s64(p0, vandq_s64(vshrq_n_s64(p0, 63), bias));
+            p1 = vaddq_s64(p1, vandq_s64(vshrq_n_s64(p1, 63), bias));
+            s = vcombine_s32(vshrn_n_s64(p0, 7), vshrn_n_s64(p1, 7));
+        }
+        vst1q_s32(&dst[i], vqaddq_s32(vld1q_s32(&dst[i]), s));
+    }
+    return i;
+}
+
+static size_t MixAudio_F32_NEON(float *dst, const float *src, size_t num_samples, float volume)
+{
+    const float32x4_t vol = vdupq_n_f32(volume);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+    size_t i;
+
+    for (i = 0; i + 4 <= num_samples; i += 4) {
+#ifdef __aarch64__
+        float32x4_t x = vfmaq_f32(vld1q_f32(&dst[i]), vld1q_f32(&src[i]), vol);
+#else
+        float32x4_t x = vmlaq_f32(vld1q_f32(&dst[i]), vld1q_f32(&src[i]), vol);
+#endif
+        x = vminq_f32(vmaxq_f32(x, minus_one), one);
+        vst1q_f32(&dst[i], x);
+    }
+    return i;
+}
+#endif
+
+// Mixes as much of the buffer as possible with SIMD, returns the number of bytes mixed.
+static Uint32 MixAudio_SIMD(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, int volume, float fvolume)
+{
+    const size_t num_samples = len / (SDL_AUDIO_BYTESIZE(format) ? SDL_AUDIO_BYTESIZE(format) : 1);
+
+    if (format == SDL_AUDIO_S16 && volume > 0 && volume <= MIX_MAXVOLUME) {
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return (Uint32)(MixAudio_S16_AVX2((Sint16 *)dst, (const Sint16 *)src, num_samples, volume) * sizeof(Sint16));
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return (Uint32)(MixAudio_S16_SSE2((Sint16 *)dst, (const Sint16 *)src, num_samples, volume) * sizeof(Sint16));
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return (Uint32)(MixAudio_S16_NEON((Sint16 *)dst, (const Sint16 *)src, num_samples, volume) * sizeof(Sint16));
+        }
+#endif
+    } else if (format == SDL_AUDIO_S32 && volume > 0 && volume <= MIX_MAXVOLUME) {
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2()) {
+            return (Uint32)(MixAudio_S32_AVX2((Sint32 *)dst, (const Sint32 *)src, num_samples, volume) * sizeof(Sint32));
+        }
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+        if (SDL_HasSSE41()) {
+            return (Uint32)(MixAudio_S32_SSE41((Sint32 *)dst, (const Sint32 *)src, num_samples, volume) * sizeof(Sint32));
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return (Uint32)(MixAudio_S32_NEON((Sint32 *)dst, (const Sint32 *)src, num_samples, volume) * sizeof(Sint32));
+        }
+#endif
+    } else if (format == SDL_AUDIO_F32) {
+#ifdef SDL_AVX2_INTRINSICS
+        if (SDL_HasAVX2() && SDL_HasFMA()) {
+            return (Uint32)(MixAudio_F32_AVX2((float *)dst, (const float *)src, num_samples, fvolume) * sizeof(float));
+        }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+        if (SDL_HasSSE2()) {
+            return (Uint32)(MixAudio_F32_SSE2((float *)dst, (const float *)src, num_samples, fvolume) * sizeof(float));
+        }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+        if (SDL_HasNEON()) {
+            return (Uint32)(MixAudio_F32_NEON((float *)dst, (const float *)src, num_samples, fvolume) * sizeof(float));
+        }
+#endif
+    }
+
+    return 0;
+}
+
 bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 len, float fvolume)
 {
     int volume = (int)SDL_roundf(fvolume * MIX_MAXVOLUME);
@@ -94,6 +364,13 @@ bool SDL_MixAudio(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format, Uint32 l
         return true;
     }
 
+    {
+        const Uint32 mixed = MixAudio_SIMD(dst, src, format, len, volume, fvolume);
+        dst += mixed;
+        src += mixed;
+        len -= mixed;
+    }
+
     switch (format) {
 
     case SDL_AUDIO_U8:
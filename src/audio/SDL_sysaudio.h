@@ -63,6 +63,10 @@ const SDL_AudioFormat *SDL_ClosestAudioFormats(SDL_AudioFormat format);
 // Must be called at least once before using converters.
 extern void SDL_ChooseAudioConverters(void);
 extern void SDL_SetupAudioResampler(void);
+extern void SDL_SetupAudioChannelMixer(void);
+
+// Moves data from a stream's lock-free ring buffer to its queue. The stream must be locked.
+extern void SDL_DrainAudioStreamRingBuffer(SDL_AudioStream *stream);
 
 /* Backends should call this as devices are added to the system (such as
    a USB headset being plugged in), and should also be called for
@@ -73,6 +77,9 @@ extern SDL_AudioDevice *SDL_AddAudioDevice(bool recording, const char *name, con
    This can happen due to i/o errors, or a device being unplugged, etc. */
 extern void SDL_AudioDeviceDisconnected(SDL_AudioDevice *device);
 
+// Backends should call this when an opened device underruns (playback) or overruns (recording). Safe to call from any thread.
+extern void SDL_AudioDeviceXrun(SDL_AudioDevice *device);
+
 // Backends should call this if the system default device changes.
 extern void SDL_DefaultAudioDeviceChanged(SDL_AudioDevice *new_default_device);
 
@@ -123,6 +130,15 @@ extern void ConvertAudio(int num_frames,
                          void *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
                          void* scratch, float gain);
 
+// Channel mix matrices hold this many gains for each source channel, one for each output channel (the rest are ignored).
+#define SDL_AUDIO_MIX_MATRIX_STRIDE 8
+
+// Same as ConvertAudio, but mixes the channels through mix_matrix instead of the default up/downmix when it isn't NULL.
+extern void ConvertAudioWithMixMatrix(int num_frames,
+                                      const void *src, SDL_AudioFormat src_format, int src_channels, const int *src_map,
+                                      void *dst, SDL_AudioFormat dst_format, int dst_channels, const int *dst_map,
+                                      const float *mix_matrix, void* scratch, float gain);
+
 // Compare two SDL_AudioSpecs, return true if they match exactly.
 // Using SDL_memcmp directly isn't safe, since potential padding might not be initialized.
 // either channel map can be NULL for the default (and both should be if you don't care about them).
@@ -195,6 +211,8 @@ typedef struct SDL_AudioDriver
     SDL_AtomicInt playback_device_count;
     SDL_AtomicInt recording_device_count;
     SDL_AtomicInt shutting_down;  // non-zero during SDL_Quit, so we known not to accept any last-minute device hotplugs.
+    SDL_Thread *detection_thread;  // runs the initial DetectDevices if SDL_HINT_DEFERRED_INIT is set.
+    SDL_AtomicInt detection_complete;  // non-zero once the initial DetectDevices has finished.
 } SDL_AudioDriver;
 
 struct SDL_AudioQueue; // forward decl.
@@ -214,15 +232,24 @@ struct SDL_AudioStream
     SDL_AudioSpec dst_spec;
     int *src_chmap;
     int *dst_chmap;
+    float *mix_matrix;  // NULL for the default up/downmix, otherwise points to mix_matrix_storage.
+    float mix_matrix_storage[8 * SDL_AUDIO_MIX_MATRIX_STRIDE];
     float freq_ratio;
     float gain;
 
     struct SDL_AudioQueue* queue;
 
+    // Optional single-producer ring buffer in front of the queue, see SDL_SetAudioStreamLockFreeBuffer().
+    Uint8 *ring;
+    Uint32 ring_size;          // in bytes; a power of two.
+    SDL_AtomicU32 ring_head;   // total bytes written by the producer, without holding the lock.
+    SDL_AtomicU32 ring_tail;   // total bytes moved to the queue, only changed with the lock held.
+
     SDL_AudioSpec input_spec; // The spec of input data currently being processed
     int *input_chmap;
     int input_chmap_storage[SDL_MAX_CHANNELMAP_CHANNELS];  // !!! FIXME: this needs to grow if SDL ever supports more channels. But if it grows, we should probably be more clever about allocations.
     Sint64 resample_offset;
+    struct SDL_ResamplerPhases *resampler_phases;  // shared polyphase filters for the current rate ratio, if it has any.
 
     Uint8 *work_buffer;    // used for scratch space during data conversion/resampling.
     size_t work_buffer_allocation;
@@ -270,6 +297,12 @@ struct SDL_LogicalAudioDevice
     // App-supplied pointer for postmix callback.
     void *postmix_userdata;
 
+    // If non-NULL, callback into the app that gets a read-only view of each captured buffer.
+    SDL_AudioRecordingCallback recording_callback;
+
+    // App-supplied pointer for recording callback.
+    void *recording_userdata;
+
     // double-linked list of opened devices on the same physical device.
     SDL_LogicalAudioDevice *next;
     SDL_LogicalAudioDevice *prev;
@@ -341,6 +374,22 @@ struct SDL_AudioDevice
     // Size of work_buffer (and mix_buffer) in bytes.
     int work_buffer_size;
 
+    // true if bound streams can be converted on the job threads, see SDL_HINT_AUDIO_DEVICE_PARALLEL_MIX.
+    bool parallel_mix;
+
+    // Output buffers and bookkeeping for converting bound streams in parallel.
+    Uint8 *parallel_buffer;
+    size_t parallel_buffer_allocation;
+    struct SDL_AudioMixSlot *parallel_slots;
+    int parallel_slots_allocation;
+
+    // Counters for SDL_GetAudioDeviceStats(), updated by the device thread with `lock` held.
+    SDL_AudioDeviceStats stats;
+    Uint64 last_iterate_ns;
+
+    // Underruns/overruns reported by the backend, possibly from its own threads.
+    SDL_AtomicInt xruns;
+
     // A thread to feed the audio device
     SDL_Thread *thread;
 
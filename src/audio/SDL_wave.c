@@ -1159,7 +1159,10 @@ static bool LAW_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+/* Expands sample_count A-law or mu-law samples from src to native byte order
+ * 16-bit samples in dst. src and dst may point to the same memory.
+ */
+static bool LAW_ExpandSamples(Uint16 encoding, const Uint8 *src, Sint16 *dst, size_t sample_count)
 {
 #ifdef SDL_WAVE_LAW_LUT
     const Sint16 alaw_lut[256] = {
@@ -1200,53 +1203,11 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
     };
 #endif
 
-    WaveFormat *format = &file->format;
-    WaveChunk *chunk = &file->chunk;
-    size_t i, sample_count, expanded_len;
-    Uint8 *src;
-    Sint16 *dst;
-
-    if (chunk->length != chunk->size) {
-        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
-        if (file->sampleframes < 0) {
-            return false;
-        }
-    }
-
-    // Nothing to decode, nothing to return.
-    if (file->sampleframes == 0) {
-        *audio_buf = NULL;
-        *audio_len = 0;
-        return true;
-    }
-
-    sample_count = (size_t)file->sampleframes;
-    if (SafeMult(&sample_count, format->channels)) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    expanded_len = sample_count;
-    if (SafeMult(&expanded_len, sizeof(Sint16))) {
-        return SDL_SetError("WAVE file too big");
-    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
-        return SDL_SetError("WAVE file too big");
-    }
-
-    // 1 to avoid allocating zero bytes, to keep static analysis happy.
-    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
-    if (!src) {
-        return false;
-    }
-    chunk->data = NULL;
-    chunk->size = 0;
-
-    dst = (Sint16 *)src;
+    size_t i;
 
-    /* Work backwards, since we're expanding in-place. `format` will
-     * inform the caller about the byte order.
-     */
+    // Work backwards, since the expansion may happen in-place.
     i = sample_count;
-    switch (file->format.encoding) {
+    switch (encoding) {
 #ifdef SDL_WAVE_LAW_LUT
     case ALAW_CODE:
         while (i--) {
@@ -1291,10 +1252,63 @@ static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
         break;
 #endif
     default:
-        SDL_free(src);
         return SDL_SetError("Unknown companded encoding");
     }
 
+
+    return true;
+}
+
+static bool LAW_Decode(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+    size_t sample_count, expanded_len;
+    Uint8 *src;
+    Sint16 *dst;
+
+    if (chunk->length != chunk->size) {
+        file->sampleframes = WaveAdjustToFactValue(file, chunk->size / format->blockalign);
+        if (file->sampleframes < 0) {
+            return false;
+        }
+    }
+
+    // Nothing to decode, nothing to return.
+    if (file->sampleframes == 0) {
+        *audio_buf = NULL;
+        *audio_len = 0;
+        return true;
+    }
+
+    sample_count = (size_t)file->sampleframes;
+    if (SafeMult(&sample_count, format->channels)) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    expanded_len = sample_count;
+    if (SafeMult(&expanded_len, sizeof(Sint16))) {
+        return SDL_SetError("WAVE file too big");
+    } else if (expanded_len > SDL_MAX_UINT32 || file->sampleframes > SIZE_MAX) {
+        return SDL_SetError("WAVE file too big");
+    }
+
+    // 1 to avoid allocating zero bytes, to keep static analysis happy.
+    src = (Uint8 *)SDL_realloc(chunk->data, expanded_len ? expanded_len : 1);
+    if (!src) {
+        return false;
+    }
+    chunk->data = NULL;
+    chunk->size = 0;
+
+    dst = (Sint16 *)src;
+
+    // `format` will inform the caller about the byte order.
+    if (!LAW_ExpandSamples(format->encoding, src, dst, sample_count)) {
+        SDL_free(src);
+        return false;
+    }
+
     *audio_buf = src;
     *audio_len = (Uint32)expanded_len;
 
@@ -1344,11 +1358,33 @@ static bool PCM_Init(WaveFile *file, size_t datalength)
     return true;
 }
 
+// Shifts sample_count 24-bit samples in ptr to 32 bits. ptr must be big enough for the result.
+static void PCM_ExpandSint24ToSint32(Uint8 *ptr, size_t sample_count)
+{
+    size_t i;
+
+    // work from end to start, since we're expanding in-place.
+    for (i = sample_count; i > 0; i--) {
+        const size_t o = i - 1;
+        uint8_t b[4];
+
+        b[0] = 0;
+        b[1] = ptr[o * 3];
+        b[2] = ptr[o * 3 + 1];
+        b[3] = ptr[o * 3 + 2];
+
+        ptr[o * 4 + 0] = b[0];
+        ptr[o * 4 + 1] = b[1];
+        ptr[o * 4 + 2] = b[2];
+        ptr[o * 4 + 3] = b[3];
+    }
+}
+
 static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32 *audio_len)
 {
     WaveFormat *format = &file->format;
     WaveChunk *chunk = &file->chunk;
-    size_t i, expanded_len, sample_count;
+    size_t expanded_len, sample_count;
     Uint8 *ptr;
 
     sample_count = (size_t)file->sampleframes;
@@ -1376,21 +1412,7 @@ static bool PCM_ConvertSint24ToSint32(WaveFile *file, Uint8 **audio_buf, Uint32
     *audio_buf = ptr;
     *audio_len = (Uint32)expanded_len;
 
-    // work from end to start, since we're expanding in-place.
-    for (i = sample_count; i > 0; i--) {
-        const size_t o = i - 1;
-        uint8_t b[4];
-
-        b[0] = 0;
-        b[1] = ptr[o * 3];
-        b[2] = ptr[o * 3 + 1];
-        b[3] = ptr[o * 3 + 2];
-
-        ptr[o * 4 + 0] = b[0];
-        ptr[o * 4 + 1] = b[1];
-        ptr[o * 4 + 2] = b[2];
-        ptr[o * 4 + 3] = b[3];
-    }
+    PCM_ExpandSint24ToSint32(ptr, sample_count);
 
     return true;
 }
@@ -1770,7 +1792,11 @@ static bool WaveCheckFormat(WaveFile *file, size_t datalength)
     return true;
 }
 
-static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+/* Reads the chunk headers and the fmt chunk, checks the format, and fills in
+ * spec. On success, file->chunk describes the data chunk (without reading it)
+ * and endposition is where the cleanup code should leave the stream.
+ */
+static bool WaveParse(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Sint64 *endposition)
 {
     int result;
     Uint32 chunkcount = 0;
@@ -1990,9 +2016,69 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
 
     WaveFreeChunkData(chunk);
 
-    // Process data chunk.
+    /* Setting up the specs. All unsupported formats were filtered out
+     * by checks earlier in this function.
+     */
+    spec->freq = format->frequency;
+    spec->channels = (Uint8)format->channels;
+    spec->format = SDL_AUDIO_UNKNOWN;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    case ALAW_CODE:
+    case MULAW_CODE:
+        // These can be easily stored in the byte order of the system.
+        spec->format = SDL_AUDIO_S16;
+        break;
+    case IEEE_FLOAT_CODE:
+        spec->format = SDL_AUDIO_F32LE;
+        break;
+    case PCM_CODE:
+        switch (format->bitspersample) {
+        case 8:
+            spec->format = SDL_AUDIO_U8;
+            break;
+        case 16:
+            spec->format = SDL_AUDIO_S16LE;
+            break;
+        case 24: // Has been shifted to 32 bits.
+        case 32:
+            spec->format = SDL_AUDIO_S32LE;
+            break;
+        default:
+            // Just in case something unexpected happened in the checks.
+            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
+        }
+        break;
+    default:
+        return SDL_SetError("Unexpected data format");
+    }
+
+    // The data chunk is read by the caller.
     *chunk = datachunk;
 
+    if (RIFFlengthknown) {
+        *endposition = RIFFend;
+    } else {
+        *endposition = lastchunkpos;
+    }
+
+    return true;
+}
+
+static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
+{
+    int result;
+    Sint64 endposition = 0;
+    WaveFormat *format = &file->format;
+    WaveChunk *chunk = &file->chunk;
+
+    if (!WaveParse(src, file, spec, &endposition)) {
+        return false;
+    }
+
+    // Process data chunk.
     if (chunk->length > 0) {
         result = WaveReadChunkData(src, chunk);
         if (result < 0) {
@@ -2036,51 +2122,8 @@ static bool WaveLoad(SDL_IOStream *src, WaveFile *file, SDL_AudioSpec *spec, Uin
         break;
     }
 
-    /* Setting up the specs. All unsupported formats were filtered out
-     * by checks earlier in this function.
-     */
-    spec->freq = format->frequency;
-    spec->channels = (Uint8)format->channels;
-    spec->format = SDL_AUDIO_UNKNOWN;
-
-    switch (format->encoding) {
-    case MS_ADPCM_CODE:
-    case IMA_ADPCM_CODE:
-    case ALAW_CODE:
-    case MULAW_CODE:
-        // These can be easily stored in the byte order of the system.
-        spec->format = SDL_AUDIO_S16;
-        break;
-    case IEEE_FLOAT_CODE:
-        spec->format = SDL_AUDIO_F32LE;
-        break;
-    case PCM_CODE:
-        switch (format->bitspersample) {
-        case 8:
-            spec->format = SDL_AUDIO_U8;
-            break;
-        case 16:
-            spec->format = SDL_AUDIO_S16LE;
-            break;
-        case 24: // Has been shifted to 32 bits.
-        case 32:
-            spec->format = SDL_AUDIO_S32LE;
-            break;
-        default:
-            // Just in case something unexpected happened in the checks.
-            return SDL_SetError("Unexpected %u-bit PCM data format", (unsigned int)format->bitspersample);
-        }
-        break;
-    default:
-        return SDL_SetError("Unexpected data format");
-    }
-
     // Report the end position back to the cleanup code.
-    if (RIFFlengthknown) {
-        chunk->position = RIFFend;
-    } else {
-        chunk->position = lastchunkpos;
-    }
+    chunk->position = endposition;
 
     return true;
 }
@@ -2122,6 +2165,7 @@ bool SDL_LoadWAV_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec, Uint8
 
     result = WaveLoad(src, &file, spec, audio_buf, audio_len);
     if (!result) {
+        SDL_zerop(spec);
         SDL_free(*audio_buf);
         *audio_buf = NULL;
         *audio_len = 0;
@@ -2158,3 +2202,364 @@ bool SDL_LoadWAV(const char *path, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint3
     return SDL_LoadWAV_IO(stream, true, spec, audio_buf, audio_len);
 }
 
+
+// Number of sample frames decoded at once from uncompressed and companded data.
+#define WAVE_STREAM_BLOCK_FRAMES 1024
+
+#define WAVE_STREAM_PROPERTY "SDL.internal.audiostream.wave"
+
+// Decodes a WAVE file block by block as an audio stream asks for data.
+typedef struct WaveStream
+{
+    SDL_AudioStream *stream;
+    SDL_IOStream *src;
+    bool closeio;
+    WaveFile file;
+    size_t framesize;      // Size of a decoded sample frame in bytes.
+    Sint64 dataposition;   // Position of the data chunk data in src.
+    Uint64 datalength;     // Size of the data chunk data. Shrinks if the file turns out to be truncated.
+    size_t blocksize;      // Number of bytes read from the data chunk for each block.
+    Uint32 blockframes;    // Number of sample frames in a complete block.
+    Uint64 block;          // Index of the next block that gets decoded.
+    Sint64 framesleft;     // Number of sample frames still to be decoded.
+    Uint32 skipframes;     // Sample frames to drop from the next block after a seek.
+    bool seek;             // True if src has to be positioned before reading the next block.
+    bool eof;              // True if everything was decoded and the audio stream was flushed.
+    ADPCM_DecoderState adpcm;
+    Uint8 *input;          // Data read from the data chunk.
+    Uint8 *output;         // Decoded data. Same as input if the data is converted in-place.
+} WaveStream;
+
+static void WaveStreamFree(WaveStream *ws)
+{
+    if (ws->output != ws->input) {
+        SDL_free(ws->output);
+    }
+    SDL_free(ws->input);
+    SDL_free(ws->adpcm.cstate);
+    SDL_free(ws->file.decoderdata);
+    if (ws->closeio) {
+        SDL_CloseIO(ws->src);
+    }
+    SDL_free(ws);
+}
+
+static void SDLCALL WaveStreamCleanup(void *userdata, void *value)
+{
+    WaveStream *ws = (WaveStream *)value;
+
+    // Make sure the audio device thread is done with the decoder before freeing it.
+    SDL_SetAudioStreamGetCallback(ws->stream, NULL, NULL);
+    WaveStreamFree(ws);
+}
+
+static bool WaveStreamSetup(WaveStream *ws)
+{
+    WaveFormat *format = &ws->file.format;
+    size_t inputsize, outputsize;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+        ws->blocksize = format->blockalign;
+        ws->blockframes = format->samplesperblock;
+        inputsize = ws->blocksize;
+        outputsize = (size_t)ws->blockframes * ws->framesize;
+
+        ws->adpcm.channels = format->channels;
+        ws->adpcm.blocksize = format->blockalign;
+        ws->adpcm.samplesperblock = format->samplesperblock;
+        ws->adpcm.framesize = ws->framesize;
+        ws->adpcm.framestotal = ws->file.sampleframes;
+        ws->adpcm.ddata = ws->file.decoderdata;
+        ws->adpcm.output.size = (size_t)ws->blockframes * format->channels;
+        if (format->encoding == MS_ADPCM_CODE) {
+            ws->adpcm.blockheadersize = (size_t)format->channels * 7;
+            ws->adpcm.cstate = SDL_calloc(format->channels, sizeof(MS_ADPCM_ChannelState));
+        } else {
+            ws->adpcm.blockheadersize = (size_t)format->channels * 4;
+            ws->adpcm.cstate = SDL_calloc(format->channels, sizeof(Sint8));
+        }
+        if (!ws->adpcm.cstate) {
+            return false;
+        }
+        break;
+    default:
+        // Uncompressed and companded data gets expanded in-place.
+        ws->blockframes = WAVE_STREAM_BLOCK_FRAMES;
+        ws->blocksize = (size_t)ws->blockframes * format->blockalign;
+        inputsize = (size_t)ws->blockframes * SDL_max(format->blockalign, ws->framesize);
+        outputsize = 0;
+        break;
+    }
+
+    ws->input = (Uint8 *)SDL_malloc(inputsize);
+    if (!ws->input) {
+        return false;
+    }
+
+    if (outputsize) {
+        ws->output = (Uint8 *)SDL_malloc(outputsize);
+        if (!ws->output) {
+            return false;
+        }
+    } else {
+        ws->output = ws->input;
+    }
+
+    return true;
+}
+
+/* Reads and decodes the next block. frames is set to zero at the end of the
+ * data. A truncated block ends the decoding after the frames that could be
+ * recovered from it.
+ */
+static bool WaveStreamDecodeBlock(WaveStream *ws, size_t *frames)
+{
+    WaveFile *file = &ws->file;
+    WaveFormat *format = &file->format;
+    const Uint64 offset = ws->block * ws->blocksize;
+    size_t requested, bytes, count;
+    bool truncated = false;
+
+    *frames = 0;
+
+    if (ws->framesleft <= 0 || offset >= ws->datalength) {
+        return true;
+    }
+
+    if (ws->seek) {
+        const Sint64 position = ws->dataposition + (Sint64)offset;
+        if (SDL_SeekIO(ws->src, position, SDL_IO_SEEK_SET) != position) {
+            return SDL_SetError("Could not seek to WAVE data");
+        }
+        ws->seek = false;
+    }
+
+    requested = (size_t)SDL_min((Uint64)ws->blocksize, ws->datalength - offset);
+    bytes = SDL_ReadIO(ws->src, ws->input, requested);
+    if (bytes < requested) {
+        // I/O issues or corrupt file.
+        if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+            return SDL_SetError("Could not read data of WAVE data chunk");
+        }
+        ws->datalength = offset + bytes;
+        truncated = true;
+    }
+    ws->block++;
+
+    switch (format->encoding) {
+    case MS_ADPCM_CODE:
+    case IMA_ADPCM_CODE:
+    {
+        ADPCM_DecoderState *state = &ws->adpcm;
+        bool result;
+
+        if (bytes < state->blockheadersize) {
+            ws->framesleft = 0;
+            return true;
+        }
+
+        state->framesleft = ws->framesleft;
+        state->block.data = ws->input;
+        state->block.size = bytes;
+        state->block.pos = 0;
+        state->output.data = (Sint16 *)ws->output;
+        state->output.pos = 0;
+
+        if (format->encoding == MS_ADPCM_CODE) {
+            if (!MS_ADPCM_DecodeBlockHeader(state)) {
+                return false;
+            }
+            result = MS_ADPCM_DecodeBlockData(state);
+        } else {
+            result = IMA_ADPCM_DecodeBlockHeader(state) && IMA_ADPCM_DecodeBlockData(state);
+        }
+
+        if (!result) {
+            // Unexpected end. Stop decoding and return partial data if necessary.
+            if (file->trunchint == TruncVeryStrict || file->trunchint == TruncStrict) {
+                return SDL_SetError("Truncated data chunk");
+            } else if (file->trunchint != TruncDropFrame) {
+                state->output.pos = 0;
+            }
+            truncated = true;
+        }
+        count = state->output.pos / state->channels;
+        break;
+    }
+    case ALAW_CODE:
+    case MULAW_CODE:
+        count = bytes / format->blockalign;
+        if (!LAW_ExpandSamples(format->encoding, ws->input, (Sint16 *)ws->input, count * format->channels)) {
+            return false;
+        }
+        break;
+    default:
+        count = bytes / format->blockalign;
+        if (format->encoding == PCM_CODE && format->bitspersample == 24) {
+            PCM_ExpandSint24ToSint32(ws->input, count * format->channels);
+        }
+        break;
+    }
+
+    if ((Sint64)count > ws->framesleft) {
+        count = (size_t)ws->framesleft;
+    }
+    ws->framesleft = truncated ? 0 : ws->framesleft - count;
+
+    *frames = count;
+    return true;
+}
+
+static void SDLCALL WaveStreamGetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    WaveStream *ws = (WaveStream *)userdata;
+
+    while (additional_amount > 0 && !ws->eof) {
+        const Uint8 *data = ws->output;
+        size_t frames = 0;
+
+        // A decoding error ends the stream. SDL_GetError() has the details.
+        if (!WaveStreamDecodeBlock(ws, &frames) || frames == 0) {
+            ws->eof = true;
+            SDL_FlushAudioStream(stream);
+            break;
+        }
+
+        if (ws->skipframes > 0) {
+            const size_t skip = SDL_min(ws->skipframes, frames);
+            data += skip * ws->framesize;
+            frames -= skip;
+            ws->skipframes -= (Uint32)skip;
+        }
+
+        if (frames > 0) {
+            const int len = (int)(frames * ws->framesize);
+            if (!SDL_PutAudioStreamData(stream, data, len)) {
+                ws->eof = true;
+                break;
+            }
+            additional_amount -= len;
+        }
+    }
+}
+
+SDL_AudioStream *SDL_CreateWAVAudioStream_IO(SDL_IOStream *src, bool closeio, SDL_AudioSpec *spec)
+{
+    SDL_AudioStream *stream;
+    SDL_AudioSpec wavspec;
+    SDL_PropertiesID props;
+    WaveStream *ws;
+    Sint64 endposition = 0;
+
+    if (spec) {
+        SDL_zerop(spec);
+    }
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    ws = (WaveStream *)SDL_calloc(1, sizeof(*ws));
+    if (!ws) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return NULL;
+    }
+
+    ws->src = src;
+    ws->closeio = closeio;
+    ws->file.riffhint = WaveGetRiffSizeHint();
+    ws->file.trunchint = WaveGetTruncationHint();
+    ws->file.facthint = WaveGetFactChunkHint();
+
+    SDL_zero(wavspec);
+    if (!WaveParse(src, &ws->file, &wavspec, &endposition)) {
+        WaveFreeChunkData(&ws->file.chunk);
+        WaveStreamFree(ws);
+        return NULL;
+    }
+
+    ws->framesize = SDL_AUDIO_FRAMESIZE(wavspec);
+    ws->dataposition = ws->file.chunk.position;
+    ws->datalength = ws->file.chunk.length;
+    ws->framesleft = ws->file.sampleframes;
+    ws->seek = true;
+
+    if (!WaveStreamSetup(ws)) {
+        WaveStreamFree(ws);
+        return NULL;
+    }
+
+    stream = SDL_CreateAudioStream(&wavspec, &wavspec);
+    if (!stream) {
+        WaveStreamFree(ws);
+        return NULL;
+    }
+    ws->stream = stream;
+
+    props = SDL_GetAudioStreamProperties(stream);
+    if (!props || !SDL_SetPointerPropertyWithCleanup(props, WAVE_STREAM_PROPERTY, ws, WaveStreamCleanup, NULL)) {
+        if (!props) {
+            WaveStreamFree(ws);
+        }
+        SDL_DestroyAudioStream(stream);
+        return NULL;
+    }
+    SDL_SetNumberProperty(props, SDL_PROP_AUDIOSTREAM_WAV_FRAMES_NUMBER, ws->file.sampleframes);
+
+    if (!SDL_SetAudioStreamGetCallback(stream, WaveStreamGetCallback, ws)) {
+        SDL_DestroyAudioStream(stream);
+        return NULL;
+    }
+
+    if (spec) {
+        *spec = wavspec;
+    }
+    return stream;
+}
+
+SDL_AudioStream *SDL_CreateWAVAudioStream(const char *path, SDL_AudioSpec *spec)
+{
+    SDL_IOStream *src = SDL_IOFromFile(path, "rb");
+    if (!src) {
+        if (spec) {
+            SDL_zerop(spec);
+        }
+        return NULL;
+    }
+    return SDL_CreateWAVAudioStream_IO(src, true, spec);
+}
+
+bool SDL_SeekWAVAudioStream(SDL_AudioStream *stream, Uint64 frame)
+{
+    WaveStream *ws;
+
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    ws = (WaveStream *)SDL_GetPointerProperty(SDL_GetAudioStreamProperties(stream), WAVE_STREAM_PROPERTY, NULL);
+    if (!ws) {
+        return SDL_SetError("Audio stream was not created by SDL_CreateWAVAudioStream_IO()");
+    }
+
+    if (frame > (Uint64)ws->file.sampleframes) {
+        frame = (Uint64)ws->file.sampleframes;
+    }
+
+    // Hold the lock so the get callback doesn't see a half-updated decoder.
+    SDL_LockAudioStream(stream);
+    SDL_ClearAudioStream(stream);
+    ws->block = frame / ws->blockframes;
+    ws->skipframes = (Uint32)(frame % ws->blockframes);
+    ws->framesleft = ws->file.sampleframes - (Sint64)(ws->block * ws->blockframes);
+    ws->seek = true;
+    ws->eof = false;
+    SDL_UnlockAudioStream(stream);
+
+    return true;
+}
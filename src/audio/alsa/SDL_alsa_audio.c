@@ -354,6 +354,9 @@ static bool ALSA_WaitDevice(SDL_AudioDevice *device)
     while (!SDL_GetAtomicInt(&device->shutdown)) {
         const int rc = ALSA_snd_pcm_wait(device->hidden->pcm, delay);
         if (rc < 0 && (rc != -EAGAIN)) {
+            if (rc == -EPIPE) {
+                SDL_AudioDeviceXrun(device);
+            }
             const int status = ALSA_snd_pcm_recover(device->hidden->pcm, rc, 0);
             if (status < 0) {
                 // Hmm, not much we can do - abort
@@ -386,6 +389,9 @@ static bool ALSA_PlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int bu
         SDL_assert(rc != 0);  // assuming this can't happen if we used snd_pcm_wait and queried for available space.
         if (rc < 0) {
             SDL_assert(rc != -EAGAIN);  // assuming this can't happen if we used snd_pcm_wait and queried for available space. snd_pcm_recover won't handle it!
+            if (rc == -EPIPE) {
+                SDL_AudioDeviceXrun(device);
+            }
             const int status = ALSA_snd_pcm_recover(device->hidden->pcm, rc, 0);
             if (status < 0) {
                 // Hmm, not much we can do - abort
@@ -438,6 +444,9 @@ static int ALSA_RecordDevice(SDL_AudioDevice *device, void *buffer, int buflen)
     SDL_assert(rc != -EAGAIN);  // assuming this can't happen if we used snd_pcm_wait and queried for available space. snd_pcm_recover won't handle it!
 
     if (rc < 0) {
+        if (rc == -EPIPE) {
+            SDL_AudioDeviceXrun(device);
+        }
         const int status = ALSA_snd_pcm_recover(device->hidden->pcm, rc, 0);
         if (status < 0) {
             // Hmm, not much we can do - abort
@@ -27,6 +27,17 @@
 
 #include <emscripten/emscripten.h>
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/threading.h>
+#include <errno.h>
+
+/* With pthreads, playback and recording go through an AudioWorkletNode that
+   reads (or fills) a lock-free ring in the wasm heap, which is a
+   SharedArrayBuffer in these builds. SDL's own audio device thread is on the
+   other end, so nothing waits on the browser main thread. */
+static bool use_audio_worklet = false;
+#endif
+
 // just turn off clang-format for this whole file, this INDENT_OFF stuff on
 //  each EM_ASM section is ugly.
 /* *INDENT-OFF* */ // clang-format off
@@ -95,12 +106,137 @@ static int EMSCRIPTENAUDIO_RecordDevice(SDL_AudioDevice *device, void *buffer, i
     return buflen;
 }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+static int EMSCRIPTENAUDIO_RingUsed(struct SDL_PrivateAudioData *hidden)
+{
+    const int read_pos = SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_READ]);
+    const int write_pos = SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_WRITE]);
+    return (write_pos - read_pos + (2 * hidden->ring_frames)) % (2 * hidden->ring_frames);
+}
+
+// Waits until frames_wanted frames can be played (or recorded) without blocking, sleeping on ring_pos[index].
+static bool EMSCRIPTENAUDIO_WaitRing(SDL_AudioDevice *device, int index, int frames_wanted)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const double timeout_ms = (((double)device->sample_frames) * 1000.0) / device->spec.freq;
+
+    while (!SDL_GetAtomicInt(&device->shutdown)) {
+        const int pos = SDL_GetAtomicInt(&hidden->ring_pos[index]);
+        const int used = EMSCRIPTENAUDIO_RingUsed(hidden);
+        const int available = device->recording ? used : (hidden->ring_frames - used);
+        if (available >= frames_wanted) {
+            break;
+        }
+
+        // The processor only runs while the AudioContext does. If it's suspended (autoplay
+        //  policy, no microphone yet), give up and let the app make progress anyway.
+        if (emscripten_futex_wait(&hidden->ring_pos[index].value, (uint32_t)pos, timeout_ms) == -ETIMEDOUT) {
+            break;
+        }
+    }
+    return true;
+}
+
+static bool EMSCRIPTENAUDIO_WorkletWaitDevice(SDL_AudioDevice *device)
+{
+    return EMSCRIPTENAUDIO_WaitRing(device, EMSCRIPTENAUDIO_RING_READ, device->sample_frames);
+}
+
+static bool EMSCRIPTENAUDIO_WorkletPlayDevice(SDL_AudioDevice *device, const Uint8 *buffer, int buffer_size)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int framelen = SDL_AUDIO_FRAMESIZE(device->spec);
+    const int frames = buffer_size / framelen;
+    const int write_pos = SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_WRITE]);
+    const int start = write_pos % hidden->ring_frames;
+    const int first = SDL_min(frames, hidden->ring_frames - start);
+
+    if ((hidden->ring_frames - EMSCRIPTENAUDIO_RingUsed(hidden)) < frames) {
+        return true;  // nobody is draining the ring right now, drop this buffer.
+    }
+
+    SDL_memcpy(hidden->ring + (start * device->spec.channels), buffer, first * framelen);
+    SDL_memcpy(hidden->ring, buffer + (first * framelen), (frames - first) * framelen);
+    SDL_SetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_WRITE], (write_pos + frames) % (2 * hidden->ring_frames));
+    return true;
+}
+
+static bool EMSCRIPTENAUDIO_WorkletWaitRecordingDevice(SDL_AudioDevice *device)
+{
+    return EMSCRIPTENAUDIO_WaitRing(device, EMSCRIPTENAUDIO_RING_WRITE, device->sample_frames);
+}
+
+static int EMSCRIPTENAUDIO_WorkletRecordDevice(SDL_AudioDevice *device, void *buffer, int buflen)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    const int framelen = SDL_AUDIO_FRAMESIZE(device->spec);
+    const int frames = buflen / framelen;
+    const int read_pos = SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_READ]);
+    const int start = read_pos % hidden->ring_frames;
+    const int first = SDL_min(frames, hidden->ring_frames - start);
+
+    if (EMSCRIPTENAUDIO_RingUsed(hidden) < frames) {
+        SDL_memset(buffer, device->silence_value, buflen);  // no microphone (yet), feed silence.
+        return buflen;
+    }
+
+    SDL_memcpy(buffer, hidden->ring + (start * device->spec.channels), first * framelen);
+    SDL_memcpy(((Uint8 *)buffer) + (first * framelen), hidden->ring, (frames - first) * framelen);
+    SDL_SetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_READ], (read_pos + frames) % (2 * hidden->ring_frames));
+    return buflen;
+}
+
+static void EMSCRIPTENAUDIO_WorkletFlushRecording(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    SDL_SetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_READ], SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_WRITE]));
+}
+
+static void EMSCRIPTENAUDIO_ReleaseRing(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+    int node_state;
+
+    if (!hidden->ring_pos) {
+        return;
+    }
+
+    // The processor runs on the browser's audio thread; make sure it let go of the ring before it goes back to the heap.
+    SDL_SetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_STOP], 1);
+    node_state = MAIN_THREAD_EM_ASM_INT({
+        var SDL3 = Module['SDL3'];
+        var state = $0 ? SDL3.audio_recording : SDL3.audio_playback;
+        state.released = true;  // don't create the node if the module is still loading.
+        if (state.workletNode === undefined) {
+            return 0;
+        }
+        return (SDL3.audioContext.state === 'running') ? 1 : 2;
+    }, device->recording);
+
+    if (node_state == 1) {
+        for (int i = 0; (i < 10) && !SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_STOPPED]); i++) {
+            emscripten_futex_wait(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_STOPPED].value, 0, 10.0);
+        }
+    }
+
+    if ((node_state == 0) || SDL_GetAtomicInt(&hidden->ring_pos[EMSCRIPTENAUDIO_RING_STOPPED])) {
+        SDL_free(hidden->ring_pos);
+    }  // else: a suspended context might still wake the node up later, so leak the ring rather than let it scribble over the heap.
+    hidden->ring_pos = NULL;
+    hidden->ring = NULL;
+}
+#endif
+
 static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
 {
     if (!device->hidden) {
         return;
     }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    EMSCRIPTENAUDIO_ReleaseRing(device);
+#endif
+
     MAIN_THREAD_EM_ASM({
         var SDL3 = Module['SDL3'];
         if ($0) {
@@ -117,6 +253,9 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
                 SDL3.audio_recording.scriptProcessorNode.onaudioprocess = function(audioProcessingEvent) {};
                 SDL3.audio_recording.scriptProcessorNode.disconnect();
             }
+            if (SDL3.audio_recording.workletNode !== undefined) {
+                SDL3.audio_recording.workletNode.disconnect();
+            }
             if (SDL3.audio_recording.mediaStreamNode !== undefined) {
                 SDL3.audio_recording.mediaStreamNode.disconnect();
             }
@@ -125,6 +264,12 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
             if (SDL3.audio_playback.scriptProcessorNode != undefined) {
                 SDL3.audio_playback.scriptProcessorNode.disconnect();
             }
+            if (SDL3.audio_playback.workletNode !== undefined) {
+                SDL3.audio_playback.workletNode.disconnect();
+            }
+            if (SDL3.audio_playback.resumeTimer !== undefined) {
+                clearInterval(SDL3.audio_playback.resumeTimer);
+            }
             if (SDL3.audio_playback.silenceTimer !== undefined) {
                 clearInterval(SDL3.audio_playback.silenceTimer);
             }
@@ -133,6 +278,7 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
         if ((SDL3.audioContext !== undefined) && (SDL3.audio_playback === undefined) && (SDL3.audio_recording === undefined)) {
             SDL3.audioContext.close();
             SDL3.audioContext = undefined;
+            SDL3.audioWorkletModule = undefined;
         }
     }, device->recording);
 
@@ -145,10 +291,88 @@ static void EMSCRIPTENAUDIO_CloseDevice(SDL_AudioDevice *device)
 
 EM_JS_DEPS(sdlaudio, "$autoResumeAudioContext,$dynCall");
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+static bool EMSCRIPTENAUDIO_OpenWorklet(SDL_AudioDevice *device)
+{
+    struct SDL_PrivateAudioData *hidden = device->hidden;
+
+    hidden->ring_frames = device->sample_frames * 2;
+    hidden->ring_pos = (SDL_AtomicInt *)SDL_calloc(1, (sizeof(SDL_AtomicInt) * EMSCRIPTENAUDIO_RING_POSITIONS) + (hidden->ring_frames * SDL_AUDIO_FRAMESIZE(device->spec)));
+    if (!hidden->ring_pos) {
+        return false;
+    }
+    hidden->ring = (float *)(hidden->ring_pos + EMSCRIPTENAUDIO_RING_POSITIONS);
+
+    // the node is created once the processor module has loaded; until then the device thread times out and drops (or records silence).
+    MAIN_THREAD_EM_ASM({
+        var SDL3 = Module['SDL3'];
+        var recording = $0;
+        var state = recording ? SDL3.audio_recording : SDL3.audio_playback;
+        var options = ({
+            numberOfInputs: (recording ? 1 : 0),
+            numberOfOutputs: 1,
+            outputChannelCount: [(recording ? 1 : $1)],
+            channelCount: $1,
+            channelCountMode: 'explicit',
+            processorOptions: { memory: HEAPU8.buffer, positions: $3, samples: $4, frames: $2, channels: $1, recording: (recording !== 0) }
+        });
+
+        var create_node = function(source) {
+            SDL3.audioWorkletModule.then(function() {
+                var current = recording ? SDL3.audio_recording : SDL3.audio_playback;
+                if ((current !== state) || state.released) { return; }  // closed while the module was loading.
+                state.workletNode = new AudioWorkletNode(SDL3.audioContext, 'sdl3-audio', options);
+                if (source !== undefined) {
+                    source.connect(state.workletNode);
+                }
+                state.workletNode.connect(SDL3.audioContext.destination);
+            });
+        };
+
+        if (recording) {
+            var have_microphone = function(stream) {
+                if (SDL3.audio_recording !== state) { return; }
+                state.stream = stream;
+                state.mediaStreamNode = SDL3.audioContext.createMediaStreamSource(stream);
+                create_node(state.mediaStreamNode);
+            };
+            var no_microphone = function(error) {
+                // the recording thread just keeps getting silence.
+            };
+            if ((navigator.mediaDevices !== undefined) && (navigator.mediaDevices.getUserMedia !== undefined)) {
+                navigator.mediaDevices.getUserMedia({ audio: true, video: false }).then(have_microphone).catch(no_microphone);
+            } else if (navigator.webkitGetUserMedia !== undefined) {
+                navigator.webkitGetUserMedia({ audio: true, video: false }, have_microphone, no_microphone);
+            }
+        } else {
+            create_node(undefined);
+            if (SDL3.audioContext.state === 'suspended') {  // uhoh, autoplay is blocked.
+                state.resumeTimer = setInterval(function() {
+                    if (SDL3.audioContext.state !== 'suspended') {
+                        clearInterval(state.resumeTimer);
+                        state.resumeTimer = undefined;
+                    } else if (((typeof navigator.userActivation) !== 'undefined') && navigator.userActivation.hasBeenActive) {
+                        SDL3.audioContext.resume();
+                    }
+                }, 100);
+            }
+        }
+    }, device->recording, device->spec.channels, hidden->ring_frames, hidden->ring_pos, hidden->ring);
+
+    return true;
+}
+#endif
+
 static bool EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
 {
     // based on parts of library_sdl.js
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    const bool worklet = use_audio_worklet;
+#else
+    const bool worklet = false;
+#endif
+
     // create context
     const bool result = MAIN_THREAD_EM_ASM_INT({
         if (typeof(Module['SDL3']) === 'undefined') {
@@ -173,8 +397,66 @@ static bool EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
                 }
             }
         }
+
+        if ($1 && SDL3.audioContext && (SDL3.audioWorkletModule === undefined)) {
+            /* One processor serves both directions. pos[0] is where the reader is, pos[1] where the
+               writer is (both in frames, modulo twice the ring size), pos[2] asks the processor
+               to stop and pos[3] is its answer. */
+            var processorSource =
+                "class SDL3AudioProcessor extends AudioWorkletProcessor {" +
+                "  constructor(options) {" +
+                "    super();" +
+                "    var o = options.processorOptions;" +
+                "    this.pos = new Int32Array(o.memory, o.positions, 4);" +
+                "    this.samples = new Float32Array(o.memory, o.samples, o.frames * o.channels);" +
+                "    this.frames = o.frames;" +
+                "    this.channels = o.channels;" +
+                "    this.recording = o.recording;" +
+                "  }" +
+                "  process(inputs, outputs) {" +
+                "    var pos = this.pos;" +
+                "    var frames = this.frames;" +
+                "    var channels = this.channels;" +
+                "    var samples = this.samples;" +
+                "    var out = outputs[0];" +
+                "    if (Atomics.load(pos, 2)) {" +
+                "      Atomics.store(pos, 3, 1);" +
+                "      Atomics.notify(pos, 3);" +
+                "      return false;" +
+                "    }" +
+                "    for (var c = 0; c < out.length; ++c) { out[c].fill(0); }" +
+                "    var head = Atomics.load(pos, 0);" +
+                "    var tail = Atomics.load(pos, 1);" +
+                "    var used = (tail - head + 2 * frames) % (2 * frames);" +
+                "    if (this.recording) {" +
+                "      var inp = inputs[0];" +
+                "      if (inp.length === 0) { return true; }" +
+                "      var count = Math.min(inp[0].length, frames - used);" +
+                "      for (var j = 0; j < count; ++j) {" +
+                "        var base = ((tail + j) % frames) * channels;" +
+                "        for (var c = 0; c < channels; ++c) { samples[base + c] = (c < inp.length) ? inp[c][j] : 0; }" +
+                "      }" +
+                "      Atomics.store(pos, 1, (tail + count) % (2 * frames));" +
+                "      Atomics.notify(pos, 1);" +
+                "    } else {" +
+                "      var count = Math.min(out[0].length, used);" +
+                "      var numChannels = Math.min(out.length, channels);" +
+                "      for (var j = 0; j < count; ++j) {" +
+                "        var base = ((head + j) % frames) * channels;" +
+                "        for (var c = 0; c < numChannels; ++c) { out[c][j] = samples[base + c]; }" +
+                "      }" +
+                "      Atomics.store(pos, 0, (head + count) % (2 * frames));" +
+                "      Atomics.notify(pos, 0);" +
+                "    }" +
+                "    return true;" +
+                "  }" +
+                "}" +
+                "registerProcessor('sdl3-audio', SDL3AudioProcessor);";
+            var url = URL.createObjectURL(new Blob([processorSource], { type: 'text/javascript' }));
+            SDL3.audioWorkletModule = SDL3.audioContext.audioWorklet.addModule(url);
+        }
         return (SDL3.audioContext !== undefined);
-    }, device->recording);
+    }, device->recording, worklet);
 
     if (!result) {
         return SDL_SetError("Web Audio API is not available!");
@@ -190,7 +472,11 @@ static bool EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
 
     // limit to native freq
     device->spec.freq = MAIN_THREAD_EM_ASM_INT({ return Module['SDL3'].audioContext.sampleRate; });
-    device->sample_frames = SDL_GetDefaultSampleFramesFromFreq(device->spec.freq) * 2;  // double the buffer size, some browsers need more, and we'll just have to live with the latency.
+    if (worklet) {
+        device->sample_frames = SDL_GetDefaultSampleFramesFromFreq(device->spec.freq);  // the ring holds two of these, the worklet drains it in 128 frame quanta.
+    } else {
+        device->sample_frames = SDL_GetDefaultSampleFramesFromFreq(device->spec.freq) * 2;  // double the buffer size, some browsers need more, and we'll just have to live with the latency.
+    }
 
     SDL_UpdatedAudioDeviceFormat(device);
 
@@ -202,6 +488,12 @@ static bool EMSCRIPTENAUDIO_OpenDevice(SDL_AudioDevice *device)
         SDL_memset(device->hidden->mixbuf, device->silence_value, device->buffer_size);
     }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    if (worklet) {
+        return EMSCRIPTENAUDIO_OpenWorklet(device);
+    }
+#endif
+
     if (device->recording) {
         /* The idea is to take the recording media stream, hook it up to an
            audio graph where we can pass it through a ScriptProcessorNode
@@ -335,6 +627,22 @@ static bool EMSCRIPTENAUDIO_Init(SDL_AudioDriverImpl *impl)
         SDL_SetError("No audio context available");
     }
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+    // the processor needs to see the wasm heap, so this only works when it is shared (cross-origin isolated pages).
+    use_audio_worklet = available && MAIN_THREAD_EM_ASM_INT({
+        return (typeof(AudioWorkletNode) !== 'undefined') && (typeof(SharedArrayBuffer) !== 'undefined') && (HEAPU8.buffer instanceof SharedArrayBuffer);
+    });
+
+    if (use_audio_worklet) {
+        impl->WaitDevice = EMSCRIPTENAUDIO_WorkletWaitDevice;
+        impl->PlayDevice = EMSCRIPTENAUDIO_WorkletPlayDevice;
+        impl->WaitRecordingDevice = EMSCRIPTENAUDIO_WorkletWaitRecordingDevice;
+        impl->RecordDevice = EMSCRIPTENAUDIO_WorkletRecordDevice;
+        impl->FlushRecording = EMSCRIPTENAUDIO_WorkletFlushRecording;
+        impl->ProvidesOwnCallbackThread = false;  // SDL's audio device thread feeds the ring.
+    }
+#endif
+
     recording_available = available && MAIN_THREAD_EM_ASM_INT({
         if ((typeof(navigator.mediaDevices) !== 'undefined') && (typeof(navigator.mediaDevices.getUserMedia) !== 'undefined')) {
             return true;
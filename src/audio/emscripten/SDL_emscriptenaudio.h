@@ -25,9 +25,24 @@
 
 #include "../SDL_sysaudio.h"
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+// Indices into ring_pos, shared with the AudioWorkletProcessor.
+#define EMSCRIPTENAUDIO_RING_READ      0  // next frame to consume, in [0, 2 * ring_frames)
+#define EMSCRIPTENAUDIO_RING_WRITE     1  // next frame to produce, in [0, 2 * ring_frames)
+#define EMSCRIPTENAUDIO_RING_STOP      2  // set by CloseDevice
+#define EMSCRIPTENAUDIO_RING_STOPPED   3  // set by the processor once it let go of the ring
+#define EMSCRIPTENAUDIO_RING_POSITIONS 4
+#endif
+
 struct SDL_PrivateAudioData
 {
     Uint8 *mixbuf;
+#ifdef __EMSCRIPTEN_PTHREADS__
+    // Only set when playing through an AudioWorklet.
+    SDL_AtomicInt *ring_pos;
+    float *ring;
+    int ring_frames;
+#endif
 };
 
 #endif // SDL_emscriptenaudio_h_
@@ -950,6 +950,12 @@ static Uint8 *PIPEWIRE_GetDeviceBuf(SDL_AudioDevice *device, int *buffer_size)
         return NULL;
     }
 
+#if PW_CHECK_VERSION(0, 3, 49)
+    if (device->hidden->mix_requested && pw_buf->requested) {
+        *buffer_size = (int)SDL_min(pw_buf->requested * device->hidden->stride, (Uint64)*buffer_size);
+    }
+#endif
+
     device->hidden->pw_buf = pw_buf;
     return (Uint8 *) spa_buf->datas[0].data;
 }
@@ -1086,7 +1092,8 @@ static bool PIPEWIRE_OpenDevice(SDL_AudioDevice *device)
      * processing callback from the realtime thread.  However, it comes with some
      * caveats: no file IO, allocations, locking or other blocking operations
      * must occur in the mixer callback.  As this cannot be guaranteed when the
-     * callback is in the calling application, this flag is omitted.
+     * callback is in the calling application, this flag is only set when the
+     * app opts in with SDL_HINT_AUDIO_PIPEWIRE_LOW_LATENCY.
      */
     static const enum pw_stream_flags STREAM_FLAGS = PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS;
 
@@ -1100,6 +1107,8 @@ static bool PIPEWIRE_OpenDevice(SDL_AudioDevice *device)
     const char *app_name, *icon_name, *app_id, *stream_name, *stream_role, *error;
     Uint32 node_id = !device->handle ? PW_ID_ANY : PW_HANDLE_TO_ID(device->handle);
     const bool recording = device->recording;
+    const bool low_latency = SDL_GetHintBoolean(SDL_HINT_AUDIO_PIPEWIRE_LOW_LATENCY, false);
+    enum pw_stream_flags stream_flags = STREAM_FLAGS;
     int res;
 
     // Clamp the period size to sane values
@@ -1156,6 +1165,15 @@ static bool PIPEWIRE_OpenDevice(SDL_AudioDevice *device)
         device->sample_frames = min_period;
     }
 
+    if (low_latency) {
+        // Ask for the smallest quantum, unless the app asked for something specific
+        if (!SDL_GetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES)) {
+            device->sample_frames = min_period;
+        }
+        priv->mix_requested = pipewire_core_version_at_least(0, 3, 49);
+        stream_flags |= PW_STREAM_FLAG_RT_PROCESS;
+    }
+
     SDL_UpdatedAudioDeviceFormat(device);
 
     SDL_GetAudioThreadName(device, thread_name, sizeof(thread_name));
@@ -1216,7 +1234,7 @@ static bool PIPEWIRE_OpenDevice(SDL_AudioDevice *device)
     }
 
     // The target node is passed via PW_KEY_TARGET_OBJECT; target_id is a legacy parameter and must be PW_ID_ANY.
-    res = PIPEWIRE_pw_stream_connect(priv->stream, recording ? PW_DIRECTION_INPUT : PW_DIRECTION_OUTPUT, PW_ID_ANY, STREAM_FLAGS,
+    res = PIPEWIRE_pw_stream_connect(priv->stream, recording ? PW_DIRECTION_INPUT : PW_DIRECTION_OUTPUT, PW_ID_ANY, stream_flags,
                                      &params, 1);
     if (res != 0) {
         return SDL_SetError("Pipewire: Failed to connect stream");
@@ -36,6 +36,9 @@ struct SDL_PrivateAudioData
     Sint32 stride; // Bytes-per-frame
     int stream_init_status;
 
+    // Only mix the number of frames PipeWire requests each cycle
+    bool mix_requested;
+
     // Set in GetDeviceBuf, filled in AudioThreadIterate, queued in PlayDevice
     struct pw_buffer *pw_buf;
 };
@@ -127,6 +127,8 @@ static int (*PULSEAUDIO_pa_stream_disconnect)(pa_stream *);
 static void (*PULSEAUDIO_pa_stream_unref)(pa_stream *);
 static void (*PULSEAUDIO_pa_stream_set_write_callback)(pa_stream *, pa_stream_request_cb_t, void *);
 static void (*PULSEAUDIO_pa_stream_set_read_callback)(pa_stream *, pa_stream_request_cb_t, void *);
+static void (*PULSEAUDIO_pa_stream_set_underflow_callback)(pa_stream *, pa_stream_notify_cb_t, void *);
+static void (*PULSEAUDIO_pa_stream_set_overflow_callback)(pa_stream *, pa_stream_notify_cb_t, void *);
 static pa_operation *(*PULSEAUDIO_pa_context_get_server_info)(pa_context *, pa_server_info_cb_t, void *);
 
 static bool load_pulseaudio_syms(void);
@@ -241,6 +243,8 @@ static bool load_pulseaudio_syms(void)
     SDL_PULSEAUDIO_SYM(pa_strerror);
     SDL_PULSEAUDIO_SYM(pa_stream_set_write_callback);
     SDL_PULSEAUDIO_SYM(pa_stream_set_read_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_underflow_callback);
+    SDL_PULSEAUDIO_SYM(pa_stream_set_overflow_callback);
     SDL_PULSEAUDIO_SYM(pa_context_get_server_info);
     SDL_PULSEAUDIO_SYM(pa_proplist_new);
     SDL_PULSEAUDIO_SYM(pa_proplist_free);
@@ -403,6 +407,11 @@ static void WriteCallback(pa_stream *p, size_t nbytes, void *userdata)
     PULSEAUDIO_pa_threaded_mainloop_signal(pulseaudio_threaded_mainloop, 0);
 }
 
+static void XrunCallback(pa_stream *p, void *userdata)
+{
+    SDL_AudioDeviceXrun((SDL_AudioDevice *)userdata);
+}
+
 // This function waits until it is possible to write a full sound buffer
 static bool PULSEAUDIO_WaitDevice(SDL_AudioDevice *device)
 {
@@ -710,9 +719,11 @@ static bool PULSEAUDIO_OpenDevice(SDL_AudioDevice *device)
         const char *device_path = ((PulseDeviceHandle *) device->handle)->device_path;
         if (recording) {
             PULSEAUDIO_pa_stream_set_read_callback(h->stream, ReadCallback, h);
+            PULSEAUDIO_pa_stream_set_overflow_callback(h->stream, XrunCallback, device);
             rc = PULSEAUDIO_pa_stream_connect_record(h->stream, device_path, &paattr, flags);
         } else {
             PULSEAUDIO_pa_stream_set_write_callback(h->stream, WriteCallback, h);
+            PULSEAUDIO_pa_stream_set_underflow_callback(h->stream, XrunCallback, device);
             rc = PULSEAUDIO_pa_stream_connect_playback(h->stream, device_path, &paattr, flags, NULL, NULL);
         }
 
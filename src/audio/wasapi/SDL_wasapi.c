@@ -584,6 +584,9 @@ static bool WASAPI_WaitDevice(SDL_AudioDevice *device)
                 UINT32 padding = 0;
                 if (!WasapiFailed(device, IAudioClient_GetCurrentPadding(device->hidden->client, &padding))) {
                     //SDL_Log("WASAPI EVENT! padding=%u maxpadding=%u", (unsigned int)padding, (unsigned int)maxpadding);
+                    if ((padding == 0) && (device->stats.iterations > 0)) {
+                        SDL_AudioDeviceXrun(device);  // the endpoint buffer ran dry before we got back to it.
+                    }
                     if (padding <= (UINT32)device->sample_frames) {
                         break;
                     }
@@ -619,6 +622,10 @@ static int WASAPI_RecordDevice(SDL_AudioDevice *device, void *buffer, int buflen
             const int leftover = total - cpy;
             const bool silent = (flags & AUDCLNT_BUFFERFLAGS_SILENT) ? true : false;
 
+            if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {
+                SDL_AudioDeviceXrun(device);  // we didn't read fast enough and the endpoint dropped data.
+            }
+
             SDL_assert(leftover == 0);  // according to MSDN, this isn't everything available, just one "packet" of data per-GetBuffer call.
 
             if (silent) {
@@ -26,6 +26,10 @@
 #include "../video/SDL_surface_c.h"
 #include "../thread/SDL_systhread.h"
 
+#ifdef HAVE_CLOCK_GETTIME
+#include <time.h>
+#endif
+
 
 // A lot of this is a simplified version of SDL_audio.c; if fixing stuff here,
 //  maybe check that file, too.
@@ -257,6 +261,7 @@ static void ClosePhysicalCamera(SDL_Camera *device)
     camera_driver.impl.CloseDevice(device);
 
     SDL_DestroyProperties(device->props);
+    device->props = 0;
 
     SDL_DestroySurface(device->acquire_surface);
     device->acquire_surface = NULL;
@@ -267,6 +272,12 @@ static void ClosePhysicalCamera(SDL_Camera *device)
         SDL_DestroySurface(device->output_surfaces[i].surface);
     }
     SDL_zeroa(device->output_surfaces);
+    device->num_output_surfaces = 0;
+
+    device->frames_captured = 0;
+    device->frames_dropped = 0;
+    device->frames_converted = 0;
+    device->conversion_ns = 0;
 
     SDL_aligned_free(device->zombie_pixels);
 
@@ -278,6 +289,8 @@ static void ClosePhysicalCamera(SDL_Camera *device)
 
     device->base_timestamp = 0;
     device->adjust_timestamp = 0;
+    device->timestamps_are_sdl_ticks = false;
+    device->low_latency = false;
 
     SDL_zero(device->spec);
 }
@@ -798,6 +811,88 @@ void SDL_CameraThreadSetup(SDL_Camera *device)
 #endif
 }
 
+static void ClearCameraFrameDMABUFProperties(SDL_Surface *frame)
+{
+    const SDL_PropertiesID props = frame->props;  // don't create properties on surfaces that have none.
+    if (props) {
+        SDL_ClearProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER);
+        SDL_ClearProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER);
+        SDL_ClearProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER);
+        SDL_ClearProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER);
+    }
+}
+
+static void CopyCameraFrameDMABUFProperties(SDL_Surface *src, SDL_Surface *dst)
+{
+    const SDL_PropertiesID srcprops = src->props;
+    if (srcprops && SDL_HasProperty(srcprops, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER)) {
+        const SDL_PropertiesID dstprops = SDL_GetSurfaceProperties(dst);
+        SDL_SetNumberProperty(dstprops, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, SDL_GetNumberProperty(srcprops, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, -1));
+        SDL_SetNumberProperty(dstprops, SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER, SDL_GetNumberProperty(srcprops, SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER, 0));
+        SDL_SetNumberProperty(dstprops, SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER, SDL_GetNumberProperty(srcprops, SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER, src->pitch));
+        SDL_SetNumberProperty(dstprops, SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER, SDL_GetNumberProperty(srcprops, SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER, 0));
+    } else {
+        ClearCameraFrameDMABUFProperties(dst);
+    }
+}
+
+#ifdef HAVE_CLOCK_GETTIME
+Uint64 SDL_CameraMonotonicToTicksNS(Uint64 monotonicNS)
+{
+    // SDL's clock might not be CLOCK_MONOTONIC, so measure how old the frame is and subtract that from the current SDL time.
+    struct timespec now;
+    const Uint64 ticks = SDL_GetTicksNS();
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+        const Uint64 nowNS = SDL_SECONDS_TO_NS((Uint64) now.tv_sec) + (Uint64) now.tv_nsec;
+        if ((monotonicNS <= nowNS) && ((nowNS - monotonicNS) < ticks)) {
+            return ticks - (nowNS - monotonicNS);
+        }
+    }
+    return ticks;
+}
+#endif
+
+// Call this with the device lock held.
+static void PublishCameraStats(SDL_Camera *device)
+{
+    if (device->props == 0) {
+        device->props = SDL_CreateProperties();
+    }
+    const SDL_PropertiesID props = device->props;
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_CAPTURED_NUMBER, (Sint64) device->frames_captured);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_DROPPED_NUMBER, (Sint64) device->frames_dropped);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAMES_CONVERTED_NUMBER, (Sint64) device->frames_converted);
+    SDL_SetNumberProperty(props, SDL_PROP_CAMERA_CONVERSION_TIME_NUMBER, (Sint64) device->conversion_ns);
+}
+
+// Call this with the device lock held. Moves the oldest frame the app hasn't acquired yet back to the empty list.
+static bool RecycleOldestCameraFrame(SDL_Camera *device)
+{
+    SurfaceList *slistprev = &device->filled_output_surfaces;
+    SurfaceList *slist = slistprev->next;
+    if (!slist) {
+        return false;
+    }
+
+    while (slist->next) {  // frames are in this list from newest to oldest, so find the end of the list...
+        slistprev = slist;
+        slist = slist->next;
+    }
+    slistprev->next = NULL;
+
+    // this pointer was owned by the backend (DMA memory or whatever), give it back.
+    if (!device->needs_conversion && !device->needs_scaling) {
+        device->ReleaseFrame(device, slist->surface);
+        slist->surface->pixels = NULL;
+        slist->surface->pitch = 0;
+    }
+    slist->timestampNS = 0;
+
+    slist->next = device->empty_output_surfaces.next;
+    device->empty_output_surfaces.next = slist;
+    return true;
+}
+
 bool SDL_CameraThreadIterate(SDL_Camera *device)
 {
     SDL_LockMutex(device->lock);
@@ -818,6 +913,10 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
     SDL_Surface *output_surface = NULL;
     SurfaceList *slist = NULL;
     Uint64 timestampNS = 0;
+    Uint64 conversion_ns = 0;
+
+    // backends set these again for each frame that has them.
+    ClearCameraFrameDMABUFProperties(device->acquire_surface);
 
     // AcquireFrame SHOULD NOT BLOCK, as we are holding a lock right now. Block in WaitDevice instead!
     const SDL_CameraFrameResult rc = device->AcquireFrame(device, device->acquire_surface, &timestampNS);
@@ -827,6 +926,18 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
         SDL_Log("CAMERA: New frame available! pixels=%p pitch=%d", device->acquire_surface->pixels, device->acquire_surface->pitch);
         #endif
 
+        device->frames_captured++;
+
+        if ((device->drop_frames <= 0) && (device->empty_output_surfaces.next == NULL) && device->drop_oldest_frames) {
+            // the app is falling behind and wants the latest video, so throw away the oldest frame it hasn't seen yet.
+            if (RecycleOldestCameraFrame(device)) {
+                #if DEBUG_CAMERA
+                SDL_Log("CAMERA: No empty output surfaces! Dropping oldest frame!");
+                #endif
+                device->frames_dropped++;
+            }
+        }
+
         if (device->drop_frames > 0) {
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: Dropping an initial frame");
@@ -843,12 +954,16 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
             device->ReleaseFrame(device, device->acquire_surface);
             device->acquire_surface->pixels = NULL;
             device->acquire_surface->pitch = 0;
+            device->frames_dropped++;
+            PublishCameraStats(device);
         } else {
-            if (!device->adjust_timestamp) {
-                device->adjust_timestamp = SDL_GetTicksNS();
-                device->base_timestamp = timestampNS;
+            if (!device->timestamps_are_sdl_ticks) {
+                if (!device->adjust_timestamp) {
+                    device->adjust_timestamp = SDL_GetTicksNS();
+                    device->base_timestamp = timestampNS;
+                }
+                timestampNS = (timestampNS - device->base_timestamp) + device->adjust_timestamp;
             }
-            timestampNS = (timestampNS - device->base_timestamp) + device->adjust_timestamp;
 
             slist = device->empty_output_surfaces.next;
             output_surface = slist->surface;
@@ -885,10 +1000,12 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
             output_surface->h = acquired->h;
             output_surface->pixels = acquired->pixels;
             output_surface->pitch = acquired->pitch;
+            CopyCameraFrameDMABUFProperties(acquired, output_surface);
         } else {  // convert/scale into a different surface.
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: Frame is getting converted!");
             #endif
+            const Uint64 conversion_start = SDL_GetTicksNS();
             SDL_Surface *srcsurf = acquired;
             if (device->needs_scaling == -1) {  // downscaling? Do it first.  -1: downscale, 0: no scaling, 1: upscale
                 SDL_Surface *dstsurf = device->needs_conversion ? device->conversion_surface : output_surface;
@@ -908,6 +1025,7 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
 
             // we made a copy, so we can give the driver back its resources.
             device->ReleaseFrame(device, acquired);
+            conversion_ns = SDL_GetTicksNS() - conversion_start;
         }
 
         // we either released these already after we copied the data, or the pointer was migrated to output_surface.
@@ -918,6 +1036,11 @@ bool SDL_CameraThreadIterate(SDL_Camera *device)
         SDL_LockMutex(device->lock);
         slist->next = device->filled_output_surfaces.next;
         device->filled_output_surfaces.next = slist;
+        if (device->needs_scaling || device->needs_conversion) {
+            device->frames_converted++;
+            device->conversion_ns += conversion_ns;
+        }
+        PublishCameraStats(device);
         SDL_UnlockMutex(device->lock);
     }
 
@@ -982,6 +1105,14 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
         appspec->framerate_denominator = devspec->framerate_denominator;
     }
 
+    // if the app is going to convert on the GPU, hand it the raw frames. MJPG isn't something a GPU can sample, though.
+    if ((devspec->format != SDL_PIXELFORMAT_MJPG) && SDL_GetHintBoolean(SDL_HINT_CAMERA_DEFER_CONVERSION, false)) {
+        appspec->format = devspec->format;
+        appspec->colorspace = devspec->colorspace;
+        appspec->width = devspec->width;
+        appspec->height = devspec->height;
+    }
+
     if ((devspec->width == appspec->width) && (devspec->height == appspec->height)) {
         device->needs_scaling = 0;
     } else {
@@ -996,6 +1127,16 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
 
     device->needs_conversion = (devspec->format != appspec->format);
 
+    const char *pool_size = SDL_GetHint(SDL_HINT_CAMERA_FRAME_POOL_SIZE);
+    device->num_output_surfaces = (pool_size && *pool_size) ? SDL_atoi(pool_size) : 8;
+    device->num_output_surfaces = SDL_clamp(device->num_output_surfaces, 1, (int) SDL_arraysize(device->output_surfaces));
+    const char *drop_policy = SDL_GetHint(SDL_HINT_CAMERA_FRAME_DROP_POLICY);
+    if (drop_policy && *drop_policy) {
+        device->drop_oldest_frames = (SDL_strcasecmp(drop_policy, "oldest") == 0);
+    } else {
+        device->drop_oldest_frames = device->low_latency;  // a low latency app wants the newest frame, not the next one.
+    }
+
     device->acquire_surface = SDL_CreateSurfaceFrom(devspec->width, devspec->height, devspec->format, NULL, 0);
     if (!device->acquire_surface) {
         goto failed;
@@ -1018,12 +1159,12 @@ bool SDL_PrepareCameraSurfaces(SDL_Camera *device)
     // the backend fills into acquired_surface, and you can get all the way from DMA access in the camera hardware
     // to the app without a single copy. Otherwise, these will be full surfaces that hold converted/scaled copies.
 
-    for (int i = 0; i < (SDL_arraysize(device->output_surfaces) - 1); i++) {
+    for (int i = 0; i < (device->num_output_surfaces - 1); i++) {
         device->output_surfaces[i].next = &device->output_surfaces[i + 1];
     }
     device->empty_output_surfaces.next = device->output_surfaces;
 
-    for (int i = 0; i < SDL_arraysize(device->output_surfaces); i++) {
+    for (int i = 0; i < device->num_output_surfaces; i++) {
         SDL_Surface *surf;
         if (device->needs_scaling || device->needs_conversion) {
             surf = SDL_CreateSurface(appspec->width, appspec->height, appspec->format);
@@ -1199,6 +1340,8 @@ SDL_Camera *SDL_OpenCamera(SDL_CameraID instance_id, const SDL_CameraSpec *spec)
     device->AcquireFrame = camera_driver.impl.AcquireFrame;
     device->ReleaseFrame = camera_driver.impl.ReleaseFrame;
 
+    device->low_latency = SDL_GetHintBoolean(SDL_HINT_CAMERA_LOW_LATENCY, false);
+
     SDL_CameraSpec closest;
     ChooseBestCameraSpec(device, spec, &closest);
 
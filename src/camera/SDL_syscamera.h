@@ -57,6 +57,11 @@ extern void SDL_CameraThreadShutdown(SDL_Camera *device);
 // Backends can call this if they have to finish initializing later, like Emscripten. Most backends should _not_ call this directly!
 extern bool SDL_PrepareCameraSurfaces(SDL_Camera *device);
 
+#ifdef HAVE_CLOCK_GETTIME
+// Backends can call this to convert a CLOCK_MONOTONIC capture time to SDL_GetTicksNS() time. Set timestamps_are_sdl_ticks if you do!
+extern Uint64 SDL_CameraMonotonicToTicksNS(Uint64 monotonicNS);
+#endif
+
 
 // common utility functionality to gather up camera specs. Not required!
 typedef struct CameraFormatAddData
@@ -129,6 +134,12 @@ struct SDL_Camera
     // SDL timestamp of first acquired frame, so we can roughly convert to SDL ticks.
     Uint64 adjust_timestamp;
 
+    // Backends set this if AcquireFrame reports when the frame was captured in SDL_GetTicksNS() time, so it doesn't need adjusting.
+    bool timestamps_are_sdl_ticks;
+
+    // true if the app asked for SDL_HINT_CAMERA_LOW_LATENCY. Backends should keep as few frames in flight as they can.
+    bool low_latency;
+
     // Pixel data flows from the driver into these, then gets converted for the app if necessary.
     SDL_Surface *acquire_surface;
 
@@ -136,7 +147,8 @@ struct SDL_Camera
     SDL_Surface *conversion_surface;
 
     // A queue of surfaces that buffer converted/scaled frames of video until the app claims them.
-    SurfaceList output_surfaces[8];
+    SurfaceList output_surfaces[32];
+    int num_output_surfaces;                   // how many of output_surfaces are in use, from SDL_HINT_CAMERA_FRAME_POOL_SIZE.
     SurfaceList filled_output_surfaces;        // this is FIFO
     SurfaceList empty_output_surfaces;         // this is LIFO
     SurfaceList app_held_output_surfaces;
@@ -150,6 +162,15 @@ struct SDL_Camera
     // true if acquire_surface needs to be converted for final output.
     bool needs_conversion;
 
+    // true to replace the oldest unclaimed frame when the app falls behind, false to drop the new frame.
+    bool drop_oldest_frames;
+
+    // Frame statistics, published through the camera properties.
+    Uint64 frames_captured;
+    Uint64 frames_dropped;
+    Uint64 frames_converted;
+    Uint64 conversion_ns;
+
     // Current state flags
     SDL_AtomicInt shutdown;
     SDL_AtomicInt zombie;
@@ -324,6 +324,11 @@ static bool COREMEDIA_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
         (id)kCVPixelBufferPixelFormatTypeKey : @(CMFormatDescriptionGetMediaSubType([spec_format formatDescription]))
     };
 
+    // this is the default, but make sure a frame that's already late never delays the next one in low latency mode.
+    if (device->low_latency) {
+        output.alwaysDiscardsLateVideoFrames = YES;
+    }
+
     char threadname[64];
     SDL_GetCameraThreadName(device, threadname, sizeof (threadname));
     dispatch_queue_t queue = dispatch_queue_create(threadname, NULL);
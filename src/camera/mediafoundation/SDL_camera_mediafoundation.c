@@ -51,6 +51,7 @@ static const GUID SDL_MF_MT_YUV_MATRIX = { 0x3e23d450, 0x2c75, 0x4d25, { 0xa0, 0
 static const GUID SDL_MF_MT_VIDEO_CHROMA_SITING = { 0x65df2370, 0xc773, 0x4c33, { 0xaa, 0x64, 0x84, 0x3e, 0x06, 0x8e, 0xfb, 0x0c } };
 static const GUID SDL_MF_MT_FRAME_SIZE = { 0x1652c33d, 0xd6b2, 0x4012, { 0xb8, 0x34, 0x72, 0x03, 0x08, 0x49, 0xa3, 0x7d } };
 static const GUID SDL_MF_MT_FRAME_RATE = { 0xc459a2e8, 0x3d2c, 0x4e44, { 0xb1, 0x32, 0xfe, 0xe5, 0x15, 0x6c, 0x7b, 0xb0 } };
+static const GUID SDL_MF_LOW_LATENCY = { 0x9c27891a, 0xed7a, 0x40e1, { 0x88, 0xe8, 0xb2, 0x27, 0x27, 0xa0, 0x24, 0xee } };
 static const GUID SDL_MFMediaType_Video = { 0x73646976, 0x0000, 0x0010, { 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71 } };
 static const IID SDL_MF_DEVSOURCE_ATTRIBUTE_FRIENDLY_NAME = { 0x60d0e559, 0x52f8, 0x4fa2, { 0xbb, 0xce, 0xac, 0xdb, 0x34, 0xa8, 0xec, 0x1 } };
 static const IID SDL_MF_DEVSOURCE_ATTRIBUTE_SOURCE_TYPE = { 0xc60ac5fe, 0x252a, 0x478f, { 0xa0, 0xef, 0xbc, 0x8f, 0xa5, 0xf7, 0xca, 0xd3 } };
@@ -770,9 +771,22 @@ static bool MEDIAFOUNDATION_OpenDevice(SDL_Camera *device, const SDL_CameraSpec
     // than we're dealing with, but this will do for now. The docs are slightly
     // insistent that you should use one, though...Maybe it's extremely hard
     // to handle directly at the IMFMediaSource layer...?
-    ret = pMFCreateSourceReaderFromMediaSource(source, NULL, &srcreader);
+    if (device->low_latency) {
+        ret = pMFCreateAttributes(&attrs, 1);
+        CHECK_HRESULT("MFCreateAttributes", ret);
+
+        ret = IMFAttributes_SetUINT32(attrs, &SDL_MF_LOW_LATENCY, TRUE);
+        CHECK_HRESULT("IMFAttributes_SetUINT32(low_latency)", ret);
+    }
+
+    ret = pMFCreateSourceReaderFromMediaSource(source, attrs, &srcreader);
     CHECK_HRESULT("MFCreateSourceReaderFromMediaSource", ret);
 
+    if (attrs) {
+        IMFAttributes_Release(attrs);
+        attrs = NULL;
+    }
+
     // !!! FIXME: do we actually have to find the media type object in the source reader or can we just roll our own like this?
     ret = pMFCreateMediaType(&mediatype);
     CHECK_HRESULT("MFCreateMediaType", ret);
@@ -579,11 +579,13 @@ static SDL_CameraFrameResult PIPEWIRECAMERA_AcquireFrame(SDL_Camera *device, SDL
         return SDL_CAMERA_FRAME_SKIP;
     }
 
+    // PipeWire buffer times are CLOCK_MONOTONIC, so we can report them in SDL's clock directly.
 #if PW_CHECK_VERSION(1,0,5)
-    *timestampNS = hotplug.have_1_0_5 ? b->time : SDL_GetTicksNS();
+    *timestampNS = hotplug.have_1_0_5 ? SDL_CameraMonotonicToTicksNS(b->time) : SDL_GetTicksNS();
 #else
     *timestampNS = SDL_GetTicksNS();
 #endif
+    device->timestamps_are_sdl_ticks = true;
     frame->pixels = b->buffer->datas[0].data;
     if (frame->format == SDL_PIXELFORMAT_MJPG) {
         frame->pitch = b->buffer->datas[0].chunk->size;
@@ -591,6 +593,15 @@ static SDL_CameraFrameResult PIPEWIRECAMERA_AcquireFrame(SDL_Camera *device, SDL
         frame->pitch = b->buffer->datas[0].chunk->stride;
     }
 
+    if (b->buffer->datas[0].type == SPA_DATA_DmaBuf) {
+        // We don't negotiate modifiers, so the producer gives us linear buffers
+        const SDL_PropertiesID props = SDL_GetSurfaceProperties(frame);
+        SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, b->buffer->datas[0].fd);
+        SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER, b->buffer->datas[0].chunk->offset);
+        SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER, frame->pitch);
+        SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER, 0);  // DRM_FORMAT_MOD_LINEAR
+    }
+
     PIPEWIRE_pw_thread_loop_unlock(hotplug.loop);
 
     return SDL_CAMERA_FRAME_READY;
@@ -68,6 +68,7 @@ struct buffer {
     void   *start;
     size_t  length;
     int available; // Is available in userspace
+    int dmabuf_fd; // Exported with VIDIOC_EXPBUF, or -1
 };
 
 struct SDL_PrivateCameraData
@@ -122,6 +123,37 @@ static bool V4L2_WaitDevice(SDL_Camera *device)
     return false;
 }
 
+static Uint64 V4L2_GetFrameTimestamp(SDL_Camera *device, const struct v4l2_buffer *buf)
+{
+    const Uint64 timestampNS = (((Uint64) buf->timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf->timestamp.tv_usec);
+    if ((buf->flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+        // The driver stamped this with CLOCK_MONOTONIC when it captured the frame (at start of exposure, if it supports V4L2_BUF_FLAG_TSTAMP_SRC_SOE).
+        device->timestamps_are_sdl_ticks = true;
+        return SDL_CameraMonotonicToTicksNS(timestampNS);
+    }
+    return timestampNS;
+}
+
+// In low latency mode, skip ahead to the newest frame the driver has, and give older frames back right away.
+static bool V4L2_DequeueNewestFrame(SDL_Camera *device, struct v4l2_buffer *buf)
+{
+    const int fd = device->hidden->fd;
+
+    while (true) {
+        struct v4l2_buffer newer;
+        SDL_zero(newer);
+        newer.type = buf->type;
+        newer.memory = buf->memory;
+        if (xioctl(fd, VIDIOC_DQBUF, &newer) == -1) {
+            return true;  // no more frames waiting, we've got the newest one.
+        }
+        if (xioctl(fd, VIDIOC_QBUF, buf) == -1) {
+            return SDL_SetError("VIDIOC_QBUF");
+        }
+        SDL_copyp(buf, &newer);
+    }
+}
+
 static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *frame, Uint64 *timestampNS)
 {
     const int fd = device->hidden->fd;
@@ -177,6 +209,10 @@ static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *
                 }
             }
 
+            if (device->low_latency && !V4L2_DequeueNewestFrame(device, &buf)) {
+                return SDL_CAMERA_FRAME_ERROR;
+            }
+
             if ((int)buf.index < 0 || (int)buf.index >= device->hidden->nb_buffers) {
                 SDL_SetError("invalid buffer index");
                 return SDL_CAMERA_FRAME_ERROR;
@@ -190,7 +226,15 @@ static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *
             }
             device->hidden->buffers[buf.index].available = 1;
 
-            *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
+            if (device->hidden->buffers[buf.index].dmabuf_fd >= 0) {
+                const SDL_PropertiesID props = SDL_GetSurfaceProperties(frame);
+                SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_FD_NUMBER, device->hidden->buffers[buf.index].dmabuf_fd);
+                SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_OFFSET_NUMBER, 0);
+                SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_PITCH_NUMBER, frame->pitch);
+                SDL_SetNumberProperty(props, SDL_PROP_CAMERA_FRAME_DMABUF_MODIFIER_NUMBER, 0);  // DRM_FORMAT_MOD_LINEAR
+            }
+
+            *timestampNS = V4L2_GetFrameTimestamp(device, &buf);
 
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: debug mmap: image %d/%d  data[0]=%p", buf.index, device->hidden->nb_buffers, (void*)frame->pixels);
@@ -218,6 +262,10 @@ static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *
                 }
             }
 
+            if (device->low_latency && !V4L2_DequeueNewestFrame(device, &buf)) {
+                return SDL_CAMERA_FRAME_ERROR;
+            }
+
             int i;
             for (i = 0; i < device->hidden->nb_buffers; ++i) {
                 if (buf.m.userptr == (unsigned long)device->hidden->buffers[i].start && buf.length == size) {
@@ -238,7 +286,7 @@ static SDL_CameraFrameResult V4L2_AcquireFrame(SDL_Camera *device, SDL_Surface *
             }
             device->hidden->buffers[i].available = 1;
 
-            *timestampNS = (((Uint64) buf.timestamp.tv_sec) * SDL_NS_PER_SECOND) + SDL_US_TO_NS(buf.timestamp.tv_usec);
+            *timestampNS = V4L2_GetFrameTimestamp(device, &buf);
 
             #if DEBUG_CAMERA
             SDL_Log("CAMERA: debug userptr: image %d/%d  data[0]=%p", buf.index, device->hidden->nb_buffers, (void*)frame->pixels);
@@ -394,6 +442,18 @@ static bool AllocBufferMmap(SDL_Camera *device)
         if (MAP_FAILED == device->hidden->buffers[i].start) {
             return SDL_SetError("mmap");
         }
+
+#ifdef VIDIOC_EXPBUF
+        // Export the buffer as a dma-buf too, so apps can import frames into the GPU without a copy. This is optional.
+        struct v4l2_exportbuffer expbuf;
+        SDL_zero(expbuf);
+        expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        expbuf.index = i;
+        expbuf.flags = O_RDONLY | O_CLOEXEC;
+        if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) == 0) {
+            device->hidden->buffers[i].dmabuf_fd = expbuf.fd;
+        }
+#endif
     }
     return true;
 }
@@ -471,6 +531,9 @@ static void V4L2_CloseDevice(SDL_Camera *device)
 
                 case IO_METHOD_MMAP:
                     for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+                        if (device->hidden->buffers[i].dmabuf_fd >= 0) {
+                            close(device->hidden->buffers[i].dmabuf_fd);
+                        }
                         if (munmap(device->hidden->buffers[i].start, device->hidden->buffers[i].length) == -1) {
                             SDL_SetError("munmap");
                         }
@@ -588,11 +651,14 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
     }
     device->hidden->driver_pitch = fmt.fmt.pix.bytesperline;
 
+    // in low latency mode, use the minimum number of buffers the driver will stream with, so frames can't queue up.
+    const int num_buffers = device->low_latency ? 2 : 8;
+
     io_method io = IO_METHOD_INVALID;
     if ((io == IO_METHOD_INVALID) && (cap.device_caps & V4L2_CAP_STREAMING)) {
         struct v4l2_requestbuffers req;
         SDL_zero(req);
-        req.count = 8;
+        req.count = num_buffers;
         req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
         req.memory = V4L2_MEMORY_MMAP;
         if ((xioctl(fd, VIDIOC_REQBUFS, &req) == 0) && (req.count >= 2)) {
@@ -600,12 +666,12 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
             device->hidden->nb_buffers = req.count;
         } else {  // mmap didn't work out? Try USERPTR.
             SDL_zero(req);
-            req.count = 8;
+            req.count = num_buffers;
             req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
             req.memory = V4L2_MEMORY_USERPTR;
             if (xioctl(fd, VIDIOC_REQBUFS, &req) == 0) {
                 io = IO_METHOD_USERPTR;
-                device->hidden->nb_buffers = 8;
+                device->hidden->nb_buffers = num_buffers;
             }
         }
     }
@@ -625,6 +691,9 @@ static bool V4L2_OpenDevice(SDL_Camera *device, const SDL_CameraSpec *spec)
     if (!device->hidden->buffers) {
         return false;
     }
+    for (int i = 0; i < device->hidden->nb_buffers; ++i) {
+        device->hidden->buffers[i].dmabuf_fd = -1;
+    }
 
     size_t size, pitch;
     if (!SDL_CalculateSurfaceSize(device->spec.format, device->spec.width, device->spec.height, &size, &pitch, false)) {
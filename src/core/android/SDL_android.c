@@ -348,6 +348,7 @@ static jmethodID midDestroyCustomCursor;
 static jmethodID midGetContext;
 static jmethodID midGetManifestEnvironmentVariables;
 static jmethodID midGetNativeSurface;
+static jmethodID midGetPowerInfo;
 static jmethodID midInitTouch;
 static jmethodID midIsAndroidTV;
 static jmethodID midIsChromebook;
@@ -399,6 +400,13 @@ static bool bHasNewData;
 
 static bool bHasEnvironmentVariables;
 
+/* Results of Java calls that can be answered without a JNI transition until
+   the Java side tells us they changed. The clipboard state is -1 if unknown
+   and -2 while it's being queried. The cursor is 0 if unknown, a custom
+   cursor ID or -1 - a system cursor ID. */
+static SDL_AtomicInt mClipboardHasText = { -1 };
+static SDL_AtomicInt mCurrentCursor;
+
 // Android AssetManager
 static void Internal_Android_Create_AssetManager(void);
 static void Internal_Android_Destroy_AssetManager(void);
@@ -638,6 +646,7 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeSetupJNI)(JNIEnv *env, jclass cl
     midGetContext = (*env)->GetStaticMethodID(env, mActivityClass, "getContext", "()Landroid/content/Context;");
     midGetManifestEnvironmentVariables = (*env)->GetStaticMethodID(env, mActivityClass, "getManifestEnvironmentVariables", "()Z");
     midGetNativeSurface = (*env)->GetStaticMethodID(env, mActivityClass, "getNativeSurface", "()Landroid/view/Surface;");
+    midGetPowerInfo = (*env)->GetStaticMethodID(env, mActivityClass, "getPowerInfo", "()[I");
     midInitTouch = (*env)->GetStaticMethodID(env, mActivityClass, "initTouch", "()V");
     midIsAndroidTV = (*env)->GetStaticMethodID(env, mActivityClass, "isAndroidTV", "()Z");
     midIsChromebook = (*env)->GetStaticMethodID(env, mActivityClass, "isChromebook", "()Z");
@@ -671,6 +680,7 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeSetupJNI)(JNIEnv *env, jclass cl
         !midGetContext ||
         !midGetManifestEnvironmentVariables ||
         !midGetNativeSurface ||
+        !midGetPowerInfo ||
         !midInitTouch ||
         !midIsAndroidTV ||
         !midIsChromebook ||
@@ -1207,6 +1217,9 @@ JNIEXPORT void JNICALL SDL_JAVA_CONTROLLER_INTERFACE(nativeRemoveHaptic)(
 // Called from surfaceCreated()
 JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(onNativeSurfaceCreated)(JNIEnv *env, jclass jcls)
 {
+    // A new surface doesn't have our cursor yet
+    SDL_SetAtomicInt(&mCurrentCursor, 0);
+
     SDL_LockMutex(Android_ActivityMutex);
 
     if (Android_Window) {
@@ -1386,6 +1399,8 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(onNativeAccel)(
 JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(onNativeClipboardChanged)(
     JNIEnv *env, jclass jcls)
 {
+    SDL_SetAtomicInt(&mClipboardHasText, -1);
+
     // TODO: compute new mime types
     SDL_SendClipboardUpdate(false, NULL, 0);
 }
@@ -1473,6 +1488,9 @@ JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeResume)(
 JNIEXPORT void JNICALL SDL_JAVA_INTERFACE(nativeFocusChanged)(
     JNIEnv *env, jclass cls, jboolean hasFocus)
 {
+    // We aren't told about clipboard changes while we don't have focus
+    SDL_SetAtomicInt(&mClipboardHasText, -1);
+
     SDL_LockMutex(Android_ActivityMutex);
 
     if (Android_Window) {
@@ -1860,6 +1878,7 @@ bool Android_JNI_SetClipboardText(const char *text)
     jstring string = (*env)->NewStringUTF(env, text);
     (*env)->CallStaticVoidMethod(env, mActivityClass, midClipboardSetText, string);
     (*env)->DeleteLocalRef(env, string);
+    SDL_SetAtomicInt(&mClipboardHasText, -1);
     return true;
 }
 
@@ -1884,8 +1903,15 @@ char *Android_JNI_GetClipboardText(void)
 
 bool Android_JNI_HasClipboardText(void)
 {
-    JNIEnv *env = Android_JNI_GetEnv();
-    return (*env)->CallStaticBooleanMethod(env, mActivityClass, midClipboardHasText);
+    int has_text = SDL_GetAtomicInt(&mClipboardHasText);
+    if (has_text < 0) {
+        JNIEnv *env = Android_JNI_GetEnv();
+        // Only keep the result if the clipboard didn't change while we were asking
+        SDL_SetAtomicInt(&mClipboardHasText, -2);
+        has_text = (*env)->CallStaticBooleanMethod(env, mActivityClass, midClipboardHasText) ? 1 : 0;
+        SDL_CompareAndSwapAtomicInt(&mClipboardHasText, -2, has_text);
+    }
+    return has_text > 0;
 }
 
 /* returns 0 on success or -1 on error (others undefined then)
@@ -1894,86 +1920,37 @@ bool Android_JNI_HasClipboardText(void)
  */
 int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seconds, int *percent)
 {
-    struct LocalReferenceHolder refs = LocalReferenceHolder_Setup(__FUNCTION__);
     JNIEnv *env = Android_JNI_GetEnv();
-    jmethodID mid;
-    jobject context;
-    jstring action;
-    jclass cls;
-    jobject filter;
-    jobject intent;
-    jstring iname;
-    jmethodID imid;
-    jstring bname;
-    jmethodID bmid;
-    if (!LocalReferenceHolder_Init(&refs, env)) {
-        LocalReferenceHolder_Cleanup(&refs);
+    jintArray array;
+    jint info[5]; // plugged, status, present, level, scale
+
+    // info = SDLActivity.getPowerInfo();
+    array = (jintArray)(*env)->CallStaticObjectMethod(env, mActivityClass, midGetPowerInfo);
+    if (!array) {
         return -1;
     }
-
-    // context = SDLActivity.getContext();
-    context = (*env)->CallStaticObjectMethod(env, mActivityClass, midGetContext);
-
-    action = (*env)->NewStringUTF(env, "android.intent.action.BATTERY_CHANGED");
-
-    cls = (*env)->FindClass(env, "android/content/IntentFilter");
-
-    mid = (*env)->GetMethodID(env, cls, "<init>", "(Ljava/lang/String;)V");
-    filter = (*env)->NewObject(env, cls, mid, action);
-
-    (*env)->DeleteLocalRef(env, action);
-
-    mid = (*env)->GetMethodID(env, mActivityClass, "registerReceiver", "(Landroid/content/BroadcastReceiver;Landroid/content/IntentFilter;)Landroid/content/Intent;");
-    intent = (*env)->CallObjectMethod(env, context, mid, NULL, filter);
-
-    (*env)->DeleteLocalRef(env, filter);
-
-    cls = (*env)->GetObjectClass(env, intent);
-
-    imid = (*env)->GetMethodID(env, cls, "getIntExtra", "(Ljava/lang/String;I)I");
-
-    // Watch out for C89 scoping rules because of the macro
-#define GET_INT_EXTRA(var, key)                                  \
-    int var;                                                     \
-    iname = (*env)->NewStringUTF(env, key);                      \
-    (var) = (*env)->CallIntMethod(env, intent, imid, iname, -1); \
-    (*env)->DeleteLocalRef(env, iname);
-
-    bmid = (*env)->GetMethodID(env, cls, "getBooleanExtra", "(Ljava/lang/String;Z)Z");
-
-    // Watch out for C89 scoping rules because of the macro
-#define GET_BOOL_EXTRA(var, key)                                            \
-    int var;                                                                \
-    bname = (*env)->NewStringUTF(env, key);                                 \
-    (var) = (*env)->CallBooleanMethod(env, intent, bmid, bname, JNI_FALSE); \
-    (*env)->DeleteLocalRef(env, bname);
+    (*env)->GetIntArrayRegion(env, array, 0, SDL_arraysize(info), info);
+    (*env)->DeleteLocalRef(env, array);
 
     if (plugged) {
-        // Watch out for C89 scoping rules because of the macro
-        GET_INT_EXTRA(plug, "plugged") // == BatteryManager.EXTRA_PLUGGED (API 5)
-        if (plug == -1) {
-            LocalReferenceHolder_Cleanup(&refs);
+        if (info[0] == -1) {
             return -1;
         }
         // 1 == BatteryManager.BATTERY_PLUGGED_AC
         // 2 == BatteryManager.BATTERY_PLUGGED_USB
-        *plugged = (0 < plug) ? 1 : 0;
+        *plugged = (0 < info[0]) ? 1 : 0;
     }
 
     if (charged) {
-        // Watch out for C89 scoping rules because of the macro
-        GET_INT_EXTRA(status, "status") // == BatteryManager.EXTRA_STATUS (API 5)
-        if (status == -1) {
-            LocalReferenceHolder_Cleanup(&refs);
+        if (info[1] == -1) {
             return -1;
         }
         // 5 == BatteryManager.BATTERY_STATUS_FULL
-        *charged = (status == 5) ? 1 : 0;
+        *charged = (info[1] == 5) ? 1 : 0;
     }
 
     if (battery) {
-        GET_BOOL_EXTRA(present, "present") // == BatteryManager.EXTRA_PRESENT (API 5)
-        *battery = present ? 1 : 0;
+        *battery = info[2] ? 1 : 0;
     }
 
     if (seconds) {
@@ -1981,30 +1958,12 @@ int Android_JNI_GetPowerInfo(int *plugged, int *charged, int *battery, int *seco
     }
 
     if (percent) {
-        int level;
-        int scale;
-
-        // Watch out for C89 scoping rules because of the macro
-        {
-            GET_INT_EXTRA(level_temp, "level") // == BatteryManager.EXTRA_LEVEL (API 5)
-            level = level_temp;
-        }
-        // Watch out for C89 scoping rules because of the macro
-        {
-            GET_INT_EXTRA(scale_temp, "scale") // == BatteryManager.EXTRA_SCALE (API 5)
-            scale = scale_temp;
-        }
-
-        if ((level == -1) || (scale == -1)) {
-            LocalReferenceHolder_Cleanup(&refs);
+        if ((info[3] == -1) || (info[4] == -1)) {
             return -1;
         }
-        *percent = level * 100 / scale;
+        *percent = info[3] * 100 / info[4];
     }
 
-    (*env)->DeleteLocalRef(env, intent);
-
-    LocalReferenceHolder_Cleanup(&refs);
     return 0;
 }
 
@@ -2479,19 +2438,34 @@ int Android_JNI_CreateCustomCursor(SDL_Surface *surface, int hot_x, int hot_y)
 void Android_JNI_DestroyCustomCursor(int cursorID)
 {
     JNIEnv *env = Android_JNI_GetEnv();
+    SDL_CompareAndSwapAtomicInt(&mCurrentCursor, cursorID, 0);
     (*env)->CallStaticVoidMethod(env, mActivityClass, midDestroyCustomCursor, cursorID);
 }
 
 bool Android_JNI_SetCustomCursor(int cursorID)
 {
     JNIEnv *env = Android_JNI_GetEnv();
-    return (*env)->CallStaticBooleanMethod(env, mActivityClass, midSetCustomCursor, cursorID);
+    if (SDL_GetAtomicInt(&mCurrentCursor) == cursorID) {
+        return true;
+    }
+    if (!(*env)->CallStaticBooleanMethod(env, mActivityClass, midSetCustomCursor, cursorID)) {
+        return false;
+    }
+    SDL_SetAtomicInt(&mCurrentCursor, cursorID);
+    return true;
 }
 
 bool Android_JNI_SetSystemCursor(int cursorID)
 {
     JNIEnv *env = Android_JNI_GetEnv();
-    return (*env)->CallStaticBooleanMethod(env, mActivityClass, midSetSystemCursor, cursorID);
+    if (SDL_GetAtomicInt(&mCurrentCursor) == -1 - cursorID) {
+        return true;
+    }
+    if (!(*env)->CallStaticBooleanMethod(env, mActivityClass, midSetSystemCursor, cursorID)) {
+        return false;
+    }
+    SDL_SetAtomicInt(&mCurrentCursor, -1 - cursorID);
+    return true;
 }
 
 bool Android_JNI_SupportsRelativeMouse(void)
@@ -0,0 +1,76 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#ifndef SDL_futex_h_
+#define SDL_futex_h_
+
+// Thin wrappers around the Linux futex syscall, for SDL's semaphores and condition variables
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* The old futex syscall takes a timespec of two longs on every architecture, whatever the
+   C library's time_t is. Newer 32-bit architectures only have the 64-bit time version. */
+#ifdef SYS_futex
+#define SDL_SYS_futex SYS_futex
+typedef struct SDL_FutexTimespec
+{
+    long tv_sec;
+    long tv_nsec;
+} SDL_FutexTimespec;
+#else
+#define SDL_SYS_futex SYS_futex_time64
+typedef struct SDL_FutexTimespec
+{
+    Sint64 tv_sec;
+    Sint64 tv_nsec;
+} SDL_FutexTimespec;
+#endif
+
+/* Sleep while `addr` still holds `expected`, for up to `timeoutNS` (forever if negative).
+   Returns false only on timeout; wakeups may be spurious, so callers recheck their state. */
+static inline bool SDL_FutexWait(SDL_AtomicInt *addr, int expected, Sint64 timeoutNS)
+{
+    SDL_FutexTimespec ts;
+    SDL_FutexTimespec *timeout = NULL;
+
+    if (timeoutNS >= 0) {
+        ts.tv_sec = (long)(timeoutNS / SDL_NS_PER_SECOND);
+        ts.tv_nsec = (long)(timeoutNS % SDL_NS_PER_SECOND);
+        timeout = &ts;
+    }
+    if (syscall(SDL_SYS_futex, &addr->value, FUTEX_WAIT_PRIVATE, expected, timeout, NULL, 0) < 0 && errno == ETIMEDOUT) {
+        return false;
+    }
+    return true;
+}
+
+// Wake up to `count` threads sleeping on `addr`
+static inline void SDL_FutexWake(SDL_AtomicInt *addr, int count)
+{
+    syscall(SDL_SYS_futex, &addr->value, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+#endif // SDL_futex_h_
@@ -73,6 +73,11 @@
 #include <sys/param.h>
 #endif
 
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #if defined(SDL_PLATFORM_ANDROID) && defined(__arm__) && !defined(HAVE_GETAUXVAL)
 #include <cpu-features.h>
 #endif
@@ -110,6 +115,9 @@
 #define CPU_HAS_ARM_SIMD (1 << 11)
 #define CPU_HAS_LSX      (1 << 12)
 #define CPU_HAS_LASX     (1 << 13)
+#define CPU_HAS_FMA      (1 << 14)
+#define CPU_HAS_PCLMULQDQ (1 << 15)
+#define CPU_HAS_ARM_CRC32 (1 << 16)
 
 #define CPU_CFG2      0x2
 #define CPU_CFG2_LSX  (1 << 6)
@@ -519,6 +527,24 @@ static int CPU_haveNEON(void)
 #endif
 }
 
+static int CPU_haveARMCRC32(void)
+{
+#ifdef __ARM_FEATURE_CRC32
+    return 1;
+#elif defined(SDL_PLATFORM_WINDOWS) && defined(_M_ARM64)
+#ifndef PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE
+#define PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE 31
+#endif
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRC32_INSTRUCTIONS_AVAILABLE) != 0;
+#elif defined(SDL_PLATFORM_APPLE) && defined(__aarch64__)
+    return 1; // all Apple ARM64 chips have the CRC32 extension.
+#elif (defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)) && defined(__aarch64__) && defined(HAVE_GETAUXVAL)
+    return (getauxval(AT_HWCAP) & (1 << 7)) != 0; // HWCAP_CRC32
+#else
+    return 0;
+#endif
+}
+
 static int CPU_readCPUCFG(void)
 {
     uint32_t cfg2 = 0;
@@ -570,6 +596,16 @@ static int CPU_readCPUCFG(void)
 #else
 #define CPU_haveAVX() (0)
 #endif
+#ifdef __FMA__
+#define CPU_haveFMA() (1)
+#else
+#define CPU_haveFMA() (0)
+#endif
+#ifdef __PCLMUL__
+#define CPU_havePCLMULQDQ() (1)
+#else
+#define CPU_havePCLMULQDQ() (0)
+#endif
 #else
 #define CPU_haveMMX()   (CPU_CPUIDFeatures[3] & 0x00800000)
 #define CPU_haveSSE()   (CPU_CPUIDFeatures[3] & 0x02000000)
@@ -578,6 +614,8 @@ static int CPU_readCPUCFG(void)
 #define CPU_haveSSE41() (CPU_CPUIDFeatures[2] & 0x00080000)
 #define CPU_haveSSE42() (CPU_CPUIDFeatures[2] & 0x00100000)
 #define CPU_haveAVX()   (CPU_OSSavesYMM && (CPU_CPUIDFeatures[2] & 0x10000000))
+#define CPU_haveFMA()   (CPU_OSSavesYMM && (CPU_CPUIDFeatures[2] & 0x00001000))
+#define CPU_havePCLMULQDQ() (CPU_CPUIDFeatures[2] & 0x00000002)
 #endif
 
 #ifdef __e2k__
@@ -668,6 +706,316 @@ int SDL_GetNumLogicalCPUCores(void)
     return SDL_NumLogicalCPUCores;
 }
 
+// Which logical CPUs are performance or efficiency cores, indexed by SDL_CPUCoreType
+typedef struct CPU_Topology
+{
+    Uint64 masks[3];
+    int counts[3];
+#ifdef SDL_PLATFORM_WINDOWS
+    Uint32 cpuset_ids[64];
+#endif
+} CPU_Topology;
+
+static CPU_Topology SDL_CPUTopology;
+static SDL_AtomicInt SDL_CPUTopologyReady;
+
+static int CPU_CountBits(Uint64 mask)
+{
+    int count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        ++count;
+    }
+    return count;
+}
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+static bool CPU_ReadSysfs(const char *path, char *buf, size_t buflen)
+{
+    ssize_t len;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    len = read(fd, buf, buflen - 1);
+    close(fd);
+    if (len <= 0) {
+        return false;
+    }
+    buf[len] = '\0';
+    return true;
+}
+
+// Parses a kernel CPU list like "0-3,8,10-11" into a mask
+static bool CPU_ReadSysfsCPUList(const char *path, Uint64 *mask)
+{
+    char buf[256];
+    const char *p = buf;
+
+    if (!CPU_ReadSysfs(path, buf, sizeof(buf))) {
+        return false;
+    }
+
+    *mask = 0;
+    for (;;) {
+        char *end;
+        long first, last;
+
+        first = SDL_strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        last = first;
+        p = end;
+        if (*p == '-') {
+            ++p;
+            last = SDL_strtol(p, &end, 10);
+            if (end == p) {
+                break;
+            }
+            p = end;
+        }
+        for (; first <= last && first < 64; ++first) {
+            if (first >= 0) {
+                *mask |= SDL_UINT64_C(1) << first;
+            }
+        }
+        if (*p != ',') {
+            break;
+        }
+        ++p;
+    }
+    return true;
+}
+
+// Fills in one value per online CPU from a per-CPU sysfs file, returns the largest
+static Sint64 CPU_ReadSysfsCPUValues(Uint64 online, const char *name, Sint64 *values)
+{
+    Sint64 maximum = 0;
+    int cpu;
+
+    for (cpu = 0; cpu < 64; ++cpu) {
+        char path[128];
+        char buf[32];
+
+        if (!(online & (SDL_UINT64_C(1) << cpu))) {
+            continue;
+        }
+        SDL_snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, name);
+        if (!CPU_ReadSysfs(path, buf, sizeof(buf))) {
+            return 0;
+        }
+        values[cpu] = SDL_strtoll(buf, NULL, 10);
+        if (values[cpu] <= 0) {
+            return 0;
+        }
+        maximum = SDL_max(maximum, values[cpu]);
+    }
+    return maximum;
+}
+
+static void CPU_DetectLinuxTopology(CPU_Topology *topology)
+{
+    Uint64 online = topology->masks[SDL_CPU_CORE_ANY];
+    Uint64 performance = 0, efficiency = 0;
+
+    if (CPU_ReadSysfsCPUList("/sys/devices/system/cpu/online", &online) && online) {
+        topology->masks[SDL_CPU_CORE_ANY] = online;
+    }
+
+    // Intel hybrid parts register a PMU for each core type, listing its CPUs.
+    if (CPU_ReadSysfsCPUList("/sys/devices/cpu_core/cpus", &performance) &&
+        CPU_ReadSysfsCPUList("/sys/devices/cpu_atom/cpus", &efficiency)) {
+        efficiency &= online;
+    } else {
+        /* ARM systems report each core's relative capacity (the biggest core is
+           1024), or failing that its top clock speed. Anything well below the
+           fastest core counts as an efficiency core; mid-sized cores on
+           three-cluster phones still count as performance cores. */
+        Sint64 values[64];
+        Sint64 maximum = CPU_ReadSysfsCPUValues(online, "cpu_capacity", values);
+        if (!maximum) {
+            maximum = CPU_ReadSysfsCPUValues(online, "cpufreq/cpuinfo_max_freq", values);
+        }
+        efficiency = 0;
+        if (maximum) {
+            int cpu;
+            for (cpu = 0; cpu < 64; ++cpu) {
+                if ((online & (SDL_UINT64_C(1) << cpu)) && values[cpu] * 10 < maximum * 7) {
+                    efficiency |= SDL_UINT64_C(1) << cpu;
+                }
+            }
+        }
+    }
+    topology->masks[SDL_CPU_CORE_EFFICIENCY] = efficiency;
+    topology->masks[SDL_CPU_CORE_PERFORMANCE] = online & ~efficiency;
+}
+#endif // SDL_PLATFORM_LINUX || SDL_PLATFORM_ANDROID
+
+#ifdef SDL_PLATFORM_WINDOWS
+// Mirrors SYSTEM_CPU_SET_INFORMATION, which older SDKs don't have
+typedef struct CPU_SetInformation
+{
+    DWORD Size;
+    DWORD Type;
+    DWORD Id;
+    WORD Group;
+    BYTE LogicalProcessorIndex;
+    BYTE CoreIndex;
+    BYTE LastLevelCacheIndex;
+    BYTE NumaNodeIndex;
+    BYTE EfficiencyClass;
+    BYTE AllFlags;
+    DWORD Reserved;
+    DWORD64 AllocationTag;
+} CPU_SetInformation;
+
+typedef BOOL(WINAPI *pfnGetSystemCpuSetInformation)(void *, ULONG, PULONG, HANDLE, ULONG);
+
+static void CPU_DetectWindowsTopology(CPU_Topology *topology)
+{
+    // CPU sets arrived in Windows 10; older systems are treated as uniform.
+    pfnGetSystemCpuSetInformation pGetSystemCpuSetInformation = NULL;
+    HMODULE kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+    BYTE classes[64];
+    BYTE lowest = 0xFF, highest = 0;
+    Uint64 present = 0;
+    ULONG length = 0;
+    BYTE *buffer, *p;
+    int cpu;
+
+    if (kernel32) {
+        pGetSystemCpuSetInformation = (pfnGetSystemCpuSetInformation)GetProcAddress(kernel32, "GetSystemCpuSetInformation");
+    }
+    if (!pGetSystemCpuSetInformation) {
+        return;
+    }
+    pGetSystemCpuSetInformation(NULL, 0, &length, GetCurrentProcess(), 0);
+    if (!length) {
+        return;
+    }
+    buffer = (BYTE *)SDL_malloc(length);
+    if (!buffer) {
+        return;
+    }
+    if (pGetSystemCpuSetInformation(buffer, length, &length, GetCurrentProcess(), 0)) {
+        for (p = buffer; p + sizeof(DWORD) * 2 <= buffer + length; p += ((CPU_SetInformation *)p)->Size) {
+            const CPU_SetInformation *info = (const CPU_SetInformation *)p;
+            if (info->Size < sizeof(*info)) {
+                break;  // malformed, don't loop forever
+            }
+            if (info->Type != 0 /* CpuSetInformation */ || info->Group != 0 || info->LogicalProcessorIndex >= 64) {
+                continue;  // only the first processor group fits in a 64-bit mask
+            }
+            cpu = info->LogicalProcessorIndex;
+            present |= SDL_UINT64_C(1) << cpu;
+            classes[cpu] = info->EfficiencyClass;
+            topology->cpuset_ids[cpu] = info->Id;
+            lowest = SDL_min(lowest, info->EfficiencyClass);
+            highest = SDL_max(highest, info->EfficiencyClass);
+        }
+    }
+    SDL_free(buffer);
+
+    if (!present) {
+        return;
+    }
+    topology->masks[SDL_CPU_CORE_ANY] = present;
+    topology->masks[SDL_CPU_CORE_PERFORMANCE] = present;
+    topology->masks[SDL_CPU_CORE_EFFICIENCY] = 0;
+    if (lowest != highest) {
+        // Higher efficiency classes are faster; only the lowest class counts as efficiency cores.
+        for (cpu = 0; cpu < 64; ++cpu) {
+            if ((present & (SDL_UINT64_C(1) << cpu)) && classes[cpu] == lowest) {
+                topology->masks[SDL_CPU_CORE_EFFICIENCY] |= SDL_UINT64_C(1) << cpu;
+            }
+        }
+        topology->masks[SDL_CPU_CORE_PERFORMANCE] &= ~topology->masks[SDL_CPU_CORE_EFFICIENCY];
+    }
+}
+#endif // SDL_PLATFORM_WINDOWS
+
+static const CPU_Topology *SDL_GetCPUTopology(void)
+{
+    if (!SDL_GetAtomicInt(&SDL_CPUTopologyReady)) {
+        CPU_Topology topology;
+        const int num_cpus = SDL_GetNumLogicalCPUCores();
+        bool have_masks = true;
+        int i;
+
+        SDL_zero(topology);
+
+        // Until something says otherwise, every core is a performance core.
+        topology.masks[SDL_CPU_CORE_ANY] = (num_cpus >= 64) ? ~SDL_UINT64_C(0) : ((SDL_UINT64_C(1) << num_cpus) - 1);
+        topology.masks[SDL_CPU_CORE_PERFORMANCE] = topology.masks[SDL_CPU_CORE_ANY];
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+        CPU_DetectLinuxTopology(&topology);
+#elif defined(SDL_PLATFORM_WINDOWS)
+        CPU_DetectWindowsTopology(&topology);
+#elif defined(SDL_PLATFORM_APPLE) && defined(HAVE_SYSCTLBYNAME)
+        {
+            // Apple silicon lists its performance levels fastest first, but doesn't say which CPU numbers are which.
+            int nperflevels = 0, count = 0;
+            size_t size = sizeof(nperflevels);
+            if (sysctlbyname("hw.nperflevels", &nperflevels, &size, NULL, 0) == 0 && nperflevels > 1) {
+                size = sizeof(count);
+                if (sysctlbyname("hw.perflevel0.logicalcpu", &count, &size, NULL, 0) == 0 && count > 0) {
+                    topology.counts[SDL_CPU_CORE_PERFORMANCE] = count;
+                    topology.counts[SDL_CPU_CORE_EFFICIENCY] = SDL_max(num_cpus - count, 0);
+                    topology.masks[SDL_CPU_CORE_PERFORMANCE] = 0;
+                    have_masks = false;
+                }
+            }
+        }
+#endif
+
+        if (have_masks) {
+            for (i = 0; i < SDL_arraysize(topology.masks); ++i) {
+                topology.counts[i] = CPU_CountBits(topology.masks[i]);
+            }
+        }
+        topology.counts[SDL_CPU_CORE_ANY] = num_cpus;
+
+        SDL_CPUTopology = topology;
+        SDL_SetAtomicInt(&SDL_CPUTopologyReady, 1);
+    }
+    return &SDL_CPUTopology;
+}
+
+int SDL_GetNumCPUCoresOfType(SDL_CPUCoreType type)
+{
+    if (type < SDL_CPU_CORE_ANY || type > SDL_CPU_CORE_EFFICIENCY) {
+        SDL_InvalidParamError("type");
+        return 0;
+    }
+    return SDL_GetCPUTopology()->counts[type];
+}
+
+Uint64 SDL_GetCPUCoreMask(SDL_CPUCoreType type)
+{
+    if (type < SDL_CPU_CORE_ANY || type > SDL_CPU_CORE_EFFICIENCY) {
+        SDL_InvalidParamError("type");
+        return 0;
+    }
+    return SDL_GetCPUTopology()->masks[type];
+}
+
+#ifdef SDL_PLATFORM_WINDOWS
+int SDL_GetWindowsCPUSetIDs(Uint64 mask, Uint32 *ids)
+{
+    const CPU_Topology *topology = SDL_GetCPUTopology();
+    int cpu, count = 0;
+
+    for (cpu = 0; cpu < 64; ++cpu) {
+        if ((mask & (SDL_UINT64_C(1) << cpu)) && topology->cpuset_ids[cpu]) {
+            ids[count++] = topology->cpuset_ids[cpu];
+        }
+    }
+    return count;
+}
+#endif
+
 #ifdef __e2k__
 inline const char *
 SDL_GetCPUType(void)
@@ -955,12 +1303,18 @@ static Uint32 SDLCALL SDL_CPUFeatureMaskFromHint(void)
                 spot_mask = CPU_HAS_AVX;
             } else if (ref_string_equals("avx2", spot, end)) {
                 spot_mask = CPU_HAS_AVX2;
+            } else if (ref_string_equals("fma", spot, end)) {
+                spot_mask = CPU_HAS_FMA;
+            } else if (ref_string_equals("pclmul", spot, end)) {
+                spot_mask = CPU_HAS_PCLMULQDQ;
             } else if (ref_string_equals("avx512f", spot, end)) {
                 spot_mask = CPU_HAS_AVX512F;
             } else if (ref_string_equals("arm-simd", spot, end)) {
                 spot_mask = CPU_HAS_ARM_SIMD;
             } else if (ref_string_equals("neon", spot, end)) {
                 spot_mask = CPU_HAS_NEON;
+            } else if (ref_string_equals("arm-crc32", spot, end)) {
+                spot_mask = CPU_HAS_ARM_CRC32;
             } else if (ref_string_equals("lsx", spot, end)) {
                 spot_mask = CPU_HAS_LSX;
             } else if (ref_string_equals("lasx", spot, end)) {
@@ -1021,6 +1375,12 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_AVX2;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 32);
         }
+        if (CPU_haveFMA()) {
+            SDL_CPUFeatures |= CPU_HAS_FMA;
+        }
+        if (CPU_havePCLMULQDQ()) {
+            SDL_CPUFeatures |= CPU_HAS_PCLMULQDQ;
+        }
         if (CPU_haveAVX512F()) {
             SDL_CPUFeatures |= CPU_HAS_AVX512F;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 64);
@@ -1033,6 +1393,9 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_NEON;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 16);
         }
+        if (CPU_haveARMCRC32()) {
+            SDL_CPUFeatures |= CPU_HAS_ARM_CRC32;
+        }
         if (CPU_haveLSX()) {
             SDL_CPUFeatures |= CPU_HAS_LSX;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 16);
@@ -1097,6 +1460,21 @@ bool SDL_HasAVX2(void)
     return CPU_FEATURE_AVAILABLE(CPU_HAS_AVX2);
 }
 
+bool SDL_HasFMA(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_FMA);
+}
+
+bool SDL_HasPCLMULQDQ(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_PCLMULQDQ);
+}
+
+bool SDL_HasARMCRC32(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_ARM_CRC32);
+}
+
 bool SDL_HasAVX512F(void)
 {
     return CPU_FEATURE_AVAILABLE(CPU_HAS_AVX512F);
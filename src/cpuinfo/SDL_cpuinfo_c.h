@@ -24,4 +24,16 @@
 
 extern void SDL_QuitCPUInfo(void);
 
+// FMA3 isn't implied by AVX2, so code using _mm_fmadd_ps and friends has to check for it separately.
+extern bool SDL_HasFMA(void);
+
+// Carry-less multiply and the ARMv8 CRC32 instructions, used by SDL_crc32()
+extern bool SDL_HasPCLMULQDQ(void);
+extern bool SDL_HasARMCRC32(void);
+
+#ifdef SDL_PLATFORM_WINDOWS
+// Fills `ids` (room for 64) with the CPU set IDs of the logical CPUs in `mask`, returns how many
+extern int SDL_GetWindowsCPUSetIDs(Uint64 mask, Uint32 *ids);
+#endif
+
 #endif // SDL_cpuinfo_c_h_
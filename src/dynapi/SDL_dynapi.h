@@ -34,6 +34,8 @@
    To be sure, as new system-level video and audio APIs are introduced, an
    updated SDL can transparently take advantage of them, but your program will
    not without this feature. Think hard before turning it off.
+   The one exception is SDL_DISABLE_DYNAMIC_API, which the build defines when
+   asked to, for static builds where LTO should inline across the API.
 */
 #ifdef SDL_DYNAMIC_API // Tried to force it on the command line?
 #error Nope, you have to edit this file to force this off.
@@ -43,7 +45,9 @@
 #include "TargetConditionals.h"
 #endif
 
-#if defined(SDL_PLATFORM_PRIVATE) // probably not useful on private platforms.
+#if defined(SDL_DISABLE_DYNAMIC_API) // static builds that want LTO to inline across the API, see README.md
+#define SDL_DYNAMIC_API 0
+#elif defined(SDL_PLATFORM_PRIVATE) // probably not useful on private platforms.
 #define SDL_DYNAMIC_API 0
 #elif defined(TARGET_OS_IPHONE) && TARGET_OS_IPHONE // probably not useful on iOS.
 #define SDL_DYNAMIC_API 0
@@ -1259,3 +1259,132 @@
 #define SDL_ClickTrayEntry SDL_ClickTrayEntry_REAL
 #define SDL_UpdateTrays SDL_UpdateTrays_REAL
 #define SDL_StretchSurface SDL_StretchSurface_REAL
+#define SDL_GetGPUPipelineCacheData SDL_GetGPUPipelineCacheData_REAL
+#define SDL_IOFromMappedFile SDL_IOFromMappedFile_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_RenderTextureInstances SDL_RenderTextureInstances_REAL
+#define SDL_CreateTextureAtlas SDL_CreateTextureAtlas_REAL
+#define SDL_CreateAtlasTexture SDL_CreateAtlasTexture_REAL
+#define SDL_DestroyTextureAtlas SDL_DestroyTextureAtlas_REAL
+#define SDL_RenderReadPixelsAsync SDL_RenderReadPixelsAsync_REAL
+#define SDL_IsRenderReadbackComplete SDL_IsRenderReadbackComplete_REAL
+#define SDL_FinishRenderReadback SDL_FinishRenderReadback_REAL
+#define SDL_CancelRenderReadback SDL_CancelRenderReadback_REAL
+#define SDL_SetRenderDamageRects SDL_SetRenderDamageRects_REAL
+#define SDL_CreateGPUQueryPool SDL_CreateGPUQueryPool_REAL
+#define SDL_WriteGPUTimestamp SDL_WriteGPUTimestamp_REAL
+#define SDL_BeginGPUQuery SDL_BeginGPUQuery_REAL
+#define SDL_EndGPUQuery SDL_EndGPUQuery_REAL
+#define SDL_GetGPUQueryResults SDL_GetGPUQueryResults_REAL
+#define SDL_ReleaseGPUQueryPool SDL_ReleaseGPUQueryPool_REAL
+#define SDL_AcquireGPUCommandBufferForQueue SDL_AcquireGPUCommandBufferForQueue_REAL
+#define SDL_GPUSupportsDedicatedQueue SDL_GPUSupportsDedicatedQueue_REAL
+#define SDL_AddGPUCommandBufferWaitFence SDL_AddGPUCommandBufferWaitFence_REAL
+#define SDL_AcquireGPUTransientBuffer SDL_AcquireGPUTransientBuffer_REAL
+#define SDL_AcquireGPUTransientTransferBuffer SDL_AcquireGPUTransientTransferBuffer_REAL
+#define SDL_CreateGPUGraphicsPipelineAsync SDL_CreateGPUGraphicsPipelineAsync_REAL
+#define SDL_CreateGPUComputePipelineAsync SDL_CreateGPUComputePipelineAsync_REAL
+#define SDL_WaitForGPUPipelines SDL_WaitForGPUPipelines_REAL
+#define SDL_GetGPUMemoryHeapStats SDL_GetGPUMemoryHeapStats_REAL
+#define SDL_GPUSupportsIndirectCount SDL_GPUSupportsIndirectCount_REAL
+#define SDL_DrawGPUPrimitivesIndirectCount SDL_DrawGPUPrimitivesIndirectCount_REAL
+#define SDL_DrawGPUIndexedPrimitivesIndirectCount SDL_DrawGPUIndexedPrimitivesIndirectCount_REAL
+#define SDL_DrawGPUMeshTasks SDL_DrawGPUMeshTasks_REAL
+#define SDL_DrawGPUMeshTasksIndirect SDL_DrawGPUMeshTasksIndirect_REAL
+#define SDL_GPUTextureSupportsSparse SDL_GPUTextureSupportsSparse_REAL
+#define SDL_GetGPUSparseTextureInfo SDL_GetGPUSparseTextureInfo_REAL
+#define SDL_CommitGPUTextureTiles SDL_CommitGPUTextureTiles_REAL
+#define SDL_GetSurfacePoolStats SDL_GetSurfacePoolStats_REAL
+#define SDL_SetAudioStreamMixMatrix SDL_SetAudioStreamMixMatrix_REAL
+#define SDL_PutAudioStreamDataNoCopy SDL_PutAudioStreamDataNoCopy_REAL
+#define SDL_CreateWAVAudioStream_IO SDL_CreateWAVAudioStream_IO_REAL
+#define SDL_CreateWAVAudioStream SDL_CreateWAVAudioStream_REAL
+#define SDL_SeekWAVAudioStream SDL_SeekWAVAudioStream_REAL
+#define SDL_SetAudioStreamLockFreeBuffer SDL_SetAudioStreamLockFreeBuffer_REAL
+#define SDL_GetAudioDeviceStats SDL_GetAudioDeviceStats_REAL
+#define SDL_SetAudioRecordingCallback SDL_SetAudioRecordingCallback_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_AddEventWatchRange SDL_AddEventWatchRange_REAL
+#define SDL_GetEventLatencyStats SDL_GetEventLatencyStats_REAL
+#define SDL_ResetEventLatencyStats SDL_ResetEventLatencyStats_REAL
+#define SDL_GetEventQueueStats SDL_GetEventQueueStats_REAL
+#define SDL_GetMemoryTag SDL_GetMemoryTag_REAL
+#define SDL_GetMemoryTagName SDL_GetMemoryTagName_REAL
+#define SDL_memchr SDL_memchr_REAL
+#define SDL_qsort_by_key SDL_qsort_by_key_REAL
+#define SDL_CreateFramePacer SDL_CreateFramePacer_REAL
+#define SDL_SetFramePacerPeriod SDL_SetFramePacerPeriod_REAL
+#define SDL_WaitFramePacer SDL_WaitFramePacer_REAL
+#define SDL_ResetFramePacer SDL_ResetFramePacer_REAL
+#define SDL_GetFramePacerStats SDL_GetFramePacerStats_REAL
+#define SDL_DestroyFramePacer SDL_DestroyFramePacer_REAL
+#define SDL_CreateNamedMutex SDL_CreateNamedMutex_REAL
+#define SDL_GetMutexContentionStats SDL_GetMutexContentionStats_REAL
+#define SDL_CreateAtomicQueue SDL_CreateAtomicQueue_REAL
+#define SDL_PushAtomicQueue SDL_PushAtomicQueue_REAL
+#define SDL_PopAtomicQueue SDL_PopAtomicQueue_REAL
+#define SDL_DestroyAtomicQueue SDL_DestroyAtomicQueue_REAL
+#define SDL_GetNumCPUCoresOfType SDL_GetNumCPUCoresOfType_REAL
+#define SDL_GetCPUCoreMask SDL_GetCPUCoreMask_REAL
+#define SDL_SetCurrentThreadAffinity SDL_SetCurrentThreadAffinity_REAL
+#define SDL_SetCurrentThreadCoreType SDL_SetCurrentThreadCoreType_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_ParallelSort SDL_ParallelSort_REAL
+#define SDL_AddTimerWithProperties SDL_AddTimerWithProperties_REAL
+#define SDL_GetTimerStats SDL_GetTimerStats_REAL
+#define SDL_ReadAsyncIOSegments SDL_ReadAsyncIOSegments_REAL
+#define SDL_WriteAsyncIOSegments SDL_WriteAsyncIOSegments_REAL
+#define SDL_SubmitAsyncIOBatch SDL_SubmitAsyncIOBatch_REAL
+#define SDL_AsyncIOFromFileWithProperties SDL_AsyncIOFromFileWithProperties_REAL
+#define SDL_GetAsyncIOAlignment SDL_GetAsyncIOAlignment_REAL
+#define SDL_AdviseAsyncIO SDL_AdviseAsyncIO_REAL
+#define SDL_EnumerateDirectoryRecursive SDL_EnumerateDirectoryRecursive_REAL
+#define SDL_ReadStorageFileAsync SDL_ReadStorageFileAsync_REAL
+#define SDL_WriteStorageFileAsync SDL_WriteStorageFileAsync_REAL
+#define SDL_OpenArchiveStorage SDL_OpenArchiveStorage_REAL
+#define SDL_OpenStorageFile SDL_OpenStorageFile_REAL
+#define SDL_IOFromLZ4 SDL_IOFromLZ4_REAL
+#define SDL_DetachDynamicMemIO SDL_DetachDynamicMemIO_REAL
+#define SDL_WaitProcesses SDL_WaitProcesses_REAL
+#define SDL_LoadFileAsyncWithProperties SDL_LoadFileAsyncWithProperties_REAL
+#define SDL_GetGamepadSensorSamples SDL_GetGamepadSensorSamples_REAL
+#define SDL_GetSensorSamples SDL_GetSensorSamples_REAL
+#define SDL_SetOffscreenFrameCallback SDL_SetOffscreenFrameCallback_REAL
+#define SDL_GetWindowPresentationFeedback SDL_GetWindowPresentationFeedback_REAL
+#define SDL_SetTraceCallback SDL_SetTraceCallback_REAL
+#define SDL_StartTraceCapture SDL_StartTraceCapture_REAL
+#define SDL_StopTraceCapture SDL_StopTraceCapture_REAL
+#define SDL_BeginTraceZone SDL_BeginTraceZone_REAL
+#define SDL_EndTraceZone SDL_EndTraceZone_REAL
+#define SDL_SetTraceCounter SDL_SetTraceCounter_REAL
+#define SDL_SetTraceThreadName SDL_SetTraceThreadName_REAL
+#define SDL_GetGPUDeviceStats SDL_GetGPUDeviceStats_REAL
+#define SDL_GetSubSystemInitTimeNS SDL_GetSubSystemInitTimeNS_REAL
+#define SDL_GetMemoryUsage SDL_GetMemoryUsage_REAL
+#define SDL_GetMemoryUsageForOwner SDL_GetMemoryUsageForOwner_REAL
+#define SDL_CompressGPUTextureData SDL_CompressGPUTextureData_REAL
+#define SDL_BlitGPUTextures SDL_BlitGPUTextures_REAL
+#define SDL_GetIntersectingRects SDL_GetIntersectingRects_REAL
+#define SDL_GetIntersectingRectsFloat SDL_GetIntersectingRectsFloat_REAL
+#define SDL_OpenClipboardDataIO SDL_OpenClipboardDataIO_REAL
+#define SDL_CreateRenderCommandList SDL_CreateRenderCommandList_REAL
+#define SDL_RecordRenderTexture SDL_RecordRenderTexture_REAL
+#define SDL_RecordRenderTextureInstances SDL_RecordRenderTextureInstances_REAL
+#define SDL_RecordRenderGeometry SDL_RecordRenderGeometry_REAL
+#define SDL_SubmitRenderCommandList SDL_SubmitRenderCommandList_REAL
+#define SDL_ResetRenderCommandList SDL_ResetRenderCommandList_REAL
+#define SDL_DestroyRenderCommandList SDL_DestroyRenderCommandList_REAL
+#define SDL_CreatePropertiesSnapshot SDL_CreatePropertiesSnapshot_REAL
+#define SDL_SetProperties SDL_SetProperties_REAL
+#define SDL_SetJoystickVirtualState SDL_SetJoystickVirtualState_REAL
+#define SDL_LoadBMPWithProperties SDL_LoadBMPWithProperties_REAL
+#define SDL_Prepare9Grid SDL_Prepare9Grid_REAL
+#define SDL_BlitPrepared9Grid SDL_BlitPrepared9Grid_REAL
+#define SDL_DestroyPrepared9Grid SDL_DestroyPrepared9Grid_REAL
+#define SDL_UploadSurfaceToGPUTexture SDL_UploadSurfaceToGPUTexture_REAL
+#define SDL_rand_fill SDL_rand_fill_REAL
+#define SDL_rand_fill_float SDL_rand_fill_float_REAL
+#define SDL_rand_fill_bits SDL_rand_fill_bits_REAL
+#define SDL_rand_fill_r SDL_rand_fill_r_REAL
+#define SDL_rand_fill_float_r SDL_rand_fill_float_r_REAL
+#define SDL_rand_fill_bits_r SDL_rand_fill_bits_r_REAL
@@ -1267,3 +1267,132 @@ SDL_DYNAPI_PROC(bool,SDL_AudioStreamDevicePaused,(SDL_AudioStream *a),(a),return
 SDL_DYNAPI_PROC(void,SDL_ClickTrayEntry,(SDL_TrayEntry *a),(a),)
 SDL_DYNAPI_PROC(void,SDL_UpdateTrays,(void),(),)
 SDL_DYNAPI_PROC(bool,SDL_StretchSurface,(SDL_Surface *a,const SDL_Rect *b,SDL_Surface *c,const SDL_Rect *d,SDL_ScaleMode e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void*,SDL_GetGPUPipelineCacheData,(SDL_GPUDevice *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromMappedFile,(const char*a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SubmitJob,(SDL_JobFunction a, void*b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_RenderTextureInstances,(SDL_Renderer *a, SDL_Texture *b, const SDL_TextureInstance *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_TextureAtlas*,SDL_CreateTextureAtlas,(SDL_Renderer *a, SDL_PixelFormat b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_Texture*,SDL_CreateAtlasTexture,(SDL_TextureAtlas *a, int b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyTextureAtlas,(SDL_TextureAtlas *a),(a),)
+SDL_DYNAPI_PROC(SDL_RenderReadback*,SDL_RenderReadPixelsAsync,(SDL_Renderer *a, const SDL_Rect *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_IsRenderReadbackComplete,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_FinishRenderReadback,(SDL_RenderReadback *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_CancelRenderReadback,(SDL_RenderReadback *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_SetRenderDamageRects,(SDL_Renderer *a, const SDL_Rect *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_GPUQueryPool*,SDL_CreateGPUQueryPool,(SDL_GPUDevice *a, SDL_GPUQueryType b, Uint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_WriteGPUTimestamp,(SDL_GPUCommandBuffer *a, SDL_GPUQueryPool *b, Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_BeginGPUQuery,(SDL_GPUCommandBuffer *a, SDL_GPUQueryPool *b, Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(void,SDL_EndGPUQuery,(SDL_GPUCommandBuffer *a, SDL_GPUQueryPool *b, Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(bool,SDL_GetGPUQueryResults,(SDL_GPUDevice *a, SDL_GPUQueryPool *b, Uint32 c, Uint32 d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_ReleaseGPUQueryPool,(SDL_GPUDevice *a, SDL_GPUQueryPool *b),(a,b),)
+SDL_DYNAPI_PROC(SDL_GPUCommandBuffer*,SDL_AcquireGPUCommandBufferForQueue,(SDL_GPUDevice *a, SDL_GPUQueueType b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GPUSupportsDedicatedQueue,(SDL_GPUDevice *a, SDL_GPUQueueType b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_AddGPUCommandBufferWaitFence,(SDL_GPUCommandBuffer *a, SDL_GPUFence *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_AcquireGPUTransientBuffer,(SDL_GPUCommandBuffer *a, SDL_GPUBufferUsageFlags b, Uint32 c, SDL_GPUBufferRegion *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void*,SDL_AcquireGPUTransientTransferBuffer,(SDL_GPUCommandBuffer *a, Uint32 b, SDL_GPUTransferBufferLocation *c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_CreateGPUGraphicsPipelineAsync,(SDL_GPUDevice *a, const SDL_GPUGraphicsPipelineCreateInfo *b, SDL_GPUGraphicsPipelineCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_CreateGPUComputePipelineAsync,(SDL_GPUDevice *a, const SDL_GPUComputePipelineCreateInfo *b, SDL_GPUComputePipelineCallback c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void,SDL_WaitForGPUPipelines,(SDL_GPUDevice *a),(a),)
+SDL_DYNAPI_PROC(SDL_GPUMemoryHeapStats*,SDL_GetGPUMemoryHeapStats,(SDL_GPUDevice *a, int *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GPUSupportsIndirectCount,(SDL_GPUDevice *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DrawGPUPrimitivesIndirectCount,(SDL_GPURenderPass *a, SDL_GPUBuffer *b, Uint32 c, SDL_GPUBuffer *d, Uint32 e, Uint32 f),(a,b,c,d,e,f),)
+SDL_DYNAPI_PROC(void,SDL_DrawGPUIndexedPrimitivesIndirectCount,(SDL_GPURenderPass *a, SDL_GPUBuffer *b, Uint32 c, SDL_GPUBuffer *d, Uint32 e, Uint32 f),(a,b,c,d,e,f),)
+SDL_DYNAPI_PROC(void,SDL_DrawGPUMeshTasks,(SDL_GPURenderPass *a, Uint32 b, Uint32 c, Uint32 d),(a,b,c,d),)
+SDL_DYNAPI_PROC(void,SDL_DrawGPUMeshTasksIndirect,(SDL_GPURenderPass *a, SDL_GPUBuffer *b, Uint32 c, Uint32 d),(a,b,c,d),)
+SDL_DYNAPI_PROC(bool,SDL_GPUTextureSupportsSparse,(SDL_GPUDevice *a, SDL_GPUTextureFormat b, SDL_GPUTextureType c, SDL_GPUTextureUsageFlags d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_GetGPUSparseTextureInfo,(SDL_GPUDevice *a, SDL_GPUTexture *b, Uint32 *c, Uint32 *d, Uint32 *e, Uint32 *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(bool,SDL_CommitGPUTextureTiles,(SDL_GPUDevice *a, const SDL_GPUTextureRegion *b, bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_GetSurfacePoolStats,(SDL_SurfacePoolStats *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetAudioStreamMixMatrix,(SDL_AudioStream *a, const float *b, int c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamDataNoCopy,(SDL_AudioStream *a, const void *b, int c, SDL_AudioStreamDataCompleteCallback d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_CreateWAVAudioStream_IO,(SDL_IOStream *a, bool b, SDL_AudioSpec *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_AudioStream*,SDL_CreateWAVAudioStream,(const char *a, SDL_AudioSpec *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SeekWAVAudioStream,(SDL_AudioStream *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetAudioStreamLockFreeBuffer,(SDL_AudioStream *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetAudioDeviceStats,(SDL_AudioDeviceID a, SDL_AudioDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetAudioRecordingCallback,(SDL_AudioDeviceID a, SDL_AudioRecordingCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_AddEventWatchRange,(Uint32 a, Uint32 b, SDL_EventFilter c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_GetEventLatencyStats,(Uint32 a, SDL_EventLatencyStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetEventLatencyStats,(void),(),)
+SDL_DYNAPI_PROC(bool,SDL_GetEventQueueStats,(SDL_EventQueueStats *a),(a),return)
+SDL_DYNAPI_PROC(SDL_MemoryTag,SDL_GetMemoryTag,(void),(),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetMemoryTagName,(SDL_MemoryTag a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_memchr,(const void *a, int b, size_t c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_qsort_by_key,(void *a, size_t b, size_t c, size_t d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_FramePacer*,SDL_CreateFramePacer,(Uint64 a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetFramePacerPeriod,(SDL_FramePacer *a, Uint64 b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_WaitFramePacer,(SDL_FramePacer *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_ResetFramePacer,(SDL_FramePacer *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetFramePacerStats,(SDL_FramePacer *a, SDL_FramePacerStats *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyFramePacer,(SDL_FramePacer *a),(a),)
+SDL_DYNAPI_PROC(SDL_Mutex*,SDL_CreateNamedMutex,(const char *a, SDL_MutexFlags b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetMutexContentionStats,(const char *a, SDL_MutexContentionStats *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_AtomicQueue*,SDL_CreateAtomicQueue,(int a, size_t b, SDL_AtomicQueueFlags c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_PushAtomicQueue,(SDL_AtomicQueue *a, const void *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_PopAtomicQueue,(SDL_AtomicQueue *a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyAtomicQueue,(SDL_AtomicQueue *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_GetNumCPUCoresOfType,(SDL_CPUCoreType a),(a),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetCPUCoreMask,(SDL_CPUCoreType a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetCurrentThreadAffinity,(Uint64 a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetCurrentThreadCoreType,(SDL_CPUCoreType a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_ParallelFor,(int a, int b, int c, SDL_ParallelForCallback d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_ParallelSort,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),)
+SDL_DYNAPI_PROC(SDL_TimerID,SDL_AddTimerWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTimerStats,(SDL_TimerID a, SDL_TimerStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadAsyncIOSegments,(SDL_AsyncIO *a, const SDL_AsyncIOSegment *b, int c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(bool,SDL_WriteAsyncIOSegments,(SDL_AsyncIO *a, const SDL_AsyncIOSegment *b, int c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(bool,SDL_SubmitAsyncIOBatch,(SDL_AsyncIORequest *a, int b, SDL_AsyncIOQueue *c, void *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_AsyncIO*,SDL_AsyncIOFromFileWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(size_t,SDL_GetAsyncIOAlignment,(SDL_AsyncIO *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_AdviseAsyncIO,(SDL_AsyncIO *a, Uint64 b, Uint64 c, SDL_AsyncIOAdvice d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_EnumerateDirectoryRecursive,(const char *a, SDL_EnumerateDirectoryCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_ReadStorageFileAsync,(SDL_Storage *a, const char *b, void *c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(bool,SDL_WriteStorageFileAsync,(SDL_Storage *a, const char *b, const void *c, Uint64 d, SDL_AsyncIOQueue *e, void *f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(SDL_Storage*,SDL_OpenArchiveStorage,(SDL_IOStream *a, bool b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_OpenStorageFile,(SDL_Storage *a, const char *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromLZ4,(SDL_IOStream *a, bool b),(a,b),return)
+SDL_DYNAPI_PROC(void*,SDL_DetachDynamicMemIO,(SDL_IOStream *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_WaitProcesses,(SDL_ProcessWait *a, int b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_LoadFileAsyncWithProperties,(SDL_PropertiesID a, SDL_AsyncIOQueue *b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_GetGamepadSensorSamples,(SDL_Gamepad *a, SDL_SensorType b, float *c, int d, Uint64 *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(int,SDL_GetSensorSamples,(SDL_Sensor *a, float *b, int c, Uint64 *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_SetOffscreenFrameCallback,(SDL_Window *a, SDL_OffscreenFrameCallback b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_GetWindowPresentationFeedback,(SDL_Window *a, SDL_PresentationFeedback *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_SetTraceCallback,(SDL_TraceCallback a, void *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_StartTraceCapture,(int a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_StopTraceCapture,(const char *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_BeginTraceZone,(const char *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_EndTraceZone,(const char *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_SetTraceCounter,(const char *a, double b),(a,b),)
+SDL_DYNAPI_PROC(void,SDL_SetTraceThreadName,(const char *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_GetGPUDeviceStats,(SDL_GPUDevice *a, SDL_GPUDeviceStats *b),(a,b),return)
+SDL_DYNAPI_PROC(Uint64,SDL_GetSubSystemInitTimeNS,(SDL_InitFlags a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetMemoryUsage,(SDL_MemoryObjectType a, SDL_MemoryUsage *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetMemoryUsageForOwner,(const char *a, SDL_MemoryUsage *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_CompressGPUTextureData,(SDL_GPUTextureFormat a, Uint32 b, Uint32 c, const void *d, int e, void *f, size_t g),(a,b,c,d,e,f,g),return)
+SDL_DYNAPI_PROC(void,SDL_BlitGPUTextures,(SDL_GPUCommandBuffer *a, const SDL_GPUBlitInfo *b, Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(int,SDL_GetIntersectingRects,(const SDL_Rect *a, int b, const SDL_Rect *c, int *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_GetIntersectingRectsFloat,(const SDL_FRect *a, int b, const SDL_FRect *c, int *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_OpenClipboardDataIO,(const char *a),(a),return)
+SDL_DYNAPI_PROC(SDL_RenderCommandList*,SDL_CreateRenderCommandList,(SDL_Renderer *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_RecordRenderTexture,(SDL_RenderCommandList *a, SDL_Texture *b, const SDL_FRect *c, const SDL_FRect *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_RecordRenderTextureInstances,(SDL_RenderCommandList *a, SDL_Texture *b, const SDL_TextureInstance *c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_RecordRenderGeometry,(SDL_RenderCommandList *a, SDL_Texture *b, const SDL_Vertex *c, int d, const int *e, int f),(a,b,c,d,e,f),return)
+SDL_DYNAPI_PROC(bool,SDL_SubmitRenderCommandList,(SDL_Renderer *a, SDL_RenderCommandList *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_ResetRenderCommandList,(SDL_RenderCommandList *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DestroyRenderCommandList,(SDL_RenderCommandList *a),(a),)
+SDL_DYNAPI_PROC(SDL_PropertiesID,SDL_CreatePropertiesSnapshot,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_SetProperties,(SDL_PropertiesID a, const SDL_PropertyValue *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_SetJoystickVirtualState,(SDL_Joystick *a, const SDL_VirtualJoystickState *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_Surface*,SDL_LoadBMPWithProperties,(SDL_IOStream *a,bool b,SDL_PropertiesID c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_Prepared9Grid*,SDL_Prepare9Grid,(SDL_Surface *a, const SDL_Rect *b, int c, int d, int e, int f, float g, SDL_ScaleMode h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(bool,SDL_BlitPrepared9Grid,(SDL_Prepared9Grid *a, SDL_Surface *b, const SDL_Rect *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyPrepared9Grid,(SDL_Prepared9Grid *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_UploadSurfaceToGPUTexture,(SDL_GPUCommandBuffer *a, SDL_Surface *b, const SDL_GPUTextureRegion *c, SDL_PropertiesID d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill,(Sint32 *a, int b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill_float,(float *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill_bits,(Uint32 *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill_r,(Uint64 *a, Sint32 *b, int c, Sint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill_float_r,(Uint64 *a, float *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_rand_fill_bits_r,(Uint64 *a, Uint32 *b, int c),(a,b,c),return)
@@ -26,6 +26,15 @@
 #include "SDL_categories_c.h"
 
 SDL_EventCategory SDL_GetEventCategory(Uint32 type)
+{
+    const SDL_EventCategory category = SDL_GetEventCategoryNoError(type);
+    if (category == SDL_EVENTCATEGORY_UNKNOWN) {
+        SDL_SetError("Unknown event type");
+    }
+    return category;
+}
+
+SDL_EventCategory SDL_GetEventCategoryNoError(Uint32 type)
 {
     if (type >= SDL_EVENT_USER && type <= SDL_EVENT_LAST) {
         return SDL_EVENTCATEGORY_USER;
@@ -38,7 +47,6 @@ SDL_EventCategory SDL_GetEventCategory(Uint32 type)
     }
     switch (type) {
     default:
-        SDL_SetError("Unknown event type");
         return SDL_EVENTCATEGORY_UNKNOWN;
 
     case SDL_EVENT_KEYMAP_CHANGED:
@@ -140,6 +148,9 @@ SDL_EventCategory SDL_GetEventCategory(Uint32 type)
     case SDL_EVENT_FINGER_MOTION:
         return SDL_EVENTCATEGORY_TFINGER;
 
+    case SDL_EVENT_FINGER_FRAME:
+        return SDL_EVENTCATEGORY_TFRAME;
+
     case SDL_EVENT_CLIPBOARD_UPDATE:
         return SDL_EVENTCATEGORY_CLIPBOARD;
 
@@ -176,6 +187,9 @@ SDL_EventCategory SDL_GetEventCategory(Uint32 type)
     case SDL_EVENT_PEN_AXIS:
         return SDL_EVENTCATEGORY_PAXIS;
 
+    case SDL_EVENT_PEN_FRAME:
+        return SDL_EVENTCATEGORY_PFRAME;
+
     case SDL_EVENT_CAMERA_DEVICE_ADDED:
     case SDL_EVENT_CAMERA_DEVICE_REMOVED:
     case SDL_EVENT_CAMERA_DEVICE_APPROVED:
@@ -219,6 +233,9 @@ SDL_Window *SDL_GetWindowFromEvent(const SDL_Event *event)
     case SDL_EVENTCATEGORY_TFINGER:
         windowID = event->tfinger.windowID;
         break;
+    case SDL_EVENTCATEGORY_TFRAME:
+        windowID = event->tframe.windowID;
+        break;
     case SDL_EVENTCATEGORY_PPROXIMITY:
         windowID = event->pproximity.windowID;
         break;
@@ -234,6 +251,9 @@ SDL_Window *SDL_GetWindowFromEvent(const SDL_Event *event)
     case SDL_EVENTCATEGORY_PAXIS:
         windowID = event->paxis.windowID;
         break;
+    case SDL_EVENTCATEGORY_PFRAME:
+        windowID = event->pframe.windowID;
+        break;
     case SDL_EVENTCATEGORY_DROP:
         windowID = event->drop.windowID;
         break;
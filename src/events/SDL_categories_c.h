@@ -55,16 +55,19 @@ typedef enum SDL_EventCategory
     SDL_EVENTCATEGORY_QUIT,
     SDL_EVENTCATEGORY_USER,
     SDL_EVENTCATEGORY_TFINGER,
+    SDL_EVENTCATEGORY_TFRAME,
     SDL_EVENTCATEGORY_PPROXIMITY,
     SDL_EVENTCATEGORY_PTOUCH,
     SDL_EVENTCATEGORY_PMOTION,
     SDL_EVENTCATEGORY_PBUTTON,
     SDL_EVENTCATEGORY_PAXIS,
+    SDL_EVENTCATEGORY_PFRAME,
     SDL_EVENTCATEGORY_DROP,
     SDL_EVENTCATEGORY_CLIPBOARD,
     SDL_EVENTCATEGORY_RENDER,
 } SDL_EventCategory;
 
 extern SDL_EventCategory SDL_GetEventCategory(Uint32 type);
+extern SDL_EventCategory SDL_GetEventCategoryNoError(Uint32 type);
 
 #endif // SDL_categories_c_h_
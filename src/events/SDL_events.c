@@ -23,9 +23,11 @@
 // General event handling code for SDL
 
 #include "SDL_events_c.h"
+#include "SDL_categories_c.h"
 #include "SDL_eventwatch_c.h"
 #include "SDL_windowevents_c.h"
 #include "../SDL_hints_c.h"
+#include "../SDL_trace_c.h"
 #include "../audio/SDL_audio_c.h"
 #include "../camera/SDL_camera_c.h"
 #include "../timer/SDL_timer_c.h"
@@ -35,6 +37,7 @@
 #ifndef SDL_SENSOR_DISABLED
 #include "../sensor/SDL_sensor_c.h"
 #endif
+#include "../stdlib/SDL_sysstdlib.h"
 #include "../video/SDL_sysvideo.h"
 
 #ifdef SDL_PLATFORM_ANDROID
@@ -51,6 +54,9 @@
 // Determines how often to pump events if joysticks or sensors are actively being read
 #define EVENT_POLL_INTERVAL_NS SDL_MS_TO_NS(1)
 
+// The longest we'll go between pumps while open joysticks and sensors are idle
+#define IDLE_POLL_INTERVAL_NS SDL_MS_TO_NS(50)
+
 // Make sure the type in the SDL_Event aligns properly across the union
 SDL_COMPILE_TIME_ASSERT(SDL_Event_type, sizeof(Uint32) == sizeof(SDL_EventType));
 
@@ -131,6 +137,10 @@ typedef struct SDL_EventEntry
 {
     SDL_Event event;
     SDL_TemporaryMemory *memory;
+    Uint64 queued_ns; // when the event was queued, if latency statistics are being collected
+    SDL_MotionSample *history; // samples merged into a coalesced motion event, owned through `memory`
+    int num_history;
+    int history_capacity;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
 } SDL_EventEntry;
@@ -144,14 +154,67 @@ static struct
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
+    struct SDL_EventSlab *slabs;
+    int num_slabs;
+    Uint64 slab_allocations;
+    Uint64 slab_releases;
+} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL, NULL, 0, 0, 0 };
+
+/* Event entries are carved out of slabs instead of being allocated one at a
+   time, so bursts of events don't hit malloc for every event and the list
+   stays in a few contiguous blocks. Each entry starts on its own cache line.
+   Once the queue empties, slabs beyond the reserve are given back.
+ */
+#define SDL_EVENT_SLAB_ENTRIES      64
+#define SDL_EVENT_SLAB_RESERVE      4
+#define SDL_EVENT_ENTRY_ALIGNMENT   64
+#define SDL_EVENT_ENTRY_STRIDE      ((sizeof(SDL_EventEntry) + SDL_EVENT_ENTRY_ALIGNMENT - 1) & ~(SDL_EVENT_ENTRY_ALIGNMENT - 1))
+
+typedef struct SDL_EventSlab
+{
+    struct SDL_EventSlab *next;
+    Uint8 padding[SDL_EVENT_ENTRY_ALIGNMENT - sizeof(struct SDL_EventSlab *)];
+    Uint8 entries[SDL_EVENT_SLAB_ENTRIES * SDL_EVENT_ENTRY_STRIDE];
+} SDL_EventSlab;
+
+/* Producers push events into this bounded ring without taking SDL_EventQ.lock.
+   Whoever holds the lock drains it onto the list above before looking at the
+   list, so the list stays the single place where filtering and peeking happen.
+   This is a bounded MPMC queue in the style of Dmitry Vyukov's, with the
+   event queue lock guaranteeing there is only ever one consumer.
+ */
+#define SDL_EVENT_RING_SIZE 512 // must be a power of two
 
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicU32 sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingSlot;
+
+static struct
+{
+    bool initialized;
+    SDL_AtomicU32 enqueue_pos;
+    Uint32 dequeue_pos; // only used with SDL_EventQ.lock held
+    SDL_EventRingSlot slots[SDL_EVENT_RING_SIZE];
+} SDL_EventRing;
+
+static void SDL_DrainEventRing(void);
+
+
+#ifdef SDL_THREAD_LOCAL
+// Looked up for every event with strings attached, so cache it natively where we can
+static SDL_THREAD_LOCAL SDL_TemporaryMemoryState *SDL_temporary_memory_state;
+#endif
 
 static void SDL_CleanupTemporaryMemory(void *data)
 {
     SDL_TemporaryMemoryState *state = (SDL_TemporaryMemoryState *)data;
 
     SDL_FreeTemporaryMemory();
+#ifdef SDL_THREAD_LOCAL
+    SDL_temporary_memory_state = NULL;
+#endif
     SDL_free(state);
 }
 
@@ -159,6 +222,12 @@ static SDL_TemporaryMemoryState *SDL_GetTemporaryMemoryState(bool create)
 {
     SDL_TemporaryMemoryState *state;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_temporary_memory_state) {
+        return SDL_temporary_memory_state;
+    }
+#endif
+
     state = (SDL_TemporaryMemoryState *)SDL_GetTLS(&SDL_temporary_memory);
     if (!state) {
         if (!create) {
@@ -175,6 +244,9 @@ static SDL_TemporaryMemoryState *SDL_GetTemporaryMemoryState(bool create)
             return NULL;
         }
     }
+#ifdef SDL_THREAD_LOCAL
+    SDL_temporary_memory_state = state;
+#endif
     return state;
 }
 
@@ -285,6 +357,9 @@ static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
     case SDL_EVENT_CLIPBOARD_UPDATE:
         SDL_LinkTemporaryMemoryToEvent(event, event->event.clipboard.mime_types);
         break;
+    case SDL_EVENT_FINGER_FRAME:
+        SDL_LinkTemporaryMemoryToEvent(event, event->event.tframe.fingers);
+        break;
     case SDL2_SYSWMEVENT:
         // We need to copy the stack pointer into temporary memory
         SDL_TransferSysWMMemoryToEvent(event);
@@ -412,6 +487,24 @@ static void SDLCALL SDL_AutoUpdateSensorsChanged(void *userdata, const char *nam
 
 #endif // !SDL_SENSOR_DISABLED
 
+static bool SDL_CoalesceMotion = false;
+
+#define SDL_EVENT_LATENCY_CATEGORIES    (SDL_EVENTCATEGORY_RENDER + 1)
+#define SDL_EVENT_LATENCY_FIRST_BUCKET_NS SDL_US_TO_NS(125)
+
+static bool SDL_EventLatencyTracking = false;
+static SDL_EventLatencyStats SDL_event_latency[SDL_EVENT_LATENCY_CATEGORIES]; // protected by SDL_EventQ.lock
+
+static void SDLCALL SDL_EventLatencyStatsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_EventLatencyTracking = SDL_GetStringBoolean(hint, false);
+}
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_CoalesceMotion = SDL_GetStringBoolean(hint, false);
+}
+
 static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, true));
@@ -442,6 +535,8 @@ static void SDL_LogEvent(const SDL_Event *event)
     if ((SDL_EventLoggingVerbosity < 2) &&
         ((event->type == SDL_EVENT_MOUSE_MOTION) ||
          (event->type == SDL_EVENT_FINGER_MOTION) ||
+         (event->type == SDL_EVENT_FINGER_FRAME) ||
+         (event->type == SDL_EVENT_PEN_FRAME) ||
          (event->type == SDL_EVENT_PEN_AXIS) ||
          (event->type == SDL_EVENT_PEN_MOTION) ||
          (event->type == SDL_EVENT_GAMEPAD_TOUCHPAD_MOTION) ||
@@ -765,6 +860,11 @@ static void SDL_LogEvent(const SDL_Event *event)
         break;
 #undef PRINT_FINGER_EVENT
 
+        SDL_EVENT_CASE(SDL_EVENT_FINGER_FRAME)
+        (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u touchid=%" SDL_PRIu64 " windowid=%u num_fingers=%d)",
+                           (uint)event->tframe.timestamp, event->tframe.touchID, (uint)event->tframe.windowID, event->tframe.num_fingers);
+        break;
+
 #define PRINT_PTOUCH_EVENT(event)                                                                             \
     (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u windowid=%u which=%u pen_state=%u x=%g y=%g eraser=%s state=%s)", \
                        (uint)event->ptouch.timestamp, (uint)event->ptouch.windowID, (uint)event->ptouch.which, (uint)event->ptouch.pen_state, event->ptouch.x, event->ptouch.y, \
@@ -794,6 +894,12 @@ static void SDL_LogEvent(const SDL_Event *event)
                            ((((int) event->paxis.axis) >= 0) && (event->paxis.axis < SDL_arraysize(pen_axisnames))) ? pen_axisnames[event->paxis.axis] : "[UNKNOWN]", event->paxis.value);
         break;
 
+        SDL_EVENT_CASE(SDL_EVENT_PEN_FRAME)
+        (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u windowid=%u which=%u pen_state=%u x=%g y=%g pressure=%g)",
+                           (uint)event->pframe.timestamp, (uint)event->pframe.windowID, (uint)event->pframe.which, (uint)event->pframe.pen_state, event->pframe.x, event->pframe.y,
+                           event->pframe.axes[SDL_PEN_AXIS_PRESSURE]);
+        break;
+
         SDL_EVENT_CASE(SDL_EVENT_PEN_MOTION)
         (void)SDL_snprintf(details, sizeof(details), " (timestamp=%u windowid=%u which=%u pen_state=%u x=%g y=%g)",
                            (uint)event->pmotion.timestamp, (uint)event->pmotion.windowID, (uint)event->pmotion.which, (uint)event->pmotion.pen_state, event->pmotion.x, event->pmotion.y);
@@ -898,22 +1004,21 @@ void SDL_StopEventLoop(void)
 
     SDL_EventQ.active = false;
 
+    SDL_DrainEventRing();
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d",
                 SDL_EventQ.max_events_seen);
     }
 
     // Clean out EventQ
-    for (entry = SDL_EventQ.head; entry;) {
-        SDL_EventEntry *next = entry->next;
+    for (entry = SDL_EventQ.head; entry; entry = entry->next) {
         SDL_TransferTemporaryMemoryFromEvent(entry);
-        SDL_free(entry);
-        entry = next;
     }
-    for (entry = SDL_EventQ.free; entry;) {
-        SDL_EventEntry *next = entry->next;
-        SDL_free(entry);
-        entry = next;
+    while (SDL_EventQ.slabs) {
+        SDL_EventSlab *next = SDL_EventQ.slabs->next;
+        SDL_aligned_free(SDL_EventQ.slabs);
+        SDL_EventQ.slabs = next;
     }
 
     SDL_SetAtomicInt(&SDL_EventQ.count, 0);
@@ -921,6 +1026,9 @@ void SDL_StopEventLoop(void)
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_EventQ.num_slabs = 0;
+    SDL_EventQ.slab_allocations = 0;
+    SDL_EventQ.slab_releases = 0;
     SDL_SetAtomicInt(&SDL_sentinel_pending, 0);
 
     // Clear disabled event state
@@ -972,6 +1080,13 @@ bool SDL_StartEventLoop(void)
 
     SDL_InitWindowEventWatch();
 
+    if (!SDL_EventRing.initialized) {
+        for (Uint32 i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+            SDL_SetAtomicU32(&SDL_EventRing.slots[i].sequence, i);
+        }
+        SDL_EventRing.initialized = true;
+    }
+
     SDL_EventQ.active = true;
 
 #ifndef SDL_THREADS_DISABLED
@@ -980,39 +1095,68 @@ bool SDL_StartEventLoop(void)
     return true;
 }
 
-// Add an event to the event queue -- called with the queue locked
-static int SDL_AddEvent(SDL_Event *event)
+// Put every entry of a slab on the free list -- called with the queue locked
+static void SDL_FreeEventSlabEntries(SDL_EventSlab *slab)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
+    int i;
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
+    for (i = SDL_EVENT_SLAB_ENTRIES; i--; ) {
+        SDL_EventEntry *entry = (SDL_EventEntry *)&slab->entries[i * SDL_EVENT_ENTRY_STRIDE];
+        entry->next = SDL_EventQ.free;
+        SDL_EventQ.free = entry;
     }
+}
+
+static SDL_EventEntry *SDL_AllocEventEntry(void)
+{
+    SDL_EventEntry *entry;
 
     if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
+        SDL_EventSlab *slab = (SDL_EventSlab *)SDL_aligned_alloc(SDL_EVENT_ENTRY_ALIGNMENT, sizeof(*slab));
+        if (!slab) {
+            return NULL;
         }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
-    }
+        slab->next = SDL_EventQ.slabs;
+        SDL_EventQ.slabs = slab;
+        ++SDL_EventQ.num_slabs;
+        ++SDL_EventQ.slab_allocations;
+        SDL_FreeEventSlabEntries(slab);
+    }
+    entry = SDL_EventQ.free;
+    SDL_EventQ.free = entry->next;
+    return entry;
+}
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
+// Give back slabs beyond the reserve -- called with the queue locked and empty
+static void SDL_TrimEventSlabs(void)
+{
+    SDL_EventSlab **link = &SDL_EventQ.slabs;
+    SDL_EventSlab *slab;
+    int i;
+
+    SDL_assert(SDL_EventQ.head == NULL);
+
+    // Every entry is free, so the free list can be rebuilt from the slabs we keep
+    SDL_EventQ.free = NULL;
+    for (i = 0; i < SDL_EVENT_SLAB_RESERVE && *link; ++i) {
+        SDL_FreeEventSlabEntries(*link);
+        link = &(*link)->next;
     }
 
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    slab = *link;
+    *link = NULL;
+    while (slab) {
+        SDL_EventSlab *next = slab->next;
+        SDL_aligned_free(slab);
+        --SDL_EventQ.num_slabs;
+        ++SDL_EventQ.slab_releases;
+        slab = next;
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
+}
 
+// Append an entry to the tail of the list -- called with the queue locked
+static void SDL_LinkEvent(SDL_EventEntry *entry)
+{
     if (SDL_EventQ.tail) {
         SDL_EventQ.tail->next = entry;
         entry->prev = SDL_EventQ.tail;
@@ -1026,16 +1170,378 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->next = NULL;
     }
 
-    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    ++SDL_last_event_id;
+}
+
+static void SDL_UpdateMaxEventsSeen(int count)
+{
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
     }
+}
 
-    ++SDL_last_event_id;
+static void SDL_PrepareEventEntry(SDL_EventEntry *entry, SDL_Event *event)
+{
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&entry->event, event);
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    }
+    entry->memory = NULL;
+    entry->queued_ns = SDL_EventLatencyTracking ? SDL_GetTicksNS() : 0;
+    entry->history = NULL;
+    entry->num_history = 0;
+    entry->history_capacity = 0;
+    SDL_TransferTemporaryMemoryToEvent(entry);
+}
+
+static bool SDL_AppendMotionSample(SDL_EventEntry *entry, const SDL_Event *event)
+{
+    SDL_MotionSample *sample;
+
+    if (entry->num_history == entry->history_capacity) {
+        const int capacity = entry->history_capacity ? (entry->history_capacity * 2) : 16;
+        SDL_MotionSample *history;
+        SDL_TemporaryMemory *memory;
+
+        if (capacity > SDL_MAX_QUEUED_EVENTS) {
+            return false;  // queue it separately, one event shouldn't grow without bound.
+        }
+
+        /* The old array is left attached to the event rather than reallocated,
+           so history pointers handed out by SDL_PeepEvents() stay valid until
+           the event is freed. */
+        history = (SDL_MotionSample *)SDL_malloc(capacity * sizeof(*history));
+        memory = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*memory));
+        if (!history || !memory) {
+            SDL_free(history);
+            SDL_free(memory);
+            return false;
+        }
+        if (entry->num_history > 0) {
+            SDL_memcpy(history, entry->history, entry->num_history * sizeof(*history));
+        }
+        memory->memory = history;
+        memory->prev = NULL;
+        memory->next = entry->memory;
+        entry->memory = memory;
+        entry->history = history;
+        entry->history_capacity = capacity;
+    }
+
+    sample = &entry->history[entry->num_history++];
+    SDL_zerop(sample);
+    sample->timestamp = event->common.timestamp;
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        sample->x = event->motion.x;
+        sample->y = event->motion.y;
+        sample->xrel = event->motion.xrel;
+        sample->yrel = event->motion.yrel;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        sample->x = event->pmotion.x;
+        sample->y = event->pmotion.y;
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        sample->x = event->tfinger.x;
+        sample->y = event->tfinger.y;
+        sample->xrel = event->tfinger.dx;
+        sample->yrel = event->tfinger.dy;
+        sample->pressure = event->tfinger.pressure;
+        break;
+    default:
+        SDL_assert(!"Unexpected motion event type");
+        break;
+    }
+    return true;
+}
+
+/* Merge a motion event into a matching motion event at the tail of the queue -- called with the queue locked
+   Returns true if the event was merged and shouldn't be queued by itself. */
+static bool SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *tail = SDL_EventQ.tail;
+    SDL_Event *merged;
+
+    if (!SDL_CoalesceMotion || !tail || (tail->event.type != event->type)) {
+        return false;
+    }
+
+    merged = &tail->event;
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if ((merged->motion.windowID != event->motion.windowID) ||
+            (merged->motion.which != event->motion.which) ||
+            (merged->motion.state != event->motion.state)) {
+            return false;
+        }
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if ((merged->pmotion.windowID != event->pmotion.windowID) ||
+            (merged->pmotion.which != event->pmotion.which) ||
+            (merged->pmotion.pen_state != event->pmotion.pen_state)) {
+            return false;
+        }
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if ((merged->tfinger.windowID != event->tfinger.windowID) ||
+            (merged->tfinger.touchID != event->tfinger.touchID) ||
+            (merged->tfinger.fingerID != event->tfinger.fingerID)) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+
+    // The queued event's own sample starts the history the first time something is merged into it
+    if (tail->num_history == 0 && !SDL_AppendMotionSample(tail, merged)) {
+        return false;
+    }
+    if (!SDL_AppendMotionSample(tail, event)) {
+        return false;
+    }
+
+    merged->common.timestamp = event->common.timestamp;
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        merged->motion.x = event->motion.x;
+        merged->motion.y = event->motion.y;
+        merged->motion.xrel += event->motion.xrel;
+        merged->motion.yrel += event->motion.yrel;
+        merged->motion.num_history = tail->num_history;
+        merged->motion.history = tail->history;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        merged->pmotion.x = event->pmotion.x;
+        merged->pmotion.y = event->pmotion.y;
+        merged->pmotion.num_history = tail->num_history;
+        merged->pmotion.history = tail->history;
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        merged->tfinger.x = event->tfinger.x;
+        merged->tfinger.y = event->tfinger.y;
+        merged->tfinger.dx += event->tfinger.dx;
+        merged->tfinger.dy += event->tfinger.dy;
+        merged->tfinger.pressure = event->tfinger.pressure;
+        merged->tfinger.num_history = tail->num_history;
+        merged->tfinger.history = tail->history;
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+/* Add an event to the lock-free ring -- may be called from any thread without the queue locked.
+   Returns false if the ring or the queue is full, and the caller should fall back to SDL_AddEvent(). */
+static bool SDL_PushEventToRing(SDL_Event *event)
+{
+    SDL_EventRingSlot *slot;
+    Uint32 pos;
+
+    if (!SDL_EventRing.initialized) {
+        return false;
+    }
+
+    if (SDL_AddAtomicInt(&SDL_EventQ.count, 1) >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        return false;
+    }
+
+    pos = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+    for (;;) {
+        slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+        const Sint32 diff = (Sint32)(SDL_GetAtomicU32(&slot->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&SDL_EventRing.enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+        } else if (diff < 0) {
+            // The consumer hasn't caught up, the ring is full
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+            return false;
+        } else {
+            pos = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+        }
+    }
+    SDL_MemoryBarrierAcquire();
+
+    SDL_PrepareEventEntry(&slot->entry, event);
+
+    // Publish the slot to the consumer
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicU32(&slot->sequence, pos + 1);
+
+    return true;
+}
+
+/* Move all events pushed so far from the ring onto the list, in order -- called with the queue locked
+
+   Slots that have been claimed but not yet published belong to pushes that are
+   still in progress on other threads. We wait for those to land, otherwise an
+   event added later through SDL_AddEvent() could be linked ahead of them.
+ */
+static void SDL_DrainEventRing(void)
+{
+    Uint32 end;
+
+    if (!SDL_EventRing.initialized) {
+        return;
+    }
+
+    end = SDL_GetAtomicU32(&SDL_EventRing.enqueue_pos);
+    while (SDL_EventRing.dequeue_pos != end) {
+        const Uint32 pos = SDL_EventRing.dequeue_pos;
+        SDL_EventRingSlot *slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+        SDL_EventEntry *entry;
+
+        if (SDL_GetAtomicU32(&slot->sequence) != pos + 1) {
+            // The producer hasn't finished writing this slot yet
+            SDL_CPUPauseInstruction();
+            continue;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (SDL_CoalesceMotionEvent(&slot->entry.event)) {
+            // Merged into the event at the tail of the list
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        } else {
+            entry = SDL_AllocEventEntry();
+            if (entry) {
+                SDL_copyp(entry, &slot->entry);
+                SDL_LinkEvent(entry);
+                SDL_UpdateMaxEventsSeen(SDL_GetAtomicInt(&SDL_EventQ.count));
+            } else {
+                // Out of memory, drop the event
+                SDL_TransferTemporaryMemoryFromEvent(&slot->entry);
+                if (slot->entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+                    SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+                }
+                SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+            }
+        }
+
+        // Hand the slot back to the producers
+        SDL_MemoryBarrierRelease();
+        SDL_SetAtomicU32(&slot->sequence, pos + SDL_EVENT_RING_SIZE);
+        SDL_EventRing.dequeue_pos = pos + 1;
+    }
+}
+
+// Add an event to the event queue -- called with the queue locked
+static int SDL_AddEvent(SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
+    int final_count;
+
+    if (SDL_CoalesceMotionEvent(event)) {
+        if (SDL_EventLoggingVerbosity > 0) {
+            SDL_LogEvent(event);
+        }
+        return 1;
+    }
+
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    entry = SDL_AllocEventEntry();
+    if (entry == NULL) {
+        return 0;
+    }
+
+    SDL_PrepareEventEntry(entry, event);
+    SDL_LinkEvent(entry);
+
+    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
+    SDL_UpdateMaxEventsSeen(final_count);
 
     return 1;
 }
 
+static int SDL_GetEventLatencyBucket(Uint64 ns)
+{
+    Uint64 limit = SDL_EVENT_LATENCY_FIRST_BUCKET_NS;
+    int bucket = 0;
+
+    while (bucket < (SDL_EVENT_LATENCY_HISTOGRAM_BUCKETS - 1) && ns >= limit) {
+        limit *= 2;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Record how long an event took to reach the queue and be delivered from it -- called with the queue locked
+static void SDL_RecordEventLatency(const SDL_EventEntry *entry)
+{
+    const Uint64 timestamp = entry->event.common.timestamp;
+    SDL_EventLatencyStats *stats;
+    Uint64 source_ns, queue_ns;
+
+    if (!entry->queued_ns || entry->event.type == SDL_EVENT_POLL_SENTINEL) {
+        return;
+    }
+
+    source_ns = (timestamp && timestamp < entry->queued_ns) ? (entry->queued_ns - timestamp) : 0;
+    queue_ns = SDL_GetTicksNS() - entry->queued_ns;
+
+    stats = &SDL_event_latency[SDL_GetEventCategoryNoError(entry->event.type)];
+    ++stats->count;
+    stats->source_ns_total += source_ns;
+    stats->source_ns_max = SDL_max(stats->source_ns_max, source_ns);
+    stats->queue_ns_total += queue_ns;
+    stats->queue_ns_max = SDL_max(stats->queue_ns_max, queue_ns);
+    ++stats->source_histogram[SDL_GetEventLatencyBucket(source_ns)];
+    ++stats->queue_histogram[SDL_GetEventLatencyBucket(queue_ns)];
+}
+
+bool SDL_GetEventLatencyStats(Uint32 type, SDL_EventLatencyStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    SDL_copyp(stats, &SDL_event_latency[SDL_GetEventCategoryNoError(type)]);
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return true;
+}
+
+void SDL_ResetEventLatencyStats(void)
+{
+    SDL_LockMutex(SDL_EventQ.lock);
+    SDL_zeroa(SDL_event_latency);
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
+bool SDL_GetEventQueueStats(SDL_EventQueueStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        stats->num_events = SDL_GetAtomicInt(&SDL_EventQ.count);
+        stats->max_events_seen = SDL_EventQ.max_events_seen;
+        stats->num_entries = SDL_EventQ.num_slabs * SDL_EVENT_SLAB_ENTRIES;
+        stats->block_allocations = SDL_EventQ.slab_allocations;
+        stats->block_releases = SDL_EventQ.slab_releases;
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return true;
+}
+
 // Remove an event from the queue -- called with the queue locked
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
@@ -1065,6 +1571,10 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
     SDL_EventQ.free = entry;
     SDL_assert(SDL_GetAtomicInt(&SDL_EventQ.count) > 0);
     SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+
+    if (!SDL_EventQ.head && SDL_EventQ.num_slabs > SDL_EVENT_SLAB_RESERVE) {
+        SDL_TrimEventSlabs();
+    }
 }
 
 static void SDL_SendWakeupEvent(void)
@@ -1091,9 +1601,22 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
 {
     int i, used, sentinels_expected = 0;
 
-    // Lock the event queue
     used = 0;
 
+    if (action == SDL_ADDEVENT && events && SDL_EventQ.active) {
+        // Try the lock-free path first, falling back to the locked list once the ring is full
+        while (used < numevents && SDL_PushEventToRing(&events[used])) {
+            ++used;
+        }
+        if (used == numevents) {
+            if (used > 0) {
+                SDL_SendWakeupEvent();
+            }
+            return used;
+        }
+    }
+
+    // Lock the event queue
     SDL_LockMutex(SDL_EventQ.lock);
     {
         // Don't look after we've quit
@@ -1110,13 +1633,17 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                 SDL_UnlockMutex(SDL_EventQ.lock);
                 return SDL_InvalidParamError("events");
             }
-            for (i = 0; i < numevents; ++i) {
+            // Keep ordering with anything that went through the ring
+            SDL_DrainEventRing();
+            for (i = used; i < numevents; ++i) {
                 used += SDL_AddEvent(&events[i]);
             }
         } else {
             SDL_EventEntry *entry, *next;
             Uint32 type;
 
+            SDL_DrainEventRing();
+
             for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
                 next = entry->next;
                 type = entry->event.type;
@@ -1125,6 +1652,7 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                         SDL_copyp(&events[used], &entry->event);
 
                         if (action == SDL_GETEVENT) {
+                            SDL_RecordEventLatency(entry);
                             SDL_CutEvent(entry);
                         }
                     }
@@ -1173,6 +1701,7 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         if (SDL_EventQ.active) {
+            SDL_DrainEventRing();
             for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
                 const Uint32 type = entry->event.type;
                 if (minType <= type && type <= maxType) {
@@ -1213,6 +1742,7 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -1236,77 +1766,165 @@ typedef struct SDL_MainThreadCallbackEntry
     SDL_MainThreadCallback callback;
     void *userdata;
     SDL_AtomicInt state;
-    SDL_Semaphore *semaphore;
+    SDL_Semaphore *semaphore; // the waiting thread's, NULL if nobody waits
     struct SDL_MainThreadCallbackEntry *next;
 } SDL_MainThreadCallbackEntry;
 
+/* Callbacks are queued without locking in SDL_main_callbacks_queue. If that fills
+   up, they go on the locked list instead, and until the main thread takes the
+   list all callbacks go there, so callbacks from any one thread stay in order.
+
+   Entries nobody waits on come from a pool the main thread refills as it runs
+   them. Entries that are waited on live on the waiting thread's stack and use
+   that thread's semaphore, so neither case allocates once things warm up.
+ */
+#define SDL_MAIN_CALLBACK_QUEUE_SIZE 256
+
+static SDL_AtomicQueue *SDL_main_callbacks_queue;
+static SDL_AtomicQueue *SDL_main_callbacks_pool;
+static SDL_AtomicInt SDL_main_callbacks_overflow;
+static SDL_AtomicInt SDL_main_callbacks_pending;
 static SDL_Mutex *SDL_main_callbacks_lock;
 static SDL_MainThreadCallbackEntry *SDL_main_callbacks_head;
 static SDL_MainThreadCallbackEntry *SDL_main_callbacks_tail;
+static SDL_TLSID SDL_main_callbacks_semaphore;
 
-static SDL_MainThreadCallbackEntry *SDL_CreateMainThreadCallback(SDL_MainThreadCallback callback, void *userdata, bool wait_complete)
+static SDL_MainThreadCallbackEntry *SDL_AllocMainThreadCallback(void)
 {
-    SDL_MainThreadCallbackEntry *entry = (SDL_MainThreadCallbackEntry *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        return NULL;
+    SDL_MainThreadCallbackEntry *entry;
+
+    if (SDL_main_callbacks_pool && SDL_PopAtomicQueue(SDL_main_callbacks_pool, &entry)) {
+        return entry;
     }
+    return (SDL_MainThreadCallbackEntry *)SDL_malloc(sizeof(*entry));
+}
 
-    entry->callback = callback;
-    entry->userdata = userdata;
-    SDL_SetAtomicInt(&entry->state, SDL_MAIN_CALLBACK_WAITING);
-    if (wait_complete) {
-        entry->semaphore = SDL_CreateSemaphore(0);
-        if (!entry->semaphore) {
-            SDL_free(entry);
-            return NULL;
-        }
-    } else {
-        entry->semaphore = NULL;
+static void SDL_FreeMainThreadCallback(SDL_MainThreadCallbackEntry *entry)
+{
+    if (!SDL_main_callbacks_pool || !SDL_PushAtomicQueue(SDL_main_callbacks_pool, &entry)) {
+        SDL_free(entry);
     }
-    entry->next = NULL;
+}
 
-    return entry;
+static void SDLCALL SDL_CleanupMainThreadCallbackSemaphore(void *data)
+{
+    SDL_DestroySemaphore((SDL_Semaphore *)data);
 }
 
-static void SDL_DestroyMainThreadCallback(SDL_MainThreadCallbackEntry *entry)
+static SDL_Semaphore *SDL_GetMainThreadCallbackSemaphore(void)
 {
-    if (entry->semaphore) {
-        SDL_DestroySemaphore(entry->semaphore);
+    SDL_Semaphore *semaphore = (SDL_Semaphore *)SDL_GetTLS(&SDL_main_callbacks_semaphore);
+    if (!semaphore) {
+        semaphore = SDL_CreateSemaphore(0);
+        if (!semaphore) {
+            return NULL;
+        }
+        if (!SDL_SetTLS(&SDL_main_callbacks_semaphore, semaphore, SDL_CleanupMainThreadCallbackSemaphore)) {
+            SDL_DestroySemaphore(semaphore);
+            return NULL;
+        }
     }
-    SDL_free(entry);
+    return semaphore;
 }
 
 static void SDL_InitMainThreadCallbacks(void)
 {
+    SDL_main_callbacks_queue = SDL_CreateAtomicQueue(SDL_MAIN_CALLBACK_QUEUE_SIZE, sizeof(SDL_MainThreadCallbackEntry *), SDL_ATOMIC_QUEUE_SINGLE_CONSUMER);
+    SDL_main_callbacks_pool = SDL_CreateAtomicQueue(SDL_MAIN_CALLBACK_QUEUE_SIZE, sizeof(SDL_MainThreadCallbackEntry *), SDL_ATOMIC_QUEUE_SINGLE_PRODUCER);
+    SDL_SetAtomicInt(&SDL_main_callbacks_overflow, 0);
+    SDL_SetAtomicInt(&SDL_main_callbacks_pending, 0);
     SDL_main_callbacks_lock = SDL_CreateMutex();
     SDL_assert(SDL_main_callbacks_head == NULL &&
                SDL_main_callbacks_tail == NULL);
 }
 
-static void SDL_QuitMainThreadCallbacks(void)
+static void SDL_FinishMainThreadCallback(SDL_MainThreadCallbackEntry *entry, SDL_MainThreadCallbackState state)
 {
-    SDL_MainThreadCallbackEntry *entry;
+    if (entry->semaphore) {
+        // Let the waiting thread know this is done or canceled; the entry is gone once it wakes up
+        SDL_Semaphore *semaphore = entry->semaphore;
+        SDL_SetAtomicInt(&entry->state, state);
+        SDL_SignalSemaphore(semaphore);
+    } else {
+        // Nobody's waiting for this, recycle it
+        SDL_FreeMainThreadCallback(entry);
+    }
+}
 
-    SDL_LockMutex(SDL_main_callbacks_lock);
-    {
-        entry = SDL_main_callbacks_head;
-        SDL_main_callbacks_head = NULL;
-        SDL_main_callbacks_tail = NULL;
+// Wake the main thread once for everything queued since it last ran callbacks
+static void SDL_WakeMainThreadForCallbacks(void)
+{
+    if (SDL_CompareAndSwapAtomicInt(&SDL_main_callbacks_pending, 0, 1)) {
+        SDL_SendWakeupEvent();
     }
-    SDL_UnlockMutex(SDL_main_callbacks_lock);
+}
+
+// Take every queued callback, in order, and let new callbacks use the queue again
+static SDL_MainThreadCallbackEntry *SDL_TakeMainThreadCallbacks(void)
+{
+    SDL_MainThreadCallbackEntry *head = NULL;
+    SDL_MainThreadCallbackEntry *tail = NULL;
+    SDL_MainThreadCallbackEntry *entry;
+    bool overflow;
+
+    do {
+        /* Anything on the list was added after everything that's in the queue
+           when we hold the lock, so empty the queue again under the lock. */
+        overflow = SDL_GetAtomicInt(&SDL_main_callbacks_overflow) != 0;
+        if (overflow) {
+            SDL_LockMutex(SDL_main_callbacks_lock);
+        }
 
+        while (SDL_main_callbacks_queue && SDL_PopAtomicQueue(SDL_main_callbacks_queue, &entry)) {
+            entry->next = NULL;
+            if (tail) {
+                tail->next = entry;
+            } else {
+                head = entry;
+            }
+            tail = entry;
+        }
+
+        if (overflow) {
+            if (SDL_main_callbacks_head) {
+                if (tail) {
+                    tail->next = SDL_main_callbacks_head;
+                } else {
+                    head = SDL_main_callbacks_head;
+                }
+                tail = SDL_main_callbacks_tail;
+            }
+            SDL_main_callbacks_head = NULL;
+            SDL_main_callbacks_tail = NULL;
+            SDL_SetAtomicInt(&SDL_main_callbacks_overflow, 0);
+            SDL_UnlockMutex(SDL_main_callbacks_lock);
+        }
+    } while (!overflow && SDL_GetAtomicInt(&SDL_main_callbacks_overflow));
+
+    return head;
+}
+
+static void SDL_QuitMainThreadCallbacks(void)
+{
+    SDL_MainThreadCallbackEntry *entry;
+
+    SDL_SetAtomicInt(&SDL_main_callbacks_pending, 0);
+    entry = SDL_TakeMainThreadCallbacks();
     while (entry) {
         SDL_MainThreadCallbackEntry *next = entry->next;
+        SDL_FinishMainThreadCallback(entry, SDL_MAIN_CALLBACK_CANCELED);
+        entry = next;
+    }
 
-        if (entry->semaphore) {
-            // Let the waiting thread know this is canceled
-            SDL_SetAtomicInt(&entry->state, SDL_MAIN_CALLBACK_CANCELED);
-            SDL_SignalSemaphore(entry->semaphore);
-        } else {
-            // Nobody's waiting for this, clean it up
-            SDL_DestroyMainThreadCallback(entry);
+    SDL_DestroyAtomicQueue(SDL_main_callbacks_queue);
+    SDL_main_callbacks_queue = NULL;
+
+    if (SDL_main_callbacks_pool) {
+        while (SDL_PopAtomicQueue(SDL_main_callbacks_pool, &entry)) {
+            SDL_free(entry);
         }
-        entry = next;
+        SDL_DestroyAtomicQueue(SDL_main_callbacks_pool);
+        SDL_main_callbacks_pool = NULL;
     }
 
     SDL_DestroyMutex(SDL_main_callbacks_lock);
@@ -1317,27 +1935,14 @@ static void SDL_RunMainThreadCallbacks(void)
 {
     SDL_MainThreadCallbackEntry *entry;
 
-    SDL_LockMutex(SDL_main_callbacks_lock);
-    {
-        entry = SDL_main_callbacks_head;
-        SDL_main_callbacks_head = NULL;
-        SDL_main_callbacks_tail = NULL;
-    }
-    SDL_UnlockMutex(SDL_main_callbacks_lock);
+    // Anything queued from here on needs a new wakeup
+    SDL_SetAtomicInt(&SDL_main_callbacks_pending, 0);
+    entry = SDL_TakeMainThreadCallbacks();
 
     while (entry) {
         SDL_MainThreadCallbackEntry *next = entry->next;
-
         entry->callback(entry->userdata);
-
-        if (entry->semaphore) {
-            // Let the waiting thread know this is done
-            SDL_SetAtomicInt(&entry->state, SDL_MAIN_CALLBACK_COMPLETE);
-            SDL_SignalSemaphore(entry->semaphore);
-        } else {
-            // Nobody's waiting for this, clean it up
-            SDL_DestroyMainThreadCallback(entry);
-        }
+        SDL_FinishMainThreadCallback(entry, SDL_MAIN_CALLBACK_COMPLETE);
         entry = next;
     }
 }
@@ -1350,25 +1955,46 @@ bool SDL_RunOnMainThread(SDL_MainThreadCallback callback, void *userdata, bool w
         return true;
     }
 
-    SDL_MainThreadCallbackEntry *entry = SDL_CreateMainThreadCallback(callback, userdata, wait_complete);
-    if (!entry) {
-        return false;
+    SDL_MainThreadCallbackEntry waiter;
+    SDL_MainThreadCallbackEntry *entry;
+    if (wait_complete) {
+        // We block until the main thread is done with it, so it can live on our stack
+        entry = &waiter;
+        entry->semaphore = SDL_GetMainThreadCallbackSemaphore();
+        if (!entry->semaphore) {
+            return false;
+        }
+    } else {
+        entry = SDL_AllocMainThreadCallback();
+        if (!entry) {
+            return false;
+        }
+        entry->semaphore = NULL;
     }
+    entry->callback = callback;
+    entry->userdata = userdata;
+    SDL_SetAtomicInt(&entry->state, SDL_MAIN_CALLBACK_WAITING);
+    entry->next = NULL;
 
-    SDL_LockMutex(SDL_main_callbacks_lock);
-    {
-        if (SDL_main_callbacks_tail) {
-            SDL_main_callbacks_tail->next = entry;
-            SDL_main_callbacks_tail = entry;
-        } else {
-            SDL_main_callbacks_head = entry;
-            SDL_main_callbacks_tail = entry;
+    if (SDL_GetAtomicInt(&SDL_main_callbacks_overflow) ||
+        !SDL_main_callbacks_queue ||
+        !SDL_PushAtomicQueue(SDL_main_callbacks_queue, &entry)) {
+        SDL_LockMutex(SDL_main_callbacks_lock);
+        {
+            SDL_SetAtomicInt(&SDL_main_callbacks_overflow, 1);
+            if (SDL_main_callbacks_tail) {
+                SDL_main_callbacks_tail->next = entry;
+                SDL_main_callbacks_tail = entry;
+            } else {
+                SDL_main_callbacks_head = entry;
+                SDL_main_callbacks_tail = entry;
+            }
         }
+        SDL_UnlockMutex(SDL_main_callbacks_lock);
     }
-    SDL_UnlockMutex(SDL_main_callbacks_lock);
 
     // If the main thread is waiting for events, wake it up
-    SDL_SendWakeupEvent();
+    SDL_WakeMainThreadForCallbacks();
 
     if (!wait_complete) {
         // Queued for execution, wait not requested
@@ -1377,23 +2003,11 @@ bool SDL_RunOnMainThread(SDL_MainThreadCallback callback, void *userdata, bool w
 
     SDL_WaitSemaphore(entry->semaphore);
 
-    switch (SDL_GetAtomicInt(&entry->state)) {
-    case SDL_MAIN_CALLBACK_COMPLETE:
-        // Execution complete!
-        SDL_DestroyMainThreadCallback(entry);
-        return true;
-
-    case SDL_MAIN_CALLBACK_CANCELED:
+    if (SDL_GetAtomicInt(&entry->state) != SDL_MAIN_CALLBACK_COMPLETE) {
         // The callback was canceled on the main thread
-        SDL_DestroyMainThreadCallback(entry);
         return SDL_SetError("Callback canceled");
-
-    default:
-        // Probably hit a deadlock in the callback
-        // We can't destroy the entry as the semaphore will be signaled
-        // if it ever comes back, just leak it here.
-        return SDL_SetError("Callback timed out");
     }
+    return true;
 }
 
 void SDL_PumpEventMaintenance(void)
@@ -1414,12 +2028,15 @@ void SDL_PumpEventMaintenance(void)
 #endif
 
 #ifndef SDL_JOYSTICK_DISABLED
-    // Check for joystick state change
-    if (SDL_update_joysticks) {
+    // Check for joystick state change, unless a background thread is already doing that
+    if (SDL_update_joysticks && !SDL_JoystickUpdateThreadActive()) {
         SDL_UpdateJoysticks();
     }
 #endif
 
+    SDL_SendTouchFrames();
+    SDL_SendPenFrames();
+
     SDL_UpdateTrays();
 
     SDL_SendPendingSignalEvents(); // in case we had a signal handler fire, etc.
@@ -1428,6 +2045,10 @@ void SDL_PumpEventMaintenance(void)
 // Run the system dependent event loops
 static void SDL_PumpEventsInternal(bool push_sentinel)
 {
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_EVENTS);
+
+    SDL_TRACE_BEGIN("SDL_PumpEvents");
+
     // Free any temporary memory from old events
     SDL_FreeTemporaryMemory();
 
@@ -1444,7 +2065,9 @@ static void SDL_PumpEventsInternal(bool push_sentinel)
     // Get events from the video subsystem
     SDL_VideoDevice *_this = SDL_GetVideoDevice();
     if (_this) {
+        SDL_TRACE_BEGIN("PumpEvents");
         _this->PumpEvents(_this);
+        SDL_TRACE_END("PumpEvents");
     }
 #endif
 
@@ -1462,6 +2085,9 @@ static void SDL_PumpEventsInternal(bool push_sentinel)
         sentinel.common.timestamp = 0;
         SDL_PushEvent(&sentinel);
     }
+
+    SDL_TRACE_END("SDL_PumpEvents");
+    SDL_PopMemoryTag(memory_tag);
 }
 
 void SDL_PumpEvents(void)
@@ -1476,17 +2102,82 @@ bool SDL_PollEvent(SDL_Event *event)
     return SDL_WaitEventTimeoutNS(event, 0);
 }
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    SDL_EventEntry *entry, *next;
+    int used = 0;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    } else if (numevents < 0) {
+        SDL_InvalidParamError("numevents");
+        return -1;
+    }
+
+    // If there isn't a poll sentinel event pending, pump events and add one
+    if (SDL_GetAtomicInt(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(true);
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        if (!SDL_EventQ.active) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            SDL_SetError("The event system has been shut down");
+            return -1;
+        }
+
+        SDL_DrainEventRing();
+
+        for (entry = SDL_EventQ.head; entry && used < numevents; entry = next) {
+            next = entry->next;
+            if (entry->event.type == SDL_EVENT_POLL_SENTINEL) {
+                if (SDL_GetAtomicInt(&SDL_sentinel_pending) > 1) {
+                    // Skip it, there's another one pending
+                    SDL_CutEvent(entry);
+                    continue;
+                }
+                if (used == 0) {
+                    // Reached the end of a poll cycle, and not willing to wait
+                    SDL_CutEvent(entry);
+                }
+                // Otherwise leave it queued, so the next call reports the end of the poll cycle
+                break;
+            }
+            SDL_copyp(&events[used], &entry->event);
+            SDL_RecordEventLatency(entry);
+            SDL_CutEvent(entry);
+            ++used;
+        }
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return used;
+}
+
 #ifndef SDL_PLATFORM_ANDROID
 
+/* Open devices that haven't changed state in a while are polled less often, backing
+   off gradually as they stay idle and snapping back to the fast interval on activity.
+ */
+static Sint64 SDL_events_get_active_polling_interval(Uint64 last_activityNS)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    Uint64 idleNS = (now > last_activityNS) ? (now - last_activityNS) : 0;
+
+    return (Sint64)SDL_clamp(idleNS / 64, EVENT_POLL_INTERVAL_NS, IDLE_POLL_INTERVAL_NS);
+}
+
 static Sint64 SDL_events_get_polling_interval(void)
 {
     Sint64 poll_intervalNS = SDL_MAX_SINT64;
 
 #ifndef SDL_JOYSTICK_DISABLED
-    if (SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks) {
+    if (SDL_WasInit(SDL_INIT_JOYSTICK) && SDL_update_joysticks && !SDL_JoystickUpdateThreadActive()) {
         if (SDL_JoysticksOpened()) {
             // If we have joysticks open, we need to poll rapidly for events
-            poll_intervalNS = SDL_min(poll_intervalNS, EVENT_POLL_INTERVAL_NS);
+            poll_intervalNS = SDL_min(poll_intervalNS, SDL_events_get_active_polling_interval(SDL_GetJoystickActivityTime()));
         } else {
             // If not, just poll every few seconds to enumerate new joysticks
             poll_intervalNS = SDL_min(poll_intervalNS, ENUMERATION_POLL_INTERVAL_NS);
@@ -1497,7 +2188,7 @@ static Sint64 SDL_events_get_polling_interval(void)
 #ifndef SDL_SENSOR_DISABLED
     if (SDL_WasInit(SDL_INIT_SENSOR) && SDL_update_sensors && SDL_SensorsOpened()) {
         // If we have sensors open, we need to poll rapidly for events
-        poll_intervalNS = SDL_min(poll_intervalNS, EVENT_POLL_INTERVAL_NS);
+        poll_intervalNS = SDL_min(poll_intervalNS, SDL_events_get_active_polling_interval(SDL_GetSensorActivityTime()));
     }
 #endif
 
@@ -1507,7 +2198,7 @@ static Sint64 SDL_events_get_polling_interval(void)
 static int SDL_WaitEventTimeout_Device(SDL_VideoDevice *_this, SDL_Window *wakeup_window, SDL_Event *event, Uint64 start, Sint64 timeoutNS)
 {
     Sint64 loop_timeoutNS = timeoutNS;
-    Sint64 poll_intervalNS = SDL_events_get_polling_interval();
+    Sint64 poll_intervalNS;
 
     for (;;) {
         int status;
@@ -1537,6 +2228,7 @@ static int SDL_WaitEventTimeout_Device(SDL_VideoDevice *_this, SDL_Window *wakeu
             loop_timeoutNS = (timeoutNS - elapsed);
         }
         // Adjust the timeout for any polling requirements we currently have.
+        poll_intervalNS = SDL_events_get_polling_interval();
         if (poll_intervalNS != SDL_MAX_SINT64) {
             if (loop_timeoutNS >= 0) {
                 loop_timeoutNS = SDL_min(loop_timeoutNS, poll_intervalNS);
@@ -1545,6 +2237,12 @@ static int SDL_WaitEventTimeout_Device(SDL_VideoDevice *_this, SDL_Window *wakeu
             }
         }
         SDL_SetAtomicPointer(&_this->wakeup_window, wakeup_window);
+        if (SDL_GetAtomicInt(&SDL_main_callbacks_pending)) {
+            /* A callback was queued after we ran them but before we could be woken
+               up, and its wakeup covers anything queued after it, so go run it now. */
+            SDL_SetAtomicPointer(&_this->wakeup_window, NULL);
+            continue;
+        }
         status = _this->WaitEventTimeout(_this, loop_timeoutNS);
         SDL_SetAtomicPointer(&_this->wakeup_window, NULL);
         if (status == 0 && poll_intervalNS != SDL_MAX_SINT64 && loop_timeoutNS == poll_intervalNS) {
@@ -1742,6 +2440,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing();
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1779,6 +2478,14 @@ bool SDL_AddEventWatch(SDL_EventFilter filter, void *userdata)
     return SDL_AddEventWatchList(&SDL_event_watchers, filter, userdata);
 }
 
+bool SDL_AddEventWatchRange(Uint32 minType, Uint32 maxType, SDL_EventFilter filter, void *userdata)
+{
+    if (minType > maxType) {
+        return SDL_SetError("minType must not be greater than maxType");
+    }
+    return SDL_AddEventWatchListRange(&SDL_event_watchers, minType, maxType, filter, userdata);
+}
+
 void SDL_RemoveEventWatch(SDL_EventFilter filter, void *userdata)
 {
     SDL_RemoveEventWatchList(&SDL_event_watchers, filter, userdata);
@@ -1789,6 +2496,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1940,6 +2648,8 @@ bool SDL_InitEvents(void)
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_LATENCY_STATS, SDL_EventLatencyStatsChanged, NULL);
     SDL_InitMainThreadCallbacks();
     if (!SDL_StartEventLoop()) {
         SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
@@ -1956,6 +2666,8 @@ void SDL_QuitEvents(void)
     SDL_QuitQuit();
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_LATENCY_STATS, SDL_EventLatencyStatsChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
@@ -45,14 +45,27 @@ void SDL_QuitEventWatchList(SDL_EventWatchList *list)
         list->watchers = NULL;
         list->count = 0;
     }
+    SDL_zeroa(list->interested);
     SDL_zero(list->filter);
 }
 
+static void SDL_UpdateEventWatchInterest(SDL_EventWatchList *list, const SDL_EventWatcher *watcher, int delta)
+{
+    const Uint32 first = SDL_EVENT_WATCH_BLOCK(watcher->minType);
+    const Uint32 last = SDL_EVENT_WATCH_BLOCK(watcher->maxType);
+    Uint32 block;
+
+    for (block = first; block <= last; ++block) {
+        list->interested[block] += delta;
+    }
+}
+
 bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event)
 {
     SDL_EventWatcher *filter = &list->filter;
+    const Uint32 type = event->type;
 
-    if (!filter->callback && list->count == 0) {
+    if (!filter->callback && list->interested[SDL_EVENT_WATCH_BLOCK(type)] == 0) {
         return true;
     }
 
@@ -68,8 +81,9 @@ bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event)
 
         list->dispatching = true;
         for (i = 0; i < count; ++i) {
-            if (!list->watchers[i].removed) {
-                list->watchers[i].callback(list->watchers[i].userdata, event);
+            const SDL_EventWatcher *watcher = &list->watchers[i];
+            if (!watcher->removed && type >= watcher->minType && type <= watcher->maxType) {
+                watcher->callback(watcher->userdata, event);
             }
         }
         list->dispatching = false;
@@ -92,6 +106,11 @@ bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event)
 }
 
 bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata)
+{
+    return SDL_AddEventWatchListRange(list, 0, SDL_MAX_UINT32, filter, userdata);
+}
+
+bool SDL_AddEventWatchListRange(SDL_EventWatchList *list, Uint32 minType, Uint32 maxType, SDL_EventFilter filter, void *userdata)
 {
     bool result = true;
 
@@ -107,7 +126,10 @@ bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, voi
             watcher = &list->watchers[list->count];
             watcher->callback = filter;
             watcher->userdata = userdata;
+            watcher->minType = minType;
+            watcher->maxType = maxType;
             watcher->removed = false;
+            SDL_UpdateEventWatchInterest(list, watcher, 1);
             ++list->count;
         } else {
             result = false;
@@ -125,7 +147,8 @@ void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter,
         int i;
 
         for (i = 0; i < list->count; ++i) {
-            if (list->watchers[i].callback == filter && list->watchers[i].userdata == userdata) {
+            if (list->watchers[i].callback == filter && list->watchers[i].userdata == userdata && !list->watchers[i].removed) {
+                SDL_UpdateEventWatchInterest(list, &list->watchers[i], -1);
                 if (list->dispatching) {
                     list->watchers[i].removed = true;
                     list->removed = true;
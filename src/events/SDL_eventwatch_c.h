@@ -20,10 +20,16 @@
 */
 #include "SDL_internal.h"
 
+// Event types are grouped into blocks of 256 (the high byte of SDL_EventType), everything past SDL_EVENT_LAST lands in the last block
+#define SDL_EVENT_WATCH_BLOCKS  256
+#define SDL_EVENT_WATCH_BLOCK(type) (((type) > SDL_EVENT_LAST) ? (SDL_EVENT_WATCH_BLOCKS - 1) : ((type) >> 8))
+
 typedef struct SDL_EventWatcher
 {
     SDL_EventFilter callback;
     void *userdata;
+    Uint32 minType;
+    Uint32 maxType;
     bool removed;
 } SDL_EventWatcher;
 
@@ -33,6 +39,7 @@ typedef struct SDL_EventWatchList
     SDL_EventWatcher filter;
     SDL_EventWatcher *watchers;
     int count;
+    int interested[SDL_EVENT_WATCH_BLOCKS];  // how many watchers have a range touching each block of event types
     bool dispatching;
     bool removed;
 } SDL_EventWatchList;
@@ -42,4 +49,5 @@ extern bool SDL_InitEventWatchList(SDL_EventWatchList *list);
 extern void SDL_QuitEventWatchList(SDL_EventWatchList *list);
 extern bool SDL_DispatchEventWatchList(SDL_EventWatchList *list, SDL_Event *event);
 extern bool SDL_AddEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
+extern bool SDL_AddEventWatchListRange(SDL_EventWatchList *list, Uint32 minType, Uint32 maxType, SDL_EventFilter filter, void *userdata);
 extern void SDL_RemoveEventWatchList(SDL_EventWatchList *list, SDL_EventFilter filter, void *userdata);
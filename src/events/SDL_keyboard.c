@@ -24,6 +24,7 @@
 
 #include "SDL_events_c.h"
 #include "SDL_keymap_c.h"
+#include "../SDL_hints_c.h"
 #include "../video/SDL_sysvideo.h"
 
 #if 0
@@ -507,6 +508,8 @@ SDL_Scancode SDL_GetScancodeFromKey(SDL_Keycode key, SDL_Keymod *modstate)
     return SDL_GetKeymapScancode(keyboard->keymap, key, modstate);
 }
 
+static SDL_CachedHint SDL_allow_alt_tab_while_grabbed_hint = SDL_CACHED_HINT(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED, true);
+
 static bool SDL_SendKeyboardKeyInternal(Uint64 timestamp, Uint32 flags, SDL_KeyboardID keyboardID, int rawcode, SDL_Scancode scancode, bool down)
 {
     SDL_Keyboard *keyboard = &SDL_keyboard;
@@ -641,7 +644,7 @@ static bool SDL_SendKeyboardKeyInternal(Uint64 timestamp, Uint32 flags, SDL_Keyb
         keyboard->focus &&
         (keyboard->focus->flags & SDL_WINDOW_KEYBOARD_GRABBED) &&
         (keyboard->focus->flags & SDL_WINDOW_FULLSCREEN) &&
-        SDL_GetHintBoolean(SDL_HINT_ALLOW_ALT_TAB_WHILE_GRABBED, true)) {
+        SDL_GetCachedHintBoolean(&SDL_allow_alt_tab_while_grabbed_hint)) {
         /* We will temporarily forfeit our grab by minimizing our window,
            allowing the user to escape the application */
         SDL_MinimizeWindow(keyboard->focus);
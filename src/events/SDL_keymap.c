@@ -23,9 +23,20 @@
 #include "SDL_keymap_c.h"
 #include "SDL_keyboard_c.h"
 
+// The modifiers that affect the keymap are SHIFT, CAPS, ALT, MODE, and LEVEL5, giving 32 keymap levels
+#define SDL_KEYMAP_LEVELS       32
+
+// Keycodes below this value are looked up in a dense table instead of the hash table
+#define SDL_KEYMAP_DENSE_KEYS   256
+
+#define SDL_KEYMAP_UNMAPPED     0xFFFFFFFFu
+
 struct SDL_Keymap
 {
-    SDL_HashTable *scancode_to_keycode;
+    // Dense scancode to keycode tables, allocated on demand for each modifier level
+    SDL_Keycode *scancode_to_keycode[SDL_KEYMAP_LEVELS];
+    // Dense (modstate << 16 | scancode) entries for keycodes below SDL_KEYMAP_DENSE_KEYS
+    Uint32 keycode_to_scancode_dense[SDL_KEYMAP_DENSE_KEYS];
     SDL_HashTable *keycode_to_scancode;
 };
 
@@ -34,14 +45,14 @@ static SDL_Scancode SDL_GetDefaultScancodeFromKey(SDL_Keycode key, SDL_Keymod *m
 
 SDL_Keymap *SDL_CreateKeymap(void)
 {
-    SDL_Keymap *keymap = (SDL_Keymap *)SDL_malloc(sizeof(*keymap));
+    SDL_Keymap *keymap = (SDL_Keymap *)SDL_calloc(1, sizeof(*keymap));
     if (!keymap) {
         return NULL;
     }
 
-    keymap->scancode_to_keycode = SDL_CreateHashTable(256, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    SDL_memset(keymap->keycode_to_scancode_dense, 0xFF, sizeof(keymap->keycode_to_scancode_dense));
     keymap->keycode_to_scancode = SDL_CreateHashTable(256, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
-    if (!keymap->scancode_to_keycode || !keymap->keycode_to_scancode) {
+    if (!keymap->keycode_to_scancode) {
         SDL_DestroyKeymap(keymap);
         return NULL;
     }
@@ -66,68 +77,105 @@ static SDL_Keymod NormalizeModifierStateForKeymap(SDL_Keymod modstate)
     return modstate;
 }
 
+static int GetKeymapLevel(SDL_Keymod modstate)
+{
+    int level = 0;
+
+    if (modstate & SDL_KMOD_SHIFT) {
+        level |= 0x01;
+    }
+    if (modstate & SDL_KMOD_CAPS) {
+        level |= 0x02;
+    }
+    if (modstate & SDL_KMOD_ALT) {
+        level |= 0x04;
+    }
+    if (modstate & SDL_KMOD_MODE) {
+        level |= 0x08;
+    }
+    if (modstate & SDL_KMOD_LEVEL5) {
+        level |= 0x10;
+    }
+    return level;
+}
+
+static bool FindKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, Uint32 *key)
+{
+    if (keycode < SDL_KEYMAP_DENSE_KEYS) {
+        *key = keymap->keycode_to_scancode_dense[keycode];
+        return (*key != SDL_KEYMAP_UNMAPPED);
+    }
+
+    const void *value;
+    if (SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, &value)) {
+        *key = (Uint32)(uintptr_t)value;
+        return true;
+    }
+    return false;
+}
+
 void SDL_SetKeymapEntry(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate, SDL_Keycode keycode)
 {
-    if (!keymap) {
+    if (!keymap || ((int)scancode) < SDL_SCANCODE_UNKNOWN || scancode >= SDL_SCANCODE_COUNT) {
         return;
     }
 
     modstate = NormalizeModifierStateForKeymap(modstate);
-    Uint32 key = ((Uint32)modstate << 16) | scancode;
-    const void *value;
-    if (SDL_FindInHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, &value)) {
-        const SDL_Keycode existing_keycode = (SDL_Keycode)(uintptr_t)value;
-        if (existing_keycode == keycode) {
-            // We already have this mapping
+
+    const int level = GetKeymapLevel(modstate);
+    SDL_Keycode *keycodes = keymap->scancode_to_keycode[level];
+    if (!keycodes) {
+        keycodes = (SDL_Keycode *)SDL_malloc(SDL_SCANCODE_COUNT * sizeof(*keycodes));
+        if (!keycodes) {
             return;
         }
-        // InsertIntoHashTable will replace the existing entry in the keymap atomically.
+        SDL_memset(keycodes, 0xFF, SDL_SCANCODE_COUNT * sizeof(*keycodes));
+        keymap->scancode_to_keycode[level] = keycodes;
     }
-    SDL_InsertIntoHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, (void *)(uintptr_t)keycode, true);
+    if (keycodes[scancode] == keycode) {
+        // We already have this mapping
+        return;
+    }
+    keycodes[scancode] = keycode;
 
-    bool update_keycode = true;
-    if (SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, &value)) {
-        const Uint32 existing_value = (Uint32)(uintptr_t)value;
-        const SDL_Keymod existing_modstate = (SDL_Keymod)(existing_value >> 16);
+    const Uint32 key = ((Uint32)modstate << 16) | scancode;
+    Uint32 existing_key;
+    if (FindKeymapScancode(keymap, keycode, &existing_key)) {
+        const SDL_Keymod existing_modstate = (SDL_Keymod)(existing_key >> 16);
 
         // Keep the simplest combination of scancode and modifiers to generate this keycode
         if (existing_modstate <= modstate) {
-            update_keycode = false;
+            return;
         }
     }
-    if (update_keycode) {
+    if (keycode < SDL_KEYMAP_DENSE_KEYS) {
+        keymap->keycode_to_scancode_dense[keycode] = key;
+    } else {
         SDL_InsertIntoHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, (void *)(uintptr_t)key, true);
     }
 }
 
 SDL_Keycode SDL_GetKeymapKeycode(SDL_Keymap *keymap, SDL_Scancode scancode, SDL_Keymod modstate)
 {
-    SDL_Keycode keycode;
-
-    const Uint32 key = ((Uint32)NormalizeModifierStateForKeymap(modstate) << 16) | scancode;
-    const void *value;
-    if (keymap && SDL_FindInHashTable(keymap->scancode_to_keycode, (void *)(uintptr_t)key, &value)) {
-        keycode = (SDL_Keycode)(uintptr_t)value;
-    } else {
-        keycode = SDL_GetDefaultKeyFromScancode(scancode, modstate);
+    if (keymap && ((int)scancode) >= SDL_SCANCODE_UNKNOWN && scancode < SDL_SCANCODE_COUNT) {
+        const SDL_Keycode *keycodes = keymap->scancode_to_keycode[GetKeymapLevel(modstate)];
+        if (keycodes && keycodes[scancode] != SDL_KEYMAP_UNMAPPED) {
+            return keycodes[scancode];
+        }
     }
-    return keycode;
+    return SDL_GetDefaultKeyFromScancode(scancode, modstate);
 }
 
 SDL_Scancode SDL_GetKeymapScancode(SDL_Keymap *keymap, SDL_Keycode keycode, SDL_Keymod *modstate)
 {
-    SDL_Scancode scancode;
-
-    const void *value;
-    if (keymap && SDL_FindInHashTable(keymap->keycode_to_scancode, (void *)(uintptr_t)keycode, &value)) {
-        scancode = (SDL_Scancode)((uintptr_t)value & 0xFFFF);
+    Uint32 key;
+    if (keymap && FindKeymapScancode(keymap, keycode, &key)) {
         if (modstate) {
-            *modstate = (SDL_Keymod)((uintptr_t)value >> 16);
+            *modstate = (SDL_Keymod)(key >> 16);
         }
-    } else {
-        scancode = SDL_GetDefaultScancodeFromKey(keycode, modstate);
+        return (SDL_Scancode)(key & 0xFFFF);
     }
-    return scancode;
+    return SDL_GetDefaultScancodeFromKey(keycode, modstate);
 }
 
 void SDL_DestroyKeymap(SDL_Keymap *keymap)
@@ -136,7 +184,9 @@ void SDL_DestroyKeymap(SDL_Keymap *keymap)
         return;
     }
 
-    SDL_DestroyHashTable(keymap->scancode_to_keycode);
+    for (int i = 0; i < SDL_arraysize(keymap->scancode_to_keycode); ++i) {
+        SDL_free(keymap->scancode_to_keycode[i]);
+    }
     SDL_DestroyHashTable(keymap->keycode_to_scancode);
     SDL_free(keymap);
 }
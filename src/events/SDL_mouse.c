@@ -830,6 +830,8 @@ static void SDL_PrivateSendMouseMotion(Uint64 timestamp, SDL_Window *window, SDL
         event.motion.y = mouse->y;
         event.motion.xrel = xrel;
         event.motion.yrel = yrel;
+        event.motion.num_history = 0;
+        event.motion.history = NULL;
         SDL_PushEvent(&event);
     }
 }
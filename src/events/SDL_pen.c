@@ -38,6 +38,9 @@ typedef struct SDL_Pen
     float y;
     SDL_PenInputFlags input_state;
     void *driverdata;
+    bool frame_pending;     // position or axes changed since the last SDL_EVENT_PEN_FRAME
+    Uint64 frame_timestamp;
+    SDL_WindowID frame_windowID;
 } SDL_Pen;
 
 // we assume there's usually 0-1 pens in most cases and this list doesn't
@@ -45,6 +48,21 @@ typedef struct SDL_Pen
 static SDL_RWLock *pen_device_rwlock = NULL;
 static SDL_Pen *pen_devices SDL_GUARDED_BY(pen_device_rwlock) = NULL;
 static int pen_device_count SDL_GUARDED_BY(pen_device_rwlock) = 0;
+static bool pen_frame_events = false;
+
+static void SDLCALL SDL_PenFrameEventsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    pen_frame_events = SDL_GetStringBoolean(hint, false);
+}
+
+static void UpdatePenFrame(SDL_Pen *pen, Uint64 timestamp, SDL_Window *window)
+{
+    if (pen_frame_events) {
+        pen->frame_pending = true;
+        pen->frame_timestamp = timestamp;
+        pen->frame_windowID = window ? window->id : 0;
+    }
+}
 
 // You must hold pen_device_rwlock before calling this, and result is only safe while lock is held!
 // If SDL isn't initialized, grabbing the NULL lock is a no-op and there will be zero devices, so
@@ -103,11 +121,14 @@ bool SDL_InitPen(void)
     if (!pen_device_rwlock) {
         return false;
     }
+    SDL_AddHintCallback(SDL_HINT_PEN_FRAME_EVENTS, SDL_PenFrameEventsChanged, NULL);
     return true;
 }
 
 void SDL_QuitPen(void)
 {
+    SDL_RemoveHintCallback(SDL_HINT_PEN_FRAME_EVENTS, SDL_PenFrameEventsChanged, NULL);
+
     SDL_DestroyRWLock(pen_device_rwlock);
     pen_device_rwlock = NULL;
     if (pen_devices) {
@@ -427,6 +448,7 @@ void SDL_SendPenAxis(Uint64 timestamp, SDL_PenID instance_id, SDL_Window *window
     if (pen) {
         if (pen->axes[axis] != value) {
             pen->axes[axis] = value;  // we could do an SDL_SetAtomicInt here if we run into trouble...
+            UpdatePenFrame(pen, timestamp, window);
             input_state = pen->input_state;
             x = pen->x;
             y = pen->y;
@@ -475,6 +497,7 @@ void SDL_SendPenMotion(Uint64 timestamp, SDL_PenID instance_id, SDL_Window *wind
         if ((pen->x != x) || (pen->y != y)) {
             pen->x = x;  // we could do an SDL_SetAtomicInt here if we run into trouble...
             pen->y = y;  // we could do an SDL_SetAtomicInt here if we run into trouble...
+            UpdatePenFrame(pen, timestamp, window);
             input_state = pen->input_state;
             send_event = true;
         }
@@ -491,6 +514,8 @@ void SDL_SendPenMotion(Uint64 timestamp, SDL_PenID instance_id, SDL_Window *wind
         event.pmotion.pen_state = input_state;
         event.pmotion.x = x;
         event.pmotion.y = y;
+        event.pmotion.num_history = 0;
+        event.pmotion.history = NULL;
         SDL_PushEvent(&event);
 
         if (window) {
@@ -515,6 +540,37 @@ void SDL_SendPenMotion(Uint64 timestamp, SDL_PenID instance_id, SDL_Window *wind
     }
 }
 
+void SDL_SendPenFrames(void)
+{
+    if (!pen_frame_events) {
+        return;
+    }
+
+    SDL_LockRWLockForReading(pen_device_rwlock);
+    for (int i = 0; i < pen_device_count; i++) {
+        SDL_Pen *pen = &pen_devices[i];
+        if (!pen->frame_pending) {
+            continue;
+        }
+        pen->frame_pending = false;
+
+        if (SDL_EventEnabled(SDL_EVENT_PEN_FRAME)) {
+            SDL_Event event;
+            SDL_zero(event);
+            event.pframe.type = SDL_EVENT_PEN_FRAME;
+            event.pframe.timestamp = pen->frame_timestamp;
+            event.pframe.windowID = pen->frame_windowID;
+            event.pframe.which = pen->instance_id;
+            event.pframe.pen_state = pen->input_state;
+            event.pframe.x = pen->x;
+            event.pframe.y = pen->y;
+            SDL_memcpy(event.pframe.axes, pen->axes, sizeof(event.pframe.axes));
+            SDL_PushEvent(&event);
+        }
+    }
+    SDL_UnlockRWLock(pen_device_rwlock);
+}
+
 void SDL_SendPenButton(Uint64 timestamp, SDL_PenID instance_id, SDL_Window *window, Uint8 button, bool down)
 {
     bool send_event = false;
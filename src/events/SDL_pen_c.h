@@ -84,6 +84,9 @@ extern SDL_PenID SDL_FindPenByHandle(void *handle);
 // Backend can optionally use this to find a SDL_PenID, selected by a callback examining all devices. Zero if not found.
 extern SDL_PenID SDL_FindPenByCallback(bool (*callback)(void *handle, void *userdata), void *userdata);
 
+// Send SDL_EVENT_PEN_FRAME events for pens that changed since the last frame.
+extern void SDL_SendPenFrames(void);
+
 // Backend can use this to query current pen status.
 SDL_PenInputFlags SDL_GetPenStatus(SDL_PenID instance_id, float *axes, int num_axes);
 
@@ -23,6 +23,7 @@
 // General touch handling code for SDL
 
 #include "SDL_events_c.h"
+#include "../SDL_hints_c.h"
 #include "../video/SDL_sysvideo.h"
 
 static int SDL_num_touch = 0;
@@ -33,9 +34,17 @@ static bool finger_touching = false;
 static SDL_FingerID track_fingerid;
 static SDL_TouchID track_touchid;
 
+static bool SDL_touch_frame_events = false;
+
+static void SDLCALL SDL_TouchFrameEventsChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_touch_frame_events = SDL_GetStringBoolean(hint, false);
+}
+
 // Public functions
 bool SDL_InitTouch(void)
 {
+    SDL_AddHintCallback(SDL_HINT_TOUCH_FRAME_EVENTS, SDL_TouchFrameEventsChanged, NULL);
     return true;
 }
 
@@ -199,6 +208,9 @@ int SDL_AddTouch(SDL_TouchID touchID, SDL_TouchDeviceType type, const char *name
     SDL_touchDevices[index]->max_fingers = 0;
     SDL_touchDevices[index]->fingers = NULL;
     SDL_touchDevices[index]->name = SDL_strdup(name ? name : "");
+    SDL_touchDevices[index]->frame_pending = false;
+    SDL_touchDevices[index]->frame_timestamp = 0;
+    SDL_touchDevices[index]->frame_windowID = 0;
 
     return index;
 }
@@ -249,6 +261,15 @@ static void SDL_DelFinger(SDL_Touch *touch, SDL_FingerID fingerid)
     }
 }
 
+static void SDL_UpdateTouchFrame(SDL_Touch *touch, Uint64 timestamp, SDL_Window *window)
+{
+    if (SDL_touch_frame_events) {
+        touch->frame_pending = true;
+        touch->frame_timestamp = timestamp;
+        touch->frame_windowID = window ? SDL_GetWindowID(window) : 0;
+    }
+}
+
 void SDL_SendTouch(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid, SDL_Window *window, SDL_EventType type, float x, float y, float pressure)
 {
     SDL_Finger *finger;
@@ -330,6 +351,7 @@ void SDL_SendTouch(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid, SDL_
         if (!SDL_AddFinger(touch, fingerid, x, y, pressure)) {
             return;
         }
+        SDL_UpdateTouchFrame(touch, timestamp, window);
 
         if (SDL_EventEnabled(type)) {
             SDL_Event event;
@@ -343,6 +365,8 @@ void SDL_SendTouch(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid, SDL_
             event.tfinger.dy = 0;
             event.tfinger.pressure = pressure;
             event.tfinger.windowID = window ? SDL_GetWindowID(window) : 0;
+            event.tfinger.num_history = 0;
+            event.tfinger.history = NULL;
             SDL_PushEvent(&event);
         }
     } else {
@@ -364,10 +388,13 @@ void SDL_SendTouch(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid, SDL_
             event.tfinger.dy = 0;
             event.tfinger.pressure = pressure;
             event.tfinger.windowID = window ? SDL_GetWindowID(window) : 0;
+            event.tfinger.num_history = 0;
+            event.tfinger.history = NULL;
             SDL_PushEvent(&event);
         }
 
         SDL_DelFinger(touch, fingerid);
+        SDL_UpdateTouchFrame(touch, timestamp, window);
     }
 }
 
@@ -441,6 +468,7 @@ void SDL_SendTouchMotion(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid
     finger->x = x;
     finger->y = y;
     finger->pressure = pressure;
+    SDL_UpdateTouchFrame(touch, timestamp, window);
 
     // Post the event, if desired
     if (SDL_EventEnabled(SDL_EVENT_FINGER_MOTION)) {
@@ -455,10 +483,47 @@ void SDL_SendTouchMotion(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid
         event.tfinger.dy = yrel;
         event.tfinger.pressure = pressure;
         event.tfinger.windowID = window ? SDL_GetWindowID(window) : 0;
+        event.tfinger.num_history = 0;
+        event.tfinger.history = NULL;
         SDL_PushEvent(&event);
     }
 }
 
+void SDL_SendTouchFrames(void)
+{
+    int i, j;
+
+    for (i = 0; i < SDL_num_touch; ++i) {
+        SDL_Touch *touch = SDL_touchDevices[i];
+        if (!touch->frame_pending) {
+            continue;
+        }
+        touch->frame_pending = false;
+
+        if (SDL_EventEnabled(SDL_EVENT_FINGER_FRAME)) {
+            SDL_Finger *fingers = NULL;
+            if (touch->num_fingers > 0) {
+                fingers = (SDL_Finger *)SDL_AllocateTemporaryMemory(touch->num_fingers * sizeof(*fingers));
+                if (!fingers) {
+                    continue;
+                }
+                for (j = 0; j < touch->num_fingers; ++j) {
+                    SDL_copyp(&fingers[j], touch->fingers[j]);
+                }
+            }
+
+            SDL_Event event;
+            event.type = SDL_EVENT_FINGER_FRAME;
+            event.common.timestamp = touch->frame_timestamp;
+            event.tframe.touchID = touch->id;
+            event.tframe.windowID = touch->frame_windowID;
+            event.tframe.num_fingers = touch->num_fingers;
+            event.tframe.fingers = fingers;
+            SDL_PushEvent(&event);
+        }
+    }
+}
+
 void SDL_DelTouch(SDL_TouchID id)
 {
     int i, index;
@@ -497,4 +562,6 @@ void SDL_QuitTouch(void)
 
     SDL_free(SDL_touchDevices);
     SDL_touchDevices = NULL;
+
+    SDL_RemoveHintCallback(SDL_HINT_TOUCH_FRAME_EVENTS, SDL_TouchFrameEventsChanged, NULL);
 }
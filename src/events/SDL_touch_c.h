@@ -31,6 +31,9 @@ typedef struct SDL_Touch
     int max_fingers;
     SDL_Finger **fingers;
     char *name;
+    bool frame_pending;         // a finger changed since the last SDL_EVENT_FINGER_FRAME
+    Uint64 frame_timestamp;
+    SDL_WindowID frame_windowID;
 } SDL_Touch;
 
 // Initialize the touch subsystem
@@ -51,6 +54,9 @@ extern void SDL_SendTouch(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingeri
 // Send a touch motion event for a touch
 extern void SDL_SendTouchMotion(Uint64 timestamp, SDL_TouchID id, SDL_FingerID fingerid, SDL_Window *window, float x, float y, float pressure);
 
+// Send SDL_EVENT_FINGER_FRAME events for touch devices that changed since the last frame
+extern void SDL_SendTouchFrames(void);
+
 // Remove a touch
 extern void SDL_DelTouch(SDL_TouchID id);
 
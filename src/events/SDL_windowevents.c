@@ -25,6 +25,7 @@
 #include "SDL_events_c.h"
 #include "SDL_eventwatch_c.h"
 #include "SDL_mouse_c.h"
+#include "../SDL_hints_c.h"
 #include "../tray/SDL_tray_utils.h"
 
 
@@ -68,6 +69,8 @@ static bool SDLCALL RemoveSupercededWindowEvents(void *userdata, SDL_Event *even
     return true;
 }
 
+static SDL_CachedHint SDL_quit_on_last_window_close_hint = SDL_CACHED_HINT(SDL_HINT_QUIT_ON_LAST_WINDOW_CLOSE, true);
+
 bool SDL_SendWindowEvent(SDL_Window *window, SDL_EventType windowevent, int data1, int data2)
 {
     bool posted = false;
@@ -290,7 +293,7 @@ bool SDL_SendWindowEvent(SDL_Window *window, SDL_EventType windowevent, int data
         }
 
         if (toplevel_count <= 1) {
-            if (SDL_GetHintBoolean(SDL_HINT_QUIT_ON_LAST_WINDOW_CLOSE, true)) {
+            if (SDL_GetCachedHintBoolean(&SDL_quit_on_last_window_close_hint)) {
                 SDL_SendQuit(); // This is the last toplevel window in the list so send the SDL_EVENT_QUIT event
             }
         }
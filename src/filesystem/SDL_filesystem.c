@@ -24,6 +24,7 @@
 #include "SDL_filesystem_c.h"
 #include "SDL_sysfilesystem.h"
 #include "../stdlib/SDL_sysstdlib.h"
+#include "../thread/SDL_jobs_c.h"
 
 bool SDL_RemovePath(const char *path)
 {
@@ -114,6 +115,18 @@ bool SDL_CreateDirectory(const char *path)
     return retval;
 }
 
+typedef struct EnumerateDirectoryData
+{
+    SDL_EnumerateDirectoryCallback callback;
+    void *userdata;
+} EnumerateDirectoryData;
+
+static SDL_EnumerationResult EnumerateDirectoryWithoutTypes(void *userdata, const char *dirname, const char *fname, SDL_PathType type)
+{
+    const EnumerateDirectoryData *data = (const EnumerateDirectoryData *) userdata;
+    return data->callback(data->userdata, dirname, fname);
+}
+
 bool SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata)
 {
     if (!path) {
@@ -121,7 +134,193 @@ bool SDL_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback cal
     } else if (!callback) {
         return SDL_InvalidParamError("callback");
     }
-    return SDL_SYS_EnumerateDirectory(path, callback, userdata);
+
+    EnumerateDirectoryData data;
+    data.callback = callback;
+    data.userdata = userdata;
+    return SDL_SYS_EnumerateDirectory(path, EnumerateDirectoryWithoutTypes, &data);
+}
+
+
+/* Walking a directory tree on the job workers. Directories waiting to be read
+   sit in a shared pile; each thread takes one, reads it, and puts any
+   subdirectories it wants to descend into back on the pile for whichever
+   thread gets there first. The walk is over once the pile is empty and no
+   thread is in the middle of a directory that could add to it. */
+
+typedef SDL_EnumerationResult (*DirectoryWalkCallback)(void *userdata, const char *dirname, const char *fname, bool *descend);
+
+typedef struct DirectoryWalkDir
+{
+    struct DirectoryWalkDir *next;
+    char *path;  // allocated along with this struct.
+} DirectoryWalkDir;
+
+typedef struct DirectoryWalk
+{
+    DirectoryWalkCallback callback;
+    void *userdata;
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+    DirectoryWalkDir *pending;
+    int busy;  // threads reading a directory right now, which might add more to `pending`.
+    SDL_AtomicInt stop;  // set once anything ends the walk early.
+    bool failed;
+    char *error;  // the first failure's message, errors are per-thread so it has to be carried back to the caller.
+} DirectoryWalk;
+
+static void StopDirectoryWalk(DirectoryWalk *walk, bool failed)
+{
+    SDL_SetAtomicInt(&walk->stop, 1);
+    SDL_LockMutex(walk->lock);
+    if (failed && !walk->failed) {
+        walk->failed = true;
+        walk->error = SDL_strdup(SDL_GetError());
+    }
+    SDL_BroadcastCondition(walk->condition);  // wake everyone up so they notice.
+    SDL_UnlockMutex(walk->lock);
+}
+
+static bool PushDirectoryWalkDir(DirectoryWalk *walk, const char *dirname, const char *fname)
+{
+    const size_t pathlen = SDL_strlen(dirname) + SDL_strlen(fname) + 1;
+    DirectoryWalkDir *dir = (DirectoryWalkDir *) SDL_malloc(sizeof (*dir) + pathlen);
+    if (!dir) {
+        return false;
+    }
+    dir->path = (char *) (dir + 1);
+    SDL_snprintf(dir->path, pathlen, "%s%s", dirname, fname);
+
+    SDL_LockMutex(walk->lock);
+    dir->next = walk->pending;
+    walk->pending = dir;
+    SDL_SignalCondition(walk->condition);
+    SDL_UnlockMutex(walk->lock);
+    return true;
+}
+
+static SDL_EnumerationResult DirectoryWalkEntry(void *userdata, const char *dirname, const char *fname, SDL_PathType type)
+{
+    DirectoryWalk *walk = (DirectoryWalk *) userdata;
+    if (SDL_GetAtomicInt(&walk->stop)) {
+        return SDL_ENUM_SUCCESS;  // something else ended the walk, so quietly stop reading this directory.
+    }
+
+    bool descend = false;
+    SDL_EnumerationResult result = walk->callback(walk->userdata, dirname, fname, &descend);
+    if ((result == SDL_ENUM_CONTINUE) && descend) {
+        if (type == SDL_PATHTYPE_NONE) {  // the platform didn't say what this is, so we have to ask.
+            char *fullpath = NULL;
+            if (SDL_asprintf(&fullpath, "%s%s", dirname, fname) < 0) {
+                result = SDL_ENUM_FAILURE;
+            } else {
+                SDL_PathInfo info;
+                if (SDL_GetPathInfo(fullpath, &info)) {
+                    type = info.type;
+                }
+                SDL_free(fullpath);
+            }
+        }
+        if ((type == SDL_PATHTYPE_DIRECTORY) && !PushDirectoryWalkDir(walk, dirname, fname)) {
+            result = SDL_ENUM_FAILURE;
+        }
+    }
+
+    if (result != SDL_ENUM_CONTINUE) {
+        StopDirectoryWalk(walk, (result == SDL_ENUM_FAILURE));
+        result = SDL_ENUM_SUCCESS;  // already recorded, don't let this directory's enumeration report it again.
+    }
+    return result;
+}
+
+static void SDLCALL DirectoryWalkJob(void *data)
+{
+    DirectoryWalk *walk = (DirectoryWalk *) data;
+
+    SDL_LockMutex(walk->lock);
+    for (;;) {
+        while (!walk->pending && walk->busy && !SDL_GetAtomicInt(&walk->stop)) {
+            SDL_WaitCondition(walk->condition, walk->lock);
+        }
+
+        DirectoryWalkDir *dir = walk->pending;
+        if (!dir || SDL_GetAtomicInt(&walk->stop)) {
+            break;  // nothing left and nobody can add more, or the walk was stopped.
+        }
+        walk->pending = dir->next;
+        walk->busy++;
+        SDL_UnlockMutex(walk->lock);
+
+        if (!SDL_SYS_EnumerateDirectory(dir->path, DirectoryWalkEntry, walk)) {
+            StopDirectoryWalk(walk, true);
+        }
+        SDL_free(dir);
+
+        SDL_LockMutex(walk->lock);
+        walk->busy--;
+    }
+    SDL_BroadcastCondition(walk->condition);  // anyone still waiting is done too.
+    SDL_UnlockMutex(walk->lock);
+}
+
+static bool WalkDirectoryTree(const char *path, DirectoryWalkCallback callback, void *userdata)
+{
+    DirectoryWalk walk;
+    SDL_zero(walk);
+    walk.callback = callback;
+    walk.userdata = userdata;
+    walk.lock = SDL_CreateMutex();
+    walk.condition = SDL_CreateCondition();
+    if (!walk.lock || !walk.condition || !PushDirectoryWalkDir(&walk, "", path)) {
+        SDL_DestroyCondition(walk.condition);
+        SDL_DestroyMutex(walk.lock);
+        return false;
+    }
+
+    void *jobs[SDL_MAX_JOB_WORKERS + 1];
+    const int num_jobs = SDL_GetNumJobWorkers() + 1;  // the calling thread takes part, too.
+    for (int i = 0; i < num_jobs; i++) {
+        jobs[i] = &walk;
+    }
+    SDL_RunJobsAndWait(DirectoryWalkJob, jobs, num_jobs);
+
+    while (walk.pending) {  // left over if the walk stopped early.
+        DirectoryWalkDir *next = walk.pending->next;
+        SDL_free(walk.pending);
+        walk.pending = next;
+    }
+
+    const bool result = !walk.failed;
+    if (walk.error) {
+        if (*walk.error) {  // a callback might have failed without setting an error, keep whatever this thread had then.
+            SDL_SetError("%s", walk.error);
+        }
+        SDL_free(walk.error);
+    }
+    SDL_DestroyCondition(walk.condition);
+    SDL_DestroyMutex(walk.lock);
+    return result;
+}
+
+static SDL_EnumerationResult EnumerateDirectoryRecursiveCallback(void *userdata, const char *dirname, const char *fname, bool *descend)
+{
+    const EnumerateDirectoryData *data = (const EnumerateDirectoryData *) userdata;
+    *descend = true;
+    return data->callback(data->userdata, dirname, fname);
+}
+
+bool SDL_EnumerateDirectoryRecursive(const char *path, SDL_EnumerateDirectoryCallback callback, void *userdata)
+{
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    } else if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    EnumerateDirectoryData data;
+    data.callback = callback;
+    data.userdata = userdata;
+    return WalkDirectoryTree(path, EnumerateDirectoryRecursiveCallback, &data);
 }
 
 bool SDL_GetPathInfo(const char *path, SDL_PathInfo *info)
@@ -140,70 +339,35 @@ bool SDL_GetPathInfo(const char *path, SDL_PathInfo *info)
     return SDL_SYS_GetPathInfo(path, info);
 }
 
-static bool EverythingMatch(const char *pattern, const char *str, bool *matched_to_dir)
-{
-    SDL_assert(pattern == NULL);
-    SDL_assert(str != NULL);
-    SDL_assert(matched_to_dir != NULL);
-
-    *matched_to_dir = true;
-    return true;  // everything matches!
-}
-
-// this is just '*' and '?', with '/' matching nothing.
-static bool WildcardMatch(const char *pattern, const char *str, bool *matched_to_dir)
+// this is just '*' and '?', matched against a single path element, so there's no '/' to worry about.
+static bool WildcardMatch(const char *pattern, const char *str)
 {
     SDL_assert(pattern != NULL);
     SDL_assert(str != NULL);
-    SDL_assert(matched_to_dir != NULL);
 
     const char *str_backtrack = NULL;
     const char *pattern_backtrack = NULL;
-    char sch_backtrack = 0;
-    char sch = *str;
-    char pch = *pattern;
 
-    while (sch) {
-        if (pch == '*') {
-            str_backtrack = str;
+    while (*str) {
+        if (*pattern == '*') {
             pattern_backtrack = ++pattern;
-            sch_backtrack = sch;
-            pch = *pattern;
-        } else if (pch == sch) {
-            if (pch == '/') {
-                str_backtrack = pattern_backtrack = NULL;
-            }
-            sch = *(++str);
-            pch = *(++pattern);
-        } else if ((pch == '?') && (sch != '/')) {  // end of string (checked at `while`) or path separator do not match '?'.
-            sch = *(++str);
-            pch = *(++pattern);
-        } else if (!pattern_backtrack || (sch_backtrack == '/')) { // we didn't have a match. Are we in a '*' and NOT on a path separator? Keep going. Otherwise, fail.
-            *matched_to_dir = false;
-            return false;
-        } else {  // still here? Wasn't a match, but we're definitely in a '*' pattern.
-            str = ++str_backtrack;
+            str_backtrack = str;
+        } else if ((*pattern == *str) || (*pattern == '?')) {
+            pattern++;
+            str++;
+        } else if (pattern_backtrack) {  // still in a '*'? Let it swallow one more character and try again.
             pattern = pattern_backtrack;
-            sch_backtrack = sch;
-            sch = *str;
-            pch = *pattern;
-        }
-
-        #ifdef SDL_PLATFORM_WINDOWS
-        if (sch == '\\') {
-            sch = '/';
+            str = ++str_backtrack;
+        } else {
+            return false;
         }
-        #endif
     }
 
     // '*' at the end can be ignored, they are allowed to match nothing.
-    while (pch == '*') {
-        pch = *(++pattern);
+    while (*pattern == '*') {
+        pattern++;
     }
-
-    *matched_to_dir = ((pch == '/') || (pch == '\0'));  // end of string and the pattern is complete or failed at a '/'? We should descend into this directory.
-
-    return (pch == '\0');  // survived the whole pattern? That's a match!
+    return (*pattern == '\0');  // survived the whole pattern? That's a match!
 }
 
 
@@ -286,62 +450,194 @@ static char *CaseFoldUtf8String(const char *fname)
 }
 
 
-typedef struct GlobDirCallbackData
+// Patterns are split up into their path elements once per glob, and an entry is only ever matched against the element for its depth.
+typedef enum GlobElementType
+{
+    GLOB_ELEMENT_ANYTHING,  // nothing but '*', so there's no need to look at the name at all.
+    GLOB_ELEMENT_LITERAL,   // no wildcards, a plain string compare.
+    GLOB_ELEMENT_WILDCARD
+} GlobElementType;
+
+typedef struct GlobElement
 {
-    bool (*matcher)(const char *pattern, const char *str, bool *matched_to_dir);
+    GlobElementType type;
     const char *pattern;
+} GlobElement;
+
+typedef struct GlobDirCallbackData
+{
+    GlobElement *elements;  // NULL if there's no pattern, and everything matches.
+    int num_elements;
+    char *pattern_storage;
     int num_entries;
     SDL_GlobFlags flags;
     SDL_GlobEnumeratorFunc enumerator;
     SDL_GlobGetPathInfoFunc getpathinfo;
     void *fsuserdata;
     size_t basedirlen;
+    SDL_Mutex *lock;  // protects string_stream and num_entries, entries can come from several threads at once.
     SDL_IOStream *string_stream;
 } GlobDirCallbackData;
 
-static SDL_EnumerationResult SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+static bool CompileGlobPattern(GlobDirCallbackData *data, const char *pattern)
 {
-    SDL_assert(userdata != NULL);
-    SDL_assert(dirname != NULL);
-    SDL_assert(fname != NULL);
+    data->pattern_storage = SDL_strdup(pattern);
+    if (!data->pattern_storage) {
+        return false;
+    }
 
-    //SDL_Log("GlobDirectoryCallback('%s', '%s')", dirname, fname);
+    int num_elements = 1;
+    for (const char *ptr = pattern; *ptr; ptr++) {
+        if (*ptr == '/') {
+            num_elements++;
+        }
+    }
 
-    GlobDirCallbackData *data = (GlobDirCallbackData *) userdata;
+    data->elements = (GlobElement *) SDL_malloc(num_elements * sizeof (GlobElement));
+    if (!data->elements) {
+        return false;
+    }
 
-    // !!! FIXME: if we're careful, we can keep a single buffer in `data` that we push and pop paths off the end of as we walk the tree,
-    // !!! FIXME: and only casefold the new pieces instead of allocating and folding full paths for all of this.
+    char *element = data->pattern_storage;
+    for (int i = 0; i < num_elements; i++) {
+        char *end = SDL_strchr(element, '/');
+        if (end) {
+            *end = '\0';
+        }
 
-    char *fullpath = NULL;
-    if (SDL_asprintf(&fullpath, "%s%s", dirname, fname) < 0) {
-        return SDL_ENUM_FAILURE;
-    }
+        const char *nonstar = element;
+        while (*nonstar == '*') {
+            nonstar++;
+        }
 
-    char *folded = NULL;
-    if (data->flags & SDL_GLOB_CASEINSENSITIVE) {
-        folded = CaseFoldUtf8String(fullpath);
-        if (!folded) {
-            return SDL_ENUM_FAILURE;
+        GlobElement *glob = &data->elements[i];
+        glob->pattern = element;
+        if (*element && !*nonstar) {
+            glob->type = GLOB_ELEMENT_ANYTHING;
+        } else if (SDL_strpbrk(element, "*?")) {
+            glob->type = GLOB_ELEMENT_WILDCARD;
+        } else {
+            glob->type = GLOB_ELEMENT_LITERAL;
         }
+
+        element = end ? (end + 1) : NULL;
     }
 
-    bool matched_to_dir = false;
-    const bool matched = data->matcher(data->pattern, (folded ? folded : fullpath) + data->basedirlen, &matched_to_dir);
-    //SDL_Log("GlobDirectoryCallback: Considered %spath='%s' vs pattern='%s': %smatched (matched_to_dir=%s)", folded ? "(folded) " : "", (folded ? folded : fullpath) + data->basedirlen, data->pattern, matched ? "" : "NOT ", matched_to_dir ? "TRUE" : "FALSE");
-    SDL_free(folded);
+    data->num_elements = num_elements;
+    return true;
+}
+
+static bool MatchGlobElement(const GlobElement *glob, const char *fname)
+{
+    switch (glob->type) {
+    case GLOB_ELEMENT_ANYTHING: return true;
+    case GLOB_ELEMENT_LITERAL: return (SDL_strcmp(glob->pattern, fname) == 0);
+    case GLOB_ELEMENT_WILDCARD: return WildcardMatch(glob->pattern, fname);
+    }
+    return false;
+}
+
+static bool IsGlobPathSeparator(char ch)
+{
+    #ifdef SDL_PLATFORM_WINDOWS
+    if (ch == '\\') {
+        return true;
+    }
+    #endif
+    return (ch == '/');
+}
+
+// Decide if an entry is a match, and if it's worth looking inside it. `dirname` has to start with the base directory we're globbing.
+static SDL_EnumerationResult GlobDirectoryEntry(GlobDirCallbackData *data, const char *dirname, const char *fname, bool *descend)
+{
+    const char *subdir = dirname + data->basedirlen;
+    bool matched = true;
+    *descend = true;
+
+    if (data->elements) {
+        int depth = 0;
+        for (const char *ptr = subdir; *ptr; ptr++) {
+            if (IsGlobPathSeparator(*ptr)) {
+                depth++;
+            }
+        }
+
+        if (depth >= data->num_elements) {
+            *descend = false;  // can't happen unless the enumerator ignored us, but deeper than the pattern can never match.
+            return SDL_ENUM_CONTINUE;
+        }
+
+        // almost every filename is plain ASCII, which can be folded on the stack without decoding anything.
+        char asciibuf[256];
+        char *folded = NULL;
+        const char *name = fname;
+        if (data->flags & SDL_GLOB_CASEINSENSITIVE) {
+            size_t i;
+            for (i = 0; fname[i] && ((Uint8) fname[i] < 0x80) && (i < (sizeof (asciibuf) - 1)); i++) {
+                asciibuf[i] = (char) SDL_tolower((unsigned char) fname[i]);
+            }
+            if (fname[i] == '\0') {
+                asciibuf[i] = '\0';
+                name = asciibuf;
+            } else {
+                folded = CaseFoldUtf8String(fname);
+                if (!folded) {
+                    return SDL_ENUM_FAILURE;
+                }
+                name = folded;
+            }
+        }
+
+        matched = MatchGlobElement(&data->elements[depth], name);
+        //SDL_Log("GlobDirectoryEntry: Considered %s'%s' at depth %d vs pattern='%s': %smatched", folded ? "(folded) " : "", name, depth, data->elements[depth].pattern, matched ? "" : "NOT ");
+        SDL_free(folded);
+
+        *descend = matched && (depth < (data->num_elements - 1));
+        matched = matched && (depth == (data->num_elements - 1));
+    }
 
     if (matched) {
-        const char *subpath = fullpath + data->basedirlen;
-        const size_t slen = SDL_strlen(subpath) + 1;
-        if (SDL_WriteIO(data->string_stream, subpath, slen) != slen) {
-            SDL_free(fullpath);
+        const size_t subdirlen = SDL_strlen(subdir);
+        const size_t fnamelen = SDL_strlen(fname) + 1;
+        SDL_LockMutex(data->lock);
+        const bool okay = (SDL_WriteIO(data->string_stream, subdir, subdirlen) == subdirlen) &&
+                          (SDL_WriteIO(data->string_stream, fname, fnamelen) == fnamelen);
+        if (okay) {
+            data->num_entries++;
+        }
+        SDL_UnlockMutex(data->lock);
+        if (!okay) {
             return SDL_ENUM_FAILURE;  // stop enumerating, return failure to the app.
         }
-        data->num_entries++;
     }
 
-    SDL_EnumerationResult result = SDL_ENUM_CONTINUE;  // keep enumerating by default.
-    if (matched_to_dir) {
+    return SDL_ENUM_CONTINUE;
+}
+
+static SDL_EnumerationResult GlobDirectoryWalkCallback(void *userdata, const char *dirname, const char *fname, bool *descend)
+{
+    return GlobDirectoryEntry((GlobDirCallbackData *) userdata, dirname, fname, descend);
+}
+
+// This is for enumerators that can't run on the job workers (like SDL_Storage): one directory at a time, on this thread.
+static SDL_EnumerationResult SDLCALL GlobDirectoryCallback(void *userdata, const char *dirname, const char *fname)
+{
+    SDL_assert(userdata != NULL);
+    SDL_assert(dirname != NULL);
+    SDL_assert(fname != NULL);
+
+    //SDL_Log("GlobDirectoryCallback('%s', '%s')", dirname, fname);
+
+    GlobDirCallbackData *data = (GlobDirCallbackData *) userdata;
+
+    bool descend = false;
+    SDL_EnumerationResult result = GlobDirectoryEntry(data, dirname, fname, &descend);
+    if ((result == SDL_ENUM_CONTINUE) && descend) {
+        char *fullpath = NULL;
+        if (SDL_asprintf(&fullpath, "%s%s", dirname, fname) < 0) {
+            return SDL_ENUM_FAILURE;
+        }
+
         SDL_PathInfo info;
         if (data->getpathinfo(fullpath, &info, data->fsuserdata) && (info.type == SDL_PATHTYPE_DIRECTORY)) {
             //SDL_Log("GlobDirectoryCallback: Descending into subdir '%s'", fname);
@@ -349,10 +645,9 @@ static SDL_EnumerationResult SDLCALL GlobDirectoryCallback(void *userdata, const
                 result = SDL_ENUM_FAILURE;
             }
         }
+        SDL_free(fullpath);
     }
 
-    SDL_free(fullpath);
-
     return result;
 }
 
@@ -400,34 +695,48 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
 
     GlobDirCallbackData data;
     SDL_zero(data);
-    data.string_stream = SDL_IOFromDynamicMem();
-    if (!data.string_stream) {
-        SDL_free(folded);
-        SDL_free(pathcpy);
-        return NULL;
-    }
-
-    if (!pattern) {
-        data.matcher = EverythingMatch;  // no pattern? Everything matches.
 
     // !!! FIXME
-    //} else if (flags & SDL_GLOB_GITIGNORE) {
+    //if (flags & SDL_GLOB_GITIGNORE) {
     //    data.matcher = GitIgnoreMatch;
+    //}
 
-    } else {
-        data.matcher = WildcardMatch;
+    bool okay = true;
+    if (pattern) {  // no pattern? Everything matches, and `elements` stays NULL.
+        okay = CompileGlobPattern(&data, folded ? folded : pattern);
+    }
+    SDL_free(folded);
+
+    if (okay) {
+        data.lock = SDL_CreateMutex();
+        data.string_stream = data.lock ? SDL_IOFromDynamicMem() : NULL;
+        okay = (data.string_stream != NULL);
+    }
+
+    if (!okay) {
+        SDL_DestroyMutex(data.lock);
+        SDL_free(data.elements);
+        SDL_free(data.pattern_storage);
+        SDL_free(pathcpy);
+        return NULL;
     }
 
-    data.pattern = folded ? folded : pattern;
     data.flags = flags;
     data.enumerator = enumerator;
     data.getpathinfo = getpathinfo;
     data.fsuserdata = userdata;
     data.basedirlen = *path ? (SDL_strlen(path) + 1) : 0;  // +1 for the '/' we'll be adding.
 
+    // without an enumerator, this is the real filesystem, which can be walked on the job workers.
+    bool enumerated;
+    if (enumerator) {
+        enumerated = enumerator(path, GlobDirectoryCallback, &data, userdata);
+    } else {
+        enumerated = WalkDirectoryTree(path, GlobDirectoryWalkCallback, &data);
+    }
 
     char **result = NULL;
-    if (data.enumerator(path, GlobDirectoryCallback, &data, data.fsuserdata)) {
+    if (enumerated) {
         const size_t streamlen = (size_t) SDL_GetIOSize(data.string_stream);
         const size_t buflen = streamlen + ((data.num_entries + 1) * sizeof (char *));  // +1 for NULL terminator at end of array.
         result = (char **) SDL_malloc(buflen);
@@ -449,26 +758,18 @@ char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_Glob
     }
 
     SDL_CloseIO(data.string_stream);
-    SDL_free(folded);
+    SDL_DestroyMutex(data.lock);
+    SDL_free(data.elements);
+    SDL_free(data.pattern_storage);
     SDL_free(pathcpy);
 
     return result;
 }
 
-static bool GlobDirectoryGetPathInfo(const char *path, SDL_PathInfo *info, void *userdata)
-{
-    return SDL_GetPathInfo(path, info);
-}
-
-static bool GlobDirectoryEnumerator(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata)
-{
-    return SDL_EnumerateDirectory(path, cb, cbuserdata);
-}
-
 char **SDL_GlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count)
 {
     //SDL_Log("SDL_GlobDirectory('%s', '%s') ...", path, pattern);
-    return SDL_InternalGlobDirectory(path, pattern, flags, count, GlobDirectoryEnumerator, GlobDirectoryGetPathInfo, NULL);
+    return SDL_InternalGlobDirectory(path, pattern, flags, count, NULL, NULL, NULL);
 }
 
 
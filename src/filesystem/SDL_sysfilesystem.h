@@ -28,7 +28,11 @@ extern char *SDL_SYS_GetPrefPath(const char *org, const char *app);
 extern char *SDL_SYS_GetUserFolder(SDL_Folder folder);
 extern char *SDL_SYS_GetCurrentDirectory(void);
 
-extern bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback cb, void *userdata);
+// Like SDL_EnumerateDirectoryCallback, plus the entry's type when the platform hands it out with the name.
+// `type` is SDL_PATHTYPE_NONE when it isn't known (symlinks, some filesystems), and the caller has to ask SDL_SYS_GetPathInfo().
+typedef SDL_EnumerationResult (*SDL_SYS_EnumerateDirectoryCallback)(void *userdata, const char *dirname, const char *fname, SDL_PathType type);
+
+extern bool SDL_SYS_EnumerateDirectory(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata);
 extern bool SDL_SYS_RemovePath(const char *path);
 extern bool SDL_SYS_RenamePath(const char *oldpath, const char *newpath);
 extern bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath);
@@ -37,6 +41,7 @@ extern bool SDL_SYS_GetPathInfo(const char *path, SDL_PathInfo *info);
 
 typedef bool (*SDL_GlobEnumeratorFunc)(const char *path, SDL_EnumerateDirectoryCallback cb, void *cbuserdata, void *userdata);
 typedef bool (*SDL_GlobGetPathInfoFunc)(const char *path, SDL_PathInfo *info, void *userdata);
+// Pass NULL for `enumerator` and `getpathinfo` to glob the real filesystem, which is walked on the job workers.
 extern char **SDL_InternalGlobDirectory(const char *path, const char *pattern, SDL_GlobFlags flags, int *count, SDL_GlobEnumeratorFunc enumerator, SDL_GlobGetPathInfoFunc getpathinfo, void *userdata);
 
 #endif
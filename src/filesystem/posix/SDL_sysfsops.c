@@ -32,10 +32,41 @@
 #include <string.h>
 #include <errno.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
-bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback cb, void *userdata)
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <linux/fs.h>
+#elif defined(SDL_PLATFORM_APPLE)
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#endif
+
+#ifndef O_CLOEXEC
+#define O_CLOEXEC 0
+#endif
+
+// readdir() usually knows what each entry is, which saves a stat() per entry when walking a tree.
+static SDL_PathType GetDirentPathType(const struct dirent *ent)
+{
+#ifdef DT_DIR
+    switch (ent->d_type) {
+    case DT_DIR: return SDL_PATHTYPE_DIRECTORY;
+    case DT_REG: return SDL_PATHTYPE_FILE;
+    case DT_UNKNOWN: return SDL_PATHTYPE_NONE;
+    case DT_LNK: return SDL_PATHTYPE_NONE;  // SDL_GetPathInfo follows symlinks, so let it decide.
+    default: return SDL_PATHTYPE_OTHER;
+    }
+#else
+    return SDL_PATHTYPE_NONE;
+#endif
+}
+
+bool SDL_SYS_EnumerateDirectory(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata)
 {
     char *pathwithsep = NULL;
     int pathwithseplen = SDL_asprintf(&pathwithsep, "%s/", path);
@@ -66,7 +97,7 @@ bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback
         if ((SDL_strcmp(name, ".") == 0) || (SDL_strcmp(name, "..") == 0)) {
             continue;
         }
-        result = cb(userdata, pathwithsep, name);
+        result = cb(userdata, pathwithsep, name, GetDirentPathType(ent));
     }
 
     closedir(dir);
@@ -97,12 +128,149 @@ bool SDL_SYS_RenamePath(const char *oldpath, const char *newpath)
     return true;
 }
 
-bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
+#define SDL_COPY_BUFFER_SIZE (1024 * 1024)
+
+// Copy whatever is left of src to dst through a buffer, the way every platform can.
+static bool SDL_CopyFileBuffered(int src, int dst)
+{
+#ifdef POSIX_FADV_SEQUENTIAL
+    // Ask for aggressive read-ahead, this is only a hint so failure doesn't matter
+    (void)posix_fadvise(src, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    char *buffer = (char *)SDL_malloc(SDL_COPY_BUFFER_SIZE);
+    if (!buffer) {
+        return false;
+    }
+
+    bool result = true;
+    for (;;) {
+        ssize_t len = read(src, buffer, SDL_COPY_BUFFER_SIZE);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            result = SDL_SetError("Can't read file: %s", strerror(errno));
+            break;
+        } else if (len == 0) {
+            break;
+        }
+
+        for (ssize_t written = 0; written < len; ) {
+            const ssize_t rc = write(dst, buffer + written, (size_t)(len - written));
+            if (rc < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                result = SDL_SetError("Can't write file: %s", strerror(errno));
+                break;
+            }
+            written += rc;
+        }
+        if (!result) {
+            break;
+        }
+    }
+
+    SDL_free(buffer);
+    return result;
+}
+
+/* Let the OS copy the data without bringing it through userspace, and
+   share the blocks outright if the filesystem supports it. This sets
+   *complete if the whole file was copied, otherwise the rest should be
+   copied with SDL_CopyFileBuffered(), starting from the current offsets. */
+static bool SDL_CopyFileKernel(int src, int dst, bool *complete)
+{
+    *complete = false;
+
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    struct stat statbuf;
+
+    // Files in places like /proc claim to be empty, and the kernel won't copy those
+    if (fstat(src, &statbuf) < 0 || !S_ISREG(statbuf.st_mode) || statbuf.st_size == 0) {
+        return true;
+    }
+
+#ifdef FICLONE
+    // A reflink on Btrfs, XFS and friends, which shares the source's blocks until either is written to
+    if (ioctl(dst, FICLONE, src) == 0) {
+        *complete = true;
+        return true;
+    }
+#endif
+
+    const size_t chunk = 1024 * 1024 * 1024;
+    bool copied = false;
+
+#ifdef __NR_copy_file_range
+    for (;;) {
+        const ssize_t rc = (ssize_t)syscall(__NR_copy_file_range, src, NULL, dst, NULL, chunk, 0);
+        if (rc > 0) {
+            copied = true;
+        } else if (rc == 0) {
+            *complete = true;
+            return true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (!copied && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP || errno == EPERM)) {
+            break;  // not supported between these files, try something else.
+        } else {
+            return SDL_SetError("Can't copy file: %s", strerror(errno));
+        }
+    }
+#endif
+
+    for (;;) {
+        const ssize_t rc = sendfile(dst, src, NULL, chunk);
+        if (rc > 0) {
+            copied = true;
+        } else if (rc == 0) {
+            *complete = true;
+            return true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (!copied && (errno == ENOSYS || errno == EINVAL)) {
+            return true;
+        } else {
+            return SDL_SetError("Can't copy file: %s", strerror(errno));
+        }
+    }
+#elif defined(SDL_PLATFORM_APPLE)
+    if (fcopyfile(src, dst, NULL, COPYFILE_DATA) < 0) {
+        return SDL_SetError("Can't copy file: %s", strerror(errno));
+    }
+    *complete = true;
+    return true;
+#else
+    (void)src;
+    (void)dst;
+    return true;
+#endif
+}
+
+static int SDL_SyncFile(int fd)
+{
+    int result = 0;
+
+#if defined(SDL_PLATFORM_APPLE)  // Apple doesn't have fdatasync (rather, the symbol exists as an incompatible system call).
+    result = fcntl(fd, F_FULLFSYNC);
+#elif defined(SDL_PLATFORM_HAIKU)
+    result = fsync(fd);
+#elif defined(HAVE_FDATASYNC)
+    result = fdatasync(fd);
+#endif
+    return result;
+}
+
+#ifdef SDL_PLATFORM_ANDROID
+// Relative paths on Android may name assets inside the APK, which only SDL_IOFromFile() can open.
+static bool SDL_CopyFileWithIO(const char *oldpath, const char *newpath)
 {
     char *buffer = NULL;
     SDL_IOStream *input = NULL;
     SDL_IOStream *output = NULL;
-    const size_t maxlen = 4096;
+    const size_t maxlen = SDL_COPY_BUFFER_SIZE;
     size_t len;
     bool result = false;
 
@@ -151,6 +319,56 @@ done:
 
     return result;
 }
+#endif // SDL_PLATFORM_ANDROID
+
+bool SDL_SYS_CopyFile(const char *oldpath, const char *newpath)
+{
+#ifdef SDL_PLATFORM_ANDROID
+    if (*oldpath != '/') {
+        return SDL_CopyFileWithIO(oldpath, newpath);
+    }
+#elif defined(SDL_PLATFORM_APPLE)
+    // A clone on APFS shares the source's blocks and is nearly instant, but it can't replace an existing file
+    if (clonefile(oldpath, newpath, 0) == 0) {
+        return true;
+    }
+#endif
+
+    const int src = open(oldpath, O_RDONLY | O_CLOEXEC);
+    if (src < 0) {
+        return SDL_SetError("Couldn't open %s: %s", oldpath, strerror(errno));
+    }
+
+    const int dst = open(newpath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (dst < 0) {
+        SDL_SetError("Couldn't open %s: %s", newpath, strerror(errno));
+        close(src);
+        return false;
+    }
+
+    bool complete = false;
+    bool result = SDL_CopyFileKernel(src, dst, &complete);
+    if (result && !complete) {
+        result = SDL_CopyFileBuffered(src, dst);
+    }
+    close(src);
+
+    if (result) {
+        int rc;
+        do {
+            rc = SDL_SyncFile(dst);
+        } while (rc < 0 && errno == EINTR);
+
+        // We get EINVAL when the destination can't be synchronized, like a pipe
+        if (rc < 0 && errno != EINVAL) {
+            result = SDL_SetError("Can't sync file: %s", strerror(errno));
+        }
+    }
+    if (close(dst) < 0 && result) {
+        result = SDL_SetError("Can't close file: %s", strerror(errno));
+    }
+    return result;
+}
 
 bool SDL_SYS_CreateDirectory(const char *path)
 {
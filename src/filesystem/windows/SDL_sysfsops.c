@@ -29,7 +29,7 @@
 #include "../../core/windows/SDL_windows.h"
 #include "../SDL_sysfilesystem.h"
 
-bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback cb, void *userdata)
+bool SDL_SYS_EnumerateDirectory(const char *path, SDL_SYS_EnumerateDirectoryCallback cb, void *userdata)
 {
     SDL_EnumerationResult result = SDL_ENUM_CONTINUE;
     if (*path == '\0') {  // if empty (completely at the root), we need to enumerate drive letters.
@@ -38,7 +38,7 @@ bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback
         for (int i = 'A'; (result == SDL_ENUM_CONTINUE) && (i <= 'Z'); i++) {
             if (drives & (1 << (i - 'A'))) {
                 name[0] = (char) i;
-                result = cb(userdata, "", name);
+                result = cb(userdata, "", name, SDL_PATHTYPE_DIRECTORY);
             }
         }
     } else {
@@ -68,8 +68,9 @@ bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback
 
         pattern[--patternlen] = '\0';  // chop off the '*' so we just have the dirname with a path separator.
 
+        // FindExInfoBasic skips the short 8.3 names we never use, and a large fetch pulls in more entries per trip to the kernel.
         WIN32_FIND_DATAW entw;
-        HANDLE dir = FindFirstFileExW(wpattern, FindExInfoStandard, &entw, FindExSearchNameMatch, NULL, 0);
+        HANDLE dir = FindFirstFileExW(wpattern, FindExInfoBasic, &entw, FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
         SDL_free(wpattern);
         if (dir == INVALID_HANDLE_VALUE) {
             SDL_free(pattern);
@@ -89,7 +90,13 @@ bool SDL_SYS_EnumerateDirectory(const char *path, SDL_EnumerateDirectoryCallback
             if (!utf8fn) {
                 result = SDL_ENUM_FAILURE;
             } else {
-                result = cb(userdata, pattern, utf8fn);
+                SDL_PathType type = SDL_PATHTYPE_FILE;
+                if (entw.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+                    type = SDL_PATHTYPE_NONE;  // links and junctions, SDL_GetPathInfo decides what they point to.
+                } else if (entw.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                    type = SDL_PATHTYPE_DIRECTORY;
+                }
+                result = cb(userdata, pattern, utf8fn, type);
                 SDL_free(utf8fn);
             }
         } while ((result == SDL_ENUM_CONTINUE) && (FindNextFileW(dir, &entw) != 0));
@@ -20,6 +20,10 @@
 */
 #include "SDL_internal.h"
 #include "SDL_sysgpu.h"
+#include "../stdlib/SDL_sysstdlib.h"
+#include "../SDL_memoryusage_c.h"
+#include "../SDL_trace_c.h"
+#include "../video/SDL_pixels_c.h"
 
 // FIXME: This could probably use SDL_ObjectValid
 #define CHECK_DEVICE_MAGIC(device, retval)  \
@@ -55,6 +59,14 @@
         return retval;                                                          \
     }
 
+#define CHECK_QUEUE_TYPE(allowed, msg, retval)                            \
+    if (!(allowed)) {                                                     \
+        SDL_assert_release(!msg);                                         \
+        return retval;                                                    \
+    }
+
+#define QUEUE_TYPE ((CommandBufferCommonHeader *)command_buffer)->queue_type
+
 #define CHECK_RENDERPASS                                     \
     if (!((RenderPass *)render_pass)->in_progress) {                 \
         SDL_assert_release(!"Render pass not in progress!"); \
@@ -99,6 +111,12 @@
         return;                                                                         \
     }
 
+#define CHECK_MESH_PIPELINE_BOUND                                                                          \
+    if (!((GraphicsPipelineCommonHeader *)((RenderPass *)render_pass)->graphics_pipeline)->mesh_pipeline) { \
+        SDL_assert_release(!"Bound graphics pipeline is not a mesh pipeline!");                            \
+        return;                                                                                            \
+    }
+
 #define CHECK_COMPUTEPASS                                     \
     if (!((Pass *)compute_pass)->in_progress) {                 \
         SDL_assert_release(!"Compute pass not in progress!"); \
@@ -192,6 +210,26 @@
 #define COPYPASS_DEVICE \
     ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->device
 
+// Builds with SDL_GPU_NO_VALIDATION never check API usage, even in debug mode
+#ifdef SDL_GPU_NO_VALIDATION
+#define GPU_DEBUG_MODE(device) false
+#else
+#define GPU_DEBUG_MODE(device) ((device)->debug_mode)
+#endif
+
+// Per command buffer statistics, added to the device totals on submission
+#define COMMAND_BUFFER_STATS \
+    ((CommandBufferCommonHeader *)command_buffer)->stats
+
+#define RENDERPASS_STATS \
+    ((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->stats
+
+#define COMPUTEPASS_STATS \
+    ((CommandBufferCommonHeader *)COMPUTEPASS_COMMAND_BUFFER)->stats
+
+#define COPYPASS_STATS \
+    ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->stats
+
 static bool TextureFormatIsComputeWritable[] = {
     false, // INVALID
     false, // A8_UNORM
@@ -339,15 +377,27 @@ SDL_GPUGraphicsPipeline *SDL_GPU_FetchBlitPipeline(
     SDL_GPUGraphicsPipelineCreateInfo blit_pipeline_create_info;
     SDL_GPUColorTargetDescription color_target_desc;
     SDL_GPUGraphicsPipeline *pipeline;
+    Uint32 low, high;
 
     if (blit_pipeline_count == NULL) {
         // use pre-created, format-agnostic pipelines
         return (*blit_pipelines)[source_texture_type].pipeline;
     }
 
-    for (Uint32 i = 0; i < *blit_pipeline_count; i += 1) {
-        if ((*blit_pipelines)[i].type == source_texture_type && (*blit_pipelines)[i].format == destination_format) {
-            return (*blit_pipelines)[i].pipeline;
+    // Binary search the sorted cache, leaving the insertion point in 'low'
+    low = 0;
+    high = *blit_pipeline_count;
+    while (low < high) {
+        Uint32 mid = low + (high - low) / 2;
+        BlitPipelineCacheEntry *entry = &(*blit_pipelines)[mid];
+        if (entry->type == source_texture_type && entry->format == destination_format) {
+            return entry->pipeline;
+        }
+        if (entry->type < source_texture_type ||
+            (entry->type == source_texture_type && entry->format < destination_format)) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
 
@@ -398,17 +448,36 @@ SDL_GPUGraphicsPipeline *SDL_GPU_FetchBlitPipeline(
         *blit_pipeline_capacity,
         *blit_pipeline_capacity * 2);
 
-    (*blit_pipelines)[*blit_pipeline_count].pipeline = pipeline;
-    (*blit_pipelines)[*blit_pipeline_count].type = source_texture_type;
-    (*blit_pipelines)[*blit_pipeline_count].format = destination_format;
+    SDL_memmove(
+        &(*blit_pipelines)[low + 1],
+        &(*blit_pipelines)[low],
+        (*blit_pipeline_count - low) * sizeof(BlitPipelineCacheEntry));
+    (*blit_pipelines)[low].pipeline = pipeline;
+    (*blit_pipelines)[low].type = source_texture_type;
+    (*blit_pipelines)[low].format = destination_format;
     *blit_pipeline_count += 1;
 
     return pipeline;
 }
 
+static bool SDL_GPU_BlitSharesRenderPass(
+    const SDL_GPUBlitInfo *previous,
+    const SDL_GPUBlitInfo *info)
+{
+    /* A clear or a cycle has to happen at the start of a pass, so only blits
+     * that load (or don't care about) the existing contents of the same
+     * subresource can join the previous blit's pass. */
+    return info->destination.texture == previous->destination.texture &&
+           info->destination.mip_level == previous->destination.mip_level &&
+           info->destination.layer_or_depth_plane == previous->destination.layer_or_depth_plane &&
+           info->load_op != SDL_GPU_LOADOP_CLEAR &&
+           !info->cycle;
+}
+
 void SDL_GPU_BlitCommon(
     SDL_GPUCommandBuffer *command_buffer,
-    const SDL_GPUBlitInfo *info,
+    const SDL_GPUBlitInfo *infos,
+    Uint32 num_infos,
     SDL_GPUSampler *blit_linear_sampler,
     SDL_GPUSampler *blit_nearest_sampler,
     SDL_GPUShader *blit_vertex_shader,
@@ -422,99 +491,120 @@ void SDL_GPU_BlitCommon(
     Uint32 *blit_pipeline_capacity)
 {
     CommandBufferCommonHeader *cmdbufHeader = (CommandBufferCommonHeader *)command_buffer;
-    SDL_GPURenderPass *render_pass;
-    TextureCommonHeader *src_header = (TextureCommonHeader *)info->source.texture;
-    TextureCommonHeader *dst_header = (TextureCommonHeader *)info->destination.texture;
-    SDL_GPUGraphicsPipeline *blit_pipeline;
-    SDL_GPUColorTargetInfo color_target_info;
-    SDL_GPUViewport viewport;
-    SDL_GPUTextureSamplerBinding texture_sampler_binding;
-    BlitFragmentUniforms blit_fragment_uniforms;
-    Uint32 layer_divisor;
-
-    blit_pipeline = SDL_GPU_FetchBlitPipeline(
-        cmdbufHeader->device,
-        src_header->info.type,
-        dst_header->info.format,
-        blit_vertex_shader,
-        blit_from_2d_shader,
-        blit_from_2d_array_shader,
-        blit_from_3d_shader,
-        blit_from_cube_shader,
-        blit_from_cube_array_shader,
-        blit_pipelines,
-        blit_pipeline_count,
-        blit_pipeline_capacity);
-
-    SDL_assert(blit_pipeline != NULL);
-
-    color_target_info.load_op = info->load_op;
-    color_target_info.clear_color = info->clear_color;
-    color_target_info.store_op = SDL_GPU_STOREOP_STORE;
-
-    color_target_info.texture = info->destination.texture;
-    color_target_info.mip_level = info->destination.mip_level;
-    color_target_info.layer_or_depth_plane = info->destination.layer_or_depth_plane;
-    color_target_info.cycle = info->cycle;
-
-    render_pass = SDL_BeginGPURenderPass(
-        command_buffer,
-        &color_target_info,
-        1,
-        NULL);
+    SDL_GPURenderPass *render_pass = NULL;
+    SDL_GPUGraphicsPipeline *bound_pipeline = NULL;
+
+    for (Uint32 i = 0; i < num_infos; i += 1) {
+        const SDL_GPUBlitInfo *info = &infos[i];
+        TextureCommonHeader *src_header = (TextureCommonHeader *)info->source.texture;
+        TextureCommonHeader *dst_header = (TextureCommonHeader *)info->destination.texture;
+        SDL_GPUGraphicsPipeline *blit_pipeline;
+        SDL_GPUViewport viewport;
+        SDL_GPUTextureSamplerBinding texture_sampler_binding;
+        BlitFragmentUniforms blit_fragment_uniforms;
+        Uint32 layer_divisor;
+
+        blit_pipeline = SDL_GPU_FetchBlitPipeline(
+            cmdbufHeader->device,
+            src_header->info.type,
+            dst_header->info.format,
+            blit_vertex_shader,
+            blit_from_2d_shader,
+            blit_from_2d_array_shader,
+            blit_from_3d_shader,
+            blit_from_cube_shader,
+            blit_from_cube_array_shader,
+            blit_pipelines,
+            blit_pipeline_count,
+            blit_pipeline_capacity);
+
+        SDL_assert(blit_pipeline != NULL);
+
+        if (render_pass != NULL && !SDL_GPU_BlitSharesRenderPass(&infos[i - 1], info)) {
+            SDL_EndGPURenderPass(render_pass);
+            render_pass = NULL;
+        }
 
-    viewport.x = (float)info->destination.x;
-    viewport.y = (float)info->destination.y;
-    viewport.w = (float)info->destination.w;
-    viewport.h = (float)info->destination.h;
-    viewport.min_depth = 0;
-    viewport.max_depth = 1;
+        if (render_pass == NULL) {
+            SDL_GPUColorTargetInfo color_target_info;
+            SDL_zero(color_target_info);
+
+            color_target_info.load_op = info->load_op;
+            color_target_info.clear_color = info->clear_color;
+            color_target_info.store_op = SDL_GPU_STOREOP_STORE;
+
+            color_target_info.texture = info->destination.texture;
+            color_target_info.mip_level = info->destination.mip_level;
+            color_target_info.layer_or_depth_plane = info->destination.layer_or_depth_plane;
+            color_target_info.cycle = info->cycle;
+
+            render_pass = SDL_BeginGPURenderPass(
+                command_buffer,
+                &color_target_info,
+                1,
+                NULL);
+            bound_pipeline = NULL;
+        }
 
-    SDL_SetGPUViewport(
-        render_pass,
-        &viewport);
+        viewport.x = (float)info->destination.x;
+        viewport.y = (float)info->destination.y;
+        viewport.w = (float)info->destination.w;
+        viewport.h = (float)info->destination.h;
+        viewport.min_depth = 0;
+        viewport.max_depth = 1;
+
+        SDL_SetGPUViewport(
+            render_pass,
+            &viewport);
+
+        if (blit_pipeline != bound_pipeline) {
+            SDL_BindGPUGraphicsPipeline(
+                render_pass,
+                blit_pipeline);
+            bound_pipeline = blit_pipeline;
+        }
 
-    SDL_BindGPUGraphicsPipeline(
-        render_pass,
-        blit_pipeline);
+        texture_sampler_binding.texture = info->source.texture;
+        texture_sampler_binding.sampler =
+            info->filter == SDL_GPU_FILTER_NEAREST ? blit_nearest_sampler : blit_linear_sampler;
 
-    texture_sampler_binding.texture = info->source.texture;
-    texture_sampler_binding.sampler =
-        info->filter == SDL_GPU_FILTER_NEAREST ? blit_nearest_sampler : blit_linear_sampler;
+        SDL_BindGPUFragmentSamplers(
+            render_pass,
+            0,
+            &texture_sampler_binding,
+            1);
 
-    SDL_BindGPUFragmentSamplers(
-        render_pass,
-        0,
-        &texture_sampler_binding,
-        1);
+        blit_fragment_uniforms.left = (float)info->source.x / (src_header->info.width >> info->source.mip_level);
+        blit_fragment_uniforms.top = (float)info->source.y / (src_header->info.height >> info->source.mip_level);
+        blit_fragment_uniforms.width = (float)info->source.w / (src_header->info.width >> info->source.mip_level);
+        blit_fragment_uniforms.height = (float)info->source.h / (src_header->info.height >> info->source.mip_level);
+        blit_fragment_uniforms.mip_level = info->source.mip_level;
 
-    blit_fragment_uniforms.left = (float)info->source.x / (src_header->info.width >> info->source.mip_level);
-    blit_fragment_uniforms.top = (float)info->source.y / (src_header->info.height >> info->source.mip_level);
-    blit_fragment_uniforms.width = (float)info->source.w / (src_header->info.width >> info->source.mip_level);
-    blit_fragment_uniforms.height = (float)info->source.h / (src_header->info.height >> info->source.mip_level);
-    blit_fragment_uniforms.mip_level = info->source.mip_level;
+        layer_divisor = (src_header->info.type == SDL_GPU_TEXTURETYPE_3D) ? src_header->info.layer_count_or_depth : 1;
+        blit_fragment_uniforms.layer_or_depth = (float)info->source.layer_or_depth_plane / layer_divisor;
 
-    layer_divisor = (src_header->info.type == SDL_GPU_TEXTURETYPE_3D) ? src_header->info.layer_count_or_depth : 1;
-    blit_fragment_uniforms.layer_or_depth = (float)info->source.layer_or_depth_plane / layer_divisor;
+        if (info->flip_mode & SDL_FLIP_HORIZONTAL) {
+            blit_fragment_uniforms.left += blit_fragment_uniforms.width;
+            blit_fragment_uniforms.width *= -1;
+        }
 
-    if (info->flip_mode & SDL_FLIP_HORIZONTAL) {
-        blit_fragment_uniforms.left += blit_fragment_uniforms.width;
-        blit_fragment_uniforms.width *= -1;
-    }
+        if (info->flip_mode & SDL_FLIP_VERTICAL) {
+            blit_fragment_uniforms.top += blit_fragment_uniforms.height;
+            blit_fragment_uniforms.height *= -1;
+        }
 
-    if (info->flip_mode & SDL_FLIP_VERTICAL) {
-        blit_fragment_uniforms.top += blit_fragment_uniforms.height;
-        blit_fragment_uniforms.height *= -1;
-    }
+        SDL_PushGPUFragmentUniformData(
+            command_buffer,
+            0,
+            &blit_fragment_uniforms,
+            sizeof(blit_fragment_uniforms));
 
-    SDL_PushGPUFragmentUniformData(
-        command_buffer,
-        0,
-        &blit_fragment_uniforms,
-        sizeof(blit_fragment_uniforms));
+        SDL_DrawGPUPrimitives(render_pass, 3, 1, 0, 0);
+    }
 
-    SDL_DrawGPUPrimitives(render_pass, 3, 1, 0, 0);
-    SDL_EndGPURenderPass(render_pass);
+    if (render_pass != NULL) {
+        SDL_EndGPURenderPass(render_pass);
+    }
 }
 
 static void SDL_GPU_CheckGraphicsBindings(SDL_GPURenderPass *render_pass)
@@ -584,6 +674,440 @@ static void SDL_GPU_CheckComputeBindings(SDL_GPUComputePass *compute_pass)
     }
 }
 
+// Transient Allocation
+
+#define TRANSIENT_BLOCK_SIZE (4 * 1024 * 1024)
+#define TRANSIENT_ALIGNMENT  16
+
+#define TRANSIENT_BUFFER_USAGE_MASK \
+    (SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_INDEX | SDL_GPU_BUFFERUSAGE_INDIRECT)
+
+struct TransientBlock
+{
+    TransientBlock *next;
+    SDL_GPUBufferUsageFlags usage; // 0 for upload blocks
+    SDL_GPUBuffer *buffer;
+    SDL_GPUTransferBuffer *transfer_buffer;
+    Uint8 *mapped;
+    Uint32 size;
+    Uint32 offset;
+};
+
+struct TransientBatch
+{
+    TransientBatch *next;
+    SDL_GPUFence *fence;
+    TransientBlock *blocks;
+};
+
+static void SDL_GPU_DestroyTransientBlocks(
+    SDL_GPUDevice *device,
+    TransientBlock *blocks)
+{
+    while (blocks != NULL) {
+        TransientBlock *next = blocks->next;
+        if (blocks->transfer_buffer != NULL) {
+            if (blocks->mapped != NULL) {
+                device->UnmapTransferBuffer(device->driverData, blocks->transfer_buffer);
+            }
+            device->ReleaseTransferBuffer(device->driverData, blocks->transfer_buffer);
+        } else {
+            device->ReleaseBuffer(device->driverData, blocks->buffer);
+        }
+        SDL_free(blocks);
+        blocks = next;
+    }
+}
+
+// The caller must hold transient_lock
+static void SDL_GPU_FreeTransientBlocks(
+    SDL_GPUDevice *device,
+    TransientBlock *blocks)
+{
+    while (blocks != NULL) {
+        TransientBlock *next = blocks->next;
+        blocks->offset = 0;
+        blocks->next = device->transient_free_blocks;
+        device->transient_free_blocks = blocks;
+        blocks = next;
+    }
+}
+
+// Recycles the blocks of every submission that has completed. The caller must hold transient_lock.
+static void SDL_GPU_RetireTransientBatches(
+    SDL_GPUDevice *device)
+{
+    TransientBatch **link = &device->transient_pending_batches;
+
+    while (*link != NULL) {
+        TransientBatch *batch = *link;
+        if (device->QueryFence(device->driverData, batch->fence)) {
+            *link = batch->next;
+            SDL_GPU_FreeTransientBlocks(device, batch->blocks);
+            device->ReleaseFence(device->driverData, batch->fence);
+            SDL_free(batch);
+        } else {
+            link = &batch->next;
+        }
+    }
+}
+
+static TransientBlock *SDL_GPU_AcquireTransientBlock(
+    CommandBufferCommonHeader *commandBufferHeader,
+    SDL_GPUBufferUsageFlags usage,
+    Uint32 size,
+    Uint32 *offset)
+{
+    SDL_GPUDevice *device = commandBufferHeader->device;
+    TransientBlock **link;
+    TransientBlock *block;
+
+    // Keep filling the blocks this command buffer already owns
+    for (block = commandBufferHeader->transient_blocks; block != NULL; block = block->next) {
+        if (block->usage == usage) {
+            Uint32 alignedOffset = (block->offset + TRANSIENT_ALIGNMENT - 1) & ~(TRANSIENT_ALIGNMENT - 1);
+            if (alignedOffset <= block->size && size <= block->size - alignedOffset) {
+                block->offset = alignedOffset + size;
+                *offset = alignedOffset;
+                return block;
+            }
+        }
+    }
+
+    SDL_LockMutex(device->transient_lock);
+    SDL_GPU_RetireTransientBatches(device);
+    for (link = &device->transient_free_blocks; *link != NULL; link = &(*link)->next) {
+        if ((*link)->usage == usage && (*link)->size >= size) {
+            break;
+        }
+    }
+    block = *link;
+    if (block != NULL) {
+        *link = block->next;
+    }
+    SDL_UnlockMutex(device->transient_lock);
+
+    if (block == NULL) {
+        block = (TransientBlock *)SDL_calloc(1, sizeof(TransientBlock));
+        if (block == NULL) {
+            return NULL;
+        }
+        block->usage = usage;
+        block->size = SDL_max(size, TRANSIENT_BLOCK_SIZE);
+
+        if (usage == 0) {
+            block->transfer_buffer = device->CreateTransferBuffer(
+                device->driverData,
+                SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+                block->size,
+                "SDL_GPU transient transfer buffer");
+        } else {
+            block->buffer = device->CreateBuffer(
+                device->driverData,
+                usage,
+                block->size,
+                "SDL_GPU transient buffer");
+        }
+
+        if (block->buffer == NULL && block->transfer_buffer == NULL) {
+            SDL_free(block);
+            return NULL;
+        }
+    }
+
+    // Upload blocks stay mapped while they are owned by a command buffer
+    if (block->transfer_buffer != NULL) {
+        block->mapped = (Uint8 *)device->MapTransferBuffer(
+            device->driverData,
+            block->transfer_buffer,
+            false);
+        if (block->mapped == NULL) {
+            block->next = NULL;
+            SDL_GPU_DestroyTransientBlocks(device, block);
+            return NULL;
+        }
+    }
+
+    block->offset = size;
+    block->next = commandBufferHeader->transient_blocks;
+    commandBufferHeader->transient_blocks = block;
+    *offset = 0;
+    return block;
+}
+
+/* Takes the blocks away from a command buffer that is about to be submitted or cancelled,
+ * unmapping upload blocks so their writes become visible to the GPU.
+ */
+static TransientBlock *SDL_GPU_DetachTransientBlocks(
+    CommandBufferCommonHeader *commandBufferHeader)
+{
+    SDL_GPUDevice *device = commandBufferHeader->device;
+    TransientBlock *blocks = commandBufferHeader->transient_blocks;
+
+    for (TransientBlock *block = blocks; block != NULL; block = block->next) {
+        if (block->mapped != NULL) {
+            device->UnmapTransferBuffer(device->driverData, block->transfer_buffer);
+            block->mapped = NULL;
+        }
+    }
+
+    commandBufferHeader->transient_blocks = NULL;
+    return blocks;
+}
+
+/* Holds on to the blocks until the fence signals. Takes ownership of the fence reference;
+ * a NULL fence means the work never reached the GPU, so the blocks are free right away.
+ */
+static void SDL_GPU_QueueTransientBlocks(
+    SDL_GPUDevice *device,
+    TransientBlock *blocks,
+    SDL_GPUFence *fence)
+{
+    TransientBatch *batch = NULL;
+
+    if (fence != NULL) {
+        batch = (TransientBatch *)SDL_malloc(sizeof(TransientBatch));
+        if (batch == NULL) {
+            // Nowhere to track the submission, so wait for it instead
+            device->WaitForFences(device->driverData, true, &fence, 1);
+            device->ReleaseFence(device->driverData, fence);
+        }
+    }
+
+    SDL_LockMutex(device->transient_lock);
+    if (batch != NULL) {
+        batch->fence = fence;
+        batch->blocks = blocks;
+        batch->next = device->transient_pending_batches;
+        device->transient_pending_batches = batch;
+    } else {
+        SDL_GPU_FreeTransientBlocks(device, blocks);
+    }
+    SDL_UnlockMutex(device->transient_lock);
+}
+
+static void SDL_GPU_DestroyTransientAllocator(
+    SDL_GPUDevice *device)
+{
+    while (device->transient_pending_batches != NULL) {
+        TransientBatch *batch = device->transient_pending_batches;
+        device->transient_pending_batches = batch->next;
+        SDL_GPU_DestroyTransientBlocks(device, batch->blocks);
+        device->ReleaseFence(device->driverData, batch->fence);
+        SDL_free(batch);
+    }
+
+    SDL_GPU_DestroyTransientBlocks(device, device->transient_free_blocks);
+    device->transient_free_blocks = NULL;
+
+    SDL_DestroyMutex(device->transient_lock);
+    device->transient_lock = NULL;
+}
+
+// Asynchronous Pipeline Creation
+
+#define DEFAULT_PIPELINE_THREADS 4
+#define MAX_PIPELINE_THREADS     16
+
+typedef struct PipelineJob
+{
+    struct PipelineJob *next;
+    SDL_GPUGraphicsPipelineCreateInfo graphics_info;
+    SDL_GPUComputePipelineCreateInfo compute_info;
+    SDL_GPUGraphicsPipelineCallback graphics_callback; // NULL for compute jobs
+    SDL_GPUComputePipelineCallback compute_callback;
+    void *userdata;
+} PipelineJob;
+
+struct PipelineCompiler
+{
+    SDL_GPUDevice *device;
+    SDL_Mutex *lock;
+    SDL_Condition *job_available;
+    SDL_Condition *jobs_done;
+
+    PipelineJob *first_job;
+    PipelineJob *last_job;
+    Uint32 num_pending; // queued or running
+
+    SDL_Thread *threads[MAX_PIPELINE_THREADS];
+    int num_threads;
+    int max_threads;
+    bool quit;
+};
+
+static void SDL_GPU_FreePipelineJob(PipelineJob *job)
+{
+    SDL_DestroyProperties(job->graphics_info.props);
+    SDL_DestroyProperties(job->compute_info.props);
+    SDL_free(job);
+}
+
+static int SDLCALL SDL_GPU_PipelineWorker(void *data)
+{
+    PipelineCompiler *compiler = (PipelineCompiler *)data;
+
+    SDL_LockMutex(compiler->lock);
+    for (;;) {
+        PipelineJob *job;
+
+        while (compiler->first_job == NULL && !compiler->quit) {
+            SDL_WaitCondition(compiler->job_available, compiler->lock);
+        }
+
+        // On quit, the queue is drained first so that every callback is called
+        job = compiler->first_job;
+        if (job == NULL) {
+            break;
+        }
+        compiler->first_job = job->next;
+        if (compiler->first_job == NULL) {
+            compiler->last_job = NULL;
+        }
+        SDL_UnlockMutex(compiler->lock);
+
+        if (job->graphics_callback != NULL) {
+            SDL_GPUGraphicsPipeline *pipeline = SDL_CreateGPUGraphicsPipeline(
+                compiler->device,
+                &job->graphics_info);
+            job->graphics_callback(job->userdata, pipeline);
+        } else {
+            SDL_GPUComputePipeline *pipeline = SDL_CreateGPUComputePipeline(
+                compiler->device,
+                &job->compute_info);
+            job->compute_callback(job->userdata, pipeline);
+        }
+        SDL_GPU_FreePipelineJob(job);
+
+        SDL_LockMutex(compiler->lock);
+        compiler->num_pending -= 1;
+        if (compiler->num_pending == 0) {
+            SDL_BroadcastCondition(compiler->jobs_done);
+        }
+    }
+    SDL_UnlockMutex(compiler->lock);
+
+    return 0;
+}
+
+static bool SDL_GPU_QueuePipelineJob(
+    SDL_GPUDevice *device,
+    PipelineJob *job)
+{
+    PipelineCompiler *compiler = device->pipeline_compiler;
+    bool result = true;
+
+    SDL_LockMutex(compiler->lock);
+
+    job->next = NULL;
+    if (compiler->last_job != NULL) {
+        compiler->last_job->next = job;
+    } else {
+        compiler->first_job = job;
+    }
+    compiler->last_job = job;
+    compiler->num_pending += 1;
+
+    // Threads are started on demand, up to the configured limit
+    if (compiler->num_threads < compiler->max_threads &&
+        compiler->num_pending > (Uint32)compiler->num_threads) {
+        SDL_Thread *thread = SDL_CreateThread(SDL_GPU_PipelineWorker, "SDLGPUPipeline", compiler);
+        if (thread != NULL) {
+            compiler->threads[compiler->num_threads] = thread;
+            compiler->num_threads += 1;
+        } else if (compiler->num_threads == 0) {
+            // Nothing would ever run the job, and nothing else can be queued either
+            compiler->first_job = NULL;
+            compiler->last_job = NULL;
+            compiler->num_pending = 0;
+            result = false;
+        }
+    }
+
+    if (result) {
+        SDL_SignalCondition(compiler->job_available);
+    }
+
+    SDL_UnlockMutex(compiler->lock);
+
+    if (!result) {
+        SDL_GPU_FreePipelineJob(job);
+    }
+    return result;
+}
+
+static bool SDL_GPU_CopyPipelineProperties(
+    SDL_PropertiesID src,
+    SDL_PropertiesID *dst)
+{
+    *dst = 0;
+    if (src == 0) {
+        return true;
+    }
+
+    *dst = SDL_CreateProperties();
+    if (*dst == 0) {
+        return false;
+    }
+    return SDL_CopyProperties(src, *dst);
+}
+
+static PipelineCompiler *SDL_GPU_CreatePipelineCompiler(
+    SDL_GPUDevice *device,
+    SDL_PropertiesID props)
+{
+    PipelineCompiler *compiler;
+    Sint64 max_threads;
+
+    compiler = (PipelineCompiler *)SDL_calloc(1, sizeof(PipelineCompiler));
+    if (compiler == NULL) {
+        return NULL;
+    }
+
+    max_threads = SDL_GetNumberProperty(
+        props,
+        SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_THREADS_NUMBER,
+        SDL_min(SDL_GetNumLogicalCPUCores() - 1, DEFAULT_PIPELINE_THREADS));
+
+    compiler->device = device;
+    compiler->max_threads = (int)SDL_clamp(max_threads, 1, MAX_PIPELINE_THREADS);
+    compiler->lock = SDL_CreateMutex();
+    compiler->job_available = SDL_CreateCondition();
+    compiler->jobs_done = SDL_CreateCondition();
+
+    if (compiler->lock == NULL || compiler->job_available == NULL || compiler->jobs_done == NULL) {
+        SDL_DestroyCondition(compiler->jobs_done);
+        SDL_DestroyCondition(compiler->job_available);
+        SDL_DestroyMutex(compiler->lock);
+        SDL_free(compiler);
+        return NULL;
+    }
+
+    return compiler;
+}
+
+static void SDL_GPU_DestroyPipelineCompiler(
+    PipelineCompiler *compiler)
+{
+    if (compiler == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(compiler->lock);
+    compiler->quit = true;
+    SDL_BroadcastCondition(compiler->job_available);
+    SDL_UnlockMutex(compiler->lock);
+
+    for (int i = 0; i < compiler->num_threads; i += 1) {
+        SDL_WaitThread(compiler->threads[i], NULL);
+    }
+
+    SDL_DestroyCondition(compiler->jobs_done);
+    SDL_DestroyCondition(compiler->job_available);
+    SDL_DestroyMutex(compiler->lock);
+    SDL_free(compiler);
+}
+
 // Driver Functions
 
 #ifndef SDL_GPU_DISABLED
@@ -631,7 +1155,7 @@ static const SDL_GPUBootstrap * SDL_GPUSelectBackend(SDL_PropertiesID props)
                     SDL_SetError("Required shader format for backend %s not provided!", gpudriver);
                     return NULL;
                 }
-                if (backends[i]->PrepareDriver(_this)) {
+                if (backends[i]->PrepareDriver(_this, props)) {
                     return backends[i];
                 }
             }
@@ -646,7 +1170,7 @@ static const SDL_GPUBootstrap * SDL_GPUSelectBackend(SDL_PropertiesID props)
             // Don't select a backend which doesn't support the app's shaders.
             continue;
         }
-        if (backends[i]->PrepareDriver(_this)) {
+        if (backends[i]->PrepareDriver(_this, props)) {
             return backends[i];
         }
     }
@@ -729,7 +1253,7 @@ SDL_GPUDevice *SDL_CreateGPUDevice(
 #endif // SDL_GPU_DISABLED
 }
 
-SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
+static SDL_GPUDevice *SDL_CreateGPUDeviceWithPropertiesInternal(SDL_PropertiesID props)
 {
 #ifndef SDL_GPU_DISABLED
     bool debug_mode;
@@ -746,6 +1270,15 @@ SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
         if (result != NULL) {
             result->backend = selectedBackend->name;
             result->debug_mode = debug_mode;
+
+            result->transient_lock = SDL_CreateMutex();
+            result->pipeline_compiler = SDL_GPU_CreatePipelineCompiler(result, props);
+            if (result->transient_lock == NULL || result->pipeline_compiler == NULL) {
+                SDL_GPU_DestroyPipelineCompiler(result->pipeline_compiler);
+                SDL_DestroyMutex(result->transient_lock);
+                result->DestroyDevice(result);
+                return NULL;
+            }
         }
     }
     return result;
@@ -755,10 +1288,24 @@ SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
 #endif // SDL_GPU_DISABLED
 }
 
+SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_GPU);
+    SDL_GPUDevice *result = SDL_CreateGPUDeviceWithPropertiesInternal(props);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 void SDL_DestroyGPUDevice(SDL_GPUDevice *device)
 {
     CHECK_DEVICE_MAGIC(device, );
 
+    // Pending pipeline requests finish first, so every callback gets called
+    SDL_GPU_DestroyPipelineCompiler(device->pipeline_compiler);
+    device->pipeline_compiler = NULL;
+
+    SDL_GPU_DestroyTransientAllocator(device);
+
     device->DestroyDevice(device);
 }
 
@@ -929,7 +1476,7 @@ bool SDL_GPUTextureSupportsFormat(
 {
     CHECK_DEVICE_MAGIC(device, false);
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         CHECK_TEXTUREFORMAT_ENUM_INVALID(format, false)
     }
 
@@ -954,7 +1501,7 @@ bool SDL_GPUTextureSupportsSampleCount(
 {
     CHECK_DEVICE_MAGIC(device, 0);
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         CHECK_TEXTUREFORMAT_ENUM_INVALID(format, 0)
     }
 
@@ -964,6 +1511,100 @@ bool SDL_GPUTextureSupportsSampleCount(
         sample_count);
 }
 
+bool SDL_GPUTextureSupportsSparse(
+    SDL_GPUDevice *device,
+    SDL_GPUTextureFormat format,
+    SDL_GPUTextureType type,
+    SDL_GPUTextureUsageFlags usage)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+
+    if (GPU_DEBUG_MODE(device)) {
+        CHECK_TEXTUREFORMAT_ENUM_INVALID(format, false)
+    }
+
+    if (device->SupportsSparseTexture == NULL) {
+        return false;
+    }
+
+    if (!SDL_GPUTextureSupportsFormat(device, format, type, usage)) {
+        return false;
+    }
+
+    return device->SupportsSparseTexture(
+        device->driverData,
+        format,
+        type,
+        usage);
+}
+
+void *SDL_GetGPUPipelineCacheData(
+    SDL_GPUDevice *device,
+    size_t *size)
+{
+    size_t unused;
+
+    if (!size) {
+        size = &unused;
+    }
+    *size = 0;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    return device->GetPipelineCacheData(
+        device->driverData,
+        size);
+}
+
+bool SDL_GetGPUDeviceStats(
+    SDL_GPUDevice *device,
+    SDL_GPUDeviceStats *stats)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+
+    if (stats == NULL) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&device->stats_lock);
+    SDL_copyp(stats, &device->stats);
+    SDL_UnlockSpinlock(&device->stats_lock);
+    return true;
+}
+
+static void SDL_GPU_AccumulateStats(
+    SDL_GPUDevice *device,
+    const SDL_GPUDeviceStats *stats)
+{
+    SDL_LockSpinlock(&device->stats_lock);
+    device->stats.command_buffers += 1;
+    device->stats.draw_calls += stats->draw_calls;
+    device->stats.dispatches += stats->dispatches;
+    device->stats.pipeline_binds += stats->pipeline_binds;
+    device->stats.resource_binds += stats->resource_binds;
+    device->stats.uniform_bytes += stats->uniform_bytes;
+    device->stats.upload_bytes += stats->upload_bytes;
+    SDL_UnlockSpinlock(&device->stats_lock);
+}
+
+SDL_GPUMemoryHeapStats *SDL_GetGPUMemoryHeapStats(
+    SDL_GPUDevice *device,
+    int *count)
+{
+    int unused;
+
+    if (!count) {
+        count = &unused;
+    }
+    *count = 0;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    return device->GetMemoryHeapStats(
+        device->driverData,
+        count);
+}
+
 // State Creation
 
 SDL_GPUComputePipeline *SDL_CreateGPUComputePipeline(
@@ -976,7 +1617,7 @@ SDL_GPUComputePipeline *SDL_CreateGPUComputePipeline(
         return NULL;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         if (createinfo->format == SDL_GPU_SHADERFORMAT_INVALID) {
             SDL_assert_release(!"Shader format cannot be INVALID!");
             return NULL;
@@ -1016,11 +1657,33 @@ SDL_GPUGraphicsPipeline *SDL_CreateGPUGraphicsPipeline(
         return NULL;
     }
 
-    if (device->debug_mode) {
-        if (graphicsPipelineCreateInfo->vertex_shader == NULL) {
+    SDL_GPUShader *task_shader = SDL_GetPointerProperty(
+        graphicsPipelineCreateInfo->props,
+        SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_TASK_SHADER_POINTER,
+        NULL);
+    SDL_GPUShader *mesh_shader = SDL_GetPointerProperty(
+        graphicsPipelineCreateInfo->props,
+        SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER,
+        NULL);
+
+    if ((task_shader != NULL || mesh_shader != NULL) && device->DrawMeshTasks == NULL) {
+        SDL_SetError("Mesh shaders were not enabled when the device was created");
+        return NULL;
+    }
+
+    if (GPU_DEBUG_MODE(device)) {
+        if (mesh_shader == NULL && graphicsPipelineCreateInfo->vertex_shader == NULL) {
             SDL_assert_release(!"Vertex shader cannot be NULL!");
             return NULL;
         }
+        if (mesh_shader != NULL && graphicsPipelineCreateInfo->vertex_shader != NULL) {
+            SDL_assert_release(!"Vertex shader must be NULL when a mesh shader is used!");
+            return NULL;
+        }
+        if (task_shader != NULL && mesh_shader == NULL) {
+            SDL_assert_release(!"Task shader requires a mesh shader!");
+            return NULL;
+        }
         if (graphicsPipelineCreateInfo->fragment_shader == NULL) {
             SDL_assert_release(!"Fragment shader cannot be NULL!");
             return NULL;
@@ -1119,6 +1782,133 @@ SDL_GPUGraphicsPipeline *SDL_CreateGPUGraphicsPipeline(
         graphicsPipelineCreateInfo);
 }
 
+bool SDL_CreateGPUGraphicsPipelineAsync(
+    SDL_GPUDevice *device,
+    const SDL_GPUGraphicsPipelineCreateInfo *createinfo,
+    SDL_GPUGraphicsPipelineCallback callback,
+    void *userdata)
+{
+    const SDL_GPUVertexInputState *vertex_input;
+    const SDL_GPUGraphicsPipelineTargetInfo *target_info;
+    size_t vertex_buffers_size, vertex_attributes_size, color_targets_size;
+    PipelineJob *job;
+    Uint8 *storage;
+
+    CHECK_DEVICE_MAGIC(device, false);
+    if (createinfo == NULL) {
+        return SDL_InvalidParamError("createinfo");
+    }
+    if (callback == NULL) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    vertex_input = &createinfo->vertex_input_state;
+    target_info = &createinfo->target_info;
+    vertex_buffers_size = vertex_input->num_vertex_buffers * sizeof(SDL_GPUVertexBufferDescription);
+    vertex_attributes_size = vertex_input->num_vertex_attributes * sizeof(SDL_GPUVertexAttribute);
+    color_targets_size = target_info->num_color_targets * sizeof(SDL_GPUColorTargetDescription);
+
+    // The arrays of the create info live in the same allocation as the job
+    job = (PipelineJob *)SDL_calloc(1, sizeof(PipelineJob) + vertex_buffers_size + vertex_attributes_size + color_targets_size);
+    if (job == NULL) {
+        return false;
+    }
+    storage = (Uint8 *)(job + 1);
+
+    job->graphics_info = *createinfo;
+    job->graphics_callback = callback;
+    job->userdata = userdata;
+
+    if (vertex_buffers_size > 0) {
+        SDL_memcpy(storage, vertex_input->vertex_buffer_descriptions, vertex_buffers_size);
+        job->graphics_info.vertex_input_state.vertex_buffer_descriptions = (const SDL_GPUVertexBufferDescription *)storage;
+        storage += vertex_buffers_size;
+    }
+    if (vertex_attributes_size > 0) {
+        SDL_memcpy(storage, vertex_input->vertex_attributes, vertex_attributes_size);
+        job->graphics_info.vertex_input_state.vertex_attributes = (const SDL_GPUVertexAttribute *)storage;
+        storage += vertex_attributes_size;
+    }
+    if (color_targets_size > 0) {
+        SDL_memcpy(storage, target_info->color_target_descriptions, color_targets_size);
+        job->graphics_info.target_info.color_target_descriptions = (const SDL_GPUColorTargetDescription *)storage;
+    }
+
+    if (!SDL_GPU_CopyPipelineProperties(createinfo->props, &job->graphics_info.props)) {
+        SDL_GPU_FreePipelineJob(job);
+        return false;
+    }
+
+    return SDL_GPU_QueuePipelineJob(device, job);
+}
+
+bool SDL_CreateGPUComputePipelineAsync(
+    SDL_GPUDevice *device,
+    const SDL_GPUComputePipelineCreateInfo *createinfo,
+    SDL_GPUComputePipelineCallback callback,
+    void *userdata)
+{
+    size_t entrypoint_size;
+    PipelineJob *job;
+    Uint8 *storage;
+
+    CHECK_DEVICE_MAGIC(device, false);
+    if (createinfo == NULL) {
+        return SDL_InvalidParamError("createinfo");
+    }
+    if (callback == NULL) {
+        return SDL_InvalidParamError("callback");
+    }
+    if (createinfo->code == NULL && createinfo->code_size > 0) {
+        return SDL_InvalidParamError("createinfo->code");
+    }
+
+    entrypoint_size = createinfo->entrypoint ? SDL_strlen(createinfo->entrypoint) + 1 : 0;
+
+    // The shader code and entrypoint live in the same allocation as the job
+    job = (PipelineJob *)SDL_calloc(1, sizeof(PipelineJob) + createinfo->code_size + entrypoint_size);
+    if (job == NULL) {
+        return false;
+    }
+    storage = (Uint8 *)(job + 1);
+
+    job->compute_info = *createinfo;
+    job->compute_callback = callback;
+    job->userdata = userdata;
+
+    if (createinfo->code_size > 0) {
+        SDL_memcpy(storage, createinfo->code, createinfo->code_size);
+        job->compute_info.code = storage;
+        storage += createinfo->code_size;
+    }
+    if (entrypoint_size > 0) {
+        SDL_memcpy(storage, createinfo->entrypoint, entrypoint_size);
+        job->compute_info.entrypoint = (const char *)storage;
+    }
+
+    if (!SDL_GPU_CopyPipelineProperties(createinfo->props, &job->compute_info.props)) {
+        SDL_GPU_FreePipelineJob(job);
+        return false;
+    }
+
+    return SDL_GPU_QueuePipelineJob(device, job);
+}
+
+void SDL_WaitForGPUPipelines(
+    SDL_GPUDevice *device)
+{
+    PipelineCompiler *compiler;
+
+    CHECK_DEVICE_MAGIC(device, );
+
+    compiler = device->pipeline_compiler;
+    SDL_LockMutex(compiler->lock);
+    while (compiler->num_pending > 0) {
+        SDL_WaitCondition(compiler->jobs_done, compiler->lock);
+    }
+    SDL_UnlockMutex(compiler->lock);
+}
+
 SDL_GPUSampler *SDL_CreateGPUSampler(
     SDL_GPUDevice *device,
     const SDL_GPUSamplerCreateInfo *createinfo)
@@ -1144,7 +1934,7 @@ SDL_GPUShader *SDL_CreateGPUShader(
         return NULL;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         if (createinfo->format == SDL_GPU_SHADERFORMAT_INVALID) {
             SDL_assert_release(!"Shader format cannot be INVALID!");
             return NULL;
@@ -1160,6 +1950,22 @@ SDL_GPUShader *SDL_CreateGPUShader(
         createinfo);
 }
 
+// The drivers don't report how much memory a texture takes, so estimate it from its dimensions
+static Uint64 SDL_GPU_EstimateTextureSize(const SDL_GPUTextureCreateInfo *createinfo)
+{
+    const bool is_3d = (createinfo->type == SDL_GPU_TEXTURETYPE_3D);
+    Uint64 size = 0;
+
+    for (Uint32 level = 0; level < createinfo->num_levels; level += 1) {
+        size += SDL_CalculateGPUTextureFormatSize(
+            createinfo->format,
+            SDL_max(createinfo->width >> level, 1),
+            SDL_max(createinfo->height >> level, 1),
+            is_3d ? SDL_max(createinfo->layer_count_or_depth >> level, 1) : createinfo->layer_count_or_depth);
+    }
+    return size << createinfo->sample_count;
+}
+
 SDL_GPUTexture *SDL_CreateGPUTexture(
     SDL_GPUDevice *device,
     const SDL_GPUTextureCreateInfo *createinfo)
@@ -1170,7 +1976,7 @@ SDL_GPUTexture *SDL_CreateGPUTexture(
         return NULL;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         bool failed = false;
 
         const Uint32 MAX_2D_DIMENSION = 16384;
@@ -1199,10 +2005,28 @@ SDL_GPUTexture *SDL_CreateGPUTexture(
             SDL_assert_release(!"For multisample textures: usage cannot contain SAMPLER or STORAGE flags");
             failed = true;
         }
-        if (IsDepthFormat(createinfo->format) && (createinfo->usage & ~(SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER))) {
-            SDL_assert_release(!"For depth textures: usage cannot contain any flags except for DEPTH_STENCIL_TARGET and SAMPLER");
+        if (IsDepthFormat(createinfo->format) && (createinfo->usage & ~(SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET | SDL_GPU_TEXTUREUSAGE_SAMPLER | SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT))) {
+            SDL_assert_release(!"For depth textures: usage cannot contain any flags except for DEPTH_STENCIL_TARGET, SAMPLER and TRANSIENT_ATTACHMENT");
             failed = true;
         }
+        if (createinfo->usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+            if (createinfo->usage & ~(SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET | SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT)) {
+                SDL_assert_release(!"For transient textures: usage cannot contain any flags except for COLOR_TARGET and DEPTH_STENCIL_TARGET");
+                failed = true;
+            }
+            if (!(createinfo->usage & (SDL_GPU_TEXTUREUSAGE_COLOR_TARGET | SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET))) {
+                SDL_assert_release(!"For transient textures: usage must contain COLOR_TARGET or DEPTH_STENCIL_TARGET");
+                failed = true;
+            }
+            if (createinfo->type != SDL_GPU_TEXTURETYPE_2D || createinfo->num_levels != 1) {
+                SDL_assert_release(!"For transient textures: type must be SDL_GPU_TEXTURETYPE_2D and num_levels must be 1");
+                failed = true;
+            }
+            if (SDL_GetBooleanProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false)) {
+                SDL_assert_release(!"For transient textures: the texture cannot be sparse");
+                failed = true;
+            }
+        }
         if (IsIntegerFormat(createinfo->format) && (createinfo->usage & SDL_GPU_TEXTUREUSAGE_SAMPLER)) {
             SDL_assert_release(!"For any texture: usage cannot contain SAMPLER for textures with an integer format");
             failed = true;
@@ -1297,9 +2121,100 @@ SDL_GPUTexture *SDL_CreateGPUTexture(
         }
     }
 
-    return device->CreateTexture(
+    const bool sparse = SDL_GetBooleanProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false);
+    if (sparse) {
+        if (createinfo->sample_count != SDL_GPU_SAMPLECOUNT_1 ||
+            !SDL_GPUTextureSupportsSparse(device, createinfo->format, createinfo->type, createinfo->usage)) {
+            SDL_SetError("Sparse textures of this format and usage are not supported");
+            return NULL;
+        }
+    }
+
+    SDL_GPUTexture *texture = device->CreateTexture(
         device->driverData,
         createinfo);
+
+    if (texture) {
+        SDL_TrackMemoryObject(
+            texture,
+            SDL_MEMORY_OBJECT_GPU_TEXTURE,
+            sparse ? 0 : SDL_GPU_EstimateTextureSize(createinfo),
+            NULL,
+            SDL_GetStringProperty(createinfo->props, SDL_PROP_MEMORY_OWNER_STRING, NULL));
+    }
+    return texture;
+}
+
+bool SDL_GetGPUSparseTextureInfo(
+    SDL_GPUDevice *device,
+    SDL_GPUTexture *texture,
+    Uint32 *tile_width,
+    Uint32 *tile_height,
+    Uint32 *tile_depth,
+    Uint32 *num_tiled_levels)
+{
+    Uint32 unused;
+
+    CHECK_DEVICE_MAGIC(device, false);
+    if (texture == NULL) {
+        return SDL_InvalidParamError("texture");
+    }
+    if (!SDL_GetBooleanProperty(((TextureCommonHeader *)texture)->info.props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false)) {
+        return SDL_SetError("Texture was not created sparse");
+    }
+
+    return device->GetSparseTextureInfo(
+        device->driverData,
+        texture,
+        tile_width ? tile_width : &unused,
+        tile_height ? tile_height : &unused,
+        tile_depth ? tile_depth : &unused,
+        num_tiled_levels ? num_tiled_levels : &unused);
+}
+
+bool SDL_CommitGPUTextureTiles(
+    SDL_GPUDevice *device,
+    const SDL_GPUTextureRegion *region,
+    bool commit)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+    if (region == NULL) {
+        return SDL_InvalidParamError("region");
+    }
+    if (region->texture == NULL) {
+        return SDL_InvalidParamError("region->texture");
+    }
+
+    const SDL_GPUTextureCreateInfo *info = &((TextureCommonHeader *)region->texture)->info;
+
+    if (!SDL_GetBooleanProperty(info->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false)) {
+        return SDL_SetError("Texture was not created sparse");
+    }
+
+    if (GPU_DEBUG_MODE(device)) {
+        Uint32 layers = (info->type == SDL_GPU_TEXTURETYPE_3D) ? 1 : info->layer_count_or_depth;
+        Uint32 depth = (info->type == SDL_GPU_TEXTURETYPE_3D) ? info->layer_count_or_depth : 1;
+
+        if (region->mip_level >= info->num_levels) {
+            SDL_assert_release(!"Sparse commit mip level is out of range!");
+            return false;
+        }
+        if (region->layer >= layers) {
+            SDL_assert_release(!"Sparse commit layer is out of range!");
+            return false;
+        }
+        if (region->x + region->w > SDL_max(info->width >> region->mip_level, 1) ||
+            region->y + region->h > SDL_max(info->height >> region->mip_level, 1) ||
+            region->z + region->d > SDL_max(depth >> region->mip_level, 1)) {
+            SDL_assert_release(!"Sparse commit region exceeds the mip level's dimensions!");
+            return false;
+        }
+    }
+
+    return device->CommitTextureTiles(
+        device->driverData,
+        region,
+        commit);
 }
 
 SDL_GPUBuffer *SDL_CreateGPUBuffer(
@@ -1314,11 +2229,21 @@ SDL_GPUBuffer *SDL_CreateGPUBuffer(
 
     const char *debugName = SDL_GetStringProperty(createinfo->props, SDL_PROP_GPU_BUFFER_CREATE_NAME_STRING, NULL);
 
-    return device->CreateBuffer(
+    SDL_GPUBuffer *buffer = device->CreateBuffer(
         device->driverData,
         createinfo->usage,
         createinfo->size,
         debugName);
+
+    if (buffer) {
+        SDL_TrackMemoryObject(
+            buffer,
+            SDL_MEMORY_OBJECT_GPU_BUFFER,
+            createinfo->size,
+            NULL,
+            SDL_GetStringProperty(createinfo->props, SDL_PROP_MEMORY_OWNER_STRING, NULL));
+    }
+    return buffer;
 }
 
 SDL_GPUTransferBuffer *SDL_CreateGPUTransferBuffer(
@@ -1333,11 +2258,21 @@ SDL_GPUTransferBuffer *SDL_CreateGPUTransferBuffer(
 
     const char *debugName = SDL_GetStringProperty(createinfo->props, SDL_PROP_GPU_TRANSFERBUFFER_CREATE_NAME_STRING, NULL);
 
-    return device->CreateTransferBuffer(
+    SDL_GPUTransferBuffer *transfer_buffer = device->CreateTransferBuffer(
         device->driverData,
         createinfo->usage,
         createinfo->size,
         debugName);
+
+    if (transfer_buffer) {
+        SDL_TrackMemoryObject(
+            transfer_buffer,
+            SDL_MEMORY_OBJECT_GPU_TRANSFER_BUFFER,
+            createinfo->size,
+            NULL,
+            SDL_GetStringProperty(createinfo->props, SDL_PROP_MEMORY_OWNER_STRING, NULL));
+    }
+    return transfer_buffer;
 }
 
 // Debug Naming
@@ -1395,7 +2330,7 @@ void SDL_InsertGPUDebugLabel(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
@@ -1417,7 +2352,7 @@ void SDL_PushGPUDebugGroup(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
@@ -1434,7 +2369,7 @@ void SDL_PopGPUDebugGroup(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
@@ -1453,6 +2388,8 @@ void SDL_ReleaseGPUTexture(
         return;
     }
 
+    SDL_UntrackMemoryObject(texture);
+
     device->ReleaseTexture(
         device->driverData,
         texture);
@@ -1481,6 +2418,8 @@ void SDL_ReleaseGPUBuffer(
         return;
     }
 
+    SDL_UntrackMemoryObject(buffer);
+
     device->ReleaseBuffer(
         device->driverData,
         buffer);
@@ -1495,6 +2434,8 @@ void SDL_ReleaseGPUTransferBuffer(
         return;
     }
 
+    SDL_UntrackMemoryObject(transfer_buffer);
+
     device->ReleaseTransferBuffer(
         device->driverData,
         transfer_buffer);
@@ -1544,16 +2485,24 @@ void SDL_ReleaseGPUGraphicsPipeline(
 
 // Command Buffer
 
-SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
-    SDL_GPUDevice *device)
+static SDL_GPUCommandBuffer *SDL_GPU_AcquireCommandBufferInternal(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type)
 {
     SDL_GPUCommandBuffer *command_buffer;
     CommandBufferCommonHeader *commandBufferHeader;
 
-    CHECK_DEVICE_MAGIC(device, NULL);
-
-    command_buffer = device->AcquireCommandBuffer(
-        device->driverData);
+    // Without a dedicated queue the work goes to the graphics queue
+    if (queue_type != SDL_GPU_QUEUETYPE_GRAPHICS &&
+        device->SupportsDedicatedQueue &&
+        device->SupportsDedicatedQueue(device->driverData, queue_type)) {
+        command_buffer = device->AcquireCommandBufferForQueue(
+            device->driverData,
+            queue_type);
+    } else {
+        command_buffer = device->AcquireCommandBuffer(
+            device->driverData);
+    }
 
     if (command_buffer == NULL) {
         return NULL;
@@ -1561,11 +2510,14 @@ SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
     commandBufferHeader->device = device;
+    commandBufferHeader->queue_type = queue_type;
+    commandBufferHeader->transient_blocks = NULL;
     commandBufferHeader->render_pass.command_buffer = command_buffer;
     commandBufferHeader->compute_pass.command_buffer = command_buffer;
     commandBufferHeader->copy_pass.command_buffer = command_buffer;
+    SDL_zero(commandBufferHeader->stats);
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         commandBufferHeader->render_pass.in_progress = false;
         commandBufferHeader->render_pass.graphics_pipeline = NULL;
         commandBufferHeader->compute_pass.in_progress = false;
@@ -1590,6 +2542,62 @@ SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
     return command_buffer;
 }
 
+static SDL_GPUCommandBuffer *SDL_GPU_AcquireCommandBuffer(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_GPU);
+    SDL_GPUCommandBuffer *result = SDL_GPU_AcquireCommandBufferInternal(device, queue_type);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
+SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
+    SDL_GPUDevice *device)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    return SDL_GPU_AcquireCommandBuffer(
+        device,
+        SDL_GPU_QUEUETYPE_GRAPHICS);
+}
+
+SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBufferForQueue(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    if (queue_type != SDL_GPU_QUEUETYPE_GRAPHICS &&
+        queue_type != SDL_GPU_QUEUETYPE_COMPUTE &&
+        queue_type != SDL_GPU_QUEUETYPE_TRANSFER) {
+        SDL_InvalidParamError("queue_type");
+        return NULL;
+    }
+
+    return SDL_GPU_AcquireCommandBuffer(
+        device,
+        queue_type);
+}
+
+bool SDL_GPUSupportsDedicatedQueue(
+    SDL_GPUDevice *device,
+    SDL_GPUQueueType queue_type)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+
+    if (queue_type == SDL_GPU_QUEUETYPE_GRAPHICS) {
+        return true;
+    }
+    if (!device->SupportsDedicatedQueue) {
+        return false;
+    }
+
+    return device->SupportsDedicatedQueue(
+        device->driverData,
+        queue_type);
+}
+
 // Uniforms
 
 void SDL_PushGPUVertexUniformData(
@@ -1607,11 +2615,13 @@ void SDL_PushGPUVertexUniformData(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
-    COMMAND_BUFFER_DEVICE->PushVertexUniformData(
+    COMMAND_BUFFER_STATS.uniform_bytes += length;
+
+    SDL_GPU_DIRECT_CALL(COMMAND_BUFFER_DEVICE, PushVertexUniformData)(
         command_buffer,
         slot_index,
         data,
@@ -1633,11 +2643,13 @@ void SDL_PushGPUFragmentUniformData(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
-    COMMAND_BUFFER_DEVICE->PushFragmentUniformData(
+    COMMAND_BUFFER_STATS.uniform_bytes += length;
+
+    SDL_GPU_DIRECT_CALL(COMMAND_BUFFER_DEVICE, PushFragmentUniformData)(
         command_buffer,
         slot_index,
         data,
@@ -1659,11 +2671,13 @@ void SDL_PushGPUComputeUniformData(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
     }
 
-    COMMAND_BUFFER_DEVICE->PushComputeUniformData(
+    COMMAND_BUFFER_STATS.uniform_bytes += length;
+
+    SDL_GPU_DIRECT_CALL(COMMAND_BUFFER_DEVICE, PushComputeUniformData)(
         command_buffer,
         slot_index,
         data,
@@ -1694,9 +2708,10 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
         return NULL;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         CHECK_ANY_PASS_IN_PROGRESS("Cannot begin render pass during another pass!", NULL)
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Render passes require a graphics queue command buffer!", NULL)
 
         for (Uint32 i = 0; i < num_color_targets; i += 1) {
             TextureCommonHeader *textureHeader = (TextureCommonHeader *)color_target_infos[i].texture;
@@ -1706,6 +2721,17 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
                 return NULL;
             }
 
+            if (textureHeader->info.usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+                if (color_target_infos[i].load_op == SDL_GPU_LOADOP_LOAD) {
+                    SDL_assert_release(!"Transient color target load op must be CLEAR or DONT_CARE!");
+                    return NULL;
+                }
+                if (color_target_infos[i].store_op != SDL_GPU_STOREOP_DONT_CARE && color_target_infos[i].store_op != SDL_GPU_STOREOP_RESOLVE) {
+                    SDL_assert_release(!"Transient color target store op must be DONT_CARE or RESOLVE!");
+                    return NULL;
+                }
+            }
+
             if (color_target_infos[i].store_op == SDL_GPU_STOREOP_RESOLVE || color_target_infos[i].store_op == SDL_GPU_STOREOP_RESOLVE_AND_STORE) {
                 if (color_target_infos[i].resolve_texture == NULL) {
                     SDL_assert_release(!"Store op is RESOLVE or RESOLVE_AND_STORE but resolve_texture is NULL!");
@@ -1732,6 +2758,10 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
                         SDL_assert_release(!"Resolve texture usage must include COLOR_TARGET!");
                         return NULL;
                     }
+                    if (resolveTextureHeader->info.usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+                        SDL_assert_release(!"Resolve texture must not be transient!");
+                        return NULL;
+                    }
                 }
             }
 
@@ -1766,6 +2796,17 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
                 SDL_assert_release(!"RESOLVE store ops are not supported for depth-stencil targets!");
                 return NULL;
             }
+
+            if (textureHeader->info.usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+                if (depth_stencil_target_info->load_op == SDL_GPU_LOADOP_LOAD || depth_stencil_target_info->stencil_load_op == SDL_GPU_LOADOP_LOAD) {
+                    SDL_assert_release(!"Transient depth target load ops must be CLEAR or DONT_CARE!");
+                    return NULL;
+                }
+                if (depth_stencil_target_info->store_op != SDL_GPU_STOREOP_DONT_CARE || depth_stencil_target_info->stencil_store_op != SDL_GPU_STOREOP_DONT_CARE) {
+                    SDL_assert_release(!"Transient depth target store ops must be DONT_CARE!");
+                    return NULL;
+                }
+            }
         }
     }
 
@@ -1777,7 +2818,7 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         commandBufferHeader->render_pass.in_progress = true;
         for (Uint32 i = 0; i < num_color_targets; i += 1) {
             commandBufferHeader->render_pass.color_targets[i] = color_target_infos[i].texture;
@@ -1806,12 +2847,14 @@ void SDL_BindGPUGraphicsPipeline(
         return;
     }
 
-    RENDERPASS_DEVICE->BindGraphicsPipeline(
+    RENDERPASS_STATS.pipeline_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindGraphicsPipeline)(
         RENDERPASS_COMMAND_BUFFER,
         graphics_pipeline);
 
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         RENDERPASS_BOUND_PIPELINE = graphics_pipeline;
     }
 }
@@ -1829,11 +2872,11 @@ void SDL_SetGPUViewport(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->SetViewport(
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, SetViewport)(
         RENDERPASS_COMMAND_BUFFER,
         viewport);
 }
@@ -1851,11 +2894,11 @@ void SDL_SetGPUScissor(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->SetScissor(
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, SetScissor)(
         RENDERPASS_COMMAND_BUFFER,
         scissor);
 }
@@ -1869,11 +2912,11 @@ void SDL_SetGPUBlendConstants(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->SetBlendConstants(
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, SetBlendConstants)(
         RENDERPASS_COMMAND_BUFFER,
         blend_constants);
 }
@@ -1887,11 +2930,11 @@ void SDL_SetGPUStencilReference(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->SetStencilReference(
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, SetStencilReference)(
         RENDERPASS_COMMAND_BUFFER,
         reference);
 }
@@ -1911,11 +2954,13 @@ void SDL_BindGPUVertexBuffers(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->BindVertexBuffers(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindVertexBuffers)(
         RENDERPASS_COMMAND_BUFFER,
         first_binding,
         bindings,
@@ -1936,11 +2981,13 @@ void SDL_BindGPUIndexBuffer(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->BindIndexBuffer(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindIndexBuffer)(
         RENDERPASS_COMMAND_BUFFER,
         binding,
         index_element_size);
@@ -1961,7 +3008,7 @@ void SDL_BindGPUVertexSamplers(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
 
         if (!((CommandBufferCommonHeader*)RENDERPASS_COMMAND_BUFFER)->ignore_render_pass_texture_validation)
@@ -1974,7 +3021,9 @@ void SDL_BindGPUVertexSamplers(
         }
     }
 
-    RENDERPASS_DEVICE->BindVertexSamplers(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindVertexSamplers)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         texture_sampler_bindings,
@@ -1996,7 +3045,7 @@ void SDL_BindGPUVertexStorageTextures(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_STORAGE_TEXTURES
 
@@ -2005,7 +3054,9 @@ void SDL_BindGPUVertexStorageTextures(
         }
     }
 
-    RENDERPASS_DEVICE->BindVertexStorageTextures(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindVertexStorageTextures)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         storage_textures,
@@ -2027,7 +3078,7 @@ void SDL_BindGPUVertexStorageBuffers(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
 
         for (Uint32 i = 0; i < num_bindings; i += 1) {
@@ -2035,7 +3086,9 @@ void SDL_BindGPUVertexStorageBuffers(
         }
     }
 
-    RENDERPASS_DEVICE->BindVertexStorageBuffers(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindVertexStorageBuffers)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         storage_buffers,
@@ -2057,7 +3110,7 @@ void SDL_BindGPUFragmentSamplers(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
 
         if (!((CommandBufferCommonHeader*)RENDERPASS_COMMAND_BUFFER)->ignore_render_pass_texture_validation) {
@@ -2069,7 +3122,9 @@ void SDL_BindGPUFragmentSamplers(
         }
     }
 
-    RENDERPASS_DEVICE->BindFragmentSamplers(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindFragmentSamplers)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         texture_sampler_bindings,
@@ -2091,7 +3146,7 @@ void SDL_BindGPUFragmentStorageTextures(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_STORAGE_TEXTURES
 
@@ -2100,7 +3155,9 @@ void SDL_BindGPUFragmentStorageTextures(
         }
     }
 
-    RENDERPASS_DEVICE->BindFragmentStorageTextures(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindFragmentStorageTextures)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         storage_textures,
@@ -2122,7 +3179,7 @@ void SDL_BindGPUFragmentStorageBuffers(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
 
         for (Uint32 i = 0; i < num_bindings; i += 1) {
@@ -2130,7 +3187,9 @@ void SDL_BindGPUFragmentStorageBuffers(
         }
     }
 
-    RENDERPASS_DEVICE->BindFragmentStorageBuffers(
+    RENDERPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, BindFragmentStorageBuffers)(
         RENDERPASS_COMMAND_BUFFER,
         first_slot,
         storage_buffers,
@@ -2150,13 +3209,15 @@ void SDL_DrawGPUIndexedPrimitives(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_GRAPHICS_PIPELINE_BOUND
         SDL_GPU_CheckGraphicsBindings(render_pass);
     }
 
-    RENDERPASS_DEVICE->DrawIndexedPrimitives(
+    RENDERPASS_STATS.draw_calls++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, DrawIndexedPrimitives)(
         RENDERPASS_COMMAND_BUFFER,
         num_indices,
         num_instances,
@@ -2177,13 +3238,15 @@ void SDL_DrawGPUPrimitives(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_GRAPHICS_PIPELINE_BOUND
         SDL_GPU_CheckGraphicsBindings(render_pass);
     }
 
-    RENDERPASS_DEVICE->DrawPrimitives(
+    RENDERPASS_STATS.draw_calls++;
+
+    SDL_GPU_DIRECT_CALL(RENDERPASS_DEVICE, DrawPrimitives)(
         RENDERPASS_COMMAND_BUFFER,
         num_vertices,
         num_instances,
@@ -2206,12 +3269,14 @@ void SDL_DrawGPUPrimitivesIndirect(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_GRAPHICS_PIPELINE_BOUND
         SDL_GPU_CheckGraphicsBindings(render_pass);
     }
 
+    RENDERPASS_STATS.draw_calls++;
+
     RENDERPASS_DEVICE->DrawPrimitivesIndirect(
         RENDERPASS_COMMAND_BUFFER,
         buffer,
@@ -2234,12 +3299,14 @@ void SDL_DrawGPUIndexedPrimitivesIndirect(
         return;
     }
 
-    if (RENDERPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
         CHECK_RENDERPASS
         CHECK_GRAPHICS_PIPELINE_BOUND
         SDL_GPU_CheckGraphicsBindings(render_pass);
     }
 
+    RENDERPASS_STATS.draw_calls++;
+
     RENDERPASS_DEVICE->DrawIndexedPrimitivesIndirect(
         RENDERPASS_COMMAND_BUFFER,
         buffer,
@@ -2247,60 +3314,237 @@ void SDL_DrawGPUIndexedPrimitivesIndirect(
         draw_count);
 }
 
-void SDL_EndGPURenderPass(
-    SDL_GPURenderPass *render_pass)
+bool SDL_GPUSupportsIndirectCount(
+    SDL_GPUDevice *device)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+
+    if (!device->SupportsIndirectCount) {
+        return false;
+    }
+
+    return device->SupportsIndirectCount(device->driverData);
+}
+
+void SDL_DrawGPUPrimitivesIndirectCount(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *count_buffer,
+    Uint32 count_offset,
+    Uint32 max_draw_count)
 {
     if (render_pass == NULL) {
         SDL_InvalidParamError("render_pass");
         return;
     }
-
-    CommandBufferCommonHeader *commandBufferCommonHeader;
-    commandBufferCommonHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
-
-    if (RENDERPASS_DEVICE->debug_mode) {
-        CHECK_RENDERPASS
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (count_buffer == NULL) {
+        SDL_InvalidParamError("count_buffer");
+        return;
+    }
+    if (!SDL_GPUSupportsIndirectCount(RENDERPASS_DEVICE)) {
+        SDL_Unsupported();
+        return;
     }
 
-    RENDERPASS_DEVICE->EndRenderPass(
-        RENDERPASS_COMMAND_BUFFER);
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        CHECK_RENDERPASS
+        CHECK_GRAPHICS_PIPELINE_BOUND
+        SDL_GPU_CheckGraphicsBindings(render_pass);
 
-    if (RENDERPASS_DEVICE->debug_mode) {
-        commandBufferCommonHeader->render_pass.in_progress = false;
-        for (Uint32 i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1)
-        {
-            commandBufferCommonHeader->render_pass.color_targets[i] = NULL;
+        if ((offset & 3) != 0 || (count_offset & 3) != 0) {
+            SDL_assert_release(!"Indirect draw offsets must be multiples of 4!");
+            return;
         }
-        commandBufferCommonHeader->render_pass.num_color_targets = 0;
-        commandBufferCommonHeader->render_pass.depth_stencil_target = NULL;
-        commandBufferCommonHeader->render_pass.graphics_pipeline = NULL;
-        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_sampler_bound);
-        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_storage_texture_bound);
-        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_storage_buffer_bound);
-        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_sampler_bound);
-        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_storage_texture_bound);
-        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_storage_buffer_bound);
     }
-}
 
-// Compute Pass
+    RENDERPASS_STATS.draw_calls++;
 
-SDL_GPUComputePass *SDL_BeginGPUComputePass(
-    SDL_GPUCommandBuffer *command_buffer,
-    const SDL_GPUStorageTextureReadWriteBinding *storage_texture_bindings,
-    Uint32 num_storage_texture_bindings,
-    const SDL_GPUStorageBufferReadWriteBinding *storage_buffer_bindings,
-    Uint32 num_storage_buffer_bindings)
-{
-    CommandBufferCommonHeader *commandBufferHeader;
+    RENDERPASS_DEVICE->DrawPrimitivesIndirectCount(
+        RENDERPASS_COMMAND_BUFFER,
+        buffer,
+        offset,
+        count_buffer,
+        count_offset,
+        max_draw_count);
+}
 
-    if (command_buffer == NULL) {
-        SDL_InvalidParamError("command_buffer");
-        return NULL;
+void SDL_DrawGPUIndexedPrimitivesIndirectCount(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *count_buffer,
+    Uint32 count_offset,
+    Uint32 max_draw_count)
+{
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return;
     }
-    if (storage_texture_bindings == NULL && num_storage_texture_bindings > 0) {
-        SDL_InvalidParamError("storage_texture_bindings");
-        return NULL;
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (count_buffer == NULL) {
+        SDL_InvalidParamError("count_buffer");
+        return;
+    }
+    if (!SDL_GPUSupportsIndirectCount(RENDERPASS_DEVICE)) {
+        SDL_Unsupported();
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        CHECK_RENDERPASS
+        CHECK_GRAPHICS_PIPELINE_BOUND
+        SDL_GPU_CheckGraphicsBindings(render_pass);
+
+        if ((offset & 3) != 0 || (count_offset & 3) != 0) {
+            SDL_assert_release(!"Indirect draw offsets must be multiples of 4!");
+            return;
+        }
+    }
+
+    RENDERPASS_STATS.draw_calls++;
+
+    RENDERPASS_DEVICE->DrawIndexedPrimitivesIndirectCount(
+        RENDERPASS_COMMAND_BUFFER,
+        buffer,
+        offset,
+        count_buffer,
+        count_offset,
+        max_draw_count);
+}
+
+void SDL_DrawGPUMeshTasks(
+    SDL_GPURenderPass *render_pass,
+    Uint32 groupcount_x,
+    Uint32 groupcount_y,
+    Uint32 groupcount_z)
+{
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return;
+    }
+    if (RENDERPASS_DEVICE->DrawMeshTasks == NULL) {
+        SDL_Unsupported();
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        CHECK_RENDERPASS
+        CHECK_GRAPHICS_PIPELINE_BOUND
+        CHECK_MESH_PIPELINE_BOUND
+        SDL_GPU_CheckGraphicsBindings(render_pass);
+    }
+
+    RENDERPASS_STATS.draw_calls++;
+
+    RENDERPASS_DEVICE->DrawMeshTasks(
+        RENDERPASS_COMMAND_BUFFER,
+        groupcount_x,
+        groupcount_y,
+        groupcount_z);
+}
+
+void SDL_DrawGPUMeshTasksIndirect(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    Uint32 draw_count)
+{
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return;
+    }
+    if (buffer == NULL) {
+        SDL_InvalidParamError("buffer");
+        return;
+    }
+    if (RENDERPASS_DEVICE->DrawMeshTasks == NULL) {
+        SDL_Unsupported();
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        CHECK_RENDERPASS
+        CHECK_GRAPHICS_PIPELINE_BOUND
+        CHECK_MESH_PIPELINE_BOUND
+        SDL_GPU_CheckGraphicsBindings(render_pass);
+
+        if ((offset & 3) != 0) {
+            SDL_assert_release(!"Indirect draw offsets must be multiples of 4!");
+            return;
+        }
+    }
+
+    RENDERPASS_STATS.draw_calls++;
+
+    RENDERPASS_DEVICE->DrawMeshTasksIndirect(
+        RENDERPASS_COMMAND_BUFFER,
+        buffer,
+        offset,
+        draw_count);
+}
+
+void SDL_EndGPURenderPass(
+    SDL_GPURenderPass *render_pass)
+{
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return;
+    }
+
+    CommandBufferCommonHeader *commandBufferCommonHeader;
+    commandBufferCommonHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        CHECK_RENDERPASS
+    }
+
+    RENDERPASS_DEVICE->EndRenderPass(
+        RENDERPASS_COMMAND_BUFFER);
+
+    if (GPU_DEBUG_MODE(RENDERPASS_DEVICE)) {
+        commandBufferCommonHeader->render_pass.in_progress = false;
+        for (Uint32 i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1)
+        {
+            commandBufferCommonHeader->render_pass.color_targets[i] = NULL;
+        }
+        commandBufferCommonHeader->render_pass.num_color_targets = 0;
+        commandBufferCommonHeader->render_pass.depth_stencil_target = NULL;
+        commandBufferCommonHeader->render_pass.graphics_pipeline = NULL;
+        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_sampler_bound);
+        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_storage_texture_bound);
+        SDL_zeroa(commandBufferCommonHeader->render_pass.vertex_storage_buffer_bound);
+        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_sampler_bound);
+        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_storage_texture_bound);
+        SDL_zeroa(commandBufferCommonHeader->render_pass.fragment_storage_buffer_bound);
+    }
+}
+
+// Compute Pass
+
+SDL_GPUComputePass *SDL_BeginGPUComputePass(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUStorageTextureReadWriteBinding *storage_texture_bindings,
+    Uint32 num_storage_texture_bindings,
+    const SDL_GPUStorageBufferReadWriteBinding *storage_buffer_bindings,
+    Uint32 num_storage_buffer_bindings)
+{
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return NULL;
+    }
+    if (storage_texture_bindings == NULL && num_storage_texture_bindings > 0) {
+        SDL_InvalidParamError("storage_texture_bindings");
+        return NULL;
     }
     if (storage_buffer_bindings == NULL && num_storage_buffer_bindings > 0) {
         SDL_InvalidParamError("storage_buffer_bindings");
@@ -2314,9 +3558,10 @@ SDL_GPUComputePass *SDL_BeginGPUComputePass(
         SDL_InvalidParamError("num_storage_buffer_bindings");
         return NULL;
     }
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         CHECK_ANY_PASS_IN_PROGRESS("Cannot begin compute pass during another pass!", NULL)
+        CHECK_QUEUE_TYPE(QUEUE_TYPE != SDL_GPU_QUEUETYPE_TRANSFER, "Compute passes cannot be recorded on a transfer queue command buffer!", NULL)
 
         for (Uint32 i = 0; i < num_storage_texture_bindings; i += 1) {
             TextureCommonHeader *header = (TextureCommonHeader *)storage_texture_bindings[i].texture;
@@ -2348,7 +3593,7 @@ SDL_GPUComputePass *SDL_BeginGPUComputePass(
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         commandBufferHeader->compute_pass.in_progress = true;
 
         for (Uint32 i = 0; i < num_storage_texture_bindings; i += 1) {
@@ -2376,16 +3621,18 @@ void SDL_BindGPUComputePipeline(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
     }
 
-    COMPUTEPASS_DEVICE->BindComputePipeline(
+    COMPUTEPASS_STATS.pipeline_binds++;
+
+    SDL_GPU_DIRECT_CALL(COMPUTEPASS_DEVICE, BindComputePipeline)(
         COMPUTEPASS_COMMAND_BUFFER,
         compute_pipeline);
 
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         COMPUTEPASS_BOUND_PIPELINE = compute_pipeline;
     }
 }
@@ -2405,7 +3652,7 @@ void SDL_BindGPUComputeSamplers(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
 
         for (Uint32 i = 0; i < num_bindings; i += 1) {
@@ -2413,7 +3660,9 @@ void SDL_BindGPUComputeSamplers(
         }
     }
 
-    COMPUTEPASS_DEVICE->BindComputeSamplers(
+    COMPUTEPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(COMPUTEPASS_DEVICE, BindComputeSamplers)(
         COMPUTEPASS_COMMAND_BUFFER,
         first_slot,
         texture_sampler_bindings,
@@ -2435,7 +3684,7 @@ void SDL_BindGPUComputeStorageTextures(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
 
         for (Uint32 i = 0; i < num_bindings; i += 1) {
@@ -2443,7 +3692,9 @@ void SDL_BindGPUComputeStorageTextures(
         }
     }
 
-    COMPUTEPASS_DEVICE->BindComputeStorageTextures(
+    COMPUTEPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(COMPUTEPASS_DEVICE, BindComputeStorageTextures)(
         COMPUTEPASS_COMMAND_BUFFER,
         first_slot,
         storage_textures,
@@ -2465,7 +3716,7 @@ void SDL_BindGPUComputeStorageBuffers(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
 
         for (Uint32 i = 0; i < num_bindings; i += 1) {
@@ -2473,7 +3724,9 @@ void SDL_BindGPUComputeStorageBuffers(
         }
     }
 
-    COMPUTEPASS_DEVICE->BindComputeStorageBuffers(
+    COMPUTEPASS_STATS.resource_binds++;
+
+    SDL_GPU_DIRECT_CALL(COMPUTEPASS_DEVICE, BindComputeStorageBuffers)(
         COMPUTEPASS_COMMAND_BUFFER,
         first_slot,
         storage_buffers,
@@ -2491,13 +3744,15 @@ void SDL_DispatchGPUCompute(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
         CHECK_COMPUTE_PIPELINE_BOUND
         SDL_GPU_CheckComputeBindings(compute_pass);
     }
 
-    COMPUTEPASS_DEVICE->DispatchCompute(
+    COMPUTEPASS_STATS.dispatches++;
+
+    SDL_GPU_DIRECT_CALL(COMPUTEPASS_DEVICE, DispatchCompute)(
         COMPUTEPASS_COMMAND_BUFFER,
         groupcount_x,
         groupcount_y,
@@ -2514,12 +3769,14 @@ void SDL_DispatchGPUComputeIndirect(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
         CHECK_COMPUTE_PIPELINE_BOUND
         SDL_GPU_CheckComputeBindings(compute_pass);
     }
 
+    COMPUTEPASS_STATS.dispatches++;
+
     COMPUTEPASS_DEVICE->DispatchComputeIndirect(
         COMPUTEPASS_COMMAND_BUFFER,
         buffer,
@@ -2536,14 +3793,14 @@ void SDL_EndGPUComputePass(
         return;
     }
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         CHECK_COMPUTEPASS
     }
 
     COMPUTEPASS_DEVICE->EndComputePass(
         COMPUTEPASS_COMMAND_BUFFER);
 
-    if (COMPUTEPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMPUTEPASS_DEVICE)) {
         commandBufferCommonHeader = (CommandBufferCommonHeader *)COMPUTEPASS_COMMAND_BUFFER;
         commandBufferCommonHeader->compute_pass.in_progress = false;
         commandBufferCommonHeader->compute_pass.compute_pipeline = NULL;
@@ -2589,6 +3846,88 @@ void SDL_UnmapGPUTransferBuffer(
         transfer_buffer);
 }
 
+// Transient Allocation
+
+bool SDL_AcquireGPUTransientBuffer(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUBufferUsageFlags usage,
+    Uint32 size,
+    SDL_GPUBufferRegion *region)
+{
+    TransientBlock *block;
+    Uint32 offset;
+
+    if (command_buffer == NULL) {
+        return SDL_InvalidParamError("command_buffer");
+    }
+    if (size == 0) {
+        return SDL_InvalidParamError("size");
+    }
+    if (region == NULL) {
+        return SDL_InvalidParamError("region");
+    }
+    if (usage == 0 || (usage & ~TRANSIENT_BUFFER_USAGE_MASK) != 0) {
+        return SDL_SetError("Transient buffers only support vertex, index and indirect usage");
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER_RETURN_FALSE
+    }
+
+    block = SDL_GPU_AcquireTransientBlock(
+        (CommandBufferCommonHeader *)command_buffer,
+        usage,
+        size,
+        &offset);
+    if (block == NULL) {
+        return false;
+    }
+
+    region->buffer = block->buffer;
+    region->offset = offset;
+    region->size = size;
+    return true;
+}
+
+void *SDL_AcquireGPUTransientTransferBuffer(
+    SDL_GPUCommandBuffer *command_buffer,
+    Uint32 size,
+    SDL_GPUTransferBufferLocation *location)
+{
+    TransientBlock *block;
+    Uint32 offset;
+
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return NULL;
+    }
+    if (size == 0) {
+        SDL_InvalidParamError("size");
+        return NULL;
+    }
+    if (location == NULL) {
+        SDL_InvalidParamError("location");
+        return NULL;
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER_RETURN_NULL
+    }
+
+    block = SDL_GPU_AcquireTransientBlock(
+        (CommandBufferCommonHeader *)command_buffer,
+        0,
+        size,
+        &offset);
+    if (block == NULL) {
+        return NULL;
+    }
+
+    location->transfer_buffer = block->transfer_buffer;
+    location->offset = offset;
+    return block->mapped + offset;
+}
+
 // Copy Pass
 
 SDL_GPUCopyPass *SDL_BeginGPUCopyPass(
@@ -2601,7 +3940,7 @@ SDL_GPUCopyPass *SDL_BeginGPUCopyPass(
         return NULL;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         CHECK_ANY_PASS_IN_PROGRESS("Cannot begin copy pass during another pass!", NULL)
     }
@@ -2611,7 +3950,7 @@ SDL_GPUCopyPass *SDL_BeginGPUCopyPass(
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         commandBufferHeader->copy_pass.in_progress = true;
     }
 
@@ -2637,7 +3976,7 @@ void SDL_UploadToGPUTexture(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->transfer_buffer == NULL) {
             SDL_assert_release(!"Source transfer buffer cannot be NULL!");
@@ -2649,6 +3988,12 @@ void SDL_UploadToGPUTexture(
         }
     }
 
+    COPYPASS_STATS.upload_bytes += SDL_CalculateGPUTextureFormatSize(
+        ((TextureCommonHeader *)destination->texture)->info.format,
+        destination->w,
+        destination->h,
+        destination->d);
+
     COPYPASS_DEVICE->UploadToTexture(
         COPYPASS_COMMAND_BUFFER,
         source,
@@ -2675,7 +4020,7 @@ void SDL_UploadToGPUBuffer(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->transfer_buffer == NULL) {
             SDL_assert_release(!"Source transfer buffer cannot be NULL!");
@@ -2687,6 +4032,8 @@ void SDL_UploadToGPUBuffer(
         }
     }
 
+    COPYPASS_STATS.upload_bytes += destination->size;
+
     COPYPASS_DEVICE->UploadToBuffer(
         COPYPASS_COMMAND_BUFFER,
         source,
@@ -2716,7 +4063,7 @@ void SDL_CopyGPUTextureToTexture(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->texture == NULL) {
             SDL_assert_release(!"Source texture cannot be NULL!");
@@ -2758,7 +4105,7 @@ void SDL_CopyGPUBufferToBuffer(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->buffer == NULL) {
             SDL_assert_release(!"Source buffer cannot be NULL!");
@@ -2796,7 +4143,7 @@ void SDL_DownloadFromGPUTexture(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->texture == NULL) {
             SDL_assert_release(!"Source texture cannot be NULL!");
@@ -2832,7 +4179,7 @@ void SDL_DownloadFromGPUBuffer(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
         if (source->buffer == NULL) {
             SDL_assert_release(!"Source buffer cannot be NULL!");
@@ -2858,14 +4205,14 @@ void SDL_EndGPUCopyPass(
         return;
     }
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         CHECK_COPYPASS
     }
 
     COPYPASS_DEVICE->EndCopyPass(
         COPYPASS_COMMAND_BUFFER);
 
-    if (COPYPASS_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COPYPASS_DEVICE)) {
         ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->copy_pass.in_progress = false;
     }
 }
@@ -2883,9 +4230,10 @@ void SDL_GenerateMipmapsForGPUTexture(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
         CHECK_ANY_PASS_IN_PROGRESS("Cannot generate mipmaps during a pass!", )
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Generating mipmaps requires a graphics queue command buffer!", )
 
         TextureCommonHeader *header = (TextureCommonHeader *)texture;
         if (header->info.num_levels <= 1) {
@@ -2906,12 +4254,191 @@ void SDL_GenerateMipmapsForGPUTexture(
         command_buffer,
         texture);
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CommandBufferCommonHeader *commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
         commandBufferHeader->ignore_render_pass_texture_validation = false;
     }
 }
 
+// Surface Upload
+
+static SDL_PixelFormat SDL_GPU_GetSurfaceUploadFormat(SDL_GPUTextureFormat format)
+{
+    switch (format) {
+    case SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM:
+    case SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM_SRGB:
+        return SDL_PIXELFORMAT_RGBA32;
+    case SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM:
+    case SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM_SRGB:
+        return SDL_PIXELFORMAT_BGRA32;
+    case SDL_GPU_TEXTUREFORMAT_B5G6R5_UNORM:
+        return SDL_PIXELFORMAT_BGR565;
+    case SDL_GPU_TEXTUREFORMAT_B5G5R5A1_UNORM:
+        return SDL_PIXELFORMAT_BGRA5551;
+    case SDL_GPU_TEXTUREFORMAT_B4G4R4A4_UNORM:
+        return SDL_PIXELFORMAT_BGRA4444;
+    case SDL_GPU_TEXTUREFORMAT_R10G10B10A2_UNORM:
+        return SDL_PIXELFORMAT_ABGR2101010;
+    case SDL_GPU_TEXTUREFORMAT_R16G16B16A16_UNORM:
+        return SDL_PIXELFORMAT_RGBA64;
+    case SDL_GPU_TEXTUREFORMAT_R16G16B16A16_FLOAT:
+        return SDL_PIXELFORMAT_RGBA64_FLOAT;
+    case SDL_GPU_TEXTUREFORMAT_R32G32B32A32_FLOAT:
+        return SDL_PIXELFORMAT_RGBA128_FLOAT;
+    default:
+        return SDL_PIXELFORMAT_UNKNOWN;
+    }
+}
+
+// Converts the surface straight into the mapped upload memory
+static bool SDL_GPU_WriteSurfacePixels(SDL_Surface *surface, SDL_PixelFormat format, void *pixels, int pitch, bool premultiply)
+{
+    SDL_Surface *converted = NULL;
+    SDL_Colorspace colorspace = SDL_GetDefaultColorspaceForFormat(format);
+    bool result;
+
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
+        // Expand the palette, the pixel conversion functions don't take one
+        converted = SDL_ConvertSurface(surface, format);
+        if (converted == NULL) {
+            return false;
+        }
+        surface = converted;
+    }
+
+    if (!SDL_LockSurface(surface)) {
+        SDL_DestroySurface(converted);
+        return false;
+    }
+    if (premultiply && SDL_ISPIXELFORMAT_ALPHA(surface->format) && SDL_ISPIXELFORMAT_ALPHA(format)) {
+        result = SDL_PremultiplyAlpha(surface->w, surface->h,
+            surface->format, surface->pixels, surface->pitch,
+            format, pixels, pitch, false);
+    } else {
+        result = SDL_ConvertPixelsAndColorspace(surface->w, surface->h,
+            surface->format, SDL_GetSurfaceColorspace(surface), SDL_GetSurfaceProperties(surface), surface->pixels, surface->pitch,
+            format, colorspace, 0, pixels, pitch);
+    }
+    SDL_UnlockSurface(surface);
+
+    SDL_DestroySurface(converted);
+    return result;
+}
+
+bool SDL_UploadSurfaceToGPUTexture(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_Surface *surface,
+    const SDL_GPUTextureRegion *destination,
+    SDL_PropertiesID props)
+{
+    SDL_GPUTransferBufferLocation location;
+    SDL_GPUTextureTransferInfo source;
+    SDL_GPUCopyPass *copy_pass;
+    TextureCommonHeader *header;
+    SDL_PixelFormat format;
+    Uint64 size;
+    int pitch;
+    void *pixels;
+    const bool premultiply = SDL_GetBooleanProperty(props, SDL_PROP_GPU_UPLOAD_SURFACE_PREMULTIPLY_ALPHA_BOOLEAN, false);
+    const bool generate_mipmaps = SDL_GetBooleanProperty(props, SDL_PROP_GPU_UPLOAD_SURFACE_GENERATE_MIPMAPS_BOOLEAN, false);
+    const bool cycle = SDL_GetBooleanProperty(props, SDL_PROP_GPU_UPLOAD_SURFACE_CYCLE_BOOLEAN, false);
+
+    if (command_buffer == NULL) {
+        return SDL_InvalidParamError("command_buffer");
+    }
+    if (!SDL_SurfaceValid(surface)) {
+        return SDL_InvalidParamError("surface");
+    }
+    if (destination == NULL || destination->texture == NULL) {
+        return SDL_InvalidParamError("destination");
+    }
+    if ((int)destination->w != surface->w || (int)destination->h != surface->h || destination->d > 1) {
+        return SDL_SetError("Destination region must be the size of the surface");
+    }
+
+    header = (TextureCommonHeader *)destination->texture;
+    format = SDL_GPU_GetSurfaceUploadFormat(header->info.format);
+    if (format == SDL_PIXELFORMAT_UNKNOWN) {
+        return SDL_SetError("Surfaces can't be uploaded to textures of this format");
+    }
+    if (generate_mipmaps && destination->mip_level != 0) {
+        return SDL_SetError("Mipmaps can only be generated from mip level 0");
+    }
+
+    pitch = surface->w * SDL_BYTESPERPIXEL(format);
+    size = (Uint64)pitch * surface->h;
+    if (size > SDL_MAX_UINT32) {
+        return SDL_SetError("Surface is too large to upload");
+    }
+
+    pixels = SDL_AcquireGPUTransientTransferBuffer(command_buffer, (Uint32)size, &location);
+    if (pixels == NULL) {
+        return false;
+    }
+    if (!SDL_GPU_WriteSurfacePixels(surface, format, pixels, pitch, premultiply)) {
+        return false;
+    }
+
+    source.transfer_buffer = location.transfer_buffer;
+    source.offset = location.offset;
+    source.pixels_per_row = surface->w;
+    source.rows_per_layer = surface->h;
+
+    copy_pass = SDL_BeginGPUCopyPass(command_buffer);
+    if (copy_pass == NULL) {
+        return false;
+    }
+    SDL_UploadToGPUTexture(copy_pass, &source, destination, cycle);
+    SDL_EndGPUCopyPass(copy_pass);
+
+    if (generate_mipmaps && header->info.num_levels > 1) {
+        SDL_GenerateMipmapsForGPUTexture(command_buffer, destination->texture);
+    }
+    return true;
+}
+
+static bool SDL_GPU_CheckBlitInfo(const SDL_GPUBlitInfo *info)
+{
+    bool failed = false;
+    TextureCommonHeader *srcHeader = (TextureCommonHeader *)info->source.texture;
+    TextureCommonHeader *dstHeader = (TextureCommonHeader *)info->destination.texture;
+
+    if (srcHeader == NULL) {
+        SDL_assert_release(!"Blit source texture must be non-NULL");
+        return false; // attempting to proceed will crash
+    }
+    if (dstHeader == NULL) {
+        SDL_assert_release(!"Blit destination texture must be non-NULL");
+        return false; // attempting to proceed will crash
+    }
+    if (srcHeader->info.sample_count != SDL_GPU_SAMPLECOUNT_1) {
+        SDL_assert_release(!"Blit source texture must have a sample count of 1");
+        failed = true;
+    }
+    if ((srcHeader->info.usage & SDL_GPU_TEXTUREUSAGE_SAMPLER) == 0) {
+        SDL_assert_release(!"Blit source texture must be created with the SAMPLER usage flag");
+        failed = true;
+    }
+    if ((dstHeader->info.usage & SDL_GPU_TEXTUREUSAGE_COLOR_TARGET) == 0) {
+        SDL_assert_release(!"Blit destination texture must be created with the COLOR_TARGET usage flag");
+        failed = true;
+    }
+    if (dstHeader->info.usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+        SDL_assert_release(!"Blit destination texture must not be transient");
+        failed = true;
+    }
+    if (IsDepthFormat(srcHeader->info.format)) {
+        SDL_assert_release(!"Blit source texture cannot have a depth format");
+        failed = true;
+    }
+    if (info->source.w == 0 || info->source.h == 0 || info->destination.w == 0 || info->destination.h == 0) {
+        SDL_assert_release(!"Blit source/destination regions must have non-zero width, height, and depth");
+        failed = true;
+    }
+
+    return !failed;
+}
+
 void SDL_BlitGPUTexture(
     SDL_GPUCommandBuffer *command_buffer,
     const SDL_GPUBlitInfo *info)
@@ -2925,52 +4452,55 @@ void SDL_BlitGPUTexture(
         return;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER
         CHECK_ANY_PASS_IN_PROGRESS("Cannot blit during a pass!", )
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Blitting requires a graphics queue command buffer!", )
 
-        // Validation
-        bool failed = false;
-        TextureCommonHeader *srcHeader = (TextureCommonHeader *)info->source.texture;
-        TextureCommonHeader *dstHeader = (TextureCommonHeader *)info->destination.texture;
-
-        if (srcHeader == NULL) {
-            SDL_assert_release(!"Blit source texture must be non-NULL");
-            return; // attempting to proceed will crash
-        }
-        if (dstHeader == NULL) {
-            SDL_assert_release(!"Blit destination texture must be non-NULL");
-            return; // attempting to proceed will crash
-        }
-        if (srcHeader->info.sample_count != SDL_GPU_SAMPLECOUNT_1) {
-            SDL_assert_release(!"Blit source texture must have a sample count of 1");
-            failed = true;
-        }
-        if ((srcHeader->info.usage & SDL_GPU_TEXTUREUSAGE_SAMPLER) == 0) {
-            SDL_assert_release(!"Blit source texture must be created with the SAMPLER usage flag");
-            failed = true;
-        }
-        if ((dstHeader->info.usage & SDL_GPU_TEXTUREUSAGE_COLOR_TARGET) == 0) {
-            SDL_assert_release(!"Blit destination texture must be created with the COLOR_TARGET usage flag");
-            failed = true;
-        }
-        if (IsDepthFormat(srcHeader->info.format)) {
-            SDL_assert_release(!"Blit source texture cannot have a depth format");
-            failed = true;
-        }
-        if (info->source.w == 0 || info->source.h == 0 || info->destination.w == 0 || info->destination.h == 0) {
-            SDL_assert_release(!"Blit source/destination regions must have non-zero width, height, and depth");
-            failed = true;
+        if (!SDL_GPU_CheckBlitInfo(info)) {
+            return;
         }
+    }
 
-        if (failed) {
-            return;
+    COMMAND_BUFFER_DEVICE->Blit(
+        command_buffer,
+        info,
+        1);
+}
+
+void SDL_BlitGPUTextures(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUBlitInfo *infos,
+    Uint32 num_infos)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return;
+    }
+    if (infos == NULL && num_infos > 0) {
+        SDL_InvalidParamError("infos");
+        return;
+    }
+    if (num_infos == 0) {
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER
+        CHECK_ANY_PASS_IN_PROGRESS("Cannot blit during a pass!", )
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Blitting requires a graphics queue command buffer!", )
+
+        for (Uint32 i = 0; i < num_infos; i += 1) {
+            if (!SDL_GPU_CheckBlitInfo(&infos[i])) {
+                return;
+            }
         }
     }
 
     COMMAND_BUFFER_DEVICE->Blit(
         command_buffer,
-        info);
+        infos,
+        num_infos);
 }
 
 // Submission/Presentation
@@ -2986,7 +4516,7 @@ bool SDL_WindowSupportsGPUSwapchainComposition(
         return false;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         CHECK_SWAPCHAINCOMPOSITION_ENUM_INVALID(swapchain_composition, false)
     }
 
@@ -3007,7 +4537,7 @@ bool SDL_WindowSupportsGPUPresentMode(
         return false;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         CHECK_PRESENTMODE_ENUM_INVALID(present_mode, false)
     }
 
@@ -3062,7 +4592,7 @@ bool SDL_SetGPUSwapchainParameters(
         return false;
     }
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         CHECK_SWAPCHAINCOMPOSITION_ENUM_INVALID(swapchain_composition, false)
         CHECK_PRESENTMODE_ENUM_INVALID(present_mode, false)
     }
@@ -3080,7 +4610,7 @@ bool SDL_SetGPUAllowedFramesInFlight(
 {
     CHECK_DEVICE_MAGIC(device, false);
 
-    if (device->debug_mode) {
+    if (GPU_DEBUG_MODE(device)) {
         if (allowed_frames_in_flight < 1 || allowed_frames_in_flight > 3)
         {
             SDL_assert_release(!"allowed_frames_in_flight value must be between 1 and 3!");
@@ -3108,6 +4638,32 @@ SDL_GPUTextureFormat SDL_GetGPUSwapchainTextureFormat(
         window);
 }
 
+static void SDL_GPU_LimitFrameRate(SDL_GPUDevice *device)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_GPU_FRAME_RATE_LIMIT);
+    int frame_rate = hint ? SDL_atoi(hint) : 0;
+    Uint64 interval, now;
+
+    if (frame_rate <= 0) {
+        device->next_frame_ns = 0;
+        return;
+    }
+
+    interval = SDL_NS_PER_SECOND / frame_rate;
+    now = SDL_GetTicksNS();
+    if (device->next_frame_ns > now) {
+        SDL_DelayPrecise(device->next_frame_ns - now);
+        now = device->next_frame_ns;
+    }
+
+    // Don't try to catch up after a long stall, just restart the schedule
+    if (device->next_frame_ns == 0 || (now - device->next_frame_ns) > interval) {
+        device->next_frame_ns = now + interval;
+    } else {
+        device->next_frame_ns += interval;
+    }
+}
+
 bool SDL_AcquireGPUSwapchainTexture(
     SDL_GPUCommandBuffer *command_buffer,
     SDL_Window *window,
@@ -3127,11 +4683,14 @@ bool SDL_AcquireGPUSwapchainTexture(
         return SDL_InvalidParamError("swapchain_texture");
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_FALSE
         CHECK_ANY_PASS_IN_PROGRESS("Cannot acquire a swapchain texture during a pass!", false)
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Swapchain textures require a graphics queue command buffer!", false)
     }
 
+    SDL_GPU_LimitFrameRate(COMMAND_BUFFER_DEVICE);
+
     bool result = COMMAND_BUFFER_DEVICE->AcquireSwapchainTexture(
         command_buffer,
         window,
@@ -3180,11 +4739,14 @@ bool SDL_WaitAndAcquireGPUSwapchainTexture(
         return SDL_InvalidParamError("swapchain_texture");
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_FALSE
         CHECK_ANY_PASS_IN_PROGRESS("Cannot acquire a swapchain texture during a pass!", false)
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Swapchain textures require a graphics queue command buffer!", false)
     }
 
+    SDL_GPU_LimitFrameRate(COMMAND_BUFFER_DEVICE);
+
     bool result = COMMAND_BUFFER_DEVICE->WaitAndAcquireSwapchainTexture(
         command_buffer,
         window,
@@ -3199,7 +4761,7 @@ bool SDL_WaitAndAcquireGPUSwapchainTexture(
     return result;
 }
 
-bool SDL_SubmitGPUCommandBuffer(
+static bool SDL_SubmitGPUCommandBufferInternal(
     SDL_GPUCommandBuffer *command_buffer)
 {
     CommandBufferCommonHeader *commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
@@ -3209,7 +4771,7 @@ bool SDL_SubmitGPUCommandBuffer(
         return false;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_FALSE
         if (
             commandBufferHeader->render_pass.in_progress ||
@@ -3221,11 +4783,32 @@ bool SDL_SubmitGPUCommandBuffer(
     }
 
     commandBufferHeader->submitted = true;
+    SDL_GPU_AccumulateStats(COMMAND_BUFFER_DEVICE, &commandBufferHeader->stats);
+
+    if (commandBufferHeader->transient_blocks != NULL) {
+        // The transient blocks can only be recycled once we know the submission has completed
+        TransientBlock *blocks = SDL_GPU_DetachTransientBlocks(commandBufferHeader);
+        SDL_GPUFence *fence = COMMAND_BUFFER_DEVICE->SubmitAndAcquireFence(
+            command_buffer);
+        SDL_GPU_QueueTransientBlocks(COMMAND_BUFFER_DEVICE, blocks, fence);
+        return fence != NULL;
+    }
 
     return COMMAND_BUFFER_DEVICE->Submit(
         command_buffer);
 }
 
+bool SDL_SubmitGPUCommandBuffer(
+    SDL_GPUCommandBuffer *command_buffer)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_GPU);
+    SDL_TRACE_BEGIN("SDL_SubmitGPUCommandBuffer");
+    bool result = SDL_SubmitGPUCommandBufferInternal(command_buffer);
+    SDL_TRACE_END("SDL_SubmitGPUCommandBuffer");
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 SDL_GPUFence *SDL_SubmitGPUCommandBufferAndAcquireFence(
     SDL_GPUCommandBuffer *command_buffer)
 {
@@ -3236,7 +4819,7 @@ SDL_GPUFence *SDL_SubmitGPUCommandBufferAndAcquireFence(
         return NULL;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         if (
             commandBufferHeader->render_pass.in_progress ||
@@ -3248,11 +4831,50 @@ SDL_GPUFence *SDL_SubmitGPUCommandBufferAndAcquireFence(
     }
 
     commandBufferHeader->submitted = true;
+    SDL_GPU_AccumulateStats(COMMAND_BUFFER_DEVICE, &commandBufferHeader->stats);
+
+    if (commandBufferHeader->transient_blocks != NULL) {
+        SDL_GPUDevice *device = COMMAND_BUFFER_DEVICE;
+        TransientBlock *blocks = SDL_GPU_DetachTransientBlocks(commandBufferHeader);
+        SDL_GPUFence *fence = device->SubmitAndAcquireFence(
+            command_buffer);
+        if (fence != NULL) {
+            // One reference for the caller, one for the transient allocator
+            device->RetainFence(device->driverData, fence);
+        }
+        SDL_GPU_QueueTransientBlocks(device, blocks, fence);
+        return fence;
+    }
 
     return COMMAND_BUFFER_DEVICE->SubmitAndAcquireFence(
         command_buffer);
 }
 
+bool SDL_AddGPUCommandBufferWaitFence(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUFence *fence)
+{
+    if (command_buffer == NULL) {
+        return SDL_InvalidParamError("command_buffer");
+    }
+    if (fence == NULL) {
+        return SDL_InvalidParamError("fence");
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER_RETURN_FALSE
+    }
+
+    // A single queue executes submissions in order, so there is nothing to wait for
+    if (!COMMAND_BUFFER_DEVICE->AddWaitFence) {
+        return true;
+    }
+
+    return COMMAND_BUFFER_DEVICE->AddWaitFence(
+        command_buffer,
+        fence);
+}
+
 bool SDL_CancelGPUCommandBuffer(
     SDL_GPUCommandBuffer *command_buffer)
 {
@@ -3263,13 +4885,18 @@ bool SDL_CancelGPUCommandBuffer(
         return false;
     }
 
-    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
         if (commandBufferHeader->swapchain_texture_acquired) {
             SDL_assert_release(!"Cannot cancel command buffer after a swapchain texture has been acquired!");
             return false;
         }
     }
 
+    if (commandBufferHeader->transient_blocks != NULL) {
+        TransientBlock *blocks = SDL_GPU_DetachTransientBlocks(commandBufferHeader);
+        SDL_GPU_QueueTransientBlocks(COMMAND_BUFFER_DEVICE, blocks, NULL);
+    }
+
     return COMMAND_BUFFER_DEVICE->Cancel(
         command_buffer);
 }
@@ -3279,8 +4906,15 @@ bool SDL_WaitForGPUIdle(
 {
     CHECK_DEVICE_MAGIC(device, false);
 
-    return device->Wait(
-        device->driverData);
+    if (!device->Wait(device->driverData)) {
+        return false;
+    }
+
+    SDL_LockMutex(device->transient_lock);
+    SDL_GPU_RetireTransientBatches(device);
+    SDL_UnlockMutex(device->transient_lock);
+
+    return true;
 }
 
 bool SDL_WaitForGPUFences(
@@ -3331,6 +4965,181 @@ void SDL_ReleaseGPUFence(
         fence);
 }
 
+// Queries
+
+SDL_GPUQueryPool *SDL_CreateGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryType type,
+    Uint32 num_queries)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    if (type != SDL_GPU_QUERYTYPE_TIMESTAMP &&
+        type != SDL_GPU_QUERYTYPE_PIPELINE_STATISTICS) {
+        SDL_InvalidParamError("type");
+        return NULL;
+    }
+    if (num_queries == 0) {
+        SDL_InvalidParamError("num_queries");
+        return NULL;
+    }
+    if (!device->CreateQueryPool) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    return device->CreateQueryPool(
+        device->driverData,
+        type,
+        num_queries);
+}
+
+void SDL_WriteGPUTimestamp(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return;
+    }
+    if (query_pool == NULL) {
+        SDL_InvalidParamError("query_pool");
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER
+        CHECK_ANY_PASS_IN_PROGRESS("Cannot write a timestamp during a pass!", )
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Queries require a graphics queue command buffer!", )
+
+        if (((QueryPoolCommonHeader *)query_pool)->type != SDL_GPU_QUERYTYPE_TIMESTAMP) {
+            SDL_assert_release(!"Query pool is not a timestamp pool!");
+            return;
+        }
+        if (index >= ((QueryPoolCommonHeader *)query_pool)->num_queries) {
+            SDL_assert_release(!"Query index out of range!");
+            return;
+        }
+    }
+
+    COMMAND_BUFFER_DEVICE->WriteTimestamp(
+        command_buffer,
+        query_pool,
+        index);
+}
+
+void SDL_BeginGPUQuery(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return;
+    }
+    if (query_pool == NULL) {
+        SDL_InvalidParamError("query_pool");
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER
+        CHECK_ANY_PASS_IN_PROGRESS("Cannot begin a query during a pass!", )
+        CHECK_QUEUE_TYPE(QUEUE_TYPE == SDL_GPU_QUEUETYPE_GRAPHICS, "Queries require a graphics queue command buffer!", )
+
+        if (((QueryPoolCommonHeader *)query_pool)->type != SDL_GPU_QUERYTYPE_PIPELINE_STATISTICS) {
+            SDL_assert_release(!"Query pool is not a pipeline statistics pool!");
+            return;
+        }
+        if (index >= ((QueryPoolCommonHeader *)query_pool)->num_queries) {
+            SDL_assert_release(!"Query index out of range!");
+            return;
+        }
+    }
+
+    COMMAND_BUFFER_DEVICE->BeginQuery(
+        command_buffer,
+        query_pool,
+        index);
+}
+
+void SDL_EndGPUQuery(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 index)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return;
+    }
+    if (query_pool == NULL) {
+        SDL_InvalidParamError("query_pool");
+        return;
+    }
+
+    if (GPU_DEBUG_MODE(COMMAND_BUFFER_DEVICE)) {
+        CHECK_COMMAND_BUFFER
+        CHECK_ANY_PASS_IN_PROGRESS("Cannot end a query during a pass!", )
+
+        if (((QueryPoolCommonHeader *)query_pool)->type != SDL_GPU_QUERYTYPE_PIPELINE_STATISTICS) {
+            SDL_assert_release(!"Query pool is not a pipeline statistics pool!");
+            return;
+        }
+        if (index >= ((QueryPoolCommonHeader *)query_pool)->num_queries) {
+            SDL_assert_release(!"Query index out of range!");
+            return;
+        }
+    }
+
+    COMMAND_BUFFER_DEVICE->EndQuery(
+        command_buffer,
+        query_pool,
+        index);
+}
+
+bool SDL_GetGPUQueryResults(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 first_query,
+    Uint32 num_queries,
+    void *data)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+    if (query_pool == NULL) {
+        return SDL_InvalidParamError("query_pool");
+    }
+    if (data == NULL) {
+        return SDL_InvalidParamError("data");
+    }
+    if (num_queries == 0 ||
+        first_query >= ((QueryPoolCommonHeader *)query_pool)->num_queries ||
+        num_queries > ((QueryPoolCommonHeader *)query_pool)->num_queries - first_query) {
+        return SDL_SetError("Query range out of bounds");
+    }
+
+    return device->GetQueryResults(
+        device->driverData,
+        query_pool,
+        first_query,
+        num_queries,
+        data);
+}
+
+void SDL_ReleaseGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (query_pool == NULL) {
+        return;
+    }
+
+    device->ReleaseQueryPool(
+        device->driverData,
+        query_pool);
+}
+
 Uint32 SDL_CalculateGPUTextureFormatSize(
     SDL_GPUTextureFormat format,
     Uint32 width,
@@ -3343,3 +5152,194 @@ Uint32 SDL_CalculateGPUTextureFormatSize(
     Uint32 blocksPerColumn = (height + blockHeight - 1) / blockHeight;
     return depth_or_layer_count * blocksPerRow * blocksPerColumn * SDL_GPUTextureFormatTexelBlockSize(format);
 }
+
+// Real-time block compression
+
+static Uint16 GPU_INTERNAL_PackRGB565(const Uint8 *c)
+{
+    return (Uint16)(((c[0] * 31 + 127) / 255) << 11 |
+                    ((c[1] * 63 + 127) / 255) << 5 |
+                    ((c[2] * 31 + 127) / 255));
+}
+
+static void GPU_INTERNAL_UnpackRGB565(Uint16 v, Uint8 *c)
+{
+    Uint8 r = (v >> 11) & 0x1F;
+    Uint8 g = (v >> 5) & 0x3F;
+    Uint8 b = v & 0x1F;
+    c[0] = (Uint8)((r << 3) | (r >> 2));
+    c[1] = (Uint8)((g << 2) | (g >> 4));
+    c[2] = (Uint8)((b << 3) | (b >> 2));
+}
+
+static void GPU_INTERNAL_EncodeBC1ColorBlock(const Uint8 block[16][4], Uint8 *dst)
+{
+    Uint8 minColor[3] = { 255, 255, 255 };
+    Uint8 maxColor[3] = { 0, 0, 0 };
+    Uint8 palette[4][3];
+    Uint16 color0, color1;
+    Uint32 indices = 0;
+
+    // Fit the endpoints to the bounding box of the block, inset slightly to
+    // reduce the error of the interpolated colors.
+    for (int i = 0; i < 16; i += 1) {
+        for (int c = 0; c < 3; c += 1) {
+            minColor[c] = SDL_min(minColor[c], block[i][c]);
+            maxColor[c] = SDL_max(maxColor[c], block[i][c]);
+        }
+    }
+    for (int c = 0; c < 3; c += 1) {
+        Uint8 inset = (Uint8)((maxColor[c] - minColor[c]) >> 4);
+        minColor[c] = (Uint8)SDL_min(minColor[c] + inset, 255);
+        maxColor[c] = (Uint8)SDL_max(maxColor[c] - inset, 0);
+    }
+
+    color0 = GPU_INTERNAL_PackRGB565(maxColor);
+    color1 = GPU_INTERNAL_PackRGB565(minColor);
+
+    // color0 > color1 selects the four color mode, so equal endpoints can
+    // only use index 0.
+    if (color0 < color1) {
+        Uint16 tmp = color0;
+        color0 = color1;
+        color1 = tmp;
+    }
+
+    if (color0 != color1) {
+        GPU_INTERNAL_UnpackRGB565(color0, palette[0]);
+        GPU_INTERNAL_UnpackRGB565(color1, palette[1]);
+        for (int c = 0; c < 3; c += 1) {
+            palette[2][c] = (Uint8)((2 * palette[0][c] + palette[1][c] + 1) / 3);
+            palette[3][c] = (Uint8)((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+        }
+
+        for (int i = 15; i >= 0; i -= 1) {
+            Uint32 best = 0;
+            int bestDistance = SDL_MAX_SINT32;
+            for (Uint32 p = 0; p < 4; p += 1) {
+                int dr = (int)block[i][0] - palette[p][0];
+                int dg = (int)block[i][1] - palette[p][1];
+                int db = (int)block[i][2] - palette[p][2];
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices = (indices << 2) | best;
+        }
+    }
+
+    dst[0] = (Uint8)(color0 & 0xFF);
+    dst[1] = (Uint8)(color0 >> 8);
+    dst[2] = (Uint8)(color1 & 0xFF);
+    dst[3] = (Uint8)(color1 >> 8);
+    dst[4] = (Uint8)(indices & 0xFF);
+    dst[5] = (Uint8)((indices >> 8) & 0xFF);
+    dst[6] = (Uint8)((indices >> 16) & 0xFF);
+    dst[7] = (Uint8)(indices >> 24);
+}
+
+static void GPU_INTERNAL_EncodeBC3AlphaBlock(const Uint8 block[16][4], Uint8 *dst)
+{
+    Uint8 minAlpha = 255;
+    Uint8 maxAlpha = 0;
+    Uint64 indices = 0;
+
+    for (int i = 0; i < 16; i += 1) {
+        minAlpha = SDL_min(minAlpha, block[i][3]);
+        maxAlpha = SDL_max(maxAlpha, block[i][3]);
+    }
+
+    // alpha0 > alpha1 selects the eight value mode: index 0 is alpha0, index
+    // 1 is alpha1 and indices 2-7 are interpolated from alpha0 to alpha1.
+    if (maxAlpha != minAlpha) {
+        int range = maxAlpha - minAlpha;
+        for (int i = 15; i >= 0; i -= 1) {
+            // Step 0 is minAlpha and step 7 is maxAlpha
+            int step = ((block[i][3] - minAlpha) * 7 + range / 2) / range;
+            Uint64 index;
+            if (step == 7) {
+                index = 0;
+            } else if (step == 0) {
+                index = 1;
+            } else {
+                index = (Uint64)(8 - step);
+            }
+            indices = (indices << 3) | index;
+        }
+    }
+
+    dst[0] = maxAlpha;
+    dst[1] = minAlpha;
+    for (int i = 0; i < 6; i += 1) {
+        dst[2 + i] = (Uint8)((indices >> (8 * i)) & 0xFF);
+    }
+}
+
+bool SDL_CompressGPUTextureData(
+    SDL_GPUTextureFormat format,
+    Uint32 width,
+    Uint32 height,
+    const void *src,
+    int src_pitch,
+    void *dst,
+    size_t dst_size)
+{
+    bool hasAlphaBlock;
+    Uint32 blockSize;
+    Uint8 *out = (Uint8 *)dst;
+
+    if (src == NULL) {
+        return SDL_InvalidParamError("src");
+    }
+    if (dst == NULL) {
+        return SDL_InvalidParamError("dst");
+    }
+    if (width == 0 || height == 0) {
+        return SDL_SetError("Invalid texture dimensions");
+    }
+
+    switch (format) {
+    case SDL_GPU_TEXTUREFORMAT_BC1_RGBA_UNORM:
+    case SDL_GPU_TEXTUREFORMAT_BC1_RGBA_UNORM_SRGB:
+        hasAlphaBlock = false;
+        break;
+    case SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM:
+    case SDL_GPU_TEXTUREFORMAT_BC3_RGBA_UNORM_SRGB:
+        hasAlphaBlock = true;
+        break;
+    default:
+        return SDL_Unsupported();
+    }
+
+    blockSize = hasAlphaBlock ? 16 : 8;
+    if (dst_size < SDL_CalculateGPUTextureFormatSize(format, width, height, 1)) {
+        return SDL_SetError("Destination buffer is too small");
+    }
+
+    for (Uint32 by = 0; by < height; by += 4) {
+        for (Uint32 bx = 0; bx < width; bx += 4) {
+            Uint8 block[16][4];
+
+            // Partial blocks at the right and bottom edges repeat the last
+            // row and column so that they don't skew the endpoints.
+            for (Uint32 y = 0; y < 4; y += 1) {
+                const Uint8 *row = (const Uint8 *)src + (size_t)SDL_min(by + y, height - 1) * src_pitch;
+                for (Uint32 x = 0; x < 4; x += 1) {
+                    SDL_memcpy(block[y * 4 + x], row + (size_t)SDL_min(bx + x, width - 1) * 4, 4);
+                }
+            }
+
+            if (hasAlphaBlock) {
+                GPU_INTERNAL_EncodeBC3AlphaBlock(block, out);
+                GPU_INTERNAL_EncodeBC1ColorBlock(block, out + 8);
+            } else {
+                GPU_INTERNAL_EncodeBC1ColorBlock(block, out);
+            }
+            out += blockSize;
+        }
+    }
+
+    return true;
+}
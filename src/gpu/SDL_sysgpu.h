@@ -80,9 +80,20 @@ typedef struct RenderPass
     bool fragment_storage_buffer_bound[MAX_STORAGE_BUFFERS_PER_STAGE];
 } RenderPass;
 
+// Transient allocator blocks and retired batches, defined in SDL_gpu.c
+typedef struct TransientBlock TransientBlock;
+typedef struct TransientBatch TransientBatch;
+
+// Worker threads for asynchronous pipeline creation, defined in SDL_gpu.c
+typedef struct PipelineCompiler PipelineCompiler;
+
 typedef struct CommandBufferCommonHeader
 {
     SDL_GPUDevice *device;
+    SDL_GPUQueueType queue_type;
+
+    // blocks owned by this command buffer until it is submitted
+    TransientBlock *transient_blocks;
 
     RenderPass render_pass;
     ComputePass compute_pass;
@@ -92,6 +103,9 @@ typedef struct CommandBufferCommonHeader
     bool submitted;
     // used to avoid tripping assert on GenerateMipmaps
     bool ignore_render_pass_texture_validation;
+
+    // counted while recording, see SDL_GetGPUDeviceStats()
+    SDL_GPUDeviceStats stats;
 } CommandBufferCommonHeader;
 
 typedef struct TextureCommonHeader
@@ -110,6 +124,9 @@ typedef struct GraphicsPipelineCommonHeader
     Uint32 num_fragment_storage_textures;
     Uint32 num_fragment_storage_buffers;
     Uint32 num_fragment_uniform_buffers;
+
+    // Mesh pipelines use the vertex resource counts for their task and mesh shaders
+    bool mesh_pipeline;
 } GraphicsPipelineCommonHeader;
 
 typedef struct ComputePipelineCommonHeader
@@ -122,6 +139,12 @@ typedef struct ComputePipelineCommonHeader
     Uint32 numUniformBuffers;
 } ComputePipelineCommonHeader;
 
+typedef struct QueryPoolCommonHeader
+{
+    SDL_GPUQueryType type;
+    Uint32 num_queries;
+} QueryPoolCommonHeader;
+
 typedef struct BlitFragmentUniforms
 {
     // texcoord space
@@ -134,6 +157,7 @@ typedef struct BlitFragmentUniforms
     float layer_or_depth;
 } BlitFragmentUniforms;
 
+// Kept sorted by (type, format) so lookups can binary search
 typedef struct BlitPipelineCacheEntry
 {
     SDL_GPUTextureType type;
@@ -150,7 +174,7 @@ typedef struct BlitPipelineCacheEntry
 #define SDL_GPU_BLENDOP_MAX_ENUM_VALUE              (SDL_GPU_BLENDOP_MAX + 1)
 #define SDL_GPU_BLENDFACTOR_MAX_ENUM_VALUE          (SDL_GPU_BLENDFACTOR_SRC_ALPHA_SATURATE + 1)
 #define SDL_GPU_SWAPCHAINCOMPOSITION_MAX_ENUM_VALUE (SDL_GPU_SWAPCHAINCOMPOSITION_HDR10_ST2084 + 1)
-#define SDL_GPU_PRESENTMODE_MAX_ENUM_VALUE          (SDL_GPU_PRESENTMODE_MAILBOX + 1)
+#define SDL_GPU_PRESENTMODE_MAX_ENUM_VALUE          (SDL_GPU_PRESENTMODE_VSYNC_RELAXED + 1)
 
 static inline Sint32 Texture_GetBlockWidth(
     SDL_GPUTextureFormat format)
@@ -494,7 +518,8 @@ SDL_GPUGraphicsPipeline *SDL_GPU_FetchBlitPipeline(
 
 void SDL_GPU_BlitCommon(
     SDL_GPUCommandBuffer *commandBuffer,
-    const SDL_GPUBlitInfo *info,
+    const SDL_GPUBlitInfo *infos,
+    Uint32 numInfos,
     SDL_GPUSampler *blitLinearSampler,
     SDL_GPUSampler *blitNearestSampler,
     SDL_GPUShader *blitVertexShader,
@@ -722,6 +747,47 @@ struct SDL_GPUDevice
         Uint32 offset,
         Uint32 drawCount);
 
+    /* These are optional, and aren't part of ASSIGN_DRIVER; a backend that
+     * can read the draw count from a buffer assigns them with
+     * ASSIGN_INDIRECT_COUNT_DRIVER.
+     */
+
+    bool (*SupportsIndirectCount)(
+        SDL_GPURenderer *driverData);
+
+    void (*DrawPrimitivesIndirectCount)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUBuffer *buffer,
+        Uint32 offset,
+        SDL_GPUBuffer *countBuffer,
+        Uint32 countOffset,
+        Uint32 maxDrawCount);
+
+    void (*DrawIndexedPrimitivesIndirectCount)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUBuffer *buffer,
+        Uint32 offset,
+        SDL_GPUBuffer *countBuffer,
+        Uint32 countOffset,
+        Uint32 maxDrawCount);
+
+    /* These are optional, and aren't part of ASSIGN_DRIVER; a backend that
+     * enabled mesh shading for this device assigns them with
+     * ASSIGN_MESH_SHADER_DRIVER.
+     */
+
+    void (*DrawMeshTasks)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        Uint32 groupcountX,
+        Uint32 groupcountY,
+        Uint32 groupcountZ);
+
+    void (*DrawMeshTasksIndirect)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUBuffer *buffer,
+        Uint32 offset,
+        Uint32 drawCount);
+
     void (*EndRenderPass)(
         SDL_GPUCommandBuffer *commandBuffer);
 
@@ -839,7 +905,8 @@ struct SDL_GPUDevice
 
     void (*Blit)(
         SDL_GPUCommandBuffer *commandBuffer,
-        const SDL_GPUBlitInfo *info);
+        const SDL_GPUBlitInfo *infos,
+        Uint32 numInfos);
 
     // Submission/Presentation
 
@@ -922,6 +989,87 @@ struct SDL_GPUDevice
         SDL_GPURenderer *driverData,
         SDL_GPUFence *fence);
 
+    void (*RetainFence)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUFence *fence);
+
+    /* Queues
+     * These are optional, and aren't part of ASSIGN_DRIVER; a backend that
+     * has more than one hardware queue assigns them with ASSIGN_QUEUE_DRIVER.
+     */
+
+    SDL_GPUCommandBuffer *(*AcquireCommandBufferForQueue)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueueType queueType);
+
+    bool (*SupportsDedicatedQueue)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueueType queueType);
+
+    bool (*AddWaitFence)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUFence *fence);
+
+    /* Queries
+     * These are optional, and aren't part of ASSIGN_DRIVER; a backend that
+     * supports queries assigns them with ASSIGN_QUERY_DRIVER.
+     */
+
+    SDL_GPUQueryPool *(*CreateQueryPool)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryType type,
+        Uint32 numQueries);
+
+    void (*WriteTimestamp)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 index);
+
+    void (*BeginQuery)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 index);
+
+    void (*EndQuery)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 index);
+
+    bool (*GetQueryResults)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 firstQuery,
+        Uint32 numQueries,
+        void *data);
+
+    void (*ReleaseQueryPool)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryPool *queryPool);
+
+    /* Sparse Textures
+     * These are optional, and aren't part of ASSIGN_DRIVER; a backend that
+     * can commit texture tiles on demand assigns them with ASSIGN_SPARSE_DRIVER.
+     */
+
+    bool (*SupportsSparseTexture)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUTextureFormat format,
+        SDL_GPUTextureType type,
+        SDL_GPUTextureUsageFlags usage);
+
+    bool (*GetSparseTextureInfo)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUTexture *texture,
+        Uint32 *tileWidth,
+        Uint32 *tileHeight,
+        Uint32 *tileDepth,
+        Uint32 *numTiledLevels);
+
+    bool (*CommitTextureTiles)(
+        SDL_GPURenderer *driverData,
+        const SDL_GPUTextureRegion *region,
+        bool commit);
+
     // Feature Queries
 
     bool (*SupportsTextureFormat)(
@@ -935,6 +1083,18 @@ struct SDL_GPUDevice
         SDL_GPUTextureFormat format,
         SDL_GPUSampleCount desiredSampleCount);
 
+    // Pipeline Cache
+
+    void *(*GetPipelineCacheData)(
+        SDL_GPURenderer *driverData,
+        size_t *size);
+
+    // Memory Statistics
+
+    SDL_GPUMemoryHeapStats *(*GetMemoryHeapStats)(
+        SDL_GPURenderer *driverData,
+        int *count);
+
     // Opaque pointer for the Driver
     SDL_GPURenderer *driverData;
 
@@ -946,6 +1106,21 @@ struct SDL_GPUDevice
 
     // Store this for SDL_gpu.c's debug layer
     bool debug_mode;
+
+    // SDL_gpu.c's frame rate limiter, see SDL_HINT_GPU_FRAME_RATE_LIMIT
+    Uint64 next_frame_ns;
+
+    // Totals of the submitted command buffers' statistics
+    SDL_SpinLock stats_lock;
+    SDL_GPUDeviceStats stats;
+
+    // SDL_gpu.c's transient allocator
+    SDL_Mutex *transient_lock;
+    TransientBlock *transient_free_blocks;
+    TransientBatch *transient_pending_batches;
+
+    // SDL_gpu.c's asynchronous pipeline creation
+    PipelineCompiler *pipeline_compiler;
 };
 
 #define ASSIGN_DRIVER_FUNC(func, name) \
@@ -1031,14 +1206,44 @@ struct SDL_GPUDevice
     ASSIGN_DRIVER_FUNC(WaitForFences, name)                 \
     ASSIGN_DRIVER_FUNC(QueryFence, name)                    \
     ASSIGN_DRIVER_FUNC(ReleaseFence, name)                  \
+    ASSIGN_DRIVER_FUNC(RetainFence, name)                   \
     ASSIGN_DRIVER_FUNC(SupportsTextureFormat, name)         \
-    ASSIGN_DRIVER_FUNC(SupportsSampleCount, name)
+    ASSIGN_DRIVER_FUNC(SupportsSampleCount, name)           \
+    ASSIGN_DRIVER_FUNC(GetPipelineCacheData, name)         \
+    ASSIGN_DRIVER_FUNC(GetMemoryHeapStats, name)
+
+#define ASSIGN_QUEUE_DRIVER(name)                           \
+    ASSIGN_DRIVER_FUNC(AcquireCommandBufferForQueue, name)  \
+    ASSIGN_DRIVER_FUNC(SupportsDedicatedQueue, name)        \
+    ASSIGN_DRIVER_FUNC(AddWaitFence, name)
+
+#define ASSIGN_INDIRECT_COUNT_DRIVER(name)                       \
+    ASSIGN_DRIVER_FUNC(SupportsIndirectCount, name)              \
+    ASSIGN_DRIVER_FUNC(DrawPrimitivesIndirectCount, name)        \
+    ASSIGN_DRIVER_FUNC(DrawIndexedPrimitivesIndirectCount, name)
+
+#define ASSIGN_MESH_SHADER_DRIVER(name)            \
+    ASSIGN_DRIVER_FUNC(DrawMeshTasks, name)        \
+    ASSIGN_DRIVER_FUNC(DrawMeshTasksIndirect, name)
+
+#define ASSIGN_SPARSE_DRIVER(name)                  \
+    ASSIGN_DRIVER_FUNC(SupportsSparseTexture, name) \
+    ASSIGN_DRIVER_FUNC(GetSparseTextureInfo, name)  \
+    ASSIGN_DRIVER_FUNC(CommitTextureTiles, name)
+
+#define ASSIGN_QUERY_DRIVER(name)                           \
+    ASSIGN_DRIVER_FUNC(CreateQueryPool, name)               \
+    ASSIGN_DRIVER_FUNC(WriteTimestamp, name)                \
+    ASSIGN_DRIVER_FUNC(BeginQuery, name)                    \
+    ASSIGN_DRIVER_FUNC(EndQuery, name)                      \
+    ASSIGN_DRIVER_FUNC(GetQueryResults, name)               \
+    ASSIGN_DRIVER_FUNC(ReleaseQueryPool, name)
 
 typedef struct SDL_GPUBootstrap
 {
     const char *name;
     const SDL_GPUShaderFormat shader_formats;
-    bool (*PrepareDriver)(SDL_VideoDevice *_this);
+    bool (*PrepareDriver)(SDL_VideoDevice *_this, SDL_PropertiesID props);
     SDL_GPUDevice *(*CreateDevice)(bool debug_mode, bool prefer_low_power, SDL_PropertiesID props);
 } SDL_GPUBootstrap;
 
@@ -1051,6 +1256,128 @@ extern SDL_GPUBootstrap D3D12Driver;
 extern SDL_GPUBootstrap MetalDriver;
 extern SDL_GPUBootstrap PrivateGPUDriver;
 
+/* A build with SDL_GPU_STATIC_BACKEND defined to VULKAN, D3D12 or METAL only
+ * has that backend, so SDL_gpu.c calls its per-draw functions directly rather
+ * than through the device, which lets them be inlined with LTO. The backend
+ * defines these functions with SDL_GPU_DIRECT instead of static.
+ */
+#ifdef SDL_GPU_STATIC_BACKEND
+#define SDL_GPU_DIRECT
+#define SDL_GPU_DIRECT_FUNC_NAME(backend, func) backend##_##func
+#define SDL_GPU_DIRECT_FUNC_EXPAND(backend, func) SDL_GPU_DIRECT_FUNC_NAME(backend, func)
+#define SDL_GPU_DIRECT_FUNC(func) SDL_GPU_DIRECT_FUNC_EXPAND(SDL_GPU_STATIC_BACKEND, func)
+#define SDL_GPU_DIRECT_CALL(device, func) SDL_GPU_DIRECT_FUNC(func)
+
+extern void SDL_GPU_DIRECT_FUNC(BindGraphicsPipeline)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUGraphicsPipeline *graphicsPipeline);
+extern void SDL_GPU_DIRECT_FUNC(SetViewport)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUViewport *viewport);
+extern void SDL_GPU_DIRECT_FUNC(SetScissor)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_Rect *scissor);
+extern void SDL_GPU_DIRECT_FUNC(SetBlendConstants)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_FColor blendConstants);
+extern void SDL_GPU_DIRECT_FUNC(SetStencilReference)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint8 reference);
+extern void SDL_GPU_DIRECT_FUNC(BindVertexBuffers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    const SDL_GPUBufferBinding *bindings,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindIndexBuffer)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUBufferBinding *binding,
+    SDL_GPUIndexElementSize indexElementSize);
+extern void SDL_GPU_DIRECT_FUNC(BindVertexSamplers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindVertexStorageTextures)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUTexture *const *storageTextures,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindVertexStorageBuffers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUBuffer *const *storageBuffers,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindFragmentSamplers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindFragmentStorageTextures)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUTexture *const *storageTextures,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindFragmentStorageBuffers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUBuffer *const *storageBuffers,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(PushVertexUniformData)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 slotIndex,
+    const void *data,
+    Uint32 length);
+extern void SDL_GPU_DIRECT_FUNC(PushFragmentUniformData)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 slotIndex,
+    const void *data,
+    Uint32 length);
+extern void SDL_GPU_DIRECT_FUNC(DrawIndexedPrimitives)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 numIndices,
+    Uint32 numInstances,
+    Uint32 firstIndex,
+    Sint32 vertexOffset,
+    Uint32 firstInstance);
+extern void SDL_GPU_DIRECT_FUNC(DrawPrimitives)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 numVertices,
+    Uint32 numInstances,
+    Uint32 firstVertex,
+    Uint32 firstInstance);
+extern void SDL_GPU_DIRECT_FUNC(BindComputePipeline)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUComputePipeline *computePipeline);
+extern void SDL_GPU_DIRECT_FUNC(BindComputeSamplers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindComputeStorageTextures)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUTexture *const *storageTextures,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(BindComputeStorageBuffers)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 firstSlot,
+    SDL_GPUBuffer *const *storageBuffers,
+    Uint32 numBindings);
+extern void SDL_GPU_DIRECT_FUNC(PushComputeUniformData)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 slotIndex,
+    const void *data,
+    Uint32 length);
+extern void SDL_GPU_DIRECT_FUNC(DispatchCompute)(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 groupcountX,
+    Uint32 groupcountY,
+    Uint32 groupcountZ);
+#else
+#define SDL_GPU_DIRECT static
+#define SDL_GPU_DIRECT_CALL(device, func) (device)->func
+#endif // SDL_GPU_STATIC_BACKEND
+
 #ifdef __cplusplus
 }
 #endif
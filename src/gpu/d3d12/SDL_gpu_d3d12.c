@@ -26,6 +26,7 @@
 #include "../../core/windows/SDL_windows.h"
 #include "../../video/directx/SDL_d3d12.h"
 #include "../SDL_sysgpu.h"
+#include "../../SDL_memoryusage_c.h"
 
 #ifdef __IDXGIInfoQueue_INTERFACE_DEFINED__
 #define HAVE_IDXGIINFOQUEUE
@@ -118,8 +119,11 @@
 #define VIEW_GPU_DESCRIPTOR_COUNT             65536
 #define SAMPLER_GPU_DESCRIPTOR_COUNT          2048
 #define STAGING_HEAP_DESCRIPTOR_COUNT         1024
+#define SPARSE_TILES_PER_HEAP                 16
+#define SPARSE_TILE_NOT_RESIDENT              0xFFFFFFFF
+#define MAX_PENDING_BARRIERS                  64
 
-#define SDL_GPU_SHADERSTAGE_COMPUTE (SDL_GPUShaderStage)2
+#define SDL_GPU_SHADERSTAGE_COMPUTE (SDL_GPUShaderStage)4 // past the task and mesh stages
 
 #define EXPAND_ELEMENTS_IF_NEEDED(arr, initialValue, type) \
     if (arr->count == arr->capacity) {                     \
@@ -162,16 +166,23 @@ static const IID D3D_IID_IDXGIInfoQueue = { 0xd67441c7, 0x672a, 0x476f, { 0x9e,
 static const GUID D3D_IID_DXGI_DEBUG_ALL = { 0xe48ae283, 0xda80, 0x490b, { 0x87, 0xe6, 0x43, 0xe9, 0xa9, 0xcf, 0xda, 0x08 } };
 
 static const IID D3D_IID_ID3D12Device = { 0x189819f1, 0x1db6, 0x4b57, { 0xbe, 0x54, 0x18, 0x21, 0x33, 0x9b, 0x85, 0xf7 } };
+static const IID D3D_IID_ID3D12Device2 = { 0x30baa41e, 0xb15b, 0x475c, { 0xa0, 0xbb, 0x1a, 0xf5, 0xc5, 0xb6, 0x43, 0x28 } };
 static const IID D3D_IID_ID3D12CommandQueue = { 0x0ec870a6, 0x5d7e, 0x4c22, { 0x8c, 0xfc, 0x5b, 0xaa, 0xe0, 0x76, 0x16, 0xed } };
 static const IID D3D_IID_ID3D12DescriptorHeap = { 0x8efb471d, 0x616c, 0x4f49, { 0x90, 0xf7, 0x12, 0x7b, 0xb7, 0x63, 0xfa, 0x51 } };
 static const IID D3D_IID_ID3D12Resource = { 0x696442be, 0xa72e, 0x4059, { 0xbc, 0x79, 0x5b, 0x5c, 0x98, 0x04, 0x0f, 0xad } };
+static const IID D3D_IID_ID3D12Heap = { 0x6b3b2502, 0x6e51, 0x45b3, { 0x90, 0xee, 0x98, 0x84, 0x26, 0x5e, 0x8d, 0xf3 } };
 static const IID D3D_IID_ID3D12CommandAllocator = { 0x6102dee4, 0xaf59, 0x4b09, { 0xb9, 0x99, 0xb4, 0x4d, 0x73, 0xf0, 0x9b, 0x24 } };
 static const IID D3D_IID_ID3D12CommandList = { 0x7116d91c, 0xe7e4, 0x47ce, { 0xb8, 0xc6, 0xec, 0x81, 0x68, 0xf4, 0x37, 0xe5 } };
 static const IID D3D_IID_ID3D12GraphicsCommandList = { 0x5b160d0f, 0xac1b, 0x4185, { 0x8b, 0xa8, 0xb3, 0xae, 0x42, 0xa5, 0xa4, 0x55 } };
+static const IID D3D_IID_ID3D12GraphicsCommandList6 = { 0xc3827890, 0xe548, 0x4cfa, { 0x96, 0xcf, 0x56, 0x89, 0xa9, 0x37, 0x0f, 0x80 } };
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+static const IID D3D_IID_ID3D12GraphicsCommandList7 = { 0xdd171223, 0x8b61, 0x4769, { 0x90, 0xe3, 0x16, 0x0c, 0xcd, 0xe4, 0xe2, 0xc1 } };
+#endif
 static const IID D3D_IID_ID3D12Fence = { 0x0a753dcf, 0xc4d8, 0x4b91, { 0xad, 0xf6, 0xbe, 0x5a, 0x60, 0xd9, 0x5a, 0x76 } };
 static const IID D3D_IID_ID3D12RootSignature = { 0xc54a6b66, 0x72df, 0x4ee8, { 0x8b, 0xe5, 0xa9, 0x46, 0xa1, 0x42, 0x92, 0x14 } };
 static const IID D3D_IID_ID3D12CommandSignature = { 0xc36a797c, 0xec80, 0x4f0a, { 0x89, 0x85, 0xa7, 0xb2, 0x47, 0x50, 0x82, 0xd1 } };
 static const IID D3D_IID_ID3D12PipelineState = { 0x765a30f3, 0xf624, 0x4c6f, { 0xa8, 0x28, 0xac, 0xe9, 0x48, 0x62, 0x24, 0x45 } };
+static const IID D3D_IID_ID3D12QueryHeap = { 0x0d9658ae, 0xed45, 0x469e, { 0xa6, 0x1d, 0x97, 0x0e, 0xc5, 0x83, 0xca, 0xb4 } };
 static const IID D3D_IID_ID3D12Debug = { 0x344488b7, 0x6846, 0x474b, { 0xb9, 0x89, 0xf0, 0x27, 0x44, 0x82, 0x45, 0xe0 } };
 static const IID D3D_IID_ID3D12InfoQueue = { 0x0742a90b, 0xc387, 0x483f, { 0xb9, 0x46, 0x30, 0xa7, 0xe4, 0xe6, 0x14, 0x58 } };
 static const IID D3D_IID_ID3D12InfoQueue1 = { 0x2852dd88, 0xb484, 0x4c0c, { 0xb6, 0xb1, 0x67, 0x16, 0x85, 0x00, 0xe6, 0x00 } };
@@ -724,6 +735,7 @@ typedef struct D3D12UniformBuffer D3D12UniformBuffer;
 typedef struct D3D12DescriptorHeap D3D12DescriptorHeap;
 typedef struct D3D12StagingDescriptor D3D12StagingDescriptor;
 typedef struct D3D12TextureDownload D3D12TextureDownload;
+typedef struct D3D12QueryPool D3D12QueryPool;
 
 typedef struct D3D12Fence
 {
@@ -807,6 +819,32 @@ typedef struct D3D12TextureSubresource
     D3D12StagingDescriptor dsvHandle; // NULL if not a depth stencil target
 } D3D12TextureSubresource;
 
+/* Sparse textures are reserved resources. Each texture maps its tiles from
+ * its own heaps, and keeps its packed mips mapped for life.
+ */
+typedef struct D3D12SparseResidency
+{
+    Uint32 width;
+    Uint32 height;
+    Uint32 depth;
+    Uint32 layerCount;
+    Uint32 levelCount;
+    D3D12_TILE_SHAPE tileShape;
+    Uint32 tiledLevelCount; // levels from here on are packed
+
+    Uint32 *levelTileOffsets; // first tile of each layer and level in tileSlots
+    Uint32 *tileSlots;        // heap slot of each tile, or SPARSE_TILE_NOT_RESIDENT
+
+    D3D12_HEAP_FLAGS heapFlags;
+    ID3D12Heap **heaps;
+    Uint32 heapCount;
+    Uint32 *freeSlots;
+    Uint32 freeSlotCount;
+
+    ID3D12Heap *packedMipHeap;
+    SDL_Mutex *lock;
+} D3D12SparseResidency;
+
 struct D3D12Texture
 {
     D3D12TextureContainer *container;
@@ -818,6 +856,8 @@ struct D3D12Texture
     ID3D12Resource *resource;
     D3D12StagingDescriptor srvHandle;
 
+    D3D12SparseResidency *sparse; // NULL unless the texture was created sparse
+
     SDL_AtomicInt referenceCount;
 };
 
@@ -835,6 +875,7 @@ typedef struct D3D12WindowData
     D3D12XBOX_FRAME_PIPELINE_TOKEN frameToken;
 #else
     IDXGISwapChain3 *swapchain;
+    HANDLE frameLatencyWaitableObject;
 #endif
     SDL_GPUPresentMode present_mode;
     SDL_GPUSwapchainComposition swapchainComposition;
@@ -875,6 +916,7 @@ struct D3D12Renderer
     BOOL supportsTearing;
     SDL_SharedObject *d3d12_dll;
     ID3D12Device *device;
+    ID3D12Device2 *device2; // Only set when mesh shading is enabled
     PFN_D3D12_SERIALIZE_ROOT_SIGNATURE D3D12SerializeRootSignature_func;
     const char *semantic;
     SDL_iconv_t iconv;
@@ -883,6 +925,8 @@ struct D3D12Renderer
 
     bool debug_mode;
     bool GPUUploadHeapSupported;
+    bool enhancedBarriersSupported;
+    D3D12_TILED_RESOURCES_TIER tiledResourcesTier;
     // FIXME: these might not be necessary since we're not using custom heaps
     bool UMA;
     bool UMACacheCoherent;
@@ -892,6 +936,7 @@ struct D3D12Renderer
     ID3D12CommandSignature *indirectDrawCommandSignature;
     ID3D12CommandSignature *indirectIndexedDrawCommandSignature;
     ID3D12CommandSignature *indirectDispatchCommandSignature;
+    ID3D12CommandSignature *indirectDispatchMeshCommandSignature;
 
     // Blit
     SDL_GPUShader *blitVertexShader;
@@ -964,6 +1009,16 @@ struct D3D12Renderer
     SDL_Mutex *disposeLock;
 };
 
+typedef struct D3D12PendingBarrier
+{
+    ID3D12Resource *resource;
+    Uint32 subresourceIndex;
+    D3D12_RESOURCE_STATES sourceState;
+    D3D12_RESOURCE_STATES destinationState;
+    bool isTexture;
+    bool isUav; // UAV barriers only use resource
+} D3D12PendingBarrier;
+
 struct D3D12CommandBuffer
 {
     // reserved for SDL_gpu
@@ -974,6 +1029,10 @@ struct D3D12CommandBuffer
 
     ID3D12CommandAllocator *commandAllocator;
     ID3D12GraphicsCommandList *graphicsCommandList;
+    ID3D12GraphicsCommandList6 *meshCommandList; // Only set when mesh shading is enabled
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    ID3D12GraphicsCommandList7 *barrierCommandList; // Only set when enhanced barriers are supported
+#endif
     D3D12Fence *inFlightFence;
     bool autoReleaseFence;
 
@@ -982,6 +1041,10 @@ struct D3D12CommandBuffer
     Uint32 presentDataCount;
     Uint32 presentDataCapacity;
 
+    // Barriers are queued and recorded in one call before the next command that depends on them
+    D3D12PendingBarrier pendingBarriers[MAX_PENDING_BARRIERS];
+    Uint32 pendingBarrierCount;
+
     D3D12TextureSubresource *colorTargetSubresources[MAX_COLOR_TARGET_BINDINGS];
     D3D12TextureSubresource *colorResolveSubresources[MAX_COLOR_TARGET_BINDINGS];
     D3D12TextureSubresource *depthStencilTextureSubresource;
@@ -1070,6 +1133,10 @@ struct D3D12CommandBuffer
     Uint32 usedComputePipelineCount;
     Uint32 usedComputePipelineCapacity;
 
+    D3D12QueryPool **usedQueryPools;
+    Uint32 usedQueryPoolCount;
+    Uint32 usedQueryPoolCapacity;
+
     // Used for texture pitch hack
     D3D12TextureDownload **textureDownloads;
     Uint32 textureDownloadCount;
@@ -1144,6 +1211,18 @@ struct D3D12ComputePipeline
     SDL_AtomicInt referenceCount;
 };
 
+struct D3D12QueryPool
+{
+    QueryPoolCommonHeader header;
+
+    ID3D12QueryHeap *heap;
+    ID3D12Resource *readbackBuffer;
+    D3D12_QUERY_TYPE queryType;
+    Uint64 timestampFrequency;
+
+    SDL_AtomicInt referenceCount; // in-flight command buffers that resolve into readbackBuffer
+};
+
 struct D3D12TextureDownload
 {
     D3D12Buffer *destinationBuffer;
@@ -1406,6 +1485,24 @@ static void D3D12_INTERNAL_DestroyTexture(
         ID3D12Resource_Release(texture->resource);
     }
 
+    if (texture->sparse) {
+        D3D12SparseResidency *sparse = texture->sparse;
+
+        for (Uint32 i = 0; i < sparse->heapCount; i += 1) {
+            ID3D12Heap_Release(sparse->heaps[i]);
+        }
+        if (sparse->packedMipHeap) {
+            ID3D12Heap_Release(sparse->packedMipHeap);
+        }
+
+        SDL_free(sparse->heaps);
+        SDL_free(sparse->freeSlots);
+        SDL_free(sparse->levelTileOffsets);
+        SDL_free(sparse->tileSlots);
+        SDL_DestroyMutex(sparse->lock);
+        SDL_free(sparse);
+    }
+
     SDL_free(texture);
 }
 
@@ -1539,6 +1636,14 @@ static void D3D12_ReleaseFence(
     }
 }
 
+static void D3D12_RetainFence(
+    SDL_GPURenderer *driverData,
+    SDL_GPUFence *fence)
+{
+    (void)driverData;
+    SDL_AtomicIncRef(&((D3D12Fence *)fence)->referenceCount);
+}
+
 static bool D3D12_QueryFence(
     SDL_GPURenderer *driverData,
     SDL_GPUFence *fence)
@@ -1552,6 +1657,7 @@ static void D3D12_INTERNAL_DestroyDescriptorHeap(D3D12DescriptorHeap *descriptor
     if (!descriptorHeap) {
         return;
     }
+    SDL_UntrackMemoryObject(descriptorHeap);
     if (descriptorHeap->handle) {
         ID3D12DescriptorHeap_Release(descriptorHeap->handle);
     }
@@ -1576,6 +1682,14 @@ static void D3D12_INTERNAL_DestroyCommandBuffer(D3D12CommandBuffer *commandBuffe
     if (!commandBuffer) {
         return;
     }
+    if (commandBuffer->meshCommandList) {
+        ID3D12GraphicsCommandList6_Release(commandBuffer->meshCommandList);
+    }
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    if (commandBuffer->barrierCommandList) {
+        ID3D12GraphicsCommandList7_Release(commandBuffer->barrierCommandList);
+    }
+#endif
     if (commandBuffer->graphicsCommandList) {
         ID3D12GraphicsCommandList_Release(commandBuffer->graphicsCommandList);
     }
@@ -1588,6 +1702,7 @@ static void D3D12_INTERNAL_DestroyCommandBuffer(D3D12CommandBuffer *commandBuffe
     SDL_free(commandBuffer->usedSamplers);
     SDL_free(commandBuffer->usedGraphicsPipelines);
     SDL_free(commandBuffer->usedComputePipelines);
+    SDL_free(commandBuffer->usedQueryPools);
     SDL_free(commandBuffer->usedUniformBuffers);
     SDL_free(commandBuffer->textureDownloads);
     SDL_free(commandBuffer);
@@ -1682,6 +1797,14 @@ static void D3D12_INTERNAL_DestroyRenderer(D3D12Renderer *renderer)
         ID3D12CommandSignature_Release(renderer->indirectDispatchCommandSignature);
         renderer->indirectDispatchCommandSignature = NULL;
     }
+    if (renderer->indirectDispatchMeshCommandSignature) {
+        ID3D12CommandSignature_Release(renderer->indirectDispatchMeshCommandSignature);
+        renderer->indirectDispatchMeshCommandSignature = NULL;
+    }
+    if (renderer->device2) {
+        ID3D12Device2_Release(renderer->device2);
+        renderer->device2 = NULL;
+    }
 #if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
     if (renderer->commandQueue) {
         ID3D12CommandQueue_Release(renderer->commandQueue);
@@ -1766,42 +1889,300 @@ static inline Uint32 D3D12_INTERNAL_CalcSubresource(
     return mipLevel + (layer * numLevels);
 }
 
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+static void D3D12_INTERNAL_GetBarrierScope(
+    D3D12_RESOURCE_STATES state,
+    D3D12_BARRIER_SYNC *sync,
+    D3D12_BARRIER_ACCESS *access,
+    D3D12_BARRIER_LAYOUT *layout)
+{
+    /* SDL_GPU only puts resources in NON_PIXEL_SHADER_RESOURCE and UNORDERED_ACCESS
+     * for compute passes, so those can be scoped to compute shading. */
+    switch (state) {
+    case D3D12_RESOURCE_STATE_COMMON:
+        // Never used yet, or presented
+        *sync = D3D12_BARRIER_SYNC_NONE;
+        *access = D3D12_BARRIER_ACCESS_NO_ACCESS;
+        *layout = D3D12_BARRIER_LAYOUT_COMMON;
+        break;
+    case D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER:
+        *sync = D3D12_BARRIER_SYNC_ALL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_VERTEX_BUFFER | D3D12_BARRIER_ACCESS_CONSTANT_BUFFER;
+        *layout = D3D12_BARRIER_LAYOUT_UNDEFINED;
+        break;
+    case D3D12_RESOURCE_STATE_INDEX_BUFFER:
+        *sync = D3D12_BARRIER_SYNC_INDEX_INPUT;
+        *access = D3D12_BARRIER_ACCESS_INDEX_BUFFER;
+        *layout = D3D12_BARRIER_LAYOUT_UNDEFINED;
+        break;
+    case D3D12_RESOURCE_STATE_RENDER_TARGET:
+        *sync = D3D12_BARRIER_SYNC_RENDER_TARGET;
+        *access = D3D12_BARRIER_ACCESS_RENDER_TARGET;
+        *layout = D3D12_BARRIER_LAYOUT_RENDER_TARGET;
+        break;
+    case D3D12_RESOURCE_STATE_UNORDERED_ACCESS:
+        *sync = D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+        *access = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+        *layout = D3D12_BARRIER_LAYOUT_UNORDERED_ACCESS;
+        break;
+    case D3D12_RESOURCE_STATE_DEPTH_WRITE:
+        *sync = D3D12_BARRIER_SYNC_DEPTH_STENCIL;
+        *access = D3D12_BARRIER_ACCESS_DEPTH_STENCIL_WRITE;
+        *layout = D3D12_BARRIER_LAYOUT_DEPTH_STENCIL_WRITE;
+        break;
+    case D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:
+        *sync = D3D12_BARRIER_SYNC_COMPUTE_SHADING;
+        *access = D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        break;
+    case D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE:
+        *sync = D3D12_BARRIER_SYNC_ALL_SHADING;
+        *access = D3D12_BARRIER_ACCESS_SHADER_RESOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_SHADER_RESOURCE;
+        break;
+    case D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT:
+        *sync = D3D12_BARRIER_SYNC_EXECUTE_INDIRECT;
+        *access = D3D12_BARRIER_ACCESS_INDIRECT_ARGUMENT;
+        *layout = D3D12_BARRIER_LAYOUT_UNDEFINED;
+        break;
+    case D3D12_RESOURCE_STATE_COPY_DEST:
+        *sync = D3D12_BARRIER_SYNC_COPY;
+        *access = D3D12_BARRIER_ACCESS_COPY_DEST;
+        *layout = D3D12_BARRIER_LAYOUT_COPY_DEST;
+        break;
+    case D3D12_RESOURCE_STATE_COPY_SOURCE:
+        *sync = D3D12_BARRIER_SYNC_COPY;
+        *access = D3D12_BARRIER_ACCESS_COPY_SOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_COPY_SOURCE;
+        break;
+    case D3D12_RESOURCE_STATE_RESOLVE_DEST:
+        *sync = D3D12_BARRIER_SYNC_RESOLVE;
+        *access = D3D12_BARRIER_ACCESS_RESOLVE_DEST;
+        *layout = D3D12_BARRIER_LAYOUT_RESOLVE_DEST;
+        break;
+    case D3D12_RESOURCE_STATE_RESOLVE_SOURCE:
+        *sync = D3D12_BARRIER_SYNC_RESOLVE;
+        *access = D3D12_BARRIER_ACCESS_RESOLVE_SOURCE;
+        *layout = D3D12_BARRIER_LAYOUT_RESOLVE_SOURCE;
+        break;
+    default:
+        *sync = D3D12_BARRIER_SYNC_ALL;
+        *access = D3D12_BARRIER_ACCESS_COMMON;
+        *layout = D3D12_BARRIER_LAYOUT_COMMON;
+        break;
+    }
+}
+
+static void D3D12_INTERNAL_FlushEnhancedBarriers(
+    D3D12CommandBuffer *commandBuffer)
+{
+    D3D12_TEXTURE_BARRIER textureBarriers[MAX_PENDING_BARRIERS];
+    D3D12_BUFFER_BARRIER bufferBarriers[MAX_PENDING_BARRIERS];
+    D3D12_GLOBAL_BARRIER globalBarrier;
+    D3D12_BARRIER_GROUP barrierGroups[3];
+    Uint32 textureBarrierCount = 0;
+    Uint32 bufferBarrierCount = 0;
+    Uint32 barrierGroupCount = 0;
+    bool needsGlobalUavBarrier = false;
+    D3D12_BARRIER_LAYOUT layoutBefore, layoutAfter;
+
+    for (Uint32 i = 0; i < commandBuffer->pendingBarrierCount; i += 1) {
+        D3D12PendingBarrier *pending = &commandBuffer->pendingBarriers[i];
+
+        if (pending->isUav) {
+            // A transition out of UNORDERED_ACCESS in the same batch already orders the writes
+            bool covered = false;
+            for (Uint32 j = 0; j < commandBuffer->pendingBarrierCount; j += 1) {
+                D3D12PendingBarrier *other = &commandBuffer->pendingBarriers[j];
+                if (!other->isUav &&
+                    other->resource == pending->resource &&
+                    other->sourceState == D3D12_RESOURCE_STATE_UNORDERED_ACCESS) {
+                    covered = true;
+                    break;
+                }
+            }
+            needsGlobalUavBarrier |= !covered;
+        } else if (pending->isTexture) {
+            D3D12_TEXTURE_BARRIER *barrier = &textureBarriers[textureBarrierCount];
+            D3D12_INTERNAL_GetBarrierScope(pending->sourceState, &barrier->SyncBefore, &barrier->AccessBefore, &layoutBefore);
+            D3D12_INTERNAL_GetBarrierScope(pending->destinationState, &barrier->SyncAfter, &barrier->AccessAfter, &layoutAfter);
+            barrier->LayoutBefore = layoutBefore;
+            barrier->LayoutAfter = layoutAfter;
+            barrier->pResource = pending->resource;
+            // NumMipLevels == 0 means IndexOrFirstMipLevel is a subresource index
+            barrier->Subresources.IndexOrFirstMipLevel = pending->subresourceIndex;
+            barrier->Subresources.NumMipLevels = 0;
+            barrier->Subresources.FirstArraySlice = 0;
+            barrier->Subresources.NumArraySlices = 0;
+            barrier->Subresources.FirstPlane = 0;
+            barrier->Subresources.NumPlanes = 0;
+            barrier->Flags = D3D12_TEXTURE_BARRIER_FLAG_NONE;
+            textureBarrierCount += 1;
+        } else {
+            D3D12_BUFFER_BARRIER *barrier = &bufferBarriers[bufferBarrierCount];
+            D3D12_INTERNAL_GetBarrierScope(pending->sourceState, &barrier->SyncBefore, &barrier->AccessBefore, &layoutBefore);
+            D3D12_INTERNAL_GetBarrierScope(pending->destinationState, &barrier->SyncAfter, &barrier->AccessAfter, &layoutAfter);
+            barrier->pResource = pending->resource;
+            barrier->Offset = 0;
+            barrier->Size = UINT64_MAX;
+            bufferBarrierCount += 1;
+        }
+    }
+
+    if (needsGlobalUavBarrier) {
+        globalBarrier.SyncBefore = D3D12_BARRIER_SYNC_ALL_SHADING;
+        globalBarrier.SyncAfter = D3D12_BARRIER_SYNC_ALL_SHADING;
+        globalBarrier.AccessBefore = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+        globalBarrier.AccessAfter = D3D12_BARRIER_ACCESS_UNORDERED_ACCESS;
+        barrierGroups[barrierGroupCount].Type = D3D12_BARRIER_TYPE_GLOBAL;
+        barrierGroups[barrierGroupCount].NumBarriers = 1;
+        barrierGroups[barrierGroupCount].pGlobalBarriers = &globalBarrier;
+        barrierGroupCount += 1;
+    }
+
+    if (textureBarrierCount > 0) {
+        barrierGroups[barrierGroupCount].Type = D3D12_BARRIER_TYPE_TEXTURE;
+        barrierGroups[barrierGroupCount].NumBarriers = textureBarrierCount;
+        barrierGroups[barrierGroupCount].pTextureBarriers = textureBarriers;
+        barrierGroupCount += 1;
+    }
+
+    if (bufferBarrierCount > 0) {
+        barrierGroups[barrierGroupCount].Type = D3D12_BARRIER_TYPE_BUFFER;
+        barrierGroups[barrierGroupCount].NumBarriers = bufferBarrierCount;
+        barrierGroups[barrierGroupCount].pBufferBarriers = bufferBarriers;
+        barrierGroupCount += 1;
+    }
+
+    if (barrierGroupCount > 0) {
+        ID3D12GraphicsCommandList7_Barrier(
+            commandBuffer->barrierCommandList,
+            barrierGroupCount,
+            barrierGroups);
+    }
+}
+#endif
+
+static void D3D12_INTERNAL_FlushBarriers(
+    D3D12CommandBuffer *commandBuffer)
+{
+    D3D12_RESOURCE_BARRIER barrierDescs[MAX_PENDING_BARRIERS];
+    Uint32 i;
+
+    if (commandBuffer->pendingBarrierCount == 0) {
+        return;
+    }
+
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    if (commandBuffer->barrierCommandList) {
+        D3D12_INTERNAL_FlushEnhancedBarriers(commandBuffer);
+        commandBuffer->pendingBarrierCount = 0;
+        return;
+    }
+#endif
+
+    for (i = 0; i < commandBuffer->pendingBarrierCount; i += 1) {
+        D3D12PendingBarrier *pending = &commandBuffer->pendingBarriers[i];
+
+        if (pending->isUav) {
+            barrierDescs[i].Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            barrierDescs[i].Flags = (D3D12_RESOURCE_BARRIER_FLAGS)0;
+            barrierDescs[i].UAV.pResource = pending->resource;
+        } else {
+            barrierDescs[i].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrierDescs[i].Flags = (D3D12_RESOURCE_BARRIER_FLAGS)0;
+            barrierDescs[i].Transition.StateBefore = pending->sourceState;
+            barrierDescs[i].Transition.StateAfter = pending->destinationState;
+            barrierDescs[i].Transition.pResource = pending->resource;
+            barrierDescs[i].Transition.Subresource = pending->subresourceIndex;
+        }
+    }
+
+    ID3D12GraphicsCommandList_ResourceBarrier(
+        commandBuffer->graphicsCommandList,
+        commandBuffer->pendingBarrierCount,
+        barrierDescs);
+
+    commandBuffer->pendingBarrierCount = 0;
+}
+
+static D3D12PendingBarrier *D3D12_INTERNAL_AppendBarrier(
+    D3D12CommandBuffer *commandBuffer)
+{
+    if (commandBuffer->pendingBarrierCount == MAX_PENDING_BARRIERS) {
+        D3D12_INTERNAL_FlushBarriers(commandBuffer);
+    }
+    return &commandBuffer->pendingBarriers[commandBuffer->pendingBarrierCount++];
+}
+
+/* Queues a barrier on the command buffer. Nothing is recorded until
+ * D3D12_INTERNAL_FlushBarriers, which must be called before any command
+ * that reads or writes the resource in its new state. */
 static void D3D12_INTERNAL_ResourceBarrier(
     D3D12CommandBuffer *commandBuffer,
     D3D12_RESOURCE_STATES sourceState,
     D3D12_RESOURCE_STATES destinationState,
     ID3D12Resource *resource,
     Uint32 subresourceIndex,
+    bool isTexture,
     bool needsUavBarrier)
 {
-    D3D12_RESOURCE_BARRIER barrierDesc[2];
-    Uint32 numBarriers = 0;
+    D3D12PendingBarrier *pending;
+    Uint32 i;
 
     // No transition barrier is needed if the state is not changing.
     if (sourceState != destinationState) {
-        barrierDesc[numBarriers].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrierDesc[numBarriers].Flags = (D3D12_RESOURCE_BARRIER_FLAGS)0;
-        barrierDesc[numBarriers].Transition.StateBefore = sourceState;
-        barrierDesc[numBarriers].Transition.StateAfter = destinationState;
-        barrierDesc[numBarriers].Transition.pResource = resource;
-        barrierDesc[numBarriers].Transition.Subresource = subresourceIndex;
+        pending = NULL;
+        for (i = 0; i < commandBuffer->pendingBarrierCount; i += 1) {
+            if (!commandBuffer->pendingBarriers[i].isUav &&
+                commandBuffer->pendingBarriers[i].resource == resource &&
+                commandBuffer->pendingBarriers[i].subresourceIndex == subresourceIndex) {
+                pending = &commandBuffer->pendingBarriers[i];
+                break;
+            }
+        }
 
-        numBarriers += 1;
+        if (pending && pending->destinationState == sourceState && pending->sourceState != destinationState) {
+            // Nothing used the intermediate state, so the two transitions collapse into one
+            pending->destinationState = destinationState;
+        } else if (pending && pending->destinationState == sourceState &&
+                   !(destinationState & (D3D12_RESOURCE_STATE_COPY_DEST | D3D12_RESOURCE_STATE_RESOLVE_DEST | D3D12_RESOURCE_STATE_UNORDERED_ACCESS))) {
+            /* The resource goes straight back to where it was. Only safe to drop
+             * when no earlier writes in that state still need to be ordered. */
+            SDL_memmove(
+                pending,
+                pending + 1,
+                (commandBuffer->pendingBarrierCount - i - 1) * sizeof(D3D12PendingBarrier));
+            commandBuffer->pendingBarrierCount -= 1;
+        } else {
+            if (pending) {
+                D3D12_INTERNAL_FlushBarriers(commandBuffer);
+            }
+            pending = D3D12_INTERNAL_AppendBarrier(commandBuffer);
+            pending->resource = resource;
+            pending->subresourceIndex = subresourceIndex;
+            pending->sourceState = sourceState;
+            pending->destinationState = destinationState;
+            pending->isTexture = isTexture;
+            pending->isUav = false;
+        }
     }
 
     if (needsUavBarrier) {
-        barrierDesc[numBarriers].Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-        barrierDesc[numBarriers].Flags = (D3D12_RESOURCE_BARRIER_FLAGS)0;
-        barrierDesc[numBarriers].UAV.pResource = resource;
-
-        numBarriers += 1;
-    }
+        for (i = 0; i < commandBuffer->pendingBarrierCount; i += 1) {
+            if (commandBuffer->pendingBarriers[i].isUav &&
+                commandBuffer->pendingBarriers[i].resource == resource) {
+                return;
+            }
+        }
 
-    if (numBarriers > 0) {
-        ID3D12GraphicsCommandList_ResourceBarrier(
-            commandBuffer->graphicsCommandList,
-            numBarriers,
-            barrierDesc);
+        pending = D3D12_INTERNAL_AppendBarrier(commandBuffer);
+        pending->resource = resource;
+        pending->subresourceIndex = 0;
+        pending->sourceState = D3D12_RESOURCE_STATE_COMMON;
+        pending->destinationState = D3D12_RESOURCE_STATE_COMMON;
+        pending->isTexture = isTexture;
+        pending->isUav = true;
     }
 }
 
@@ -1821,6 +2202,7 @@ static void D3D12_INTERNAL_TextureSubresourceBarrier(
         destinationState,
         textureSubresource->parent->resource,
         textureSubresource->index,
+        true,
         needsUAVBarrier);
 }
 
@@ -1932,6 +2314,7 @@ static void D3D12_INTERNAL_BufferBarrier(
         destinationState,
         buffer->handle,
         0,
+        false,
         buffer->container->usage & SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE);
 
     buffer->transitioned = true;
@@ -2042,6 +2425,18 @@ static void D3D12_INTERNAL_TrackComputePipeline(
         usedComputePipelineCapacity)
 }
 
+static void D3D12_INTERNAL_TrackQueryPool(
+    D3D12CommandBuffer *commandBuffer,
+    D3D12QueryPool *queryPool)
+{
+    TRACK_RESOURCE(
+        queryPool,
+        D3D12QueryPool *,
+        usedQueryPools,
+        usedQueryPoolCount,
+        usedQueryPoolCapacity)
+}
+
 #undef TRACK_RESOURCE
 
 // Debug Naming
@@ -2165,6 +2560,252 @@ static void D3D12_PopDebugGroup(
     ID3D12GraphicsCommandList_EndEvent(d3d12CommandBuffer->graphicsCommandList);
 }
 
+// Queries
+
+static SDL_GPUQueryPool *D3D12_CreateQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryType type,
+    Uint32 numQueries)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12QueryPool *queryPool;
+    D3D12_QUERY_HEAP_DESC heapDesc;
+    D3D12_HEAP_PROPERTIES heapProperties;
+    D3D12_RESOURCE_DESC desc;
+    UINT64 resultSize;
+    HRESULT res;
+
+    queryPool = (D3D12QueryPool *)SDL_calloc(1, sizeof(D3D12QueryPool));
+    if (!queryPool) {
+        return NULL;
+    }
+    queryPool->header.type = type;
+    queryPool->header.num_queries = numQueries;
+    SDL_SetAtomicInt(&queryPool->referenceCount, 0);
+
+    if (type == SDL_GPU_QUERYTYPE_TIMESTAMP) {
+        heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        queryPool->queryType = D3D12_QUERY_TYPE_TIMESTAMP;
+        resultSize = sizeof(UINT64);
+
+        res = ID3D12CommandQueue_GetTimestampFrequency(
+            renderer->commandQueue,
+            &queryPool->timestampFrequency);
+        if (FAILED(res) || queryPool->timestampFrequency == 0) {
+            SDL_free(queryPool);
+            SET_STRING_ERROR_AND_RETURN("Timestamp queries are not supported on this queue", NULL);
+        }
+    } else {
+        heapDesc.Type = D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+        queryPool->queryType = D3D12_QUERY_TYPE_PIPELINE_STATISTICS;
+        resultSize = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+    }
+    heapDesc.Count = numQueries;
+    heapDesc.NodeMask = 0;
+
+    res = ID3D12Device_CreateQueryHeap(
+        renderer->device,
+        &heapDesc,
+        D3D_GUID(D3D_IID_ID3D12QueryHeap),
+        (void **)&queryPool->heap);
+    if (FAILED(res)) {
+        SDL_free(queryPool);
+        CHECK_D3D12_ERROR_AND_RETURN("Could not create query heap", NULL);
+    }
+
+    heapProperties.Type = D3D12_HEAP_TYPE_READBACK;
+    heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapProperties.CreationNodeMask = 0; // We don't do multi-adapter operation
+    heapProperties.VisibleNodeMask = 0;  // We don't do multi-adapter operation
+
+    desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    desc.Width = resultSize * numQueries;
+    desc.Height = 1;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels = 1;
+    desc.Format = DXGI_FORMAT_UNKNOWN;
+    desc.SampleDesc.Count = 1;
+    desc.SampleDesc.Quality = 0;
+    desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+    res = ID3D12Device_CreateCommittedResource(
+        renderer->device,
+        &heapProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &desc,
+        D3D12_RESOURCE_STATE_COPY_DEST,
+        NULL,
+        D3D_GUID(D3D_IID_ID3D12Resource),
+        (void **)&queryPool->readbackBuffer);
+    if (FAILED(res)) {
+        ID3D12QueryHeap_Release(queryPool->heap);
+        SDL_free(queryPool);
+        CHECK_D3D12_ERROR_AND_RETURN("Could not create query readback buffer", NULL);
+    }
+
+    return (SDL_GPUQueryPool *)queryPool;
+}
+
+static void D3D12_INTERNAL_ResolveQuery(
+    D3D12CommandBuffer *d3d12CommandBuffer,
+    D3D12QueryPool *queryPool,
+    Uint32 index)
+{
+    UINT64 resultSize = (queryPool->queryType == D3D12_QUERY_TYPE_TIMESTAMP) ?
+        sizeof(UINT64) :
+        sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+
+    ID3D12GraphicsCommandList_ResolveQueryData(
+        d3d12CommandBuffer->graphicsCommandList,
+        queryPool->heap,
+        queryPool->queryType,
+        index,
+        1,
+        queryPool->readbackBuffer,
+        resultSize * index);
+
+    D3D12_INTERNAL_TrackQueryPool(d3d12CommandBuffer, queryPool);
+}
+
+static void D3D12_WriteTimestamp(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+
+    ID3D12GraphicsCommandList_EndQuery(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12QueryPool->heap,
+        D3D12_QUERY_TYPE_TIMESTAMP,
+        index);
+
+    D3D12_INTERNAL_ResolveQuery(d3d12CommandBuffer, d3d12QueryPool, index);
+}
+
+static void D3D12_BeginQuery(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+
+    ID3D12GraphicsCommandList_BeginQuery(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12QueryPool->heap,
+        D3D12_QUERY_TYPE_PIPELINE_STATISTICS,
+        index);
+}
+
+static void D3D12_EndQuery(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+
+    ID3D12GraphicsCommandList_EndQuery(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12QueryPool->heap,
+        D3D12_QUERY_TYPE_PIPELINE_STATISTICS,
+        index);
+
+    D3D12_INTERNAL_ResolveQuery(d3d12CommandBuffer, d3d12QueryPool, index);
+}
+
+static bool D3D12_GetQueryResults(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 numQueries,
+    void *data)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+    D3D12_RANGE readRange;
+    D3D12_RANGE writeRange;
+    Uint8 *mapPointer;
+    SIZE_T resultSize;
+    Uint32 i;
+    HRESULT res;
+
+    /* D3D12 has no per-query availability, so results are ready
+     * once no submitted command buffer still resolves into this pool.
+     */
+    if (SDL_GetAtomicInt(&d3d12QueryPool->referenceCount) > 0) {
+        return SDL_SetError("Query results are not available yet");
+    }
+
+    if (d3d12QueryPool->queryType == D3D12_QUERY_TYPE_TIMESTAMP) {
+        resultSize = sizeof(UINT64);
+    } else {
+        resultSize = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS);
+    }
+
+    readRange.Begin = resultSize * firstQuery;
+    readRange.End = resultSize * (firstQuery + numQueries);
+    res = ID3D12Resource_Map(
+        d3d12QueryPool->readbackBuffer,
+        0,
+        &readRange,
+        (void **)&mapPointer);
+    CHECK_D3D12_ERROR_AND_RETURN("Failed to map query readback buffer!", false);
+
+    if (d3d12QueryPool->queryType == D3D12_QUERY_TYPE_TIMESTAMP) {
+        const UINT64 *ticks = (const UINT64 *)(mapPointer + readRange.Begin);
+        Uint64 *timestamps = (Uint64 *)data;
+        Uint64 frequency = d3d12QueryPool->timestampFrequency;
+        for (i = 0; i < numQueries; i += 1) {
+            // Split the conversion to keep precision without overflowing
+            timestamps[i] =
+                (ticks[i] / frequency) * SDL_NS_PER_SECOND +
+                ((ticks[i] % frequency) * SDL_NS_PER_SECOND) / frequency;
+        }
+    } else {
+        const D3D12_QUERY_DATA_PIPELINE_STATISTICS *stats =
+            (const D3D12_QUERY_DATA_PIPELINE_STATISTICS *)(mapPointer + readRange.Begin);
+        SDL_GPUPipelineStatistics *results = (SDL_GPUPipelineStatistics *)data;
+        for (i = 0; i < numQueries; i += 1) {
+            results[i].input_assembly_vertices = stats[i].IAVertices;
+            results[i].input_assembly_primitives = stats[i].IAPrimitives;
+            results[i].vertex_shader_invocations = stats[i].VSInvocations;
+            results[i].clipping_invocations = stats[i].CInvocations;
+            results[i].clipping_primitives = stats[i].CPrimitives;
+            results[i].fragment_shader_invocations = stats[i].PSInvocations;
+            results[i].compute_shader_invocations = stats[i].CSInvocations;
+        }
+    }
+
+    writeRange.Begin = 0;
+    writeRange.End = 0;
+    ID3D12Resource_Unmap(
+        d3d12QueryPool->readbackBuffer,
+        0,
+        &writeRange);
+
+    return true;
+}
+
+static void D3D12_ReleaseQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+
+    // Query pools are rarely released, so just make sure nothing in flight still uses it
+    D3D12_Wait(driverData);
+
+    ID3D12Resource_Release(d3d12QueryPool->readbackBuffer);
+    ID3D12QueryHeap_Release(d3d12QueryPool->heap);
+    SDL_free(d3d12QueryPool);
+}
+
 // State Creation
 
 static D3D12DescriptorHeap *D3D12_INTERNAL_CreateDescriptorHeap(
@@ -2212,6 +2853,13 @@ static D3D12DescriptorHeap *D3D12_INTERNAL_CreateDescriptorHeap(
         D3D_CALL_RET(handle, GetGPUDescriptorHandleForHeapStart, &heap->descriptorHeapGPUStart);
     }
 
+    SDL_TrackMemoryObject(
+        heap,
+        SDL_MEMORY_OBJECT_CACHE,
+        (Uint64)descriptorCount * heap->descriptorSize,
+        NULL,
+        staging ? "SDL.gpu.d3d12.staging_descriptors" : "SDL.gpu.d3d12.gpu_descriptors");
+
     return heap;
 }
 
@@ -2354,7 +3002,8 @@ static void D3D12_INTERNAL_ReturnGPUDescriptorHeapToPool(
 static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
     D3D12Renderer *renderer,
     D3D12Shader *vertexShader,
-    D3D12Shader *fragmentShader)
+    D3D12Shader *fragmentShader,
+    D3D12_SHADER_VISIBILITY vertexVisibility)
 {
     // FIXME: I think the max can be smaller...
     D3D12_ROOT_PARAMETER rootParameters[MAX_ROOT_SIGNATURE_PARAMETERS];
@@ -2400,7 +3049,7 @@ static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
         rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
         rootParameter.DescriptorTable.NumDescriptorRanges = 1;
         rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRanges[rangeCount];
-        rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameter.ShaderVisibility = vertexVisibility;
         rootParameters[parameterCount] = rootParameter;
         d3d12GraphicsRootSignature->vertexSamplerRootIndex = parameterCount;
         rangeCount += 1;
@@ -2416,7 +3065,7 @@ static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
         rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
         rootParameter.DescriptorTable.NumDescriptorRanges = 1;
         rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRanges[rangeCount];
-        rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameter.ShaderVisibility = vertexVisibility;
         rootParameters[parameterCount] = rootParameter;
         d3d12GraphicsRootSignature->vertexSamplerTextureRootIndex = parameterCount;
         rangeCount += 1;
@@ -2435,7 +3084,7 @@ static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
         rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
         rootParameter.DescriptorTable.NumDescriptorRanges = 1;
         rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRanges[rangeCount];
-        rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameter.ShaderVisibility = vertexVisibility;
         rootParameters[parameterCount] = rootParameter;
         d3d12GraphicsRootSignature->vertexStorageTextureRootIndex = parameterCount;
         rangeCount += 1;
@@ -2455,7 +3104,7 @@ static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
         rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
         rootParameter.DescriptorTable.NumDescriptorRanges = 1;
         rootParameter.DescriptorTable.pDescriptorRanges = &descriptorRanges[rangeCount];
-        rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameter.ShaderVisibility = vertexVisibility;
         rootParameters[parameterCount] = rootParameter;
         d3d12GraphicsRootSignature->vertexStorageBufferRootIndex = parameterCount;
         rangeCount += 1;
@@ -2467,7 +3116,7 @@ static D3D12GraphicsRootSignature *D3D12_INTERNAL_CreateGraphicsRootSignature(
         rootParameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
         rootParameter.Descriptor.ShaderRegister = i;
         rootParameter.Descriptor.RegisterSpace = 1;
-        rootParameter.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+        rootParameter.ShaderVisibility = vertexVisibility;
         rootParameters[parameterCount] = rootParameter;
         d3d12GraphicsRootSignature->vertexUniformBufferRootIndex[i] = parameterCount;
         parameterCount += 1;
@@ -3071,16 +3720,91 @@ static bool D3D12_INTERNAL_AssignStagingDescriptorHandle(
     return true;
 }
 
+static void D3D12_INTERNAL_AppendPipelineSubobject(
+    Uint8 *stream,
+    size_t *streamSize,
+    D3D12_PIPELINE_STATE_SUBOBJECT_TYPE type,
+    const void *data,
+    size_t dataSize,
+    size_t dataAlignment)
+{
+    // Each subobject starts pointer-aligned, with its data naturally aligned after the type
+    size_t offset = (*streamSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    size_t dataOffset = (offset + sizeof(type) + dataAlignment - 1) & ~(dataAlignment - 1);
+
+    SDL_memcpy(stream + offset, &type, sizeof(type));
+    SDL_memcpy(stream + dataOffset, data, dataSize);
+    *streamSize = dataOffset + dataSize;
+}
+
+static HRESULT D3D12_INTERNAL_CreateMeshPipelineState(
+    D3D12Renderer *renderer,
+    const D3D12_GRAPHICS_PIPELINE_STATE_DESC *psoDesc,
+    D3D12Shader *taskShader,
+    D3D12Shader *meshShader,
+    ID3D12PipelineState **pipelineState)
+{
+    // Mesh pipelines can only be described as a subobject stream
+    Uint64 stream[128];
+    size_t streamSize = 0;
+    D3D12_SHADER_BYTECODE bytecode;
+    struct D3D12_RT_FORMAT_ARRAY renderTargetFormats;
+    D3D12_PIPELINE_STATE_STREAM_DESC streamDesc;
+
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_ROOT_SIGNATURE, &psoDesc->pRootSignature, sizeof(psoDesc->pRootSignature), sizeof(void *));
+    if (taskShader != NULL) {
+        bytecode.pShaderBytecode = taskShader->bytecode;
+        bytecode.BytecodeLength = taskShader->bytecodeSize;
+        D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_AS, &bytecode, sizeof(bytecode), sizeof(void *));
+    }
+    bytecode.pShaderBytecode = meshShader->bytecode;
+    bytecode.BytecodeLength = meshShader->bytecodeSize;
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_MS, &bytecode, sizeof(bytecode), sizeof(void *));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_PS, &psoDesc->PS, sizeof(psoDesc->PS), sizeof(void *));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_BLEND, &psoDesc->BlendState, sizeof(psoDesc->BlendState), sizeof(UINT));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_MASK, &psoDesc->SampleMask, sizeof(psoDesc->SampleMask), sizeof(UINT));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RASTERIZER, &psoDesc->RasterizerState, sizeof(psoDesc->RasterizerState), sizeof(UINT));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL, &psoDesc->DepthStencilState, sizeof(psoDesc->DepthStencilState), sizeof(UINT));
+
+    SDL_zero(renderTargetFormats);
+    renderTargetFormats.NumRenderTargets = psoDesc->NumRenderTargets;
+    SDL_memcpy(renderTargetFormats.RTFormats, psoDesc->RTVFormats, sizeof(renderTargetFormats.RTFormats));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_RENDER_TARGET_FORMATS, &renderTargetFormats, sizeof(renderTargetFormats), sizeof(UINT));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, &psoDesc->DSVFormat, sizeof(psoDesc->DSVFormat), sizeof(UINT));
+    D3D12_INTERNAL_AppendPipelineSubobject((Uint8 *)stream, &streamSize, D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, &psoDesc->SampleDesc, sizeof(psoDesc->SampleDesc), sizeof(UINT));
+
+    SDL_assert(streamSize <= sizeof(stream));
+
+    streamDesc.SizeInBytes = (streamSize + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    streamDesc.pPipelineStateSubobjectStream = stream;
+
+    return ID3D12Device2_CreatePipelineState(
+        renderer->device2,
+        &streamDesc,
+        D3D_GUID(D3D_IID_ID3D12PipelineState),
+        (void **)pipelineState);
+}
+
 static SDL_GPUGraphicsPipeline *D3D12_CreateGraphicsPipeline(
     SDL_GPURenderer *driverData,
     const SDL_GPUGraphicsPipelineCreateInfo *createinfo)
 {
     D3D12Renderer *renderer = (D3D12Renderer *)driverData;
-    D3D12Shader *vertShader = (D3D12Shader *)createinfo->vertex_shader;
+    D3D12Shader *taskShader = (D3D12Shader *)SDL_GetPointerProperty(createinfo->props, SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_TASK_SHADER_POINTER, NULL);
+    D3D12Shader *meshShader = (D3D12Shader *)SDL_GetPointerProperty(createinfo->props, SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER, NULL);
+    D3D12Shader *vertShader = (meshShader != NULL) ? meshShader : (D3D12Shader *)createinfo->vertex_shader;
     D3D12Shader *fragShader = (D3D12Shader *)createinfo->fragment_shader;
+    D3D12Shader geometryResources = *vertShader;
 
     if (renderer->debug_mode) {
-        if (vertShader->stage != SDL_GPU_SHADERSTAGE_VERTEX) {
+        if (meshShader != NULL) {
+            if (meshShader->stage != SDL_GPU_SHADERSTAGE_MESH) {
+                SDL_assert_release(!"CreateGraphicsPipeline was passed a non-mesh shader for the mesh stage");
+            }
+            if (taskShader != NULL && taskShader->stage != SDL_GPU_SHADERSTAGE_TASK) {
+                SDL_assert_release(!"CreateGraphicsPipeline was passed a non-task shader for the task stage");
+            }
+        } else if (vertShader->stage != SDL_GPU_SHADERSTAGE_VERTEX) {
             SDL_assert_release(!"CreateGraphicsPipeline was passed a fragment shader for the vertex stage");
         }
         if (fragShader->stage != SDL_GPU_SHADERSTAGE_FRAGMENT) {
@@ -3088,15 +3812,25 @@ static SDL_GPUGraphicsPipeline *D3D12_CreateGraphicsPipeline(
         }
     }
 
+    // Task and mesh shaders share the vertex stage's root parameters
+    if (taskShader != NULL) {
+        geometryResources.num_samplers = SDL_max(geometryResources.num_samplers, taskShader->num_samplers);
+        geometryResources.numUniformBuffers = SDL_max(geometryResources.numUniformBuffers, taskShader->numUniformBuffers);
+        geometryResources.numStorageBuffers = SDL_max(geometryResources.numStorageBuffers, taskShader->numStorageBuffers);
+        geometryResources.numStorageTextures = SDL_max(geometryResources.numStorageTextures, taskShader->numStorageTextures);
+    }
+
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc;
     SDL_zero(psoDesc);
-    psoDesc.VS.pShaderBytecode = vertShader->bytecode;
-    psoDesc.VS.BytecodeLength = vertShader->bytecodeSize;
+    if (meshShader == NULL) {
+        psoDesc.VS.pShaderBytecode = vertShader->bytecode;
+        psoDesc.VS.BytecodeLength = vertShader->bytecodeSize;
+    }
     psoDesc.PS.pShaderBytecode = fragShader->bytecode;
     psoDesc.PS.BytecodeLength = fragShader->bytecodeSize;
 
     D3D12_INPUT_ELEMENT_DESC inputElementDescs[D3D12_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT];
-    if (createinfo->vertex_input_state.num_vertex_attributes > 0) {
+    if (meshShader == NULL && createinfo->vertex_input_state.num_vertex_attributes > 0) {
         psoDesc.InputLayout.pInputElementDescs = inputElementDescs;
         psoDesc.InputLayout.NumElements = createinfo->vertex_input_state.num_vertex_attributes;
         D3D12_INTERNAL_ConvertVertexInputState(createinfo->vertex_input_state, inputElementDescs, renderer->semantic);
@@ -3140,8 +3874,9 @@ static SDL_GPUGraphicsPipeline *D3D12_CreateGraphicsPipeline(
 
     D3D12GraphicsRootSignature *rootSignature = D3D12_INTERNAL_CreateGraphicsRootSignature(
         renderer,
-        vertShader,
-        fragShader);
+        &geometryResources,
+        fragShader,
+        (meshShader != NULL) ? D3D12_SHADER_VISIBILITY_ALL : D3D12_SHADER_VISIBILITY_VERTEX);
 
     if (rootSignature == NULL) {
         D3D12_INTERNAL_DestroyGraphicsPipeline(pipeline);
@@ -3151,12 +3886,22 @@ static SDL_GPUGraphicsPipeline *D3D12_CreateGraphicsPipeline(
 
     psoDesc.pRootSignature = rootSignature->handle;
     ID3D12PipelineState *pipelineState;
+    HRESULT res;
 
-    HRESULT res = ID3D12Device_CreateGraphicsPipelineState(
-        renderer->device,
-        &psoDesc,
-        D3D_GUID(D3D_IID_ID3D12PipelineState),
-        (void **)&pipelineState);
+    if (meshShader != NULL) {
+        res = D3D12_INTERNAL_CreateMeshPipelineState(
+            renderer,
+            &psoDesc,
+            taskShader,
+            meshShader,
+            &pipelineState);
+    } else {
+        res = ID3D12Device_CreateGraphicsPipelineState(
+            renderer->device,
+            &psoDesc,
+            D3D_GUID(D3D_IID_ID3D12PipelineState),
+            (void **)&pipelineState);
+    }
     if (FAILED(res)) {
         D3D12_INTERNAL_SetError(renderer, "Could not create graphics pipeline state", res);
         D3D12_INTERNAL_DestroyGraphicsPipeline(pipeline);
@@ -3172,10 +3917,11 @@ static SDL_GPUGraphicsPipeline *D3D12_CreateGraphicsPipeline(
 
     pipeline->primitiveType = createinfo->primitive_type;
 
-    pipeline->header.num_vertex_samplers = vertShader->num_samplers;
-    pipeline->header.num_vertex_storage_textures = vertShader->numStorageTextures;
-    pipeline->header.num_vertex_storage_buffers = vertShader->numStorageBuffers;
-    pipeline->header.num_vertex_uniform_buffers = vertShader->numUniformBuffers;
+    pipeline->header.num_vertex_samplers = geometryResources.num_samplers;
+    pipeline->header.num_vertex_storage_textures = geometryResources.numStorageTextures;
+    pipeline->header.num_vertex_storage_buffers = geometryResources.numStorageBuffers;
+    pipeline->header.num_vertex_uniform_buffers = geometryResources.numUniformBuffers;
+    pipeline->header.mesh_pipeline = (meshShader != NULL);
 
     pipeline->header.num_fragment_samplers = fragShader->num_samplers;
     pipeline->header.num_fragment_storage_textures = fragShader->numStorageTextures;
@@ -3281,6 +4027,167 @@ static SDL_GPUShader *D3D12_CreateShader(
     return (SDL_GPUShader *)shader;
 }
 
+static bool D3D12_INTERNAL_CreateSparseHeap(
+    D3D12Renderer *renderer,
+    D3D12SparseResidency *sparse,
+    Uint32 tileCount,
+    ID3D12Heap **pHeap)
+{
+    D3D12_HEAP_DESC heapDesc;
+    HRESULT res;
+
+    heapDesc.SizeInBytes = (UINT64)tileCount * D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES;
+    heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapDesc.Properties.CreationNodeMask = 0; // We don't do multi-adapter operation
+    heapDesc.Properties.VisibleNodeMask = 0;  // We don't do multi-adapter operation
+    heapDesc.Alignment = 0;
+    heapDesc.Flags = sparse->heapFlags;
+
+    res = ID3D12Device_CreateHeap(
+        renderer->device,
+        &heapDesc,
+        D3D_GUID(D3D_IID_ID3D12Heap),
+        (void **)pHeap);
+    CHECK_D3D12_ERROR_AND_RETURN("Could not create sparse texture heap", false);
+
+    return true;
+}
+
+static void D3D12_INTERNAL_GetSparseLevelTiles(
+    D3D12SparseResidency *sparse,
+    Uint32 level,
+    Uint32 *tilesX,
+    Uint32 *tilesY,
+    Uint32 *tilesZ)
+{
+    *tilesX = (SDL_max(sparse->width >> level, 1) + sparse->tileShape.WidthInTexels - 1) / sparse->tileShape.WidthInTexels;
+    *tilesY = (SDL_max(sparse->height >> level, 1) + sparse->tileShape.HeightInTexels - 1) / sparse->tileShape.HeightInTexels;
+    *tilesZ = (SDL_max(sparse->depth >> level, 1) + sparse->tileShape.DepthInTexels - 1) / sparse->tileShape.DepthInTexels;
+}
+
+// Maps the packed mips of a new reserved resource and creates its empty tile table
+static bool D3D12_INTERNAL_InitSparseResidency(
+    D3D12Renderer *renderer,
+    D3D12Texture *texture,
+    const SDL_GPUTextureCreateInfo *createinfo)
+{
+    D3D12SparseResidency *sparse;
+    D3D12_PACKED_MIP_INFO packedMipInfo;
+    UINT totalTiles;
+    UINT subresourceTilingCount = 0;
+    Uint32 tileCount = 0;
+
+    sparse = (D3D12SparseResidency *)SDL_calloc(1, sizeof(D3D12SparseResidency));
+    if (!sparse) {
+        return false;
+    }
+
+    sparse->width = createinfo->width;
+    sparse->height = createinfo->height;
+    sparse->depth = createinfo->type == SDL_GPU_TEXTURETYPE_3D ? createinfo->layer_count_or_depth : 1;
+    sparse->layerCount = createinfo->type == SDL_GPU_TEXTURETYPE_3D ? 1 : createinfo->layer_count_or_depth;
+    sparse->levelCount = createinfo->num_levels;
+    sparse->lock = SDL_CreateMutex();
+
+    // Heap tier 1 can't mix render targets with other textures
+    if (createinfo->usage & SDL_GPU_TEXTUREUSAGE_COLOR_TARGET) {
+        sparse->heapFlags = D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_NON_RT_DS_TEXTURES;
+    } else {
+        sparse->heapFlags = D3D12_HEAP_FLAG_DENY_BUFFERS | D3D12_HEAP_FLAG_DENY_RT_DS_TEXTURES;
+    }
+
+    texture->sparse = sparse; // destroying the texture cleans up after a failure
+
+    ID3D12Device_GetResourceTiling(
+        renderer->device,
+        texture->resource,
+        &totalTiles,
+        &packedMipInfo,
+        &sparse->tileShape,
+        &subresourceTilingCount,
+        0,
+        NULL);
+
+    sparse->tiledLevelCount = SDL_min(packedMipInfo.NumStandardMips, createinfo->num_levels);
+
+    // Every layer has its own packed mips
+    if (packedMipInfo.NumPackedMips > 0 && packedMipInfo.NumTilesForPackedMips > 0) {
+        D3D12_TILED_RESOURCE_COORDINATE *coordinates;
+        D3D12_TILE_REGION_SIZE *regionSizes;
+        UINT *heapOffsets;
+        UINT *tileCounts;
+
+        if (!D3D12_INTERNAL_CreateSparseHeap(
+                renderer,
+                sparse,
+                packedMipInfo.NumTilesForPackedMips * sparse->layerCount,
+                &sparse->packedMipHeap)) {
+            return false;
+        }
+
+        coordinates = (D3D12_TILED_RESOURCE_COORDINATE *)SDL_malloc(sparse->layerCount * sizeof(D3D12_TILED_RESOURCE_COORDINATE));
+        regionSizes = (D3D12_TILE_REGION_SIZE *)SDL_malloc(sparse->layerCount * sizeof(D3D12_TILE_REGION_SIZE));
+        heapOffsets = (UINT *)SDL_malloc(sparse->layerCount * sizeof(UINT));
+        tileCounts = (UINT *)SDL_malloc(sparse->layerCount * sizeof(UINT));
+
+        for (Uint32 layer = 0; layer < sparse->layerCount; layer += 1) {
+            coordinates[layer].X = 0;
+            coordinates[layer].Y = 0;
+            coordinates[layer].Z = 0;
+            coordinates[layer].Subresource = D3D12_INTERNAL_CalcSubresource(
+                sparse->tiledLevelCount,
+                layer,
+                sparse->levelCount);
+            regionSizes[layer].NumTiles = packedMipInfo.NumTilesForPackedMips;
+            regionSizes[layer].UseBox = FALSE;
+            regionSizes[layer].Width = 0;
+            regionSizes[layer].Height = 0;
+            regionSizes[layer].Depth = 0;
+            heapOffsets[layer] = layer * packedMipInfo.NumTilesForPackedMips;
+            tileCounts[layer] = packedMipInfo.NumTilesForPackedMips;
+        }
+
+        SDL_LockMutex(renderer->submitLock);
+        ID3D12CommandQueue_UpdateTileMappings(
+            renderer->commandQueue,
+            texture->resource,
+            sparse->layerCount,
+            coordinates,
+            regionSizes,
+            sparse->packedMipHeap,
+            sparse->layerCount,
+            NULL,
+            heapOffsets,
+            tileCounts,
+            D3D12_TILE_MAPPING_FLAG_NONE);
+        SDL_UnlockMutex(renderer->submitLock);
+
+        SDL_free(coordinates);
+        SDL_free(regionSizes);
+        SDL_free(heapOffsets);
+        SDL_free(tileCounts);
+    }
+
+    sparse->levelTileOffsets = (Uint32 *)SDL_malloc((sparse->layerCount * sparse->tiledLevelCount + 1) * sizeof(Uint32));
+
+    for (Uint32 layer = 0; layer < sparse->layerCount; layer += 1) {
+        for (Uint32 level = 0; level < sparse->tiledLevelCount; level += 1) {
+            Uint32 tilesX, tilesY, tilesZ;
+            D3D12_INTERNAL_GetSparseLevelTiles(sparse, level, &tilesX, &tilesY, &tilesZ);
+
+            sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + level] = tileCount;
+            tileCount += tilesX * tilesY * tilesZ;
+        }
+    }
+
+    sparse->tileSlots = (Uint32 *)SDL_malloc((tileCount + 1) * sizeof(Uint32));
+    SDL_memset(sparse->tileSlots, 0xFF, (tileCount + 1) * sizeof(Uint32)); // SPARSE_TILE_NOT_RESIDENT
+
+    return true;
+}
+
 static D3D12Texture *D3D12_INTERNAL_CreateTexture(
     D3D12Renderer *renderer,
     const SDL_GPUTextureCreateInfo *createinfo,
@@ -3304,6 +4211,7 @@ static D3D12Texture *D3D12_INTERNAL_CreateTexture(
     bool needsUAV =
         (createinfo->usage & SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE) ||
         (createinfo->usage & SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE);
+    bool sparse = SDL_GetBooleanProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false);
     HRESULT res;
 
     texture = (D3D12Texture *)SDL_calloc(1, sizeof(D3D12Texture));
@@ -3376,15 +4284,29 @@ static D3D12Texture *D3D12_INTERNAL_CreateTexture(
 
     initialState = isSwapchainTexture ? D3D12_RESOURCE_STATE_PRESENT : D3D12_INTERNAL_DefaultTextureResourceState(createinfo->usage);
 
-    res = ID3D12Device_CreateCommittedResource(
-        renderer->device,
-        &heapProperties,
-        heapFlags,
-        &desc,
-        initialState,
-        useClearValue ? &clearValue : NULL,
-        D3D_GUID(D3D_IID_ID3D12Resource),
-        (void **)&handle);
+    if (sparse) {
+        // Reserved resources must use the standard 64KB tile layout
+        desc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE;
+
+        res = ID3D12Device_CreateReservedResource(
+            renderer->device,
+            &desc,
+            initialState,
+            useClearValue ? &clearValue : NULL,
+            D3D_GUID(D3D_IID_ID3D12Resource),
+            (void **)&handle);
+    } else {
+        res = ID3D12Device_CreateCommittedResource(
+            renderer->device,
+            &heapProperties,
+            heapFlags,
+            &desc,
+            initialState,
+            useClearValue ? &clearValue : NULL,
+            D3D_GUID(D3D_IID_ID3D12Resource),
+            (void **)&handle);
+    }
     if (FAILED(res)) {
         D3D12_INTERNAL_SetError(renderer, "Failed to create texture!", res);
         D3D12_INTERNAL_DestroyTexture(renderer, texture);
@@ -3393,6 +4315,11 @@ static D3D12Texture *D3D12_INTERNAL_CreateTexture(
 
     texture->resource = handle;
 
+    if (sparse && !D3D12_INTERNAL_InitSparseResidency(renderer, texture, createinfo)) {
+        D3D12_INTERNAL_DestroyTexture(renderer, texture);
+        return NULL;
+    }
+
     // Create the SRV if applicable
     if (needsSRV) {
         D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
@@ -3631,12 +4558,206 @@ static SDL_GPUTexture *D3D12_CreateTexture(
     container->textures[0] = texture;
     container->activeTexture = texture;
 
+    // A cycled sparse texture would lose its mapped tiles
+    container->canBeCycled = texture->sparse == NULL;
+
     texture->container = container;
     texture->containerIndex = 0;
 
     return (SDL_GPUTexture *)container;
 }
 
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+static bool D3D12_GetSparseTextureInfo(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTexture *texture,
+    Uint32 *tileWidth,
+    Uint32 *tileHeight,
+    Uint32 *tileDepth,
+    Uint32 *numTiledLevels)
+{
+    D3D12SparseResidency *sparse = ((D3D12TextureContainer *)texture)->activeTexture->sparse;
+    (void)driverData;
+
+    *tileWidth = sparse->tileShape.WidthInTexels;
+    *tileHeight = sparse->tileShape.HeightInTexels;
+    *tileDepth = sparse->tileShape.DepthInTexels;
+    *numTiledLevels = sparse->tiledLevelCount;
+
+    return true;
+}
+
+static bool D3D12_CommitTextureTiles(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureRegion *region,
+    bool commit)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12Texture *texture = ((D3D12TextureContainer *)region->texture)->activeTexture;
+    D3D12SparseResidency *sparse = texture->sparse;
+    D3D12_TILED_RESOURCE_COORDINATE *coordinates;
+    Uint32 *slots;
+    Uint32 coordinateCount = 0;
+    Uint32 tilesX, tilesY, tilesZ;
+    Uint32 firstX, firstY, firstZ, lastX, lastY, lastZ;
+    Uint32 layer = (sparse->depth > 1) ? 0 : region->layer;
+    Uint32 subresource;
+    Uint32 *levelSlots;
+    bool result = true;
+
+    // Packed mips are always resident
+    if (region->mip_level >= sparse->tiledLevelCount) {
+        return true;
+    }
+
+    D3D12_INTERNAL_GetSparseLevelTiles(sparse, region->mip_level, &tilesX, &tilesY, &tilesZ);
+
+    // Every tile the region touches is affected
+    firstX = region->x / sparse->tileShape.WidthInTexels;
+    firstY = region->y / sparse->tileShape.HeightInTexels;
+    firstZ = region->z / sparse->tileShape.DepthInTexels;
+    lastX = SDL_min((region->x + region->w + sparse->tileShape.WidthInTexels - 1) / sparse->tileShape.WidthInTexels, tilesX);
+    lastY = SDL_min((region->y + region->h + sparse->tileShape.HeightInTexels - 1) / sparse->tileShape.HeightInTexels, tilesY);
+    lastZ = SDL_min((region->z + region->d + sparse->tileShape.DepthInTexels - 1) / sparse->tileShape.DepthInTexels, tilesZ);
+
+    if (firstX >= lastX || firstY >= lastY || firstZ >= lastZ) {
+        return true;
+    }
+
+    coordinates = (D3D12_TILED_RESOURCE_COORDINATE *)SDL_malloc((lastX - firstX) * (lastY - firstY) * (lastZ - firstZ) * sizeof(D3D12_TILED_RESOURCE_COORDINATE));
+    slots = (Uint32 *)SDL_malloc((lastX - firstX) * (lastY - firstY) * (lastZ - firstZ) * sizeof(Uint32));
+    subresource = D3D12_INTERNAL_CalcSubresource(region->mip_level, layer, sparse->levelCount);
+    levelSlots = &sparse->tileSlots[sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + region->mip_level]];
+
+    SDL_LockMutex(sparse->lock);
+
+    for (Uint32 z = firstZ; z < lastZ && result; z += 1) {
+        for (Uint32 y = firstY; y < lastY && result; y += 1) {
+            for (Uint32 x = firstX; x < lastX; x += 1) {
+                Uint32 *slot = &levelSlots[(((z * tilesY) + y) * tilesX) + x];
+
+                if (commit == (*slot != SPARSE_TILE_NOT_RESIDENT)) {
+                    continue;
+                }
+
+                if (commit) {
+                    if (sparse->freeSlotCount == 0) {
+                        ID3D12Heap *heap;
+
+                        if (!D3D12_INTERNAL_CreateSparseHeap(renderer, sparse, SPARSE_TILES_PER_HEAP, &heap)) {
+                            // Map what we have so the tile table stays accurate
+                            result = false;
+                            break;
+                        }
+
+                        sparse->heaps = (ID3D12Heap **)SDL_realloc(
+                            sparse->heaps,
+                            (sparse->heapCount + 1) * sizeof(ID3D12Heap *));
+                        sparse->freeSlots = (Uint32 *)SDL_realloc(
+                            sparse->freeSlots,
+                            (sparse->heapCount + 1) * SPARSE_TILES_PER_HEAP * sizeof(Uint32));
+
+                        // Push in reverse so that slots are handed out in order
+                        for (Uint32 i = 0; i < SPARSE_TILES_PER_HEAP; i += 1) {
+                            sparse->freeSlots[sparse->freeSlotCount] = (sparse->heapCount * SPARSE_TILES_PER_HEAP) + (SPARSE_TILES_PER_HEAP - 1 - i);
+                            sparse->freeSlotCount += 1;
+                        }
+
+                        sparse->heaps[sparse->heapCount] = heap;
+                        sparse->heapCount += 1;
+                    }
+
+                    sparse->freeSlotCount -= 1;
+                    *slot = sparse->freeSlots[sparse->freeSlotCount];
+                } else {
+                    sparse->freeSlots[sparse->freeSlotCount] = *slot;
+                    sparse->freeSlotCount += 1;
+                    *slot = SPARSE_TILE_NOT_RESIDENT;
+                }
+
+                coordinates[coordinateCount].X = x;
+                coordinates[coordinateCount].Y = y;
+                coordinates[coordinateCount].Z = z;
+                coordinates[coordinateCount].Subresource = subresource;
+                slots[coordinateCount] = *slot;
+                coordinateCount += 1;
+            }
+        }
+    }
+
+    SDL_LockMutex(renderer->submitLock);
+
+    if (coordinateCount > 0 && !commit) {
+        D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NULL;
+        UINT rangeTileCount = coordinateCount;
+
+        ID3D12CommandQueue_UpdateTileMappings(
+            renderer->commandQueue,
+            texture->resource,
+            coordinateCount,
+            coordinates,
+            NULL,
+            NULL,
+            1,
+            &rangeFlags,
+            NULL,
+            &rangeTileCount,
+            D3D12_TILE_MAPPING_FLAG_NONE);
+    } else if (coordinateCount > 0) {
+        // Each call maps from a single heap, so group the tiles by heap
+        D3D12_TILED_RESOURCE_COORDINATE *heapCoordinates = (D3D12_TILED_RESOURCE_COORDINATE *)SDL_malloc(coordinateCount * sizeof(D3D12_TILED_RESOURCE_COORDINATE));
+        UINT *heapOffsets = (UINT *)SDL_malloc(coordinateCount * sizeof(UINT));
+        UINT *tileCounts = (UINT *)SDL_malloc(coordinateCount * sizeof(UINT));
+
+        for (Uint32 i = 0; i < coordinateCount; i += 1) {
+            Uint32 heapIndex;
+            Uint32 heapCoordinateCount = 0;
+
+            if (slots[i] == SPARSE_TILE_NOT_RESIDENT) {
+                continue;
+            }
+
+            heapIndex = slots[i] / SPARSE_TILES_PER_HEAP;
+
+            for (Uint32 j = i; j < coordinateCount; j += 1) {
+                if (slots[j] != SPARSE_TILE_NOT_RESIDENT && slots[j] / SPARSE_TILES_PER_HEAP == heapIndex) {
+                    heapCoordinates[heapCoordinateCount] = coordinates[j];
+                    heapOffsets[heapCoordinateCount] = slots[j] % SPARSE_TILES_PER_HEAP;
+                    tileCounts[heapCoordinateCount] = 1;
+                    heapCoordinateCount += 1;
+                    slots[j] = SPARSE_TILE_NOT_RESIDENT;
+                }
+            }
+
+            ID3D12CommandQueue_UpdateTileMappings(
+                renderer->commandQueue,
+                texture->resource,
+                heapCoordinateCount,
+                heapCoordinates,
+                NULL,
+                sparse->heaps[heapIndex],
+                heapCoordinateCount,
+                NULL,
+                heapOffsets,
+                tileCounts,
+                D3D12_TILE_MAPPING_FLAG_NONE);
+        }
+
+        SDL_free(heapCoordinates);
+        SDL_free(heapOffsets);
+        SDL_free(tileCounts);
+    }
+
+    SDL_UnlockMutex(renderer->submitLock);
+    SDL_UnlockMutex(sparse->lock);
+
+    SDL_free(coordinates);
+    SDL_free(slots);
+
+    return result;
+}
+#endif
+
 static D3D12Buffer *D3D12_INTERNAL_CreateBuffer(
     D3D12Renderer *renderer,
     SDL_GPUBufferUsageFlags usageFlags,
@@ -4060,7 +5181,7 @@ static void D3D12_INTERNAL_ReleaseBlitPipelines(SDL_GPURenderer *driverData)
 
 // Render Pass
 
-static void D3D12_SetViewport(
+SDL_GPU_DIRECT void D3D12_SetViewport(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUViewport *viewport)
 {
@@ -4075,7 +5196,7 @@ static void D3D12_SetViewport(
     ID3D12GraphicsCommandList_RSSetViewports(d3d12CommandBuffer->graphicsCommandList, 1, &d3d12Viewport);
 }
 
-static void D3D12_SetScissor(
+SDL_GPU_DIRECT void D3D12_SetScissor(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_Rect *scissor)
 {
@@ -4088,7 +5209,7 @@ static void D3D12_SetScissor(
     ID3D12GraphicsCommandList_RSSetScissorRects(d3d12CommandBuffer->graphicsCommandList, 1, &scissorRect);
 }
 
-static void D3D12_SetBlendConstants(
+SDL_GPU_DIRECT void D3D12_SetBlendConstants(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_FColor blendConstants)
 {
@@ -4097,7 +5218,7 @@ static void D3D12_SetBlendConstants(
     ID3D12GraphicsCommandList_OMSetBlendFactor(d3d12CommandBuffer->graphicsCommandList, blendFactor);
 }
 
-static void D3D12_SetStencilReference(
+SDL_GPU_DIRECT void D3D12_SetStencilReference(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint8 reference
 ) {
@@ -4320,24 +5441,8 @@ static void D3D12_BeginRenderPass(
             D3D12_RESOURCE_STATE_RENDER_TARGET);
 
         Uint32 rtvIndex = container->header.info.type == SDL_GPU_TEXTURETYPE_3D ? colorTargetInfos[i].layer_or_depth_plane : 0;
-        D3D12_CPU_DESCRIPTOR_HANDLE rtv = subresource->rtvHandles[rtvIndex].cpuHandle;
-
-        if (colorTargetInfos[i].load_op == SDL_GPU_LOADOP_CLEAR) {
-            float clearColor[4];
-            clearColor[0] = colorTargetInfos[i].clear_color.r;
-            clearColor[1] = colorTargetInfos[i].clear_color.g;
-            clearColor[2] = colorTargetInfos[i].clear_color.b;
-            clearColor[3] = colorTargetInfos[i].clear_color.a;
-
-            ID3D12GraphicsCommandList_ClearRenderTargetView(
-                d3d12CommandBuffer->graphicsCommandList,
-                rtv,
-                clearColor,
-                0,
-                NULL);
-        }
 
-        rtvs[i] = rtv;
+        rtvs[i] = subresource->rtvHandles[rtvIndex].cpuHandle;
         d3d12CommandBuffer->colorTargetSubresources[i] = subresource;
 
         D3D12_INTERNAL_TrackTexture(d3d12CommandBuffer, subresource->parent);
@@ -4352,22 +5457,48 @@ static void D3D12_BeginRenderPass(
                 colorTargetInfos[i].cycle_resolve_texture,
                 D3D12_RESOURCE_STATE_RESOLVE_DEST);
 
-            d3d12CommandBuffer->colorResolveSubresources[i] = resolveSubresource;
-            D3D12_INTERNAL_TrackTexture(d3d12CommandBuffer, resolveSubresource->parent);
+            d3d12CommandBuffer->colorResolveSubresources[i] = resolveSubresource;
+            D3D12_INTERNAL_TrackTexture(d3d12CommandBuffer, resolveSubresource->parent);
+        }
+    }
+
+    D3D12_CPU_DESCRIPTOR_HANDLE dsv;
+    if (depthStencilTargetInfo != NULL) {
+        D3D12TextureContainer *container = (D3D12TextureContainer *)depthStencilTargetInfo->texture;
+        D3D12TextureSubresource *subresource = D3D12_INTERNAL_PrepareTextureSubresourceForWrite(
+            d3d12CommandBuffer,
+            container,
+            0,
+            0,
+            depthStencilTargetInfo->cycle,
+            D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+        dsv = subresource->dsvHandle.cpuHandle;
+        d3d12CommandBuffer->depthStencilTextureSubresource = subresource;
+        D3D12_INTERNAL_TrackTexture(d3d12CommandBuffer, subresource->parent);
+    }
+
+    // All target transitions go out in one barrier call before the clears
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
+    for (Uint32 i = 0; i < numColorTargets; i += 1) {
+        if (colorTargetInfos[i].load_op == SDL_GPU_LOADOP_CLEAR) {
+            float clearColor[4];
+            clearColor[0] = colorTargetInfos[i].clear_color.r;
+            clearColor[1] = colorTargetInfos[i].clear_color.g;
+            clearColor[2] = colorTargetInfos[i].clear_color.b;
+            clearColor[3] = colorTargetInfos[i].clear_color.a;
+
+            ID3D12GraphicsCommandList_ClearRenderTargetView(
+                d3d12CommandBuffer->graphicsCommandList,
+                rtvs[i],
+                clearColor,
+                0,
+                NULL);
         }
     }
 
-    D3D12_CPU_DESCRIPTOR_HANDLE dsv;
     if (depthStencilTargetInfo != NULL) {
-        D3D12TextureContainer *container = (D3D12TextureContainer *)depthStencilTargetInfo->texture;
-        D3D12TextureSubresource *subresource = D3D12_INTERNAL_PrepareTextureSubresourceForWrite(
-            d3d12CommandBuffer,
-            container,
-            0,
-            0,
-            depthStencilTargetInfo->cycle,
-            D3D12_RESOURCE_STATE_DEPTH_WRITE);
-
         if (
             depthStencilTargetInfo->load_op == SDL_GPU_LOADOP_CLEAR ||
             depthStencilTargetInfo->stencil_load_op == SDL_GPU_LOADOP_CLEAR) {
@@ -4381,17 +5512,13 @@ static void D3D12_BeginRenderPass(
 
             ID3D12GraphicsCommandList_ClearDepthStencilView(
                 d3d12CommandBuffer->graphicsCommandList,
-                subresource->dsvHandle.cpuHandle,
+                dsv,
                 clearFlags,
                 depthStencilTargetInfo->clear_depth,
                 depthStencilTargetInfo->clear_stencil,
                 0,
                 NULL);
         }
-
-        dsv = subresource->dsvHandle.cpuHandle;
-        d3d12CommandBuffer->depthStencilTextureSubresource = subresource;
-        D3D12_INTERNAL_TrackTexture(d3d12CommandBuffer, subresource->parent);
     }
 
     ID3D12GraphicsCommandList_OMSetRenderTargets(
@@ -4609,7 +5736,7 @@ static void D3D12_INTERNAL_PushUniformData(
     }
 }
 
-static void D3D12_BindGraphicsPipeline(
+SDL_GPU_DIRECT void D3D12_BindGraphicsPipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUGraphicsPipeline *graphicsPipeline)
 {
@@ -4654,7 +5781,7 @@ static void D3D12_BindGraphicsPipeline(
     D3D12_INTERNAL_TrackGraphicsPipeline(d3d12CommandBuffer, pipeline);
 }
 
-static void D3D12_BindVertexBuffers(
+SDL_GPU_DIRECT void D3D12_BindVertexBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUBufferBinding *bindings,
@@ -4678,7 +5805,7 @@ static void D3D12_BindVertexBuffers(
         SDL_max(d3d12CommandBuffer->vertexBufferCount, firstSlot + numBindings);
 }
 
-static void D3D12_BindIndexBuffer(
+SDL_GPU_DIRECT void D3D12_BindIndexBuffer(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUBufferBinding *binding,
     SDL_GPUIndexElementSize indexElementSize)
@@ -4699,7 +5826,7 @@ static void D3D12_BindIndexBuffer(
         &view);
 }
 
-static void D3D12_BindVertexSamplers(
+SDL_GPU_DIRECT void D3D12_BindVertexSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -4731,7 +5858,7 @@ static void D3D12_BindVertexSamplers(
     }
 }
 
-static void D3D12_BindVertexStorageTextures(
+SDL_GPU_DIRECT void D3D12_BindVertexStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -4752,7 +5879,7 @@ static void D3D12_BindVertexStorageTextures(
     }
 }
 
-static void D3D12_BindVertexStorageBuffers(
+SDL_GPU_DIRECT void D3D12_BindVertexStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -4773,7 +5900,7 @@ static void D3D12_BindVertexStorageBuffers(
     }
 }
 
-static void D3D12_BindFragmentSamplers(
+SDL_GPU_DIRECT void D3D12_BindFragmentSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -4805,7 +5932,7 @@ static void D3D12_BindFragmentSamplers(
     }
 }
 
-static void D3D12_BindFragmentStorageTextures(
+SDL_GPU_DIRECT void D3D12_BindFragmentStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -4826,7 +5953,7 @@ static void D3D12_BindFragmentStorageTextures(
     }
 }
 
-static void D3D12_BindFragmentStorageBuffers(
+SDL_GPU_DIRECT void D3D12_BindFragmentStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -4848,7 +5975,7 @@ static void D3D12_BindFragmentStorageBuffers(
     }
 }
 
-static void D3D12_PushVertexUniformData(
+SDL_GPU_DIRECT void D3D12_PushVertexUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -4864,7 +5991,7 @@ static void D3D12_PushVertexUniformData(
         length);
 }
 
-static void D3D12_PushFragmentUniformData(
+SDL_GPU_DIRECT void D3D12_PushFragmentUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -5152,7 +6279,7 @@ static void D3D12_INTERNAL_BindGraphicsResources(
     }
 }
 
-static void D3D12_DrawIndexedPrimitives(
+SDL_GPU_DIRECT void D3D12_DrawIndexedPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numIndices,
     Uint32 numInstances,
@@ -5172,7 +6299,7 @@ static void D3D12_DrawIndexedPrimitives(
         firstInstance);
 }
 
-static void D3D12_DrawPrimitives(
+SDL_GPU_DIRECT void D3D12_DrawPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numVertices,
     Uint32 numInstances,
@@ -5236,12 +6363,116 @@ static void D3D12_DrawIndexedPrimitivesIndirect(
     D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12Buffer);
 }
 
+static bool D3D12_SupportsIndirectCount(
+    SDL_GPURenderer *driverData)
+{
+    // ExecuteIndirect always accepts a count buffer
+    (void)driverData;
+    return true;
+}
+
+static void D3D12_DrawPrimitivesIndirectCount(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *countBuffer,
+    Uint32 countOffset,
+    Uint32 maxDrawCount)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12Buffer *d3d12Buffer = ((D3D12BufferContainer *)buffer)->activeBuffer;
+    D3D12Buffer *d3d12CountBuffer = ((D3D12BufferContainer *)countBuffer)->activeBuffer;
+
+    D3D12_INTERNAL_BindGraphicsResources(d3d12CommandBuffer);
+
+    ID3D12GraphicsCommandList_ExecuteIndirect(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12CommandBuffer->renderer->indirectDrawCommandSignature,
+        maxDrawCount,
+        d3d12Buffer->handle,
+        offset,
+        d3d12CountBuffer->handle,
+        countOffset);
+
+    D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12Buffer);
+    D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12CountBuffer);
+}
+
+static void D3D12_DrawIndexedPrimitivesIndirectCount(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *countBuffer,
+    Uint32 countOffset,
+    Uint32 maxDrawCount)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12Buffer *d3d12Buffer = ((D3D12BufferContainer *)buffer)->activeBuffer;
+    D3D12Buffer *d3d12CountBuffer = ((D3D12BufferContainer *)countBuffer)->activeBuffer;
+
+    D3D12_INTERNAL_BindGraphicsResources(d3d12CommandBuffer);
+
+    ID3D12GraphicsCommandList_ExecuteIndirect(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12CommandBuffer->renderer->indirectIndexedDrawCommandSignature,
+        maxDrawCount,
+        d3d12Buffer->handle,
+        offset,
+        d3d12CountBuffer->handle,
+        countOffset);
+
+    D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12Buffer);
+    D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12CountBuffer);
+}
+
+static void D3D12_DrawMeshTasks(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 groupcountX,
+    Uint32 groupcountY,
+    Uint32 groupcountZ)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+
+    D3D12_INTERNAL_BindGraphicsResources(d3d12CommandBuffer);
+
+    ID3D12GraphicsCommandList6_DispatchMesh(
+        d3d12CommandBuffer->meshCommandList,
+        groupcountX,
+        groupcountY,
+        groupcountZ);
+}
+
+static void D3D12_DrawMeshTasksIndirect(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    Uint32 drawCount)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12Buffer *d3d12Buffer = ((D3D12BufferContainer *)buffer)->activeBuffer;
+
+    D3D12_INTERNAL_BindGraphicsResources(d3d12CommandBuffer);
+
+    ID3D12GraphicsCommandList_ExecuteIndirect(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12CommandBuffer->renderer->indirectDispatchMeshCommandSignature,
+        drawCount,
+        d3d12Buffer->handle,
+        offset,
+        NULL,
+        0);
+
+    D3D12_INTERNAL_TrackBuffer(d3d12CommandBuffer, d3d12Buffer);
+}
+
 static void D3D12_EndRenderPass(
     SDL_GPUCommandBuffer *commandBuffer)
 {
     D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
     Uint32 i;
 
+    bool needsResolve = false;
+
     for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1) {
         if (d3d12CommandBuffer->colorTargetSubresources[i] != NULL) {
             if (d3d12CommandBuffer->colorResolveSubresources[i] != NULL) {
@@ -5252,7 +6483,23 @@ static void D3D12_EndRenderPass(
                     D3D12_RESOURCE_STATE_RESOLVE_SOURCE,
                     d3d12CommandBuffer->colorTargetSubresources[i]
                 );
+                needsResolve = true;
+            } else {
+                D3D12_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
+                    d3d12CommandBuffer,
+                    D3D12_RESOURCE_STATE_RENDER_TARGET,
+                    d3d12CommandBuffer->colorTargetSubresources[i]);
+            }
+        }
+    }
 
+    if (needsResolve) {
+        // Every resolve source is transitioned with a single barrier call
+        D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
+        for (i = 0; i < MAX_COLOR_TARGET_BINDINGS; i += 1) {
+            if (d3d12CommandBuffer->colorTargetSubresources[i] != NULL &&
+                d3d12CommandBuffer->colorResolveSubresources[i] != NULL) {
                 ID3D12GraphicsCommandList_ResolveSubresource(
                     d3d12CommandBuffer->graphicsCommandList,
                     d3d12CommandBuffer->colorResolveSubresources[i]->parent->resource,
@@ -5270,11 +6517,6 @@ static void D3D12_EndRenderPass(
                     d3d12CommandBuffer,
                     D3D12_RESOURCE_STATE_RESOLVE_DEST,
                     d3d12CommandBuffer->colorResolveSubresources[i]);
-            } else {
-                D3D12_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
-                    d3d12CommandBuffer,
-                    D3D12_RESOURCE_STATE_RENDER_TARGET,
-                    d3d12CommandBuffer->colorTargetSubresources[i]);
             }
         }
     }
@@ -5376,7 +6618,7 @@ static void D3D12_BeginComputePass(
     }
 }
 
-static void D3D12_BindComputePipeline(
+SDL_GPU_DIRECT void D3D12_BindComputePipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUComputePipeline *computePipeline)
 {
@@ -5456,7 +6698,7 @@ static void D3D12_BindComputePipeline(
     }
 }
 
-static void D3D12_BindComputeSamplers(
+SDL_GPU_DIRECT void D3D12_BindComputeSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -5488,7 +6730,7 @@ static void D3D12_BindComputeSamplers(
     }
 }
 
-static void D3D12_BindComputeStorageTextures(
+SDL_GPU_DIRECT void D3D12_BindComputeStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -5525,7 +6767,7 @@ static void D3D12_BindComputeStorageTextures(
     }
 }
 
-static void D3D12_BindComputeStorageBuffers(
+SDL_GPU_DIRECT void D3D12_BindComputeStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -5563,7 +6805,7 @@ static void D3D12_BindComputeStorageBuffers(
     }
 }
 
-static void D3D12_PushComputeUniformData(
+SDL_GPU_DIRECT void D3D12_PushComputeUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -5584,6 +6826,9 @@ static void D3D12_INTERNAL_BindComputeResources(
 {
     D3D12ComputePipeline *computePipeline = commandBuffer->currentComputePipeline;
 
+    // Storage bindings made since the last dispatch are transitioned together
+    D3D12_INTERNAL_FlushBarriers(commandBuffer);
+
     /* Acquire GPU descriptor heaps if we haven't yet */
     if (commandBuffer->gpuDescriptorHeaps[0] == NULL) {
         D3D12_INTERNAL_SetGPUDescriptorHeaps(commandBuffer);
@@ -5684,7 +6929,7 @@ static void D3D12_INTERNAL_BindComputeResources(
     }
 }
 
-static void D3D12_DispatchCompute(
+SDL_GPU_DIRECT void D3D12_DispatchCompute(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 groupcountX,
     Uint32 groupcountY,
@@ -5869,6 +7114,8 @@ static void D3D12_UploadToTexture(
         cycle,
         D3D12_RESOURCE_STATE_COPY_DEST);
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     /* D3D12 requires texture data row pitch to be 256 byte aligned, which is obviously insane.
      * Instead of exposing that restriction to the client, which is a huge rake to step on,
      * and a restriction that no other backend requires, we're going to copy data to a temporary buffer,
@@ -6033,6 +7280,8 @@ static void D3D12_UploadToBuffer(
         cycle,
         D3D12_RESOURCE_STATE_COPY_DEST);
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     ID3D12GraphicsCommandList_CopyBufferRegion(
         d3d12CommandBuffer->graphicsCommandList,
         buffer->handle,
@@ -6091,6 +7340,8 @@ static void D3D12_CopyTextureToTexture(
 
     D3D12_BOX sourceBox = { source->x, source->y, source->z, source->x + w, source->y + h, source->z + d };
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     ID3D12GraphicsCommandList_CopyTextureRegion(
         d3d12CommandBuffer->graphicsCommandList,
         &destinationLocation,
@@ -6142,6 +7393,8 @@ static void D3D12_CopyBufferToBuffer(
         D3D12_RESOURCE_STATE_COPY_SOURCE,
         sourceBuffer);
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     ID3D12GraphicsCommandList_CopyBufferRegion(
         d3d12CommandBuffer->graphicsCommandList,
         destinationBuffer->handle,
@@ -6269,6 +7522,8 @@ static void D3D12_DownloadFromTexture(
         D3D12_RESOURCE_STATE_COPY_SOURCE,
         sourceSubresource);
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     ID3D12GraphicsCommandList_CopyTextureRegion(
         d3d12CommandBuffer->graphicsCommandList,
         &destinationLocation,
@@ -6320,6 +7575,8 @@ static void D3D12_DownloadFromBuffer(
 
     D3D12Buffer *destinationBuffer = destinationContainer->activeBuffer;
 
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     ID3D12GraphicsCommandList_CopyBufferRegion(
         d3d12CommandBuffer->graphicsCommandList,
         destinationBuffer->handle,
@@ -6408,14 +7665,16 @@ static void D3D12_GenerateMipmaps(
 
 static void D3D12_Blit(
     SDL_GPUCommandBuffer *commandBuffer,
-    const SDL_GPUBlitInfo *info)
+    const SDL_GPUBlitInfo *infos,
+    Uint32 numInfos)
 {
     D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
     D3D12Renderer *renderer = (D3D12Renderer *)d3d12CommandBuffer->renderer;
 
     SDL_GPU_BlitCommon(
         commandBuffer,
-        info,
+        infos,
+        numInfos,
         renderer->blitLinearSampler,
         renderer->blitNearestSampler,
         renderer->blitVertexShader,
@@ -6522,6 +7781,9 @@ static bool D3D12_SupportsPresentMode(
 #else
         return true;
 #endif
+    case SDL_GPU_PRESENTMODE_VSYNC_RELAXED:
+        // DXGI has no adaptive vsync present
+        return false;
     default:
         SDL_assert(!"Unrecognized present mode");
         return false;
@@ -6779,7 +8041,7 @@ static bool D3D12_INTERNAL_ResizeSwapchain(
         0, // use client window width
         0, // use client window height
         DXGI_FORMAT_UNKNOWN, // Keep the old format
-        renderer->supportsTearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0);
+        DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT | (renderer->supportsTearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0));
     CHECK_D3D12_ERROR_AND_RETURN("Could not resize swapchain buffers", false);
 
     // Create texture object for the swapchain
@@ -6823,6 +8085,11 @@ static void D3D12_INTERNAL_DestroySwapchain(
         SDL_free(windowData->textureContainers[i].textures);
     }
 
+    if (windowData->frameLatencyWaitableObject) {
+        CloseHandle(windowData->frameLatencyWaitableObject);
+        windowData->frameLatencyWaitableObject = NULL;
+    }
+
     IDXGISwapChain_Release(windowData->swapchain);
     windowData->swapchain = NULL;
 }
@@ -6875,10 +8142,10 @@ static bool D3D12_INTERNAL_CreateSwapchain(
     fullscreenDesc.Scaling = DXGI_MODE_SCALING_UNSPECIFIED;
     fullscreenDesc.Windowed = true;
 
+    // The waitable object lets D3D12_WaitForSwapchain block until DXGI is ready for another frame
+    swapchainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
     if (renderer->supportsTearing) {
-        swapchainDesc.Flags = DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
-    } else {
-        swapchainDesc.Flags = 0;
+        swapchainDesc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
     }
 
     if (!IsWindow(dxgiHandle)) {
@@ -6903,6 +8170,17 @@ static bool D3D12_INTERNAL_CreateSwapchain(
     IDXGISwapChain1_Release(swapchain);
     CHECK_D3D12_ERROR_AND_RETURN("Could not create IDXGISwapChain3", false);
 
+    res = IDXGISwapChain3_SetMaximumFrameLatency(
+        swapchain3,
+        renderer->allowedFramesInFlight);
+    if (FAILED(res)) {
+        SDL_LogWarn(
+            SDL_LOG_CATEGORY_GPU,
+            "Could not set swapchain frame latency! Error Code: " HRESULT_FMT,
+            res);
+    }
+    windowData->frameLatencyWaitableObject = IDXGISwapChain3_GetFrameLatencyWaitableObject(swapchain3);
+
     if (swapchainComposition != SDL_GPU_SWAPCHAINCOMPOSITION_SDR) {
         // Support already verified if we hit this block
         IDXGISwapChain3_SetColorSpace1(
@@ -7019,7 +8297,7 @@ static bool D3D12_ClaimWindow(
             renderer->claimedWindowCount += 1;
             SDL_UnlockMutex(renderer->windowLock);
 
-            SDL_AddEventWatch(D3D12_INTERNAL_OnWindowResize, window);
+            SDL_AddEventWatchRange(SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED, SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED, D3D12_INTERNAL_OnWindowResize, window);
 
             return true;
         } else {
@@ -7245,6 +8523,31 @@ static bool D3D12_INTERNAL_AllocateCommandBuffer(
     }
     commandBuffer->graphicsCommandList = commandList;
 
+    if (renderer->device2) {
+        res = ID3D12GraphicsCommandList_QueryInterface(
+            commandList,
+            D3D_GUID(D3D_IID_ID3D12GraphicsCommandList6),
+            (void **)&commandBuffer->meshCommandList);
+        if (FAILED(res)) {
+            D3D12_INTERNAL_SetError(renderer, "Failed to query ID3D12GraphicsCommandList6", res);
+            D3D12_INTERNAL_DestroyCommandBuffer(commandBuffer);
+            return false;
+        }
+    }
+
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    if (renderer->enhancedBarriersSupported) {
+        // Not fatal, the legacy ResourceBarrier path still works
+        res = ID3D12GraphicsCommandList_QueryInterface(
+            commandList,
+            D3D_GUID(D3D_IID_ID3D12GraphicsCommandList7),
+            (void **)&commandBuffer->barrierCommandList);
+        if (FAILED(res)) {
+            commandBuffer->barrierCommandList = NULL;
+        }
+    }
+#endif
+
     commandBuffer->renderer = renderer;
     commandBuffer->inFlightFence = NULL;
 
@@ -7280,6 +8583,11 @@ static bool D3D12_INTERNAL_AllocateCommandBuffer(
     commandBuffer->usedComputePipelines = (D3D12ComputePipeline **)SDL_calloc(
         commandBuffer->usedComputePipelineCapacity, sizeof(D3D12ComputePipeline *));
 
+    commandBuffer->usedQueryPoolCapacity = 4;
+    commandBuffer->usedQueryPoolCount = 0;
+    commandBuffer->usedQueryPools = (D3D12QueryPool **)SDL_calloc(
+        commandBuffer->usedQueryPoolCapacity, sizeof(D3D12QueryPool *));
+
     commandBuffer->usedUniformBufferCapacity = 4;
     commandBuffer->usedUniformBufferCount = 0;
     commandBuffer->usedUniformBuffers = (D3D12UniformBuffer **)SDL_calloc(
@@ -7297,6 +8605,7 @@ static bool D3D12_INTERNAL_AllocateCommandBuffer(
         (!commandBuffer->usedSamplers) ||
         (!commandBuffer->usedGraphicsPipelines) ||
         (!commandBuffer->usedComputePipelines) ||
+        (!commandBuffer->usedQueryPools) ||
         (!commandBuffer->usedUniformBuffers) ||
         (!commandBuffer->textureDownloads)) {
         D3D12_INTERNAL_DestroyCommandBuffer(commandBuffer);
@@ -7413,6 +8722,15 @@ static bool D3D12_WaitForSwapchain(
         }
     }
 
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    /* Block until DXGI has fewer than allowedFramesInFlight presents queued,
+     * so the caller can sample input as late as possible.
+     */
+    if (windowData->frameLatencyWaitableObject) {
+        WaitForSingleObjectEx(windowData->frameLatencyWaitableObject, 1000, TRUE);
+    }
+#endif
+
     return true;
 }
 
@@ -7512,18 +8830,14 @@ static bool D3D12_INTERNAL_AcquireSwapchainTexture(
     d3d12CommandBuffer->presentDataCount += 1;
 
     // Set up resource barrier
-    D3D12_RESOURCE_BARRIER barrierDesc;
-    barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
-    barrierDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-    barrierDesc.Transition.pResource = windowData->textureContainers[swapchainIndex].activeTexture->resource;
-    barrierDesc.Transition.Subresource = 0;
-
-    ID3D12GraphicsCommandList_ResourceBarrier(
-        d3d12CommandBuffer->graphicsCommandList,
-        1,
-        &barrierDesc);
+    D3D12_INTERNAL_ResourceBarrier(
+        d3d12CommandBuffer,
+        D3D12_RESOURCE_STATE_PRESENT,
+        D3D12_RESOURCE_STATE_RENDER_TARGET,
+        windowData->textureContainers[swapchainIndex].activeTexture->resource,
+        0,
+        true,
+        false);
 
     *swapchainTexture = (SDL_GPUTexture*)&windowData->textureContainers[swapchainIndex];
     return true;
@@ -7687,6 +9001,7 @@ static bool D3D12_INTERNAL_CleanCommandBuffer(
         SDL_free(commandBuffer->textureDownloads[i]);
     }
     commandBuffer->textureDownloadCount = 0;
+    commandBuffer->pendingBarrierCount = 0;
 
     if (!result) {
         return false;
@@ -7751,6 +9066,11 @@ static bool D3D12_INTERNAL_CleanCommandBuffer(
     }
     commandBuffer->usedComputePipelineCount = 0;
 
+    for (i = 0; i < commandBuffer->usedQueryPoolCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedQueryPools[i]->referenceCount);
+    }
+    commandBuffer->usedQueryPoolCount = 0;
+
     // Reset presentation
     commandBuffer->presentDataCount = 0;
 
@@ -7828,20 +9148,19 @@ static bool D3D12_Submit(
         D3D12TextureContainer *container = &d3d12CommandBuffer->presentDatas[i].windowData->textureContainers[swapchainIndex];
         D3D12TextureSubresource *subresource = D3D12_INTERNAL_FetchTextureSubresource(container, 0, 0);
 
-        D3D12_RESOURCE_BARRIER barrierDesc;
-        barrierDesc.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrierDesc.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-        barrierDesc.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrierDesc.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
-        barrierDesc.Transition.pResource = subresource->parent->resource;
-        barrierDesc.Transition.Subresource = subresource->index;
-
-        ID3D12GraphicsCommandList_ResourceBarrier(
-            d3d12CommandBuffer->graphicsCommandList,
-            1,
-            &barrierDesc);
+        D3D12_INTERNAL_ResourceBarrier(
+            d3d12CommandBuffer,
+            D3D12_RESOURCE_STATE_RENDER_TARGET,
+            D3D12_RESOURCE_STATE_PRESENT,
+            subresource->parent->resource,
+            subresource->index,
+            true,
+            false);
     }
 
+    // Anything still queued is recorded before the list is closed
+    D3D12_INTERNAL_FlushBarriers(d3d12CommandBuffer);
+
     // Notify the command buffer that we have completed recording
     res = ID3D12GraphicsCommandList_Close(d3d12CommandBuffer->graphicsCommandList);
     CHECK_D3D12_ERROR_AND_RETURN("Failed to close command list!", false);
@@ -8111,6 +9430,38 @@ static bool D3D12_WaitForFences(
 
 // Feature Queries
 
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+static bool D3D12_SupportsSparseTexture(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTextureFormat format,
+    SDL_GPUTextureType type,
+    SDL_GPUTextureUsageFlags usage)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12_FEATURE_DATA_FORMAT_SUPPORT formatSupport = { SDLToD3D12_TextureFormat[format], D3D12_FORMAT_SUPPORT1_NONE, D3D12_FORMAT_SUPPORT2_NONE };
+    HRESULT res;
+    (void)usage;
+
+    // Tiled 3D textures need tier 3
+    if (renderer->tiledResourcesTier < (type == SDL_GPU_TEXTURETYPE_3D ? D3D12_TILED_RESOURCES_TIER_3 : D3D12_TILED_RESOURCES_TIER_1)) {
+        return false;
+    }
+
+    // Depth-stencil tiles would need mapping per plane
+    if (IsDepthFormat(format)) {
+        return false;
+    }
+
+    res = ID3D12Device_CheckFeatureSupport(
+        renderer->device,
+        D3D12_FEATURE_FORMAT_SUPPORT,
+        &formatSupport,
+        sizeof(formatSupport));
+
+    return SUCCEEDED(res) && (formatSupport.Support2 & D3D12_FORMAT_SUPPORT2_TILED);
+}
+#endif
+
 static bool D3D12_SupportsTextureFormat(
     SDL_GPURenderer *driverData,
     SDL_GPUTextureFormat format,
@@ -8213,6 +9564,26 @@ static bool D3D12_SupportsSampleCount(
     return SUCCEEDED(res) && featureData.NumQualityLevels > 0;
 }
 
+static void *D3D12_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    (void)driverData;
+    (void)size;
+    SDL_Unsupported();
+    return NULL;
+}
+
+static SDL_GPUMemoryHeapStats *D3D12_GetMemoryHeapStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    (void)driverData;
+    (void)count;
+    SDL_Unsupported();
+    return NULL;
+}
+
 static void D3D12_INTERNAL_InitBlitResources(
     D3D12Renderer *renderer)
 {
@@ -8338,10 +9709,41 @@ static void D3D12_INTERNAL_InitBlitResources(
     }
 }
 
-static bool D3D12_PrepareDriver(SDL_VideoDevice *_this)
+static bool D3D12_INTERNAL_SupportsMeshShaders(ID3D12Device *device)
 {
 #if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
-    return true;
+    (void)device;
+    return false;
+#else
+    D3D12_FEATURE_DATA_D3D12_OPTIONS7 options7;
+    D3D12_FEATURE_DATA_SHADER_MODEL shaderModel;
+    HRESULT res;
+
+    SDL_zero(options7);
+    res = ID3D12Device_CheckFeatureSupport(
+        device,
+        D3D12_FEATURE_D3D12_OPTIONS7,
+        &options7,
+        sizeof(options7));
+    if (FAILED(res) || options7.MeshShaderTier == D3D12_MESH_SHADER_TIER_NOT_SUPPORTED) {
+        return false;
+    }
+
+    // Amplification and mesh shaders need Shader Model 6.5
+    shaderModel.HighestShaderModel = D3D_SHADER_MODEL_6_5;
+    res = ID3D12Device_CheckFeatureSupport(
+        device,
+        D3D12_FEATURE_SHADER_MODEL,
+        &shaderModel,
+        sizeof(shaderModel));
+    return SUCCEEDED(res) && shaderModel.HighestShaderModel >= D3D_SHADER_MODEL_6_5;
+#endif
+}
+
+static bool D3D12_PrepareDriver(SDL_VideoDevice *_this, SDL_PropertiesID props)
+{
+#if defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES)
+    return !SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false);
 #else
     SDL_SharedObject *d3d12Dll;
     SDL_SharedObject *dxgiDll;
@@ -8354,6 +9756,7 @@ static bool D3D12_PrepareDriver(SDL_VideoDevice *_this)
     IDXGIFactory6 *factory6;
     IDXGIAdapter1 *adapter;
     bool supports_64UAVs = false;
+    bool supports_mesh_shaders = true;
 
     // Can we load D3D12?
 
@@ -8476,6 +9879,9 @@ static bool D3D12_PrepareDriver(SDL_VideoDevice *_this)
     }
 
     if (SUCCEEDED(res)) {
+        if (SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false)) {
+            supports_mesh_shaders = D3D12_INTERNAL_SupportsMeshShaders(device);
+        }
         ID3D12Device_Release(device);
     }
     IDXGIAdapter1_Release(adapter);
@@ -8494,6 +9900,11 @@ static bool D3D12_PrepareDriver(SDL_VideoDevice *_this)
         return false;
     }
 
+    if (!supports_mesh_shaders) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_GPU, "D3D12: Mesh shaders are not supported");
+        return false;
+    }
+
     return true;
 #endif
 }
@@ -8955,6 +10366,7 @@ static SDL_GPUDevice *D3D12_CreateDevice(bool debugMode, bool preferLowPower, SD
 
 #if (defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
     renderer->GPUUploadHeapSupported = false;
+    renderer->enhancedBarriersSupported = false;
 #else
     // Check "GPU Upload Heap" support (for fast uniform buffers)
     D3D12_FEATURE_DATA_D3D12_OPTIONS16 options16; // 15 wasn't enough, huh?
@@ -8968,6 +10380,31 @@ static SDL_GPUDevice *D3D12_CreateDevice(bool debugMode, bool preferLowPower, SD
     if (SUCCEEDED(res)) {
         renderer->GPUUploadHeapSupported = options16.GPUUploadHeapSupported;
     }
+
+    // Check enhanced barrier support (ID3D12GraphicsCommandList7::Barrier)
+    D3D12_FEATURE_DATA_D3D12_OPTIONS12 options12;
+    renderer->enhancedBarriersSupported = false;
+    res = ID3D12Device_CheckFeatureSupport(
+        renderer->device,
+        D3D12_FEATURE_D3D12_OPTIONS12,
+        &options12,
+        sizeof(options12));
+
+    if (SUCCEEDED(res)) {
+        renderer->enhancedBarriersSupported = options12.EnhancedBarriersSupported;
+    }
+
+    D3D12_FEATURE_DATA_D3D12_OPTIONS options;
+    renderer->tiledResourcesTier = D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED;
+    res = ID3D12Device_CheckFeatureSupport(
+        renderer->device,
+        D3D12_FEATURE_D3D12_OPTIONS,
+        &options,
+        sizeof(options));
+
+    if (SUCCEEDED(res)) {
+        renderer->tiledResourcesTier = options.TiledResourcesTier;
+    }
 #endif
 
     // Create command queue
@@ -9049,6 +10486,37 @@ static SDL_GPUDevice *D3D12_CreateDevice(bool debugMode, bool preferLowPower, SD
         CHECK_D3D12_ERROR_AND_RETURN("Could not create indirect dispatch command signature", NULL);
     }
 
+    if (SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false)) {
+        if (!D3D12_INTERNAL_SupportsMeshShaders(renderer->device)) {
+            D3D12_INTERNAL_DestroyRenderer(renderer);
+            SET_STRING_ERROR_AND_RETURN("Mesh shaders are not supported by this device", NULL);
+        }
+
+        res = ID3D12Device_QueryInterface(
+            renderer->device,
+            D3D_GUID(D3D_IID_ID3D12Device2),
+            (void **)&renderer->device2);
+        if (FAILED(res)) {
+            D3D12_INTERNAL_DestroyRenderer(renderer);
+            CHECK_D3D12_ERROR_AND_RETURN("Could not query ID3D12Device2", NULL);
+        }
+
+        indirectArgumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DISPATCH_MESH;
+        commandSignatureDesc.ByteStride = sizeof(SDL_GPUIndirectDispatchCommand);
+        commandSignatureDesc.pArgumentDescs = &indirectArgumentDesc;
+
+        res = ID3D12Device_CreateCommandSignature(
+            renderer->device,
+            &commandSignatureDesc,
+            NULL,
+            D3D_GUID(D3D_IID_ID3D12CommandSignature),
+            (void **)&renderer->indirectDispatchMeshCommandSignature);
+        if (FAILED(res)) {
+            D3D12_INTERNAL_DestroyRenderer(renderer);
+            CHECK_D3D12_ERROR_AND_RETURN("Could not create indirect mesh dispatch command signature", NULL);
+        }
+    }
+
     // Initialize pools
 
     renderer->submittedCommandBufferCapacity = 4;
@@ -9229,6 +10697,16 @@ static SDL_GPUDevice *D3D12_CreateDevice(bool debugMode, bool preferLowPower, SD
     }
 
     ASSIGN_DRIVER(D3D12)
+    ASSIGN_QUERY_DRIVER(D3D12)
+    ASSIGN_INDIRECT_COUNT_DRIVER(D3D12)
+    if (renderer->device2) {
+        ASSIGN_MESH_SHADER_DRIVER(D3D12)
+    }
+#if !(defined(SDL_PLATFORM_XBOXONE) || defined(SDL_PLATFORM_XBOXSERIES))
+    if (renderer->tiledResourcesTier >= D3D12_TILED_RESOURCES_TIER_1) {
+        ASSIGN_SPARSE_DRIVER(D3D12)
+    }
+#endif
     result->driverData = (SDL_GPURenderer *)renderer;
     result->shader_formats = shaderFormats;
     result->debug_mode = debugMode;
@@ -32,7 +32,7 @@
 
 #define METAL_FIRST_VERTEX_BUFFER_SLOT 14
 #define WINDOW_PROPERTY_DATA           "SDL_GPUMetalWindowPropertyData"
-#define SDL_GPU_SHADERSTAGE_COMPUTE    2
+#define SDL_GPU_SHADERSTAGE_COMPUTE    4 // past the task and mesh stages
 
 #define TRACK_RESOURCE(resource, type, array, count, capacity)   \
     do {                                                         \
@@ -423,9 +423,26 @@ static MTLDepthClipMode SDLToMetal_DepthClipMode(
 
 // Structs
 
+typedef struct MetalSparseResidency
+{
+    Uint32 width;
+    Uint32 height;
+    Uint32 depth;
+    Uint32 layerCount;
+    MTLSize tileSize;
+    Uint32 tiledLevelCount;
+    Uint32 *levelTileOffsets; // indexed by (layer * tiledLevelCount) + level
+    Uint8 *residentTiles;
+    Uint32 residentTileCount;
+    Uint32 maxTiles;
+    SDL_Mutex *lock;
+} MetalSparseResidency;
+
 typedef struct MetalTexture
 {
     id<MTLTexture> handle;
+    id<MTLHeap> sparseHeap;
+    MetalSparseResidency *sparse; // NULL unless the texture is sparse
     SDL_AtomicInt referenceCount;
 } MetalTexture;
 
@@ -885,7 +902,15 @@ static void METAL_INTERNAL_DestroyTextureContainer(
     MetalTextureContainer *container)
 {
     for (Uint32 i = 0; i < container->textureCount; i += 1) {
+        MetalSparseResidency *sparse = container->textures[i]->sparse;
+        if (sparse != NULL) {
+            SDL_DestroyMutex(sparse->lock);
+            SDL_free(sparse->levelTileOffsets);
+            SDL_free(sparse->residentTiles);
+            SDL_free(sparse);
+        }
         container->textures[i]->handle = nil;
+        container->textures[i]->sparseHeap = nil;
         SDL_free(container->textures[i]);
     }
     SDL_DestroyProperties(container->header.info.props);
@@ -1386,6 +1411,154 @@ static SDL_GPUShader *METAL_CreateShader(
     }
 }
 
+// Sparse residency
+
+static void METAL_INTERNAL_GetSparseLevelTiles(
+    MetalSparseResidency *sparse,
+    Uint32 level,
+    Uint32 *tilesX,
+    Uint32 *tilesY,
+    Uint32 *tilesZ)
+{
+    Uint32 levelWidth = SDL_max(sparse->width >> level, 1);
+    Uint32 levelHeight = SDL_max(sparse->height >> level, 1);
+    Uint32 levelDepth = SDL_max(sparse->depth >> level, 1);
+
+    *tilesX = (levelWidth + (Uint32)sparse->tileSize.width - 1) / (Uint32)sparse->tileSize.width;
+    *tilesY = (levelHeight + (Uint32)sparse->tileSize.height - 1) / (Uint32)sparse->tileSize.height;
+    *tilesZ = (levelDepth + (Uint32)sparse->tileSize.depth - 1) / (Uint32)sparse->tileSize.depth;
+}
+
+// This function assumes that it's called from within an autorelease pool
+static bool METAL_INTERNAL_UpdateSparseMappings(
+    MetalRenderer *renderer,
+    id<MTLTexture> texture,
+    const MTLRegion *regions,
+    Uint32 regionCount,
+    Uint32 level,
+    Uint32 slice,
+    bool map)
+{
+    if (@available(macOS 11.0, iOS 13.0, tvOS 16.0, *)) {
+        id<MTLCommandBuffer> commandBuffer = [renderer->queue commandBuffer];
+        id<MTLResourceStateCommandEncoder> encoder = [commandBuffer resourceStateCommandEncoder];
+
+        for (Uint32 i = 0; i < regionCount; i += 1) {
+            [encoder updateTextureMapping:texture
+                                     mode:map ? MTLSparseTextureMappingModeMap : MTLSparseTextureMappingModeUnmap
+                                   region:regions[i]
+                                 mipLevel:level
+                                    slice:slice];
+        }
+        [encoder endEncoding];
+
+        // Mapping changes are made synchronously, like the other backends
+        [commandBuffer commit];
+        [commandBuffer waitUntilCompleted];
+
+        if (commandBuffer.status == MTLCommandBufferStatusError) {
+            SET_STRING_ERROR_AND_RETURN("Failed to update sparse texture mappings", false);
+        }
+        return true;
+    } else {
+        SET_STRING_ERROR_AND_RETURN("Sparse textures are not supported", false);
+    }
+}
+
+// This function assumes that it's called from within an autorelease pool
+static MetalTexture *METAL_INTERNAL_CreateSparseTexture(
+    MetalRenderer *renderer,
+    const SDL_GPUTextureCreateInfo *createinfo,
+    MTLTextureDescriptor *textureDescriptor)
+{
+    if (@available(macOS 11.0, iOS 13.0, tvOS 16.0, *)) {
+        MTLHeapDescriptor *heapDescriptor = [MTLHeapDescriptor new];
+        MetalSparseResidency *sparse;
+        MetalTexture *metalTexture;
+        id<MTLHeap> heap;
+        id<MTLTexture> texture;
+        Uint32 tileCount = 0;
+        Uint32 tilesX, tilesY, tilesZ;
+        MTLRegion tailRegion = MTLRegionMake3D(0, 0, 0, 1, 1, 1);
+
+        sparse = SDL_calloc(1, sizeof(MetalSparseResidency));
+        sparse->width = createinfo->width;
+        sparse->height = createinfo->height;
+        sparse->depth = (Uint32)textureDescriptor.depth;
+        sparse->layerCount = (Uint32)textureDescriptor.arrayLength;
+        sparse->tileSize = [renderer->device sparseTileSizeWithTextureType:textureDescriptor.textureType
+                                                               pixelFormat:textureDescriptor.pixelFormat
+                                                               sampleCount:textureDescriptor.sampleCount];
+
+        // The tail isn't known until the texture exists, so size the default for every level
+        sparse->tiledLevelCount = createinfo->num_levels;
+        for (Uint32 level = 0; level < createinfo->num_levels; level += 1) {
+            METAL_INTERNAL_GetSparseLevelTiles(sparse, level, &tilesX, &tilesY, &tilesZ);
+            tileCount += tilesX * tilesY * tilesZ;
+        }
+        tileCount *= sparse->layerCount;
+        sparse->maxTiles = (Uint32)SDL_GetNumberProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_MAX_TILES_NUMBER, tileCount);
+
+        // Reserve one extra tile per slice for the mip tail
+        heapDescriptor.type = MTLHeapTypeSparse;
+        heapDescriptor.storageMode = MTLStorageModePrivate;
+        heapDescriptor.size = (sparse->maxTiles + sparse->layerCount) * renderer->device.sparseTileSizeInBytes;
+
+        heap = [renderer->device newHeapWithDescriptor:heapDescriptor];
+        if (heap == nil) {
+            SDL_free(sparse);
+            SET_STRING_ERROR_AND_RETURN("Failed to create sparse MTLHeap", NULL);
+        }
+
+        texture = [heap newTextureWithDescriptor:textureDescriptor];
+        if (texture == nil) {
+            SDL_free(sparse);
+            SET_STRING_ERROR_AND_RETURN("Failed to create sparse MTLTexture", NULL);
+        }
+
+        // Build the per-level tile table for the levels above the tail
+        sparse->tiledLevelCount = SDL_min((Uint32)texture.firstMipmapInTail, createinfo->num_levels);
+        sparse->levelTileOffsets = SDL_calloc(SDL_max(sparse->layerCount * sparse->tiledLevelCount, 1), sizeof(Uint32));
+        tileCount = 0;
+        for (Uint32 layer = 0; layer < sparse->layerCount; layer += 1) {
+            for (Uint32 level = 0; level < sparse->tiledLevelCount; level += 1) {
+                sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + level] = tileCount;
+                METAL_INTERNAL_GetSparseLevelTiles(sparse, level, &tilesX, &tilesY, &tilesZ);
+                tileCount += tilesX * tilesY * tilesZ;
+            }
+        }
+        sparse->residentTiles = SDL_calloc(SDL_max(tileCount, 1), sizeof(Uint8));
+        sparse->lock = SDL_CreateMutex();
+
+        // The mip tail is always resident
+        if (sparse->tiledLevelCount < createinfo->num_levels) {
+            for (Uint32 layer = 0; layer < sparse->layerCount; layer += 1) {
+                if (!METAL_INTERNAL_UpdateSparseMappings(renderer, texture, &tailRegion, 1, sparse->tiledLevelCount, layer, true)) {
+                    SDL_DestroyMutex(sparse->lock);
+                    SDL_free(sparse->levelTileOffsets);
+                    SDL_free(sparse->residentTiles);
+                    SDL_free(sparse);
+                    return NULL;
+                }
+            }
+        }
+
+        metalTexture = (MetalTexture *)SDL_calloc(1, sizeof(MetalTexture));
+        metalTexture->handle = texture;
+        metalTexture->sparseHeap = heap;
+        metalTexture->sparse = sparse;
+        SDL_SetAtomicInt(&metalTexture->referenceCount, 0);
+
+        if (renderer->debugMode && SDL_HasProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_NAME_STRING)) {
+            metalTexture->handle.label = @(SDL_GetStringProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_NAME_STRING, NULL));
+        }
+
+        return metalTexture;
+    } else {
+        SET_STRING_ERROR_AND_RETURN("Sparse textures are not supported", NULL);
+    }
+}
+
 // This function assumes that it's called from within an autorelease pool
 static MetalTexture *METAL_INTERNAL_CreateTexture(
     MetalRenderer *renderer,
@@ -1420,6 +1593,15 @@ static MetalTexture *METAL_INTERNAL_CreateTexture(
             : 1;
     textureDescriptor.storageMode = MTLStorageModePrivate;
 
+    // Apple GPUs can keep transient attachments in tile memory only
+    if (createinfo->usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+        if (@available(macOS 11.0, iOS 13.0, tvOS 13.0, *)) {
+            if ([renderer->device supportsFamily:MTLGPUFamilyApple1]) {
+                textureDescriptor.storageMode = MTLStorageModeMemoryless;
+            }
+        }
+    }
+
     textureDescriptor.usage = 0;
     if (createinfo->usage & (SDL_GPU_TEXTUREUSAGE_COLOR_TARGET |
                              SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET)) {
@@ -1435,6 +1617,10 @@ static MetalTexture *METAL_INTERNAL_CreateTexture(
         textureDescriptor.usage |= MTLTextureUsageShaderWrite;
     }
 
+    if (SDL_GetBooleanProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false)) {
+        return METAL_INTERNAL_CreateSparseTexture(renderer, createinfo, textureDescriptor);
+    }
+
     texture = [renderer->device newTextureWithDescriptor:textureDescriptor];
     if (texture == NULL) {
         SDL_LogError(SDL_LOG_CATEGORY_GPU, "Failed to create MTLTexture!");
@@ -1452,6 +1638,137 @@ static MetalTexture *METAL_INTERNAL_CreateTexture(
     return metalTexture;
 }
 
+static bool METAL_GetSparseTextureInfo(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTexture *texture,
+    Uint32 *tileWidth,
+    Uint32 *tileHeight,
+    Uint32 *tileDepth,
+    Uint32 *numTiledLevels)
+{
+    MetalSparseResidency *sparse = ((MetalTextureContainer *)texture)->activeTexture->sparse;
+    (void)driverData;
+
+    *tileWidth = (Uint32)sparse->tileSize.width;
+    *tileHeight = (Uint32)sparse->tileSize.height;
+    *tileDepth = (Uint32)sparse->tileSize.depth;
+    *numTiledLevels = sparse->tiledLevelCount;
+    return true;
+}
+
+static bool METAL_CommitTextureTiles(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureRegion *region,
+    bool commit)
+{
+    @autoreleasepool {
+        MetalRenderer *renderer = (MetalRenderer *)driverData;
+        MetalTexture *texture = ((MetalTextureContainer *)region->texture)->activeTexture;
+        MetalSparseResidency *sparse = texture->sparse;
+        MTLRegion *runs;
+        Uint32 runCount = 0;
+        Uint32 changeCount = 0;
+        Uint32 tilesX, tilesY, tilesZ;
+        Uint32 firstX, firstY, firstZ, lastX, lastY, lastZ;
+        Uint32 layer = (sparse->depth > 1) ? 0 : region->layer;
+        Uint8 *levelTiles;
+        bool result;
+
+        // The mip tail is always resident
+        if (region->mip_level >= sparse->tiledLevelCount) {
+            return true;
+        }
+
+        // Every tile the region touches is affected
+        METAL_INTERNAL_GetSparseLevelTiles(sparse, region->mip_level, &tilesX, &tilesY, &tilesZ);
+        firstX = region->x / (Uint32)sparse->tileSize.width;
+        firstY = region->y / (Uint32)sparse->tileSize.height;
+        firstZ = region->z / (Uint32)sparse->tileSize.depth;
+        lastX = SDL_min((region->x + region->w + (Uint32)sparse->tileSize.width - 1) / (Uint32)sparse->tileSize.width, tilesX);
+        lastY = SDL_min((region->y + region->h + (Uint32)sparse->tileSize.height - 1) / (Uint32)sparse->tileSize.height, tilesY);
+        lastZ = SDL_min((region->z + region->d + (Uint32)sparse->tileSize.depth - 1) / (Uint32)sparse->tileSize.depth, tilesZ);
+
+        if (firstX >= lastX || firstY >= lastY || firstZ >= lastZ) {
+            return true;
+        }
+
+        levelTiles = &sparse->residentTiles[sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + region->mip_level]];
+
+        SDL_LockMutex(sparse->lock);
+
+        // Count the tiles that change first, since the heap can't grow
+        for (Uint32 z = firstZ; z < lastZ; z += 1) {
+            for (Uint32 y = firstY; y < lastY; y += 1) {
+                for (Uint32 x = firstX; x < lastX; x += 1) {
+                    if (levelTiles[(((z * tilesY) + y) * tilesX) + x] != commit) {
+                        changeCount += 1;
+                    }
+                }
+            }
+        }
+
+        if (changeCount == 0) {
+            SDL_UnlockMutex(sparse->lock);
+            return true;
+        }
+
+        if (commit && sparse->residentTileCount + changeCount > sparse->maxTiles) {
+            SDL_UnlockMutex(sparse->lock);
+            SET_STRING_ERROR_AND_RETURN("Sparse texture heap is full, raise SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_MAX_TILES_NUMBER", false);
+        }
+
+        // Merge each row of changing tiles into runs
+        runs = SDL_malloc(changeCount * sizeof(MTLRegion));
+        for (Uint32 z = firstZ; z < lastZ; z += 1) {
+            for (Uint32 y = firstY; y < lastY; y += 1) {
+                Uint8 *row = &levelTiles[((z * tilesY) + y) * tilesX];
+                Uint32 x = firstX;
+                while (x < lastX) {
+                    Uint32 runStart;
+                    if (row[x] == commit) {
+                        x += 1;
+                        continue;
+                    }
+                    runStart = x;
+                    while (x < lastX && row[x] != commit) {
+                        row[x] = commit;
+                        x += 1;
+                    }
+                    runs[runCount] = MTLRegionMake3D(runStart, y, z, x - runStart, 1, 1);
+                    runCount += 1;
+                }
+            }
+        }
+
+        result = METAL_INTERNAL_UpdateSparseMappings(
+            renderer,
+            texture->handle,
+            runs,
+            runCount,
+            region->mip_level,
+            layer,
+            commit);
+
+        if (result) {
+            if (commit) {
+                sparse->residentTileCount += changeCount;
+            } else {
+                sparse->residentTileCount -= changeCount;
+            }
+        } else {
+            // Roll the table back so it matches what the GPU has
+            for (Uint32 i = 0; i < runCount; i += 1) {
+                Uint8 *row = &levelTiles[((runs[i].origin.z * tilesY) + runs[i].origin.y) * tilesX];
+                SDL_memset(&row[runs[i].origin.x], !commit, runs[i].size.width);
+            }
+        }
+
+        SDL_UnlockMutex(sparse->lock);
+        SDL_free(runs);
+        return result;
+    }
+}
+
 static bool METAL_SupportsSampleCount(
     SDL_GPURenderer *driverData,
     SDL_GPUTextureFormat format,
@@ -1464,6 +1781,26 @@ static bool METAL_SupportsSampleCount(
     }
 }
 
+static void *METAL_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    (void)driverData;
+    (void)size;
+    SDL_Unsupported();
+    return NULL;
+}
+
+static SDL_GPUMemoryHeapStats *METAL_GetMemoryHeapStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    (void)driverData;
+    (void)count;
+    SDL_Unsupported();
+    return NULL;
+}
+
 static SDL_GPUTexture *METAL_CreateTexture(
     SDL_GPURenderer *driverData,
     const SDL_GPUTextureCreateInfo *createinfo)
@@ -1482,7 +1819,7 @@ static SDL_GPUTexture *METAL_CreateTexture(
         }
 
         container = SDL_calloc(1, sizeof(MetalTextureContainer));
-        container->canBeCycled = 1;
+        container->canBeCycled = texture->sparse == NULL;
 
         // Copy properties so we don't lose information when the client destroys them
         container->header.info = *createinfo;
@@ -2171,7 +2508,7 @@ static void METAL_INTERNAL_ReturnUniformBufferToPool(
     uniformBuffer->drawOffset = 0;
 }
 
-static void METAL_SetViewport(
+SDL_GPU_DIRECT void METAL_SetViewport(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUViewport *viewport)
 {
@@ -2190,7 +2527,7 @@ static void METAL_SetViewport(
     }
 }
 
-static void METAL_SetScissor(
+SDL_GPU_DIRECT void METAL_SetScissor(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_Rect *scissor)
 {
@@ -2207,7 +2544,7 @@ static void METAL_SetScissor(
     }
 }
 
-static void METAL_SetBlendConstants(
+SDL_GPU_DIRECT void METAL_SetBlendConstants(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_FColor blendConstants)
 {
@@ -2220,7 +2557,7 @@ static void METAL_SetBlendConstants(
     }
 }
 
-static void METAL_SetStencilReference(
+SDL_GPU_DIRECT void METAL_SetStencilReference(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint8 reference)
 {
@@ -2367,7 +2704,7 @@ static void METAL_BeginRenderPass(
     }
 }
 
-static void METAL_BindGraphicsPipeline(
+SDL_GPU_DIRECT void METAL_BindGraphicsPipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUGraphicsPipeline *graphicsPipeline)
 {
@@ -2418,7 +2755,7 @@ static void METAL_BindGraphicsPipeline(
     }
 }
 
-static void METAL_BindVertexBuffers(
+SDL_GPU_DIRECT void METAL_BindVertexBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUBufferBinding *bindings,
@@ -2440,7 +2777,7 @@ static void METAL_BindVertexBuffers(
         SDL_max(metalCommandBuffer->vertexBufferCount, firstSlot + numBindings);
 }
 
-static void METAL_BindIndexBuffer(
+SDL_GPU_DIRECT void METAL_BindIndexBuffer(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUBufferBinding *binding,
     SDL_GPUIndexElementSize indexElementSize)
@@ -2453,7 +2790,7 @@ static void METAL_BindIndexBuffer(
     METAL_INTERNAL_TrackBuffer(metalCommandBuffer, metalCommandBuffer->indexBuffer);
 }
 
-static void METAL_BindVertexSamplers(
+SDL_GPU_DIRECT void METAL_BindVertexSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -2485,7 +2822,7 @@ static void METAL_BindVertexSamplers(
     }
 }
 
-static void METAL_BindVertexStorageTextures(
+SDL_GPU_DIRECT void METAL_BindVertexStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -2510,7 +2847,7 @@ static void METAL_BindVertexStorageTextures(
     }
 }
 
-static void METAL_BindVertexStorageBuffers(
+SDL_GPU_DIRECT void METAL_BindVertexStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -2535,7 +2872,7 @@ static void METAL_BindVertexStorageBuffers(
     }
 }
 
-static void METAL_BindFragmentSamplers(
+SDL_GPU_DIRECT void METAL_BindFragmentSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -2567,7 +2904,7 @@ static void METAL_BindFragmentSamplers(
     }
 }
 
-static void METAL_BindFragmentStorageTextures(
+SDL_GPU_DIRECT void METAL_BindFragmentStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -2592,7 +2929,7 @@ static void METAL_BindFragmentStorageTextures(
     }
 }
 
-static void METAL_BindFragmentStorageBuffers(
+SDL_GPU_DIRECT void METAL_BindFragmentStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -2786,7 +3123,7 @@ static void METAL_INTERNAL_BindComputeResources(
     }
 }
 
-static void METAL_DrawIndexedPrimitives(
+SDL_GPU_DIRECT void METAL_DrawIndexedPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numIndices,
     Uint32 numInstances,
@@ -2813,7 +3150,7 @@ static void METAL_DrawIndexedPrimitives(
     }
 }
 
-static void METAL_DrawPrimitives(
+SDL_GPU_DIRECT void METAL_DrawPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numVertices,
     Uint32 numInstances,
@@ -2996,7 +3333,7 @@ static void METAL_INTERNAL_PushUniformData(
     }
 }
 
-static void METAL_PushVertexUniformData(
+SDL_GPU_DIRECT void METAL_PushVertexUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -3012,7 +3349,7 @@ static void METAL_PushVertexUniformData(
     }
 }
 
-static void METAL_PushFragmentUniformData(
+SDL_GPU_DIRECT void METAL_PushFragmentUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -3032,14 +3369,16 @@ static void METAL_PushFragmentUniformData(
 
 static void METAL_Blit(
     SDL_GPUCommandBuffer *commandBuffer,
-    const SDL_GPUBlitInfo *info)
+    const SDL_GPUBlitInfo *infos,
+    Uint32 numInfos)
 {
     MetalCommandBuffer *metalCommandBuffer = (MetalCommandBuffer *)commandBuffer;
     MetalRenderer *renderer = (MetalRenderer *)metalCommandBuffer->renderer;
 
     SDL_GPU_BlitCommon(
         commandBuffer,
-        info,
+        infos,
+        numInfos,
         renderer->blitLinearSampler,
         renderer->blitNearestSampler,
         renderer->blitVertexShader,
@@ -3107,7 +3446,7 @@ static void METAL_BeginComputePass(
     }
 }
 
-static void METAL_BindComputePipeline(
+SDL_GPU_DIRECT void METAL_BindComputePipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUComputePipeline *computePipeline)
 {
@@ -3151,7 +3490,7 @@ static void METAL_BindComputePipeline(
     }
 }
 
-static void METAL_BindComputeSamplers(
+SDL_GPU_DIRECT void METAL_BindComputeSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -3183,7 +3522,7 @@ static void METAL_BindComputeSamplers(
     }
 }
 
-static void METAL_BindComputeStorageTextures(
+SDL_GPU_DIRECT void METAL_BindComputeStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -3208,7 +3547,7 @@ static void METAL_BindComputeStorageTextures(
     }
 }
 
-static void METAL_BindComputeStorageBuffers(
+SDL_GPU_DIRECT void METAL_BindComputeStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -3233,7 +3572,7 @@ static void METAL_BindComputeStorageBuffers(
     }
 }
 
-static void METAL_PushComputeUniformData(
+SDL_GPU_DIRECT void METAL_PushComputeUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -3249,7 +3588,7 @@ static void METAL_PushComputeUniformData(
     }
 }
 
-static void METAL_DispatchCompute(
+SDL_GPU_DIRECT void METAL_DispatchCompute(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 groupcountX,
     Uint32 groupcountY,
@@ -3355,6 +3694,14 @@ static void METAL_ReleaseFence(
     }
 }
 
+static void METAL_RetainFence(
+    SDL_GPURenderer *driverData,
+    SDL_GPUFence *fence)
+{
+    (void)driverData;
+    SDL_AtomicIncRef(&((MetalFence *)fence)->referenceCount);
+}
+
 // Cleanup
 
 static void METAL_INTERNAL_CleanCommandBuffer(
@@ -4268,10 +4615,34 @@ static bool METAL_SupportsTextureFormat(
     }
 }
 
+static bool METAL_SupportsSparseTexture(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTextureFormat format,
+    SDL_GPUTextureType type,
+    SDL_GPUTextureUsageFlags usage)
+{
+    (void)driverData;
+    (void)usage;
+
+    // Depth formats can't be sparse on Apple GPUs
+    if (IsDepthFormat(format)) {
+        return false;
+    }
+
+    return type == SDL_GPU_TEXTURETYPE_2D ||
+           type == SDL_GPU_TEXTURETYPE_2D_ARRAY ||
+           type == SDL_GPU_TEXTURETYPE_3D;
+}
+
 // Device Creation
 
-static bool METAL_PrepareDriver(SDL_VideoDevice *this)
+static bool METAL_PrepareDriver(SDL_VideoDevice *this, SDL_PropertiesID props)
 {
+    // Mesh shading is not implemented for Metal
+    if (SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false)) {
+        return false;
+    }
+
     if (@available(macOS 10.14, iOS 13.0, tvOS 13.0, *)) {
         return (this->Metal_CreateView != NULL);
     }
@@ -4559,6 +4930,11 @@ static SDL_GPUDevice *METAL_CreateDevice(bool debugMode, bool preferLowPower, SD
 
         SDL_GPUDevice *result = SDL_calloc(1, sizeof(SDL_GPUDevice));
         ASSIGN_DRIVER(METAL)
+        if (@available(macOS 11.0, iOS 13.0, tvOS 16.0, *)) {
+            if ([renderer->device supportsFamily:MTLGPUFamilyApple6]) {
+                ASSIGN_SPARSE_DRIVER(METAL)
+            }
+        }
         result->driverData = (SDL_GPURenderer *)renderer;
         result->shader_formats = SDL_GPU_SHADERFORMAT_MSL | SDL_GPU_SHADERFORMAT_METALLIB;
         renderer->sdlGPUDevice = result;
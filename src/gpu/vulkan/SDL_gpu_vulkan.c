@@ -32,6 +32,8 @@
 #include <SDL3/SDL_vulkan.h>
 
 #include "../SDL_sysgpu.h"
+#include "../../SDL_memoryusage_c.h"
+#include "../../SDL_trace_c.h"
 
 #define VULKAN_INTERNAL_clamp(val, min, max) SDL_max(min, SDL_min(val, max))
 
@@ -60,6 +62,22 @@ typedef struct VulkanExtensions
     Uint8 KHR_portability_subset;
     // Only required for decoding HDR ASTC textures
     Uint8 EXT_texture_compression_astc_hdr;
+    // Needs KHR_get_physical_device_properties2, used to stay within the memory budget
+    Uint8 EXT_memory_budget;
+    // Core since 1.2, needed for draw counts read from a buffer
+    Uint8 KHR_draw_indirect_count;
+    // Only enabled when requested, needs a Vulkan 1.2 instance for SPIR-V 1.4
+    Uint8 EXT_mesh_shader;
+    // Both need KHR_get_physical_device_properties2, used to wait for presents to reach the display
+    Uint8 KHR_present_id;
+    Uint8 KHR_present_wait;
+    // Core since 1.3, begins render passes without render pass or framebuffer objects
+    Uint8 KHR_dynamic_rendering;
+    // Dependencies of KHR_dynamic_rendering on a Vulkan 1.0 instance
+    Uint8 KHR_depth_stencil_resolve;
+    Uint8 KHR_create_renderpass2;
+    Uint8 KHR_multiview;
+    Uint8 KHR_maintenance2;
 } VulkanExtensions;
 
 // Defines
@@ -69,6 +87,9 @@ typedef struct VulkanExtensions
 #define LARGE_ALLOCATION_INCREMENT    67108864 // 64  MiB
 #define MAX_UBO_SECTION_SIZE          4096     // 4   KiB
 #define DESCRIPTOR_POOL_SIZE          128
+#define DESCRIPTOR_SIZE_ESTIMATE      64       // bytes, for memory accounting; Vulkan doesn't report pool sizes
+#define SPARSE_TILES_PER_PAGE         16       // tiles per sparse texture memory page
+#define SPARSE_TILE_NOT_RESIDENT      0xFFFFFFFF
 #define WINDOW_PROPERTY_DATA          "SDL_GPUVulkanWindowPropertyData"
 
 #define IDENTITY_SWIZZLE               \
@@ -127,7 +148,8 @@ static const Uint8 DEVICE_PRIORITY_LOWPOWER[] = {
 static VkPresentModeKHR SDLToVK_PresentMode[] = {
     VK_PRESENT_MODE_FIFO_KHR,
     VK_PRESENT_MODE_IMMEDIATE_KHR,
-    VK_PRESENT_MODE_MAILBOX_KHR
+    VK_PRESENT_MODE_MAILBOX_KHR,
+    VK_PRESENT_MODE_FIFO_RELAXED_KHR
 };
 
 static VkFormat SDLToVK_TextureFormat[] = {
@@ -485,8 +507,18 @@ typedef struct VulkanFenceHandle
 {
     VkFence fence;
     SDL_AtomicInt referenceCount;
+
+    // Signaled alongside the fence so another queue can wait on it
+    VkSemaphore semaphore;
+    bool semaphoreSignaled;
 } VulkanFenceHandle;
 
+typedef struct VulkanQueryPool
+{
+    QueryPoolCommonHeader header;
+    VkQueryPool queryPool;
+} VulkanQueryPool;
+
 // Memory Allocation
 
 typedef struct VulkanMemoryFreeRegion
@@ -629,6 +661,32 @@ typedef struct VulkanTextureSubresource
     VkImageView depthStencilView;
 } VulkanTextureSubresource;
 
+/* Sparse textures don't use the memory allocator. Each texture binds its
+ * tiles from its own pages of memory, and keeps its mip tail bound for life.
+ */
+typedef struct VulkanSparseResidency
+{
+    Uint32 width;
+    Uint32 height;
+    Uint32 depth;
+    Uint32 layerCount;
+    VkExtent3D tileExtent;
+    Uint32 tiledLevelCount; // levels from here on are in the mip tail
+
+    Uint32 *levelTileOffsets; // first tile of each layer and level in tileSlots
+    Uint32 *tileSlots;        // page slot of each tile, or SPARSE_TILE_NOT_RESIDENT
+
+    Uint32 memoryTypeIndex;
+    VkDeviceSize tileSize;
+    VkDeviceMemory *pages;
+    Uint32 pageCount;
+    Uint32 *freeSlots;
+    Uint32 freeSlotCount;
+
+    VkDeviceMemory mipTailMemory;
+    SDL_Mutex *lock;
+} VulkanSparseResidency;
+
 struct VulkanTexture
 {
     VulkanTextureContainer *container;
@@ -648,6 +706,8 @@ struct VulkanTexture
     Uint32 subresourceCount;
     VulkanTextureSubresource *subresources;
 
+    VulkanSparseResidency *sparse; // NULL unless the texture was created sparse
+
     bool markedForDestroy; // so that defrag doesn't double-free
     SDL_AtomicInt referenceCount;
 };
@@ -736,6 +796,9 @@ typedef struct WindowData
     SDL_GPUFence *inFlightFences[MAX_FRAMES_IN_FLIGHT];
 
     Uint32 frameCounter;
+
+    // The VK_KHR_present_id of the last present, reset with the swapchain
+    Uint64 presentID;
 } WindowData;
 
 typedef struct SwapchainSupportDetails
@@ -760,6 +823,8 @@ struct VulkanUniformBuffer
     Uint32 writeOffset;
 };
 
+#define DESCRIPTOR_SET_REUSE_CACHE_SIZE 64
+
 typedef struct VulkanDescriptorInfo
 {
     VkDescriptorType descriptorType;
@@ -778,6 +843,25 @@ typedef struct DescriptorSetPool
     Uint32 descriptorSetIndex;
 } DescriptorSetPool;
 
+// The resources written into a read-only resource descriptor set
+typedef struct DescriptorSetReuseKey
+{
+    Uint32 layoutID;
+    Uint32 samplerCount;
+    Uint32 storageTextureCount;
+    Uint32 storageBufferCount;
+    VkSampler samplers[MAX_TEXTURE_SAMPLERS_PER_STAGE];
+    VkImageView samplerTextureViews[MAX_TEXTURE_SAMPLERS_PER_STAGE];
+    VkImageView storageTextureViews[MAX_STORAGE_TEXTURES_PER_STAGE];
+    VkBuffer storageBuffers[MAX_STORAGE_BUFFERS_PER_STAGE];
+} DescriptorSetReuseKey;
+
+typedef struct DescriptorSetReuseEntry
+{
+    DescriptorSetReuseKey key;
+    VkDescriptorSet descriptorSet;
+} DescriptorSetReuseEntry;
+
 // A command buffer acquires a cache at command buffer acquisition time
 typedef struct DescriptorSetCache
 {
@@ -785,6 +869,13 @@ typedef struct DescriptorSetCache
     // There's only a certain number of maximum layouts possible since we de-duplicate them.
     DescriptorSetPool *pools;
     Uint32 poolCount;
+    Uint64 descriptorBytes;
+
+    /* Resource descriptor sets already written by this command buffer, so that
+     * switching back and forth between materials doesn't write the same
+     * descriptors over and over again. Direct-mapped by the key's hash.
+     */
+    DescriptorSetReuseEntry reuseEntries[DESCRIPTOR_SET_REUSE_CACHE_SIZE];
 } DescriptorSetCache;
 
 typedef struct DescriptorSetLayoutHashTableKey
@@ -821,6 +912,7 @@ typedef struct DescriptorSetLayout
 
 typedef struct GraphicsPipelineResourceLayoutHashTableKey
 {
+    VkShaderStageFlags vertexStages;
     Uint32 vertexSamplerCount;
     Uint32 vertexStorageTextureCount;
     Uint32 vertexStorageBufferCount;
@@ -865,7 +957,8 @@ typedef struct VulkanGraphicsPipeline
 
     VulkanGraphicsPipelineResourceLayout *resourceLayout;
 
-    VulkanShader *vertexShader;
+    VulkanShader *vertexShader; // The mesh shader, in mesh pipelines
+    VulkanShader *taskShader;   // Optional, mesh pipelines only
     VulkanShader *fragmentShader;
 
     SDL_AtomicInt referenceCount;
@@ -930,6 +1023,7 @@ typedef struct RenderPassDepthStencilTargetDescription
 typedef struct CommandPoolHashTableKey
 {
     SDL_ThreadID threadID;
+    SDL_GPUQueueType queueType;
 } CommandPoolHashTableKey;
 
 typedef struct RenderPassHashTableKey
@@ -986,9 +1080,14 @@ typedef struct VulkanCommandBuffer
     Uint32 presentDataCapacity;
 
     VkSemaphore *waitSemaphores;
+    VkPipelineStageFlags *waitSemaphoreStages;
     Uint32 waitSemaphoreCount;
     Uint32 waitSemaphoreCapacity;
 
+    VulkanFenceHandle **waitFences;
+    Uint32 waitFenceCount;
+    Uint32 waitFenceCapacity;
+
     VkSemaphore *signalSemaphores;
     Uint32 signalSemaphoreCount;
     Uint32 signalSemaphoreCapacity;
@@ -1117,9 +1216,26 @@ struct VulkanCommandPool
     SDL_ThreadID threadID;
     VkCommandPool commandPool;
 
+    VkQueue queue;
+    VkPipelineStageFlags supportedStages; // barriers are restricted to these
+
     VulkanCommandBuffer **inactiveCommandBuffers;
     Uint32 inactiveCommandBufferCapacity;
     Uint32 inactiveCommandBufferCount;
+
+    /* Uniform buffers and descriptor set caches released by this thread's
+     * command buffers, so that recording threads don't contend with each other.
+     * The lock is only taken by the owning thread and by command buffer cleanup.
+     */
+    SDL_Mutex *lock;
+
+    VulkanUniformBuffer **inactiveUniformBuffers;
+    Uint32 inactiveUniformBufferCapacity;
+    Uint32 inactiveUniformBufferCount;
+
+    DescriptorSetCache **inactiveDescriptorSetCaches;
+    Uint32 inactiveDescriptorSetCacheCapacity;
+    Uint32 inactiveDescriptorSetCacheCount;
 };
 
 // Context
@@ -1138,6 +1254,8 @@ struct VulkanRenderer
 
     bool debugMode;
     bool preferLowPower;
+    bool allowDedicatedQueues;
+    bool requireMeshShaders;
     Uint32 allowedFramesInFlight;
 
     VulkanExtensions supports;
@@ -1146,6 +1264,14 @@ struct VulkanRenderer
     bool supportsPhysicalDeviceProperties2;
     bool supportsFillModeNonSolid;
     bool supportsMultiDrawIndirect;
+    bool supportsPipelineStatisticsQuery;
+    bool supportsSparseResidency2D;
+    bool supportsSparseResidency3D;
+    VkFence sparseBindFence;
+    Uint32 timestampValidBits;
+
+    // Every shader stage a render pass can read resources from
+    VkPipelineStageFlags graphicsShaderStages;
 
     VulkanMemoryAllocator *memoryAllocator;
     VkPhysicalDeviceMemoryProperties memoryProperties;
@@ -1158,6 +1284,16 @@ struct VulkanRenderer
     Uint32 queueFamilyIndex;
     VkQueue unifiedQueue;
 
+    // Equal to queueFamilyIndex/unifiedQueue when there is no dedicated queue
+    Uint32 computeQueueFamilyIndex;
+    VkQueue computeQueue;
+    Uint32 transferQueueFamilyIndex;
+    VkQueue transferQueue;
+
+    // Resources are shared concurrently when more than one family is used
+    Uint32 uniqueQueueFamilyIndices[3];
+    Uint32 uniqueQueueFamilyCount;
+
     VulkanCommandBuffer **submittedCommandBuffers;
     Uint32 submittedCommandBufferCount;
     Uint32 submittedCommandBufferCapacity;
@@ -1171,6 +1307,8 @@ struct VulkanRenderer
     SDL_HashTable *computePipelineResourceLayoutHashTable;
     SDL_HashTable *descriptorSetLayoutHashTable;
 
+    VkPipelineCache pipelineCache;
+
     VulkanUniformBuffer **uniformBufferPool;
     Uint32 uniformBufferPoolCount;
     Uint32 uniformBufferPoolCapacity;
@@ -1226,6 +1364,7 @@ struct VulkanRenderer
     SDL_Mutex *windowLock;
 
     Uint8 defragInProgress;
+    VkDeviceSize defragBudget; // bytes moved per submission, 0 for one allocation per submission
 
     VulkanMemoryAllocation **allocationsToDefrag;
     Uint32 allocationsToDefragCount;
@@ -1247,6 +1386,7 @@ static bool VULKAN_Wait(SDL_GPURenderer *driverData);
 static bool VULKAN_WaitForFences(SDL_GPURenderer *driverData, bool waitAll, SDL_GPUFence *const *fences, Uint32 numFences);
 static bool VULKAN_Submit(SDL_GPUCommandBuffer *commandBuffer);
 static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(SDL_GPURenderer *driverData);
+static void VULKAN_INTERNAL_DestroyDescriptorSetCache(VulkanRenderer *renderer, DescriptorSetCache *descriptorSetCache);
 
 // Error Handling
 
@@ -1382,6 +1522,12 @@ static void VULKAN_INTERNAL_MarkAllocationsForDefrag(
     for (memoryType = 0; memoryType < VK_MAX_MEMORY_TYPES; memoryType += 1) {
         currentAllocator = &renderer->memoryAllocator->subAllocators[memoryType];
 
+        // Lazily allocated memory only holds transient attachments, which cannot be copied
+        if (memoryType < renderer->memoryProperties.memoryTypeCount &&
+            (renderer->memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+            continue;
+        }
+
         for (allocationIndex = 0; allocationIndex < currentAllocator->allocationCount; allocationIndex += 1) {
             if (currentAllocator->allocations[allocationIndex]->availableForAllocation == 1) {
                 if (currentAllocator->allocations[allocationIndex]->freeRegionCount > 1) {
@@ -1951,12 +2097,73 @@ static Uint8 VULKAN_INTERNAL_BindImageMemory(
     return 1;
 }
 
+/* Reports how much of each memory heap the process may use and is using.
+ * Without VK_EXT_memory_budget the budget is the heap size, and the usage
+ * is only what we have allocated ourselves. The caller must hold allocatorLock.
+ */
+static void VULKAN_INTERNAL_GetMemoryBudget(
+    VulkanRenderer *renderer,
+    VkDeviceSize *heapBudgets,
+    VkDeviceSize *heapUsages)
+{
+    Uint32 i, j;
+
+    if (renderer->supports.EXT_memory_budget) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+        VkPhysicalDeviceMemoryProperties2KHR memoryProperties;
+
+        budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        budgetProperties.pNext = NULL;
+        memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+        memoryProperties.pNext = &budgetProperties;
+
+        renderer->vkGetPhysicalDeviceMemoryProperties2KHR(
+            renderer->physicalDevice,
+            &memoryProperties);
+
+        for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1) {
+            heapBudgets[i] = budgetProperties.heapBudget[i];
+            heapUsages[i] = budgetProperties.heapUsage[i];
+        }
+        return;
+    }
+
+    for (i = 0; i < renderer->memoryProperties.memoryHeapCount; i += 1) {
+        heapBudgets[i] = renderer->memoryProperties.memoryHeaps[i].size;
+        heapUsages[i] = 0;
+    }
+
+    for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1) {
+        VulkanMemorySubAllocator *allocator = &renderer->memoryAllocator->subAllocators[i];
+        Uint32 heapIndex = renderer->memoryProperties.memoryTypes[i].heapIndex;
+
+        for (j = 0; j < allocator->allocationCount; j += 1) {
+            heapUsages[heapIndex] += allocator->allocations[j]->size;
+        }
+    }
+}
+
+static bool VULKAN_INTERNAL_ExceedsMemoryBudget(
+    VulkanRenderer *renderer,
+    Uint32 memoryTypeIndex,
+    VkDeviceSize allocationSize)
+{
+    VkDeviceSize heapBudgets[VK_MAX_MEMORY_HEAPS];
+    VkDeviceSize heapUsages[VK_MAX_MEMORY_HEAPS];
+    Uint32 heapIndex = renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+
+    VULKAN_INTERNAL_GetMemoryBudget(renderer, heapBudgets, heapUsages);
+
+    return heapUsages[heapIndex] + allocationSize > heapBudgets[heapIndex];
+}
+
 static Uint8 VULKAN_INTERNAL_BindResourceMemory(
     VulkanRenderer *renderer,
     Uint32 memoryTypeIndex,
     VkMemoryRequirements *memoryRequirements,
     VkDeviceSize resourceSize, // may be different from requirements size!
     bool dedicated,            // the entire memory allocation should be used for this resource
+    bool respectBudget,        // fail instead of allocating past the heap's budget
     VkBuffer buffer,           // may be VK_NULL_HANDLE
     VkImage image,             // may be VK_NULL_HANDLE
     VulkanMemoryUsedRegion **pMemoryUsedRegion)
@@ -2098,6 +2305,12 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
         }
     }
 
+    // Let the caller try a memory type on another heap before going over budget
+    if (respectBudget && VULKAN_INTERNAL_ExceedsMemoryBudget(renderer, memoryTypeIndex, allocationSize)) {
+        SDL_UnlockMutex(renderer->allocatorLock);
+        return 2;
+    }
+
     allocationResult = VULKAN_INTERNAL_AllocateMemory(
         renderer,
         buffer,
@@ -2176,13 +2389,14 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
 static Uint8 VULKAN_INTERNAL_BindMemoryForImage(
     VulkanRenderer *renderer,
     VkImage image,
+    bool transient,
     VulkanMemoryUsedRegion **usedRegion)
 {
     Uint8 bindResult = 0;
     Uint32 memoryTypeCount = 0;
     Uint32 *memoryTypesToTry = NULL;
     Uint32 selectedMemoryTypeIndex = 0;
-    Uint32 i;
+    Uint32 i, pass;
     VkMemoryPropertyFlags preferredMemoryPropertyFlags;
     VkMemoryRequirements memoryRequirements;
 
@@ -2196,6 +2410,13 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForImage(
      */
     preferredMemoryPropertyFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 
+    /* Transient attachments prefer lazily allocated memory, which tile-based
+     * GPUs only commit when the attachment actually spills out of tile memory.
+     */
+    if (transient) {
+        preferredMemoryPropertyFlags |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    }
+
     memoryTypesToTry = VULKAN_INTERNAL_FindBestImageMemoryTypes(
         renderer,
         image,
@@ -2203,20 +2424,24 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForImage(
         &memoryRequirements,
         &memoryTypeCount);
 
-    for (i = 0; i < memoryTypeCount; i += 1) {
-        bindResult = VULKAN_INTERNAL_BindResourceMemory(
-            renderer,
-            memoryTypesToTry[i],
-            &memoryRequirements,
-            memoryRequirements.size,
-            false,
-            VK_NULL_HANDLE,
-            image,
-            usedRegion);
+    // The first pass keeps within the memory budget, the second takes whatever is left
+    for (pass = 0; pass < 2 && bindResult != 1; pass += 1) {
+        for (i = 0; i < memoryTypeCount; i += 1) {
+            bindResult = VULKAN_INTERNAL_BindResourceMemory(
+                renderer,
+                memoryTypesToTry[i],
+                &memoryRequirements,
+                memoryRequirements.size,
+                false,
+                pass == 0,
+                VK_NULL_HANDLE,
+                image,
+                usedRegion);
 
-        if (bindResult == 1) {
-            selectedMemoryTypeIndex = memoryTypesToTry[i];
-            break;
+            if (bindResult == 1) {
+                selectedMemoryTypeIndex = memoryTypesToTry[i];
+                break;
+            }
         }
     }
 
@@ -2247,7 +2472,7 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
     Uint32 memoryTypeCount = 0;
     Uint32 *memoryTypesToTry = NULL;
     Uint32 selectedMemoryTypeIndex = 0;
-    Uint32 i;
+    Uint32 i, pass;
     VkMemoryPropertyFlags requiredMemoryPropertyFlags = 0;
     VkMemoryPropertyFlags preferredMemoryPropertyFlags = 0;
     VkMemoryPropertyFlags tolerableMemoryPropertyFlags = 0;
@@ -2348,20 +2573,24 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
         &memoryRequirements,
         &memoryTypeCount);
 
-    for (i = 0; i < memoryTypeCount; i += 1) {
-        bindResult = VULKAN_INTERNAL_BindResourceMemory(
-            renderer,
-            memoryTypesToTry[i],
-            &memoryRequirements,
-            size,
-            dedicated,
-            buffer,
-            VK_NULL_HANDLE,
-            usedRegion);
+    // The first pass keeps within the memory budget, the second takes whatever is left
+    for (pass = 0; pass < 2 && bindResult != 1; pass += 1) {
+        for (i = 0; i < memoryTypeCount; i += 1) {
+            bindResult = VULKAN_INTERNAL_BindResourceMemory(
+                renderer,
+                memoryTypesToTry[i],
+                &memoryRequirements,
+                size,
+                dedicated,
+                pass == 0,
+                buffer,
+                VK_NULL_HANDLE,
+                usedRegion);
 
-        if (bindResult == 1) {
-            selectedMemoryTypeIndex = memoryTypesToTry[i];
-            break;
+            if (bindResult == 1) {
+                selectedMemoryTypeIndex = memoryTypesToTry[i];
+                break;
+            }
         }
     }
 
@@ -2396,6 +2625,277 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
     return bindResult;
 }
 
+// Sparse residency
+
+static bool VULKAN_INTERNAL_QueueBindSparse(
+    VulkanRenderer *renderer,
+    const VkBindSparseInfo *bindInfo)
+{
+    VkResult vulkanResult;
+
+    /* Sparse binds aren't ordered against later submissions without a
+     * semaphore, so wait for the bind to finish before returning.
+     */
+    SDL_LockMutex(renderer->submitLock);
+
+    vulkanResult = renderer->vkQueueBindSparse(
+        renderer->unifiedQueue,
+        1,
+        bindInfo,
+        renderer->sparseBindFence);
+
+    if (vulkanResult == VK_SUCCESS) {
+        vulkanResult = renderer->vkWaitForFences(
+            renderer->logicalDevice,
+            1,
+            &renderer->sparseBindFence,
+            VK_TRUE,
+            SDL_MAX_UINT64);
+
+        renderer->vkResetFences(
+            renderer->logicalDevice,
+            1,
+            &renderer->sparseBindFence);
+    }
+
+    SDL_UnlockMutex(renderer->submitLock);
+
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkQueueBindSparse, false);
+
+    return true;
+}
+
+static void VULKAN_INTERNAL_GetSparseLevelTiles(
+    VulkanSparseResidency *sparse,
+    Uint32 level,
+    Uint32 *tilesX,
+    Uint32 *tilesY,
+    Uint32 *tilesZ)
+{
+    *tilesX = (SDL_max(sparse->width >> level, 1) + sparse->tileExtent.width - 1) / sparse->tileExtent.width;
+    *tilesY = (SDL_max(sparse->height >> level, 1) + sparse->tileExtent.height - 1) / sparse->tileExtent.height;
+    *tilesZ = (SDL_max(sparse->depth >> level, 1) + sparse->tileExtent.depth - 1) / sparse->tileExtent.depth;
+}
+
+static bool VULKAN_INTERNAL_AddSparsePage(
+    VulkanRenderer *renderer,
+    VulkanSparseResidency *sparse)
+{
+    VkMemoryAllocateInfo allocateInfo;
+    VkDeviceMemory memory;
+    VkResult vulkanResult;
+
+    allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocateInfo.pNext = NULL;
+    allocateInfo.allocationSize = sparse->tileSize * SPARSE_TILES_PER_PAGE;
+    allocateInfo.memoryTypeIndex = sparse->memoryTypeIndex;
+
+    vulkanResult = renderer->vkAllocateMemory(
+        renderer->logicalDevice,
+        &allocateInfo,
+        NULL,
+        &memory);
+
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkAllocateMemory, false);
+
+    sparse->pages = SDL_realloc(
+        sparse->pages,
+        (sparse->pageCount + 1) * sizeof(VkDeviceMemory));
+    sparse->freeSlots = SDL_realloc(
+        sparse->freeSlots,
+        (sparse->pageCount + 1) * SPARSE_TILES_PER_PAGE * sizeof(Uint32));
+
+    // Push in reverse so that slots are handed out in order
+    for (Uint32 i = 0; i < SPARSE_TILES_PER_PAGE; i += 1) {
+        sparse->freeSlots[sparse->freeSlotCount] = (sparse->pageCount * SPARSE_TILES_PER_PAGE) + (SPARSE_TILES_PER_PAGE - 1 - i);
+        sparse->freeSlotCount += 1;
+    }
+
+    sparse->pages[sparse->pageCount] = memory;
+    sparse->pageCount += 1;
+
+    return true;
+}
+
+static void VULKAN_INTERNAL_DestroySparseResidency(
+    VulkanRenderer *renderer,
+    VulkanSparseResidency *sparse)
+{
+    for (Uint32 i = 0; i < sparse->pageCount; i += 1) {
+        renderer->vkFreeMemory(
+            renderer->logicalDevice,
+            sparse->pages[i],
+            NULL);
+    }
+
+    if (sparse->mipTailMemory != VK_NULL_HANDLE) {
+        renderer->vkFreeMemory(
+            renderer->logicalDevice,
+            sparse->mipTailMemory,
+            NULL);
+    }
+
+    SDL_free(sparse->pages);
+    SDL_free(sparse->freeSlots);
+    SDL_free(sparse->levelTileOffsets);
+    SDL_free(sparse->tileSlots);
+    SDL_DestroyMutex(sparse->lock);
+    SDL_free(sparse);
+}
+
+// Binds the mip tail of a new sparse image and creates its empty tile table
+static bool VULKAN_INTERNAL_InitSparseResidency(
+    VulkanRenderer *renderer,
+    VulkanTexture *texture,
+    const SDL_GPUTextureCreateInfo *createinfo)
+{
+    VulkanSparseResidency *sparse;
+    VkMemoryRequirements memoryRequirements;
+    VkSparseImageMemoryRequirements sparseRequirements[4];
+    Uint32 sparseRequirementCount = SDL_arraysize(sparseRequirements);
+    VkSparseMemoryBind *tailBinds;
+    Uint32 tailBindCount = 0;
+    VkDeviceSize tailSize = 0;
+    Uint32 *memoryTypes;
+    Uint32 memoryTypeCount = 0;
+    Uint32 tileCount = 0;
+    bool foundColor = false;
+    bool result = true;
+    VkResult vulkanResult;
+
+    sparse = SDL_calloc(1, sizeof(VulkanSparseResidency));
+    sparse->width = createinfo->width;
+    sparse->height = createinfo->height;
+    sparse->depth = texture->depth;
+    sparse->layerCount = (createinfo->type == SDL_GPU_TEXTURETYPE_3D) ? 1 : createinfo->layer_count_or_depth;
+    sparse->lock = SDL_CreateMutex();
+    texture->sparse = sparse; // destroying the texture cleans up after a failure
+
+    memoryTypes = VULKAN_INTERNAL_FindBestImageMemoryTypes(
+        renderer,
+        texture->image,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        &memoryRequirements,
+        &memoryTypeCount);
+
+    if (memoryTypeCount == 0) {
+        SDL_free(memoryTypes);
+        SET_STRING_ERROR_AND_RETURN("No memory type is usable for sparse texture tiles!", false);
+    }
+
+    sparse->memoryTypeIndex = memoryTypes[0];
+    sparse->tileSize = memoryRequirements.alignment;
+    SDL_free(memoryTypes);
+
+    renderer->vkGetImageSparseMemoryRequirements(
+        renderer->logicalDevice,
+        texture->image,
+        &sparseRequirementCount,
+        sparseRequirements);
+
+    for (Uint32 i = 0; i < sparseRequirementCount; i += 1) {
+        if (sparseRequirements[i].formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT) {
+            sparse->tileExtent = sparseRequirements[i].formatProperties.imageGranularity;
+            sparse->tiledLevelCount = SDL_min(sparseRequirements[i].imageMipTailFirstLod, createinfo->num_levels);
+            foundColor = true;
+            break;
+        }
+    }
+
+    if (!foundColor) {
+        SET_STRING_ERROR_AND_RETURN("Sparse texture has no color tiles!", false);
+    }
+
+    // The mip tail, along with any metadata, is bound once for the life of the texture
+    tailBinds = SDL_malloc(sparseRequirementCount * sparse->layerCount * sizeof(VkSparseMemoryBind));
+
+    for (Uint32 i = 0; i < sparseRequirementCount; i += 1) {
+        VkSparseImageMemoryRequirements *requirements = &sparseRequirements[i];
+        bool metadata = (requirements->formatProperties.aspectMask & VK_IMAGE_ASPECT_METADATA_BIT) != 0;
+        Uint32 tailCount;
+
+        if (!metadata && requirements->imageMipTailFirstLod >= createinfo->num_levels) {
+            continue;
+        }
+
+        tailCount = (requirements->formatProperties.flags & VK_SPARSE_IMAGE_FORMAT_SINGLE_MIPTAIL_BIT) ? 1 : sparse->layerCount;
+
+        for (Uint32 layer = 0; layer < tailCount; layer += 1) {
+            VkSparseMemoryBind *bind = &tailBinds[tailBindCount];
+            bind->resourceOffset = requirements->imageMipTailOffset + (layer * requirements->imageMipTailStride);
+            bind->size = requirements->imageMipTailSize;
+            bind->memory = VK_NULL_HANDLE;
+            bind->memoryOffset = tailSize;
+            bind->flags = metadata ? VK_SPARSE_MEMORY_BIND_METADATA_BIT : 0;
+            tailBindCount += 1;
+
+            tailSize += VULKAN_INTERNAL_NextHighestAlignment(
+                requirements->imageMipTailSize,
+                memoryRequirements.alignment);
+        }
+    }
+
+    if (tailBindCount > 0) {
+        VkMemoryAllocateInfo allocateInfo;
+        VkSparseImageOpaqueMemoryBindInfo opaqueBindInfo;
+        VkBindSparseInfo bindInfo;
+
+        allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.pNext = NULL;
+        allocateInfo.allocationSize = tailSize;
+        allocateInfo.memoryTypeIndex = sparse->memoryTypeIndex;
+
+        vulkanResult = renderer->vkAllocateMemory(
+            renderer->logicalDevice,
+            &allocateInfo,
+            NULL,
+            &sparse->mipTailMemory);
+
+        if (vulkanResult != VK_SUCCESS) {
+            SDL_free(tailBinds);
+            CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkAllocateMemory, false);
+        }
+
+        for (Uint32 i = 0; i < tailBindCount; i += 1) {
+            tailBinds[i].memory = sparse->mipTailMemory;
+        }
+
+        opaqueBindInfo.image = texture->image;
+        opaqueBindInfo.bindCount = tailBindCount;
+        opaqueBindInfo.pBinds = tailBinds;
+
+        SDL_zero(bindInfo);
+        bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindInfo.imageOpaqueBindCount = 1;
+        bindInfo.pImageOpaqueBinds = &opaqueBindInfo;
+
+        result = VULKAN_INTERNAL_QueueBindSparse(renderer, &bindInfo);
+    }
+
+    SDL_free(tailBinds);
+
+    if (!result) {
+        return false;
+    }
+
+    sparse->levelTileOffsets = SDL_malloc((sparse->layerCount * sparse->tiledLevelCount + 1) * sizeof(Uint32));
+
+    for (Uint32 layer = 0; layer < sparse->layerCount; layer += 1) {
+        for (Uint32 level = 0; level < sparse->tiledLevelCount; level += 1) {
+            Uint32 tilesX, tilesY, tilesZ;
+            VULKAN_INTERNAL_GetSparseLevelTiles(sparse, level, &tilesX, &tilesY, &tilesZ);
+
+            sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + level] = tileCount;
+            tileCount += tilesX * tilesY * tilesZ;
+        }
+    }
+
+    sparse->tileSlots = SDL_malloc((tileCount + 1) * sizeof(Uint32));
+    SDL_memset(sparse->tileSlots, 0xFF, (tileCount + 1) * sizeof(Uint32)); // SPARSE_TILE_NOT_RESIDENT
+
+    return true;
+}
+
 // Resource tracking
 
 #define ADD_TO_ARRAY_UNIQUE(resource, type, array, count, capacity) \
@@ -2569,6 +3069,31 @@ static void VULKAN_INTERNAL_TrackUniformBuffer(
  * Sync hazards can be detected by setting VK_KHRONOS_VALIDATION_VALIDATE_SYNC=1 when using validation layers.
  */
 
+/* Dedicated compute and transfer queues only support some pipeline stages.
+ * A usage mode whose stages don't exist on the queue is never actually used
+ * on it; accesses from other queues are ordered by the semaphore that the
+ * app waits on with SDL_AddGPUCommandBufferWaitFence, so all that is left for
+ * the barrier to do is the layout transition.
+ */
+static void VULKAN_INTERNAL_RestrictBarrierToQueue(
+    VulkanCommandBuffer *commandBuffer,
+    VkPipelineStageFlags *stages,
+    VkAccessFlags *accessMask,
+    VkPipelineStageFlags fallbackStage)
+{
+    VkPipelineStageFlags supportedStages = commandBuffer->commandPool->supportedStages;
+
+    if (supportedStages == VK_PIPELINE_STAGE_ALL_COMMANDS_BIT) {
+        return;
+    }
+
+    *stages &= supportedStages;
+    if (*stages == 0) {
+        *stages = fallbackStage;
+        *accessMask = 0;
+    }
+}
+
 static void VULKAN_INTERNAL_BufferMemoryBarrier(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer,
@@ -2606,7 +3131,7 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
         srcStages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
         memoryBarrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
     } else if (sourceUsageMode == VULKAN_BUFFER_USAGE_MODE_GRAPHICS_STORAGE_READ) {
-        srcStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        srcStages = renderer->graphicsShaderStages;
         memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
     } else if (sourceUsageMode == VULKAN_BUFFER_USAGE_MODE_COMPUTE_STORAGE_READ) {
         srcStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
@@ -2635,7 +3160,7 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
         dstStages = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
         memoryBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
     } else if (destinationUsageMode == VULKAN_BUFFER_USAGE_MODE_GRAPHICS_STORAGE_READ) {
-        dstStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dstStages = renderer->graphicsShaderStages;
         memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
     } else if (destinationUsageMode == VULKAN_BUFFER_USAGE_MODE_COMPUTE_STORAGE_READ) {
         dstStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
@@ -2648,6 +3173,9 @@ static void VULKAN_INTERNAL_BufferMemoryBarrier(
         return;
     }
 
+    VULKAN_INTERNAL_RestrictBarrierToQueue(commandBuffer, &srcStages, &memoryBarrier.srcAccessMask, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    VULKAN_INTERNAL_RestrictBarrierToQueue(commandBuffer, &dstStages, &memoryBarrier.dstAccessMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
     renderer->vkCmdPipelineBarrier(
         commandBuffer->commandBuffer,
         srcStages,
@@ -2702,11 +3230,11 @@ static void VULKAN_INTERNAL_TextureSubresourceMemoryBarrier(
         memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         memoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     } else if (sourceUsageMode == VULKAN_TEXTURE_USAGE_MODE_SAMPLER) {
-        srcStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        srcStages = renderer->graphicsShaderStages;
         memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
         memoryBarrier.oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     } else if (sourceUsageMode == VULKAN_TEXTURE_USAGE_MODE_GRAPHICS_STORAGE_READ) {
-        srcStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        srcStages = renderer->graphicsShaderStages;
         memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
         memoryBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
     } else if (sourceUsageMode == VULKAN_TEXTURE_USAGE_MODE_COMPUTE_STORAGE_READ) {
@@ -2739,11 +3267,11 @@ static void VULKAN_INTERNAL_TextureSubresourceMemoryBarrier(
         memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
         memoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
     } else if (destinationUsageMode == VULKAN_TEXTURE_USAGE_MODE_SAMPLER) {
-        dstStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dstStages = renderer->graphicsShaderStages;
         memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
         memoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
     } else if (destinationUsageMode == VULKAN_TEXTURE_USAGE_MODE_GRAPHICS_STORAGE_READ) {
-        dstStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        dstStages = renderer->graphicsShaderStages;
         memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
         memoryBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
     } else if (destinationUsageMode == VULKAN_TEXTURE_USAGE_MODE_COMPUTE_STORAGE_READ) {
@@ -2771,6 +3299,9 @@ static void VULKAN_INTERNAL_TextureSubresourceMemoryBarrier(
         return;
     }
 
+    VULKAN_INTERNAL_RestrictBarrierToQueue(commandBuffer, &srcStages, &memoryBarrier.srcAccessMask, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    VULKAN_INTERNAL_RestrictBarrierToQueue(commandBuffer, &dstStages, &memoryBarrier.dstAccessMask, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+
     renderer->vkCmdPipelineBarrier(
         commandBuffer->commandBuffer,
         srcStages,
@@ -3085,6 +3616,12 @@ static void VULKAN_INTERNAL_DestroyTexture(
             texture->usedRegion);
     }
 
+    if (texture->sparse) {
+        VULKAN_INTERNAL_DestroySparseResidency(
+            renderer,
+            texture->sparse);
+    }
+
     SDL_free(texture);
 }
 
@@ -3121,6 +3658,8 @@ static void VULKAN_INTERNAL_DestroyCommandPool(
 
         SDL_free(commandBuffer->presentDatas);
         SDL_free(commandBuffer->waitSemaphores);
+        SDL_free(commandBuffer->waitSemaphoreStages);
+        SDL_free(commandBuffer->waitFences);
         SDL_free(commandBuffer->signalSemaphores);
         SDL_free(commandBuffer->usedBuffers);
         SDL_free(commandBuffer->usedTextures);
@@ -3134,6 +3673,23 @@ static void VULKAN_INTERNAL_DestroyCommandPool(
     }
 
     SDL_free(commandPool->inactiveCommandBuffers);
+
+    for (i = 0; i < commandPool->inactiveUniformBufferCount; i += 1) {
+        VULKAN_INTERNAL_DestroyBuffer(
+            renderer,
+            commandPool->inactiveUniformBuffers[i]->buffer);
+        SDL_free(commandPool->inactiveUniformBuffers[i]);
+    }
+    SDL_free(commandPool->inactiveUniformBuffers);
+
+    for (i = 0; i < commandPool->inactiveDescriptorSetCacheCount; i += 1) {
+        VULKAN_INTERNAL_DestroyDescriptorSetCache(
+            renderer,
+            commandPool->inactiveDescriptorSetCaches[i]);
+    }
+    SDL_free(commandPool->inactiveDescriptorSetCaches);
+
+    SDL_DestroyMutex(commandPool->lock);
     SDL_free(commandPool);
 }
 
@@ -3165,6 +3721,9 @@ static void VULKAN_INTERNAL_DestroyGraphicsPipeline(
         NULL);
 
     (void)SDL_AtomicDecRef(&graphicsPipeline->vertexShader->referenceCount);
+    if (graphicsPipeline->taskShader != NULL) {
+        (void)SDL_AtomicDecRef(&graphicsPipeline->taskShader->referenceCount);
+    }
     (void)SDL_AtomicDecRef(&graphicsPipeline->fragmentShader->referenceCount);
 
     SDL_free(graphicsPipeline);
@@ -3314,6 +3873,7 @@ static void VULKAN_INTERNAL_DestroyDescriptorSetCache(
     VulkanRenderer *renderer,
     DescriptorSetCache *descriptorSetCache)
 {
+    SDL_UntrackMemoryObject(descriptorSetCache);
     for (Uint32 i = 0; i < descriptorSetCache->poolCount; i += 1) {
         for (Uint32 j = 0; j < descriptorSetCache->pools[i].poolCount; j += 1) {
             renderer->vkDestroyDescriptorPool(
@@ -3339,6 +3899,7 @@ static Uint32 SDLCALL VULKAN_INTERNAL_GraphicsPipelineResourceLayoutHashFunction
      */
     const Uint32 hashFactor = 31;
     Uint32 result = 1;
+    result = result * hashFactor + hashTableKey->vertexStages;
     result = result * hashFactor + hashTableKey->vertexSamplerCount;
     result = result * hashFactor + hashTableKey->vertexStorageBufferCount;
     result = result * hashFactor + hashTableKey->vertexStorageTextureCount;
@@ -3427,14 +3988,15 @@ static void SDLCALL VULKAN_INTERNAL_DescriptorSetLayoutHashDestroy(void *userdat
 
 static Uint32 SDLCALL VULKAN_INTERNAL_CommandPoolHashFunction(void *userdata, const void *key)
 {
-    return (Uint32)((CommandPoolHashTableKey *)key)->threadID;
+    CommandPoolHashTableKey *hashTableKey = (CommandPoolHashTableKey *)key;
+    return (Uint32)hashTableKey->threadID ^ ((Uint32)hashTableKey->queueType << 30);
 }
 
 static bool SDLCALL VULKAN_INTERNAL_CommandPoolHashKeyMatch(void *userdata, const void *aKey, const void *bKey)
 {
     CommandPoolHashTableKey *a = (CommandPoolHashTableKey *)aKey;
     CommandPoolHashTableKey *b = (CommandPoolHashTableKey *)bKey;
-    return a->threadID == b->threadID;
+    return a->threadID == b->threadID && a->queueType == b->queueType;
 }
 
 static void SDLCALL VULKAN_INTERNAL_CommandPoolHashDestroy(void *userdata, const void *key, const void *value)
@@ -3900,16 +4462,35 @@ static DescriptorSetLayout *VULKAN_INTERNAL_FetchDescriptorSetLayout(
 static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipelineResourceLayout(
     VulkanRenderer *renderer,
     VulkanShader *vertexShader,
+    VulkanShader *taskShader,
     VulkanShader *fragmentShader)
 {
     GraphicsPipelineResourceLayoutHashTableKey key;
     SDL_zero(key);
     VulkanGraphicsPipelineResourceLayout *pipelineResourceLayout = NULL;
-
-    key.vertexSamplerCount = vertexShader->numSamplers;
-    key.vertexStorageTextureCount = vertexShader->numStorageTextures;
-    key.vertexStorageBufferCount = vertexShader->numStorageBuffers;
-    key.vertexUniformBufferCount = vertexShader->numUniformBuffers;
+    VkShaderStageFlags vertexStages = VK_SHADER_STAGE_VERTEX_BIT;
+    Uint32 vertexSamplerCount = vertexShader->numSamplers;
+    Uint32 vertexStorageTextureCount = vertexShader->numStorageTextures;
+    Uint32 vertexStorageBufferCount = vertexShader->numStorageBuffers;
+    Uint32 vertexUniformBufferCount = vertexShader->numUniformBuffers;
+
+    // Task and mesh shaders share the vertex stage's descriptor sets
+    if (vertexShader->stage == SDL_GPU_SHADERSTAGE_MESH) {
+        vertexStages = VK_SHADER_STAGE_MESH_BIT_EXT;
+        if (taskShader != NULL) {
+            vertexStages |= VK_SHADER_STAGE_TASK_BIT_EXT;
+            vertexSamplerCount = SDL_max(vertexSamplerCount, taskShader->numSamplers);
+            vertexStorageTextureCount = SDL_max(vertexStorageTextureCount, taskShader->numStorageTextures);
+            vertexStorageBufferCount = SDL_max(vertexStorageBufferCount, taskShader->numStorageBuffers);
+            vertexUniformBufferCount = SDL_max(vertexUniformBufferCount, taskShader->numUniformBuffers);
+        }
+    }
+
+    key.vertexStages = vertexStages;
+    key.vertexSamplerCount = vertexSamplerCount;
+    key.vertexStorageTextureCount = vertexStorageTextureCount;
+    key.vertexStorageBufferCount = vertexStorageBufferCount;
+    key.vertexUniformBufferCount = vertexUniformBufferCount;
     key.fragmentSamplerCount = fragmentShader->numSamplers;
     key.fragmentStorageTextureCount = fragmentShader->numStorageTextures;
     key.fragmentStorageBufferCount = fragmentShader->numStorageBuffers;
@@ -3933,23 +4514,23 @@ static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipeli
 
     pipelineResourceLayout->descriptorSetLayouts[0] = VULKAN_INTERNAL_FetchDescriptorSetLayout(
         renderer,
-        VK_SHADER_STAGE_VERTEX_BIT,
-        vertexShader->numSamplers,
-        vertexShader->numStorageTextures,
-        vertexShader->numStorageBuffers,
+        (VkShaderStageFlagBits)vertexStages,
+        vertexSamplerCount,
+        vertexStorageTextureCount,
+        vertexStorageBufferCount,
         0,
         0,
         0);
 
     pipelineResourceLayout->descriptorSetLayouts[1] = VULKAN_INTERNAL_FetchDescriptorSetLayout(
         renderer,
-        VK_SHADER_STAGE_VERTEX_BIT,
+        (VkShaderStageFlagBits)vertexStages,
         0,
         0,
         0,
         0,
         0,
-        vertexShader->numUniformBuffers);
+        vertexUniformBufferCount);
 
     pipelineResourceLayout->descriptorSetLayouts[2] = VULKAN_INTERNAL_FetchDescriptorSetLayout(
         renderer,
@@ -3976,10 +4557,10 @@ static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipeli
     descriptorSetLayouts[2] = pipelineResourceLayout->descriptorSetLayouts[2]->descriptorSetLayout;
     descriptorSetLayouts[3] = pipelineResourceLayout->descriptorSetLayouts[3]->descriptorSetLayout;
 
-    pipelineResourceLayout->vertexSamplerCount = vertexShader->numSamplers;
-    pipelineResourceLayout->vertexStorageTextureCount = vertexShader->numStorageTextures;
-    pipelineResourceLayout->vertexStorageBufferCount = vertexShader->numStorageBuffers;
-    pipelineResourceLayout->vertexUniformBufferCount = vertexShader->numUniformBuffers;
+    pipelineResourceLayout->vertexSamplerCount = vertexSamplerCount;
+    pipelineResourceLayout->vertexStorageTextureCount = vertexStorageTextureCount;
+    pipelineResourceLayout->vertexStorageBufferCount = vertexStorageBufferCount;
+    pipelineResourceLayout->vertexUniformBufferCount = vertexUniformBufferCount;
 
     pipelineResourceLayout->fragmentSamplerCount = fragmentShader->numSamplers;
     pipelineResourceLayout->fragmentStorageTextureCount = fragmentShader->numStorageTextures;
@@ -4180,9 +4761,15 @@ static VulkanBuffer *VULKAN_INTERNAL_CreateBuffer(
     createinfo.flags = 0;
     createinfo.size = size;
     createinfo.usage = vulkanUsageFlags;
-    createinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    createinfo.queueFamilyIndexCount = 1;
-    createinfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
+    if (renderer->uniqueQueueFamilyCount > 1) {
+        createinfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        createinfo.queueFamilyIndexCount = renderer->uniqueQueueFamilyCount;
+        createinfo.pQueueFamilyIndices = renderer->uniqueQueueFamilyIndices;
+    } else {
+        createinfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createinfo.queueFamilyIndexCount = 1;
+        createinfo.pQueueFamilyIndices = &renderer->queueFamilyIndex;
+    }
 
     // Set transfer bits so we can defrag
     createinfo.usage |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
@@ -4697,6 +5284,8 @@ static Uint32 VULKAN_INTERNAL_CreateSwapchain(
     swapchainCreateInfo.clipped = VK_TRUE;
     swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
 
+    windowData->presentID = 0;
+
     vulkanResult = renderer->vkCreateSwapchainKHR(
         renderer->logicalDevice,
         &swapchainCreateInfo,
@@ -4943,12 +5532,26 @@ static void VULKAN_DestroyDevice(
             renderer->fencePool.availableFences[i]->fence,
             NULL);
 
+        if (renderer->fencePool.availableFences[i]->semaphore != VK_NULL_HANDLE) {
+            renderer->vkDestroySemaphore(
+                renderer->logicalDevice,
+                renderer->fencePool.availableFences[i]->semaphore,
+                NULL);
+        }
+
         SDL_free(renderer->fencePool.availableFences[i]);
     }
 
     SDL_free(renderer->fencePool.availableFences);
     SDL_DestroyMutex(renderer->fencePool.lock);
 
+    if (renderer->sparseBindFence != VK_NULL_HANDLE) {
+        renderer->vkDestroyFence(
+            renderer->logicalDevice,
+            renderer->sparseBindFence,
+            NULL);
+    }
+
     SDL_DestroyHashTable(renderer->commandPoolHashTable);
     SDL_DestroyHashTable(renderer->renderPassHashTable);
     SDL_DestroyHashTable(renderer->framebufferHashTable);
@@ -4956,6 +5559,13 @@ static void VULKAN_DestroyDevice(
     SDL_DestroyHashTable(renderer->computePipelineResourceLayoutHashTable);
     SDL_DestroyHashTable(renderer->descriptorSetLayoutHashTable);
 
+    if (renderer->pipelineCache != VK_NULL_HANDLE) {
+        renderer->vkDestroyPipelineCache(
+            renderer->logicalDevice,
+            renderer->pipelineCache,
+            NULL);
+    }
+
     for (Uint32 i = 0; i < VK_MAX_MEMORY_TYPES; i += 1) {
         allocator = &renderer->memoryAllocator->subAllocators[i];
 
@@ -5011,14 +5621,30 @@ static void VULKAN_DestroyDevice(
 }
 
 static DescriptorSetCache *VULKAN_INTERNAL_AcquireDescriptorSetCache(
-    VulkanRenderer *renderer)
+    VulkanRenderer *renderer,
+    VulkanCommandPool *commandPool)
 {
-    DescriptorSetCache *cache;
+    DescriptorSetCache *cache = NULL;
+
+    // Prefer a cache released by this thread, its pools are already sized for its work
+    SDL_LockMutex(commandPool->lock);
+    if (commandPool->inactiveDescriptorSetCacheCount > 0) {
+        cache = commandPool->inactiveDescriptorSetCaches[commandPool->inactiveDescriptorSetCacheCount - 1];
+        commandPool->inactiveDescriptorSetCacheCount -= 1;
+    }
+    SDL_UnlockMutex(commandPool->lock);
+
+    if (cache) {
+        return cache;
+    }
 
+    // The shared pool is protected by acquireCommandBufferLock
     if (renderer->descriptorSetCachePoolCount == 0) {
         cache = SDL_malloc(sizeof(DescriptorSetCache));
         cache->poolCount = 0;
         cache->pools = NULL;
+        cache->descriptorBytes = 0;
+        SDL_zeroa(cache->reuseEntries);
     } else {
         cache = renderer->descriptorSetCachePool[renderer->descriptorSetCachePoolCount - 1];
         renderer->descriptorSetCachePoolCount -= 1;
@@ -5027,23 +5653,27 @@ static DescriptorSetCache *VULKAN_INTERNAL_AcquireDescriptorSetCache(
     return cache;
 }
 
+// Must be called with commandPool->lock held
 static void VULKAN_INTERNAL_ReturnDescriptorSetCacheToPool(
-    VulkanRenderer *renderer,
+    VulkanCommandPool *commandPool,
     DescriptorSetCache *descriptorSetCache)
 {
     EXPAND_ARRAY_IF_NEEDED(
-        renderer->descriptorSetCachePool,
+        commandPool->inactiveDescriptorSetCaches,
         DescriptorSetCache *,
-        renderer->descriptorSetCachePoolCount + 1,
-        renderer->descriptorSetCachePoolCapacity,
-        renderer->descriptorSetCachePoolCapacity * 2);
+        commandPool->inactiveDescriptorSetCacheCount + 1,
+        commandPool->inactiveDescriptorSetCacheCapacity,
+        commandPool->inactiveDescriptorSetCacheCapacity * 2 + 1);
 
-    renderer->descriptorSetCachePool[renderer->descriptorSetCachePoolCount] = descriptorSetCache;
-    renderer->descriptorSetCachePoolCount += 1;
+    commandPool->inactiveDescriptorSetCaches[commandPool->inactiveDescriptorSetCacheCount] = descriptorSetCache;
+    commandPool->inactiveDescriptorSetCacheCount += 1;
 
     for (Uint32 i = 0; i < descriptorSetCache->poolCount; i += 1) {
         descriptorSetCache->pools[i].descriptorSetIndex = 0;
     }
+
+    // The descriptor sets will be handed out again, so forget what they contain
+    SDL_zeroa(descriptorSetCache->reuseEntries);
 }
 
 static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
@@ -5074,6 +5704,21 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
             pool)) {
             return VK_NULL_HANDLE;
         }
+
+        DescriptorSetCache *descriptorSetCache = vulkanCommandBuffer->descriptorSetCache;
+        descriptorSetCache->descriptorBytes += (Uint64)DESCRIPTOR_POOL_SIZE * DESCRIPTOR_SIZE_ESTIMATE * (
+            descriptorSetLayout->samplerCount +
+            descriptorSetLayout->storageTextureCount +
+            descriptorSetLayout->storageBufferCount +
+            descriptorSetLayout->writeStorageTextureCount +
+            descriptorSetLayout->writeStorageBufferCount +
+            descriptorSetLayout->uniformBufferCount);
+        SDL_TrackMemoryObject(
+            descriptorSetCache,
+            SDL_MEMORY_OBJECT_CACHE,
+            descriptorSetCache->descriptorBytes,
+            NULL,
+            "SDL.gpu.vulkan.descriptor_pools");
     }
 
     VkDescriptorSet descriptorSet = pool->descriptorSets[pool->descriptorSetIndex];
@@ -5082,6 +5727,54 @@ static VkDescriptorSet VULKAN_INTERNAL_FetchDescriptorSet(
     return descriptorSet;
 }
 
+/* Returns true if a descriptor set with exactly these resources was already
+ * written earlier in this command buffer. Otherwise a new descriptor set is
+ * fetched and remembered, and the caller must write the resources into it.
+ */
+static bool VULKAN_INTERNAL_FetchReusableDescriptorSet(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    DescriptorSetLayout *descriptorSetLayout,
+    Uint32 samplerCount,
+    const VkSampler *samplers,
+    const VkImageView *samplerTextureViews,
+    Uint32 storageTextureCount,
+    const VkImageView *storageTextureViews,
+    Uint32 storageBufferCount,
+    const VkBuffer *storageBuffers,
+    VkDescriptorSet *descriptorSet)
+{
+    DescriptorSetReuseKey key;
+    DescriptorSetReuseEntry *entry;
+
+    SDL_zero(key);
+    key.layoutID = descriptorSetLayout->ID;
+    key.samplerCount = samplerCount;
+    key.storageTextureCount = storageTextureCount;
+    key.storageBufferCount = storageBufferCount;
+    SDL_memcpy(key.samplers, samplers, samplerCount * sizeof(VkSampler));
+    SDL_memcpy(key.samplerTextureViews, samplerTextureViews, samplerCount * sizeof(VkImageView));
+    SDL_memcpy(key.storageTextureViews, storageTextureViews, storageTextureCount * sizeof(VkImageView));
+    SDL_memcpy(key.storageBuffers, storageBuffers, storageBufferCount * sizeof(VkBuffer));
+
+    entry = &vulkanCommandBuffer->descriptorSetCache->reuseEntries[SDL_murmur3_32(&key, sizeof(key), 0) % DESCRIPTOR_SET_REUSE_CACHE_SIZE];
+    if (entry->descriptorSet != VK_NULL_HANDLE && SDL_memcmp(&entry->key, &key, sizeof(key)) == 0) {
+        *descriptorSet = entry->descriptorSet;
+        return true;
+    }
+
+    *descriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
+        renderer,
+        vulkanCommandBuffer,
+        descriptorSetLayout);
+
+    if (*descriptorSet != VK_NULL_HANDLE) {
+        SDL_copyp(&entry->key, &key);
+        entry->descriptorSet = *descriptorSet;
+    }
+    return false;
+}
+
 static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer)
@@ -5129,78 +5822,86 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     if (commandBuffer->needNewVertexResourceDescriptorSet) {
         descriptorSetLayout = resourceLayout->descriptorSetLayouts[0];
 
-        commandBuffer->vertexResourceDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetLayout);
-
-        for (Uint32 i = 0; i < resourceLayout->vertexSamplerCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
-
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
-
-            imageInfos[imageInfoCount].sampler = commandBuffer->vertexSamplerBindings[i];
-            imageInfos[imageInfoCount].imageView = commandBuffer->vertexSamplerTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
-
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+        if (!VULKAN_INTERNAL_FetchReusableDescriptorSet(
+                renderer,
+                commandBuffer,
+                descriptorSetLayout,
+                resourceLayout->vertexSamplerCount,
+                commandBuffer->vertexSamplerBindings,
+                commandBuffer->vertexSamplerTextureViewBindings,
+                resourceLayout->vertexStorageTextureCount,
+                commandBuffer->vertexStorageTextureViewBindings,
+                resourceLayout->vertexStorageBufferCount,
+                commandBuffer->vertexStorageBufferBindings,
+                &commandBuffer->vertexResourceDescriptorSet)) {
+            for (Uint32 i = 0; i < resourceLayout->vertexSamplerCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
+
+                imageInfos[imageInfoCount].sampler = commandBuffer->vertexSamplerBindings[i];
+                imageInfos[imageInfoCount].imageView = commandBuffer->vertexSamplerTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->vertexStorageTextureCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->vertexStorageTextureCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring a storage image as a sampled image, because shaders are stupid.
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring a storage image as a sampled image, because shaders are stupid.
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
 
-            imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
-            imageInfos[imageInfoCount].imageView = commandBuffer->vertexStorageTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
+                imageInfos[imageInfoCount].imageView = commandBuffer->vertexStorageTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
 
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->vertexStorageBufferCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->vertexStorageBufferCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + resourceLayout->vertexStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pImageInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->vertexSamplerCount + resourceLayout->vertexStorageTextureCount + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->vertexResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pImageInfo = NULL;
 
-            bufferInfos[bufferInfoCount].buffer = commandBuffer->vertexStorageBufferBindings[i];
-            bufferInfos[bufferInfoCount].offset = 0;
-            bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
+                bufferInfos[bufferInfoCount].buffer = commandBuffer->vertexStorageBufferBindings[i];
+                bufferInfos[bufferInfoCount].offset = 0;
+                bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
 
-            currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
+                currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
 
-            writeCount += 1;
-            bufferInfoCount += 1;
+                writeCount += 1;
+                bufferInfoCount += 1;
+            }
         }
 
         commandBuffer->needNewVertexResourceDescriptorSet = false;
@@ -5248,78 +5949,86 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     if (commandBuffer->needNewFragmentResourceDescriptorSet) {
         descriptorSetLayout = resourceLayout->descriptorSetLayouts[2];
 
-        commandBuffer->fragmentResourceDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetLayout);
-
-        for (Uint32 i = 0; i < resourceLayout->fragmentSamplerCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
-
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
-
-            imageInfos[imageInfoCount].sampler = commandBuffer->fragmentSamplerBindings[i];
-            imageInfos[imageInfoCount].imageView = commandBuffer->fragmentSamplerTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
-
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+        if (!VULKAN_INTERNAL_FetchReusableDescriptorSet(
+                renderer,
+                commandBuffer,
+                descriptorSetLayout,
+                resourceLayout->fragmentSamplerCount,
+                commandBuffer->fragmentSamplerBindings,
+                commandBuffer->fragmentSamplerTextureViewBindings,
+                resourceLayout->fragmentStorageTextureCount,
+                commandBuffer->fragmentStorageTextureViewBindings,
+                resourceLayout->fragmentStorageBufferCount,
+                commandBuffer->fragmentStorageBufferBindings,
+                &commandBuffer->fragmentResourceDescriptorSet)) {
+            for (Uint32 i = 0; i < resourceLayout->fragmentSamplerCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
+
+                imageInfos[imageInfoCount].sampler = commandBuffer->fragmentSamplerBindings[i];
+                imageInfos[imageInfoCount].imageView = commandBuffer->fragmentSamplerTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->fragmentStorageTextureCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->fragmentStorageTextureCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring a storage image as a sampled image, because shaders are stupid.
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring a storage image as a sampled image, because shaders are stupid.
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
 
-            imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
-            imageInfos[imageInfoCount].imageView = commandBuffer->fragmentStorageTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
+                imageInfos[imageInfoCount].imageView = commandBuffer->fragmentStorageTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
 
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->fragmentStorageBufferCount; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->fragmentStorageBufferCount; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + resourceLayout->fragmentStorageTextureCount + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pImageInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->fragmentSamplerCount + resourceLayout->fragmentStorageTextureCount + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->fragmentResourceDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pImageInfo = NULL;
 
-            bufferInfos[bufferInfoCount].buffer = commandBuffer->fragmentStorageBufferBindings[i];
-            bufferInfos[bufferInfoCount].offset = 0;
-            bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
+                bufferInfos[bufferInfoCount].buffer = commandBuffer->fragmentStorageBufferBindings[i];
+                bufferInfos[bufferInfoCount].offset = 0;
+                bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
 
-            currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
+                currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
 
-            writeCount += 1;
-            bufferInfoCount += 1;
+                writeCount += 1;
+                bufferInfoCount += 1;
+            }
         }
 
         commandBuffer->needNewFragmentResourceDescriptorSet = false;
@@ -5391,7 +6100,7 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
     commandBuffer->needNewFragmentUniformOffsets = false;
 }
 
-static void VULKAN_DrawIndexedPrimitives(
+SDL_GPU_DIRECT void VULKAN_DrawIndexedPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numIndices,
     Uint32 numInstances,
@@ -5413,7 +6122,7 @@ static void VULKAN_DrawIndexedPrimitives(
         firstInstance);
 }
 
-static void VULKAN_DrawPrimitives(
+SDL_GPU_DIRECT void VULKAN_DrawPrimitives(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 numVertices,
     Uint32 numInstances,
@@ -5507,6 +6216,126 @@ static void VULKAN_DrawIndexedPrimitivesIndirect(
     VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
 }
 
+static bool VULKAN_SupportsIndirectCount(
+    SDL_GPURenderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    // Without multiDrawIndirect the maximum draw count would be limited to 1
+    return renderer->supports.KHR_draw_indirect_count && renderer->supportsMultiDrawIndirect;
+}
+
+static void VULKAN_DrawPrimitivesIndirectCount(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *countBuffer,
+    Uint32 countOffset,
+    Uint32 maxDrawCount)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBuffer;
+    VulkanBuffer *vulkanCountBuffer = ((VulkanBufferContainer *)countBuffer)->activeBuffer;
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    renderer->vkCmdDrawIndirectCountKHR(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanBuffer->buffer,
+        offset,
+        vulkanCountBuffer->buffer,
+        countOffset,
+        maxDrawCount,
+        sizeof(SDL_GPUIndirectDrawCommand));
+
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanCountBuffer);
+}
+
+static void VULKAN_DrawIndexedPrimitivesIndirectCount(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    SDL_GPUBuffer *countBuffer,
+    Uint32 countOffset,
+    Uint32 maxDrawCount)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBuffer;
+    VulkanBuffer *vulkanCountBuffer = ((VulkanBufferContainer *)countBuffer)->activeBuffer;
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    renderer->vkCmdDrawIndexedIndirectCountKHR(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanBuffer->buffer,
+        offset,
+        vulkanCountBuffer->buffer,
+        countOffset,
+        maxDrawCount,
+        sizeof(SDL_GPUIndexedIndirectDrawCommand));
+
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanCountBuffer);
+}
+
+static void VULKAN_DrawMeshTasks(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 groupcountX,
+    Uint32 groupcountY,
+    Uint32 groupcountZ)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    renderer->vkCmdDrawMeshTasksEXT(
+        vulkanCommandBuffer->commandBuffer,
+        groupcountX,
+        groupcountY,
+        groupcountZ);
+}
+
+static void VULKAN_DrawMeshTasksIndirect(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUBuffer *buffer,
+    Uint32 offset,
+    Uint32 drawCount)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanBuffer *vulkanBuffer = ((VulkanBufferContainer *)buffer)->activeBuffer;
+    Uint32 pitch = sizeof(SDL_GPUIndirectDispatchCommand);
+    Uint32 i;
+
+    VULKAN_INTERNAL_BindGraphicsDescriptorSets(renderer, vulkanCommandBuffer);
+
+    if (renderer->supportsMultiDrawIndirect) {
+        // Real multi-draw!
+        renderer->vkCmdDrawMeshTasksIndirectEXT(
+            vulkanCommandBuffer->commandBuffer,
+            vulkanBuffer->buffer,
+            offset,
+            drawCount,
+            pitch);
+    } else {
+        // Fake multi-draw...
+        for (i = 0; i < drawCount; i += 1) {
+            renderer->vkCmdDrawMeshTasksIndirectEXT(
+                vulkanCommandBuffer->commandBuffer,
+                vulkanBuffer->buffer,
+                offset + (pitch * i),
+                1,
+                pitch);
+        }
+    }
+
+    VULKAN_INTERNAL_TrackBuffer(vulkanCommandBuffer, vulkanBuffer);
+}
+
 // Debug Naming
 
 static void VULKAN_INTERNAL_SetBufferName(
@@ -5665,8 +6494,10 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
     VkImageViewCreateInfo imageViewCreateInfo;
     Uint8 bindResult;
     VkImageUsageFlags vkUsageFlags = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    bool transient = (createinfo->usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) != 0;
     Uint32 layerCount = (createinfo->type == SDL_GPU_TEXTURETYPE_3D) ? 1 : createinfo->layer_count_or_depth;
     Uint32 depth = (createinfo->type == SDL_GPU_TEXTURETYPE_3D) ? createinfo->layer_count_or_depth : 1;
+    bool sparse = SDL_GetBooleanProperty(createinfo->props, SDL_PROP_GPU_TEXTURE_CREATE_SPARSE_BOOLEAN, false);
 
     VulkanTexture *texture = SDL_calloc(1, sizeof(VulkanTexture));
     texture->swizzle = SwizzleForSDLFormat(createinfo->format);
@@ -5690,6 +6521,10 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
         imageCreateFlags |= VK_IMAGE_CREATE_2D_ARRAY_COMPATIBLE_BIT;
     }
 
+    if (sparse) {
+        imageCreateFlags |= VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT;
+    }
+
     if (createinfo->usage & (SDL_GPU_TEXTUREUSAGE_SAMPLER |
                              SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ |
                              SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ)) {
@@ -5705,6 +6540,11 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
                              SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE)) {
         vkUsageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
     }
+    if (transient) {
+        // Transient images may only be used as attachments, never as transfer targets
+        vkUsageFlags &= ~(VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+        vkUsageFlags |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
 
     imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
     imageCreateInfo.pNext = NULL;
@@ -5719,9 +6559,15 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
     imageCreateInfo.samples = SDLToVK_SampleCount[createinfo->sample_count];
     imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
     imageCreateInfo.usage = vkUsageFlags;
-    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-    imageCreateInfo.queueFamilyIndexCount = 0;
-    imageCreateInfo.pQueueFamilyIndices = NULL;
+    if (renderer->uniqueQueueFamilyCount > 1) {
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        imageCreateInfo.queueFamilyIndexCount = renderer->uniqueQueueFamilyCount;
+        imageCreateInfo.pQueueFamilyIndices = renderer->uniqueQueueFamilyIndices;
+    } else {
+        imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageCreateInfo.queueFamilyIndexCount = 0;
+        imageCreateInfo.pQueueFamilyIndices = NULL;
+    }
     imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
     vulkanResult = renderer->vkCreateImage(
@@ -5735,22 +6581,30 @@ static VulkanTexture *VULKAN_INTERNAL_CreateTexture(
         CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateImage, NULL);
     }
 
-    bindResult = VULKAN_INTERNAL_BindMemoryForImage(
-        renderer,
-        texture->image,
-        &texture->usedRegion);
-
-    if (bindResult != 1) {
-        renderer->vkDestroyImage(
-            renderer->logicalDevice,
+    if (sparse) {
+        if (!VULKAN_INTERNAL_InitSparseResidency(renderer, texture, createinfo)) {
+            VULKAN_INTERNAL_DestroyTexture(renderer, texture);
+            return NULL;
+        }
+    } else {
+        bindResult = VULKAN_INTERNAL_BindMemoryForImage(
+            renderer,
             texture->image,
-            NULL);
+            transient,
+            &texture->usedRegion);
 
-        VULKAN_INTERNAL_DestroyTexture(renderer, texture);
-        SET_STRING_ERROR_AND_RETURN("Unable to bind memory for texture!", NULL);
-    }
+        if (bindResult != 1) {
+            renderer->vkDestroyImage(
+                renderer->logicalDevice,
+                texture->image,
+                NULL);
+
+            VULKAN_INTERNAL_DestroyTexture(renderer, texture);
+            SET_STRING_ERROR_AND_RETURN("Unable to bind memory for texture!", NULL);
+        }
 
-    texture->usedRegion->vulkanTexture = texture; // lol
+        texture->usedRegion->vulkanTexture = texture; // lol
+    }
 
     if (createinfo->usage & (SDL_GPU_TEXTUREUSAGE_SAMPLER | SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ | SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ)) {
 
@@ -6277,7 +7131,10 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     VulkanGraphicsPipeline *graphicsPipeline = (VulkanGraphicsPipeline *)SDL_malloc(sizeof(VulkanGraphicsPipeline));
     VkGraphicsPipelineCreateInfo vkPipelineCreateInfo;
 
-    VkPipelineShaderStageCreateInfo shaderStageCreateInfos[2];
+    VkPipelineShaderStageCreateInfo shaderStageCreateInfos[3];
+    Uint32 stageCount = 0;
+    VulkanShader *taskShader = (VulkanShader *)SDL_GetPointerProperty(createinfo->props, SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_TASK_SHADER_POINTER, NULL);
+    VulkanShader *meshShader = (VulkanShader *)SDL_GetPointerProperty(createinfo->props, SDL_PROP_GPU_GRAPHICSPIPELINE_CREATE_MESH_SHADER_POINTER, NULL);
 
     VkPipelineVertexInputStateCreateInfo vertexInputStateCreateInfo;
     VkVertexInputBindingDescription *vertexInputBindingDescriptions = SDL_stack_alloc(VkVertexInputBindingDescription, createinfo->vertex_input_state.num_vertex_buffers);
@@ -6310,12 +7167,39 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
 
     VulkanRenderer *renderer = (VulkanRenderer *)driverData;
 
-    // Create a "compatible" render pass
+    VkPipelineRenderingCreateInfoKHR renderingCreateInfo;
+    VkFormat colorAttachmentFormats[MAX_COLOR_TARGET_BINDINGS];
+    VkRenderPass transientRenderPass = VK_NULL_HANDLE;
 
-    VkRenderPass transientRenderPass = VULKAN_INTERNAL_CreateTransientRenderPass(
-        renderer,
-        createinfo->target_info,
-        SDLToVK_SampleCount[createinfo->multisample_state.sample_count]);
+    if (renderer->supports.KHR_dynamic_rendering) {
+        // With dynamic rendering the pipeline only needs the attachment formats
+
+        for (i = 0; i < createinfo->target_info.num_color_targets; i += 1) {
+            colorAttachmentFormats[i] = SDLToVK_TextureFormat[createinfo->target_info.color_target_descriptions[i].format];
+        }
+
+        renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
+        renderingCreateInfo.pNext = NULL;
+        renderingCreateInfo.viewMask = 0;
+        renderingCreateInfo.colorAttachmentCount = createinfo->target_info.num_color_targets;
+        renderingCreateInfo.pColorAttachmentFormats = colorAttachmentFormats;
+        renderingCreateInfo.depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+        renderingCreateInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+
+        if (createinfo->target_info.has_depth_stencil_target) {
+            renderingCreateInfo.depthAttachmentFormat = SDLToVK_TextureFormat[createinfo->target_info.depth_stencil_format];
+            if (IsStencilFormat(createinfo->target_info.depth_stencil_format)) {
+                renderingCreateInfo.stencilAttachmentFormat = renderingCreateInfo.depthAttachmentFormat;
+            }
+        }
+    } else {
+        // Create a "compatible" render pass
+
+        transientRenderPass = VULKAN_INTERNAL_CreateTransientRenderPass(
+            renderer,
+            createinfo->target_info,
+            SDLToVK_SampleCount[createinfo->multisample_state.sample_count]);
+    }
 
     // Dynamic state
 
@@ -6327,30 +7211,60 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
 
     // Shader stages
 
-    graphicsPipeline->vertexShader = (VulkanShader *)createinfo->vertex_shader;
+    if (meshShader != NULL) {
+        // The mesh shader takes the vertex shader's place, including its resources
+        graphicsPipeline->vertexShader = meshShader;
+        graphicsPipeline->taskShader = taskShader;
+    } else {
+        graphicsPipeline->vertexShader = (VulkanShader *)createinfo->vertex_shader;
+        graphicsPipeline->taskShader = NULL;
+    }
+
+    if (graphicsPipeline->taskShader != NULL) {
+        SDL_AtomicIncRef(&graphicsPipeline->taskShader->referenceCount);
+
+        shaderStageCreateInfos[stageCount].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        shaderStageCreateInfos[stageCount].pNext = NULL;
+        shaderStageCreateInfos[stageCount].flags = 0;
+        shaderStageCreateInfos[stageCount].stage = VK_SHADER_STAGE_TASK_BIT_EXT;
+        shaderStageCreateInfos[stageCount].module = graphicsPipeline->taskShader->shaderModule;
+        shaderStageCreateInfos[stageCount].pName = graphicsPipeline->taskShader->entrypointName;
+        shaderStageCreateInfos[stageCount].pSpecializationInfo = NULL;
+        stageCount += 1;
+    }
+
     SDL_AtomicIncRef(&graphicsPipeline->vertexShader->referenceCount);
 
-    shaderStageCreateInfos[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStageCreateInfos[0].pNext = NULL;
-    shaderStageCreateInfos[0].flags = 0;
-    shaderStageCreateInfos[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-    shaderStageCreateInfos[0].module = graphicsPipeline->vertexShader->shaderModule;
-    shaderStageCreateInfos[0].pName = graphicsPipeline->vertexShader->entrypointName;
-    shaderStageCreateInfos[0].pSpecializationInfo = NULL;
+    shaderStageCreateInfos[stageCount].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStageCreateInfos[stageCount].pNext = NULL;
+    shaderStageCreateInfos[stageCount].flags = 0;
+    shaderStageCreateInfos[stageCount].stage = (meshShader != NULL) ? VK_SHADER_STAGE_MESH_BIT_EXT : VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStageCreateInfos[stageCount].module = graphicsPipeline->vertexShader->shaderModule;
+    shaderStageCreateInfos[stageCount].pName = graphicsPipeline->vertexShader->entrypointName;
+    shaderStageCreateInfos[stageCount].pSpecializationInfo = NULL;
+    stageCount += 1;
 
     graphicsPipeline->fragmentShader = (VulkanShader *)createinfo->fragment_shader;
     SDL_AtomicIncRef(&graphicsPipeline->fragmentShader->referenceCount);
 
-    shaderStageCreateInfos[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStageCreateInfos[1].pNext = NULL;
-    shaderStageCreateInfos[1].flags = 0;
-    shaderStageCreateInfos[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    shaderStageCreateInfos[1].module = graphicsPipeline->fragmentShader->shaderModule;
-    shaderStageCreateInfos[1].pName = graphicsPipeline->fragmentShader->entrypointName;
-    shaderStageCreateInfos[1].pSpecializationInfo = NULL;
+    shaderStageCreateInfos[stageCount].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStageCreateInfos[stageCount].pNext = NULL;
+    shaderStageCreateInfos[stageCount].flags = 0;
+    shaderStageCreateInfos[stageCount].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStageCreateInfos[stageCount].module = graphicsPipeline->fragmentShader->shaderModule;
+    shaderStageCreateInfos[stageCount].pName = graphicsPipeline->fragmentShader->entrypointName;
+    shaderStageCreateInfos[stageCount].pSpecializationInfo = NULL;
+    stageCount += 1;
 
     if (renderer->debugMode) {
-        if (graphicsPipeline->vertexShader->stage != SDL_GPU_SHADERSTAGE_VERTEX) {
+        if (meshShader != NULL) {
+            if (meshShader->stage != SDL_GPU_SHADERSTAGE_MESH) {
+                SDL_assert_release(!"CreateGraphicsPipeline was passed a non-mesh shader for the mesh stage");
+            }
+            if (taskShader != NULL && taskShader->stage != SDL_GPU_SHADERSTAGE_TASK) {
+                SDL_assert_release(!"CreateGraphicsPipeline was passed a non-task shader for the task stage");
+            }
+        } else if (graphicsPipeline->vertexShader->stage != SDL_GPU_SHADERSTAGE_VERTEX) {
             SDL_assert_release(!"CreateGraphicsPipeline was passed a fragment shader for the vertex stage");
         }
         if (graphicsPipeline->fragmentShader->stage != SDL_GPU_SHADERSTAGE_FRAGMENT) {
@@ -6519,6 +7433,7 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
         VULKAN_INTERNAL_FetchGraphicsPipelineResourceLayout(
             renderer,
             graphicsPipeline->vertexShader,
+            graphicsPipeline->taskShader,
             graphicsPipeline->fragmentShader);
 
     if (graphicsPipeline->resourceLayout == NULL) {
@@ -6532,12 +7447,13 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     // Pipeline
 
     vkPipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    vkPipelineCreateInfo.pNext = NULL;
+    vkPipelineCreateInfo.pNext = renderer->supports.KHR_dynamic_rendering ? &renderingCreateInfo : NULL;
     vkPipelineCreateInfo.flags = 0;
-    vkPipelineCreateInfo.stageCount = 2;
+    vkPipelineCreateInfo.stageCount = stageCount;
     vkPipelineCreateInfo.pStages = shaderStageCreateInfos;
-    vkPipelineCreateInfo.pVertexInputState = &vertexInputStateCreateInfo;
-    vkPipelineCreateInfo.pInputAssemblyState = &inputAssemblyStateCreateInfo;
+    // Mesh pipelines generate their own primitives
+    vkPipelineCreateInfo.pVertexInputState = (meshShader != NULL) ? NULL : &vertexInputStateCreateInfo;
+    vkPipelineCreateInfo.pInputAssemblyState = (meshShader != NULL) ? NULL : &inputAssemblyStateCreateInfo;
     vkPipelineCreateInfo.pTessellationState = VK_NULL_HANDLE;
     vkPipelineCreateInfo.pViewportState = &viewportStateCreateInfo;
     vkPipelineCreateInfo.pRasterizationState = &rasterizationStateCreateInfo;
@@ -6551,10 +7467,9 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     vkPipelineCreateInfo.basePipelineIndex = 0;
 
-    // TODO: enable pipeline caching
     vulkanResult = renderer->vkCreateGraphicsPipelines(
         renderer->logicalDevice,
-        VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkPipelineCreateInfo,
         NULL,
@@ -6564,10 +7479,12 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     SDL_stack_free(vertexInputAttributeDescriptions);
     SDL_stack_free(colorBlendAttachmentStates);
 
-    renderer->vkDestroyRenderPass(
-        renderer->logicalDevice,
-        transientRenderPass,
-        NULL);
+    if (transientRenderPass != VK_NULL_HANDLE) {
+        renderer->vkDestroyRenderPass(
+            renderer->logicalDevice,
+            transientRenderPass,
+            NULL);
+    }
 
     if (vulkanResult != VK_SUCCESS) {
         SDL_free(graphicsPipeline);
@@ -6598,6 +7515,7 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     graphicsPipeline->header.num_fragment_storage_buffers = graphicsPipeline->resourceLayout->fragmentStorageBufferCount;
     graphicsPipeline->header.num_fragment_storage_textures = graphicsPipeline->resourceLayout->fragmentStorageTextureCount;
     graphicsPipeline->header.num_fragment_uniform_buffers = graphicsPipeline->resourceLayout->fragmentUniformBufferCount;
+    graphicsPipeline->header.mesh_pipeline = (meshShader != NULL);
 
     return (SDL_GPUGraphicsPipeline *)graphicsPipeline;
 }
@@ -6666,7 +7584,7 @@ static SDL_GPUComputePipeline *VULKAN_CreateComputePipeline(
 
     vulkanResult = renderer->vkCreateComputePipelines(
         renderer->logicalDevice,
-        (VkPipelineCache)VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkShaderCreateInfo,
         NULL,
@@ -6828,6 +7746,101 @@ static bool VULKAN_SupportsSampleCount(
     return !!(bits & vkSampleCount);
 }
 
+static void *VULKAN_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkResult vulkanResult;
+    size_t dataSize = 0;
+    void *data;
+
+    if (renderer->pipelineCache == VK_NULL_HANDLE) {
+        SET_STRING_ERROR_AND_RETURN("Pipeline cache is not available", NULL);
+    }
+
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        &dataSize,
+        NULL);
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+
+    // Always return a valid allocation, even for an empty cache
+    data = SDL_malloc(dataSize ? dataSize : 1);
+    if (!data) {
+        return NULL;
+    }
+
+    // The cache may have grown between the calls; VK_INCOMPLETE still writes a valid prefix
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        &dataSize,
+        data);
+    if (vulkanResult != VK_SUCCESS && vulkanResult != VK_INCOMPLETE) {
+        SDL_free(data);
+        CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+    }
+
+    *size = dataSize;
+    return data;
+}
+
+// Memory Statistics
+
+static SDL_GPUMemoryHeapStats *VULKAN_GetMemoryHeapStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkDeviceSize heapBudgets[VK_MAX_MEMORY_HEAPS];
+    VkDeviceSize heapUsages[VK_MAX_MEMORY_HEAPS];
+    SDL_GPUMemoryHeapStats *stats;
+    Uint32 heapCount = renderer->memoryProperties.memoryHeapCount;
+    Uint32 i, j, k;
+
+    stats = (SDL_GPUMemoryHeapStats *)SDL_calloc(heapCount, sizeof(SDL_GPUMemoryHeapStats));
+    if (!stats) {
+        return NULL;
+    }
+
+    SDL_LockMutex(renderer->allocatorLock);
+
+    VULKAN_INTERNAL_GetMemoryBudget(renderer, heapBudgets, heapUsages);
+
+    for (i = 0; i < heapCount; i += 1) {
+        stats[i].size = renderer->memoryProperties.memoryHeaps[i].size;
+        stats[i].budget = heapBudgets[i];
+        stats[i].usage = heapUsages[i];
+        stats[i].device_local = (renderer->memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    for (i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1) {
+        VulkanMemorySubAllocator *allocator = &renderer->memoryAllocator->subAllocators[i];
+        SDL_GPUMemoryHeapStats *heapStats = &stats[renderer->memoryProperties.memoryTypes[i].heapIndex];
+
+        for (j = 0; j < allocator->allocationCount; j += 1) {
+            VulkanMemoryAllocation *allocation = allocator->allocations[j];
+            VkDeviceSize largestFreeRegion = 0;
+
+            for (k = 0; k < allocation->freeRegionCount; k += 1) {
+                largestFreeRegion = SDL_max(largestFreeRegion, allocation->freeRegions[k]->size);
+            }
+
+            heapStats->allocated += allocation->size;
+            heapStats->used += allocation->usedSpace;
+            heapStats->fragmented += allocation->freeSpace - largestFreeRegion;
+            heapStats->allocation_count += 1;
+        }
+    }
+
+    SDL_UnlockMutex(renderer->allocatorLock);
+
+    *count = (int)heapCount;
+    return stats;
+}
+
 static SDL_GPUTexture *VULKAN_CreateTexture(
     SDL_GPURenderer *driverData,
     const SDL_GPUTextureCreateInfo *createinfo)
@@ -6854,7 +7867,8 @@ static SDL_GPUTexture *VULKAN_CreateTexture(
         SDL_CopyProperties(createinfo->props, container->header.info.props);
     }
 
-    container->canBeCycled = true;
+    // A cycled sparse texture would lose its committed tiles
+    container->canBeCycled = texture->sparse == NULL;
     container->activeTexture = texture;
     container->textureCapacity = 1;
     container->textureCount = 1;
@@ -6873,6 +7887,139 @@ static SDL_GPUTexture *VULKAN_CreateTexture(
     return (SDL_GPUTexture *)container;
 }
 
+static bool VULKAN_GetSparseTextureInfo(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTexture *texture,
+    Uint32 *tileWidth,
+    Uint32 *tileHeight,
+    Uint32 *tileDepth,
+    Uint32 *numTiledLevels)
+{
+    VulkanSparseResidency *sparse = ((VulkanTextureContainer *)texture)->activeTexture->sparse;
+    (void)driverData;
+
+    *tileWidth = sparse->tileExtent.width;
+    *tileHeight = sparse->tileExtent.height;
+    *tileDepth = sparse->tileExtent.depth;
+    *numTiledLevels = sparse->tiledLevelCount;
+
+    return true;
+}
+
+static bool VULKAN_CommitTextureTiles(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureRegion *region,
+    bool commit)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanTexture *texture = ((VulkanTextureContainer *)region->texture)->activeTexture;
+    VulkanSparseResidency *sparse = texture->sparse;
+    VkSparseImageMemoryBind *binds;
+    Uint32 bindCount = 0;
+    Uint32 tilesX, tilesY, tilesZ;
+    Uint32 levelWidth, levelHeight, levelDepth;
+    Uint32 firstX, firstY, firstZ, lastX, lastY, lastZ;
+    Uint32 layer = (sparse->depth > 1) ? 0 : region->layer;
+    Uint32 *levelSlots;
+    bool result = true;
+
+    // The mip tail is always resident
+    if (region->mip_level >= sparse->tiledLevelCount) {
+        return true;
+    }
+
+    VULKAN_INTERNAL_GetSparseLevelTiles(sparse, region->mip_level, &tilesX, &tilesY, &tilesZ);
+    levelWidth = SDL_max(sparse->width >> region->mip_level, 1);
+    levelHeight = SDL_max(sparse->height >> region->mip_level, 1);
+    levelDepth = SDL_max(sparse->depth >> region->mip_level, 1);
+
+    // Every tile the region touches is affected
+    firstX = region->x / sparse->tileExtent.width;
+    firstY = region->y / sparse->tileExtent.height;
+    firstZ = region->z / sparse->tileExtent.depth;
+    lastX = SDL_min((region->x + region->w + sparse->tileExtent.width - 1) / sparse->tileExtent.width, tilesX);
+    lastY = SDL_min((region->y + region->h + sparse->tileExtent.height - 1) / sparse->tileExtent.height, tilesY);
+    lastZ = SDL_min((region->z + region->d + sparse->tileExtent.depth - 1) / sparse->tileExtent.depth, tilesZ);
+
+    if (firstX >= lastX || firstY >= lastY || firstZ >= lastZ) {
+        return true;
+    }
+
+    binds = SDL_malloc((lastX - firstX) * (lastY - firstY) * (lastZ - firstZ) * sizeof(VkSparseImageMemoryBind));
+    levelSlots = &sparse->tileSlots[sparse->levelTileOffsets[(layer * sparse->tiledLevelCount) + region->mip_level]];
+
+    SDL_LockMutex(sparse->lock);
+
+    for (Uint32 z = firstZ; z < lastZ && result; z += 1) {
+        for (Uint32 y = firstY; y < lastY && result; y += 1) {
+            for (Uint32 x = firstX; x < lastX; x += 1) {
+                Uint32 *slot = &levelSlots[(((z * tilesY) + y) * tilesX) + x];
+                VkSparseImageMemoryBind *bind;
+
+                if (commit == (*slot != SPARSE_TILE_NOT_RESIDENT)) {
+                    continue;
+                }
+
+                bind = &binds[bindCount];
+
+                if (commit) {
+                    if (sparse->freeSlotCount == 0 && !VULKAN_INTERNAL_AddSparsePage(renderer, sparse)) {
+                        // Bind what we have so the tile table stays accurate
+                        result = false;
+                        break;
+                    }
+
+                    sparse->freeSlotCount -= 1;
+                    *slot = sparse->freeSlots[sparse->freeSlotCount];
+                    bind->memory = sparse->pages[*slot / SPARSE_TILES_PER_PAGE];
+                    bind->memoryOffset = (*slot % SPARSE_TILES_PER_PAGE) * sparse->tileSize;
+                } else {
+                    sparse->freeSlots[sparse->freeSlotCount] = *slot;
+                    sparse->freeSlotCount += 1;
+                    *slot = SPARSE_TILE_NOT_RESIDENT;
+                    bind->memory = VK_NULL_HANDLE;
+                    bind->memoryOffset = 0;
+                }
+
+                bind->subresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                bind->subresource.mipLevel = region->mip_level;
+                bind->subresource.arrayLayer = layer;
+                bind->offset.x = (Sint32)(x * sparse->tileExtent.width);
+                bind->offset.y = (Sint32)(y * sparse->tileExtent.height);
+                bind->offset.z = (Sint32)(z * sparse->tileExtent.depth);
+                bind->extent.width = SDL_min(sparse->tileExtent.width, levelWidth - (x * sparse->tileExtent.width));
+                bind->extent.height = SDL_min(sparse->tileExtent.height, levelHeight - (y * sparse->tileExtent.height));
+                bind->extent.depth = SDL_min(sparse->tileExtent.depth, levelDepth - (z * sparse->tileExtent.depth));
+                bind->flags = 0;
+                bindCount += 1;
+            }
+        }
+    }
+
+    if (bindCount > 0) {
+        VkSparseImageMemoryBindInfo imageBindInfo;
+        VkBindSparseInfo bindInfo;
+
+        imageBindInfo.image = texture->image;
+        imageBindInfo.bindCount = bindCount;
+        imageBindInfo.pBinds = binds;
+
+        SDL_zero(bindInfo);
+        bindInfo.sType = VK_STRUCTURE_TYPE_BIND_SPARSE_INFO;
+        bindInfo.imageBindCount = 1;
+        bindInfo.pImageBinds = &imageBindInfo;
+
+        if (!VULKAN_INTERNAL_QueueBindSparse(renderer, &bindInfo)) {
+            result = false;
+        }
+    }
+
+    SDL_UnlockMutex(sparse->lock);
+    SDL_free(binds);
+
+    return result;
+}
+
 static SDL_GPUBuffer *VULKAN_CreateBuffer(
     SDL_GPURenderer *driverData,
     SDL_GPUBufferUsageFlags usageFlags,
@@ -7397,7 +8544,7 @@ static void VULKAN_INTERNAL_SetCurrentViewport(
         &vulkanCommandBuffer->currentViewport);
 }
 
-static void VULKAN_SetViewport(
+SDL_GPU_DIRECT void VULKAN_SetViewport(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUViewport *viewport)
 {
@@ -7426,7 +8573,7 @@ static void VULKAN_INTERNAL_SetCurrentScissor(
         &vulkanCommandBuffer->currentScissor);
 }
 
-static void VULKAN_SetScissor(
+SDL_GPU_DIRECT void VULKAN_SetScissor(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_Rect *scissor)
 {
@@ -7453,7 +8600,7 @@ static void VULKAN_INTERNAL_SetCurrentBlendConstants(
         vulkanCommandBuffer->blendConstants);
 }
 
-static void VULKAN_SetBlendConstants(
+SDL_GPU_DIRECT void VULKAN_SetBlendConstants(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_FColor blendConstants)
 {
@@ -7478,7 +8625,7 @@ static void VULKAN_INTERNAL_SetCurrentStencilReference(
         vulkanCommandBuffer->stencilRef);
 }
 
-static void VULKAN_SetStencilReference(
+SDL_GPU_DIRECT void VULKAN_SetStencilReference(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint8 reference)
 {
@@ -7489,7 +8636,7 @@ static void VULKAN_SetStencilReference(
         reference);
 }
 
-static void VULKAN_BindVertexSamplers(
+SDL_GPU_DIRECT void VULKAN_BindVertexSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -7521,7 +8668,7 @@ static void VULKAN_BindVertexSamplers(
     }
 }
 
-static void VULKAN_BindVertexStorageTextures(
+SDL_GPU_DIRECT void VULKAN_BindVertexStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -7543,7 +8690,7 @@ static void VULKAN_BindVertexStorageTextures(
     }
 }
 
-static void VULKAN_BindVertexStorageBuffers(
+SDL_GPU_DIRECT void VULKAN_BindVertexStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -7565,7 +8712,7 @@ static void VULKAN_BindVertexStorageBuffers(
     }
 }
 
-static void VULKAN_BindFragmentSamplers(
+SDL_GPU_DIRECT void VULKAN_BindFragmentSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -7597,7 +8744,7 @@ static void VULKAN_BindFragmentSamplers(
     }
 }
 
-static void VULKAN_BindFragmentStorageTextures(
+SDL_GPU_DIRECT void VULKAN_BindFragmentStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -7619,7 +8766,7 @@ static void VULKAN_BindFragmentStorageTextures(
     }
 }
 
-static void VULKAN_BindFragmentStorageBuffers(
+SDL_GPU_DIRECT void VULKAN_BindFragmentStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -7647,39 +8794,51 @@ static VulkanUniformBuffer *VULKAN_INTERNAL_AcquireUniformBufferFromPool(
     VulkanCommandBuffer *commandBuffer)
 {
     VulkanRenderer *renderer = commandBuffer->renderer;
-    VulkanUniformBuffer *uniformBuffer;
-
-    SDL_LockMutex(renderer->acquireUniformBufferLock);
+    VulkanCommandPool *commandPool = commandBuffer->commandPool;
+    VulkanUniformBuffer *uniformBuffer = NULL;
 
-    if (renderer->uniformBufferPoolCount > 0) {
-        uniformBuffer = renderer->uniformBufferPool[renderer->uniformBufferPoolCount - 1];
-        renderer->uniformBufferPoolCount -= 1;
-    } else {
-        uniformBuffer = VULKAN_INTERNAL_CreateUniformBuffer(
-            renderer,
-            UNIFORM_BUFFER_SIZE);
+    // Prefer a buffer released by this thread's command buffers
+    SDL_LockMutex(commandPool->lock);
+    if (commandPool->inactiveUniformBufferCount > 0) {
+        uniformBuffer = commandPool->inactiveUniformBuffers[commandPool->inactiveUniformBufferCount - 1];
+        commandPool->inactiveUniformBufferCount -= 1;
     }
+    SDL_UnlockMutex(commandPool->lock);
 
-    SDL_UnlockMutex(renderer->acquireUniformBufferLock);
+    if (!uniformBuffer) {
+        SDL_LockMutex(renderer->acquireUniformBufferLock);
+
+        if (renderer->uniformBufferPoolCount > 0) {
+            uniformBuffer = renderer->uniformBufferPool[renderer->uniformBufferPoolCount - 1];
+            renderer->uniformBufferPoolCount -= 1;
+        } else {
+            uniformBuffer = VULKAN_INTERNAL_CreateUniformBuffer(
+                renderer,
+                UNIFORM_BUFFER_SIZE);
+        }
+
+        SDL_UnlockMutex(renderer->acquireUniformBufferLock);
+    }
 
     VULKAN_INTERNAL_TrackUniformBuffer(commandBuffer, uniformBuffer);
 
     return uniformBuffer;
 }
 
+// Must be called with commandPool->lock held
 static void VULKAN_INTERNAL_ReturnUniformBufferToPool(
-    VulkanRenderer *renderer,
+    VulkanCommandPool *commandPool,
     VulkanUniformBuffer *uniformBuffer)
 {
-    if (renderer->uniformBufferPoolCount >= renderer->uniformBufferPoolCapacity) {
-        renderer->uniformBufferPoolCapacity *= 2;
-        renderer->uniformBufferPool = SDL_realloc(
-            renderer->uniformBufferPool,
-            renderer->uniformBufferPoolCapacity * sizeof(VulkanUniformBuffer *));
-    }
+    EXPAND_ARRAY_IF_NEEDED(
+        commandPool->inactiveUniformBuffers,
+        VulkanUniformBuffer *,
+        commandPool->inactiveUniformBufferCount + 1,
+        commandPool->inactiveUniformBufferCapacity,
+        commandPool->inactiveUniformBufferCapacity * 2 + 8);
 
-    renderer->uniformBufferPool[renderer->uniformBufferPoolCount] = uniformBuffer;
-    renderer->uniformBufferPoolCount += 1;
+    commandPool->inactiveUniformBuffers[commandPool->inactiveUniformBufferCount] = uniformBuffer;
+    commandPool->inactiveUniformBufferCount += 1;
 
     uniformBuffer->writeOffset = 0;
     uniformBuffer->drawOffset = 0;
@@ -7770,6 +8929,124 @@ static void VULKAN_INTERNAL_PushUniformData(
     }
 }
 
+static VkResolveModeFlagBits VULKAN_INTERNAL_GetResolveMode(SDL_GPUTextureFormat format)
+{
+    // Integer formats cannot be averaged, render pass resolves use sample zero for them too
+    switch (format) {
+    case SDL_GPU_TEXTUREFORMAT_R8_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R8G8_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R16_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R16G16_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R16G16B16A16_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R32_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R32G32_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R32G32B32A32_UINT:
+    case SDL_GPU_TEXTUREFORMAT_R8_INT:
+    case SDL_GPU_TEXTUREFORMAT_R8G8_INT:
+    case SDL_GPU_TEXTUREFORMAT_R8G8B8A8_INT:
+    case SDL_GPU_TEXTUREFORMAT_R16_INT:
+    case SDL_GPU_TEXTUREFORMAT_R16G16_INT:
+    case SDL_GPU_TEXTUREFORMAT_R16G16B16A16_INT:
+    case SDL_GPU_TEXTUREFORMAT_R32_INT:
+    case SDL_GPU_TEXTUREFORMAT_R32G32_INT:
+    case SDL_GPU_TEXTUREFORMAT_R32G32B32A32_INT:
+        return VK_RESOLVE_MODE_SAMPLE_ZERO_BIT_KHR;
+    default:
+        return VK_RESOLVE_MODE_AVERAGE_BIT_KHR;
+    }
+}
+
+/* Begins the pass with vkCmdBeginRenderingKHR. The attachments have already
+ * been transitioned, so this needs no render pass or framebuffer objects and
+ * never touches their caches.
+ */
+static void VULKAN_INTERNAL_BeginRendering(
+    VulkanRenderer *renderer,
+    VulkanCommandBuffer *commandBuffer,
+    const SDL_GPUColorTargetInfo *colorTargetInfos,
+    Uint32 numColorTargets,
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo,
+    Uint32 width,
+    Uint32 height)
+{
+    VkRenderingAttachmentInfoKHR colorAttachments[MAX_COLOR_TARGET_BINDINGS];
+    VkRenderingAttachmentInfoKHR depthAttachment;
+    VkRenderingAttachmentInfoKHR stencilAttachment;
+    VkRenderingInfoKHR renderingInfo;
+    Uint32 resolveIndex = 0;
+    Uint32 i;
+
+    for (i = 0; i < numColorTargets; i += 1) {
+        VulkanTextureContainer *container = (VulkanTextureContainer *)colorTargetInfos[i].texture;
+        Uint32 rtvIndex =
+            container->header.info.type == SDL_GPU_TEXTURETYPE_3D ? colorTargetInfos[i].layer_or_depth_plane : 0;
+
+        colorAttachments[i].sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        colorAttachments[i].pNext = NULL;
+        colorAttachments[i].imageView = commandBuffer->colorAttachmentSubresources[i]->renderTargetViews[rtvIndex];
+        colorAttachments[i].imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachments[i].resolveMode = VK_RESOLVE_MODE_NONE_KHR;
+        colorAttachments[i].resolveImageView = VK_NULL_HANDLE;
+        colorAttachments[i].resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        colorAttachments[i].loadOp = SDLToVK_LoadOp[colorTargetInfos[i].load_op];
+        colorAttachments[i].storeOp = SDLToVK_StoreOp[colorTargetInfos[i].store_op];
+        colorAttachments[i].clearValue.color.float32[0] = colorTargetInfos[i].clear_color.r;
+        colorAttachments[i].clearValue.color.float32[1] = colorTargetInfos[i].clear_color.g;
+        colorAttachments[i].clearValue.color.float32[2] = colorTargetInfos[i].clear_color.b;
+        colorAttachments[i].clearValue.color.float32[3] = colorTargetInfos[i].clear_color.a;
+
+        if (colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE || colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE_AND_STORE) {
+            colorAttachments[i].resolveMode = VULKAN_INTERNAL_GetResolveMode(container->header.info.format);
+            colorAttachments[i].resolveImageView = commandBuffer->resolveAttachmentSubresources[resolveIndex]->renderTargetViews[0];
+            colorAttachments[i].resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            resolveIndex += 1;
+        }
+    }
+
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+    renderingInfo.pNext = NULL;
+    renderingInfo.flags = 0;
+    renderingInfo.renderArea.offset.x = 0;
+    renderingInfo.renderArea.offset.y = 0;
+    renderingInfo.renderArea.extent.width = width;
+    renderingInfo.renderArea.extent.height = height;
+    renderingInfo.layerCount = 1;
+    renderingInfo.viewMask = 0;
+    renderingInfo.colorAttachmentCount = numColorTargets;
+    renderingInfo.pColorAttachments = colorAttachments;
+    renderingInfo.pDepthAttachment = NULL;
+    renderingInfo.pStencilAttachment = NULL;
+
+    if (depthStencilTargetInfo != NULL) {
+        VulkanTextureContainer *container = (VulkanTextureContainer *)depthStencilTargetInfo->texture;
+
+        depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+        depthAttachment.pNext = NULL;
+        depthAttachment.imageView = commandBuffer->depthStencilAttachmentSubresource->depthStencilView;
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.resolveMode = VK_RESOLVE_MODE_NONE_KHR;
+        depthAttachment.resolveImageView = VK_NULL_HANDLE;
+        depthAttachment.resolveImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.loadOp = SDLToVK_LoadOp[depthStencilTargetInfo->load_op];
+        depthAttachment.storeOp = SDLToVK_StoreOp[depthStencilTargetInfo->store_op];
+        depthAttachment.clearValue.depthStencil.depth = depthStencilTargetInfo->clear_depth;
+        depthAttachment.clearValue.depthStencil.stencil = depthStencilTargetInfo->clear_stencil;
+        renderingInfo.pDepthAttachment = &depthAttachment;
+
+        if (IsStencilFormat(container->header.info.format)) {
+            stencilAttachment = depthAttachment;
+            stencilAttachment.loadOp = SDLToVK_LoadOp[depthStencilTargetInfo->stencil_load_op];
+            stencilAttachment.storeOp = SDLToVK_StoreOp[depthStencilTargetInfo->stencil_store_op];
+            renderingInfo.pStencilAttachment = &stencilAttachment;
+        }
+    }
+
+    renderer->vkCmdBeginRenderingKHR(
+        commandBuffer->commandBuffer,
+        &renderingInfo);
+}
+
 static void VULKAN_BeginRenderPass(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUColorTargetInfo *colorTargetInfos,
@@ -7878,77 +9155,88 @@ static void VULKAN_BeginRenderPass(
         clearCount += 1;
     }
 
-    // Fetch required render objects
+    if (renderer->supports.KHR_dynamic_rendering) {
+        VULKAN_INTERNAL_BeginRendering(
+            renderer,
+            vulkanCommandBuffer,
+            colorTargetInfos,
+            numColorTargets,
+            depthStencilTargetInfo,
+            framebufferWidth,
+            framebufferHeight);
+    } else {
+        // Fetch required render objects
 
-    renderPass = VULKAN_INTERNAL_FetchRenderPass(
-        renderer,
-        vulkanCommandBuffer,
-        colorTargetInfos,
-        numColorTargets,
-        depthStencilTargetInfo);
+        renderPass = VULKAN_INTERNAL_FetchRenderPass(
+            renderer,
+            vulkanCommandBuffer,
+            colorTargetInfos,
+            numColorTargets,
+            depthStencilTargetInfo);
 
-    if (renderPass == VK_NULL_HANDLE) {
-        return;
-    }
+        if (renderPass == VK_NULL_HANDLE) {
+            return;
+        }
 
-    framebuffer = VULKAN_INTERNAL_FetchFramebuffer(
-        renderer,
-        renderPass,
-        colorTargetInfos,
-        numColorTargets,
-        depthStencilTargetInfo,
-        framebufferWidth,
-        framebufferHeight);
+        framebuffer = VULKAN_INTERNAL_FetchFramebuffer(
+            renderer,
+            renderPass,
+            colorTargetInfos,
+            numColorTargets,
+            depthStencilTargetInfo,
+            framebufferWidth,
+            framebufferHeight);
+
+        if (framebuffer == NULL) {
+            return;
+        }
 
-    if (framebuffer == NULL) {
-        return;
-    }
+        VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
 
-    VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
+        // Set clear values
 
-    // Set clear values
+        clearValues = SDL_stack_alloc(VkClearValue, clearCount);
 
-    clearValues = SDL_stack_alloc(VkClearValue, clearCount);
+        int clearIndex = 0;
+        for (i = 0; i < numColorTargets; i += 1) {
+            clearValues[clearIndex].color.float32[0] = colorTargetInfos[i].clear_color.r;
+            clearValues[clearIndex].color.float32[1] = colorTargetInfos[i].clear_color.g;
+            clearValues[clearIndex].color.float32[2] = colorTargetInfos[i].clear_color.b;
+            clearValues[clearIndex].color.float32[3] = colorTargetInfos[i].clear_color.a;
+            clearIndex += 1;
 
-    int clearIndex = 0;
-    for (i = 0; i < numColorTargets; i += 1) {
-        clearValues[clearIndex].color.float32[0] = colorTargetInfos[i].clear_color.r;
-        clearValues[clearIndex].color.float32[1] = colorTargetInfos[i].clear_color.g;
-        clearValues[clearIndex].color.float32[2] = colorTargetInfos[i].clear_color.b;
-        clearValues[clearIndex].color.float32[3] = colorTargetInfos[i].clear_color.a;
-        clearIndex += 1;
+            if (colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE || colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE_AND_STORE) {
+                // Skip over the resolve texture, we're not clearing it
+                clearIndex += 1;
+            }
+        }
 
-        if (colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE || colorTargetInfos[i].store_op == SDL_GPU_STOREOP_RESOLVE_AND_STORE) {
-            // Skip over the resolve texture, we're not clearing it
-            clearIndex += 1;
+        if (depthStencilTargetInfo != NULL) {
+            clearValues[totalColorAttachmentCount].depthStencil.depth =
+                depthStencilTargetInfo->clear_depth;
+            clearValues[totalColorAttachmentCount].depthStencil.stencil =
+                depthStencilTargetInfo->clear_stencil;
         }
-    }
 
-    if (depthStencilTargetInfo != NULL) {
-        clearValues[totalColorAttachmentCount].depthStencil.depth =
-            depthStencilTargetInfo->clear_depth;
-        clearValues[totalColorAttachmentCount].depthStencil.stencil =
-            depthStencilTargetInfo->clear_stencil;
-    }
-
-    VkRenderPassBeginInfo renderPassBeginInfo;
-    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassBeginInfo.pNext = NULL;
-    renderPassBeginInfo.renderPass = renderPass;
-    renderPassBeginInfo.framebuffer = framebuffer->framebuffer;
-    renderPassBeginInfo.pClearValues = clearValues;
-    renderPassBeginInfo.clearValueCount = clearCount;
-    renderPassBeginInfo.renderArea.extent.width = framebufferWidth;
-    renderPassBeginInfo.renderArea.extent.height = framebufferHeight;
-    renderPassBeginInfo.renderArea.offset.x = 0;
-    renderPassBeginInfo.renderArea.offset.y = 0;
-
-    renderer->vkCmdBeginRenderPass(
-        vulkanCommandBuffer->commandBuffer,
-        &renderPassBeginInfo,
-        VK_SUBPASS_CONTENTS_INLINE);
+        VkRenderPassBeginInfo renderPassBeginInfo;
+        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.pNext = NULL;
+        renderPassBeginInfo.renderPass = renderPass;
+        renderPassBeginInfo.framebuffer = framebuffer->framebuffer;
+        renderPassBeginInfo.pClearValues = clearValues;
+        renderPassBeginInfo.clearValueCount = clearCount;
+        renderPassBeginInfo.renderArea.extent.width = framebufferWidth;
+        renderPassBeginInfo.renderArea.extent.height = framebufferHeight;
+        renderPassBeginInfo.renderArea.offset.x = 0;
+        renderPassBeginInfo.renderArea.offset.y = 0;
+
+        renderer->vkCmdBeginRenderPass(
+            vulkanCommandBuffer->commandBuffer,
+            &renderPassBeginInfo,
+            VK_SUBPASS_CONTENTS_INLINE);
 
-    SDL_stack_free(clearValues);
+        SDL_stack_free(clearValues);
+    }
 
     // Set sensible default states
 
@@ -7986,7 +9274,7 @@ static void VULKAN_BeginRenderPass(
         0);
 }
 
-static void VULKAN_BindGraphicsPipeline(
+SDL_GPU_DIRECT void VULKAN_BindGraphicsPipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUGraphicsPipeline *graphicsPipeline)
 {
@@ -8027,7 +9315,7 @@ static void VULKAN_BindGraphicsPipeline(
     vulkanCommandBuffer->needNewFragmentUniformOffsets = true;
 }
 
-static void VULKAN_BindVertexBuffers(
+SDL_GPU_DIRECT void VULKAN_BindVertexBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUBufferBinding *bindings,
@@ -8050,7 +9338,7 @@ static void VULKAN_BindVertexBuffers(
         SDL_max(vulkanCommandBuffer->vertexBufferCount, firstSlot + numBindings);
 }
 
-static void VULKAN_BindIndexBuffer(
+SDL_GPU_DIRECT void VULKAN_BindIndexBuffer(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUBufferBinding *binding,
     SDL_GPUIndexElementSize indexElementSize)
@@ -8068,7 +9356,7 @@ static void VULKAN_BindIndexBuffer(
         SDLToVK_IndexType[indexElementSize]);
 }
 
-static void VULKAN_PushVertexUniformData(
+SDL_GPU_DIRECT void VULKAN_PushVertexUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -8084,7 +9372,7 @@ static void VULKAN_PushVertexUniformData(
         length);
 }
 
-static void VULKAN_PushFragmentUniformData(
+SDL_GPU_DIRECT void VULKAN_PushFragmentUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -8107,8 +9395,13 @@ static void VULKAN_EndRenderPass(
     VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
     Uint32 i;
 
-    renderer->vkCmdEndRenderPass(
-        vulkanCommandBuffer->commandBuffer);
+    if (renderer->supports.KHR_dynamic_rendering) {
+        renderer->vkCmdEndRenderingKHR(
+            vulkanCommandBuffer->commandBuffer);
+    } else {
+        renderer->vkCmdEndRenderPass(
+            vulkanCommandBuffer->commandBuffer);
+    }
 
     for (i = 0; i < vulkanCommandBuffer->colorAttachmentSubresourceCount; i += 1) {
         VULKAN_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
@@ -8216,7 +9509,7 @@ static void VULKAN_BeginComputePass(
     }
 }
 
-static void VULKAN_BindComputePipeline(
+SDL_GPU_DIRECT void VULKAN_BindComputePipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUComputePipeline *computePipeline)
 {
@@ -8248,7 +9541,7 @@ static void VULKAN_BindComputePipeline(
     vulkanCommandBuffer->needNewComputeUniformOffsets = true;
 }
 
-static void VULKAN_BindComputeSamplers(
+SDL_GPU_DIRECT void VULKAN_BindComputeSamplers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     const SDL_GPUTextureSamplerBinding *textureSamplerBindings,
@@ -8280,7 +9573,7 @@ static void VULKAN_BindComputeSamplers(
     }
 }
 
-static void VULKAN_BindComputeStorageTextures(
+SDL_GPU_DIRECT void VULKAN_BindComputeStorageTextures(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUTexture *const *storageTextures,
@@ -8321,7 +9614,7 @@ static void VULKAN_BindComputeStorageTextures(
     }
 }
 
-static void VULKAN_BindComputeStorageBuffers(
+SDL_GPU_DIRECT void VULKAN_BindComputeStorageBuffers(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 firstSlot,
     SDL_GPUBuffer *const *storageBuffers,
@@ -8361,7 +9654,7 @@ static void VULKAN_BindComputeStorageBuffers(
     }
 }
 
-static void VULKAN_PushComputeUniformData(
+SDL_GPU_DIRECT void VULKAN_PushComputeUniformData(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 slotIndex,
     const void *data,
@@ -8412,78 +9705,86 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
     if (commandBuffer->needNewComputeReadOnlyDescriptorSet) {
         descriptorSetLayout = resourceLayout->descriptorSetLayouts[0];
 
-        commandBuffer->computeReadOnlyDescriptorSet = VULKAN_INTERNAL_FetchDescriptorSet(
-            renderer,
-            commandBuffer,
-            descriptorSetLayout);
-
-        for (Uint32 i = 0; i < resourceLayout->numSamplers; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
-
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
-
-            imageInfos[imageInfoCount].sampler = commandBuffer->computeSamplerBindings[i];
-            imageInfos[imageInfoCount].imageView = commandBuffer->computeSamplerTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
-
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+        if (!VULKAN_INTERNAL_FetchReusableDescriptorSet(
+                renderer,
+                commandBuffer,
+                descriptorSetLayout,
+                resourceLayout->numSamplers,
+                commandBuffer->computeSamplerBindings,
+                commandBuffer->computeSamplerTextureViewBindings,
+                resourceLayout->numReadonlyStorageTextures,
+                commandBuffer->readOnlyComputeStorageTextureViewBindings,
+                resourceLayout->numReadonlyStorageBuffers,
+                commandBuffer->readOnlyComputeStorageBufferBindings,
+                &commandBuffer->computeReadOnlyDescriptorSet)) {
+            for (Uint32 i = 0; i < resourceLayout->numSamplers; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
+
+                imageInfos[imageInfoCount].sampler = commandBuffer->computeSamplerBindings[i];
+                imageInfos[imageInfoCount].imageView = commandBuffer->computeSamplerTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->numReadonlyStorageTextures; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->numReadonlyStorageTextures; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring the readonly storage texture as a sampled image, because shaders are stupid.
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->numSamplers + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pBufferInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE; // Yes, we are declaring the readonly storage texture as a sampled image, because shaders are stupid.
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->numSamplers + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pBufferInfo = NULL;
 
-            imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
-            imageInfos[imageInfoCount].imageView = commandBuffer->readOnlyComputeStorageTextureViewBindings[i];
-            imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+                imageInfos[imageInfoCount].sampler = VK_NULL_HANDLE;
+                imageInfos[imageInfoCount].imageView = commandBuffer->readOnlyComputeStorageTextureViewBindings[i];
+                imageInfos[imageInfoCount].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
-            currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
+                currentWriteDescriptorSet->pImageInfo = &imageInfos[imageInfoCount];
 
-            writeCount += 1;
-            imageInfoCount += 1;
-        }
+                writeCount += 1;
+                imageInfoCount += 1;
+            }
 
-        for (Uint32 i = 0; i < resourceLayout->numReadonlyStorageBuffers; i += 1) {
-            VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
+            for (Uint32 i = 0; i < resourceLayout->numReadonlyStorageBuffers; i += 1) {
+                VkWriteDescriptorSet *currentWriteDescriptorSet = &writeDescriptorSets[writeCount];
 
-            currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            currentWriteDescriptorSet->pNext = NULL;
-            currentWriteDescriptorSet->descriptorCount = 1;
-            currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-            currentWriteDescriptorSet->dstArrayElement = 0;
-            currentWriteDescriptorSet->dstBinding = resourceLayout->numSamplers + resourceLayout->numReadonlyStorageTextures + i;
-            currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
-            currentWriteDescriptorSet->pTexelBufferView = NULL;
-            currentWriteDescriptorSet->pImageInfo = NULL;
+                currentWriteDescriptorSet->sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                currentWriteDescriptorSet->pNext = NULL;
+                currentWriteDescriptorSet->descriptorCount = 1;
+                currentWriteDescriptorSet->descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                currentWriteDescriptorSet->dstArrayElement = 0;
+                currentWriteDescriptorSet->dstBinding = resourceLayout->numSamplers + resourceLayout->numReadonlyStorageTextures + i;
+                currentWriteDescriptorSet->dstSet = commandBuffer->computeReadOnlyDescriptorSet;
+                currentWriteDescriptorSet->pTexelBufferView = NULL;
+                currentWriteDescriptorSet->pImageInfo = NULL;
 
-            bufferInfos[bufferInfoCount].buffer = commandBuffer->readOnlyComputeStorageBufferBindings[i];
-            bufferInfos[bufferInfoCount].offset = 0;
-            bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
+                bufferInfos[bufferInfoCount].buffer = commandBuffer->readOnlyComputeStorageBufferBindings[i];
+                bufferInfos[bufferInfoCount].offset = 0;
+                bufferInfos[bufferInfoCount].range = VK_WHOLE_SIZE;
 
-            currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
+                currentWriteDescriptorSet->pBufferInfo = &bufferInfos[bufferInfoCount];
 
-            writeCount += 1;
-            bufferInfoCount += 1;
+                writeCount += 1;
+                bufferInfoCount += 1;
+            }
         }
 
         commandBuffer->needNewComputeReadOnlyDescriptorSet = false;
@@ -8611,7 +9912,7 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
     commandBuffer->needNewComputeUniformOffsets = false;
 }
 
-static void VULKAN_DispatchCompute(
+SDL_GPU_DIRECT void VULKAN_DispatchCompute(
     SDL_GPUCommandBuffer *commandBuffer,
     Uint32 groupcountX,
     Uint32 groupcountY,
@@ -9181,7 +10482,7 @@ static void VULKAN_EndCopyPass(
     (void)commandBuffer;
 }
 
-static void VULKAN_Blit(
+static void VULKAN_INTERNAL_Blit(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUBlitInfo *info)
 {
@@ -9297,6 +10598,17 @@ static void VULKAN_Blit(
     VULKAN_INTERNAL_TrackTexture(vulkanCommandBuffer, dstSubresource->parent);
 }
 
+static void VULKAN_Blit(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUBlitInfo *infos,
+    Uint32 numInfos)
+{
+    // vkCmdBlitImage runs outside of render passes, so there is nothing to batch
+    for (Uint32 i = 0; i < numInfos; i += 1) {
+        VULKAN_INTERNAL_Blit(commandBuffer, &infos[i]);
+    }
+}
+
 static bool VULKAN_INTERNAL_AllocateCommandBuffer(
     VulkanRenderer *renderer,
     VulkanCommandPool *vulkanCommandPool)
@@ -9344,6 +10656,12 @@ static bool VULKAN_INTERNAL_AllocateCommandBuffer(
     commandBuffer->waitSemaphoreCount = 0;
     commandBuffer->waitSemaphores = SDL_malloc(
         commandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
+    commandBuffer->waitSemaphoreStages = SDL_malloc(
+        commandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags));
+
+    commandBuffer->waitFenceCapacity = 0;
+    commandBuffer->waitFenceCount = 0;
+    commandBuffer->waitFences = NULL;
 
     commandBuffer->signalSemaphoreCapacity = 1;
     commandBuffer->signalSemaphoreCount = 0;
@@ -9423,13 +10741,15 @@ static bool VULKAN_INTERNAL_AllocateCommandBuffer(
 
 static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
     VulkanRenderer *renderer,
-    SDL_ThreadID threadID)
+    SDL_ThreadID threadID,
+    SDL_GPUQueueType queueType)
 {
     VulkanCommandPool *vulkanCommandPool = NULL;
     VkCommandPoolCreateInfo commandPoolCreateInfo;
     VkResult vulkanResult;
     CommandPoolHashTableKey key;
     key.threadID = threadID;
+    key.queueType = queueType;
 
     bool result = SDL_FindInHashTable(
         renderer->commandPoolHashTable,
@@ -9445,7 +10765,27 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
     commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     commandPoolCreateInfo.pNext = NULL;
     commandPoolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-    commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
+    if (queueType == SDL_GPU_QUEUETYPE_COMPUTE) {
+        commandPoolCreateInfo.queueFamilyIndex = renderer->computeQueueFamilyIndex;
+        vulkanCommandPool->queue = renderer->computeQueue;
+        vulkanCommandPool->supportedStages =
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT |
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+            VK_PIPELINE_STAGE_TRANSFER_BIT |
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    } else if (queueType == SDL_GPU_QUEUETYPE_TRANSFER) {
+        commandPoolCreateInfo.queueFamilyIndex = renderer->transferQueueFamilyIndex;
+        vulkanCommandPool->queue = renderer->transferQueue;
+        vulkanCommandPool->supportedStages =
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT |
+            VK_PIPELINE_STAGE_TRANSFER_BIT |
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+    } else {
+        commandPoolCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
+        vulkanCommandPool->queue = renderer->unifiedQueue;
+        vulkanCommandPool->supportedStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    }
 
     vulkanResult = renderer->vkCreateCommandPool(
         renderer->logicalDevice,
@@ -9465,6 +10805,14 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
     vulkanCommandPool->inactiveCommandBufferCount = 0;
     vulkanCommandPool->inactiveCommandBuffers = NULL;
 
+    vulkanCommandPool->lock = SDL_CreateNamedMutex("SDL_gpu_command_pool", SDL_MUTEX_NONRECURSIVE);
+    vulkanCommandPool->inactiveUniformBufferCapacity = 0;
+    vulkanCommandPool->inactiveUniformBufferCount = 0;
+    vulkanCommandPool->inactiveUniformBuffers = NULL;
+    vulkanCommandPool->inactiveDescriptorSetCacheCapacity = 0;
+    vulkanCommandPool->inactiveDescriptorSetCacheCount = 0;
+    vulkanCommandPool->inactiveDescriptorSetCaches = NULL;
+
     if (!VULKAN_INTERNAL_AllocateCommandBuffer(
         renderer,
         vulkanCommandPool)) {
@@ -9474,6 +10822,7 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
 
     CommandPoolHashTableKey *allocedKey = SDL_malloc(sizeof(CommandPoolHashTableKey));
     allocedKey->threadID = threadID;
+    allocedKey->queueType = queueType;
 
     SDL_InsertIntoHashTable(
         renderer->commandPoolHashTable,
@@ -9485,10 +10834,11 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
 
 static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
     VulkanRenderer *renderer,
-    SDL_ThreadID threadID)
+    SDL_ThreadID threadID,
+    SDL_GPUQueueType queueType)
 {
     VulkanCommandPool *commandPool =
-        VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
+        VULKAN_INTERNAL_FetchCommandPool(renderer, threadID, queueType);
     VulkanCommandBuffer *commandBuffer;
 
     if (commandPool == NULL) {
@@ -9509,10 +10859,10 @@ static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
     return commandBuffer;
 }
 
-static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
-    SDL_GPURenderer *driverData)
+static SDL_GPUCommandBuffer *VULKAN_INTERNAL_AcquireCommandBuffer(
+    VulkanRenderer *renderer,
+    SDL_GPUQueueType queueType)
 {
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
     VkResult result;
     Uint32 i;
 
@@ -9521,10 +10871,12 @@ static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
     SDL_LockMutex(renderer->acquireCommandBufferLock);
 
     VulkanCommandBuffer *commandBuffer =
-        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
+        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID, queueType);
 
-    DescriptorSetCache *descriptorSetCache =
-        VULKAN_INTERNAL_AcquireDescriptorSetCache(renderer);
+    DescriptorSetCache *descriptorSetCache = NULL;
+    if (commandBuffer != NULL) {
+        descriptorSetCache = VULKAN_INTERNAL_AcquireDescriptorSetCache(renderer, commandBuffer->commandPool);
+    }
 
     SDL_UnlockMutex(renderer->acquireCommandBufferLock);
 
@@ -9617,6 +10969,39 @@ static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
     return (SDL_GPUCommandBuffer *)commandBuffer;
 }
 
+static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
+    SDL_GPURenderer *driverData)
+{
+    return VULKAN_INTERNAL_AcquireCommandBuffer(
+        (VulkanRenderer *)driverData,
+        SDL_GPU_QUEUETYPE_GRAPHICS);
+}
+
+static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBufferForQueue(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueueType queueType)
+{
+    return VULKAN_INTERNAL_AcquireCommandBuffer(
+        (VulkanRenderer *)driverData,
+        queueType);
+}
+
+static bool VULKAN_SupportsDedicatedQueue(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueueType queueType)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    switch (queueType) {
+    case SDL_GPU_QUEUETYPE_COMPUTE:
+        return renderer->computeQueueFamilyIndex != renderer->queueFamilyIndex;
+    case SDL_GPU_QUEUETYPE_TRANSFER:
+        return renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex;
+    default:
+        return false;
+    }
+}
+
 static bool VULKAN_QueryFence(
     SDL_GPURenderer *driverData,
     SDL_GPUFence *fence)
@@ -9667,6 +11052,195 @@ static void VULKAN_ReleaseFence(
     }
 }
 
+static void VULKAN_RetainFence(
+    SDL_GPURenderer *driverData,
+    SDL_GPUFence *fence)
+{
+    (void)driverData;
+    SDL_AtomicIncRef(&((VulkanFenceHandle *)fence)->referenceCount);
+}
+
+// Queries
+
+static SDL_GPUQueryPool *VULKAN_CreateQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryType type,
+    Uint32 numQueries)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanQueryPool *queryPool;
+    VkQueryPoolCreateInfo createInfo;
+    VkResult vulkanResult;
+
+    SDL_zero(createInfo);
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryCount = numQueries;
+
+    if (type == SDL_GPU_QUERYTYPE_TIMESTAMP) {
+        if (renderer->timestampValidBits == 0) {
+            SET_STRING_ERROR_AND_RETURN("Timestamp queries are not supported on this queue", NULL);
+        }
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    } else {
+        if (!renderer->supportsPipelineStatisticsQuery) {
+            SET_STRING_ERROR_AND_RETURN("Pipeline statistics queries are not supported on this device", NULL);
+        }
+        createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+
+        // Results are written in bit order, which matches SDL_GPUPipelineStatistics
+        createInfo.pipelineStatistics =
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+            VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+    }
+
+    queryPool = SDL_malloc(sizeof(VulkanQueryPool));
+    if (!queryPool) {
+        return NULL;
+    }
+    queryPool->header.type = type;
+    queryPool->header.num_queries = numQueries;
+
+    vulkanResult = renderer->vkCreateQueryPool(
+        renderer->logicalDevice,
+        &createInfo,
+        NULL,
+        &queryPool->queryPool);
+
+    if (vulkanResult != VK_SUCCESS) {
+        SDL_free(queryPool);
+        CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateQueryPool, NULL);
+    }
+
+    return (SDL_GPUQueryPool *)queryPool;
+}
+
+static void VULKAN_WriteTimestamp(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+
+    renderer->vkCmdResetQueryPool(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        index,
+        1);
+
+    renderer->vkCmdWriteTimestamp(
+        vulkanCommandBuffer->commandBuffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        vulkanQueryPool->queryPool,
+        index);
+}
+
+static void VULKAN_BeginQuery(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+
+    renderer->vkCmdResetQueryPool(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        index,
+        1);
+
+    renderer->vkCmdBeginQuery(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        index,
+        0);
+}
+
+static void VULKAN_EndQuery(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 index)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+
+    renderer->vkCmdEndQuery(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        index);
+}
+
+static bool VULKAN_GetQueryResults(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 numQueries,
+    void *data)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+    VkDeviceSize stride;
+    VkResult vulkanResult;
+    Uint32 i;
+
+    if (vulkanQueryPool->header.type == SDL_GPU_QUERYTYPE_TIMESTAMP) {
+        stride = sizeof(Uint64);
+    } else {
+        stride = sizeof(SDL_GPUPipelineStatistics);
+    }
+
+    vulkanResult = renderer->vkGetQueryPoolResults(
+        renderer->logicalDevice,
+        vulkanQueryPool->queryPool,
+        firstQuery,
+        numQueries,
+        (size_t)(stride * numQueries),
+        data,
+        stride,
+        VK_QUERY_RESULT_64_BIT);
+
+    if (vulkanResult == VK_NOT_READY) {
+        return SDL_SetError("Query results are not available yet");
+    }
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetQueryPoolResults, false);
+
+    if (vulkanQueryPool->header.type == SDL_GPU_QUERYTYPE_TIMESTAMP) {
+        Uint64 *timestamps = (Uint64 *)data;
+        double period = renderer->physicalDeviceProperties.properties.limits.timestampPeriod;
+        for (i = 0; i < numQueries; i += 1) {
+            timestamps[i] = (Uint64)((double)timestamps[i] * period);
+        }
+    }
+
+    return true;
+}
+
+static void VULKAN_ReleaseQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+
+    // Query pools are rarely released, so just make sure nothing in flight still uses it
+    VULKAN_Wait(driverData);
+
+    renderer->vkDestroyQueryPool(
+        renderer->logicalDevice,
+        vulkanQueryPool->queryPool,
+        NULL);
+
+    SDL_free(vulkanQueryPool);
+}
+
 static WindowData *VULKAN_INTERNAL_FetchWindowData(
     SDL_Window *window)
 {
@@ -9813,7 +11387,7 @@ static bool VULKAN_ClaimWindow(
             renderer->claimedWindowCount += 1;
             SDL_UnlockMutex(renderer->windowLock);
 
-            SDL_AddEventWatch(VULKAN_INTERNAL_OnWindowResize, window);
+            SDL_AddEventWatchRange(SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED, SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED, VULKAN_INTERNAL_OnWindowResize, window);
 
             return true;
         } else if (createSwapchainResult == VULKAN_INTERNAL_TRY_AGAIN) {
@@ -9915,9 +11489,43 @@ static bool VULKAN_WaitForSwapchain(
         }
     }
 
+    /* Wait until at most allowedFramesInFlight - 1 presents are still queued for
+     * the display, so the caller can sample input as late as possible.
+     * A timeout or out-of-date swapchain here isn't an error, acquire handles it.
+     */
+    if (renderer->supports.KHR_present_wait &&
+        windowData->swapchain != VK_NULL_HANDLE &&
+        windowData->presentID >= renderer->allowedFramesInFlight) {
+        renderer->vkWaitForPresentKHR(
+            renderer->logicalDevice,
+            windowData->swapchain,
+            windowData->presentID - (renderer->allowedFramesInFlight - 1),
+            SDL_NS_PER_SECOND);
+    }
+
     return true;
 }
 
+static void VULKAN_INTERNAL_AddWaitSemaphore(
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    VkSemaphore semaphore,
+    VkPipelineStageFlags waitStage)
+{
+    if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity) {
+        vulkanCommandBuffer->waitSemaphoreCapacity += 1;
+        vulkanCommandBuffer->waitSemaphores = SDL_realloc(
+            vulkanCommandBuffer->waitSemaphores,
+            vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
+        vulkanCommandBuffer->waitSemaphoreStages = SDL_realloc(
+            vulkanCommandBuffer->waitSemaphoreStages,
+            vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkPipelineStageFlags));
+    }
+
+    vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] = semaphore;
+    vulkanCommandBuffer->waitSemaphoreStages[vulkanCommandBuffer->waitSemaphoreCount] = waitStage;
+    vulkanCommandBuffer->waitSemaphoreCount += 1;
+}
+
 static bool VULKAN_INTERNAL_AcquireSwapchainTexture(
     bool block,
     SDL_GPUCommandBuffer *commandBuffer,
@@ -10080,16 +11688,10 @@ static bool VULKAN_INTERNAL_AcquireSwapchainTexture(
 
     // Set up present semaphores
 
-    if (vulkanCommandBuffer->waitSemaphoreCount == vulkanCommandBuffer->waitSemaphoreCapacity) {
-        vulkanCommandBuffer->waitSemaphoreCapacity += 1;
-        vulkanCommandBuffer->waitSemaphores = SDL_realloc(
-            vulkanCommandBuffer->waitSemaphores,
-            vulkanCommandBuffer->waitSemaphoreCapacity * sizeof(VkSemaphore));
-    }
-
-    vulkanCommandBuffer->waitSemaphores[vulkanCommandBuffer->waitSemaphoreCount] =
-        windowData->imageAvailableSemaphore[windowData->frameCounter];
-    vulkanCommandBuffer->waitSemaphoreCount += 1;
+    VULKAN_INTERNAL_AddWaitSemaphore(
+        vulkanCommandBuffer,
+        windowData->imageAvailableSemaphore[windowData->frameCounter],
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
 
     if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity) {
         vulkanCommandBuffer->signalSemaphoreCapacity += 1;
@@ -10239,6 +11841,8 @@ static VulkanFenceHandle *VULKAN_INTERNAL_AcquireFenceFromPool(
 
         handle = SDL_malloc(sizeof(VulkanFenceHandle));
         handle->fence = fence;
+        handle->semaphore = VK_NULL_HANDLE;
+        handle->semaphoreSignaled = false;
         SDL_SetAtomicInt(&handle->referenceCount, 0);
         return handle;
     }
@@ -10248,6 +11852,18 @@ static VulkanFenceHandle *VULKAN_INTERNAL_AcquireFenceFromPool(
     handle = renderer->fencePool.availableFences[renderer->fencePool.availableFenceCount - 1];
     renderer->fencePool.availableFenceCount -= 1;
 
+    /* A binary semaphore that nobody waited on stays signaled, and can't be
+     * signaled again. Its submission has completed, so just replace it.
+     */
+    if (handle->semaphoreSignaled) {
+        renderer->vkDestroySemaphore(
+            renderer->logicalDevice,
+            handle->semaphore,
+            NULL);
+        handle->semaphore = VK_NULL_HANDLE;
+        handle->semaphoreSignaled = false;
+    }
+
     vulkanResult = renderer->vkResetFences(
         renderer->logicalDevice,
         1,
@@ -10360,16 +11976,16 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
 
     // Uniform buffers are now available
 
-    SDL_LockMutex(renderer->acquireUniformBufferLock);
+    SDL_LockMutex(commandBuffer->commandPool->lock);
 
     for (Sint32 i = 0; i < commandBuffer->usedUniformBufferCount; i += 1) {
         VULKAN_INTERNAL_ReturnUniformBufferToPool(
-            renderer,
+            commandBuffer->commandPool,
             commandBuffer->usedUniformBuffers[i]);
     }
     commandBuffer->usedUniformBufferCount = 0;
 
-    SDL_UnlockMutex(renderer->acquireUniformBufferLock);
+    SDL_UnlockMutex(commandBuffer->commandPool->lock);
 
     // Decrement reference counts
 
@@ -10403,6 +12019,19 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
     }
     commandBuffer->usedFramebufferCount = 0;
 
+    // Fences waited on by this command buffer can be reused now
+
+    for (Uint32 i = 0; i < commandBuffer->waitFenceCount; i += 1) {
+        if (cancel) {
+            // The wait never happened, so the semaphore is still signaled
+            commandBuffer->waitFences[i]->semaphoreSignaled = true;
+        }
+        VULKAN_ReleaseFence(
+            (SDL_GPURenderer *)renderer,
+            (SDL_GPUFence *)commandBuffer->waitFences[i]);
+    }
+    commandBuffer->waitFenceCount = 0;
+
     // Reset presentation data
 
     commandBuffer->presentDataCount = 0;
@@ -10430,15 +12059,19 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
     commandBuffer->commandPool->inactiveCommandBuffers[commandBuffer->commandPool->inactiveCommandBufferCount] = commandBuffer;
     commandBuffer->commandPool->inactiveCommandBufferCount += 1;
 
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
     // Release descriptor set cache
 
+    SDL_LockMutex(commandBuffer->commandPool->lock);
+
     VULKAN_INTERNAL_ReturnDescriptorSetCacheToPool(
-        renderer,
+        commandBuffer->commandPool,
         commandBuffer->descriptorSetCache);
 
-    commandBuffer->descriptorSetCache = NULL;
+    SDL_UnlockMutex(commandBuffer->commandPool->lock);
 
-    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+    commandBuffer->descriptorSetCache = NULL;
 
     // Remove this command buffer from the submitted list
     if (!cancel) {
@@ -10542,6 +12175,49 @@ static SDL_GPUFence *VULKAN_SubmitAndAcquireFence(
     return (SDL_GPUFence *)vulkanCommandBuffer->inFlightFence;
 }
 
+static bool VULKAN_AddWaitFence(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUFence *fence)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanFenceHandle *fenceHandle = (VulkanFenceHandle *)fence;
+
+    // With a single queue family everything runs on the unified queue
+    if (renderer->uniqueQueueFamilyCount == 1) {
+        return true;
+    }
+
+    SDL_LockMutex(renderer->submitLock);
+
+    if (!fenceHandle->semaphoreSignaled) {
+        SDL_UnlockMutex(renderer->submitLock);
+        SET_STRING_ERROR_AND_RETURN("Fence was already waited on by another command buffer", false);
+    }
+    fenceHandle->semaphoreSignaled = false;
+
+    SDL_UnlockMutex(renderer->submitLock);
+
+    VULKAN_INTERNAL_AddWaitSemaphore(
+        vulkanCommandBuffer,
+        fenceHandle->semaphore,
+        vulkanCommandBuffer->commandPool->supportedStages);
+
+    // Keep the fence, and with it the semaphore, alive until this command buffer completes
+    EXPAND_ARRAY_IF_NEEDED(
+        vulkanCommandBuffer->waitFences,
+        VulkanFenceHandle *,
+        vulkanCommandBuffer->waitFenceCount + 1,
+        vulkanCommandBuffer->waitFenceCapacity,
+        vulkanCommandBuffer->waitFenceCapacity + 1);
+
+    vulkanCommandBuffer->waitFences[vulkanCommandBuffer->waitFenceCount] = fenceHandle;
+    vulkanCommandBuffer->waitFenceCount += 1;
+    (void)SDL_AtomicIncRef(&fenceHandle->referenceCount);
+
+    return true;
+}
+
 static void VULKAN_INTERNAL_ReleaseCommandBuffer(VulkanCommandBuffer *vulkanCommandBuffer)
 {
     VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
@@ -10558,16 +12234,16 @@ static void VULKAN_INTERNAL_ReleaseCommandBuffer(VulkanCommandBuffer *vulkanComm
     renderer->submittedCommandBufferCount += 1;
 }
 
-static bool VULKAN_Submit(
+static bool VULKAN_INTERNAL_Submit(
     SDL_GPUCommandBuffer *commandBuffer)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
     VkSubmitInfo submitInfo;
     VkPresentInfoKHR presentInfo;
+    VkPresentIdKHR presentIDInfo;
     VulkanPresentData *presentData;
     VkResult vulkanResult, presentResult = VK_SUCCESS;
-    VkPipelineStageFlags waitStages[MAX_PRESENT_COUNT];
     Uint32 swapchainImageIndex;
     VulkanTextureSubresource *swapchainTextureSubresource;
     VulkanMemorySubAllocator *allocator;
@@ -10577,11 +12253,6 @@ static bool VULKAN_Submit(
 
     SDL_LockMutex(renderer->submitLock);
 
-    // FIXME: Can this just be permanent?
-    for (Uint32 i = 0; i < MAX_PRESENT_COUNT; i += 1) {
-        waitStages[i] = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    }
-
     for (Uint32 j = 0; j < vulkanCommandBuffer->presentDataCount; j += 1) {
         swapchainImageIndex = vulkanCommandBuffer->presentDatas[j].swapchainImageIndex;
         swapchainTextureSubresource = VULKAN_INTERNAL_FetchTextureSubresource(
@@ -10596,7 +12267,9 @@ static bool VULKAN_Submit(
             swapchainTextureSubresource);
     }
 
+    // Defragmenting needs blits, which only the graphics queue supports
     if (performCleanups &&
+        vulkanCommandBuffer->commandPool->queue == renderer->unifiedQueue &&
         renderer->allocationsToDefragCount > 0 &&
         !renderer->defragInProgress) {
         if (!VULKAN_INTERNAL_DefragmentMemory(renderer, vulkanCommandBuffer))
@@ -10619,22 +12292,58 @@ static bool VULKAN_Submit(
     // Command buffer has a reference to the in-flight fence
     (void)SDL_AtomicIncRef(&vulkanCommandBuffer->inFlightFence->referenceCount);
 
+    // An acquired fence may be waited on by another queue
+    if (!vulkanCommandBuffer->autoReleaseFence && renderer->uniqueQueueFamilyCount > 1) {
+        VulkanFenceHandle *fenceHandle = vulkanCommandBuffer->inFlightFence;
+
+        if (fenceHandle->semaphore == VK_NULL_HANDLE) {
+            VkSemaphoreCreateInfo semaphoreCreateInfo;
+            semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+            semaphoreCreateInfo.pNext = NULL;
+            semaphoreCreateInfo.flags = 0;
+
+            vulkanResult = renderer->vkCreateSemaphore(
+                renderer->logicalDevice,
+                &semaphoreCreateInfo,
+                NULL,
+                &fenceHandle->semaphore);
+
+            if (vulkanResult != VK_SUCCESS) {
+                SDL_UnlockMutex(renderer->submitLock);
+                CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateSemaphore, false);
+            }
+        }
+
+        if (vulkanCommandBuffer->signalSemaphoreCount == vulkanCommandBuffer->signalSemaphoreCapacity) {
+            vulkanCommandBuffer->signalSemaphoreCapacity += 1;
+            vulkanCommandBuffer->signalSemaphores = SDL_realloc(
+                vulkanCommandBuffer->signalSemaphores,
+                vulkanCommandBuffer->signalSemaphoreCapacity * sizeof(VkSemaphore));
+        }
+
+        vulkanCommandBuffer->signalSemaphores[vulkanCommandBuffer->signalSemaphoreCount] = fenceHandle->semaphore;
+        vulkanCommandBuffer->signalSemaphoreCount += 1;
+        fenceHandle->semaphoreSignaled = true;
+    }
+
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     submitInfo.pNext = NULL;
     submitInfo.commandBufferCount = 1;
     submitInfo.pCommandBuffers = &vulkanCommandBuffer->commandBuffer;
 
-    submitInfo.pWaitDstStageMask = waitStages;
+    submitInfo.pWaitDstStageMask = vulkanCommandBuffer->waitSemaphoreStages;
     submitInfo.pWaitSemaphores = vulkanCommandBuffer->waitSemaphores;
     submitInfo.waitSemaphoreCount = vulkanCommandBuffer->waitSemaphoreCount;
     submitInfo.pSignalSemaphores = vulkanCommandBuffer->signalSemaphores;
     submitInfo.signalSemaphoreCount = vulkanCommandBuffer->signalSemaphoreCount;
 
+    SDL_TRACE_BEGIN("vkQueueSubmit");
     vulkanResult = renderer->vkQueueSubmit(
-        renderer->unifiedQueue,
+        vulkanCommandBuffer->commandPool->queue,
         1,
         &submitInfo,
         vulkanCommandBuffer->inFlightFence->fence);
+    SDL_TRACE_END("vkQueueSubmit");
 
     if (vulkanResult != VK_SUCCESS) {
         SDL_UnlockMutex(renderer->submitLock);
@@ -10655,9 +12364,20 @@ static bool VULKAN_Submit(
         presentInfo.pImageIndices = &presentData->swapchainImageIndex;
         presentInfo.pResults = NULL;
 
+        if (renderer->supports.KHR_present_wait) {
+            presentData->windowData->presentID += 1;
+            presentIDInfo.sType = VK_STRUCTURE_TYPE_PRESENT_ID_KHR;
+            presentIDInfo.pNext = NULL;
+            presentIDInfo.swapchainCount = 1;
+            presentIDInfo.pPresentIds = &presentData->windowData->presentID;
+            presentInfo.pNext = &presentIDInfo;
+        }
+
+        SDL_TRACE_BEGIN("vkQueuePresentKHR");
         presentResult = renderer->vkQueuePresentKHR(
             renderer->unifiedQueue,
             &presentInfo);
+        SDL_TRACE_END("vkQueuePresentKHR");
 
         if (presentResult == VK_SUCCESS || presentResult == VK_SUBOPTIMAL_KHR || presentResult == VK_ERROR_OUT_OF_DATE_KHR) {
             // If presenting, the swapchain is using the in-flight fence
@@ -10726,6 +12446,17 @@ static bool VULKAN_Submit(
     return true;
 }
 
+static bool VULKAN_Submit(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    bool result;
+
+    SDL_TRACE_BEGIN("VULKAN_Submit");
+    result = VULKAN_INTERNAL_Submit(commandBuffer);
+    SDL_TRACE_END("VULKAN_Submit");
+    return result;
+}
+
 static bool VULKAN_Cancel(
     SDL_GPUCommandBuffer *commandBuffer)
 {
@@ -10753,170 +12484,196 @@ static bool VULKAN_INTERNAL_DefragmentMemory(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer)
 {
+    VkDeviceSize movedSize = 0;
+
     renderer->defragInProgress = 1;
     commandBuffer->isDefrag = 1;
 
     SDL_LockMutex(renderer->allocatorLock);
 
-    VulkanMemoryAllocation *allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
-    renderer->allocationsToDefragCount -= 1;
-
-    /* For each used region in the allocation
-     * create a new resource, copy the data
-     * and re-point the resource containers
+    /* Without a budget, a whole allocation is moved per submission.
+     * With one, moving stops once the budget is used up and resumes
+     * with the next submission; regions that were already moved are
+     * marked for destroy and get skipped.
      */
-    for (Uint32 i = 0; i < allocation->usedRegionCount; i += 1) {
-        VulkanMemoryUsedRegion *currentRegion = allocation->usedRegions[i];
-
-        if (currentRegion->isBuffer && !currentRegion->vulkanBuffer->markedForDestroy) {
-            currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    while (renderer->allocationsToDefragCount > 0) {
+        VulkanMemoryAllocation *allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
+        bool allocationDone = true;
 
-            VulkanBuffer *newBuffer = VULKAN_INTERNAL_CreateBuffer(
-                renderer,
-                currentRegion->vulkanBuffer->size,
-                currentRegion->vulkanBuffer->usage,
-                currentRegion->vulkanBuffer->type,
-                false,
-                currentRegion->vulkanBuffer->container != NULL ? currentRegion->vulkanBuffer->container->debugName : NULL);
+        /* For each used region in the allocation
+         * create a new resource, copy the data
+         * and re-point the resource containers
+         */
+        for (Uint32 i = 0; i < allocation->usedRegionCount; i += 1) {
+            VulkanMemoryUsedRegion *currentRegion = allocation->usedRegions[i];
 
-            if (newBuffer == NULL) {
-                SDL_UnlockMutex(renderer->allocatorLock);
-                SDL_LogError(SDL_LOG_CATEGORY_GPU, "%s", "Failed to allocate defrag buffer!");
-                return false;
+            if (renderer->defragBudget > 0 && movedSize >= renderer->defragBudget) {
+                allocationDone = false;
+                break;
             }
 
-            // Copy buffer contents if necessary
-            if (
-                currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
-                    currentRegion->vulkanBuffer);
+            if (currentRegion->isBuffer && !currentRegion->vulkanBuffer->markedForDestroy) {
+                currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                VulkanBuffer *newBuffer = VULKAN_INTERNAL_CreateBuffer(
                     renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
-
-                VkBufferCopy bufferCopy;
-                bufferCopy.srcOffset = 0;
-                bufferCopy.dstOffset = 0;
-                bufferCopy.size = currentRegion->resourceSize;
-
-                renderer->vkCmdCopyBuffer(
-                    commandBuffer->commandBuffer,
-                    currentRegion->vulkanBuffer->buffer,
-                    newBuffer->buffer,
-                    1,
-                    &bufferCopy);
+                    currentRegion->vulkanBuffer->size,
+                    currentRegion->vulkanBuffer->usage,
+                    currentRegion->vulkanBuffer->type,
+                    false,
+                    currentRegion->vulkanBuffer->container != NULL ? currentRegion->vulkanBuffer->container->debugName : NULL);
+
+                if (newBuffer == NULL) {
+                    renderer->allocationsToDefragCount -= 1;
+                    SDL_UnlockMutex(renderer->allocatorLock);
+                    SDL_LogError(SDL_LOG_CATEGORY_GPU, "%s", "Failed to allocate defrag buffer!");
+                    return false;
+                }
 
-                VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
+                // Copy buffer contents if necessary
+                if (
+                    currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
+                    VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
+                        currentRegion->vulkanBuffer);
 
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
-            }
+                    VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                        newBuffer);
+
+                    VkBufferCopy bufferCopy;
+                    bufferCopy.srcOffset = 0;
+                    bufferCopy.dstOffset = 0;
+                    bufferCopy.size = currentRegion->resourceSize;
+
+                    renderer->vkCmdCopyBuffer(
+                        commandBuffer->commandBuffer,
+                        currentRegion->vulkanBuffer->buffer,
+                        newBuffer->buffer,
+                        1,
+                        &bufferCopy);
+
+                    VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                        newBuffer);
 
-            // re-point original container to new buffer
-            newBuffer->container = currentRegion->vulkanBuffer->container;
-            newBuffer->containerIndex = currentRegion->vulkanBuffer->containerIndex;
-            if (newBuffer->type == VULKAN_BUFFER_TYPE_UNIFORM) {
-                currentRegion->vulkanBuffer->uniformBufferForDefrag->buffer = newBuffer;
-            } else {
-                newBuffer->container->buffers[newBuffer->containerIndex] = newBuffer;
-                if (newBuffer->container->activeBuffer == currentRegion->vulkanBuffer) {
-                    newBuffer->container->activeBuffer = newBuffer;
+                    VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
+                    VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
                 }
-            }
 
-            if (currentRegion->vulkanBuffer->uniformBufferForDefrag) {
-                newBuffer->uniformBufferForDefrag = currentRegion->vulkanBuffer->uniformBufferForDefrag;
-            }
+                // re-point original container to new buffer
+                newBuffer->container = currentRegion->vulkanBuffer->container;
+                newBuffer->containerIndex = currentRegion->vulkanBuffer->containerIndex;
+                if (newBuffer->type == VULKAN_BUFFER_TYPE_UNIFORM) {
+                    currentRegion->vulkanBuffer->uniformBufferForDefrag->buffer = newBuffer;
+                } else {
+                    newBuffer->container->buffers[newBuffer->containerIndex] = newBuffer;
+                    if (newBuffer->container->activeBuffer == currentRegion->vulkanBuffer) {
+                        newBuffer->container->activeBuffer = newBuffer;
+                    }
+                }
 
-            VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
-        } else if (!currentRegion->isBuffer && !currentRegion->vulkanTexture->markedForDestroy) {
-            VulkanTexture *newTexture = VULKAN_INTERNAL_CreateTexture(
-                renderer,
-                false,
-                &currentRegion->vulkanTexture->container->header.info);
+                if (currentRegion->vulkanBuffer->uniformBufferForDefrag) {
+                    newBuffer->uniformBufferForDefrag = currentRegion->vulkanBuffer->uniformBufferForDefrag;
+                }
 
-            if (newTexture == NULL) {
-                SDL_UnlockMutex(renderer->allocatorLock);
-                SDL_LogError(SDL_LOG_CATEGORY_GPU, "%s", "Failed to allocate defrag buffer!");
-                return false;
-            }
+                VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
+                movedSize += currentRegion->resourceSize;
+            } else if (!currentRegion->isBuffer && !currentRegion->vulkanTexture->markedForDestroy) {
+                VulkanTexture *newTexture = VULKAN_INTERNAL_CreateTexture(
+                    renderer,
+                    false,
+                    &currentRegion->vulkanTexture->container->header.info);
+
+                if (newTexture == NULL) {
+                    renderer->allocationsToDefragCount -= 1;
+                    SDL_UnlockMutex(renderer->allocatorLock);
+                    SDL_LogError(SDL_LOG_CATEGORY_GPU, "%s", "Failed to allocate defrag buffer!");
+                    return false;
+                }
 
-            SDL_GPUTextureCreateInfo info = currentRegion->vulkanTexture->container->header.info;
-            for (Uint32 subresourceIndex = 0; subresourceIndex < currentRegion->vulkanTexture->subresourceCount; subresourceIndex += 1) {
-                // copy subresource if necessary
-                VulkanTextureSubresource *srcSubresource = &currentRegion->vulkanTexture->subresources[subresourceIndex];
-                VulkanTextureSubresource *dstSubresource = &newTexture->subresources[subresourceIndex];
+                SDL_GPUTextureCreateInfo info = currentRegion->vulkanTexture->container->header.info;
+                for (Uint32 subresourceIndex = 0; subresourceIndex < currentRegion->vulkanTexture->subresourceCount; subresourceIndex += 1) {
+                    // copy subresource if necessary
+                    VulkanTextureSubresource *srcSubresource = &currentRegion->vulkanTexture->subresources[subresourceIndex];
+                    VulkanTextureSubresource *dstSubresource = &newTexture->subresources[subresourceIndex];
 
-                VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-                    srcSubresource);
+                    VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+                        srcSubresource);
 
-                VULKAN_INTERNAL_TextureSubresourceMemoryBarrier(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_UNINITIALIZED,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                    dstSubresource);
-
-                VkImageCopy imageCopy;
-                imageCopy.srcOffset.x = 0;
-                imageCopy.srcOffset.y = 0;
-                imageCopy.srcOffset.z = 0;
-                imageCopy.srcSubresource.aspectMask = srcSubresource->parent->aspectFlags;
-                imageCopy.srcSubresource.baseArrayLayer = srcSubresource->layer;
-                imageCopy.srcSubresource.layerCount = 1;
-                imageCopy.srcSubresource.mipLevel = srcSubresource->level;
-                imageCopy.extent.width = SDL_max(1, info.width >> srcSubresource->level);
-                imageCopy.extent.height = SDL_max(1, info.height >> srcSubresource->level);
-                imageCopy.extent.depth = info.type == SDL_GPU_TEXTURETYPE_3D ? info.layer_count_or_depth : 1;
-                imageCopy.dstOffset.x = 0;
-                imageCopy.dstOffset.y = 0;
-                imageCopy.dstOffset.z = 0;
-                imageCopy.dstSubresource.aspectMask = dstSubresource->parent->aspectFlags;
-                imageCopy.dstSubresource.baseArrayLayer = dstSubresource->layer;
-                imageCopy.dstSubresource.layerCount = 1;
-                imageCopy.dstSubresource.mipLevel = dstSubresource->level;
-
-                renderer->vkCmdCopyImage(
-                    commandBuffer->commandBuffer,
-                    currentRegion->vulkanTexture->image,
-                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                    newTexture->image,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    1,
-                    &imageCopy);
-
-                VULKAN_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                    dstSubresource);
+                    VULKAN_INTERNAL_TextureSubresourceMemoryBarrier(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_UNINITIALIZED,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSubresource);
+
+                    VkImageCopy imageCopy;
+                    imageCopy.srcOffset.x = 0;
+                    imageCopy.srcOffset.y = 0;
+                    imageCopy.srcOffset.z = 0;
+                    imageCopy.srcSubresource.aspectMask = srcSubresource->parent->aspectFlags;
+                    imageCopy.srcSubresource.baseArrayLayer = srcSubresource->layer;
+                    imageCopy.srcSubresource.layerCount = 1;
+                    imageCopy.srcSubresource.mipLevel = srcSubresource->level;
+                    imageCopy.extent.width = SDL_max(1, info.width >> srcSubresource->level);
+                    imageCopy.extent.height = SDL_max(1, info.height >> srcSubresource->level);
+                    imageCopy.extent.depth = info.type == SDL_GPU_TEXTURETYPE_3D ? info.layer_count_or_depth : 1;
+                    imageCopy.dstOffset.x = 0;
+                    imageCopy.dstOffset.y = 0;
+                    imageCopy.dstOffset.z = 0;
+                    imageCopy.dstSubresource.aspectMask = dstSubresource->parent->aspectFlags;
+                    imageCopy.dstSubresource.baseArrayLayer = dstSubresource->layer;
+                    imageCopy.dstSubresource.layerCount = 1;
+                    imageCopy.dstSubresource.mipLevel = dstSubresource->level;
+
+                    renderer->vkCmdCopyImage(
+                        commandBuffer->commandBuffer,
+                        currentRegion->vulkanTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        newTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        1,
+                        &imageCopy);
+
+                    VULKAN_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSubresource);
 
-                VULKAN_INTERNAL_TrackTexture(commandBuffer, srcSubresource->parent);
-                VULKAN_INTERNAL_TrackTexture(commandBuffer, dstSubresource->parent);
-            }
+                    VULKAN_INTERNAL_TrackTexture(commandBuffer, srcSubresource->parent);
+                    VULKAN_INTERNAL_TrackTexture(commandBuffer, dstSubresource->parent);
+                }
 
-            // re-point original container to new texture
-            newTexture->container = currentRegion->vulkanTexture->container;
-            newTexture->containerIndex = currentRegion->vulkanTexture->containerIndex;
-            newTexture->container->textures[currentRegion->vulkanTexture->containerIndex] = newTexture;
-            if (currentRegion->vulkanTexture == currentRegion->vulkanTexture->container->activeTexture) {
-                newTexture->container->activeTexture = newTexture;
+                // re-point original container to new texture
+                newTexture->container = currentRegion->vulkanTexture->container;
+                newTexture->containerIndex = currentRegion->vulkanTexture->containerIndex;
+                newTexture->container->textures[currentRegion->vulkanTexture->containerIndex] = newTexture;
+                if (currentRegion->vulkanTexture == currentRegion->vulkanTexture->container->activeTexture) {
+                    newTexture->container->activeTexture = newTexture;
+                }
+
+                VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
+                movedSize += currentRegion->resourceSize;
             }
+        }
+
+        if (allocationDone) {
+            renderer->allocationsToDefragCount -= 1;
+        }
 
-            VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
+        if (renderer->defragBudget == 0 || movedSize >= renderer->defragBudget) {
+            break;
         }
     }
 
@@ -10949,6 +12706,9 @@ static bool VULKAN_SupportsTextureFormat(
     if (usage & SDL_GPU_TEXTUREUSAGE_DEPTH_STENCIL_TARGET) {
         vulkanUsage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
     }
+    if (usage & SDL_GPU_TEXTUREUSAGE_TRANSIENT_ATTACHMENT) {
+        vulkanUsage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    }
     if (usage & (SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ |
                  SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ |
                  SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE |
@@ -10972,6 +12732,51 @@ static bool VULKAN_SupportsTextureFormat(
     return vulkanResult == VK_SUCCESS;
 }
 
+static bool VULKAN_SupportsSparseTexture(
+    SDL_GPURenderer *driverData,
+    SDL_GPUTextureFormat format,
+    SDL_GPUTextureType type,
+    SDL_GPUTextureUsageFlags usage)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkImageUsageFlags vulkanUsage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    Uint32 propertyCount = 0;
+
+    if (type == SDL_GPU_TEXTURETYPE_3D ? !renderer->supportsSparseResidency3D : !renderer->supportsSparseResidency2D) {
+        return false;
+    }
+
+    // Depth-stencil tiles would need a bind per aspect
+    if (IsDepthFormat(format)) {
+        return false;
+    }
+
+    if (usage & (SDL_GPU_TEXTUREUSAGE_SAMPLER |
+                 SDL_GPU_TEXTUREUSAGE_GRAPHICS_STORAGE_READ |
+                 SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_READ)) {
+        vulkanUsage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+    }
+    if (usage & SDL_GPU_TEXTUREUSAGE_COLOR_TARGET) {
+        vulkanUsage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    }
+    if (usage & (SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_WRITE |
+                 SDL_GPU_TEXTUREUSAGE_COMPUTE_STORAGE_SIMULTANEOUS_READ_WRITE)) {
+        vulkanUsage |= VK_IMAGE_USAGE_STORAGE_BIT;
+    }
+
+    renderer->vkGetPhysicalDeviceSparseImageFormatProperties(
+        renderer->physicalDevice,
+        SDLToVK_TextureFormat[format],
+        (type == SDL_GPU_TEXTURETYPE_3D) ? VK_IMAGE_TYPE_3D : VK_IMAGE_TYPE_2D,
+        VK_SAMPLE_COUNT_1_BIT,
+        vulkanUsage,
+        VK_IMAGE_TILING_OPTIMAL,
+        &propertyCount,
+        NULL);
+
+    return propertyCount > 0;
+}
+
 // Device instantiation
 
 static inline Uint8 CheckDeviceExtensions(
@@ -10989,7 +12794,7 @@ static inline Uint8 CheckDeviceExtensions(
         supports->ext = 1;                   \
     }
         CHECK(KHR_swapchain)
-        else CHECK(KHR_maintenance1) else CHECK(KHR_driver_properties) else CHECK(KHR_portability_subset) else CHECK(EXT_texture_compression_astc_hdr)
+        else CHECK(KHR_maintenance1) else CHECK(KHR_driver_properties) else CHECK(KHR_portability_subset) else CHECK(EXT_texture_compression_astc_hdr) else CHECK(EXT_memory_budget) else CHECK(KHR_draw_indirect_count) else CHECK(EXT_mesh_shader) else CHECK(KHR_present_id) else CHECK(KHR_present_wait) else CHECK(KHR_dynamic_rendering) else CHECK(KHR_depth_stencil_resolve) else CHECK(KHR_create_renderpass2) else CHECK(KHR_multiview) else CHECK(KHR_maintenance2)
 #undef CHECK
     }
 
@@ -11004,7 +12809,17 @@ static inline Uint32 GetDeviceExtensionCount(VulkanExtensions *supports)
         supports->KHR_maintenance1 +
         supports->KHR_driver_properties +
         supports->KHR_portability_subset +
-        supports->EXT_texture_compression_astc_hdr);
+        supports->EXT_texture_compression_astc_hdr +
+        supports->EXT_memory_budget +
+        supports->KHR_draw_indirect_count +
+        supports->EXT_mesh_shader +
+        supports->KHR_present_id +
+        supports->KHR_present_wait +
+        supports->KHR_dynamic_rendering +
+        supports->KHR_depth_stencil_resolve +
+        supports->KHR_create_renderpass2 +
+        supports->KHR_multiview +
+        supports->KHR_maintenance2);
 }
 
 static inline void CreateDeviceExtensionArray(
@@ -11021,6 +12836,16 @@ static inline void CreateDeviceExtensionArray(
     CHECK(KHR_driver_properties)
     CHECK(KHR_portability_subset)
     CHECK(EXT_texture_compression_astc_hdr)
+    CHECK(EXT_memory_budget)
+    CHECK(KHR_draw_indirect_count)
+    CHECK(EXT_mesh_shader)
+    CHECK(KHR_present_id)
+    CHECK(KHR_present_wait)
+    CHECK(KHR_dynamic_rendering)
+    CHECK(KHR_depth_stencil_resolve)
+    CHECK(KHR_create_renderpass2)
+    CHECK(KHR_multiview)
+    CHECK(KHR_maintenance2)
 #undef CHECK
 }
 
@@ -11119,6 +12944,38 @@ static Uint8 VULKAN_INTERNAL_CheckDeviceExtensions(
         extensionCount,
         physicalDeviceExtensions);
 
+    // The budget can only be queried through vkGetPhysicalDeviceMemoryProperties2KHR
+    if (!renderer->supportsPhysicalDeviceProperties2) {
+        physicalDeviceExtensions->EXT_memory_budget = 0;
+    }
+
+    // Mesh shading is opt-in, since it needs a newer instance than we otherwise use
+    if (!renderer->requireMeshShaders) {
+        physicalDeviceExtensions->EXT_mesh_shader = 0;
+    }
+
+    // Present waits need present IDs, and both are enabled through feature structs
+    if (!renderer->supportsPhysicalDeviceProperties2 ||
+        !physicalDeviceExtensions->KHR_present_id ||
+        !physicalDeviceExtensions->KHR_present_wait) {
+        physicalDeviceExtensions->KHR_present_id = 0;
+        physicalDeviceExtensions->KHR_present_wait = 0;
+    }
+
+    // Dynamic rendering is enabled through a feature struct, and only with its whole dependency chain
+    if (!renderer->supportsPhysicalDeviceProperties2 ||
+        !physicalDeviceExtensions->KHR_dynamic_rendering ||
+        !physicalDeviceExtensions->KHR_depth_stencil_resolve ||
+        !physicalDeviceExtensions->KHR_create_renderpass2 ||
+        !physicalDeviceExtensions->KHR_multiview ||
+        !physicalDeviceExtensions->KHR_maintenance2) {
+        physicalDeviceExtensions->KHR_dynamic_rendering = 0;
+        physicalDeviceExtensions->KHR_depth_stencil_resolve = 0;
+        physicalDeviceExtensions->KHR_create_renderpass2 = 0;
+        physicalDeviceExtensions->KHR_multiview = 0;
+        physicalDeviceExtensions->KHR_maintenance2 = 0;
+    }
+
     SDL_free(availableExtensions);
     return allExtensionsSupported;
 }
@@ -11173,7 +13030,8 @@ static Uint8 VULKAN_INTERNAL_CreateInstance(VulkanRenderer *renderer)
     appInfo.applicationVersion = 0;
     appInfo.pEngineName = "SDLGPU";
     appInfo.engineVersion = SDL_VERSION;
-    appInfo.apiVersion = VK_MAKE_VERSION(1, 0, 0);
+    // Mesh shaders are SPIR-V 1.4, which is core since 1.2
+    appInfo.apiVersion = renderer->requireMeshShaders ? VK_MAKE_VERSION(1, 2, 0) : VK_MAKE_VERSION(1, 0, 0);
 
     createFlags = 0;
 
@@ -11268,6 +13126,35 @@ static Uint8 VULKAN_INTERNAL_CreateInstance(VulkanRenderer *renderer)
     return 1;
 }
 
+static bool VULKAN_INTERNAL_SupportsMeshShaders(
+    VulkanRenderer *renderer,
+    VkPhysicalDevice physicalDevice,
+    const VkPhysicalDeviceProperties *deviceProperties,
+    const VulkanExtensions *physicalDeviceExtensions)
+{
+    VkPhysicalDeviceFeatures2KHR deviceFeatures;
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures;
+
+    if (!renderer->supportsPhysicalDeviceProperties2 ||
+        !physicalDeviceExtensions->EXT_mesh_shader ||
+        deviceProperties->apiVersion < VK_MAKE_VERSION(1, 2, 0)) {
+        return false;
+    }
+
+    SDL_zero(meshShaderFeatures);
+    meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+
+    SDL_zero(deviceFeatures);
+    deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+    deviceFeatures.pNext = &meshShaderFeatures;
+
+    renderer->vkGetPhysicalDeviceFeatures2KHR(
+        physicalDevice,
+        &deviceFeatures);
+
+    return meshShaderFeatures.taskShader && meshShaderFeatures.meshShader;
+}
+
 static Uint8 VULKAN_INTERNAL_IsDeviceSuitable(
     VulkanRenderer *renderer,
     VkPhysicalDevice physicalDevice,
@@ -11324,6 +13211,15 @@ static Uint8 VULKAN_INTERNAL_IsDeviceSuitable(
         return 0;
     }
 
+    if (renderer->requireMeshShaders &&
+        !VULKAN_INTERNAL_SupportsMeshShaders(
+            renderer,
+            physicalDevice,
+            &deviceProperties,
+            physicalDeviceExtensions)) {
+        return 0;
+    }
+
     renderer->vkGetPhysicalDeviceQueueFamilyProperties(
         physicalDevice,
         &queueFamilyCount,
@@ -11410,6 +13306,8 @@ static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(VulkanRenderer *renderer)
     Uint32 i, physicalDeviceCount;
     Sint32 suitableIndex;
     Uint32 queueFamilyIndex, suitableQueueFamilyIndex;
+    Uint32 queueFamilyCount;
+    VkQueueFamilyProperties *queueProps;
     Uint8 deviceRank, highestRank;
 
     vulkanResult = renderer->vkEnumeratePhysicalDevices(
@@ -11519,6 +13417,57 @@ static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(VulkanRenderer *renderer)
         renderer->physicalDevice,
         &renderer->memoryProperties);
 
+    // Timestamp support is a property of the queue family, not the device
+    renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+        renderer->physicalDevice,
+        &queueFamilyCount,
+        NULL);
+    queueProps = SDL_stack_alloc(VkQueueFamilyProperties, queueFamilyCount);
+    renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+        renderer->physicalDevice,
+        &queueFamilyCount,
+        queueProps);
+    if (renderer->queueFamilyIndex < queueFamilyCount) {
+        renderer->timestampValidBits = queueProps[renderer->queueFamilyIndex].timestampValidBits;
+    }
+
+    /* Look for async compute and transfer queue families.
+     * Transfer-only families may have a coarse image transfer granularity,
+     * which our copies can't honor, so those are skipped.
+     */
+    renderer->computeQueueFamilyIndex = renderer->queueFamilyIndex;
+    renderer->transferQueueFamilyIndex = renderer->queueFamilyIndex;
+    for (i = 0; renderer->allowDedicatedQueues && i < queueFamilyCount; i += 1) {
+        VkQueueFlags queueFlags = queueProps[i].queueFlags;
+        VkExtent3D granularity = queueProps[i].minImageTransferGranularity;
+
+        if (queueProps[i].queueCount == 0 || (queueFlags & VK_QUEUE_GRAPHICS_BIT)) {
+            continue;
+        }
+
+        if (queueFlags & VK_QUEUE_COMPUTE_BIT) {
+            if (renderer->computeQueueFamilyIndex == renderer->queueFamilyIndex) {
+                renderer->computeQueueFamilyIndex = i;
+            }
+        } else if (queueFlags & VK_QUEUE_TRANSFER_BIT) {
+            if (renderer->transferQueueFamilyIndex == renderer->queueFamilyIndex &&
+                granularity.width == 1 && granularity.height == 1 && granularity.depth == 1) {
+                renderer->transferQueueFamilyIndex = i;
+            }
+        }
+    }
+
+    renderer->uniqueQueueFamilyIndices[0] = renderer->queueFamilyIndex;
+    renderer->uniqueQueueFamilyCount = 1;
+    if (renderer->computeQueueFamilyIndex != renderer->queueFamilyIndex) {
+        renderer->uniqueQueueFamilyIndices[renderer->uniqueQueueFamilyCount++] = renderer->computeQueueFamilyIndex;
+    }
+    if (renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex) {
+        renderer->uniqueQueueFamilyIndices[renderer->uniqueQueueFamilyCount++] = renderer->transferQueueFamilyIndex;
+    }
+
+    SDL_stack_free(queueProps);
+
     SDL_stack_free(physicalDevices);
     SDL_stack_free(physicalDeviceExtensions);
     return 1;
@@ -11532,18 +13481,25 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
     VkPhysicalDeviceFeatures desiredDeviceFeatures;
     VkPhysicalDeviceFeatures haveDeviceFeatures;
     VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeatures;
+    VkPhysicalDeviceMeshShaderFeaturesEXT meshShaderFeatures;
+    VkPhysicalDevicePresentIdFeaturesKHR presentIDFeatures;
+    VkPhysicalDevicePresentWaitFeaturesKHR presentWaitFeatures;
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures;
     const char **deviceExtensions;
 
-    VkDeviceQueueCreateInfo queueCreateInfo;
+    VkDeviceQueueCreateInfo queueCreateInfos[3];
     float queuePriority = 1.0f;
 
-    queueCreateInfo.sType =
-        VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queueCreateInfo.pNext = NULL;
-    queueCreateInfo.flags = 0;
-    queueCreateInfo.queueFamilyIndex = renderer->queueFamilyIndex;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    // One queue per family: the unified queue, then any dedicated ones
+    for (Uint32 i = 0; i < renderer->uniqueQueueFamilyCount; i += 1) {
+        queueCreateInfos[i].sType =
+            VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfos[i].pNext = NULL;
+        queueCreateInfos[i].flags = 0;
+        queueCreateInfos[i].queueFamilyIndex = renderer->uniqueQueueFamilyIndices[i];
+        queueCreateInfos[i].queueCount = 1;
+        queueCreateInfos[i].pQueuePriorities = &queuePriority;
+    }
 
     // check feature support
 
@@ -11571,6 +13527,85 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
         renderer->supportsMultiDrawIndirect = true;
     }
 
+    if (haveDeviceFeatures.pipelineStatisticsQuery) {
+        desiredDeviceFeatures.pipelineStatisticsQuery = VK_TRUE;
+        renderer->supportsPipelineStatisticsQuery = true;
+    }
+
+    // Sparse binds are done on the unified queue, so its family must support them
+    if (haveDeviceFeatures.sparseBinding) {
+        Uint32 queueFamilyCount = 0;
+        VkQueueFamilyProperties *queueProps;
+
+        renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+            renderer->physicalDevice,
+            &queueFamilyCount,
+            NULL);
+        queueProps = SDL_malloc(queueFamilyCount * sizeof(VkQueueFamilyProperties));
+        renderer->vkGetPhysicalDeviceQueueFamilyProperties(
+            renderer->physicalDevice,
+            &queueFamilyCount,
+            queueProps);
+
+        if (renderer->queueFamilyIndex < queueFamilyCount &&
+            (queueProps[renderer->queueFamilyIndex].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT)) {
+            desiredDeviceFeatures.sparseBinding = VK_TRUE;
+            desiredDeviceFeatures.sparseResidencyImage2D = haveDeviceFeatures.sparseResidencyImage2D;
+            desiredDeviceFeatures.sparseResidencyImage3D = haveDeviceFeatures.sparseResidencyImage3D;
+            renderer->supportsSparseResidency2D = haveDeviceFeatures.sparseResidencyImage2D;
+            renderer->supportsSparseResidency3D = haveDeviceFeatures.sparseResidencyImage3D;
+        }
+
+        SDL_free(queueProps);
+    }
+
+    SDL_zero(presentIDFeatures);
+    presentIDFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_ID_FEATURES_KHR;
+    SDL_zero(presentWaitFeatures);
+    presentWaitFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PRESENT_WAIT_FEATURES_KHR;
+    if (renderer->supports.KHR_present_wait) {
+        VkPhysicalDeviceFeatures2KHR features2;
+
+        SDL_zero(features2);
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features2.pNext = &presentIDFeatures;
+        presentIDFeatures.pNext = &presentWaitFeatures;
+        renderer->vkGetPhysicalDeviceFeatures2KHR(
+            renderer->physicalDevice,
+            &features2);
+
+        if (!presentIDFeatures.presentId || !presentWaitFeatures.presentWait) {
+            renderer->supports.KHR_present_id = 0;
+            renderer->supports.KHR_present_wait = 0;
+        }
+    }
+
+    SDL_zero(dynamicRenderingFeatures);
+    dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
+    if (renderer->supports.KHR_dynamic_rendering) {
+        VkPhysicalDeviceFeatures2KHR features2;
+
+        SDL_zero(features2);
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features2.pNext = &dynamicRenderingFeatures;
+        renderer->vkGetPhysicalDeviceFeatures2KHR(
+            renderer->physicalDevice,
+            &features2);
+
+        if (!dynamicRenderingFeatures.dynamicRendering) {
+            renderer->supports.KHR_dynamic_rendering = 0;
+            renderer->supports.KHR_depth_stencil_resolve = 0;
+            renderer->supports.KHR_create_renderpass2 = 0;
+            renderer->supports.KHR_multiview = 0;
+            renderer->supports.KHR_maintenance2 = 0;
+        }
+    }
+
+    renderer->graphicsShaderStages = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    if (renderer->supports.EXT_mesh_shader) {
+        renderer->graphicsShaderStages |= VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT;
+    }
+
     // creating the logical device
 
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -11596,9 +13631,29 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
     } else {
         deviceCreateInfo.pNext = NULL;
     }
+    if (renderer->supports.EXT_mesh_shader) {
+        SDL_zero(meshShaderFeatures);
+        meshShaderFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+        meshShaderFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        meshShaderFeatures.taskShader = VK_TRUE;
+        meshShaderFeatures.meshShader = VK_TRUE;
+        deviceCreateInfo.pNext = &meshShaderFeatures;
+    }
+    if (renderer->supports.KHR_present_wait) {
+        presentIDFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        presentIDFeatures.presentId = VK_TRUE;
+        presentWaitFeatures.pNext = &presentIDFeatures;
+        presentWaitFeatures.presentWait = VK_TRUE;
+        deviceCreateInfo.pNext = &presentWaitFeatures;
+    }
+    if (renderer->supports.KHR_dynamic_rendering) {
+        dynamicRenderingFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+        deviceCreateInfo.pNext = &dynamicRenderingFeatures;
+    }
     deviceCreateInfo.flags = 0;
-    deviceCreateInfo.queueCreateInfoCount = 1;
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = renderer->uniqueQueueFamilyCount;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
     deviceCreateInfo.enabledLayerCount = 0;
     deviceCreateInfo.ppEnabledLayerNames = NULL;
     deviceCreateInfo.enabledExtensionCount = GetDeviceExtensionCount(
@@ -11633,6 +13688,24 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
         0,
         &renderer->unifiedQueue);
 
+    renderer->computeQueue = renderer->unifiedQueue;
+    if (renderer->computeQueueFamilyIndex != renderer->queueFamilyIndex) {
+        renderer->vkGetDeviceQueue(
+            renderer->logicalDevice,
+            renderer->computeQueueFamilyIndex,
+            0,
+            &renderer->computeQueue);
+    }
+
+    renderer->transferQueue = renderer->unifiedQueue;
+    if (renderer->transferQueueFamilyIndex != renderer->queueFamilyIndex) {
+        renderer->vkGetDeviceQueue(
+            renderer->logicalDevice,
+            renderer->transferQueueFamilyIndex,
+            0,
+            &renderer->transferQueue);
+    }
+
     return 1;
 }
 
@@ -11693,7 +13766,7 @@ static bool VULKAN_INTERNAL_PrepareVulkan(
     return true;
 }
 
-static bool VULKAN_PrepareDriver(SDL_VideoDevice *_this)
+static bool VULKAN_PrepareDriver(SDL_VideoDevice *_this, SDL_PropertiesID props)
 {
     // Set up dummy VulkanRenderer
     VulkanRenderer *renderer;
@@ -11709,6 +13782,7 @@ static bool VULKAN_PrepareDriver(SDL_VideoDevice *_this)
 
     renderer = (VulkanRenderer *)SDL_calloc(1, sizeof(*renderer));
     if (renderer) {
+        renderer->requireMeshShaders = SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false);
         result = VULKAN_INTERNAL_PrepareVulkan(renderer);
         if (result) {
             renderer->vkDestroyInstance(renderer->instance, NULL);
@@ -11720,6 +13794,65 @@ static bool VULKAN_PrepareDriver(SDL_VideoDevice *_this)
     return result;
 }
 
+static bool VULKAN_INTERNAL_IsPipelineCacheDataCompatible(
+    VulkanRenderer *renderer,
+    const void *data,
+    size_t size)
+{
+    VkPipelineCacheHeaderVersionOne header;
+
+    if (size < sizeof(header)) {
+        return false;
+    }
+
+    SDL_memcpy(&header, data, sizeof(header));
+
+    return header.headerSize >= sizeof(header) &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == renderer->physicalDeviceProperties.properties.vendorID &&
+           header.deviceID == renderer->physicalDeviceProperties.properties.deviceID &&
+           SDL_memcmp(header.pipelineCacheUUID, renderer->physicalDeviceProperties.properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+static void VULKAN_INTERNAL_CreatePipelineCache(
+    VulkanRenderer *renderer,
+    SDL_PropertiesID props)
+{
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+    VkResult vulkanResult;
+    const void *initialData = SDL_GetPointerProperty(props, SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_DATA_POINTER, NULL);
+    size_t initialDataSize = (size_t)SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_PIPELINE_CACHE_SIZE_NUMBER, 0);
+
+    /* Stale data from a different driver or device is legal to pass in, but
+     * some drivers have been known to misbehave, so just start empty instead.
+     */
+    if (initialData && !VULKAN_INTERNAL_IsPipelineCacheDataCompatible(renderer, initialData, initialDataSize)) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_GPU, "Discarding incompatible pipeline cache data");
+        initialData = NULL;
+    }
+    if (!initialData) {
+        initialDataSize = 0;
+    }
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = NULL;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = initialDataSize;
+    pipelineCacheCreateInfo.pInitialData = initialData;
+
+    vulkanResult = renderer->vkCreatePipelineCache(
+        renderer->logicalDevice,
+        &pipelineCacheCreateInfo,
+        NULL,
+        &renderer->pipelineCache);
+
+    if (vulkanResult != VK_SUCCESS) {
+        // Not fatal, pipelines will just be created uncached
+        SDL_LogWarn(SDL_LOG_CATEGORY_GPU, "vkCreatePipelineCache %s", VkErrorMessages(vulkanResult));
+        renderer->pipelineCache = VK_NULL_HANDLE;
+    }
+}
+
 static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, SDL_PropertiesID props)
 {
     VulkanRenderer *renderer;
@@ -11741,6 +13874,9 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
     renderer->debugMode = debugMode;
     renderer->preferLowPower = preferLowPower;
     renderer->allowedFramesInFlight = 2;
+    renderer->allowDedicatedQueues = SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEDICATED_QUEUES_BOOLEAN, false);
+    renderer->requireMeshShaders = SDL_GetBooleanProperty(props, SDL_PROP_GPU_DEVICE_CREATE_FEATURE_MESH_SHADERS_BOOLEAN, false);
+    renderer->defragBudget = (VkDeviceSize)SDL_max(0, SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_NUMBER, 0));
 
     if (!VULKAN_INTERNAL_PrepareVulkan(renderer)) {
         SET_STRING_ERROR("Failed to initialize Vulkan!");
@@ -11778,9 +13914,34 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
         return NULL;
     }
 
+    if (renderer->supportsSparseResidency2D || renderer->supportsSparseResidency3D) {
+        VkFenceCreateInfo fenceCreateInfo;
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.pNext = NULL;
+        fenceCreateInfo.flags = 0;
+
+        if (renderer->vkCreateFence(
+                renderer->logicalDevice,
+                &fenceCreateInfo,
+                NULL,
+                &renderer->sparseBindFence) != VK_SUCCESS) {
+            renderer->supportsSparseResidency2D = false;
+            renderer->supportsSparseResidency3D = false;
+        }
+    }
+
     // FIXME: just move this into this function
     result = (SDL_GPUDevice *)SDL_calloc(1, sizeof(SDL_GPUDevice));
     ASSIGN_DRIVER(VULKAN)
+    ASSIGN_QUEUE_DRIVER(VULKAN)
+    ASSIGN_QUERY_DRIVER(VULKAN)
+    ASSIGN_INDIRECT_COUNT_DRIVER(VULKAN)
+    if (renderer->supports.EXT_mesh_shader) {
+        ASSIGN_MESH_SHADER_DRIVER(VULKAN)
+    }
+    if (renderer->sparseBindFence != VK_NULL_HANDLE) {
+        ASSIGN_SPARSE_DRIVER(VULKAN)
+    }
 
     result->driverData = (SDL_GPURenderer *)renderer;
     result->shader_formats = SDL_GPU_SHADERFORMAT_SPIRV;
@@ -11856,6 +14017,8 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
 
     // Initialize caches
 
+    VULKAN_INTERNAL_CreatePipelineCache(renderer, props);
+
     renderer->commandPoolHashTable = SDL_CreateHashTable(
         0,  // !!! FIXME: a real guess here, for a _minimum_ if not a maximum, could be useful.
         false,  // manually synchronized due to submission timing
@@ -11906,7 +14069,7 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
 
     // Initialize fence pool
 
-    renderer->fencePool.lock = SDL_CreateMutex();
+    renderer->fencePool.lock = SDL_CreateNamedMutex("SDL_gpu_fence_pool", SDL_MUTEX_NONRECURSIVE);
 
     renderer->fencePool.availableFenceCapacity = 4;
     renderer->fencePool.availableFenceCount = 0;
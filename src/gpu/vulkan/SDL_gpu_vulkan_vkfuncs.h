@@ -50,8 +50,11 @@ VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceFormatProperties)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceImageFormatProperties)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties)
+VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceSparseImageFormatProperties)
 
-// VK_KHR_get_physical_device_properties2, needed for KHR_driver_properties
+// VK_KHR_get_physical_device_properties2, needed for KHR_driver_properties and EXT_memory_budget
+VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceFeatures2KHR)
+VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties2KHR)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties2KHR)
 
 // VK_KHR_surface
@@ -82,6 +85,7 @@ VULKAN_DEVICE_FUNCTION(vkAllocateMemory)
 VULKAN_DEVICE_FUNCTION(vkBeginCommandBuffer)
 VULKAN_DEVICE_FUNCTION(vkBindBufferMemory)
 VULKAN_DEVICE_FUNCTION(vkBindImageMemory)
+VULKAN_DEVICE_FUNCTION(vkCmdBeginQuery)
 VULKAN_DEVICE_FUNCTION(vkCmdBeginRenderPass)
 VULKAN_DEVICE_FUNCTION(vkCmdBindDescriptorSets)
 VULKAN_DEVICE_FUNCTION(vkCmdBindIndexBuffer)
@@ -102,13 +106,16 @@ VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexed)
 VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexedIndirect)
 VULKAN_DEVICE_FUNCTION(vkCmdDrawIndirect)
 VULKAN_DEVICE_FUNCTION(vkCmdEndRenderPass)
+VULKAN_DEVICE_FUNCTION(vkCmdEndQuery)
 VULKAN_DEVICE_FUNCTION(vkCmdPipelineBarrier)
+VULKAN_DEVICE_FUNCTION(vkCmdResetQueryPool)
 VULKAN_DEVICE_FUNCTION(vkCmdResolveImage)
 VULKAN_DEVICE_FUNCTION(vkCmdSetBlendConstants)
 VULKAN_DEVICE_FUNCTION(vkCmdSetDepthBias)
 VULKAN_DEVICE_FUNCTION(vkCmdSetScissor)
 VULKAN_DEVICE_FUNCTION(vkCmdSetStencilReference)
 VULKAN_DEVICE_FUNCTION(vkCmdSetViewport)
+VULKAN_DEVICE_FUNCTION(vkCmdWriteTimestamp)
 VULKAN_DEVICE_FUNCTION(vkCreateBuffer)
 VULKAN_DEVICE_FUNCTION(vkCreateCommandPool)
 VULKAN_DEVICE_FUNCTION(vkCreateDescriptorPool)
@@ -121,6 +128,7 @@ VULKAN_DEVICE_FUNCTION(vkCreateImage)
 VULKAN_DEVICE_FUNCTION(vkCreateImageView)
 VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache)
 VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout)
+VULKAN_DEVICE_FUNCTION(vkCreateQueryPool)
 VULKAN_DEVICE_FUNCTION(vkCreateRenderPass)
 VULKAN_DEVICE_FUNCTION(vkCreateSampler)
 VULKAN_DEVICE_FUNCTION(vkCreateSemaphore)
@@ -137,6 +145,7 @@ VULKAN_DEVICE_FUNCTION(vkDestroyImageView)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipeline)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout)
+VULKAN_DEVICE_FUNCTION(vkDestroyQueryPool)
 VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass)
 VULKAN_DEVICE_FUNCTION(vkDestroySampler)
 VULKAN_DEVICE_FUNCTION(vkDestroySemaphore)
@@ -147,10 +156,13 @@ VULKAN_DEVICE_FUNCTION(vkFreeCommandBuffers)
 VULKAN_DEVICE_FUNCTION(vkFreeMemory)
 VULKAN_DEVICE_FUNCTION(vkGetDeviceQueue)
 VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData)
+VULKAN_DEVICE_FUNCTION(vkGetQueryPoolResults)
 VULKAN_DEVICE_FUNCTION(vkGetFenceStatus)
 VULKAN_DEVICE_FUNCTION(vkGetBufferMemoryRequirements)
 VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements)
+VULKAN_DEVICE_FUNCTION(vkGetImageSparseMemoryRequirements)
 VULKAN_DEVICE_FUNCTION(vkMapMemory)
+VULKAN_DEVICE_FUNCTION(vkQueueBindSparse)
 VULKAN_DEVICE_FUNCTION(vkQueueSubmit)
 VULKAN_DEVICE_FUNCTION(vkQueueWaitIdle)
 VULKAN_DEVICE_FUNCTION(vkResetCommandBuffer)
@@ -161,6 +173,21 @@ VULKAN_DEVICE_FUNCTION(vkUnmapMemory)
 VULKAN_DEVICE_FUNCTION(vkUpdateDescriptorSets)
 VULKAN_DEVICE_FUNCTION(vkWaitForFences)
 
+// VK_KHR_draw_indirect_count, optional
+VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexedIndirectCountKHR)
+VULKAN_DEVICE_FUNCTION(vkCmdDrawIndirectCountKHR)
+
+// VK_EXT_mesh_shader, optional
+VULKAN_DEVICE_FUNCTION(vkCmdDrawMeshTasksEXT)
+VULKAN_DEVICE_FUNCTION(vkCmdDrawMeshTasksIndirectEXT)
+
+// VK_KHR_present_wait, optional
+VULKAN_DEVICE_FUNCTION(vkWaitForPresentKHR)
+
+// VK_KHR_dynamic_rendering, optional
+VULKAN_DEVICE_FUNCTION(vkCmdBeginRenderingKHR)
+VULKAN_DEVICE_FUNCTION(vkCmdEndRenderingKHR)
+
 // VK_KHR_swapchain
 VULKAN_DEVICE_FUNCTION(vkAcquireNextImageKHR)
 VULKAN_DEVICE_FUNCTION(vkCreateSwapchainKHR)
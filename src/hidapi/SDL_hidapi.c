@@ -559,6 +559,7 @@ typedef struct PLATFORM_hid_device_ PLATFORM_hid_device;
 #define hid_open_path                PLATFORM_hid_open_path
 #define hid_open                     PLATFORM_hid_open
 #define hid_read                     PLATFORM_hid_read
+#define hid_read_reports             PLATFORM_hid_read_reports
 #define hid_read_timeout             PLATFORM_hid_read_timeout
 #define hid_send_feature_report      PLATFORM_hid_send_feature_report
 #define hid_set_nonblocking          PLATFORM_hid_set_nonblocking
@@ -607,6 +608,7 @@ typedef struct PLATFORM_hid_device_ PLATFORM_hid_device;
 #undef hid_open
 #undef hid_open_path
 #undef hid_read
+#undef hid_read_reports
 #undef hid_read_timeout
 #undef hid_send_feature_report
 #undef hid_set_nonblocking
@@ -803,6 +805,7 @@ typedef struct LIBUSB_hid_device_ LIBUSB_hid_device;
 #define hid_open                     LIBUSB_hid_open
 #define hid_open_path                LIBUSB_hid_open_path
 #define hid_read                     LIBUSB_hid_read
+#define hid_read_reports             LIBUSB_hid_read_reports
 #define hid_read_timeout             LIBUSB_hid_read_timeout
 #define hid_send_feature_report      LIBUSB_hid_send_feature_report
 #define hid_set_nonblocking          LIBUSB_hid_set_nonblocking
@@ -867,6 +870,7 @@ typedef struct LIBUSB_hid_device_ LIBUSB_hid_device;
 #undef hid_open
 #undef hid_open_path
 #undef hid_read
+#undef hid_read_reports
 #undef hid_read_timeout
 #undef hid_send_feature_report
 #undef hid_set_nonblocking
@@ -937,6 +941,8 @@ struct hidapi_backend
     struct hid_device_info *(*hid_get_device_info)(void *device);
     int (*hid_get_report_descriptor)(void *device, unsigned char *buf, size_t buf_size);
     const wchar_t *(*hid_error)(void *device);
+    // optional, SDL_hid_read_reports() reads one report at a time if this is NULL.
+    int (*hid_read_reports)(void *device, unsigned char *data, size_t report_size, int *lengths, int max_reports);
 };
 
 #ifdef HAVE_PLATFORM_BACKEND
@@ -955,7 +961,12 @@ static const struct hidapi_backend PLATFORM_Backend = {
     (void *)PLATFORM_hid_get_indexed_string,
     (void *)PLATFORM_hid_get_device_info,
     (void *)PLATFORM_hid_get_report_descriptor,
-    (void *)PLATFORM_hid_error
+    (void *)PLATFORM_hid_error,
+#ifdef HAVE_PLATFORM_READ_REPORTS
+    (void *)PLATFORM_hid_read_reports
+#else
+    NULL
+#endif
 };
 #endif // HAVE_PLATFORM_BACKEND
 
@@ -975,7 +986,8 @@ static const struct hidapi_backend DRIVER_Backend = {
     (void *)DRIVER_hid_get_indexed_string,
     (void *)DRIVER_hid_get_device_info,
     (void *)DRIVER_hid_get_report_descriptor,
-    (void *)DRIVER_hid_error
+    (void *)DRIVER_hid_error,
+    NULL
 };
 #endif // HAVE_DRIVER_BACKEND
 
@@ -995,7 +1007,8 @@ static const struct hidapi_backend LIBUSB_Backend = {
     (void *)LIBUSB_hid_get_indexed_string,
     (void *)LIBUSB_hid_get_device_info,
     (void *)LIBUSB_hid_get_report_descriptor,
-    (void *)LIBUSB_hid_error
+    (void *)LIBUSB_hid_error,
+    (void *)LIBUSB_hid_read_reports
 };
 #endif // HAVE_LIBUSB
 
@@ -1592,6 +1605,30 @@ int SDL_hid_read_timeout(SDL_hid_device *device, unsigned char *data, size_t len
     return device->backend->hid_read_timeout(device->device, data, length, milliseconds);
 }
 
+int SDL_hid_read_reports(SDL_hid_device *device, unsigned char *data, size_t report_size, int *lengths, int max_reports)
+{
+    int num_reports;
+
+    CHECK_DEVICE_MAGIC(device, -1);
+
+    if (device->backend->hid_read_reports) {
+        return device->backend->hid_read_reports(device->device, data, report_size, lengths, max_reports);
+    }
+
+    for (num_reports = 0; num_reports < max_reports; ++num_reports) {
+        int size = device->backend->hid_read_timeout(device->device, data + num_reports * report_size, report_size, 0);
+        if (size <= 0) {
+            if (size < 0 && num_reports == 0) {
+                return -1;
+            }
+            // Any error after this will be reported by the next read
+            break;
+        }
+        lengths[num_reports] = size;
+    }
+    return num_reports;
+}
+
 int SDL_hid_read(SDL_hid_device *device, unsigned char *data, size_t length)
 {
     CHECK_DEVICE_MAGIC(device, -1);
@@ -24,6 +24,11 @@
 /* Return true if the HIDAPI should ignore a device during enumeration */
 extern bool SDL_HIDAPI_ShouldIgnoreDevice(int bus_type, Uint16 vendor_id, Uint16 product_id, Uint16 usage_page, Uint16 usage);
 
+/* Read every input report that's already queued without waiting, up to max_reports of them.
+   Report i is stored at data + i * report_size and its length in lengths[i].
+   Returns the number of reports read, 0 if there were none, or -1 on error. */
+extern int SDL_hid_read_reports(SDL_hid_device *device, unsigned char *data, size_t report_size, int *lengths, int max_reports);
+
 #ifdef SDL_JOYSTICK_HIDAPI
 #ifdef HAVE_LIBUSB
 #define HAVE_ENABLE_GAMECUBE_ADAPTORS
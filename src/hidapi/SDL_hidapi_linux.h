@@ -43,5 +43,6 @@ static const SDL_UDEV_Symbols *udev_ctx = NULL;
 #define HIDAPI_ALLOW_BUILD_WORKAROUND_KERNEL_2_6_39
 #include "linux/hid.c"
 #define HAVE_PLATFORM_BACKEND 1
+#define HAVE_PLATFORM_READ_REPORTS 1
 
 #endif /* SDL_USE_LIBUDEV */
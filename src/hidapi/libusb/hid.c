@@ -1750,6 +1750,25 @@ ret:
 	return bytes_read;
 }
 
+/* SDL: hand back every report that's already queued, up to max_reports of them, under a single lock. */
+static int hid_read_reports(hid_device *dev, unsigned char *data, size_t report_size, int *lengths, int max_reports)
+{
+	int num_reports = 0;
+
+	hidapi_thread_mutex_lock(&dev->thread_state);
+	while (dev->input_reports && num_reports < max_reports) {
+		lengths[num_reports] = return_data(dev, data + num_reports * report_size, report_size);
+		++num_reports;
+	}
+	if (num_reports == 0 && dev->shutdown_thread) {
+		/* This means the device has been disconnected. */
+		num_reports = -1;
+	}
+	hidapi_thread_mutex_unlock(&dev->thread_state);
+
+	return num_reports;
+}
+
 int HID_API_EXPORT hid_read(hid_device *dev, unsigned char *data, size_t length)
 {
 	return hid_read_timeout(dev, data, length, dev->blocking ? -1 : 0);
@@ -1178,6 +1178,9 @@ hid_device * HID_API_EXPORT hid_open_path(const char *path)
 	if (dev->device_handle >= 0) {
 		int res, desc_size = 0;
 
+		/* SDL: reads always poll() first, this lets hid_read_reports() stop when the queue is empty */
+		fcntl(dev->device_handle, F_SETFL, fcntl(dev->device_handle, F_GETFL) | O_NONBLOCK);
+
 		/* Make sure this is a HIDRAW device - responds to HIDIOCGRDESCSIZE */
 		res = ioctl(dev->device_handle, HIDIOCGRDESCSIZE, &desc_size);
 		if (res < 0) {
@@ -1224,13 +1227,17 @@ int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t
 
 	int bytes_read;
 
-	if (milliseconds >= 0) {
-		/* Milliseconds is either 0 (non-blocking) or > 0 (contains
-		   a valid timeout). In both cases we want to call poll()
-		   and wait for data to arrive.  Don't rely on non-blocking
+	{
+		/* Milliseconds is either -1 (blocking), 0 (non-blocking) or
+		   > 0 (contains a valid timeout). In all cases we want to call
+		   poll() and wait for data to arrive.  Don't rely on non-blocking
 		   operation (O_NONBLOCK) since some kernels don't seem to
 		   properly report device disconnection through read() when
-		   in non-blocking mode.  */
+		   in non-blocking mode.
+
+		   SDL: the handle is opened with O_NONBLOCK anyway, so that
+		   hid_read_reports() can drain the queue without a poll() per
+		   report, which means even blocking reads have to poll first. */
 		int ret;
 		struct pollfd fds;
 
@@ -1269,6 +1276,29 @@ int HID_API_EXPORT hid_read_timeout(hid_device *dev, unsigned char *data, size_t
 	return bytes_read;
 }
 
+/* SDL: read every report that's already queued, up to max_reports of them.
+   Only the first read is preceded by poll(), which also catches a
+   disconnection, the rest just read until the queue is empty. */
+static int hid_read_reports(hid_device *dev, unsigned char *data, size_t report_size, int *lengths, int max_reports)
+{
+	int num_reports;
+	int bytes_read = hid_read_timeout(dev, data, report_size, 0);
+	if (bytes_read <= 0) {
+		return bytes_read;
+	}
+	lengths[0] = bytes_read;
+
+	for (num_reports = 1; num_reports < max_reports; ++num_reports) {
+		bytes_read = read(dev->device_handle, data + num_reports * report_size, report_size);
+		if (bytes_read <= 0) {
+			/* EAGAIN means the queue is empty, any other error is reported by the next read. */
+			break;
+		}
+		lengths[num_reports] = bytes_read;
+	}
+	return num_reports;
+}
+
 int HID_API_EXPORT hid_read(hid_device *dev, unsigned char *data, size_t length)
 {
 	return hid_read_timeout(dev, data, length, (dev->blocking)? -1: 0);
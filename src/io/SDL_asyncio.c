@@ -40,7 +40,7 @@ static const char *AsyncFileModeValid(const char *mode)
     return NULL;
 }
 
-SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
+static SDL_AsyncIO *OpenAsyncIOFile(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options)
 {
     if (!file) {
         SDL_InvalidParamError("file");
@@ -67,68 +67,177 @@ SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
         return NULL;
     }
 
-    if (!SDL_SYS_AsyncIOFromFile(file, binary_mode, asyncio)) {
+    asyncio->alignment = 1;
+    if (!SDL_SYS_AsyncIOFromFile(file, binary_mode, options, asyncio)) {
         SDL_DestroyMutex(asyncio->lock);
         SDL_free(asyncio);
         return NULL;
     }
 
+    if ((options->advice != SDL_ASYNCIO_ADVICE_NORMAL) && asyncio->iface.advise) {
+        asyncio->iface.advise(asyncio->userdata, 0, 0, options->advice);  // just a hint, don't fail the open over it.
+    }
+
     return asyncio;
 }
 
-Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
+SDL_AsyncIO *SDL_AsyncIOFromFile(const char *file, const char *mode)
+{
+    SDL_AsyncIOFileOptions options;
+    SDL_zero(options);
+    options.advice = SDL_ASYNCIO_ADVICE_NORMAL;
+    return OpenAsyncIOFile(file, mode, &options);
+}
+
+SDL_AsyncIO *SDL_AsyncIOFromFileWithProperties(SDL_PropertiesID props)
+{
+    const char *file = SDL_GetStringProperty(props, SDL_PROP_ASYNCIO_CREATE_FILENAME_STRING, NULL);
+    const char *mode = SDL_GetStringProperty(props, SDL_PROP_ASYNCIO_CREATE_MODE_STRING, "r");
+
+    SDL_AsyncIOFileOptions options;
+    SDL_zero(options);
+    options.unbuffered = SDL_GetBooleanProperty(props, SDL_PROP_ASYNCIO_CREATE_UNBUFFERED_BOOLEAN, false);
+    options.advice = (SDL_AsyncIOAdvice) SDL_GetNumberProperty(props, SDL_PROP_ASYNCIO_CREATE_ADVICE_NUMBER, SDL_ASYNCIO_ADVICE_NORMAL);
+    if ((options.advice < SDL_ASYNCIO_ADVICE_NORMAL) || (options.advice > SDL_ASYNCIO_ADVICE_DONTNEED)) {
+        SDL_InvalidParamError(SDL_PROP_ASYNCIO_CREATE_ADVICE_NUMBER);
+        return NULL;
+    }
+
+    return OpenAsyncIOFile(file, mode, &options);
+}
+
+size_t SDL_GetAsyncIOAlignment(SDL_AsyncIO *asyncio)
 {
     if (!asyncio) {
         SDL_InvalidParamError("asyncio");
-        return -1;
+        return 0;
     }
-    return asyncio->iface.size(asyncio->userdata);
+    return asyncio->alignment;
 }
 
-static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+bool SDL_AdviseAsyncIO(SDL_AsyncIO *asyncio, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice)
 {
     if (!asyncio) {
         return SDL_InvalidParamError("asyncio");
-    } else if (!ptr) {
-        return SDL_InvalidParamError("ptr");
-    } else if (!queue) {
-        return SDL_InvalidParamError("queue");
+    } else if ((advice < SDL_ASYNCIO_ADVICE_NORMAL) || (advice > SDL_ASYNCIO_ADVICE_DONTNEED)) {
+        return SDL_InvalidParamError("advice");
+    } else if (!asyncio->iface.advise) {
+        return true;  // the backend can't do anything with hints, which is fine.
     }
+    return asyncio->iface.advise(asyncio->userdata, offset, size, advice);
+}
 
-    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*task));
+// unbuffered files fail later with an unhelpful error if this isn't respected, so catch it up front.
+static bool CheckAsyncIOAlignment(SDL_AsyncIO *asyncio, const void *ptr, Uint64 offset, Uint64 size)
+{
+    const size_t alignment = asyncio->alignment;
+    if ((alignment > 1) && ((((uintptr_t) ptr) % alignment) || (offset % alignment) || (size % alignment))) {
+        return SDL_SetError("Unbuffered i/o needs buffers, offsets and sizes aligned to %u bytes", (unsigned int) alignment);
+    }
+    return true;
+}
+
+Sint64 SDL_GetAsyncIOSize(SDL_AsyncIO *asyncio)
+{
+    if (!asyncio) {
+        SDL_InvalidParamError("asyncio");
+        return -1;
+    }
+    return asyncio->iface.size(asyncio->userdata);
+}
+
+static SDL_AsyncIOTask *CreateAsyncIOTask(SDL_AsyncIO *asyncio, SDL_AsyncIOTaskType type, void *ptr, Uint64 offset, Uint64 size, int num_segments, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) SDL_calloc(1, sizeof (*task) + (num_segments * sizeof (SDL_AsyncIOSegment)));
     if (!task) {
-        return false;
+        return NULL;
     }
 
     task->asyncio = asyncio;
-    task->type = reading ? SDL_ASYNCIO_TASK_READ : SDL_ASYNCIO_TASK_WRITE;
+    task->type = type;
     task->offset = offset;
     task->buffer = ptr;
     task->requested_size = size;
     task->app_userdata = userdata;
     task->queue = queue;
+    if (num_segments > 0) {
+        task->segments = (SDL_AsyncIOSegment *) (task + 1);
+        task->num_segments = num_segments;
+    }
+    return task;
+}
+
+static void DestroyAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_free(task->backend_data);
+    SDL_free(task);
+}
+
+// Add a new task to its SDL_AsyncIO, so closing waits for it. This fails if the SDL_AsyncIO is already closing.
+static bool LinkAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIO *asyncio = task->asyncio;
 
     SDL_LockMutex(asyncio->lock);
     if (asyncio->closing) {
-        SDL_free(task);
         SDL_UnlockMutex(asyncio->lock);
         return SDL_SetError("SDL_AsyncIO is closing, can't start new tasks");
     }
     LINKED_LIST_PREPEND(task, asyncio->tasks, asyncio);
-    SDL_AddAtomicInt(&queue->tasks_inflight, 1);
+    SDL_AddAtomicInt(&task->queue->tasks_inflight, 1);
     SDL_UnlockMutex(asyncio->lock);
+    return true;
+}
 
-    const bool queued = reading ? asyncio->iface.read(asyncio->userdata, task) : asyncio->iface.write(asyncio->userdata, task);
-    if (!queued) {
-        SDL_AddAtomicInt(&queue->tasks_inflight, -1);
-        SDL_LockMutex(asyncio->lock);
-        LINKED_LIST_UNLINK(task, asyncio);
-        SDL_UnlockMutex(asyncio->lock);
-        SDL_free(task);
-        task = NULL;
+// Take back a task that was linked but never started.
+static void UnlinkAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AddAtomicInt(&task->queue->tasks_inflight, -1);
+    SDL_LockMutex(task->asyncio->lock);
+    LINKED_LIST_UNLINK(task, asyncio);
+    SDL_UnlockMutex(task->asyncio->lock);
+}
+
+static bool StartAsyncIOTask(SDL_AsyncIOTask *task)
+{
+    SDL_AsyncIO *asyncio = task->asyncio;
+    const bool reading = (task->type == SDL_ASYNCIO_TASK_READ);
+
+    if (task->segments) {
+        return reading ? asyncio->iface.readv(asyncio->userdata, task) : asyncio->iface.writev(asyncio->userdata, task);
     }
+    return reading ? asyncio->iface.read(asyncio->userdata, task) : asyncio->iface.write(asyncio->userdata, task);
+}
 
-    return (task != NULL);
+static bool RequestAsyncIO(bool reading, SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    } else if (!ptr) {
+        return SDL_InvalidParamError("ptr");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!CheckAsyncIOAlignment(asyncio, ptr, offset, size)) {
+        return false;
+    }
+
+    SDL_AsyncIOTask *task = CreateAsyncIOTask(asyncio, reading ? SDL_ASYNCIO_TASK_READ : SDL_ASYNCIO_TASK_WRITE, ptr, offset, size, 0, queue, userdata);
+    if (!task) {
+        return false;
+    }
+
+    if (!LinkAsyncIOTask(task)) {
+        DestroyAsyncIOTask(task);
+        return false;
+    }
+
+    if (!StartAsyncIOTask(task)) {
+        UnlinkAsyncIOTask(task);
+        DestroyAsyncIOTask(task);
+        return false;
+    }
+
+    return true;
 }
 
 bool SDL_ReadAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
@@ -141,6 +250,238 @@ bool SDL_WriteAsyncIO(SDL_AsyncIO *asyncio, void *ptr, Uint64 offset, Uint64 siz
     return RequestAsyncIO(false, asyncio, ptr, offset, size, queue, userdata);
 }
 
+static void RecordAsyncIOGroupMember(SDL_AsyncIOGroup *group, const SDL_AsyncIOTask *task)
+{
+    if (group->requests) {
+        SDL_AsyncIORequest *request = &group->requests[task->group_index];
+        request->result = task->result;
+        request->bytes_transferred = task->result_size;
+    }
+
+    SDL_LockSpinlock(&group->lock);
+    group->task.result_size += task->result_size;
+    if (task->result == SDL_ASYNCIO_FAILURE) {
+        group->task.result = SDL_ASYNCIO_FAILURE;
+    } else if ((task->result == SDL_ASYNCIO_CANCELED) && (group->task.result == SDL_ASYNCIO_COMPLETE)) {
+        group->task.result = SDL_ASYNCIO_CANCELED;
+    }
+    SDL_UnlockSpinlock(&group->lock);
+}
+
+// For a group that nothing else is going to report, hand it to the queue directly; Get/Wait check for these first.
+static void PushReadyAsyncIOGroup(SDL_AsyncIOQueue *queue, SDL_AsyncIOGroup *group)
+{
+    SDL_LockSpinlock(&queue->ready_lock);
+    group->next_ready = queue->ready_groups;
+    SDL_SetAtomicPointer((void **) &queue->ready_groups, group);
+    SDL_UnlockSpinlock(&queue->ready_lock);
+    queue->iface.signal(queue->userdata);
+}
+
+/* Start every member of a group, or none of them if any can't be set up.
+   This takes ownership of the group and its tasks, freeing them on failure.
+   Once this returns true, the group is reported to the app after its last
+   member finishes, and it's freed after that. */
+static bool StartAsyncIOGroup(SDL_AsyncIOGroup *group, SDL_AsyncIOTask **tasks, int num_tasks)
+{
+    SDL_AsyncIOQueue *queue = group->task.queue;
+    int i;
+
+    for (i = 0; i < num_tasks; i++) {
+        if (!LinkAsyncIOTask(tasks[i])) {
+            break;
+        }
+    }
+    if ((i < num_tasks) || (queue->iface.begin_batch && !queue->iface.begin_batch(queue->userdata))) {
+        while (i--) {
+            UnlinkAsyncIOTask(tasks[i]);
+        }
+        for (i = 0; i < num_tasks; i++) {
+            DestroyAsyncIOTask(tasks[i]);
+        }
+        SDL_free(group);
+        return false;
+    }
+
+    // Hold one extra count until everything is started, so the group can't be reported halfway through.
+    SDL_SetAtomicInt(&group->remaining, num_tasks + 1);
+
+    int num_started = 0;
+    for (i = 0; i < num_tasks; i++) {
+        SDL_AsyncIOTask *task = tasks[i];
+        if (StartAsyncIOTask(task)) {
+            num_started++;
+        } else {
+            // The OS refused this one after others may have started, so report it as a failure with the rest.
+            task->result = SDL_ASYNCIO_FAILURE;
+            RecordAsyncIOGroupMember(group, task);
+            UnlinkAsyncIOTask(task);
+            DestroyAsyncIOTask(task);
+            SDL_AddAtomicInt(&group->remaining, -1);
+        }
+    }
+
+    if (queue->iface.end_batch) {
+        queue->iface.end_batch(queue->userdata);
+    }
+
+    if (num_started == 0) {
+        SDL_free(group);
+        return false;
+    }
+
+    if (SDL_AtomicDecRef(&group->remaining)) {
+        // Everything already finished, so nothing else is going to report this group; hand it to the queue ourselves.
+        PushReadyAsyncIOGroup(queue, group);
+    }
+    return true;
+}
+
+static bool RequestAsyncIOSegments(bool reading, SDL_AsyncIO *asyncio, const SDL_AsyncIOSegment *segments, int num_segments, Uint64 offset, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    if (!asyncio) {
+        return SDL_InvalidParamError("asyncio");
+    } else if (!segments) {
+        return SDL_InvalidParamError("segments");
+    } else if (num_segments <= 0) {
+        return SDL_InvalidParamError("num_segments");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    Uint64 total = 0;
+    for (int i = 0; i < num_segments; i++) {
+        if (!segments[i].buffer) {
+            return SDL_InvalidParamError("segments");
+        } else if ((segments[i].size > SDL_SIZE_MAX) || (segments[i].size > (SDL_MAX_UINT64 - total))) {
+            return SDL_SetError("Segments are too large");
+        } else if (!CheckAsyncIOAlignment(asyncio, segments[i].buffer, offset, segments[i].size)) {
+            return false;
+        }
+        total += segments[i].size;
+    }
+
+    if (num_segments == 1) {
+        return RequestAsyncIO(reading, asyncio, segments[0].buffer, offset, total, queue, userdata);
+    }
+
+    const SDL_AsyncIOTaskType type = reading ? SDL_ASYNCIO_TASK_READ : SDL_ASYNCIO_TASK_WRITE;
+    const bool vectored = reading ? (asyncio->iface.readv != NULL) : (asyncio->iface.writev != NULL);
+    if (vectored) {
+        SDL_AsyncIOTask *task = CreateAsyncIOTask(asyncio, type, segments[0].buffer, offset, total, num_segments, queue, userdata);
+        if (!task) {
+            return false;
+        }
+        SDL_memcpy(task->segments, segments, num_segments * sizeof (*segments));
+
+        if (!LinkAsyncIOTask(task)) {
+            DestroyAsyncIOTask(task);
+            return false;
+        }
+        if (!StartAsyncIOTask(task)) {
+            UnlinkAsyncIOTask(task);
+            DestroyAsyncIOTask(task);
+            return false;
+        }
+        return true;
+    }
+
+    // The backend can't do this in one request, so it becomes a group of plain requests, one per segment, reported as one.
+    SDL_AsyncIOGroup *group = (SDL_AsyncIOGroup *) SDL_calloc(1, sizeof (*group) + (num_segments * sizeof (SDL_AsyncIOTask *)));
+    if (!group) {
+        return false;
+    }
+    group->task.asyncio = asyncio;
+    group->task.type = type;
+    group->task.buffer = segments[0].buffer;
+    group->task.offset = offset;
+    group->task.requested_size = total;
+    group->task.app_userdata = userdata;
+    group->task.queue = queue;
+
+    SDL_AsyncIOTask **tasks = (SDL_AsyncIOTask **) (group + 1);
+    Uint64 segment_offset = offset;
+    for (int i = 0; i < num_segments; i++) {
+        tasks[i] = CreateAsyncIOTask(asyncio, type, segments[i].buffer, segment_offset, segments[i].size, 0, queue, NULL);
+        if (!tasks[i]) {
+            while (i--) {
+                DestroyAsyncIOTask(tasks[i]);
+            }
+            SDL_free(group);
+            return false;
+        }
+        tasks[i]->group = group;
+        tasks[i]->group_index = i;
+        segment_offset += segments[i].size;
+    }
+
+    return StartAsyncIOGroup(group, tasks, num_segments);
+}
+
+bool SDL_ReadAsyncIOSegments(SDL_AsyncIO *asyncio, const SDL_AsyncIOSegment *segments, int num_segments, Uint64 offset, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return RequestAsyncIOSegments(true, asyncio, segments, num_segments, offset, queue, userdata);
+}
+
+bool SDL_WriteAsyncIOSegments(SDL_AsyncIO *asyncio, const SDL_AsyncIOSegment *segments, int num_segments, Uint64 offset, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    return RequestAsyncIOSegments(false, asyncio, segments, num_segments, offset, queue, userdata);
+}
+
+bool SDL_SubmitAsyncIOBatch(SDL_AsyncIORequest *requests, int num_requests, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    if (!requests) {
+        return SDL_InvalidParamError("requests");
+    } else if (num_requests <= 0) {
+        return SDL_InvalidParamError("num_requests");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    }
+
+    Uint64 total = 0;
+    for (int i = 0; i < num_requests; i++) {
+        const SDL_AsyncIORequest *request = &requests[i];
+        if (!request->asyncio || !request->buffer) {
+            return SDL_InvalidParamError("requests");
+        } else if ((request->type != SDL_ASYNCIO_TASK_READ) && (request->type != SDL_ASYNCIO_TASK_WRITE)) {
+            return SDL_SetError("Batched requests must be reads or writes");
+        } else if (!CheckAsyncIOAlignment(request->asyncio, request->buffer, request->offset, request->size)) {
+            return false;
+        }
+        total += request->size;
+    }
+
+    SDL_AsyncIOGroup *group = (SDL_AsyncIOGroup *) SDL_calloc(1, sizeof (*group) + (num_requests * sizeof (SDL_AsyncIOTask *)));
+    if (!group) {
+        return false;
+    }
+    group->task.type = SDL_ASYNCIO_TASK_BATCH;
+    group->task.buffer = requests;
+    group->task.requested_size = total;
+    group->task.app_userdata = userdata;
+    group->task.queue = queue;
+    group->requests = requests;
+
+    SDL_AsyncIOTask **tasks = (SDL_AsyncIOTask **) (group + 1);
+    for (int i = 0; i < num_requests; i++) {
+        SDL_AsyncIORequest *request = &requests[i];
+        request->result = SDL_ASYNCIO_COMPLETE;
+        request->bytes_transferred = 0;
+        tasks[i] = CreateAsyncIOTask(request->asyncio, request->type, request->buffer, request->offset, request->size, 0, queue, NULL);
+        if (!tasks[i]) {
+            while (i--) {
+                DestroyAsyncIOTask(tasks[i]);
+            }
+            SDL_free(group);
+            return false;
+        }
+        tasks[i]->group = group;
+        tasks[i]->group_index = i;
+    }
+
+    return StartAsyncIOGroup(group, tasks, num_requests);
+}
+
 bool SDL_CloseAsyncIO(SDL_AsyncIO *asyncio, bool flush, SDL_AsyncIOQueue *queue, void *userdata)
 {
     if (!asyncio) {
@@ -196,16 +537,12 @@ SDL_AsyncIOQueue *SDL_CreateAsyncIOQueue(void)
     return queue;
 }
 
-static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
+static void GetAsyncIOGroupOutcome(SDL_AsyncIOGroup *group, SDL_AsyncIOOutcome *outcome)
 {
-    if (!task || !outcome) {
-        return false;
-    }
-
-    SDL_AsyncIO *asyncio = task->asyncio;
+    const SDL_AsyncIOTask *task = &group->task;
 
     SDL_zerop(outcome);
-    outcome->asyncio = asyncio->oneshot ? NULL : asyncio;
+    outcome->asyncio = task->asyncio;
     outcome->result = task->result;
     outcome->type = task->type;
     outcome->buffer = task->buffer;
@@ -214,6 +551,151 @@ static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *out
     outcome->bytes_transferred = task->result_size;
     outcome->userdata = task->app_userdata;
 
+    SDL_free(group);
+}
+
+static bool StartAsyncIOLoadChunk(SDL_AsyncIOLoad *load, Uint64 offset, Uint64 size)
+{
+    SDL_AsyncIOTask *task = CreateAsyncIOTask(load->asyncio, SDL_ASYNCIO_TASK_READ, load->buffer + offset, offset, size, 0, load->queue, NULL);
+    if (!task) {
+        return false;
+    }
+    task->load = load;
+
+    if (!LinkAsyncIOTask(task)) {
+        DestroyAsyncIOTask(task);
+        return false;
+    }
+
+    if (!StartAsyncIOTask(task)) {
+        UnlinkAsyncIOTask(task);
+        DestroyAsyncIOTask(task);
+        return false;
+    }
+
+    return true;
+}
+
+static void RecordAsyncIOLoadChunk(SDL_AsyncIOLoad *load, const SDL_AsyncIOTask *task)
+{
+    SDL_LockSpinlock(&load->lock);
+    load->bytes_done += task->result_size;
+    if (task->result == SDL_ASYNCIO_FAILURE) {
+        load->result = SDL_ASYNCIO_FAILURE;
+    } else if ((task->result == SDL_ASYNCIO_CANCELED) && (load->result == SDL_ASYNCIO_COMPLETE)) {
+        load->result = SDL_ASYNCIO_CANCELED;
+    } else if (task->result_size < task->requested_size) {
+        load->size = SDL_min(load->size, task->offset + task->result_size);  // hit the end of the file.
+    }
+    const bool report = (load->progress && (load->result == SDL_ASYNCIO_COMPLETE) && !load->discarding);
+    const Uint64 bytes_done = load->bytes_done;
+    const Uint64 bytes_total = load->size;
+    SDL_UnlockSpinlock(&load->lock);
+
+    if (report && !load->progress(load->progress_userdata, bytes_done, bytes_total)) {
+        SDL_LockSpinlock(&load->lock);
+        if (load->result == SDL_ASYNCIO_COMPLETE) {
+            load->result = SDL_ASYNCIO_CANCELED;
+        }
+        SDL_UnlockSpinlock(&load->lock);
+    }
+}
+
+/* Start as many chunks as the load allows, then drop the caller's reference
+   to it. The one that drops the last reference closes the file and posts the
+   whole load's outcome to the queue. */
+static void AdvanceAsyncIOLoad(SDL_AsyncIOLoad *load)
+{
+    bool done;
+    for (;;) {
+        SDL_LockSpinlock(&load->lock);
+        // `inflight` counts the caller's reference too, so this allows max_inflight chunks besides it.
+        if ((load->result == SDL_ASYNCIO_COMPLETE) && !load->discarding && (load->next_offset < load->size) && (load->inflight <= load->max_inflight)) {
+            const Uint64 offset = load->next_offset;
+            const Uint64 size = SDL_min(load->chunk_size, load->size - offset);
+            load->next_offset += size;
+            load->inflight++;
+            SDL_UnlockSpinlock(&load->lock);
+            if (!StartAsyncIOLoadChunk(load, offset, size)) {
+                SDL_LockSpinlock(&load->lock);
+                load->inflight--;
+                load->result = SDL_ASYNCIO_FAILURE;
+                SDL_UnlockSpinlock(&load->lock);
+            }
+            continue;
+        }
+        done = (--load->inflight == 0);
+        SDL_UnlockSpinlock(&load->lock);
+        break;
+    }
+
+    if (!done) {
+        return;
+    }
+
+    SDL_CloseAsyncIO(load->asyncio, false, load->queue, NULL);  // a oneshot close isn't reported. If this fails, it's already a dramatic system failure.
+
+    SDL_AsyncIOOutcome outcome;
+    SDL_zero(outcome);
+    outcome.type = SDL_ASYNCIO_TASK_READ;
+    outcome.result = load->result;
+    outcome.buffer = load->buffer;
+    outcome.bytes_requested = load->requested;
+    outcome.bytes_transferred = load->bytes_done;
+    outcome.userdata = load->app_userdata;
+    if (load->owns_buffer) {
+        load->buffer[load->bytes_done] = '\0';  // chunks past the end of the file come back empty, so this is the end of the data.
+        if (load->discarding) {
+            SDL_free(load->buffer);  // the app will never see this, so throw it away.
+            outcome.buffer = NULL;
+        }
+    }
+
+    SDL_PostAsyncIOOutcome(load->reserved, &outcome);
+    SDL_free(load);
+}
+
+static SDL_AsyncIOGroup *GetReadyAsyncIOGroup(SDL_AsyncIOQueue *queue)
+{
+    SDL_AsyncIOGroup *group = NULL;
+    if (SDL_GetAtomicPointer((void **) &queue->ready_groups)) {
+        SDL_LockSpinlock(&queue->ready_lock);
+        group = queue->ready_groups;
+        if (group) {
+            SDL_SetAtomicPointer((void **) &queue->ready_groups, group->next_ready);
+        }
+        SDL_UnlockSpinlock(&queue->ready_lock);
+    }
+    return group;
+}
+
+// Returns false if there's nothing to report to the app for this task, as for members of a group that isn't done yet.
+static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *outcome)
+{
+    if (!task || !outcome) {
+        return false;
+    }
+
+    SDL_AsyncIO *asyncio = task->asyncio;
+    SDL_AsyncIOGroup *group = task->group;
+    SDL_AsyncIOLoad *load = task->load;
+
+    SDL_zerop(outcome);
+    if (group) {
+        RecordAsyncIOGroupMember(group, task);
+    } else if (load) {
+        RecordAsyncIOLoadChunk(load, task);
+    } else {
+        outcome->asyncio = asyncio->oneshot ? NULL : asyncio;
+        outcome->result = task->result;
+        outcome->type = task->type;
+        outcome->buffer = task->buffer;
+        outcome->offset = task->offset;
+        outcome->bytes_requested = task->requested_size;
+        outcome->bytes_transferred = task->result_size;
+        outcome->userdata = task->app_userdata;
+    }
+
     // Take the completed task out of the SDL_AsyncIO that created it.
     SDL_LockMutex(asyncio->lock);
     LINKED_LIST_UNLINK(task, asyncio);
@@ -242,7 +724,17 @@ static bool GetAsyncIOTaskOutcome(SDL_AsyncIOTask *task, SDL_AsyncIOOutcome *out
     }
 
     SDL_AddAtomicInt(&task->queue->tasks_inflight, -1);
-    SDL_free(task);
+    DestroyAsyncIOTask(task);
+
+    if (group) {
+        if (!SDL_AtomicDecRef(&group->remaining)) {
+            return false;  // still waiting on other members.
+        }
+        GetAsyncIOGroupOutcome(group, outcome);
+    } else if (load) {
+        AdvanceAsyncIOLoad(load);
+        return false;  // the whole load is reported through its reserved outcome once it's done.
+    }
 
     return retval;
 }
@@ -252,7 +744,22 @@ bool SDL_GetAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome)
     if (!queue || !outcome) {
         return false;
     }
-    return GetAsyncIOTaskOutcome(queue->iface.get_results(queue->userdata), outcome);
+
+    // keep going past completions that don't get reported on their own, there might be a reportable one behind them.
+    for (;;) {
+        SDL_AsyncIOGroup *group = GetReadyAsyncIOGroup(queue);
+        if (group) {
+            GetAsyncIOGroupOutcome(group, outcome);
+            return true;
+        }
+
+        SDL_AsyncIOTask *task = queue->iface.get_results(queue->userdata);
+        if (!task) {
+            return false;
+        } else if (GetAsyncIOTaskOutcome(task, outcome)) {
+            return true;
+        }
+    }
 }
 
 bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome, Sint32 timeoutMS)
@@ -260,7 +767,34 @@ bool SDL_WaitAsyncIOResult(SDL_AsyncIOQueue *queue, SDL_AsyncIOOutcome *outcome,
     if (!queue || !outcome) {
         return false;
     }
-    return GetAsyncIOTaskOutcome(queue->iface.wait_results(queue->userdata, timeoutMS), outcome);
+
+    const Uint64 deadline = (timeoutMS > 0) ? (SDL_GetTicks() + (Uint64) timeoutMS) : 0;
+    for (;;) {
+        SDL_AsyncIOGroup *group = GetReadyAsyncIOGroup(queue);
+        if (group) {
+            GetAsyncIOGroupOutcome(group, outcome);
+            return true;
+        }
+
+        SDL_AsyncIOTask *task = queue->iface.wait_results(queue->userdata, timeoutMS);
+        if (!task) {
+            // a group that finished while it was being started wakes us up without a task.
+            group = GetReadyAsyncIOGroup(queue);
+            if (group) {
+                GetAsyncIOGroupOutcome(group, outcome);
+                return true;
+            }
+            return false;
+        } else if (GetAsyncIOTaskOutcome(task, outcome)) {
+            return true;
+        }
+
+        // that completion isn't reported on its own, so wait for the rest of the time.
+        if (timeoutMS > 0) {
+            const Uint64 now = SDL_GetTicks();
+            timeoutMS = (now < deadline) ? (Sint32) (deadline - now) : 0;
+        }
+    }
 }
 
 void SDL_SignalAsyncIOQueue(SDL_AsyncIOQueue *queue)
@@ -277,7 +811,11 @@ void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
         while (SDL_GetAtomicInt(&queue->tasks_inflight) > 0) {
             SDL_AsyncIOTask *task = queue->iface.wait_results(queue->userdata, -1);
             if (task) {
-                if (task->asyncio->oneshot) {
+                if (task->load) {
+                    SDL_LockSpinlock(&task->load->lock);
+                    task->load->discarding = true;  // don't start any more chunks, and free the buffer if it's ours.
+                    SDL_UnlockSpinlock(&task->load->lock);
+                } else if (task->asyncio->owns_buffer) {
                     SDL_free(task->buffer);  // throw away the buffer from SDL_LoadFileAsync that will never be consumed/freed by app.
                     task->buffer = NULL;
                 }
@@ -286,6 +824,11 @@ void SDL_DestroyAsyncIOQueue(SDL_AsyncIOQueue *queue)
             }
         }
 
+        SDL_AsyncIOGroup *group;
+        while ((group = GetReadyAsyncIOGroup(queue)) != NULL) {
+            SDL_free(group);
+        }
+
         queue->iface.destroy(queue->userdata);
         SDL_free(queue);
     }
@@ -296,6 +839,60 @@ void SDL_QuitAsyncIO(void)
     SDL_SYS_QuitAsyncIO();
 }
 
+SDL_AsyncIOGroup *SDL_ReserveAsyncIOOutcome(SDL_AsyncIOQueue *queue)
+{
+    // this is a group with no members, which only ever gets to the app through ready_groups.
+    SDL_AsyncIOGroup *group = (SDL_AsyncIOGroup *) SDL_calloc(1, sizeof (*group));
+    if (group) {
+        group->task.queue = queue;
+        SDL_AddAtomicInt(&queue->tasks_inflight, 1);
+    }
+    return group;
+}
+
+void SDL_PostAsyncIOOutcome(SDL_AsyncIOGroup *reserved, const SDL_AsyncIOOutcome *outcome)
+{
+    SDL_AsyncIOTask *task = &reserved->task;
+    SDL_AsyncIOQueue *queue = task->queue;
+    task->asyncio = outcome->asyncio;
+    task->type = outcome->type;
+    task->result = outcome->result;
+    task->buffer = outcome->buffer;
+    task->offset = outcome->offset;
+    task->requested_size = outcome->bytes_requested;
+    task->result_size = outcome->bytes_transferred;
+    task->app_userdata = outcome->userdata;
+
+    PushReadyAsyncIOGroup(queue, reserved);
+    SDL_AddAtomicInt(&queue->tasks_inflight, -1);  // after it's pushed, so SDL_DestroyAsyncIOQueue can't miss it.
+    queue->iface.signal(queue->userdata);  // in case that was waiting on tasks_inflight.
+}
+
+void SDL_ReleaseAsyncIOOutcome(SDL_AsyncIOGroup *reserved)
+{
+    SDL_AddAtomicInt(&reserved->task.queue->tasks_inflight, -1);
+    SDL_free(reserved);
+}
+
+bool SDL_TransferFileAsync(const char *file, bool writing, void *ptr, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    SDL_AsyncIO *asyncio = SDL_AsyncIOFromFile(file, writing ? "w" : "r");
+    if (!asyncio) {
+        return false;
+    }
+    asyncio->oneshot = true;
+
+    bool retval;
+    if (writing) {
+        retval = SDL_WriteAsyncIO(asyncio, ptr, 0, size, queue, userdata);
+    } else {
+        retval = SDL_ReadAsyncIO(asyncio, ptr, 0, size, queue, userdata);
+    }
+
+    SDL_CloseAsyncIO(asyncio, false, queue, userdata);  // as with SDL_LoadFileAsync, if this fails, it's already a dramatic system failure.
+    return retval;
+}
+
 bool SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata)
 {
     if (!file) {
@@ -308,6 +905,7 @@ bool SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata
     SDL_AsyncIO *asyncio = SDL_AsyncIOFromFile(file, "r");
     if (asyncio) {
         asyncio->oneshot = true;
+        asyncio->owns_buffer = true;
 
         Uint8 *ptr = NULL;
         const Sint64 flen = SDL_GetAsyncIOSize(asyncio);
@@ -329,3 +927,97 @@ bool SDL_LoadFileAsync(const char *file, SDL_AsyncIOQueue *queue, void *userdata
     return retval;
 }
 
+bool SDL_LoadFileAsyncWithProperties(SDL_PropertiesID props, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    const char *file = SDL_GetStringProperty(props, SDL_PROP_ASYNCIO_LOAD_FILENAME_STRING, NULL);
+    Uint8 *buffer = (Uint8 *) SDL_GetPointerProperty(props, SDL_PROP_ASYNCIO_LOAD_BUFFER_POINTER, NULL);
+    const Sint64 buffer_size = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIO_LOAD_BUFFER_SIZE_NUMBER, -1);
+    SDL_AsyncIOAllocateCallback allocate = (SDL_AsyncIOAllocateCallback) SDL_GetPointerProperty(props, SDL_PROP_ASYNCIO_LOAD_ALLOCATE_CALLBACK_POINTER, NULL);
+    void *allocate_userdata = SDL_GetPointerProperty(props, SDL_PROP_ASYNCIO_LOAD_ALLOCATE_USERDATA_POINTER, NULL);
+    const Sint64 size_hint = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIO_LOAD_SIZE_HINT_NUMBER, -1);
+    const Sint64 chunk_size = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIO_LOAD_CHUNK_SIZE_NUMBER, 4 * 1024 * 1024);
+    const Sint64 max_inflight = SDL_GetNumberProperty(props, SDL_PROP_ASYNCIO_LOAD_MAX_INFLIGHT_NUMBER, 4);
+
+    if (!file) {
+        return SDL_InvalidParamError("file");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (buffer && (buffer_size < 0)) {
+        return SDL_InvalidParamError(SDL_PROP_ASYNCIO_LOAD_BUFFER_SIZE_NUMBER);
+    } else if (chunk_size <= 0) {
+        return SDL_InvalidParamError(SDL_PROP_ASYNCIO_LOAD_CHUNK_SIZE_NUMBER);
+    } else if (max_inflight <= 0) {
+        return SDL_InvalidParamError(SDL_PROP_ASYNCIO_LOAD_MAX_INFLIGHT_NUMBER);
+    }
+
+    SDL_AsyncIOFileOptions options;
+    SDL_zero(options);
+    options.advice = SDL_ASYNCIO_ADVICE_SEQUENTIAL;
+
+    SDL_AsyncIO *asyncio = OpenAsyncIOFile(file, "r", &options);
+    if (!asyncio) {
+        return false;
+    }
+    asyncio->oneshot = true;
+
+    SDL_AsyncIOLoad *load = NULL;
+    Sint64 flen = SDL_GetAsyncIOSize(asyncio);
+    if (flen < 0) {
+        flen = size_hint;
+    }
+
+    if (flen < 0) {
+        // SDL_GetAsyncIOSize already set the error.
+    } else if ((Uint64) flen >= SDL_SIZE_MAX) {
+        SDL_SetError("File is too large to load");
+    } else if (buffer && (flen > buffer_size)) {
+        SDL_SetError("Buffer is too small for the file");
+    } else {
+        load = (SDL_AsyncIOLoad *) SDL_calloc(1, sizeof (*load));
+    }
+
+    if (load) {
+        load->reserved = SDL_ReserveAsyncIOOutcome(queue);
+        if (load->reserved && !buffer) {
+            if (allocate) {
+                buffer = (Uint8 *) allocate(allocate_userdata, (Uint64) flen);
+                if (!buffer) {
+                    SDL_SetError("Allocation callback failed");
+                }
+            } else {
+                buffer = (Uint8 *) SDL_malloc((size_t) (flen + 1));  // over-allocate by one so we can add a null-terminator.
+                load->owns_buffer = true;
+            }
+        }
+
+        if (!buffer) {
+            if (load->reserved) {
+                SDL_ReleaseAsyncIOOutcome(load->reserved);
+            }
+            SDL_free(load);
+            load = NULL;
+        }
+    }
+
+    if (!load) {
+        SDL_CloseAsyncIO(asyncio, false, queue, NULL);  // if this fails, we'll have a resource leak, but this would already be a dramatic system failure.
+        return false;
+    }
+
+    load->asyncio = asyncio;
+    load->queue = queue;
+    load->buffer = buffer;
+    load->requested = (Uint64) flen;
+    load->size = (Uint64) flen;
+    load->chunk_size = (Uint64) chunk_size;
+    load->max_inflight = (int) SDL_min(max_inflight, 1024);  // far more than any device can make use of.
+    load->result = SDL_ASYNCIO_COMPLETE;
+    load->progress = (SDL_AsyncIOProgressCallback) SDL_GetPointerProperty(props, SDL_PROP_ASYNCIO_LOAD_PROGRESS_CALLBACK_POINTER, NULL);
+    load->progress_userdata = SDL_GetPointerProperty(props, SDL_PROP_ASYNCIO_LOAD_PROGRESS_USERDATA_POINTER, NULL);
+    load->app_userdata = userdata;
+    load->inflight = 1;  // our own reference, so nothing finishes the load while the first chunks are starting.
+
+    // From here on, even failure is reported through the queue, so an app's buffer always comes back to it.
+    AdvanceAsyncIOLoad(load);
+    return true;
+}
@@ -26,5 +26,16 @@
 // Shutdown any still-existing Async I/O. Note that there is no Init function, as it inits on-demand!
 extern void SDL_QuitAsyncIO(void);
 
+// Work that finishes on an SDL_AsyncIOQueue without an SDL_AsyncIO behind it, like SDL_Storage transfers on a job thread.
+// Reserve the outcome before the work starts, so SDL_DestroyAsyncIOQueue waits for it, then post it once the work is done.
+// If the work never starts, release the reservation instead.
+extern struct SDL_AsyncIOGroup *SDL_ReserveAsyncIOOutcome(SDL_AsyncIOQueue *queue);
+extern void SDL_PostAsyncIOOutcome(struct SDL_AsyncIOGroup *reserved, const SDL_AsyncIOOutcome *outcome);
+extern void SDL_ReleaseAsyncIOOutcome(struct SDL_AsyncIOGroup *reserved);
+
+// Read or write `size` bytes at the start of `file`; it's opened and closed behind the scenes, like SDL_LoadFileAsync, so there's just the one outcome.
+// Writing replaces the file.
+extern bool SDL_TransferFileAsync(const char *file, bool writing, void *ptr, Uint64 size, SDL_AsyncIOQueue *queue, void *userdata);
+
 #endif // SDL_asyncio_c_h_
 
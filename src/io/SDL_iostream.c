@@ -39,6 +39,15 @@
 #include <fcntl.h>
 #endif
 
+#if !defined(SDL_PLATFORM_WINDOWS) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#define HAVE_MMAP_IOSTREAM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#elif defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#define HAVE_MMAP_IOSTREAM
+#endif
+
 #include "SDL_iostream_c.h"
 
 /* This file provides a general interface for SDL to read and write
@@ -70,8 +79,11 @@ typedef struct IOStreamWindowsData
     void *data;
     size_t size;
     size_t left;
+    size_t readahead_size;
     bool append;
     bool autoclose;
+    bool buffer_configured;
+    SDL_IOStream *stream;
 } IOStreamWindowsData;
 
 
@@ -190,6 +202,30 @@ static Sint64 SDLCALL windows_file_seek(void *userdata, Sint64 offset, SDL_IOWhe
     return windowsoffset.QuadPart;
 }
 
+static void windows_file_configure_buffer(IOStreamWindowsData *iodata)
+{
+    if (iodata->buffer_configured) {
+        return;
+    }
+    iodata->buffer_configured = true;
+
+    const SDL_PropertiesID props = SDL_GetIOProperties(iodata->stream);
+    if (!SDL_HasProperty(props, SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER)) {
+        return;
+    }
+
+    const Sint64 buffer_size = SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER, READAHEAD_BUFFER_SIZE);
+    if (buffer_size <= 0) {
+        iodata->readahead_size = 0;
+    } else if ((size_t)buffer_size != iodata->readahead_size && buffer_size <= SDL_MAX_UINT32) {
+        void *data = SDL_realloc(iodata->data, (size_t)buffer_size);
+        if (data) {
+            iodata->data = data;
+            iodata->readahead_size = (size_t)buffer_size;
+        }
+    }
+}
+
 static size_t SDLCALL windows_file_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
 {
     IOStreamWindowsData *iodata = (IOStreamWindowsData *) userdata;
@@ -198,6 +234,8 @@ static size_t SDLCALL windows_file_read(void *userdata, void *ptr, size_t size,
     size_t read_ahead;
     DWORD bytes;
 
+    windows_file_configure_buffer(iodata);
+
     if (iodata->left > 0) {
         void *data = (char *)iodata->data +
                      iodata->size -
@@ -214,8 +252,8 @@ static size_t SDLCALL windows_file_read(void *userdata, void *ptr, size_t size,
         total_read += read_ahead;
     }
 
-    if (total_need < READAHEAD_BUFFER_SIZE) {
-        if (!ReadFile(iodata->h, iodata->data, READAHEAD_BUFFER_SIZE, &bytes, NULL)) {
+    if (total_need < iodata->readahead_size) {
+        if (!ReadFile(iodata->h, iodata->data, (DWORD)iodata->readahead_size, &bytes, NULL)) {
             DWORD error = GetLastError();
             switch (error) {
             case ERROR_BROKEN_PIPE:
@@ -342,11 +380,14 @@ SDL_IOStream *SDL_IOFromHandle(HANDLE handle, const char *mode, bool autoclose)
         iface.close(iodata);
         return NULL;
     }
+    iodata->readahead_size = READAHEAD_BUFFER_SIZE;
 
     SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
     if (!iostr) {
         iface.close(iodata);
     } else {
+        iodata->stream = iostr;
+
         const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
         if (props) {
             SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_WINDOWS_HANDLE_POINTER, iodata->h);
@@ -366,6 +407,17 @@ typedef struct IOStreamFDData
     int fd;
     bool autoclose;
     bool regular_file;
+    SDL_IOStream *stream;
+
+    /* Optional user-space buffer for regular files, see SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER.
+       It either holds read-ahead data (buffer_pos..buffer_len not yet consumed),
+       or, if buffer_dirty is set, buffer_len bytes of coalesced writes. */
+    bool buffer_configured;
+    bool buffer_dirty;
+    Uint8 *buffer;
+    size_t buffer_size;
+    size_t buffer_pos;
+    size_t buffer_len;
 } IOStreamFDData;
 
 static int SDL_fdatasync(int fd)
@@ -382,6 +434,106 @@ static int SDL_fdatasync(int fd)
     return result;
 }
 
+static size_t fd_read_unbuffered(IOStreamFDData *iodata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    ssize_t bytes;
+    do {
+        bytes = read(iodata->fd, ptr, size);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0) {
+        if (errno == EAGAIN) {
+            *status = SDL_IO_STATUS_NOT_READY;
+        } else {
+            SDL_SetError("Error reading from datastream: %s", strerror(errno));
+        }
+        bytes = 0;
+    }
+    return (size_t)bytes;
+}
+
+static size_t fd_write_unbuffered(IOStreamFDData *iodata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    ssize_t bytes;
+    do {
+        bytes = write(iodata->fd, ptr, size);
+    } while (bytes < 0 && errno == EINTR);
+
+    if (bytes < 0) {
+        if (errno == EAGAIN) {
+            *status = SDL_IO_STATUS_NOT_READY;
+        } else {
+            SDL_SetError("Error writing to datastream: %s", strerror(errno));
+        }
+        bytes = 0;
+    }
+    return (size_t)bytes;
+}
+
+// The buffer size is picked up on first use, so it can be set any time before the first read, write or seek.
+static void fd_configure_buffer(IOStreamFDData *iodata)
+{
+    if (iodata->buffer_configured) {
+        return;
+    }
+    iodata->buffer_configured = true;
+
+    // Pipes and sockets can't seek back over read-ahead data, so they stay unbuffered
+    if (!iodata->regular_file) {
+        return;
+    }
+
+    const Sint64 buffer_size = SDL_GetNumberProperty(SDL_GetIOProperties(iodata->stream), SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER, 0);
+    if (buffer_size > 0 && (Uint64)buffer_size <= SDL_SIZE_MAX) {
+        iodata->buffer = (Uint8 *)SDL_malloc((size_t)buffer_size);
+        if (iodata->buffer) {
+            iodata->buffer_size = (size_t)buffer_size;
+        }
+    }
+}
+
+// Write out any coalesced writes
+static bool fd_flush_buffer(IOStreamFDData *iodata, SDL_IOStatus *status)
+{
+    size_t written = 0;
+
+    if (!iodata->buffer_dirty) {
+        return true;
+    }
+
+    while (written < iodata->buffer_len) {
+        const size_t bytes = fd_write_unbuffered(iodata, iodata->buffer + written, iodata->buffer_len - written, status);
+        if (bytes == 0) {
+            // Keep whatever couldn't be written for the next attempt
+            SDL_memmove(iodata->buffer, iodata->buffer + written, iodata->buffer_len - written);
+            iodata->buffer_len -= written;
+            return false;
+        }
+        written += bytes;
+    }
+
+    iodata->buffer_dirty = false;
+    iodata->buffer_pos = 0;
+    iodata->buffer_len = 0;
+    return true;
+}
+
+// Throw away read-ahead data, moving the file position back to where the app thinks it is
+static bool fd_discard_buffer(IOStreamFDData *iodata)
+{
+    const size_t unread = iodata->buffer_len - iodata->buffer_pos;
+
+    SDL_assert(!iodata->buffer_dirty);
+
+    iodata->buffer_pos = 0;
+    iodata->buffer_len = 0;
+
+    if (unread > 0 && lseek(iodata->fd, -(off_t)unread, SEEK_CUR) < 0) {
+        return SDL_SetError("Couldn't get stream offset: %s", strerror(errno));
+    }
+    return true;
+}
+
 static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
@@ -402,6 +554,34 @@ static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence
         return -1;
     }
 
+    fd_configure_buffer(iodata);
+
+    if (iodata->buffer_dirty) {
+        SDL_IOStatus status = SDL_IO_STATUS_READY;
+        if (!fd_flush_buffer(iodata, &status)) {
+            return -1;
+        }
+    } else if (iodata->buffer_len > 0) {
+        const size_t unread = iodata->buffer_len - iodata->buffer_pos;
+
+        // Relative seeks that land inside the read-ahead data don't need to touch it
+        if (whence == SDL_IO_SEEK_CUR && offset >= -(Sint64)iodata->buffer_pos && offset <= (Sint64)unread) {
+            iodata->buffer_pos += (size_t)offset;
+            off_t result = lseek(iodata->fd, 0, SEEK_CUR);
+            if (result < 0) {
+                SDL_SetError("Couldn't get stream offset: %s", strerror(errno));
+                return -1;
+            }
+            return (Sint64)result - (Sint64)(iodata->buffer_len - iodata->buffer_pos);
+        }
+
+        if (whence == SDL_IO_SEEK_CUR) {
+            offset -= (Sint64)unread;
+        }
+        iodata->buffer_pos = 0;
+        iodata->buffer_len = 0;
+    }
+
     off_t result = lseek(iodata->fd, (off_t)offset, fdwhence);
     if (result < 0) {
         SDL_SetError("Couldn't get stream offset: %s", strerror(errno));
@@ -412,45 +592,82 @@ static Sint64 SDLCALL fd_seek(void *userdata, Sint64 offset, SDL_IOWhence whence
 static size_t SDLCALL fd_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
-    ssize_t bytes;
-    do {
-        bytes = read(iodata->fd, ptr, size);
-    } while (bytes < 0 && errno == EINTR);
+    size_t total_read = 0;
 
-    if (bytes < 0) {
-        if (errno == EAGAIN) {
-            *status = SDL_IO_STATUS_NOT_READY;
-        } else {
-            SDL_SetError("Error reading from datastream: %s", strerror(errno));
+    fd_configure_buffer(iodata);
+
+    if (!iodata->buffer) {
+        return fd_read_unbuffered(iodata, ptr, size, status);
+    }
+
+    if (iodata->buffer_dirty && !fd_flush_buffer(iodata, status)) {
+        return 0;
+    }
+
+    // Serve as much as possible from the read-ahead data
+    if (iodata->buffer_pos < iodata->buffer_len) {
+        const size_t bytes = SDL_min(size, iodata->buffer_len - iodata->buffer_pos);
+        SDL_memcpy(ptr, iodata->buffer + iodata->buffer_pos, bytes);
+        iodata->buffer_pos += bytes;
+        total_read += bytes;
+        if (bytes == size) {
+            return total_read;
         }
-        bytes = 0;
+        ptr = (Uint8 *)ptr + bytes;
+        size -= bytes;
     }
-    return (size_t)bytes;
+    iodata->buffer_pos = 0;
+    iodata->buffer_len = 0;
+
+    // Big reads go straight into the caller's memory
+    if (size >= iodata->buffer_size) {
+        return total_read + fd_read_unbuffered(iodata, ptr, size, status);
+    }
+
+    iodata->buffer_len = fd_read_unbuffered(iodata, iodata->buffer, iodata->buffer_size, status);
+    iodata->buffer_pos = SDL_min(size, iodata->buffer_len);
+    SDL_memcpy(ptr, iodata->buffer, iodata->buffer_pos);
+    return total_read + iodata->buffer_pos;
 }
 
 static size_t SDLCALL fd_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
-    ssize_t bytes;
-    do {
-        bytes = write(iodata->fd, ptr, size);
-    } while (bytes < 0 && errno == EINTR);
 
-    if (bytes < 0) {
-        if (errno == EAGAIN) {
-            *status = SDL_IO_STATUS_NOT_READY;
-        } else {
-            SDL_SetError("Error writing to datastream: %s", strerror(errno));
-        }
-        bytes = 0;
+    fd_configure_buffer(iodata);
+
+    if (!iodata->buffer) {
+        return fd_write_unbuffered(iodata, ptr, size, status);
     }
-    return (size_t)bytes;
+
+    if (!iodata->buffer_dirty && iodata->buffer_len > 0 && !fd_discard_buffer(iodata)) {
+        return 0;
+    }
+
+    if (iodata->buffer_len + size > iodata->buffer_size && !fd_flush_buffer(iodata, status)) {
+        return 0;
+    }
+
+    // Big writes go straight out once the pending data is gone
+    if (size >= iodata->buffer_size) {
+        return fd_write_unbuffered(iodata, ptr, size, status);
+    }
+
+    SDL_memcpy(iodata->buffer + iodata->buffer_len, ptr, size);
+    iodata->buffer_len += size;
+    iodata->buffer_dirty = true;
+    return size;
 }
 
 static bool SDLCALL fd_flush(void *userdata, SDL_IOStatus *status)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     int result;
+
+    if (!fd_flush_buffer(iodata, status)) {
+        return false;
+    }
+
     do {
         result = SDL_fdatasync(iodata->fd);
     } while (result < 0 && errno == EINTR);
@@ -466,6 +683,11 @@ static bool SDLCALL fd_close(void *userdata)
 {
     IOStreamFDData *iodata = (IOStreamFDData *) userdata;
     bool status = true;
+    if (iodata->buffer_dirty) {
+        SDL_IOStatus io_status = SDL_IO_STATUS_READY;
+        status = fd_flush_buffer(iodata, &io_status);
+    }
+    SDL_free(iodata->buffer);
     if (iodata->autoclose) {
         if (close(iodata->fd) < 0) {
             status = SDL_SetError("Error closing datastream: %s", strerror(errno));
@@ -504,6 +726,8 @@ SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose)
     if (!iostr) {
         iface.close(iodata);
     } else {
+        iodata->stream = iostr;
+
         const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
         if (props) {
             SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, fd);
@@ -523,6 +747,8 @@ typedef struct IOStreamStdioData
     FILE *fp;
     bool autoclose;
     bool regular_file;
+    bool buffer_configured;
+    SDL_IOStream *stream;
 } IOStreamStdioData;
 
 #ifdef HAVE_FOPEN64
@@ -561,11 +787,32 @@ typedef struct IOStreamStdioData
 #define fseek_off_t long
 #endif
 
+// setvbuf() has to happen before any other operation on the FILE, so this runs on first use
+static void stdio_configure_buffer(IOStreamStdioData *iodata)
+{
+    if (iodata->buffer_configured) {
+        return;
+    }
+    iodata->buffer_configured = true;
+
+    const SDL_PropertiesID props = SDL_GetIOProperties(iodata->stream);
+    if (SDL_HasProperty(props, SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER)) {
+        const Sint64 buffer_size = SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER, 0);
+        if (buffer_size <= 0) {
+            setvbuf(iodata->fp, NULL, _IONBF, 0);
+        } else if ((Uint64)buffer_size <= SDL_SIZE_MAX) {
+            setvbuf(iodata->fp, NULL, _IOFBF, (size_t)buffer_size);
+        }
+    }
+}
+
 static Sint64 SDLCALL stdio_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
 {
     IOStreamStdioData *iodata = (IOStreamStdioData *) userdata;
     int stdiowhence;
 
+    stdio_configure_buffer(iodata);
+
     switch (whence) {
     case SDL_IO_SEEK_SET:
         stdiowhence = SEEK_SET;
@@ -606,6 +853,7 @@ static Sint64 SDLCALL stdio_seek(void *userdata, Sint64 offset, SDL_IOWhence whe
 static size_t SDLCALL stdio_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
 {
     IOStreamStdioData *iodata = (IOStreamStdioData *) userdata;
+    stdio_configure_buffer(iodata);
     const size_t bytes = fread(ptr, 1, size, iodata->fp);
     if (bytes == 0 && ferror(iodata->fp)) {
         if (errno == EAGAIN) {
@@ -621,6 +869,7 @@ static size_t SDLCALL stdio_read(void *userdata, void *ptr, size_t size, SDL_IOS
 static size_t SDLCALL stdio_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
 {
     IOStreamStdioData *iodata = (IOStreamStdioData *) userdata;
+    stdio_configure_buffer(iodata);
     const size_t bytes = fwrite(ptr, 1, size, iodata->fp);
     if (bytes == 0 && ferror(iodata->fp)) {
         if (errno == EAGAIN) {
@@ -699,6 +948,8 @@ SDL_IOStream *SDL_IOFromFP(FILE *fp, bool autoclose)
     if (!iostr) {
         iface.close(iodata);
     } else {
+        iodata->stream = iostr;
+
         const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
         if (props) {
             SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_STDIO_FILE_POINTER, fp);
@@ -998,6 +1249,162 @@ SDL_IOStream *SDL_IOFromConstMem(const void *mem, size_t size)
     return iostr;
 }
 
+typedef struct IOStreamMappedData
+{
+    IOStreamMemData data;
+    void *mapping;
+    size_t mapping_size;
+#ifdef SDL_PLATFORM_WINDOWS
+    HANDLE mapping_handle;
+#endif
+} IOStreamMappedData;
+
+static Sint64 SDLCALL mapped_size(void *userdata)
+{
+    IOStreamMappedData *iodata = (IOStreamMappedData *) userdata;
+    return mem_size(&iodata->data);
+}
+
+static Sint64 SDLCALL mapped_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamMappedData *iodata = (IOStreamMappedData *) userdata;
+    return mem_seek(&iodata->data, offset, whence);
+}
+
+static size_t SDLCALL mapped_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamMappedData *iodata = (IOStreamMappedData *) userdata;
+    return mem_read(&iodata->data, ptr, size, status);
+}
+
+static bool SDLCALL mapped_close(void *userdata)
+{
+    IOStreamMappedData *iodata = (IOStreamMappedData *) userdata;
+    if (iodata->mapping) {
+#if defined(HAVE_MMAP_IOSTREAM) && defined(SDL_PLATFORM_WINDOWS)
+        UnmapViewOfFile(iodata->mapping);
+        CloseHandle(iodata->mapping_handle);
+#elif defined(HAVE_MMAP_IOSTREAM)
+        munmap(iodata->mapping, iodata->mapping_size);
+#endif
+    } else {
+        SDL_free(iodata->data.base);
+    }
+    SDL_free(iodata);
+    return true;
+}
+
+// Returns false if the file couldn't be mapped, in which case the caller falls back to loading it.
+static bool SDL_MapFile(const char *file, IOStreamMappedData *iodata)
+{
+#if defined(HAVE_MMAP_IOSTREAM) && defined(SDL_PLATFORM_WINDOWS)
+    HANDLE handle = windows_file_open(file, "rb");
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0 || (Uint64)size.QuadPart > SDL_SIZE_MAX) {
+        CloseHandle(handle);
+        return false;
+    }
+
+    // The mapping keeps its own reference to the file, so the handle can be closed right away
+    HANDLE mapping_handle = CreateFileMapping(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle);
+    if (!mapping_handle) {
+        return false;
+    }
+
+    void *mapping = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+    if (!mapping) {
+        CloseHandle(mapping_handle);
+        return false;
+    }
+
+    iodata->mapping = mapping;
+    iodata->mapping_size = (size_t)size.QuadPart;
+    iodata->mapping_handle = mapping_handle;
+    return true;
+
+#elif defined(HAVE_MMAP_IOSTREAM)
+    int fd = open(file, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode) || st.st_size <= 0 || (Uint64)st.st_size > SDL_SIZE_MAX) {
+        close(fd);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void *mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    iodata->mapping = mapping;
+    iodata->mapping_size = (size_t)st.st_size;
+    return true;
+
+#else
+    (void)file;
+    (void)iodata;
+    return false;
+#endif
+}
+
+SDL_IOStream *SDL_IOFromMappedFile(const char *file)
+{
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+    IOStreamMappedData *iodata = (IOStreamMappedData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        return NULL;
+    }
+
+    if (SDL_MapFile(file, iodata)) {
+        iodata->data.base = (Uint8 *)iodata->mapping;
+        iodata->data.stop = iodata->data.base + iodata->mapping_size;
+    } else {
+        // Files that can't be mapped (empty files, pipes, Android assets, etc.) are read into memory instead
+        size_t size = 0;
+        iodata->data.base = (Uint8 *)SDL_LoadFile(file, &size);
+        if (!iodata->data.base) {
+            SDL_free(iodata);
+            return NULL;
+        }
+        iodata->data.stop = iodata->data.base + size;
+    }
+    iodata->data.here = iodata->data.base;
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = mapped_size;
+    iface.seek = mapped_seek;
+    iface.read = mapped_read;
+    // leave iface.write as NULL.
+    iface.close = mapped_close;
+
+    SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        mapped_close(iodata);
+    } else {
+        const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
+        if (props) {
+            SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, iodata->data.base);
+            SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, mem_size(&iodata->data));
+        }
+    }
+    return iostr;
+}
+
 typedef struct IOStreamDynamicMemData
 {
     SDL_IOStream *stream;
@@ -1025,14 +1432,35 @@ static size_t SDLCALL dynamic_mem_read(void *userdata, void *ptr, size_t size, S
 
 static bool dynamic_mem_realloc(IOStreamDynamicMemData *iodata, size_t size)
 {
-    size_t chunksize = (size_t)SDL_GetNumberProperty(SDL_GetIOProperties(iodata->stream), SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER, 0);
+    const SDL_PropertiesID props = SDL_GetIOProperties(iodata->stream);
+    size_t chunksize = (size_t)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER, 0);
     if (!chunksize) {
         chunksize = 1024;
     }
+    const size_t reserve = (size_t)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_RESERVE_NUMBER, 0);
+    const float growth = SDL_GetFloatProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_GROWTH_FLOAT, 1.5f);
 
     // We're intentionally allocating more memory than needed so it can be null terminated
-    size_t chunks = (((iodata->end - iodata->data.base) + size) / chunksize) + 1;
-    size_t length = (chunks * chunksize);
+    const size_t capacity = (size_t)(iodata->end - iodata->data.base);
+    const size_t needed = (size_t)(iodata->data.here - iodata->data.base) + size + 1;
+    if (needed <= size) {
+        return SDL_SetError("Dynamic memory stream is too large");
+    }
+    size_t length = SDL_max(needed, reserve);
+
+    // Growing by a factor of the current size keeps the number of copies down, so writing a large stream is O(n).
+    if (growth > 1.0f) {
+        const double grown = (double)capacity * growth;
+        if (grown >= (double)SDL_SIZE_MAX) {
+            length = SDL_SIZE_MAX;
+        } else {
+            length = SDL_max(length, (size_t)grown);
+        }
+    }
+    if (length <= (SDL_SIZE_MAX - chunksize)) {
+        length = ((length + chunksize - 1) / chunksize) * chunksize;
+    }
+
     Uint8 *base = (Uint8 *)SDL_realloc(iodata->data.base, length);
     if (!base) {
         return false;
@@ -1072,6 +1500,46 @@ static bool SDLCALL dynamic_mem_close(void *userdata)
     return true;
 }
 
+void *SDL_DetachDynamicMemIO(SDL_IOStream *context, size_t *datasize)
+{
+    if (datasize) {
+        *datasize = 0;
+    }
+
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    } else if (context->iface.close != dynamic_mem_close) {
+        SDL_SetError("Stream wasn't created by SDL_IOFromDynamicMem()");
+        return NULL;
+    }
+
+    IOStreamDynamicMemData *iodata = (IOStreamDynamicMemData *) context->userdata;
+    Uint8 *mem = iodata->data.base;
+    if (!mem) {
+        // nothing has been written, but the caller still gets a buffer to free.
+        mem = (Uint8 *)SDL_malloc(1);
+        if (!mem) {
+            return NULL;
+        }
+    } else if (!SDL_GetPointerProperty(SDL_GetIOProperties(context), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL)) {
+        SDL_SetError("Stream memory has already been taken through its properties");
+        return NULL;
+    }
+    const size_t size = (size_t)(iodata->data.stop - iodata->data.base);
+    mem[size] = '\0';  // there's always room for this, see dynamic_mem_realloc().
+
+    // the stream carries on empty, and allocates new memory if it's written to again.
+    SDL_zero(iodata->data);
+    iodata->end = NULL;
+    SDL_ClearProperty(SDL_GetIOProperties(context), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER);
+
+    if (datasize) {
+        *datasize = size;
+    }
+    return mem;
+}
+
 SDL_IOStream *SDL_IOFromDynamicMem(void)
 {
     IOStreamDynamicMemData *iodata = (IOStreamDynamicMemData *) SDL_calloc(1, sizeof (*iodata));
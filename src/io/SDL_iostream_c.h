@@ -32,4 +32,8 @@ extern SDL_IOStream *SDL_IOFromFP(FILE *fp, bool autoclose);
 extern SDL_IOStream *SDL_IOFromFD(int fd, bool autoclose);
 #endif
 
+// Decodes one raw LZ4 block into dst, returning the number of bytes decoded, or -1 if the block is damaged or doesn't fit in dstlen.
+// Matches may reach back into the dictlen bytes just before dst, which is how the blocks of a linked LZ4 frame refer to each other.
+extern Sint64 SDL_DecodeLZ4Block(const void *src, size_t srclen, void *dst, size_t dstlen, size_t dictlen);
+
 #endif // SDL_iostream_c_h_
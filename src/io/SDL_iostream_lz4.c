@@ -0,0 +1,648 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+#include "SDL_internal.h"
+
+#include "SDL_iostream_c.h"
+#include "../thread/SDL_jobs_c.h"
+
+/* A read-only SDL_IOStream over LZ4 frames.
+
+   Opening the stream walks the frame and block headers, without decoding anything, to build an index of where
+   each block's data is. Decoded sizes aren't in the headers, so each block's place in the output gets filled in
+   the first time it's decoded; after that, seeking to it is just a matter of decoding that one block again.
+
+   Blocks in frames with independent blocks (what the lz4 tool writes by default) are decoded ahead in batches,
+   spread over the job threads. Blocks in linked frames can refer to the 64K of output before them, so those are
+   decoded one at a time, in order, and seeking backwards in one means starting over from the start of its frame. */
+
+#define LZ4_FRAME_MAGIC         0x184D2204
+#define LZ4_SKIPPABLE_MAGIC     0x184D2A50  // the low 4 bits can be anything
+#define LZ4_HISTORY_SIZE        (64 * 1024)
+#define LZ4_MAX_BATCH_BYTES     (8 * 1024 * 1024)
+
+#define LZ4_FLG_VERSION_MASK    0xC0
+#define LZ4_FLG_VERSION         0x40
+#define LZ4_FLG_INDEPENDENT     0x20
+#define LZ4_FLG_BLOCK_CHECKSUM  0x10
+#define LZ4_FLG_CONTENT_SIZE    0x08
+#define LZ4_FLG_CONTENT_CHECKSUM 0x04
+#define LZ4_FLG_RESERVED        0x02
+#define LZ4_FLG_DICTIONARY      0x01
+
+#define LZ4_BLOCK_UNCOMPRESSED  0x80000000u
+
+Sint64 SDL_DecodeLZ4Block(const void *src, size_t srclen, void *dst, size_t dstlen, size_t dictlen)
+{
+    const Uint8 *ip = (const Uint8 *)src;
+    const Uint8 *iend = ip + srclen;
+    Uint8 *op = (Uint8 *)dst;
+    Uint8 *oend = op + dstlen;
+    const Uint8 *lowest = op - dictlen;  // matches can't reach back past this.
+
+    while (ip < iend) {
+        const Uint8 token = *ip++;
+
+        size_t len = token >> 4;
+        if (len == 15) {
+            Uint8 b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+        }
+        if ((len > (size_t)(iend - ip)) || (len > (size_t)(oend - op))) {
+            return -1;
+        }
+        SDL_memcpy(op, ip, len);
+        ip += len;
+        op += len;
+
+        if (ip == iend) {
+            break;  // the last sequence is just literals.
+        } else if ((iend - ip) < 2) {
+            return -1;
+        }
+
+        const size_t distance = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if ((distance == 0) || (distance > (size_t)(op - lowest))) {
+            return -1;
+        }
+
+        len = token & 15;
+        if (len == 15) {
+            Uint8 b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+        }
+        len += 4;
+        if (len > (size_t)(oend - op)) {
+            return -1;
+        }
+
+        // the match can overlap what it's writing, so this has to go a byte at a time.
+        const Uint8 *match = op - distance;
+        while (len--) {
+            *op++ = *match++;
+        }
+    }
+
+    return (Sint64)(op - (Uint8 *)dst);
+}
+
+typedef struct LZ4Block
+{
+    Uint64 src_offset;      // of the stored data, in the source stream
+    Uint64 offset;          // of the decoded data in this stream, once it's known
+    Uint32 stored_size;
+    Uint32 size;            // decoded size, once it's known
+    Uint32 frame;
+    bool raw;               // stored without compression
+} LZ4Block;
+
+typedef struct LZ4Frame
+{
+    Uint32 first_block;
+    Uint32 max_block_size;
+    bool linked;
+} LZ4Frame;
+
+typedef struct LZ4BlockJob
+{
+    const Uint8 *stored;
+    size_t stored_size;
+    Uint8 *out;
+    size_t out_size;
+    Sint64 result;
+} LZ4BlockJob;
+
+typedef struct IOStreamLZ4Data
+{
+    SDL_IOStream *src;
+    bool closeio;
+    LZ4Frame *frames;
+    Uint32 num_frames;
+    LZ4Block *blocks;
+    Uint32 num_blocks;
+    Uint32 num_sized;       // blocks before this one have their offset and size filled in
+    Uint32 max_block_size;
+    Sint64 content_size;    // from the frame headers, or -1 if any of them left it out
+    Uint64 pos;
+
+    // decoded blocks [window_first, window_first + window_count), each with LZ4_HISTORY_SIZE bytes of room in front for linked frames.
+    Uint8 *window;
+    Uint32 window_slots;
+    Uint32 window_first;
+    Uint32 window_count;
+    Uint8 *stored;          // window_slots * max_block_size bytes of compressed data being decoded
+
+    // the end of the output so far in a linked frame, which the block after it refers to.
+    Uint8 *history;
+    size_t history_len;
+    Uint32 history_next;
+} IOStreamLZ4Data;
+
+static Uint8 *GetLZ4WindowSlot(IOStreamLZ4Data *iodata, Uint32 slot)
+{
+    return iodata->window + ((size_t)slot * (LZ4_HISTORY_SIZE + iodata->max_block_size)) + LZ4_HISTORY_SIZE;
+}
+
+static bool ReadLZ4Stored(IOStreamLZ4Data *iodata, const LZ4Block *block, Uint8 *ptr)
+{
+    if (SDL_SeekIO(iodata->src, (Sint64)block->src_offset, SDL_IO_SEEK_SET) != (Sint64)block->src_offset) {
+        return false;
+    } else if (SDL_ReadIO(iodata->src, ptr, block->stored_size) != block->stored_size) {
+        if (SDL_GetIOStatus(iodata->src) == SDL_IO_STATUS_EOF) {
+            SDL_SetError("LZ4 stream is truncated");
+        }
+        return false;
+    }
+    return true;
+}
+
+static void SDLCALL DecodeLZ4BlockJob(void *userdata)
+{
+    LZ4BlockJob *job = (LZ4BlockJob *)userdata;
+    job->result = SDL_DecodeLZ4Block(job->stored, job->stored_size, job->out, job->out_size, 0);
+}
+
+// Records the decoded size of a block, and extends the run of blocks that know where they are in the output.
+static void SetLZ4BlockSize(IOStreamLZ4Data *iodata, Uint32 index, Uint32 size)
+{
+    LZ4Block *block = &iodata->blocks[index];
+    block->size = size;
+    if (index == iodata->num_sized) {
+        block->offset = index ? (block[-1].offset + block[-1].size) : 0;
+        iodata->num_sized++;
+    }
+}
+
+static bool DecodeLinkedLZ4Block(IOStreamLZ4Data *iodata, Uint32 index)
+{
+    const LZ4Block *block = &iodata->blocks[index];
+    const LZ4Frame *frame = &iodata->frames[block->frame];
+    Uint8 *out = GetLZ4WindowSlot(iodata, 0);
+    Sint64 size;
+
+    iodata->window_count = 0;
+    if (index == frame->first_block) {
+        iodata->history_len = 0;
+    }
+    SDL_memcpy(out - iodata->history_len, iodata->history, iodata->history_len);
+
+    if (block->raw) {
+        if (!ReadLZ4Stored(iodata, block, out)) {
+            return false;
+        }
+        size = block->stored_size;
+    } else {
+        if (!ReadLZ4Stored(iodata, block, iodata->stored)) {
+            return false;
+        }
+        size = SDL_DecodeLZ4Block(iodata->stored, block->stored_size, out, frame->max_block_size, iodata->history_len);
+        if (size < 0) {
+            return SDL_SetError("LZ4 stream has a damaged block");
+        }
+    }
+
+    // the history and this block are next to each other, so the new history is just the end of the two.
+    const size_t keep = SDL_min(iodata->history_len + (size_t)size, LZ4_HISTORY_SIZE);
+    SDL_memcpy(iodata->history, out + size - keep, keep);
+    iodata->history_len = keep;
+    iodata->history_next = index + 1;
+
+    SetLZ4BlockSize(iodata, index, (Uint32)size);
+    iodata->window_first = index;
+    iodata->window_count = 1;
+    return true;
+}
+
+// Decodes the block at index into the window, along with as many independent blocks after it as fit.
+static bool DecodeLZ4Blocks(IOStreamLZ4Data *iodata, Uint32 index)
+{
+    if (iodata->frames[iodata->blocks[index].frame].linked) {
+        const Uint32 first_block = iodata->frames[iodata->blocks[index].frame].first_block;
+        if ((index != first_block) && (index != iodata->history_next)) {
+            // the block before this one hasn't just been decoded, so work up to it from the start of the frame.
+            for (Uint32 i = first_block; i < index; ++i) {
+                if (!DecodeLinkedLZ4Block(iodata, i)) {
+                    return false;
+                }
+            }
+        }
+        return DecodeLinkedLZ4Block(iodata, index);
+    }
+
+    LZ4BlockJob jobs[SDL_MAX_JOB_WORKERS];
+    void *job_userdata[SDL_MAX_JOB_WORKERS];
+    Uint32 count = 0;
+    int num_jobs = 0;
+
+    iodata->window_count = 0;
+
+    // the source stream can only do one thing at a time, so all the reading happens here first.
+    while ((count < iodata->window_slots) && ((index + count) < iodata->num_blocks)) {
+        const LZ4Block *block = &iodata->blocks[index + count];
+        const LZ4Frame *frame = &iodata->frames[block->frame];
+        if (frame->linked) {
+            break;
+        }
+
+        Uint8 *out = GetLZ4WindowSlot(iodata, count);
+        if (block->raw) {
+            if (!ReadLZ4Stored(iodata, block, out)) {
+                return false;
+            }
+        } else {
+            LZ4BlockJob *job = &jobs[num_jobs];
+            job->stored = iodata->stored + ((size_t)count * iodata->max_block_size);
+            job->stored_size = block->stored_size;
+            job->out = out;
+            job->out_size = frame->max_block_size;
+            job->result = -1;
+            if (!ReadLZ4Stored(iodata, block, (Uint8 *)job->stored)) {
+                return false;
+            }
+            job_userdata[num_jobs++] = job;
+        }
+        ++count;
+    }
+
+    if (num_jobs > 1) {
+        SDL_RunJobsAndWait(DecodeLZ4BlockJob, job_userdata, num_jobs);
+    } else if (num_jobs == 1) {
+        DecodeLZ4BlockJob(job_userdata[0]);
+    }
+
+    num_jobs = 0;
+    for (Uint32 i = 0; i < count; ++i) {
+        const LZ4Block *block = &iodata->blocks[index + i];
+        Sint64 size = block->stored_size;
+        if (!block->raw) {
+            size = jobs[num_jobs++].result;
+            if (size < 0) {
+                return SDL_SetError("LZ4 stream has a damaged block");
+            }
+        }
+        SetLZ4BlockSize(iodata, index + i, (Uint32)size);
+    }
+
+    iodata->window_first = index;
+    iodata->window_count = count;
+    return true;
+}
+
+static Uint64 GetLZ4SizedEnd(const IOStreamLZ4Data *iodata)
+{
+    if (iodata->num_sized == 0) {
+        return 0;
+    }
+    const LZ4Block *last = &iodata->blocks[iodata->num_sized - 1];
+    return last->offset + last->size;
+}
+
+// Finds the block holding pos, decoding ahead if it's past what's been decoded so far. Returns false with no error at the end of the stream.
+static bool FindLZ4Block(IOStreamLZ4Data *iodata, Uint64 pos, Uint32 *index, bool *failed)
+{
+    *failed = false;
+    while ((iodata->num_sized < iodata->num_blocks) && (pos >= GetLZ4SizedEnd(iodata))) {
+        if (!DecodeLZ4Blocks(iodata, iodata->num_sized)) {
+            *failed = true;
+            return false;
+        }
+    }
+    if (pos >= GetLZ4SizedEnd(iodata)) {
+        return false;
+    }
+
+    // the last block starting at or before pos.
+    Uint32 lo = 0;
+    Uint32 hi = iodata->num_sized;
+    while ((hi - lo) > 1) {
+        const Uint32 mid = lo + ((hi - lo) / 2);
+        if (iodata->blocks[mid].offset <= pos) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    *index = lo;
+    return true;
+}
+
+static Sint64 SDLCALL lz4_size(void *userdata)
+{
+    IOStreamLZ4Data *iodata = (IOStreamLZ4Data *)userdata;
+    if (iodata->content_size >= 0) {
+        return iodata->content_size;
+    }
+
+    // without sizes in the frame headers, the only way to know is to decode everything.
+    while (iodata->num_sized < iodata->num_blocks) {
+        if (!DecodeLZ4Blocks(iodata, iodata->num_sized)) {
+            return -1;
+        }
+    }
+    return (Sint64)GetLZ4SizedEnd(iodata);
+}
+
+static Sint64 SDLCALL lz4_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamLZ4Data *iodata = (IOStreamLZ4Data *)userdata;
+    Sint64 base;
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        base = 0;
+        break;
+    case SDL_IO_SEEK_CUR:
+        base = (Sint64)iodata->pos;
+        break;
+    case SDL_IO_SEEK_END:
+        base = lz4_size(iodata);
+        if (base < 0) {
+            return -1;
+        }
+        break;
+    default:
+        SDL_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+
+    const Sint64 newpos = base + offset;
+    if (newpos < 0) {
+        SDL_SetError("Seek before the start of the stream");
+        return -1;
+    }
+    iodata->pos = (Uint64)newpos;  // the seek itself doesn't decode anything, reads take care of that.
+    return newpos;
+}
+
+static size_t SDLCALL lz4_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamLZ4Data *iodata = (IOStreamLZ4Data *)userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+
+    while (total < size) {
+        Uint32 index;
+        bool failed;
+        if (!FindLZ4Block(iodata, iodata->pos, &index, &failed)) {
+            *status = failed ? SDL_IO_STATUS_ERROR : SDL_IO_STATUS_EOF;
+            break;
+        }
+        if ((index < iodata->window_first) || (index >= (iodata->window_first + iodata->window_count))) {
+            if (!DecodeLZ4Blocks(iodata, index)) {
+                *status = SDL_IO_STATUS_ERROR;
+                break;
+            }
+        }
+
+        const LZ4Block *block = &iodata->blocks[index];
+        const Uint64 skip = iodata->pos - block->offset;
+        const size_t len = (size_t)SDL_min((Uint64)(size - total), block->size - skip);
+        SDL_memcpy(dst + total, GetLZ4WindowSlot(iodata, index - iodata->window_first) + skip, len);
+        total += len;
+        iodata->pos += len;
+    }
+
+    return total;
+}
+
+static void FreeLZ4Data(IOStreamLZ4Data *iodata)
+{
+    if (iodata->closeio) {
+        SDL_CloseIO(iodata->src);
+    }
+    SDL_free(iodata->frames);
+    SDL_free(iodata->blocks);
+    SDL_free(iodata->window);
+    SDL_free(iodata->stored);
+    SDL_free(iodata->history);
+    SDL_free(iodata);
+}
+
+static bool SDLCALL lz4_close(void *userdata)
+{
+    FreeLZ4Data((IOStreamLZ4Data *)userdata);
+    return true;
+}
+
+static bool SkipLZ4Bytes(SDL_IOStream *src, Sint64 len, Sint64 src_size)
+{
+    const Sint64 pos = SDL_SeekIO(src, len, SDL_IO_SEEK_CUR);
+    if (pos < 0) {
+        return false;
+    } else if ((src_size >= 0) && (pos > src_size)) {
+        return SDL_SetError("LZ4 stream is truncated");
+    }
+    return true;
+}
+
+static bool AddLZ4Block(IOStreamLZ4Data *iodata, Uint32 *capacity, const LZ4Block *block)
+{
+    if (iodata->num_blocks == *capacity) {
+        const Uint32 new_capacity = *capacity ? (*capacity * 2) : 16;
+        LZ4Block *blocks = (LZ4Block *)SDL_realloc(iodata->blocks, new_capacity * sizeof(*blocks));
+        if (!blocks) {
+            return false;
+        }
+        iodata->blocks = blocks;
+        *capacity = new_capacity;
+    }
+    iodata->blocks[iodata->num_blocks++] = *block;
+    return true;
+}
+
+static bool IndexLZ4Frames(IOStreamLZ4Data *iodata)
+{
+    SDL_IOStream *src = iodata->src;
+    const Sint64 src_size = SDL_GetIOSize(src);
+    Uint32 block_capacity = 0;
+    Uint32 frame_capacity = 0;
+    Uint64 content_size = 0;
+    bool have_content_size = true;
+
+    for (;;) {
+        Uint32 magic;
+        if (!SDL_ReadU32LE(src, &magic)) {
+            if ((SDL_GetIOStatus(src) == SDL_IO_STATUS_EOF) && (iodata->num_frames > 0)) {
+                break;  // frames can be concatenated, so the end of the stream is the only real end.
+            }
+            return (SDL_GetIOStatus(src) == SDL_IO_STATUS_EOF) ? SDL_SetError("Not an LZ4 stream") : false;
+        }
+
+        if ((magic & 0xFFFFFFF0) == LZ4_SKIPPABLE_MAGIC) {
+            Uint32 len;
+            if (!SDL_ReadU32LE(src, &len) || !SkipLZ4Bytes(src, len, src_size)) {
+                return false;
+            }
+            continue;
+        } else if (magic != LZ4_FRAME_MAGIC) {
+            return SDL_SetError("Not an LZ4 stream");
+        }
+
+        Uint8 flg, bd, checksum;
+        if (!SDL_ReadU8(src, &flg) || !SDL_ReadU8(src, &bd)) {
+            return false;
+        } else if (((flg & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION) || (flg & LZ4_FLG_RESERVED) || (bd & 0x8F)) {
+            return SDL_SetError("Unsupported LZ4 frame version");
+        } else if (flg & LZ4_FLG_DICTIONARY) {
+            return SDL_SetError("LZ4 frames with a dictionary aren't supported");
+        }
+
+        const int block_size_id = (bd >> 4) & 7;
+        if (block_size_id < 4) {
+            return SDL_SetError("Invalid LZ4 block size");
+        }
+
+        if (flg & LZ4_FLG_CONTENT_SIZE) {
+            Uint64 frame_size;
+            if (!SDL_ReadU64LE(src, &frame_size)) {
+                return false;
+            }
+            content_size += frame_size;
+        } else {
+            have_content_size = false;
+        }
+        if (!SDL_ReadU8(src, &checksum)) {  // the checksums aren't verified.
+            return false;
+        }
+
+        if (iodata->num_frames == frame_capacity) {
+            frame_capacity = frame_capacity ? (frame_capacity * 2) : 1;
+            LZ4Frame *frames = (LZ4Frame *)SDL_realloc(iodata->frames, frame_capacity * sizeof(*frames));
+            if (!frames) {
+                return false;
+            }
+            iodata->frames = frames;
+        }
+        LZ4Frame *frame = &iodata->frames[iodata->num_frames];
+        frame->first_block = iodata->num_blocks;
+        frame->max_block_size = (Uint32)1 << (8 + (2 * block_size_id));
+        frame->linked = !(flg & LZ4_FLG_INDEPENDENT);
+        iodata->max_block_size = SDL_max(iodata->max_block_size, frame->max_block_size);
+
+        for (;;) {
+            Uint32 block_header;
+            if (!SDL_ReadU32LE(src, &block_header)) {
+                return (SDL_GetIOStatus(src) == SDL_IO_STATUS_EOF) ? SDL_SetError("LZ4 stream is truncated") : false;
+            } else if (block_header == 0) {
+                break;  // end mark
+            }
+
+            LZ4Block block;
+            SDL_zero(block);
+            block.stored_size = block_header & ~LZ4_BLOCK_UNCOMPRESSED;
+            block.raw = (block_header & LZ4_BLOCK_UNCOMPRESSED) != 0;
+            block.frame = iodata->num_frames;
+            block.src_offset = (Uint64)SDL_TellIO(src);
+            if (block.stored_size > frame->max_block_size) {
+                return SDL_SetError("LZ4 block is larger than its frame allows");
+            } else if (!AddLZ4Block(iodata, &block_capacity, &block)) {
+                return false;
+            } else if (!SkipLZ4Bytes(src, (Sint64)block.stored_size + ((flg & LZ4_FLG_BLOCK_CHECKSUM) ? 4 : 0), src_size)) {
+                return false;
+            }
+        }
+
+        if ((flg & LZ4_FLG_CONTENT_CHECKSUM) && !SkipLZ4Bytes(src, 4, src_size)) {
+            return false;
+        }
+        iodata->num_frames++;
+    }
+
+    iodata->content_size = have_content_size ? (Sint64)content_size : -1;
+    return true;
+}
+
+SDL_IOStream *SDL_IOFromLZ4(SDL_IOStream *src, bool closeio)
+{
+    IOStreamLZ4Data *iodata = NULL;
+    bool linked = false;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto failed;
+    }
+
+    iodata = (IOStreamLZ4Data *)SDL_calloc(1, sizeof(*iodata));
+    if (!iodata) {
+        goto failed;
+    }
+    iodata->src = src;
+    iodata->closeio = closeio;
+
+    if (!IndexLZ4Frames(iodata)) {
+        goto failed;
+    }
+
+    for (Uint32 i = 0; i < iodata->num_frames; ++i) {
+        linked |= iodata->frames[i].linked;
+    }
+
+    // decode a batch of blocks at once, one per job thread, as long as that doesn't take too much memory.
+    iodata->window_slots = (Uint32)SDL_GetNumJobWorkers() + 1;
+    iodata->window_slots = SDL_min(iodata->window_slots, LZ4_MAX_BATCH_BYTES / iodata->max_block_size);
+    iodata->window_slots = SDL_clamp(iodata->window_slots, 1, SDL_MAX_JOB_WORKERS);
+
+    iodata->window = (Uint8 *)SDL_malloc((size_t)iodata->window_slots * (LZ4_HISTORY_SIZE + iodata->max_block_size));
+    iodata->stored = (Uint8 *)SDL_malloc((size_t)iodata->window_slots * iodata->max_block_size);
+    if (!iodata->window || !iodata->stored) {
+        goto failed;
+    }
+    if (linked) {
+        iodata->history = (Uint8 *)SDL_malloc(LZ4_HISTORY_SIZE);
+        if (!iodata->history) {
+            goto failed;
+        }
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = lz4_size;
+    iface.seek = lz4_seek;
+    iface.read = lz4_read;
+    iface.close = lz4_close;
+
+    SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        goto failed;
+    }
+    return iostr;
+
+failed:
+    if (iodata) {
+        FreeLZ4Data(iodata);
+    } else if (src && closeio) {
+        SDL_CloseIO(src);
+    }
+    return NULL;
+}
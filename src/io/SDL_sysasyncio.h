@@ -67,6 +67,8 @@
 #define LINKED_LIST_PREV(item, prefix) (item->prefix##prev)
 
 typedef struct SDL_AsyncIOTask SDL_AsyncIOTask;
+typedef struct SDL_AsyncIOGroup SDL_AsyncIOGroup;
+typedef struct SDL_AsyncIOLoad SDL_AsyncIOLoad;
 
 struct SDL_AsyncIOTask
 {
@@ -83,7 +85,46 @@ struct SDL_AsyncIOTask
     void *app_userdata;
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, asyncio);
     LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, queue);      // the generic backend uses this, so I've added it here to avoid the extra allocation.
-    LINKED_LIST_DECLARE_FIELDS(struct SDL_AsyncIOTask, threadpool); // the generic backend uses this, so I've added it here to avoid the extra allocation.
+    SDL_AtomicInt threadpool_canceled;  // the generic backend uses this, so I've added it here to avoid the extra allocation.
+    SDL_AsyncIOSegment *segments;  // for vectored i/o, this is allocated along with the task; `buffer` is the first one and `requested_size` their total. NULL otherwise.
+    int num_segments;
+    SDL_AsyncIOGroup *group;  // if not NULL, this task is one member of a group, and its results are reported through that instead.
+    int group_index;
+    SDL_AsyncIOLoad *load;  // if not NULL, this task is one chunk of a SDL_LoadFileAsyncWithProperties load, and is reported through that instead.
+    void *backend_data;  // anything a backend needs to keep until the task is done, it's SDL_free()'d along with the task.
+};
+
+// Several tasks that are reported to the app as one, once all of them are done.
+struct SDL_AsyncIOGroup
+{
+    SDL_AsyncIOTask task;  // not queued anywhere, this holds what the app gets back.
+    SDL_AtomicInt remaining;
+    SDL_SpinLock lock;  // protects the results in `task` while members finish on different threads.
+    SDL_AsyncIORequest *requests;  // for SDL_SubmitAsyncIOBatch, each member's results go here too.
+    SDL_AsyncIOGroup *next_ready;
+};
+
+// A chunked load from SDL_LoadFileAsyncWithProperties. New chunks are started as finished ones are collected from the queue.
+struct SDL_AsyncIOLoad
+{
+    SDL_AsyncIO *asyncio;  // a oneshot open, closed once the last chunk is done.
+    SDL_AsyncIOQueue *queue;
+    SDL_AsyncIOGroup *reserved;  // the outcome slot, for a load that finishes before anything is collected from the queue.
+    SDL_SpinLock lock;  // protects everything below, since several threads might be collecting chunks from the queue.
+    Uint8 *buffer;
+    bool owns_buffer;  // true if SDL allocated the buffer.
+    bool discarding;  // true if the queue is being destroyed, so nobody will ever see this.
+    Uint64 requested;
+    Uint64 size;  // this shrinks if a chunk comes up short, so nothing past the end is asked for.
+    Uint64 next_offset;
+    Uint64 bytes_done;
+    Uint64 chunk_size;
+    int inflight;  // chunks started and not collected yet, plus one for whoever is starting more.
+    int max_inflight;
+    SDL_AsyncIOResult result;
+    SDL_AsyncIOProgressCallback progress;
+    void *progress_userdata;
+    void *app_userdata;
 };
 
 typedef struct SDL_AsyncIOQueueInterface
@@ -94,6 +135,9 @@ typedef struct SDL_AsyncIOQueueInterface
     SDL_AsyncIOTask * (*wait_results)(void *userdata, Sint32 timeoutMS);
     void (*signal)(void *userdata);
     void (*destroy)(void *userdata);
+    // optional, tasks queued between these may be held back and handed to the OS all at once.
+    bool (*begin_batch)(void *userdata);
+    void (*end_batch)(void *userdata);
 } SDL_AsyncIOQueueInterface;
 
 struct SDL_AsyncIOQueue
@@ -101,6 +145,8 @@ struct SDL_AsyncIOQueue
     SDL_AsyncIOQueueInterface iface;
     void *userdata;
     SDL_AtomicInt tasks_inflight;
+    SDL_SpinLock ready_lock;
+    SDL_AsyncIOGroup *ready_groups;  // groups whose last member finished before they were fully started, waiting to be reported.
 };
 
 // this interface is kept per-object, even though generally it's going to decide
@@ -114,6 +160,11 @@ typedef struct SDL_AsyncIOInterface
     bool (*write)(void *userdata, SDL_AsyncIOTask *task);
     bool (*close)(void *userdata, SDL_AsyncIOTask *task);
     void (*destroy)(void *userdata);
+    // optional, tasks with segments are split into a group of plain reads or writes if these are NULL.
+    bool (*readv)(void *userdata, SDL_AsyncIOTask *task);
+    bool (*writev)(void *userdata, SDL_AsyncIOTask *task);
+    // optional, a NULL here means the backend ignores access hints.
+    bool (*advise)(void *userdata, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice);
 } SDL_AsyncIOInterface;
 
 struct SDL_AsyncIO
@@ -123,11 +174,20 @@ struct SDL_AsyncIO
     SDL_Mutex *lock;
     SDL_AsyncIOTask tasks;
     SDL_AsyncIOTask *closing;  // The close task, which isn't queued until all pending work for this file is done.
-    bool oneshot;  // true if this is a SDL_LoadFileAsync open.
+    bool oneshot;  // true if this is a SDL_LoadFileAsync (or SDL_TransferFileAsync) open.
+    bool owns_buffer;  // true if SDL_LoadFileAsync allocated the buffer, so it's freed if the app never gets it.
+    size_t alignment;  // buffers, offsets and sizes must be multiples of this. Backends set it for unbuffered files, it's 1 otherwise.
 };
 
+// Backends get the creation options that they can act on while opening the file.
+typedef struct SDL_AsyncIOFileOptions
+{
+    bool unbuffered;  // bypass the OS file cache if possible. A backend that manages it sets asyncio->alignment.
+    SDL_AsyncIOAdvice advice;  // also passed to iface.advise after opening, this is here for platforms that can only take hints at open time.
+} SDL_AsyncIOFileOptions;
+
 // This is implemented for various platforms; param validation is done before calling this. Open file, fill in iface and userdata.
-extern bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+extern bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio);
 
 // This is implemented for various platforms. Call SDL_OpenAsyncIOQueue from in here.
 extern bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue);
@@ -136,9 +196,17 @@ extern bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue);
 extern void SDL_SYS_QuitAsyncIO(void);
 
 // the "generic" version is always available, since it is almost always needed as a fallback even on platforms that might offer something better.
-extern bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+extern bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio);
 extern bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue);
 extern void SDL_SYS_QuitAsyncIO_Generic(void);
 
+// Unix backends share the file descriptor side of unbuffered i/o and access hints; these live with the generic backend.
+#if !defined(SDL_PLATFORM_WINDOWS) && (defined(SDL_PLATFORM_UNIX) || defined(SDL_PLATFORM_APPLE)) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#define SDL_ASYNCIO_HAVE_FD_HINTS 1
+// Try to turn off caching on an open file descriptor, returns the alignment it needs now, or 1 if caching is still on.
+extern size_t SDL_SYS_MakeAsyncIOFDUnbuffered(int fd);
+extern bool SDL_SYS_AdviseAsyncIOFD(int fd, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice);
+#endif
+
 #endif
 
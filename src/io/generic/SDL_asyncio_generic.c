@@ -19,13 +19,21 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 
-// The generic backend uses a threadpool to block on synchronous i/o.
+// The generic backend uses SDL's shared job threads to block on synchronous i/o.
 // This is not ideal, it's meant to be used if there isn't a platform-specific
 // backend that can do something more efficient!
 
 #include "SDL_internal.h"
 #include "../SDL_sysasyncio.h"
 
+#ifdef SDL_ASYNCIO_HAVE_FD_HINTS
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>  // for fileno()
+#include <string.h>  // for strerror()
+#include <sys/stat.h>
+#endif
+
 // on Emscripten without threads, async i/o is synchronous. Sorry. Almost
 // everything is MEMFS, so it's just a memcpy anyhow, and the Emscripten
 // filesystem APIs don't offer async. In theory, directly accessing
@@ -48,6 +56,7 @@ typedef struct GenericAsyncIOData
 {
     SDL_Mutex *lock;  // !!! FIXME: we can skip this lock if we have an equivalent of pread/pwrite
     SDL_IOStream *io;
+    int fd;  // the stream's file descriptor if it has one, for access hints. -1 otherwise.
 } GenericAsyncIOData;
 
 static void AsyncIOTaskComplete(SDL_AsyncIOTask *task)
@@ -60,8 +69,8 @@ static void AsyncIOTaskComplete(SDL_AsyncIOTask *task)
     SDL_UnlockMutex(data->lock);
 }
 
-// synchronous i/o is offloaded onto the threadpool. This function does the threaded work.
-// This is called directly, without a threadpool, if !SDL_ASYNCIO_USE_THREADPOOL.
+// synchronous i/o is offloaded onto a job thread. This function does the threaded work.
+// This is called directly, without a job thread, if !SDL_ASYNCIO_USE_THREADPOOL.
 static void SynchronousIO(SDL_AsyncIOTask *task)
 {
     SDL_assert(task->result != SDL_ASYNCIO_CANCELED);  // shouldn't have gotten in here if canceled!
@@ -86,7 +95,21 @@ static void SynchronousIO(SDL_AsyncIOTask *task)
         task->result = SDL_ASYNCIO_FAILURE;
     } else {
         const bool writing = (task->type == SDL_ASYNCIO_TASK_WRITE);
-        task->result_size = (Uint64) (writing ? SDL_WriteIO(io, ptr, size) : SDL_ReadIO(io, ptr, size));
+        if (task->segments) {
+            // vectored i/o is one contiguous range of the file, so just walk the segments in order until one comes up short.
+            task->result_size = 0;
+            for (int i = 0; i < task->num_segments; i++) {
+                void *segptr = task->segments[i].buffer;
+                const size_t segsize = (size_t) task->segments[i].size;
+                const size_t amount = writing ? SDL_WriteIO(io, segptr, segsize) : SDL_ReadIO(io, segptr, segsize);
+                task->result_size += amount;
+                if (amount < segsize) {
+                    break;
+                }
+            }
+        } else {
+            task->result_size = (Uint64) (writing ? SDL_WriteIO(io, ptr, size) : SDL_ReadIO(io, ptr, size));
+        }
         if (task->result_size == task->requested_size) {
             task->result = SDL_ASYNCIO_COMPLETE;
         } else {
@@ -106,178 +129,120 @@ static void SynchronousIO(SDL_AsyncIOTask *task)
 }
 
 #if SDL_ASYNCIO_USE_THREADPOOL
-static SDL_InitState threadpool_init;
-static SDL_Mutex *threadpool_lock = NULL;
-static bool stop_threadpool = false;
-static SDL_AsyncIOTask threadpool_tasks;
-static SDL_Condition *threadpool_condition = NULL;
-static int max_threadpool_threads = 0;
-static int running_threadpool_threads = 0;
-static int idle_threadpool_threads = 0;
-static int threadpool_threads_spun = 0;
-
-static int SDLCALL AsyncIOThreadpoolWorker(void *data)
+static void SDLCALL AsyncIOJob(void *userdata)
 {
-    SDL_LockMutex(threadpool_lock);
-
-    while (!stop_threadpool) {
-        SDL_AsyncIOTask *task = LINKED_LIST_START(threadpool_tasks, threadpool);
-        if (!task) {
-            // if we go 30 seconds without a new task, terminate unless we're the only thread left.
-            idle_threadpool_threads++;
-            const bool rc = SDL_WaitConditionTimeout(threadpool_condition, threadpool_lock, 30000);
-            idle_threadpool_threads--;
-
-            if (!rc) {
-                // decide if we have too many idle threads, and if so, quit to let thread pool shrink when not busy.
-                if (idle_threadpool_threads) {
-                    break;
-                }
-            }
-
-            continue;
-        }
+    SDL_AsyncIOTask *task = (SDL_AsyncIOTask *) userdata;
 
-        LINKED_LIST_UNLINK(task, threadpool);
-
-        SDL_UnlockMutex(threadpool_lock);
-
-        // bookkeeping is done, so we drop the mutex and fire the work.
+    // canceled tasks can't be pulled back out of the job queue, they just skip the i/o when they come up.
+    if (SDL_GetAtomicInt(&task->threadpool_canceled)) {
+        task->result = SDL_ASYNCIO_CANCELED;
+        AsyncIOTaskComplete(task);
+    } else {
         SynchronousIO(task);
-
-        SDL_LockMutex(threadpool_lock);  // take the lock again and see if there's another task (if not, we'll wait on the Condition).
     }
-
-    running_threadpool_threads--;
-
-    // this is kind of a hack, but this lets us reuse threadpool_condition to block on shutdown until all threads have exited.
-    if (stop_threadpool) {
-        SDL_BroadcastCondition(threadpool_condition);
-    }
-
-    SDL_UnlockMutex(threadpool_lock);
-
-    return 0;
 }
+#endif
+
 
-static bool MaybeSpinNewWorkerThread(void)
+static Sint64 generic_asyncio_size(void *userdata)
 {
-    // if all existing threads are busy and the pool of threads isn't maxed out, make a new one.
-    if ((idle_threadpool_threads == 0) && (running_threadpool_threads < max_threadpool_threads)) {
-        char threadname[32];
-        SDL_snprintf(threadname, sizeof (threadname), "SDLasyncio%d", threadpool_threads_spun);
-        SDL_Thread *thread = SDL_CreateThread(AsyncIOThreadpoolWorker, threadname, NULL);
-        if (thread == NULL) {
-            return false;
-        }
-        SDL_DetachThread(thread);  // these terminate themselves when idle too long, so we never WaitThread.
-        running_threadpool_threads++;
-        threadpool_threads_spun++;
-    }
-    return true;
+    GenericAsyncIOData *data = (GenericAsyncIOData *) userdata;
+    return SDL_GetIOSize(data->io);
 }
 
-static void QueueAsyncIOTask(SDL_AsyncIOTask *task)
+static bool generic_asyncio_io(void *userdata, SDL_AsyncIOTask *task)
 {
-    SDL_assert(task != NULL);
-
-    SDL_LockMutex(threadpool_lock);
-
-    if (stop_threadpool) {  // just in case.
-        task->result = SDL_ASYNCIO_CANCELED;
-        AsyncIOTaskComplete(task);
-    } else {
-        LINKED_LIST_PREPEND(task, threadpool_tasks, threadpool);
-        MaybeSpinNewWorkerThread();  // okay if this fails or the thread pool is maxed out. Something will get there eventually.
-
-        // tell idle threads to get to work.
-        // This is a broadcast because we want someone from the thread pool to wake up, but
-        // also shutdown might also be blocking on this. One of the threads will grab
-        // it, the others will go back to sleep.
-        SDL_BroadcastCondition(threadpool_condition);
-    }
-
-    SDL_UnlockMutex(threadpool_lock);
+    return task->queue->iface.queue_task(task->queue->userdata, task);
 }
 
-// We don't initialize async i/o at all until it's used, so
-//  JUST IN CASE two things try to start at the same time,
-//  this will make sure everything gets the same mutex.
-static bool PrepareThreadpool(void)
+#ifdef SDL_ASYNCIO_HAVE_FD_HINTS
+size_t SDL_SYS_MakeAsyncIOFDUnbuffered(int fd)
 {
-    bool okay = true;
-    if (SDL_ShouldInit(&threadpool_init)) {
-        max_threadpool_threads = (SDL_GetNumLogicalCPUCores() * 2) + 1;  // !!! FIXME: this should probably have a hint to override.
-        max_threadpool_threads = SDL_clamp(max_threadpool_threads, 1, 8);  // 8 is probably more than enough.
-
-        okay = (okay && ((threadpool_lock = SDL_CreateMutex()) != NULL));
-        okay = (okay && ((threadpool_condition = SDL_CreateCondition()) != NULL));
-        okay = (okay && MaybeSpinNewWorkerThread());  // make sure at least one thread is going, since we'll need it.
-
-        if (!okay) {
-            if (threadpool_condition) {
-                SDL_DestroyCondition(threadpool_condition);
-                threadpool_condition = NULL;
-            }
-            if (threadpool_lock) {
-                SDL_DestroyMutex(threadpool_lock);
-                threadpool_lock = NULL;
-            }
-        }
+#if defined(SDL_PLATFORM_APPLE)
+    // F_NOCACHE keeps data out of the unified buffer cache, and has no alignment rules.
+    (void) fcntl(fd, F_NOCACHE, 1);
+    return 1;
+#elif defined(O_DIRECT)
+    const int flags = fcntl(fd, F_GETFL);
+    if ((flags == -1) || (fcntl(fd, F_SETFL, flags | O_DIRECT) == -1)) {
+        return 1;  // not every filesystem supports this, so the file just stays cached.
+    }
 
-        SDL_SetInitialized(&threadpool_init, okay);
+    size_t alignment = 0;
+#ifdef STATX_DIOALIGN
+    struct statx stx;
+    if ((statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &stx) == 0) && (stx.stx_mask & STATX_DIOALIGN) && stx.stx_dio_offset_align) {
+        alignment = (size_t) SDL_max(stx.stx_dio_mem_align, stx.stx_dio_offset_align);
+    }
+#endif
+    if (!alignment) {
+        // older kernels can't tell us, but the filesystem block size is always a safe choice.
+        struct stat statbuf;
+        alignment = ((fstat(fd, &statbuf) == 0) && (statbuf.st_blksize > 0)) ? (size_t) statbuf.st_blksize : 4096;
     }
-    return okay;
+    return alignment;
+#else
+    return 1;
+#endif
 }
 
-static void ShutdownThreadpool(void)
+bool SDL_SYS_AdviseAsyncIOFD(int fd, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice)
 {
-    if (SDL_ShouldQuit(&threadpool_init)) {
-        SDL_LockMutex(threadpool_lock);
-
-        // cancel anything that's still pending.
-        SDL_AsyncIOTask *task;
-        while ((task = LINKED_LIST_START(threadpool_tasks, threadpool)) != NULL) {
-            LINKED_LIST_UNLINK(task, threadpool);
-            task->result = SDL_ASYNCIO_CANCELED;
-            AsyncIOTaskComplete(task);
-        }
-
-        stop_threadpool = true;
-        SDL_BroadcastCondition(threadpool_condition);  // tell the whole threadpool to wake up and quit.
-
-        while (running_threadpool_threads > 0) {
-            // each threadpool thread will broadcast this condition before it terminates if stop_threadpool is set.
-            // we can't just join the threads because they are detached, so the thread pool can automatically shrink as necessary.
-            SDL_WaitCondition(threadpool_condition, threadpool_lock);
-        }
-
-        SDL_UnlockMutex(threadpool_lock);
-
-        SDL_DestroyMutex(threadpool_lock);
-        threadpool_lock = NULL;
-        SDL_DestroyCondition(threadpool_condition);
-        threadpool_condition = NULL;
+    if ((offset > SDL_MAX_SINT64) || (size > SDL_MAX_SINT64)) {
+        return SDL_SetError("Range is too large");
+    }
 
-        max_threadpool_threads = running_threadpool_threads = idle_threadpool_threads = threadpool_threads_spun = 0;
+#if defined(POSIX_FADV_NORMAL) && !defined(SDL_PLATFORM_APPLE)
+    int fadvice;
+    switch (advice) {
+    case SDL_ASYNCIO_ADVICE_SEQUENTIAL: fadvice = POSIX_FADV_SEQUENTIAL; break;
+    case SDL_ASYNCIO_ADVICE_RANDOM: fadvice = POSIX_FADV_RANDOM; break;
+    case SDL_ASYNCIO_ADVICE_WILLNEED: fadvice = POSIX_FADV_WILLNEED; break;
+    case SDL_ASYNCIO_ADVICE_DONTNEED: fadvice = POSIX_FADV_DONTNEED; break;
+    default: fadvice = POSIX_FADV_NORMAL; break;
+    }
 
-        stop_threadpool = false;
-        SDL_SetInitialized(&threadpool_init, false);
+    const int rc = posix_fadvise(fd, (off_t) offset, (off_t) size, fadvice);  // this returns the error instead of setting errno.
+    if (rc == ESPIPE) {
+        return true;  // pipes and such don't have a cache to tune.
+    } else if (rc != 0) {
+        return SDL_SetError("posix_fadvise failed: %s", strerror(rc));
+    }
+#elif defined(SDL_PLATFORM_APPLE)
+    // no posix_fadvise here, but read-ahead can be switched on and off, and a range can be prefetched.
+    if (advice == SDL_ASYNCIO_ADVICE_WILLNEED) {
+        struct radvisory ra;
+        ra.ra_offset = (off_t) offset;
+        ra.ra_count = (int) SDL_min(size ? size : SDL_MAX_SINT32, SDL_MAX_SINT32);
+        (void) fcntl(fd, F_RDADVISE, &ra);
+    } else if (advice != SDL_ASYNCIO_ADVICE_DONTNEED) {
+        (void) fcntl(fd, F_RDAHEAD, (advice == SDL_ASYNCIO_ADVICE_RANDOM) ? 0 : 1);
     }
-}
 #endif
+    return true;
+}
 
-
-static Sint64 generic_asyncio_size(void *userdata)
+static bool generic_asyncio_advise(void *userdata, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice)
 {
     GenericAsyncIOData *data = (GenericAsyncIOData *) userdata;
-    return SDL_GetIOSize(data->io);
+    if (data->fd == -1) {
+        return true;  // not backed by a file descriptor, so there's nothing to tell the OS.
+    }
+    return SDL_SYS_AdviseAsyncIOFD(data->fd, offset, size, advice);
 }
 
-static bool generic_asyncio_io(void *userdata, SDL_AsyncIOTask *task)
+static int GetIOStreamFD(SDL_IOStream *io)
 {
-    return task->queue->iface.queue_task(task->queue->userdata, task);
+    const SDL_PropertiesID props = SDL_GetIOProperties(io);
+    if (SDL_HasProperty(props, SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER)) {
+        return (int) SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, -1);
+    }
+    FILE *fp = (FILE *) SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_STDIO_FILE_POINTER, NULL);
+    return fp ? fileno(fp) : -1;
 }
+#else
+#define generic_asyncio_advise NULL
+#endif
 
 static void generic_asyncio_destroy(void *userdata)
 {
@@ -290,11 +255,11 @@ static void generic_asyncio_destroy(void *userdata)
 static bool generic_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
 {
     #if SDL_ASYNCIO_USE_THREADPOOL
-    QueueAsyncIOTask(task);
+    return SDL_SubmitJob(AsyncIOJob, task);
     #else
     SynchronousIO(task);  // oh well. Get a better platform.
-    #endif
     return true;
+    #endif
 }
 
 static void generic_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
@@ -303,14 +268,8 @@ static void generic_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *ta
     task->result = SDL_ASYNCIO_CANCELED;
     AsyncIOTaskComplete(task);
     #else
-    // we can't stop i/o that's in-flight, but we _can_ just refuse to start it if the threadpool hadn't picked it up yet.
-    SDL_LockMutex(threadpool_lock);
-    if (LINKED_LIST_PREV(task, threadpool) != NULL) {  // still in the queue waiting to be run? Take it out.
-        LINKED_LIST_UNLINK(task, threadpool);
-        task->result = SDL_ASYNCIO_CANCELED;
-        AsyncIOTaskComplete(task);
-    }
-    SDL_UnlockMutex(threadpool_lock);
+    // we can't stop i/o that's in-flight, but we _can_ just refuse to start it if a job thread hadn't picked it up yet.
+    SDL_SetAtomicInt(&task->threadpool_canceled, 1);
     #endif
 }
 
@@ -360,12 +319,6 @@ static void generic_asyncioqueue_destroy(void *userdata)
 
 bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
 {
-    #if SDL_ASYNCIO_USE_THREADPOOL
-    if (!PrepareThreadpool()) {
-        return false;
-    }
-    #endif
-
     GenericAsyncIOQueueData *data = (GenericAsyncIOQueueData *) SDL_calloc(1, sizeof (*data));
     if (!data) {
         return false;
@@ -399,14 +352,8 @@ bool SDL_SYS_CreateAsyncIOQueue_Generic(SDL_AsyncIOQueue *queue)
 }
 
 
-bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
-    #if SDL_ASYNCIO_USE_THREADPOOL
-    if (!PrepareThreadpool()) {
-        return false;
-    }
-    #endif
-
     GenericAsyncIOData *data = (GenericAsyncIOData *) SDL_calloc(1, sizeof (*data));
     if (!data) {
         return false;
@@ -425,12 +372,25 @@ bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_Asy
         return false;
     }
 
+    data->fd = -1;
+#ifdef SDL_ASYNCIO_HAVE_FD_HINTS
+    data->fd = GetIOStreamFD(data->io);
+    if (options->unbuffered && (data->fd != -1)) {
+        // SDL's own buffering (or stdio's) would defeat the point, and would break the alignment rules.
+        SDL_SetNumberProperty(SDL_GetIOProperties(data->io), SDL_PROP_IOSTREAM_BUFFER_SIZE_NUMBER, 0);
+        asyncio->alignment = SDL_SYS_MakeAsyncIOFDUnbuffered(data->fd);
+    }
+#endif
+
     static const SDL_AsyncIOInterface SDL_AsyncIOFile_Generic = {
         generic_asyncio_size,
         generic_asyncio_io,
         generic_asyncio_io,
         generic_asyncio_io,
-        generic_asyncio_destroy
+        generic_asyncio_destroy,
+        generic_asyncio_io,
+        generic_asyncio_io,
+        generic_asyncio_advise
     };
 
     SDL_copyp(&asyncio->iface, &SDL_AsyncIOFile_Generic);
@@ -440,16 +400,14 @@ bool SDL_SYS_AsyncIOFromFile_Generic(const char *file, const char *mode, SDL_Asy
 
 void SDL_SYS_QuitAsyncIO_Generic(void)
 {
-    #if SDL_ASYNCIO_USE_THREADPOOL
-    ShutdownThreadpool();
-    #endif
+    // the job threads are shared with the rest of SDL, and are shut down by SDL_Quit().
 }
 
 
 #if SDL_ASYNCIO_ONLY_HAVE_GENERIC
-bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
-    return SDL_SYS_AsyncIOFromFile_Generic(file, mode, asyncio);
+    return SDL_SYS_AsyncIOFromFile_Generic(file, mode, options, asyncio);
 }
 
 bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
@@ -32,14 +32,16 @@
 #include <liburing.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>  // for IOV_MAX
 #include <string.h>  // for strerror()
+#include <sys/uio.h>
 
 static SDL_InitState liburing_init;
 
 // We could add a whole bootstrap thing like the audio/video/etc subsystems use, but let's keep this simple for now.
 static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue);
 static void (*QuitAsyncIO)(void);
-static bool (*AsyncIOFromFile)(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+static bool (*AsyncIOFromFile)(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio);
 
 // we never link directly to liburing.
 // (this says "-ffi" which sounds like a scripting language binding thing, but the non-ffi version
@@ -55,6 +57,8 @@ static void *liburing_handle = NULL;
     SDL_LIBURING_FUNC(struct io_uring_sqe *, io_uring_get_sqe, (struct io_uring *ring)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_read,(struct io_uring_sqe *sqe, int fd, void *buf, unsigned nbytes, __u64 offset)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_write,(struct io_uring_sqe *sqe, int fd, const void *buf, unsigned nbytes, __u64 offset)) \
+    SDL_LIBURING_FUNC(void, io_uring_prep_readv,(struct io_uring_sqe *sqe, int fd, const struct iovec *iovecs, unsigned nr_vecs, __u64 offset)) \
+    SDL_LIBURING_FUNC(void, io_uring_prep_writev,(struct io_uring_sqe *sqe, int fd, const struct iovec *iovecs, unsigned nr_vecs, __u64 offset)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_close, (struct io_uring_sqe *sqe, int fd)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_fsync, (struct io_uring_sqe *sqe, int fd, unsigned fsync_flags)) \
     SDL_LIBURING_FUNC(void, io_uring_prep_cancel, (struct io_uring_sqe *sqe, void *user_data, int flags)) \
@@ -90,6 +94,9 @@ typedef struct LibUringAsyncIOQueueData
     SDL_Mutex *cqe_lock;
     struct io_uring ring;
     SDL_AtomicInt num_waiting;
+    bool defer_submit;  // if true, sqes are batched up until someone asks for results, see SDL_HINT_ASYNCIO_DEFER_SUBMIT.
+    SDL_AtomicInt num_pending;  // sqes queued but not submitted yet. Only changed while holding sqe_lock.
+    int batching;  // non-zero while an SDL_SubmitAsyncIOBatch() is queueing tasks, which are submitted together at the end. Only used while holding sqe_lock.
 } LibUringAsyncIOQueueData;
 
 
@@ -137,6 +144,8 @@ static bool LoadLibUring(void)
                     IORING_OP_CLOSE,
                     IORING_OP_READ,
                     IORING_OP_WRITE,
+                    IORING_OP_READV,
+                    IORING_OP_WRITEV,
                     IORING_OP_ASYNC_CANCEL
                 };
 
@@ -179,12 +188,67 @@ static Sint64 liburing_asyncio_size(void *userdata)
     return ((Sint64) statbuf.st_size);
 }
 
+// you must hold sqe_lock when calling this!
+static bool liburing_submit(LibUringAsyncIOQueueData *queuedata)
+{
+    const int rc = liburing.io_uring_submit(&queuedata->ring);
+    if (rc < 0) {
+        return liburing_SetError("io_uring_submit", rc);
+    }
+    SDL_SetAtomicInt(&queuedata->num_pending, 0);
+    return true;
+}
+
+// push out anything batched up by defer_submit. This takes sqe_lock, don't hold it when calling this!
+static void liburing_submit_pending(LibUringAsyncIOQueueData *queuedata)
+{
+    if (SDL_GetAtomicInt(&queuedata->num_pending) > 0) {
+        SDL_LockMutex(queuedata->sqe_lock);
+        if (SDL_GetAtomicInt(&queuedata->num_pending) > 0) {
+            liburing_submit(queuedata);
+        }
+        SDL_UnlockMutex(queuedata->sqe_lock);
+    }
+}
+
+// you must hold sqe_lock when calling this! If we're batching submissions, a full submission queue gets flushed to make room.
+static struct io_uring_sqe *liburing_get_sqe(LibUringAsyncIOQueueData *queuedata)
+{
+    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    if (!sqe && (SDL_GetAtomicInt(&queuedata->num_pending) > 0) && liburing_submit(queuedata)) {
+        sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    }
+    return sqe;
+}
+
 // you must hold sqe_lock when calling this!
 static bool liburing_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
-    const int rc = liburing.io_uring_submit(&queuedata->ring);
-    return (rc < 0) ? liburing_SetError("io_uring_submit", rc) : true;
+    if (queuedata->defer_submit || queuedata->batching) {
+        SDL_AddAtomicInt(&queuedata->num_pending, 1);
+        return true;
+    }
+    return liburing_submit(queuedata);
+}
+
+// sqe_lock is held for the whole batch (it's recursive), so everything in it goes out with one submit.
+static bool liburing_asyncioqueue_begin_batch(void *userdata)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    SDL_LockMutex(queuedata->sqe_lock);
+    queuedata->batching++;
+    return true;
+}
+
+static void liburing_asyncioqueue_end_batch(void *userdata)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
+    queuedata->batching--;
+    if (!queuedata->batching && !queuedata->defer_submit && (SDL_GetAtomicInt(&queuedata->num_pending) > 0)) {
+        liburing_submit(queuedata);  // if this fails, the tasks are still queued and the next submit will pick them up.
+    }
+    SDL_UnlockMutex(queuedata->sqe_lock);
 }
 
 static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
@@ -198,7 +262,7 @@ static void liburing_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *t
 
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
     if (!sqe) {
         SDL_UnlockMutex(queuedata->sqe_lock);
         SDL_free(cancel_task);  // oh well, the task can just finish on its own.
@@ -257,6 +321,8 @@ static SDL_AsyncIOTask *liburing_asyncioqueue_get_results(void *userdata)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
 
+    liburing_submit_pending(queuedata);
+
     // have to hold a lock because otherwise two threads will get the same cqe until we mark it "seen". Copy and mark it right away, then process further.
     SDL_LockMutex(queuedata->cqe_lock);
     struct io_uring_cqe *cqe = NULL;
@@ -280,6 +346,8 @@ static SDL_AsyncIOTask *liburing_asyncioqueue_wait_results(void *userdata, Sint3
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) userdata;
     struct io_uring_cqe *cqe = NULL;
 
+    liburing_submit_pending(queuedata);  // don't wait on work that was never handed to the kernel.
+
     SDL_AddAtomicInt(&queuedata->num_waiting, 1);
     if (timeoutMS < 0) {
         liburing.io_uring_wait_cqe(&queuedata->ring, &cqe);
@@ -303,14 +371,14 @@ static void liburing_asyncioqueue_signal(void *userdata)
 
     SDL_LockMutex(queuedata->sqe_lock);
     for (int i = 0; i < num_waiting; i++) {  // !!! FIXME: is there a better way to do this than pushing a zero-timeout request for everything waiting?
-        struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+        struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
         if (sqe) {
             static struct __kernel_timespec ts;   // no wait, just wake a thread as fast as this can land in the completion queue.
             liburing.io_uring_prep_timeout(sqe, &ts, 0, 0);
             liburing.io_uring_sqe_set_data(sqe, NULL);
         }
     }
-    liburing.io_uring_submit(&queuedata->ring);
+    liburing_submit(queuedata);
 
     SDL_UnlockMutex(queuedata->sqe_lock);
 }
@@ -332,6 +400,8 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
     }
 
     SDL_SetAtomicInt(&queuedata->num_waiting, 0);
+    SDL_SetAtomicInt(&queuedata->num_pending, 0);
+    queuedata->defer_submit = SDL_GetHintBoolean(SDL_HINT_ASYNCIO_DEFER_SUBMIT, false);
 
     queuedata->sqe_lock = SDL_CreateMutex();
     if (!queuedata->sqe_lock) {
@@ -361,7 +431,9 @@ static bool SDL_SYS_CreateAsyncIOQueue_liburing(SDL_AsyncIOQueue *queue)
         liburing_asyncioqueue_get_results,
         liburing_asyncioqueue_wait_results,
         liburing_asyncioqueue_signal,
-        liburing_asyncioqueue_destroy
+        liburing_asyncioqueue_destroy,
+        liburing_asyncioqueue_begin_batch,
+        liburing_asyncioqueue_end_batch
     };
 
     SDL_copyp(&queue->iface, &SDL_AsyncIOQueue_liburing);
@@ -384,7 +456,7 @@ static bool liburing_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
     if (!sqe) {
         retval = SDL_SetError("io_uring: submission queue is full");
     } else {
@@ -410,7 +482,7 @@ static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
     if (!sqe) {
         retval = SDL_SetError("io_uring: submission queue is full");
     } else {
@@ -422,6 +494,48 @@ static bool liburing_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
     return retval;
 }
 
+static bool liburing_asyncio_vectored(void *userdata, SDL_AsyncIOTask *task)
+{
+    LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
+    const int fd = (int) (intptr_t) userdata;
+
+    // the kernel reports the total transferred in an int, same limit as the plain read and write.
+    if (task->requested_size > ((Uint64) ~((unsigned) 0))) {
+        return SDL_SetError("io_uring: i/o task is too large");
+    } else if (task->num_segments > IOV_MAX) {
+        return SDL_SetError("io_uring: i/o task has too many segments");
+    }
+
+    // the kernel might not copy these until the request actually runs, so they live as long as the task.
+    struct iovec *iov = (struct iovec *) SDL_malloc(task->num_segments * sizeof (*iov));
+    if (!iov) {
+        return false;
+    }
+    for (int i = 0; i < task->num_segments; i++) {
+        iov[i].iov_base = task->segments[i].buffer;
+        iov[i].iov_len = (size_t) task->segments[i].size;
+    }
+    task->backend_data = iov;
+
+    // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
+    SDL_LockMutex(queuedata->sqe_lock);
+    bool retval;
+    struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
+    if (!sqe) {
+        retval = SDL_SetError("io_uring: submission queue is full");
+    } else {
+        if (task->type == SDL_ASYNCIO_TASK_READ) {
+            liburing.io_uring_prep_readv(sqe, fd, iov, (unsigned) task->num_segments, task->offset);
+        } else {
+            liburing.io_uring_prep_writev(sqe, fd, iov, (unsigned) task->num_segments, task->offset);
+        }
+        liburing.io_uring_sqe_set_data(sqe, task);
+        retval = task->queue->iface.queue_task(task->queue->userdata, task);
+    }
+    SDL_UnlockMutex(queuedata->sqe_lock);
+    return retval;
+}
+
 static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
 {
     LibUringAsyncIOQueueData *queuedata = (LibUringAsyncIOQueueData *) task->queue->userdata;
@@ -430,13 +544,13 @@ static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    struct io_uring_sqe *sqe = liburing.io_uring_get_sqe(&queuedata->ring);
+    struct io_uring_sqe *sqe = liburing_get_sqe(queuedata);
     if (!sqe) {
         retval = SDL_SetError("io_uring: submission queue is full");
     } else {
         if (task->flush) {
             struct io_uring_sqe *flush_sqe = sqe;
-            sqe = liburing.io_uring_get_sqe(&queuedata->ring);  // this will be our actual close task.
+            sqe = liburing.io_uring_get_sqe(&queuedata->ring);  // this will be our actual close task. Not liburing_get_sqe(): flushing to make room would submit flush_sqe before it is set up.
             if (!sqe) {
                 liburing.io_uring_prep_nop(flush_sqe);  // we already have the first sqe, just make it a NOP.
                 liburing.io_uring_sqe_set_data(flush_sqe, NULL);
@@ -458,6 +572,12 @@ static bool liburing_asyncio_close(void *userdata, SDL_AsyncIOTask *task)
     return retval;
 }
 
+static bool liburing_asyncio_advise(void *userdata, Uint64 offset, Uint64 size, SDL_AsyncIOAdvice advice)
+{
+    const int fd = (int) (intptr_t) userdata;
+    return SDL_SYS_AdviseAsyncIOFD(fd, offset, size, advice);
+}
+
 static void liburing_asyncio_destroy(void *userdata)
 {
     // this is only a Unix file descriptor, should have been closed elsewhere.
@@ -483,19 +603,26 @@ static int PosixOpenModeFromString(const char *mode)
     return 0;
 }
 
-static bool SDL_SYS_AsyncIOFromFile_liburing(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+static bool SDL_SYS_AsyncIOFromFile_liburing(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
     const int fd = open(file, PosixOpenModeFromString(mode), 0644);
     if (fd == -1) {
         return SDL_SetError("open failed: %s", strerror(errno));
     }
 
+    if (options->unbuffered) {
+        asyncio->alignment = SDL_SYS_MakeAsyncIOFDUnbuffered(fd);
+    }
+
     static const SDL_AsyncIOInterface SDL_AsyncIOFile_liburing = {
         liburing_asyncio_size,
         liburing_asyncio_read,
         liburing_asyncio_write,
         liburing_asyncio_close,
-        liburing_asyncio_destroy
+        liburing_asyncio_destroy,
+        liburing_asyncio_vectored,
+        liburing_asyncio_vectored,
+        liburing_asyncio_advise
     };
 
     SDL_copyp(&asyncio->iface, &SDL_AsyncIOFile_liburing);
@@ -530,10 +657,10 @@ bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
     return CreateAsyncIOQueue(queue);
 }
 
-bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
     MaybeInitializeLibUring();
-    return AsyncIOFromFile(file, mode, asyncio);
+    return AsyncIOFromFile(file, mode, options, asyncio);
 }
 
 void SDL_SYS_QuitAsyncIO(void)
@@ -39,7 +39,7 @@ static SDL_InitState ioring_init;
 // We could add a whole bootstrap thing like the audio/video/etc subsystems use, but let's keep this simple for now.
 static bool (*CreateAsyncIOQueue)(SDL_AsyncIOQueue *queue);
 static void (*QuitAsyncIO)(void);
-static bool (*AsyncIOFromFile)(const char *file, const char *mode, SDL_AsyncIO *asyncio);
+static bool (*AsyncIOFromFile)(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio);
 
 // we never link directly to ioring.
 static const char *ioring_library = "KernelBase.dll";
@@ -80,6 +80,8 @@ typedef struct WinIoRingAsyncIOQueueData
     HANDLE event;
     HIORING ring;
     SDL_AtomicInt num_waiting;
+    int batching;  // non-zero while an SDL_SubmitAsyncIOBatch() is queueing tasks, which are submitted together at the end. Only used while holding sqe_lock.
+    bool batch_pending;
 } WinIoRingAsyncIOQueueData;
 
 
@@ -149,10 +151,44 @@ static Sint64 ioring_asyncio_size(void *userdata)
 static bool ioring_asyncioqueue_queue_task(void *userdata, SDL_AsyncIOTask *task)
 {
     WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) userdata;
+    if (queuedata->batching) {
+        queuedata->batch_pending = true;
+        return true;
+    }
     const HRESULT hr = ioring.SubmitIoRing(queuedata->ring, 0, 0, NULL);
     return (FAILED(hr) ? WIN_SetErrorFromHRESULT("SubmitIoRing", hr) : true);
 }
 
+// you must hold sqe_lock when calling this! A batch can fill the submission queue, so push out what it has so far to make room.
+static bool ioring_flush_batch(WinIoRingAsyncIOQueueData *queuedata)
+{
+    if (!queuedata->batch_pending) {
+        return false;
+    }
+    queuedata->batch_pending = false;
+    return SUCCEEDED(ioring.SubmitIoRing(queuedata->ring, 0, 0, NULL));
+}
+
+// sqe_lock is held for the whole batch (it's recursive), so everything in it goes out with one submit.
+static bool ioring_asyncioqueue_begin_batch(void *userdata)
+{
+    WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) userdata;
+    SDL_LockMutex(queuedata->sqe_lock);
+    queuedata->batching++;
+    return true;
+}
+
+static void ioring_asyncioqueue_end_batch(void *userdata)
+{
+    WinIoRingAsyncIOQueueData *queuedata = (WinIoRingAsyncIOQueueData *) userdata;
+    queuedata->batching--;
+    if (!queuedata->batching && queuedata->batch_pending) {
+        queuedata->batch_pending = false;
+        ioring.SubmitIoRing(queuedata->ring, 0, 0, NULL);  // if this fails, the entries are still queued and the next submit will pick them up.
+    }
+    SDL_UnlockMutex(queuedata->sqe_lock);
+}
+
 static void ioring_asyncioqueue_cancel_task(void *userdata, SDL_AsyncIOTask *task)
 {
     if (!task->asyncio || !task->asyncio->userdata) {
@@ -347,7 +383,9 @@ static bool SDL_SYS_CreateAsyncIOQueue_ioring(SDL_AsyncIOQueue *queue)
         ioring_asyncioqueue_get_results,
         ioring_asyncioqueue_wait_results,
         ioring_asyncioqueue_signal,
-        ioring_asyncioqueue_destroy
+        ioring_asyncioqueue_destroy,
+        ioring_asyncioqueue_begin_batch,
+        ioring_asyncioqueue_end_batch
     };
 
     SDL_copyp(&queue->iface, &SDL_AsyncIOQueue_ioring);
@@ -387,7 +425,10 @@ static bool ioring_asyncio_read(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    const HRESULT hr = ioring.BuildIoRingReadFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    HRESULT hr = ioring.BuildIoRingReadFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    if (FAILED(hr) && ioring_flush_batch(queuedata)) {
+        hr = ioring.BuildIoRingReadFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    }
     if (FAILED(hr)) {
         retval = WIN_SetErrorFromHRESULT("BuildIoRingReadFile", hr);
     } else {
@@ -413,7 +454,10 @@ static bool ioring_asyncio_write(void *userdata, SDL_AsyncIOTask *task)
     // have to hold a lock because otherwise two threads could get_sqe and submit while one request isn't fully set up.
     SDL_LockMutex(queuedata->sqe_lock);
     bool retval;
-    const HRESULT hr = ioring.BuildIoRingWriteFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, 0 /*FILE_WRITE_FLAGS_NONE*/, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    HRESULT hr = ioring.BuildIoRingWriteFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, 0 /*FILE_WRITE_FLAGS_NONE*/, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    if (FAILED(hr) && ioring_flush_batch(queuedata)) {
+        hr = ioring.BuildIoRingWriteFile(queuedata->ring, href, bref, (UINT32) task->requested_size, task->offset, 0 /*FILE_WRITE_FLAGS_NONE*/, (UINT_PTR) task, IOSQE_FLAGS_NONE);
+    }
     if (FAILED(hr)) {
         retval = WIN_SetErrorFromHRESULT("BuildIoRingWriteFile", hr);
     } else {
@@ -470,7 +514,17 @@ static bool Win32OpenModeFromString(const char *mode, DWORD *access_mode, DWORD
     return SDL_SetError("Invalid file open mode");
 }
 
-static bool SDL_SYS_AsyncIOFromFile_ioring(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+// FILE_FLAG_NO_BUFFERING needs everything aligned to the volume's sector size.
+static size_t GetUnbufferedAlignment(HANDLE handle)
+{
+    FILE_STORAGE_INFO info;
+    if (GetFileInformationByHandleEx(handle, FileStorageInfo, &info, sizeof (info)) && info.PhysicalBytesPerSectorForPerformance) {
+        return (size_t) SDL_max(info.PhysicalBytesPerSectorForPerformance, info.LogicalBytesPerSector);
+    }
+    return 4096;  // larger than any sector size in common use, so it's always safe.
+}
+
+static bool SDL_SYS_AsyncIOFromFile_ioring(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
     DWORD access_mode, create_mode;
     if (!Win32OpenModeFromString(mode, &access_mode, &create_mode)) {
@@ -482,7 +536,18 @@ static bool SDL_SYS_AsyncIOFromFile_ioring(const char *file, const char *mode, S
         return false;
     }
 
-    HANDLE handle = CreateFileW(wstr, access_mode, FILE_SHARE_READ, NULL, create_mode, FILE_ATTRIBUTE_NORMAL, NULL);
+    // Windows only takes access pattern hints when opening the file, so SDL_AdviseAsyncIO() is a no-op here.
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (options->advice == SDL_ASYNCIO_ADVICE_SEQUENTIAL) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (options->advice == SDL_ASYNCIO_ADVICE_RANDOM) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    if (options->unbuffered) {
+        flags |= FILE_FLAG_NO_BUFFERING;
+    }
+
+    HANDLE handle = CreateFileW(wstr, access_mode, FILE_SHARE_READ, NULL, create_mode, flags, NULL);
     SDL_free(wstr);
     if (!handle) {
         return WIN_SetError("CreateFileW");
@@ -498,6 +563,9 @@ static bool SDL_SYS_AsyncIOFromFile_ioring(const char *file, const char *mode, S
 
     SDL_copyp(&asyncio->iface, &SDL_AsyncIOFile_ioring);
 
+    if (options->unbuffered) {
+        asyncio->alignment = GetUnbufferedAlignment(handle);
+    }
     asyncio->userdata = (void *) handle;
     return true;
 }
@@ -529,10 +597,10 @@ bool SDL_SYS_CreateAsyncIOQueue(SDL_AsyncIOQueue *queue)
     return CreateAsyncIOQueue(queue);
 }
 
-bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, SDL_AsyncIO *asyncio)
+bool SDL_SYS_AsyncIOFromFile(const char *file, const char *mode, const SDL_AsyncIOFileOptions *options, SDL_AsyncIO *asyncio)
 {
     MaybeInitializeWinIoRing();
-    return AsyncIOFromFile(file, mode, asyncio);
+    return AsyncIOFromFile(file, mode, options, asyncio);
 }
 
 void SDL_SYS_QuitAsyncIO(void)
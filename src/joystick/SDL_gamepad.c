@@ -31,6 +31,7 @@
 #include "usb_ids.h"
 #include "hidapi/SDL_hidapi_nintendo.h"
 #include "../events/SDL_events_c.h"
+#include "../sensor/SDL_sensor_c.h"
 
 
 #ifdef SDL_PLATFORM_ANDROID
@@ -82,6 +83,10 @@ typedef struct GamepadMapping_t
     char *name _guarded;
     char *mapping _guarded;
     SDL_GamepadMappingPriority priority _guarded;
+    bool has_crc _guarded;  // true if the mapping string has a CRC field, which is cached in `crc`
+    Uint16 crc _guarded;
+    SDL_GUID index_key _guarded;  // the GUID without its version, which is what s_mappingIndex is keyed on
+    struct GamepadMapping_t *next_match _guarded;  // the next mapping with the same index key, in database order
     struct GamepadMapping_t *next _guarded;
 } GamepadMapping_t;
 
@@ -92,6 +97,7 @@ typedef struct
     GamepadMapping_t **joystick_mappings _guarded;
 
     int num_changed_mappings _guarded;
+    int max_changed_mappings _guarded;
     GamepadMapping_t **changed_mappings _guarded;
 
 } MappingChangeTracker;
@@ -100,6 +106,8 @@ typedef struct
 
 static SDL_GUID s_zeroGUID;
 static GamepadMapping_t *s_pSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pSupportedGamepadsTail SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static SDL_HashTable *s_mappingIndex SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pDefaultMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pXInputMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static MappingChangeTracker *s_mappingChangeTracker SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
@@ -517,12 +525,18 @@ static void AddMappingChangeTracking(GamepadMapping_t *mapping)
     SDL_assert(s_mappingChangeTracker != NULL);
     tracker = s_mappingChangeTracker;
     num_mappings = tracker->num_changed_mappings;
-    new_mappings = (GamepadMapping_t **)SDL_realloc(tracker->changed_mappings, (num_mappings + 1) * sizeof(*new_mappings));
-    if (new_mappings) {
+    if (num_mappings == tracker->max_changed_mappings) {
+        // Grow geometrically, a whole mapping database can be added in one go
+        int max_mappings = SDL_max(16, num_mappings * 2);
+        new_mappings = (GamepadMapping_t **)SDL_realloc(tracker->changed_mappings, max_mappings * sizeof(*new_mappings));
+        if (!new_mappings) {
+            return;
+        }
         tracker->changed_mappings = new_mappings;
-        tracker->changed_mappings[num_mappings] = mapping;
-        tracker->num_changed_mappings = (num_mappings + 1);
+        tracker->max_changed_mappings = max_mappings;
     }
+    tracker->changed_mappings[num_mappings] = mapping;
+    tracker->num_changed_mappings = (num_mappings + 1);
 }
 
 static bool HasMappingChangeTracking(MappingChangeTracker *tracker, GamepadMapping_t *mapping)
@@ -870,12 +884,88 @@ static GamepadMapping_t *SDL_CreateMappingForWGIGamepad(SDL_GUID guid)
     return SDL_PrivateAddMappingForGUID(guid, mapping_string, &existing, SDL_GAMEPAD_MAPPING_PRIORITY_DEFAULT);
 }
 
+static Uint32 SDLCALL SDL_HashMappingKey(void *unused, const void *key)
+{
+    return SDL_murmur3_32(key, sizeof(SDL_GUID), 0);
+}
+
+static bool SDLCALL SDL_KeyMatchMappingKey(void *unused, const void *a, const void *b)
+{
+    return SDL_memcmp(a, b, sizeof(SDL_GUID)) == 0;
+}
+
+/*
+ * Helper function to get the GUID mappings are indexed by, which ignores the version and CRC
+ */
+static SDL_GUID SDL_PrivateGetMappingIndexKey(SDL_GUID guid)
+{
+    SDL_SetJoystickGUIDCRC(&guid, 0);
+    SDL_SetJoystickGUIDVersion(&guid, 0);
+    return guid;
+}
+
+/*
+ * Helper function to cache the CRC field of a mapping string, so matching doesn't have to search for it
+ */
+static void SDL_PrivateUpdateMappingCRC(GamepadMapping_t *mapping)
+{
+    const char *crc_string = SDL_strstr(mapping->mapping, SDL_GAMEPAD_CRC_FIELD);
+    if (crc_string) {
+        mapping->has_crc = true;
+        mapping->crc = (Uint16)SDL_strtol(crc_string + SDL_GAMEPAD_CRC_FIELD_SIZE, NULL, 16);
+    } else {
+        mapping->has_crc = false;
+        mapping->crc = 0;
+    }
+}
+
+/*
+ * Helper function to add a new mapping to the end of the mappings database and its index
+ */
+static bool SDL_PrivateLinkGamepadMapping(GamepadMapping_t *mapping)
+{
+    SDL_AssertJoysticksLocked();
+
+    // Mappings without a GUID are never matched by it, so they don't need to be indexed
+    if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) != 0) {
+        const void *value;
+
+        if (!s_mappingIndex) {
+            s_mappingIndex = SDL_CreateHashTable(0, false, SDL_HashMappingKey, SDL_KeyMatchMappingKey, NULL, NULL);
+            if (!s_mappingIndex) {
+                return false;
+            }
+        }
+
+        mapping->index_key = SDL_PrivateGetMappingIndexKey(mapping->guid);
+        if (SDL_FindInHashTable(s_mappingIndex, &mapping->index_key, &value)) {
+            GamepadMapping_t *match = (GamepadMapping_t *)value;
+            while (match->next_match) {
+                match = match->next_match;
+            }
+            match->next_match = mapping;
+        } else if (!SDL_InsertIntoHashTable(s_mappingIndex, &mapping->index_key, mapping, false)) {
+            return false;
+        }
+    }
+
+    if (s_pSupportedGamepadsTail) {
+        s_pSupportedGamepadsTail->next = mapping;
+    } else {
+        s_pSupportedGamepads = mapping;
+    }
+    s_pSupportedGamepadsTail = mapping;
+    return true;
+}
+
 /*
  * Helper function to scan the mappings database for a gamepad with the specified GUID
  */
 static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_GUID guid, bool match_version, bool exact_match_crc)
 {
     GamepadMapping_t *mapping, *best_match = NULL;
+    SDL_GUID key;
+    const void *value;
     Uint16 crc = 0;
 
     SDL_AssertJoysticksLocked();
@@ -885,40 +975,31 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_GUID guid, bo
     // Clear the CRC from the GUID for matching, the mappings never include it in the GUID
     SDL_SetJoystickGUIDCRC(&guid, 0);
 
-    if (!match_version) {
-        SDL_SetJoystickGUIDVersion(&guid, 0);
+    // Every mapping that could match shares the GUID without its version, so only those need to be checked
+    key = SDL_PrivateGetMappingIndexKey(guid);
+    if (!s_mappingIndex || !SDL_FindInHashTable(s_mappingIndex, &key, &value)) {
+        return NULL;
     }
 
-    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
-        SDL_GUID mapping_guid;
-
-        if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
+    for (mapping = (GamepadMapping_t *)value; mapping; mapping = mapping->next_match) {
+        if (match_version && SDL_memcmp(&guid, &mapping->guid, sizeof(guid)) != 0) {
             continue;
         }
 
-        SDL_memcpy(&mapping_guid, &mapping->guid, sizeof(mapping_guid));
-        if (!match_version) {
-            SDL_SetJoystickGUIDVersion(&mapping_guid, 0);
-        }
-
-        if (SDL_memcmp(&guid, &mapping_guid, sizeof(guid)) == 0) {
-            const char *crc_string = SDL_strstr(mapping->mapping, SDL_GAMEPAD_CRC_FIELD);
-            if (crc_string) {
-                Uint16 mapping_crc = (Uint16)SDL_strtol(crc_string + SDL_GAMEPAD_CRC_FIELD_SIZE, NULL, 16);
-                if (mapping_crc != crc) {
-                    // This mapping specified a CRC and they don't match
-                    continue;
-                }
-
-                // An exact match, including CRC
-                return mapping;
-            } else if (crc && exact_match_crc) {
+        if (mapping->has_crc) {
+            if (mapping->crc != crc) {
+                // This mapping specified a CRC and they don't match
                 continue;
             }
 
-            if (!best_match) {
-                best_match = mapping;
-            }
+            // An exact match, including CRC
+            return mapping;
+        } else if (crc && exact_match_crc) {
+            continue;
+        }
+
+        if (!best_match) {
+            best_match = mapping;
         }
     }
     return best_match;
@@ -1670,6 +1751,7 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_GUID jGUID, const char
             SDL_free(pGamepadMapping->mapping);
             pGamepadMapping->mapping = pchMapping;
             pGamepadMapping->priority = priority;
+            SDL_PrivateUpdateMappingCRC(pGamepadMapping);
         } else {
             SDL_free(pchName);
             SDL_free(pchMapping);
@@ -1679,7 +1761,7 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_GUID jGUID, const char
         }
         AddMappingChangeTracking(pGamepadMapping);
     } else {
-        pGamepadMapping = (GamepadMapping_t *)SDL_malloc(sizeof(*pGamepadMapping));
+        pGamepadMapping = (GamepadMapping_t *)SDL_calloc(1, sizeof(*pGamepadMapping));
         if (!pGamepadMapping) {
             PopMappingChangeTracking();
             SDL_free(pchName);
@@ -1693,21 +1775,16 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_GUID jGUID, const char
         pGamepadMapping->guid = jGUID;
         pGamepadMapping->name = pchName;
         pGamepadMapping->mapping = pchMapping;
-        pGamepadMapping->next = NULL;
         pGamepadMapping->priority = priority;
+        SDL_PrivateUpdateMappingCRC(pGamepadMapping);
 
-        if (s_pSupportedGamepads) {
-            // Add the mapping to the end of the list
-            GamepadMapping_t *pCurrMapping, *pPrevMapping;
-
-            for (pPrevMapping = s_pSupportedGamepads, pCurrMapping = pPrevMapping->next;
-                 pCurrMapping;
-                 pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next) {
-                // continue;
-            }
-            pPrevMapping->next = pGamepadMapping;
-        } else {
-            s_pSupportedGamepads = pGamepadMapping;
+        // Add the mapping to the end of the list
+        if (!SDL_PrivateLinkGamepadMapping(pGamepadMapping)) {
+            PopMappingChangeTracking();
+            SDL_free(pchName);
+            SDL_free(pchMapping);
+            SDL_free(pGamepadMapping);
+            return NULL;
         }
         if (existing) {
             *existing = false;
@@ -2435,7 +2512,7 @@ bool SDL_InitGamepads(void)
     SDL_gamepads_initialized = true;
 
     // Watch for joystick events and fire gamepad ones if needed
-    SDL_AddEventWatch(SDL_GamepadEventWatcher, NULL);
+    SDL_AddEventWatchRange(SDL_EVENT_JOYSTICK_AXIS_MOTION, SDL_EVENT_JOYSTICK_UPDATE_COMPLETE, SDL_GamepadEventWatcher, NULL);
 
     // Send added events for gamepads currently attached
     joysticks = SDL_GetJoysticks(NULL);
@@ -3238,6 +3315,11 @@ bool SDL_SetGamepadSensorEnabled(SDL_Gamepad *gamepad, SDL_SensorType type, bool
                     }
 
                     sensor->enabled = enabled;
+                    if (!enabled && sensor->samples) {
+                        // Don't leave stale samples around for when the sensor is enabled again
+                        SDL_DestroySensorSampleBuffer(sensor->samples);
+                        sensor->samples = NULL;
+                    }
                     SDL_UnlockJoysticks();
                     return true;
                 }
@@ -3328,6 +3410,58 @@ bool SDL_GetGamepadSensorData(SDL_Gamepad *gamepad, SDL_SensorType type, float *
     return SDL_Unsupported();
 }
 
+int SDL_GetGamepadSensorSamples(SDL_Gamepad *gamepad, SDL_SensorType type, float *data, int num_values, Uint64 *timestamps, int max_samples)
+{
+    if (!data) {
+        SDL_InvalidParamError("data");
+        return -1;
+    }
+    if (num_values <= 0) {
+        SDL_InvalidParamError("num_values");
+        return -1;
+    }
+    if (max_samples < 0) {
+        SDL_InvalidParamError("max_samples");
+        return -1;
+    }
+
+    SDL_LockJoysticks();
+    {
+        SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
+        if (joystick) {
+            int i;
+            for (i = 0; i < joystick->nsensors; ++i) {
+                SDL_JoystickSensorInfo *sensor = &joystick->sensors[i];
+
+                if (sensor->type == type) {
+                    int result = 0;
+
+                    if (!sensor->enabled) {
+                        SDL_UnlockJoysticks();
+                        SDL_SetError("Sensor is not enabled");
+                        return -1;
+                    }
+                    if (!sensor->samples) {
+                        // Start collecting samples, they'll be available on the next call
+                        sensor->samples = SDL_CreateSensorSampleBuffer(SDL_arraysize(sensor->data));
+                    }
+                    if (sensor->samples) {
+                        result = SDL_ReadSensorSamples(sensor->samples, data, num_values, timestamps, max_samples);
+                    } else {
+                        result = -1;
+                    }
+                    SDL_UnlockJoysticks();
+                    return result;
+                }
+            }
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    SDL_Unsupported();
+    return -1;
+}
+
 SDL_JoystickID SDL_GetGamepadID(SDL_Gamepad *gamepad)
 {
     SDL_Joystick *joystick = SDL_GetGamepadJoystick(gamepad);
@@ -3757,6 +3891,12 @@ void SDL_QuitGamepadMappings(void)
         SDL_free(pGamepadMap->mapping);
         SDL_free(pGamepadMap);
     }
+    s_pSupportedGamepadsTail = NULL;
+
+    if (s_mappingIndex) {
+        SDL_DestroyHashTable(s_mappingIndex);
+        s_mappingIndex = NULL;
+    }
 
     SDL_FreeVIDPIDList(&SDL_allowed_gamepads);
     SDL_FreeVIDPIDList(&SDL_ignored_gamepads);
@@ -31,6 +31,7 @@
 #include "../events/SDL_events_c.h"
 #include "../video/SDL_sysvideo.h"
 #include "../sensor/SDL_sensor_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
 #include "hidapi/SDL_hidapijoystick_c.h"
 
 // This is included in only one place because it has a large static list of controllers
@@ -124,6 +125,10 @@ static SDL_Joystick *SDL_joysticks SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static int SDL_joystick_player_count SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static SDL_JoystickID *SDL_joystick_players SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static bool SDL_joystick_allows_background_events = false;
+static SDL_Thread *SDL_joystick_update_thread = NULL;
+static SDL_AtomicInt SDL_joystick_update_thread_quit;
+static Uint64 SDL_joystick_update_interval_ns = 0;
+static Uint64 SDL_joystick_activity_ns = 0;
 
 static Uint32 initial_arcadestick_devices[] = {
     MAKE_VIDPID(0x0079, 0x181a), // Venom Arcade Stick
@@ -639,6 +644,51 @@ static void SDLCALL SDL_JoystickAllowBackgroundEventsChanged(void *userdata, con
     }
 }
 
+static int SDLCALL SDL_JoystickUpdateThread(void *data)
+{
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_GetAtomicInt(&SDL_joystick_update_thread_quit)) {
+        SDL_UpdateJoysticks();
+        SDL_DelayPrecise(SDL_joystick_update_interval_ns);
+    }
+    return 0;
+}
+
+static void SDL_StartJoystickUpdateThread(void)
+{
+#if !defined(SDL_PLATFORM_APPLE) && !defined(SDL_PLATFORM_EMSCRIPTEN) && !defined(SDL_PLATFORM_ANDROID)
+    const char *hint = SDL_GetHint(SDL_HINT_JOYSTICK_UPDATE_THREAD_RATE);
+    const int rate = hint ? SDL_atoi(hint) : 0;
+    if (rate <= 0) {
+        return;
+    }
+
+    SDL_joystick_update_interval_ns = SDL_NS_PER_SECOND / SDL_min(rate, 8000);
+    SDL_SetAtomicInt(&SDL_joystick_update_thread_quit, 0);
+    SDL_joystick_update_thread = SDL_CreateThread(SDL_JoystickUpdateThread, "SDLJoystickUpdate", NULL);
+#endif
+}
+
+static void SDL_StopJoystickUpdateThread(void)
+{
+    if (SDL_joystick_update_thread) {
+        SDL_SetAtomicInt(&SDL_joystick_update_thread_quit, 1);
+        SDL_WaitThread(SDL_joystick_update_thread, NULL);
+        SDL_joystick_update_thread = NULL;
+    }
+}
+
+Uint64 SDL_GetJoystickActivityTime(void)
+{
+    return SDL_joystick_activity_ns;
+}
+
+bool SDL_JoystickUpdateThreadActive(void)
+{
+    return (SDL_joystick_update_thread != NULL);
+}
+
 bool SDL_InitJoysticks(void)
 {
     int i;
@@ -683,6 +733,8 @@ bool SDL_InitJoysticks(void)
 
     if (!result) {
         SDL_QuitJoysticks();
+    } else {
+        SDL_StartJoystickUpdateThread();
     }
 
     return result;
@@ -1419,6 +1471,30 @@ bool SDL_SendJoystickVirtualSensorData(SDL_Joystick *joystick, SDL_SensorType ty
     return result;
 }
 
+bool SDL_SetJoystickVirtualState(SDL_Joystick *joystick, const SDL_VirtualJoystickState *state)
+{
+    bool result;
+
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+
+    SDL_LockJoysticks();
+    {
+        CHECK_JOYSTICK_MAGIC(joystick, false);
+        CHECK_JOYSTICK_VIRTUAL(joystick, false);
+
+#ifdef SDL_JOYSTICK_VIRTUAL
+        result = SDL_SetJoystickVirtualStateInner(joystick, state);
+#else
+        result = SDL_SetError("SDL not built with virtual-joystick support");
+#endif
+    }
+    SDL_UnlockJoysticks();
+
+    return result;
+}
+
 /*
  * Checks to make sure the joystick is valid.
  */
@@ -2001,6 +2077,9 @@ void SDL_CloseJoystick(SDL_Joystick *joystick)
             SDL_free(touchpad->fingers);
         }
         SDL_free(joystick->touchpads);
+        for (i = 0; i < joystick->nsensors; i++) {
+            SDL_DestroySensorSampleBuffer(joystick->sensors[i].samples);
+        }
         SDL_free(joystick->sensors);
         SDL_free(joystick);
     }
@@ -2012,6 +2091,9 @@ void SDL_QuitJoysticks(void)
     int i;
     SDL_JoystickID *joysticks;
 
+    // This must be done before locking, since the update thread takes the joystick lock
+    SDL_StopJoystickUpdateThread();
+
     SDL_LockJoysticks();
 
     SDL_joysticks_quitting = true;
@@ -2494,7 +2576,7 @@ static void SendSteamHandleUpdateEvents(void)
     }
 }
 
-void SDL_UpdateJoysticks(void)
+static void SDL_UpdateJoysticksInternal(void)
 {
     int i;
     Uint64 now;
@@ -2522,6 +2604,11 @@ void SDL_UpdateJoysticks(void)
 
         joystick->driver->Update(joystick);
 
+        // update_complete is the timestamp of the last state change, if any
+        if (joystick->update_complete > SDL_joystick_activity_ns) {
+            SDL_joystick_activity_ns = joystick->update_complete;
+        }
+
         if (joystick->delayed_guide_button) {
             SDL_GamepadHandleDelayedGuideButton(joystick);
         }
@@ -2579,6 +2666,13 @@ void SDL_UpdateJoysticks(void)
     SDL_UnlockJoysticks();
 }
 
+void SDL_UpdateJoysticks(void)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_JOYSTICK);
+    SDL_UpdateJoysticksInternal();
+    SDL_PopMemoryTag(memory_tag);
+}
+
 static const Uint32 SDL_joystick_event_list[] = {
     SDL_EVENT_JOYSTICK_AXIS_MOTION,
     SDL_EVENT_JOYSTICK_BALL_MOTION,
@@ -3613,6 +3707,10 @@ void SDL_SendJoystickSensor(Uint64 timestamp, SDL_Joystick *joystick, SDL_Sensor
                 SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
                 joystick->update_complete = timestamp;
 
+                if (sensor->samples) {
+                    SDL_AddSensorSample(sensor->samples, sensor_timestamp, data, num_values);
+                }
+
                 // Post the event, if desired
                 if (SDL_EventEnabled(SDL_EVENT_GAMEPAD_SENSOR_UPDATE)) {
                     SDL_Event event;
@@ -44,6 +44,12 @@ extern bool SDL_JoysticksInitialized(void);
 // Return whether the joystick system is shutting down
 extern bool SDL_JoysticksQuitting(void);
 
+// Return the time of the most recent joystick state change, in nanoseconds
+extern Uint64 SDL_GetJoystickActivityTime(void);
+
+// Return whether joysticks are being updated from a background thread
+extern bool SDL_JoystickUpdateThreadActive(void);
+
 // Return whether the joysticks are currently locked
 extern bool SDL_JoysticksLocked(void);
 
@@ -70,6 +70,7 @@ typedef struct SDL_JoystickSensorInfo
     bool enabled;
     float rate;
     float data[3]; // If this needs to expand, update SDL_GamepadSensorEvent
+    struct SDL_SensorSampleBuffer *samples; // Recent samples, created by SDL_GetGamepadSensorSamples()
 } SDL_JoystickSensorInfo;
 
 #define _guarded SDL_GUARDED_BY(SDL_joystick_lock)
@@ -361,7 +361,7 @@ static bool HIDAPI_DriverLuna_UpdateDevice(SDL_HIDAPI_Device *device)
         return false;
     }
 
-    while ((size = SDL_hid_read_timeout(device->dev, data, sizeof(data), 0)) > 0) {
+    while ((size = HIDAPI_ReadReport(device, data, sizeof(data))) > 0) {
 #ifdef DEBUG_LUNA_PROTOCOL
         HIDAPI_DumpPacket("Amazon Luna packet: size = %d", data, size);
 #endif
@@ -1035,9 +1035,6 @@ static bool HIDAPI_DriverPS5_InternalSendJoystickEffect(SDL_DriverPS5_Context *c
 {
     Uint8 data[78];
     int report_size, offset;
-    Uint8 *pending_data;
-    int *pending_size;
-    int maximum_size;
 
     if (!ctx->effects_supported) {
         // We shouldn't be sending packets to this controller
@@ -1088,18 +1085,11 @@ static bool HIDAPI_DriverPS5_InternalSendJoystickEffect(SDL_DriverPS5_Context *c
         return false;
     }
 
-    // See if we can update an existing pending request
-    if (SDL_HIDAPI_GetPendingRumbleLocked(ctx->device, &pending_data, &pending_size, &maximum_size)) {
-        DS5EffectsState_t *effects = (DS5EffectsState_t *)&data[offset];
-        DS5EffectsState_t *pending_effects = (DS5EffectsState_t *)&pending_data[offset];
-        if (report_size == *pending_size &&
-            effects->ucEnableBits1 == pending_effects->ucEnableBits1 &&
-            effects->ucEnableBits2 == pending_effects->ucEnableBits2) {
-            // We're simply updating the data for this request
-            SDL_memcpy(pending_data, data, report_size);
-            SDL_HIDAPI_UnlockRumble();
-            return true;
-        }
+    // See if we can update an existing pending request with the same enable bits
+    if (SDL_HIDAPI_CoalesceRumbleLocked(ctx->device, data, report_size, offset, 2)) {
+        // We're simply updating the data for this request
+        SDL_HIDAPI_UnlockRumble();
+        return true;
     }
 
     if (SDL_HIDAPI_SendRumbleAndUnlock(ctx->device, data, report_size) != report_size) {
@@ -1504,7 +1494,7 @@ static bool HIDAPI_DriverPS5_UpdateDevice(SDL_HIDAPI_Device *device)
         joystick = SDL_GetJoystickFromID(device->joysticks[0]);
     }
 
-    while ((size = SDL_hid_read_timeout(device->dev, data, sizeof(data), 0)) > 0) {
+    while ((size = HIDAPI_ReadReport(device, data, sizeof(data))) > 0) {
         Uint64 timestamp = SDL_GetTicksNS();
 
 #ifdef DEBUG_PS5_PROTOCOL
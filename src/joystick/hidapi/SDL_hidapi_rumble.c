@@ -47,6 +47,7 @@ typedef struct SDL_HIDAPI_RumbleContext
     SDL_Semaphore *request_sem;
     SDL_HIDAPI_RumbleRequest *requests_head;
     SDL_HIDAPI_RumbleRequest *requests_tail;
+    SDL_HIDAPI_RumbleStats stats;
 } SDL_HIDAPI_RumbleContext;
 
 #ifndef SDL_THREAD_SAFETY_ANALYSIS
@@ -73,6 +74,8 @@ static int SDLCALL SDL_HIDAPI_RumbleThread(void *data)
                 ctx->requests_head = NULL;
             }
             ctx->requests_tail = request->prev;
+            --ctx->stats.depth;
+            ++ctx->stats.sent;
         }
         SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 
@@ -119,6 +122,7 @@ static void SDL_HIDAPI_StopRumbleThread(SDL_HIDAPI_RumbleContext *ctx)
             ctx->requests_head = NULL;
         }
         ctx->requests_tail = request->prev;
+        --ctx->stats.depth;
 
         if (request->callback) {
             request->callback(request->userdata);
@@ -126,6 +130,11 @@ static void SDL_HIDAPI_StopRumbleThread(SDL_HIDAPI_RumbleContext *ctx)
         (void)SDL_AtomicDecRef(&request->device->rumble_pending);
         SDL_free(request);
     }
+#ifdef DEBUG_RUMBLE
+    SDL_Log("Rumble queue: %" SDL_PRIu64 " queued, %" SDL_PRIu64 " coalesced, %" SDL_PRIu64 " sent, max depth %d",
+            ctx->stats.queued, ctx->stats.coalesced, ctx->stats.sent, ctx->stats.max_depth);
+#endif
+    SDL_zero(ctx->stats);
     SDL_UnlockMutex(SDL_HIDAPI_rumble_lock);
 
     if (ctx->request_sem) {
@@ -198,6 +207,51 @@ bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **data,
     return false;
 }
 
+bool SDL_HIDAPI_CoalesceRumbleLocked(SDL_HIDAPI_Device *device, const Uint8 *data, int size, int offset, int length)
+{
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+    SDL_HIDAPI_RumbleRequest *request, *found;
+
+    if (offset < 0 || length < 0 || offset + length > size) {
+        return false;
+    }
+
+    /* Look for the newest pending request of the same type for this device.
+     * Requests of other types may be queued after it, but since they target
+     * independent state on the controller it's safe to update this one in place,
+     * which means the latest data goes out as soon as possible and the stale
+     * packet is never written.
+     *
+     * Requests with a callback are left alone, the caller is tracking them.
+     */
+    found = NULL;
+    for (request = ctx->requests_tail; request; request = request->prev) {
+        if (request->device == device && !request->callback &&
+            request->size == size &&
+            SDL_memcmp(&request->data[offset], &data[offset], length) == 0) {
+            found = request;
+        }
+    }
+    if (found) {
+        SDL_memcpy(found->data, data, size);
+        ++ctx->stats.coalesced;
+        return true;
+    }
+    return false;
+}
+
+void SDL_HIDAPI_GetRumbleStats(SDL_HIDAPI_RumbleStats *stats)
+{
+    SDL_HIDAPI_RumbleContext *ctx = &rumble_context;
+
+    if (SDL_HIDAPI_LockRumble()) {
+        SDL_copyp(stats, &ctx->stats);
+        SDL_HIDAPI_UnlockRumble();
+    } else {
+        SDL_zerop(stats);
+    }
+}
+
 int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
 {
     return SDL_HIDAPI_SendRumbleWithCallbackAndUnlock(device, data, size, NULL, NULL);
@@ -234,6 +288,12 @@ int SDL_HIDAPI_SendRumbleWithCallbackAndUnlock(SDL_HIDAPI_Device *device, const
     }
     ctx->requests_head = request;
 
+    ++ctx->stats.queued;
+    ++ctx->stats.depth;
+    if (ctx->stats.depth > ctx->stats.max_depth) {
+        ctx->stats.max_depth = ctx->stats.depth;
+    }
+
     // Make sure we unlock before posting the semaphore so the rumble thread can run immediately
     SDL_HIDAPI_UnlockRumble();
 
@@ -249,10 +309,6 @@ void SDL_HIDAPI_UnlockRumble(void)
 
 int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size)
 {
-    Uint8 *pending_data;
-    int *pending_size;
-    int maximum_size;
-
     if (size <= 0) {
         SDL_SetError("Tried to send rumble with invalid size");
         return -1;
@@ -262,10 +318,8 @@ int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size
         return -1;
     }
 
-    // check if there is a pending request for the device and update it
-    if (SDL_HIDAPI_GetPendingRumbleLocked(device, &pending_data, &pending_size, &maximum_size) &&
-        size == *pending_size && data[0] == pending_data[0]) {
-        SDL_memcpy(pending_data, data, size);
+    // check if there is a pending request with the same report ID for the device and update it
+    if (SDL_HIDAPI_CoalesceRumbleLocked(device, data, size, 0, 1)) {
         SDL_HIDAPI_UnlockRumble();
         return size;
     }
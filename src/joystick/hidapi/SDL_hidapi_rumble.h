@@ -24,12 +24,23 @@
 
 // Handle rumble on a separate thread so it doesn't block the application
 
+typedef struct SDL_HIDAPI_RumbleStats
+{
+    Uint64 queued;      // requests added to the queue
+    Uint64 coalesced;   // requests merged into an already pending request
+    Uint64 sent;        // requests taken off the queue by the rumble thread
+    int depth;          // requests currently waiting
+    int max_depth;      // the most requests that have been waiting at once
+} SDL_HIDAPI_RumbleStats;
+
 // Advanced API
 #ifdef SDL_THREAD_SAFETY_ANALYSIS
 extern SDL_Mutex *SDL_HIDAPI_rumble_lock;
 #endif
 bool SDL_HIDAPI_LockRumble(void) SDL_TRY_ACQUIRE(0, SDL_HIDAPI_rumble_lock);
 bool SDL_HIDAPI_GetPendingRumbleLocked(SDL_HIDAPI_Device *device, Uint8 **data, int **size, int *maximum_size);
+// Replace the newest pending request for the device that has the same size and the same bytes at [offset, offset+length), returns false if there isn't one
+bool SDL_HIDAPI_CoalesceRumbleLocked(SDL_HIDAPI_Device *device, const Uint8 *data, int size, int offset, int length);
 int SDL_HIDAPI_SendRumbleAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data, int size) SDL_RELEASE(SDL_HIDAPI_rumble_lock);
 typedef void (*SDL_HIDAPI_RumbleSentCallback)(void *userdata);
 int SDL_HIDAPI_SendRumbleWithCallbackAndUnlock(SDL_HIDAPI_Device *device, const Uint8 *data, int size, SDL_HIDAPI_RumbleSentCallback callback, void *userdata) SDL_RELEASE(SDL_HIDAPI_rumble_lock);
@@ -37,6 +48,7 @@ void SDL_HIDAPI_UnlockRumble(void) SDL_RELEASE(SDL_HIDAPI_rumble_lock);
 
 // Simple API, will replace any pending rumble with the new data
 int SDL_HIDAPI_SendRumble(SDL_HIDAPI_Device *device, const Uint8 *data, int size);
+void SDL_HIDAPI_GetRumbleStats(SDL_HIDAPI_RumbleStats *stats);
 void SDL_HIDAPI_QuitRumble(void);
 
 #endif // SDL_JOYSTICK_HIDAPI
@@ -362,7 +362,7 @@ static bool HIDAPI_DriverSteamHori_UpdateDevice(SDL_HIDAPI_Device *device)
         return false;
     }
 
-    while ((size = SDL_hid_read_timeout(device->dev, data, sizeof(data), 0)) > 0) {
+    while ((size = HIDAPI_ReadReport(device, data, sizeof(data))) > 0) {
 #ifdef DEBUG_HORI_PROTOCOL
         HIDAPI_DumpPacket("Google Hori packet: size = %d", data, size);
 #endif
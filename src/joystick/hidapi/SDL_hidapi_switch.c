@@ -358,7 +358,7 @@ static int ReadInput(SDL_DriverSwitch_Context *ctx)
         return 0;
     }
 
-    result = SDL_hid_read_timeout(ctx->device->dev, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer), 0);
+    result = HIDAPI_ReadReport(ctx->device, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer));
 
     // See if we can guess the initial input mode
     if (result > 0 && !ctx->m_bInputOnly && !ctx->m_nInitialInputMode) {
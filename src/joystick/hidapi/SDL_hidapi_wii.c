@@ -198,7 +198,7 @@ static int ReadInput(SDL_DriverWii_Context *ctx)
         return 0;
     }
 
-    size = SDL_hid_read_timeout(ctx->device->dev, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer), 0);
+    size = HIDAPI_ReadReport(ctx->device, ctx->m_rgucReadBuffer, sizeof(ctx->m_rgucReadBuffer));
 #ifdef DEBUG_WII_PROTOCOL
     if (size > 0) {
         HIDAPI_DumpPacket("Wii packet: size = %d", ctx->m_rgucReadBuffer, size);
@@ -26,6 +26,9 @@
 #include "SDL_hidapijoystick_c.h"
 #include "SDL_hidapi_rumble.h"
 #include "../../SDL_hints_c.h"
+#include "../../SDL_trace_c.h"
+#include "../../stdlib/SDL_sysstdlib.h"
+#include "../../hidapi/SDL_hidapi_c.h"
 
 #if defined(SDL_PLATFORM_WIN32) || defined(SDL_PLATFORM_WINGDK)
 #include "../windows/SDL_rawinputjoystick_c.h"
@@ -90,6 +93,9 @@ static int SDL_HIDAPI_numdrivers = 0;
 static SDL_AtomicInt SDL_HIDAPI_updating_devices;
 static bool SDL_HIDAPI_hints_changed = false;
 static Uint32 SDL_HIDAPI_change_count = 0;
+static SDL_Thread *SDL_HIDAPI_scan_thread = NULL;
+static SDL_AtomicInt SDL_HIDAPI_scan_complete;
+static struct SDL_hid_device_info *SDL_HIDAPI_scan_devices = NULL;
 static SDL_HIDAPI_Device *SDL_HIDAPI_devices SDL_GUARDED_BY(SDL_joystick_lock);
 static int SDL_HIDAPI_numjoysticks = 0;
 static bool SDL_HIDAPI_combine_joycons = true;
@@ -137,6 +143,134 @@ void HIDAPI_DumpPacket(const char *prefix, const Uint8 *data, int size)
     SDL_free(buffer);
 }
 
+static int SDLCALL HIDAPI_ReaderThread(void *data)
+{
+    SDL_HIDAPI_ReportReader *reader = (SDL_HIDAPI_ReportReader *)data;
+
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (SDL_GetAtomicInt(&reader->running)) {
+        const Uint32 head = SDL_GetAtomicU32(&reader->head);
+        const Uint32 slot = (head & (HIDAPI_REPORT_RING_SIZE - 1));
+        int size;
+
+        // Some drivers can't read while a write is happening, and if the ring is full there's nowhere to put a report
+        if (SDL_GetAtomicInt(reader->rumble_pending) > 0 ||
+            (head - SDL_GetAtomicU32(&reader->tail)) == HIDAPI_REPORT_RING_SIZE) {
+            SDL_Delay(1);
+            continue;
+        }
+
+        // Wake up now and then to see if we've been stopped
+        size = SDL_hid_read_timeout(reader->dev, reader->data[slot], sizeof(reader->data[slot]), 50);
+        if (size < 0) {
+            SDL_SetAtomicInt(&reader->failed, 1);
+            break;
+        }
+        if (size > 0) {
+            reader->lengths[slot] = size;
+            SDL_SetAtomicU32(&reader->head, head + 1);
+        }
+    }
+    return 0;
+}
+
+static SDL_HIDAPI_ReportReader *HIDAPI_StartReaderThread(SDL_HIDAPI_Device *device)
+{
+    SDL_HIDAPI_ReportReader *reader = (SDL_HIDAPI_ReportReader *)SDL_calloc(1, sizeof(*reader));
+    if (!reader) {
+        return NULL;
+    }
+    reader->dev = device->dev;
+    reader->rumble_pending = &device->rumble_pending;
+    SDL_SetAtomicInt(&reader->running, 1);
+
+    reader->thread = SDL_CreateThread(HIDAPI_ReaderThread, "HIDAPI Reader", reader);
+    if (!reader->thread) {
+        SDL_free(reader);
+        return NULL;
+    }
+    return reader;
+}
+
+static void HIDAPI_StopReaderThread(SDL_HIDAPI_Device *device)
+{
+    SDL_HIDAPI_ReportReader *reader = device->reader;
+
+    if (reader) {
+        SDL_SetAtomicInt(&reader->running, 0);
+        SDL_WaitThread(reader->thread, NULL);
+        SDL_free(reader);
+        device->reader = NULL;
+    }
+    device->reader_checked = false;
+
+    SDL_free(device->reports);
+    device->reports = NULL;
+}
+
+static int HIDAPI_ReadQueuedReport(SDL_HIDAPI_ReportReader *reader, Uint8 *data, size_t size)
+{
+    const Uint32 tail = SDL_GetAtomicU32(&reader->tail);
+    const Uint32 slot = (tail & (HIDAPI_REPORT_RING_SIZE - 1));
+    int length;
+
+    if (tail == SDL_GetAtomicU32(&reader->head)) {
+        // Report a read error once everything that came before it has been handled
+        return SDL_GetAtomicInt(&reader->failed) ? -1 : 0;
+    }
+
+    length = SDL_min(reader->lengths[slot], (int)size);
+    SDL_memcpy(data, reader->data[slot], length);
+    SDL_SetAtomicU32(&reader->tail, tail + 1);
+    return length;
+}
+
+int HIDAPI_ReadReport(SDL_HIDAPI_Device *device, Uint8 *data, size_t size)
+{
+    SDL_HIDAPI_ReportBatch *batch = device->reports;
+    int length;
+
+    if (size > HIDAPI_MAX_BATCHED_REPORT_SIZE) {
+        return SDL_hid_read_timeout(device->dev, data, size, 0);
+    }
+
+    /* Reader threads start the first time a driver reads a report this way,
+       so drivers that read the device by other means are never raced. */
+    if (!device->reader_checked) {
+        device->reader_checked = true;
+        if (SDL_GetHintBoolean(SDL_HINT_JOYSTICK_HIDAPI_THREADS, false)) {
+            device->reader = HIDAPI_StartReaderThread(device);
+        }
+    }
+    if (device->reader) {
+        return HIDAPI_ReadQueuedReport(device->reader, data, size);
+    }
+
+    if (!batch) {
+        batch = (SDL_HIDAPI_ReportBatch *)SDL_calloc(1, sizeof(*batch));
+        if (!batch) {
+            return SDL_hid_read_timeout(device->dev, data, size, 0);
+        }
+        device->reports = batch;
+    }
+
+    if (batch->next == batch->count) {
+        int count = SDL_hid_read_reports(device->dev, batch->data[0], sizeof(batch->data[0]), batch->lengths, SDL_arraysize(batch->lengths));
+        batch->next = 0;
+        if (count <= 0) {
+            batch->count = 0;
+            return count;
+        }
+        batch->count = count;
+    }
+
+    length = SDL_min(batch->lengths[batch->next], (int)size);
+    SDL_memcpy(data, batch->data[batch->next], length);
+    ++batch->next;
+    return length;
+}
+
 bool HIDAPI_SupportsPlaystationDetection(Uint16 vendor, Uint16 product)
 {
     /* If we already know the controller is a different type, don't try to detect it.
@@ -410,6 +544,7 @@ static void HIDAPI_CleanupDeviceDriver(SDL_HIDAPI_Device *device)
 
     SDL_LockMutex(device->dev_lock);
     {
+        HIDAPI_StopReaderThread(device);
         if (device->dev) {
             SDL_hid_close(device->dev);
             device->dev = NULL;
@@ -482,6 +617,7 @@ static void HIDAPI_SetupDeviceDriver(SDL_HIDAPI_Device *device, bool *removed) S
 
         if (!device->driver && device->dev) {
             // No driver claimed this device, go ahead and close it
+            HIDAPI_StopReaderThread(device);
             SDL_hid_close(device->dev);
             device->dev = NULL;
         }
@@ -525,6 +661,29 @@ static void SDLCALL SDL_HIDAPIDriverHintChanged(void *userdata, const char *name
     SDL_HIDAPI_change_count = 0;
 }
 
+static int SDLCALL HIDAPI_ScanThread(void *data)
+{
+    SDL_TRACE_BEGIN("HIDAPI_ScanThread");
+    SDL_HIDAPI_scan_devices = SDL_hid_enumerate(0, 0);
+    SDL_SetAtomicInt(&SDL_HIDAPI_scan_complete, true);
+    SDL_TRACE_END("HIDAPI_ScanThread");
+    return 0;
+}
+
+// Returns the devices found by the background scan started in HIDAPI_JoystickInit(), waiting for it if needed
+static struct SDL_hid_device_info *HIDAPI_FinishDeviceScan(void)
+{
+    struct SDL_hid_device_info *devs = NULL;
+
+    if (SDL_HIDAPI_scan_thread) {
+        SDL_WaitThread(SDL_HIDAPI_scan_thread, NULL);
+        SDL_HIDAPI_scan_thread = NULL;
+        devs = SDL_HIDAPI_scan_devices;
+        SDL_HIDAPI_scan_devices = NULL;
+    }
+    return devs;
+}
+
 static bool HIDAPI_JoystickInit(void)
 {
     int i;
@@ -547,8 +706,15 @@ static bool HIDAPI_JoystickInit(void)
                         SDL_HIDAPIDriverHintChanged, NULL);
 
     SDL_HIDAPI_change_count = SDL_hid_device_change_count();
-    HIDAPI_UpdateDeviceList();
-    HIDAPI_UpdateDevices();
+    if (SDL_GetHintBoolean(SDL_HINT_DEFERRED_INIT, false)) {
+        // Enumerating HID devices can be slow, so do that in the background and add them like hotplugged devices
+        SDL_SetAtomicInt(&SDL_HIDAPI_scan_complete, false);
+        SDL_HIDAPI_scan_thread = SDL_CreateThread(HIDAPI_ScanThread, "SDLHIDAPIScan", NULL);
+    }
+    if (!SDL_HIDAPI_scan_thread) {
+        HIDAPI_UpdateDeviceList();
+        HIDAPI_UpdateDevices();
+    }
 
     initialized = true;
 
@@ -987,6 +1153,7 @@ static void HIDAPI_DelDevice(SDL_HIDAPI_Device *device)
             SDL_free(device->name);
             SDL_free(device->path);
             SDL_free(device->children);
+            HIDAPI_StopReaderThread(device);
             SDL_free(device);
             return;
         }
@@ -1094,9 +1261,12 @@ static void HIDAPI_UpdateDeviceList(void)
         device->seen = false;
     }
 
-    // Enumerate the devices
+    // Enumerate the devices, unless the initial scan already did that in the background
+    devs = HIDAPI_FinishDeviceScan();
     if (SDL_HIDAPI_numdrivers > 0) {
-        devs = SDL_hid_enumerate(0, 0);
+        if (!devs) {
+            devs = SDL_hid_enumerate(0, 0);
+        }
         if (devs) {
             for (info = devs; info; info = info->next) {
                 device = HIDAPI_GetJoystickByInfo(info->path, info->vendor_id, info->product_id);
@@ -1111,9 +1281,11 @@ static void HIDAPI_UpdateDeviceList(void)
                     HIDAPI_AddDevice(info, 0, NULL);
                 }
             }
-            SDL_hid_free_enumeration(devs);
         }
     }
+    if (devs) {
+        SDL_hid_free_enumeration(devs);
+    }
 
     // Remove any devices that weren't seen or have been disconnected due to read errors
 check_removed:
@@ -1362,9 +1534,14 @@ SDL_GamepadType HIDAPI_GetGamepadTypeFromGUID(SDL_GUID guid)
 
 static void HIDAPI_JoystickDetect(void)
 {
+    if (SDL_HIDAPI_scan_thread && !SDL_GetAtomicInt(&SDL_HIDAPI_scan_complete)) {
+        // Still scanning for the devices that were connected at startup
+        return;
+    }
+
     if (HIDAPI_StartUpdatingDevices()) {
         Uint32 count = SDL_hid_device_change_count();
-        if (SDL_HIDAPI_change_count != count) {
+        if (SDL_HIDAPI_change_count != count || SDL_HIDAPI_scan_thread) {
             SDL_HIDAPI_change_count = count;
             HIDAPI_UpdateDeviceList();
         }
@@ -1372,7 +1549,7 @@ static void HIDAPI_JoystickDetect(void)
     }
 }
 
-void HIDAPI_UpdateDevices(void)
+static void HIDAPI_UpdateDevicesInternal(void)
 {
     SDL_HIDAPI_Device *device;
 
@@ -1399,6 +1576,13 @@ void HIDAPI_UpdateDevices(void)
     }
 }
 
+void HIDAPI_UpdateDevices(void)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_HIDAPI);
+    HIDAPI_UpdateDevicesInternal();
+    SDL_PopMemoryTag(memory_tag);
+}
+
 static const char *HIDAPI_JoystickGetDeviceName(int device_index)
 {
     SDL_HIDAPI_Device *device;
@@ -1661,12 +1845,18 @@ static void HIDAPI_JoystickClose(SDL_Joystick *joystick) SDL_NO_THREAD_SAFETY_AN
 
 static void HIDAPI_JoystickQuit(void)
 {
+    struct SDL_hid_device_info *devs;
     int i;
 
     SDL_AssertJoysticksLocked();
 
     shutting_down = true;
 
+    devs = HIDAPI_FinishDeviceScan();
+    if (devs) {
+        SDL_hid_free_enumeration(devs);
+    }
+
     SDL_HIDAPI_QuitRumble();
 
     while (SDL_HIDAPI_devices) {
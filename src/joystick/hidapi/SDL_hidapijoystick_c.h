@@ -65,6 +65,34 @@
 // Forward declaration
 struct SDL_HIDAPI_DeviceDriver;
 
+// Input reports read in one go by HIDAPI_ReadReport(), and handed out one at a time
+#define HIDAPI_REPORT_BATCH_SIZE        16
+#define HIDAPI_MAX_BATCHED_REPORT_SIZE  128
+
+typedef struct SDL_HIDAPI_ReportBatch
+{
+    int count;
+    int next;
+    int lengths[HIDAPI_REPORT_BATCH_SIZE];
+    Uint8 data[HIDAPI_REPORT_BATCH_SIZE][HIDAPI_MAX_BATCHED_REPORT_SIZE];
+} SDL_HIDAPI_ReportBatch;
+
+// With SDL_HINT_JOYSTICK_HIDAPI_THREADS, a thread reads input reports into this ring, which HIDAPI_ReadReport() empties
+#define HIDAPI_REPORT_RING_SIZE 64  // must be a power of two
+
+typedef struct SDL_HIDAPI_ReportReader
+{
+    SDL_hid_device *dev;
+    SDL_AtomicInt *rumble_pending;
+    SDL_Thread *thread;
+    SDL_AtomicInt running;
+    SDL_AtomicInt failed;
+    SDL_AtomicU32 head;  // only written by the reader thread
+    SDL_AtomicU32 tail;  // only written by HIDAPI_ReadReport()
+    int lengths[HIDAPI_REPORT_RING_SIZE];
+    Uint8 data[HIDAPI_REPORT_RING_SIZE][HIDAPI_MAX_BATCHED_REPORT_SIZE];
+} SDL_HIDAPI_ReportReader;
+
 typedef struct SDL_HIDAPI_Device
 {
     char *name;
@@ -91,6 +119,9 @@ typedef struct SDL_HIDAPI_Device
     void *context;
     SDL_Mutex *dev_lock;
     SDL_hid_device *dev;
+    SDL_HIDAPI_ReportBatch *reports;
+    SDL_HIDAPI_ReportReader *reader;
+    bool reader_checked;
     SDL_AtomicInt rumble_pending;
     int num_joysticks;
     SDL_JoystickID *joysticks;
@@ -188,6 +219,9 @@ extern void HIDAPI_UpdateDeviceProperties(SDL_HIDAPI_Device *device);
 
 extern void HIDAPI_DumpPacket(const char *prefix, const Uint8 *data, int size);
 
+// Read the next input report without waiting, like SDL_hid_read_timeout(device->dev, data, size, 0), but draining the OS queue in batches
+extern int HIDAPI_ReadReport(SDL_HIDAPI_Device *device, Uint8 *data, size_t size);
+
 extern bool HIDAPI_SupportsPlaystationDetection(Uint16 vendor, Uint16 product);
 
 extern float HIDAPI_RemapVal(float val, float val_min, float val_max, float output_min, float output_max);
@@ -170,11 +170,23 @@ typedef struct SDL_sensorlist_item
     struct SDL_sensorlist_item *next;
 } SDL_sensorlist_item;
 
+// A cache of device class probes, so we don't reopen devices we've already looked at
+typedef struct SDL_classcache_item
+{
+    char *path;
+    dev_t devnum;
+    ino_t ino;
+    time_t ctime; // changes when the node is recreated or its permissions change
+    int device_class;
+    struct SDL_classcache_item *next;
+} SDL_classcache_item;
+
 static bool SDL_classic_joysticks = false;
 static SDL_joylist_item *SDL_joylist SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static SDL_joylist_item *SDL_joylist_tail SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static int numjoysticks SDL_GUARDED_BY(SDL_joystick_lock) = 0;
 static SDL_sensorlist_item *SDL_sensorlist SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static SDL_classcache_item *SDL_classcache SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static int inotify_fd = -1;
 
 static Uint64 last_joy_detect_time;
@@ -258,23 +270,98 @@ static int GuessDeviceClass(int fd)
     return SDL_EVDEV_GuessDeviceClass(propbit, evbit, absbit, keybit, relbit);
 }
 
-static bool GuessIsJoystick(int fd)
+static SDL_classcache_item *GetClassCacheItem(const char *path)
 {
-    if (GuessDeviceClass(fd) & SDL_UDEV_DEVICE_JOYSTICK) {
-        return true;
+    SDL_classcache_item *item;
+
+    SDL_AssertJoysticksLocked();
+
+    for (item = SDL_classcache; item; item = item->next) {
+        if (SDL_strcmp(path, item->path) == 0) {
+            return item;
+        }
     }
-    return false;
+    return NULL;
 }
 
-static bool GuessIsSensor(int fd)
+static bool GetCachedDeviceClass(const char *path, const struct stat *sb, int *device_class)
 {
-    if (GuessDeviceClass(fd) & SDL_UDEV_DEVICE_ACCELEROMETER) {
+    SDL_classcache_item *item = GetClassCacheItem(path);
+
+    if (item && item->devnum == sb->st_rdev && item->ino == sb->st_ino && item->ctime == sb->st_ctime) {
+        *device_class = item->device_class;
         return true;
     }
     return false;
 }
 
-static bool IsJoystick(const char *path, int *fd, char **name_return, Uint16 *vendor_return, Uint16 *product_return, SDL_GUID *guid)
+static void CacheDeviceClass(const char *path, const struct stat *sb, int device_class)
+{
+    SDL_classcache_item *item = GetClassCacheItem(path);
+
+    if (!item) {
+        item = (SDL_classcache_item *)SDL_calloc(1, sizeof(*item));
+        if (!item) {
+            return;
+        }
+        item->path = SDL_strdup(path);
+        if (!item->path) {
+            SDL_free(item);
+            return;
+        }
+        item->next = SDL_classcache;
+        SDL_classcache = item;
+    }
+    item->devnum = sb->st_rdev;
+    item->ino = sb->st_ino;
+    item->ctime = sb->st_ctime;
+    item->device_class = device_class;
+}
+
+static void UncacheDeviceClass(const char *path)
+{
+    SDL_classcache_item *item;
+    SDL_classcache_item *prev = NULL;
+
+    SDL_AssertJoysticksLocked();
+
+    for (item = SDL_classcache; item; item = item->next) {
+        if (SDL_strcmp(path, item->path) == 0) {
+            if (prev) {
+                prev->next = item->next;
+            } else {
+                SDL_classcache = item->next;
+            }
+            SDL_free(item->path);
+            SDL_free(item);
+            return;
+        }
+        prev = item;
+    }
+}
+
+static int GetDeviceClass(const char *path, const struct stat *sb, int *fd)
+{
+    int device_class;
+
+    if (GetCachedDeviceClass(path, sb, &device_class)) {
+        return device_class;
+    }
+
+    if (*fd < 0) {
+        *fd = open(path, O_RDONLY | O_CLOEXEC, 0);
+        if (*fd < 0) {
+            // We might be able to open it later, so don't cache this
+            return 0;
+        }
+    }
+
+    device_class = GuessDeviceClass(*fd);
+    CacheDeviceClass(path, sb, device_class);
+    return device_class;
+}
+
+static bool IsJoystick(const char *path, const struct stat *sb, int *fd, char **name_return, Uint16 *vendor_return, Uint16 *product_return, SDL_GUID *guid)
 {
     struct input_id inpid;
     char *name;
@@ -290,16 +377,22 @@ static bool IsJoystick(const char *path, int *fd, char **name_return, Uint16 *ve
     }
 #endif
 
-    if (fd && *fd < 0) {
+    // Event nodes never respond to JSIOCGNAME, so we can check the device class before opening them
+    if (enumeration_method != ENUMERATION_LIBUDEV && !class && !IsJoystickJSNode(path) &&
+        !(GetDeviceClass(path, sb, fd) & SDL_UDEV_DEVICE_JOYSTICK)) {
+        return false;
+    }
+
+    if (*fd < 0) {
         *fd = open(path, O_RDONLY | O_CLOEXEC, 0);
     }
-    if (!fd || *fd < 0) {
+    if (*fd < 0) {
         return false;
     }
 
     if (ioctl(*fd, JSIOCGNAME(sizeof(product_string)), product_string) <= 0) {
         // When udev enumeration or classification, we only got joysticks here, so no need to test
-        if (enumeration_method != ENUMERATION_LIBUDEV && !class && !GuessIsJoystick(*fd)) {
+        if (enumeration_method != ENUMERATION_LIBUDEV && !class && !(GetDeviceClass(path, sb, fd) & SDL_UDEV_DEVICE_JOYSTICK)) {
             return false;
         }
 
@@ -341,7 +434,7 @@ static bool IsJoystick(const char *path, int *fd, char **name_return, Uint16 *ve
     return true;
 }
 
-static bool IsSensor(const char *path, int *fd)
+static bool IsSensor(const char *path, const struct stat *sb, int *fd)
 {
     struct input_id inpid;
     int class = 0;
@@ -355,14 +448,14 @@ static bool IsSensor(const char *path, int *fd)
     }
 #endif
 
-    if (fd && *fd < 0) {
-        *fd = open(path, O_RDONLY | O_CLOEXEC, 0);
-    }
-    if (!fd || *fd < 0) {
+    if (!class && !(GetDeviceClass(path, sb, fd) & SDL_UDEV_DEVICE_ACCELEROMETER)) {
         return false;
     }
 
-    if (!class && !GuessIsSensor(*fd)) {
+    if (*fd < 0) {
+        *fd = open(path, O_RDONLY | O_CLOEXEC, 0);
+    }
+    if (*fd < 0) {
         return false;
     }
 
@@ -380,6 +473,30 @@ static bool IsSensor(const char *path, int *fd)
 }
 
 #ifdef SDL_USE_LIBUDEV
+static bool IsDeviceAdded(const char *path)
+{
+    SDL_joylist_item *item;
+    SDL_sensorlist_item *item_sensor;
+    bool result = false;
+
+    SDL_LockJoysticks();
+    for (item = SDL_joylist; item; item = item->next) {
+        if (SDL_strcmp(path, item->path) == 0) {
+            result = true;
+            break;
+        }
+    }
+    for (item_sensor = SDL_sensorlist; item_sensor && !result; item_sensor = item_sensor->next) {
+        if (SDL_strcmp(path, item_sensor->path) == 0) {
+            result = true;
+            break;
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    return result;
+}
+
 static void joystick_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_class, const char *devpath)
 {
     if (!devpath) {
@@ -401,6 +518,11 @@ static void joystick_udev_callback(SDL_UDEV_deviceevent udev_type, int udev_clas
             }
         }
 
+        // The initial udev scan reports devices we've already found
+        if (IsDeviceAdded(devpath)) {
+            return;
+        }
+
         // Wait a bit for the hidraw udev node to initialize
         SDL_Delay(10);
 
@@ -445,13 +567,8 @@ static void MaybeAddDevice(const char *path)
         return;
     }
 
-    fd = open(path, O_RDONLY | O_CLOEXEC, 0);
-    if (fd < 0) {
-        return;
-    }
-
-    if (fstat(fd, &sb) == -1) {
-        close(fd);
+    // Opening input devices can generate synchronous device I/O, so don't do that until we need to
+    if (stat(path, &sb) == -1) {
         return;
     }
 
@@ -473,7 +590,7 @@ static void MaybeAddDevice(const char *path)
     SDL_Log("Checking %s", path);
 #endif
 
-    if (IsJoystick(path, &fd, &name, &vendor, &product, &guid)) {
+    if (IsJoystick(path, &sb, &fd, &name, &vendor, &product, &guid)) {
 #ifdef DEBUG_INPUT_EVENTS
         SDL_Log("found joystick: %s", path);
 #endif
@@ -514,7 +631,7 @@ static void MaybeAddDevice(const char *path)
         goto done;
     }
 
-    if (IsSensor(path, &fd)) {
+    if (IsSensor(path, &sb, &fd)) {
 #ifdef DEBUG_INPUT_EVENTS
         SDL_Log("found sensor: %s", path);
 #endif
@@ -536,7 +653,9 @@ static void MaybeAddDevice(const char *path)
     }
 
 done:
-    close(fd);
+    if (fd >= 0) {
+        close(fd);
+    }
     SDL_UnlockJoysticks();
 }
 
@@ -598,6 +717,8 @@ static void MaybeRemoveDevice(const char *path)
     }
 
     SDL_LockJoysticks();
+    UncacheDeviceClass(path);
+
     for (item = SDL_joylist; item; item = item->next) {
         // found it, remove it.
         if (SDL_strcmp(path, item->path) == 0) {
@@ -903,6 +1024,119 @@ static void LINUX_ScanSteamVirtualGamepads(void)
     SDL_free(virtual_gamepads);
 }
 
+typedef struct
+{
+    char path[PATH_MAX];
+    struct stat sb;
+    int device_class;
+    bool probed;
+} ProbeEntry;
+
+typedef struct
+{
+    ProbeEntry *entries;
+    int count;
+    SDL_AtomicInt next;
+} ProbeContext;
+
+static int SDLCALL ProbeThread(void *data)
+{
+    ProbeContext *ctx = (ProbeContext *)data;
+    int i;
+
+    while ((i = SDL_AddAtomicInt(&ctx->next, 1)) < ctx->count) {
+        ProbeEntry *entry = &ctx->entries[i];
+        int fd = open(entry->path, O_RDONLY | O_CLOEXEC, 0);
+        if (fd >= 0) {
+            entry->device_class = GuessDeviceClass(fd);
+            entry->probed = true;
+            close(fd);
+        }
+    }
+    return 0;
+}
+
+/* Opening and probing input devices can be slow, so when there are several
+ * devices that we'll need to open to classify, do that in parallel and let
+ * MaybeAddDevice() pick up the results from the device class cache.
+ */
+static void ProbeInputDevices(struct dirent **entries, int count)
+{
+    SDL_Thread *threads[8];
+    ProbeContext ctx;
+    int i, num_threads;
+
+    if (SDL_classic_joysticks || enumeration_method == ENUMERATION_LIBUDEV) {
+        // Classic nodes don't use the device class and udev classifies devices for us
+        return;
+    }
+
+    SDL_zero(ctx);
+    ctx.entries = (ProbeEntry *)SDL_calloc(count, sizeof(*ctx.entries));
+    if (!ctx.entries) {
+        return;
+    }
+
+    SDL_LockJoysticks();
+    for (i = 0; i < count; ++i) {
+        ProbeEntry *entry = &ctx.entries[ctx.count];
+        SDL_joylist_item *item;
+        SDL_sensorlist_item *item_sensor;
+        int device_class;
+        bool known = false;
+
+        (void)SDL_snprintf(entry->path, SDL_arraysize(entry->path), "/dev/input/%s", entries[i]->d_name);
+        if (stat(entry->path, &entry->sb) == -1 ||
+            GetCachedDeviceClass(entry->path, &entry->sb, &device_class)) {
+            continue;
+        }
+        for (item = SDL_joylist; item && !known; item = item->next) {
+            known = (entry->sb.st_rdev == item->devnum);
+        }
+        for (item_sensor = SDL_sensorlist; item_sensor && !known; item_sensor = item_sensor->next) {
+            known = (entry->sb.st_rdev == item_sensor->devnum);
+        }
+#ifdef SDL_USE_LIBUDEV
+        if (!known) {
+            Uint16 vendor, product, version;
+            int class = 0;
+            known = (SDL_UDEV_GetProductInfo(entry->path, &vendor, &product, &version, &class) && class);
+        }
+#endif
+        if (!known) {
+            ++ctx.count;
+        }
+    }
+    SDL_UnlockJoysticks();
+
+    num_threads = SDL_min(SDL_min(ctx.count, SDL_GetNumLogicalCPUCores()), (int)SDL_arraysize(threads));
+    if (num_threads > 1) {
+        int started = 0;
+
+        for (i = 0; i < num_threads; ++i) {
+            threads[started] = SDL_CreateThread(ProbeThread, "SDL evdev probe", &ctx);
+            if (threads[started]) {
+                ++started;
+            }
+        }
+        // Finish up on this thread, in case we couldn't create any threads
+        ProbeThread(&ctx);
+        for (i = 0; i < started; ++i) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+
+        SDL_LockJoysticks();
+        for (i = 0; i < ctx.count; ++i) {
+            ProbeEntry *entry = &ctx.entries[i];
+            if (entry->probed) {
+                CacheDeviceClass(entry->path, &entry->sb, entry->device_class);
+            }
+        }
+        SDL_UnlockJoysticks();
+    }
+    SDL_free(ctx.entries);
+}
+
 static void LINUX_ScanInputDevices(void)
 {
     int i, count;
@@ -912,6 +1146,7 @@ static void LINUX_ScanInputDevices(void)
     count = scandir("/dev/input", &entries, filter_entries, NULL);
     if (count > 1) {
         SDL_qsort(entries, count, sizeof(*entries), sort_entries);
+        ProbeInputDevices(entries, count);
     }
     for (i = 0; i < count; ++i) {
         (void)SDL_snprintf(path, SDL_arraysize(path), "/dev/input/%s", entries[i]->d_name);
@@ -2194,6 +2429,8 @@ static void LINUX_JoystickQuit(void)
     SDL_joylist_item *next = NULL;
     SDL_sensorlist_item *item_sensor = NULL;
     SDL_sensorlist_item *next_sensor = NULL;
+    SDL_classcache_item *item_class = NULL;
+    SDL_classcache_item *next_class = NULL;
 
     SDL_AssertJoysticksLocked();
 
@@ -2210,9 +2447,15 @@ static void LINUX_JoystickQuit(void)
         next_sensor = item_sensor->next;
         FreeSensorlistItem(item_sensor);
     }
+    for (item_class = SDL_classcache; item_class; item_class = next_class) {
+        next_class = item_class->next;
+        SDL_free(item_class->path);
+        SDL_free(item_class);
+    }
 
     SDL_joylist = SDL_joylist_tail = NULL;
     SDL_sensorlist = NULL;
+    SDL_classcache = NULL;
 
     numjoysticks = 0;
 
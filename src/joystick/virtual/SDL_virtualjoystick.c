@@ -483,6 +483,89 @@ bool SDL_SendJoystickVirtualSensorDataInner(SDL_Joystick *joystick, SDL_SensorTy
     return true;
 }
 
+bool SDL_SetJoystickVirtualStateInner(SDL_Joystick *joystick, const SDL_VirtualJoystickState *state)
+{
+    joystick_hwdata *hwdata;
+    int i;
+
+    SDL_AssertJoysticksLocked();
+
+    if (!joystick || !joystick->hwdata) {
+        return SDL_SetError("Invalid joystick");
+    }
+
+    hwdata = (joystick_hwdata *)joystick->hwdata;
+
+    // Check everything first, so the state is never partially updated
+    if (state->naxes < 0 || state->naxes > hwdata->desc.naxes || (state->naxes > 0 && !state->axes)) {
+        return SDL_SetError("Invalid axis count");
+    }
+    if (state->nbuttons < 0 || state->nbuttons > hwdata->desc.nbuttons || (state->nbuttons > 0 && !state->buttons)) {
+        return SDL_SetError("Invalid button count");
+    }
+    if (state->nhats < 0 || state->nhats > hwdata->desc.nhats || (state->nhats > 0 && !state->hats)) {
+        return SDL_SetError("Invalid hat count");
+    }
+    if (state->nfingers < 0 || (state->nfingers > 0 && !state->fingers)) {
+        return SDL_SetError("Invalid finger count");
+    }
+    for (i = 0; i < state->nfingers; ++i) {
+        const SDL_VirtualJoystickFingerState *finger = &state->fingers[i];
+        if (finger->touchpad < 0 || finger->touchpad >= hwdata->desc.ntouchpads) {
+            return SDL_SetError("Invalid touchpad index");
+        }
+        if (finger->finger < 0 || finger->finger >= hwdata->touchpads[finger->touchpad].nfingers) {
+            return SDL_SetError("Invalid finger index");
+        }
+    }
+    if (state->nsensor_events < 0 || (state->nsensor_events > 0 && !state->sensor_events)) {
+        return SDL_SetError("Invalid sensor event count");
+    }
+    if (state->nsensor_events > hwdata->max_sensor_events - hwdata->num_sensor_events) {
+        int new_max_sensor_events = (hwdata->num_sensor_events + state->nsensor_events);
+        VirtualSensorEvent *sensor_events = (VirtualSensorEvent *)SDL_realloc(hwdata->sensor_events, new_max_sensor_events * sizeof(*sensor_events));
+        if (!sensor_events) {
+            return false;
+        }
+        hwdata->sensor_events = sensor_events;
+        hwdata->max_sensor_events = new_max_sensor_events;
+    }
+
+    if (state->naxes > 0) {
+        SDL_memcpy(hwdata->axes, state->axes, state->naxes * sizeof(*hwdata->axes));
+        hwdata->changes |= AXES_CHANGED;
+    }
+    if (state->nbuttons > 0) {
+        SDL_memcpy(hwdata->buttons, state->buttons, state->nbuttons * sizeof(*hwdata->buttons));
+        hwdata->changes |= BUTTONS_CHANGED;
+    }
+    if (state->nhats > 0) {
+        SDL_memcpy(hwdata->hats, state->hats, state->nhats * sizeof(*hwdata->hats));
+        hwdata->changes |= HATS_CHANGED;
+    }
+    for (i = 0; i < state->nfingers; ++i) {
+        const SDL_VirtualJoystickFingerState *finger = &state->fingers[i];
+        SDL_JoystickTouchpadFingerInfo *info = &hwdata->touchpads[finger->touchpad].fingers[finger->finger];
+        info->down = finger->down;
+        info->x = finger->x;
+        info->y = finger->y;
+        info->pressure = finger->pressure;
+        hwdata->changes |= TOUCHPADS_CHANGED;
+    }
+    for (i = 0; i < state->nsensor_events; ++i) {
+        const SDL_VirtualJoystickSensorEvent *sensor_event = &state->sensor_events[i];
+        VirtualSensorEvent *event = &hwdata->sensor_events[hwdata->num_sensor_events++];
+        event->type = sensor_event->type;
+        event->sensor_timestamp = sensor_event->sensor_timestamp;
+        event->num_values = SDL_clamp(sensor_event->num_values, 0, (int)SDL_arraysize(event->data));
+        if (event->num_values > 0) {
+            SDL_memcpy(event->data, sensor_event->data, (event->num_values * sizeof(*event->data)));
+        }
+    }
+
+    return true;
+}
+
 static bool VIRTUAL_JoystickInit(void)
 {
     return true;
@@ -78,6 +78,7 @@ extern bool SDL_SetJoystickVirtualButtonInner(SDL_Joystick *joystick, int button
 extern bool SDL_SetJoystickVirtualHatInner(SDL_Joystick *joystick, int hat, Uint8 value);
 extern bool SDL_SetJoystickVirtualTouchpadInner(SDL_Joystick *joystick, int touchpad, int finger, bool down, float x, float y, float pressure);
 extern bool SDL_SendJoystickVirtualSensorDataInner(SDL_Joystick *joystick, SDL_SensorType type, Uint64 sensor_timestamp, const float *data, int num_values);
+extern bool SDL_SetJoystickVirtualStateInner(SDL_Joystick *joystick, const SDL_VirtualJoystickState *state);
 
 #endif // SDL_JOYSTICK_VIRTUAL
 
@@ -179,6 +179,41 @@ bool SDL_WaitProcess(SDL_Process *process, bool block, int *exitcode)
     return false;
 }
 
+int SDL_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS)
+{
+    if (count < 0 || (!waits && count > 0)) {
+        SDL_InvalidParamError("waits");
+        return -1;
+    }
+
+    int ready = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!waits[i].process) {
+            SDL_InvalidParamError("waits[i].process");
+            return -1;
+        }
+        waits[i].revents = 0;
+        if ((waits[i].events & SDL_PROCESS_EVENT_EXITED) && !waits[i].process->alive) {
+            waits[i].revents = SDL_PROCESS_EVENT_EXITED;
+            ++ready;
+        }
+    }
+
+    // if something's already ready, just check on the rest without waiting.
+    const int result = SDL_SYS_WaitProcesses(waits, count, ready ? 0 : timeoutMS);
+    if (result < 0) {
+        return -1;
+    }
+
+    ready = 0;
+    for (int i = 0; i < count; ++i) {
+        if (waits[i].revents) {
+            ++ready;
+        }
+    }
+    return ready;
+}
+
 void SDL_DestroyProcess(SDL_Process *process)
 {
     if (!process) {
@@ -34,4 +34,5 @@ struct SDL_Process
 bool SDL_SYS_CreateProcessWithProperties(SDL_Process *process, SDL_PropertiesID props);
 bool SDL_SYS_KillProcess(SDL_Process *process, bool force);
 bool SDL_SYS_WaitProcess(SDL_Process *process, bool block, int *exitcode);
+int SDL_SYS_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS);
 void SDL_SYS_DestroyProcess(SDL_Process *process);
@@ -40,6 +40,12 @@ bool SDL_SYS_WaitProcess(SDL_Process *process, bool block, int *exitcode)
     return SDL_Unsupported();
 }
 
+int SDL_SYS_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS)
+{
+    SDL_Unsupported();
+    return -1;
+}
+
 void SDL_SYS_DestroyProcess(SDL_Process *process)
 {
     return;
@@ -30,8 +30,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <poll.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#ifdef SDL_PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
+#if defined(SDL_PLATFORM_APPLE) || defined(SDL_PLATFORM_FREEBSD) || defined(SDL_PLATFORM_NETBSD) || defined(SDL_PLATFORM_OPENBSD)
+#include <sys/event.h>
+#define HAVE_PROCESS_KQUEUE
+#endif
 
 #include "../SDL_sysprocess.h"
 #include "../../io/SDL_iostream_c.h"
@@ -40,8 +48,13 @@
 #define READ_END 0
 #define WRITE_END 1
 
+// How long SDL_WaitProcesses() waits between checks on processes it can't get notified about.
+#define PROCESS_POLL_INTERVAL_MS 10
+
 struct SDL_ProcessData {
     pid_t pid;
+    int exit_fd;            // becomes readable when the process exits, -1 if there isn't one
+    bool exit_fd_checked;
 };
 
 static void CleanupStream(void *userdata, void *value)
@@ -177,6 +190,7 @@ bool SDL_SYS_CreateProcessWithProperties(SDL_Process *process, SDL_PropertiesID
         SDL_free(envp);
         return false;
     }
+    data->exit_fd = -1;
     process->internal = data;
 
     posix_spawnattr_t attr;
@@ -458,6 +472,168 @@ bool SDL_SYS_WaitProcess(SDL_Process *process, bool block, int *exitcode)
     }
 }
 
+// A pidfd on Linux, or a kqueue watching just this process elsewhere; either can go in a poll() with the pipes.
+static int GetProcessExitFD(SDL_Process *process)
+{
+    SDL_ProcessData *data = process->internal;
+    if (!data->exit_fd_checked) {
+        data->exit_fd_checked = true;
+#if defined(SDL_PLATFORM_LINUX) && defined(SYS_pidfd_open)
+        data->exit_fd = (int)syscall(SYS_pidfd_open, data->pid, 0);  // pidfds are close-on-exec already.
+#elif defined(HAVE_PROCESS_KQUEUE)
+        int kq = kqueue();
+        if (kq >= 0) {
+            struct kevent ev;
+            EV_SET(&ev, data->pid, EVFILT_PROC, EV_ADD, NOTE_EXIT, 0, NULL);
+            if (kevent(kq, &ev, 1, NULL, 0, NULL) == 0) {
+                fcntl(kq, F_SETFD, fcntl(kq, F_GETFD) | FD_CLOEXEC);
+                data->exit_fd = kq;
+            } else {
+                close(kq);  // if the process is already gone, it'll be noticed by checking on it.
+            }
+        }
+#endif
+        if (data->exit_fd < 0) {
+            data->exit_fd = -1;
+        }
+    }
+    return data->exit_fd;
+}
+
+static int GetProcessStreamFD(SDL_Process *process, const char *property)
+{
+    SDL_IOStream *io = (SDL_IOStream *)SDL_GetPointerProperty(process->props, property, NULL);
+    if (!io) {
+        return -1;
+    }
+    return (int)SDL_GetNumberProperty(SDL_GetIOProperties(io), SDL_PROP_IOSTREAM_FILE_DESCRIPTOR_NUMBER, -1);
+}
+
+typedef struct ProcessPollTarget
+{
+    int wait;
+    SDL_ProcessEvents event;
+} ProcessPollTarget;
+
+int SDL_SYS_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS)
+{
+    static const struct
+    {
+        SDL_ProcessEvents event;
+        const char *property;
+        short poll_events;
+    } streams[] = {
+        { SDL_PROCESS_EVENT_STDIN, SDL_PROP_PROCESS_STDIN_POINTER, POLLOUT },
+        { SDL_PROCESS_EVENT_STDOUT, SDL_PROP_PROCESS_STDOUT_POINTER, POLLIN },
+        { SDL_PROCESS_EVENT_STDERR, SDL_PROP_PROCESS_STDERR_POINTER, POLLIN }
+    };
+    const int max_fds = count * (SDL_arraysize(streams) + 1);
+    struct pollfd *fds = (struct pollfd *)SDL_malloc(max_fds * sizeof(*fds) + 1);
+    ProcessPollTarget *targets = (ProcessPollTarget *)SDL_malloc(max_fds * sizeof(*targets) + 1);
+    const Uint64 deadline = (timeoutMS > 0) ? (SDL_GetTicks() + (Uint64)timeoutMS) : 0;
+    int ready = -1;
+
+    if (!fds || !targets) {
+        goto done;
+    }
+
+    for (;;) {
+        bool need_checks = false;
+        nfds_t nfds = 0;
+        for (int i = 0; i < count; ++i) {
+            SDL_Process *process = waits[i].process;
+            for (int j = 0; j < (int)SDL_arraysize(streams); ++j) {
+                if (waits[i].events & streams[j].event) {
+                    const int fd = GetProcessStreamFD(process, streams[j].property);
+                    if (fd >= 0) {
+                        fds[nfds].fd = fd;
+                        fds[nfds].events = streams[j].poll_events;
+                        fds[nfds].revents = 0;
+                        targets[nfds].wait = i;
+                        targets[nfds].event = streams[j].event;
+                        ++nfds;
+                    }
+                }
+            }
+            if ((waits[i].events & SDL_PROCESS_EVENT_EXITED) && process->alive) {
+                const int fd = process->background ? -1 : GetProcessExitFD(process);
+                if (fd >= 0) {
+                    fds[nfds].fd = fd;
+                    fds[nfds].events = POLLIN;
+                    fds[nfds].revents = 0;
+                    targets[nfds].wait = i;
+                    targets[nfds].event = SDL_PROCESS_EVENT_EXITED;
+                    ++nfds;
+                } else {
+                    need_checks = true;
+                }
+            }
+        }
+
+        if (nfds == 0 && !need_checks && timeoutMS < 0) {
+            SDL_SetError("None of the processes have anything to wait for");
+            goto done;
+        }
+
+        int poll_timeout = timeoutMS;
+        if (timeoutMS > 0) {
+            const Uint64 now = SDL_GetTicks();
+            poll_timeout = (now < deadline) ? (int)(deadline - now) : 0;
+        }
+        if (need_checks && (poll_timeout < 0 || poll_timeout > PROCESS_POLL_INTERVAL_MS)) {
+            poll_timeout = PROCESS_POLL_INTERVAL_MS;
+        }
+
+        const int rc = poll(fds, nfds, poll_timeout);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            SDL_SetError("poll() failed: %s", strerror(errno));
+            goto done;
+        }
+
+        ready = 0;
+        for (nfds_t k = 0; k < nfds; ++k) {
+            if (fds[k].revents) {
+                SDL_ProcessWait *wait = &waits[targets[k].wait];
+                if (targets[k].event == SDL_PROCESS_EVENT_EXITED) {
+                    if (SDL_WaitProcess(wait->process, false, NULL)) {
+                        wait->revents |= SDL_PROCESS_EVENT_EXITED;
+                    }
+                } else {
+                    wait->revents |= targets[k].event;  // POLLHUP and POLLERR count too, the next read or write will say what happened.
+                }
+            }
+        }
+        if (need_checks) {
+            for (int i = 0; i < count; ++i) {
+                SDL_Process *process = waits[i].process;
+                if ((waits[i].events & SDL_PROCESS_EVENT_EXITED) && process->alive && (process->background || GetProcessExitFD(process) < 0)) {
+                    if (SDL_WaitProcess(process, false, NULL)) {
+                        waits[i].revents |= SDL_PROCESS_EVENT_EXITED;
+                    }
+                }
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            if (waits[i].revents) {
+                ++ready;
+            }
+        }
+
+        if (ready > 0 || timeoutMS == 0 || (timeoutMS > 0 && SDL_GetTicks() >= deadline)) {
+            break;
+        }
+        ready = -1;
+    }
+
+done:
+    SDL_free(fds);
+    SDL_free(targets);
+    return ready;
+}
+
 void SDL_SYS_DestroyProcess(SDL_Process *process)
 {
     SDL_IOStream *io;
@@ -477,6 +653,9 @@ void SDL_SYS_DestroyProcess(SDL_Process *process)
         SDL_CloseIO(io);
     }
 
+    if (process->internal && process->internal->exit_fd >= 0) {
+        close(process->internal->exit_fd);
+    }
     SDL_free(process->internal);
 }
 
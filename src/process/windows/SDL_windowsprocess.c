@@ -527,6 +527,111 @@ bool SDL_SYS_WaitProcess(SDL_Process *process, bool block, int *exitcode)
     }
 }
 
+// Anonymous pipes can't be waited on, so SDL_WaitProcesses() checks them this often.
+#define PROCESS_POLL_INTERVAL_MS 10
+
+static HANDLE GetProcessStreamHandle(SDL_Process *process, const char *property)
+{
+    SDL_IOStream *io = (SDL_IOStream *)SDL_GetPointerProperty(process->props, property, NULL);
+    if (!io) {
+        return INVALID_HANDLE_VALUE;
+    }
+    return (HANDLE)SDL_GetPointerProperty(SDL_GetIOProperties(io), SDL_PROP_IOSTREAM_WINDOWS_HANDLE_POINTER, INVALID_HANDLE_VALUE);
+}
+
+static bool IsProcessPipeReadable(HANDLE pipe)
+{
+    DWORD avail = 0;
+    if (!PeekNamedPipe(pipe, NULL, 0, NULL, &avail, NULL)) {
+        return true;  // it's broken or closed, which the next read will report.
+    }
+    return avail > 0;
+}
+
+int SDL_SYS_WaitProcesses(SDL_ProcessWait *waits, int count, Sint32 timeoutMS)
+{
+    const Uint64 deadline = (timeoutMS > 0) ? (SDL_GetTicks() + (Uint64)timeoutMS) : 0;
+    HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+
+    for (;;) {
+        bool need_checks = false;
+        DWORD nhandles = 0;
+        int ready = 0;
+
+        for (int i = 0; i < count; ++i) {
+            SDL_ProcessWait *wait = &waits[i];
+            SDL_Process *process = wait->process;
+            HANDLE pipe;
+
+            if (wait->events & SDL_PROCESS_EVENT_STDIN) {
+                pipe = GetProcessStreamHandle(process, SDL_PROP_PROCESS_STDIN_POINTER);
+                if (pipe != INVALID_HANDLE_VALUE) {
+                    wait->revents |= SDL_PROCESS_EVENT_STDIN;  // there's no asking an anonymous pipe how full it is.
+                }
+            }
+            if (wait->events & SDL_PROCESS_EVENT_STDOUT) {
+                pipe = GetProcessStreamHandle(process, SDL_PROP_PROCESS_STDOUT_POINTER);
+                if (pipe != INVALID_HANDLE_VALUE) {
+                    if (IsProcessPipeReadable(pipe)) {
+                        wait->revents |= SDL_PROCESS_EVENT_STDOUT;
+                    }
+                    need_checks = true;
+                }
+            }
+            if (wait->events & SDL_PROCESS_EVENT_STDERR) {
+                pipe = GetProcessStreamHandle(process, SDL_PROP_PROCESS_STDERR_POINTER);
+                if (pipe != INVALID_HANDLE_VALUE) {
+                    if (IsProcessPipeReadable(pipe)) {
+                        wait->revents |= SDL_PROCESS_EVENT_STDERR;
+                    }
+                    need_checks = true;
+                }
+            }
+            if ((wait->events & SDL_PROCESS_EVENT_EXITED) && process->alive) {
+                if (SDL_WaitProcess(process, false, NULL)) {
+                    wait->revents |= SDL_PROCESS_EVENT_EXITED;
+                } else if (nhandles < SDL_arraysize(handles)) {
+                    handles[nhandles++] = process->internal->process_information.hProcess;
+                } else {
+                    need_checks = true;
+                }
+            }
+
+            if (wait->revents) {
+                ++ready;
+            }
+        }
+
+        DWORD wait_timeout = INFINITE;
+        if (timeoutMS >= 0) {
+            const Uint64 now = SDL_GetTicks();
+            wait_timeout = (now < deadline) ? (DWORD)(deadline - now) : 0;
+        }
+        if (ready > 0 || wait_timeout == 0) {
+            return ready;
+        } else if (nhandles == 0 && !need_checks && timeoutMS < 0) {
+            SDL_SetError("None of the processes have anything to wait for");
+            return -1;
+        }
+        if (need_checks && (wait_timeout == INFINITE || wait_timeout > PROCESS_POLL_INTERVAL_MS)) {
+            wait_timeout = PROCESS_POLL_INTERVAL_MS;
+        }
+
+        // any process exiting wakes this up, and the next time around picks it up.
+        DWORD result;
+        if (nhandles > 0) {
+            result = WaitForMultipleObjects(nhandles, handles, FALSE, wait_timeout);
+        } else {
+            Sleep(wait_timeout);
+            result = WAIT_TIMEOUT;
+        }
+        if (result == WAIT_FAILED) {
+            WIN_SetError("WaitForMultipleObjects()");
+            return -1;
+        }
+    }
+}
+
 void SDL_SYS_DestroyProcess(SDL_Process *process)
 {
     SDL_ProcessData *data = process->internal;
@@ -27,7 +27,12 @@
 #include "software/SDL_render_sw_c.h"
 #include "../events/SDL_windowevents_c.h"
 #include "../video/SDL_pixels_c.h"
+#include "../video/SDL_surface_c.h"
 #include "../video/SDL_video_c.h"
+#include "../SDL_memoryusage_c.h"
+#include "../SDL_properties_c.h"
+#include "../SDL_trace_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
 
 #ifdef SDL_PLATFORM_ANDROID
 #include "../core/android/SDL_android.h"
@@ -49,6 +54,11 @@ this should probably be removed at some point in the future.  --ryan. */
 #define SDL_PROP_WINDOW_RENDERER_POINTER "SDL.internal.window.renderer"
 #define SDL_PROP_TEXTURE_PARENT_POINTER "SDL.internal.texture.parent"
 
+// These are looked up every frame
+static SDL_PropertyKey SDL_window_renderer_key = SDL_PROPERTY_KEY(SDL_PROP_WINDOW_RENDERER_POINTER);
+static SDL_PropertyKey SDL_window_shape_key = SDL_PROPERTY_KEY(SDL_PROP_WINDOW_SHAPE_POINTER);
+static SDL_PropertyKey SDL_texture_parent_key = SDL_PROPERTY_KEY(SDL_PROP_TEXTURE_PARENT_POINTER);
+
 #define CHECK_RENDERER_MAGIC_BUT_NOT_DESTROYED_FLAG(renderer, result)   \
     if (!SDL_ObjectValid(renderer, SDL_OBJECT_TYPE_RENDERER)) {         \
         SDL_InvalidParamError("renderer");                              \
@@ -68,6 +78,18 @@ this should probably be removed at some point in the future.  --ryan. */
         return result;                                          \
     }
 
+#define CHECK_RENDER_READBACK_MAGIC(readback, result)                   \
+    if (!SDL_ObjectValid(readback, SDL_OBJECT_TYPE_RENDER_READBACK)) {  \
+        SDL_InvalidParamError("readback");                              \
+        return result;                                                  \
+    }
+
+#define CHECK_TEXTURE_ATLAS_MAGIC(atlas, result)                    \
+    if (!SDL_ObjectValid(atlas, SDL_OBJECT_TYPE_TEXTURE_ATLAS)) {   \
+        SDL_InvalidParamError("atlas");                             \
+        return result;                                              \
+    }
+
 // Predefined blend modes
 #define SDL_COMPOSE_BLENDMODE(srcColorFactor, dstColorFactor, colorOperation, \
                               srcAlphaFactor, dstAlphaFactor, alphaOperation) \
@@ -152,6 +174,39 @@ static SDL_Renderer *SDL_renderers;
 
 static const int rect_index_order[] = { 0, 1, 2, 0, 2, 3 };
 
+// The size of the first block of render commands
+#define SDL_RENDER_COMMAND_BLOCK_SIZE 64
+
+// The default size of texture atlas pages, and the padding after each texture in them
+#define SDL_ATLAS_DEFAULT_PAGE_SIZE 1024
+#define SDL_ATLAS_PADDING           1
+
+typedef struct SDL_AtlasSkylineNode
+{
+    int x;
+    int y;
+    int w;
+} SDL_AtlasSkylineNode;
+
+typedef struct SDL_TextureAtlasPage
+{
+    SDL_Texture *texture;
+    SDL_AtlasSkylineNode *skyline; // The top of the used space, sorted by x
+    int num_nodes;
+    int num_textures;
+} SDL_TextureAtlasPage;
+
+struct SDL_TextureAtlas
+{
+    SDL_Renderer *renderer;
+    SDL_PixelFormat format;
+    int page_w;
+    int page_h;
+    SDL_TextureAtlasPage *pages;
+    int num_pages;
+    SDL_TextureAtlas *next;
+};
+
 void SDL_QuitRender(void)
 {
     while (SDL_renderers) {
@@ -304,8 +359,200 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+// How far back a draw may be moved to join a batch
+#define SDL_RENDER_REORDER_WINDOW 64
+
+static bool CanBatchRenderCommands(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    if (a->data.draw.texture != b->data.draw.texture ||
+        a->data.draw.blend != b->data.draw.blend ||
+        a->data.draw.texture_address_mode != b->data.draw.texture_address_mode ||
+        a->data.draw.color_scale != b->data.draw.color_scale) {
+        return false;
+    }
+    if (a->data.draw.texture && a->data.draw.texture_scale_mode != b->data.draw.texture_scale_mode) {
+        return false;
+    }
+    return true;
+}
+
+static void ReorderRenderCommandRun(SDL_Renderer *renderer, SDL_RenderCommand *prev, int count)
+{
+    SDL_RenderCommand **cmds = renderer->reorder_commands;
+    SDL_RenderCommand **sorted = cmds + count;
+    SDL_RenderCommand *next = cmds[count - 1]->next;
+    const size_t span_start = cmds[0]->data.draw.first;
+    const size_t span_size = cmds[count - 1]->data.draw.vertex_end - span_start;
+    Uint8 *vertices = (Uint8 *)renderer->vertex_data;
+    bool moved = false;
+    size_t alignment, offset;
+    int i, j, n;
+
+    // The vertex data of the run has to be contiguous so it can be rearranged to match
+    for (i = 1; i < count; ++i) {
+        if (cmds[i]->data.draw.first != cmds[i - 1]->data.draw.vertex_end) {
+            return;
+        }
+    }
+
+    /* Move each draw back to the most recent draw it can be batched with,
+       as long as it doesn't overlap any of the draws it moves in front of. */
+    for (i = 0, n = 0; i < count; ++i, ++n) {
+        SDL_RenderCommand *cmd = cmds[i];
+        int insert = n;
+
+        for (j = n - 1; j >= 0 && j >= n - SDL_RENDER_REORDER_WINDOW; --j) {
+            if (CanBatchRenderCommands(sorted[j], cmd)) {
+                insert = j + 1;
+                break;
+            }
+            if (SDL_HasRectIntersectionFloat(&sorted[j]->data.draw.bounds, &cmd->data.draw.bounds)) {
+                break;
+            }
+        }
+        if (insert < n) {
+            SDL_memmove(&sorted[insert + 1], &sorted[insert], (n - insert) * sizeof(*sorted));
+            moved = true;
+        }
+        sorted[insert] = cmd;
+    }
+
+    if (!moved) {
+        return;
+    }
+
+    /* The render driver aligned each allocation, so its alignment divides the size of
+       every draw's vertex data except the last one. Keep every draw on that boundary. */
+    alignment = 0;
+    for (i = 0; i < count - 1; ++i) {
+        alignment |= cmds[i]->data.draw.vertex_end - cmds[i]->data.draw.first;
+    }
+    alignment &= ~(alignment - 1);
+    offset = 0;
+    for (i = 0; i < count; ++i) {
+        if (offset & (alignment - 1)) {
+            return;
+        }
+        offset += sorted[i]->data.draw.vertex_end - sorted[i]->data.draw.first;
+    }
+
+    if (renderer->reorder_vertex_data_allocation < span_size) {
+        void *ptr = SDL_realloc(renderer->reorder_vertex_data, span_size);
+        if (!ptr) {
+            return;
+        }
+        renderer->reorder_vertex_data = ptr;
+        renderer->reorder_vertex_data_allocation = span_size;
+    }
+    SDL_memcpy(renderer->reorder_vertex_data, vertices + span_start, span_size);
+
+    offset = span_start;
+    for (i = 0; i < count; ++i) {
+        SDL_RenderCommand *cmd = sorted[i];
+        const size_t size = cmd->data.draw.vertex_end - cmd->data.draw.first;
+
+        SDL_memcpy(vertices + offset, (Uint8 *)renderer->reorder_vertex_data + (cmd->data.draw.first - span_start), size);
+        cmd->data.draw.first = offset;
+        cmd->data.draw.vertex_end = offset + size;
+        offset += size;
+
+        if (prev) {
+            prev->next = cmd;
+        } else {
+            renderer->render_commands = cmd;
+        }
+        prev = cmd;
+    }
+    prev->next = next;
+    if (!next) {
+        renderer->render_commands_tail = prev;
+    }
+}
+
+static void ReorderRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *prev = NULL;
+    SDL_RenderCommand *cmd = renderer->render_commands;
+
+    while (cmd) {
+        SDL_RenderCommand *run_prev = prev;
+        int count = 0;
+
+        // Collect a run of consecutive geometry draws, nothing else can be moved around
+        while (cmd && cmd->command == SDL_RENDERCMD_GEOMETRY && cmd->data.draw.vertex_end > cmd->data.draw.first) {
+            if (count * 2 + 2 > renderer->reorder_commands_allocation) {
+                int allocation = SDL_max(renderer->reorder_commands_allocation * 2, 128);
+                SDL_RenderCommand **ptr = (SDL_RenderCommand **)SDL_realloc(renderer->reorder_commands, allocation * sizeof(*ptr));
+                if (!ptr) {
+                    return;
+                }
+                renderer->reorder_commands = ptr;
+                renderer->reorder_commands_allocation = allocation;
+            }
+            renderer->reorder_commands[count++] = cmd;
+            prev = cmd;
+            cmd = cmd->next;
+        }
+
+        if (count > 2) {
+            ReorderRenderCommandRun(renderer, run_prev, count);
+            // The last command in the list may have changed
+            prev = run_prev ? run_prev : renderer->render_commands;
+            while (prev->next != cmd) {
+                prev = prev->next;
+            }
+        }
+
+        if (cmd) {
+            prev = cmd;
+            cmd = cmd->next;
+        }
+    }
+}
+
+// Counts the work a flush hands to the backend, published as renderer properties by SDL_RenderPresent()
+static void CountRenderCommands(SDL_Renderer *renderer)
+{
+    const SDL_RenderCommand *cmd;
+    const SDL_RenderCommand *last_draw = NULL;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            ++renderer->frame_state_changes;
+            break;
+
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            ++renderer->frame_draw_calls;
+            if (cmd->data.draw.texture &&
+                (!last_draw || last_draw->data.draw.texture != cmd->data.draw.texture)) {
+                ++renderer->frame_texture_binds;
+            }
+            if (last_draw &&
+                (last_draw->data.draw.blend != cmd->data.draw.blend ||
+                 last_draw->data.draw.texture_scale_mode != cmd->data.draw.texture_scale_mode ||
+                 last_draw->data.draw.texture_address_mode != cmd->data.draw.texture_address_mode)) {
+                ++renderer->frame_state_changes;
+            }
+            last_draw = cmd;
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
 static bool FlushRenderCommands(SDL_Renderer *renderer)
 {
+    Uint64 start;
     bool result;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
@@ -315,9 +562,23 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
         return true;
     }
 
+    if (renderer->reorder_draws) {
+        ReorderRenderCommands(renderer);
+    }
+
+    SDL_TRACE_BEGIN("FlushRenderCommands");
+    SDL_TRACE_COUNTER("render.vertex_bytes", renderer->vertex_data_used);
+
     DebugLogRenderCommands(renderer->render_commands);
+    CountRenderCommands(renderer);
 
+    SDL_TRACE_BEGIN("RunCommandQueue");
+    start = SDL_GetTicksNS();
     result = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
+    renderer->frame_queue_ns += SDL_GetTicksNS() - start;
+    SDL_TRACE_END("RunCommandQueue");
+
+    renderer->frame_vertex_bytes += renderer->vertex_data_used;
 
     // Move the whole render command queue to the unused pool so we can reuse them next time.
     if (renderer->render_commands_tail) {
@@ -331,6 +592,7 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
     renderer->color_queued = false;
     renderer->viewport_queued = false;
     renderer->cliprect_queued = false;
+    SDL_TRACE_END("FlushRenderCommands");
     return result;
 }
 
@@ -376,6 +638,8 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t
         }
         renderer->vertex_data = ptr;
         renderer->vertex_data_allocation = newsize;
+        ++renderer->frame_allocations;
+        SDL_TrackMemoryObject(&renderer->vertex_data, SDL_MEMORY_OBJECT_CACHE, newsize, NULL, "SDL.render.vertex_buffer");
     }
 
     if (offset) {
@@ -387,20 +651,51 @@ void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, size_t numbytes, size_t
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
 
+/* Add a block of render commands to the unused pool. Blocks double in size,
+ * so the pool quickly reaches the high-water mark of a frame, and it's never
+ * shrunk, so steady frames don't allocate at all. */
+static bool GrowRenderCommandPool(SDL_Renderer *renderer)
+{
+    const int count = SDL_max(renderer->render_commands_allocated, SDL_RENDER_COMMAND_BLOCK_SIZE);
+    SDL_RenderCommand **blocks;
+    SDL_RenderCommand *block;
+    int i;
+
+    blocks = (SDL_RenderCommand **)SDL_realloc(renderer->render_command_blocks, (renderer->num_render_command_blocks + 1) * sizeof(*blocks));
+    if (!blocks) {
+        return false;
+    }
+    renderer->render_command_blocks = blocks;
+
+    block = (SDL_RenderCommand *)SDL_calloc(count, sizeof(*block));
+    if (!block) {
+        return false;
+    }
+    blocks[renderer->num_render_command_blocks++] = block;
+
+    for (i = 0; i < count - 1; ++i) {
+        block[i].next = &block[i + 1];
+    }
+    block[count - 1].next = renderer->render_commands_pool;
+    renderer->render_commands_pool = block;
+    renderer->render_commands_allocated += count;
+    ++renderer->frame_allocations;
+    return true;
+}
+
 static SDL_RenderCommand *AllocateRenderCommand(SDL_Renderer *renderer)
 {
     SDL_RenderCommand *result = NULL;
 
-    result = renderer->render_commands_pool;
-    if (result) {
-        renderer->render_commands_pool = result->next;
-        result->next = NULL;
-    } else {
-        result = (SDL_RenderCommand *)SDL_calloc(1, sizeof(*result));
-        if (!result) {
+    if (!renderer->render_commands_pool) {
+        if (!GrowRenderCommandPool(renderer)) {
             return NULL;
         }
     }
+    result = renderer->render_commands_pool;
+    renderer->render_commands_pool = result->next;
+    result->next = NULL;
+    ++renderer->frame_commands;
 
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
     if (renderer->render_commands_tail) {
@@ -575,11 +870,49 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
                 cmd->data.draw.texture_scale_mode = texture->scaleMode;
             }
             cmd->data.draw.texture_address_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+            cmd->data.draw.vertex_end = 0;
         }
     }
     return cmd;
 }
 
+// Remember what a geometry draw covers, so it can be reordered by ReorderRenderCommands()
+static void SetDrawCmdBounds(SDL_Renderer *renderer, SDL_RenderCommand *cmd, const float *xy, int xy_stride, int num_vertices, float scale_x, float scale_y)
+{
+    float minx, miny, maxx, maxy;
+    int i;
+
+    if (num_vertices <= 0 || renderer->vertex_data_used <= cmd->data.draw.first) {
+        return;
+    }
+
+    minx = maxx = xy[0];
+    miny = maxy = xy[1];
+    for (i = 1; i < num_vertices; ++i) {
+        const float *v = (const float *)((const Uint8 *)xy + i * xy_stride);
+        minx = SDL_min(minx, v[0]);
+        maxx = SDL_max(maxx, v[0]);
+        miny = SDL_min(miny, v[1]);
+        maxy = SDL_max(maxy, v[1]);
+    }
+    if (scale_x < 0.0f) {
+        float tmp = minx;
+        minx = maxx;
+        maxx = tmp;
+    }
+    if (scale_y < 0.0f) {
+        float tmp = miny;
+        miny = maxy;
+        maxy = tmp;
+    }
+
+    cmd->data.draw.bounds.x = minx * scale_x;
+    cmd->data.draw.bounds.y = miny * scale_y;
+    cmd->data.draw.bounds.w = (maxx - minx) * scale_x;
+    cmd->data.draw.bounds.h = (maxy - miny) * scale_y;
+    cmd->data.draw.vertex_end = renderer->vertex_data_used;
+}
+
 static bool QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
@@ -664,6 +997,8 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
 
                 if (!result) {
                     cmd->command = SDL_RENDERCMD_NO_OP;
+                } else if (renderer->reorder_draws) {
+                    SetDrawCmdBounds(renderer, cmd, xy, xy_stride, num_vertices, 1.0f, 1.0f);
                 }
             }
             SDL_small_free(xy, isstack1);
@@ -679,11 +1014,65 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
     return result;
 }
 
+/* Textures in an atlas are drawn from their page texture, so draws from the
+ * same page batch together, but keep their own color, blend and scale modes. */
+static SDL_Texture *GetAtlasPageTexture(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture)
+{
+    SDL_Texture *page = texture->atlas->pages[texture->atlas_page].texture;
+
+    if (page->native) {
+        page = page->native;
+    }
+    page->last_command_generation = renderer->render_command_generation;
+    cmd->data.draw.texture = page;
+    return page;
+}
+
+static void GetAtlasSrcRect(const SDL_Texture *texture, const SDL_FRect *srcrect, SDL_FRect *atlas_srcrect)
+{
+    atlas_srcrect->x = srcrect->x + texture->atlas_rect.x;
+    atlas_srcrect->y = srcrect->y + texture->atlas_rect.y;
+    atlas_srcrect->w = srcrect->w;
+    atlas_srcrect->h = srcrect->h;
+}
+
+static const float *GetAtlasTextureCoordinates(SDL_Renderer *renderer, const SDL_Texture *texture, const float *uv, int uv_stride, int num_vertices)
+{
+    const size_t size = (size_t)num_vertices * 2 * sizeof(float);
+    const float page_w = (float)texture->atlas->page_w;
+    const float page_h = (float)texture->atlas->page_h;
+    float *atlas_uv;
+    int i;
+
+    if (renderer->atlas_uv_allocation < size) {
+        float *ptr = (float *)SDL_realloc(renderer->atlas_uv, size);
+        if (!ptr) {
+            return NULL;
+        }
+        renderer->atlas_uv = ptr;
+        renderer->atlas_uv_allocation = size;
+    }
+    atlas_uv = renderer->atlas_uv;
+
+    for (i = 0; i < num_vertices; ++i) {
+        const float *uv_ = (const float *)((const char *)uv + i * uv_stride);
+        atlas_uv[i * 2 + 0] = (texture->atlas_rect.x + uv_[0] * texture->w) / page_w;
+        atlas_uv[i * 2 + 1] = (texture->atlas_rect.y + uv_[1] * texture->h) / page_h;
+    }
+    return atlas_uv;
+}
+
 static bool QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_COPY, texture);
     bool result = false;
     if (cmd) {
+        SDL_FRect atlas_srcrect;
+        if (texture->atlas) {
+            GetAtlasSrcRect(texture, srcrect, &atlas_srcrect);
+            srcrect = &atlas_srcrect;
+            texture = GetAtlasPageTexture(renderer, cmd, texture);
+        }
         result = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
@@ -699,6 +1088,12 @@ static bool QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_COPY_EX, texture);
     bool result = false;
     if (cmd) {
+        SDL_FRect atlas_srcquad;
+        if (texture->atlas) {
+            GetAtlasSrcRect(texture, srcquad, &atlas_srcquad);
+            srcquad = &atlas_srcquad;
+            texture = GetAtlasPageTexture(renderer, cmd, texture);
+        }
         result = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip, scale_x, scale_y);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
@@ -720,6 +1115,15 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
         cmd->data.draw.texture_address_mode = texture_address_mode;
+        if (texture && texture->atlas) {
+            uv = GetAtlasTextureCoordinates(renderer, texture, uv, uv_stride, num_vertices);
+            if (!uv) {
+                cmd->command = SDL_RENDERCMD_NO_OP;
+                return false;
+            }
+            uv_stride = 2 * sizeof(float);
+            texture = GetAtlasPageTexture(renderer, cmd, texture);
+        }
         result = renderer->QueueGeometry(renderer, cmd, texture,
                                          xy, xy_stride,
                                          color, color_stride, uv, uv_stride,
@@ -727,6 +1131,8 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else if (renderer->reorder_draws) {
+            SetDrawCmdBounds(renderer, cmd, xy, xy_stride, num_vertices, scale_x, scale_y);
         }
     }
     return result;
@@ -956,7 +1362,7 @@ static void SDL_CalculateSimulatedVSyncInterval(SDL_Renderer *renderer, SDL_Wind
 #endif // !SDL_RENDER_DISABLED
 
 
-SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
+static SDL_Renderer *SDL_CreateRendererWithPropertiesInternal(SDL_PropertiesID props)
 {
 #ifndef SDL_RENDER_DISABLED
     SDL_Window *window = (SDL_Window *)SDL_GetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, NULL);
@@ -1086,6 +1492,8 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
         renderer->line_method = SDL_GetRenderLineMethod();
     }
 
+    renderer->reorder_draws = SDL_GetHintBoolean(SDL_HINT_RENDER_REORDER_DRAWS, false);
+
     renderer->SDR_white_point = 1.0f;
     renderer->HDR_headroom = 1.0f;
     renderer->desired_color_scale = 1.0f;
@@ -1113,7 +1521,7 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
     UpdateHDRProperties(renderer);
 
     if (window) {
-        SDL_SetPointerProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_RENDERER_POINTER, renderer);
+        SDL_SetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_renderer_key, renderer);
         SDL_AddWindowRenderer(window, renderer);
     }
 
@@ -1157,6 +1565,14 @@ error:
 #endif
 }
 
+SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_RENDER);
+    SDL_Renderer *result = SDL_CreateRendererWithPropertiesInternal(props);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 SDL_Renderer *SDL_CreateRenderer(SDL_Window *window, const char *name)
 {
     SDL_Renderer *renderer;
@@ -1191,7 +1607,7 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
 
 SDL_Renderer *SDL_GetRenderer(SDL_Window *window)
 {
-    return (SDL_Renderer *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_RENDERER_POINTER, NULL);
+    return (SDL_Renderer *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_renderer_key, NULL);
 }
 
 SDL_Window *SDL_GetRenderWindow(SDL_Renderer *renderer)
@@ -1339,7 +1755,7 @@ static SDL_PixelFormat GetClosestSupportedFormat(SDL_Renderer *renderer, SDL_Pix
     return renderer->texture_formats[0];
 }
 
-SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
+static SDL_Texture *SDL_CreateTextureWithPropertiesInternal(SDL_Renderer *renderer, SDL_PropertiesID props)
 {
     SDL_Texture *texture;
     SDL_PixelFormat format = (SDL_PixelFormat)SDL_GetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
@@ -1456,7 +1872,7 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
             return NULL;
         }
 
-        SDL_SetPointerProperty(SDL_GetTextureProperties(texture->native), SDL_PROP_TEXTURE_PARENT_POINTER, texture);
+        SDL_SetPointerPropertyByKey(SDL_GetTextureProperties(texture->native), &SDL_texture_parent_key, texture);
 
         // Swap textures to have texture before texture->native in the list
         texture->native->next = texture->next;
@@ -1505,17 +1921,46 @@ SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_Propert
     if (texture->HDR_headroom > 0.0f) {
         SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
     }
+
+    // A texture in a format the renderer doesn't support is accounted with the memory of its native texture
+    size_t texture_bytes = 0;
+    if (texture->native) {
+        SDL_UntrackMemoryObject(texture->native);
+    }
+    SDL_CalculateSurfaceSize(texture->native ? texture->native->format : texture->format, w, h, &texture_bytes, NULL, true);
+    if (texture->pixels) {
+        texture_bytes += (size_t)texture->pitch * h;
+    }
+    SDL_TrackMemoryObject(texture, SDL_MEMORY_OBJECT_TEXTURE, texture_bytes, &texture->props, NULL);
     return texture;
 }
 
+SDL_Texture *SDL_CreateTextureWithProperties(SDL_Renderer *renderer, SDL_PropertiesID props)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_RENDER);
+    SDL_Texture *result = SDL_CreateTextureWithPropertiesInternal(renderer, props);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 SDL_Texture *SDL_CreateTexture(SDL_Renderer *renderer, SDL_PixelFormat format, SDL_TextureAccess access, int w, int h)
 {
     SDL_Texture *texture;
+    SDL_PropertyValue values[4];
     SDL_PropertiesID props = SDL_CreateProperties();
-    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER, format);
-    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER, access);
-    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER, w);
-    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER, h);
+    values[0].name = SDL_PROP_TEXTURE_CREATE_FORMAT_NUMBER;
+    values[0].type = SDL_PROPERTY_TYPE_NUMBER;
+    values[0].value.number_value = format;
+    values[1].name = SDL_PROP_TEXTURE_CREATE_ACCESS_NUMBER;
+    values[1].type = SDL_PROPERTY_TYPE_NUMBER;
+    values[1].value.number_value = access;
+    values[2].name = SDL_PROP_TEXTURE_CREATE_WIDTH_NUMBER;
+    values[2].type = SDL_PROPERTY_TYPE_NUMBER;
+    values[2].value.number_value = w;
+    values[3].name = SDL_PROP_TEXTURE_CREATE_HEIGHT_NUMBER;
+    values[3].type = SDL_PROPERTY_TYPE_NUMBER;
+    values[3].value.number_value = h;
+    SDL_SetProperties(props, values, SDL_arraysize(values));
     texture = SDL_CreateTextureWithProperties(renderer, props);
     SDL_DestroyProperties(props);
     return texture;
@@ -1992,6 +2437,16 @@ bool SDL_GetTextureScaleMode(SDL_Texture *texture, SDL_ScaleMode *scaleMode)
     return true;
 }
 
+// Only uploads that reach the backend are counted, so converted textures aren't counted twice
+static void CountTextureUpload(SDL_Texture *texture, const SDL_Rect *rect)
+{
+    size_t size = 0;
+
+    if (SDL_CalculateSurfaceSize(texture->format, rect->w, rect->h, &size, NULL, true)) {
+        texture->renderer->frame_upload_bytes += size;
+    }
+}
+
 #ifdef SDL_HAVE_YUV
 static bool SDL_UpdateTextureYUV(SDL_Texture *texture, const SDL_Rect *rect,
                                 const void *pixels, int pitch)
@@ -2104,6 +2559,10 @@ bool SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *p
 
     if (real_rect.w == 0 || real_rect.h == 0) {
         return true; // nothing to do.
+    } else if (texture->atlas) {
+        real_rect.x += texture->atlas_rect.x;
+        real_rect.y += texture->atlas_rect.y;
+        return SDL_UpdateTexture(texture->atlas->pages[texture->atlas_page].texture, &real_rect, pixels, pitch);
 #ifdef SDL_HAVE_YUV
     } else if (texture->yuv) {
         return SDL_UpdateTextureYUV(texture, &real_rect, pixels, pitch);
@@ -2115,6 +2574,7 @@ bool SDL_UpdateTexture(SDL_Texture *texture, const SDL_Rect *rect, const void *p
         if (!FlushRenderCommandsIfTextureNeeded(texture)) {
             return false;
         }
+        CountTextureUpload(texture, &real_rect);
         return renderer->UpdateTexture(renderer, texture, &real_rect, pixels, pitch);
     }
 }
@@ -2280,6 +2740,7 @@ bool SDL_UpdateYUVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (!FlushRenderCommandsIfTextureNeeded(texture)) {
                 return false;
             }
+            CountTextureUpload(texture, &real_rect);
             return renderer->UpdateTextureYUV(renderer, texture, &real_rect, Yplane, Ypitch, Uplane, Upitch, Vplane, Vpitch);
         } else {
             return SDL_Unsupported();
@@ -2340,6 +2801,7 @@ bool SDL_UpdateNVTexture(SDL_Texture *texture, const SDL_Rect *rect,
             if (!FlushRenderCommandsIfTextureNeeded(texture)) {
                 return false;
             }
+            CountTextureUpload(texture, &real_rect);
             return renderer->UpdateTextureNV(renderer, texture, &real_rect, Yplane, Ypitch, UVplane, UVpitch);
         } else {
             return SDL_Unsupported();
@@ -2403,6 +2865,7 @@ bool SDL_LockTexture(SDL_Texture *texture, const SDL_Rect *rect, void **pixels,
         if (!FlushRenderCommandsIfTextureNeeded(texture)) {
             return false;
         }
+        texture->locked_rect = *rect;
         return renderer->LockTexture(renderer, texture, rect, pixels, pitch);
     }
 }
@@ -2497,6 +2960,7 @@ void SDL_UnlockTexture(SDL_Texture *texture)
         SDL_UnlockTextureNative(texture);
     } else {
         SDL_Renderer *renderer = texture->renderer;
+        CountTextureUpload(texture, &texture->locked_rect);
         renderer->UnlockTexture(renderer, texture);
     }
 
@@ -2562,7 +3026,7 @@ SDL_Texture *SDL_GetRenderTarget(SDL_Renderer *renderer)
     if (!renderer->target) {
         return NULL;
     }
-    return (SDL_Texture *) SDL_GetPointerProperty(SDL_GetTextureProperties(renderer->target), SDL_PROP_TEXTURE_PARENT_POINTER, renderer->target);
+    return (SDL_Texture *) SDL_GetPointerPropertyByKey(SDL_GetTextureProperties(renderer->target), &SDL_texture_parent_key, renderer->target);
 }
 
 static void UpdateLogicalPresentation(SDL_Renderer *renderer)
@@ -3751,9 +4215,48 @@ bool SDL_RenderFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, int cou
         frects[i].y = rects[i].y * scale_y;
         frects[i].w = rects[i].w * scale_x;
         frects[i].h = rects[i].h * scale_y;
+
+        // Normalize flipped rects, they fill the same area and would otherwise be culled
+        if (frects[i].w < 0.0f) {
+            frects[i].x += frects[i].w;
+            frects[i].w = -frects[i].w;
+        }
+        if (frects[i].h < 0.0f) {
+            frects[i].y += frects[i].h;
+            frects[i].h = -frects[i].h;
+        }
     }
 
-    result = QueueCmdFillRects(renderer, frects, count);
+    // Drop the rects that are entirely outside of the clip rect or viewport
+    if (count > 1) {
+        SDL_FRect visible;
+        bool indices_isstack;
+        int *indices = SDL_small_alloc(int, count, &indices_isstack);
+        if (indices) {
+            if (view->clipping_enabled) {
+                visible.x = (float)view->pixel_clip_rect.x;
+                visible.y = (float)view->pixel_clip_rect.y;
+                visible.w = (float)view->pixel_clip_rect.w;
+                visible.h = (float)view->pixel_clip_rect.h;
+            } else {
+                visible.x = 0.0f;
+                visible.y = 0.0f;
+                visible.w = (float)view->pixel_viewport.w;
+                visible.h = (float)view->pixel_viewport.h;
+            }
+
+            const int visible_count = SDL_GetIntersectingRectsFloat(frects, count, &visible, indices);
+            if (visible_count >= 0 && visible_count < count) {
+                for (i = 0; i < visible_count; ++i) {
+                    frects[i] = frects[indices[i]];
+                }
+                count = visible_count;
+            }
+            SDL_small_free(indices, indices_isstack);
+        }
+    }
+
+    result = (count > 0) ? QueueCmdFillRects(renderer, frects, count) : true;
 
     SDL_small_free(frects, isstack);
 
@@ -4282,7 +4785,7 @@ bool SDL_RenderTextureTiled(SDL_Renderer *renderer, SDL_Texture *texture, const
     texture->last_command_generation = renderer->render_command_generation;
 
     // See if we can use geometry with repeating texture coordinates
-    if (!renderer->software &&
+    if (!renderer->software && !texture->atlas &&
         (!srcrect ||
          (real_srcrect.x == 0.0f && real_srcrect.y == 0.0f &&
           real_srcrect.w == (float)texture->w && real_srcrect.h == (float)texture->h))) {
@@ -4899,6 +5402,10 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
         }
     }
 
+    if (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP && texture && texture->atlas) {
+        return SDL_SetError("Texture coordinates outside of atlas textures aren't supported");
+    }
+
     if (indices) {
         for (i = 0; i < num_indices; ++i) {
             int j;
@@ -4936,88 +5443,650 @@ bool SDL_RenderGeometryRaw(SDL_Renderer *renderer,
                             texture_address_mode);
 }
 
-SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+// Expand texture instances into quads, appending to vertices and indices at *num_vertices and *num_indices
+static void GenerateTextureInstanceGeometry(SDL_Texture *texture, const SDL_TextureInstance *instances, int count, const SDL_FColor *texture_color, SDL_Vertex *vertices, int *indices, int *num_vertices, int *num_indices)
 {
-    CHECK_RENDERER_MAGIC(renderer, NULL);
+    const SDL_FRect texture_rect = { 0.0f, 0.0f, (float)texture->w, (float)texture->h };
+    int i;
 
-    if (!renderer->RenderReadPixels) {
-        SDL_Unsupported();
-        return NULL;
-    }
+    for (i = 0; i < count; ++i) {
+        const SDL_TextureInstance *instance = &instances[i];
+        const SDL_FRect *dstrect = &instance->dstrect;
+        SDL_FRect srcrect;
+        SDL_FColor color;
+        float minu, minv, maxu, maxv;
+        float minx, miny, maxx, maxy;
+        float centerx, centery;
+        SDL_Vertex *v = &vertices[*num_vertices];
+        int j;
 
-    FlushRenderCommands(renderer); // we need to render before we read the results.
+        if (!SDL_GetRectIntersectionFloat(&instance->srcrect, &texture_rect, &srcrect)) {
+            continue;
+        }
 
-    SDL_Rect real_rect = renderer->view->pixel_viewport;
+        minu = srcrect.x / texture->w;
+        minv = srcrect.y / texture->h;
+        maxu = (srcrect.x + srcrect.w) / texture->w;
+        maxv = (srcrect.y + srcrect.h) / texture->h;
 
-    if (rect) {
-        if (!SDL_GetRectIntersection(rect, &real_rect, &real_rect)) {
-            SDL_SetError("Can't read outside the current viewport");
-            return NULL;
-        }
-    }
+        color.r = instance->color.r * texture_color->r;
+        color.g = instance->color.g * texture_color->g;
+        color.b = instance->color.b * texture_color->b;
+        color.a = instance->color.a * texture_color->a;
 
-    SDL_Surface *surface = renderer->RenderReadPixels(renderer, &real_rect);
-    if (surface) {
-        SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
-
-        if (renderer->target) {
-            SDL_Texture *target = renderer->target;
-            SDL_Texture *parent = SDL_GetPointerProperty(SDL_GetTextureProperties(target), SDL_PROP_TEXTURE_PARENT_POINTER, NULL);
-            SDL_PixelFormat expected_format = (parent ? parent->format : target->format);
-
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, target->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, target->HDR_headroom);
-
-            // Set the expected surface format
-            if ((surface->format == SDL_PIXELFORMAT_ARGB8888 && expected_format == SDL_PIXELFORMAT_XRGB8888) ||
-                (surface->format == SDL_PIXELFORMAT_RGBA8888 && expected_format == SDL_PIXELFORMAT_RGBX8888) ||
-                (surface->format == SDL_PIXELFORMAT_ABGR8888 && expected_format == SDL_PIXELFORMAT_XBGR8888) ||
-                (surface->format == SDL_PIXELFORMAT_BGRA8888 && expected_format == SDL_PIXELFORMAT_BGRX8888)) {
-                surface->format = expected_format;
-                surface->fmt = SDL_GetPixelFormatDetails(expected_format);
-            }
-        } else {
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, renderer->SDR_white_point);
-            SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, renderer->HDR_headroom);
-        }
-    }
-    return surface;
-}
+        minx = dstrect->x;
+        miny = dstrect->y;
+        maxx = dstrect->x + dstrect->w;
+        maxy = dstrect->y + dstrect->h;
 
-static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
-{
-    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_SHAPE_POINTER, NULL);
-    if (shape != renderer->shape_surface) {
-        if (renderer->shape_texture) {
-            SDL_DestroyTexture(renderer->shape_texture);
-            renderer->shape_texture = NULL;
+        v[0].position.x = minx;
+        v[0].position.y = miny;
+        v[1].position.x = maxx;
+        v[1].position.y = miny;
+        v[2].position.x = maxx;
+        v[2].position.y = maxy;
+        v[3].position.x = minx;
+        v[3].position.y = maxy;
+
+        if (instance->angle != 0.0f) {
+            const float radian_angle = (float)((SDL_PI_D * instance->angle) / 180.0);
+            const float s = SDL_sinf(radian_angle);
+            const float c = SDL_cosf(radian_angle);
+
+            centerx = dstrect->x + dstrect->w / 2.0f;
+            centery = dstrect->y + dstrect->h / 2.0f;
+
+            /* apply rotation with 2x2 matrix ( c -s )
+             *                                ( s  c ) */
+            for (j = 0; j < 4; ++j) {
+                const float x = v[j].position.x - centerx;
+                const float y = v[j].position.y - centery;
+                v[j].position.x = (c * x - s * y) + centerx;
+                v[j].position.y = (s * x + c * y) + centery;
+            }
         }
 
-        if (shape) {
-            // There's nothing we can do if this fails, so just keep on going
-            renderer->shape_texture = SDL_CreateTextureFromSurface(renderer, shape);
+        v[0].tex_coord.x = minu;
+        v[0].tex_coord.y = minv;
+        v[1].tex_coord.x = maxu;
+        v[1].tex_coord.y = minv;
+        v[2].tex_coord.x = maxu;
+        v[2].tex_coord.y = maxv;
+        v[3].tex_coord.x = minu;
+        v[3].tex_coord.y = maxv;
 
-            SDL_SetTextureBlendMode(renderer->shape_texture,
-                SDL_ComposeCustomBlendMode(
-                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
-                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        for (j = 0; j < 4; ++j) {
+            v[j].color = color;
         }
-        renderer->shape_surface = shape;
-    }
-
-    if (renderer->shape_texture) {
-        SDL_RenderTexture(renderer, renderer->shape_texture, NULL, NULL);
+        for (j = 0; j < 6; ++j) {
+            indices[(*num_indices)++] = *num_vertices + rect_index_order[j];
+        }
+        *num_vertices += 4;
     }
 }
 
-static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
+bool SDL_RenderTextureInstances(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureInstance *instances, int count)
 {
-    Uint64 now, elapsed;
-    const Uint64 interval = renderer->simulate_vsync_interval_ns;
+    SDL_Vertex *vertices;
+    int *indices;
+    size_t size;
+    int num_vertices = 0, num_indices = 0;
 
-    if (!interval) {
-        // We can't do sub-ns delay, so just return here
-        return;
+    CHECK_RENDERER_MAGIC(renderer, false);
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!instances) {
+        return SDL_InvalidParamError("instances");
+    }
+    if (count < 0 || count > SDL_MAX_SINT32 / 6) {
+        return SDL_InvalidParamError("count");
+    }
+    if (count == 0) {
+        return true;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
+    // Expand all the instances into one geometry draw
+    size = (size_t)count * (4 * sizeof(SDL_Vertex) + 6 * sizeof(int));
+    if (renderer->instance_data_allocation < size) {
+        void *ptr = SDL_realloc(renderer->instance_data, size);
+        if (!ptr) {
+            return false;
+        }
+        renderer->instance_data = ptr;
+        renderer->instance_data_allocation = size;
+    }
+    vertices = (SDL_Vertex *)renderer->instance_data;
+    indices = (int *)(vertices + 4 * count);
+
+    GenerateTextureInstanceGeometry(texture, instances, count, &texture->color, vertices, indices, &num_vertices, &num_indices);
+
+    if (num_vertices == 0) {
+        return true;
+    }
+
+    return SDL_RenderGeometryRaw(renderer, texture,
+                                 &vertices->position.x, sizeof(*vertices),
+                                 &vertices->color, sizeof(*vertices),
+                                 &vertices->tex_coord.x, sizeof(*vertices),
+                                 num_vertices, indices, num_indices, sizeof(*indices));
+}
+
+typedef struct SDL_RenderCommandListDraw
+{
+    SDL_Texture *texture;
+    int first_vertex;
+    int num_vertices;
+    int first_index;
+    int num_indices;    // Indices are relative to first_vertex
+} SDL_RenderCommandListDraw;
+
+struct SDL_RenderCommandList
+{
+    SDL_Renderer *renderer;
+    SDL_Vertex *vertices;
+    int num_vertices;
+    int max_vertices;
+    int *indices;
+    int num_indices;
+    int max_indices;
+    SDL_RenderCommandListDraw *draws;
+    int num_draws;
+    int max_draws;
+};
+
+SDL_RenderCommandList *SDL_CreateRenderCommandList(SDL_Renderer *renderer)
+{
+    SDL_RenderCommandList *list;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    list = (SDL_RenderCommandList *)SDL_calloc(1, sizeof(*list));
+    if (!list) {
+        return NULL;
+    }
+    list->renderer = renderer;
+    return list;
+}
+
+// Make room for more geometry and return the draw it should be appended to
+static SDL_RenderCommandListDraw *ReserveRenderCommandListDraw(SDL_RenderCommandList *list, SDL_Texture *texture, int num_vertices, int num_indices)
+{
+    SDL_RenderCommandListDraw *draw;
+
+    if (num_vertices > SDL_MAX_SINT32 - list->num_vertices ||
+        num_indices > SDL_MAX_SINT32 - list->num_indices) {
+        SDL_SetError("Render command list is too large");
+        return NULL;
+    }
+
+    if (list->num_vertices + num_vertices > list->max_vertices) {
+        int max_vertices = SDL_max(list->max_vertices * 2, list->num_vertices + num_vertices);
+        SDL_Vertex *vertices = (SDL_Vertex *)SDL_realloc(list->vertices, (size_t)max_vertices * sizeof(*vertices));
+        if (!vertices) {
+            return NULL;
+        }
+        list->vertices = vertices;
+        list->max_vertices = max_vertices;
+    }
+    if (list->num_indices + num_indices > list->max_indices) {
+        int max_indices = SDL_max(list->max_indices * 2, list->num_indices + num_indices);
+        int *indices = (int *)SDL_realloc(list->indices, (size_t)max_indices * sizeof(*indices));
+        if (!indices) {
+            return NULL;
+        }
+        list->indices = indices;
+        list->max_indices = max_indices;
+    }
+
+    // Consecutive draws with the same texture are merged into one
+    if (list->num_draws > 0 && list->draws[list->num_draws - 1].texture == texture) {
+        return &list->draws[list->num_draws - 1];
+    }
+
+    if (list->num_draws == list->max_draws) {
+        int max_draws = SDL_max(list->max_draws * 2, 16);
+        SDL_RenderCommandListDraw *draws = (SDL_RenderCommandListDraw *)SDL_realloc(list->draws, (size_t)max_draws * sizeof(*draws));
+        if (!draws) {
+            return NULL;
+        }
+        list->draws = draws;
+        list->max_draws = max_draws;
+    }
+    draw = &list->draws[list->num_draws++];
+    draw->texture = texture;
+    draw->first_vertex = list->num_vertices;
+    draw->num_vertices = 0;
+    draw->first_index = list->num_indices;
+    draw->num_indices = 0;
+    return draw;
+}
+
+bool SDL_RecordRenderTextureInstances(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_TextureInstance *instances, int count)
+{
+    static const SDL_FColor white = { 1.0f, 1.0f, 1.0f, 1.0f };
+    SDL_RenderCommandListDraw *draw;
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    if (list->renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!instances) {
+        return SDL_InvalidParamError("instances");
+    }
+    if (count < 0 || count > SDL_MAX_SINT32 / 6) {
+        return SDL_InvalidParamError("count");
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    draw = ReserveRenderCommandListDraw(list, texture, 4 * count, 6 * count);
+    if (!draw) {
+        return false;
+    }
+
+    // The texture color and alpha modulation are applied when the list is submitted
+    GenerateTextureInstanceGeometry(texture, instances, count, &white,
+                                    &list->vertices[draw->first_vertex], &list->indices[draw->first_index],
+                                    &draw->num_vertices, &draw->num_indices);
+    list->num_vertices = draw->first_vertex + draw->num_vertices;
+    list->num_indices = draw->first_index + draw->num_indices;
+    return true;
+}
+
+bool SDL_RecordRenderTexture(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_FRect *srcrect, const SDL_FRect *dstrect)
+{
+    SDL_TextureInstance instance;
+
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    // The render target size isn't known until submission, so there's no default destination
+    if (!dstrect) {
+        return SDL_InvalidParamError("dstrect");
+    }
+
+    if (srcrect) {
+        instance.srcrect = *srcrect;
+    } else {
+        instance.srcrect.x = 0.0f;
+        instance.srcrect.y = 0.0f;
+        instance.srcrect.w = (float)texture->w;
+        instance.srcrect.h = (float)texture->h;
+    }
+    instance.dstrect = *dstrect;
+    instance.color.r = 1.0f;
+    instance.color.g = 1.0f;
+    instance.color.b = 1.0f;
+    instance.color.a = 1.0f;
+    instance.angle = 0.0f;
+
+    return SDL_RecordRenderTextureInstances(list, texture, &instance, 1);
+}
+
+bool SDL_RecordRenderGeometry(SDL_RenderCommandList *list, SDL_Texture *texture, const SDL_Vertex *vertices, int num_vertices, const int *indices, int num_indices)
+{
+    SDL_RenderCommandListDraw *draw;
+    int i;
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+    if (texture) {
+        CHECK_TEXTURE_MAGIC(texture, false);
+
+        if (list->renderer != texture->renderer) {
+            return SDL_SetError("Texture was not created with this renderer");
+        }
+    }
+    if (!vertices) {
+        return SDL_InvalidParamError("vertices");
+    }
+    if (num_vertices < 3) {
+        return SDL_InvalidParamError("num_vertices");
+    }
+    if (!indices) {
+        num_indices = num_vertices;
+    } else if (num_indices < 3) {
+        return SDL_InvalidParamError("num_indices");
+    }
+    if (num_indices % 3 != 0) {
+        return SDL_InvalidParamError(indices ? "num_indices" : "num_vertices");
+    }
+    if (indices) {
+        for (i = 0; i < num_indices; ++i) {
+            if (indices[i] < 0 || indices[i] >= num_vertices) {
+                return SDL_SetError("Values of 'indices' out of bounds");
+            }
+        }
+    }
+
+    draw = ReserveRenderCommandListDraw(list, texture, num_vertices, num_indices);
+    if (!draw) {
+        return false;
+    }
+
+    SDL_memcpy(&list->vertices[draw->first_vertex + draw->num_vertices], vertices, (size_t)num_vertices * sizeof(*vertices));
+    for (i = 0; i < num_indices; ++i) {
+        list->indices[draw->first_index + draw->num_indices + i] = draw->num_vertices + (indices ? indices[i] : i);
+    }
+    draw->num_vertices += num_vertices;
+    draw->num_indices += num_indices;
+    list->num_vertices = draw->first_vertex + draw->num_vertices;
+    list->num_indices = draw->first_index + draw->num_indices;
+    return true;
+}
+
+bool SDL_SubmitRenderCommandList(SDL_Renderer *renderer, SDL_RenderCommandList *list)
+{
+    int i;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (!list) {
+        return SDL_InvalidParamError("list");
+    }
+    if (list->renderer != renderer) {
+        return SDL_SetError("Render command list was not created with this renderer");
+    }
+
+    for (i = 0; i < list->num_draws; ++i) {
+        const SDL_RenderCommandListDraw *draw = &list->draws[i];
+        SDL_Texture *texture = draw->texture;
+        SDL_Vertex *vertices = &list->vertices[draw->first_vertex];
+
+        if (texture) {
+            CHECK_TEXTURE_MAGIC(texture, false);
+
+            if (texture->color.r != 1.0f || texture->color.g != 1.0f ||
+                texture->color.b != 1.0f || texture->color.a != 1.0f) {
+                // Apply the current texture color and alpha modulation to recorded sprites
+                const size_t size = (size_t)draw->num_vertices * sizeof(SDL_Vertex);
+                int j;
+
+                if (renderer->instance_data_allocation < size) {
+                    void *ptr = SDL_realloc(renderer->instance_data, size);
+                    if (!ptr) {
+                        return false;
+                    }
+                    renderer->instance_data = ptr;
+                    renderer->instance_data_allocation = size;
+                }
+                SDL_memcpy(renderer->instance_data, vertices, size);
+                vertices = (SDL_Vertex *)renderer->instance_data;
+                for (j = 0; j < draw->num_vertices; ++j) {
+                    vertices[j].color.r *= texture->color.r;
+                    vertices[j].color.g *= texture->color.g;
+                    vertices[j].color.b *= texture->color.b;
+                    vertices[j].color.a *= texture->color.a;
+                }
+            }
+        }
+
+        if (!SDL_RenderGeometryRaw(renderer, texture,
+                                   &vertices->position.x, sizeof(*vertices),
+                                   &vertices->color, sizeof(*vertices),
+                                   &vertices->tex_coord.x, sizeof(*vertices),
+                                   draw->num_vertices, &list->indices[draw->first_index], draw->num_indices, sizeof(int))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SDL_ResetRenderCommandList(SDL_RenderCommandList *list)
+{
+    if (list) {
+        list->num_vertices = 0;
+        list->num_indices = 0;
+        list->num_draws = 0;
+    }
+}
+
+void SDL_DestroyRenderCommandList(SDL_RenderCommandList *list)
+{
+    if (list) {
+        SDL_free(list->vertices);
+        SDL_free(list->indices);
+        SDL_free(list->draws);
+        SDL_free(list);
+    }
+}
+
+// Get the state of the render target that's needed to describe pixels read from it
+static void GetReadPixelsState(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    if (renderer->target) {
+        SDL_Texture *target = renderer->target;
+        SDL_Texture *parent = SDL_GetPointerPropertyByKey(SDL_GetTextureProperties(target), &SDL_texture_parent_key, NULL);
+
+        readback->expected_format = (parent ? parent->format : target->format);
+        readback->SDR_white_point = target->SDR_white_point;
+        readback->HDR_headroom = target->HDR_headroom;
+    } else {
+        readback->expected_format = SDL_PIXELFORMAT_UNKNOWN;
+        readback->SDR_white_point = renderer->SDR_white_point;
+        readback->HDR_headroom = renderer->HDR_headroom;
+    }
+}
+
+static void SetupReadPixelsSurface(const SDL_RenderReadback *readback, SDL_Surface *surface)
+{
+    SDL_PropertiesID props = SDL_GetSurfaceProperties(surface);
+    SDL_PixelFormat expected_format = readback->expected_format;
+
+    SDL_SetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, readback->SDR_white_point);
+    SDL_SetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, readback->HDR_headroom);
+
+    // Set the expected surface format
+    if ((surface->format == SDL_PIXELFORMAT_ARGB8888 && expected_format == SDL_PIXELFORMAT_XRGB8888) ||
+        (surface->format == SDL_PIXELFORMAT_RGBA8888 && expected_format == SDL_PIXELFORMAT_RGBX8888) ||
+        (surface->format == SDL_PIXELFORMAT_ABGR8888 && expected_format == SDL_PIXELFORMAT_XBGR8888) ||
+        (surface->format == SDL_PIXELFORMAT_BGRA8888 && expected_format == SDL_PIXELFORMAT_BGRX8888)) {
+        surface->format = expected_format;
+        surface->fmt = SDL_GetPixelFormatDetails(expected_format);
+    }
+}
+
+static bool GetReadPixelsRect(SDL_Renderer *renderer, const SDL_Rect *rect, SDL_Rect *real_rect)
+{
+    *real_rect = renderer->view->pixel_viewport;
+
+    if (rect) {
+        if (!SDL_GetRectIntersection(rect, real_rect, real_rect)) {
+            return SDL_SetError("Can't read outside the current viewport");
+        }
+    }
+    return true;
+}
+
+SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_RenderReadback readback;
+    SDL_Rect real_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    FlushRenderCommands(renderer); // we need to render before we read the results.
+
+    if (!GetReadPixelsRect(renderer, rect, &real_rect)) {
+        return NULL;
+    }
+
+    SDL_Surface *surface = renderer->RenderReadPixels(renderer, &real_rect);
+    if (surface) {
+        SDL_zero(readback);
+        GetReadPixelsState(renderer, &readback);
+        SetupReadPixelsSurface(&readback, surface);
+    }
+    return surface;
+}
+
+SDL_RenderReadback *SDL_RenderReadPixelsAsync(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_RenderReadback *readback;
+    SDL_Rect real_rect;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!renderer->RenderReadPixels) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    FlushRenderCommands(renderer); // we need to render before we read the results.
+
+    if (!GetReadPixelsRect(renderer, rect, &real_rect)) {
+        return NULL;
+    }
+
+    readback = (SDL_RenderReadback *)SDL_calloc(1, sizeof(*readback));
+    if (!readback) {
+        return NULL;
+    }
+    readback->renderer = renderer;
+    readback->rect = real_rect;
+    GetReadPixelsState(renderer, readback);
+
+    if (renderer->RenderReadPixelsAsync) {
+        if (!renderer->RenderReadPixelsAsync(renderer, readback)) {
+            SDL_free(readback);
+            return NULL;
+        }
+    } else {
+        // Read the pixels now, the readback is complete right away
+        readback->surface = renderer->RenderReadPixels(renderer, &real_rect);
+        if (!readback->surface) {
+            SDL_free(readback);
+            return NULL;
+        }
+    }
+
+    SDL_SetObjectValid(readback, SDL_OBJECT_TYPE_RENDER_READBACK, true);
+    readback->next = renderer->readbacks;
+    if (renderer->readbacks) {
+        renderer->readbacks->prev = readback;
+    }
+    renderer->readbacks = readback;
+    return readback;
+}
+
+bool SDL_IsRenderReadbackComplete(SDL_RenderReadback *readback)
+{
+    SDL_Renderer *renderer;
+
+    CHECK_RENDER_READBACK_MAGIC(readback, false);
+
+    renderer = readback->renderer;
+    if (readback->surface || !renderer->IsReadbackComplete) {
+        return true;
+    }
+    return renderer->IsReadbackComplete(renderer, readback);
+}
+
+static void SDL_DestroyRenderReadback(SDL_RenderReadback *readback)
+{
+    SDL_Renderer *renderer = readback->renderer;
+
+    SDL_SetObjectValid(readback, SDL_OBJECT_TYPE_RENDER_READBACK, false);
+
+    if (readback->next) {
+        readback->next->prev = readback->prev;
+    }
+    if (readback->prev) {
+        readback->prev->next = readback->next;
+    } else {
+        renderer->readbacks = readback->next;
+    }
+
+    if (readback->internal && renderer->ReleaseReadback) {
+        renderer->ReleaseReadback(renderer, readback);
+    }
+    SDL_DestroySurface(readback->surface);
+    SDL_free(readback);
+}
+
+SDL_Surface *SDL_FinishRenderReadback(SDL_RenderReadback *readback)
+{
+    SDL_Renderer *renderer;
+    SDL_Surface *surface;
+
+    CHECK_RENDER_READBACK_MAGIC(readback, NULL);
+
+    renderer = readback->renderer;
+    if (readback->surface) {
+        surface = readback->surface;
+        readback->surface = NULL;
+    } else {
+        surface = renderer->FinishReadback(renderer, readback);
+    }
+    if (surface) {
+        SetupReadPixelsSurface(readback, surface);
+    }
+
+    SDL_DestroyRenderReadback(readback);
+    return surface;
+}
+
+void SDL_CancelRenderReadback(SDL_RenderReadback *readback)
+{
+    CHECK_RENDER_READBACK_MAGIC(readback, );
+
+    SDL_DestroyRenderReadback(readback);
+}
+
+static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
+{
+    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(renderer->window), &SDL_window_shape_key, NULL);
+    if (shape != renderer->shape_surface) {
+        if (renderer->shape_texture) {
+            SDL_DestroyTexture(renderer->shape_texture);
+            renderer->shape_texture = NULL;
+        }
+
+        if (shape) {
+            // There's nothing we can do if this fails, so just keep on going
+            renderer->shape_texture = SDL_CreateTextureFromSurface(renderer, shape);
+
+            SDL_SetTextureBlendMode(renderer->shape_texture,
+                SDL_ComposeCustomBlendMode(
+                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                    SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        }
+        renderer->shape_surface = shape;
+    }
+
+    if (renderer->shape_texture) {
+        SDL_RenderTexture(renderer, renderer->shape_texture, NULL, NULL);
+    }
+}
+
+static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
+{
+    Uint64 now, elapsed;
+    const Uint64 interval = renderer->simulate_vsync_interval_ns;
+
+    if (!interval) {
+        // We can't do sub-ns delay, so just return here
+        return;
     }
 
     now = SDL_GetTicksNS();
@@ -5037,7 +6106,61 @@ static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
     }
 }
 
-bool SDL_RenderPresent(SDL_Renderer *renderer)
+static void UpdateRenderQueueStats(SDL_Renderer *renderer)
+{
+    SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+    const size_t queue_bytes = renderer->render_commands_allocated * sizeof(SDL_RenderCommand) + renderer->vertex_data_allocation;
+
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_COMMANDS_NUMBER, renderer->frame_commands);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_VERTEX_BYTES_NUMBER, (Sint64)renderer->frame_vertex_bytes);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_ALLOCATIONS_NUMBER, renderer->frame_allocations);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_QUEUE_BYTES_NUMBER, (Sint64)queue_bytes);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_DRAW_CALLS_NUMBER, renderer->frame_draw_calls);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_STATE_CHANGES_NUMBER, renderer->frame_state_changes);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_TEXTURE_BINDS_NUMBER, renderer->frame_texture_binds);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_UPLOAD_BYTES_NUMBER, (Sint64)renderer->frame_upload_bytes);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_FRAME_QUEUE_TIME_NS_NUMBER, (Sint64)renderer->frame_queue_ns);
+
+    renderer->frame_commands = 0;
+    renderer->frame_vertex_bytes = 0;
+    renderer->frame_allocations = 0;
+    renderer->frame_draw_calls = 0;
+    renderer->frame_state_changes = 0;
+    renderer->frame_texture_binds = 0;
+    renderer->frame_upload_bytes = 0;
+    renderer->frame_queue_ns = 0;
+}
+
+bool SDL_SetRenderDamageRects(SDL_Renderer *renderer, const SDL_Rect *rects, int count)
+{
+    CHECK_RENDERER_MAGIC(renderer, false);
+
+    if (!rects) {
+        renderer->damage_rects_set = false;
+        renderer->num_damage_rects = 0;
+        return true;
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    if (count > renderer->damage_rects_allocation) {
+        SDL_Rect *damage_rects = (SDL_Rect *)SDL_realloc(renderer->damage_rects, count * sizeof(*damage_rects));
+        if (!damage_rects) {
+            return false;
+        }
+        renderer->damage_rects = damage_rects;
+        renderer->damage_rects_allocation = count;
+    }
+    if (count > 0) {
+        SDL_memcpy(renderer->damage_rects, rects, count * sizeof(*rects));
+    }
+    renderer->num_damage_rects = count;
+    renderer->damage_rects_set = true;
+    return true;
+}
+
+static bool SDL_RenderPresentInternal(SDL_Renderer *renderer)
 {
     bool presented = true;
 
@@ -5054,16 +6177,26 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
 
     FlushRenderCommands(renderer); // time to send everything to the GPU!
 
+    UpdateRenderQueueStats(renderer);
+
 #if DONT_DRAW_WHILE_HIDDEN
     // Don't present while we're hidden
     if (renderer->hidden) {
         presented = false;
     } else
 #endif
-    if (!renderer->RenderPresent(renderer)) {
-        presented = false;
+    {
+        SDL_TRACE_BEGIN("RenderPresent");
+        if (!renderer->RenderPresent(renderer)) {
+            presented = false;
+        }
+        SDL_TRACE_END("RenderPresent");
     }
 
+    // The damage only applies to one present
+    renderer->damage_rects_set = false;
+    renderer->num_damage_rects = 0;
+
     if (target) {
         SDL_SetRenderTarget(renderer, target);
     }
@@ -5075,10 +6208,53 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
     return true;
 }
 
+bool SDL_RenderPresent(SDL_Renderer *renderer)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_RENDER);
+    SDL_TRACE_BEGIN("SDL_RenderPresent");
+    bool result = SDL_RenderPresentInternal(renderer);
+    SDL_TRACE_END("SDL_RenderPresent");
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
+static void ResetAtlasPage(const SDL_TextureAtlas *atlas, SDL_TextureAtlasPage *page)
+{
+    page->skyline[0].x = 0;
+    page->skyline[0].y = 0;
+    page->skyline[0].w = atlas->page_w;
+    page->num_nodes = 1;
+}
+
+static void SDL_ReleaseAtlasTexture(SDL_Texture *texture)
+{
+    SDL_TextureAtlas *atlas = texture->atlas;
+    SDL_TextureAtlasPage *page = &atlas->pages[texture->atlas_page];
+
+    // The space on a page is reused once all of its textures are gone
+    if (--page->num_textures == 0) {
+        ResetAtlasPage(atlas, page);
+    }
+}
+
+static void SDL_FreeTextureAtlas(SDL_TextureAtlas *atlas)
+{
+    int i;
+
+    SDL_SetObjectValid(atlas, SDL_OBJECT_TYPE_TEXTURE_ATLAS, false);
+
+    for (i = 0; i < atlas->num_pages; ++i) {
+        SDL_free(atlas->pages[i].skyline);
+    }
+    SDL_free(atlas->pages);
+    SDL_free(atlas);
+}
+
 static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying)
 {
     SDL_Renderer *renderer;
 
+    SDL_UntrackMemoryObject(texture);
     SDL_DestroyProperties(texture->props);
 
     renderer = texture->renderer;
@@ -5113,7 +6289,13 @@ static void SDL_DestroyTextureInternal(SDL_Texture *texture, bool is_destroying)
 #endif
     SDL_free(texture->pixels);
 
-    renderer->DestroyTexture(renderer, texture);
+    if (texture->atlas) {
+        if (!is_destroying) {
+            SDL_ReleaseAtlasTexture(texture);
+        }
+    } else {
+        renderer->DestroyTexture(renderer, texture);
+    }
 
     SDL_DestroySurface(texture->locked_surface);
     texture->locked_surface = NULL;
@@ -5132,27 +6314,309 @@ void SDL_DestroyTexture(SDL_Texture *texture)
     SDL_DestroyTextureInternal(texture, false /* is_destroying */);
 }
 
-static void SDL_DiscardAllCommands(SDL_Renderer *renderer)
+static bool AddAtlasPage(SDL_TextureAtlas *atlas)
 {
-    SDL_RenderCommand *cmd;
+    SDL_TextureAtlasPage *pages;
+    SDL_TextureAtlasPage *page;
+    const int pitch = atlas->page_w * SDL_BYTESPERPIXEL(atlas->format);
+    void *pixels;
 
-    if (renderer->render_commands_tail) {
-        renderer->render_commands_tail->next = renderer->render_commands_pool;
-        cmd = renderer->render_commands;
-    } else {
-        cmd = renderer->render_commands_pool;
+    pages = (SDL_TextureAtlasPage *)SDL_realloc(atlas->pages, (atlas->num_pages + 1) * sizeof(*pages));
+    if (!pages) {
+        return false;
+    }
+    atlas->pages = pages;
+
+    page = &pages[atlas->num_pages];
+    SDL_zerop(page);
+
+    // A skyline node is at least a pixel wide, plus one while inserting
+    page->skyline = (SDL_AtlasSkylineNode *)SDL_malloc((atlas->page_w + 1) * sizeof(*page->skyline));
+    if (!page->skyline) {
+        return false;
+    }
+
+    page->texture = SDL_CreateTexture(atlas->renderer, atlas->format, SDL_TEXTUREACCESS_STATIC, atlas->page_w, atlas->page_h);
+    if (!page->texture) {
+        SDL_free(page->skyline);
+        return false;
+    }
+
+    // Clear the page, so the padding around textures is transparent
+    pixels = SDL_calloc(atlas->page_h, pitch);
+    if (!pixels) {
+        SDL_DestroyTexture(page->texture);
+        SDL_free(page->skyline);
+        return false;
+    }
+    SDL_UpdateTexture(page->texture, NULL, pixels, pitch);
+    SDL_free(pixels);
+
+    ResetAtlasPage(atlas, page);
+    ++atlas->num_pages;
+    return true;
+}
+
+// Find the lowest place on a page where a texture fits above the skyline
+static bool FindAtlasPosition(const SDL_TextureAtlas *atlas, const SDL_TextureAtlasPage *page, int w, int h, int *node, int *x, int *y)
+{
+    const SDL_AtlasSkylineNode *skyline = page->skyline;
+    int best_bottom = SDL_MAX_SINT32;
+    int i;
+
+    for (i = 0; i < page->num_nodes; ++i) {
+        const int left = skyline[i].x;
+        int top = 0;
+        int covered = 0;
+        int padded_w;
+        int j;
+
+        if (left + w > atlas->page_w) {
+            break;
+        }
+
+        // The padding is raised along with the texture, so it has to be above the skyline too
+        padded_w = SDL_min(w + SDL_ATLAS_PADDING, atlas->page_w - left);
+        for (j = i; covered < padded_w; ++j) {
+            top = SDL_max(top, skyline[j].y);
+            covered += skyline[j].w;
+        }
+        if (top + h <= atlas->page_h && top + h < best_bottom) {
+            best_bottom = top + h;
+            *node = i;
+            *x = left;
+            *y = top;
+        }
+    }
+    return (best_bottom != SDL_MAX_SINT32);
+}
+
+// Raise the skyline over a newly placed texture and its padding
+static void RaiseAtlasSkyline(const SDL_TextureAtlas *atlas, SDL_TextureAtlasPage *page, int node, const SDL_Rect *rect)
+{
+    SDL_AtlasSkylineNode *skyline = page->skyline;
+    const int right = SDL_min(rect->x + rect->w + SDL_ATLAS_PADDING, atlas->page_w);
+    const int top = SDL_min(rect->y + rect->h + SDL_ATLAS_PADDING, atlas->page_h);
+    int i;
+
+    SDL_memmove(&skyline[node + 1], &skyline[node], (page->num_nodes - node) * sizeof(*skyline));
+    skyline[node].x = rect->x;
+    skyline[node].y = top;
+    skyline[node].w = right - rect->x;
+    ++page->num_nodes;
+
+    // Cut the nodes that are now below the new one
+    i = node + 1;
+    while (i < page->num_nodes && skyline[i].x < right) {
+        const int overlap = right - skyline[i].x;
+        if (overlap < skyline[i].w) {
+            skyline[i].x += overlap;
+            skyline[i].w -= overlap;
+            break;
+        }
+        SDL_memmove(&skyline[i], &skyline[i + 1], (page->num_nodes - i - 1) * sizeof(*skyline));
+        --page->num_nodes;
+    }
+
+    // Merge neighbors at the same height
+    i = 0;
+    while (i + 1 < page->num_nodes) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].w += skyline[i + 1].w;
+            SDL_memmove(&skyline[i + 1], &skyline[i + 2], (page->num_nodes - i - 2) * sizeof(*skyline));
+            --page->num_nodes;
+        } else {
+            ++i;
+        }
+    }
+}
+
+SDL_TextureAtlas *SDL_CreateTextureAtlas(SDL_Renderer *renderer, SDL_PixelFormat format, int page_width, int page_height)
+{
+    SDL_TextureAtlas *atlas;
+    int max_texture_size;
+
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (!format) {
+        format = renderer->texture_formats[0];
+    }
+    if (SDL_BYTESPERPIXEL(format) == 0 || SDL_ISPIXELFORMAT_FOURCC(format)) {
+        SDL_SetError("Invalid texture atlas format");
+        return NULL;
+    }
+    if (page_width < 0 || page_height < 0) {
+        SDL_InvalidParamError(page_width < 0 ? "page_width" : "page_height");
+        return NULL;
+    }
+
+    max_texture_size = (int)SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (!page_width) {
+        page_width = max_texture_size ? SDL_min(SDL_ATLAS_DEFAULT_PAGE_SIZE, max_texture_size) : SDL_ATLAS_DEFAULT_PAGE_SIZE;
+    }
+    if (!page_height) {
+        page_height = max_texture_size ? SDL_min(SDL_ATLAS_DEFAULT_PAGE_SIZE, max_texture_size) : SDL_ATLAS_DEFAULT_PAGE_SIZE;
+    }
+    if (max_texture_size && (page_width > max_texture_size || page_height > max_texture_size)) {
+        SDL_SetError("Texture dimensions are limited to %dx%d", max_texture_size, max_texture_size);
+        return NULL;
+    }
+
+    atlas = (SDL_TextureAtlas *)SDL_calloc(1, sizeof(*atlas));
+    if (!atlas) {
+        return NULL;
+    }
+    SDL_SetObjectValid(atlas, SDL_OBJECT_TYPE_TEXTURE_ATLAS, true);
+    atlas->renderer = renderer;
+    atlas->format = format;
+    atlas->page_w = page_width;
+    atlas->page_h = page_height;
+
+    // Create the first page now, so an unusable format fails early
+    if (!AddAtlasPage(atlas)) {
+        SDL_FreeTextureAtlas(atlas);
+        return NULL;
+    }
+
+    atlas->next = renderer->atlases;
+    renderer->atlases = atlas;
+    return atlas;
+}
+
+SDL_Texture *SDL_CreateAtlasTexture(SDL_TextureAtlas *atlas, int w, int h)
+{
+    SDL_Renderer *renderer;
+    SDL_Texture *texture;
+    SDL_Texture *page_texture;
+    SDL_PropertiesID props;
+    int page, node = 0, x = 0, y = 0;
+
+    CHECK_TEXTURE_ATLAS_MAGIC(atlas, NULL);
+
+    renderer = atlas->renderer;
+    CHECK_RENDERER_MAGIC(renderer, NULL);
+
+    if (w <= 0 || h <= 0) {
+        SDL_SetError("Texture dimensions can't be 0");
+        return NULL;
+    }
+    if (w > atlas->page_w || h > atlas->page_h) {
+        SDL_SetError("Texture dimensions are limited to %dx%d in this atlas", atlas->page_w, atlas->page_h);
+        return NULL;
+    }
+
+    for (page = 0; page < atlas->num_pages; ++page) {
+        if (FindAtlasPosition(atlas, &atlas->pages[page], w, h, &node, &x, &y)) {
+            break;
+        }
+    }
+    if (page == atlas->num_pages) {
+        if (!AddAtlasPage(atlas)) {
+            return NULL;
+        }
+        if (!FindAtlasPosition(atlas, &atlas->pages[page], w, h, &node, &x, &y)) {
+            SDL_SetError("Couldn't fit texture in an empty atlas page");
+            return NULL;
+        }
+    }
+    page_texture = atlas->pages[page].texture;
+
+    texture = (SDL_Texture *)SDL_calloc(1, sizeof(*texture));
+    if (!texture) {
+        return NULL;
+    }
+    texture->refcount = 1;
+    SDL_SetObjectValid(texture, SDL_OBJECT_TYPE_TEXTURE, true);
+    texture->colorspace = page_texture->colorspace;
+    texture->SDR_white_point = page_texture->SDR_white_point;
+    texture->HDR_headroom = page_texture->HDR_headroom;
+    texture->format = atlas->format;
+    texture->access = SDL_TEXTUREACCESS_STATIC;
+    texture->w = w;
+    texture->h = h;
+    texture->color.r = 1.0f;
+    texture->color.g = 1.0f;
+    texture->color.b = 1.0f;
+    texture->color.a = 1.0f;
+    texture->blendMode = SDL_ISPIXELFORMAT_ALPHA(atlas->format) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE;
+    texture->scaleMode = SDL_SCALEMODE_LINEAR;
+    texture->renderer = renderer;
+    texture->atlas = atlas;
+    texture->atlas_page = page;
+    texture->atlas_rect.x = x;
+    texture->atlas_rect.y = y;
+    texture->atlas_rect.w = w;
+    texture->atlas_rect.h = h;
+    texture->next = renderer->textures;
+    if (renderer->textures) {
+        renderer->textures->prev = texture;
+    }
+    renderer->textures = texture;
+
+    RaiseAtlasSkyline(atlas, &atlas->pages[page], node, &texture->atlas_rect);
+    ++atlas->pages[page].num_textures;
+
+    props = SDL_GetTextureProperties(texture);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_COLORSPACE_NUMBER, texture->colorspace);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_FORMAT_NUMBER, texture->format);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_ACCESS_NUMBER, texture->access);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_WIDTH_NUMBER, texture->w);
+    SDL_SetNumberProperty(props, SDL_PROP_TEXTURE_HEIGHT_NUMBER, texture->h);
+    SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_SDR_WHITE_POINT_FLOAT, texture->SDR_white_point);
+    if (texture->HDR_headroom > 0.0f) {
+        SDL_SetFloatProperty(props, SDL_PROP_TEXTURE_HDR_HEADROOM_FLOAT, texture->HDR_headroom);
+    }
+    return texture;
+}
+
+void SDL_DestroyTextureAtlas(SDL_TextureAtlas *atlas)
+{
+    SDL_Renderer *renderer;
+    SDL_TextureAtlas **prev;
+    SDL_Texture *texture;
+    int i;
+
+    CHECK_TEXTURE_ATLAS_MAGIC(atlas, );
+
+    renderer = atlas->renderer;
+
+    texture = renderer->textures;
+    while (texture) {
+        SDL_Texture *next = texture->next;
+        if (texture->atlas == atlas) {
+            SDL_DestroyTextureInternal(texture, false /* is_destroying */);
+        }
+        texture = next;
+    }
+    for (i = 0; i < atlas->num_pages; ++i) {
+        SDL_DestroyTexture(atlas->pages[i].texture);
+    }
+
+    for (prev = &renderer->atlases; *prev; prev = &(*prev)->next) {
+        if (*prev == atlas) {
+            *prev = atlas->next;
+            break;
+        }
     }
+    SDL_FreeTextureAtlas(atlas);
+}
+
+static void SDL_DiscardAllCommands(SDL_Renderer *renderer)
+{
+    int i;
 
     renderer->render_commands_pool = NULL;
     renderer->render_commands_tail = NULL;
     renderer->render_commands = NULL;
     renderer->vertex_data_used = 0;
 
-    while (cmd) {
-        SDL_RenderCommand *next = cmd->next;
-        SDL_free(cmd);
-        cmd = next;
+    for (i = 0; i < renderer->num_render_command_blocks; ++i) {
+        SDL_free(renderer->render_command_blocks[i]);
     }
+    SDL_free(renderer->render_command_blocks);
+    renderer->render_command_blocks = NULL;
+    renderer->num_render_command_blocks = 0;
+    renderer->render_commands_allocated = 0;
 }
 
 void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
@@ -5166,7 +6630,7 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 
     if (renderer->window) {
         SDL_PropertiesID props = SDL_GetWindowProperties(renderer->window);
-        if (SDL_GetPointerProperty(props, SDL_PROP_WINDOW_RENDERER_POINTER, NULL) == renderer) {
+        if (SDL_GetPointerPropertyByKey(props, &SDL_window_renderer_key, NULL) == renderer) {
             SDL_ClearProperty(props, SDL_PROP_WINDOW_RENDERER_POINTER);
         }
         SDL_RemoveWindowRenderer(renderer->window, renderer);
@@ -5182,6 +6646,15 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_DestroyTexture(renderer->debug_char_texture_atlas);
         renderer->debug_char_texture_atlas = NULL;
     }
+    if (renderer->debug_text_cache) {
+        SDL_DestroyHashTable(renderer->debug_text_cache);
+        renderer->debug_text_cache = NULL;
+        renderer->debug_text_cache_count = 0;
+    }
+
+    while (renderer->readbacks) {
+        SDL_DestroyRenderReadback(renderer->readbacks);
+    }
 
     // Free existing textures for this renderer
     while (renderer->textures) {
@@ -5189,6 +6662,11 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_DestroyTextureInternal(renderer->textures, true /* is_destroying */);
         SDL_assert(tex != renderer->textures); // satisfy static analysis.
     }
+    while (renderer->atlases) {
+        SDL_TextureAtlas *atlas = renderer->atlases;
+        renderer->atlases = atlas->next;
+        SDL_FreeTextureAtlas(atlas);
+    }
 
     // Clean up renderer-specific resources
     if (renderer->DestroyRenderer) {
@@ -5200,9 +6678,34 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         renderer->target_mutex = NULL;
     }
     if (renderer->vertex_data) {
+        SDL_UntrackMemoryObject(&renderer->vertex_data);
         SDL_free(renderer->vertex_data);
         renderer->vertex_data = NULL;
     }
+    if (renderer->reorder_commands) {
+        SDL_free(renderer->reorder_commands);
+        renderer->reorder_commands = NULL;
+    }
+    if (renderer->reorder_vertex_data) {
+        SDL_free(renderer->reorder_vertex_data);
+        renderer->reorder_vertex_data = NULL;
+    }
+    if (renderer->instance_data) {
+        SDL_free(renderer->instance_data);
+        renderer->instance_data = NULL;
+    }
+    if (renderer->debug_text_data) {
+        SDL_free(renderer->debug_text_data);
+        renderer->debug_text_data = NULL;
+    }
+    if (renderer->atlas_uv) {
+        SDL_free(renderer->atlas_uv);
+        renderer->atlas_uv = NULL;
+    }
+    if (renderer->damage_rects) {
+        SDL_free(renderer->damage_rects);
+        renderer->damage_rects = NULL;
+    }
     if (renderer->texture_formats) {
         SDL_free(renderer->texture_formats);
         renderer->texture_formats = NULL;
@@ -5491,17 +6994,13 @@ static bool CreateDebugTextAtlas(SDL_Renderer *renderer)
     return texture != NULL;
 }
 
-static bool DrawDebugCharacter(SDL_Renderer *renderer, float x, float y, Uint32 c)
+// Returns false for characters that are completely blank
+static bool GetDebugGlyph(Uint32 c, Uint32 *glyph)
 {
-    SDL_assert(renderer->debug_char_texture_atlas != NULL);   // should have been created by now!
-
-    const int charWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
-    const int charHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
-
     // Character index in cache
     Uint32 ci = c;
     if ((ci <= 32) || ((ci >= 127) && (ci <= 160))) {
-        return true;  // these are just completely blank chars, don't bother doing anything.
+        return false;  // these are just completely blank chars, don't bother doing anything.
     } else if (ci >= SDL_DEBUG_FONT_NUM_GLYPHS) {
         ci = SDL_DEBUG_FONT_NUM_GLYPHS - 1;  // use our "not a valid/supported character" glyph.
     } else if (ci < 127) {
@@ -5509,18 +7008,114 @@ static bool DrawDebugCharacter(SDL_Renderer *renderer, float x, float y, Uint32
     } else {
         ci -= 67;     // adjust for the 33 blank glyphs at the start AND the 34 gap in the middle.
     }
+    *glyph = ci;
+    return true;
+}
+
+// Strings are laid out once, with their glyph quads relative to where they're drawn
+#define SDL_DEBUG_TEXT_CACHE_SIZE 256
+
+typedef struct SDL_DebugTextLayout
+{
+    int num_glyphs;
+    float *xy;  // 4 vertices per glyph
+    float *uv;
+} SDL_DebugTextLayout;
+
+static const SDL_DebugTextLayout *GetDebugTextLayout(SDL_Renderer *renderer, const char *s)
+{
+    const SDL_DebugTextLayout *cached = NULL;
+    SDL_DebugTextLayout *layout;
+    SDL_Texture *atlas = renderer->debug_char_texture_atlas;
+    const int charWidth = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const int charHeight = SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    const char *p;
+    char *key;
+    Uint32 ch, glyph;
+    int num_glyphs = 0;
+    float curx = 0.0f;
+
+    if (!renderer->debug_text_cache) {
+        renderer->debug_text_cache = SDL_CreateHashTable(0, false, SDL_HashString, SDL_KeyMatchString, SDL_DestroyHashKeyAndValue, NULL);
+        if (!renderer->debug_text_cache) {
+            return NULL;
+        }
+    }
+    if (SDL_FindInHashTable(renderer->debug_text_cache, s, (const void **)&cached)) {
+        return cached;
+    }
+
+    p = s;
+    while ((ch = SDL_StepUTF8(&p, NULL)) != 0) {
+        if (GetDebugGlyph(ch, &glyph)) {
+            ++num_glyphs;
+        }
+    }
+
+    layout = (SDL_DebugTextLayout *)SDL_malloc(sizeof(*layout) + (size_t)num_glyphs * 16 * sizeof(float));
+    if (!layout) {
+        return NULL;
+    }
+    layout->num_glyphs = num_glyphs;
+    layout->xy = (float *)(layout + 1);
+    layout->uv = layout->xy + (size_t)num_glyphs * 8;
+
+    float *xy = layout->xy;
+    float *uv = layout->uv;
+    p = s;
+    while ((ch = SDL_StepUTF8(&p, NULL)) != 0) {
+        if (GetDebugGlyph(ch, &glyph)) {
+            const float minu = (float)(((glyph % SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charWidth + 2)) + 1) / atlas->w;
+            const float minv = (float)(((glyph / SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charHeight + 2)) + 1) / atlas->h;
+            const float maxu = minu + (float)charWidth / atlas->w;
+            const float maxv = minv + (float)charHeight / atlas->h;
+            const float maxx = curx + charWidth;
+            const float maxy = (float)charHeight;
+
+            xy[0] = curx;  xy[1] = 0.0f;
+            xy[2] = maxx;  xy[3] = 0.0f;
+            xy[4] = maxx;  xy[5] = maxy;
+            xy[6] = curx;  xy[7] = maxy;
+            uv[0] = minu;  uv[1] = minv;
+            uv[2] = maxu;  uv[3] = minv;
+            uv[4] = maxu;  uv[5] = maxv;
+            uv[6] = minu;  uv[7] = maxv;
+            xy += 8;
+            uv += 8;
+        }
+        curx += charWidth;
+    }
+
+    key = SDL_strdup(s);
+    if (!key) {
+        SDL_free(layout);
+        return NULL;
+    }
 
-    const float src_x = (float) (((ci % SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charWidth + 2)) + 1);
-    const float src_y = (float) (((ci / SDL_DEBUG_FONT_GLYPHS_PER_ROW) * (charHeight + 2)) + 1);
+    // HUDs with changing numbers would grow this forever, so start over when it's full
+    if (renderer->debug_text_cache_count >= SDL_DEBUG_TEXT_CACHE_SIZE) {
+        SDL_ClearHashTable(renderer->debug_text_cache);
+        renderer->debug_text_cache_count = 0;
+    }
+    if (!SDL_InsertIntoHashTable(renderer->debug_text_cache, key, layout, false)) {
+        SDL_free(key);
+        SDL_free(layout);
+        return NULL;
+    }
+    ++renderer->debug_text_cache_count;
 
-    // Draw texture onto destination
-    const SDL_FRect srect = { src_x, src_y, (float) charWidth, (float) charHeight };
-    const SDL_FRect drect = { x, y, (float) charWidth, (float) charHeight };
-    return SDL_RenderTexture(renderer, renderer->debug_char_texture_atlas, &srect, &drect);
+    return layout;
 }
 
 bool SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *s)
 {
+    const SDL_DebugTextLayout *layout;
+    SDL_FColor color;
+    float *xy;
+    int *indices;
+    size_t size;
+    int i;
+
     CHECK_RENDERER_MAGIC(renderer, false);
 
     // Allocate a texture atlas for this renderer if needed.
@@ -5530,22 +7125,52 @@ bool SDL_RenderDebugText(SDL_Renderer *renderer, float x, float y, const char *s
         }
     }
 
-    bool result = true;
+    layout = GetDebugTextLayout(renderer, s);
+    if (!layout) {
+        return false;
+    }
+    if (layout->num_glyphs == 0) {
+        return true;
+    }
+    if (layout->num_glyphs > SDL_MAX_SINT32 / 6) {
+        return SDL_InvalidParamError("s");
+    }
 
-    Uint8 r, g, b, a;
-    result &= SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
-    result &= SDL_SetTextureColorMod(renderer->debug_char_texture_atlas, r, g, b);
-    result &= SDL_SetTextureAlphaMod(renderer->debug_char_texture_atlas, a);
+    // Draw the whole string as a single geometry command
+    size = (size_t)layout->num_glyphs * (8 * sizeof(float) + 6 * sizeof(int));
+    if (renderer->debug_text_data_allocation < size) {
+        void *ptr = SDL_realloc(renderer->debug_text_data, size);
+        if (!ptr) {
+            return false;
+        }
+        renderer->debug_text_data = ptr;
+        renderer->debug_text_data_allocation = size;
+    }
+    xy = (float *)renderer->debug_text_data;
+    indices = (int *)(xy + (size_t)layout->num_glyphs * 8);
 
-    float curx = x;
-    Uint32 ch;
+    for (i = 0; i < layout->num_glyphs * 4; ++i) {
+        xy[i * 2 + 0] = layout->xy[i * 2 + 0] + x;
+        xy[i * 2 + 1] = layout->xy[i * 2 + 1] + y;
+    }
+    for (i = 0; i < layout->num_glyphs; ++i) {
+        const int v = i * 4;
+        indices[i * 6 + 0] = v + 0;
+        indices[i * 6 + 1] = v + 1;
+        indices[i * 6 + 2] = v + 2;
+        indices[i * 6 + 3] = v + 0;
+        indices[i * 6 + 4] = v + 2;
+        indices[i * 6 + 5] = v + 3;
+    }
 
-    while (result && ((ch = SDL_StepUTF8(&s, NULL)) != 0)) {
-        result &= DrawDebugCharacter(renderer, curx, y, ch);
-        curx += SDL_DEBUG_TEXT_FONT_CHARACTER_SIZE;
+    if (!SDL_GetRenderDrawColorFloat(renderer, &color.r, &color.g, &color.b, &color.a)) {
+        return false;
     }
 
-    return result;
+    return SDL_RenderGeometryRaw(renderer, renderer->debug_char_texture_atlas,
+                                 xy, 2 * sizeof(float), &color, 0,
+                                 layout->uv, 2 * sizeof(float),
+                                 layout->num_glyphs * 4, indices, layout->num_glyphs * 6, sizeof(int));
 }
 
 bool SDL_RenderDebugTextFormat(SDL_Renderer *renderer, float x, float y, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
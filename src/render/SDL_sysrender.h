@@ -112,12 +112,36 @@ struct SDL_Texture
 
     SDL_PropertiesID props;
 
+    // Textures in a texture atlas are drawn from a region of one of its pages
+    SDL_TextureAtlas *atlas;
+    int atlas_page;
+    SDL_Rect atlas_rect;
+
     void *internal;             // Driver specific texture representation
 
     SDL_Texture *prev;
     SDL_Texture *next;
 };
 
+// A pending read of pixels from a render target
+struct SDL_RenderReadback
+{
+    SDL_Renderer *renderer;
+    SDL_Rect rect;
+
+    // The state of the render target when the read was started
+    SDL_PixelFormat expected_format;
+    float SDR_white_point;
+    float HDR_headroom;
+
+    SDL_Surface *surface;   // The pixels, if they were read immediately
+
+    void *internal;         // Driver specific readback representation
+
+    SDL_RenderReadback *prev;
+    SDL_RenderReadback *next;
+};
+
 typedef enum
 {
     SDL_RENDERCMD_NO_OP,
@@ -158,6 +182,8 @@ typedef struct SDL_RenderCommand
             SDL_Texture *texture;
             SDL_ScaleMode texture_scale_mode;
             SDL_TextureAddressMode texture_address_mode;
+            SDL_FRect bounds;   // the area covered by geometry, when reordering draws
+            size_t vertex_end;  // the end of the geometry vertex data, 0 if the draw can't be reordered
         } draw;
         struct
         {
@@ -228,6 +254,10 @@ struct SDL_Renderer
     void (*UnlockTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
     bool (*SetRenderTarget)(SDL_Renderer *renderer, SDL_Texture *texture);
     SDL_Surface *(*RenderReadPixels)(SDL_Renderer *renderer, const SDL_Rect *rect);
+    bool (*RenderReadPixelsAsync)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    bool (*IsReadbackComplete)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    SDL_Surface *(*FinishReadback)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
+    void (*ReleaseReadback)(SDL_Renderer *renderer, SDL_RenderReadback *readback);
     bool (*RenderPresent)(SDL_Renderer *renderer);
     void (*DestroyTexture)(SDL_Renderer *renderer, SDL_Texture *texture);
 
@@ -246,6 +276,9 @@ struct SDL_Renderer
     int num_texture_formats;
     bool software;
 
+    // Locking a streaming texture always returns the same staging memory, with its contents kept
+    bool persistent_texture_lock;
+
     // The window associated with the renderer
     SDL_Window *window;
     bool hidden;
@@ -283,6 +316,9 @@ struct SDL_Renderer
     SDL_RenderCommand *render_commands;
     SDL_RenderCommand *render_commands_tail;
     SDL_RenderCommand *render_commands_pool;
+    SDL_RenderCommand **render_command_blocks;  // Render commands are allocated in blocks, freed with the renderer
+    int num_render_command_blocks;
+    int render_commands_allocated;
     Uint32 render_command_generation;
     SDL_FColor last_queued_color;
     float last_queued_color_scale;
@@ -297,6 +333,41 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    // Statistics for the current frame, published as renderer properties by SDL_RenderPresent()
+    int frame_commands;
+    size_t frame_vertex_bytes;
+    int frame_allocations;
+    int frame_draw_calls;
+    int frame_state_changes;
+    int frame_texture_binds;
+    size_t frame_upload_bytes;
+    Uint64 frame_queue_ns;
+
+    // Reordering of independent geometry draws into batches, see SDL_HINT_RENDER_REORDER_DRAWS
+    bool reorder_draws;
+    SDL_RenderCommand **reorder_commands;
+    int reorder_commands_allocation;
+    void *reorder_vertex_data;
+    size_t reorder_vertex_data_allocation;
+
+    // Scratch space for SDL_RenderTextureInstances()
+    void *instance_data;
+    size_t instance_data_allocation;
+
+    // The list of pending readbacks
+    SDL_RenderReadback *readbacks;
+
+    // The damage set by SDL_SetRenderDamageRects() for the next present
+    bool damage_rects_set;
+    SDL_Rect *damage_rects;
+    int num_damage_rects;
+    int damage_rects_allocation;
+
+    // The list of texture atlases, and scratch space for their texture coordinates
+    SDL_TextureAtlas *atlases;
+    float *atlas_uv;
+    size_t atlas_uv_allocation;
+
     // Shaped window support
     bool transparent_window;
     SDL_Surface *shape_surface;
@@ -305,6 +376,10 @@ struct SDL_Renderer
     SDL_PropertiesID props;
 
     SDL_Texture *debug_char_texture_atlas;
+    SDL_HashTable *debug_text_cache;
+    int debug_text_cache_count;
+    void *debug_text_data;
+    size_t debug_text_data_allocation;
 
     bool destroyed;   // already destroyed by SDL_DestroyWindow; just free this struct in SDL_DestroyRenderer.
 
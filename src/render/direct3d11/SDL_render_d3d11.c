@@ -102,8 +102,16 @@ typedef struct
 {
     ID3D11Buffer *constants;
     D3D11_PixelShaderConstants shader_constants;
+    UINT constants_offset; // in the constant ring, in 16 byte constants
+    Uint32 constants_generation;
 } D3D11_PixelShaderState;
 
+/* Pixel shader constants are packed into a ring buffer and bound by offset
+ * when the device supports it, instead of creating a buffer per change.
+ */
+#define D3D11_CONSTANT_RING_SIZE      (256 * 1024)
+#define D3D11_CONSTANT_RING_ALIGNMENT 256
+
 // Per-vertex data
 typedef struct
 {
@@ -166,8 +174,9 @@ typedef struct
     ID3D11RenderTargetView *mainRenderTargetView;
     ID3D11RenderTargetView *currentOffscreenRenderTargetView;
     ID3D11InputLayout *inputLayout;
-    ID3D11Buffer *vertexBuffers[8];
-    size_t vertexBufferSizes[8];
+    ID3D11Buffer *vertexBuffer;
+    size_t vertexBufferSize;
+    size_t vertexBufferOffset;
     ID3D11VertexShader *vertexShader;
     ID3D11PixelShader *pixelShaders[NUM_SHADERS];
     int blendModesCount;
@@ -184,6 +193,11 @@ typedef struct
     D3D11_VertexShaderConstants vertexShaderConstantsData;
     ID3D11Buffer *vertexShaderConstants;
 
+    // Pixel shader constant ring
+    ID3D11Buffer *constantRing;
+    UINT constantRingOffset;
+    Uint32 constantRingGeneration;
+
     // Cached renderer properties
     DXGI_MODE_ROTATION rotation;
     ID3D11RenderTargetView *currentRenderTargetView;
@@ -200,7 +214,6 @@ typedef struct
     int currentViewportRotation;
     bool viewportDirty;
     Float4X4 identity;
-    int currentVertexBuffer;
 } D3D11_RenderData;
 
 // Define D3D GUIDs here so we don't have to include uuid.lib.
@@ -357,9 +370,8 @@ static void D3D11_ReleaseAll(SDL_Renderer *renderer)
             SAFE_RELEASE(data->currentShaderState[i].constants);
         }
         SAFE_RELEASE(data->vertexShader);
-        for (i = 0; i < SDL_arraysize(data->vertexBuffers); ++i) {
-            SAFE_RELEASE(data->vertexBuffers[i]);
-        }
+        SAFE_RELEASE(data->vertexBuffer);
+        SAFE_RELEASE(data->constantRing);
         SAFE_RELEASE(data->inputLayout);
         SAFE_RELEASE(data->mainRenderTargetView);
         SAFE_RELEASE(data->swapChain);
@@ -721,6 +733,27 @@ static HRESULT D3D11_CreateDeviceResources(SDL_Renderer *renderer)
         goto done;
     }
 
+    // Setup a ring for pixel shader constants, if they can be bound by offset
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+        SDL_zero(options);
+        if (SUCCEEDED(ID3D11Device_CheckFeatureSupport(data->d3dDevice, D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+            options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer) {
+            SDL_zero(constantBufferDesc);
+            constantBufferDesc.ByteWidth = D3D11_CONSTANT_RING_SIZE;
+            constantBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
+            constantBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+            constantBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            if (FAILED(ID3D11Device_CreateBuffer(data->d3dDevice, &constantBufferDesc, NULL, &data->constantRing))) {
+                // Not fatal, we'll fall back to a buffer per shader
+                data->constantRing = NULL;
+            }
+            // The first upload wraps around, so the buffer is discarded before it's used
+            data->constantRingOffset = D3D11_CONSTANT_RING_SIZE;
+            ++data->constantRingGeneration;
+        }
+    }
+
     // Create samplers to use when drawing textures:
     static struct
     {
@@ -1149,6 +1182,22 @@ static bool GetTextureProperty(SDL_PropertiesID props, const char *name, ID3D11T
     return true;
 }
 
+static bool GetSharedTextureProperty(D3D11_RenderData *rendererData, SDL_PropertiesID props, const char *name, ID3D11Texture2D **texture)
+{
+    HANDLE handle = (HANDLE)SDL_GetPointerProperty(props, name, NULL);
+    if (handle) {
+        // NT handles need OpenSharedResource1, legacy shared handles need OpenSharedResource
+        HRESULT result = ID3D11Device1_OpenSharedResource1(rendererData->d3dDevice, handle, &SDL_IID_ID3D11Texture2D, (void **)texture);
+        if (FAILED(result)) {
+            result = ID3D11Device_OpenSharedResource(rendererData->d3dDevice, handle, &SDL_IID_ID3D11Texture2D, (void **)texture);
+        }
+        if (FAILED(result)) {
+            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::OpenSharedResource"), result);
+        }
+    }
+    return true;
+}
+
 static bool D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->internal;
@@ -1216,6 +1265,10 @@ static bool D3D11_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
     if (!GetTextureProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D11_TEXTURE_POINTER, &textureData->mainTexture)) {
         return false;
     }
+    if (!textureData->mainTexture &&
+        !GetSharedTextureProperty(rendererData, create_props, SDL_PROP_TEXTURE_CREATE_D3D11_SHARED_HANDLE_POINTER, &textureData->mainTexture)) {
+        return false;
+    }
     if (!textureData->mainTexture) {
         result = ID3D11Device_CreateTexture2D(rendererData->d3dDevice,
                                               &textureDesc,
@@ -1905,71 +1958,84 @@ static bool D3D11_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     return true;
 }
 
+/* Vertices are streamed through a single ring buffer: each batch is appended
+ * with D3D11_MAP_WRITE_NO_OVERWRITE, and the buffer is only discarded when the
+ * ring wraps around, or recreated when a batch doesn't fit in it.
+ */
+#define D3D11_VERTEX_BUFFER_DEFAULT_SIZE (1024 * 1024)
+
 static bool D3D11_UpdateVertexBuffer(SDL_Renderer *renderer,
                                     const void *vertexData, size_t dataSizeInBytes)
 {
     D3D11_RenderData *rendererData = (D3D11_RenderData *)renderer->internal;
     HRESULT result = S_OK;
-    const int vbidx = rendererData->currentVertexBuffer;
     const UINT stride = sizeof(D3D11_VertexPositionColor);
-    const UINT offset = 0;
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    size_t offset;
+    UINT offsetInBytes;
 
     if (dataSizeInBytes == 0) {
         return true; // nothing to do.
     }
 
-    if (rendererData->vertexBuffers[vbidx] && rendererData->vertexBufferSizes[vbidx] >= dataSizeInBytes) {
-        D3D11_MAPPED_SUBRESOURCE mappedResource;
-        result = ID3D11DeviceContext_Map(rendererData->d3dContext,
-                                         (ID3D11Resource *)rendererData->vertexBuffers[vbidx],
-                                         0,
-                                         D3D11_MAP_WRITE_DISCARD,
-                                         0,
-                                         &mappedResource);
-        if (FAILED(result)) {
-            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
-        }
-        SDL_memcpy(mappedResource.pData, vertexData, dataSizeInBytes);
-        ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffers[vbidx], 0);
-    } else {
+    if (!rendererData->vertexBuffer || rendererData->vertexBufferSize < dataSizeInBytes) {
         D3D11_BUFFER_DESC vertexBufferDesc;
-        D3D11_SUBRESOURCE_DATA vertexBufferData;
+        size_t size = D3D11_VERTEX_BUFFER_DEFAULT_SIZE;
+
+        while (size < dataSizeInBytes) {
+            size *= 2;
+        }
 
-        SAFE_RELEASE(rendererData->vertexBuffers[vbidx]);
+        SAFE_RELEASE(rendererData->vertexBuffer);
 
         SDL_zero(vertexBufferDesc);
-        vertexBufferDesc.ByteWidth = (UINT)dataSizeInBytes;
+        vertexBufferDesc.ByteWidth = (UINT)size;
         vertexBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
         vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         vertexBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
 
-        SDL_zero(vertexBufferData);
-        vertexBufferData.pSysMem = vertexData;
-        vertexBufferData.SysMemPitch = 0;
-        vertexBufferData.SysMemSlicePitch = 0;
-
         result = ID3D11Device_CreateBuffer(rendererData->d3dDevice,
                                            &vertexBufferDesc,
-                                           &vertexBufferData,
-                                           &rendererData->vertexBuffers[vbidx]);
+                                           NULL,
+                                           &rendererData->vertexBuffer);
         if (FAILED(result)) {
             return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11Device1::CreateBuffer [vertex buffer]"), result);
         }
 
-        rendererData->vertexBufferSizes[vbidx] = dataSizeInBytes;
+        rendererData->vertexBufferSize = size;
+        rendererData->vertexBufferOffset = 0;
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+
+    // Start each batch on a vertex boundary
+    offset = (rendererData->vertexBufferOffset + stride - 1) / stride * stride;
+    if (offset + dataSizeInBytes > rendererData->vertexBufferSize) {
+        offset = 0;
+        mapType = D3D11_MAP_WRITE_DISCARD;
     }
 
+    result = ID3D11DeviceContext_Map(rendererData->d3dContext,
+                                     (ID3D11Resource *)rendererData->vertexBuffer,
+                                     0,
+                                     mapType,
+                                     0,
+                                     &mappedResource);
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [vertex buffer]"), result);
+    }
+    SDL_memcpy((Uint8 *)mappedResource.pData + offset, vertexData, dataSizeInBytes);
+    ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->vertexBuffer, 0);
+
+    rendererData->vertexBufferOffset = offset + dataSizeInBytes;
+
+    offsetInBytes = (UINT)offset;
     ID3D11DeviceContext_IASetVertexBuffers(rendererData->d3dContext,
                                            0,
                                            1,
-                                           &rendererData->vertexBuffers[vbidx],
+                                           &rendererData->vertexBuffer,
                                            &stride,
-                                           &offset);
-
-    rendererData->currentVertexBuffer++;
-    if (rendererData->currentVertexBuffer >= SDL_arraysize(rendererData->vertexBuffers)) {
-        rendererData->currentVertexBuffer = 0;
-    }
+                                           &offsetInBytes);
 
     return true;
 }
@@ -2138,6 +2204,40 @@ static void D3D11_SetupShaderConstants(SDL_Renderer *renderer, const SDL_RenderC
     }
 }
 
+static bool D3D11_UploadShaderConstants(D3D11_RenderData *rendererData, D3D11_PixelShaderState *shader_state, const D3D11_PixelShaderConstants *shader_constants)
+{
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    D3D11_MAPPED_SUBRESOURCE mappedResource;
+    HRESULT result;
+
+    SDL_COMPILE_TIME_ASSERT(D3D11_PixelShaderConstants_size, sizeof(D3D11_PixelShaderConstants) <= D3D11_CONSTANT_RING_ALIGNMENT);
+
+    if (rendererData->constantRingOffset + D3D11_CONSTANT_RING_ALIGNMENT > D3D11_CONSTANT_RING_SIZE) {
+        // Discarding the buffer loses the constants of the other shaders too
+        rendererData->constantRingOffset = 0;
+        ++rendererData->constantRingGeneration;
+        mapType = D3D11_MAP_WRITE_DISCARD;
+    }
+
+    result = ID3D11DeviceContext_Map(rendererData->d3dContext,
+                                     (ID3D11Resource *)rendererData->constantRing,
+                                     0,
+                                     mapType,
+                                     0,
+                                     &mappedResource);
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D11DeviceContext1::Map [constant ring]"), result);
+    }
+    SDL_memcpy((Uint8 *)mappedResource.pData + rendererData->constantRingOffset, shader_constants, sizeof(*shader_constants));
+    ID3D11DeviceContext_Unmap(rendererData->d3dContext, (ID3D11Resource *)rendererData->constantRing, 0);
+
+    SDL_memcpy(&shader_state->shader_constants, shader_constants, sizeof(*shader_constants));
+    shader_state->constants_offset = rendererData->constantRingOffset / 16;
+    shader_state->constants_generation = rendererData->constantRingGeneration;
+    rendererData->constantRingOffset += D3D11_CONSTANT_RING_ALIGNMENT;
+    return true;
+}
+
 static bool D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd,
                               D3D11_Shader shader, const D3D11_PixelShaderConstants *shader_constants,
                               const int numShaderResources, ID3D11ShaderResourceView **shaderResources,
@@ -2232,7 +2332,17 @@ static bool D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *
         shader_constants = &solid_constants;
     }
 
-    if (!shader_state->constants ||
+    if (rendererData->constantRing) {
+        if (shader_state->constants_generation != rendererData->constantRingGeneration ||
+            SDL_memcmp(shader_constants, &shader_state->shader_constants, sizeof(*shader_constants)) != 0) {
+            if (!D3D11_UploadShaderConstants(rendererData, shader_state, shader_constants)) {
+                return false;
+            }
+
+            // Force the shader parameters to be re-set
+            rendererData->currentShader = SHADER_NONE;
+        }
+    } else if (!shader_state->constants ||
         SDL_memcmp(shader_constants, &shader_state->shader_constants, sizeof(*shader_constants)) != 0) {
         SAFE_RELEASE(shader_state->constants);
 
@@ -2263,7 +2373,10 @@ static bool D3D11_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand *
             }
         }
         ID3D11DeviceContext_PSSetShader(rendererData->d3dContext, rendererData->pixelShaders[shader], NULL, 0);
-        if (shader_state->constants) {
+        if (rendererData->constantRing) {
+            const UINT numConstants = D3D11_CONSTANT_RING_ALIGNMENT / 16;
+            ID3D11DeviceContext1_PSSetConstantBuffers1(rendererData->d3dContext, 0, 1, &rendererData->constantRing, &shader_state->constants_offset, &numConstants);
+        } else if (shader_state->constants) {
             ID3D11DeviceContext_PSSetConstantBuffers(rendererData->d3dContext, 0, 1, &shader_state->constants);
         }
         rendererData->currentShader = shader;
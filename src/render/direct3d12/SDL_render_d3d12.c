@@ -1551,6 +1551,18 @@ static bool GetTextureProperty(SDL_PropertiesID props, const char *name, ID3D12R
     return true;
 }
 
+static bool GetSharedTextureProperty(D3D12_RenderData *rendererData, SDL_PropertiesID props, const char *name, ID3D12Resource **texture)
+{
+    HANDLE handle = (HANDLE)SDL_GetPointerProperty(props, name, NULL);
+    if (handle) {
+        HRESULT result = ID3D12Device1_OpenSharedHandle(rendererData->d3dDevice, handle, D3D_GUID(SDL_IID_ID3D12Resource), (void **)texture);
+        if (FAILED(result)) {
+            return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::OpenSharedHandle"), result);
+        }
+    }
+    return true;
+}
+
 static bool D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_PropertiesID create_props)
 {
     D3D12_RenderData *rendererData = (D3D12_RenderData *)renderer->internal;
@@ -1615,6 +1627,16 @@ static bool D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
     if (!GetTextureProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D12_TEXTURE_POINTER, &textureData->mainTexture)) {
         return false;
     }
+    textureData->mainResourceState = D3D12_RESOURCE_STATE_COPY_DEST;
+    if (!textureData->mainTexture) {
+        if (!GetSharedTextureProperty(rendererData, create_props, SDL_PROP_TEXTURE_CREATE_D3D12_SHARED_HANDLE_POINTER, &textureData->mainTexture)) {
+            return false;
+        }
+        if (textureData->mainTexture) {
+            // Resources shared across devices are promoted from and decay to the common state
+            textureData->mainResourceState = D3D12_RESOURCE_STATE_COMMON;
+        }
+    }
     if (!textureData->mainTexture) {
         result = ID3D12Device1_CreateCommittedResource(rendererData->d3dDevice,
                           &heapProps,
@@ -1628,7 +1650,17 @@ static bool D3D12_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
             return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12Device::CreateCommittedResource [texture]"), result);
         }
     }
-    textureData->mainResourceState = D3D12_RESOURCE_STATE_COPY_DEST;
+    {
+        ID3D12Fence *fence = (ID3D12Fence *)SDL_GetPointerProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_POINTER, NULL);
+        if (fence) {
+            // Make the GPU wait until the producer has finished writing the texture contents
+            UINT64 fenceValue = (UINT64)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_D3D12_FENCE_VALUE_NUMBER, 0);
+            result = ID3D12CommandQueue_Wait(rendererData->commandQueue, fence, fenceValue);
+            if (FAILED(result)) {
+                return WIN_SetErrorFromHRESULT(SDL_COMPOSE_ERROR("ID3D12CommandQueue::Wait"), result);
+            }
+        }
+    }
     SDL_SetPointerProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_D3D12_TEXTURE_POINTER, textureData->mainTexture);
 #ifdef SDL_HAVE_YUV
     if (texture->format == SDL_PIXELFORMAT_YV12 ||
@@ -36,6 +36,8 @@ typedef struct GPU_ShaderUniformData
     float texture_size[2];
 } GPU_ShaderUniformData;
 
+#define GPU_READBACK_POOL_SIZE 4
+
 typedef struct GPU_RenderData
 {
     SDL_GPUDevice *device;
@@ -63,6 +65,22 @@ typedef struct GPU_RenderData
         Uint32 buffer_size;
     } vertices;
 
+    struct
+    {
+        SDL_GPUTransferBuffer *transfer_buf;
+        Uint32 size;
+        Uint32 offset;
+        bool cycle;
+    } uploads;
+
+    // Download buffers of finished readbacks, kept for reuse
+    struct
+    {
+        SDL_GPUTransferBuffer *transfer_bufs[GPU_READBACK_POOL_SIZE];
+        Uint32 sizes[GPU_READBACK_POOL_SIZE];
+        int count;
+    } readbacks;
+
     struct
     {
         SDL_GPURenderPass *render_pass;
@@ -74,19 +92,34 @@ typedef struct GPU_RenderData
         SDL_FColor draw_color;
         bool scissor_enabled;
         bool scissor_was_enabled;
-        GPU_ShaderUniformData shader_data;
+        GPU_ShaderUniformData shader_data; // last uniforms pushed to command_buffer
+        bool shader_data_valid;
     } state;
 
     SDL_GPUSampler *samplers[2][2];
 } GPU_RenderData;
 
+typedef struct GPU_ReadbackData
+{
+    SDL_GPUTransferBuffer *transfer_buf;
+    Uint32 size;
+    SDL_GPUFence *fence;
+    SDL_PixelFormat format;
+} GPU_ReadbackData;
+
+// Texture uploads are suballocated from one transfer buffer, which is cycled once per command buffer
+#define GPU_UPLOAD_BUFFER_MIN_SIZE (4 * 1024 * 1024)
+
+// D3D12 copies uploads that aren't aligned to D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT through a temporary buffer
+#define GPU_UPLOAD_ALIGNMENT 512
+
 typedef struct GPU_TextureData
 {
     SDL_GPUTexture *texture;
     SDL_GPUTextureFormat format;
     GPU_FragmentShaderID shader;
-    void *pixels;
-    int pitch;
+    SDL_GPUTransferBuffer *transfer_buf; // streaming textures are locked directly in here
+    Uint32 pitch;
     SDL_Rect locked_rect;
 } GPU_TextureData;
 
@@ -188,26 +221,29 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
     }
 
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
-        size_t size;
-        data->pitch = texture->w * SDL_BYTESPERPIXEL(texture->format);
-        size = (size_t)texture->h * data->pitch;
-        if (texture->format == SDL_PIXELFORMAT_YV12 ||
-            texture->format == SDL_PIXELFORMAT_IYUV) {
-            // Need to add size for the U and V planes
-            size += 2 * ((texture->h + 1) / 2) * ((data->pitch + 1) / 2);
-        }
-        if (texture->format == SDL_PIXELFORMAT_NV12 ||
-            texture->format == SDL_PIXELFORMAT_NV21) {
-            // Need to add size for the U/V plane
-            size += 2 * ((texture->h + 1) / 2) * ((data->pitch + 1) / 2);
+        SDL_GPUTransferBufferCreateInfo tbci;
+        size_t pitch, size;
+
+        /* Rows are padded so that locks of whole rows start at an offset every backend can
+           upload from without an extra copy */
+        if (!SDL_size_mul_check_overflow(texture->w, SDL_BYTESPERPIXEL(texture->format), &pitch) ||
+            !SDL_size_add_check_overflow(pitch, GPU_UPLOAD_ALIGNMENT - 1, &pitch) ||
+            !SDL_size_mul_check_overflow(texture->h, pitch & ~(size_t)(GPU_UPLOAD_ALIGNMENT - 1), &size) ||
+            size > SDL_MAX_UINT32) {
+            SDL_free(data);
+            return SDL_SetError("Texture is too large");
         }
-        data->pixels = SDL_calloc(1, size);
-        if (!data->pixels) {
+        data->pitch = (Uint32)(pitch & ~(size_t)(GPU_UPLOAD_ALIGNMENT - 1));
+
+        SDL_zero(tbci);
+        tbci.size = (Uint32)size;
+        tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+
+        data->transfer_buf = SDL_CreateGPUTransferBuffer(renderdata->device, &tbci);
+        if (!data->transfer_buf) {
             SDL_free(data);
             return false;
         }
-
-        // TODO allocate a persistent transfer buffer
     }
 
     if (texture->access == SDL_TEXTUREACCESS_TARGET) {
@@ -241,6 +277,78 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
     return true;
 }
 
+static void ReleaseUploadBuffer(GPU_RenderData *data)
+{
+    if (data->uploads.transfer_buf) {
+        SDL_ReleaseGPUTransferBuffer(data->device, data->uploads.transfer_buf);
+        data->uploads.transfer_buf = NULL;
+    }
+
+    data->uploads.size = 0;
+    data->uploads.offset = 0;
+}
+
+static void CycleUploadBuffer(GPU_RenderData *data)
+{
+    // Uploads recorded in submitted command buffers may still be reading the current contents
+    data->uploads.offset = 0;
+    data->uploads.cycle = true;
+}
+
+static Uint8 *MapUploadBuffer(GPU_RenderData *data, size_t size, Uint32 *offset)
+{
+    Uint32 start;
+
+    if (size > SDL_MAX_UINT32 - GPU_UPLOAD_ALIGNMENT) {
+        SDL_SetError("update size overflow");
+        return NULL;
+    }
+
+    if (size > data->uploads.size) {
+        SDL_GPUTransferBufferCreateInfo tbci;
+        Uint32 new_size = GPU_UPLOAD_BUFFER_MIN_SIZE;
+
+        while (new_size < size) {
+            new_size = (new_size > SDL_MAX_UINT32 / 2) ? (Uint32)size : new_size * 2;
+        }
+
+        // Uploads already recorded keep the old buffer alive until they're done with it
+        ReleaseUploadBuffer(data);
+
+        SDL_zero(tbci);
+        tbci.size = new_size;
+        tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+
+        data->uploads.transfer_buf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
+
+        if (!data->uploads.transfer_buf) {
+            return NULL;
+        }
+
+        data->uploads.size = new_size;
+        data->uploads.cycle = false;
+    }
+
+    start = (data->uploads.offset + (GPU_UPLOAD_ALIGNMENT - 1)) & ~(Uint32)(GPU_UPLOAD_ALIGNMENT - 1);
+    if (start < data->uploads.offset || size > data->uploads.size - SDL_min(start, data->uploads.size)) {
+        // Out of space, start over in a fresh buffer
+        start = 0;
+        data->uploads.cycle = true;
+    }
+
+    Uint8 *mapped = SDL_MapGPUTransferBuffer(data->device, data->uploads.transfer_buf, data->uploads.cycle);
+
+    if (!mapped) {
+        return NULL;
+    }
+
+    data->uploads.cycle = false;
+    data->uploads.offset = start + (Uint32)size;
+    *offset = start;
+
+    return mapped + start;
+}
+
 static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                               const SDL_Rect *rect, const void *pixels, int pitch)
 {
@@ -255,19 +363,13 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
         return SDL_SetError("update size overflow");
     }
 
-    SDL_GPUTransferBufferCreateInfo tbci;
-    SDL_zero(tbci);
-    tbci.size = (Uint32)data_size;
-    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-
-    SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(renderdata->device, &tbci);
+    Uint32 offset;
+    Uint8 *output = MapUploadBuffer(renderdata, data_size, &offset);
 
-    if (tbuf == NULL) {
+    if (output == NULL) {
         return false;
     }
 
-    Uint8 *output = SDL_MapGPUTransferBuffer(renderdata->device, tbuf, false);
-
     if ((size_t)pitch == row_size) {
         SDL_memcpy(output, pixels, data_size);
     } else {
@@ -282,14 +384,15 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
         }
     }
 
-    SDL_UnmapGPUTransferBuffer(renderdata->device, tbuf);
+    SDL_UnmapGPUTransferBuffer(renderdata->device, renderdata->uploads.transfer_buf);
 
     SDL_GPUCommandBuffer *cbuf = renderdata->state.command_buffer;
     SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
 
     SDL_GPUTextureTransferInfo tex_src;
     SDL_zero(tex_src);
-    tex_src.transfer_buffer = tbuf;
+    tex_src.transfer_buffer = renderdata->uploads.transfer_buf;
+    tex_src.offset = offset;
     tex_src.rows_per_layer = rect->h;
     tex_src.pixels_per_row = rect->w;
 
@@ -304,7 +407,6 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 
     SDL_UploadToGPUTexture(cpass, &tex_src, &tex_dst, false);
     SDL_EndGPUCopyPass(cpass);
-    SDL_ReleaseGPUTransferBuffer(renderdata->device, tbuf);
 
     return true;
 }
@@ -312,27 +414,53 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 static bool GPU_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                             const SDL_Rect *rect, void **pixels, int *pitch)
 {
+    GPU_RenderData *renderdata = (GPU_RenderData *)renderer->internal;
     GPU_TextureData *data = (GPU_TextureData *)texture->internal;
 
+    /* Locked pixels don't have to keep their old contents, so cycle the transfer buffer.
+       If the GPU is still uploading from it, this switches to another backing buffer instead
+       of waiting, and the caller writes straight into memory that is uploaded at unlock. */
+    Uint8 *mapped = SDL_MapGPUTransferBuffer(renderdata->device, data->transfer_buf, true);
+
+    if (!mapped) {
+        return false;
+    }
+
     data->locked_rect = *rect;
-    *pixels =
-        (void *)((Uint8 *)data->pixels + rect->y * data->pitch +
-                 rect->x * SDL_BYTESPERPIXEL(texture->format));
-    *pitch = data->pitch;
+    *pixels = mapped + rect->y * data->pitch + rect->x * SDL_BYTESPERPIXEL(texture->format);
+    *pitch = (int)data->pitch;
     return true;
 }
 
 static void GPU_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    GPU_RenderData *renderdata = (GPU_RenderData *)renderer->internal;
     GPU_TextureData *data = (GPU_TextureData *)texture->internal;
-    const SDL_Rect *rect;
-    void *pixels;
-
-    rect = &data->locked_rect;
-    pixels =
-        (void *)((Uint8 *)data->pixels + rect->y * data->pitch +
-                 rect->x * SDL_BYTESPERPIXEL(texture->format));
-    GPU_UpdateTexture(renderer, texture, rect, pixels, data->pitch);
+    const SDL_Rect *rect = &data->locked_rect;
+
+    SDL_UnmapGPUTransferBuffer(renderdata->device, data->transfer_buf);
+
+    SDL_GPUCommandBuffer *cbuf = renderdata->state.command_buffer;
+    SDL_GPUCopyPass *cpass = SDL_BeginGPUCopyPass(cbuf);
+
+    SDL_GPUTextureTransferInfo tex_src;
+    SDL_zero(tex_src);
+    tex_src.transfer_buffer = data->transfer_buf;
+    tex_src.offset = rect->y * data->pitch + rect->x * SDL_BYTESPERPIXEL(texture->format);
+    tex_src.rows_per_layer = rect->h;
+    tex_src.pixels_per_row = data->pitch / SDL_BYTESPERPIXEL(texture->format);
+
+    SDL_GPUTextureRegion tex_dst;
+    SDL_zero(tex_dst);
+    tex_dst.texture = data->texture;
+    tex_dst.x = rect->x;
+    tex_dst.y = rect->y;
+    tex_dst.w = rect->w;
+    tex_dst.h = rect->h;
+    tex_dst.d = 1;
+
+    SDL_UploadToGPUTexture(cpass, &tex_src, &tex_dst, false);
+    SDL_EndGPUCopyPass(cpass);
 }
 
 static bool GPU_SetRenderTarget(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -485,7 +613,15 @@ static void PushUniforms(GPU_RenderData *data, SDL_RenderCommand *cmd)
         uniforms.texture_size[1] = cmd->data.draw.texture->h;
     }
 
+    // Uniforms stay bound for the rest of the command buffer, so skip pushing them again
+    if (data->state.shader_data_valid &&
+        SDL_memcmp(&uniforms, &data->state.shader_data, sizeof(uniforms)) == 0) {
+        return;
+    }
+
     SDL_PushGPUVertexUniformData(data->state.command_buffer, 0, &uniforms, sizeof(uniforms));
+    SDL_copyp(&data->state.shader_data, &uniforms);
+    data->state.shader_data_valid = true;
 }
 
 static SDL_GPUSampler **SamplerPointer(GPU_RenderData *data, SDL_TextureAddressMode address_mode, SDL_ScaleMode scale_mode)
@@ -835,9 +971,58 @@ static bool GPU_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     return true;
 }
 
-static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+// Take the smallest pooled download buffer that fits, or create a new one
+static SDL_GPUTransferBuffer *AcquireReadbackBuffer(GPU_RenderData *data, Uint32 size, Uint32 *buffer_size)
+{
+    int best = -1;
+
+    for (int i = 0; i < data->readbacks.count; ++i) {
+        if (data->readbacks.sizes[i] >= size && (best < 0 || data->readbacks.sizes[i] < data->readbacks.sizes[best])) {
+            best = i;
+        }
+    }
+
+    if (best >= 0) {
+        SDL_GPUTransferBuffer *tbuf = data->readbacks.transfer_bufs[best];
+        *buffer_size = data->readbacks.sizes[best];
+        --data->readbacks.count;
+        data->readbacks.transfer_bufs[best] = data->readbacks.transfer_bufs[data->readbacks.count];
+        data->readbacks.sizes[best] = data->readbacks.sizes[data->readbacks.count];
+        return tbuf;
+    }
+
+    SDL_GPUTransferBufferCreateInfo tbci;
+    SDL_zero(tbci);
+    tbci.size = size;
+    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
+
+    *buffer_size = size;
+    return SDL_CreateGPUTransferBuffer(data->device, &tbci);
+}
+
+static void ReleaseReadbackBuffer(GPU_RenderData *data, SDL_GPUTransferBuffer *tbuf, Uint32 size)
+{
+    if (data->readbacks.count < GPU_READBACK_POOL_SIZE) {
+        data->readbacks.transfer_bufs[data->readbacks.count] = tbuf;
+        data->readbacks.sizes[data->readbacks.count] = size;
+        ++data->readbacks.count;
+    } else {
+        SDL_ReleaseGPUTransferBuffer(data->device, tbuf);
+    }
+}
+
+static void ReleaseReadbackBuffers(GPU_RenderData *data)
+{
+    for (int i = 0; i < data->readbacks.count; ++i) {
+        SDL_ReleaseGPUTransferBuffer(data->device, data->readbacks.transfer_bufs[i]);
+    }
+    data->readbacks.count = 0;
+}
+
+static bool GPU_RenderReadPixelsAsync(SDL_Renderer *renderer, SDL_RenderReadback *readback)
 {
     GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    const SDL_Rect *rect = &readback->rect;
     SDL_GPUTexture *gpu_tex;
     SDL_PixelFormat pixfmt;
 
@@ -851,8 +1036,7 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
         pixfmt = TexFormatToPixFormat(data->backbuffer.format);
 
         if (pixfmt == SDL_PIXELFORMAT_UNKNOWN) {
-            SDL_SetError("Unsupported backbuffer format");
-            return NULL;
+            return SDL_SetError("Unsupported backbuffer format");
         }
     }
 
@@ -860,26 +1044,21 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
     size_t row_size, image_size;
 
     if (!SDL_size_mul_check_overflow(rect->w, bpp, &row_size) ||
-        !SDL_size_mul_check_overflow(rect->h, row_size, &image_size)) {
-        SDL_SetError("read size overflow");
-        return NULL;
+        !SDL_size_mul_check_overflow(rect->h, row_size, &image_size) ||
+        image_size > SDL_MAX_UINT32) {
+        return SDL_SetError("read size overflow");
     }
 
-    SDL_Surface *surface = SDL_CreateSurface(rect->w, rect->h, pixfmt);
-
-    if (!surface) {
-        return NULL;
+    GPU_ReadbackData *rbdata = (GPU_ReadbackData *)SDL_calloc(1, sizeof(*rbdata));
+    if (!rbdata) {
+        return false;
     }
+    rbdata->format = pixfmt;
+    rbdata->transfer_buf = AcquireReadbackBuffer(data, (Uint32)image_size, &rbdata->size);
 
-    SDL_GPUTransferBufferCreateInfo tbci;
-    SDL_zero(tbci);
-    tbci.size = (Uint32)image_size;
-    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD;
-
-    SDL_GPUTransferBuffer *tbuf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
-
-    if (!tbuf) {
-        return NULL;
+    if (!rbdata->transfer_buf) {
+        SDL_free(rbdata);
+        return false;
     }
 
     SDL_GPUCopyPass *pass = SDL_BeginGPUCopyPass(data->state.command_buffer);
@@ -895,19 +1074,56 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
 
     SDL_GPUTextureTransferInfo dst;
     SDL_zero(dst);
-    dst.transfer_buffer = tbuf;
+    dst.transfer_buffer = rbdata->transfer_buf;
     dst.rows_per_layer = rect->h;
     dst.pixels_per_row = rect->w;
 
     SDL_DownloadFromGPUTexture(pass, &src, &dst);
     SDL_EndGPUCopyPass(pass);
 
-    SDL_GPUFence *fence = SDL_SubmitGPUCommandBufferAndAcquireFence(data->state.command_buffer);
-    SDL_WaitForGPUFences(data->device, true, &fence, 1);
-    SDL_ReleaseGPUFence(data->device, fence);
+    // Submit the download now and keep rendering on a new command buffer
+    rbdata->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(data->state.command_buffer);
     data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
+    data->state.shader_data_valid = false;
 
-    void *mapped_tbuf = SDL_MapGPUTransferBuffer(data->device, tbuf, false);
+    readback->internal = rbdata;
+    return true;
+}
+
+static bool GPU_IsReadbackComplete(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    GPU_ReadbackData *rbdata = (GPU_ReadbackData *)readback->internal;
+
+    return !rbdata->fence || SDL_QueryGPUFence(data->device, rbdata->fence);
+}
+
+static SDL_Surface *GPU_FinishReadback(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    GPU_ReadbackData *rbdata = (GPU_ReadbackData *)readback->internal;
+    const SDL_Rect *rect = &readback->rect;
+
+    if (rbdata->fence) {
+        SDL_WaitForGPUFences(data->device, true, &rbdata->fence, 1);
+        SDL_ReleaseGPUFence(data->device, rbdata->fence);
+        rbdata->fence = NULL;
+    }
+
+    SDL_Surface *surface = SDL_CreateSurface(rect->w, rect->h, rbdata->format);
+
+    if (!surface) {
+        return NULL;
+    }
+
+    const size_t row_size = (size_t)rect->w * SDL_BYTESPERPIXEL(rbdata->format);
+    const size_t image_size = row_size * rect->h;
+    void *mapped_tbuf = SDL_MapGPUTransferBuffer(data->device, rbdata->transfer_buf, false);
+
+    if (!mapped_tbuf) {
+        SDL_DestroySurface(surface);
+        return NULL;
+    }
 
     if ((size_t)surface->pitch == row_size) {
         SDL_memcpy(surface->pixels, mapped_tbuf, image_size);
@@ -922,8 +1138,41 @@ static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect
         }
     }
 
-    SDL_UnmapGPUTransferBuffer(data->device, tbuf);
-    SDL_ReleaseGPUTransferBuffer(data->device, tbuf);
+    SDL_UnmapGPUTransferBuffer(data->device, rbdata->transfer_buf);
+
+    return surface;
+}
+
+static void GPU_ReleaseReadback(SDL_Renderer *renderer, SDL_RenderReadback *readback)
+{
+    GPU_RenderData *data = (GPU_RenderData *)renderer->internal;
+    GPU_ReadbackData *rbdata = (GPU_ReadbackData *)readback->internal;
+
+    if (rbdata->fence) {
+        // The download is still pending, the device frees the buffer once it's done
+        SDL_ReleaseGPUFence(data->device, rbdata->fence);
+        SDL_ReleaseGPUTransferBuffer(data->device, rbdata->transfer_buf);
+    } else {
+        ReleaseReadbackBuffer(data, rbdata->transfer_buf, rbdata->size);
+    }
+
+    SDL_free(rbdata);
+    readback->internal = NULL;
+}
+
+static SDL_Surface *GPU_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
+{
+    SDL_RenderReadback readback;
+    SDL_Surface *surface;
+
+    SDL_zero(readback);
+    readback.rect = *rect;
+
+    if (!GPU_RenderReadPixelsAsync(renderer, &readback)) {
+        return NULL;
+    }
+    surface = GPU_FinishReadback(renderer, &readback);
+    GPU_ReleaseReadback(renderer, &readback);
 
     return surface;
 }
@@ -990,6 +1239,8 @@ static bool GPU_RenderPresent(SDL_Renderer *renderer)
     }
 
     data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
+    data->state.shader_data_valid = false;
+    CycleUploadBuffer(data);
 
     return true;
 }
@@ -1008,7 +1259,9 @@ static void GPU_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     }
 
     SDL_ReleaseGPUTexture(renderdata->device, data->texture);
-    SDL_free(data->pixels);
+    if (data->transfer_buf) {
+        SDL_ReleaseGPUTransferBuffer(renderdata->device, data->transfer_buf);
+    }
     SDL_free(data);
     texture->internal = NULL;
 }
@@ -1039,6 +1292,8 @@ static void GPU_DestroyRenderer(SDL_Renderer *renderer)
     }
 
     ReleaseVertexBuffer(data);
+    ReleaseUploadBuffer(data);
+    ReleaseReadbackBuffers(data);
     GPU_DestroyPipelineCache(&data->pipeline_cache);
     GPU_ReleaseShaders(&data->shaders, data->device);
     SDL_DestroyGPUDevice(data->device);
@@ -1185,6 +1440,10 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     renderer->InvalidateCachedState = GPU_InvalidateCachedState;
     renderer->RunCommandQueue = GPU_RunCommandQueue;
     renderer->RenderReadPixels = GPU_RenderReadPixels;
+    renderer->RenderReadPixelsAsync = GPU_RenderReadPixelsAsync;
+    renderer->IsReadbackComplete = GPU_IsReadbackComplete;
+    renderer->FinishReadback = GPU_FinishReadback;
+    renderer->ReleaseReadback = GPU_ReleaseReadback;
     renderer->RenderPresent = GPU_RenderPresent;
     renderer->DestroyTexture = GPU_DestroyTexture;
     renderer->DestroyRenderer = GPU_DestroyRenderer;
@@ -1255,6 +1514,7 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     data->state.viewport.min_depth = 0;
     data->state.viewport.max_depth = 1;
     data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
+    data->state.shader_data_valid = false;
 
     int w, h;
     SDL_GetWindowSizeInPixels(window, &w, &h);
@@ -628,6 +628,9 @@ static bool METAL_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
             if (!surface) {
                 return SDL_SetError("CVPixelBufferGetIOSurface() failed");
             }
+        } else {
+            // The Metal textures retain the surface, so it can be shared by another process
+            surface = (IOSurfaceRef)SDL_GetPointerProperty(create_props, SDL_PROP_TEXTURE_CREATE_METAL_IOSURFACE_POINTER, nil);
         }
 
         switch (texture->format) {
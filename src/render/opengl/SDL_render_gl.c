@@ -84,6 +84,21 @@ typedef struct
     SDL_FColor clear_color;
 } GL_DrawStateCache;
 
+// The vertex ring buffer is split into segments, each guarded by a fence from its last use
+#define GL_VERTEX_RING_SEGMENTS     4
+#define GL_VERTEX_RING_DEFAULT_SIZE (1024 * 1024)
+
+typedef struct
+{
+    GLuint buffer;
+    size_t size;
+    size_t offset;
+    Uint8 *mapping;
+    size_t first_segment;
+    size_t last_segment;
+    GLsync fences[GL_VERTEX_RING_SEGMENTS];
+} GL_VertexRing;
+
 typedef struct
 {
     SDL_GLContext context;
@@ -118,6 +133,19 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    // Persistently mapped vertex buffer support
+    bool GL_ARB_buffer_storage_supported;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+    GL_VertexRing vertex_ring;
+
     // Shader support
     GL_ShaderContext *shaders;
 
@@ -1231,15 +1259,123 @@ static void GL_InvalidateCachedState(SDL_Renderer *renderer)
     cache->clear_color_dirty = true;
 }
 
+static void GL_DestroyVertexRing(GL_RenderData *data)
+{
+    GL_VertexRing *ring = &data->vertex_ring;
+
+    for (int i = 0; i < GL_VERTEX_RING_SEGMENTS; ++i) {
+        if (ring->fences[i]) {
+            data->glDeleteSync(ring->fences[i]);
+            ring->fences[i] = NULL;
+        }
+    }
+    if (ring->buffer) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+        data->glUnmapBuffer(GL_ARRAY_BUFFER);
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        data->glDeleteBuffers(1, &ring->buffer);
+        ring->buffer = 0;
+    }
+    ring->mapping = NULL;
+    ring->size = 0;
+    ring->offset = 0;
+}
+
+static bool GL_CreateVertexRing(GL_RenderData *data, size_t size)
+{
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_VertexRing *ring = &data->vertex_ring;
+
+    GL_DestroyVertexRing(data);
+
+    data->glGenBuffers(1, &ring->buffer);
+    data->glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+    data->glBufferStorage(GL_ARRAY_BUFFER, (GLsizeiptr)size, NULL, flags);
+    ring->mapping = (Uint8 *)data->glMapBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)size, flags);
+    data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    if (!ring->mapping) {
+        GL_DestroyVertexRing(data);
+        return false;
+    }
+    ring->size = size;
+    return true;
+}
+
+/* Copies the vertices into the ring buffer, without reallocating or orphaning it,
+   and returns their offset in the buffer. */
+static bool GL_UploadVertexRing(GL_RenderData *data, const void *vertices, size_t vertsize, size_t *offset)
+{
+    GL_VertexRing *ring = &data->vertex_ring;
+    size_t segment_size = ring->size / GL_VERTEX_RING_SEGMENTS;
+    size_t start = ring->offset;
+
+    if (vertsize > segment_size) {
+        size_t size = GL_VERTEX_RING_DEFAULT_SIZE;
+        while (size / GL_VERTEX_RING_SEGMENTS < vertsize) {
+            size *= 2;
+        }
+        if (!GL_CreateVertexRing(data, size)) {
+            return false;
+        }
+        segment_size = ring->size / GL_VERTEX_RING_SEGMENTS;
+        start = 0;
+    }
+
+    if (start + vertsize > ring->size) {
+        start = 0;
+    }
+
+    ring->first_segment = start / segment_size;
+    ring->last_segment = (start + vertsize - 1) / segment_size;
+
+    // Wait for the GPU to finish with segments we're about to reuse
+    for (size_t i = ring->first_segment; i <= ring->last_segment; ++i) {
+        if (i * segment_size >= ring->offset || start < ring->offset) {
+            if (ring->fences[i]) {
+                data->glClientWaitSync(ring->fences[i], GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+                data->glDeleteSync(ring->fences[i]);
+                ring->fences[i] = NULL;
+            }
+        }
+    }
+
+    SDL_memcpy(ring->mapping + start, vertices, vertsize);
+    ring->offset = start + vertsize;
+    *offset = start;
+    return true;
+}
+
+static void GL_FenceVertexRing(GL_RenderData *data)
+{
+    GL_VertexRing *ring = &data->vertex_ring;
+
+    for (size_t i = ring->first_segment; i <= ring->last_segment; ++i) {
+        if (ring->fences[i]) {
+            data->glDeleteSync(ring->fences[i]);
+        }
+        ring->fences[i] = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
 static bool GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
-    // !!! FIXME: it'd be nice to use a vertex buffer instead of immediate mode...
     GL_RenderData *data = (GL_RenderData *)renderer->internal;
+    bool vertex_ring_bound = false;
 
     if (!GL_ActivateRenderer(renderer)) {
         return false;
     }
 
+    if (data->GL_ARB_buffer_storage_supported && vertsize > 0) {
+        size_t offset;
+        if (GL_UploadVertexRing(data, vertices, vertsize, &offset)) {
+            // The vertex pointers set up below become offsets into the bound buffer
+            data->glBindBuffer(GL_ARRAY_BUFFER, data->vertex_ring.buffer);
+            vertices = (void *)(uintptr_t)offset;
+            vertex_ring_bound = true;
+        }
+    }
+
     data->drawstate.target = renderer->target;
     if (!data->drawstate.target) {
         int w, h;
@@ -1481,6 +1617,11 @@ static bool GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         data->drawstate.texture_array = false;
     }
 
+    if (vertex_ring_bound) {
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GL_FenceVertexRing(data);
+    }
+
     return GL_CheckError("", renderer);
 }
 
@@ -1596,6 +1737,9 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
             GL_DestroyShaderContext(data->shaders);
         }
         if (data->context) {
+            if (data->GL_ARB_buffer_storage_supported) {
+                GL_DestroyVertexRing(data);
+            }
             while (data->framebuffers) {
                 GL_FBOList *nextnode = data->framebuffers->next;
                 // delete the framebuffer object
@@ -1699,6 +1843,7 @@ static bool GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pr
     renderer->window = window;
 
     renderer->name = GL_RenderDriver.name;
+    renderer->persistent_texture_lock = true;
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_ARGB8888);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_ABGR8888);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_XRGB8888);
@@ -1824,6 +1969,25 @@ static bool GL_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_Pr
         goto error;
     }
 
+    // Stream vertices through a persistently mapped ring buffer instead of client memory, if we can
+    if (SDL_GL_ExtensionSupported("GL_ARB_buffer_storage") && SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers");
+        data->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)SDL_GL_GetProcAddress("glDeleteBuffers");
+        data->glBindBuffer = (PFNGLBINDBUFFERPROC)SDL_GL_GetProcAddress("glBindBuffer");
+        data->glBufferStorage = (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress("glBufferStorage");
+        data->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)SDL_GL_GetProcAddress("glUnmapBuffer");
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glGenBuffers && data->glDeleteBuffers && data->glBindBuffer &&
+            data->glBufferStorage && data->glMapBufferRange && data->glUnmapBuffer &&
+            data->glFenceSync && data->glClientWaitSync && data->glDeleteSync &&
+            GL_CreateVertexRing(data, GL_VERTEX_RING_DEFAULT_SIZE)) {
+            data->GL_ARB_buffer_storage_supported = true;
+        }
+    }
+
     // Set up parameters for rendering
     data->glMatrixMode(GL_MODELVIEW);
     data->glLoadIdentity();
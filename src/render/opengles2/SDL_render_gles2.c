@@ -45,6 +45,10 @@
 #define RENDERER_CONTEXT_MAJOR 2
 #define RENDERER_CONTEXT_MINOR 0
 
+// The header of the program binary cache file, "SGPB" and a version
+#define GLES2_PROGRAM_CACHE_MAGIC   0x42504753
+#define GLES2_PROGRAM_CACHE_VERSION 1
+
 /*************************************************************************************************
  * Context structures                                                                            *
  *************************************************************************************************/
@@ -71,6 +75,7 @@ typedef struct GLES2_TextureData
     // YUV texture support
     bool yuv;
     bool nv12;
+    bool packed;
     GLuint texture_v;
     GLuint texture_v_external;
     GLuint texture_u;
@@ -112,8 +117,8 @@ SDL_COMPILE_TIME_ASSERT(GLES2_UniformNames, SDL_arraysize(GLES2_UniformNames) ==
 typedef struct GLES2_ProgramCacheEntry
 {
     GLuint id;
-    GLuint vertex_shader;
-    GLuint fragment_shader;
+    GLES2_ShaderType vertex_type;
+    GLES2_ShaderType fragment_type;
     GLuint uniform_locations[NUM_GLES2_UNIFORMS];
     GLfloat projection[4][4];
     const float *shader_params;
@@ -128,6 +133,17 @@ typedef struct GLES2_ProgramCache
     GLES2_ProgramCacheEntry *tail;
 } GLES2_ProgramCache;
 
+// A linked program saved with glGetProgramBinaryOES()
+typedef struct GLES2_ProgramBinary
+{
+    Uint32 vertex_type;
+    Uint32 fragment_type;
+    Uint32 source_hash;
+    Uint32 format;
+    Uint32 length;
+    void *binary;
+} GLES2_ProgramBinary;
+
 typedef enum
 {
     GLES2_IMAGESOURCE_INVALID,
@@ -139,6 +155,9 @@ typedef enum
     GLES2_IMAGESOURCE_TEXTURE_YUV,
     GLES2_IMAGESOURCE_TEXTURE_NV12,
     GLES2_IMAGESOURCE_TEXTURE_NV21,
+    GLES2_IMAGESOURCE_TEXTURE_YUY2,
+    GLES2_IMAGESOURCE_TEXTURE_UYVY,
+    GLES2_IMAGESOURCE_TEXTURE_YVYU,
     GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES
 } GLES2_ImageSource;
 
@@ -184,6 +203,15 @@ typedef struct GLES2_RenderData
     GLES2_ProgramCache program_cache;
     Uint8 clear_r, clear_g, clear_b, clear_a;
 
+    // The on-disk program binary cache, if SDL_PROP_RENDERER_CREATE_OPENGLES2_PROGRAM_CACHE_STRING was set
+    PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOES;
+    PFNGLPROGRAMBINARYOESPROC glProgramBinaryOES;
+    char *program_binary_path;
+    Uint32 program_binary_driver_hash;
+    GLES2_ProgramBinary *program_binaries;
+    int num_program_binaries;
+    bool program_binaries_changed;
+
 #if USE_VERTEX_BUFFER_OBJECTS
     GLuint vertex_buffers[8];
     size_t vertex_buffer_size[8];
@@ -405,16 +433,235 @@ static bool GLES2_SupportsBlendMode(SDL_Renderer *renderer, SDL_BlendMode blendM
     return true;
 }
 
-static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuint vertex, GLuint fragment)
+static GLuint GLES2_CacheShader(GLES2_RenderData *data, GLES2_ShaderType type, GLenum shader_type);
+
+static Uint32 GLES2_HashString(Uint32 crc, const char *string)
+{
+    if (string) {
+        crc = SDL_crc32(crc, string, SDL_strlen(string));
+    }
+    return crc;
+}
+
+// Program binaries are keyed by the source SDL would compile for them, so they're rebuilt when the shaders change
+static Uint32 GLES2_HashProgramSource(GLES2_RenderData *data, GLES2_ShaderType vtype, GLES2_ShaderType ftype)
+{
+    Uint32 crc = 0;
+
+    crc = GLES2_HashString(crc, GLES2_GetShaderPrologue(vtype));
+    crc = GLES2_HashString(crc, GLES2_GetShader(vtype));
+    crc = GLES2_HashString(crc, GLES2_GetShaderPrologue(ftype));
+    crc = GLES2_HashString(crc, GLES2_GetShaderInclude(data->texcoord_precision_hint));
+    crc = GLES2_HashString(crc, GLES2_GetShader(ftype));
+    return crc;
+}
+
+static void GLES2_LoadProgramBinaries(GLES2_RenderData *data)
+{
+    SDL_IOStream *io = NULL;
+    size_t size = 0;
+    void *file;
+    Uint32 magic, version, driver_hash, count, i;
+
+    file = SDL_LoadFile(data->program_binary_path, &size);
+    if (!file) {
+        return; // not created yet
+    }
+
+    io = SDL_IOFromConstMem(file, size);
+    if (io &&
+        SDL_ReadU32LE(io, &magic) && magic == GLES2_PROGRAM_CACHE_MAGIC &&
+        SDL_ReadU32LE(io, &version) && version == GLES2_PROGRAM_CACHE_VERSION &&
+        SDL_ReadU32LE(io, &driver_hash) && driver_hash == data->program_binary_driver_hash &&
+        SDL_ReadU32LE(io, &count)) {
+        for (i = 0; i < count; ++i) {
+            GLES2_ProgramBinary entry, *entries;
+
+            SDL_zero(entry);
+            if (!SDL_ReadU32LE(io, &entry.vertex_type) ||
+                !SDL_ReadU32LE(io, &entry.fragment_type) ||
+                !SDL_ReadU32LE(io, &entry.source_hash) ||
+                !SDL_ReadU32LE(io, &entry.format) ||
+                !SDL_ReadU32LE(io, &entry.length) ||
+                entry.length == 0 || entry.length > size) {
+                break;
+            }
+            entry.binary = SDL_malloc(entry.length);
+            if (!entry.binary || SDL_ReadIO(io, entry.binary, entry.length) != entry.length) {
+                SDL_free(entry.binary);
+                break;
+            }
+            entries = (GLES2_ProgramBinary *)SDL_realloc(data->program_binaries, (data->num_program_binaries + 1) * sizeof(*entries));
+            if (!entries) {
+                SDL_free(entry.binary);
+                break;
+            }
+            data->program_binaries = entries;
+            data->program_binaries[data->num_program_binaries++] = entry;
+        }
+    }
+    SDL_CloseIO(io);
+    SDL_free(file);
+}
+
+static void GLES2_SaveProgramBinaries(GLES2_RenderData *data)
+{
+    SDL_IOStream *io;
+    bool result;
+    int i;
+
+    if (!data->program_binary_path || !data->program_binaries_changed) {
+        return;
+    }
+
+    io = SDL_IOFromFile(data->program_binary_path, "wb");
+    if (!io) {
+        return;
+    }
+
+    result = SDL_WriteU32LE(io, GLES2_PROGRAM_CACHE_MAGIC) &&
+             SDL_WriteU32LE(io, GLES2_PROGRAM_CACHE_VERSION) &&
+             SDL_WriteU32LE(io, data->program_binary_driver_hash) &&
+             SDL_WriteU32LE(io, (Uint32)data->num_program_binaries);
+    for (i = 0; result && i < data->num_program_binaries; ++i) {
+        const GLES2_ProgramBinary *entry = &data->program_binaries[i];
+        result = SDL_WriteU32LE(io, entry->vertex_type) &&
+                 SDL_WriteU32LE(io, entry->fragment_type) &&
+                 SDL_WriteU32LE(io, entry->source_hash) &&
+                 SDL_WriteU32LE(io, entry->format) &&
+                 SDL_WriteU32LE(io, entry->length) &&
+                 SDL_WriteIO(io, entry->binary, entry->length) == entry->length;
+    }
+    if (!SDL_CloseIO(io) || !result) {
+        // Don't leave a partial cache behind
+        SDL_RemovePath(data->program_binary_path);
+    }
+}
+
+static void GLES2_InitProgramBinaryCache(GLES2_RenderData *data, SDL_PropertiesID create_props)
+{
+    const char *path = SDL_GetStringProperty(create_props, SDL_PROP_RENDERER_CREATE_OPENGLES2_PROGRAM_CACHE_STRING, NULL);
+    GLint num_formats = 0;
+    Uint32 hash = 0;
+
+    if (!path || !*path || !SDL_GL_ExtensionSupported("GL_OES_get_program_binary")) {
+        return;
+    }
+
+    data->glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &num_formats);
+    if (num_formats <= 0) {
+        return;
+    }
+
+    data->glGetProgramBinaryOES = (PFNGLGETPROGRAMBINARYOESPROC)SDL_GL_GetProcAddress("glGetProgramBinaryOES");
+    data->glProgramBinaryOES = (PFNGLPROGRAMBINARYOESPROC)SDL_GL_GetProcAddress("glProgramBinaryOES");
+    if (!data->glGetProgramBinaryOES || !data->glProgramBinaryOES) {
+        return;
+    }
+
+    data->program_binary_path = SDL_strdup(path);
+    if (!data->program_binary_path) {
+        return;
+    }
+
+    // Program binaries are only valid for the driver that made them
+    hash = GLES2_HashString(hash, (const char *)data->glGetString(GL_VENDOR));
+    hash = GLES2_HashString(hash, (const char *)data->glGetString(GL_RENDERER));
+    hash = GLES2_HashString(hash, (const char *)data->glGetString(GL_VERSION));
+    data->program_binary_driver_hash = hash;
+
+    GLES2_LoadProgramBinaries(data);
+}
+
+static bool GLES2_LoadProgramBinary(GLES2_RenderData *data, GLuint program, GLES2_ShaderType vtype, GLES2_ShaderType ftype)
+{
+    Uint32 source_hash;
+    GLint linkSuccessful = GL_FALSE;
+    int i;
+
+    if (!data->program_binary_path) {
+        return false;
+    }
+
+    source_hash = GLES2_HashProgramSource(data, vtype, ftype);
+    for (i = 0; i < data->num_program_binaries; ++i) {
+        const GLES2_ProgramBinary *entry = &data->program_binaries[i];
+        if (entry->vertex_type == (Uint32)vtype && entry->fragment_type == (Uint32)ftype && entry->source_hash == source_hash) {
+            break;
+        }
+    }
+    if (i == data->num_program_binaries) {
+        return false;
+    }
+
+    data->glProgramBinaryOES(program, data->program_binaries[i].format, data->program_binaries[i].binary, (GLint)data->program_binaries[i].length);
+    data->glGetProgramiv(program, GL_LINK_STATUS, &linkSuccessful);
+    if (!linkSuccessful) {
+        // The driver can reject binaries at any time, link this program from source again
+        SDL_free(data->program_binaries[i].binary);
+        data->program_binaries[i] = data->program_binaries[--data->num_program_binaries];
+        data->program_binaries_changed = true;
+        while (data->glGetError() != GL_NO_ERROR) {
+            // continue;
+        }
+        return false;
+    }
+    return true;
+}
+
+static void GLES2_SaveProgramBinary(GLES2_RenderData *data, GLuint program, GLES2_ShaderType vtype, GLES2_ShaderType ftype)
+{
+    GLES2_ProgramBinary entry, *entries;
+    GLint length = 0;
+    GLsizei written = 0;
+    GLenum format = 0;
+
+    if (!data->program_binary_path) {
+        return;
+    }
+
+    data->glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    SDL_zero(entry);
+    entry.binary = SDL_malloc(length);
+    if (!entry.binary) {
+        return;
+    }
+    data->glGetProgramBinaryOES(program, length, &written, &format, entry.binary);
+    if (written <= 0) {
+        SDL_free(entry.binary);
+        return;
+    }
+
+    entries = (GLES2_ProgramBinary *)SDL_realloc(data->program_binaries, (data->num_program_binaries + 1) * sizeof(*entries));
+    if (!entries) {
+        SDL_free(entry.binary);
+        return;
+    }
+    entry.vertex_type = (Uint32)vtype;
+    entry.fragment_type = (Uint32)ftype;
+    entry.source_hash = GLES2_HashProgramSource(data, vtype, ftype);
+    entry.format = (Uint32)format;
+    entry.length = (Uint32)written;
+    data->program_binaries = entries;
+    data->program_binaries[data->num_program_binaries++] = entry;
+    data->program_binaries_changed = true;
+}
+
+static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLES2_ShaderType vtype, GLES2_ShaderType ftype)
 {
     GLES2_ProgramCacheEntry *entry;
+    GLuint vertex, fragment;
     GLint linkSuccessful;
     int i;
 
     // Check if we've already cached this program
     entry = data->program_cache.head;
     while (entry) {
-        if (entry->vertex_shader == vertex && entry->fragment_shader == fragment) {
+        if (entry->vertex_type == vtype && entry->fragment_type == ftype) {
             break;
         }
         entry = entry->next;
@@ -440,23 +687,41 @@ static GLES2_ProgramCacheEntry *GLES2_CacheProgram(GLES2_RenderData *data, GLuin
     if (!entry) {
         return NULL;
     }
-    entry->vertex_shader = vertex;
-    entry->fragment_shader = fragment;
+    entry->vertex_type = vtype;
+    entry->fragment_type = ftype;
 
-    // Create the program and link it
+    // Create the program, from the program binary cache if we can, otherwise compile and link it
     entry->id = data->glCreateProgram();
-    data->glAttachShader(entry->id, vertex);
-    data->glAttachShader(entry->id, fragment);
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_POSITION, "a_position");
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
-    data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
-    data->glLinkProgram(entry->id);
-    data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
-    if (!linkSuccessful) {
-        data->glDeleteProgram(entry->id);
-        SDL_free(entry);
-        SDL_SetError("Failed to link shader program");
-        return NULL;
+    if (!GLES2_LoadProgramBinary(data, entry->id, vtype, ftype)) {
+        vertex = data->shader_id_cache[(Uint32)vtype];
+        if (!vertex) {
+            vertex = GLES2_CacheShader(data, vtype, GL_VERTEX_SHADER);
+        }
+        fragment = data->shader_id_cache[(Uint32)ftype];
+        if (!fragment && vertex) {
+            fragment = GLES2_CacheShader(data, ftype, GL_FRAGMENT_SHADER);
+        }
+        if (!vertex || !fragment) {
+            data->glDeleteProgram(entry->id);
+            SDL_free(entry);
+            return NULL;
+        }
+
+        data->glAttachShader(entry->id, vertex);
+        data->glAttachShader(entry->id, fragment);
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_POSITION, "a_position");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_COLOR, "a_color");
+        data->glBindAttribLocation(entry->id, GLES2_ATTRIBUTE_TEXCOORD, "a_texCoord");
+        data->glLinkProgram(entry->id);
+        data->glGetProgramiv(entry->id, GL_LINK_STATUS, &linkSuccessful);
+        if (!linkSuccessful) {
+            data->glDeleteProgram(entry->id);
+            SDL_free(entry);
+            SDL_SetError("Failed to link shader program");
+            return NULL;
+        }
+
+        GLES2_SaveProgramBinary(data, entry->id, vtype, ftype);
     }
 
     // Predetermine locations of uniform variables
@@ -604,8 +869,6 @@ static bool GLES2_CacheShaders(GLES2_RenderData *data)
 
 static bool GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source, SDL_Colorspace colorspace)
 {
-    GLuint vertex;
-    GLuint fragment;
     GLES2_ShaderType vtype, ftype;
     GLES2_ProgramCacheEntry *program;
     const float *shader_params = NULL;
@@ -661,6 +924,30 @@ static bool GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source
             goto fault;
         }
         break;
+    case GLES2_IMAGESOURCE_TEXTURE_YUY2:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YUY2;
+        shader_params = SDL_GetYCbCRtoRGBConversionMatrix(colorspace, 0, 0, 8);
+        if (!shader_params) {
+            SDL_SetError("Unsupported YUV colorspace");
+            goto fault;
+        }
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_UYVY:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_UYVY;
+        shader_params = SDL_GetYCbCRtoRGBConversionMatrix(colorspace, 0, 0, 8);
+        if (!shader_params) {
+            SDL_SetError("Unsupported YUV colorspace");
+            goto fault;
+        }
+        break;
+    case GLES2_IMAGESOURCE_TEXTURE_YVYU:
+        ftype = GLES2_SHADER_FRAGMENT_TEXTURE_YVYU;
+        shader_params = SDL_GetYCbCRtoRGBConversionMatrix(colorspace, 0, 0, 8);
+        if (!shader_params) {
+            SDL_SetError("Unsupported YUV colorspace");
+            goto fault;
+        }
+        break;
 #endif // SDL_HAVE_YUV
     case GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES:
         ftype = GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES;
@@ -669,33 +956,16 @@ static bool GLES2_SelectProgram(GLES2_RenderData *data, GLES2_ImageSource source
         goto fault;
     }
 
-    // Load the requested shaders
-    vertex = data->shader_id_cache[(Uint32)vtype];
-    if (!vertex) {
-        vertex = GLES2_CacheShader(data, vtype, GL_VERTEX_SHADER);
-        if (!vertex) {
-            goto fault;
-        }
-    }
-
-    fragment = data->shader_id_cache[(Uint32)ftype];
-    if (!fragment) {
-        fragment = GLES2_CacheShader(data, ftype, GL_FRAGMENT_SHADER);
-        if (!fragment) {
-            goto fault;
-        }
-    }
-
     // Check if we need to change programs at all
     if (data->drawstate.program &&
-        data->drawstate.program->vertex_shader == vertex &&
-        data->drawstate.program->fragment_shader == fragment &&
+        data->drawstate.program->vertex_type == vtype &&
+        data->drawstate.program->fragment_type == ftype &&
         data->drawstate.program->shader_params == shader_params) {
         return true;
     }
 
-    // Generate a matching program
-    program = GLES2_CacheProgram(data, vertex, fragment);
+    // Generate a matching program, compiling its shaders if needed
+    program = GLES2_CacheProgram(data, vtype, ftype);
     if (!program) {
         goto fault;
     }
@@ -1146,6 +1416,15 @@ static bool SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, v
             case SDL_PIXELFORMAT_NV21:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
                 break;
+            case SDL_PIXELFORMAT_YUY2:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_YUY2;
+                break;
+            case SDL_PIXELFORMAT_UYVY:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_UYVY;
+                break;
+            case SDL_PIXELFORMAT_YVYU:
+                sourceType = GLES2_IMAGESOURCE_TEXTURE_YVYU;
+                break;
 #endif
             case SDL_PIXELFORMAT_EXTERNAL_OES:
                 sourceType = GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES;
@@ -1181,6 +1460,15 @@ static bool SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, v
         case SDL_PIXELFORMAT_NV21:
             sourceType = GLES2_IMAGESOURCE_TEXTURE_NV21;
             break;
+        case SDL_PIXELFORMAT_YUY2:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_YUY2;
+            break;
+        case SDL_PIXELFORMAT_UYVY:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_UYVY;
+            break;
+        case SDL_PIXELFORMAT_YVYU:
+            sourceType = GLES2_IMAGESOURCE_TEXTURE_YVYU;
+            break;
 #endif
         case SDL_PIXELFORMAT_EXTERNAL_OES:
             sourceType = GLES2_IMAGESOURCE_TEXTURE_EXTERNAL_OES;
@@ -1202,7 +1490,7 @@ static bool SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, v
             data->glBindTexture(tdata->texture_type, tdata->texture_u);
 
             data->glActiveTexture(GL_TEXTURE0);
-        } else if (tdata->nv12) {
+        } else if (tdata->nv12 || tdata->packed) {
             data->glActiveTexture(GL_TEXTURE1);
             data->glBindTexture(tdata->texture_type, tdata->texture_u);
 
@@ -1228,7 +1516,7 @@ static bool SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, v
             }
 
             data->glActiveTexture(GL_TEXTURE0);
-        } else if (tdata->nv12) {
+        } else if (tdata->nv12 || tdata->packed) {
             data->glActiveTexture(GL_TEXTURE1);
             if (!SetTextureScaleMode(data, tdata->texture_type, cmd->data.draw.texture_scale_mode)) {
                 return false;
@@ -1258,7 +1546,7 @@ static bool SetCopyState(SDL_Renderer *renderer, const SDL_RenderCommand *cmd, v
             }
 
             data->glActiveTexture(GL_TEXTURE0);
-        } else if (tdata->nv12) {
+        } else if (tdata->nv12 || tdata->packed) {
             data->glActiveTexture(GL_TEXTURE1);
             if (!SetTextureAddressMode(data, tdata->texture_type, cmd->data.draw.texture_address_mode)) {
                 return false;
@@ -1528,6 +1816,15 @@ static void GLES2_DestroyRenderer(SDL_Renderer *renderer)
                 entry = next;
             }
         }
+        {
+            int i;
+            GLES2_SaveProgramBinaries(data);
+            for (i = 0; i < data->num_program_binaries; i++) {
+                SDL_free(data->program_binaries[i].binary);
+            }
+            SDL_free(data->program_binaries);
+            SDL_free(data->program_binary_path);
+        }
 
         if (data->context) {
             while (data->framebuffers) {
@@ -1578,6 +1875,12 @@ static bool GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
         format = GL_LUMINANCE;
         type = GL_UNSIGNED_BYTE;
         break;
+    case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_UYVY:
+    case SDL_PIXELFORMAT_YVYU:
+        format = GL_LUMINANCE_ALPHA;
+        type = GL_UNSIGNED_BYTE;
+        break;
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
     case SDL_PIXELFORMAT_EXTERNAL_OES:
@@ -1613,6 +1916,7 @@ static bool GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
 #ifdef SDL_HAVE_YUV
     data->yuv = ((texture->format == SDL_PIXELFORMAT_IYUV) || (texture->format == SDL_PIXELFORMAT_YV12));
     data->nv12 = ((texture->format == SDL_PIXELFORMAT_NV12) || (texture->format == SDL_PIXELFORMAT_NV21));
+    data->packed = ((texture->format == SDL_PIXELFORMAT_YUY2) || (texture->format == SDL_PIXELFORMAT_UYVY) || (texture->format == SDL_PIXELFORMAT_YVYU));
     data->texture_u = 0;
     data->texture_v = 0;
 #endif
@@ -1623,6 +1927,12 @@ static bool GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
     if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
         size_t size;
         data->pitch = texture->w * SDL_BYTESPERPIXEL(texture->format);
+#ifdef SDL_HAVE_YUV
+        if (data->packed) {
+            // Each pair of pixels shares 4 bytes
+            data->pitch = ((texture->w + 1) / 2) * 4;
+        }
+#endif
         size = (size_t)texture->h * data->pitch;
 #ifdef SDL_HAVE_YUV
         if (data->yuv) {
@@ -1720,6 +2030,30 @@ static bool GLES2_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SD
         SetTextureAddressMode(renderdata, data->texture_type, data->texture_address_mode);
         SDL_SetNumberProperty(SDL_GetTextureProperties(texture), SDL_PROP_TEXTURE_OPENGLES2_TEXTURE_UV_NUMBER, data->texture_u);
 
+        if (!SDL_GetYCbCRtoRGBConversionMatrix(texture->colorspace, texture->w, texture->h, 8)) {
+            SDL_free(data->pixel_data);
+            SDL_free(data);
+            return SDL_SetError("Unsupported YUV colorspace");
+        }
+    } else if (data->packed) {
+        // The same data is uploaded again as RGBA at half width, for the U and V values
+        renderdata->glGenTextures(1, &data->texture_u);
+        if (!GL_CheckError("glGenTexures()", renderer)) {
+            SDL_free(data->pixel_data);
+            SDL_free(data);
+            return false;
+        }
+        renderdata->glActiveTexture(GL_TEXTURE1);
+        renderdata->glBindTexture(data->texture_type, data->texture_u);
+        renderdata->glTexImage2D(data->texture_type, 0, GL_RGBA, (texture->w + 1) / 2, texture->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        if (!GL_CheckError("glTexImage2D()", renderer)) {
+            SDL_free(data->pixel_data);
+            SDL_free(data);
+            return false;
+        }
+        SetTextureScaleMode(renderdata, data->texture_type, data->texture_scale_mode);
+        SetTextureAddressMode(renderdata, data->texture_type, data->texture_address_mode);
+
         if (!SDL_GetYCbCRtoRGBConversionMatrix(texture->colorspace, texture->w, texture->h, 8)) {
             SDL_free(data->pixel_data);
             SDL_free(data);
@@ -1868,6 +2202,16 @@ static bool GLES2_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture, co
                             GL_LUMINANCE_ALPHA,
                             GL_UNSIGNED_BYTE,
                             pixels, 2 * ((pitch + 1) / 2), 2);
+    } else if (tdata->packed) {
+        data->glBindTexture(tdata->texture_type, tdata->texture_u);
+        GLES2_TexSubImage2D(data, tdata->texture_type,
+                            rect->x / 2,
+                            rect->y,
+                            (rect->w + 1) / 2,
+                            rect->h,
+                            GL_RGBA,
+                            GL_UNSIGNED_BYTE,
+                            pixels, pitch, 4);
     }
 #endif
 
@@ -2162,6 +2506,7 @@ static bool GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
     renderer->window = window;
 
     renderer->name = GLES2_RenderDriver.name;
+    renderer->persistent_texture_lock = true;
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BGRA32);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_RGBA32);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BGRX32);
@@ -2180,7 +2525,11 @@ static bool GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
         goto error;
     }
 
-    if (!GLES2_CacheShaders(data)) {
+    GLES2_InitProgramBinaryCache(data, create_props);
+    if (data->program_binary_path) {
+        // Shaders are compiled on demand, for programs that aren't in the cache
+        data->texcoord_precision_hint = GLES2_GetTexCoordPrecisionEnumFromHint();
+    } else if (!GLES2_CacheShaders(data)) {
         goto error;
     }
 
@@ -2232,11 +2581,14 @@ static bool GLES2_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_IYUV);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV12);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV21);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YUY2);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_UYVY);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YVYU);
 #endif
 #ifdef GL_TEXTURE_EXTERNAL_OES
     if (SDL_GL_ExtensionSupported("GL_OES_EGL_image_external")) {
         data->GL_OES_EGL_image_external_supported = true;
-        if (!GLES2_CacheShader(data, GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES, GL_FRAGMENT_SHADER)) {
+        if (!data->program_binary_path && !GLES2_CacheShader(data, GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES, GL_FRAGMENT_SHADER)) {
             goto error;
         }
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_EXTERNAL_OES);
@@ -256,6 +256,66 @@ static const char GLES2_Fragment_TextureBGR[] =                 \
 "    gl_FragColor *= v_color;\n"                                \
 "}"                                                             \
 
+/* Packed 4:2:2 formats are sampled twice from the same data: as luminance/alpha
+ * pairs at full width for the Y values, and as RGBA at half width for the U and V values.
+ */
+#define YUY2_SHADER_BODY                                        \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump vec3 yuv;\n"                                       \
+"    lowp vec3 rgb;\n"                                          \
+"\n"                                                            \
+"    // Get the YUV values \n"                                  \
+"    yuv.x = texture2D(u_texture,   v_texCoord).r;\n"           \
+"    yuv.yz = texture2D(u_texture_u, v_texCoord).ga;\n"         \
+"\n"                                                            \
+"    // Do the color transform \n"                              \
+"    yuv += u_offset;\n"                                        \
+"    rgb = yuv * u_matrix;\n"                                   \
+"\n"                                                            \
+"    // That was easy. :) \n"                                   \
+"    gl_FragColor = vec4(rgb, 1);\n"                            \
+"    gl_FragColor *= v_color;\n"                                \
+"}"                                                             \
+
+#define UYVY_SHADER_BODY                                        \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump vec3 yuv;\n"                                       \
+"    lowp vec3 rgb;\n"                                          \
+"\n"                                                            \
+"    // Get the YUV values \n"                                  \
+"    yuv.x = texture2D(u_texture,   v_texCoord).a;\n"           \
+"    yuv.yz = texture2D(u_texture_u, v_texCoord).rb;\n"         \
+"\n"                                                            \
+"    // Do the color transform \n"                              \
+"    yuv += u_offset;\n"                                        \
+"    rgb = yuv * u_matrix;\n"                                   \
+"\n"                                                            \
+"    // That was easy. :) \n"                                   \
+"    gl_FragColor = vec4(rgb, 1);\n"                            \
+"    gl_FragColor *= v_color;\n"                                \
+"}"                                                             \
+
+#define YVYU_SHADER_BODY                                        \
+"void main()\n"                                                 \
+"{\n"                                                           \
+"    mediump vec3 yuv;\n"                                       \
+"    lowp vec3 rgb;\n"                                          \
+"\n"                                                            \
+"    // Get the YUV values \n"                                  \
+"    yuv.x = texture2D(u_texture,   v_texCoord).r;\n"           \
+"    yuv.yz = texture2D(u_texture_u, v_texCoord).ag;\n"         \
+"\n"                                                            \
+"    // Do the color transform \n"                              \
+"    yuv += u_offset;\n"                                        \
+"    rgb = yuv * u_matrix;\n"                                   \
+"\n"                                                            \
+"    // That was easy. :) \n"                                   \
+"    gl_FragColor = vec4(rgb, 1);\n"                            \
+"    gl_FragColor *= v_color;\n"                                \
+"}"                                                             \
+
 // YUV to ABGR conversion
 static const char GLES2_Fragment_TextureYUV[] = \
         YUV_SHADER_PROLOGUE \
@@ -281,6 +341,20 @@ static const char GLES2_Fragment_TextureNV21_RG[] = \
         YUV_SHADER_PROLOGUE \
         NV21_RG_SHADER_BODY \
 ;
+
+// Packed 4:2:2 YUV to ABGR conversion
+static const char GLES2_Fragment_TextureYUY2[] = \
+        YUV_SHADER_PROLOGUE \
+        YUY2_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureUYVY[] = \
+        YUV_SHADER_PROLOGUE \
+        UYVY_SHADER_BODY \
+;
+static const char GLES2_Fragment_TextureYVYU[] = \
+        YUV_SHADER_PROLOGUE \
+        YVYU_SHADER_BODY \
+;
 #endif
 
 // Custom Android video format texture
@@ -376,6 +450,12 @@ const char *GLES2_GetShader(GLES2_ShaderType type)
         return GLES2_Fragment_TextureNV21_RA;
     case GLES2_SHADER_FRAGMENT_TEXTURE_NV21_RG:
         return GLES2_Fragment_TextureNV21_RG;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YUY2:
+        return GLES2_Fragment_TextureYUY2;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_UYVY:
+        return GLES2_Fragment_TextureUYVY;
+    case GLES2_SHADER_FRAGMENT_TEXTURE_YVYU:
+        return GLES2_Fragment_TextureYVYU;
 #endif
     case GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES:
         return GLES2_Fragment_TextureExternalOES;
@@ -49,6 +49,9 @@ typedef enum
     GLES2_SHADER_FRAGMENT_TEXTURE_NV12_RG,
     GLES2_SHADER_FRAGMENT_TEXTURE_NV21_RA,
     GLES2_SHADER_FRAGMENT_TEXTURE_NV21_RG,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YUY2,
+    GLES2_SHADER_FRAGMENT_TEXTURE_UYVY,
+    GLES2_SHADER_FRAGMENT_TEXTURE_YVYU,
 #endif
     // Shaders beyond this point are optional and not cached at render creation
     GLES2_SHADER_FRAGMENT_TEXTURE_EXTERNAL_OES,
@@ -34,9 +34,14 @@
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
 #include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_RLEaccel_c.h"
+#include "../../thread/SDL_jobs_c.h"
 
 // SDL surface based renderer implementation
 
+// The most separate areas of damage tracked for a present, after that they get merged
+#define SW_MAX_DAMAGE_RECTS 16
+
 typedef struct
 {
     const SDL_Rect *viewport;
@@ -49,6 +54,17 @@ typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    // Scratch space for tiled rendering
+    struct SW_TiledDraw *tiled_draws;
+    int tiled_draws_allocation;
+    SDL_Texture **tiled_textures;
+    int tiled_textures_allocation;
+
+    // The parts of the window surface drawn since the last present
+    SDL_Rect damage[SW_MAX_DAMAGE_RECTS];
+    int num_damage;
+    bool damage_full;
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -62,6 +78,8 @@ static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
         SDL_Surface *surface = SDL_GetWindowSurface(renderer->window);
         if (surface) {
             data->surface = data->window = surface;
+            // A new surface has to be presented in full
+            data->damage_full = true;
         }
     }
     return data->surface;
@@ -74,6 +92,8 @@ static void SW_WindowEvent(SDL_Renderer *renderer, const SDL_WindowEvent *event)
     if (event->type == SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED) {
         data->surface = NULL;
         data->window = NULL;
+    } else if (event->type == SDL_EVENT_WINDOW_EXPOSED) {
+        data->damage_full = true;
     }
 }
 
@@ -311,6 +331,239 @@ static bool Blit_to_Screen(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *sur
     return result;
 }
 
+/* Rotated copies of 32-bit textures onto a surface with the same RGB layout are drawn by mapping
+ * each destination pixel back into the texture, so nothing has to be allocated per draw. */
+#define SW_COPYEX_MAX_TEXTURE_SIZE 16384
+
+// (x + 1 + ((x + 1) >> 8)) >> 8 is x / 255 for the products of two 8-bit values
+SDL_FORCE_INLINE Uint32 SW_Div255(Uint32 x)
+{
+    x += 1;
+    x += x >> 8;
+    return x >> 8;
+}
+
+// Interpolate all four channels of two 8888 pixels, with a weight for b from 0 to 255
+SDL_FORCE_INLINE Uint32 SW_Lerp8888(Uint32 a, Uint32 b, Uint32 w)
+{
+    const Uint32 even = ((((a & 0x00FF00FF) * (256 - w)) + ((b & 0x00FF00FF) * w)) >> 8) & 0x00FF00FF;
+    const Uint32 odd = ((((a >> 8) & 0x00FF00FF) * (256 - w)) + (((b >> 8) & 0x00FF00FF) * w)) & 0xFF00FF00;
+    return even | odd;
+}
+
+static bool SW_CanRenderCopyExDirect(SDL_Surface *surface, SDL_Surface *src, SDL_BlendMode blendmode)
+{
+    const SDL_PixelFormatDetails *src_fmt = src->fmt;
+    const SDL_PixelFormatDetails *dst_fmt = surface->fmt;
+
+    if (SDL_MUSTLOCK(surface)) {
+        return false;
+    }
+    if (src_fmt->bits_per_pixel != 32 || dst_fmt->bits_per_pixel != 32 ||
+        SDL_PIXELLAYOUT(src->format) != SDL_PACKEDLAYOUT_8888 || SDL_PIXELLAYOUT(surface->format) != SDL_PACKEDLAYOUT_8888) {
+        return false;
+    }
+    if (src_fmt->Rmask != dst_fmt->Rmask || src_fmt->Gmask != dst_fmt->Gmask || src_fmt->Bmask != dst_fmt->Bmask) {
+        return false;
+    }
+    if (src->w > SW_COPYEX_MAX_TEXTURE_SIZE || src->h > SW_COPYEX_MAX_TEXTURE_SIZE) {
+        return false; // keep the 16.16 fixed point texture coordinates in range
+    }
+
+    switch (blendmode) {
+    case SDL_BLENDMODE_NONE:
+    case SDL_BLENDMODE_BLEND:
+    case SDL_BLENDMODE_ADD:
+    case SDL_BLENDMODE_MOD:
+    case SDL_BLENDMODE_MUL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void SW_RenderCopyExDirect(SDL_Surface *surface, SDL_Surface *src,
+                                  const SDL_Rect *srcrect, const SDL_Rect *final_rect,
+                                  const double angle, const SDL_FPoint *center, const SDL_FlipMode flip,
+                                  float scale_x, float scale_y, const SDL_ScaleMode scaleMode, SDL_BlendMode blendmode)
+{
+    const SDL_PixelFormatDetails *src_fmt = src->fmt;
+    const SDL_PixelFormatDetails *dst_fmt = surface->fmt;
+    const Uint32 Rshift = src_fmt->Rshift, Gshift = src_fmt->Gshift, Bshift = src_fmt->Bshift;
+    const Uint32 src_Ashift = src_fmt->Ashift, dst_Ashift = dst_fmt->Ashift;
+    const bool src_alpha = (src_fmt->Amask != 0);
+    const bool dst_alpha = (dst_fmt->Amask != 0);
+    const bool linear = (scaleMode != SDL_SCALEMODE_NEAREST);
+    const Sint32 tex_x0 = srcrect->x, tex_y0 = srcrect->y;
+    const Sint32 tex_x1 = srcrect->x + srcrect->w - 1, tex_y1 = srcrect->y + srcrect->h - 1;
+    const Uint32 tex_w = (Uint32)srcrect->w << 16, tex_h = (Uint32)srcrect->h << 16;
+    Uint8 rMod, gMod, bMod, aMod;
+    double radangle, c, s, px, py, u_x, u_y, u_0, v_x, v_y, v_0, tex_sx, tex_sy;
+    double minx, miny, maxx, maxy;
+    SDL_Rect bounds;
+    int i, x, y;
+
+    if (final_rect->w <= 0 || final_rect->h <= 0 || srcrect->w <= 0 || srcrect->h <= 0) {
+        return;
+    }
+
+    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+    SDL_GetSurfaceAlphaMod(src, &aMod);
+
+    // Multiples of 90 degrees should map pixels exactly
+    radangle = angle * (SDL_PI_D / 180.0);
+    if (SDL_fmod(angle, 90.0) == 0.0) {
+        int angle90 = ((int)(angle / 90.0) % 4 + 4) % 4;
+        c = (angle90 == 0) ? 1.0 : (angle90 == 2) ? -1.0 : 0.0;
+        s = (angle90 == 1) ? 1.0 : (angle90 == 3) ? -1.0 : 0.0;
+    } else {
+        c = SDL_cos(radangle);
+        s = SDL_sin(radangle);
+    }
+
+    /* A point L in the unflipped, unscaled sprite lands at
+     *   S = scale * (final_rect.xy + center + R * (L - center))
+     * with R rotating clockwise, so the bounding box comes from the corners and
+     * destination pixels map back with the transpose of R. */
+    minx = miny = SDL_MAX_SINT32;
+    maxx = maxy = SDL_MIN_SINT32;
+    for (i = 0; i < 4; ++i) {
+        const double lx = ((i & 1) ? final_rect->w : 0) - center->x;
+        const double ly = ((i & 2) ? final_rect->h : 0) - center->y;
+        const double sx = (final_rect->x + center->x + c * lx - s * ly) * scale_x;
+        const double sy = (final_rect->y + center->y + s * lx + c * ly) * scale_y;
+        minx = SDL_min(minx, sx);
+        maxx = SDL_max(maxx, sx);
+        miny = SDL_min(miny, sy);
+        maxy = SDL_max(maxy, sy);
+    }
+    bounds.x = (int)SDL_floor(minx);
+    bounds.y = (int)SDL_floor(miny);
+    bounds.w = (int)SDL_ceil(maxx) - bounds.x;
+    bounds.h = (int)SDL_ceil(maxy) - bounds.y;
+    if (!SDL_GetRectIntersection(&bounds, &surface->clip_rect, &bounds)) {
+        return;
+    }
+
+    /* Sprite coordinates as a function of the destination pixel (X, Y):
+     *   u = u_0 + u_x * X + u_y * Y,  v = v_0 + v_x * X + v_y * Y */
+    px = -(final_rect->x + center->x);
+    py = -(final_rect->y + center->y);
+    u_x = c / scale_x;
+    u_y = s / scale_y;
+    u_0 = center->x + c * px + s * py;
+    v_x = -s / scale_x;
+    v_y = c / scale_y;
+    v_0 = center->y - s * px + c * py;
+
+    // Flipping mirrors the sprite before it is rotated
+    if (flip & SDL_FLIP_HORIZONTAL) {
+        u_x = -u_x;
+        u_y = -u_y;
+        u_0 = final_rect->w - u_0;
+    }
+    if (flip & SDL_FLIP_VERTICAL) {
+        v_x = -v_x;
+        v_y = -v_y;
+        v_0 = final_rect->h - v_0;
+    }
+
+    // Sprite to texture coordinates
+    tex_sx = (double)srcrect->w / final_rect->w;
+    tex_sy = (double)srcrect->h / final_rect->h;
+
+    for (y = bounds.y; y < bounds.y + bounds.h; ++y) {
+        Uint32 *dst = (Uint32 *)((Uint8 *)surface->pixels + (size_t)y * surface->pitch) + bounds.x;
+        const double dx = bounds.x + 0.5, dy = y + 0.5;
+        // 16.16 fixed point texture coordinates, relative to the srcrect origin
+        Sint32 fu = (Sint32)SDL_floor((u_0 + u_x * dx + u_y * dy) * tex_sx * 65536.0);
+        Sint32 fv = (Sint32)SDL_floor((v_0 + v_x * dx + v_y * dy) * tex_sy * 65536.0);
+        const Sint32 dfu = (Sint32)SDL_floor(u_x * tex_sx * 65536.0 + 0.5);
+        const Sint32 dfv = (Sint32)SDL_floor(v_x * tex_sy * 65536.0 + 0.5);
+
+        for (x = 0; x < bounds.w; ++x, ++dst, fu += dfu, fv += dfv) {
+            Uint32 texel, dpixel;
+            Uint32 sr, sg, sb, sa, dr, dg, db, da;
+
+            // Skip pixels outside of the sprite
+            if ((Uint32)fu >= tex_w || (Uint32)fv >= tex_h) {
+                continue;
+            }
+
+            if (linear) {
+                // Sample between the four nearest texel centers, clamped to the srcrect
+                const Sint32 gu = fu - 0x8000, gv = fv - 0x8000;
+                const Sint32 tx = tex_x0 + (gu >> 16), ty = tex_y0 + (gv >> 16);
+                const Uint32 wx = (Uint32)(gu >> 8) & 0xFF, wy = (Uint32)(gv >> 8) & 0xFF;
+                const Sint32 tx0 = SDL_clamp(tx, tex_x0, tex_x1), tx1 = SDL_clamp(tx + 1, tex_x0, tex_x1);
+                const Uint32 *row0 = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)SDL_clamp(ty, tex_y0, tex_y1) * src->pitch);
+                const Uint32 *row1 = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)SDL_clamp(ty + 1, tex_y0, tex_y1) * src->pitch);
+                texel = SW_Lerp8888(SW_Lerp8888(row0[tx0], row0[tx1], wx), SW_Lerp8888(row1[tx0], row1[tx1], wx), wy);
+            } else {
+                const Uint32 *row = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)(tex_y0 + (fv >> 16)) * src->pitch);
+                texel = row[tex_x0 + (fu >> 16)];
+            }
+
+            sr = (texel >> Rshift) & 0xFF;
+            sg = (texel >> Gshift) & 0xFF;
+            sb = (texel >> Bshift) & 0xFF;
+            sa = src_alpha ? ((texel >> src_Ashift) & 0xFF) : 0xFF;
+            if ((rMod & gMod & bMod) != 0xFF) {
+                sr = SW_Div255(sr * rMod);
+                sg = SW_Div255(sg * gMod);
+                sb = SW_Div255(sb * bMod);
+            }
+            if (aMod != 0xFF) {
+                sa = SW_Div255(sa * aMod);
+            }
+
+            dpixel = *dst;
+            dr = (dpixel >> Rshift) & 0xFF;
+            dg = (dpixel >> Gshift) & 0xFF;
+            db = (dpixel >> Bshift) & 0xFF;
+            da = dst_alpha ? ((dpixel >> dst_Ashift) & 0xFF) : 0xFF;
+
+            // Same equations as the surface blitters, see SDL_BlendMode
+            switch (blendmode) {
+            case SDL_BLENDMODE_NONE:
+                dr = sr;
+                dg = sg;
+                db = sb;
+                da = sa;
+                break;
+            case SDL_BLENDMODE_BLEND:
+                if (sa == 0) {
+                    continue;
+                }
+                dr = SW_Div255(sr * sa + dr * (255 - sa));
+                dg = SW_Div255(sg * sa + dg * (255 - sa));
+                db = SW_Div255(sb * sa + db * (255 - sa));
+                da = sa + SW_Div255(da * (255 - sa));
+                break;
+            case SDL_BLENDMODE_ADD:
+                dr = SDL_min(dr + SW_Div255(sr * sa), 255);
+                dg = SDL_min(dg + SW_Div255(sg * sa), 255);
+                db = SDL_min(db + SW_Div255(sb * sa), 255);
+                break;
+            case SDL_BLENDMODE_MOD:
+                dr = SW_Div255(sr * dr);
+                dg = SW_Div255(sg * dg);
+                db = SW_Div255(sb * db);
+                break;
+            case SDL_BLENDMODE_MUL:
+                dr = SDL_min((sr * dr + dr * (255 - sa) + 127) / 255, 255);
+                dg = SDL_min((sg * dg + dg * (255 - sa) + 127) / 255, 255);
+                db = SDL_min((sb * db + db * (255 - sa) + 127) / 255, 255);
+                break;
+            default:
+                break;
+            }
+
+            *dst = (dr << Rshift) | (dg << Gshift) | (db << Bshift) | (dst_alpha ? (da << dst_Ashift) : 0);
+        }
+    }
+}
+
 static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture,
                             const SDL_Rect *srcrect, const SDL_Rect *final_rect,
                             const double angle, const SDL_FPoint *center, const SDL_FlipMode flip, float scale_x, float scale_y, const SDL_ScaleMode scaleMode)
@@ -344,6 +597,15 @@ static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Te
         }
     }
 
+    SDL_GetSurfaceBlendMode(src, &blendmode);
+    if (SW_CanRenderCopyExDirect(surface, src, blendmode)) {
+        SW_RenderCopyExDirect(surface, src, srcrect, final_rect, angle, center, flip, scale_x, scale_y, scaleMode, blendmode);
+        if (SDL_MUSTLOCK(src)) {
+            SDL_UnlockSurface(src);
+        }
+        return true;
+    }
+
     /* Clone the source surface but use its pixel buffer directly.
      * The original source surface must be treated as read-only.
      */
@@ -355,7 +617,6 @@ static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Te
         return false;
     }
 
-    SDL_GetSurfaceBlendMode(src, &blendmode);
     SDL_GetSurfaceAlphaMod(src, &alphaMod);
     SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
 
@@ -616,15 +877,13 @@ static bool SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL
     return true;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+static void PrepTextureForCopy(SDL_Surface *surface, const SDL_RenderCommand *cmd, SDL_Color color)
 {
-    const Uint8 r = drawstate->color.r;
-    const Uint8 g = drawstate->color.g;
-    const Uint8 b = drawstate->color.b;
-    const Uint8 a = drawstate->color.a;
+    const Uint8 r = color.r;
+    const Uint8 g = color.g;
+    const Uint8 b = color.b;
+    const Uint8 a = color.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->internal;
     const bool colormod = ((r & g & b) != 0xFF);
     const bool alphamod = (a != 0xFF);
     const bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -666,9 +925,748 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
     // SW_DrawStateCache only lives during SW_RunCommandQueue, so nothing to do here!
 }
 
+// Move the vertices of a draw command from viewport to surface coordinates
+static void ApplyViewport(SDL_RenderCommand *cmd, void *vertices, const SDL_Rect *viewport)
+{
+    const int count = (int)cmd->data.draw.count;
+    void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+    int i;
+
+    if (!viewport || (!viewport->x && !viewport->y)) {
+        return;
+    }
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        SDL_Point *points = (SDL_Point *)verts;
+        for (i = 0; i < count; i++) {
+            points[i].x += viewport->x;
+            points[i].y += viewport->y;
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        SDL_Rect *rects = (SDL_Rect *)verts;
+        for (i = 0; i < count; i++) {
+            rects[i].x += viewport->x;
+            rects[i].y += viewport->y;
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *dstrect = (SDL_Rect *)verts + 1;
+        dstrect->x += viewport->x;
+        dstrect->y += viewport->y;
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY_EX:
+    {
+        CopyExData *copydata = (CopyExData *)verts;
+        copydata->dstrect.x += viewport->x;
+        copydata->dstrect.y += viewport->y;
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        SDL_Point vp;
+        vp.x = viewport->x;
+        vp.y = viewport->y;
+        trianglepoint_2_fixedpoint(&vp);
+        if (cmd->data.draw.texture) {
+            GeometryCopyData *ptr = (GeometryCopyData *)verts;
+            for (i = 0; i < count; i++) {
+                ptr[i].dst.x += vp.x;
+                ptr[i].dst.y += vp.y;
+            }
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)verts;
+            for (i = 0; i < count; i++) {
+                ptr[i].dst.x += vp.x;
+                ptr[i].dst.y += vp.y;
+            }
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/* Run a draw command, other than SDL_RENDERCMD_COPY_EX, on a surface that already has its clip rect set.
+   src is the surface used for the texture, if there is one. */
+static void RunDrawCommand(SDL_Surface *surface, SDL_Surface *src, const SDL_RenderCommand *cmd, void *vertices, SDL_Color color)
+{
+    const Uint8 r = color.r;
+    const Uint8 g = color.g;
+    const Uint8 b = color.b;
+    const Uint8 a = color.a;
+    const int count = (int)cmd->data.draw.count;
+    const SDL_BlendMode blend = cmd->data.draw.blend;
+    void *verts = ((Uint8 *)vertices) + cmd->data.draw.first;
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(surface, (SDL_Point *)verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendPoints(surface, (SDL_Point *)verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawLines(surface, (SDL_Point *)verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendLines(surface, (SDL_Point *)verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(surface, (SDL_Rect *)verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+        } else {
+            SDL_BlendFillRects(surface, (SDL_Rect *)verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        const SDL_Rect *srcrect = (SDL_Rect *)verts;
+        SDL_Rect dstrect = *((SDL_Rect *)verts + 1);
+
+        PrepTextureForCopy(src, cmd, color);
+
+        if (srcrect->w == dstrect.w && srcrect->h == dstrect.h) {
+            SDL_BlitSurface(src, srcrect, surface, &dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+
+            // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
+            if (dstrect.x < 0 || dstrect.y < 0 || dstrect.x + dstrect.w > surface->w || dstrect.y + dstrect.h > surface->h) {
+                SDL_Surface *tmp = SDL_CreateSurface(dstrect.w, dstrect.h, src->format);
+                // Scale to an intermediate surface, then blit
+                if (tmp) {
+                    SDL_Rect rect;
+                    SDL_BlendMode blendmode;
+                    Uint8 alphaMod, rMod, gMod, bMod;
+
+                    SDL_GetSurfaceBlendMode(src, &blendmode);
+                    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+                    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+                    rect.x = 0;
+                    rect.y = 0;
+                    rect.w = dstrect.w;
+                    rect.h = dstrect.h;
+
+                    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                    SDL_SetSurfaceAlphaMod(src, 255);
+
+                    SDL_BlitSurfaceScaled(src, srcrect, tmp, &rect, cmd->data.draw.texture_scale_mode);
+
+                    SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
+                    SDL_SetSurfaceAlphaMod(tmp, alphaMod);
+                    SDL_SetSurfaceBlendMode(tmp, blendmode);
+
+                    SDL_BlitSurface(tmp, NULL, surface, &dstrect);
+                    SDL_DestroySurface(tmp);
+                    // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
+                }
+            } else {
+                SDL_BlitSurfaceScaled(src, srcrect, surface, &dstrect, cmd->data.draw.texture_scale_mode);
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        int i;
+
+        if (src) {
+            const GeometryCopyData *ptr = (const GeometryCopyData *)verts;
+
+            PrepTextureForCopy(src, cmd, color);
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                // SDL_SW_BlitTriangle() adjusts the source points, so the same triangle can be drawn more than once
+                SDL_Point s0 = ptr[0].src, s1 = ptr[1].src, s2 = ptr[2].src;
+                SDL_Point d0 = ptr[0].dst, d1 = ptr[1].dst, d2 = ptr[2].dst;
+
+                SDL_SW_BlitTriangle(
+                    src,
+                    &s0, &s1, &s2,
+                    surface,
+                    &d0, &d1, &d2,
+                    ptr[0].color, ptr[1].color, ptr[2].color,
+                    cmd->data.draw.texture_address_mode);
+            }
+        } else {
+            const GeometryFillData *ptr = (const GeometryFillData *)verts;
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_Point d0 = ptr[0].dst, d1 = ptr[1].dst, d2 = ptr[2].dst;
+
+                SDL_SW_FillTriangle(surface, &d0, &d1, &d2, blend, ptr[0].color, ptr[1].color, ptr[2].color);
+            }
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+static SDL_Color GetCommandColor(const SDL_RenderCommand *cmd)
+{
+    SDL_Color color;
+    color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+    color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+    color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
+    color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+    return color;
+}
+
+/* Tiled rendering
+ *
+ * The target is split into bands of rows, and every band runs the draws that touch it on a job thread,
+ * clipped to its own rows, so draws stay in order within each band. Every band gets its own view of the
+ * target and of each texture, since blitting caches state in the source surface.
+ *
+ * Points, rects, triangles and unscaled copies draw exactly the same pixels however they're clipped.
+ * Lines and scaled copies don't, so they are only split up when they fit inside a single band, and
+ * rotated copies share temporary state in the texture surface. Anything else is drawn on the calling
+ * thread once the bands have caught up with it.
+ */
+#define SW_TILED_MIN_PIXELS    (256 * 256)
+#define SW_TILED_MIN_BAND_ROWS 32
+#define SW_TILED_MAX_BANDS     32
+
+typedef struct SW_TiledDraw
+{
+    SDL_RenderCommand *cmd;
+    SDL_Color color;
+    SDL_Rect clip;   // the clip rect, in surface coordinates
+    int top, bottom; // the rows this draw can touch
+    int texture;     // index into the texture views, or -1
+    bool serial;     // has to be run on the calling thread
+} SW_TiledDraw;
+
+typedef struct SW_TiledBand
+{
+    int top, bottom;
+    SDL_Surface *surface;
+    SDL_Surface **textures;
+    const SW_TiledDraw *draws;
+    int num_draws;
+    void *vertices;
+} SW_TiledBand;
+
+static void SDLCALL SW_RunTiledBand(void *userdata)
+{
+    SW_TiledBand *band = (SW_TiledBand *)userdata;
+    int i;
+
+    for (i = 0; i < band->num_draws; ++i) {
+        const SW_TiledDraw *draw = &band->draws[i];
+        SDL_Rect clip;
+
+        if (draw->bottom <= band->top || draw->top >= band->bottom) {
+            continue;
+        }
+
+        clip = draw->clip;
+        clip.y = SDL_max(draw->clip.y, band->top);
+        clip.h = SDL_min(draw->clip.y + draw->clip.h, band->bottom) - clip.y;
+        SDL_SetSurfaceClipRect(band->surface, &clip);
+
+        if (draw->cmd->command == SDL_RENDERCMD_CLEAR) {
+            SDL_FillSurfaceRect(band->surface, NULL, SDL_MapSurfaceRGBA(band->surface, draw->color.r, draw->color.g, draw->color.b, draw->color.a));
+        } else {
+            SDL_Surface *src = (draw->texture >= 0) ? band->textures[draw->texture] : NULL;
+            RunDrawCommand(band->surface, src, draw->cmd, band->vertices, draw->color);
+        }
+    }
+}
+
+static int FindTiledTexture(SW_RenderData *data, int num_textures, SDL_Texture *texture)
+{
+    int i;
+
+    for (i = num_textures; i--; ) {
+        if (data->tiled_textures[i] == texture) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Work out the area a draw can touch, in surface coordinates, returning false if it isn't known
+static bool GetDrawBounds(const SDL_RenderCommand *cmd, void *vertices, SDL_Rect *bounds)
+{
+    const int count = (int)cmd->data.draw.count;
+    const void *verts = ((const Uint8 *)vertices) + cmd->data.draw.first;
+    int minx = SDL_MAX_SINT32, maxx = SDL_MIN_SINT32;
+    int miny = SDL_MAX_SINT32, maxy = SDL_MIN_SINT32;
+    int i;
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        const SDL_Point *points = (const SDL_Point *)verts;
+        for (i = 0; i < count; i++) {
+            minx = SDL_min(minx, points[i].x);
+            maxx = SDL_max(maxx, points[i].x + 1);
+            miny = SDL_min(miny, points[i].y);
+            maxy = SDL_max(maxy, points[i].y + 1);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const SDL_Rect *rects = (const SDL_Rect *)verts;
+        for (i = 0; i < count; i++) {
+            minx = SDL_min(minx, rects[i].x);
+            maxx = SDL_max(maxx, rects[i].x + rects[i].w);
+            miny = SDL_min(miny, rects[i].y);
+            maxy = SDL_max(maxy, rects[i].y + rects[i].h);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        *bounds = *((const SDL_Rect *)verts + 1);
+        return true;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        const size_t stride = cmd->data.draw.texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+        const size_t offset = cmd->data.draw.texture ? offsetof(GeometryCopyData, dst) : offsetof(GeometryFillData, dst);
+        const Uint8 *ptr = (const Uint8 *)verts + offset;
+        if (count == 0) {
+            break;
+        }
+        for (i = 0; i < count; i++, ptr += stride) {
+            const SDL_Point *dst = (const SDL_Point *)ptr;
+            minx = SDL_min(minx, dst->x);
+            maxx = SDL_max(maxx, dst->x);
+            miny = SDL_min(miny, dst->y);
+            maxy = SDL_max(maxy, dst->y);
+        }
+        // The points are in fixed point
+        minx = (minx >> FP_BITS);
+        maxx = (maxx >> FP_BITS) + 1;
+        miny = (miny >> FP_BITS);
+        maxy = (maxy >> FP_BITS) + 1;
+        break;
+    }
+
+    default:
+        return false;
+    }
+
+    bounds->x = minx;
+    bounds->y = miny;
+    bounds->w = (maxx > minx) ? (maxx - minx) : 0;
+    bounds->h = (maxy > miny) ? (maxy - miny) : 0;
+    return true;
+}
+
+static void DestroyTiledBands(SW_TiledBand *bands, int num_bands, int num_textures)
+{
+    int i, j;
+
+    for (i = 0; i < num_bands; ++i) {
+        if (bands[i].textures) {
+            for (j = 0; j < num_textures; ++j) {
+                SDL_DestroySurface(bands[i].textures[j]);
+            }
+            SDL_free(bands[i].textures);
+        }
+        SDL_DestroySurface(bands[i].surface);
+    }
+}
+
+static SDL_Surface *CreateTiledView(SDL_Surface *surface)
+{
+    SDL_Surface *view = SDL_CreateSurfaceFrom(surface->w, surface->h, surface->format, surface->pixels, surface->pitch);
+    Uint32 key;
+
+    if (!view) {
+        return NULL;
+    }
+    if (!SDL_SetSurfaceColorspace(view, SDL_GetSurfaceColorspace(surface))) {
+        SDL_DestroySurface(view);
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format) && !SDL_SetSurfacePalette(view, SDL_GetSurfacePalette(surface))) {
+        SDL_DestroySurface(view);
+        return NULL;
+    }
+    if (SDL_GetSurfaceColorKey(surface, &key) && !SDL_SetSurfaceColorKey(view, true, key)) {
+        SDL_DestroySurface(view);
+        return NULL;
+    }
+    return view;
+}
+
+static Sint64 GetRectArea(const SDL_Rect *rect)
+{
+    return (Sint64)rect->w * rect->h;
+}
+
+static void AddDamageRect(SW_RenderData *data, const SDL_Rect *rect)
+{
+    SDL_Rect merged;
+    Sint64 best_cost = 0;
+    int i, best = -1;
+
+    if (data->damage_full || SDL_RectEmpty(rect)) {
+        return;
+    }
+
+    for (i = 0; i < data->num_damage; ++i) {
+        Sint64 cost;
+
+        // Merge with an area if that doesn't cover anything new
+        SDL_GetRectUnion(&data->damage[i], rect, &merged);
+        cost = GetRectArea(&merged) - GetRectArea(&data->damage[i]) - GetRectArea(rect);
+        if (cost <= 0) {
+            data->damage[i] = merged;
+            return;
+        }
+        if (best < 0 || cost < best_cost) {
+            best = i;
+            best_cost = cost;
+        }
+    }
+
+    if (data->num_damage < SW_MAX_DAMAGE_RECTS) {
+        data->damage[data->num_damage++] = *rect;
+    } else {
+        SDL_GetRectUnion(&data->damage[best], rect, &data->damage[best]);
+    }
+}
+
+// Record the area a draw command touches on the window surface, the vertices must already be in surface coordinates
+static void AddDrawDamage(SW_RenderData *data, SDL_Surface *surface, const SDL_RenderCommand *cmd, void *vertices, const SDL_Rect *clip)
+{
+    SDL_Rect rect;
+
+    if (surface != data->window) {
+        return;
+    }
+
+    if (cmd->command == SDL_RENDERCMD_CLEAR) {
+        data->damage_full = true;
+        return;
+    }
+
+    if (!GetDrawBounds(cmd, vertices, &rect)) {
+        // Rotated copies can land anywhere in the clip rect
+        rect = *clip;
+    } else if (!SDL_GetRectIntersection(&rect, clip, &rect)) {
+        return;
+    }
+    AddDamageRect(data, &rect);
+}
+
+static bool SW_RunCommandQueueTiled(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SW_TiledBand bands[SW_TILED_MAX_BANDS];
+    void *userdata[SW_TILED_MAX_BANDS];
+    SW_DrawStateCache drawstate;
+    SDL_RenderCommand *first = cmd;
+    int num_bands, num_draws = 0, num_textures = 0;
+    int i, j, start;
+
+    if (!SDL_GetHintBoolean(SDL_HINT_RENDER_SOFTWARE_TILED, false)) {
+        return false;
+    }
+    if ((Sint64)surface->w * surface->h < SW_TILED_MIN_PIXELS) {
+        return false;
+    }
+    // Color lookups for palettized targets aren't safe to run in parallel
+    if (SDL_ISPIXELFORMAT_INDEXED(surface->format) || SDL_MUSTLOCK(surface)) {
+        return false;
+    }
+
+    num_bands = SDL_min(SDL_GetNumLogicalCPUCores(), surface->h / SW_TILED_MIN_BAND_ROWS);
+    num_bands = SDL_min(num_bands, SW_TILED_MAX_BANDS);
+    if (num_bands < 2) {
+        return false;
+    }
+
+    // Collect the draws and the textures they use, without touching anything so we can still fall back
+    for (cmd = first; cmd; cmd = cmd->next) {
+        SW_TiledDraw *draw;
+        int texture = -1;
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_CLEAR:
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            break;
+        default:
+            continue;
+        }
+
+        if (cmd->command != SDL_RENDERCMD_CLEAR && cmd->data.draw.texture) {
+            texture = FindTiledTexture(data, num_textures, cmd->data.draw.texture);
+            if (texture < 0) {
+                if (num_textures == data->tiled_textures_allocation) {
+                    const int allocation = SDL_max(16, num_textures * 2);
+                    SDL_Texture **textures = (SDL_Texture **)SDL_realloc(data->tiled_textures, allocation * sizeof(*textures));
+                    if (!textures) {
+                        return false;
+                    }
+                    data->tiled_textures = textures;
+                    data->tiled_textures_allocation = allocation;
+                }
+                texture = num_textures++;
+                data->tiled_textures[texture] = cmd->data.draw.texture;
+            }
+        }
+
+        if (num_draws == data->tiled_draws_allocation) {
+            const int allocation = SDL_max(64, num_draws * 2);
+            SW_TiledDraw *draws = (SW_TiledDraw *)SDL_realloc(data->tiled_draws, allocation * sizeof(*draws));
+            if (!draws) {
+                return false;
+            }
+            data->tiled_draws = draws;
+            data->tiled_draws_allocation = allocation;
+        }
+        draw = &data->tiled_draws[num_draws++];
+        draw->cmd = cmd;
+        draw->texture = texture;
+    }
+
+    if (num_draws == 0) {
+        return false;
+    }
+
+    // The views need the raw pixels, so stop RLE encoding the textures
+    for (i = 0; i < num_textures; ++i) {
+        SDL_Surface *src = (SDL_Surface *)data->tiled_textures[i]->internal;
+        SDL_SetSurfaceRLE(src, 0);
+#ifdef SDL_HAVE_RLE
+        if (src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+            SDL_UnRLESurface(src, true);
+        }
+#endif
+        if (SDL_MUSTLOCK(src)) {
+            return false;
+        }
+    }
+
+    SDL_zeroa(bands);
+    for (i = 0; i < num_bands; ++i) {
+        SW_TiledBand *band = &bands[i];
+
+        band->top = (surface->h * i) / num_bands;
+        band->bottom = (surface->h * (i + 1)) / num_bands;
+        band->vertices = vertices;
+        band->surface = CreateTiledView(surface);
+        if (!band->surface) {
+            DestroyTiledBands(bands, num_bands, num_textures);
+            return false;
+        }
+        if (num_textures > 0) {
+            band->textures = (SDL_Surface **)SDL_calloc(num_textures, sizeof(*band->textures));
+            if (!band->textures) {
+                DestroyTiledBands(bands, num_bands, num_textures);
+                return false;
+            }
+            for (j = 0; j < num_textures; ++j) {
+                band->textures[j] = CreateTiledView((SDL_Surface *)data->tiled_textures[j]->internal);
+                if (!band->textures[j]) {
+                    DestroyTiledBands(bands, num_bands, num_textures);
+                    return false;
+                }
+            }
+        }
+        userdata[i] = band;
+    }
+
+    // Resolve the draw state for each draw and work out where it lands
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.color.r = 0;
+    drawstate.color.g = 0;
+    drawstate.color.b = 0;
+    drawstate.color.a = 0;
+
+    for (cmd = first, i = 0; cmd; cmd = cmd->next) {
+        SW_TiledDraw *draw;
+        const SDL_Rect bounds = { 0, 0, surface->w, surface->h };
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+            drawstate.color = GetCommandColor(cmd);
+            continue;
+        case SDL_RENDERCMD_SETVIEWPORT:
+            drawstate.viewport = &cmd->data.viewport.rect;
+            continue;
+        case SDL_RENDERCMD_SETCLIPRECT:
+            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+            continue;
+        case SDL_RENDERCMD_CLEAR:
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        case SDL_RENDERCMD_GEOMETRY:
+            break;
+        default:
+            continue;
+        }
+
+        draw = &data->tiled_draws[i++];
+        draw->serial = false;
+
+        if (cmd->command == SDL_RENDERCMD_CLEAR) {
+            // By definition the clear ignores the clip rect
+            draw->color = GetCommandColor(cmd);
+            draw->clip = bounds;
+            draw->top = 0;
+            draw->bottom = surface->h;
+            AddDrawDamage(data, surface, cmd, vertices, &draw->clip);
+            continue;
+        }
+
+        SDL_assert_release(drawstate.viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
+        draw->color = drawstate.color;
+        if (drawstate.cliprect && drawstate.viewport) {
+            draw->clip.x = drawstate.cliprect->x + drawstate.viewport->x;
+            draw->clip.y = drawstate.cliprect->y + drawstate.viewport->y;
+            draw->clip.w = drawstate.cliprect->w;
+            draw->clip.h = drawstate.cliprect->h;
+            SDL_GetRectIntersection(drawstate.viewport, &draw->clip, &draw->clip);
+        } else if (drawstate.viewport) {
+            draw->clip = *drawstate.viewport;
+        } else {
+            draw->clip = bounds;
+        }
+        if (!SDL_GetRectIntersection(&draw->clip, &bounds, &draw->clip)) {
+            draw->top = draw->bottom = 0;
+            continue;
+        }
+
+        ApplyViewport(cmd, vertices, drawstate.viewport);
+        AddDrawDamage(data, surface, cmd, vertices, &draw->clip);
+
+        if (cmd->command == SDL_RENDERCMD_COPY_EX) {
+            draw->top = draw->clip.y;
+            draw->bottom = draw->clip.y + draw->clip.h;
+            draw->serial = true;
+        } else {
+            bool exact = true;
+            SDL_Rect rect;
+
+            GetDrawBounds(cmd, vertices, &rect);
+            draw->top = SDL_max(rect.y, draw->clip.y);
+            draw->bottom = SDL_min(rect.y + rect.h, draw->clip.y + draw->clip.h);
+
+            if (cmd->command == SDL_RENDERCMD_DRAW_LINES) {
+                exact = false;
+            } else if (cmd->command == SDL_RENDERCMD_COPY) {
+                const SDL_Rect *srcrect = (const SDL_Rect *)(((const Uint8 *)vertices) + cmd->data.draw.first);
+                const SDL_Rect *dstrect = srcrect + 1;
+                if ((srcrect->w != dstrect->w || srcrect->h != dstrect->h) &&
+                    dstrect->x >= 0 && dstrect->y >= 0 && dstrect->x + dstrect->w <= surface->w && dstrect->y + dstrect->h <= surface->h) {
+                    exact = false;
+                }
+            }
+
+            if (!exact && draw->top < draw->bottom) {
+                // These are only drawn the same way if they are entirely inside one band
+                int band = (int)(((Sint64)draw->top * num_bands) / surface->h);
+                while (band > 0 && bands[band].top > draw->top) {
+                    --band;
+                }
+                while (band < num_bands - 1 && bands[band].bottom <= draw->top) {
+                    ++band;
+                }
+                if (draw->bottom > bands[band].bottom) {
+                    draw->serial = true;
+                }
+            }
+        }
+    }
+
+    // Run the draws in parallel, stopping to run the serial ones on this thread
+    for (i = 0, start = 0; i <= num_draws; ++i) {
+        SW_TiledDraw *draw = (i < num_draws) ? &data->tiled_draws[i] : NULL;
+
+        if (draw && !draw->serial) {
+            continue;
+        }
+
+        if (i > start) {
+            for (j = 0; j < num_bands; ++j) {
+                bands[j].draws = &data->tiled_draws[start];
+                bands[j].num_draws = i - start;
+            }
+            SDL_RunJobsAndWait(SW_RunTiledBand, userdata, num_bands);
+        }
+        start = i + 1;
+
+        if (draw && draw->top < draw->bottom) {
+            SDL_Texture *texture = draw->cmd->data.draw.texture;
+            SDL_Surface *src = texture ? (SDL_Surface *)texture->internal : NULL;
+
+            SDL_SetSurfaceClipRect(surface, &draw->clip);
+            if (draw->cmd->command == SDL_RENDERCMD_COPY_EX) {
+                CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + draw->cmd->data.draw.first);
+
+                PrepTextureForCopy(src, draw->cmd, draw->color);
+                SW_RenderCopyEx(renderer, surface, texture, &copydata->srcrect,
+                                &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                                copydata->scale_x, copydata->scale_y, draw->cmd->data.draw.texture_scale_mode);
+            } else {
+                RunDrawCommand(surface, src, draw->cmd, vertices, draw->color);
+            }
+        }
+    }
+
+    DestroyTiledBands(bands, num_bands, num_textures);
+    return true;
+}
 
 static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
     SW_DrawStateCache drawstate;
 
@@ -676,6 +1674,10 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         return false;
     }
 
+    if (SW_RunCommandQueueTiled(renderer, surface, cmd, vertices)) {
+        return true;
+    }
+
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = true;
@@ -688,10 +1690,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         switch (cmd->command) {
         case SDL_RENDERCMD_SETDRAWCOLOR:
         {
-            drawstate.color.r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            drawstate.color.a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+            drawstate.color = GetCommandColor(cmd);
             break;
         }
 
@@ -711,163 +1710,27 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
         case SDL_RENDERCMD_CLEAR:
         {
-            const Uint8 r = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.r * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 g = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.g * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 b = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.b * cmd->data.color.color_scale, 0.0f, 1.0f) * 255.0f);
-            const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
+            const SDL_Color color = GetCommandColor(cmd);
             // By definition the clear ignores the clip rect
             SDL_SetSurfaceClipRect(surface, NULL);
-            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, color.r, color.g, color.b, color.a));
+            AddDrawDamage(data, surface, cmd, vertices, &surface->clip_rect);
             drawstate.surface_cliprect_dirty = true;
             break;
         }
 
         case SDL_RENDERCMD_DRAW_POINTS:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
-            }
-            break;
-        }
-
         case SDL_RENDERCMD_DRAW_LINES:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-            }
-            break;
-        }
-
         case SDL_RENDERCMD_FILL_RECTS:
-        {
-            const Uint8 r = drawstate.color.r;
-            const Uint8 g = drawstate.color.g;
-            const Uint8 b = drawstate.color.b;
-            const Uint8 a = drawstate.color.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
-
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
-            } else {
-                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
-            }
-            break;
-        }
-
         case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_GEOMETRY:
         {
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_Rect *srcrect = verts;
-            SDL_Rect *dstrect = verts + 1;
             SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->internal;
 
             SetDrawState(surface, &drawstate);
-
-            PrepTextureForCopy(cmd, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
-            }
-
-            if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
-                SDL_BlitSurface(src, srcrect, surface, dstrect);
-            } else {
-                /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                 * to avoid potentially frequent RLE encoding/decoding.
-                 */
-                SDL_SetSurfaceRLE(surface, 0);
-
-                // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
-                if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                    SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                    // Scale to an intermediate surface, then blit
-                    if (tmp) {
-                        SDL_Rect r;
-                        SDL_BlendMode blendmode;
-                        Uint8 alphaMod, rMod, gMod, bMod;
-
-                        SDL_GetSurfaceBlendMode(src, &blendmode);
-                        SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                        SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                        r.x = 0;
-                        r.y = 0;
-                        r.w = dstrect->w;
-                        r.h = dstrect->h;
-
-                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                        SDL_SetSurfaceAlphaMod(src, 255);
-
-                        SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, cmd->data.draw.texture_scale_mode);
-
-                        SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                        SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                        SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                        SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                        SDL_DestroySurface(tmp);
-                        // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
-                    }
-                } else {
-                    SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, cmd->data.draw.texture_scale_mode);
-                }
-            }
+            ApplyViewport(cmd, vertices, drawstate.viewport);
+            AddDrawDamage(data, surface, cmd, vertices, &surface->clip_rect);
+            RunDrawCommand(surface, texture ? (SDL_Surface *)texture->internal : NULL, cmd, vertices, drawstate.color);
             break;
         }
 
@@ -875,13 +1738,9 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         {
             CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
             SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
-            }
+            PrepTextureForCopy((SDL_Surface *)cmd->data.draw.texture->internal, cmd, drawstate.color);
+            ApplyViewport(cmd, vertices, drawstate.viewport);
+            AddDrawDamage(data, surface, cmd, vertices, &surface->clip_rect);
 
             SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
@@ -889,66 +1748,6 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             break;
         }
 
-        case SDL_RENDERCMD_GEOMETRY:
-        {
-            int i;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const int count = (int)cmd->data.draw.count;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-
-            SetDrawState(surface, &drawstate);
-
-            if (texture) {
-                SDL_Surface *src = (SDL_Surface *)texture->internal;
-
-                GeometryCopyData *ptr = (GeometryCopyData *)verts;
-
-                PrepTextureForCopy(cmd, &drawstate);
-
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_BlitTriangle(
-                        src,
-                        &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
-                        surface,
-                        &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
-                        ptr[0].color, ptr[1].color, ptr[2].color,
-                        cmd->data.draw.texture_address_mode);
-                }
-            } else {
-                GeometryFillData *ptr = (GeometryFillData *)verts;
-
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
-                }
-            }
-            break;
-        }
-
         case SDL_RENDERCMD_NO_OP:
             break;
         }
@@ -987,12 +1786,32 @@ static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *
 
 static bool SW_RenderPresent(SDL_Renderer *renderer)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
     SDL_Window *window = renderer->window;
+    const SDL_Rect *rects = data->damage;
+    int num_rects = data->num_damage;
+    bool damage_full = data->damage_full;
 
     if (!window) {
         return false;
     }
-    return SDL_UpdateWindowSurface(window);
+
+    data->num_damage = 0;
+    data->damage_full = false;
+
+    if (!data->window) {
+        // Nothing has been drawn to this window surface yet
+        return SDL_UpdateWindowSurface(window);
+    }
+
+    if (renderer->damage_rects_set && !damage_full) {
+        // The application knows what changed
+        rects = renderer->damage_rects;
+        num_rects = renderer->num_damage_rects;
+    } else if (damage_full) {
+        return SDL_UpdateWindowSurface(window);
+    }
+    return SDL_UpdateWindowSurfaceRects(window, rects, num_rects);
 }
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
@@ -1010,6 +1829,8 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    SDL_free(data->tiled_draws);
+    SDL_free(data->tiled_textures);
     SDL_free(data);
 }
 
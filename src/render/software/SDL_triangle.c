@@ -28,14 +28,6 @@
 
 #include "../../video/SDL_surface_c.h"
 
-/* fixed points bits precision
- * Set to 1, so that it can start rendering with middle of a pixel precision.
- * It doesn't need to be increased.
- * But, if increased too much, it overflows (srcx, srcy) coordinates used for filling with texture.
- * (which could be turned to int64).
- */
-#define FP_BITS 1
-
 #define COLOR_EQ(c1, c2) ((c1).r == (c2).r && (c1).g == (c2).g && (c1).b == (c2).b && (c1).a == (c2).a)
 
 static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
@@ -165,62 +157,404 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
  * The cross product isn't computed from scratch at each iteration,
  * but optimized using constant step increments
  *
+ * Since the edge functions are linear along a row, the pixels of a row that
+ * are inside the triangle are found directly, and only those are visited.
+ * Texture coordinates and colors are interpolated as the quotient of a linear
+ * function by the area, stepped exactly from pixel to pixel with a quotient and
+ * a remainder, so they come out the same as dividing at every pixel. They're
+ * evaluated for up to TRIANGLE_SPAN_PIXELS pixels at a time, several pixels per
+ * step with SIMD when it's available.
  */
 
-#define TRIANGLE_BEGIN_LOOP                                                        \
-    {                                                                              \
-        int x, y;                                                                  \
-        for (y = 0; y < dstrect.h; y++) {                                          \
-            /* y start */                                                          \
-            Sint64 w0 = w0_row;                                                    \
-            Sint64 w1 = w1_row;                                                    \
-            Sint64 w2 = w2_row;                                                    \
-            for (x = 0; x < dstrect.w; x++) {                                      \
-                /* In triangle */                                                  \
-                if (w0 + bias_w0 >= 0 && w1 + bias_w1 >= 0 && w2 + bias_w2 >= 0) { \
-                    Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
-
-// Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles
-#define TRIANGLE_GET_TEXTCOORD                                                          \
-    int srcx = (int)(((Sint64)w0 * s2s0_x + (Sint64)w1 * s2s1_x + s2_x_area.x) / area); \
-    int srcy = (int)(((Sint64)w0 * s2s0_y + (Sint64)w1 * s2s1_y + s2_x_area.y) / area); \
-    if (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP) {                             \
-        srcx %= src_surface->w;                                                         \
-        if (srcx < 0) {                                                                 \
-            srcx += (src_surface->w - 1);                                               \
-        }                                                                               \
-        srcy %= src_surface->h;                                                         \
-        if (srcy < 0) {                                                                 \
-            srcy += (src_surface->h - 1);                                               \
-        }                                                                               \
-    }
-
-#define TRIANGLE_GET_MAPPED_COLOR                                                      \
-    Uint8 r = (Uint8)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    Uint8 g = (Uint8)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    Uint8 b = (Uint8)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    Uint8 a = (Uint8)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area); \
+#define TRIANGLE_SPAN_PIXELS 64
+#define TRIANGLE_MAX_LANES   8
+
+#define TRIANGLE_ATTR_SRCX 0
+#define TRIANGLE_ATTR_SRCY 1
+#define TRIANGLE_ATTR_R    2
+#define TRIANGLE_ATTR_G    3
+#define TRIANGLE_ATTR_B    4
+#define TRIANGLE_ATTR_A    5
+#define TRIANGLE_NUM_ATTRS 6
+
+typedef struct TriangleSpan
+{
+    int count;
+
+    // The quotient and remainder of each attribute at the next pixel, for each lane
+    Uint32 q[TRIANGLE_NUM_ATTRS][TRIANGLE_MAX_LANES];
+    Sint32 r[TRIANGLE_NUM_ATTRS][TRIANGLE_MAX_LANES]; // minus the area, with SIMD
+    Sint64 r64[TRIANGLE_NUM_ATTRS];                    // without SIMD
+
+    int attr[TRIANGLE_NUM_ATTRS][TRIANGLE_SPAN_PIXELS];
+} TriangleSpan;
+
+typedef struct TriangleRaster TriangleRaster;
+
+struct TriangleRaster
+{
+    Sint64 area;
+    int d2d1_y, d0d2_y, d1d0_y;
+    int bias_w0, bias_w1, bias_w2;
+
+    /* Attributes first_attr up to last_attr are interpolated as
+     * (w0 * k[0] + w1 * k[1] + w2 * k[2] + k[3]) / area
+     */
+    int first_attr, last_attr;
+    Sint64 k[TRIANGLE_NUM_ATTRS][4];
+
+    // The change of each attribute for one pixel, as a quotient and remainder
+    Uint32 step_q[TRIANGLE_NUM_ATTRS];
+    Sint64 step_r[TRIANGLE_NUM_ATTRS];
+
+    // With SIMD, the offset of each lane and the change for a whole step
+    int lanes;
+    Uint32 lane_q[TRIANGLE_NUM_ATTRS][TRIANGLE_MAX_LANES];
+    Sint32 lane_r[TRIANGLE_NUM_ATTRS][TRIANGLE_MAX_LANES];
+    Uint32 simd_step_q[TRIANGLE_NUM_ATTRS];
+    Sint32 simd_step_r[TRIANGLE_NUM_ATTRS];
+    void (*rasterize_simd)(const TriangleRaster *raster, TriangleSpan *span);
+};
+
+// Division rounding towards negative infinity, for a positive divisor
+static Sint64 floor_div(Sint64 n, Sint64 d)
+{
+    Sint64 q = n / d;
+    if ((n % d) != 0 && n < 0) {
+        --q;
+    }
+    return q;
+}
+
+// Add a quotient and remainder pair to another, keeping the remainder below the area
+static void add_step(Uint32 *q, Sint64 *r, Uint32 step_q, Sint64 step_r, Sint64 area)
+{
+    *q += step_q;
+    *r += step_r;
+    if (*r >= area) {
+        *q += 1;
+        *r -= area;
+    }
+}
+
+// The quotient truncated towards zero, like integer division
+#define TRUNCATED_QUOTIENT(q, r) ((int)(q) + ((int)(q) < 0 && (r) != 0))
+
+// Find the pixels of a row that are inside the triangle, returns false if there aren't any
+static bool get_triangle_row(const TriangleRaster *raster, Sint64 w0, Sint64 w1, Sint64 w2, int width, int *x_start, int *x_end)
+{
+    const Sint64 edges[3][2] = {
+        { w0 + raster->bias_w0, raster->d2d1_y },
+        { w1 + raster->bias_w1, raster->d0d2_y },
+        { w2 + raster->bias_w2, raster->d1d0_y }
+    };
+    Sint64 lo = 0, hi = width;
+    int i;
+
+    // A pixel is inside if w + bias + step * x >= 0 for each edge
+    for (i = 0; i < 3; i++) {
+        const Sint64 w = edges[i][0];
+        const Sint64 step = edges[i][1];
+        if (step > 0) {
+            lo = SDL_max(lo, -floor_div(w, step));
+        } else if (step < 0) {
+            hi = SDL_min(hi, floor_div(w, -step) + 1);
+        } else if (w < 0) {
+            return false;
+        }
+    }
+    if (lo >= hi) {
+        return false;
+    }
+    *x_start = (int)lo;
+    *x_end = (int)hi;
+    return true;
+}
+
+static void start_triangle_row(const TriangleRaster *raster, TriangleSpan *span, Sint64 w0, Sint64 w1, Sint64 w2, int x)
+{
+    const Sint64 area = raster->area;
+    int i, j;
+
+    w0 += (Sint64)x * raster->d2d1_y;
+    w1 += (Sint64)x * raster->d0d2_y;
+    w2 += (Sint64)x * raster->d1d0_y;
+
+    for (j = raster->first_attr; j <= raster->last_attr; j++) {
+        const Sint64 *k = raster->k[j];
+        const Sint64 n = w0 * k[0] + w1 * k[1] + w2 * k[2] + k[3];
+        const Sint64 q = floor_div(n, area);
+        span->q[j][0] = (Uint32)q;
+        span->r64[j] = n - q * area;
+
+        for (i = 0; i < raster->lanes; i++) {
+            Uint32 lane_q = span->q[j][0];
+            Sint64 lane_r = span->r64[j];
+            add_step(&lane_q, &lane_r, raster->lane_q[j][i], raster->lane_r[j][i], area);
+            span->q[j][i] = lane_q;
+            span->r[j][i] = (Sint32)(lane_r - area);
+        }
+    }
+}
+
+static void rasterize_span(const TriangleRaster *raster, TriangleSpan *span, int count)
+{
+    int i, j;
+
+    span->count = SDL_min(count, TRIANGLE_SPAN_PIXELS);
+
+    if (raster->rasterize_simd) {
+        raster->rasterize_simd(raster, span);
+        return;
+    }
+
+    for (j = raster->first_attr; j <= raster->last_attr; j++) {
+        Uint32 q = span->q[j][0];
+        Sint64 r = span->r64[j];
+        int *attr = span->attr[j];
+
+        for (i = 0; i < span->count; i++) {
+            attr[i] = TRUNCATED_QUOTIENT(q, r);
+            add_step(&q, &r, raster->step_q[j], raster->step_r[j], raster->area);
+        }
+        span->q[j][0] = q;
+        span->r64[j] = r;
+    }
+}
+
+/* The SIMD versions step each lane by a whole vector of pixels at a time,
+ * keeping the remainder minus the area so it fits in 32 bits and a carry
+ * is just a sign check. They may write a few attributes past the span count,
+ * and the span count is a multiple of the lanes except at the end of a row.
+ */
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") rasterize_span_SSE2(const TriangleRaster *raster, TriangleSpan *span)
+{
+    const __m128i area = _mm_set1_epi32((int)raster->area);
+    const __m128i zero_r = _mm_set1_epi32(-(int)raster->area);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i minus_one = _mm_set1_epi32(-1);
+    int i, j;
+
+    for (j = raster->first_attr; j <= raster->last_attr; j++) {
+        const __m128i step_q = _mm_set1_epi32((int)raster->simd_step_q[j]);
+        const __m128i step_r = _mm_set1_epi32(raster->simd_step_r[j]);
+        __m128i q = _mm_loadu_si128((const __m128i *)span->q[j]);
+        __m128i r = _mm_loadu_si128((const __m128i *)span->r[j]);
+        int *attr = span->attr[j];
+
+        for (i = 0; i < span->count; i += 4) {
+            // Round towards zero for negative values
+            const __m128i round = _mm_andnot_si128(_mm_cmpeq_epi32(r, zero_r), _mm_cmpgt_epi32(zero, q));
+            __m128i carry;
+            _mm_storeu_si128((__m128i *)&attr[i], _mm_sub_epi32(q, round));
+
+            r = _mm_add_epi32(r, step_r);
+            carry = _mm_cmpgt_epi32(r, minus_one);
+            q = _mm_sub_epi32(_mm_add_epi32(q, step_q), carry);
+            r = _mm_sub_epi32(r, _mm_and_si128(carry, area));
+        }
+        _mm_storeu_si128((__m128i *)span->q[j], q);
+        _mm_storeu_si128((__m128i *)span->r[j], r);
+    }
+}
+#endif // SDL_SSE2_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") rasterize_span_AVX2(const TriangleRaster *raster, TriangleSpan *span)
+{
+    const __m256i area = _mm256_set1_epi32((int)raster->area);
+    const __m256i zero_r = _mm256_set1_epi32(-(int)raster->area);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i minus_one = _mm256_set1_epi32(-1);
+    int i, j;
+
+    for (j = raster->first_attr; j <= raster->last_attr; j++) {
+        const __m256i step_q = _mm256_set1_epi32((int)raster->simd_step_q[j]);
+        const __m256i step_r = _mm256_set1_epi32(raster->simd_step_r[j]);
+        __m256i q = _mm256_loadu_si256((const __m256i *)span->q[j]);
+        __m256i r = _mm256_loadu_si256((const __m256i *)span->r[j]);
+        int *attr = span->attr[j];
+
+        for (i = 0; i < span->count; i += 8) {
+            // Round towards zero for negative values
+            const __m256i round = _mm256_andnot_si256(_mm256_cmpeq_epi32(r, zero_r), _mm256_cmpgt_epi32(zero, q));
+            __m256i carry;
+            _mm256_storeu_si256((__m256i *)&attr[i], _mm256_sub_epi32(q, round));
+
+            r = _mm256_add_epi32(r, step_r);
+            carry = _mm256_cmpgt_epi32(r, minus_one);
+            q = _mm256_sub_epi32(_mm256_add_epi32(q, step_q), carry);
+            r = _mm256_sub_epi32(r, _mm256_and_si256(carry, area));
+        }
+        _mm256_storeu_si256((__m256i *)span->q[j], q);
+        _mm256_storeu_si256((__m256i *)span->r[j], r);
+    }
+}
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+static void rasterize_span_NEON(const TriangleRaster *raster, TriangleSpan *span)
+{
+    const uint32x4_t area = vdupq_n_u32((uint32_t)raster->area);
+    const int32x4_t zero_r = vdupq_n_s32(-(int32_t)raster->area);
+    const int32x4_t zero = vdupq_n_s32(0);
+    int i, j;
+
+    for (j = raster->first_attr; j <= raster->last_attr; j++) {
+        const uint32x4_t step_q = vdupq_n_u32(raster->simd_step_q[j]);
+        const int32x4_t step_r = vdupq_n_s32(raster->simd_step_r[j]);
+        uint32x4_t q = vld1q_u32(span->q[j]);
+        int32x4_t r = vld1q_s32(span->r[j]);
+        int *attr = span->attr[j];
+
+        for (i = 0; i < span->count; i += 4) {
+            // Round towards zero for negative values
+            const uint32x4_t round = vbicq_u32(vcltq_s32(vreinterpretq_s32_u32(q), zero), vceqq_s32(r, zero_r));
+            uint32x4_t carry;
+            vst1q_s32(&attr[i], vreinterpretq_s32_u32(vsubq_u32(q, round)));
+
+            r = vaddq_s32(r, step_r);
+            carry = vcgeq_s32(r, zero);
+            q = vsubq_u32(vaddq_u32(q, step_q), carry);
+            r = vsubq_s32(r, vreinterpretq_s32_u32(vandq_u32(carry, area)));
+        }
+        vst1q_u32(span->q[j], q);
+        vst1q_s32(span->r[j], r);
+    }
+}
+#endif // SDL_NEON_INTRINSICS
+
+static void setup_triangle_raster(TriangleRaster *raster, Sint64 area, int bias_w0, int bias_w1, int bias_w2,
+                                  int d2d1_y, int d0d2_y, int d1d0_y, int first_attr, int last_attr)
+{
+    SDL_zerop(raster);
+    raster->area = area;
+    raster->d2d1_y = d2d1_y;
+    raster->d0d2_y = d0d2_y;
+    raster->d1d0_y = d1d0_y;
+    raster->bias_w0 = bias_w0;
+    raster->bias_w1 = bias_w1;
+    raster->bias_w2 = bias_w2;
+    raster->first_attr = first_attr;
+    raster->last_attr = last_attr;
+
+    if (first_attr > last_attr || area >= SDL_MAX_SINT32) {
+        return;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        raster->lanes = 8;
+        raster->rasterize_simd = rasterize_span_AVX2;
+        return;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        raster->lanes = 4;
+        raster->rasterize_simd = rasterize_span_SSE2;
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        raster->lanes = 4;
+        raster->rasterize_simd = rasterize_span_NEON;
+        return;
+    }
+#endif
+}
+
+static void setup_triangle_attr(TriangleRaster *raster, int attr, Sint64 k0, Sint64 k1, Sint64 k2, Sint64 k3)
+{
+    const Sint64 area = raster->area;
+    const Sint64 step = raster->d2d1_y * k0 + raster->d0d2_y * k1 + raster->d1d0_y * k2;
+    const Sint64 step_q = floor_div(step, area);
+    Uint32 q = 0;
+    Sint64 r = 0;
+    int i;
+
+    raster->k[attr][0] = k0;
+    raster->k[attr][1] = k1;
+    raster->k[attr][2] = k2;
+    raster->k[attr][3] = k3;
+    raster->step_q[attr] = (Uint32)step_q;
+    raster->step_r[attr] = step - step_q * area;
+
+    for (i = 0; i < raster->lanes; i++) {
+        raster->lane_q[attr][i] = q;
+        raster->lane_r[attr][i] = (Sint32)r;
+        add_step(&q, &r, raster->step_q[attr], raster->step_r[attr], area);
+    }
+    raster->simd_step_q[attr] = q;
+    raster->simd_step_r[attr] = (Sint32)r;
+}
+
+static void setup_triangle_texcoords(TriangleRaster *raster, SDL_Point s2_x_area, int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y)
+{
+    setup_triangle_attr(raster, TRIANGLE_ATTR_SRCX, s2s0_x, s2s1_x, 0, s2_x_area.x);
+    setup_triangle_attr(raster, TRIANGLE_ATTR_SRCY, s2s0_y, s2s1_y, 0, s2_x_area.y);
+}
+
+static void setup_triangle_colors(TriangleRaster *raster, SDL_Color c0, SDL_Color c1, SDL_Color c2)
+{
+    setup_triangle_attr(raster, TRIANGLE_ATTR_R, c0.r, c1.r, c2.r, 0);
+    setup_triangle_attr(raster, TRIANGLE_ATTR_G, c0.g, c1.g, c2.g, 0);
+    setup_triangle_attr(raster, TRIANGLE_ATTR_B, c0.b, c1.b, c2.b, 0);
+    setup_triangle_attr(raster, TRIANGLE_ATTR_A, c0.a, c1.a, c2.a, 0);
+}
+
+#define TRIANGLE_BEGIN_LOOP                                                                        \
+    {                                                                                              \
+        int x, x_end, y, i;                                                                        \
+        TriangleSpan span;                                                                         \
+        for (y = 0; y < dstrect.h; y++) {                                                          \
+            /* x range inside the triangle */                                                      \
+            if (get_triangle_row(&raster, w0_row, w1_row, w2_row, dstrect.w, &x, &x_end)) {        \
+                start_triangle_row(&raster, &span, w0_row, w1_row, w2_row, x);                     \
+                for (; x < x_end; x += span.count) {                                               \
+                    rasterize_span(&raster, &span, x_end - x);                                     \
+                    for (i = 0; i < span.count; i++) {                                             \
+                        Uint8 *dptr = (Uint8 *)dst_ptr + (x + i) * dstbpp;
+
+#define TRIANGLE_GET_TEXTCOORD                                      \
+    int srcx = span.attr[TRIANGLE_ATTR_SRCX][i];                    \
+    int srcy = span.attr[TRIANGLE_ATTR_SRCY][i];                    \
+    if (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP) {         \
+        srcx %= src_surface->w;                                     \
+        if (srcx < 0) {                                             \
+            srcx += (src_surface->w - 1);                           \
+        }                                                           \
+        srcy %= src_surface->h;                                     \
+        if (srcy < 0) {                                             \
+            srcy += (src_surface->h - 1);                           \
+        }                                                           \
+    }
+
+#define TRIANGLE_GET_MAPPED_COLOR                       \
+    Uint8 r = (Uint8)span.attr[TRIANGLE_ATTR_R][i];     \
+    Uint8 g = (Uint8)span.attr[TRIANGLE_ATTR_G][i];     \
+    Uint8 b = (Uint8)span.attr[TRIANGLE_ATTR_B][i];     \
+    Uint8 a = (Uint8)span.attr[TRIANGLE_ATTR_A][i];     \
     Uint32 color = SDL_MapRGBA(format, palette, r, g, b, a);
 
-#define TRIANGLE_GET_COLOR                                                             \
-    int r = (int)(((Sint64)w0 * c0.r + (Sint64)w1 * c1.r + (Sint64)w2 * c2.r) / area); \
-    int g = (int)(((Sint64)w0 * c0.g + (Sint64)w1 * c1.g + (Sint64)w2 * c2.g) / area); \
-    int b = (int)(((Sint64)w0 * c0.b + (Sint64)w1 * c1.b + (Sint64)w2 * c2.b) / area); \
-    int a = (int)(((Sint64)w0 * c0.a + (Sint64)w1 * c1.a + (Sint64)w2 * c2.a) / area);
-
-#define TRIANGLE_END_LOOP \
-    }                     \
-    /* x += 1 */          \
-    w0 += d2d1_y;         \
-    w1 += d0d2_y;         \
-    w2 += d1d0_y;         \
-    }                     \
-    /* y += 1 */          \
-    w0_row += d1d2_x;     \
-    w1_row += d2d0_x;     \
-    w2_row += d0d1_x;     \
-    dst_ptr += dst_pitch; \
-    }                     \
+#define TRIANGLE_GET_COLOR                  \
+    int r = span.attr[TRIANGLE_ATTR_R][i];  \
+    int g = span.attr[TRIANGLE_ATTR_G][i];  \
+    int b = span.attr[TRIANGLE_ATTR_B][i];  \
+    int a = span.attr[TRIANGLE_ATTR_A][i];
+
+#define TRIANGLE_END_LOOP     \
+                    }         \
+                }             \
+            }                 \
+            /* y += 1 */      \
+            w0_row += d1d2_x; \
+            w1_row += d2d0_x; \
+            w2_row += d0d1_x; \
+            dst_ptr += dst_pitch; \
+        }                     \
     }
 
 bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
@@ -243,6 +577,8 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
 
     bool is_uniform;
 
+    TriangleRaster raster;
+
     SDL_Surface *tmp = NULL;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -366,6 +702,13 @@ bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Poi
     bias_w1 = (is_top_left(d2, d0, is_clockwise) ? 0 : -1);
     bias_w2 = (is_top_left(d0, d1, is_clockwise) ? 0 : -1);
 
+    if (is_uniform) {
+        setup_triangle_raster(&raster, area, bias_w0, bias_w1, bias_w2, d2d1_y, d0d2_y, d1d0_y, 0, -1);
+    } else {
+        setup_triangle_raster(&raster, area, bias_w0, bias_w1, bias_w2, d2d1_y, d0d2_y, d1d0_y, TRIANGLE_ATTR_R, TRIANGLE_ATTR_A);
+        setup_triangle_colors(&raster, c0, c1, c2);
+    }
+
     if (is_uniform) {
         Uint32 color;
         if (tmp) {
@@ -498,6 +841,8 @@ bool SDL_SW_BlitTriangle(
 
     bool has_modulation;
 
+    TriangleRaster raster;
+
     if (!SDL_SurfaceValid(src)) {
         return SDL_InvalidParamError("src");
     }
@@ -721,6 +1066,9 @@ bool SDL_SW_BlitTriangle(
         goto end;
     }
 
+    setup_triangle_raster(&raster, area, bias_w0, bias_w1, bias_w2, d2d1_y, d0d2_y, d1d0_y, TRIANGLE_ATTR_SRCX, TRIANGLE_ATTR_SRCY);
+    setup_triangle_texcoords(&raster, s2_x_area, s2s0_x, s2s1_x, s2s0_y, s2s1_y);
+
     if (dstbpp == 4) {
         TRIANGLE_BEGIN_LOOP
         {
@@ -812,9 +1160,15 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     Uint8 *dst_ptr = info->dst;
     int dst_pitch = info->dst_pitch;
 
+    TriangleRaster raster;
+
     srcfmt_val = detect_format(src_fmt);
     dstfmt_val = detect_format(dst_fmt);
 
+    setup_triangle_raster(&raster, area, bias_w0, bias_w1, bias_w2, d2d1_y, d0d2_y, d1d0_y, TRIANGLE_ATTR_SRCX, is_uniform ? TRIANGLE_ATTR_SRCY : TRIANGLE_ATTR_A);
+    setup_triangle_texcoords(&raster, s2_x_area, s2s0_x, s2s1_x, s2s0_y, s2s1_y);
+    setup_triangle_colors(&raster, c0, c1, c2);
+
     TRIANGLE_BEGIN_LOOP
     {
         Uint8 *src;
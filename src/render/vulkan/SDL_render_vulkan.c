@@ -39,6 +39,10 @@
 #include "../../video/SDL_pixels_c.h"
 #include "SDL_shaders_vulkan.h"
 
+#ifdef SDL_PLATFORM_LINUX
+#include <unistd.h>
+#endif
+
 #define SET_ERROR_CODE(message, rc)                                                                 \
     if (SDL_GetHintBoolean(SDL_HINT_RENDER_VULKAN_DEBUG, false)) {                                  \
         SDL_LogError(SDL_LOG_CATEGORY_RENDER, "%s: %s", message, SDL_Vulkan_GetResultString(rc)); \
@@ -83,6 +87,7 @@
     VULKAN_DEVICE_FUNCTION(vkCreateGraphicsPipelines)                   \
     VULKAN_DEVICE_FUNCTION(vkCreateImage)                               \
     VULKAN_DEVICE_FUNCTION(vkCreateImageView)                           \
+    VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache)                       \
     VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout)                      \
     VULKAN_DEVICE_FUNCTION(vkCreateRenderPass)                          \
     VULKAN_DEVICE_FUNCTION(vkCreateSampler)                             \
@@ -99,6 +104,7 @@
     VULKAN_DEVICE_FUNCTION(vkDestroyImage)                              \
     VULKAN_DEVICE_FUNCTION(vkDestroyImageView)                          \
     VULKAN_DEVICE_FUNCTION(vkDestroyPipeline)                           \
+    VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache)                      \
     VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout)                     \
     VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass)                         \
     VULKAN_DEVICE_FUNCTION(vkDestroySampler)                            \
@@ -111,6 +117,7 @@
     VULKAN_DEVICE_FUNCTION(vkFreeMemory)                                \
     VULKAN_DEVICE_FUNCTION(vkGetBufferMemoryRequirements)               \
     VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements)                \
+    VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData)                      \
     VULKAN_DEVICE_FUNCTION(vkGetDeviceQueue)                            \
     VULKAN_DEVICE_FUNCTION(vkGetFenceStatus)                            \
     VULKAN_DEVICE_FUNCTION(vkGetSwapchainImagesKHR)                     \
@@ -149,6 +156,7 @@
     VULKAN_OPTIONAL_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties2KHR)            \
     VULKAN_OPTIONAL_DEVICE_FUNCTION(vkCreateSamplerYcbcrConversionKHR)              \
     VULKAN_OPTIONAL_DEVICE_FUNCTION(vkDestroySamplerYcbcrConversionKHR)             \
+    VULKAN_OPTIONAL_DEVICE_FUNCTION(vkGetMemoryFdPropertiesKHR)                     \
 
 #define VULKAN_DEVICE_FUNCTION(name)            static PFN_##name name = NULL;
 #define VULKAN_GLOBAL_FUNCTION(name)            static PFN_##name name = NULL;
@@ -341,6 +349,7 @@ typedef struct
     uint32_t *numConstantBuffers;
     uint32_t currentConstantBufferIndex;
     int32_t currentConstantBufferOffset;
+    VULKAN_PixelShaderConstants currentConstants;
 
     VkSampler samplers[VULKAN_SAMPLER_COUNT];
     VkDescriptorPool **descriptorPools;
@@ -351,10 +360,14 @@ typedef struct
     int pipelineStateCount;
     VULKAN_PipelineState *pipelineStates;
     VULKAN_PipelineState *currentPipelineState;
+    VkPipelineCache pipelineCache;
+    SDL_Thread *pipelineWarmupThread;
 
     bool supportsEXTSwapchainColorspace;
     bool supportsKHRGetPhysicalDeviceProperties2;
     bool supportsKHRSamplerYCbCrConversion;
+    bool supportsKHRExternalMemoryCapabilities;
+    bool supportsEXTExternalMemoryDmaBuf;
     uint32_t surfaceFormatsAllocatedCount;
     uint32_t surfaceFormatsCount;
     uint32_t swapchainDesiredImageCount;
@@ -440,11 +453,26 @@ static VkDeviceSize VULKAN_GetBytesPerPixel(VkFormat vkFormat, int plane)
         return 1;
     case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
         return (plane == 0) ? 1 : 2;
+    case VK_FORMAT_G8B8G8R8_422_UNORM:
+    case VK_FORMAT_B8G8R8G8_422_UNORM:
+        return 2;
     default:
         return 4;
     }
 }
 
+// Packed 4:2:2 formats are copied in blocks of 2 pixels
+static uint32_t VULKAN_GetCopyWidth(VkFormat vkFormat, uint32_t width)
+{
+    switch (vkFormat) {
+    case VK_FORMAT_G8B8G8R8_422_UNORM:
+    case VK_FORMAT_B8G8R8G8_422_UNORM:
+        return (width + 1) & ~1;
+    default:
+        return width;
+    }
+}
+
 static VkFormat SDLPixelFormatToVkTextureFormat(Uint32 format, Uint32 output_colorspace)
 {
     switch (format) {
@@ -463,6 +491,7 @@ static VkFormat SDLPixelFormatToVkTextureFormat(Uint32 format, Uint32 output_col
         }
         return VK_FORMAT_R8G8B8A8_UNORM;
     case SDL_PIXELFORMAT_YUY2:
+    case SDL_PIXELFORMAT_YVYU:
         return VK_FORMAT_G8B8G8R8_422_UNORM;
     case SDL_PIXELFORMAT_UYVY:
         return VK_FORMAT_B8G8R8G8_422_UNORM;
@@ -487,6 +516,8 @@ static bool VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *rendererData, uint32_t
 static VkResult VULKAN_CreateWindowSizeDependentResources(SDL_Renderer *renderer);
 static VkDescriptorPool VULKAN_AllocateDescriptorPool(VULKAN_RenderData *rendererData);
 static VkResult VULKAN_CreateDescriptorSetAndPipelineLayout(VULKAN_RenderData *rendererData, VkSampler samplerYcbcr, VkDescriptorSetLayout *descriptorSetLayoutOut, VkPipelineLayout *pipelineLayoutOut);
+static void VULKAN_WaitForPipelineWarmup(VULKAN_RenderData *rendererData);
+static void VULKAN_DestroyPipelineCache(VULKAN_RenderData *rendererData);
 static VkSurfaceTransformFlagBitsKHR VULKAN_GetRotationForCurrentRenderTarget(VULKAN_RenderData *rendererData);
 static bool VULKAN_IsDisplayRotated90Degrees(VkSurfaceTransformFlagBitsKHR rotation);
 
@@ -501,6 +532,8 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
         return;
     }
 
+    VULKAN_WaitForPipelineWarmup(rendererData);
+
     // Release all textures
     for (SDL_Texture *texture = renderer->textures; texture; texture = texture->next) {
         VULKAN_DestroyTexture(renderer, texture);
@@ -647,6 +680,7 @@ static void VULKAN_DestroyAll(SDL_Renderer *renderer)
     SDL_free(rendererData->pipelineStates);
     rendererData->pipelineStates = NULL;
     rendererData->pipelineStateCount = 0;
+    VULKAN_DestroyPipelineCache(rendererData);
 
     if (rendererData->currentUploadBuffer) {
         for (uint32_t i = 0; i < rendererData->swapchainImageCount; ++i) {
@@ -778,6 +812,143 @@ static void VULKAN_DestroyImage(VULKAN_RenderData *rendererData, VULKAN_Image *v
     SDL_memset(vulkanImage, 0, sizeof(VULKAN_Image));
 }
 
+#ifdef SDL_PLATFORM_LINUX
+static VkResult VULKAN_ImportDmabufImage(VULKAN_RenderData *rendererData, SDL_PropertiesID create_props, uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags imageUsage, VULKAN_Image *imageOut)
+{
+    VkResult result;
+    VkSubresourceLayout planeLayouts[2];
+    uint32_t planeCount;
+    int fd;
+
+    if (!rendererData->supportsEXTExternalMemoryDmaBuf || !vkGetMemoryFdPropertiesKHR) {
+        SDL_SetError("Importing dmabufs requires a Vulkan device that supports VK_EXT_external_memory_dma_buf and VK_EXT_image_drm_format_modifier");
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    switch (format) {
+    case VK_FORMAT_G8_B8R8_2PLANE_420_UNORM:
+    case VK_FORMAT_G10X6_B10X6R10X6_2PLANE_420_UNORM_3PACK16:
+        planeCount = 2;
+        break;
+    case VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM:
+        SDL_SetError("Importing dmabufs with three planes isn't supported");
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    default:
+        planeCount = 1;
+        break;
+    }
+
+    SDL_zeroa(planeLayouts);
+    planeLayouts[0].offset = (VkDeviceSize)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_OFFSET_NUMBER, 0);
+    planeLayouts[0].rowPitch = (VkDeviceSize)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_PITCH_NUMBER, 0);
+    planeLayouts[1].offset = (VkDeviceSize)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_OFFSET_NUMBER, 0);
+    planeLayouts[1].rowPitch = (VkDeviceSize)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_UV_PITCH_NUMBER, 0);
+    if (planeLayouts[0].rowPitch == 0 || (planeCount == 2 && planeLayouts[1].rowPitch == 0)) {
+        SDL_SetError("Importing a dmabuf requires the pitch of each plane");
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    VkImageDrmFormatModifierExplicitCreateInfoEXT modifierCreateInfo = { 0 };
+    modifierCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_DRM_FORMAT_MODIFIER_EXPLICIT_CREATE_INFO_EXT;
+    modifierCreateInfo.drmFormatModifier = (uint64_t)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_MODIFIER_NUMBER, 0);
+    modifierCreateInfo.drmFormatModifierPlaneCount = planeCount;
+    modifierCreateInfo.pPlaneLayouts = planeLayouts;
+
+    VkExternalMemoryImageCreateInfoKHR externalCreateInfo = { 0 };
+    externalCreateInfo.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_IMAGE_CREATE_INFO_KHR;
+    externalCreateInfo.pNext = &modifierCreateInfo;
+    externalCreateInfo.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+
+    VkImageCreateInfo imageCreateInfo = { 0 };
+    imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageCreateInfo.pNext = &externalCreateInfo;
+    imageCreateInfo.flags = 0;
+    imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageCreateInfo.format = format;
+    imageCreateInfo.extent.width = width;
+    imageCreateInfo.extent.height = height;
+    imageCreateInfo.extent.depth = 1;
+    imageCreateInfo.mipLevels = 1;
+    imageCreateInfo.arrayLayers = 1;
+    imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageCreateInfo.tiling = VK_IMAGE_TILING_DRM_FORMAT_MODIFIER_EXT;
+    imageCreateInfo.usage = imageUsage;
+    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageCreateInfo.queueFamilyIndexCount = 0;
+    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    imageOut->allocatedImage = VK_TRUE;
+    result = vkCreateImage(rendererData->device, &imageCreateInfo, NULL, &imageOut->image);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyImage(rendererData, imageOut);
+        SET_ERROR_CODE("vkCreateImage()", result);
+        return result;
+    }
+
+    // The imported memory takes ownership of the file descriptor it is given, so give it a copy
+    fd = dup((int)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_FD_NUMBER, -1));
+    if (fd < 0) {
+        VULKAN_DestroyImage(rendererData, imageOut);
+        SDL_SetError("Couldn't duplicate dmabuf file descriptor");
+        return VK_ERROR_INVALID_EXTERNAL_HANDLE;
+    }
+
+    VkMemoryFdPropertiesKHR memoryFdProperties = { 0 };
+    memoryFdProperties.sType = VK_STRUCTURE_TYPE_MEMORY_FD_PROPERTIES_KHR;
+    result = vkGetMemoryFdPropertiesKHR(rendererData->device, VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT, fd, &memoryFdProperties);
+    if (result != VK_SUCCESS) {
+        close(fd);
+        VULKAN_DestroyImage(rendererData, imageOut);
+        SET_ERROR_CODE("vkGetMemoryFdPropertiesKHR()", result);
+        return result;
+    }
+
+    VkMemoryRequirements memoryRequirements = { 0 };
+    vkGetImageMemoryRequirements(rendererData->device, imageOut->image, &memoryRequirements);
+
+    uint32_t memoryTypeIndex = 0;
+    if (!VULKAN_FindMemoryTypeIndex(rendererData, memoryRequirements.memoryTypeBits & memoryFdProperties.memoryTypeBits, 0, 0, &memoryTypeIndex)) {
+        close(fd);
+        VULKAN_DestroyImage(rendererData, imageOut);
+        return VK_ERROR_UNKNOWN;
+    }
+
+    VkMemoryDedicatedAllocateInfoKHR dedicatedAllocateInfo = { 0 };
+    dedicatedAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO_KHR;
+    dedicatedAllocateInfo.image = imageOut->image;
+
+    VkImportMemoryFdInfoKHR importMemoryFdInfo = { 0 };
+    importMemoryFdInfo.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_FD_INFO_KHR;
+    importMemoryFdInfo.pNext = &dedicatedAllocateInfo;
+    importMemoryFdInfo.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_DMA_BUF_BIT_EXT;
+    importMemoryFdInfo.fd = fd;
+
+    VkMemoryAllocateInfo memoryAllocateInfo = { 0 };
+    memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    memoryAllocateInfo.pNext = &importMemoryFdInfo;
+    memoryAllocateInfo.allocationSize = memoryRequirements.size;
+    memoryAllocateInfo.memoryTypeIndex = memoryTypeIndex;
+    result = vkAllocateMemory(rendererData->device, &memoryAllocateInfo, NULL, &imageOut->deviceMemory);
+    if (result != VK_SUCCESS) {
+        close(fd);
+        VULKAN_DestroyImage(rendererData, imageOut);
+        SET_ERROR_CODE("vkAllocateMemory()", result);
+        return result;
+    }
+    result = vkBindImageMemory(rendererData->device, imageOut->image, imageOut->deviceMemory, 0);
+    if (result != VK_SUCCESS) {
+        VULKAN_DestroyImage(rendererData, imageOut);
+        SET_ERROR_CODE("vkBindImageMemory()", result);
+        return result;
+    }
+
+    /* The contents are synchronized with the producer by the dmabuf's implicit fences,
+       and the image is moved to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL when first drawn. */
+    imageOut->imageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    return VK_SUCCESS;
+}
+#endif // SDL_PLATFORM_LINUX
+
 static VkResult VULKAN_AllocateImage(VULKAN_RenderData *rendererData, SDL_PropertiesID create_props, uint32_t width, uint32_t height, VkFormat format, VkImageUsageFlags imageUsage, VkComponentMapping swizzle, VkSamplerYcbcrConversionKHR samplerYcbcrConversion, VULKAN_Image *imageOut)
 {
     VkResult result;
@@ -787,7 +958,18 @@ static VkResult VULKAN_AllocateImage(VULKAN_RenderData *rendererData, SDL_Proper
     imageOut->format = format;
     imageOut->image = (VkImage)SDL_GetNumberProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_TEXTURE_NUMBER, 0);
 
-    if (imageOut->image == VK_NULL_HANDLE) {
+    if (imageOut->image == VK_NULL_HANDLE &&
+        SDL_HasProperty(create_props, SDL_PROP_TEXTURE_CREATE_VULKAN_DMABUF_FD_NUMBER)) {
+#ifdef SDL_PLATFORM_LINUX
+        result = VULKAN_ImportDmabufImage(rendererData, create_props, width, height, format, imageUsage, imageOut);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+#else
+        SDL_Unsupported();
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+#endif
+    } else if (imageOut->image == VK_NULL_HANDLE) {
         imageOut->allocatedImage = VK_TRUE;
 
         VkImageCreateInfo imageCreateInfo = { 0 };
@@ -1167,12 +1349,9 @@ static VkBlendOp GetBlendOp(SDL_BlendOperation operation)
 }
 
 
-static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
-    VULKAN_Shader shader, VkPipelineLayout pipelineLayout, VkDescriptorSetLayout descriptorSetLayout, SDL_BlendMode blendMode, VkPrimitiveTopology topology, VkFormat format)
+static VkResult VULKAN_CreatePipeline(VULKAN_RenderData *rendererData,
+    VULKAN_Shader shader, VkPipelineLayout pipelineLayout, SDL_BlendMode blendMode, VkPrimitiveTopology topology, VkRenderPass renderPass, VkPipeline *pipelineOut)
 {
-    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
-    VULKAN_PipelineState *pipelineStates;
-    VkPipeline pipeline = VK_NULL_HANDLE;
     VkResult result = VK_SUCCESS;
     VkPipelineVertexInputStateCreateInfo vertexInputCreateInfo = { 0 };
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCreateInfo = { 0 };
@@ -1291,18 +1470,31 @@ static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 
     // Renderpass / layout
-    pipelineCreateInfo.renderPass = rendererData->currentRenderPass;
+    pipelineCreateInfo.renderPass = renderPass;
     pipelineCreateInfo.subpass = 0;
     pipelineCreateInfo.layout = pipelineLayout;
 
-    result = vkCreateGraphicsPipelines(rendererData->device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, NULL, &pipeline);
+    result = vkCreateGraphicsPipelines(rendererData->device, rendererData->pipelineCache, 1, &pipelineCreateInfo, NULL, pipelineOut);
     if (result != VK_SUCCESS) {
         SET_ERROR_CODE("vkCreateGraphicsPipelines()", result);
+    }
+    return result;
+}
+
+static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
+    VULKAN_Shader shader, VkPipelineLayout pipelineLayout, VkDescriptorSetLayout descriptorSetLayout, SDL_BlendMode blendMode, VkPrimitiveTopology topology, VkFormat format, VkRenderPass renderPass)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    VULKAN_PipelineState *pipelineStates;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+
+    if (VULKAN_CreatePipeline(rendererData, shader, pipelineLayout, blendMode, topology, renderPass, &pipeline) != VK_SUCCESS) {
         return NULL;
     }
 
     pipelineStates = (VULKAN_PipelineState *)SDL_realloc(rendererData->pipelineStates, (rendererData->pipelineStateCount + 1) * sizeof(*pipelineStates));
     if (!pipelineStates) {
+        vkDestroyPipeline(rendererData->device, pipeline, NULL);
         return NULL;
     }
     pipelineStates[rendererData->pipelineStateCount].shader = shader;
@@ -1311,13 +1503,164 @@ static VULKAN_PipelineState *VULKAN_CreatePipelineState(SDL_Renderer *renderer,
     pipelineStates[rendererData->pipelineStateCount].format = format;
     pipelineStates[rendererData->pipelineStateCount].pipeline = pipeline;
     pipelineStates[rendererData->pipelineStateCount].descriptorSetLayout = descriptorSetLayout;
-    pipelineStates[rendererData->pipelineStateCount].pipelineLayout = pipelineCreateInfo.layout;
+    pipelineStates[rendererData->pipelineStateCount].pipelineLayout = pipelineLayout;
     rendererData->pipelineStates = pipelineStates;
     ++rendererData->pipelineStateCount;
 
     return &pipelineStates[rendererData->pipelineStateCount - 1];
 }
 
+static bool VULKAN_IsPipelineCacheCompatible(VULKAN_RenderData *rendererData, const void *data, size_t size)
+{
+    VkPhysicalDeviceProperties properties;
+    Uint32 header[4];
+
+    if (size < sizeof(header) + VK_UUID_SIZE) {
+        return false;
+    }
+    SDL_memcpy(header, data, sizeof(header));
+    vkGetPhysicalDeviceProperties(rendererData->physicalDevice, &properties);
+    return (header[0] >= sizeof(header) + VK_UUID_SIZE &&
+            header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header[2] == properties.vendorID &&
+            header[3] == properties.deviceID &&
+            SDL_memcmp((const Uint8 *)data + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+}
+
+static void VULKAN_CreatePipelineCache(VULKAN_RenderData *rendererData)
+{
+    const char *path = SDL_GetStringProperty(rendererData->create_props, SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_STRING, NULL);
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo = { 0 };
+    void *data = NULL;
+    size_t size = 0;
+    VkResult result;
+
+    if (path && *path) {
+        data = SDL_LoadFile(path, &size);
+        if (data && !VULKAN_IsPipelineCacheCompatible(rendererData, data, size)) {
+            // Written by a different device or driver version
+            SDL_free(data);
+            data = NULL;
+            size = 0;
+        }
+    }
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.initialDataSize = size;
+    pipelineCacheCreateInfo.pInitialData = data;
+    result = vkCreatePipelineCache(rendererData->device, &pipelineCacheCreateInfo, NULL, &rendererData->pipelineCache);
+    if (result != VK_SUCCESS && data) {
+        pipelineCacheCreateInfo.initialDataSize = 0;
+        pipelineCacheCreateInfo.pInitialData = NULL;
+        result = vkCreatePipelineCache(rendererData->device, &pipelineCacheCreateInfo, NULL, &rendererData->pipelineCache);
+    }
+    if (result != VK_SUCCESS) {
+        // Not fatal, pipelines are just created without a cache
+        rendererData->pipelineCache = VK_NULL_HANDLE;
+    }
+    SDL_free(data);
+}
+
+static void VULKAN_DestroyPipelineCache(VULKAN_RenderData *rendererData)
+{
+    const char *path;
+
+    if (rendererData->pipelineCache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    path = SDL_GetStringProperty(rendererData->create_props, SDL_PROP_RENDERER_CREATE_VULKAN_PIPELINE_CACHE_STRING, NULL);
+    if (path && *path) {
+        size_t size = 0;
+        if (vkGetPipelineCacheData(rendererData->device, rendererData->pipelineCache, &size, NULL) == VK_SUCCESS && size > 0) {
+            void *data = SDL_malloc(size);
+            if (data && vkGetPipelineCacheData(rendererData->device, rendererData->pipelineCache, &size, data) == VK_SUCCESS) {
+                SDL_SaveFile(path, data, size);
+            }
+            SDL_free(data);
+        }
+    }
+
+    vkDestroyPipelineCache(rendererData->device, rendererData->pipelineCache, NULL);
+    rendererData->pipelineCache = VK_NULL_HANDLE;
+}
+
+// The draw states most programs use, created up front with SDL_HINT_RENDER_VULKAN_PIPELINE_WARMUP
+static const struct
+{
+    VULKAN_Shader shader;
+    VkPrimitiveTopology topology;
+} VULKAN_WarmupPipelines[] = {
+    { SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST },
+    { SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_POINT_LIST },
+    { SHADER_SOLID, VK_PRIMITIVE_TOPOLOGY_LINE_STRIP },
+    { SHADER_RGB, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST },
+};
+
+static const SDL_BlendMode VULKAN_WarmupBlendModes[] = {
+    SDL_BLENDMODE_NONE,
+    SDL_BLENDMODE_BLEND,
+    SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+    SDL_BLENDMODE_ADD,
+    SDL_BLENDMODE_ADD_PREMULTIPLIED,
+    SDL_BLENDMODE_MOD,
+    SDL_BLENDMODE_MUL,
+};
+
+static int SDLCALL VULKAN_PipelineWarmupThread(void *userdata)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)userdata;
+    VkRenderPass renderPass = rendererData->renderPasses[VULKAN_RENDERPASS_LOAD];
+
+    /* This only fills the pipeline cache, the pipelines themselves are created
+     * again on the render thread when they're first used, which is then quick.
+     */
+    for (int i = 0; i < SDL_arraysize(VULKAN_WarmupPipelines); ++i) {
+        for (int j = 0; j < SDL_arraysize(VULKAN_WarmupBlendModes); ++j) {
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            if (VULKAN_CreatePipeline(rendererData, VULKAN_WarmupPipelines[i].shader, rendererData->pipelineLayout, VULKAN_WarmupBlendModes[j], VULKAN_WarmupPipelines[i].topology, renderPass, &pipeline) == VK_SUCCESS) {
+                vkDestroyPipeline(rendererData->device, pipeline, NULL);
+            }
+        }
+    }
+    return 0;
+}
+
+static void VULKAN_WarmupPipelineStates(SDL_Renderer *renderer)
+{
+    VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_VULKAN_PIPELINE_WARMUP);
+
+    if (!hint || rendererData->pipelineCache == VK_NULL_HANDLE) {
+        return;
+    }
+
+    if (SDL_strcasecmp(hint, "thread") == 0) {
+        rendererData->pipelineWarmupThread = SDL_CreateThread(VULKAN_PipelineWarmupThread, "SDLVulkanWarmup", rendererData);
+        return;
+    }
+
+    if (!SDL_GetHintBoolean(SDL_HINT_RENDER_VULKAN_PIPELINE_WARMUP, false)) {
+        return;
+    }
+
+    for (int i = 0; i < SDL_arraysize(VULKAN_WarmupPipelines); ++i) {
+        for (int j = 0; j < SDL_arraysize(VULKAN_WarmupBlendModes); ++j) {
+            VULKAN_CreatePipelineState(renderer, VULKAN_WarmupPipelines[i].shader, rendererData->pipelineLayout, rendererData->descriptorSetLayout,
+                                       VULKAN_WarmupBlendModes[j], VULKAN_WarmupPipelines[i].topology, rendererData->surfaceFormat.format,
+                                       rendererData->renderPasses[VULKAN_RENDERPASS_LOAD]);
+        }
+    }
+}
+
+static void VULKAN_WaitForPipelineWarmup(VULKAN_RenderData *rendererData)
+{
+    if (rendererData->pipelineWarmupThread) {
+        SDL_WaitThread(rendererData->pipelineWarmupThread, NULL);
+        rendererData->pipelineWarmupThread = NULL;
+    }
+}
+
 static bool VULKAN_FindMemoryTypeIndex(VULKAN_RenderData *rendererData, uint32_t typeBits, VkMemoryPropertyFlags requiredFlags, VkMemoryPropertyFlags desiredFlags, uint32_t *memoryTypeIndexOut)
 {
     uint32_t memoryTypeIndex = 0;
@@ -1722,6 +2065,16 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         VK_KHR_MAINTENANCE1_EXTENSION_NAME,
         VK_KHR_BIND_MEMORY_2_EXTENSION_NAME,
         VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+        /* dmabuf import, which also depends on the extensions above.
+           Note VULKAN_DeviceExtensionsFound() call below, if these get moved in this
+           array, update that check too.
+       */
+        VK_KHR_EXTERNAL_MEMORY_EXTENSION_NAME,
+        VK_KHR_EXTERNAL_MEMORY_FD_EXTENSION_NAME,
+        VK_EXT_EXTERNAL_MEMORY_DMA_BUF_EXTENSION_NAME,
+        VK_EXT_IMAGE_DRM_FORMAT_MODIFIER_EXTENSION_NAME,
+        VK_KHR_IMAGE_FORMAT_LIST_EXTENSION_NAME,
+        VK_KHR_DEDICATED_ALLOCATION_EXTENSION_NAME,
     };
     VULKAN_RenderData *rendererData = (VULKAN_RenderData *)renderer->internal;
     SDL_VideoDevice *device = SDL_GetVideoDevice();
@@ -1760,6 +2113,9 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
     // Check for VK_KHR_get_physical_device_properties2
     rendererData->supportsKHRGetPhysicalDeviceProperties2 = VULKAN_InstanceExtensionFound(rendererData, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
 
+    // Check for VK_KHR_external_memory_capabilities, needed to import dmabufs
+    rendererData->supportsKHRExternalMemoryCapabilities = VULKAN_InstanceExtensionFound(rendererData, VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME);
+
     // Create VkInstance
     rendererData->instance = (VkInstance)SDL_GetPointerProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_INSTANCE_POINTER, NULL);
     if (rendererData->instance) {
@@ -1773,7 +2129,7 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         instanceCreateInfo.pApplicationInfo = &appInfo;
         char const *const *instanceExtensions = SDL_Vulkan_GetInstanceExtensions(&instanceCreateInfo.enabledExtensionCount);
 
-        const char **instanceExtensionsCopy = (const char **)SDL_calloc(instanceCreateInfo.enabledExtensionCount + 2, sizeof(const char *));
+        const char **instanceExtensionsCopy = (const char **)SDL_calloc(instanceCreateInfo.enabledExtensionCount + 3, sizeof(const char *));
         for (uint32_t i = 0; i < instanceCreateInfo.enabledExtensionCount; i++) {
             instanceExtensionsCopy[i] = instanceExtensions[i];
         }
@@ -1785,6 +2141,10 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
             instanceExtensionsCopy[instanceCreateInfo.enabledExtensionCount] = VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME;
             instanceCreateInfo.enabledExtensionCount++;
         }
+        if (rendererData->supportsKHRExternalMemoryCapabilities) {
+            instanceExtensionsCopy[instanceCreateInfo.enabledExtensionCount] = VK_KHR_EXTERNAL_MEMORY_CAPABILITIES_EXTENSION_NAME;
+            instanceCreateInfo.enabledExtensionCount++;
+        }
         instanceCreateInfo.ppEnabledExtensionNames = (const char *const *)instanceExtensionsCopy;
         if (createDebug && VULKAN_ValidationLayersFound()) {
             instanceCreateInfo.ppEnabledLayerNames = validationLayerName;
@@ -1839,6 +2199,11 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         VULKAN_DeviceExtensionsFound(rendererData, 4, &deviceExtensionNames[1])) {
         rendererData->supportsKHRSamplerYCbCrConversion = true;
     }
+    if (rendererData->supportsKHRSamplerYCbCrConversion &&
+        rendererData->supportsKHRExternalMemoryCapabilities &&
+        VULKAN_DeviceExtensionsFound(rendererData, 6, &deviceExtensionNames[5])) {
+        rendererData->supportsEXTExternalMemoryDmaBuf = true;
+    }
 
     // Create Vulkan device
     rendererData->device = (VkDevice)SDL_GetPointerProperty(create_props, SDL_PROP_RENDERER_CREATE_VULKAN_DEVICE_POINTER, NULL);
@@ -1854,7 +2219,13 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         deviceCreateInfo.queueCreateInfoCount = 0;
         deviceCreateInfo.pQueueCreateInfos = deviceQueueCreateInfo;
         deviceCreateInfo.pEnabledFeatures = NULL;
-        deviceCreateInfo.enabledExtensionCount = (rendererData->supportsKHRSamplerYCbCrConversion) ? 5 : 1;
+        if (rendererData->supportsEXTExternalMemoryDmaBuf) {
+            deviceCreateInfo.enabledExtensionCount = 11;
+        } else if (rendererData->supportsKHRSamplerYCbCrConversion) {
+            deviceCreateInfo.enabledExtensionCount = 5;
+        } else {
+            deviceCreateInfo.enabledExtensionCount = 1;
+        }
         deviceCreateInfo.ppEnabledExtensionNames = deviceExtensionNames;
 
         deviceQueueCreateInfo[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
@@ -1944,6 +2315,8 @@ static VkResult VULKAN_CreateDeviceResources(SDL_Renderer *renderer, SDL_Propert
         return result;
     }
 
+    VULKAN_CreatePipelineCache(rendererData);
+
     // Create default vertex buffers
     for (uint32_t i = 0; i < SDL_VULKAN_NUM_VERTEX_BUFFERS; ++i) {
         VULKAN_CreateVertexBuffer(rendererData, i, SDL_VULKAN_VERTEX_BUFFER_DEFAULT_SIZE);
@@ -2396,6 +2769,7 @@ static VkResult VULKAN_CreateSwapChain(SDL_Renderer *renderer, int w, int h)
     }
 
     // Create renderpasses and framebuffer
+    VULKAN_WaitForPipelineWarmup(rendererData);
     for (uint32_t i = 0; i < SDL_arraysize(rendererData->renderPasses); i++) {
         if (rendererData->renderPasses[i] != VK_NULL_HANDLE) {
             vkDestroyRenderPass(rendererData->device, rendererData->renderPasses[i], NULL);
@@ -2610,7 +2984,10 @@ static bool VULKAN_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, S
         texture->format == SDL_PIXELFORMAT_IYUV ||
         texture->format == SDL_PIXELFORMAT_NV12 ||
         texture->format == SDL_PIXELFORMAT_NV21 ||
-        texture->format == SDL_PIXELFORMAT_P010) {
+        texture->format == SDL_PIXELFORMAT_P010 ||
+        texture->format == SDL_PIXELFORMAT_YUY2 ||
+        texture->format == SDL_PIXELFORMAT_UYVY ||
+        texture->format == SDL_PIXELFORMAT_YVYU) {
         const uint32_t YUV_SD_THRESHOLD = 576;
 
         // Check that we have VK_KHR_sampler_ycbcr_conversion support
@@ -2655,7 +3032,8 @@ static bool VULKAN_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, S
         samplerYcbcrConversionCreateInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
         samplerYcbcrConversionCreateInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
         if (texture->format == SDL_PIXELFORMAT_YV12 ||
-            texture->format == SDL_PIXELFORMAT_NV21) {
+            texture->format == SDL_PIXELFORMAT_NV21 ||
+            texture->format == SDL_PIXELFORMAT_YVYU) {
             samplerYcbcrConversionCreateInfo.components.r = VK_COMPONENT_SWIZZLE_B;
             samplerYcbcrConversionCreateInfo.components.b = VK_COMPONENT_SWIZZLE_R;
         }
@@ -2816,13 +3194,17 @@ static void VULKAN_DestroyTexture(SDL_Renderer *renderer,
 static bool VULKAN_UpdateTextureInternal(VULKAN_RenderData *rendererData, VkImage image, VkFormat format, int plane, int x, int y, int w, int h, const void *pixels, int pitch, VkImageLayout *imageLayout)
 {
     VkDeviceSize pixelSize = VULKAN_GetBytesPerPixel(format, plane);
-    VkDeviceSize length = w * pixelSize;
-    VkDeviceSize uploadBufferSize = length * h;
+    VkDeviceSize length;
     const Uint8 *src;
+    VkDeviceSize uploadBufferSize;
     Uint8 *dst;
     VkResult rc;
     int planeCount = VULKAN_VkFormatGetNumPlanes(format);
 
+    w = (int)VULKAN_GetCopyWidth(format, w);
+    length = w * pixelSize;
+    uploadBufferSize = length * h;
+
     VULKAN_EnsureCommandBuffer(rendererData);
 
     int currentUploadBufferIndex = rendererData->currentUploadBuffer[rendererData->currentCommandBufferIndex];
@@ -3024,7 +3406,7 @@ static bool VULKAN_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     }
 
     VkDeviceSize pixelSize = VULKAN_GetBytesPerPixel(textureData->mainImage.format, 0);
-    VkDeviceSize length = rect->w * pixelSize;
+    VkDeviceSize length = VULKAN_GetCopyWidth(textureData->mainImage.format, rect->w) * pixelSize;
     VkDeviceSize stagingBufferSize = length * rect->h;
     rc = VULKAN_AllocateBuffer(rendererData,
         stagingBufferSize,
@@ -3083,7 +3465,7 @@ static void VULKAN_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     region.imageOffset.x = textureData->lockedRect.x;
     region.imageOffset.y = textureData->lockedRect.y;
     region.imageOffset.z = 0;
-    region.imageExtent.width = textureData->lockedRect.w;
+    region.imageExtent.width = VULKAN_GetCopyWidth(textureData->mainImage.format, textureData->lockedRect.w);
     region.imageExtent.height = textureData->lockedRect.h;
     region.imageExtent.depth = 1;
     vkCmdCopyBufferToImage(rendererData->currentCommandBuffer, textureData->stagingBuffer.buffer, textureData->mainImage.image, textureData->mainImage.imageLayout, 1, &region);
@@ -3629,12 +4011,15 @@ static bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand
     VkDescriptorSet descriptorSet;
     VkBuffer constantBuffer;
     VkDeviceSize constantBufferOffset;
+    VkPipelineLayout previousPipelineLayout;
     int i;
 
     if (!VULKAN_ActivateCommandBuffer(renderer, VK_ATTACHMENT_LOAD_OP_LOAD, NULL, stateCache)) {
         return false;
     }
 
+    previousPipelineLayout = rendererData->currentPipelineState ? rendererData->currentPipelineState->pipelineLayout : VK_NULL_HANDLE;
+
     // See if we need to change the pipeline state
     if (!rendererData->currentPipelineState ||
         rendererData->currentPipelineState->shader != shader ||
@@ -3660,7 +4045,7 @@ static bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand
 
         // If we didn't find a match, create a new one -- it must mean the blend mode is non-standard
         if (!rendererData->currentPipelineState) {
-            rendererData->currentPipelineState = VULKAN_CreatePipelineState(renderer, shader, pipelineLayout, descriptorSetLayout, blendMode, topology, format);
+            rendererData->currentPipelineState = VULKAN_CreatePipelineState(renderer, shader, pipelineLayout, descriptorSetLayout, blendMode, topology, format, rendererData->currentRenderPass);
         }
 
         if (!rendererData->currentPipelineState) {
@@ -3668,7 +4053,11 @@ static bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand
         }
 
         vkCmdBindPipeline(rendererData->currentCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, rendererData->currentPipelineState->pipeline);
-        updateConstants = true;
+
+        // Push constants survive pipeline changes with the same layout
+        if (rendererData->currentPipelineState->pipelineLayout != previousPipelineLayout) {
+            updateConstants = true;
+        }
     }
 
     if (rendererData->viewportDirty) {
@@ -3694,10 +4083,13 @@ static bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand
         shader_constants = &solid_constants;
     }
 
+    /* The constants at the current offset are shared by every pipeline, so only
+     * upload new ones when they actually change, or at the start of a frame.
+     */
     constantBuffer = rendererData->constantBuffers[rendererData->currentCommandBufferIndex][rendererData->currentConstantBufferIndex].buffer;
     constantBufferOffset = (rendererData->currentConstantBufferOffset < 0) ? 0 : rendererData->currentConstantBufferOffset;
-    if (updateConstants ||
-        SDL_memcmp(shader_constants, &rendererData->currentPipelineState->shader_constants, sizeof(*shader_constants)) != 0) {
+    if (rendererData->currentConstantBufferOffset == -1 ||
+        SDL_memcmp(shader_constants, &rendererData->currentConstants, sizeof(*shader_constants)) != 0) {
 
         if (rendererData->currentConstantBufferOffset == -1) {
             // First time, grab offset 0
@@ -3742,11 +4134,12 @@ static bool VULKAN_SetDrawState(SDL_Renderer *renderer, const SDL_RenderCommand
         }
 
         SDL_memcpy(&rendererData->currentPipelineState->shader_constants, shader_constants, sizeof(*shader_constants));
+        SDL_memcpy(&rendererData->currentConstants, shader_constants, sizeof(*shader_constants));
 
         // Upload constants to persistently mapped buffer
         uint8_t *dst = (uint8_t *)rendererData->constantBuffers[rendererData->currentCommandBufferIndex][rendererData->currentConstantBufferIndex].mappedBufferPtr;
         dst += constantBufferOffset;
-        SDL_memcpy(dst, &rendererData->currentPipelineState->shader_constants, sizeof(VULKAN_PixelShaderConstants));
+        SDL_memcpy(dst, &rendererData->currentConstants, sizeof(VULKAN_PixelShaderConstants));
     }
 
     // Allocate/update descriptor set with the bindings
@@ -4250,6 +4643,27 @@ static bool VULKAN_SetVSync(SDL_Renderer *renderer, const int vsync)
     return true;
 }
 
+#ifdef SDL_HAVE_YUV
+// Check that a format for YUV textures can be sampled through the Ycbcr conversion we create for it
+static bool VULKAN_SupportsYcbcrFormat(VULKAN_RenderData *rendererData, VkFormat format)
+{
+    const VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT |
+                                          VK_FORMAT_FEATURE_TRANSFER_DST_BIT_KHR |
+                                          VK_FORMAT_FEATURE_MIDPOINT_CHROMA_SAMPLES_BIT_KHR |
+                                          VK_FORMAT_FEATURE_COSITED_CHROMA_SAMPLES_BIT_KHR |
+                                          VK_FORMAT_FEATURE_SAMPLED_IMAGE_YCBCR_CONVERSION_LINEAR_FILTER_BIT_KHR;
+    VkFormatProperties2KHR formatProperties = { 0 };
+
+    if (!vkGetPhysicalDeviceFormatProperties2KHR) {
+        return false;
+    }
+
+    formatProperties.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2_KHR;
+    vkGetPhysicalDeviceFormatProperties2KHR(rendererData->physicalDevice, format, &formatProperties);
+    return (formatProperties.formatProperties.optimalTilingFeatures & required) == required;
+}
+#endif
+
 static bool VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_PropertiesID create_props)
 {
     VULKAN_RenderData *rendererData;
@@ -4328,6 +4742,8 @@ static bool VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SD
         return false;
     }
 
+    VULKAN_WarmupPipelineStates(renderer);
+
 #ifdef SDL_HAVE_YUV
     if (rendererData->supportsKHRSamplerYCbCrConversion) {
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YV12);
@@ -4335,6 +4751,13 @@ static bool VULKAN_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SD
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV12);
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV21);
         SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_P010);
+        if (VULKAN_SupportsYcbcrFormat(rendererData, VK_FORMAT_G8B8G8R8_422_UNORM)) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YUY2);
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YVYU);
+        }
+        if (VULKAN_SupportsYcbcrFormat(rendererData, VK_FORMAT_B8G8R8G8_422_UNORM)) {
+            SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_UYVY);
+        }
     }
 #endif
 
@@ -55,6 +55,7 @@ SDL_Mutex *SDL_sensor_lock = NULL; // This needs to support recursive locks
 static SDL_AtomicInt SDL_sensor_lock_pending;
 static int SDL_sensors_locked;
 static bool SDL_sensors_initialized;
+static Uint64 SDL_sensor_activity_ns;
 static SDL_Sensor *SDL_sensors SDL_GUARDED_BY(SDL_sensor_lock) = NULL;
 
 #define CHECK_SENSOR_MAGIC(sensor, result)                  \
@@ -154,6 +155,11 @@ bool SDL_InitSensors(void)
     return status;
 }
 
+Uint64 SDL_GetSensorActivityTime(void)
+{
+    return SDL_sensor_activity_ns;
+}
+
 bool SDL_SensorsOpened(void)
 {
     bool opened;
@@ -486,6 +492,108 @@ bool SDL_GetSensorData(SDL_Sensor *sensor, float *data, int num_values)
     return true;
 }
 
+SDL_SensorSampleBuffer *SDL_CreateSensorSampleBuffer(int num_values)
+{
+    SDL_SensorSampleBuffer *buffer;
+    size_t size = sizeof(*buffer) + (SDL_SENSOR_SAMPLE_BUFFER_SIZE * num_values - 1) * sizeof(float);
+
+    buffer = (SDL_SensorSampleBuffer *)SDL_malloc(size);
+    if (!buffer) {
+        return NULL;
+    }
+    buffer->num_values = num_values;
+    buffer->head = 0;
+    buffer->count = 0;
+    return buffer;
+}
+
+void SDL_AddSensorSample(SDL_SensorSampleBuffer *buffer, Uint64 sensor_timestamp, const float *data, int num_values)
+{
+    int index;
+    float *sample;
+
+    if (buffer->count == SDL_SENSOR_SAMPLE_BUFFER_SIZE) {
+        // The buffer is full, drop the oldest sample
+        buffer->head = (buffer->head + 1) % SDL_SENSOR_SAMPLE_BUFFER_SIZE;
+        --buffer->count;
+    }
+
+    index = (buffer->head + buffer->count) % SDL_SENSOR_SAMPLE_BUFFER_SIZE;
+    sample = &buffer->data[index * buffer->num_values];
+    num_values = SDL_min(num_values, buffer->num_values);
+    SDL_memcpy(sample, data, num_values * sizeof(*data));
+    if (num_values < buffer->num_values) {
+        SDL_memset(&sample[num_values], 0, (buffer->num_values - num_values) * sizeof(*data));
+    }
+    buffer->timestamps[index] = sensor_timestamp;
+    ++buffer->count;
+}
+
+int SDL_ReadSensorSamples(SDL_SensorSampleBuffer *buffer, float *data, int num_values, Uint64 *timestamps, int max_samples)
+{
+    int i, count;
+    int copy_values = SDL_min(num_values, buffer->num_values);
+
+    count = SDL_min(max_samples, buffer->count);
+    for (i = 0; i < count; ++i) {
+        const int index = (buffer->head + i) % SDL_SENSOR_SAMPLE_BUFFER_SIZE;
+        float *sample = &data[i * num_values];
+
+        SDL_memcpy(sample, &buffer->data[index * buffer->num_values], copy_values * sizeof(*data));
+        if (copy_values < num_values) {
+            SDL_memset(&sample[copy_values], 0, (num_values - copy_values) * sizeof(*data));
+        }
+        if (timestamps) {
+            timestamps[i] = buffer->timestamps[index];
+        }
+    }
+    buffer->head = (buffer->head + count) % SDL_SENSOR_SAMPLE_BUFFER_SIZE;
+    buffer->count -= count;
+
+    return count;
+}
+
+void SDL_DestroySensorSampleBuffer(SDL_SensorSampleBuffer *buffer)
+{
+    SDL_free(buffer);
+}
+
+int SDL_GetSensorSamples(SDL_Sensor *sensor, float *data, int num_values, Uint64 *timestamps, int max_samples)
+{
+    int result;
+
+    if (!data) {
+        SDL_InvalidParamError("data");
+        return -1;
+    }
+    if (num_values <= 0) {
+        SDL_InvalidParamError("num_values");
+        return -1;
+    }
+    if (max_samples < 0) {
+        SDL_InvalidParamError("max_samples");
+        return -1;
+    }
+
+    SDL_LockSensors();
+    {
+        CHECK_SENSOR_MAGIC(sensor, -1);
+
+        if (!sensor->samples) {
+            // Start collecting samples, they'll be available on the next call
+            sensor->samples = SDL_CreateSensorSampleBuffer(SDL_arraysize(sensor->data));
+            if (!sensor->samples) {
+                SDL_UnlockSensors();
+                return -1;
+            }
+        }
+        result = SDL_ReadSensorSamples(sensor->samples, data, num_values, timestamps, max_samples);
+    }
+    SDL_UnlockSensors();
+
+    return result;
+}
+
 /*
  * Close a sensor previously opened with SDL_OpenSensor()
  */
@@ -527,6 +635,7 @@ void SDL_CloseSensor(SDL_Sensor *sensor)
         }
 
         // Free the data associated with this sensor
+        SDL_DestroySensorSampleBuffer(sensor->samples);
         SDL_free(sensor->name);
         SDL_free(sensor);
     }
@@ -568,6 +677,11 @@ void SDL_SendSensorUpdate(Uint64 timestamp, SDL_Sensor *sensor, Uint64 sensor_ti
     // Update internal sensor state
     num_values = SDL_min(num_values, SDL_arraysize(sensor->data));
     SDL_memcpy(sensor->data, data, num_values * sizeof(*data));
+    SDL_sensor_activity_ns = timestamp ? timestamp : SDL_GetTicksNS();
+
+    if (sensor->samples) {
+        SDL_AddSensorSample(sensor->samples, sensor_timestamp, data, num_values);
+    }
 
     // Post the event, if desired
     if (SDL_EventEnabled(SDL_EVENT_SENSOR_UPDATE)) {
@@ -29,6 +29,19 @@ extern SDL_Mutex *SDL_sensor_lock;
 
 struct SDL_SensorDriver;
 
+// The number of samples kept for batched sensor reads
+#define SDL_SENSOR_SAMPLE_BUFFER_SIZE 512
+
+// A ring buffer of sensor samples, used by SDL_GetSensorSamples() and SDL_GetGamepadSensorSamples()
+typedef struct SDL_SensorSampleBuffer
+{
+    int num_values;     // the number of values stored for each sample
+    int head;           // the index of the oldest sample
+    int count;          // the number of samples available
+    Uint64 timestamps[SDL_SENSOR_SAMPLE_BUFFER_SIZE];
+    float data[1];      // SDL_SENSOR_SAMPLE_BUFFER_SIZE * num_values, allocated with the buffer
+} SDL_SensorSampleBuffer;
+
 // Useful functions and variables from SDL_sensor.c
 
 // Initialization and shutdown functions
@@ -50,9 +63,18 @@ extern void SDL_UnlockSensors(void) SDL_RELEASE(SDL_sensor_lock);
 // Function to return whether there are any sensors opened by the application
 extern bool SDL_SensorsOpened(void);
 
+// Return the time of the most recent sensor update, in nanoseconds
+extern Uint64 SDL_GetSensorActivityTime(void);
+
 // Update an individual sensor, used by gamepad sensor fusion
 extern void SDL_UpdateSensor(SDL_Sensor *sensor);
 
+// Sample buffer functions, the caller is responsible for locking
+extern SDL_SensorSampleBuffer *SDL_CreateSensorSampleBuffer(int num_values);
+extern void SDL_AddSensorSample(SDL_SensorSampleBuffer *buffer, Uint64 sensor_timestamp, const float *data, int num_values);
+extern int SDL_ReadSensorSamples(SDL_SensorSampleBuffer *buffer, float *data, int num_values, Uint64 *timestamps, int max_samples);
+extern void SDL_DestroySensorSampleBuffer(SDL_SensorSampleBuffer *buffer);
+
 // Internal event queueing functions
 extern void SDL_SendSensorUpdate(Uint64 timestamp, SDL_Sensor *sensor, Uint64 sensor_timestamp, float *data, int num_values);
 
@@ -39,6 +39,8 @@ struct SDL_Sensor
 
     float data[16] _guarded;             // The current state of the sensor
 
+    SDL_SensorSampleBuffer *samples _guarded; // Recent samples, created by SDL_GetSensorSamples()
+
     struct SDL_SensorDriver *driver _guarded;
 
     struct sensor_hwdata *hwdata _guarded; // Driver dependent information
@@ -158,6 +158,92 @@ static struct
 /* *INDENT-ON* */ // clang-format on
 };
 
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ICONV_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define ICONV_NEON
+#endif
+
+static size_t GetEncodingUnitSize(int format)
+{
+    switch (format) {
+    case ENCODING_UTF16:
+    case ENCODING_UTF16BE:
+    case ENCODING_UTF16LE:
+    case ENCODING_UCS2BE:
+    case ENCODING_UCS2LE:
+        return 2;
+    case ENCODING_UTF32:
+    case ENCODING_UTF32BE:
+    case ENCODING_UTF32LE:
+    case ENCODING_UCS4BE:
+    case ENCODING_UCS4LE:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+/* Converts the run of ASCII characters at the start of a UTF-8 string straight
+   to little endian UTF-16 or UTF-32, `unit` bytes per character, skipping the
+   general decoder. Returns the number of characters converted. */
+static size_t ConvertASCIIRun(const Uint8 *src, size_t srclen, Uint8 *dst, size_t dstlen, size_t unit)
+{
+    const size_t len = SDL_min(srclen, dstlen / unit);
+    size_t i = 0;
+
+#if defined(ICONV_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    while ((len - i) >= 16) {
+        const __m128i chars = _mm_loadu_si128((const __m128i *)(src + i));
+        if (_mm_movemask_epi8(chars) != 0) {
+            break;  // finish the ASCII part of this chunk below
+        }
+        const __m128i lo = _mm_unpacklo_epi8(chars, zero);
+        const __m128i hi = _mm_unpackhi_epi8(chars, zero);
+        if (unit == 2) {
+            _mm_storeu_si128((__m128i *)dst, lo);
+            _mm_storeu_si128((__m128i *)(dst + 16), hi);
+        } else {
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + 16), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + 32), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i *)(dst + 48), _mm_unpackhi_epi16(hi, zero));
+        }
+        dst += 16 * unit;
+        i += 16;
+    }
+#elif defined(ICONV_NEON)
+    while ((len - i) >= 16) {
+        const uint8x16_t chars = vld1q_u8(src + i);
+        if (vmaxvq_u8(chars) >= 0x80) {
+            break;  // finish the ASCII part of this chunk below
+        }
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(chars));
+        const uint16x8_t hi = vmovl_u8(vget_high_u8(chars));
+        if (unit == 2) {
+            vst1q_u8(dst, vreinterpretq_u8_u16(lo));
+            vst1q_u8(dst + 16, vreinterpretq_u8_u16(hi));
+        } else {
+            vst1q_u8(dst, vreinterpretq_u8_u32(vmovl_u16(vget_low_u16(lo))));
+            vst1q_u8(dst + 16, vreinterpretq_u8_u32(vmovl_u16(vget_high_u16(lo))));
+            vst1q_u8(dst + 32, vreinterpretq_u8_u32(vmovl_u16(vget_low_u16(hi))));
+            vst1q_u8(dst + 48, vreinterpretq_u8_u32(vmovl_u16(vget_high_u16(hi))));
+        }
+        dst += 16 * unit;
+        i += 16;
+    }
+#endif
+
+    while (i < len && src[i] < 0x80) {
+        SDL_memset(dst, 0, unit);
+        dst[0] = src[i];
+        dst += unit;
+        ++i;
+    }
+    return i;
+}
+
 static const char *getlocale(char *buffer, size_t bufsize)
 {
     const char *lang;
@@ -329,8 +415,30 @@ size_t SDL_iconv(SDL_iconv_t cd,
         break;
     }
 
+    const bool ascii_fast_path = (cd->src_fmt == ENCODING_UTF8 &&
+                                  (cd->dst_fmt == ENCODING_UTF16LE ||
+                                   cd->dst_fmt == ENCODING_UTF32LE ||
+                                   cd->dst_fmt == ENCODING_UCS4LE));
+
     total = 0;
     while (srclen > 0) {
+        if (ascii_fast_path) {
+            const size_t converted = ConvertASCIIRun((const Uint8 *)src, srclen, (Uint8 *)dst, dstlen, GetEncodingUnitSize(cd->dst_fmt));
+            if (converted > 0) {
+                const size_t written = converted * GetEncodingUnitSize(cd->dst_fmt);
+                src += converted;
+                srclen -= converted;
+                dst += written;
+                dstlen -= written;
+                *inbuf = src;
+                *inbytesleft = srclen;
+                *outbuf = dst;
+                *outbytesleft = dstlen;
+                total += converted;
+                continue;
+            }
+        }
+
         // Decode a character
         switch (cd->src_fmt) {
         case ENCODING_ASCII:
@@ -785,6 +893,46 @@ int SDL_iconv_close(SDL_iconv_t cd)
     return 0;
 }
 
+/* Returns the most bytes converting `inbytes` bytes could produce, or 0 if we
+   can't tell. Each input unit yields at most one character, so this is the
+   worst case of the output size of a character over the input size it takes. */
+static size_t GetMaxConvertedSize(SDL_iconv_t cd, size_t inbytes)
+{
+    const size_t src_unit = GetEncodingUnitSize(cd->src_fmt);
+    size_t numerator, denominator = 1;
+
+    switch (cd->dst_fmt) {
+    case ENCODING_ASCII:
+    case ENCODING_LATIN1:
+        numerator = 1;
+        break;
+    case ENCODING_UTF8:
+        if (cd->src_fmt == ENCODING_ASCII) {
+            numerator = 1;
+        } else if (cd->src_fmt == ENCODING_LATIN1) {
+            numerator = 2;
+        } else if (src_unit == 1) {
+            numerator = 3;  // an invalid byte becomes a 3 byte replacement character
+        } else if (src_unit == 2) {
+            numerator = 3;  // the rest of the BMP takes 3 bytes
+            denominator = 2;
+        } else {
+            numerator = 1;
+        }
+        break;
+    default:
+        // Characters that don't fit in one UTF-16 unit take 4 bytes of input in any encoding
+        numerator = SDL_max(GetEncodingUnitSize(cd->dst_fmt) / src_unit, 1);
+        break;
+    }
+
+    if (inbytes > (SIZE_MAX - 4) / numerator) {
+        return 0;
+    }
+    // Leave room for a byte order marker
+    return ((inbytes * numerator) + denominator - 1) / denominator + 4;
+}
+
 #endif // !HAVE_ICONV
 
 char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft)
@@ -807,7 +955,15 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
         return NULL;
     }
 
+#if defined(HAVE_ICONV) && defined(HAVE_ICONV_H)
     stringsize = inbytesleft;
+#else
+    // Allocate the worst case up front instead of finding it out by growing the buffer
+    stringsize = GetMaxConvertedSize(cd, inbytesleft);
+    if (stringsize == 0) {
+        stringsize = inbytesleft;
+    }
+#endif
     string = (char *)SDL_malloc(stringsize + sizeof(Uint32));
     if (!string) {
         SDL_iconv_close(cd);
@@ -856,5 +1012,15 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     SDL_memset(outbuf, 0, sizeof(Uint32));
     SDL_iconv_close(cd);
 
+    // Give back the space we didn't need if the worst case estimate was way off
+    {
+        const size_t used = (size_t)(outbuf - string) + sizeof(Uint32);
+        if (used < stringsize / 2) {
+            char *shrunk = (char *)SDL_realloc(string, used);
+            if (shrunk) {
+                string = shrunk;
+            }
+        }
+    }
     return string;
 }
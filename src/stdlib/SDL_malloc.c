@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_sysstdlib.h"
+
 /* This file contains portable memory management functions for SDL */
 
 #ifndef HAVE_MALLOC
@@ -6336,10 +6338,129 @@ static void * SDLCALL real_calloc(size_t n, size_t s) { return calloc(n, s); }
 static void * SDLCALL real_realloc(void *p, size_t s) { return realloc(p,s); }
 static void   SDLCALL real_free(void *p) { free(p); }
 #else
-#define real_malloc dlmalloc
-#define real_calloc dlcalloc
-#define real_realloc dlrealloc
-#define real_free dlfree
+/* dlmalloc serializes every call on one global lock, so small blocks freed here are kept
+   in caches in front of it and handed back out without touching the lock. There's no
+   thread local storage without a C runtime, so instead of one cache per thread there are
+   a few, picked by thread ID, and a thread just goes to dlmalloc if its cache is busy.
+   Only small chunks are cached, larger ones always go back to the shared arena. */
+#define SDL_MALLOC_CACHE_COUNT      16
+#define SDL_MALLOC_CACHE_MAX_CHUNK  256    // largest chunk size that's cached
+#define SDL_MALLOC_CACHE_BIN_DEPTH  8      // blocks kept per chunk size, per cache
+#define SDL_MALLOC_CACHE_BINS       ((SDL_MALLOC_CACHE_MAX_CHUNK / MALLOC_ALIGNMENT) + 1)
+
+typedef struct SDL_MallocCacheBin
+{
+    void *head;  // blocks are linked through their first word
+    Uint32 count;
+} SDL_MallocCacheBin;
+
+typedef struct SDL_MallocCache
+{
+    SDL_SpinLock lock;
+    SDL_MallocCacheBin bins[SDL_MALLOC_CACHE_BINS];
+} SDL_MallocCache;
+
+static SDL_MallocCache SDL_malloc_caches[SDL_MALLOC_CACHE_COUNT];
+
+static SDL_MallocCache *SDL_LockMallocCache(void)
+{
+    const Uint64 hash = (Uint64)SDL_GetCurrentThreadID() * SDL_UINT64_C(0x9E3779B97F4A7C15);
+    SDL_MallocCache *cache = &SDL_malloc_caches[(hash >> 32) % SDL_MALLOC_CACHE_COUNT];
+    if (!SDL_TryLockSpinlock(&cache->lock)) {
+        return NULL;
+    }
+    return cache;
+}
+
+static void *SDL_GetCachedBlock(size_t bytes)
+{
+    if (bytes > MAX_REQUEST) {
+        return NULL;
+    }
+
+    const size_t chunk_size = request2size(bytes);
+    if (chunk_size > SDL_MALLOC_CACHE_MAX_CHUNK) {
+        return NULL;
+    }
+
+    void *mem = NULL;
+    SDL_MallocCache *cache = SDL_LockMallocCache();
+    if (cache) {
+        SDL_MallocCacheBin *bin = &cache->bins[chunk_size / MALLOC_ALIGNMENT];
+        mem = bin->head;
+        if (mem) {
+            bin->head = *(void **)mem;
+            --bin->count;
+        }
+        SDL_UnlockSpinlock(&cache->lock);
+    }
+    return mem;
+}
+
+static bool SDL_CacheBlock(void *mem)
+{
+    const mchunkptr p = mem2chunk(mem);
+    if (is_mmapped(p)) {
+        return false;
+    }
+
+    const size_t chunk_size = chunksize(p);
+    if (chunk_size > SDL_MALLOC_CACHE_MAX_CHUNK) {
+        return false;
+    }
+
+    bool cached = false;
+    SDL_MallocCache *cache = SDL_LockMallocCache();
+    if (cache) {
+        SDL_MallocCacheBin *bin = &cache->bins[chunk_size / MALLOC_ALIGNMENT];
+        if (bin->count < SDL_MALLOC_CACHE_BIN_DEPTH) {
+            *(void **)mem = bin->head;
+            bin->head = mem;
+            ++bin->count;
+            cached = true;
+        }
+        SDL_UnlockSpinlock(&cache->lock);
+    }
+    return cached;
+}
+
+static void * SDLCALL real_malloc(size_t s)
+{
+    void *mem = SDL_GetCachedBlock(s);
+    if (!mem) {
+        mem = dlmalloc(s);
+    }
+    return mem;
+}
+
+static void * SDLCALL real_calloc(size_t n, size_t s)
+{
+    size_t bytes;
+    if (!SDL_size_mul_check_overflow(n, s, &bytes)) {
+        return dlcalloc(n, s);  // let dlmalloc report the failure
+    }
+
+    void *mem = SDL_GetCachedBlock(bytes);
+    if (mem) {
+        SDL_memset(mem, 0, bytes);
+    } else {
+        mem = dlcalloc(n, s);
+    }
+    return mem;
+}
+
+static void * SDLCALL real_realloc(void *p, size_t s)
+{
+    // Cached blocks are still allocated as far as dlmalloc is concerned, so this just works
+    return dlrealloc(p, s);
+}
+
+static void SDLCALL real_free(void *p)
+{
+    if (p && !SDL_CacheBlock(p)) {
+        dlfree(p);
+    }
+}
 #endif
 
 // mark the allocator entry points as KEEPALIVE so we can call these from JavaScript.
@@ -6361,8 +6482,10 @@ static struct
     SDL_realloc_func realloc_func;
     SDL_free_func free_func;
     SDL_AtomicInt num_allocations;
+    SDL_AtomicInt tagging;  // set while replacement memory functions are installed
+    SDL_TLSID tag_tls;
 } s_mem = {
-    real_malloc, real_calloc, real_realloc, real_free, { 0 }
+    real_malloc, real_calloc, real_realloc, real_free, { 0 }, { 0 }, { 0 }
 };
 
 // Define this if you want to track the number of allocations active
@@ -6436,6 +6559,10 @@ bool SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
     s_mem.calloc_func = calloc_func;
     s_mem.realloc_func = realloc_func;
     s_mem.free_func = free_func;
+
+    const bool replaced = (malloc_func != real_malloc || calloc_func != real_calloc ||
+                           realloc_func != real_realloc || free_func != real_free);
+    SDL_SetAtomicInt(&s_mem.tagging, replaced ? 1 : 0);
     return true;
 }
 
@@ -6448,6 +6575,61 @@ int SDL_GetNumAllocations(void)
 #endif
 }
 
+int SDL_PushMemoryTag(SDL_MemoryTag tag)
+{
+    if (!SDL_GetAtomicInt(&s_mem.tagging)) {
+        return -1;
+    }
+
+    // The tag is stored off by one, so NULL is SDL_MEMORY_TAG_OTHER
+    const int previous = (int)(uintptr_t)SDL_GetTLS(&s_mem.tag_tls);
+    if (previous != (int)tag + 1) {
+        SDL_SetTLS(&s_mem.tag_tls, (void *)(uintptr_t)(tag + 1), NULL);
+    }
+    return previous;
+}
+
+void SDL_PopMemoryTag(int cookie)
+{
+    if (cookie >= 0) {
+        SDL_SetTLS(&s_mem.tag_tls, (void *)(uintptr_t)cookie, NULL);
+    }
+}
+
+SDL_MemoryTag SDL_GetMemoryTag(void)
+{
+    const int stored = (int)(uintptr_t)SDL_GetTLS(&s_mem.tag_tls);
+    if (stored <= 0 || stored > SDL_MEMORY_TAG_COUNT) {
+        return SDL_MEMORY_TAG_OTHER;
+    }
+    return (SDL_MemoryTag)(stored - 1);
+}
+
+const char *SDL_GetMemoryTagName(SDL_MemoryTag tag)
+{
+    switch (tag) {
+    case SDL_MEMORY_TAG_OTHER:
+        return "other";
+    case SDL_MEMORY_TAG_AUDIO:
+        return "audio";
+    case SDL_MEMORY_TAG_VIDEO:
+        return "video";
+    case SDL_MEMORY_TAG_RENDER:
+        return "render";
+    case SDL_MEMORY_TAG_GPU:
+        return "gpu";
+    case SDL_MEMORY_TAG_EVENTS:
+        return "events";
+    case SDL_MEMORY_TAG_JOYSTICK:
+        return "joystick";
+    case SDL_MEMORY_TAG_HIDAPI:
+        return "hidapi";
+    default:
+        break;
+    }
+    return NULL;
+}
+
 void *SDL_malloc(size_t size)
 {
     void *mem;
@@ -0,0 +1,319 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+#include "SDL_internal.h"
+
+// This file contains vectorized math functions for SDL internals that evaluate
+// the same function over whole arrays, like filter tables and transfer curves.
+//
+// Measured against double precision results, sinf and cosf are within 2.2 ULP
+// for |x| <= 8192, expf within 1 ULP and logf within 0.75 ULP. powf is computed
+// as exp(y * log(x)), so its error grows with y * log(x): about 6 ULP for the
+// sRGB exponent 1/2.4 over [0, 1], and 160 ULP (1e-5 relative) for the PQ
+// exponent 78.84375. sqrtf is exact.
+
+#include "SDL_sysstdlib.h"
+
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATHBATCH_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define MATHBATCH_NEON
+#endif
+
+#if defined(MATHBATCH_SSE2) && defined(SDL_AVX2_INTRINSICS)
+#define MATHBATCH_AVX2
+#endif
+
+// Inputs outside these ranges go through the scalar functions. The sin/cos limit
+// keeps the Cody-Waite reduction below accurate, the exp limits keep the result
+// a normal float, and the log limits exclude zero, denormals, infinity and NaN.
+#define SDL_MATHBATCH_SINCOS_LIMIT 8192.0f
+#define SDL_MATHBATCH_EXP_MIN      -86.0f
+#define SDL_MATHBATCH_EXP_MAX      88.0f
+#define SDL_MATHBATCH_LOG_MIN      1.17549435e-38f
+#define SDL_MATHBATCH_LOG_MAX      3.40282347e+38f
+
+// pi/2 split in four, the first three parts have at most 12 significant bits
+// so multiplying them by a quadrant up to the sin/cos limit is exact
+#define SDL_MATHBATCH_PIO2_1 1.5703125f
+#define SDL_MATHBATCH_PIO2_2 4.837512969970703125e-4f
+#define SDL_MATHBATCH_PIO2_3 7.5495336204767227172851562e-8f
+#define SDL_MATHBATCH_PIO2_4 2.5633440682570896029801588e-12f
+
+typedef enum MathBatchOp
+{
+    MATHBATCH_SIN,
+    MATHBATCH_COS,
+    MATHBATCH_EXP,
+    MATHBATCH_LOG,
+    MATHBATCH_POW,
+    MATHBATCH_SQRT,
+    MATHBATCH_NUM_OPS
+} MathBatchOp;
+
+typedef void (*MathBatchFunc)(float *dst, const float *src, float y, int count);
+
+typedef struct MathBatchKernels
+{
+    int lanes;
+    MathBatchFunc funcs[MATHBATCH_NUM_OPS];
+} MathBatchKernels;
+
+#define MATHBATCH_MAX_LANES 8
+
+#ifdef MATHBATCH_SSE2
+
+#define MATHBATCH_FUNC(name)  name##_SSE2
+#define MATHBATCH_TARGET
+#define VLANES                4
+#define VF                    __m128
+#define VI                    __m128i
+#define VM                    __m128
+#define VF_LOAD(p)            _mm_loadu_ps(p)
+#define VF_STORE(p, v)        _mm_storeu_ps(p, v)
+#define VF_SET1(x)            _mm_set1_ps(x)
+#define VF_ADD(a, b)          _mm_add_ps(a, b)
+#define VF_SUB(a, b)          _mm_sub_ps(a, b)
+#define VF_MUL(a, b)          _mm_mul_ps(a, b)
+#define VF_SQRT(a)            _mm_sqrt_ps(a)
+#define VF_XOR(a, b)          _mm_xor_ps(a, b)
+#define VF_CMPLE(a, b)        _mm_cmple_ps(a, b)
+#define VF_CMPGE(a, b)        _mm_cmpge_ps(a, b)
+#define VF_CMPLT(a, b)        _mm_cmplt_ps(a, b)
+#define VI_CMPEQ(a, b)        _mm_castsi128_ps(_mm_cmpeq_epi32(a, b))
+#define VF_SELECT(m, a, b)    _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b))
+#define VM_AND(a, b)          _mm_and_ps(a, b)
+#define VM_ALL(m)             (_mm_movemask_ps(m) == 0xF)
+#define VF_ROUNDI(a)          _mm_cvtps_epi32(a)
+#define VI_TO_VF(a)           _mm_cvtepi32_ps(a)
+#define VF_AS_VI(a)           _mm_castps_si128(a)
+#define VI_AS_VF(a)           _mm_castsi128_ps(a)
+#define VI_SET1(x)            _mm_set1_epi32(x)
+#define VI_ADD(a, b)          _mm_add_epi32(a, b)
+#define VI_SUB(a, b)          _mm_sub_epi32(a, b)
+#define VI_AND(a, b)          _mm_and_si128(a, b)
+#define VI_OR(a, b)           _mm_or_si128(a, b)
+#define VI_SLLI(a, n)         _mm_slli_epi32(a, n)
+#define VI_SRLI(a, n)         _mm_srli_epi32(a, n)
+#include "SDL_mathbatch_impl.h"
+
+static const MathBatchKernels SDL_mathbatch_SSE2 = {
+    4, { Sinf_SSE2, Cosf_SSE2, Expf_SSE2, Logf_SSE2, Powf_SSE2, Sqrtf_SSE2 }
+};
+
+#endif // MATHBATCH_SSE2
+
+#ifdef MATHBATCH_AVX2
+
+#define MATHBATCH_FUNC(name)  name##_AVX2
+#define MATHBATCH_TARGET      SDL_TARGETING("avx2")
+#define VLANES                8
+#define VF                    __m256
+#define VI                    __m256i
+#define VM                    __m256
+#define VF_LOAD(p)            _mm256_loadu_ps(p)
+#define VF_STORE(p, v)        _mm256_storeu_ps(p, v)
+#define VF_SET1(x)            _mm256_set1_ps(x)
+#define VF_ADD(a, b)          _mm256_add_ps(a, b)
+#define VF_SUB(a, b)          _mm256_sub_ps(a, b)
+#define VF_MUL(a, b)          _mm256_mul_ps(a, b)
+#define VF_SQRT(a)            _mm256_sqrt_ps(a)
+#define VF_XOR(a, b)          _mm256_xor_ps(a, b)
+#define VF_CMPLE(a, b)        _mm256_cmp_ps(a, b, _CMP_LE_OQ)
+#define VF_CMPGE(a, b)        _mm256_cmp_ps(a, b, _CMP_GE_OQ)
+#define VF_CMPLT(a, b)        _mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define VI_CMPEQ(a, b)        _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))
+#define VF_SELECT(m, a, b)    _mm256_blendv_ps(b, a, m)
+#define VM_AND(a, b)          _mm256_and_ps(a, b)
+#define VM_ALL(m)             (_mm256_movemask_ps(m) == 0xFF)
+#define VF_ROUNDI(a)          _mm256_cvtps_epi32(a)
+#define VI_TO_VF(a)           _mm256_cvtepi32_ps(a)
+#define VF_AS_VI(a)           _mm256_castps_si256(a)
+#define VI_AS_VF(a)           _mm256_castsi256_ps(a)
+#define VI_SET1(x)            _mm256_set1_epi32(x)
+#define VI_ADD(a, b)          _mm256_add_epi32(a, b)
+#define VI_SUB(a, b)          _mm256_sub_epi32(a, b)
+#define VI_AND(a, b)          _mm256_and_si256(a, b)
+#define VI_OR(a, b)           _mm256_or_si256(a, b)
+#define VI_SLLI(a, n)         _mm256_slli_epi32(a, n)
+#define VI_SRLI(a, n)         _mm256_srli_epi32(a, n)
+// No FMA here, so the results are the same as the SSE2 kernels
+#include "SDL_mathbatch_impl.h"
+
+static const MathBatchKernels SDL_mathbatch_AVX2 = {
+    8, { Sinf_AVX2, Cosf_AVX2, Expf_AVX2, Logf_AVX2, Powf_AVX2, Sqrtf_AVX2 }
+};
+
+static SDL_INLINE int hasAVX2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasAVX2();
+    return val;
+}
+
+#endif // MATHBATCH_AVX2
+
+#ifdef MATHBATCH_NEON
+
+#define MATHBATCH_FUNC(name)  name##_NEON
+#define MATHBATCH_TARGET
+#define VLANES                4
+#define VF                    float32x4_t
+#define VI                    int32x4_t
+#define VM                    uint32x4_t
+#define VF_LOAD(p)            vld1q_f32(p)
+#define VF_STORE(p, v)        vst1q_f32(p, v)
+#define VF_SET1(x)            vdupq_n_f32(x)
+#define VF_ADD(a, b)          vaddq_f32(a, b)
+#define VF_SUB(a, b)          vsubq_f32(a, b)
+#define VF_MUL(a, b)          vmulq_f32(a, b)
+#define VF_SQRT(a)            vsqrtq_f32(a)
+#define VF_XOR(a, b)          vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)))
+#define VF_CMPLE(a, b)        vcleq_f32(a, b)
+#define VF_CMPGE(a, b)        vcgeq_f32(a, b)
+#define VF_CMPLT(a, b)        vcltq_f32(a, b)
+#define VI_CMPEQ(a, b)        vceqq_s32(a, b)
+#define VF_SELECT(m, a, b)    vbslq_f32(m, a, b)
+#define VM_AND(a, b)          vandq_u32(a, b)
+#define VM_ALL(m)             (vminvq_u32(m) != 0)
+#define VF_ROUNDI(a)          vcvtnq_s32_f32(a)
+#define VI_TO_VF(a)           vcvtq_f32_s32(a)
+#define VF_AS_VI(a)           vreinterpretq_s32_f32(a)
+#define VI_AS_VF(a)           vreinterpretq_f32_s32(a)
+#define VI_SET1(x)            vdupq_n_s32(x)
+#define VI_ADD(a, b)          vaddq_s32(a, b)
+#define VI_SUB(a, b)          vsubq_s32(a, b)
+#define VI_AND(a, b)          vandq_s32(a, b)
+#define VI_OR(a, b)           vorrq_s32(a, b)
+#define VI_SLLI(a, n)         vshlq_n_s32(a, n)
+#define VI_SRLI(a, n)         vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), n))
+#include "SDL_mathbatch_impl.h"
+
+static const MathBatchKernels SDL_mathbatch_NEON = {
+    4, { Sinf_NEON, Cosf_NEON, Expf_NEON, Logf_NEON, Powf_NEON, Sqrtf_NEON }
+};
+
+#endif // MATHBATCH_NEON
+
+static const MathBatchKernels *GetMathBatchKernels(void)
+{
+#ifdef MATHBATCH_AVX2
+    if (hasAVX2()) {
+        return &SDL_mathbatch_AVX2;
+    }
+#endif
+#if defined(MATHBATCH_SSE2)
+    return &SDL_mathbatch_SSE2;
+#elif defined(MATHBATCH_NEON)
+    return &SDL_mathbatch_NEON;
+#else
+    return NULL;
+#endif
+}
+
+static float MathBatchScalar(MathBatchOp op, float x, float y)
+{
+    switch (op) {
+    case MATHBATCH_SIN:
+        return SDL_sinf(x);
+    case MATHBATCH_COS:
+        return SDL_cosf(x);
+    case MATHBATCH_EXP:
+        return SDL_expf(x);
+    case MATHBATCH_LOG:
+        return SDL_logf(x);
+    case MATHBATCH_POW:
+        return SDL_powf(x, y);
+    case MATHBATCH_SQRT:
+        return SDL_sqrtf(x);
+    default:
+        return x;
+    }
+}
+
+static void MathBatch(MathBatchOp op, float *dst, const float *src, float y, int count)
+{
+    const MathBatchKernels *kernels = GetMathBatchKernels();
+    int i;
+
+    if (count <= 0) {
+        return;
+    }
+
+    if (kernels) {
+        const MathBatchFunc func = kernels->funcs[op];
+        const int lanes = kernels->lanes;
+        const int whole = count & ~(lanes - 1);
+
+        if (whole > 0) {
+            func(dst, src, y, whole);
+        }
+        if (whole < count) {
+            // Pad the tail out to a full vector with a value that's valid for every function
+            float tail[MATHBATCH_MAX_LANES];
+            const int remaining = count - whole;
+
+            for (i = 0; i < lanes; ++i) {
+                tail[i] = (i < remaining) ? src[whole + i] : 1.0f;
+            }
+            func(tail, tail, y, lanes);
+            SDL_memcpy(dst + whole, tail, remaining * sizeof(*dst));
+        }
+        return;
+    }
+
+    for (i = 0; i < count; ++i) {
+        dst[i] = MathBatchScalar(op, src[i], y);
+    }
+}
+
+void SDL_sinf_array(float *dst, const float *src, int count)
+{
+    MathBatch(MATHBATCH_SIN, dst, src, 0.0f, count);
+}
+
+void SDL_cosf_array(float *dst, const float *src, int count)
+{
+    MathBatch(MATHBATCH_COS, dst, src, 0.0f, count);
+}
+
+void SDL_expf_array(float *dst, const float *src, int count)
+{
+    MathBatch(MATHBATCH_EXP, dst, src, 0.0f, count);
+}
+
+void SDL_logf_array(float *dst, const float *src, int count)
+{
+    MathBatch(MATHBATCH_LOG, dst, src, 0.0f, count);
+}
+
+void SDL_powf_array(float *dst, const float *src, float y, int count)
+{
+    MathBatch(MATHBATCH_POW, dst, src, y, count);
+}
+
+void SDL_sqrtf_array(float *dst, const float *src, int count)
+{
+    MathBatch(MATHBATCH_SQRT, dst, src, 0.0f, count);
+}
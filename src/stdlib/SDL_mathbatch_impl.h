@@ -0,0 +1,290 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+/* The batch math kernels, written once in terms of the vector operations
+   below and included by SDL_mathbatch.c for each instruction set.
+
+   You need to define the following before including this file:
+    MATHBATCH_FUNC(name)  the name of a kernel for this instruction set
+    MATHBATCH_TARGET      SDL_TARGETING() for the instruction set, or nothing
+    VLANES                the number of floats in a vector
+    VF, VI, VM            float, 32-bit integer and comparison mask vectors
+    VF_LOAD(p), VF_STORE(p, v), VF_SET1(x)
+    VF_ADD(a, b), VF_SUB(a, b), VF_MUL(a, b), VF_SQRT(a), VF_XOR(a, b)
+    VF_CMPLE(a, b), VF_CMPGE(a, b), VF_CMPLT(a, b), VI_CMPEQ(a, b)
+    VF_SELECT(m, a, b)    a where m is set, b elsewhere
+    VM_AND(a, b), VM_ALL(m)
+    VF_ROUNDI(a)          convert to integer, rounding to nearest even
+    VI_TO_VF(a), VF_AS_VI(a), VI_AS_VF(a)
+    VI_SET1(x), VI_ADD(a, b), VI_SUB(a, b), VI_AND(a, b), VI_OR(a, b)
+    VI_SLLI(a, n), VI_SRLI(a, n)
+
+   Every kernel takes a count that is a multiple of VLANES. Lanes the fast
+   path doesn't cover (out of range inputs, infinities, NaN) are redone with
+   the scalar function, so the results always match it for those.
+
+   The polynomials are the single precision ones from Cephes. */
+
+static SDL_INLINE VF MATHBATCH_TARGET MATHBATCH_FUNC(ExpCore)(VF x)
+{
+    const VI q = VF_ROUNDI(VF_MUL(x, VF_SET1(1.44269504088896341f)));
+    const VF qf = VI_TO_VF(q);
+    VF r, p;
+
+    r = VF_SUB(x, VF_MUL(qf, VF_SET1(0.693359375f)));
+    r = VF_SUB(r, VF_MUL(qf, VF_SET1(-2.12194440e-4f)));
+
+    p = VF_SET1(1.9875691500e-4f);
+    p = VF_ADD(VF_MUL(p, r), VF_SET1(1.3981999507e-3f));
+    p = VF_ADD(VF_MUL(p, r), VF_SET1(8.3334519073e-3f));
+    p = VF_ADD(VF_MUL(p, r), VF_SET1(4.1665795894e-2f));
+    p = VF_ADD(VF_MUL(p, r), VF_SET1(1.6666665459e-1f));
+    p = VF_ADD(VF_MUL(p, r), VF_SET1(5.0000001201e-1f));
+    p = VF_ADD(VF_ADD(VF_MUL(p, VF_MUL(r, r)), r), VF_SET1(1.0f));
+
+    // Multiply by 2^q by adding q to the exponent, the range checks keep the result normal
+    return VI_AS_VF(VI_ADD(VF_AS_VI(p), VI_SLLI(q, 23)));
+}
+
+static SDL_INLINE VF MATHBATCH_TARGET MATHBATCH_FUNC(LogCore)(VF x)
+{
+    const VI bits = VF_AS_VI(x);
+    const VF one = VF_SET1(1.0f);
+    VF e, m, z, y;
+    VM small;
+
+    // x = m * 2^e, with m in [0.5, 1)
+    e = VI_TO_VF(VI_SUB(VI_SRLI(bits, 23), VI_SET1(126)));
+    m = VI_AS_VF(VI_OR(VI_AND(bits, VI_SET1(0x007fffff)), VI_SET1(0x3f000000)));
+
+    // Move m into [sqrt(1/2), sqrt(2)) and take 1 off it
+    small = VF_CMPLT(m, VF_SET1(0.707106781186547524f));
+    e = VF_SUB(e, VF_SELECT(small, one, VF_SET1(0.0f)));
+    m = VF_SUB(VF_SELECT(small, VF_ADD(m, m), m), one);
+
+    z = VF_MUL(m, m);
+    y = VF_SET1(7.0376836292e-2f);
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(-1.1514610310e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(1.1676998740e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(-1.2420140846e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(1.4249322787e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(-1.6668057665e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(2.0000714765e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(-2.4999993993e-1f));
+    y = VF_ADD(VF_MUL(y, m), VF_SET1(3.3333331174e-1f));
+    y = VF_MUL(VF_MUL(y, m), z);
+
+    y = VF_ADD(y, VF_MUL(e, VF_SET1(-2.12194440e-4f)));
+    y = VF_SUB(y, VF_MUL(z, VF_SET1(0.5f)));
+    return VF_ADD(VF_ADD(m, y), VF_MUL(e, VF_SET1(0.693359375f)));
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(SinCos)(float *dst, const float *src, int count, bool cosine)
+{
+    const VF limit = VF_SET1(SDL_MATHBATCH_SINCOS_LIMIT);
+    const VF neg_limit = VF_SET1(-SDL_MATHBATCH_SINCOS_LIMIT);
+    const VI one_i = VI_SET1(1);
+    const VI two_i = VI_SET1(2);
+    int i, k;
+
+    for (i = 0; i < count; i += VLANES) {
+        const VF x = VF_LOAD(src + i);
+        const VM in_range = VM_AND(VF_CMPLE(x, limit), VF_CMPGE(x, neg_limit));
+        const VF xc = VF_SELECT(in_range, x, VF_SET1(0.0f));
+        VI q = VF_ROUNDI(VF_MUL(xc, VF_SET1(0.636619772367581343f)));
+        const VF qf = VI_TO_VF(q);
+        VF r, z, s, c, v;
+
+        // Reduce to [-pi/4, pi/4], q is the quadrant
+        r = VF_SUB(xc, VF_MUL(qf, VF_SET1(SDL_MATHBATCH_PIO2_1)));
+        r = VF_SUB(r, VF_MUL(qf, VF_SET1(SDL_MATHBATCH_PIO2_2)));
+        r = VF_SUB(r, VF_MUL(qf, VF_SET1(SDL_MATHBATCH_PIO2_3)));
+        r = VF_SUB(r, VF_MUL(qf, VF_SET1(SDL_MATHBATCH_PIO2_4)));
+        z = VF_MUL(r, r);
+
+        s = VF_SET1(-1.9515295891e-4f);
+        s = VF_ADD(VF_MUL(s, z), VF_SET1(8.3321608736e-3f));
+        s = VF_ADD(VF_MUL(s, z), VF_SET1(-1.6666654611e-1f));
+        s = VF_ADD(VF_MUL(VF_MUL(s, z), r), r);
+
+        c = VF_SET1(2.443315711809948e-5f);
+        c = VF_ADD(VF_MUL(c, z), VF_SET1(-1.388731625493765e-3f));
+        c = VF_ADD(VF_MUL(c, z), VF_SET1(4.166664568298827e-2f));
+        c = VF_ADD(VF_SUB(VF_MUL(VF_MUL(c, z), z), VF_MUL(z, VF_SET1(0.5f))), VF_SET1(1.0f));
+
+        // cos(x) is sin(x + pi/2), one quadrant further along
+        if (cosine) {
+            q = VI_ADD(q, one_i);
+        }
+        v = VF_SELECT(VI_CMPEQ(VI_AND(q, one_i), one_i), c, s);
+        v = VF_XOR(v, VI_AS_VF(VI_SLLI(VI_AND(q, two_i), 30)));
+
+        if (VM_ALL(in_range)) {
+            VF_STORE(dst + i, v);
+        } else {
+            float x_lanes[VLANES];
+            VF_STORE(x_lanes, x);
+            VF_STORE(dst + i, v);
+            for (k = 0; k < VLANES; ++k) {
+                if (!(x_lanes[k] <= SDL_MATHBATCH_SINCOS_LIMIT && x_lanes[k] >= -SDL_MATHBATCH_SINCOS_LIMIT)) {
+                    dst[i + k] = cosine ? SDL_cosf(x_lanes[k]) : SDL_sinf(x_lanes[k]);
+                }
+            }
+        }
+    }
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Sinf)(float *dst, const float *src, float unused, int count)
+{
+    MATHBATCH_FUNC(SinCos)(dst, src, count, false);
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Cosf)(float *dst, const float *src, float unused, int count)
+{
+    MATHBATCH_FUNC(SinCos)(dst, src, count, true);
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Expf)(float *dst, const float *src, float unused, int count)
+{
+    const VF lo = VF_SET1(SDL_MATHBATCH_EXP_MIN);
+    const VF hi = VF_SET1(SDL_MATHBATCH_EXP_MAX);
+    int i, k;
+
+    for (i = 0; i < count; i += VLANES) {
+        const VF x = VF_LOAD(src + i);
+        const VM in_range = VM_AND(VF_CMPGE(x, lo), VF_CMPLE(x, hi));
+        const VF v = MATHBATCH_FUNC(ExpCore)(VF_SELECT(in_range, x, VF_SET1(0.0f)));
+
+        if (VM_ALL(in_range)) {
+            VF_STORE(dst + i, v);
+        } else {
+            float x_lanes[VLANES];
+            VF_STORE(x_lanes, x);
+            VF_STORE(dst + i, v);
+            for (k = 0; k < VLANES; ++k) {
+                if (!(x_lanes[k] >= SDL_MATHBATCH_EXP_MIN && x_lanes[k] <= SDL_MATHBATCH_EXP_MAX)) {
+                    dst[i + k] = SDL_expf(x_lanes[k]);
+                }
+            }
+        }
+    }
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Logf)(float *dst, const float *src, float unused, int count)
+{
+    const VF lo = VF_SET1(SDL_MATHBATCH_LOG_MIN);
+    const VF hi = VF_SET1(SDL_MATHBATCH_LOG_MAX);
+    int i, k;
+
+    for (i = 0; i < count; i += VLANES) {
+        const VF x = VF_LOAD(src + i);
+        const VM in_range = VM_AND(VF_CMPGE(x, lo), VF_CMPLE(x, hi));
+        const VF v = MATHBATCH_FUNC(LogCore)(VF_SELECT(in_range, x, VF_SET1(1.0f)));
+
+        if (VM_ALL(in_range)) {
+            VF_STORE(dst + i, v);
+        } else {
+            float x_lanes[VLANES];
+            VF_STORE(x_lanes, x);
+            VF_STORE(dst + i, v);
+            for (k = 0; k < VLANES; ++k) {
+                if (!(x_lanes[k] >= SDL_MATHBATCH_LOG_MIN && x_lanes[k] <= SDL_MATHBATCH_LOG_MAX)) {
+                    dst[i + k] = SDL_logf(x_lanes[k]);
+                }
+            }
+        }
+    }
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Powf)(float *dst, const float *src, float y, int count)
+{
+    const VF lo = VF_SET1(SDL_MATHBATCH_LOG_MIN);
+    const VF hi = VF_SET1(SDL_MATHBATCH_LOG_MAX);
+    const VF exp_lo = VF_SET1(SDL_MATHBATCH_EXP_MIN);
+    const VF exp_hi = VF_SET1(SDL_MATHBATCH_EXP_MAX);
+    const VF vy = VF_SET1(y);
+    int i, k;
+
+    for (i = 0; i < count; i += VLANES) {
+        const VF x = VF_LOAD(src + i);
+        const VM x_in_range = VM_AND(VF_CMPGE(x, lo), VF_CMPLE(x, hi));
+        const VF t = VF_MUL(vy, MATHBATCH_FUNC(LogCore)(VF_SELECT(x_in_range, x, VF_SET1(1.0f))));
+        const VM in_range = VM_AND(x_in_range, VM_AND(VF_CMPGE(t, exp_lo), VF_CMPLE(t, exp_hi)));
+        const VF v = MATHBATCH_FUNC(ExpCore)(VF_SELECT(in_range, t, VF_SET1(0.0f)));
+
+        if (VM_ALL(in_range)) {
+            VF_STORE(dst + i, v);
+        } else {
+            float x_lanes[VLANES], t_lanes[VLANES];
+            VF_STORE(x_lanes, x);
+            VF_STORE(t_lanes, t);
+            VF_STORE(dst + i, v);
+            for (k = 0; k < VLANES; ++k) {
+                if (!(x_lanes[k] >= SDL_MATHBATCH_LOG_MIN && x_lanes[k] <= SDL_MATHBATCH_LOG_MAX &&
+                      t_lanes[k] >= SDL_MATHBATCH_EXP_MIN && t_lanes[k] <= SDL_MATHBATCH_EXP_MAX)) {
+                    dst[i + k] = SDL_powf(x_lanes[k], y);
+                }
+            }
+        }
+    }
+}
+
+static void MATHBATCH_TARGET MATHBATCH_FUNC(Sqrtf)(float *dst, const float *src, float unused, int count)
+{
+    int i;
+
+    for (i = 0; i < count; i += VLANES) {
+        VF_STORE(dst + i, VF_SQRT(VF_LOAD(src + i)));
+    }
+}
+
+#undef MATHBATCH_FUNC
+#undef MATHBATCH_TARGET
+#undef VLANES
+#undef VF
+#undef VI
+#undef VM
+#undef VF_LOAD
+#undef VF_STORE
+#undef VF_SET1
+#undef VF_ADD
+#undef VF_SUB
+#undef VF_MUL
+#undef VF_SQRT
+#undef VF_XOR
+#undef VF_CMPLE
+#undef VF_CMPGE
+#undef VF_CMPLT
+#undef VI_CMPEQ
+#undef VF_SELECT
+#undef VM_AND
+#undef VM_ALL
+#undef VF_ROUNDI
+#undef VI_TO_VF
+#undef VF_AS_VI
+#undef VI_AS_VF
+#undef VI_SET1
+#undef VI_ADD
+#undef VI_SUB
+#undef VI_AND
+#undef VI_OR
+#undef VI_SLLI
+#undef VI_SRLI
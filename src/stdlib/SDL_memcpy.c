@@ -20,6 +20,52 @@
 */
 #include "SDL_internal.h"
 
+#if !(defined(__GNUC__) && (defined(HAVE_LIBC) && HAVE_LIBC)) && !defined(HAVE_MEMCPY) && !defined(HAVE_BCOPY)
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MEMCPY_SSE2
+
+// Copies larger than this bypass the cache with non-temporal stores
+#define MEMCPY_STREAM_MIN_BYTES (2 * 1024 * 1024)
+
+// Copy len bytes, at least 16, with 16-byte stores to an aligned destination
+static void SDL_memcpy_SSE2(Uint8 *dst, const Uint8 *src, size_t len)
+{
+    while ((uintptr_t)dst & 15) {
+        *dst++ = *src++;
+        --len;
+    }
+
+    if (len >= MEMCPY_STREAM_MIN_BYTES) {
+        for (; len >= 64; len -= 64, src += 64, dst += 64) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+            const __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+            _mm_stream_si128((__m128i *)(dst + 0), a);
+            _mm_stream_si128((__m128i *)(dst + 16), b);
+            _mm_stream_si128((__m128i *)(dst + 32), c);
+            _mm_stream_si128((__m128i *)(dst + 48), d);
+        }
+        _mm_sfence();
+    } else {
+        for (; len >= 64; len -= 64, src += 64, dst += 64) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+            const __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+            _mm_store_si128((__m128i *)(dst + 0), a);
+            _mm_store_si128((__m128i *)(dst + 16), b);
+            _mm_store_si128((__m128i *)(dst + 32), c);
+            _mm_store_si128((__m128i *)(dst + 48), d);
+        }
+    }
+
+    while (len--) {
+        *dst++ = *src++;
+    }
+}
+#endif
+#endif
 
 #ifdef SDL_memcpy
 #undef SDL_memcpy
@@ -40,6 +86,12 @@ void *SDL_memcpy(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
     bcopy(src, dst, len);
     return dst;
 #else
+#ifdef MEMCPY_SSE2
+    if (len >= 256) {
+        SDL_memcpy_SSE2((Uint8 *)dst, (const Uint8 *)src, len);
+        return dst;
+    }
+#endif
     /* GCC 4.9.0 with -O3 will generate movaps instructions with the loop
        using Uint32* pointers, so we need to make sure the pointers are
        aligned before we loop using them.
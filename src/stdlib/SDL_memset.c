@@ -20,6 +20,57 @@
 */
 #include "SDL_internal.h"
 
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MEMSET_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__ARM_NEON) || defined(_M_ARM64))
+#define MEMSET_NEON
+#endif
+
+#if defined(MEMSET_SSE2) || defined(MEMSET_NEON)
+// Sets larger than this bypass the cache with non-temporal stores, where available
+#define MEMSET_STREAM_MIN_BYTES (2 * 1024 * 1024)
+
+// Fill 4-byte aligned memory with a 32-bit value using the widest stores the target always has
+static SDL_INLINE void SDL_memset4_wide(Uint32 *p, Uint32 val, size_t dwords)
+{
+    while (((uintptr_t)p & 15) && dwords) {
+        *p++ = val;
+        --dwords;
+    }
+
+#ifdef MEMSET_SSE2
+    const __m128i v = _mm_set1_epi32((int)val);
+    if (dwords * 4 >= MEMSET_STREAM_MIN_BYTES) {
+        for (; dwords >= 16; dwords -= 16, p += 16) {
+            _mm_stream_si128((__m128i *)(p + 0), v);
+            _mm_stream_si128((__m128i *)(p + 4), v);
+            _mm_stream_si128((__m128i *)(p + 8), v);
+            _mm_stream_si128((__m128i *)(p + 12), v);
+        }
+        _mm_sfence();
+    } else {
+        for (; dwords >= 16; dwords -= 16, p += 16) {
+            _mm_store_si128((__m128i *)(p + 0), v);
+            _mm_store_si128((__m128i *)(p + 4), v);
+            _mm_store_si128((__m128i *)(p + 8), v);
+            _mm_store_si128((__m128i *)(p + 12), v);
+        }
+    }
+#else
+    const uint32x4_t v = vdupq_n_u32(val);
+    for (; dwords >= 16; dwords -= 16, p += 16) {
+        vst1q_u32(p + 0, v);
+        vst1q_u32(p + 4, v);
+        vst1q_u32(p + 8, v);
+        vst1q_u32(p + 12, v);
+    }
+#endif
+
+    while (dwords--) {
+        *p++ = val;
+    }
+}
+#endif // MEMSET_SSE2 || MEMSET_NEON
 
 #ifdef SDL_memset
 #undef SDL_memset
@@ -59,9 +110,14 @@ void *SDL_memset(SDL_OUT_BYTECAP(len) void *dst, int c, size_t len)
     dstp4 = (Uint32 *)dstp1;
     left = (len % 4);
     len /= 4;
+#if defined(MEMSET_SSE2) || defined(MEMSET_NEON)
+    SDL_memset4_wide(dstp4, value4, len);
+    dstp4 += len;
+#else
     while (len--) {
         *dstp4++ = value4;
     }
+#endif
 
     dstp1 = (Uint8 *)dstp4;
     switch (left) {
@@ -99,6 +155,12 @@ void *SDL_memset4(void *dst, Uint32 val, size_t dwords)
     if (dwords == 0) {
         return dst;
     }
+#if defined(MEMSET_SSE2) || defined(MEMSET_NEON)
+    if (dwords >= 64 && ((uintptr_t)_p & 3) == 0) {
+        SDL_memset4_wide(_p, _val, dwords);
+        return dst;
+    }
+#endif
     switch (dwords % 4) {
     case 0:
         do {
@@ -25,506 +25,618 @@
 // tapdance to support the various qsort_r interfaces, or bridge from
 // the C runtime's non-SDLCALL compare functions.
 
-#ifdef assert
-#undef assert
-#endif
-#define assert SDL_assert
-#ifdef malloc
-#undef malloc
-#endif
-#define malloc SDL_malloc
-#ifdef free
-#undef free
-#endif
-#define free SDL_free
-#ifdef memcpy
-#undef memcpy
-#endif
-#define memcpy SDL_memcpy
-#ifdef memmove
-#undef memmove
-#endif
-#define memmove SDL_memmove
+/* This is a pattern-defeating quicksort, after Orson Peters' pdqsort:
+   https://github.com/orlp/pdqsort
+
+   - Median of three pivots, or a pseudomedian of nine for larger arrays
+   - Insertion sort for short ranges, with the cutoff depending on element size
+   - Block partitioning (BlockQuicksort) that makes no branches on the result
+     of the comparison, which would otherwise be mispredicted about half the time
+   - Detects already partitioned ranges and finishes them with a bounded
+     insertion sort, so sorted and nearly sorted input is close to linear
+   - Partitions runs of equal elements in one pass
+   - Shuffles elements when partitions come out badly unbalanced, and falls
+     back to heapsort if that keeps happening, so the worst case is O(n log n)
+   - Only recurses into the smaller partition, so the stack depth is O(log n)
+*/
 
-/*
-This code came from Gareth McCaughan, under the zlib license.
-Specifically this: https://www.mccaughan.org.uk/software/qsort.c-1.16
+#define SORT_BLOCK_SIZE             64
+#define SORT_NINTHER_THRESHOLD      128
+#define SORT_PARTIAL_INSERTION_LIMIT 8
+#define SORT_MAX_STACK_ELEMENT_SIZE 256
 
-Everything below this comment until the HAVE_QSORT #endif was from Gareth
-(any minor changes will be noted inline).
+typedef struct SDL_SortContext
+{
+    size_t size;
+    size_t word_size;   // size, if the elements are an aligned Uint32 or Uint64, otherwise 0
+    SDL_CompareCallback_r compare;
+    void *userdata;
+    size_t insertion_threshold;
+    char *pivot;    // holds the pivot while partitioning
+    char *hole;     // holds an element being moved around a cycle
+} SDL_SortContext;
+
+#define LESS(ctx, a, b) ((ctx)->compare((ctx)->userdata, (a), (b)) < 0)
+
+// Elements that are a machine word or two get moved around with plain loads and stores
+static SDL_INLINE void sort_copy(const SDL_SortContext *ctx, char *dst, const char *src)
+{
+    switch (ctx->word_size) {
+    case sizeof(Uint32):
+        *(Uint32 *)dst = *(const Uint32 *)src;
+        break;
+    case sizeof(Uint64):
+        *(Uint64 *)dst = *(const Uint64 *)src;
+        break;
+    default:
+        SDL_memcpy(dst, src, ctx->size);
+        break;
+    }
+}
 
-Thank you to Gareth for relicensing this code under the zlib license for our
-benefit!
+static SDL_INLINE void sort_swap(const SDL_SortContext *ctx, char *a, char *b)
+{
+    switch (ctx->word_size) {
+    case sizeof(Uint32):
+    {
+        const Uint32 tmp = *(Uint32 *)a;
+        *(Uint32 *)a = *(Uint32 *)b;
+        *(Uint32 *)b = tmp;
+    } break;
+    case sizeof(Uint64):
+    {
+        const Uint64 tmp = *(Uint64 *)a;
+        *(Uint64 *)a = *(Uint64 *)b;
+        *(Uint64 *)b = tmp;
+    } break;
+    default:
+    {
+        char tmp[64];
+        size_t left = ctx->size;
+        while (left > 0) {
+            const size_t chunk = SDL_min(left, sizeof(tmp));
+            SDL_memcpy(tmp, a, chunk);
+            SDL_memcpy(a, b, chunk);
+            SDL_memcpy(b, tmp, chunk);
+            a += chunk;
+            b += chunk;
+            left -= chunk;
+        }
+    } break;
+    }
+}
 
-Update for SDL3: we have modified this from a qsort function to qsort_r.
+static SDL_INLINE void sort2(const SDL_SortContext *ctx, char *a, char *b)
+{
+    if (LESS(ctx, b, a)) {
+        sort_swap(ctx, a, b);
+    }
+}
 
---ryan.
-*/
+static SDL_INLINE void sort3(const SDL_SortContext *ctx, char *a, char *b, char *c)
+{
+    sort2(ctx, a, b);
+    sort2(ctx, b, c);
+    sort2(ctx, a, b);
+}
+
+/* Insertion sort of [begin, end). If `guarded` is false, there must be an
+   element before `begin` that is no greater than anything in the range. */
+static void insertion_sort(const SDL_SortContext *ctx, char *begin, char *end, bool guarded)
+{
+    const size_t size = ctx->size;
+    char *cur;
 
-/* This is a drop-in replacement for the C library's |qsort()| routine.
- *
- * It is intended for use where you know or suspect that your
- * platform's qsort is bad. If that isn't the case, then you
- * should probably use the qsort your system gives you in preference
- * to mine -- it will likely have been tested and tuned better.
- *
- * Features:
- *   - Median-of-three pivoting (and more)
- *   - Truncation and final polishing by a single insertion sort
- *   - Early truncation when no swaps needed in pivoting step
- *   - Explicit recursion, guaranteed not to overflow
- *   - A few little wrinkles stolen from the GNU |qsort()|.
- *     (For the avoidance of doubt, no code was stolen, only
- *     broad ideas.)
- *   - separate code for non-aligned / aligned / word-size objects
- *
- * Earlier releases of this code used an idiosyncratic licence
- * I wrote myself, because I'm an idiot. The code is now released
- * under the "zlib/libpng licence"; you will find the actual
- * terms in the next comment. I request (but do not require)
- * that if you make any changes beyond the name of the exported
- * routine and reasonable tweaks to the TRUNC_* and
- * PIVOT_THRESHOLD values, you modify the _ID string so as
- * to make it clear that you have changed the code.
- *
- * If you find problems with this code, or find ways of
- * making it significantly faster, please let me know!
- * My e-mail address, valid as of early 2016 and for the
- * foreseeable future, is
- *    gareth.mccaughan@pobox.com
- * Thanks!
- *
- * Gareth McCaughan
- */
-
-/* Copyright (c) 1998-2021 Gareth McCaughan
- *
- * This software is provided 'as-is', without any express or implied
- * warranty. In no event will the authors be held liable for any
- * damages arising from the use of this software.
- *
- * Permission is granted to anyone to use this software for any purpose,
- * including commercial applications, and to alter it and redistribute it
- * freely, subject to the following restrictions:
- *
- * 1. The origin of this software must not be misrepresented;
- *    you must not claim that you wrote the original software.
- *    If you use this software in a product, an acknowledgment
- *    in the product documentation would be appreciated but
- *    is not required.
- *
- * 2. Altered source versions must be plainly marked as such,
- *    and must not be misrepresented as being the original software.
- *
- * 3. This notice may not be removed or altered from any source
- *    distribution.
- */
-
-/* Revision history since release:
- *   1998-03-19 v1.12 First release I have any records of.
- *   2007-09-02 v1.13 Fix bug kindly reported by Dan Bodoh
- *                    (premature termination of recursion).
- *                    Add a few clarifying comments.
- *                    Minor improvements to debug output.
- *   2016-02-21 v1.14 Replace licence with 2-clause BSD,
- *                    and clarify a couple of things in
- *                    comments. No code changes.
- *   2016-03-10 v1.15 Fix bug kindly reported by Ryan Gordon
- *                    (pre-insertion-sort messed up).
- *                    Disable DEBUG_QSORT by default.
- *                    Tweak comments very slightly.
- *   2021-02-20 v1.16 Fix bug kindly reported by Ray Gardner
- *                    (error in recursion leading to possible
- *                    stack overflow).
- *                    When checking alignment, avoid casting
- *                    pointer to possibly-smaller integer.
- */
-
-/* BEGIN SDL CHANGE ... commented this out with an #if 0 block. --ryan. */
-#if 0
-#include <assert.h>
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
-
-#undef DEBUG_QSORT
-
-static char _ID[]="<qsort.c gjm WITH CHANGES FOR SDL3 1.16 2021-02-20>";
-#endif
-/* END SDL CHANGE ... commented this out with an #if 0 block. --ryan. */
-
-/* How many bytes are there per word? (Must be a power of 2,
- * and must in fact equal sizeof(int).)
- */
-#define WORD_BYTES sizeof(int)
-
-/* How big does our stack need to be? Answer: one entry per
- * bit in a |size_t|. (Actually, a bit less because we don't
- * recurse all the way down to size-1 subarrays.)
- */
-#define STACK_SIZE (8*sizeof(size_t))
-
-/* Different situations have slightly different requirements,
- * and we make life epsilon easier by using different truncation
- * points for the three different cases.
- * So far, I have tuned TRUNC_words and guessed that the same
- * value might work well for the other two cases. Of course
- * what works well on my machine might work badly on yours.
- */
-#define TRUNC_nonaligned	12
-#define TRUNC_aligned		12
-#define TRUNC_words		12*WORD_BYTES	/* nb different meaning */
-
-/* We use a simple pivoting algorithm for shortish sub-arrays
- * and a more complicated one for larger ones. The threshold
- * is PIVOT_THRESHOLD.
- */
-#define PIVOT_THRESHOLD 40
-
-typedef struct { char * first; char * last; } stack_entry;
-#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop++].last=last;}
-#define pushRight {stack[stacktop].first=first;stack[stacktop++].last=llast;}
-#define doLeft {first=ffirst;llast=last;continue;}
-#define doRight {ffirst=first;last=llast;continue;}
-#define pop {if (--stacktop<0) break;\
-  first=ffirst=stack[stacktop].first;\
-  last=llast=stack[stacktop].last;\
-  continue;}
-
-/* Some comments on the implementation.
- * 1. When we finish partitioning the array into "low"
- *    and "high", we forget entirely about short subarrays,
- *    because they'll be done later by insertion sort.
- *    Doing lots of little insertion sorts might be a win
- *    on large datasets for locality-of-reference reasons,
- *    but it makes the code much nastier and increases
- *    bookkeeping overhead.
- * 2. We always save the longer and get to work on the
- *    shorter. This guarantees that whenever we push
- *    a k'th entry onto the stack we are about to get
- *    working on something of size <= N/2^k where N is
- *    the original array size; so the stack can't need
- *    more than log_2(max-array-size) entries.
- * 3. We choose a pivot by looking at the first, last
- *    and middle elements. We arrange them into order
- *    because it's easy to do that in conjunction with
- *    choosing the pivot, and it makes things a little
- *    easier in the partitioning step. Anyway, the pivot
- *    is the middle of these three. It's still possible
- *    to construct datasets where the algorithm takes
- *    time of order n^2, but it simply never happens in
- *    practice.
- * 3' Newsflash: On further investigation I find that
- *    it's easy to construct datasets where median-of-3
- *    simply isn't good enough. So on large-ish subarrays
- *    we do a more sophisticated pivoting: we take three
- *    sets of 3 elements, find their medians, and then
- *    take the median of those.
- * 4. We copy the pivot element to a separate place
- *    because that way we can always do our comparisons
- *    directly against a pointer to that separate place,
- *    and don't have to wonder "did we move the pivot
- *    element?". This makes the inner loop better.
- * 5. It's possible to make the pivoting even more
- *    reliable by looking at more candidates when n
- *    is larger. (Taking this to its logical conclusion
- *    results in a variant of quicksort that doesn't
- *    have that n^2 worst case.) However, the overhead
- *    from the extra bookkeeping means that it's just
- *    not worth while.
- * 6. This is pretty clean and portable code. Here are
- *    all the potential portability pitfalls and problems
- *    I know of:
- *      - In one place (the insertion sort) I construct
- *        a pointer that points just past the end of the
- *        supplied array, and assume that (a) it won't
- *        compare equal to any pointer within the array,
- *        and (b) it will compare equal to a pointer
- *        obtained by stepping off the end of the array.
- *        These might fail on some segmented architectures.
- *      - I assume that there are 8 bits in a |char| when
- *        computing the size of stack needed. This would
- *        fail on machines with 9-bit or 16-bit bytes.
- *      - I assume that if |((int)base&(sizeof(int)-1))==0|
- *        and |(size&(sizeof(int)-1))==0| then it's safe to
- *        get at array elements via |int*|s, and that if
- *        actually |size==sizeof(int)| as well then it's
- *        safe to treat the elements as |int|s. This might
- *        fail on systems that convert pointers to integers
- *        in non-standard ways.
- *      - I assume that |8*sizeof(size_t)<=INT_MAX|. This
- *        would be false on a machine with 8-bit |char|s,
- *        16-bit |int|s and 4096-bit |size_t|s. :-)
- */
-
-/* The recursion logic is the same in each case.
- * We keep chopping up until we reach subarrays of size
- * strictly less than Trunc; we leave these unsorted. */
-#define Recurse(Trunc)				\
-      { size_t l=last-ffirst,r=llast-first;	\
-        if (l<Trunc) {				\
-          if (r>=Trunc) doRight			\
-          else pop				\
-        }					\
-        else if (l<=r) { pushRight; doLeft }	\
-        else if (r>=Trunc) { pushLeft; doRight }\
-        else doLeft				\
-      }
-
-/* and so is the pivoting logic (note: last is inclusive): */
-#define Pivot(swapper,sz)			\
-  if ((size_t)(last-first)>PIVOT_THRESHOLD*sz) mid=pivot_big(first,mid,last,sz,compare,userdata);\
-  else {	\
-    if (compare(userdata,first,mid)<0) {			\
-      if (compare(userdata,mid,last)>0) {		\
-        swapper(mid,last);			\
-        if (compare(userdata,first,mid)>0) swapper(first,mid);\
-      }						\
-    }						\
-    else {					\
-      if (compare(userdata,mid,last)>0) swapper(first,last)\
-      else {					\
-        swapper(first,mid);			\
-        if (compare(userdata,mid,last)>0) swapper(mid,last);\
-      }						\
-    }						\
-    first+=sz; last-=sz;			\
-  }
-
-#ifdef DEBUG_QSORT
-#include <stdio.h>
-#endif
-
-/* and so is the partitioning logic: */
-#define Partition(swapper,sz) {			\
-  do {						\
-    while (compare(userdata,first,pivot)<0) first+=sz;	\
-    while (compare(userdata,pivot,last)<0) last-=sz;	\
-    if (first<last) {				\
-      swapper(first,last);			\
-      first+=sz; last-=sz; }			\
-    else if (first==last) { first+=sz; last-=sz; break; }\
-  } while (first<=last);			\
+    if (begin == end) {
+        return;
+    }
+
+    for (cur = begin + size; cur != end; cur += size) {
+        char *sift = cur;
+        char *sift_1 = cur - size;
+
+        if (LESS(ctx, sift, sift_1)) {
+            sort_copy(ctx, ctx->hole, sift);
+            do {
+                sort_copy(ctx, sift, sift_1);
+                sift -= size;
+            } while ((!guarded || sift != begin) && LESS(ctx, ctx->hole, (sift_1 -= size)));
+            sort_copy(ctx, sift, ctx->hole);
+        }
+    }
 }
 
-/* and so is the pre-insertion-sort operation of putting
- * the smallest element into place as a sentinel.
- * Doing this makes the inner loop nicer. I got this
- * idea from the GNU implementation of qsort().
- * We find the smallest element from the first |nmemb|,
- * or the first |limit|, whichever is smaller;
- * therefore we must have ensured that the globally smallest
- * element is in the first |limit| (because our
- * quicksort recursion bottoms out only once we
- * reach subarrays smaller than |limit|).
- */
-#define PreInsertion(swapper,limit,sz)		\
-  first=base;					\
-  last=first + ((nmemb>limit ? limit : nmemb)-1)*sz;\
-  while (last!=base) {				\
-    if (compare(userdata,first,last)>0) first=last;	\
-    last-=sz; }					\
-  if (first!=base) swapper(first,(char*)base);
-
-/* and so is the insertion sort, in the first two cases: */
-#define Insertion(swapper)			\
-  last=((char*)base)+nmemb*size;		\
-  for (first=((char*)base)+size;first!=last;first+=size) {	\
-    char *test;					\
-    /* Find the right place for |first|.	\
-     * My apologies for var reuse. */		\
-    for (test=first-size;compare(userdata,test,first)>0;test-=size) ;	\
-    test+=size;					\
-    if (test!=first) {				\
-      /* Shift everything in [test,first)	\
-       * up by one, and place |first|		\
-       * where |test| is. */			\
-      memcpy(pivot,first,size);			\
-      memmove(test+size,test,first-test);	\
-      memcpy(test,pivot,size);			\
-    }						\
-  }
-
-#define SWAP_nonaligned(a,b) { \
-  register char *aa=(a),*bb=(b); \
-  register size_t sz=size; \
-  do { register char t=*aa; *aa++=*bb; *bb++=t; } while (--sz); }
-
-#define SWAP_aligned(a,b) { \
-  register int *aa=(int*)(a),*bb=(int*)(b); \
-  register size_t sz=size; \
-  do { register int t=*aa;*aa++=*bb; *bb++=t; } while (sz-=WORD_BYTES); }
-
-#define SWAP_words(a,b) { \
-  register int t=*((int*)a); *((int*)a)=*((int*)b); *((int*)b)=t; }
-
-/* ---------------------------------------------------------------------- */
-
-static char * pivot_big(char *first, char *mid, char *last, size_t size,
-                        int (SDLCALL *compare)(void *, const void *, const void *), void *userdata) {
-  size_t d=(((last-first)/size)>>3)*size;
-#ifdef DEBUG_QSORT
-fprintf(stderr, "pivot_big: first=%p last=%p size=%lu n=%lu\n", first, (unsigned long)last, size, (unsigned long)((last-first+1)/size));
-#endif
-  char *m1,*m2,*m3;
-  { char *a=first, *b=first+d, *c=first+2*d;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"< %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m1 = compare(userdata,a,b)<0 ?
-           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
-         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
-  }
-  { char *a=mid-d, *b=mid, *c=mid+d;
-#ifdef DEBUG_QSORT
-fprintf(stderr,". %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m2 = compare(userdata,a,b)<0 ?
-           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
-         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
-  }
-  { char *a=last-2*d, *b=last-d, *c=last;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"> %d %d %d @ %p %p %p\n",*(int*)a,*(int*)b,*(int*)c, a,b,c);
-#endif
-    m3 = compare(userdata,a,b)<0 ?
-           (compare(userdata,b,c)<0 ? b : (compare(userdata,a,c)<0 ? c : a))
-         : (compare(userdata,a,c)<0 ? a : (compare(userdata,b,c)<0 ? c : b));
-  }
-#ifdef DEBUG_QSORT
-fprintf(stderr,"-> %d %d %d @ %p %p %p\n",*(int*)m1,*(int*)m2,*(int*)m3, m1,m2,m3);
-#endif
-  return compare(userdata,m1,m2)<0 ?
-           (compare(userdata,m2,m3)<0 ? m2 : (compare(userdata,m1,m3)<0 ? m3 : m1))
-         : (compare(userdata,m1,m3)<0 ? m1 : (compare(userdata,m2,m3)<0 ? m3 : m2));
+/* Attempts an insertion sort of [begin, end), giving up if it has to move too
+   many elements. Returns true if the range ended up sorted. The range must
+   follow an element that is no greater than anything in it. */
+static bool partial_insertion_sort(const SDL_SortContext *ctx, char *begin, char *end)
+{
+    const size_t size = ctx->size;
+    size_t limit = 0;
+    char *cur;
+
+    if (begin == end) {
+        return true;
+    }
+
+    for (cur = begin + size; cur != end; cur += size) {
+        char *sift = cur;
+        char *sift_1 = cur - size;
+
+        if (LESS(ctx, sift, sift_1)) {
+            sort_copy(ctx, ctx->hole, sift);
+            do {
+                sort_copy(ctx, sift, sift_1);
+                sift -= size;
+            } while (sift != begin && LESS(ctx, ctx->hole, (sift_1 -= size)));
+            sort_copy(ctx, sift, ctx->hole);
+            limit += (size_t)(cur - sift) / size;
+        }
+        if (limit > SORT_PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+    return true;
 }
 
-/* ---------------------------------------------------------------------- */
-
-static void qsort_r_nonaligned(void *base, size_t nmemb, size_t size,
-           int (SDLCALL *compare)(void *, const void *, const void *), void *userdata) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(size);
-  size_t trunc=TRUNC_nonaligned*size;
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*size;
-
-  if ((size_t)(last-first)>=trunc) {
-    char *ffirst=first, *llast=last;
-    while (1) {
-      /* Select pivot */
-      { char * mid=first+size*((last-first)/size >> 1);
-        Pivot(SWAP_nonaligned,size);
-        memcpy(pivot,mid,size);
-      }
-      /* Partition. */
-      Partition(SWAP_nonaligned,size);
-      /* Prepare to recurse/iterate. */
-      Recurse(trunc)
-    }
-  }
-  PreInsertion(SWAP_nonaligned,TRUNC_nonaligned,size);
-  Insertion(SWAP_nonaligned);
-  free(pivot);
+static void sift_down(const SDL_SortContext *ctx, char *base, size_t root, size_t count)
+{
+    const size_t size = ctx->size;
+
+    for (;;) {
+        size_t child = root * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && LESS(ctx, base + child * size, base + (child + 1) * size)) {
+            ++child;
+        }
+        if (!LESS(ctx, base + root * size, base + child * size)) {
+            break;
+        }
+        sort_swap(ctx, base + root * size, base + child * size);
+        root = child;
+    }
 }
 
-static void qsort_r_aligned(void *base, size_t nmemb, size_t size,
-           int (SDLCALL *compare)(void *,const void *, const void *), void *userdata) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(size);
-  size_t trunc=TRUNC_aligned*size;
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*size;
-
-  if ((size_t)(last-first)>=trunc) {
-    char *ffirst=first,*llast=last;
-    while (1) {
-      /* Select pivot */
-      { char * mid=first+size*((last-first)/size >> 1);
-        Pivot(SWAP_aligned,size);
-        memcpy(pivot,mid,size);
-      }
-      /* Partition. */
-      Partition(SWAP_aligned,size);
-      /* Prepare to recurse/iterate. */
-      Recurse(trunc)
-    }
-  }
-  PreInsertion(SWAP_aligned,TRUNC_aligned,size);
-  Insertion(SWAP_aligned);
-  free(pivot);
+static void heap_sort(const SDL_SortContext *ctx, char *begin, char *end)
+{
+    const size_t size = ctx->size;
+    const size_t count = (size_t)(end - begin) / size;
+    size_t i;
+
+    for (i = count / 2; i-- > 0;) {
+        sift_down(ctx, begin, i, count);
+    }
+    for (i = count - 1; i > 0; --i) {
+        sort_swap(ctx, begin, begin + i * size);
+        sift_down(ctx, begin, 0, i);
+    }
 }
 
-static void qsort_r_words(void *base, size_t nmemb,
-           int (SDLCALL *compare)(void *,const void *, const void *), void *userdata) {
-
-  stack_entry stack[STACK_SIZE];
-  int stacktop=0;
-  char *first,*last;
-  char *pivot=malloc(WORD_BYTES);
-  assert(pivot != NULL);
-
-  first=(char*)base; last=first+(nmemb-1)*WORD_BYTES;
-
-  if (last-first>=TRUNC_words) {
-    char *ffirst=first, *llast=last;
-    while (1) {
-#ifdef DEBUG_QSORT
-fprintf(stderr,"Doing %d:%d: ",
-        (first-(char*)base)/WORD_BYTES,
-        (last-(char*)base)/WORD_BYTES);
-#endif
-      /* Select pivot */
-      { char * mid=first+WORD_BYTES*((last-first) / (2*WORD_BYTES));
-        Pivot(SWAP_words,WORD_BYTES);
-        *(int*)pivot=*(int*)mid;
-#ifdef DEBUG_QSORT
-fprintf(stderr,"pivot = %p = #%lu = %d\n", mid, (unsigned long)(((int*)mid)-((int*)base)), *(int*)mid);
-#endif
-      }
-      /* Partition. */
-      Partition(SWAP_words,WORD_BYTES);
-#ifdef DEBUG_QSORT
-fprintf(stderr, "after partitioning first=#%lu last=#%lu\n", (first-(char*)base)/4lu, (last-(char*)base)/4lu);
-#endif
-      /* Prepare to recurse/iterate. */
-      Recurse(TRUNC_words)
-    }
-  }
-  PreInsertion(SWAP_words,TRUNC_words/WORD_BYTES,WORD_BYTES);
-  /* Now do insertion sort. */
-  last=((char*)base)+nmemb*WORD_BYTES;
-  for (first=((char*)base)+WORD_BYTES;first!=last;first+=WORD_BYTES) {
-    /* Find the right place for |first|. My apologies for var reuse */
-    int *pl=(int*)(first-WORD_BYTES),*pr=(int*)first;
-    *(int*)pivot=*(int*)first;
-    for (;compare(userdata,pl,pivot)>0;pr=pl,--pl) {
-      *pr=*pl; }
-    if (pr!=(int*)first) *pr=*(int*)pivot;
-  }
-  free(pivot);
+// Swaps the misplaced elements found by the block partition, `num` from each side
+static void swap_offsets(const SDL_SortContext *ctx, char *first, char *last, const Uint8 *offsets_l, const Uint8 *offsets_r, size_t num, bool use_swaps)
+{
+    const size_t size = ctx->size;
+    size_t i;
+
+    if (use_swaps) {
+        // The two sides are the same size, so the cycle below would leave one element in the wrong place
+        for (i = 0; i < num; ++i) {
+            sort_swap(ctx, first + offsets_l[i] * size, last - offsets_r[i] * size);
+        }
+    } else if (num > 0) {
+        char *l = first + offsets_l[0] * size;
+        char *r = last - offsets_r[0] * size;
+        sort_copy(ctx, ctx->hole, l);
+        sort_copy(ctx, l, r);
+        for (i = 1; i < num; ++i) {
+            l = first + offsets_l[i] * size;
+            sort_copy(ctx, r, l);
+            r = last - offsets_r[i] * size;
+            sort_copy(ctx, l, r);
+        }
+        sort_copy(ctx, r, ctx->hole);
+    }
 }
 
-/* ---------------------------------------------------------------------- */
+/* Partitions [begin, end) around the pivot at *begin, putting elements equal
+   to the pivot on the right. Returns the final position of the pivot, and sets
+   `*already_partitioned` if no elements had to be moved. */
+static char *partition_right(const SDL_SortContext *ctx, char *begin, char *end, bool *already_partitioned)
+{
+    const size_t size = ctx->size;
+    char *pivot = ctx->pivot;
+    char *first = begin;
+    char *last = end;
+    char *pivot_pos;
+
+    sort_copy(ctx, pivot, begin);
+
+    // Find the first element >= pivot, there is one because the median selection put one at the end
+    do {
+        first += size;
+    } while (LESS(ctx, first, pivot));
+
+    // Find the last element < pivot, guarding against running off the start if nothing was smaller
+    if (first - size == begin) {
+        while (first < last) {
+            last -= size;
+            if (LESS(ctx, last, pivot)) {
+                break;
+            }
+        }
+    } else {
+        do {
+            last -= size;
+        } while (!LESS(ctx, last, pivot));
+    }
+
+    *already_partitioned = (first >= last);
+
+    if (!*already_partitioned) {
+        Uint8 offsets_l[SORT_BLOCK_SIZE];
+        Uint8 offsets_r[SORT_BLOCK_SIZE];
+        char *offsets_l_base;
+        char *offsets_r_base;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        sort_swap(ctx, first, last);
+        first += size;
+
+        offsets_l_base = first;
+        offsets_r_base = last;
+
+        /* Scan blocks from both ends, recording the offsets of the elements
+           that are on the wrong side. The comparison result only feeds an
+           addition, so there's nothing for the branch predictor to miss. */
+        while (first < last) {
+            const size_t num_unknown = (size_t)(last - first) / size;
+            const size_t left_split = (num_l == 0) ? ((num_r == 0) ? (num_unknown / 2) : num_unknown) : 0;
+            const size_t right_split = (num_r == 0) ? (num_unknown - left_split) : 0;
+            const size_t left_count = SDL_min(left_split, SORT_BLOCK_SIZE);
+            const size_t right_count = SDL_min(right_split, SORT_BLOCK_SIZE);
+            size_t num, i;
+
+            for (i = 0; i < left_count; ++i) {
+                offsets_l[num_l] = (Uint8)i;
+                num_l += !LESS(ctx, first, pivot);
+                first += size;
+            }
+            for (i = 0; i < right_count; ++i) {
+                last -= size;
+                offsets_r[num_r] = (Uint8)(i + 1);
+                num_r += LESS(ctx, last, pivot);
+            }
+
+            num = SDL_min(num_l, num_r);
+            swap_offsets(ctx, offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+
+            if (num_l == 0) {
+                start_l = 0;
+                offsets_l_base = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                offsets_r_base = last;
+            }
+        }
+
+        // Only one side can have misplaced elements left, move them next to the split
+        if (num_l) {
+            while (num_l--) {
+                last -= size;
+                sort_swap(ctx, offsets_l_base + offsets_l[start_l + num_l] * size, last);
+            }
+            first = last;
+        }
+        if (num_r) {
+            while (num_r--) {
+                sort_swap(ctx, offsets_r_base - offsets_r[start_r + num_r] * size, first);
+                first += size;
+            }
+            last = first;
+        }
+    }
 
-void SDL_qsort_r(void *base, size_t nmemb, size_t size,
-           SDL_CompareCallback_r compare, void *userdata) {
+    // Put the pivot in place
+    pivot_pos = first - size;
+    if (pivot_pos != begin) {
+        sort_copy(ctx, begin, pivot_pos);
+        sort_copy(ctx, pivot_pos, pivot);
+    }
+    return pivot_pos;
+}
 
-  if (nmemb<=1) return;
-  if (((uintptr_t)base|size)&(WORD_BYTES-1))
-    qsort_r_nonaligned(base,nmemb,size,compare,userdata);
-  else if (size!=WORD_BYTES)
-    qsort_r_aligned(base,nmemb,size,compare,userdata);
-  else
-    qsort_r_words(base,nmemb,compare,userdata);
+/* Partitions [begin, end) around the pivot at *begin, putting elements equal
+   to the pivot on the left. This is used when the pivot equals the element
+   before the range, so everything on the left is equal and already sorted. */
+static char *partition_left(const SDL_SortContext *ctx, char *begin, char *end)
+{
+    const size_t size = ctx->size;
+    char *pivot = ctx->pivot;
+    char *first = begin;
+    char *last = end;
+    char *pivot_pos;
+
+    sort_copy(ctx, pivot, begin);
+
+    do {
+        last -= size;
+    } while (LESS(ctx, pivot, last));
+
+    if (last + size == end) {
+        while (first < last) {
+            first += size;
+            if (LESS(ctx, pivot, first)) {
+                break;
+            }
+        }
+    } else {
+        do {
+            first += size;
+        } while (!LESS(ctx, pivot, first));
+    }
+
+    while (first < last) {
+        sort_swap(ctx, first, last);
+        do {
+            last -= size;
+        } while (LESS(ctx, pivot, last));
+        do {
+            first += size;
+        } while (!LESS(ctx, pivot, first));
+    }
+
+    pivot_pos = last;
+    if (pivot_pos != begin) {
+        sort_copy(ctx, begin, pivot_pos);
+        sort_copy(ctx, pivot_pos, pivot);
+    }
+    return pivot_pos;
+}
+
+static void pdqsort_loop(const SDL_SortContext *ctx, char *begin, char *end, int bad_allowed, bool leftmost)
+{
+    const size_t size = ctx->size;
+
+    for (;;) {
+        const size_t count = (size_t)(end - begin) / size;
+        const size_t half = count / 2;
+        bool already_partitioned;
+        char *pivot_pos;
+        size_t l_count, r_count;
+
+        if (count < ctx->insertion_threshold) {
+            insertion_sort(ctx, begin, end, leftmost);
+            return;
+        }
+
+        // Move the median of a few elements to the start, to use as the pivot
+        if (count > SORT_NINTHER_THRESHOLD) {
+            sort3(ctx, begin, begin + half * size, end - size);
+            sort3(ctx, begin + size, begin + (half - 1) * size, end - 2 * size);
+            sort3(ctx, begin + 2 * size, begin + (half + 1) * size, end - 3 * size);
+            sort3(ctx, begin + (half - 1) * size, begin + half * size, begin + (half + 1) * size);
+            sort_swap(ctx, begin, begin + half * size);
+        } else {
+            sort3(ctx, begin + half * size, begin, end - size);
+        }
+
+        /* If the element before this range is no less than the pivot, the
+           pivot is equal to everything smaller than it here, so split those
+           off and only sort what's left. */
+        if (!leftmost && !LESS(ctx, begin - size, begin)) {
+            begin = partition_left(ctx, begin, end) + size;
+            continue;
+        }
+
+        pivot_pos = partition_right(ctx, begin, end, &already_partitioned);
+        l_count = (size_t)(pivot_pos - begin) / size;
+        r_count = (size_t)(end - (pivot_pos + size)) / size;
+
+        if (l_count < count / 8 || r_count < count / 8) {
+            // A bad split, give up on quicksort if it keeps happening
+            if (--bad_allowed == 0) {
+                heap_sort(ctx, begin, end);
+                return;
+            }
+
+            // Otherwise shuffle a few elements around to break up whatever pattern caused it
+            if (l_count >= ctx->insertion_threshold) {
+                sort_swap(ctx, begin, begin + (l_count / 4) * size);
+                sort_swap(ctx, pivot_pos - size, pivot_pos - (l_count / 4) * size);
+                if (l_count > SORT_NINTHER_THRESHOLD) {
+                    sort_swap(ctx, begin + size, begin + (l_count / 4 + 1) * size);
+                    sort_swap(ctx, begin + 2 * size, begin + (l_count / 4 + 2) * size);
+                    sort_swap(ctx, pivot_pos - 2 * size, pivot_pos - (l_count / 4 + 1) * size);
+                    sort_swap(ctx, pivot_pos - 3 * size, pivot_pos - (l_count / 4 + 2) * size);
+                }
+            }
+            if (r_count >= ctx->insertion_threshold) {
+                sort_swap(ctx, pivot_pos + size, pivot_pos + (1 + r_count / 4) * size);
+                sort_swap(ctx, end - size, end - (r_count / 4) * size);
+                if (r_count > SORT_NINTHER_THRESHOLD) {
+                    sort_swap(ctx, pivot_pos + 2 * size, pivot_pos + (2 + r_count / 4) * size);
+                    sort_swap(ctx, pivot_pos + 3 * size, pivot_pos + (3 + r_count / 4) * size);
+                    sort_swap(ctx, end - 2 * size, end - (1 + r_count / 4) * size);
+                    sort_swap(ctx, end - 3 * size, end - (2 + r_count / 4) * size);
+                }
+            }
+        } else if (already_partitioned &&
+                   partial_insertion_sort(ctx, begin, pivot_pos) &&
+                   partial_insertion_sort(ctx, pivot_pos + size, end)) {
+            // The input was (nearly) sorted already
+            return;
+        }
+
+        // Recurse into the smaller side and loop on the larger one, to bound the stack depth
+        if (l_count < r_count) {
+            pdqsort_loop(ctx, begin, pivot_pos, bad_allowed, leftmost);
+            begin = pivot_pos + size;
+            leftmost = false;
+        } else {
+            pdqsort_loop(ctx, pivot_pos + size, end, bad_allowed, false);
+            end = pivot_pos;
+        }
+    }
+}
+
+void SDL_qsort_r(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    char scratch[2 * SORT_MAX_STACK_ELEMENT_SIZE];
+    char *allocated = NULL;
+    SDL_SortContext ctx;
+    int bad_allowed = 0;
+    size_t n;
+
+    if (nmemb <= 1 || size == 0) {
+        return;
+    }
+
+    ctx.size = size;
+    if ((size == sizeof(Uint32) || size == sizeof(Uint64)) && ((uintptr_t)base & (size - 1)) == 0) {
+        ctx.word_size = size;
+    } else {
+        ctx.word_size = 0;
+    }
+    ctx.compare = compare;
+    ctx.userdata = userdata;
+
+    // Moving big elements costs more than comparing them, so stop insertion sort sooner
+    if (size <= 16) {
+        ctx.insertion_threshold = 24;
+    } else if (size <= 64) {
+        ctx.insertion_threshold = 16;
+    } else {
+        ctx.insertion_threshold = 8;
+    }
+
+    if (size <= SORT_MAX_STACK_ELEMENT_SIZE) {
+        ctx.pivot = scratch;
+    } else {
+        allocated = (char *)SDL_malloc(2 * size);
+        if (!allocated) {
+            // Without room for temporary elements we can only swap them, which heapsort can live with
+            ctx.pivot = ctx.hole = NULL;
+            heap_sort(&ctx, (char *)base, (char *)base + nmemb * size);
+            return;
+        }
+        ctx.pivot = allocated;
+    }
+    ctx.hole = ctx.pivot + size;
+
+    for (n = nmemb; n > 1; n >>= 1) {
+        ++bad_allowed;
+    }
+    pdqsort_loop(&ctx, (char *)base, (char *)base + nmemb * size, bad_allowed, true);
+
+    SDL_free(allocated);
+}
+
+/* Sorting by integer key is a least significant digit radix sort, a byte per
+   pass, skipping passes where every key has the same digit. Below this many
+   elements an insertion sort is quicker than clearing the histograms. */
+#define RADIX_SORT_THRESHOLD 64
+
+static SDL_INLINE Uint32 read_sort_key(const char *element, size_t key_offset)
+{
+    Uint32 key;
+    SDL_memcpy(&key, element + key_offset, sizeof(key));
+    return key;
+}
+
+bool SDL_qsort_by_key(void *base, size_t nmemb, size_t size, size_t key_offset)
+{
+    Uint32 counts[sizeof(Uint32)][256];
+    char *src = (char *)base;
+    char *dst, *scratch;
+    size_t total, i;
+    int digit;
+
+    if (nmemb > 0 && !base) {
+        return SDL_InvalidParamError("base");
+    }
+    if (size < sizeof(Uint32) || key_offset > size - sizeof(Uint32)) {
+        return SDL_InvalidParamError("key_offset");
+    }
+    if (nmemb <= 1) {
+        return true;
+    }
+
+    if (nmemb < RADIX_SORT_THRESHOLD && size <= SORT_MAX_STACK_ELEMENT_SIZE) {
+        char hole[SORT_MAX_STACK_ELEMENT_SIZE];
+        for (i = 1; i < nmemb; ++i) {
+            const Uint32 key = read_sort_key(src + i * size, key_offset);
+            size_t j = i;
+            if (read_sort_key(src + (j - 1) * size, key_offset) <= key) {
+                continue;
+            }
+            SDL_memcpy(hole, src + i * size, size);
+            do {
+                SDL_memcpy(src + j * size, src + (j - 1) * size, size);
+                --j;
+            } while (j > 0 && read_sort_key(src + (j - 1) * size, key_offset) > key);
+            SDL_memcpy(src + j * size, hole, size);
+        }
+        return true;
+    }
+
+    if (nmemb > SDL_MAX_UINT32 || !SDL_size_mul_check_overflow(nmemb, size, &total)) {
+        return SDL_SetError("Array is too large to sort");
+    }
+    scratch = (char *)SDL_malloc(total);
+    if (!scratch) {
+        return false;
+    }
+
+    SDL_zeroa(counts);
+    for (i = 0; i < nmemb; ++i) {
+        const Uint32 key = read_sort_key(src + i * size, key_offset);
+        ++counts[0][key & 0xFF];
+        ++counts[1][(key >> 8) & 0xFF];
+        ++counts[2][(key >> 16) & 0xFF];
+        ++counts[3][key >> 24];
+    }
+
+    dst = scratch;
+    for (digit = 0; digit < (int)sizeof(Uint32); ++digit) {
+        const int shift = digit * 8;
+        Uint32 *offsets = counts[digit];
+        Uint32 sum = 0;
+        char *tmp;
+        int b;
+
+        // Every element is in the same bucket, this pass wouldn't change anything
+        if (offsets[(read_sort_key(src, key_offset) >> shift) & 0xFF] == nmemb) {
+            continue;
+        }
+
+        for (b = 0; b < 256; ++b) {
+            const Uint32 count = offsets[b];
+            offsets[b] = sum;
+            sum += count;
+        }
+        for (i = 0; i < nmemb; ++i) {
+            const char *element = src + i * size;
+            const Uint32 bucket = (read_sort_key(element, key_offset) >> shift) & 0xFF;
+            SDL_memcpy(dst + (size_t)offsets[bucket]++ * size, element, size);
+        }
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != (char *)base) {
+        SDL_memcpy(base, src, total);
+    }
+    SDL_free(scratch);
+    return true;
 }
 
 static int SDLCALL qsort_non_r_bridge(void *userdata, const void *a, const void *b)
@@ -22,6 +22,15 @@
 
 // This file contains portable random functions for SDL
 
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define RAND_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define RAND_NEON
+#endif
+
+// The bulk fill functions generate this many values at a time on the stack
+#define RAND_FILL_BATCH 256
+
 static Uint64 SDL_rand_state;
 static bool SDL_rand_initialized = false;
 
@@ -61,6 +70,33 @@ Uint32 SDL_rand_bits(void)
     return SDL_rand_bits_r(&SDL_rand_state);
 }
 
+bool SDL_rand_fill(Sint32 *values, int count, Sint32 n)
+{
+    if (!SDL_rand_initialized) {
+        SDL_srand(0);
+    }
+
+    return SDL_rand_fill_r(&SDL_rand_state, values, count, n);
+}
+
+bool SDL_rand_fill_float(float *values, int count)
+{
+    if (!SDL_rand_initialized) {
+        SDL_srand(0);
+    }
+
+    return SDL_rand_fill_float_r(&SDL_rand_state, values, count);
+}
+
+bool SDL_rand_fill_bits(Uint32 *values, int count)
+{
+    if (!SDL_rand_initialized) {
+        SDL_srand(0);
+    }
+
+    return SDL_rand_fill_bits_r(&SDL_rand_state, values, count);
+}
+
 Uint32 SDL_rand_bits_r(Uint64 *state)
 {
     if (!state) {
@@ -113,3 +149,161 @@ float SDL_randf_r(Uint64 *state)
     return (SDL_rand_bits_r(state) >> (32 - 24)) * 0x1p-24f;
 }
 
+
+/* The bulk functions step the LCG four times per iteration. Each of the four
+   states is computed straight from the previous block's last state with the
+   constants for A^k and C*(A^(k-1) + ... + 1), so the multiplies don't depend
+   on each other and the loop isn't limited by the latency of one long chain.
+   The output is exactly what the same number of SDL_rand_bits_r() calls
+   would return. */
+#define RAND_A1 SDL_UINT64_C(0x00000000ff1cd035)
+#define RAND_C1 SDL_UINT64_C(0x0000000000000005)
+#define RAND_A2 SDL_UINT64_C(0xfe3a6a07caee2af9)
+#define RAND_C2 SDL_UINT64_C(0x00000004fb90110e)
+#define RAND_A3 SDL_UINT64_C(0x743bb7594075358d)
+#define RAND_C3 SDL_UINT64_C(0xf724122bf236e7eb)
+#define RAND_A4 SDL_UINT64_C(0x8a4d4702e232a631)
+#define RAND_C4 SDL_UINT64_C(0x3c4ea6ea3480f3ac)
+
+static void SDL_rand_generate(Uint64 *state, Uint32 *values, int count)
+{
+    Uint64 s = *state;
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        const Uint64 s1 = s * RAND_A1 + RAND_C1;
+        const Uint64 s2 = s * RAND_A2 + RAND_C2;
+        const Uint64 s3 = s * RAND_A3 + RAND_C3;
+        const Uint64 s4 = s * RAND_A4 + RAND_C4;
+        values[i + 0] = (Uint32)(s1 >> 32);
+        values[i + 1] = (Uint32)(s2 >> 32);
+        values[i + 2] = (Uint32)(s3 >> 32);
+        values[i + 3] = (Uint32)(s4 >> 32);
+        s = s4;
+    }
+    for (; i < count; ++i) {
+        s = s * RAND_A1 + RAND_C1;
+        values[i] = (Uint32)(s >> 32);
+    }
+
+    *state = s;
+}
+
+static void SDL_rand_bits_to_range(const Uint32 *bits, Sint32 *values, int count, Sint32 n)
+{
+    int i = 0;
+
+#if defined(RAND_SSE2)
+    const __m128i range = _mm_set1_epi32(n);
+    const __m128i odd_mask = _mm_set_epi32(-1, 0, -1, 0);
+    for (; i + 4 <= count; i += 4) {
+        const __m128i v = _mm_loadu_si128((const __m128i *)(bits + i));
+        const __m128i even = _mm_srli_epi64(_mm_mul_epu32(v, range), 32);
+        const __m128i odd = _mm_and_si128(_mm_mul_epu32(_mm_srli_epi64(v, 32), range), odd_mask);
+        _mm_storeu_si128((__m128i *)(values + i), _mm_or_si128(even, odd));
+    }
+#elif defined(RAND_NEON)
+    const uint32x2_t range = vdup_n_u32((uint32_t)n);
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t v = vld1q_u32(bits + i);
+        const uint32x2_t lo = vshrn_n_u64(vmull_u32(vget_low_u32(v), range), 32);
+        const uint32x2_t hi = vshrn_n_u64(vmull_u32(vget_high_u32(v), range), 32);
+        vst1q_s32(values + i, vreinterpretq_s32_u32(vcombine_u32(lo, hi)));
+    }
+#endif
+    for (; i < count; ++i) {
+        values[i] = (Sint32)(((Uint64)bits[i] * n) >> 32);
+    }
+}
+
+static void SDL_rand_bits_to_float(const Uint32 *bits, float *values, int count)
+{
+    int i = 0;
+
+#if defined(RAND_SSE2)
+    const __m128 scale = _mm_set1_ps(0x1p-24f);
+    for (; i + 4 <= count; i += 4) {
+        // After the shift the values fit in 24 bits, so the signed conversion is exact
+        const __m128i v = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)(bits + i)), 32 - 24);
+        _mm_storeu_ps(values + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+    }
+#elif defined(RAND_NEON)
+    for (; i + 4 <= count; i += 4) {
+        const uint32x4_t v = vshrq_n_u32(vld1q_u32(bits + i), 32 - 24);
+        vst1q_f32(values + i, vmulq_n_f32(vcvtq_f32_u32(v), 0x1p-24f));
+    }
+#endif
+    for (; i < count; ++i) {
+        values[i] = (bits[i] >> (32 - 24)) * 0x1p-24f;
+    }
+}
+
+bool SDL_rand_fill_bits_r(Uint64 *state, Uint32 *values, int count)
+{
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+    if (!values && count > 0) {
+        return SDL_InvalidParamError("values");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    SDL_rand_generate(state, values, count);
+    return true;
+}
+
+bool SDL_rand_fill_r(Uint64 *state, Sint32 *values, int count, Sint32 n)
+{
+    Uint32 bits[RAND_FILL_BATCH];
+
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+    if (!values && count > 0) {
+        return SDL_InvalidParamError("values");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    if (n < 0) {
+        // Match SDL_rand_r(), which returns 0 without touching the state
+        SDL_memset(values, 0, count * sizeof(*values));
+        return true;
+    }
+
+    while (count > 0) {
+        const int batch = SDL_min(count, RAND_FILL_BATCH);
+        SDL_rand_generate(state, bits, batch);
+        SDL_rand_bits_to_range(bits, values, batch, n);
+        values += batch;
+        count -= batch;
+    }
+    return true;
+}
+
+bool SDL_rand_fill_float_r(Uint64 *state, float *values, int count)
+{
+    Uint32 bits[RAND_FILL_BATCH];
+
+    if (!state) {
+        return SDL_InvalidParamError("state");
+    }
+    if (!values && count > 0) {
+        return SDL_InvalidParamError("values");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+
+    while (count > 0) {
+        const int batch = SDL_min(count, RAND_FILL_BATCH);
+        SDL_rand_generate(state, bits, batch);
+        SDL_rand_bits_to_float(bits, values, batch);
+        values += batch;
+        count -= batch;
+    }
+    return true;
+}
@@ -220,8 +220,9 @@ static Uint32 StepUTF8(const char **_str, const size_t slen)
             }
         }
     } else if (((octet & 0xF0) == 0xE0) && (slen >= 3)) {  // 1110xxxx 10xxxxxx 10xxxxxx: three byte codepoint.
+        // Check each trailing byte before reading the next, so we don't read past a null terminator.
         const Uint8 str1 = str[1];
-        const Uint8 str2 = str[2];
+        const Uint8 str2 = ((str1 & 0xC0) == 0x80) ? str[2] : 0;
         if (((str1 & 0xC0) == 0x80) && ((str2 & 0xC0) == 0x80)) {  // If trailing bytes aren't 10xxxxxx, sequence is bogus.
             const Uint32 octet2 = ((Uint32) (str1 & 0x3F)) << 6;
             const Uint32 octet3 = ((Uint32) (str2 & 0x3F));
@@ -235,8 +236,8 @@ static Uint32 StepUTF8(const char **_str, const size_t slen)
         }
     } else if (((octet & 0xF8) == 0xF0) && (slen >= 4)) {  // 11110xxxx 10xxxxxx 10xxxxxx 10xxxxxx: four byte codepoint.
         const Uint8 str1 = str[1];
-        const Uint8 str2 = str[2];
-        const Uint8 str3 = str[3];
+        const Uint8 str2 = ((str1 & 0xC0) == 0x80) ? str[2] : 0;
+        const Uint8 str3 = ((str2 & 0xC0) == 0x80) ? str[3] : 0;
         if (((str1 & 0xC0) == 0x80) && ((str2 & 0xC0) == 0x80) && ((str3 & 0xC0) == 0x80)) {  // If trailing bytes aren't 10xxxxxx, sequence is bogus.
             const Uint32 octet2 = ((Uint32) (str1 & 0x1F)) << 12;
             const Uint32 octet3 = ((Uint32) (str2 & 0x3F)) << 6;
@@ -690,6 +691,182 @@ static size_t SDL_ScanFloat(const char *text, double *valuep)
 }
 #endif
 
+/* Byte scanning used by the string functions below when the C runtime versions
+   aren't available. These read a whole aligned chunk (or word) at a time, which
+   may look at bytes past the end of the string, but never past the end of the
+   aligned block containing it, so it can't fault. */
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STRING_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define STRING_NEON
+#endif
+
+// Reading past the end of the string upsets AddressSanitizer, even though it's safe
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define STRING_NO_SANITIZE __attribute__((no_sanitize_address))
+#endif
+#elif defined(__SANITIZE_ADDRESS__)
+#define STRING_NO_SANITIZE __attribute__((no_sanitize_address))
+#endif
+#ifndef STRING_NO_SANITIZE
+#define STRING_NO_SANITIZE
+#endif
+
+typedef enum StringScan
+{
+    STRING_SCAN_BYTE,           // stop at the byte `c`
+    STRING_SCAN_BYTE_OR_NUL,    // stop at the byte `c` or a null terminator
+    STRING_SCAN_NON_ASCII       // stop at a null terminator or a byte >= 0x80
+} StringScan;
+
+static SDL_INLINE bool scan_byte_matches(Uint8 byte, Uint8 c, StringScan scan)
+{
+    switch (scan) {
+    case STRING_SCAN_BYTE:
+        return byte == c;
+    case STRING_SCAN_BYTE_OR_NUL:
+        return byte == c || byte == 0;
+    default:
+        return byte == 0 || byte >= 0x80;
+    }
+}
+
+#if defined(STRING_SSE2) || defined(STRING_NEON)
+#define STRING_CHUNK_SIZE 16
+
+// Returns a mask with bit N set if byte N of the aligned chunk matches
+static STRING_NO_SANITIZE SDL_INLINE Uint32 scan_chunk(const Uint8 *chunk, Uint8 c, StringScan scan)
+{
+#ifdef STRING_SSE2
+    const __m128i bytes = _mm_load_si128((const __m128i *)chunk);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i matches;
+
+    switch (scan) {
+    case STRING_SCAN_BYTE:
+        matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)c));
+        break;
+    case STRING_SCAN_BYTE_OR_NUL:
+        matches = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char)c)), _mm_cmpeq_epi8(bytes, zero));
+        break;
+    default:
+        // movemask picks up the high bit, which is set exactly for the non-ASCII bytes
+        matches = _mm_or_si128(bytes, _mm_cmpeq_epi8(bytes, zero));
+        break;
+    }
+    return (Uint32)_mm_movemask_epi8(matches);
+#else
+    static const Uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bytes = vld1q_u8(chunk);
+    const uint8x16_t zero = vdupq_n_u8(0);
+    uint8x16_t matches;
+
+    switch (scan) {
+    case STRING_SCAN_BYTE:
+        matches = vceqq_u8(bytes, vdupq_n_u8(c));
+        break;
+    case STRING_SCAN_BYTE_OR_NUL:
+        matches = vorrq_u8(vceqq_u8(bytes, vdupq_n_u8(c)), vceqq_u8(bytes, zero));
+        break;
+    default:
+        matches = vorrq_u8(vcgeq_u8(bytes, vdupq_n_u8(0x80)), vceqq_u8(bytes, zero));
+        break;
+    }
+    matches = vandq_u8(matches, vld1q_u8(bits));
+    return (Uint32)vaddv_u8(vget_low_u8(matches)) | ((Uint32)vaddv_u8(vget_high_u8(matches)) << 8);
+#endif
+}
+
+static SDL_INLINE Uint32 lowest_bit_index(Uint32 mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (Uint32)__builtin_ctz(mask);
+#else
+    Uint32 index = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/* Returns the offset of the first matching byte in the first `len` bytes of
+   `str`, or `len` if there isn't one. `len` may be SIZE_MAX for strings that
+   are known to contain the byte being looked for. */
+static STRING_NO_SANITIZE size_t scan_string(const char *str, size_t len, Uint8 c, StringScan scan)
+{
+    const Uint8 *start = (const Uint8 *)str;
+    const Uint8 *chunk = (const Uint8 *)((uintptr_t)start & ~(uintptr_t)(STRING_CHUNK_SIZE - 1));
+    const size_t skipped = (size_t)(start - chunk);
+    size_t available = STRING_CHUNK_SIZE - skipped;  // bytes of the string in the chunks we've looked at
+    Uint32 mask;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    mask = scan_chunk(chunk, c, scan) & (0xFFFFu << skipped);
+    for (;;) {
+        if (mask) {
+            const size_t offset = (size_t)(chunk + lowest_bit_index(mask) - start);
+            return SDL_min(offset, len);
+        }
+        if (available >= len) {
+            return len;
+        }
+        chunk += STRING_CHUNK_SIZE;
+        available += STRING_CHUNK_SIZE;
+        mask = scan_chunk(chunk, c, scan);
+    }
+}
+
+#else
+#define STRING_WORD_ONES ((size_t)-1 / 0xFF)
+#define STRING_WORD_HIGHS (STRING_WORD_ONES * 0x80)
+#define STRING_WORD_HAS_ZERO(w) (((w) - STRING_WORD_ONES) & ~(w) & STRING_WORD_HIGHS)
+
+static SDL_INLINE bool scan_word_matches(size_t word, size_t pattern, StringScan scan)
+{
+    switch (scan) {
+    case STRING_SCAN_BYTE:
+        return STRING_WORD_HAS_ZERO(word ^ pattern) != 0;
+    case STRING_SCAN_BYTE_OR_NUL:
+        return (STRING_WORD_HAS_ZERO(word) | STRING_WORD_HAS_ZERO(word ^ pattern)) != 0;
+    default:
+        return ((word & STRING_WORD_HIGHS) | STRING_WORD_HAS_ZERO(word)) != 0;
+    }
+}
+
+/* Returns the offset of the first matching byte in the first `len` bytes of
+   `str`, or `len` if there isn't one. `len` may be SIZE_MAX for strings that
+   are known to contain the byte being looked for. */
+static STRING_NO_SANITIZE size_t scan_string(const char *str, size_t len, Uint8 c, StringScan scan)
+{
+    const Uint8 *bytes = (const Uint8 *)str;
+    const size_t pattern = STRING_WORD_ONES * c;
+    size_t i = 0;
+
+    while (i < len && ((uintptr_t)(bytes + i) & (sizeof(size_t) - 1))) {
+        if (scan_byte_matches(bytes[i], c, scan)) {
+            return i;
+        }
+        ++i;
+    }
+    while ((len - i) >= sizeof(size_t) && !scan_word_matches(*(const size_t *)(bytes + i), pattern, scan)) {
+        i += sizeof(size_t);
+    }
+    while (i < len) {
+        if (scan_byte_matches(bytes[i], c, scan)) {
+            return i;
+        }
+        ++i;
+    }
+    return len;
+}
+#endif // STRING_SSE2 || STRING_NEON
+
 int SDL_memcmp(const void *s1, const void *s2, size_t len)
 {
 #ifdef SDL_PLATFORM_VITA
@@ -719,16 +896,22 @@ int SDL_memcmp(const void *s1, const void *s2, size_t len)
 #endif // HAVE_MEMCMP
 }
 
+void *SDL_memchr(const void *buf, int c, size_t len)
+{
+#ifdef HAVE_MEMCHR
+    return SDL_const_cast(void *, memchr(buf, c, len));
+#else
+    const size_t offset = scan_string((const char *)buf, len, (Uint8)c, STRING_SCAN_BYTE);
+    return (offset < len) ? (void *)((const Uint8 *)buf + offset) : NULL;
+#endif // HAVE_MEMCHR
+}
+
 size_t SDL_strlen(const char *string)
 {
 #ifdef HAVE_STRLEN
     return strlen(string);
 #else
-    size_t len = 0;
-    while (*string++) {
-        ++len;
-    }
-    return len;
+    return scan_string(string, SIZE_MAX, 0, STRING_SCAN_BYTE);
 #endif // HAVE_STRLEN
 }
 
@@ -737,11 +920,7 @@ size_t SDL_strnlen(const char *string, size_t maxlen)
 #ifdef HAVE_STRNLEN
     return strnlen(string, maxlen);
 #else
-    size_t len = 0;
-    while (len < maxlen && *string++) {
-        ++len;
-    }
-    return len;
+    return scan_string(string, maxlen, 0, STRING_SCAN_BYTE);
 #endif // HAVE_STRNLEN
 }
 
@@ -974,7 +1153,14 @@ size_t SDL_utf8strlcpy(SDL_OUT_Z_CAP(dst_bytes) char *dst, const char *src, size
 size_t SDL_utf8strlen(const char *str)
 {
     size_t result = 0;
-    while (SDL_StepUTF8(&str, NULL)) {
+    for (;;) {
+        // Runs of ASCII are one codepoint per byte, only decode the rest
+        const size_t ascii = scan_string(str, SIZE_MAX, 0, STRING_SCAN_NON_ASCII);
+        result += ascii;
+        str += ascii;
+        if (!StepUTF8(&str, 4)) {
+            break;
+        }
         result++;
     }
     return result;
@@ -983,7 +1169,14 @@ size_t SDL_utf8strlen(const char *str)
 size_t SDL_utf8strnlen(const char *str, size_t bytes)
 {
     size_t result = 0;
-    while (SDL_StepUTF8(&str, &bytes)) {
+    for (;;) {
+        const size_t ascii = scan_string(str, bytes, 0, STRING_SCAN_NON_ASCII);
+        result += ascii;
+        str += ascii;
+        bytes -= ascii;
+        if (!SDL_StepUTF8(&str, &bytes)) {
+            break;
+        }
         result++;
     }
     return result;
@@ -1069,16 +1262,8 @@ char *SDL_strchr(const char *string, int c)
 #elif defined(HAVE_INDEX)
     return SDL_const_cast(char *, index(string, c));
 #else
-    while (*string) {
-        if (*string == c) {
-            return (char *)string;
-        }
-        ++string;
-    }
-    if (c == '\0') {
-        return (char *)string;
-    }
-    return NULL;
+    const char *found = string + scan_string(string, SIZE_MAX, (Uint8)c, STRING_SCAN_BYTE_OR_NUL);
+    return (*found == (char)c) ? (char *)found : NULL;
 #endif // HAVE_STRCHR
 }
 
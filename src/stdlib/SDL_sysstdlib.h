@@ -28,5 +28,19 @@
 // this expects `from` to be a Unicode codepoint, and `to` to point to AT LEAST THREE Uint32s.
 int SDL_CaseFoldUnicode(Uint32 from, Uint32 *to);
 
+// Attribute allocations on this thread to a subsystem until SDL_PopMemoryTag() is called with the returned cookie.
+// This does nothing unless replacement memory functions are installed.
+int SDL_PushMemoryTag(SDL_MemoryTag tag);
+void SDL_PopMemoryTag(int cookie);
+
+// Evaluate a math function over `count` floats with SIMD where available, `dst` may be the same as `src`.
+// Results are within a few ULP of the scalar functions, see SDL_mathbatch.c for the input ranges covered.
+void SDL_sinf_array(float *dst, const float *src, int count);
+void SDL_cosf_array(float *dst, const float *src, int count);
+void SDL_expf_array(float *dst, const float *src, int count);
+void SDL_logf_array(float *dst, const float *src, int count);
+void SDL_powf_array(float *dst, const float *src, float y, int count);
+void SDL_sqrtf_array(float *dst, const float *src, int count);
+
 #endif
 
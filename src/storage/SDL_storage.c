@@ -23,6 +23,7 @@
 
 #include "SDL_sysstorage.h"
 #include "../filesystem/SDL_sysfilesystem.h"
+#include "../io/SDL_asyncio_c.h"
 
 // Available title storage drivers
 static TitleStorageBootStrap *titlebootstrap[] = {
@@ -45,6 +46,9 @@ static UserStorageBootStrap *userbootstrap[] = {
 struct SDL_Storage
 {
     SDL_StorageInterface iface;
+    const SDL_StorageAsyncInterface *async;
+    SDL_StorageOpenFileFunc open_file;
+    SDL_AtomicInt pending_async;  // transfers running on job threads, which SDL_CloseStorage waits for.
     void *userdata;
 };
 
@@ -175,6 +179,11 @@ SDL_Storage *SDL_OpenFileStorage(const char *path)
     return GENERIC_OpenFileStorage(path);
 }
 
+SDL_Storage *SDL_OpenArchiveStorage(SDL_IOStream *src, bool closeio)
+{
+    return ARCHIVE_OpenStorage(src, closeio);
+}
+
 SDL_Storage *SDL_OpenStorage(const SDL_StorageInterface *iface, void *userdata)
 {
     SDL_Storage *storage;
@@ -197,12 +206,31 @@ SDL_Storage *SDL_OpenStorage(const SDL_StorageInterface *iface, void *userdata)
     return storage;
 }
 
+void SDL_SetStorageAsyncInterface(SDL_Storage *storage, const SDL_StorageAsyncInterface *iface)
+{
+    if (storage) {
+        storage->async = iface;
+    }
+}
+
+void SDL_SetStorageOpenFileFunction(SDL_Storage *storage, SDL_StorageOpenFileFunc open_file)
+{
+    if (storage) {
+        storage->open_file = open_file;
+    }
+}
+
 bool SDL_CloseStorage(SDL_Storage *storage)
 {
     bool result = true;
 
     CHECK_STORAGE_MAGIC()
 
+    // the job threads are still using the backend, let them finish first.
+    while (SDL_GetAtomicInt(&storage->pending_async) > 0) {
+        SDL_Delay(1);
+    }
+
     if (storage->iface.close) {
         result = storage->iface.close(storage->userdata);
     }
@@ -267,6 +295,164 @@ bool SDL_WriteStorageFile(SDL_Storage *storage, const char *path, const void *so
     return storage->iface.write_file(storage->userdata, path, source, length);
 }
 
+static void SDLCALL FreeStorageFileBuffer(void *userdata, void *value)
+{
+    SDL_free(value);
+}
+
+SDL_IOStream *SDL_OpenStorageFile(SDL_Storage *storage, const char *path)
+{
+    CHECK_STORAGE_MAGIC_RET(NULL)
+
+    if (!path) {
+        SDL_InvalidParamError("path");
+        return NULL;
+    } else if (!ValidateStoragePath(path)) {
+        return NULL;
+    } else if (storage->open_file) {
+        return storage->open_file(storage->userdata, path);
+    } else if (!storage->iface.read_file) {
+        SDL_Unsupported();
+        return NULL;
+    }
+
+    Uint64 length;
+    if (!SDL_GetStorageFileSize(storage, path, &length)) {
+        return NULL;
+    } else if (length >= SDL_SIZE_MAX) {
+        SDL_SetError("File is too large to load into memory");
+        return NULL;
+    }
+
+    void *data = SDL_malloc((size_t)length + 1);  // + 1 so an empty file still gets a buffer.
+    if (!data) {
+        return NULL;
+    } else if (!storage->iface.read_file(storage->userdata, path, data, length)) {
+        SDL_free(data);
+        return NULL;
+    }
+
+    // the stream frees the buffer when its properties are destroyed on SDL_CloseIO().
+    SDL_IOStream *stream = SDL_IOFromConstMem(data, (size_t)length);
+    if (!stream) {
+        SDL_free(data);
+        return NULL;
+    } else if (!SDL_SetPointerPropertyWithCleanup(SDL_GetIOProperties(stream), "SDL.storage.file.buffer", data, FreeStorageFileBuffer, NULL)) {
+        SDL_CloseIO(stream);  // the cleanup has already freed data.
+        return NULL;
+    }
+    return stream;
+}
+
+typedef struct StorageAsyncJob
+{
+    SDL_Storage *storage;
+    struct SDL_AsyncIOGroup *outcome;
+    SDL_AsyncIOTaskType type;
+    char *path;
+    void *buffer;
+    Uint64 length;
+    void *userdata;
+} StorageAsyncJob;
+
+static void SDLCALL RunStorageAsyncJob(void *userdata)
+{
+    StorageAsyncJob *job = (StorageAsyncJob *)userdata;
+    SDL_Storage *storage = job->storage;
+    bool result;
+
+    if (job->type == SDL_ASYNCIO_TASK_WRITE) {
+        result = storage->iface.write_file(storage->userdata, job->path, job->buffer, job->length);
+    } else {
+        result = storage->iface.read_file(storage->userdata, job->path, job->buffer, job->length);
+    }
+
+    SDL_AsyncIOOutcome outcome;
+    SDL_zero(outcome);
+    outcome.type = job->type;
+    outcome.result = result ? SDL_ASYNCIO_COMPLETE : SDL_ASYNCIO_FAILURE;
+    outcome.buffer = job->buffer;
+    outcome.bytes_requested = job->length;
+    outcome.bytes_transferred = result ? job->length : 0;
+    outcome.userdata = job->userdata;
+    SDL_PostAsyncIOOutcome(job->outcome, &outcome);
+
+    SDL_free(job->path);
+    SDL_free(job);
+    SDL_AddAtomicInt(&storage->pending_async, -1);  // last, SDL_CloseStorage might free storage right after this.
+}
+
+static bool SubmitStorageAsyncJob(SDL_Storage *storage, SDL_AsyncIOTaskType type, const char *path, void *buffer, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    StorageAsyncJob *job = (StorageAsyncJob *)SDL_calloc(1, sizeof(*job));
+    if (!job) {
+        return false;
+    }
+    job->path = SDL_strdup(path);
+    job->outcome = SDL_ReserveAsyncIOOutcome(queue);
+    if (!job->path || !job->outcome) {
+        goto failed;
+    }
+    job->storage = storage;
+    job->type = type;
+    job->buffer = buffer;
+    job->length = length;
+    job->userdata = userdata;
+
+    SDL_AddAtomicInt(&storage->pending_async, 1);
+    if (!SDL_SubmitJob(RunStorageAsyncJob, job)) {
+        SDL_AddAtomicInt(&storage->pending_async, -1);
+        goto failed;
+    }
+    return true;
+
+failed:
+    if (job->outcome) {
+        SDL_ReleaseAsyncIOOutcome(job->outcome);
+    }
+    SDL_free(job->path);
+    SDL_free(job);
+    return false;
+}
+
+bool SDL_ReadStorageFileAsync(SDL_Storage *storage, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    CHECK_STORAGE_MAGIC()
+
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!ValidateStoragePath(path)) {
+        return false;
+    } else if (storage->async && storage->async->read_file) {
+        return storage->async->read_file(storage->userdata, path, destination, length, queue, userdata);
+    } else if (!storage->iface.read_file) {
+        return SDL_Unsupported();
+    }
+
+    return SubmitStorageAsyncJob(storage, SDL_ASYNCIO_TASK_READ, path, destination, length, queue, userdata);
+}
+
+bool SDL_WriteStorageFileAsync(SDL_Storage *storage, const char *path, const void *source, Uint64 length, SDL_AsyncIOQueue *queue, void *userdata)
+{
+    CHECK_STORAGE_MAGIC()
+
+    if (!path) {
+        return SDL_InvalidParamError("path");
+    } else if (!queue) {
+        return SDL_InvalidParamError("queue");
+    } else if (!ValidateStoragePath(path)) {
+        return false;
+    } else if (storage->async && storage->async->write_file) {
+        return storage->async->write_file(storage->userdata, path, source, length, queue, userdata);
+    } else if (!storage->iface.write_file) {
+        return SDL_Unsupported();
+    }
+
+    return SubmitStorageAsyncJob(storage, SDL_ASYNCIO_TASK_WRITE, path, (void *)source, length, queue, userdata);
+}
+
 bool SDL_CreateStorageDirectory(SDL_Storage *storage, const char *path)
 {
     CHECK_STORAGE_MAGIC()
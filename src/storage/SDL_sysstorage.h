@@ -48,5 +48,23 @@ extern UserStorageBootStrap PRIVATE_userbootstrap;
 extern UserStorageBootStrap STEAM_userbootstrap;
 
 extern SDL_Storage *GENERIC_OpenFileStorage(const char *path);
+extern SDL_Storage *ARCHIVE_OpenStorage(SDL_IOStream *src, bool closeio);
+
+// Backends that can do transfers without blocking set this after SDL_OpenStorage(); the app's
+// SDL_AsyncIOQueue gets each outcome. Anything left NULL runs the regular read_file/write_file
+// on a job thread instead.
+typedef struct SDL_StorageAsyncInterface
+{
+    bool (*read_file)(void *userdata, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *app_userdata);
+    bool (*write_file)(void *userdata, const char *path, const void *source, Uint64 length, SDL_AsyncIOQueue *queue, void *app_userdata);
+} SDL_StorageAsyncInterface;
+
+extern void SDL_SetStorageAsyncInterface(SDL_Storage *storage, const SDL_StorageAsyncInterface *iface);
+
+// Backends that can stream a file set this after SDL_OpenStorage(); otherwise
+// SDL_OpenStorageFile() reads the whole file into memory with read_file.
+typedef SDL_IOStream *(*SDL_StorageOpenFileFunc)(void *userdata, const char *path);
+
+extern void SDL_SetStorageOpenFileFunction(SDL_Storage *storage, SDL_StorageOpenFileFunc open_file);
 
 #endif // SDL_sysstorage_h_
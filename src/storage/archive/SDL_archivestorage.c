@@ -0,0 +1,562 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include "SDL_internal.h"
+
+#include "../SDL_sysstorage.h"
+#include "../../io/SDL_iostream_c.h"
+
+/* A read-only SDL_Storage over a single archive file, see SDL_OpenArchiveStorage() for the layout.
+
+   The directory is read and checked up front, and everything after that is offset reads from the one
+   stream, serialized by a mutex. Streams opened from the archive keep it alive, so the app can close
+   the storage container before it's done with them. */
+
+#define ARCHIVE_HEADER_SIZE 24
+#define ARCHIVE_ENTRY_SIZE 32
+#define ARCHIVE_VERSION 1
+
+#define ARCHIVE_COMPRESSION_NONE 0
+#define ARCHIVE_COMPRESSION_LZ4 1
+
+typedef struct ArchiveEntry
+{
+    Uint64 offset;          // of the stored data, in the archive
+    Uint64 stored_size;
+    Uint64 size;
+    const char *path;       // points into the name table, not null-terminated
+    Uint16 path_len;
+    Uint8 compression;
+} ArchiveEntry;
+
+typedef struct ArchiveStorage
+{
+    SDL_IOStream *io;
+    bool closeio;
+    SDL_Mutex *lock;        // serializes the seek and read pairs on io
+    SDL_AtomicInt refcount; // the storage container, plus each open stream
+    Uint8 *directory;       // the name table lives in here
+    ArchiveEntry *entries;  // sorted by path
+    Uint32 num_entries;
+    Uint16 max_path_len;
+} ArchiveStorage;
+
+static void ReleaseArchive(ArchiveStorage *archive)
+{
+    if (SDL_AtomicDecRef(&archive->refcount)) {
+        if (archive->closeio) {
+            SDL_CloseIO(archive->io);
+        }
+        SDL_DestroyMutex(archive->lock);
+        SDL_free(archive->entries);
+        SDL_free(archive->directory);
+        SDL_free(archive);
+    }
+}
+
+static bool ReadArchive(ArchiveStorage *archive, Uint64 offset, void *ptr, size_t size)
+{
+    bool result = false;
+
+    SDL_LockMutex(archive->lock);
+    if (SDL_SeekIO(archive->io, (Sint64)offset, SDL_IO_SEEK_SET) == (Sint64)offset) {
+        if (SDL_ReadIO(archive->io, ptr, size) == size) {
+            result = true;
+        } else if (SDL_GetIOStatus(archive->io) == SDL_IO_STATUS_EOF) {
+            SDL_SetError("Archive is truncated");
+        }
+    }
+    SDL_UnlockMutex(archive->lock);
+
+    return result;
+}
+
+// Fills dst with the first dstlen bytes of an entry.
+static bool ReadArchiveEntry(ArchiveStorage *archive, const ArchiveEntry *entry, void *dst, Uint64 dstlen)
+{
+    if (dstlen > entry->size) {
+        return SDL_SetError("File length did not exactly match the destination length");
+    } else if (entry->compression == ARCHIVE_COMPRESSION_NONE) {
+        return ReadArchive(archive, entry->offset, dst, (size_t)dstlen);
+    }
+
+    // compressed entries have to be read and unpacked whole.
+    bool result = false;
+    Uint8 *unpacked = (dstlen == entry->size) ? (Uint8 *)dst : (Uint8 *)SDL_malloc((size_t)entry->size);
+    Uint8 *stored = (Uint8 *)SDL_malloc((size_t)entry->stored_size + 1);
+    if (unpacked && stored && ReadArchive(archive, entry->offset, stored, (size_t)entry->stored_size)) {
+        if (SDL_DecodeLZ4Block(stored, (size_t)entry->stored_size, unpacked, (size_t)entry->size, 0) != (Sint64)entry->size) {
+            SDL_SetError("Archive has a damaged LZ4 block");
+        } else {
+            if (unpacked != dst) {
+                SDL_memcpy(dst, unpacked, (size_t)dstlen);
+            }
+            result = true;
+        }
+    }
+    SDL_free(stored);
+    if (unpacked != dst) {
+        SDL_free(unpacked);
+    }
+    return result;
+}
+
+static int ComparePaths(const char *a, size_t alen, const char *b, size_t blen)
+{
+    const int result = SDL_memcmp(a, b, SDL_min(alen, blen));
+    if (result != 0) {
+        return result;
+    }
+    return (alen < blen) ? -1 : (alen > blen) ? 1 : 0;
+}
+
+// Returns the index of the first entry at or after path, which is num_entries if there isn't one.
+static Uint32 FindArchiveEntryIndex(const ArchiveStorage *archive, const char *path, size_t len)
+{
+    Uint32 lo = 0;
+    Uint32 hi = archive->num_entries;
+    while (lo < hi) {
+        const Uint32 mid = lo + ((hi - lo) / 2);
+        const ArchiveEntry *entry = &archive->entries[mid];
+        if (ComparePaths(entry->path, entry->path_len, path, len) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool EntryHasPrefix(const ArchiveEntry *entry, const char *prefix, size_t len)
+{
+    return (entry->path_len > len) && (SDL_memcmp(entry->path, prefix, len) == 0);
+}
+
+static const ArchiveEntry *FindArchiveEntry(const ArchiveStorage *archive, const char *path, size_t len)
+{
+    const Uint32 i = FindArchiveEntryIndex(archive, path, len);
+    if ((i < archive->num_entries) && (ComparePaths(archive->entries[i].path, archive->entries[i].path_len, path, len) == 0)) {
+        return &archive->entries[i];
+    }
+    return NULL;
+}
+
+// SDL_Storage paths may end with a '/', the archive's don't.
+static size_t GetArchivePathLength(const char *path)
+{
+    size_t len = SDL_strlen(path);
+    while (len && (path[len - 1] == '/')) {
+        --len;
+    }
+    return len;
+}
+
+// Builds "path/" for looking up what's under a directory; for the root, that's an empty string.
+static char *CreateDirectoryPrefix(const char *path, size_t len)
+{
+    char *prefix = (char *)SDL_malloc(len + 2);
+    if (prefix) {
+        SDL_memcpy(prefix, path, len);
+        if (len) {
+            prefix[len++] = '/';
+        }
+        prefix[len] = '\0';
+    }
+    return prefix;
+}
+
+static bool IsArchiveDirectory(const ArchiveStorage *archive, const char *prefix, size_t len)
+{
+    if (len == 0) {
+        return true;  // the root always exists, even in an empty archive.
+    }
+    const Uint32 i = FindArchiveEntryIndex(archive, prefix, len);
+    return (i < archive->num_entries) && EntryHasPrefix(&archive->entries[i], prefix, len);
+}
+
+static bool ARCHIVE_CloseStorage(void *userdata)
+{
+    ReleaseArchive((ArchiveStorage *)userdata);
+    return true;
+}
+
+static bool ARCHIVE_EnumerateStorageDirectory(void *userdata, const char *path, SDL_EnumerateDirectoryCallback callback, void *callback_userdata)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    const size_t path_len = GetArchivePathLength(path);
+    char *prefix = CreateDirectoryPrefix(path, path_len);
+    char *fname = (char *)SDL_malloc((size_t)archive->max_path_len + 1);
+    if (!prefix || !fname) {
+        SDL_free(prefix);
+        SDL_free(fname);
+        return false;
+    }
+
+    const size_t prefix_len = SDL_strlen(prefix);
+    bool result = true;
+    if (!IsArchiveDirectory(archive, prefix, prefix_len)) {
+        result = SDL_SetError("Can't open directory '%s'", path);
+    } else {
+        SDL_EnumerationResult status = SDL_ENUM_CONTINUE;
+        Uint32 i = FindArchiveEntryIndex(archive, prefix, prefix_len);
+        while ((status == SDL_ENUM_CONTINUE) && (i < archive->num_entries) && EntryHasPrefix(&archive->entries[i], prefix, prefix_len)) {
+            const ArchiveEntry *entry = &archive->entries[i++];
+            const char *child = entry->path + prefix_len;
+            const char *slash = (const char *)SDL_memchr(child, '/', entry->path_len - prefix_len);
+            const size_t child_len = slash ? (size_t)(slash - child) : (entry->path_len - prefix_len);
+
+            // everything inside a subdirectory sorts together, so skip past the rest of it.
+            if (slash) {
+                const size_t subdir_len = (size_t)(slash - entry->path) + 1;
+                while ((i < archive->num_entries) && EntryHasPrefix(&archive->entries[i], entry->path, subdir_len)) {
+                    ++i;
+                }
+            }
+
+            SDL_memcpy(fname, child, child_len);
+            fname[child_len] = '\0';
+            status = callback(callback_userdata, prefix, fname);
+        }
+        result = (status != SDL_ENUM_FAILURE);
+    }
+
+    SDL_free(fname);
+    SDL_free(prefix);
+    return result;
+}
+
+static bool ARCHIVE_GetStoragePathInfo(void *userdata, const char *path, SDL_PathInfo *info)
+{
+    const ArchiveStorage *archive = (const ArchiveStorage *)userdata;
+    const size_t path_len = GetArchivePathLength(path);
+
+    SDL_zerop(info);
+
+    const ArchiveEntry *entry = FindArchiveEntry(archive, path, path_len);
+    if (entry) {
+        info->type = SDL_PATHTYPE_FILE;
+        info->size = entry->size;
+        return true;
+    }
+
+    char *prefix = CreateDirectoryPrefix(path, path_len);
+    if (!prefix) {
+        return false;
+    }
+    const bool found = IsArchiveDirectory(archive, prefix, SDL_strlen(prefix));
+    SDL_free(prefix);
+    if (!found) {
+        return SDL_SetError("Can't stat '%s'", path);
+    }
+    info->type = SDL_PATHTYPE_DIRECTORY;
+    return true;
+}
+
+static bool ARCHIVE_ReadStorageFile(void *userdata, const char *path, void *destination, Uint64 length)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    const ArchiveEntry *entry = FindArchiveEntry(archive, path, SDL_strlen(path));
+    if (!entry) {
+        return SDL_SetError("Couldn't open %s", path);
+    }
+    return ReadArchiveEntry(archive, entry, destination, length);
+}
+
+typedef struct ArchiveFileStream
+{
+    ArchiveStorage *archive;
+    Uint64 offset;
+    Uint64 size;
+    Uint64 pos;
+} ArchiveFileStream;
+
+static Sint64 SDLCALL ArchiveFileStream_size(void *userdata)
+{
+    return (Sint64)((ArchiveFileStream *)userdata)->size;
+}
+
+static Sint64 SDLCALL ArchiveFileStream_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    ArchiveFileStream *stream = (ArchiveFileStream *)userdata;
+    Sint64 base;
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        base = 0;
+        break;
+    case SDL_IO_SEEK_CUR:
+        base = (Sint64)stream->pos;
+        break;
+    case SDL_IO_SEEK_END:
+        base = (Sint64)stream->size;
+        break;
+    default:
+        SDL_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+
+    const Sint64 newpos = base + offset;
+    if (newpos < 0) {
+        SDL_SetError("Seek before the start of the file");
+        return -1;
+    }
+    stream->pos = (Uint64)newpos;  // seeking past the end is allowed, reads there just hit EOF.
+    return newpos;
+}
+
+static size_t SDLCALL ArchiveFileStream_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    ArchiveFileStream *stream = (ArchiveFileStream *)userdata;
+    if (stream->pos >= stream->size) {
+        *status = SDL_IO_STATUS_EOF;
+        return 0;
+    }
+
+    const size_t avail = (size_t)SDL_min((Uint64)size, stream->size - stream->pos);
+    if (!ReadArchive(stream->archive, stream->offset + stream->pos, ptr, avail)) {
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+    stream->pos += avail;
+    return avail;
+}
+
+static bool SDLCALL ArchiveFileStream_close(void *userdata)
+{
+    ArchiveFileStream *stream = (ArchiveFileStream *)userdata;
+    ReleaseArchive(stream->archive);
+    SDL_free(stream);
+    return true;
+}
+
+static void SDLCALL FreeUnpackedEntry(void *userdata, void *value)
+{
+    SDL_free(value);
+}
+
+static SDL_IOStream *ARCHIVE_OpenStorageFile(void *userdata, const char *path)
+{
+    ArchiveStorage *archive = (ArchiveStorage *)userdata;
+    const ArchiveEntry *entry = FindArchiveEntry(archive, path, SDL_strlen(path));
+    if (!entry) {
+        SDL_SetError("Couldn't open %s", path);
+        return NULL;
+    }
+
+    if (entry->compression != ARCHIVE_COMPRESSION_NONE) {
+        // there's no seeking inside an LZ4 block, so the stream reads from the whole file unpacked in memory.
+        void *data = SDL_malloc((size_t)entry->size + 1);
+        if (!data) {
+            return NULL;
+        } else if (!ReadArchiveEntry(archive, entry, data, entry->size)) {
+            SDL_free(data);
+            return NULL;
+        }
+        SDL_IOStream *io = SDL_IOFromConstMem(data, (size_t)entry->size);
+        if (!io) {
+            SDL_free(data);
+            return NULL;
+        } else if (!SDL_SetPointerPropertyWithCleanup(SDL_GetIOProperties(io), "SDL.storage.archive.data", data, FreeUnpackedEntry, NULL)) {
+            SDL_CloseIO(io);  // the cleanup has already freed data.
+            return NULL;
+        }
+        return io;
+    }
+
+    ArchiveFileStream *stream = (ArchiveFileStream *)SDL_calloc(1, sizeof(*stream));
+    if (!stream) {
+        return NULL;
+    }
+    stream->archive = archive;
+    stream->offset = entry->offset;
+    stream->size = entry->size;
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = ArchiveFileStream_size;
+    iface.seek = ArchiveFileStream_seek;
+    iface.read = ArchiveFileStream_read;
+    iface.close = ArchiveFileStream_close;
+
+    SDL_AtomicIncRef(&archive->refcount);
+    SDL_IOStream *io = SDL_OpenIO(&iface, stream);
+    if (!io) {
+        SDL_AddAtomicInt(&archive->refcount, -1);  // the storage container still holds a reference, so this is never the last one.
+        SDL_free(stream);
+    }
+    return io;
+}
+
+static const SDL_StorageInterface ARCHIVE_iface = {
+    sizeof(SDL_StorageInterface),
+    ARCHIVE_CloseStorage,
+    NULL,   // ready
+    ARCHIVE_EnumerateStorageDirectory,
+    ARCHIVE_GetStoragePathInfo,
+    ARCHIVE_ReadStorageFile,
+    NULL,   // write_file
+    NULL,   // mkdir
+    NULL,   // remove
+    NULL,   // rename
+    NULL,   // copy
+    NULL    // space_remaining
+};
+
+// Archive paths are the same as SDL_Storage paths: relative, '/' separated, with no empty, "." or ".." parts.
+static bool IsValidArchivePath(const char *path, size_t len)
+{
+    size_t start = 0;
+    for (size_t i = 0; i <= len; ++i) {
+        if ((i == len) || (path[i] == '/')) {
+            const size_t part_len = i - start;
+            if ((part_len == 0) ||
+                ((part_len == 1) && (path[start] == '.')) ||
+                ((part_len == 2) && (path[start] == '.') && (path[start + 1] == '.'))) {
+                return false;
+            }
+            start = i + 1;
+        } else if ((path[i] == '\\') || (path[i] == '\0')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool LoadArchiveDirectory(ArchiveStorage *archive)
+{
+    Uint8 header[ARCHIVE_HEADER_SIZE];
+    const Sint64 archive_size = SDL_GetIOSize(archive->io);
+    if (archive_size < 0) {
+        return SDL_SetError("Archive must be seekable");
+    } else if (!ReadArchive(archive, 0, header, sizeof(header))) {
+        return false;
+    } else if (SDL_memcmp(header, "SDLA", 4) != 0) {
+        return SDL_SetError("Not an SDL archive");
+    }
+
+    Uint32 version, num_entries, names_size;
+    Uint64 directory_offset;
+    SDL_memcpy(&version, &header[4], sizeof(Uint32));
+    SDL_memcpy(&num_entries, &header[8], sizeof(Uint32));
+    SDL_memcpy(&names_size, &header[12], sizeof(Uint32));
+    SDL_memcpy(&directory_offset, &header[16], sizeof(Uint64));
+    version = SDL_Swap32LE(version);
+    num_entries = SDL_Swap32LE(num_entries);
+    names_size = SDL_Swap32LE(names_size);
+    directory_offset = SDL_Swap64LE(directory_offset);
+
+    const Uint64 directory_size = ((Uint64)num_entries * ARCHIVE_ENTRY_SIZE) + names_size;
+    if (version != ARCHIVE_VERSION) {
+        return SDL_SetError("Unsupported SDL archive version %u", (unsigned int)version);
+    } else if ((directory_offset > (Uint64)archive_size) || (directory_size > ((Uint64)archive_size - directory_offset)) || (directory_size >= SDL_SIZE_MAX)) {
+        return SDL_SetError("Archive directory is out of bounds");
+    }
+
+    archive->directory = (Uint8 *)SDL_malloc((size_t)directory_size + 1);
+    archive->entries = (ArchiveEntry *)SDL_calloc(num_entries ? num_entries : 1, sizeof(ArchiveEntry));
+    if (!archive->directory || !archive->entries) {
+        return false;
+    } else if (!ReadArchive(archive, directory_offset, archive->directory, (size_t)directory_size)) {
+        return false;
+    }
+    archive->num_entries = num_entries;
+
+    const char *names = (const char *)archive->directory + ((size_t)num_entries * ARCHIVE_ENTRY_SIZE);
+    for (Uint32 i = 0; i < num_entries; ++i) {
+        const Uint8 *raw = archive->directory + ((size_t)i * ARCHIVE_ENTRY_SIZE);
+        ArchiveEntry *entry = &archive->entries[i];
+        Uint32 name_offset;
+
+        SDL_memcpy(&entry->offset, &raw[0], sizeof(Uint64));
+        SDL_memcpy(&entry->stored_size, &raw[8], sizeof(Uint64));
+        SDL_memcpy(&entry->size, &raw[16], sizeof(Uint64));
+        SDL_memcpy(&name_offset, &raw[24], sizeof(Uint32));
+        SDL_memcpy(&entry->path_len, &raw[28], sizeof(Uint16));
+        entry->offset = SDL_Swap64LE(entry->offset);
+        entry->stored_size = SDL_Swap64LE(entry->stored_size);
+        entry->size = SDL_Swap64LE(entry->size);
+        name_offset = SDL_Swap32LE(name_offset);
+        entry->path_len = SDL_Swap16LE(entry->path_len);
+        entry->compression = raw[30];
+        entry->path = names + name_offset;
+
+        if ((name_offset > names_size) || (entry->path_len > (names_size - name_offset)) || !IsValidArchivePath(entry->path, entry->path_len)) {
+            return SDL_SetError("Archive entry %u has an invalid path", (unsigned int)i);
+        } else if (raw[31] != 0) {
+            return SDL_SetError("Archive entry %u has unknown flags", (unsigned int)i);
+        } else if ((entry->offset > (Uint64)archive_size) || (entry->stored_size > ((Uint64)archive_size - entry->offset))) {
+            return SDL_SetError("Archive entry %u is out of bounds", (unsigned int)i);
+        } else if ((i > 0) && (ComparePaths(entry[-1].path, entry[-1].path_len, entry->path, entry->path_len) >= 0)) {
+            return SDL_SetError("Archive directory isn't sorted");
+        } else if (entry->size >= SDL_SIZE_MAX) {
+            return SDL_SetError("Archive entry %u is too large", (unsigned int)i);
+        }
+
+        switch (entry->compression) {
+        case ARCHIVE_COMPRESSION_NONE:
+            if (entry->stored_size != entry->size) {
+                return SDL_SetError("Archive entry %u has the wrong size", (unsigned int)i);
+            }
+            break;
+        case ARCHIVE_COMPRESSION_LZ4:
+            break;
+        default:
+            return SDL_SetError("Archive entry %u uses unsupported compression %u", (unsigned int)i, (unsigned int)entry->compression);
+        }
+
+        archive->max_path_len = SDL_max(archive->max_path_len, entry->path_len);
+    }
+
+    return true;
+}
+
+SDL_Storage *ARCHIVE_OpenStorage(SDL_IOStream *src, bool closeio)
+{
+    if (!src) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+
+    ArchiveStorage *archive = (ArchiveStorage *)SDL_calloc(1, sizeof(*archive));
+    if (!archive) {
+        if (closeio) {
+            SDL_CloseIO(src);
+        }
+        return NULL;
+    }
+    archive->io = src;
+    archive->closeio = closeio;
+    SDL_SetAtomicInt(&archive->refcount, 1);
+
+    SDL_Storage *result = NULL;
+    archive->lock = SDL_CreateMutex();
+    if (archive->lock && LoadArchiveDirectory(archive)) {
+        result = SDL_OpenStorage(&ARCHIVE_iface, archive);
+    }
+    if (!result) {
+        ReleaseArchive(archive);
+        return NULL;
+    }
+
+    SDL_SetStorageOpenFileFunction(result, ARCHIVE_OpenStorageFile);
+    return result;
+}
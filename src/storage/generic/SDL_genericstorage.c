@@ -22,6 +22,7 @@
 #include "SDL_internal.h"
 
 #include "../SDL_sysstorage.h"
+#include "../../io/SDL_asyncio_c.h"
 
 
 static char *GENERIC_INTERNAL_CreateFullPath(const char *base, const char *relative)
@@ -155,6 +156,39 @@ static bool GENERIC_WriteStorageFile(void *userdata, const char *path, const voi
     return result;
 }
 
+static SDL_IOStream *GENERIC_OpenStorageFile(void *userdata, const char *path)
+{
+    SDL_IOStream *result = NULL;
+    char *fullpath = GENERIC_INTERNAL_CreateFullPath((char *)userdata, path);
+    if (fullpath) {
+        result = SDL_IOFromFile(fullpath, "rb");
+        SDL_free(fullpath);
+    }
+    return result;
+}
+
+static bool GENERIC_ReadStorageFileAsync(void *userdata, const char *path, void *destination, Uint64 length, SDL_AsyncIOQueue *queue, void *app_userdata)
+{
+    bool result = false;
+    char *fullpath = GENERIC_INTERNAL_CreateFullPath((char *)userdata, path);
+    if (fullpath) {
+        result = SDL_TransferFileAsync(fullpath, false, destination, length, queue, app_userdata);
+        SDL_free(fullpath);
+    }
+    return result;
+}
+
+static bool GENERIC_WriteStorageFileAsync(void *userdata, const char *path, const void *source, Uint64 length, SDL_AsyncIOQueue *queue, void *app_userdata)
+{
+    bool result = false;
+    char *fullpath = GENERIC_INTERNAL_CreateFullPath((char *)userdata, path);
+    if (fullpath) {
+        result = SDL_TransferFileAsync(fullpath, true, (void *)source, length, queue, app_userdata);
+        SDL_free(fullpath);
+    }
+    return result;
+}
+
 static bool GENERIC_CreateStorageDirectory(void *userdata, const char *path)
 {
     // TODO: Recursively create subdirectories with SDL_CreateDirectory
@@ -218,6 +252,17 @@ static Uint64 GENERIC_GetStorageSpaceRemaining(void *userdata)
     return SDL_MAX_UINT64;
 }
 
+// the files are regular files, so SDL_AsyncIO can do these without tying up a job thread.
+static const SDL_StorageAsyncInterface GENERIC_async_iface = {
+    GENERIC_ReadStorageFileAsync,
+    GENERIC_WriteStorageFileAsync
+};
+
+static const SDL_StorageAsyncInterface GENERIC_title_async_iface = {
+    GENERIC_ReadStorageFileAsync,
+    NULL    // write_file
+};
+
 static const SDL_StorageInterface GENERIC_title_iface = {
     sizeof(SDL_StorageInterface),
     GENERIC_CloseStorage,
@@ -254,6 +299,9 @@ static SDL_Storage *GENERIC_Title_Create(const char *override, SDL_PropertiesID
         result = SDL_OpenStorage(&GENERIC_title_iface, basepath);
         if (result == NULL) {
             SDL_free(basepath);  // otherwise CloseStorage will free it.
+        } else {
+            SDL_SetStorageAsyncInterface(result, &GENERIC_title_async_iface);
+            SDL_SetStorageOpenFileFunction(result, GENERIC_OpenStorageFile);
         }
     }
 
@@ -292,6 +340,9 @@ static SDL_Storage *GENERIC_User_Create(const char *org, const char *app, SDL_Pr
     result = SDL_OpenStorage(&GENERIC_user_iface, prefpath);
     if (result == NULL) {
         SDL_free(prefpath);  // otherwise CloseStorage will free it.
+    } else {
+        SDL_SetStorageAsyncInterface(result, &GENERIC_async_iface);
+        SDL_SetStorageOpenFileFunction(result, GENERIC_OpenStorageFile);
     }
     return result;
 }
@@ -346,6 +397,9 @@ SDL_Storage *GENERIC_OpenFileStorage(const char *path)
     result = SDL_OpenStorage(&GENERIC_file_iface, basepath);
     if (result == NULL) {
         SDL_free(basepath);
+    } else {
+        SDL_SetStorageAsyncInterface(result, &GENERIC_async_iface);
+        SDL_SetStorageOpenFileFunction(result, GENERIC_OpenStorageFile);
     }
     return result;
 }
@@ -55,10 +55,28 @@ __declspec(dllimport) USHORT WINAPI RtlCaptureStackBackTrace(ULONG FramesToSkip,
 
 #define MAXIMUM_TRACKED_STACK_DEPTH 32
 
+/* The stack frame that identifies where an allocation came from: frame 0 is
+   our tracking function and frame 1 is SDL_malloc() and friends. */
+#define CALL_SITE_STACK_INDEX 2
+#define MAXIMUM_TRACKED_CALL_SITES 1024
+
+typedef struct SDL_tracked_call_site
+{
+    Uint64 pc;
+    SDL_MemoryTag tag;
+    Uint64 num_allocations;
+    Uint64 current_bytes;
+#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
+    char name[256];
+#endif
+} SDL_tracked_call_site;
+
 typedef struct SDL_tracked_allocation
 {
     void *mem;
     size_t size;
+    SDL_MemoryTag tag;
+    SDL_tracked_call_site *call_site;
     Uint64 stack[MAXIMUM_TRACKED_STACK_DEPTH];
     struct SDL_tracked_allocation *next;
 #ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
@@ -76,6 +94,9 @@ static int s_unknown_frees = 0;
 static SDL_tracked_allocation *s_tracked_allocations[256];
 static bool s_randfill_allocations = false;
 static SDL_AtomicInt s_lock;
+static SDLTest_AllocationStats s_allocation_stats[SDL_MEMORY_TAG_COUNT];
+static SDL_tracked_call_site s_call_sites[MAXIMUM_TRACKED_CALL_SITES];
+static Uint64 s_tracking_start;
 
 #define LOCK_ALLOCATOR()                               \
     do {                                               \
@@ -122,6 +143,29 @@ static bool SDL_IsAllocationTracked(void *mem)
     return SDL_GetTrackedAllocation(mem) != NULL;
 }
 
+/* This should be called with the allocator lock held */
+static SDL_tracked_call_site *SDL_GetTrackedCallSite(Uint64 pc, SDL_MemoryTag tag)
+{
+    Uint64 hash = (pc ^ (pc >> 17) ^ ((Uint64)tag << 56)) * 0x9E3779B97F4A7C15ULL;
+    unsigned int index = (unsigned int)(hash >> 32) & (MAXIMUM_TRACKED_CALL_SITES - 1);
+    unsigned int i;
+
+    for (i = 0; i < MAXIMUM_TRACKED_CALL_SITES; ++i) {
+        SDL_tracked_call_site *site = &s_call_sites[index];
+        if (site->num_allocations == 0) {
+            site->pc = pc;
+            site->tag = tag;
+            return site;
+        }
+        if (site->pc == pc && site->tag == tag) {
+            return site;
+        }
+        index = (index + 1) & (MAXIMUM_TRACKED_CALL_SITES - 1);
+    }
+    /* The table is full, these allocations only show up in the totals */
+    return NULL;
+}
+
 static void SDL_TrackAllocation(void *mem, size_t size)
 {
     SDL_tracked_allocation *entry;
@@ -137,6 +181,7 @@ static void SDL_TrackAllocation(void *mem, size_t size)
     LOCK_ALLOCATOR();
     entry->mem = mem;
     entry->size = size;
+    entry->tag = SDL_GetMemoryTag();
 
     /* Generate the stack trace for the allocation */
     SDL_zeroa(entry->stack);
@@ -187,6 +232,25 @@ static void SDL_TrackAllocation(void *mem, size_t size)
     }
 #endif /* HAVE_LIBUNWIND_H */
 
+    {
+        SDLTest_AllocationStats *stats = &s_allocation_stats[entry->tag];
+
+        stats->current_bytes += size;
+        stats->peak_bytes = SDL_max(stats->peak_bytes, stats->current_bytes);
+        stats->num_allocations += 1;
+
+        entry->call_site = SDL_GetTrackedCallSite(entry->stack[CALL_SITE_STACK_INDEX], entry->tag);
+        if (entry->call_site) {
+#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
+            if (entry->call_site->num_allocations == 0) {
+                SDL_strlcpy(entry->call_site->name, entry->stack_names[CALL_SITE_STACK_INDEX], sizeof(entry->call_site->name));
+            }
+#endif
+            entry->call_site->num_allocations += 1;
+            entry->call_site->current_bytes += size;
+        }
+    }
+
     entry->next = s_tracked_allocations[index];
     s_tracked_allocations[index] = entry;
     UNLOCK_ALLOCATOR();
@@ -206,6 +270,11 @@ static void SDL_UntrackAllocation(void *mem)
             } else {
                 s_tracked_allocations[index] = entry->next;
             }
+            s_allocation_stats[entry->tag].current_bytes -= entry->size;
+            s_allocation_stats[entry->tag].num_frees += 1;
+            if (entry->call_site) {
+                entry->call_site->current_bytes -= entry->size;
+            }
             SDL_free_orig(entry);
             UNLOCK_ALLOCATOR();
             return;
@@ -293,6 +362,7 @@ void SDLTest_TrackAllocations(void)
     }
 
     SDLTest_Crc32Init(&s_crc32_context);
+    s_tracking_start = SDL_GetPerformanceCounter();
 
     s_previous_allocations = SDL_GetNumAllocations();
     if (s_previous_allocations < 0) {
@@ -355,6 +425,52 @@ void SDLTest_RandFillAllocations(void)
     s_randfill_allocations = true;
 }
 
+static void describe_stack_address(Uint64 pc, const char *unwind_name, char *description, size_t description_size)
+{
+    SDL_strlcpy(description, "???", description_size);
+#ifdef HAVE_LIBUNWIND_H
+    {
+#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
+        if (s_unwind_symbol_names) {
+            (void)SDL_snprintf(description, description_size, "%s", unwind_name);
+        }
+#else
+        char name[256] = "???";
+        unw_word_t offset = 0;
+        (void)unwind_name;
+        unw_get_proc_name_by_ip(unw_local_addr_space, pc, name, sizeof(name), &offset, NULL);
+        (void)SDL_snprintf(description, description_size, "%s+0x%llx", name, (long long unsigned int)offset);
+#endif
+    }
+#elif defined(SDL_PLATFORM_WIN32)
+    {
+        DWORD64 dwDisplacement = 0;
+        char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
+        PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
+        DWORD lineColumn = 0;
+        pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        pSymbol->MaxNameLen = MAX_SYM_NAME;
+        IMAGEHLP_LINE64 dbg_line;
+        dbg_line.SizeOfStruct = sizeof(dbg_line);
+        dbg_line.FileName = "";
+        dbg_line.LineNumber = 0;
+
+        (void)unwind_name;
+        if (dyn_dbghelp.module) {
+            if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), pc, &dwDisplacement, pSymbol)) {
+                SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
+                dwDisplacement = 0;
+            }
+            dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)pc, &lineColumn, &dbg_line);
+        }
+        SDL_snprintf(description, description_size, "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
+    }
+#else
+    (void)pc;
+    (void)unwind_name;
+#endif
+}
+
 void SDLTest_LogAllocations(void)
 {
     char *message = NULL;
@@ -394,46 +510,15 @@ void SDLTest_LogAllocations(void)
             ADD_LINE();
             /* Start at stack index 1 to skip our tracking functions */
             for (stack_index = 1; stack_index < SDL_arraysize(entry->stack); ++stack_index) {
-                char stack_entry_description[256] = "???";
+                char stack_entry_description[256];
 
                 if (!entry->stack[stack_index]) {
                     break;
                 }
-#ifdef HAVE_LIBUNWIND_H
-                {
 #ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
-                    if (s_unwind_symbol_names) {
-                        (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s", entry->stack_names[stack_index]);
-                    }
+                describe_stack_address(entry->stack[stack_index], entry->stack_names[stack_index], stack_entry_description, sizeof(stack_entry_description));
 #else
-                    char name[256] = "???";
-                    unw_word_t offset = 0;
-                    unw_get_proc_name_by_ip(unw_local_addr_space, entry->stack[stack_index], name, sizeof(name), &offset, NULL);
-                    (void)SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%llx", name, (long long unsigned int)offset);
-#endif
-                }
-#elif defined(SDL_PLATFORM_WIN32)
-                {
-                    DWORD64 dwDisplacement = 0;
-                    char symbol_buffer[sizeof(SYMBOL_INFO) + MAX_SYM_NAME * sizeof(TCHAR)];
-                    PSYMBOL_INFO pSymbol = (PSYMBOL_INFO)symbol_buffer;
-                    DWORD lineColumn = 0;
-                    pSymbol->SizeOfStruct = sizeof(SYMBOL_INFO);
-                    pSymbol->MaxNameLen = MAX_SYM_NAME;
-                    IMAGEHLP_LINE64 dbg_line;
-                    dbg_line.SizeOfStruct = sizeof(dbg_line);
-                    dbg_line.FileName = "";
-                    dbg_line.LineNumber = 0;
-
-                    if (dyn_dbghelp.module) {
-                        if (!dyn_dbghelp.pSymFromAddr(GetCurrentProcess(), entry->stack[stack_index], &dwDisplacement, pSymbol)) {
-                            SDL_strlcpy(pSymbol->Name, "???", MAX_SYM_NAME);
-                            dwDisplacement = 0;
-                        }
-                        dyn_dbghelp.pSymGetLineFromAddr64(GetCurrentProcess(), (DWORD64)entry->stack[stack_index], &lineColumn, &dbg_line);
-                    }
-                    SDL_snprintf(stack_entry_description, sizeof(stack_entry_description), "%s+0x%I64x %s:%u", pSymbol->Name, dwDisplacement, dbg_line.FileName, (Uint32)dbg_line.LineNumber);
-                }
+                describe_stack_address(entry->stack[stack_index], NULL, stack_entry_description, sizeof(stack_entry_description));
 #endif
                 (void)SDL_snprintf(line, sizeof(line), "\t0x%" SDL_PRIx64 ": %s\n", entry->stack[stack_index], stack_entry_description);
 
@@ -456,3 +541,103 @@ void SDLTest_LogAllocations(void)
     SDL_Log("%s", message);
     SDL_free_orig(message);
 }
+
+bool SDLTest_GetAllocationStats(SDL_MemoryTag tag, SDLTest_AllocationStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    if ((int)tag < 0 || tag >= SDL_MEMORY_TAG_COUNT) {
+        return SDL_InvalidParamError("tag");
+    }
+    if (!SDL_malloc_orig) {
+        return SDL_SetError("Allocation tracking isn't enabled");
+    }
+
+    LOCK_ALLOCATOR();
+    *stats = s_allocation_stats[tag];
+    UNLOCK_ALLOCATOR();
+    return true;
+}
+
+static int SDLCALL compare_call_sites(const void *a, const void *b)
+{
+    const SDL_tracked_call_site *site_a = *(const SDL_tracked_call_site **)a;
+    const SDL_tracked_call_site *site_b = *(const SDL_tracked_call_site **)b;
+
+    if (site_a->num_allocations != site_b->num_allocations) {
+        return (site_a->num_allocations > site_b->num_allocations) ? -1 : 1;
+    }
+    if (site_a->current_bytes != site_b->current_bytes) {
+        return (site_a->current_bytes > site_b->current_bytes) ? -1 : 1;
+    }
+    return 0;
+}
+
+void SDLTest_LogAllocationStats(int max_call_sites)
+{
+    SDLTest_AllocationStats stats[SDL_MEMORY_TAG_COUNT];
+    SDL_tracked_call_site *call_sites = NULL;
+    SDL_tracked_call_site **sorted = NULL;
+    int num_call_sites = 0;
+    double seconds;
+    int i;
+
+    if (!SDL_malloc_orig) {
+        return;
+    }
+
+    /* Take a snapshot so we don't hold the lock while logging, which allocates */
+    call_sites = (SDL_tracked_call_site *)SDL_malloc_orig(sizeof(s_call_sites));
+    sorted = (SDL_tracked_call_site **)SDL_malloc_orig(SDL_arraysize(s_call_sites) * sizeof(*sorted));
+    LOCK_ALLOCATOR();
+    SDL_memcpy(stats, s_allocation_stats, sizeof(stats));
+    if (call_sites && sorted) {
+        SDL_memcpy(call_sites, s_call_sites, sizeof(s_call_sites));
+    }
+    UNLOCK_ALLOCATOR();
+
+    seconds = (double)(SDL_GetPerformanceCounter() - s_tracking_start) / SDL_GetPerformanceFrequency();
+    if (seconds <= 0.0) {
+        seconds = 1.0;
+    }
+
+    SDL_Log("Memory allocations by subsystem, over %.2f seconds:", seconds);
+    for (i = 0; i < SDL_MEMORY_TAG_COUNT; ++i) {
+        if (stats[i].num_allocations == 0) {
+            continue;
+        }
+        SDL_Log("  %-10s %10.2f Kb current, %10.2f Kb peak, %" SDL_PRIu64 " allocations (%.1f/s), %" SDL_PRIu64 " frees",
+                SDL_GetMemoryTagName((SDL_MemoryTag)i),
+                stats[i].current_bytes / 1024.0, stats[i].peak_bytes / 1024.0,
+                stats[i].num_allocations, stats[i].num_allocations / seconds,
+                stats[i].num_frees);
+    }
+
+    if (call_sites && sorted && max_call_sites > 0) {
+        for (i = 0; i < (int)SDL_arraysize(s_call_sites); ++i) {
+            if (call_sites[i].num_allocations > 0) {
+                sorted[num_call_sites++] = &call_sites[i];
+            }
+        }
+        SDL_qsort(sorted, num_call_sites, sizeof(*sorted), compare_call_sites);
+
+        SDL_Log("Top allocation call sites:");
+        for (i = 0; i < num_call_sites && i < max_call_sites; ++i) {
+            const SDL_tracked_call_site *site = sorted[i];
+            char description[256];
+
+#ifdef SDLTEST_UNWIND_NO_PROC_NAME_BY_IP
+            describe_stack_address(site->pc, site->name, description, sizeof(description));
+#else
+            describe_stack_address(site->pc, NULL, description, sizeof(description));
+#endif
+            SDL_Log("  %" SDL_PRIu64 " allocations, %.2f Kb current, [%s] 0x%" SDL_PRIx64 ": %s",
+                    site->num_allocations, site->current_bytes / 1024.0,
+                    SDL_GetMemoryTagName(site->tag), site->pc, description);
+        }
+    }
+
+    SDL_free_orig(sorted);
+    SDL_free_orig(call_sites);
+}
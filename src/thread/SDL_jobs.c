@@ -0,0 +1,545 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_jobs_c.h"
+
+/* This is a shared pool of worker threads for short jobs.
+
+   Each worker owns a deque of jobs. Jobs submitted from a worker go to the
+   back of its own deque, and the worker takes jobs from the back again, so
+   work spawned by a job tends to run on the same core while its data is
+   still in cache. Jobs submitted from other threads are spread across the
+   deques round-robin. A worker whose deque is empty steals from the front of
+   the other deques, so the only contention is between a thief and its victim
+   on a single deque's spinlock; there is no global lock on the fast path.
+
+   A counting semaphore holds one count per queued job, so every worker that
+   gets through it is guaranteed to find a job somewhere. */
+
+#define SDL_JOB_DEQUE_INITIAL_SIZE 64
+
+typedef struct SDL_Job
+{
+    SDL_JobFunction callback;
+    void *userdata;
+} SDL_Job;
+
+typedef struct SDL_JobWorker
+{
+    SDL_SpinLock lock;
+    SDL_Job *jobs;  // ring buffer of capacity entries, capacity is a power of two.
+    int capacity;
+    int head;       // the oldest job, where other workers steal from.
+    int count;
+    SDL_Thread *thread;
+} SDL_JobWorker;
+
+static SDL_InitState SDL_jobs_init;
+static SDL_JobWorker SDL_job_workers[SDL_MAX_JOB_WORKERS];
+static int SDL_num_job_workers;
+static SDL_Semaphore *SDL_job_semaphore;
+static SDL_AtomicInt SDL_job_next_worker;
+static SDL_AtomicInt SDL_jobs_stopping;
+static SDL_TLSID SDL_job_worker_tls;
+
+static bool SDL_PushJob(SDL_JobWorker *worker, const SDL_Job *job)
+{
+    bool result = true;
+
+    SDL_LockSpinlock(&worker->lock);
+    if (worker->count == worker->capacity) {
+        const int capacity = worker->capacity ? (worker->capacity * 2) : SDL_JOB_DEQUE_INITIAL_SIZE;
+        SDL_Job *jobs = (SDL_Job *)SDL_malloc(capacity * sizeof(*jobs));
+        if (jobs) {
+            for (int i = 0; i < worker->count; ++i) {
+                jobs[i] = worker->jobs[(worker->head + i) & (worker->capacity - 1)];
+            }
+            SDL_free(worker->jobs);
+            worker->jobs = jobs;
+            worker->capacity = capacity;
+            worker->head = 0;
+        } else {
+            result = false;
+        }
+    }
+    if (result) {
+        worker->jobs[(worker->head + worker->count) & (worker->capacity - 1)] = *job;
+        ++worker->count;
+    }
+    SDL_UnlockSpinlock(&worker->lock);
+
+    return result;
+}
+
+static bool SDL_PopNewestJob(SDL_JobWorker *worker, SDL_Job *job)
+{
+    bool result = false;
+
+    SDL_LockSpinlock(&worker->lock);
+    if (worker->count > 0) {
+        --worker->count;
+        *job = worker->jobs[(worker->head + worker->count) & (worker->capacity - 1)];
+        result = true;
+    }
+    SDL_UnlockSpinlock(&worker->lock);
+
+    return result;
+}
+
+static bool SDL_PopOldestJob(SDL_JobWorker *worker, SDL_Job *job)
+{
+    bool result = false;
+
+    SDL_LockSpinlock(&worker->lock);
+    if (worker->count > 0) {
+        *job = worker->jobs[worker->head];
+        worker->head = (worker->head + 1) & (worker->capacity - 1);
+        --worker->count;
+        result = true;
+    }
+    SDL_UnlockSpinlock(&worker->lock);
+
+    return result;
+}
+
+static bool SDL_TakeJob(int index, SDL_Job *job)
+{
+    if (SDL_PopNewestJob(&SDL_job_workers[index], job)) {
+        return true;
+    }
+
+    for (int i = 1; i < SDL_num_job_workers; ++i) {
+        if (SDL_PopOldestJob(&SDL_job_workers[(index + i) % SDL_num_job_workers], job)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int SDLCALL SDL_JobWorkerThread(void *data)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)data;
+    const int index = (int)(worker - SDL_job_workers);
+    SDL_Job job;
+
+    SDL_SetTLS(&SDL_job_worker_tls, worker, NULL);
+
+    for (;;) {
+        SDL_WaitSemaphore(SDL_job_semaphore);
+
+        // The job we were woken for may still be in flight to a deque we already checked, so keep looking
+        while (!SDL_TakeJob(index, &job)) {
+            if (SDL_GetAtomicInt(&SDL_jobs_stopping)) {
+                return 0;
+            }
+            SDL_CPUPauseInstruction();
+        }
+
+        job.callback(job.userdata);
+    }
+}
+
+// Workers are started the first time a job is submitted.
+static bool SDL_PrepareJobs(void)
+{
+    if (SDL_ShouldInit(&SDL_jobs_init)) {
+        const int num_workers = SDL_clamp(SDL_GetNumLogicalCPUCores(), 2, SDL_MAX_JOB_WORKERS);
+
+        SDL_job_semaphore = SDL_CreateSemaphore(0);
+        if (!SDL_job_semaphore) {
+            SDL_SetInitialized(&SDL_jobs_init, false);
+            return false;
+        }
+
+        /* Workers don't look at the other deques until the first job is submitted,
+           so it's safe to settle on the worker count after they are started.
+           If threads aren't available at all, jobs just run synchronously. */
+        SDL_num_job_workers = num_workers;
+        for (int i = 0; i < num_workers; ++i) {
+            char name[32];
+            SDL_snprintf(name, sizeof(name), "SDLjobs%d", i);
+            SDL_job_workers[i].thread = SDL_CreateThread(SDL_JobWorkerThread, name, &SDL_job_workers[i]);
+            if (!SDL_job_workers[i].thread) {
+                SDL_num_job_workers = i;
+                break;
+            }
+        }
+
+        SDL_SetInitialized(&SDL_jobs_init, true);
+    }
+    return true;
+}
+
+bool SDL_SubmitJob(SDL_JobFunction callback, void *userdata)
+{
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+
+    // Jobs submitted from a worker stay on that worker, and can't wait on initialization since shutdown may be joining it.
+    SDL_JobWorker *worker = (SDL_JobWorker *)SDL_GetTLS(&SDL_job_worker_tls);
+    if (!worker) {
+        // Anything submitted while shutting down is run immediately
+        if (SDL_GetAtomicInt(&SDL_jobs_stopping)) {
+            callback(userdata);
+            return true;
+        }
+
+        if (!SDL_PrepareJobs()) {
+            return false;
+        }
+
+        if (SDL_num_job_workers == 0) {
+            callback(userdata);
+            return true;
+        }
+
+        const Uint32 next = (Uint32)SDL_AddAtomicInt(&SDL_job_next_worker, 1);
+        worker = &SDL_job_workers[next % SDL_num_job_workers];
+    }
+
+    SDL_Job job;
+    job.callback = callback;
+    job.userdata = userdata;
+    if (!SDL_PushJob(worker, &job)) {
+        return false;
+    }
+
+    SDL_SignalSemaphore(SDL_job_semaphore);
+    return true;
+}
+
+typedef struct SDL_WaitedJob
+{
+    SDL_JobFunction callback;
+    void *userdata;
+    SDL_AtomicInt *remaining;
+} SDL_WaitedJob;
+
+static void SDLCALL SDL_RunWaitedJob(void *data)
+{
+    SDL_WaitedJob *job = (SDL_WaitedJob *)data;
+    job->callback(job->userdata);
+    SDL_AddAtomicInt(job->remaining, -1);
+}
+
+// Run a queued job on the calling thread, if there is one.
+static bool SDL_HelpWithJob(SDL_JobWorker *worker)
+{
+    // Taking a job without its semaphore count would leave a worker looking for a job that isn't there
+    if (!SDL_TryWaitSemaphore(SDL_job_semaphore)) {
+        return false;
+    }
+
+    const int index = worker ? (int)(worker - SDL_job_workers) : 0;
+    SDL_Job job;
+    while (!SDL_TakeJob(index, &job)) {
+        SDL_CPUPauseInstruction();
+    }
+    job.callback(job.userdata);
+    return true;
+}
+
+void SDL_RunJobsAndWait(SDL_JobFunction callback, void **userdata, int count)
+{
+    SDL_WaitedJob *jobs = NULL;
+    SDL_AtomicInt remaining;
+    int submitted = 0;
+
+    if (count > 1) {
+        jobs = (SDL_WaitedJob *)SDL_malloc((count - 1) * sizeof(*jobs));
+    }
+
+    SDL_SetAtomicInt(&remaining, 0);
+    if (jobs) {
+        for (int i = 1; i < count; ++i) {
+            SDL_WaitedJob *job = &jobs[submitted];
+            job->callback = callback;
+            job->userdata = userdata[i];
+            job->remaining = &remaining;
+            SDL_AddAtomicInt(&remaining, 1);
+            if (!SDL_SubmitJob(SDL_RunWaitedJob, job)) {
+                SDL_AddAtomicInt(&remaining, -1);
+                break;
+            }
+            ++submitted;
+        }
+    }
+
+    // Whatever couldn't be handed off runs right here
+    for (int i = 0; i < count - submitted; ++i) {
+        callback(userdata[(i == 0) ? 0 : (submitted + i)]);
+    }
+
+    if (submitted > 0) {
+        SDL_JobWorker *worker = (SDL_JobWorker *)SDL_GetTLS(&SDL_job_worker_tls);
+        while (SDL_GetAtomicInt(&remaining) > 0) {
+            if (!SDL_HelpWithJob(worker)) {
+                SDL_CPUPauseInstruction();
+            }
+        }
+    }
+
+    SDL_free(jobs);
+}
+
+int SDL_GetNumJobWorkers(void)
+{
+    // Workers are already running if we're on one of them
+    if (!SDL_GetTLS(&SDL_job_worker_tls)) {
+        if (SDL_GetAtomicInt(&SDL_jobs_stopping) || !SDL_PrepareJobs()) {
+            return 0;
+        }
+    }
+    return SDL_num_job_workers;
+}
+
+typedef struct SDL_ParallelForJob
+{
+    SDL_ParallelForCallback callback;
+    void *userdata;
+    int start;
+    int end;
+    int grain_size;
+    int num_chunks;
+    SDL_AtomicInt next_chunk;
+} SDL_ParallelForJob;
+
+static void SDLCALL SDL_RunParallelFor(void *data)
+{
+    SDL_ParallelForJob *job = (SDL_ParallelForJob *)data;
+
+    // Every thread keeps claiming the next chunk until there are none left, which balances uneven work
+    for (;;) {
+        const int chunk = SDL_AddAtomicInt(&job->next_chunk, 1);
+        if (chunk >= job->num_chunks) {
+            break;
+        }
+        const Sint64 start = (Sint64)job->start + (Sint64)chunk * job->grain_size;
+        const Sint64 end = SDL_min(start + job->grain_size, (Sint64)job->end);
+        job->callback(job->userdata, (int)start, (int)end);
+    }
+}
+
+bool SDL_ParallelFor(int start, int end, int grain_size, SDL_ParallelForCallback callback, void *userdata)
+{
+    if (!callback) {
+        return SDL_InvalidParamError("callback");
+    }
+    if (end < start) {
+        return SDL_InvalidParamError("end");
+    }
+    if (grain_size < 0) {
+        return SDL_InvalidParamError("grain_size");
+    }
+    if (start == end) {
+        return true;
+    }
+
+    const Sint64 length = (Sint64)end - start;
+    const int num_workers = SDL_GetNumJobWorkers();
+    if (grain_size == 0) {
+        // A few chunks per thread lets faster threads pick up the slack from slower ones
+        const Sint64 num_chunks = (Sint64)(num_workers + 1) * 4;
+        grain_size = (int)((length + num_chunks - 1) / num_chunks);
+    }
+    Sint64 num_chunks = (length + grain_size - 1) / grain_size;
+    if (num_chunks > SDL_MAX_SINT32) {
+        grain_size = (int)((length + SDL_MAX_SINT32 - 1) / SDL_MAX_SINT32);
+        num_chunks = (length + grain_size - 1) / grain_size;
+    }
+
+    if (num_workers == 0 || num_chunks == 1) {
+        callback(userdata, start, end);
+        return true;
+    }
+
+    SDL_ParallelForJob job;
+    job.callback = callback;
+    job.userdata = userdata;
+    job.start = start;
+    job.end = end;
+    job.grain_size = grain_size;
+    job.num_chunks = (int)num_chunks;
+    SDL_SetAtomicInt(&job.next_chunk, 0);
+
+    void *jobs[SDL_MAX_JOB_WORKERS + 1];
+    const int num_jobs = (int)SDL_min(num_chunks, (Sint64)num_workers + 1);
+    for (int i = 0; i < num_jobs; ++i) {
+        jobs[i] = &job;
+    }
+    SDL_RunJobsAndWait(SDL_RunParallelFor, jobs, num_jobs);
+    return true;
+}
+
+// Arrays smaller than this aren't worth the cost of handing out to other threads
+#define SDL_PARALLEL_SORT_MIN_ELEMENTS 4096
+#define SDL_PARALLEL_SORT_MAX_RUNS 32
+
+typedef struct SDL_ParallelSortState
+{
+    Uint8 *base;
+    Uint8 *temp;
+    size_t size;
+    SDL_CompareCallback_r compare;
+    void *userdata;
+    size_t bounds[SDL_PARALLEL_SORT_MAX_RUNS + 1];  // run i is elements bounds[i] up to bounds[i + 1]
+    int width;       // the number of runs already merged together at the start of this round
+    Uint8 *src;
+    Uint8 *dst;
+} SDL_ParallelSortState;
+
+static void SDLCALL SDL_SortRuns(void *data, int start, int end)
+{
+    SDL_ParallelSortState *state = (SDL_ParallelSortState *)data;
+
+    for (int i = start; i < end; ++i) {
+        const size_t first = state->bounds[i];
+        SDL_qsort_r(state->base + first * state->size, state->bounds[i + 1] - first, state->size, state->compare, state->userdata);
+    }
+}
+
+static void SDLCALL SDL_MergeRuns(void *data, int start, int end)
+{
+    SDL_ParallelSortState *state = (SDL_ParallelSortState *)data;
+    const size_t size = state->size;
+
+    for (int i = start; i < end; ++i) {
+        // Merge pair i, which is the run starting at lo with the one starting at mid, from src into dst
+        const int first_run = i * state->width * 2;
+        const size_t lo = state->bounds[first_run];
+        const size_t mid = state->bounds[first_run + state->width];
+        const size_t hi = state->bounds[first_run + state->width * 2];
+        const Uint8 *a = state->src + lo * size;
+        const Uint8 *a_end = state->src + mid * size;
+        const Uint8 *b = a_end;
+        const Uint8 *b_end = state->src + hi * size;
+        Uint8 *out = state->dst + lo * size;
+
+        while (a < a_end && b < b_end) {
+            if (state->compare(state->userdata, b, a) < 0) {
+                SDL_memcpy(out, b, size);
+                b += size;
+            } else {
+                SDL_memcpy(out, a, size);
+                a += size;
+            }
+            out += size;
+        }
+        if (a < a_end) {
+            SDL_memcpy(out, a, (size_t)(a_end - a));
+        } else if (b < b_end) {
+            SDL_memcpy(out, b, (size_t)(b_end - b));
+        }
+    }
+}
+
+void SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    if (!base || !compare || size == 0) {
+        return;
+    }
+
+    const int num_workers = (nmemb >= SDL_PARALLEL_SORT_MIN_ELEMENTS) ? SDL_GetNumJobWorkers() : 0;
+    Uint8 *temp = NULL;
+    if (num_workers >= 2 && nmemb <= SDL_SIZE_MAX / size) {
+        temp = (Uint8 *)SDL_malloc(nmemb * size);
+    }
+    if (!temp) {
+        SDL_qsort_r(base, nmemb, size, compare, userdata);
+        return;
+    }
+
+    /* Sort a power-of-two number of runs side by side, then merge neighbouring
+       runs back and forth between the array and the scratch buffer, halving
+       the number of runs each round. The merge rounds use fewer threads as
+       they go, but they are linear, so the sort itself dominates. */
+    SDL_ParallelSortState state;
+    SDL_zero(state);
+    state.base = (Uint8 *)base;
+    state.temp = temp;
+    state.size = size;
+    state.compare = compare;
+    state.userdata = userdata;
+
+    int num_runs = 1;
+    while (num_runs < SDL_PARALLEL_SORT_MAX_RUNS && num_runs < (num_workers + 1) * 2) {
+        num_runs *= 2;
+    }
+    for (int i = 0; i <= num_runs; ++i) {
+        state.bounds[i] = (size_t)(((Uint64)nmemb * i) / num_runs);
+    }
+
+    SDL_ParallelFor(0, num_runs, 1, SDL_SortRuns, &state);
+
+    state.src = state.base;
+    state.dst = state.temp;
+    for (state.width = 1; state.width < num_runs; state.width *= 2) {
+        SDL_ParallelFor(0, num_runs / (state.width * 2), 1, SDL_MergeRuns, &state);
+        Uint8 *swap = state.src;
+        state.src = state.dst;
+        state.dst = swap;
+    }
+
+    if (state.src != state.base) {
+        SDL_memcpy(state.base, state.src, nmemb * size);
+    }
+    SDL_free(temp);
+}
+
+void SDL_QuitJobs(void)
+{
+    if (!SDL_ShouldQuit(&SDL_jobs_init)) {
+        return;
+    }
+
+    SDL_SetAtomicInt(&SDL_jobs_stopping, 1);
+    for (int i = 0; i < SDL_num_job_workers; ++i) {
+        SDL_SignalSemaphore(SDL_job_semaphore);
+    }
+
+    for (int i = 0; i < SDL_num_job_workers; ++i) {
+        SDL_WaitThread(SDL_job_workers[i].thread, NULL);
+        SDL_job_workers[i].thread = NULL;
+    }
+
+    // Run anything the workers left behind on the way out
+    SDL_Job job;
+    for (int i = 0; i < SDL_num_job_workers; ++i) {
+        while (SDL_PopOldestJob(&SDL_job_workers[i], &job)) {
+            job.callback(job.userdata);
+        }
+    }
+
+    for (int i = 0; i < SDL_MAX_JOB_WORKERS; ++i) {
+        SDL_free(SDL_job_workers[i].jobs);
+        SDL_zero(SDL_job_workers[i]);
+    }
+    SDL_num_job_workers = 0;
+
+    SDL_DestroySemaphore(SDL_job_semaphore);
+    SDL_job_semaphore = NULL;
+
+    SDL_SetAtomicInt(&SDL_jobs_stopping, 0);
+
+    SDL_SetInitialized(&SDL_jobs_init, false);
+}
@@ -0,0 +1,39 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_jobs_c_h_
+#define SDL_jobs_c_h_
+
+// SDL_GetNumJobWorkers() never returns more than this.
+#define SDL_MAX_JOB_WORKERS 16
+
+// Run callback(userdata[i]) for each of the count entries on the job workers, and return once they have all finished.
+// The calling thread runs one of them itself, and helps with queued jobs while it waits, so this is safe to call from a job.
+extern void SDL_RunJobsAndWait(SDL_JobFunction callback, void **userdata, int count);
+
+// Returns the number of workers jobs can be spread across, starting them if needed. This is 0 if they can't run.
+extern int SDL_GetNumJobWorkers(void);
+
+// Shut down the shared job workers, running anything still queued. Called from SDL_Quit().
+extern void SDL_QuitJobs(void);
+
+#endif // SDL_jobs_c_h_
@@ -46,6 +46,10 @@ extern void SDL_SYS_SetupThread(const char *name);
 // This function sets the current thread priority
 extern bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority);
 
+// These functions restrict the current thread to some CPUs, or a kind of core
+extern bool SDL_SYS_SetThreadAffinity(Uint64 mask);
+extern bool SDL_SYS_SetThreadCoreType(SDL_CPUCoreType type);
+
 /* This function waits for the thread to finish and frees any data
    allocated by SDL_SYS_CreateThread()
  */
@@ -25,15 +25,37 @@
 #include "SDL_thread_c.h"
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
+#include "../SDL_trace_c.h"
 
 // The storage is local to the thread, but the IDs are global for the process
 
 static SDL_AtomicInt SDL_tls_allocated;
 static SDL_AtomicInt SDL_tls_id;
 
+#ifdef SDL_THREAD_LOCAL
+// With compiler support, each thread's storage is a plain thread-local and the system TLS goes unused
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_storage;
+
+static SDL_TLSData *GetTLSData(void)
+{
+    return SDL_tls_storage;
+}
+
+static bool SetTLSData(SDL_TLSData *data)
+{
+    SDL_tls_storage = data;
+    return true;
+}
+#else
+#define GetTLSData  SDL_SYS_GetTLSData
+#define SetTLSData  SDL_SYS_SetTLSData
+#endif
+
 void SDL_InitTLSData(void)
 {
+#ifndef SDL_THREAD_LOCAL
     SDL_SYS_InitTLSData();
+#endif
 }
 
 void *SDL_GetTLS(SDL_TLSID *id)
@@ -47,7 +69,7 @@ void *SDL_GetTLS(SDL_TLSID *id)
     }
 
     storage_index = SDL_GetAtomicInt(id) - 1;
-    storage = SDL_SYS_GetTLSData();
+    storage = GetTLSData();
     if (!storage || storage_index < 0 || storage_index >= storage->limit) {
         return NULL;
     }
@@ -83,7 +105,7 @@ bool SDL_SetTLS(SDL_TLSID *id, const void *value, SDL_TLSDestructorCallback dest
     }
 
     // Get the storage for the current thread
-    storage = SDL_SYS_GetTLSData();
+    storage = GetTLSData();
     if (!storage || storage_index >= storage->limit) {
         unsigned int i, oldlimit, newlimit;
         SDL_TLSData *new_storage;
@@ -100,7 +122,7 @@ bool SDL_SetTLS(SDL_TLSID *id, const void *value, SDL_TLSDestructorCallback dest
             storage->array[i].data = NULL;
             storage->array[i].destructor = NULL;
         }
-        if (!SDL_SYS_SetTLSData(storage)) {
+        if (!SetTLSData(storage)) {
             SDL_free(storage);
             return false;
         }
@@ -117,7 +139,7 @@ void SDL_CleanupTLS(void)
     SDL_TLSData *storage;
 
     // Cleanup the storage for the current thread
-    storage = SDL_SYS_GetTLSData();
+    storage = GetTLSData();
     if (storage) {
         int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -125,7 +147,7 @@ void SDL_CleanupTLS(void)
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
-        SDL_SYS_SetTLSData(NULL);
+        SetTLSData(NULL);
         SDL_free(storage);
         (void)SDL_AtomicDecRef(&SDL_tls_allocated);
     }
@@ -136,7 +158,9 @@ void SDL_QuitTLSData(void)
     SDL_CleanupTLS();
 
     if (SDL_GetAtomicInt(&SDL_tls_allocated) == 0) {
+#ifndef SDL_THREAD_LOCAL
         SDL_SYS_QuitTLSData();
+#endif
     } else {
         // Some thread hasn't called SDL_CleanupTLS()
     }
@@ -260,10 +284,18 @@ static SDL_error *SDL_GetStaticErrBuf(void)
 }
 
 #ifndef SDL_THREADS_DISABLED
+#ifdef SDL_THREAD_LOCAL
+// Every SDL_SetError() lands here, so skip the TLS lookup when we can
+static SDL_THREAD_LOCAL SDL_error *SDL_errbuf;
+#endif
+
 static void SDLCALL SDL_FreeErrBuf(void *data)
 {
     SDL_error *errbuf = (SDL_error *)data;
 
+#ifdef SDL_THREAD_LOCAL
+    SDL_errbuf = NULL; // destructors run on the thread that owns the data
+#endif
     if (errbuf->str) {
         errbuf->free_func(errbuf->str);
     }
@@ -280,6 +312,12 @@ SDL_error *SDL_GetErrBuf(bool create)
     static SDL_TLSID tls_errbuf;
     SDL_error *errbuf;
 
+#ifdef SDL_THREAD_LOCAL
+    if (SDL_errbuf) {
+        return SDL_errbuf;
+    }
+#endif
+
     errbuf = (SDL_error *)SDL_GetTLS(&tls_errbuf);
     if (!errbuf) {
         if (!create) {
@@ -300,7 +338,11 @@ SDL_error *SDL_GetErrBuf(bool create)
         SDL_zerop(errbuf);
         errbuf->realloc_func = realloc_func;
         errbuf->free_func = free_func;
-        SDL_SetTLS(&tls_errbuf, errbuf, SDL_FreeErrBuf);
+        if (SDL_SetTLS(&tls_errbuf, errbuf, SDL_FreeErrBuf)) {
+#ifdef SDL_THREAD_LOCAL
+            SDL_errbuf = errbuf;
+#endif
+        }
     }
     return errbuf;
 #endif // SDL_THREADS_DISABLED
@@ -321,9 +363,19 @@ void SDL_RunThread(SDL_Thread *thread)
     // Perform any system-dependent setup - this function may not fail
     SDL_SYS_SetupThread(thread->name);
 
+    // Placement is only a hint, so the thread runs even if this fails
+    if (thread->coretype != SDL_CPU_CORE_ANY) {
+        SDL_SYS_SetThreadCoreType(thread->coretype);
+    }
+    if (thread->affinity) {
+        SDL_SYS_SetThreadAffinity(thread->affinity);
+    }
+
     // Get the thread id
     thread->threadid = SDL_GetCurrentThreadID();
 
+    SDL_TRACE_THREAD_NAME(thread->name);
+
     // Run the function
     *statusloc = userfunc(userdata);
 
@@ -356,12 +408,19 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     const char *name = SDL_GetStringProperty(props, SDL_PROP_THREAD_CREATE_NAME_STRING, NULL);
     const size_t stacksize = (size_t) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_STACKSIZE_NUMBER, 0);
     void *userdata = SDL_GetPointerProperty(props, SDL_PROP_THREAD_CREATE_USERDATA_POINTER, NULL);
+    const Uint64 affinity = (Uint64) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_AFFINITY_NUMBER, 0);
+    const SDL_CPUCoreType coretype = (SDL_CPUCoreType) SDL_GetNumberProperty(props, SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER, SDL_CPU_CORE_ANY);
 
     if (!fn) {
         SDL_SetError("Thread entry function is NULL");
         return NULL;
     }
 
+    if (coretype < SDL_CPU_CORE_ANY || coretype > SDL_CPU_CORE_EFFICIENCY) {
+        SDL_InvalidParamError("SDL_PROP_THREAD_CREATE_CORE_TYPE_NUMBER");
+        return NULL;
+    }
+
     SDL_InitMainThread();
 
     SDL_Thread *thread = (SDL_Thread *)SDL_calloc(1, sizeof(*thread));
@@ -383,6 +442,8 @@ SDL_Thread *SDL_CreateThreadWithPropertiesRuntime(SDL_PropertiesID props,
     thread->userfunc = fn;
     thread->userdata = userdata;
     thread->stacksize = stacksize;
+    thread->affinity = affinity;
+    thread->coretype = coretype;
 
     SDL_SetObjectValid(thread, SDL_OBJECT_TYPE_THREAD, true);
 
@@ -454,6 +515,22 @@ bool SDL_SetCurrentThreadPriority(SDL_ThreadPriority priority)
     return SDL_SYS_SetThreadPriority(priority);
 }
 
+bool SDL_SetCurrentThreadAffinity(Uint64 mask)
+{
+    if (!mask) {
+        return SDL_InvalidParamError("mask");
+    }
+    return SDL_SYS_SetThreadAffinity(mask);
+}
+
+bool SDL_SetCurrentThreadCoreType(SDL_CPUCoreType type)
+{
+    if (type < SDL_CPU_CORE_ANY || type > SDL_CPU_CORE_EFFICIENCY) {
+        return SDL_InvalidParamError("type");
+    }
+    return SDL_SYS_SetThreadCoreType(type);
+}
+
 void SDL_WaitThread(SDL_Thread *thread, int *status)
 {
     if (!ThreadValid(thread)) {
@@ -581,3 +658,95 @@ void SDL_SetInitialized(SDL_InitState *state, bool initialized)
     }
 }
 
+
+// Lock contention statistics, shared by all mutexes created with the same name
+
+#define SDL_MAX_MUTEX_PROFILES 64
+
+struct SDL_MutexProfile
+{
+    char name[32];
+    SDL_SpinLock lock;
+    Uint64 num_locks;
+    Uint64 num_contended;
+    Uint64 total_wait;  // in performance counter ticks
+    Uint64 max_wait;    // in performance counter ticks
+};
+
+static SDL_SpinLock SDL_mutex_profiles_lock;
+static SDL_MutexProfile SDL_mutex_profiles[SDL_MAX_MUTEX_PROFILES];
+static int SDL_num_mutex_profiles;
+
+static SDL_MutexProfile *SDL_FindMutexProfile(const char *name)
+{
+    int i;
+
+    for (i = 0; i < SDL_num_mutex_profiles; ++i) {
+        if (SDL_strncmp(SDL_mutex_profiles[i].name, name, sizeof(SDL_mutex_profiles[i].name) - 1) == 0) {
+            return &SDL_mutex_profiles[i];
+        }
+    }
+    return NULL;
+}
+
+SDL_MutexProfile *SDL_GetMutexProfile(const char *name)
+{
+    SDL_MutexProfile *profile;
+
+    if (!name || !*name || !SDL_GetHintBoolean(SDL_HINT_MUTEX_PROFILING, false)) {
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&SDL_mutex_profiles_lock);
+    profile = SDL_FindMutexProfile(name);
+    if (!profile && SDL_num_mutex_profiles < SDL_MAX_MUTEX_PROFILES) {
+        profile = &SDL_mutex_profiles[SDL_num_mutex_profiles++];
+        SDL_strlcpy(profile->name, name, sizeof(profile->name));
+    }
+    SDL_UnlockSpinlock(&SDL_mutex_profiles_lock);
+
+    return profile;
+}
+
+void SDL_RecordMutexLock(SDL_MutexProfile *profile, Uint64 wait)
+{
+    SDL_LockSpinlock(&profile->lock);
+    ++profile->num_locks;
+    if (wait) {
+        ++profile->num_contended;
+        profile->total_wait += wait;
+        if (wait > profile->max_wait) {
+            profile->max_wait = wait;
+        }
+    }
+    SDL_UnlockSpinlock(&profile->lock);
+}
+
+bool SDL_GetMutexContentionStats(const char *name, SDL_MutexContentionStats *stats)
+{
+    SDL_MutexProfile *profile;
+    Uint64 freq;
+
+    if (!name) {
+        return SDL_InvalidParamError("name");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&SDL_mutex_profiles_lock);
+    profile = SDL_FindMutexProfile(name);
+    SDL_UnlockSpinlock(&SDL_mutex_profiles_lock);
+    if (!profile) {
+        return SDL_SetError("No contention statistics recorded for %s", name);
+    }
+
+    freq = SDL_GetPerformanceFrequency();
+    SDL_LockSpinlock(&profile->lock);
+    stats->num_locks = profile->num_locks;
+    stats->num_contended = profile->num_contended;
+    stats->total_wait_ns = (Uint64)((double)profile->total_wait * SDL_NS_PER_SECOND / freq);
+    stats->max_wait_ns = (Uint64)((double)profile->max_wait * SDL_NS_PER_SECOND / freq);
+    SDL_UnlockSpinlock(&profile->lock);
+    return true;
+}
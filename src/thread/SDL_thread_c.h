@@ -54,6 +54,8 @@ struct SDL_Thread
     SDL_error errbuf;
     char *name;
     size_t stacksize; // 0 for default, >0 for user-specified stack size.
+    Uint64 affinity;  // 0 for default, otherwise a mask of allowed logical CPUs.
+    SDL_CPUCoreType coretype;
     int(SDLCALL *userfunc)(void *);
     void *userdata;
     void *data;
@@ -89,4 +91,13 @@ extern SDL_TLSData *SDL_Generic_GetTLSData(void);
 extern bool SDL_Generic_SetTLSData(SDL_TLSData *data);
 extern void SDL_Generic_QuitTLSData(void);
 
+/* Lock contention statistics for named mutexes.
+   SDL_GetMutexProfile() returns NULL unless SDL_HINT_MUTEX_PROFILING is enabled.
+   Mutex backends that support this record every lock, with the time in
+   performance counter ticks spent waiting for it, or 0 if it wasn't contended.
+ */
+typedef struct SDL_MutexProfile SDL_MutexProfile;
+extern SDL_MutexProfile *SDL_GetMutexProfile(const char *name);
+extern void SDL_RecordMutexLock(SDL_MutexProfile *profile, Uint64 wait);
+
 #endif // SDL_thread_c_h_
@@ -118,6 +118,17 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority sdl_priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    return SDL_Unsupported();
+}
+
+bool SDL_SYS_SetThreadCoreType(SDL_CPUCoreType type)
+{
+    // There's only one kind of core here, so there's nothing to prefer.
+    return true;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     Result res = threadJoin(thread->handle, U64_MAX);
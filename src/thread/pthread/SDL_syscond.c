@@ -28,6 +28,105 @@
 
 #include "SDL_sysmutex_c.h"
 
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+/* Futex condition variables: a sequence number that signalers bump and
+   waiters sleep on. `waiters` counts threads inside a wait and `wakeups`
+   how many of them have been signaled but haven't left yet, so repeated
+   signals while the woken thread waits for the mutex don't make syscalls.
+   Waiters give back a wakeup as they leave, timed out or not, which only
+   ever makes the count low, and a low count just means an extra wake. */
+#include "../../core/linux/SDL_futex.h"
+
+struct SDL_Condition
+{
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt waiters;
+    SDL_AtomicInt wakeups;
+};
+
+// Create a condition variable
+SDL_Condition *SDL_CreateCondition(void)
+{
+    return (SDL_Condition *)SDL_calloc(1, sizeof(SDL_Condition));
+}
+
+// Destroy a condition variable
+void SDL_DestroyCondition(SDL_Condition *cond)
+{
+    SDL_free(cond);
+}
+
+// Claim wakeups for up to `count` waiters that don't have one yet, returns false if there are none
+static bool SDL_ClaimConditionWakeups(SDL_Condition *cond, int count)
+{
+    for (;;) {
+        // Read these in the opposite order waiters update them in
+        const int waiters = SDL_GetAtomicInt(&cond->waiters);
+        const int wakeups = SDL_GetAtomicInt(&cond->wakeups);
+        if (wakeups >= waiters) {
+            return false;
+        }
+        if (SDL_CompareAndSwapAtomicInt(&cond->wakeups, wakeups, wakeups + SDL_min(count, waiters - wakeups))) {
+            return true;
+        }
+    }
+}
+
+// Restart one of the threads that are waiting on the condition variable
+void SDL_SignalCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    if (SDL_ClaimConditionWakeups(cond, 1)) {
+        SDL_AddAtomicInt(&cond->sequence, 1);
+        SDL_FutexWake(&cond->sequence, 1);
+    }
+}
+
+// Restart all threads that are waiting on the condition variable
+void SDL_BroadcastCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    if (SDL_ClaimConditionWakeups(cond, SDL_MAX_SINT32)) {
+        SDL_AddAtomicInt(&cond->sequence, 1);
+        SDL_FutexWake(&cond->sequence, SDL_MAX_SINT32);
+    }
+}
+
+bool SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS) SDL_NO_THREAD_SAFETY_ANALYSIS // the caller holds the mutex
+{
+    bool result;
+    int sequence, wakeups;
+
+    if (!cond || !mutex) {
+        return true;
+    }
+
+    /* The caller holds the mutex, so any signal for a state change it hasn't
+       seen yet comes after we're counted and bumps the sequence we sleep on. */
+    SDL_AddAtomicInt(&cond->waiters, 1);
+    sequence = SDL_GetAtomicInt(&cond->sequence);
+
+    SDL_UnlockMutex(mutex);
+    result = SDL_FutexWait(&cond->sequence, sequence, timeoutNS);
+    SDL_LockMutex(mutex);
+
+    wakeups = SDL_GetAtomicInt(&cond->wakeups);
+    while (wakeups > 0 && !SDL_CompareAndSwapAtomicInt(&cond->wakeups, wakeups, wakeups - 1)) {
+        wakeups = SDL_GetAtomicInt(&cond->wakeups);
+    }
+    SDL_AddAtomicInt(&cond->waiters, -1);
+
+    return result;
+}
+
+#else
+
 struct SDL_Condition
 {
     pthread_cond_t cond;
@@ -126,3 +225,5 @@ tryagain:
     }
     return result;
 }
+
+#endif // SDL_PLATFORM_LINUX || SDL_PLATFORM_ANDROID
@@ -25,7 +25,10 @@
 
 #include "SDL_sysmutex_c.h"
 
-SDL_Mutex *SDL_CreateMutex(void)
+// How many times a non-recursive mutex is polled before sleeping, if pthreads can't spin for us
+#define SDL_MUTEX_SPIN_COUNT 100
+
+SDL_Mutex *SDL_CreateNamedMutex(const char *name, SDL_MutexFlags flags)
 {
     SDL_Mutex *mutex;
     pthread_mutexattr_t attr;
@@ -34,22 +37,40 @@ SDL_Mutex *SDL_CreateMutex(void)
     mutex = (SDL_Mutex *)SDL_calloc(1, sizeof(*mutex));
     if (mutex) {
         pthread_mutexattr_init(&attr);
+        if (flags & SDL_MUTEX_NONRECURSIVE) {
+            mutex->nonrecursive = true;
+#ifdef PTHREAD_ADAPTIVE_MUTEX_INITIALIZER_NP
+            pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#else
+            mutex->spin = true;
+#endif
+        } else {
 #ifdef SDL_THREAD_PTHREAD_RECURSIVE_MUTEX
-        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+            pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
 #elif defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP)
-        pthread_mutexattr_setkind_np(&attr, PTHREAD_MUTEX_RECURSIVE_NP);
+            pthread_mutexattr_setkind_np(&attr, PTHREAD_MUTEX_RECURSIVE_NP);
 #else
-        // No extra attributes necessary
+            // No extra attributes necessary
 #endif
+        }
         if (pthread_mutex_init(&mutex->id, &attr) != 0) {
             SDL_SetError("pthread_mutex_init() failed");
             SDL_free(mutex);
             mutex = NULL;
         }
+        pthread_mutexattr_destroy(&attr);
+    }
+    if (mutex) {
+        mutex->profile = SDL_GetMutexProfile(name);
     }
     return mutex;
 }
 
+SDL_Mutex *SDL_CreateMutex(void)
+{
+    return SDL_CreateNamedMutex(NULL, 0);
+}
+
 void SDL_DestroyMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
@@ -58,6 +79,43 @@ void SDL_DestroyMutex(SDL_Mutex *mutex)
     }
 }
 
+// Lock the underlying pthread mutex, spinning and profiling as needed
+static int SDL_LockMutexInternal(SDL_Mutex *mutex)
+{
+    Uint64 start;
+    int rc;
+
+    if (!mutex->spin && !mutex->profile) {
+        return pthread_mutex_lock(&mutex->id);
+    }
+
+    rc = pthread_mutex_trylock(&mutex->id);
+    if (rc != EBUSY) {
+        if (mutex->profile && rc == 0) {
+            SDL_RecordMutexLock(mutex->profile, 0);
+        }
+        return rc;
+    }
+
+    start = mutex->profile ? SDL_GetPerformanceCounter() : 0;
+    rc = EBUSY;
+    if (mutex->spin) {
+        int i;
+        for (i = 0; i < SDL_MUTEX_SPIN_COUNT && rc == EBUSY; ++i) {
+            SDL_CPUPauseInstruction();
+            rc = pthread_mutex_trylock(&mutex->id);
+        }
+    }
+    if (rc == EBUSY) {
+        rc = pthread_mutex_lock(&mutex->id);
+    }
+    if (mutex->profile && rc == 0) {
+        const Uint64 wait = SDL_GetPerformanceCounter() - start;
+        SDL_RecordMutexLock(mutex->profile, SDL_max(wait, 1));
+    }
+    return rc;
+}
+
 void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
 {
     if (mutex) {
@@ -70,13 +128,13 @@ void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang does
                We set the locking thread id after we obtain the lock
                so unlocks from other threads will fail.
              */
-            const int rc = pthread_mutex_lock(&mutex->id);
+            const int rc = SDL_LockMutexInternal(mutex);
             SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
             mutex->owner = this_thread;
             mutex->recursive = 0;
         }
 #else
-        const int rc = pthread_mutex_lock(&mutex->id);
+        const int rc = SDL_LockMutexInternal(mutex);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
 #endif
     }
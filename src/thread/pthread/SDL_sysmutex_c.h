@@ -23,6 +23,8 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
+#include "../SDL_thread_c.h"
+
 #if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
     defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
 #define FAKE_RECURSIVE_MUTEX
@@ -35,6 +37,9 @@ struct SDL_Mutex
     int recursive;
     pthread_t owner;
 #endif
+    bool nonrecursive;
+    bool spin;
+    SDL_MutexProfile *profile;
 };
 
 #endif // SDL_mutex_c_h_
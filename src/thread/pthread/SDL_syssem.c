@@ -31,6 +31,113 @@
 #if defined(SDL_PLATFORM_MACOS) || defined(SDL_PLATFORM_IOS)
 // macOS doesn't support sem_getvalue() as of version 10.4
 #include "../generic/SDL_syssem.c"
+#elif defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+/* Futex semaphores: taking an available count or signaling with nobody
+   asleep never leaves user space, and timeouts are plain relative waits. */
+#include "../../core/linux/SDL_futex.h"
+
+struct SDL_Semaphore
+{
+    SDL_AtomicInt count;
+    SDL_AtomicInt waiters;
+};
+
+SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_Semaphore *sem;
+
+    if (initial_value > SDL_MAX_SINT32) {
+        SDL_SetError("Semaphore value too large");
+        return NULL;
+    }
+
+    sem = (SDL_Semaphore *)SDL_malloc(sizeof(SDL_Semaphore));
+    if (sem) {
+        SDL_SetAtomicInt(&sem->count, (int)initial_value);
+        SDL_SetAtomicInt(&sem->waiters, 0);
+    }
+    return sem;
+}
+
+void SDL_DestroySemaphore(SDL_Semaphore *sem)
+{
+    SDL_free(sem);
+}
+
+static bool TakeSemaphoreCount(SDL_Semaphore *sem)
+{
+    int count = SDL_GetAtomicInt(&sem->count);
+    while (count > 0) {
+        if (SDL_CompareAndSwapAtomicInt(&sem->count, count, count - 1)) {
+            return true;
+        }
+        count = SDL_GetAtomicInt(&sem->count);
+    }
+    return false;
+}
+
+bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
+{
+    Uint64 deadline = 0;
+    bool result = false;
+
+    if (!sem) {
+        return true;
+    }
+
+    if (TakeSemaphoreCount(sem)) {
+        return true;
+    }
+    if (timeoutNS == 0) {
+        return false;
+    }
+    if (timeoutNS > 0) {
+        deadline = SDL_GetTicksNS() + timeoutNS;
+    }
+
+    // Signalers only make the wake syscall when this is nonzero
+    SDL_AddAtomicInt(&sem->waiters, 1);
+    for (;;) {
+        Sint64 remaining = -1;
+
+        if (TakeSemaphoreCount(sem)) {
+            result = true;
+            break;
+        }
+        if (timeoutNS > 0) {
+            const Uint64 now = SDL_GetTicksNS();
+            if (now >= deadline) {
+                break;
+            }
+            remaining = (Sint64)(deadline - now);
+        }
+        SDL_FutexWait(&sem->count, 0, remaining);
+    }
+    SDL_AddAtomicInt(&sem->waiters, -1);
+
+    return result;
+}
+
+Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return 0;
+    }
+    return (Uint32)SDL_max(SDL_GetAtomicInt(&sem->count), 0);
+}
+
+void SDL_SignalSemaphore(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return;
+    }
+
+    SDL_AddAtomicInt(&sem->count, 1);
+    if (SDL_GetAtomicInt(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count, 1);
+    }
+}
+
 #else
 
 struct SDL_Semaphore
@@ -157,4 +264,4 @@ void SDL_SignalSemaphore(SDL_Semaphore *sem)
     sem_post(&sem->sem);
 }
 
-#endif // SDL_PLATFORM_MACOS
+#endif // SDL_PLATFORM_MACOS || SDL_PLATFORM_IOS
@@ -57,6 +57,15 @@
 #include <kernel/OS.h>
 #endif
 
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+#include <sched.h>
+#elif defined(SDL_PLATFORM_FREEBSD)
+#include <sys/param.h>
+#include <sys/cpuset.h>
+#elif defined(SDL_PLATFORM_APPLE)
+#include <pthread/qos.h>
+#endif
+
 #ifdef HAVE_SIGNAL_H
 // List of signals to mask in the subthreads
 static const int sig_list[] = {
@@ -282,6 +291,80 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif // #if SDL_PLATFORM_RISCOS
 }
 
+bool SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)
+    /* Android's libc has no pthread_setaffinity_np(), but on Linux
+       sched_setaffinity() with a pid of 0 means the calling thread. */
+    cpu_set_t set;
+    int cpu;
+
+    CPU_ZERO(&set);
+    for (cpu = 0; cpu < 64; ++cpu) {
+        if (mask & (SDL_UINT64_C(1) << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        return SDL_SetError("sched_setaffinity() failed: %s", strerror(errno));
+    }
+    return true;
+#elif defined(SDL_PLATFORM_FREEBSD)
+    cpuset_t set;
+    int cpu;
+
+    CPU_ZERO(&set);
+    for (cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; ++cpu) {
+        if (mask & (SDL_UINT64_C(1) << cpu)) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        return SDL_SetError("pthread_setaffinity_np() failed");
+    }
+    return true;
+#else
+    // Apple platforms (among others) have no way to pin a thread to a CPU.
+    return SDL_Unsupported();
+#endif
+}
+
+bool SDL_SYS_SetThreadCoreType(SDL_CPUCoreType type)
+{
+#ifdef SDL_PLATFORM_APPLE
+    qos_class_t qos;
+    int rc;
+
+    switch (type) {
+    case SDL_CPU_CORE_PERFORMANCE:
+        qos = QOS_CLASS_USER_INTERACTIVE;
+        break;
+    case SDL_CPU_CORE_EFFICIENCY:
+        qos = QOS_CLASS_UTILITY;
+        break;
+    default:
+        qos = QOS_CLASS_DEFAULT;
+        break;
+    }
+    rc = pthread_set_qos_class_self_np(qos, 0);
+    if (rc != 0) {
+        return SDL_SetError("pthread_set_qos_class_self_np() failed: %s", strerror(rc));
+    }
+    return true;
+#else
+    const Uint64 mask = SDL_GetCPUCoreMask(type);
+    if (!mask) {
+        // No cores of this type, leave the thread where it is.
+        return true;
+    }
+#if defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID) || defined(SDL_PLATFORM_FREEBSD)
+    return SDL_SYS_SetThreadAffinity(mask);
+#else
+    return true;
+#endif
+#endif // SDL_PLATFORM_APPLE
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     pthread_join(thread->handle, 0);
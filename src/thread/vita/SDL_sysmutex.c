@@ -52,6 +52,14 @@ SDL_Mutex *SDL_CreateMutex(void)
     return mutex;
 }
 
+SDL_Mutex *SDL_CreateNamedMutex(const char *name, SDL_MutexFlags flags)
+{
+    // Contention profiling isn't supported here, and recursive mutexes are fine for everything
+    (void)name;
+    (void)flags;
+    return SDL_CreateMutex();
+}
+
 void SDL_DestroyMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
@@ -100,6 +100,17 @@ SDL_ThreadID SDL_GetCurrentThreadID(void)
     return (SDL_ThreadID)sceKernelGetThreadId();
 }
 
+bool SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    return SDL_Unsupported();
+}
+
+bool SDL_SYS_SetThreadCoreType(SDL_CPUCoreType type)
+{
+    // There's only one kind of core here, so there's nothing to prefer.
+    return true;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     sceKernelWaitThreadEnd(thread->handle, NULL, NULL);
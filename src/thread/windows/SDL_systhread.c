@@ -27,6 +27,7 @@
 #include "../SDL_thread_c.h"
 #include "../SDL_systhread.h"
 #include "SDL_systhread_c.h"
+#include "../../cpuinfo/SDL_cpuinfo_c.h"
 
 #ifndef STACK_SIZE_PARAM_IS_A_RESERVATION
 #define STACK_SIZE_PARAM_IS_A_RESERVATION 0x00010000
@@ -183,6 +184,56 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(Uint64 mask)
+{
+    const DWORD_PTR affinity = (DWORD_PTR)mask;
+    if (!affinity) {
+        return SDL_SetError("No CPUs in the affinity mask are usable on 32-bit Windows");
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), affinity)) {
+        return WIN_SetError("SetThreadAffinityMask()");
+    }
+    return true;
+}
+
+typedef BOOL(WINAPI *pfnSetThreadSelectedCpuSets)(HANDLE, const ULONG *, ULONG);
+
+bool SDL_SYS_SetThreadCoreType(SDL_CPUCoreType type)
+{
+    static pfnSetThreadSelectedCpuSets pSetThreadSelectedCpuSets = NULL;
+    static bool checked = false;
+    ULONG ids[64];
+    Uint32 cpuset_ids[64];
+    int i, count = 0;
+
+    if (!checked) {
+        HMODULE kernel32 = GetModuleHandle(TEXT("kernel32.dll"));
+        if (kernel32) {
+            pSetThreadSelectedCpuSets = (pfnSetThreadSelectedCpuSets)GetProcAddress(kernel32, "SetThreadSelectedCpuSets");
+        }
+        checked = true;
+    }
+    if (!pSetThreadSelectedCpuSets) {
+        // Before Windows 10 there are no CPU sets, and no hybrid CPUs to speak of.
+        return true;
+    }
+
+    // An empty list clears the selection, which is what SDL_CPU_CORE_ANY wants.
+    if (type != SDL_CPU_CORE_ANY) {
+        count = SDL_GetWindowsCPUSetIDs(SDL_GetCPUCoreMask(type), cpuset_ids);
+        if (count == 0) {
+            return true;
+        }
+        for (i = 0; i < count; ++i) {
+            ids[i] = cpuset_ids[i];
+        }
+    }
+    if (!pSetThreadSelectedCpuSets(GetCurrentThread(), count ? ids : NULL, (ULONG)count)) {
+        return WIN_SetError("SetThreadSelectedCpuSets()");
+    }
+    return true;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitForSingleObjectEx(thread->handle, INFINITE, FALSE);
@@ -35,24 +35,21 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 sequence;
+    bool job_worker;
     SDL_AtomicInt canceled;
+    SDL_SpinLock stats_lock;
+    SDL_TimerStats stats;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-// The timers are kept in a sorted list
+// The timers are kept in a binary min-heap, ordered by scheduling time
 typedef struct
 {
     // Data used by the main thread
     SDL_InitState init;
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     // Padding to separate cache lines between threads
@@ -64,9 +61,13 @@ typedef struct
     SDL_Timer *pending;
     SDL_Timer *freelist;
     SDL_AtomicInt active;
+    SDL_AtomicInt running_jobs;
 
-    // List of timers - this is only touched by the timer thread
-    SDL_Timer *timers;
+    // Heap of timers - this is only touched by the timer thread
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -77,24 +78,128 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+// Timers scheduled for the same time fire in the order they were queued
+static SDL_INLINE bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
 {
-    SDL_Timer *prev, *curr;
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+static bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    SDL_Timer **timers = data->timers;
+    int i, parent;
+
+    if (data->num_timers == data->max_timers) {
+        int max_timers = data->max_timers ? data->max_timers * 2 : 64;
+        timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return false;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    // Sift the new timer up to its place in the heap
+    for (i = data->num_timers++; i > 0; i = parent) {
+        parent = (i - 1) / 2;
+        if (!SDL_TimerBefore(timer, timers[parent])) {
+            break;
+        }
+        timers[i] = timers[parent];
+    }
+    timers[i] = timer;
+    return true;
+}
+
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer **timers = data->timers;
+    SDL_Timer *first = timers[0];
+    SDL_Timer *last = timers[--data->num_timers];
+    const int num_timers = data->num_timers;
+    int i, child;
+
+    // Sift the last timer down from the top of the heap
+    for (i = 0; (child = 2 * i + 1) < num_timers; i = child) {
+        if (child + 1 < num_timers && SDL_TimerBefore(timers[child + 1], timers[child])) {
+            ++child;
+        }
+        if (!SDL_TimerBefore(timers[child], last)) {
             break;
         }
+        timers[i] = timers[child];
     }
+    timers[i] = last;
+    return first;
+}
 
-    // Insert the timer here!
-    if (prev) {
-        prev->next = timer;
+// Call a timer's callback and record how long it took and how late it was, returning the next interval
+static Uint64 SDL_CallTimer(SDL_Timer *timer, Uint64 *started)
+{
+    const Uint64 start = SDL_GetTicksNS();
+    Uint64 interval;
+
+    if (timer->callback_ms) {
+        interval = SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
+    } else {
+        interval = timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
+    }
+
+    const Uint64 duration = SDL_GetTicksNS() - start;
+    const Uint64 lateness = (start > timer->scheduled) ? (start - timer->scheduled) : 0;
+    SDL_LockSpinlock(&timer->stats_lock);
+    {
+        SDL_TimerStats *stats = &timer->stats;
+        ++stats->num_calls;
+        stats->total_callback_ns += duration;
+        stats->max_callback_ns = SDL_max(stats->max_callback_ns, duration);
+        stats->total_lateness_ns += lateness;
+        stats->max_lateness_ns = SDL_max(stats->max_lateness_ns, lateness);
+    }
+    SDL_UnlockSpinlock(&timer->stats_lock);
+
+    *started = start;
+    return interval;
+}
+
+/* Timers created to run on the job workers are handed off by the timer
+   thread when they're due, and handed back through the pending list once
+   their callback returns, so they never run more than once at a time. */
+static void SDLCALL SDL_RunTimerJob(void *_timer)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_Timer *timer = (SDL_Timer *)_timer;
+    Uint64 start = 0;
+    Uint64 interval = 0;
+
+    if (!SDL_GetAtomicInt(&timer->canceled)) {
+        interval = SDL_CallTimer(timer, &start);
+    }
+
+    SDL_LockSpinlock(&data->lock);
+    if (interval > 0) {
+        timer->interval = interval;
+        timer->scheduled = start + interval;
+        timer->next = data->pending;
+        data->pending = timer;
     } else {
-        data->timers = timer;
+        SDL_SetAtomicInt(&timer->canceled, 1);
+        timer->next = data->freelist;
+        data->freelist = timer;
+    }
+    SDL_UnlockSpinlock(&data->lock);
+
+    if (interval > 0) {
+        SDL_SignalSemaphore(data->sem);
     }
-    timer->next = curr;
+
+    // Shutdown waits for this before tearing down the timer data
+    SDL_AddAtomicInt(&data->running_jobs, -1);
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -102,9 +207,11 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
     SDL_Timer *current;
+    SDL_Timer *expired;
+    SDL_Timer *expired_tail;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
-    Uint64 tick, now, interval, delay;
+    Uint64 tick, now, interval, delay, start;
 
     /* Threaded timer loop:
      *  1. Queue timers added by other threads
@@ -127,11 +234,24 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        // Sort the pending timers into our list
+        // Sort the pending timers into our heap
         while (pending) {
             current = pending;
+            if (!SDL_AddTimerInternal(data, current)) {
+                break;
+            }
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+        }
+        if (pending) {
+            // We couldn't grow the heap, put these back and try again shortly
+            SDL_LockSpinlock(&data->lock);
+            {
+                for (current = pending; current->next; current = current->next) {
+                }
+                current->next = data->pending;
+                data->pending = pending;
+            }
+            SDL_UnlockSpinlock(&data->lock);
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -146,31 +266,46 @@ static int SDLCALL SDL_TimerThread(void *_data)
 
         tick = SDL_GetTicksNS();
 
-        // Process all the pending timers for this tick
-        while (data->timers) {
-            current = data->timers;
+        // Pull every timer due this tick off the heap in one go
+        expired = NULL;
+        expired_tail = NULL;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
-                // Scheduled for the future, wait a bit
-                delay = (current->scheduled - tick);
                 break;
             }
 
-            // We're going to do something with this timer
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
+            current->next = NULL;
+            if (expired_tail) {
+                expired_tail->next = current;
+            } else {
+                expired = current;
+            }
+            expired_tail = current;
+        }
+
+        // Process all the timers for this tick
+        while (expired) {
+            current = expired;
+            expired = current->next;
 
             if (SDL_GetAtomicInt(&current->canceled)) {
                 interval = 0;
             } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
-                } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
+                if (current->job_worker) {
+                    SDL_AddAtomicInt(&data->running_jobs, 1);
+                    if (SDL_SubmitJob(SDL_RunTimerJob, current)) {
+                        continue;
+                    }
+                    SDL_AddAtomicInt(&data->running_jobs, -1);
                 }
+                interval = SDL_CallTimer(current, &start);
             }
 
             if (interval > 0) {
-                // Reschedule this timer
+                // Reschedule this timer, the heap has room since it was just removed
                 current->interval = interval;
                 current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
@@ -187,6 +322,16 @@ static int SDLCALL SDL_TimerThread(void *_data)
             }
         }
 
+        // Wait until the next timer is due
+        if (data->num_timers > 0) {
+            current = data->timers[0];
+            delay = (tick < current->scheduled) ? (current->scheduled - tick) : 0;
+        }
+
+        if (pending) {
+            delay = SDL_min(delay, SDL_MS_TO_NS(1));
+        }
+
         // Adjust the delay based on processing time
         now = SDL_GetTicksNS();
         interval = (now - tick);
@@ -214,11 +359,16 @@ bool SDL_InitTimers(void)
         return true;
     }
 
-    data->timermap_lock = SDL_CreateMutex();
+    data->timermap_lock = SDL_CreateNamedMutex("SDL_timers", SDL_MUTEX_NONRECURSIVE);
     if (!data->timermap_lock) {
         goto error;
     }
 
+    data->timermap = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    if (!data->timermap) {
+        goto error;
+    }
+
     data->sem = SDL_CreateSemaphore(0);
     if (!data->sem) {
         goto error;
@@ -245,7 +395,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (!SDL_ShouldQuit(&data->init)) {
         return;
@@ -260,15 +410,27 @@ void SDL_QuitTimers(void)
         data->thread = NULL;
     }
 
+    // Let any callbacks running on the job workers hand their timers back
+    while (SDL_GetAtomicInt(&data->running_jobs) > 0) {
+        SDL_Delay(1);
+    }
+
     if (data->sem) {
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
     }
 
     // Clean up the timer entries
-    while (data->timers) {
-        timer = data->timers;
-        data->timers = timer->next;
+    for (i = 0; i < data->num_timers; ++i) {
+        SDL_free(data->timers[i]);
+    }
+    SDL_free(data->timers);
+    data->timers = NULL;
+    data->num_timers = 0;
+    data->max_timers = 0;
+    while (data->pending) {
+        timer = data->pending;
+        data->pending = timer->next;
         SDL_free(timer);
     }
     while (data->freelist) {
@@ -276,11 +438,9 @@ void SDL_QuitTimers(void)
         data->freelist = timer->next;
         SDL_free(timer);
     }
-    while (data->timermap) {
-        entry = data->timermap;
-        data->timermap = entry->next;
-        SDL_free(entry);
-    }
+
+    SDL_DestroyHashTable(data->timermap);
+    data->timermap = NULL;
 
     if (data->timermap_lock) {
         SDL_DestroyMutex(data->timermap_lock);
@@ -295,11 +455,11 @@ static bool SDL_CheckInitTimers(void)
     return SDL_InitTimers();
 }
 
-static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata)
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata, bool job_worker)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    bool added;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -318,7 +478,10 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     SDL_UnlockSpinlock(&data->lock);
 
     if (timer) {
-        SDL_RemoveTimer(timer->timerID);
+        // Forget the ID of the timer that used this structure, if it finished on its own
+        SDL_LockMutex(data->timermap_lock);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
+        SDL_UnlockMutex(data->timermap_lock);
     } else {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
         if (!timer) {
@@ -331,20 +494,18 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->userdata = userdata;
     timer->interval = interval;
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
+    timer->job_worker = job_worker;
     SDL_SetAtomicInt(&timer->canceled, 0);
+    timer->stats_lock = 0;
+    SDL_zero(timer->stats);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer, false);
+    SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     // Add the timer to the pending list for the timer thread
     SDL_LockSpinlock(&data->lock);
@@ -355,23 +516,23 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     // Wake up the timer thread if necessary
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata);
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata, false);
 }
 
 SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(interval, NULL, callback, userdata);
+    return SDL_CreateTimer(interval, NULL, callback, userdata, false);
 }
 
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer = NULL;
     bool canceled = false;
 
     if (!id) {
@@ -380,25 +541,16 @@ bool SDL_RemoveTimer(SDL_TimerID id)
 
     // Find the timer
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_GetAtomicInt(&entry->timer->canceled)) {
-            SDL_SetAtomicInt(&entry->timer->canceled, 1);
+    if (timer) {
+        if (!SDL_GetAtomicInt(&timer->canceled)) {
+            SDL_SetAtomicInt(&timer->canceled, 1);
             canceled = true;
         }
-        SDL_free(entry);
     }
     if (canceled) {
         return true;
@@ -407,6 +559,33 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_Timer *timer = NULL;
+
+    if (!id) {
+        return SDL_InvalidParamError("id");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    // Timer structures aren't reused until they're out of the map, so this is safe while holding the lock
+    SDL_LockMutex(data->timermap_lock);
+    if (SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_LockSpinlock(&timer->stats_lock);
+        SDL_copyp(stats, &timer->stats);
+        SDL_UnlockSpinlock(&timer->stats_lock);
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!timer) {
+        return SDL_SetError("Timer not found");
+    }
+    return true;
+}
+
 #else
 
 #include <emscripten/emscripten.h>
@@ -420,6 +599,8 @@ typedef struct SDL_TimerMap
     SDL_TimerCallback callback_ms;
     SDL_NSTimerCallback callback_ns;
     void *userdata;
+    Uint64 scheduled;
+    SDL_TimerStats stats;
     struct SDL_TimerMap *next;
 } SDL_TimerMap;
 
@@ -433,12 +614,23 @@ static SDL_TimerData SDL_timer_data;
 static void SDL_Emscripten_TimerHelper(void *userdata)
 {
     SDL_TimerMap *entry = (SDL_TimerMap *)userdata;
+    const Uint64 start = SDL_GetTicksNS();
     if (entry->callback_ms) {
         entry->interval = SDL_MS_TO_NS(entry->callback_ms(entry->userdata, entry->timerID, (Uint32)SDL_NS_TO_MS(entry->interval)));
     } else {
         entry->interval = entry->callback_ns(entry->userdata, entry->timerID, entry->interval);
     }
+
+    const Uint64 duration = SDL_GetTicksNS() - start;
+    const Uint64 lateness = (start > entry->scheduled) ? (start - entry->scheduled) : 0;
+    ++entry->stats.num_calls;
+    entry->stats.total_callback_ns += duration;
+    entry->stats.max_callback_ns = SDL_max(entry->stats.max_callback_ns, duration);
+    entry->stats.total_lateness_ns += lateness;
+    entry->stats.max_lateness_ns = SDL_max(entry->stats.max_lateness_ns, lateness);
+
     if (entry->interval > 0) {
+        entry->scheduled = start + entry->interval;
         entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
                                                   SDL_NS_TO_MS(entry->interval),
                                                   entry);
@@ -462,11 +654,14 @@ void SDL_QuitTimers(void)
     }
 }
 
-static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata)
+// There's no timer thread to keep clear here, so job_worker has no effect
+static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_ms, SDL_NSTimerCallback callback_ns, void *userdata, bool job_worker)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_TimerMap *entry;
 
+    (void)job_worker;
+
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
         return 0;
@@ -481,6 +676,8 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     entry->callback_ns = callback_ns;
     entry->userdata = userdata;
     entry->interval = interval;
+    entry->scheduled = SDL_GetTicksNS() + interval;
+    SDL_zero(entry->stats);
 
     entry->timeoutID = emscripten_set_timeout(&SDL_Emscripten_TimerHelper,
                                               SDL_NS_TO_MS(entry->interval),
@@ -494,12 +691,12 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata);
+    return SDL_CreateTimer(SDL_MS_TO_NS(interval), callback, NULL, userdata, false);
 }
 
 SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata)
 {
-    return SDL_CreateTimer(interval, NULL, callback, userdata);
+    return SDL_CreateTimer(interval, NULL, callback, userdata, false);
 }
 
 bool SDL_RemoveTimer(SDL_TimerID id)
@@ -533,8 +730,48 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_TimerMap *entry;
+
+    if (!id) {
+        return SDL_InvalidParamError("id");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    for (entry = data->timermap; entry; entry = entry->next) {
+        if (entry->timerID == id) {
+            SDL_copyp(stats, &entry->stats);
+            return true;
+        }
+    }
+    return SDL_SetError("Timer not found");
+}
+
 #endif // !SDL_PLATFORM_EMSCRIPTEN || !SDL_THREADS_DISABLED
 
+SDL_TimerID SDL_AddTimerWithProperties(SDL_PropertiesID props)
+{
+    SDL_TimerCallback callback_ms = (SDL_TimerCallback)SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_CALLBACK_POINTER, NULL);
+    SDL_NSTimerCallback callback_ns = (SDL_NSTimerCallback)SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_NS_CALLBACK_POINTER, NULL);
+    void *userdata = SDL_GetPointerProperty(props, SDL_PROP_TIMER_CREATE_USERDATA_POINTER, NULL);
+    const Sint64 interval = SDL_GetNumberProperty(props, SDL_PROP_TIMER_CREATE_INTERVAL_NS_NUMBER, -1);
+    const bool job_worker = SDL_GetBooleanProperty(props, SDL_PROP_TIMER_CREATE_JOB_WORKER_BOOLEAN, false);
+
+    if (callback_ms && callback_ns) {
+        SDL_SetError("Only one timer callback may be set");
+        return 0;
+    }
+    if (interval < 0) {
+        SDL_SetError("Timer interval must be set");
+        return 0;
+    }
+    return SDL_CreateTimer((Uint64)interval, callback_ms, callback_ns, userdata, job_worker);
+}
+
 static Uint64 tick_start;
 static Uint32 tick_numerator_ns;
 static Uint32 tick_denominator_ns;
@@ -732,3 +969,139 @@ void SDL_DelayPrecise(Uint64 ns)
         current_value = SDL_GetTicksNS();
     }
 }
+
+struct SDL_FramePacer
+{
+    Uint64 period;
+    Uint64 deadline;
+    Uint64 spin;
+    SDL_FramePacerStats stats;
+};
+
+// The busy-wait at the end of each frame never gets shorter than this
+#define FRAME_PACER_MIN_SPIN_NS SDL_US_TO_NS(50)
+
+static void SDL_DelayFramePacer(Uint64 ns)
+{
+#ifdef SDL_HAVE_SYS_DELAY_DEADLINE
+    SDL_SYS_DelayDeadlineNS(ns);
+#else
+    SDL_SYS_DelayNS(ns);
+#endif
+}
+
+SDL_FramePacer *SDL_CreateFramePacer(Uint64 period_ns)
+{
+    SDL_FramePacer *pacer;
+
+    if (!period_ns) {
+        SDL_InvalidParamError("period_ns");
+        return NULL;
+    }
+
+    pacer = (SDL_FramePacer *)SDL_calloc(1, sizeof(*pacer));
+    if (!pacer) {
+        return NULL;
+    }
+    pacer->period = period_ns;
+    pacer->spin = SDL_MS_TO_NS(1);
+    SDL_ResetFramePacer(pacer);
+    return pacer;
+}
+
+bool SDL_SetFramePacerPeriod(SDL_FramePacer *pacer, Uint64 period_ns)
+{
+    if (!pacer) {
+        return SDL_InvalidParamError("pacer");
+    }
+    if (!period_ns) {
+        return SDL_InvalidParamError("period_ns");
+    }
+
+    // Keep the current frame's start time, but aim for the new period
+    pacer->deadline = (pacer->deadline - pacer->period) + period_ns;
+    pacer->period = period_ns;
+    return true;
+}
+
+bool SDL_WaitFramePacer(SDL_FramePacer *pacer)
+{
+    Uint64 now, wake, woke, lateness, spin;
+
+    if (!pacer) {
+        return SDL_InvalidParamError("pacer");
+    }
+
+    now = SDL_GetTicksNS();
+    if (now >= pacer->deadline) {
+        // We're already late, start the next frame from here
+        lateness = now - pacer->deadline;
+        ++pacer->stats.missed_deadlines;
+        pacer->deadline = now;
+    } else {
+        /* Sleep until shortly before the deadline. Sleeps usually overshoot, so
+           keep the busy-wait a bit longer than the worst recent overshoot, and
+           let it shrink slowly when the system sleeps more precisely than that. */
+        spin = pacer->spin;
+        wake = pacer->deadline - SDL_min(spin, pacer->deadline);
+        if (now < wake) {
+            SDL_DelayFramePacer(wake - now);
+            woke = SDL_GetTicksNS();
+
+            const Uint64 overshoot = (woke > wake) ? (woke - wake) : 0;
+            const Uint64 target = overshoot + overshoot / 4 + FRAME_PACER_MIN_SPIN_NS;
+            if (target > spin) {
+                spin = target;
+            } else {
+                spin -= (spin - target) / 16;
+            }
+            pacer->spin = SDL_clamp(spin, FRAME_PACER_MIN_SPIN_NS, pacer->period);
+            now = woke;
+        }
+
+        // Spin for any remaining time
+        while (now < pacer->deadline) {
+            SDL_CPUPauseInstruction();
+            now = SDL_GetTicksNS();
+        }
+        lateness = now - pacer->deadline;
+    }
+
+    ++pacer->stats.num_frames;
+    pacer->stats.total_lateness_ns += lateness;
+    if (lateness > pacer->stats.max_lateness_ns) {
+        pacer->stats.max_lateness_ns = lateness;
+    }
+    pacer->deadline += pacer->period;
+    return true;
+}
+
+bool SDL_ResetFramePacer(SDL_FramePacer *pacer)
+{
+    if (!pacer) {
+        return SDL_InvalidParamError("pacer");
+    }
+
+    SDL_zero(pacer->stats);
+    pacer->deadline = SDL_GetTicksNS() + pacer->period;
+    return true;
+}
+
+bool SDL_GetFramePacerStats(SDL_FramePacer *pacer, SDL_FramePacerStats *stats)
+{
+    if (!pacer) {
+        return SDL_InvalidParamError("pacer");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_copyp(stats, &pacer->stats);
+    stats->spin_ns = pacer->spin;
+    return true;
+}
+
+void SDL_DestroyFramePacer(SDL_FramePacer *pacer)
+{
+    SDL_free(pacer);
+}
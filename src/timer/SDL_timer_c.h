@@ -36,4 +36,10 @@ extern void SDL_QuitTimers(void);
 
 extern void SDL_SYS_DelayNS(Uint64 ns);
 
+#if defined(SDL_TIMER_UNIX) && defined(HAVE_CLOCK_GETTIME) && !defined(SDL_PLATFORM_EMSCRIPTEN)
+#define SDL_HAVE_SYS_DELAY_DEADLINE
+// Like SDL_SYS_DelayNS(), but sleeps against an absolute deadline so interrupted sleeps don't drift
+extern void SDL_SYS_DelayDeadlineNS(Uint64 ns);
+#endif
+
 #endif // SDL_timer_c_h_
@@ -185,4 +185,26 @@ void SDL_SYS_DelayNS(Uint64 ns)
     } while (was_error && (errno == EINTR));
 }
 
+#ifdef SDL_HAVE_SYS_DELAY_DEADLINE
+void SDL_SYS_DelayDeadlineNS(Uint64 ns)
+{
+#ifdef TIMER_ABSTIME
+    // clock_nanosleep() doesn't support CLOCK_MONOTONIC_RAW, so we only use it to measure from here
+    struct timespec deadline;
+    int rc;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &deadline) == 0) {
+        ns += deadline.tv_nsec;
+        deadline.tv_sec += (time_t)(ns / SDL_NS_PER_SECOND);
+        deadline.tv_nsec = (long)(ns % SDL_NS_PER_SECOND);
+        do {
+            rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        } while (rc == EINTR);
+        return;
+    }
+#endif
+    SDL_SYS_DelayNS(ns);
+}
+#endif // SDL_HAVE_SYS_DELAY_DEADLINE
+
 #endif // SDL_TIMER_UNIX
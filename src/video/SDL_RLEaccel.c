@@ -604,17 +604,146 @@ done:
         dst = (Uint16)(d | d >> 16);       \
     } while (0)
 
+/*
+ * Blend a run of translucent pixels onto a 32bpp destination.
+ * The vector versions do the same 32-bit arithmetic as BLIT_TRANSL_888
+ * on several pixels at once, so they give exactly the same results.
+ */
+static void BlitTranslRun888_Scalar(const Uint32 *src, Uint32 *dst, int n)
+{
+    int i;
+    for (i = 0; i < n; i++) {
+        BLIT_TRANSL_888(src[i], dst[i]);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+// SSE2 has no 32-bit multiply keeping the low half, so build one from the 32x32->64 multiply
+static SDL_INLINE __m128i SDL_TARGETING("sse2") MulLo32_SSE2(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static void SDL_TARGETING("sse2") BlitTranslRun888_SSE2(const Uint32 *src, Uint32 *dst, int n)
+{
+    const __m128i rb_mask = _mm_set1_epi32(0x00ff00ff);
+    const __m128i g_mask = _mm_set1_epi32(0x0000ff00);
+    const __m128i a_mask = _mm_set1_epi32((int)0xff000000);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+        const __m128i alpha = _mm_srli_epi32(s, 24);
+        __m128i s1 = _mm_and_si128(s, rb_mask);
+        __m128i d1 = _mm_and_si128(d, rb_mask);
+        __m128i s2 = _mm_and_si128(s, g_mask);
+        __m128i d2 = _mm_and_si128(d, g_mask);
+        d1 = _mm_and_si128(_mm_add_epi32(d1, _mm_srli_epi32(MulLo32_SSE2(_mm_sub_epi32(s1, d1), alpha), 8)), rb_mask);
+        d2 = _mm_and_si128(_mm_add_epi32(d2, _mm_srli_epi32(MulLo32_SSE2(_mm_sub_epi32(s2, d2), alpha), 8)), g_mask);
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_or_si128(_mm_or_si128(d1, d2), a_mask));
+    }
+    BlitTranslRun888_Scalar(src + i, dst + i, n - i);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") BlitTranslRun888_AVX2(const Uint32 *src, Uint32 *dst, int n)
+{
+    const __m256i rb_mask = _mm256_set1_epi32(0x00ff00ff);
+    const __m256i g_mask = _mm256_set1_epi32(0x0000ff00);
+    const __m256i a_mask = _mm256_set1_epi32((int)0xff000000);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+        const __m256i alpha = _mm256_srli_epi32(s, 24);
+        __m256i s1 = _mm256_and_si256(s, rb_mask);
+        __m256i d1 = _mm256_and_si256(d, rb_mask);
+        __m256i s2 = _mm256_and_si256(s, g_mask);
+        __m256i d2 = _mm256_and_si256(d, g_mask);
+        d1 = _mm256_and_si256(_mm256_add_epi32(d1, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s1, d1), alpha), 8)), rb_mask);
+        d2 = _mm256_and_si256(_mm256_add_epi32(d2, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(s2, d2), alpha), 8)), g_mask);
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_or_si256(_mm256_or_si256(d1, d2), a_mask));
+    }
+    BlitTranslRun888_Scalar(src + i, dst + i, n - i);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static void BlitTranslRun888_NEON(const Uint32 *src, Uint32 *dst, int n)
+{
+    const uint32x4_t rb_mask = vdupq_n_u32(0x00ff00ff);
+    const uint32x4_t g_mask = vdupq_n_u32(0x0000ff00);
+    const uint32x4_t a_mask = vdupq_n_u32(0xff000000);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t s = vld1q_u32(&src[i]);
+        const uint32x4_t d = vld1q_u32(&dst[i]);
+        const uint32x4_t alpha = vshrq_n_u32(s, 24);
+        uint32x4_t s1 = vandq_u32(s, rb_mask);
+        uint32x4_t d1 = vandq_u32(d, rb_mask);
+        uint32x4_t s2 = vandq_u32(s, g_mask);
+        uint32x4_t d2 = vandq_u32(d, g_mask);
+        d1 = vandq_u32(vaddq_u32(d1, vshrq_n_u32(vmulq_u32(vsubq_u32(s1, d1), alpha), 8)), rb_mask);
+        d2 = vandq_u32(vaddq_u32(d2, vshrq_n_u32(vmulq_u32(vsubq_u32(s2, d2), alpha), 8)), g_mask);
+        vst1q_u32(&dst[i], vorrq_u32(vorrq_u32(d1, d2), a_mask));
+    }
+    BlitTranslRun888_Scalar(src + i, dst + i, n - i);
+}
+#endif
+
+typedef void (*BlitTranslRunFunc)(const Uint32 *src, Uint32 *dst, int n);
+
+static BlitTranslRunFunc GetBlitTranslRun888(void)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return BlitTranslRun888_AVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        return BlitTranslRun888_SSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        return BlitTranslRun888_NEON;
+    }
+#endif
+    return BlitTranslRun888_Scalar;
+}
+
+// blend runs of translucent pixels, pixel by pixel for 16bpp targets
+#define BLIT_TRANSL_RUN(do_blend, src, dst, n) \
+    do {                                       \
+        int i;                                 \
+        for (i = 0; i < (int)(n); i++) {       \
+            do_blend(src[i], dst[i]);          \
+        }                                      \
+    } while (0)
+
+#define BLIT_TRANSL_RUN_565(src, dst, n) BLIT_TRANSL_RUN(BLIT_TRANSL_565, src, dst, n)
+#define BLIT_TRANSL_RUN_555(src, dst, n) BLIT_TRANSL_RUN(BLIT_TRANSL_555, src, dst, n)
+#define BLIT_TRANSL_RUN_888(src, dst, n) blit_transl_run_888(src, dst, (int)(n))
+
 // blit a pixel-alpha RLE surface clipped at the right and/or left edges
 static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                              Uint8 *dstbuf, const SDL_Rect *srcrect)
 {
     const SDL_PixelFormatDetails *df = surf_dst->fmt;
+    const BlitTranslRunFunc blit_transl_run_888 = GetBlitTranslRun888();
     /*
      * clipped blitter: Ptype is the destination pixel type,
-     * Ctype the translucent count type, and do_blend the macro
-     * to blend one pixel.
+     * Ctype the translucent count type, and do_blend_run the macro
+     * to blend a run of pixels.
      */
-#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend)                          \
+#define RLEALPHACLIPBLIT(Ptype, Ctype, do_blend_run)                      \
     do {                                                                  \
         int linecount = srcrect->h;                                       \
         int left = srcrect->x;                                            \
@@ -670,9 +799,7 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
                     if (crun > 0) {                                       \
                         Ptype *dst = (Ptype *)dstbuf + cofs;              \
                         Uint32 *src = (Uint32 *)srcbuf + (cofs - ofs);    \
-                        int i;                                            \
-                        for (i = 0; i < crun; i++)                        \
-                            do_blend(src[i], dst[i]);                     \
+                        do_blend_run(src, dst, crun);                     \
                     }                                                     \
                     srcbuf += run * 4;                                    \
                     ofs += run;                                           \
@@ -685,13 +812,13 @@ static void RLEAlphaClipBlit(int w, Uint8 *srcbuf, SDL_Surface *surf_dst,
     switch (df->bytes_per_pixel) {
     case 2:
         if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_565);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
         } else {
-            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_555);
+            RLEALPHACLIPBLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
         }
         break;
     case 4:
-        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_888);
+        RLEALPHACLIPBLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
         break;
     }
 }
@@ -780,12 +907,14 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
         RLEAlphaClipBlit(w, srcbuf, surf_dst, dstbuf, srcrect);
     } else {
 
+        const BlitTranslRunFunc blit_transl_run_888 = GetBlitTranslRun888();
+
         /*
          * non-clipped blitter. Ptype is the destination pixel type,
-         * Ctype the translucent count type, and do_blend the
-         * macro to blend one pixel.
+         * Ctype the translucent count type, and do_blend_run the
+         * macro to blend a run of pixels.
          */
-#define RLEALPHABLIT(Ptype, Ctype, do_blend)                         \
+#define RLEALPHABLIT(Ptype, Ctype, do_blend_run)                     \
     do {                                                             \
         int linecount = srcrect->h;                                  \
         do {                                                         \
@@ -816,13 +945,9 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
                 srcbuf += 4;                                         \
                 if (run) {                                           \
                     Ptype *dst = (Ptype *)dstbuf + ofs;              \
-                    unsigned i;                                      \
-                    for (i = 0; i < run; i++) {                      \
-                        Uint32 src = *(Uint32 *)srcbuf;              \
-                        do_blend(src, *dst);                         \
-                        srcbuf += 4;                                 \
-                        dst++;                                       \
-                    }                                                \
+                    Uint32 *src = (Uint32 *)srcbuf;                  \
+                    do_blend_run(src, dst, run);                     \
+                    srcbuf += run * 4;                               \
                     ofs += run;                                      \
                 }                                                    \
             } while (ofs < w);                                       \
@@ -833,13 +958,13 @@ static bool SDLCALL SDL_RLEAlphaBlit(SDL_Surface *surf_src, const SDL_Rect *srcr
         switch (df->bytes_per_pixel) {
         case 2:
             if (df->Gmask == 0x07e0 || df->Rmask == 0x07e0 || df->Bmask == 0x07e0) {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_565);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_565);
             } else {
-                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_555);
+                RLEALPHABLIT(Uint16, Uint8, BLIT_TRANSL_RUN_555);
             }
             break;
         case 4:
-            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_888);
+            RLEALPHABLIT(Uint32, Uint16, BLIT_TRANSL_RUN_888);
             break;
         }
     }
@@ -982,6 +1107,62 @@ static int uncopy_32(Uint32 *dst, const void *src, int n,
     return n * 4;
 }
 
+/*
+ * Find where a run of pixels ends during encoding: returns the first
+ * position from x on where whether (pixel & mask) is value1 or value2
+ * differs from match, or w if there is none. Checking several pixels per
+ * step makes a big difference on large surfaces with long runs.
+ */
+static int FindRunEnd32(const Uint32 *src, int x, int w, Uint32 mask, Uint32 value1, Uint32 value2, bool match)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        const __m128i vmask = _mm_set1_epi32((int)mask);
+        const __m128i vvalue1 = _mm_set1_epi32((int)value1);
+        const __m128i vvalue2 = _mm_set1_epi32((int)value2);
+        const int want = match ? 0xF : 0;
+
+        for (; x + 4 <= w; x += 4) {
+            const __m128i pixels = _mm_and_si128(_mm_loadu_si128((const __m128i *)&src[x]), vmask);
+            const __m128i equal = _mm_or_si128(_mm_cmpeq_epi32(pixels, vvalue1), _mm_cmpeq_epi32(pixels, vvalue2));
+            int differ = _mm_movemask_ps(_mm_castsi128_ps(equal)) ^ want;
+            if (differ) {
+                while (!(differ & 1)) {
+                    differ >>= 1;
+                    x++;
+                }
+                return x;
+            }
+        }
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        const uint32x4_t vmask = vdupq_n_u32(mask);
+        const uint32x4_t vvalue1 = vdupq_n_u32(value1);
+        const uint32x4_t vvalue2 = vdupq_n_u32(value2);
+        const Uint64 want = match ? ~(Uint64)0 : 0;
+
+        for (; x + 4 <= w; x += 4) {
+            const uint32x4_t pixels = vandq_u32(vld1q_u32(&src[x]), vmask);
+            const uint32x4_t equal = vorrq_u32(vceqq_u32(pixels, vvalue1), vceqq_u32(pixels, vvalue2));
+            Uint64 differ = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(equal)), 0) ^ want;
+            if (differ) {
+                while (!(differ & 0xFFFF)) {
+                    differ >>= 16;
+                    x++;
+                }
+                return x;
+            }
+        }
+    }
+#endif
+    while (x < w && ((src[x] & mask) == value1 || (src[x] & mask) == value2) == match) {
+        x++;
+    }
+    return x;
+}
+
 #define ISOPAQUE(pixel, fmt) ((((pixel)&fmt->Amask) >> fmt->Ashift) == 255)
 
 #define ISTRANSL(pixel, fmt) \
@@ -1074,6 +1255,8 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
         const SDL_PixelFormatDetails *sf = surface->fmt;
         Uint32 *src = (Uint32 *)surface->pixels;
         Uint8 *lastline = dst; // end of last non-blank line
+        // With an 8-bit alpha channel, opaque pixels are the ones with all alpha bits set
+        const bool fast_alpha = (sf->Amask == (Uint32)0xff << sf->Ashift);
 
         // opaque counts are 8 or 16 bits, depending on target depth
 #define ADD_OPAQUE_COUNTS(n, m)           \
@@ -1099,12 +1282,20 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISOPAQUE(src[x], sf)) {
-                    x++;
+                if (fast_alpha) {
+                    x = FindRunEnd32(src, x, w, sf->Amask, sf->Amask, sf->Amask, false);
+                } else {
+                    while (x < w && !ISOPAQUE(src[x], sf)) {
+                        x++;
+                    }
                 }
                 runstart = x;
-                while (x < w && ISOPAQUE(src[x], sf)) {
-                    x++;
+                if (fast_alpha) {
+                    x = FindRunEnd32(src, x, w, sf->Amask, sf->Amask, sf->Amask, true);
+                } else {
+                    while (x < w && ISOPAQUE(src[x], sf)) {
+                        x++;
+                    }
                 }
                 skip = runstart - skipstart;
                 if (skip == w) {
@@ -1137,12 +1328,21 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
             do {
                 int run, skip, len;
                 skipstart = x;
-                while (x < w && !ISTRANSL(src[x], sf)) {
-                    x++;
+                if (fast_alpha) {
+                    // pixels that are either transparent or opaque
+                    x = FindRunEnd32(src, x, w, sf->Amask, 0, sf->Amask, true);
+                } else {
+                    while (x < w && !ISTRANSL(src[x], sf)) {
+                        x++;
+                    }
                 }
                 runstart = x;
-                while (x < w && ISTRANSL(src[x], sf)) {
-                    x++;
+                if (fast_alpha) {
+                    x = FindRunEnd32(src, x, w, sf->Amask, 0, sf->Amask, false);
+                } else {
+                    while (x < w && ISTRANSL(src[x], sf)) {
+                        x++;
+                    }
                 }
                 skip = runstart - skipstart;
                 blankline &= (skip == w);
@@ -1179,7 +1379,10 @@ static bool RLEAlphaSurface(SDL_Surface *surface)
 
     // Now that we have it encoded, release the original pixels
     if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
+        if (surface->internal_flags & SDL_INTERNAL_SURFACE_POOLED) {
+            SDL_FreePooledSurfacePixels(surface->pixels);
+            surface->internal_flags &= ~SDL_INTERNAL_SURFACE_POOLED;
+        } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
             SDL_aligned_free(surface->pixels);
             surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
         } else {
@@ -1309,12 +1512,20 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
             int skipstart = x;
 
             // find run of transparent, then opaque pixels
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
-                x++;
+            if (bpp == 4) {
+                x = FindRunEnd32((const Uint32 *)srcbuf, x, w, rgbmask, ckey, ckey, true);
+            } else {
+                while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) == ckey) {
+                    x++;
+                }
             }
             runstart = x;
-            while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
-                x++;
+            if (bpp == 4) {
+                x = FindRunEnd32((const Uint32 *)srcbuf, x, w, rgbmask, ckey, ckey, false);
+            } else {
+                while (x < w && (getpix(srcbuf + x * bpp) & rgbmask) != ckey) {
+                    x++;
+                }
             }
             skip = runstart - skipstart;
             if (skip == w) {
@@ -1355,7 +1566,10 @@ static bool RLEColorkeySurface(SDL_Surface *surface)
 
     // Now that we have it encoded, release the original pixels
     if (!(surface->flags & SDL_SURFACE_PREALLOCATED)) {
-        if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
+        if (surface->internal_flags & SDL_INTERNAL_SURFACE_POOLED) {
+            SDL_FreePooledSurfacePixels(surface->pixels);
+            surface->internal_flags &= ~SDL_INTERNAL_SURFACE_POOLED;
+        } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
             SDL_aligned_free(surface->pixels);
             surface->flags &= ~SDL_SURFACE_SIMD_ALIGNED;
         } else {
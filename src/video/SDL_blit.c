@@ -27,6 +27,71 @@
 #include "SDL_blit_slow.h"
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
+#include "../thread/SDL_jobs_c.h"
+
+// Blits smaller than this aren't worth handing to other threads
+#define SDL_PARALLEL_BLIT_MIN_PIXELS    (512 * 512)
+#define SDL_PARALLEL_BLIT_MIN_BAND_ROWS 64
+#define SDL_PARALLEL_BLIT_MAX_BANDS     16
+
+typedef struct SDL_BlitBand
+{
+    SDL_BlitFunc blit;
+    SDL_BlitInfo info;
+} SDL_BlitBand;
+
+static void SDLCALL SDL_RunBlitBand(void *userdata)
+{
+    SDL_BlitBand *band = (SDL_BlitBand *)userdata;
+    band->blit(&band->info);
+}
+
+/* Split a large blit into bands of rows and run them on the job threads.
+   The blitters advance info->src and info->dst as they go, so each band gets its own copy. */
+static bool SDL_SoftBlitParallel(SDL_BlitFunc blit, const SDL_BlitInfo *info)
+{
+    // Scaled blits step through the source based on the whole rect, so bands would sample it differently.
+    if (info->src_w != info->dst_w || info->src_h != info->dst_h) {
+        return false;
+    }
+    if ((Sint64)info->dst_w * info->dst_h < SDL_PARALLEL_BLIT_MIN_PIXELS) {
+        return false;
+    }
+    // Blitting a surface onto itself and looking up colors for palettized destinations aren't safe to split up
+    if (info->src_surface == info->dst_surface ||
+        SDL_BITSPERPIXEL(info->src_fmt->format) < 8 ||
+        SDL_ISPIXELFORMAT_INDEXED(info->dst_fmt->format)) {
+        return false;
+    }
+    if (!SDL_GetHintBoolean(SDL_HINT_SURFACE_PARALLEL_BLIT, false)) {
+        return false;
+    }
+
+    int num_bands = SDL_min(SDL_GetNumLogicalCPUCores(), info->dst_h / SDL_PARALLEL_BLIT_MIN_BAND_ROWS);
+    num_bands = SDL_min(num_bands, SDL_PARALLEL_BLIT_MAX_BANDS);
+    if (num_bands < 2) {
+        return false;
+    }
+
+    SDL_BlitBand bands[SDL_PARALLEL_BLIT_MAX_BANDS];
+    void *userdata[SDL_PARALLEL_BLIT_MAX_BANDS];
+    for (int i = 0; i < num_bands; ++i) {
+        const int y = (info->dst_h * i) / num_bands;
+        const int h = ((info->dst_h * (i + 1)) / num_bands) - y;
+        SDL_BlitBand *band = &bands[i];
+
+        band->blit = blit;
+        SDL_copyp(&band->info, info);
+        band->info.src += (size_t)y * info->src_pitch;
+        band->info.dst += (size_t)y * info->dst_pitch;
+        band->info.src_h = h;
+        band->info.dst_h = h;
+        userdata[i] = band;
+    }
+
+    SDL_RunJobsAndWait(SDL_RunBlitBand, userdata, num_bands);
+    return true;
+}
 
 // The general purpose software blit routine
 static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
@@ -83,7 +148,9 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
         RunBlit = (SDL_BlitFunc)src->map.data;
 
         // Run the actual software blit
-        RunBlit(info);
+        if (!SDL_SoftBlitParallel(RunBlit, info)) {
+            RunBlit(info);
+        }
     }
 
     // We need to unlock the surfaces if they're locked
@@ -97,6 +164,84 @@ static bool SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     return okay;
 }
 
+/* The blitter chosen for a pair of non-indexed formats only depends on the formats, colorspaces and
+   copy flags, so it's kept in a small global cache instead of searching the blit tables every time
+   a surface is mapped to a different destination. Indexed formats need tables built from the
+   palettes, so they always go through the full selection. */
+#define SDL_BLIT_CACHE_SIZE 64
+
+typedef struct SDL_BlitCacheEntry
+{
+    SDL_PixelFormat src_format;
+    SDL_PixelFormat dst_format;
+    SDL_Colorspace src_colorspace;
+    SDL_Colorspace dst_colorspace;
+    Uint32 flags;
+    int identity;
+    SDL_BlitFunc blit;
+} SDL_BlitCacheEntry;
+
+static SDL_SpinLock SDL_blit_cache_lock;
+static SDL_BlitCacheEntry SDL_blit_cache[SDL_BLIT_CACHE_SIZE];
+
+static bool SDL_IsBlitCacheable(SDL_Surface *surface, SDL_Surface *dst)
+{
+    return !SDL_ISPIXELFORMAT_INDEXED(surface->format) && !SDL_ISPIXELFORMAT_INDEXED(dst->format);
+}
+
+static SDL_BlitCacheEntry *SDL_GetBlitCacheEntry(const SDL_BlitCacheEntry *key)
+{
+    Uint32 hash = (Uint32)key->src_format;
+    hash = (hash * 0x9E3779B1u) ^ (Uint32)key->dst_format;
+    hash = (hash * 0x9E3779B1u) ^ (Uint32)key->src_colorspace;
+    hash = (hash * 0x9E3779B1u) ^ (Uint32)key->dst_colorspace;
+    hash = (hash * 0x9E3779B1u) ^ key->flags ^ ((Uint32)key->identity << 31);
+    hash ^= hash >> 16;
+    return &SDL_blit_cache[hash & (SDL_BLIT_CACHE_SIZE - 1)];
+}
+
+static void SDL_SetupBlitCacheKey(SDL_BlitCacheEntry *key, SDL_Surface *surface, SDL_Surface *dst)
+{
+    key->src_format = surface->format;
+    key->dst_format = dst->format;
+    key->src_colorspace = surface->colorspace;
+    key->dst_colorspace = dst->colorspace;
+    key->flags = surface->map.info.flags;
+    key->identity = surface->map.identity;
+    key->blit = NULL;
+}
+
+static bool SDL_MatchBlitCacheKey(const SDL_BlitCacheEntry *a, const SDL_BlitCacheEntry *b)
+{
+    return a->src_format == b->src_format && a->dst_format == b->dst_format &&
+           a->src_colorspace == b->src_colorspace && a->dst_colorspace == b->dst_colorspace &&
+           a->flags == b->flags && a->identity == b->identity;
+}
+
+static SDL_BlitFunc SDL_LookupCachedBlit(const SDL_BlitCacheEntry *key)
+{
+    SDL_BlitCacheEntry *entry = SDL_GetBlitCacheEntry(key);
+    SDL_BlitFunc blit = NULL;
+
+    SDL_LockSpinlock(&SDL_blit_cache_lock);
+    if (entry->blit && SDL_MatchBlitCacheKey(entry, key)) {
+        blit = entry->blit;
+    }
+    SDL_UnlockSpinlock(&SDL_blit_cache_lock);
+
+    return blit;
+}
+
+static void SDL_CacheBlit(const SDL_BlitCacheEntry *key, SDL_BlitFunc blit)
+{
+    SDL_BlitCacheEntry *entry = SDL_GetBlitCacheEntry(key);
+
+    SDL_LockSpinlock(&SDL_blit_cache_lock);
+    *entry = *key;
+    entry->blit = blit;
+    SDL_UnlockSpinlock(&SDL_blit_cache_lock);
+}
+
 #ifdef SDL_HAVE_BLIT_AUTO
 
 #ifdef SDL_PLATFORM_MACOS
@@ -182,6 +327,8 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
     SDL_BlitMap *map = &surface->map;
     SDL_Colorspace src_colorspace = surface->colorspace;
     SDL_Colorspace dst_colorspace = dst->colorspace;
+    SDL_BlitCacheEntry key;
+    bool cacheable;
 
     // We don't currently support blitting to < 8 bpp surfaces
     if (SDL_BITSPERPIXEL(dst->format) < 8) {
@@ -213,6 +360,16 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
     }
 #endif
 
+    cacheable = SDL_IsBlitCacheable(surface, dst);
+    if (cacheable) {
+        SDL_SetupBlitCacheKey(&key, surface, dst);
+        blit = SDL_LookupCachedBlit(&key);
+        if (blit) {
+            map->data = (void *)blit;
+            return true;
+        }
+    }
+
     // Choose a standard blit function
     if (!blit) {
         if (src_colorspace != dst_colorspace ||
@@ -286,5 +443,8 @@ bool SDL_CalculateBlit(SDL_Surface *surface, SDL_Surface *dst)
         return SDL_SetError("Blit combination not supported");
     }
 
+    if (cacheable) {
+        SDL_CacheBlit(&key, blit);
+    }
     return true;
 }
@@ -514,6 +514,444 @@ static const SDL_BlitFunc one_blitkey[] = {
     (SDL_BlitFunc)NULL, Blit1to1Key, Blit1to2Key, Blit1to3Key, Blit1to4Key
 };
 
+#ifdef SDL_AVX2_INTRINSICS
+/* AVX2 versions of the 8-bit to 16/24/32-bit converters.
+ * The palette map is looked up eight pixels at a time with a 32-bit gather,
+ * whatever is left at the end of a row is done one pixel at a time.
+ */
+
+static void SDL_TARGETING("avx2") Blit1to2AVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint16 *dst = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip / 2;
+    const Uint16 *map = (const Uint16 *)info->table;
+    Uint32 map32[256];
+    int i;
+
+    // Gathering 32 bits from the 16-bit map would read past its end
+    for (i = 0; i < 256; ++i) {
+        map32[i] = map[i];
+    }
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 16) {
+            const __m128i indices = _mm_loadu_si128((const __m128i *)src);
+            const __m256i lo = _mm256_i32gather_epi32((const int *)map32, _mm256_cvtepu8_epi32(indices), 4);
+            const __m256i hi = _mm256_i32gather_epi32((const int *)map32, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+            const __m256i pixels = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+
+            _mm256_storeu_si256((__m256i *)dst, pixels);
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        while (n--) {
+            *dst++ = map[*src++];
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to3AVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    // Drop the unused fourth byte of each map entry, leaving 12 bytes at the bottom of each lane
+    const __m256i pack = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                          0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    int o;
+
+    while (height--) {
+        int n = width;
+
+        // Each store writes 4 bytes past the pixels, which the next pixels overwrite
+        while (n >= 10) {
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+            const __m256i pixels = _mm256_shuffle_epi8(_mm256_i32gather_epi32((const int *)map, indices, 4), pack);
+
+            _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(pixels));
+            _mm_storeu_si128((__m128i *)(dst + 12), _mm256_extracti128_si256(pixels, 1));
+            src += 8;
+            dst += 24;
+            n -= 8;
+        }
+        while (n--) {
+            o = *src * 4;
+            dst[0] = map[o++];
+            dst[1] = map[o++];
+            dst[2] = map[o++];
+            src++;
+            dst += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to4AVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    const Uint32 *map = (const Uint32 *)info->table;
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+
+            _mm256_storeu_si256((__m256i *)dst, _mm256_i32gather_epi32((const int *)map, indices, 4));
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        while (n--) {
+            *dst++ = map[*src++];
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to2KeyAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint16 *dst = (Uint16 *)info->dst;
+    int dstskip = info->dst_skip / 2;
+    const Uint16 *map = (const Uint16 *)info->table;
+    Uint32 ckey = info->colorkey;
+    const __m256i key = _mm256_set1_epi16((short)ckey);
+    Uint32 map32[256];
+    int i;
+
+    // Gathering 32 bits from the 16-bit map would read past its end
+    for (i = 0; i < 256; ++i) {
+        map32[i] = map[i];
+    }
+
+    while (height--) {
+        int n = width;
+
+        // A key outside of the palette never matches, and would alias a valid index in the vector compare
+        while (n >= 16 && ckey <= 0xFF) {
+            const __m128i indices = _mm_loadu_si128((const __m128i *)src);
+            const __m256i lo = _mm256_i32gather_epi32((const int *)map32, _mm256_cvtepu8_epi32(indices), 4);
+            const __m256i hi = _mm256_i32gather_epi32((const int *)map32, _mm256_cvtepu8_epi32(_mm_srli_si128(indices, 8)), 4);
+            const __m256i pixels = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+            const __m256i keyed = _mm256_cmpeq_epi16(_mm256_cvtepu8_epi16(indices), key);
+            const __m256i old = _mm256_loadu_si256((const __m256i *)dst);
+
+            _mm256_storeu_si256((__m256i *)dst, _mm256_blendv_epi8(pixels, old, keyed));
+            src += 16;
+            dst += 16;
+            n -= 16;
+        }
+        while (n--) {
+            if (*src != ckey) {
+                *dst = map[*src];
+            }
+            src++;
+            dst++;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to3KeyAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    Uint32 ckey = info->colorkey;
+    const __m256i key = _mm256_set1_epi32((int)ckey);
+    // Drop the unused fourth byte of each map entry, leaving 12 bytes at the bottom of each lane
+    const __m256i pack = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                          0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    int o;
+
+    while (height--) {
+        int n = width;
+
+        // Each store covers 4 bytes past the pixels, which are left as they were and then rewritten by the next pixels
+        while (n >= 10) {
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+            const __m256i pixels = _mm256_shuffle_epi8(_mm256_i32gather_epi32((const int *)map, indices, 4), pack);
+            // The packed -1 positions come out as zero, which keeps the old bytes there
+            const __m256i write = _mm256_shuffle_epi8(_mm256_xor_si256(_mm256_cmpeq_epi32(indices, key), _mm256_set1_epi32(-1)), pack);
+            const __m128i old_lo = _mm_loadu_si128((const __m128i *)dst);
+            const __m128i old_hi = _mm_loadu_si128((const __m128i *)(dst + 12));
+
+            _mm_storeu_si128((__m128i *)dst, _mm_blendv_epi8(old_lo, _mm256_castsi256_si128(pixels), _mm256_castsi256_si128(write)));
+            _mm_storeu_si128((__m128i *)(dst + 12), _mm_blendv_epi8(old_hi, _mm256_extracti128_si256(pixels, 1), _mm256_extracti128_si256(write, 1)));
+            src += 8;
+            dst += 24;
+            n -= 8;
+        }
+        while (n--) {
+            if (*src != ckey) {
+                o = *src * 4;
+                dst[0] = map[o++];
+                dst[1] = map[o++];
+                dst[2] = map[o++];
+            }
+            src++;
+            dst += 3;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit1to4KeyAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint32 *dst = (Uint32 *)info->dst;
+    int dstskip = info->dst_skip / 4;
+    const Uint32 *map = (const Uint32 *)info->table;
+    Uint32 ckey = info->colorkey;
+    const __m256i key = _mm256_set1_epi32((int)ckey);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 8) {
+            const __m256i indices = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+            const __m256i write = _mm256_xor_si256(_mm256_cmpeq_epi32(indices, key), _mm256_set1_epi32(-1));
+
+            _mm256_maskstore_epi32((int *)dst, write, _mm256_i32gather_epi32((const int *)map, indices, 4));
+            src += 8;
+            dst += 8;
+            n -= 8;
+        }
+        while (n--) {
+            if (*src != ckey) {
+                *dst = map[*src];
+            }
+            src++;
+            dst++;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static const SDL_BlitFunc one_blit_avx2[] = {
+    (SDL_BlitFunc)NULL, Blit1to1, Blit1to2AVX2, Blit1to3AVX2, Blit1to4AVX2
+};
+
+static const SDL_BlitFunc one_blitkey_avx2[] = {
+    (SDL_BlitFunc)NULL, Blit1to1Key, Blit1to2KeyAVX2, Blit1to3KeyAVX2, Blit1to4KeyAVX2
+};
+
+#endif // SDL_AVX2_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && defined(__aarch64__)
+/* NEON versions of the 8-bit to 16/24/32-bit converters.
+ * The map is split into one 256 byte table per output byte, and each of those
+ * is looked up sixteen pixels at a time with four 64 byte table lookups. The
+ * interleaving stores then put the bytes back together in memory order.
+ */
+
+typedef struct
+{
+    uint8x16x4_t quarters[4];
+} Blit1ByteTable;
+
+static void SetupBlit1ByteTables(const Uint8 *map, int entry_size, int num_tables, Blit1ByteTable *tables)
+{
+    Uint8 bytes[256];
+    int i, j, k;
+
+    for (i = 0; i < num_tables; ++i) {
+        for (j = 0; j < 256; ++j) {
+            bytes[j] = map[j * entry_size + i];
+        }
+        for (j = 0; j < 4; ++j) {
+            for (k = 0; k < 4; ++k) {
+                tables[i].quarters[j].val[k] = vld1q_u8(&bytes[j * 64 + k * 16]);
+            }
+        }
+    }
+}
+
+static SDL_INLINE uint8x16_t LookupBlit1ByteTable(const Blit1ByteTable *table, uint8x16_t indices)
+{
+    const uint8x16_t quarter = vdupq_n_u8(64);
+    uint8x16_t result;
+
+    // Out of range indices give zero in the first lookup and leave the result alone in the others
+    result = vqtbl4q_u8(table->quarters[0], indices);
+    indices = vsubq_u8(indices, quarter);
+    result = vqtbx4q_u8(result, table->quarters[1], indices);
+    indices = vsubq_u8(indices, quarter);
+    result = vqtbx4q_u8(result, table->quarters[2], indices);
+    indices = vsubq_u8(indices, quarter);
+    result = vqtbx4q_u8(result, table->quarters[3], indices);
+    return result;
+}
+
+static void Blit1toNNEON(SDL_BlitInfo *info, int dstbpp, bool colorkey)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const Uint8 *map = info->table;
+    const int entry_size = (dstbpp == 3) ? 4 : dstbpp;
+    Uint32 ckey = info->colorkey;
+    const uint8x16_t key = vdupq_n_u8((Uint8)ckey);
+    Blit1ByteTable tables[4];
+    int i;
+
+    // A key outside of the palette never matches
+    if (colorkey && ckey > 0xFF) {
+        colorkey = false;
+    }
+
+    SetupBlit1ByteTables(map, entry_size, dstbpp, tables);
+
+    while (height--) {
+        int n = width;
+
+        while (n >= 16) {
+            const uint8x16_t indices = vld1q_u8(src);
+            const uint8x16_t keyed = vceqq_u8(indices, key);
+
+            switch (dstbpp) {
+            case 2:
+            {
+                uint8x16x2_t pixels;
+                pixels.val[0] = LookupBlit1ByteTable(&tables[0], indices);
+                pixels.val[1] = LookupBlit1ByteTable(&tables[1], indices);
+                if (colorkey) {
+                    const uint8x16x2_t old = vld2q_u8(dst);
+                    pixels.val[0] = vbslq_u8(keyed, old.val[0], pixels.val[0]);
+                    pixels.val[1] = vbslq_u8(keyed, old.val[1], pixels.val[1]);
+                }
+                vst2q_u8(dst, pixels);
+                break;
+            }
+            case 3:
+            {
+                uint8x16x3_t pixels;
+                pixels.val[0] = LookupBlit1ByteTable(&tables[0], indices);
+                pixels.val[1] = LookupBlit1ByteTable(&tables[1], indices);
+                pixels.val[2] = LookupBlit1ByteTable(&tables[2], indices);
+                if (colorkey) {
+                    const uint8x16x3_t old = vld3q_u8(dst);
+                    pixels.val[0] = vbslq_u8(keyed, old.val[0], pixels.val[0]);
+                    pixels.val[1] = vbslq_u8(keyed, old.val[1], pixels.val[1]);
+                    pixels.val[2] = vbslq_u8(keyed, old.val[2], pixels.val[2]);
+                }
+                vst3q_u8(dst, pixels);
+                break;
+            }
+            default:
+            {
+                uint8x16x4_t pixels;
+                pixels.val[0] = LookupBlit1ByteTable(&tables[0], indices);
+                pixels.val[1] = LookupBlit1ByteTable(&tables[1], indices);
+                pixels.val[2] = LookupBlit1ByteTable(&tables[2], indices);
+                pixels.val[3] = LookupBlit1ByteTable(&tables[3], indices);
+                if (colorkey) {
+                    const uint8x16x4_t old = vld4q_u8(dst);
+                    pixels.val[0] = vbslq_u8(keyed, old.val[0], pixels.val[0]);
+                    pixels.val[1] = vbslq_u8(keyed, old.val[1], pixels.val[1]);
+                    pixels.val[2] = vbslq_u8(keyed, old.val[2], pixels.val[2]);
+                    pixels.val[3] = vbslq_u8(keyed, old.val[3], pixels.val[3]);
+                }
+                vst4q_u8(dst, pixels);
+                break;
+            }
+            }
+            src += 16;
+            dst += 16 * dstbpp;
+            n -= 16;
+        }
+        while (n--) {
+            if (!colorkey || *src != ckey) {
+                const Uint8 *entry = &map[*src * entry_size];
+                for (i = 0; i < dstbpp; ++i) {
+                    dst[i] = entry[i];
+                }
+            }
+            src++;
+            dst += dstbpp;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void Blit1to2NEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 2, false);
+}
+
+static void Blit1to3NEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 3, false);
+}
+
+static void Blit1to4NEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 4, false);
+}
+
+static void Blit1to2KeyNEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 2, true);
+}
+
+static void Blit1to3KeyNEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 3, true);
+}
+
+static void Blit1to4KeyNEON(SDL_BlitInfo *info)
+{
+    Blit1toNNEON(info, 4, true);
+}
+
+static const SDL_BlitFunc one_blit_neon[] = {
+    (SDL_BlitFunc)NULL, Blit1to1, Blit1to2NEON, Blit1to3NEON, Blit1to4NEON
+};
+
+static const SDL_BlitFunc one_blitkey_neon[] = {
+    (SDL_BlitFunc)NULL, Blit1to1Key, Blit1to2KeyNEON, Blit1to3KeyNEON, Blit1to4KeyNEON
+};
+
+#endif // SDL_NEON_INTRINSICS && __aarch64__
+
 SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
 {
     int which;
@@ -524,23 +962,39 @@ SDL_BlitFunc SDL_CalculateBlit1(SDL_Surface *surface)
         which = SDL_BYTESPERPIXEL(surface->map.info.dst_fmt->format);
     }
 
+    const SDL_BlitFunc *blit = one_blit;
+    const SDL_BlitFunc *blitkey = one_blitkey;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        blit = one_blit_avx2;
+        blitkey = one_blitkey_avx2;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && defined(__aarch64__)
+    if (SDL_HasNEON()) {
+        blit = one_blit_neon;
+        blitkey = one_blitkey_neon;
+    }
+#endif
+
     switch (surface->map.info.flags & ~SDL_COPY_RLE_MASK) {
     case 0:
         if (which < SDL_arraysize(one_blit)) {
-            return one_blit[which];
+            return blit[which];
         }
         break;
 
     case SDL_COPY_COLORKEY:
         if (which < SDL_arraysize(one_blitkey)) {
-            return one_blitkey[which];
+            return blitkey[which];
         }
         break;
 
     case SDL_COPY_COLORKEY | SDL_COPY_BLEND:  // this is not super-robust but handles a specific case we found sdl12-compat.
         if (surface->map.info.a == 255) {
             if (which < SDL_arraysize(one_blitkey)) {
-                return one_blitkey[which];
+                return blitkey[which];
             }
         } else {
             return which >= 2 ? Blit1toNAlphaKey : (SDL_BlitFunc)NULL;
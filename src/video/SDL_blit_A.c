@@ -1322,6 +1322,285 @@ static void Blit8888to8888PixelAlphaSwizzleNEON(SDL_BlitInfo *info)
 
 #endif
 
+#if defined(SDL_AVX2_INTRINSICS) || (defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8))
+
+/* 32-bit RGBA->RGB(A) blending with pixel alpha, color and/or alpha modulation, and src swizzling.
+   These give the same results as the generated blitters in SDL_blit_auto.c, including the rounding of MULT_DIV_255(). */
+typedef struct SDL_BlendModulate8888
+{
+    Uint32 dstAmask, dstAshift;
+    Uint32 mod_r, mod_g, mod_b, mod_a;
+    Uint64 mod_lanes;   // the modulation values in 16-bit lanes, in dst channel order
+    Uint64 alpha_lane;  // 0x00ff in the 16-bit lane holding dst alpha
+    Uint32 convert;     // per-pixel byte shuffle from src to dst channel order
+    int alpha_byte;     // byte index of alpha in a dst pixel
+} SDL_BlendModulate8888;
+
+static void SDL_SetupBlendModulate8888(const SDL_BlitInfo *info, SDL_BlendModulate8888 *blend)
+{
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+
+    SDL_Get8888AlphaMaskAndShift(dstfmt, &blend->dstAmask, &blend->dstAshift);
+
+    // MULT_DIV_255(x, 255) == x, so modulation that isn't enabled is the same as modulating by 255
+    blend->mod_r = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255;
+    blend->mod_g = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255;
+    blend->mod_b = (info->flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255;
+    blend->mod_a = (info->flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255;
+
+    blend->alpha_byte = (int)(blend->dstAshift >> 3);
+    blend->mod_lanes = ((Uint64)blend->mod_r << (dstfmt->Rshift * 2)) |
+                       ((Uint64)blend->mod_g << (dstfmt->Gshift * 2)) |
+                       ((Uint64)blend->mod_b << (dstfmt->Bshift * 2)) |
+                       ((Uint64)blend->mod_a << (blend->dstAshift * 2));
+    blend->alpha_lane = (Uint64)0xff << (blend->dstAshift * 2);
+    blend->convert = ((srcfmt->Rshift >> 3) << dstfmt->Rshift) |
+                     ((srcfmt->Gshift >> 3) << dstfmt->Gshift) |
+                     ((srcfmt->Bshift >> 3) << dstfmt->Bshift) |
+                     ((srcfmt->Ashift >> 3) << blend->dstAshift);
+}
+
+static SDL_INLINE Uint32 SDL_BlendModulate8888Pixel(Uint32 src32, Uint32 dst32, const SDL_PixelFormatDetails *srcfmt, const SDL_PixelFormatDetails *dstfmt, const SDL_BlendModulate8888 *blend)
+{
+    Uint32 srcR = (Uint8)(src32 >> srcfmt->Rshift);
+    Uint32 srcG = (Uint8)(src32 >> srcfmt->Gshift);
+    Uint32 srcB = (Uint8)(src32 >> srcfmt->Bshift);
+    Uint32 srcA = (Uint8)(src32 >> srcfmt->Ashift);
+    Uint32 dstR = (Uint8)(dst32 >> dstfmt->Rshift);
+    Uint32 dstG = (Uint8)(dst32 >> dstfmt->Gshift);
+    Uint32 dstB = (Uint8)(dst32 >> dstfmt->Bshift);
+    Uint32 dstA = (Uint8)(dst32 >> blend->dstAshift);
+
+    MULT_DIV_255(srcR, blend->mod_r, srcR);
+    MULT_DIV_255(srcG, blend->mod_g, srcG);
+    MULT_DIV_255(srcB, blend->mod_b, srcB);
+    MULT_DIV_255(srcA, blend->mod_a, srcA);
+
+    MULT_DIV_255(srcR, srcA, srcR);
+    MULT_DIV_255(srcG, srcA, srcG);
+    MULT_DIV_255(srcB, srcA, srcB);
+
+    MULT_DIV_255((255 - srcA), dstR, dstR);
+    MULT_DIV_255((255 - srcA), dstG, dstG);
+    MULT_DIV_255((255 - srcA), dstB, dstB);
+    MULT_DIV_255((255 - srcA), dstA, dstA);
+
+    return ((dstR + srcR) << dstfmt->Rshift) |
+           ((dstG + srcG) << dstfmt->Gshift) |
+           ((dstB + srcB) << dstfmt->Bshift) |
+           ((dstA + srcA) << blend->dstAshift);
+}
+
+#endif // SDL_AVX2_INTRINSICS || SDL_NEON_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+
+// MULT_DIV_255() on 16-bit lanes
+#define MULT_DIV_255_AVX2(a, b) \
+    _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1)), \
+                                       _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, b), _mm256_set1_epi16(1)), 8)), 8)
+
+static SDL_INLINE __m256i SDL_TARGETING("avx2") BlendModulate8888AVX2(__m256i src, __m256i dst, __m256i mod, __m256i alpha_splat, __m256i alpha_lane)
+{
+    src = MULT_DIV_255_AVX2(src, mod);
+
+    // Premultiply the color channels, the alpha channel is multiplied by 255 to leave it as is
+    const __m256i srcA = _mm256_shuffle_epi8(src, alpha_splat);
+    src = MULT_DIV_255_AVX2(src, _mm256_or_si256(srcA, alpha_lane));
+
+    dst = MULT_DIV_255_AVX2(dst, _mm256_sub_epi16(_mm256_set1_epi16(255), srcA));
+    return _mm256_add_epi16(src, dst);
+}
+
+static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaModulateAVX2(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    bool fill_alpha = !dstfmt->Amask;
+    SDL_BlendModulate8888 blend;
+
+    SDL_SetupBlendModulate8888(info, &blend);
+
+    // The byte offsets for the start of each pixel
+    const __m256i mask_offsets = _mm256_set_epi8(
+        28, 28, 28, 28, 24, 24, 24, 24, 20, 20, 20, 20, 16, 16, 16, 16, 12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0);
+    const __m256i convert_mask = _mm256_add_epi32(_mm256_set1_epi32((int)blend.convert), mask_offsets);
+
+    // Copy the 16-bit alpha lane of each pixel into all four of its lanes; the high bytes are always zero
+    const char a0 = (char)(blend.alpha_byte * 2), a1 = (char)(blend.alpha_byte * 2 + 8);
+    const __m256i alpha_splat = _mm256_set_epi8(
+        -1, a1, -1, a1, -1, a1, -1, a1, -1, a0, -1, a0, -1, a0, -1, a0,
+        -1, a1, -1, a1, -1, a1, -1, a1, -1, a0, -1, a0, -1, a0, -1, a0);
+    const __m256i mod = _mm256_set1_epi64x((long long)blend.mod_lanes);
+    const __m256i alpha_lane = _mm256_set1_epi64x((long long)blend.alpha_lane);
+    const __m256i alpha_fill_mask = _mm256_set1_epi32((int)blend.dstAmask);
+    const __m256i zero = _mm256_setzero_si256();
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            // Load 8 src pixels and convert them to dst format
+            __m256i src256 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)src), convert_mask);
+
+            // Load 8 dst pixels
+            __m256i dst256 = _mm256_loadu_si256((__m256i *)dst);
+
+            // Widen each channel to a 16-bit lane, and blend
+            __m256i dst_lo = BlendModulate8888AVX2(_mm256_unpacklo_epi8(src256, zero), _mm256_unpacklo_epi8(dst256, zero), mod, alpha_splat, alpha_lane);
+            __m256i dst_hi = BlendModulate8888AVX2(_mm256_unpackhi_epi8(src256, zero), _mm256_unpackhi_epi8(dst256, zero), mod, alpha_splat, alpha_lane);
+
+            // Save the result
+            dst256 = _mm256_packus_epi16(dst_lo, dst_hi);
+            if (fill_alpha) {
+                dst256 = _mm256_or_si256(dst256, alpha_fill_mask);
+            }
+            _mm256_storeu_si256((__m256i *)dst, dst256);
+
+            src += 32;
+            dst += 32;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 dst32 = SDL_BlendModulate8888Pixel(*(Uint32 *)src, *(Uint32 *)dst, srcfmt, dstfmt, &blend);
+            if (fill_alpha) {
+                dst32 |= blend.dstAmask;
+            }
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#undef MULT_DIV_255_AVX2
+
+#endif
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+
+// MULT_DIV_255() on 16-bit lanes
+static SDL_INLINE uint16x8_t MultDiv255NEON(uint16x8_t a, uint16x8_t b)
+{
+    uint16x8_t x = vaddq_u16(vmulq_u16(a, b), vdupq_n_u16(1));
+    return vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8);
+}
+
+static SDL_INLINE uint16x8_t BlendModulate8888NEON(uint16x8_t src, uint16x8_t dst, uint16x8_t mod, uint8x16_t alpha_splat, uint16x8_t alpha_lane)
+{
+    src = MultDiv255NEON(src, mod);
+
+    // Premultiply the color channels, the alpha channel is multiplied by 255 to leave it as is
+    const uint16x8_t srcA = vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(src), alpha_splat));
+    src = MultDiv255NEON(src, vorrq_u16(srcA, alpha_lane));
+
+    dst = MultDiv255NEON(dst, vsubq_u16(vdupq_n_u16(255), srcA));
+    return vaddq_u16(src, dst);
+}
+
+static void Blit8888to8888PixelAlphaModulateNEON(SDL_BlitInfo *info)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    const SDL_PixelFormatDetails *srcfmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dstfmt = info->dst_fmt;
+    bool fill_alpha = !dstfmt->Amask;
+    SDL_BlendModulate8888 blend;
+
+    SDL_SetupBlendModulate8888(info, &blend);
+
+    // The byte offsets for the start of each pixel
+    const uint8x16_t mask_offsets = vreinterpretq_u8_u64(vcombine_u64(
+        vcreate_u64(0x0404040400000000), vcreate_u64(0x0c0c0c0c08080808)));
+    const uint8x16_t convert_mask = vreinterpretq_u8_u32(vaddq_u32(
+        vreinterpretq_u32_u8(mask_offsets), vdupq_n_u32(blend.convert)));
+
+    // Copy the 16-bit alpha lane of each pixel into all four of its lanes; out of range indices give zero
+    const Uint64 a0 = (Uint64)(blend.alpha_byte * 2), a1 = a0 + 8;
+    const uint8x16_t alpha_splat = vreinterpretq_u8_u64(vcombine_u64(
+        vcreate_u64(0xff00ff00ff00ff00 | (a0 * 0x0001000100010001)),
+        vcreate_u64(0xff00ff00ff00ff00 | (a1 * 0x0001000100010001))));
+    const uint16x8_t mod = vreinterpretq_u16_u64(vdupq_n_u64(blend.mod_lanes));
+    const uint16x8_t alpha_lane = vreinterpretq_u16_u64(vdupq_n_u64(blend.alpha_lane));
+    const uint8x16_t alpha_fill_mask = vreinterpretq_u8_u32(vdupq_n_u32(blend.dstAmask));
+
+    while (height--) {
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            // Load 4 src pixels and convert them to dst format
+            uint8x16_t src128 = vqtbl1q_u8(vld1q_u8(src), convert_mask);
+
+            // Load 4 dst pixels
+            uint8x16_t dst128 = vld1q_u8(dst);
+
+            // Widen each channel to a 16-bit lane, and blend
+            uint16x8_t dst_lo = BlendModulate8888NEON(vmovl_u8(vget_low_u8(src128)), vmovl_u8(vget_low_u8(dst128)), mod, alpha_splat, alpha_lane);
+            uint16x8_t dst_hi = BlendModulate8888NEON(vmovl_high_u8(src128), vmovl_high_u8(dst128), mod, alpha_splat, alpha_lane);
+
+            // Save the result
+            dst128 = vcombine_u8(vmovn_u16(dst_lo), vmovn_u16(dst_hi));
+            if (fill_alpha) {
+                dst128 = vorrq_u8(dst128, alpha_fill_mask);
+            }
+            vst1q_u8(dst, dst128);
+
+            src += 16;
+            dst += 16;
+        }
+
+        for (; i < width; ++i) {
+            Uint32 dst32 = SDL_BlendModulate8888Pixel(*(Uint32 *)src, *(Uint32 *)dst, srcfmt, dstfmt, &blend);
+            if (fill_alpha) {
+                dst32 |= blend.dstAmask;
+            }
+            *(Uint32 *)dst = dst32;
+            src += 4;
+            dst += 4;
+        }
+
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+#endif
+
+// Pick a SIMD blitter for blending with modulation, otherwise leave it to the generated blitters
+static SDL_BlitFunc SDL_CalculateBlit8888PixelAlphaModulate(const SDL_PixelFormatDetails *sf, const SDL_PixelFormatDetails *df)
+{
+    if (SDL_PIXELLAYOUT(sf->format) != SDL_PACKEDLAYOUT_8888 || !sf->Amask ||
+        SDL_PIXELLAYOUT(df->format) != SDL_PACKEDLAYOUT_8888) {
+        return NULL;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        return Blit8888to8888PixelAlphaModulateAVX2;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+    if (SDL_HasNEON()) {
+        return Blit8888to8888PixelAlphaModulateNEON;
+    }
+#endif
+    return NULL;
+}
+
 // General (slow) N->N blending with pixel alpha
 static void BlitNtoNPixelAlpha(SDL_BlitInfo *info)
 {
@@ -1477,7 +1756,11 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
                 return BlitNtoNSurfaceAlpha;
             }
         }
-        break;
+        return SDL_CalculateBlit8888PixelAlphaModulate(sf, df);
+
+    case SDL_COPY_MODULATE_COLOR | SDL_COPY_BLEND:
+    case SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+        return SDL_CalculateBlit8888PixelAlphaModulate(sf, df);
 
     case SDL_COPY_COLORKEY | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
         if (sf->Amask == 0) {
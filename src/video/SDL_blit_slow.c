@@ -23,6 +23,7 @@
 #include "SDL_surface_c.h"
 #include "SDL_blit_slow.h"
 #include "SDL_pixels_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
 
 typedef enum
 {
@@ -802,6 +803,627 @@ static void ApplyTonemap(SDL_TonemapContext *ctx, float *r, float *g, float *b)
     }
 }
 
+/* Row pipelines for the common float blits
+ *
+ * The loop in SDL_Blit_Slow_Float() resolves the pixel access method, transfer
+ * function and tonemap operator for every pixel. The conversions that dominate
+ * HDR content (10-bit PQ video frames, float16 and float32 scRGB surfaces going
+ * to 8-bit sRGB or 10-bit PQ) are straight copies, so for those a pipeline is
+ * selected once per blit and run over runs of pixels: unpack into planar float
+ * buffers, tonemap and convert primaries four pixels at a time, then encode and
+ * pack the 8888 or 2101010 destination.
+ *
+ * PQ decoding of 10-bit code values is a direct table lookup, and sRGB encoding
+ * to 8 bits uses the exact rounding thresholds of SDL_sRGBfromLinear(), so the
+ * output matches the generic loop. PQ encoding has too many inputs for a table
+ * and goes through the batch powf instead, which is accurate to about 1e-5 and
+ * can round to the neighbouring 10-bit code value where the generic loop lands
+ * within that of a rounding boundary.
+ */
+#define SLOW_FLOAT_CHUNK 64
+
+// Linear values below this always encode to 0, one bucket per 1/256th of an octave above it
+#define SRGB8_MIN_LINEAR    (1.0f / 16384.0f)
+#define SRGB8_BUCKET_SHIFT  15
+#define SRGB8_BUCKET_FIRST  ((127 - 14) << (23 - SRGB8_BUCKET_SHIFT))
+#define SRGB8_BUCKET_COUNT  (14 << (23 - SRGB8_BUCKET_SHIFT))
+
+static SDL_InitState SDL_slow_float_tables_init;
+static float SDL_PQ10_nits[1024];
+static float SDL_sRGB8_thresholds[257];
+static Uint8 SDL_sRGB8_buckets[SRGB8_BUCKET_COUNT];
+static const float SDL_alpha2_values[4] = { 0.0f / 3.0f, 1.0f / 3.0f, 2.0f / 3.0f, 3.0f / 3.0f };
+
+static Uint8 SRGB8FromLinear_Reference(float v)
+{
+    return (Uint8)SDL_roundf(SDL_clamp(SDL_sRGBfromLinear(v), 0.0f, 1.0f) * 255.0f);
+}
+
+static float FloatFromBits(Uint32 bits)
+{
+    float v;
+    SDL_memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+static void InitSlowFloatTables(void)
+{
+    int i;
+
+    if (!SDL_ShouldInit(&SDL_slow_float_tables_init)) {
+        return;
+    }
+
+    for (i = 0; i < SDL_arraysize(SDL_PQ10_nits); ++i) {
+        SDL_PQ10_nits[i] = SDL_PQtoNits((float)i / 1023.0f);
+    }
+
+    // Find the smallest positive float that encodes to each value
+    SDL_sRGB8_thresholds[0] = 0.0f;
+    for (i = 1; i <= 255; ++i) {
+        Uint32 lo = 0, hi = 0x3F800000; // 1.0f
+        while (lo < hi) {
+            Uint32 mid = lo + (hi - lo) / 2;
+            if (SRGB8FromLinear_Reference(FloatFromBits(mid)) >= i) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        SDL_sRGB8_thresholds[i] = FloatFromBits(lo);
+    }
+    SDL_sRGB8_thresholds[256] = 2.0f;
+
+    // Each bucket is narrow enough to contain at most one threshold
+    for (i = 0; i < SDL_arraysize(SDL_sRGB8_buckets); ++i) {
+        SDL_sRGB8_buckets[i] = SRGB8FromLinear_Reference(FloatFromBits((Uint32)(SRGB8_BUCKET_FIRST + i) << SRGB8_BUCKET_SHIFT));
+    }
+
+    SDL_SetInitialized(&SDL_slow_float_tables_init, true);
+}
+
+static SDL_INLINE Uint32 SRGB8FromLinear(float v)
+{
+    Uint32 bits, value;
+
+    if (!(v >= SRGB8_MIN_LINEAR)) {
+        return 0; // also catches NaN
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    SDL_memcpy(&bits, &v, sizeof(bits));
+    value = SDL_sRGB8_buckets[(bits >> SRGB8_BUCKET_SHIFT) - SRGB8_BUCKET_FIRST];
+    if (v >= SDL_sRGB8_thresholds[value + 1]) {
+        ++value;
+    }
+    return value;
+}
+
+static SDL_INLINE Uint32 Unorm8FromFloat(float v)
+{
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= 1.0f) {
+        return 255;
+    }
+    return (Uint32)(v * 255.0f + 0.5f);
+}
+
+static SDL_INLINE Uint32 Unorm10FromFloat(float v)
+{
+    if (!(v > 0.0f)) {
+        return 0;
+    }
+    if (v >= 1.0f) {
+        return 1023;
+    }
+    return (Uint32)(v * 1023.0f + 0.5f);
+}
+
+// SDL_PQfromNits() over a run of values, scale takes them to units of 10000 nits
+static void PQFromLinearRun(float *v, int count, float scale)
+{
+    const float c1 = 0.8359375f;
+    const float c2 = 18.8515625f;
+    const float c3 = 18.6875f;
+    const float m1 = 0.1593017578125f;
+    const float m2 = 78.84375f;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        v[i] = SDL_clamp(v[i] * scale, 0.0f, 1.0f);
+    }
+    SDL_powf_array(v, v, m1, count);
+    for (i = 0; i < count; ++i) {
+        v[i] = (c1 + c2 * v[i]) / (1.0f + c3 * v[i]);
+    }
+    SDL_powf_array(v, v, m2, count);
+}
+
+typedef enum
+{
+    SlowFloatSource_PQ10,
+    SlowFloatSource_F16,
+    SlowFloatSource_F32
+} SlowFloatSource;
+
+typedef struct SlowFloatPipeline
+{
+    SlowFloatSource source;
+    int srcbpp;
+    int components;
+    int offsets[4]; // R, G, B, A component index, or bit shift for 10-bit formats, -1 for opaque
+    float scale;    // SDR white point normalization, with any linear tonemap folded in
+    SDL_TonemapOperator op;
+    float tonemap_a;
+    float tonemap_b;
+    const float *tonemap_matrix;
+    const float *color_primaries_matrix;
+    const SDL_PixelFormatDetails *dst_fmt;
+    bool dst_pq10;      // 10-bit PQ destination instead of 8-bit sRGB
+    float dst_pq_scale; // destination SDR white point in units of 10000 nits
+    void (*ConvertHalfs)(float *dst, const Uint16 *src, int count);
+    void (*Transform)(const struct SlowFloatPipeline *pipeline, float *r, float *g, float *b, int count);
+} SlowFloatPipeline;
+
+static void ConvertHalfs_Scalar(float *dst, const Uint16 *src, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+static void Transform_Scalar(const SlowFloatPipeline *pipeline, float *r, float *g, float *b, int count)
+{
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        float R = r[i] * pipeline->scale;
+        float G = g[i] * pipeline->scale;
+        float B = b[i] * pipeline->scale;
+
+        if (pipeline->op == SDL_TONEMAP_CHROME) {
+            if (pipeline->tonemap_matrix) {
+                SDL_ConvertColorPrimaries(&R, &G, &B, pipeline->tonemap_matrix);
+            }
+            TonemapChrome(&R, &G, &B, pipeline->tonemap_a, pipeline->tonemap_b);
+        }
+        if (pipeline->color_primaries_matrix) {
+            SDL_ConvertColorPrimaries(&R, &G, &B, pipeline->color_primaries_matrix);
+        }
+        r[i] = R;
+        g[i] = G;
+        b[i] = B;
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+
+#define CONVERT_PRIMARIES_SSE2(R, G, B, m)                                                                                       \
+    {                                                                                                                            \
+        const __m128 r_ = R, g_ = G, b_ = B;                                                                                     \
+        R = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0]), r_), _mm_mul_ps(_mm_set1_ps(m[1]), g_)), _mm_mul_ps(_mm_set1_ps(m[2]), b_)); \
+        G = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[3]), r_), _mm_mul_ps(_mm_set1_ps(m[4]), g_)), _mm_mul_ps(_mm_set1_ps(m[5]), b_)); \
+        B = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[6]), r_), _mm_mul_ps(_mm_set1_ps(m[7]), g_)), _mm_mul_ps(_mm_set1_ps(m[8]), b_)); \
+    }
+
+static void SDL_TARGETING("sse2") ConvertHalfs_SSE2(float *dst, const Uint16 *src, int count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i exponent_mantissa = _mm_set1_epi32(0x7fff);
+    const __m128i sign = _mm_set1_epi32(0x8000);
+    const __m128i infnan = _mm_set1_epi32(255 << 23);
+    const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+    const __m128 was_infnan = _mm_castsi128_ps(_mm_set1_epi32((127 + 16) << 23));
+    int i;
+
+    // Same bit manipulation as half_to_float(), eight values at a time
+    for (i = 0; i + 8 <= count; i += 8) {
+        const __m128i h8 = _mm_loadu_si128((const __m128i *)&src[i]);
+        __m128i h = _mm_unpacklo_epi16(h8, zero);
+        int j;
+
+        for (j = 0; j < 2; ++j) {
+            __m128 o = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, exponent_mantissa), 13));
+            o = _mm_mul_ps(o, magic);
+            o = _mm_or_ps(o, _mm_and_ps(_mm_cmpge_ps(o, was_infnan), _mm_castsi128_ps(infnan)));
+            o = _mm_or_ps(o, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(h, sign), 16)));
+            _mm_storeu_ps(&dst[i + j * 4], o);
+            h = _mm_unpackhi_epi16(h8, zero);
+        }
+    }
+    for (; i < count; ++i) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+static void SDL_TARGETING("sse2") Transform_SSE2(const SlowFloatPipeline *pipeline, float *r, float *g, float *b, int count)
+{
+    const __m128 scale = _mm_set1_ps(pipeline->scale);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 tonemap_a = _mm_set1_ps(pipeline->tonemap_a);
+    const __m128 tonemap_b = _mm_set1_ps(pipeline->tonemap_b);
+    const float *tonemap_matrix = pipeline->tonemap_matrix;
+    const float *color_primaries_matrix = pipeline->color_primaries_matrix;
+    int i;
+
+    // The buffers are padded to a multiple of four pixels
+    for (i = 0; i < count; i += 4) {
+        __m128 R = _mm_mul_ps(_mm_loadu_ps(&r[i]), scale);
+        __m128 G = _mm_mul_ps(_mm_loadu_ps(&g[i]), scale);
+        __m128 B = _mm_mul_ps(_mm_loadu_ps(&b[i]), scale);
+
+        if (pipeline->op == SDL_TONEMAP_CHROME) {
+            __m128 vmax, factor, positive;
+
+            if (tonemap_matrix) {
+                CONVERT_PRIMARIES_SSE2(R, G, B, tonemap_matrix);
+            }
+            vmax = _mm_max_ps(R, _mm_max_ps(G, B));
+            factor = _mm_div_ps(_mm_add_ps(one, _mm_mul_ps(tonemap_a, vmax)), _mm_add_ps(one, _mm_mul_ps(tonemap_b, vmax)));
+            positive = _mm_cmpgt_ps(vmax, zero);
+            factor = _mm_or_ps(_mm_and_ps(positive, factor), _mm_andnot_ps(positive, one));
+            R = _mm_mul_ps(R, factor);
+            G = _mm_mul_ps(G, factor);
+            B = _mm_mul_ps(B, factor);
+        }
+        if (color_primaries_matrix) {
+            CONVERT_PRIMARIES_SSE2(R, G, B, color_primaries_matrix);
+        }
+        _mm_storeu_ps(&r[i], R);
+        _mm_storeu_ps(&g[i], G);
+        _mm_storeu_ps(&b[i], B);
+    }
+}
+
+#endif // SDL_SSE2_INTRINSICS
+
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+
+#define CONVERT_PRIMARIES_NEON(R, G, B, m)                                                               \
+    {                                                                                                    \
+        const float32x4_t r_ = R, g_ = G, b_ = B;                                                        \
+        R = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(r_, m[0]), g_, m[1]), b_, m[2]);                         \
+        G = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(r_, m[3]), g_, m[4]), b_, m[5]);                         \
+        B = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(r_, m[6]), g_, m[7]), b_, m[8]);                         \
+    }
+
+static void ConvertHalfs_NEON(float *dst, const Uint16 *src, int count)
+{
+    const uint32x4_t exponent_mantissa = vdupq_n_u32(0x7fff);
+    const uint32x4_t sign = vdupq_n_u32(0x8000);
+    const uint32x4_t infnan = vdupq_n_u32(255 << 23);
+    const float32x4_t magic = vreinterpretq_f32_u32(vdupq_n_u32((254 - 15) << 23));
+    const float32x4_t was_infnan = vreinterpretq_f32_u32(vdupq_n_u32((127 + 16) << 23));
+    int i;
+
+    // Same bit manipulation as half_to_float(), four values at a time
+    for (i = 0; i + 4 <= count; i += 4) {
+        const uint32x4_t h = vmovl_u16(vld1_u16(&src[i]));
+        float32x4_t o = vreinterpretq_f32_u32(vshlq_n_u32(vandq_u32(h, exponent_mantissa), 13));
+        uint32x4_t u;
+
+        o = vmulq_f32(o, magic);
+        u = vreinterpretq_u32_f32(o);
+        u = vorrq_u32(u, vandq_u32(vcgeq_f32(o, was_infnan), infnan));
+        u = vorrq_u32(u, vshlq_n_u32(vandq_u32(h, sign), 16));
+        vst1q_f32(&dst[i], vreinterpretq_f32_u32(u));
+    }
+    for (; i < count; ++i) {
+        dst[i] = half_to_float(src[i]);
+    }
+}
+
+static void Transform_NEON(const SlowFloatPipeline *pipeline, float *r, float *g, float *b, int count)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float scale = pipeline->scale;
+    const float tonemap_a = pipeline->tonemap_a;
+    const float tonemap_b = pipeline->tonemap_b;
+    const float *tonemap_matrix = pipeline->tonemap_matrix;
+    const float *color_primaries_matrix = pipeline->color_primaries_matrix;
+    int i;
+
+    // The buffers are padded to a multiple of four pixels
+    for (i = 0; i < count; i += 4) {
+        float32x4_t R = vmulq_n_f32(vld1q_f32(&r[i]), scale);
+        float32x4_t G = vmulq_n_f32(vld1q_f32(&g[i]), scale);
+        float32x4_t B = vmulq_n_f32(vld1q_f32(&b[i]), scale);
+
+        if (pipeline->op == SDL_TONEMAP_CHROME) {
+            float32x4_t vmax, num, den, rcp, factor;
+
+            if (tonemap_matrix) {
+                CONVERT_PRIMARIES_NEON(R, G, B, tonemap_matrix);
+            }
+            vmax = vmaxq_f32(R, vmaxq_f32(G, B));
+            num = vmlaq_n_f32(one, vmax, tonemap_a);
+            den = vmlaq_n_f32(one, vmax, tonemap_b);
+
+            // Two Newton-Raphson steps bring the reciprocal estimate to full precision
+            rcp = vrecpeq_f32(den);
+            rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+            rcp = vmulq_f32(rcp, vrecpsq_f32(den, rcp));
+            factor = vbslq_f32(vcgtq_f32(vmax, zero), vmulq_f32(num, rcp), one);
+            R = vmulq_f32(R, factor);
+            G = vmulq_f32(G, factor);
+            B = vmulq_f32(B, factor);
+        }
+        if (color_primaries_matrix) {
+            CONVERT_PRIMARIES_NEON(R, G, B, color_primaries_matrix);
+        }
+        vst1q_f32(&r[i], R);
+        vst1q_f32(&g[i], G);
+        vst1q_f32(&b[i], B);
+    }
+}
+
+#endif // SDL_NEON_INTRINSICS
+
+static bool SetupSlowFloatPipeline(SDL_BlitInfo *info, SDL_Colorspace src_colorspace, SDL_Colorspace dst_colorspace, float src_white_point,
+                                   float dst_white_point, const SDL_TonemapContext *tonemap, const float *color_primaries_matrix, SlowFloatPipeline *pipeline)
+{
+    const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
+    SDL_TransferCharacteristics src_transfer = SDL_COLORSPACETRANSFER(src_colorspace);
+    SDL_TransferCharacteristics dst_transfer = SDL_COLORSPACETRANSFER(dst_colorspace);
+    bool dst_pq10;
+    int i;
+
+    if (info->flags & (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY)) {
+        return false;
+    }
+
+    // The destination has to be 8-bit sRGB with byte sized channels, or 10-bit PQ
+    if (dst_transfer == SDL_TRANSFER_CHARACTERISTICS_PQ) {
+        switch (dst_fmt->format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+        case SDL_PIXELFORMAT_ARGB2101010:
+        case SDL_PIXELFORMAT_XBGR2101010:
+        case SDL_PIXELFORMAT_ABGR2101010:
+            dst_pq10 = true;
+            break;
+        default:
+            return false;
+        }
+    } else if (dst_transfer != SDL_TRANSFER_CHARACTERISTICS_SRGB ||
+               dst_fmt->bytes_per_pixel != 4 || SDL_ISPIXELFORMAT_10BIT(dst_fmt->format) || SDL_ISPIXELFORMAT_INDEXED(dst_fmt->format) ||
+               dst_fmt->Rbits != 8 || dst_fmt->Gbits != 8 || dst_fmt->Bbits != 8 || (dst_fmt->Abits != 0 && dst_fmt->Abits != 8)) {
+        return false;
+    } else {
+        dst_pq10 = false;
+    }
+
+    SDL_zerop(pipeline);
+    pipeline->srcbpp = src_fmt->bytes_per_pixel;
+
+    if (SDL_ISPIXELFORMAT_10BIT(src_fmt->format) && src_transfer == SDL_TRANSFER_CHARACTERISTICS_PQ) {
+        pipeline->source = SlowFloatSource_PQ10;
+        switch (src_fmt->format) {
+        case SDL_PIXELFORMAT_XRGB2101010:
+        case SDL_PIXELFORMAT_ARGB2101010:
+            pipeline->offsets[0] = 20;
+            pipeline->offsets[1] = 10;
+            pipeline->offsets[2] = 0;
+            break;
+        case SDL_PIXELFORMAT_XBGR2101010:
+        case SDL_PIXELFORMAT_ABGR2101010:
+            pipeline->offsets[0] = 0;
+            pipeline->offsets[1] = 10;
+            pipeline->offsets[2] = 20;
+            break;
+        default:
+            return false;
+        }
+        pipeline->offsets[3] = SDL_ISPIXELFORMAT_ALPHA(src_fmt->format) ? 30 : -1;
+    } else if (SDL_BYTESPERPIXEL(src_fmt->format) > 4 && src_transfer == SDL_TRANSFER_CHARACTERISTICS_LINEAR) {
+        static const int array_offsets[][4] = {
+            { -1, -1, -1, -1 }, // SDL_ARRAYORDER_NONE
+            { 0, 1, 2, -1 },    // SDL_ARRAYORDER_RGB
+            { 0, 1, 2, 3 },     // SDL_ARRAYORDER_RGBA
+            { 1, 2, 3, 0 },     // SDL_ARRAYORDER_ARGB
+            { 2, 1, 0, -1 },    // SDL_ARRAYORDER_BGR
+            { 2, 1, 0, 3 },     // SDL_ARRAYORDER_BGRA
+            { 3, 2, 1, 0 },     // SDL_ARRAYORDER_ABGR
+        };
+        Uint32 order = SDL_PIXELORDER(src_fmt->format);
+
+        switch (SDL_PIXELTYPE(src_fmt->format)) {
+        case SDL_PIXELTYPE_ARRAYF16:
+            pipeline->source = SlowFloatSource_F16;
+            pipeline->components = src_fmt->bytes_per_pixel / (int)sizeof(Uint16);
+            break;
+        case SDL_PIXELTYPE_ARRAYF32:
+            pipeline->source = SlowFloatSource_F32;
+            pipeline->components = src_fmt->bytes_per_pixel / (int)sizeof(float);
+            break;
+        default:
+            return false;
+        }
+        if (order == SDL_ARRAYORDER_NONE || order >= SDL_arraysize(array_offsets)) {
+            return false;
+        }
+        for (i = 0; i < 4; ++i) {
+            pipeline->offsets[i] = array_offsets[order][i];
+        }
+        if (pipeline->offsets[3] >= pipeline->components) {
+            pipeline->offsets[3] = -1;
+        }
+        for (i = 0; i < 3; ++i) {
+            if (pipeline->offsets[i] >= pipeline->components) {
+                return false;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    pipeline->scale = 1.0f / src_white_point;
+    pipeline->op = tonemap->op;
+    if (tonemap->op == SDL_TONEMAP_LINEAR) {
+        pipeline->scale *= tonemap->data.linear.scale;
+        pipeline->op = SDL_TONEMAP_NONE;
+    } else if (tonemap->op == SDL_TONEMAP_CHROME) {
+        pipeline->tonemap_a = tonemap->data.chrome.a;
+        pipeline->tonemap_b = tonemap->data.chrome.b;
+        pipeline->tonemap_matrix = tonemap->data.chrome.color_primaries_matrix;
+    }
+    pipeline->color_primaries_matrix = color_primaries_matrix;
+    pipeline->dst_fmt = dst_fmt;
+    pipeline->dst_pq10 = dst_pq10;
+    pipeline->dst_pq_scale = dst_white_point / 10000.0f;
+
+    pipeline->ConvertHalfs = ConvertHalfs_Scalar;
+    pipeline->Transform = Transform_Scalar;
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        pipeline->ConvertHalfs = ConvertHalfs_SSE2;
+        pipeline->Transform = Transform_SSE2;
+    }
+#endif
+#if defined(SDL_NEON_INTRINSICS) && (__ARM_ARCH >= 8)
+    if (SDL_HasNEON()) {
+        pipeline->ConvertHalfs = ConvertHalfs_NEON;
+        pipeline->Transform = Transform_NEON;
+    }
+#endif
+
+    InitSlowFloatTables();
+    return true;
+}
+
+static void ReadSlowFloatRun(const SlowFloatPipeline *pipeline, const Uint8 *src, Uint64 posx, Uint64 incx, int count,
+                             float *r, float *g, float *b, float *a)
+{
+    const int *offsets = pipeline->offsets;
+    int i;
+
+    switch (pipeline->source) {
+    case SlowFloatSource_PQ10:
+        for (i = 0; i < count; ++i, posx += incx) {
+            const Uint32 pixel = *(const Uint32 *)(src + (posx >> 16) * 4);
+            r[i] = SDL_PQ10_nits[(pixel >> offsets[0]) & 0x3FF];
+            g[i] = SDL_PQ10_nits[(pixel >> offsets[1]) & 0x3FF];
+            b[i] = SDL_PQ10_nits[(pixel >> offsets[2]) & 0x3FF];
+            a[i] = (offsets[3] < 0) ? 1.0f : SDL_alpha2_values[pixel >> 30];
+        }
+        break;
+    case SlowFloatSource_F16:
+    {
+        Uint16 halfs[SLOW_FLOAT_CHUNK * 4];
+        float v[SLOW_FLOAT_CHUNK * 4];
+        const int components = pipeline->components;
+        const size_t srcbpp = (size_t)pipeline->srcbpp;
+
+        for (i = 0; i < count; ++i, posx += incx) {
+            SDL_memcpy(&halfs[i * components], src + (posx >> 16) * srcbpp, srcbpp);
+        }
+        pipeline->ConvertHalfs(v, halfs, count * components);
+        for (i = 0; i < count; ++i) {
+            const float *pixel = &v[i * components];
+            r[i] = pixel[offsets[0]];
+            g[i] = pixel[offsets[1]];
+            b[i] = pixel[offsets[2]];
+            a[i] = (offsets[3] < 0) ? 1.0f : pixel[offsets[3]];
+        }
+        break;
+    }
+    case SlowFloatSource_F32:
+        for (i = 0; i < count; ++i, posx += incx) {
+            const float *pixel = (const float *)(src + (posx >> 16) * pipeline->srcbpp);
+            r[i] = pixel[offsets[0]];
+            g[i] = pixel[offsets[1]];
+            b[i] = pixel[offsets[2]];
+            a[i] = (offsets[3] < 0) ? 1.0f : pixel[offsets[3]];
+        }
+        break;
+    }
+}
+
+static void WriteSlowFloatRun(const SlowFloatPipeline *pipeline, Uint32 *dst, int count,
+                              float *r, float *g, float *b, const float *a)
+{
+    const SDL_PixelFormatDetails *fmt = pipeline->dst_fmt;
+    const Uint32 Rshift = fmt->Rshift;
+    const Uint32 Gshift = fmt->Gshift;
+    const Uint32 Bshift = fmt->Bshift;
+    int i;
+
+    if (pipeline->dst_pq10) {
+        PQFromLinearRun(r, count, pipeline->dst_pq_scale);
+        PQFromLinearRun(g, count, pipeline->dst_pq_scale);
+        PQFromLinearRun(b, count, pipeline->dst_pq_scale);
+        for (i = 0; i < count; ++i) {
+            // Like the generic loop, the X formats get opaque alpha bits
+            const Uint32 A = fmt->Amask ? (Uint32)(SDL_clamp(a[i], 0.0f, 1.0f) * 3.0f + 0.5f) : 3;
+            dst[i] = (Unorm10FromFloat(r[i]) << Rshift) |
+                     (Unorm10FromFloat(g[i]) << Gshift) |
+                     (Unorm10FromFloat(b[i]) << Bshift) |
+                     (A << 30);
+        }
+        return;
+    }
+
+    if (fmt->Amask) {
+        const Uint32 Ashift = fmt->Ashift;
+        for (i = 0; i < count; ++i) {
+            dst[i] = (SRGB8FromLinear(r[i]) << Rshift) |
+                     (SRGB8FromLinear(g[i]) << Gshift) |
+                     (SRGB8FromLinear(b[i]) << Bshift) |
+                     (Unorm8FromFloat(a[i]) << Ashift);
+        }
+    } else {
+        for (i = 0; i < count; ++i) {
+            dst[i] = (SRGB8FromLinear(r[i]) << Rshift) |
+                     (SRGB8FromLinear(g[i]) << Gshift) |
+                     (SRGB8FromLinear(b[i]) << Bshift);
+        }
+    }
+}
+
+static void SDL_Blit_Slow_Float_Pipeline(SDL_BlitInfo *info, const SlowFloatPipeline *pipeline)
+{
+    float r[SLOW_FLOAT_CHUNK], g[SLOW_FLOAT_CHUNK], b[SLOW_FLOAT_CHUNK], a[SLOW_FLOAT_CHUNK];
+    Uint64 posy, posx;
+    Uint64 incy, incx;
+
+    // The vector transforms run over whole groups of four, keep the padding defined
+    SDL_zeroa(r);
+    SDL_zeroa(g);
+    SDL_zeroa(b);
+
+    incy = ((Uint64)info->src_h << 16) / info->dst_h;
+    incx = ((Uint64)info->src_w << 16) / info->dst_w;
+    posy = incy / 2; // start at the middle of pixel
+
+    while (info->dst_h--) {
+        const Uint8 *src = info->src + (posy >> 16) * info->src_pitch;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+
+        posx = incx / 2; // start at the middle of pixel
+        while (n > 0) {
+            const int count = SDL_min(n, SLOW_FLOAT_CHUNK);
+
+            ReadSlowFloatRun(pipeline, src, posx, incx, count, r, g, b, a);
+            pipeline->Transform(pipeline, r, g, b, (count + 3) & ~3);
+            WriteSlowFloatRun(pipeline, dst, count, r, g, b, a);
+
+            posx += incx * count;
+            dst += count;
+            n -= count;
+        }
+        posy += incy;
+        info->dst += info->dst_pitch;
+    }
+}
+
 /* The SECOND TRUE BLITTER
  * This one is even slower than the first, but also handles large pixel formats and colorspace conversion
  */
@@ -836,6 +1458,7 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
     float dst_headroom;
     float src_headroom;
     SDL_TonemapContext tonemap;
+    SlowFloatPipeline pipeline;
     Uint32 last_pixel = 0;
     Uint8 last_index = 0;
 
@@ -886,6 +1509,11 @@ void SDL_Blit_Slow_Float(SDL_BlitInfo *info)
         color_primaries_matrix = SDL_GetColorPrimariesConversionMatrix(src_primaries, dst_primaries);
     }
 
+    if (SetupSlowFloatPipeline(info, src_colorspace, dst_colorspace, src_white_point, dst_white_point, &tonemap, color_primaries_matrix, &pipeline)) {
+        SDL_Blit_Slow_Float_Pipeline(info, &pipeline);
+        return;
+    }
+
     src_access = GetPixelAccessMethod(src_fmt->format);
     dst_access = GetPixelAccessMethod(dst_fmt->format);
     if (dst_access == SlowBlitPixelAccess_Index8) {
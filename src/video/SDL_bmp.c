@@ -37,6 +37,9 @@
 
 #define SAVE_32BIT_BMP
 
+// Pixel rows are read and written in batches of about this many bytes
+#define BMP_ROW_BATCH_BYTES (256 * 1024)
+
 // Compression encodings for BMP files
 #ifndef BI_RGB
 #define BI_RGB       0
@@ -177,7 +180,28 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
     }
 }
 
-SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
+static void SetAlphaOpaque(SDL_Surface *surface)
+{
+    const Uint32 Amask = surface->fmt->Amask;
+    int x, y;
+
+    for (y = 0; y < surface->h; ++y) {
+        Uint8 *row = (Uint8 *)surface->pixels + y * surface->pitch;
+        if (surface->fmt->bytes_per_pixel == 2) {
+            Uint16 *pix = (Uint16 *)row;
+            for (x = 0; x < surface->w; ++x) {
+                pix[x] |= (Uint16)Amask;
+            }
+        } else {
+            Uint32 *pix = (Uint32 *)row;
+            for (x = 0; x < surface->w; ++x) {
+                pix[x] |= Amask;
+            }
+        }
+    }
+}
+
+SDL_Surface *SDL_LoadBMPWithProperties(SDL_IOStream *src, bool closeio, SDL_PropertiesID props)
 {
     bool was_error = true;
     Sint64 fp_offset = 0;
@@ -193,6 +217,10 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     bool haveRGBMasks = false;
     bool haveAlphaMask = false;
     bool correctAlpha = false;
+    SDL_PixelFormat file_format = SDL_PIXELFORMAT_UNKNOWN;
+    SDL_PixelFormat target_format;
+    bool direct = false;
+    Uint8 *rows = NULL;
 
     // The Win32 BMP file header (14 bytes)
     char magic[2];
@@ -214,6 +242,8 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     Uint32 biClrUsed = 0;
     // Uint32 biClrImportant;
 
+    target_format = (SDL_PixelFormat)SDL_GetNumberProperty(props, SDL_PROP_LOAD_BMP_FORMAT_NUMBER, SDL_PIXELFORMAT_UNKNOWN);
+
     // Make sure we are passed a valid data source
     surface = NULL;
     if (!src) {
@@ -409,18 +439,28 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     }
 
     // Create a compatible surface, note that the colors are RGB ordered
-    {
-        SDL_PixelFormat format;
-
-        // Get the pixel format
-        format = SDL_GetPixelFormatForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
-        surface = SDL_CreateSurface(biWidth, biHeight, format);
-
-        if (!surface) {
-            goto done;
+    file_format = SDL_GetPixelFormatForMasks(biBitCount, Rmask, Gmask, Bmask, Amask);
+
+    /* Uncompressed direct color rows can be converted one at a time into
+       the requested format, without a full size image in the file format.
+       If the alpha channel might have to be fixed up afterwards, that's only
+       done for packed formats, everything else is converted at the end. */
+    if (target_format != SDL_PIXELFORMAT_UNKNOWN && target_format != file_format &&
+        file_format != SDL_PIXELFORMAT_UNKNOWN && !SDL_ISPIXELFORMAT_INDEXED(file_format) &&
+        (biCompression == BI_RGB || biCompression == BI_BITFIELDS) &&
+        !SDL_ISPIXELFORMAT_FOURCC(target_format) && !SDL_ISPIXELFORMAT_INDEXED(target_format)) {
+        if (!correctAlpha || !SDL_ISPIXELFORMAT_ALPHA(target_format) ||
+            (SDL_ISPIXELFORMAT_PACKED(target_format) &&
+             (SDL_BYTESPERPIXEL(target_format) == 2 || SDL_BYTESPERPIXEL(target_format) == 4))) {
+            direct = true;
         }
     }
 
+    surface = SDL_CreateSurface(biWidth, biHeight, direct ? target_format : file_format);
+    if (!surface) {
+        goto done;
+    }
+
     // Load the palette, if any
     if (SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
         SDL_Palette *palette = SDL_CreateSurfacePalette(surface);
@@ -493,6 +533,71 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
         was_error = false;
         goto done;
     }
+    if (direct) {
+        const Sint64 file_pitch = (((Sint64)biWidth * biBitCount + 31) / 32) * 4;
+        int rows_per_batch, y, n, k;
+        Uint32 alpha_seen = 0;
+
+        if (file_pitch > SDL_MAX_SINT32) {
+            SDL_SetError("BMP file with bad dimensions (%" SDL_PRIs32 "x%" SDL_PRIs32 ")", biWidth, biHeight);
+            goto done;
+        }
+        rows_per_batch = (int)SDL_clamp(BMP_ROW_BATCH_BYTES / file_pitch, 1, biHeight);
+        rows = (Uint8 *)SDL_malloc((size_t)rows_per_batch * (size_t)file_pitch);
+        if (!rows) {
+            goto done;
+        }
+
+        for (y = 0; y < biHeight; y += n) {
+            n = SDL_min(rows_per_batch, biHeight - y);
+            if (SDL_ReadIO(src, rows, (size_t)n * (size_t)file_pitch) != (size_t)n * (size_t)file_pitch) {
+                goto done;
+            }
+            for (k = 0; k < n; ++k) {
+                Uint8 *row = rows + k * file_pitch;
+                const int dst_y = topDown ? (y + k) : (biHeight - 1 - (y + k));
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+                switch (biBitCount) {
+                case 15:
+                case 16:
+                {
+                    Uint16 *pix = (Uint16 *)row;
+                    for (i = 0; i < biWidth; i++) {
+                        pix[i] = SDL_Swap16(pix[i]);
+                    }
+                    break;
+                }
+
+                case 32:
+                {
+                    Uint32 *pix = (Uint32 *)row;
+                    for (i = 0; i < biWidth; i++) {
+                        pix[i] = SDL_Swap32(pix[i]);
+                    }
+                    break;
+                }
+                }
+#endif
+                if (correctAlpha) {
+                    const Uint32 *pix = (const Uint32 *)row;
+                    for (i = 0; i < biWidth; i++) {
+                        alpha_seen |= pix[i];
+                    }
+                }
+                if (!SDL_ConvertPixels(biWidth, 1, file_format, row, (int)file_pitch,
+                                       surface->format, (Uint8 *)surface->pixels + dst_y * surface->pitch, surface->pitch)) {
+                    goto done;
+                }
+            }
+        }
+        if (correctAlpha && !(alpha_seen & Amask) && SDL_ISPIXELFORMAT_ALPHA(surface->format)) {
+            SetAlphaOpaque(surface);
+        }
+
+        was_error = false;
+        goto done;
+    }
     top = (Uint8 *)surface->pixels;
     end = (Uint8 *)surface->pixels + (surface->h * surface->pitch);
     pad = ((surface->pitch % 4) ? (4 - (surface->pitch % 4)) : 0);
@@ -560,6 +665,15 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     was_error = false;
 
 done:
+    if (!was_error && target_format != SDL_PIXELFORMAT_UNKNOWN && surface->format != target_format) {
+        SDL_Surface *converted = SDL_ConvertSurface(surface, target_format);
+        if (converted) {
+            SDL_DestroySurface(surface);
+            surface = converted;
+        } else {
+            was_error = true;
+        }
+    }
     if (was_error) {
         if (src) {
             SDL_SeekIO(src, fp_offset, SDL_IO_SEEK_SET);
@@ -567,12 +681,18 @@ done:
         SDL_DestroySurface(surface);
         surface = NULL;
     }
+    SDL_free(rows);
     if (closeio && src) {
         SDL_CloseIO(src);
     }
     return surface;
 }
 
+SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
+{
+    return SDL_LoadBMPWithProperties(src, closeio, 0);
+}
+
 SDL_Surface *SDL_LoadBMP(const char *file)
 {
     SDL_IOStream *stream = SDL_IOFromFile(file, "rb");
@@ -586,9 +706,11 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
 {
     bool was_error = true;
     Sint64 fp_offset, new_offset;
-    int i, pad;
+    int i, rows_per_batch, y, n, k;
     SDL_Surface *intermediate_surface = NULL;
-    Uint8 *bits;
+    SDL_PixelFormat save_format = SDL_PIXELFORMAT_UNKNOWN;
+    bool convert_rows = false;
+    Uint8 *rows = NULL;
     bool save32bit = false;
     bool saveLegacyBMP = false;
 
@@ -669,20 +791,35 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
         } else {
             pixel_format = SDL_PIXELFORMAT_BGR24;
         }
-        intermediate_surface = SDL_ConvertSurface(surface, pixel_format);
-        if (!intermediate_surface) {
-            SDL_SetError("Couldn't convert image to %d bpp",
-                         (int)SDL_BITSPERPIXEL(pixel_format));
-            goto done;
+
+        /* Direct color surfaces are converted a batch of rows at a time while
+           writing. Colorkeys and YUV surfaces need the whole surface converted. */
+        if (!SDL_ISPIXELFORMAT_INDEXED(surface->format) &&
+            !SDL_ISPIXELFORMAT_FOURCC(surface->format) &&
+            !(surface->map.info.flags & SDL_COPY_COLORKEY)) {
+            intermediate_surface = surface;
+            save_format = pixel_format;
+            convert_rows = true;
+        } else {
+            intermediate_surface = SDL_ConvertSurface(surface, pixel_format);
+            if (!intermediate_surface) {
+                SDL_SetError("Couldn't convert image to %d bpp",
+                             (int)SDL_BITSPERPIXEL(pixel_format));
+                goto done;
+            }
         }
     }
+    if (!convert_rows) {
+        save_format = intermediate_surface->format;
+    }
 
     if (save32bit) {
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, false);
     }
 
     if (SDL_LockSurface(intermediate_surface)) {
-        const size_t bw = intermediate_surface->w * intermediate_surface->fmt->bytes_per_pixel;
+        const size_t bw = intermediate_surface->w * SDL_BYTESPERPIXEL(save_format);
+        const size_t row_size = (bw + 3) & ~3;
 
         // Set the BMP file header values
         bfSize = 0; // We'll write this when we're done
@@ -708,9 +845,9 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
         biWidth = intermediate_surface->w;
         biHeight = intermediate_surface->h;
         biPlanes = 1;
-        biBitCount = intermediate_surface->fmt->bits_per_pixel;
+        biBitCount = SDL_BITSPERPIXEL(save_format);
         biCompression = BI_RGB;
-        biSizeImage = intermediate_surface->h * intermediate_surface->pitch;
+        biSizeImage = (Uint32)(intermediate_surface->h * row_size);
         biXPelsPerMeter = 0;
         biYPelsPerMeter = 0;
         if (intermediate_surface->palette) {
@@ -814,22 +951,31 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
             goto done;
         }
 
-        // Write the bitmap image upside down
-        bits = (Uint8 *)intermediate_surface->pixels + (intermediate_surface->h * intermediate_surface->pitch);
-        pad = ((bw % 4) ? (4 - (bw % 4)) : 0);
-        while (bits > (Uint8 *)intermediate_surface->pixels) {
-            bits -= intermediate_surface->pitch;
-            if (SDL_WriteIO(dst, bits, bw) != bw) {
-                goto done;
-            }
-            if (pad) {
-                const Uint8 padbyte = 0;
-                for (i = 0; i < pad; ++i) {
-                    if (!SDL_WriteU8(dst, padbyte)) {
+        /* Write the bitmap image upside down, gathering padded rows into
+           one buffer so each batch of rows is a single write. */
+        rows_per_batch = (int)SDL_clamp(BMP_ROW_BATCH_BYTES / row_size, 1, (size_t)intermediate_surface->h);
+        rows = (Uint8 *)SDL_calloc(rows_per_batch, row_size);
+        if (!rows) {
+            goto done;
+        }
+        for (y = intermediate_surface->h; y > 0; y -= n) {
+            n = SDL_min(rows_per_batch, y);
+            for (k = 0; k < n; ++k) {
+                const Uint8 *bits = (const Uint8 *)intermediate_surface->pixels + (y - 1 - k) * intermediate_surface->pitch;
+                Uint8 *row = rows + k * row_size;
+                if (convert_rows) {
+                    if (!SDL_ConvertPixelsAndColorspace(intermediate_surface->w, 1,
+                                                        intermediate_surface->format, intermediate_surface->colorspace, intermediate_surface->props, bits, intermediate_surface->pitch,
+                                                        save_format, SDL_GetDefaultColorspaceForFormat(save_format), 0, row, (int)row_size)) {
                         goto done;
                     }
+                } else {
+                    SDL_memcpy(row, bits, bw);
                 }
             }
+            if (SDL_WriteIO(dst, rows, n * row_size) != n * row_size) {
+                goto done;
+            }
         }
 
         // Write the BMP file size
@@ -855,6 +1001,7 @@ bool SDL_SaveBMP_IO(SDL_Surface *surface, SDL_IOStream *dst, bool closeio)
     }
 
 done:
+    SDL_free(rows);
     if (intermediate_surface && intermediate_surface != surface) {
         SDL_DestroySurface(intermediate_surface);
     }
@@ -225,6 +225,67 @@ void *SDL_GetClipboardData(const char *mime_type, size_t *size)
     }
 }
 
+SDL_IOStream *SDL_OpenInternalClipboardDataIO(SDL_VideoDevice *_this, const char *mime_type)
+{
+    if (_this->clipboard_callback) {
+        size_t size = 0;
+        const void *provided_data = _this->clipboard_callback(_this->clipboard_userdata, mime_type, &size);
+        if (provided_data) {
+            // The data stays valid until the clipboard changes, so it can be read in place
+            return SDL_IOFromConstMem(provided_data, size);
+        }
+    }
+    SDL_SetError("No clipboard data available for %s", mime_type);
+    return NULL;
+}
+
+static void SDLCALL SDL_CleanupClipboardDataIO(void *userdata, void *value)
+{
+    SDL_free(value);
+}
+
+SDL_IOStream *SDL_OpenClipboardDataIO(const char *mime_type)
+{
+    SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    SDL_IOStream *io;
+    void *data;
+    size_t size = 0;
+
+    if (!_this) {
+        SDL_UninitializedVideo();
+        return NULL;
+    }
+
+    if (!mime_type) {
+        SDL_InvalidParamError("mime_type");
+        return NULL;
+    }
+
+    if (_this->OpenClipboardDataIO) {
+        return _this->OpenClipboardDataIO(_this, mime_type);
+    } else if (!_this->GetClipboardData && !_this->GetClipboardText) {
+        return SDL_OpenInternalClipboardDataIO(_this, mime_type);
+    }
+
+    // Fall back to reading the whole payload, and free it when the stream is closed
+    data = SDL_GetClipboardData(mime_type, &size);
+    if (!data) {
+        SDL_SetError("No clipboard data available for %s", mime_type);
+        return NULL;
+    }
+
+    io = SDL_IOFromConstMem(data, size);
+    if (!io) {
+        SDL_free(data);
+        return NULL;
+    }
+    if (!SDL_SetPointerPropertyWithCleanup(SDL_GetIOProperties(io), "SDL.internal.clipboard.data", data, SDL_CleanupClipboardDataIO, NULL)) {
+        SDL_CloseIO(io);
+        return NULL;
+    }
+    return io;
+}
+
 bool SDL_HasInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type)
 {
     size_t i;
@@ -35,6 +35,7 @@ extern void SDL_CancelClipboardData(Uint32 sequence);
 // Call the clipboard callback for application data
 extern void *SDL_GetInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t *size);
 extern bool SDL_HasInternalClipboardData(SDL_VideoDevice *_this, const char *mime_type);
+extern SDL_IOStream *SDL_OpenInternalClipboardDataIO(SDL_VideoDevice *_this, const char *mime_type);
 
 // General purpose clipboard text callback
 const void * SDLCALL SDL_ClipboardTextCallback(void *userdata, const char *mime_type, size_t *size);
@@ -923,20 +923,70 @@ static bool SDL_EGL_PrivateChooseConfig(SDL_VideoDevice *_this, bool set_config_
     return true;
 }
 
+static void SDL_EGL_GetConfigKey(SDL_VideoDevice *_this, SDL_EGL_ConfigKey *key)
+{
+    SDL_zerop(key); // so padding compares equal too
+    key->red_size = _this->gl_config.red_size;
+    key->green_size = _this->gl_config.green_size;
+    key->blue_size = _this->gl_config.blue_size;
+    key->alpha_size = _this->gl_config.alpha_size;
+    key->buffer_size = _this->gl_config.buffer_size;
+    key->depth_size = _this->gl_config.depth_size;
+    key->stencil_size = _this->gl_config.stencil_size;
+    key->multisamplebuffers = _this->gl_config.multisamplebuffers;
+    key->multisamplesamples = _this->gl_config.multisamplesamples;
+    key->floatbuffers = _this->gl_config.floatbuffers;
+    key->profile_mask = _this->gl_config.profile_mask;
+    key->major_version = _this->gl_config.major_version;
+    key->surfacetype = _this->egl_data->egl_surfacetype;
+    key->required_visual_id = _this->egl_data->egl_required_visual_id;
+    key->is_offscreen = _this->egl_data->is_offscreen;
+}
+
+static void SDL_EGL_CacheConfig(SDL_VideoDevice *_this, const SDL_EGL_ConfigKey *key)
+{
+    SDL_EGL_VideoData *egl_data = _this->egl_data;
+
+    // Drop the oldest entry when full
+    if (egl_data->config_cache_count == SDL_EGL_CONFIG_CACHE_SIZE) {
+        SDL_memmove(&egl_data->config_cache[0], &egl_data->config_cache[1], (SDL_EGL_CONFIG_CACHE_SIZE - 1) * sizeof(egl_data->config_cache[0]));
+        --egl_data->config_cache_count;
+    }
+    egl_data->config_cache[egl_data->config_cache_count].key = *key;
+    egl_data->config_cache[egl_data->config_cache_count].config = egl_data->egl_config;
+    ++egl_data->config_cache_count;
+}
+
 bool SDL_EGL_ChooseConfig(SDL_VideoDevice *_this)
 {
+    SDL_EGL_ConfigKey key;
+    int i;
+
     if (!_this->egl_data) {
         return SDL_SetError("EGL not initialized");
     }
 
+    /* Enumerating and scoring every config is slow on some drivers, and the
+       attributes rarely change between windows, so reuse earlier choices. */
+    SDL_EGL_GetConfigKey(_this, &key);
+    for (i = 0; i < _this->egl_data->config_cache_count; ++i) {
+        if (SDL_memcmp(&_this->egl_data->config_cache[i].key, &key, sizeof(key)) == 0) {
+            _this->egl_data->egl_config = _this->egl_data->config_cache[i].config;
+            _this->egl_data->eglBindAPI(key.profile_mask == SDL_GL_CONTEXT_PROFILE_ES ? EGL_OPENGL_ES_API : EGL_OPENGL_API);
+            return true;
+        }
+    }
+
     // Try with EGL_CONFIG_CAVEAT set to EGL_NONE, to avoid any EGL_SLOW_CONFIG or EGL_NON_CONFORMANT_CONFIG
     if (SDL_EGL_PrivateChooseConfig(_this, true)) {
+        SDL_EGL_CacheConfig(_this, &key);
         return true;
     }
 
     // Fallback with all configs
     if (SDL_EGL_PrivateChooseConfig(_this, false)) {
         SDL_Log("SDL_EGL_ChooseConfig: found a slow EGL config");
+        SDL_EGL_CacheConfig(_this, &key);
         return true;
     }
 
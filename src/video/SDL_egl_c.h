@@ -62,6 +62,35 @@ typedef EGLint (EGLAPIENTRYP PFNEGLDUPNATIVEFENCEFDANDROIDPROC) (EGLDisplay dpy,
 typedef EGLint (EGLAPIENTRYP PFNEGLWAITSYNCKHRPROC) (EGLDisplay dpy, EGLSyncKHR sync, EGLint flags);
 typedef EGLint (EGLAPIENTRYP PFNEGLCLIENTWAITSYNCKHRPROC) (EGLDisplay dpy, EGLSyncKHR sync, EGLint flags, EGLTimeKHR timeout);
 
+// The most recently chosen EGL configs that are kept, see SDL_EGL_ChooseConfig()
+#define SDL_EGL_CONFIG_CACHE_SIZE 4
+
+// Everything that SDL_EGL_ChooseConfig() bases its choice on
+typedef struct SDL_EGL_ConfigKey
+{
+    int red_size;
+    int green_size;
+    int blue_size;
+    int alpha_size;
+    int buffer_size;
+    int depth_size;
+    int stencil_size;
+    int multisamplebuffers;
+    int multisamplesamples;
+    int floatbuffers;
+    int profile_mask;
+    int major_version;
+    int surfacetype;
+    EGLint required_visual_id;
+    bool is_offscreen;
+} SDL_EGL_ConfigKey;
+
+typedef struct SDL_EGL_ConfigCacheEntry
+{
+    SDL_EGL_ConfigKey key;
+    EGLConfig config;
+} SDL_EGL_ConfigCacheEntry;
+
 typedef struct SDL_EGL_VideoData
 {
     SDL_SharedObject *opengl_dll_handle;
@@ -75,6 +104,9 @@ typedef struct SDL_EGL_VideoData
     bool is_offscreen; // whether EGL display was offscreen
     EGLenum apitype;       // EGL_OPENGL_ES_API, EGL_OPENGL_API, etc
 
+    SDL_EGL_ConfigCacheEntry config_cache[SDL_EGL_CONFIG_CACHE_SIZE];
+    int config_cache_count;
+
     PFNEGLGETDISPLAYPROC eglGetDisplay;
     PFNEGLINITIALIZEPROC eglInitialize;
     PFNEGLTERMINATEPROC eglTerminate;
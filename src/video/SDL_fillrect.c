@@ -22,6 +22,40 @@
 
 #include "SDL_surface_c.h"
 
+#include "../thread/SDL_jobs_c.h"
+
+/* Fills larger than this use non-temporal stores where available, so clearing a huge
+   surface doesn't evict everything else from the cache on its way to memory. */
+#define SDL_FILL_STREAM_MIN_BYTES (2 * 1024 * 1024)
+
+// Fills larger than this may be split into bands of rows and run on the job threads
+#define SDL_PARALLEL_FILL_MIN_BYTES     (8 * 1024 * 1024)
+#define SDL_PARALLEL_FILL_MIN_BAND_ROWS 16
+#define SDL_PARALLEL_FILL_MAX_BANDS     16
+
+#if defined(SDL_SSE_INTRINSICS) || defined(SDL_AVX2_INTRINSICS) || defined(SDL_NEON_INTRINSICS)
+// Write count pixels one at a time, for the unaligned start and the end of a row
+static SDL_INLINE Uint8 *SDL_FillPixels(Uint8 *p, Uint32 color, int count, int bpp)
+{
+    switch (bpp) {
+    case 1:
+        SDL_memset(p, (Uint8)color, count);
+        break;
+    case 2:
+        for (int i = 0; i < count; ++i) {
+            ((Uint16 *)p)[i] = (Uint16)color;
+        }
+        break;
+    default:
+        for (int i = 0; i < count; ++i) {
+            ((Uint32 *)p)[i] = color;
+        }
+        break;
+    }
+    return p + (size_t)count * bpp;
+}
+#endif
+
 #ifdef SDL_SSE_INTRINSICS
 /* *INDENT-OFF* */ // clang-format off
 
@@ -44,21 +78,36 @@
 #endif
 
 #define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
+    if (stream) { \
+        for (i = n / 64; i--;) { \
+            _mm_stream_ps((float *)(p+0), c128); \
+            _mm_stream_ps((float *)(p+16), c128); \
+            _mm_stream_ps((float *)(p+32), c128); \
+            _mm_stream_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
+    } else { \
+        for (i = n / 64; i--;) { \
+            _mm_store_ps((float *)(p+0), c128); \
+            _mm_store_ps((float *)(p+16), c128); \
+            _mm_store_ps((float *)(p+32), c128); \
+            _mm_store_ps((float *)(p+48), c128); \
+            p += 64; \
+        } \
     }
 
-#define SSE_END
+// Non-temporal stores are weakly ordered, make them visible before anyone reads the pixels
+#define SSE_END \
+    if (stream) { \
+        _mm_sfence(); \
+    }
 
 #define DEFINE_SSE_FILLRECT(bpp, type) \
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
 { \
     int i, n; \
     Uint8 *p = NULL; \
+    const bool stream = ((size_t)w * h * (bpp) >= SDL_FILL_STREAM_MIN_BYTES); \
   \
     /* If the number of bytes per row is equal to the pitch, treat */ \
     /* all rows as one long continuous row (for better performance) */ \
@@ -102,6 +151,7 @@ static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, in
 static void SDL_TARGETING("sse") SDL_FillSurfaceRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int i, n;
+    const bool stream = ((size_t)w * h >= SDL_FILL_STREAM_MIN_BYTES);
 
     SSE_BEGIN;
     while (h--) {
@@ -133,6 +183,127 @@ DEFINE_SSE_FILLRECT(4, Uint32)
 /* *INDENT-ON* */ // clang-format on
 #endif            // __SSE__
 
+#ifdef SDL_AVX2_INTRINSICS
+
+/* The color is repeated across all 32 bits for every pixel size, so once a row is aligned to
+   its pixel size, wide stores at any offset write whole pixels with the right color. */
+static void SDL_TARGETING("avx2") SDL_FillSurfaceRectAVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp)
+{
+    const __m256i c256 = _mm256_set1_epi32((int)color);
+    const bool stream = ((size_t)w * h * bpp >= SDL_FILL_STREAM_MIN_BYTES);
+
+    if (w * bpp == pitch) {
+        w = w * h;
+        h = 1;
+    }
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int n = w * bpp;
+
+        if (n >= 128 && ((uintptr_t)p & (bpp - 1)) == 0) {
+            const int adjust = (int)((32 - ((uintptr_t)p & 31)) & 31);
+            p = SDL_FillPixels(p, color, adjust / bpp, bpp);
+            n -= adjust;
+
+            if (stream) {
+                for (; n >= 128; n -= 128, p += 128) {
+                    _mm256_stream_si256((__m256i *)(p + 0), c256);
+                    _mm256_stream_si256((__m256i *)(p + 32), c256);
+                    _mm256_stream_si256((__m256i *)(p + 64), c256);
+                    _mm256_stream_si256((__m256i *)(p + 96), c256);
+                }
+            } else {
+                for (; n >= 128; n -= 128, p += 128) {
+                    _mm256_store_si256((__m256i *)(p + 0), c256);
+                    _mm256_store_si256((__m256i *)(p + 32), c256);
+                    _mm256_store_si256((__m256i *)(p + 64), c256);
+                    _mm256_store_si256((__m256i *)(p + 96), c256);
+                }
+            }
+            for (; n >= 32; n -= 32, p += 32) {
+                _mm256_store_si256((__m256i *)p, c256);
+            }
+        }
+        SDL_FillPixels(p, color, n / bpp, bpp);
+        pixels += pitch;
+    }
+
+    if (stream) {
+        _mm_sfence();
+    }
+}
+
+static void SDL_FillSurfaceRect1AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectAVX2(pixels, pitch, color, w, h, 1);
+}
+
+static void SDL_FillSurfaceRect2AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectAVX2(pixels, pitch, color, w, h, 2);
+}
+
+static void SDL_FillSurfaceRect4AVX2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectAVX2(pixels, pitch, color, w, h, 4);
+}
+
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+
+// NEON has no non-temporal store intrinsics, but wide stores still run close to memory bandwidth
+static void SDL_FillSurfaceRectNEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp)
+{
+    const uint8x16_t c128 = vreinterpretq_u8_u32(vdupq_n_u32(color));
+
+    if (w * bpp == pitch) {
+        w = w * h;
+        h = 1;
+    }
+
+    while (h--) {
+        Uint8 *p = pixels;
+        int n = w * bpp;
+
+        if (n >= 64 && ((uintptr_t)p & (bpp - 1)) == 0) {
+            const int adjust = (int)((16 - ((uintptr_t)p & 15)) & 15);
+            p = SDL_FillPixels(p, color, adjust / bpp, bpp);
+            n -= adjust;
+
+            for (; n >= 64; n -= 64, p += 64) {
+                vst1q_u8(p + 0, c128);
+                vst1q_u8(p + 16, c128);
+                vst1q_u8(p + 32, c128);
+                vst1q_u8(p + 48, c128);
+            }
+            for (; n >= 16; n -= 16, p += 16) {
+                vst1q_u8(p, c128);
+            }
+        }
+        SDL_FillPixels(p, color, n / bpp, bpp);
+        pixels += pitch;
+    }
+}
+
+static void SDL_FillSurfaceRect1NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 1);
+}
+
+static void SDL_FillSurfaceRect2NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 2);
+}
+
+static void SDL_FillSurfaceRect4NEON(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
+{
+    SDL_FillSurfaceRectNEON(pixels, pitch, color, w, h, 4);
+}
+
+#endif // SDL_NEON_INTRINSICS
+
 static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
     int n;
@@ -233,6 +404,64 @@ static void SDL_FillSurfaceRect4(Uint8 *pixels, int pitch, Uint32 color, int w,
     }
 }
 
+typedef void (*SDL_FillRectFunc)(Uint8 *pixels, int pitch, Uint32 color, int w, int h);
+
+typedef struct SDL_FillBand
+{
+    SDL_FillRectFunc fill;
+    Uint8 *pixels;
+    int pitch;
+    Uint32 color;
+    int w;
+    int h;
+} SDL_FillBand;
+
+static void SDLCALL SDL_RunFillBand(void *userdata)
+{
+    SDL_FillBand *band = (SDL_FillBand *)userdata;
+    band->fill(band->pixels, band->pitch, band->color, band->w, band->h);
+}
+
+/* Split a very large fill into bands of rows and run them on the job threads.
+   This is what SDL_ClearSurface() and the software renderer's clears go through for big surfaces. */
+static bool SDL_FillSurfaceRectParallel(SDL_FillRectFunc fill, Uint8 *pixels, int pitch, Uint32 color, int w, int h, int bpp)
+{
+    const size_t size = (size_t)w * h * bpp;
+
+    if (size < SDL_PARALLEL_FILL_MIN_BYTES) {
+        return false;
+    }
+    if (!SDL_GetHintBoolean(SDL_HINT_SURFACE_PARALLEL_BLIT, false)) {
+        return false;
+    }
+
+    // Keep each band big enough that it still takes the non-temporal path
+    int num_bands = SDL_min(SDL_GetNumLogicalCPUCores(), h / SDL_PARALLEL_FILL_MIN_BAND_ROWS);
+    num_bands = (int)SDL_min((size_t)num_bands, size / SDL_FILL_STREAM_MIN_BYTES);
+    num_bands = SDL_min(num_bands, SDL_PARALLEL_FILL_MAX_BANDS);
+    if (num_bands < 2) {
+        return false;
+    }
+
+    SDL_FillBand bands[SDL_PARALLEL_FILL_MAX_BANDS];
+    void *userdata[SDL_PARALLEL_FILL_MAX_BANDS];
+    for (int i = 0; i < num_bands; ++i) {
+        const int y = (h * i) / num_bands;
+        SDL_FillBand *band = &bands[i];
+
+        band->fill = fill;
+        band->pixels = pixels + (size_t)y * pitch;
+        band->pitch = pitch;
+        band->color = color;
+        band->w = w;
+        band->h = ((h * (i + 1)) / num_bands) - y;
+        userdata[i] = band;
+    }
+
+    SDL_RunJobsAndWait(SDL_RunFillBand, userdata, num_bands);
+    return true;
+}
+
 /*
  * This function performs a fast fill of the given rectangle with 'color'
  */
@@ -259,7 +488,7 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
     SDL_Rect clipped;
     Uint8 *pixels;
     const SDL_Rect *rect;
-    void (*fill_function)(Uint8 * pixels, int pitch, Uint32 color, int w, int h) = NULL;
+    SDL_FillRectFunc fill_function = NULL;
     int i;
 
     if (!SDL_SurfaceValid(dst)) {
@@ -280,6 +509,8 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         return SDL_InvalidParamError("SDL_FillSurfaceRects(): rects");
     }
 
+    SDL_MarkSurfaceModified(dst);
+
     /* This function doesn't usually work on surfaces < 8 bpp
      * Except: support for 4bits, when filling full size.
      */
@@ -303,6 +534,18 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         {
             color |= (color << 8);
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect1AVX2;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect1NEON;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect1SSE;
@@ -316,6 +559,18 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         case 2:
         {
             color |= (color << 16);
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect2AVX2;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect2NEON;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect2SSE;
@@ -335,6 +590,18 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
 
         case 4:
         {
+#ifdef SDL_AVX2_INTRINSICS
+            if (SDL_HasAVX2()) {
+                fill_function = SDL_FillSurfaceRect4AVX2;
+                break;
+            }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+            if (SDL_HasNEON()) {
+                fill_function = SDL_FillSurfaceRect4NEON;
+                break;
+            }
+#endif
 #ifdef SDL_SSE_INTRINSICS
             if (SDL_HasSSE()) {
                 fill_function = SDL_FillSurfaceRect4SSE;
@@ -361,7 +628,9 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         pixels = (Uint8 *)dst->pixels + rect->y * dst->pitch +
                  rect->x * SDL_BYTESPERPIXEL(dst->format);
 
-        fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        if (!SDL_FillSurfaceRectParallel(fill_function, pixels, dst->pitch, color, rect->w, rect->h, SDL_BYTESPERPIXEL(dst->format))) {
+            fill_function(pixels, dst->pitch, color, rect->w, rect->h);
+        }
     }
 
     // We're done!
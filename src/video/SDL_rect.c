@@ -84,6 +84,9 @@ bool SDL_GetSpanEnclosingRect(int width, int height,
 #define CODE_LEFT   4
 #define CODE_RIGHT  8
 
+static int GetIntersectingRectsSIMD(const SDL_Rect *rects, int count, const SDL_Rect *clip, int *indices, int *processed);
+static int GetIntersectingRectsFloatSIMD(const SDL_FRect *rects, int count, const SDL_FRect *clip, int *indices, int *processed);
+
 // Same code twice, for float and int versions...
 #define RECTTYPE                 SDL_Rect
 #define POINTTYPE                SDL_Point
@@ -98,6 +101,9 @@ bool SDL_GetSpanEnclosingRect(int width, int height,
 #define SDL_UNIONRECT            SDL_GetRectUnion
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPoints
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersection
+#define SDL_RECTSINTERSECT       SDL_RectsIntersect
+#define SDL_GETINTERSECTINGRECTS SDL_GetIntersectingRects
+#define GETINTERSECTINGRECTS_SIMD GetIntersectingRectsSIMD
 #include "SDL_rect_impl.h"
 
 #define RECTTYPE                 SDL_FRect
@@ -113,4 +119,120 @@ bool SDL_GetSpanEnclosingRect(int width, int height,
 #define SDL_UNIONRECT            SDL_GetRectUnionFloat
 #define SDL_ENCLOSEPOINTS        SDL_GetRectEnclosingPointsFloat
 #define SDL_INTERSECTRECTANDLINE SDL_GetRectAndLineIntersectionFloat
+#define SDL_RECTSINTERSECT       SDL_RectsIntersectFloat
+#define SDL_GETINTERSECTINGRECTS SDL_GetIntersectingRectsFloat
+#define GETINTERSECTINGRECTS_SIMD GetIntersectingRectsFloatSIMD
 #include "SDL_rect_impl.h"
+
+/* The SIMD versions test one rect per iteration: the left/top edges of each
+   rect and the clip are compared against the other's right/bottom edges in a
+   single vector compare, and the index is always stored but only kept if the
+   rect intersects, so there are no unpredictable branches. */
+
+#ifdef SDL_SSE2_INTRINSICS
+static int SDL_TARGETING("sse2") GetIntersectingRectsSSE2(const SDL_Rect *rects, int count, const SDL_Rect *clip, int *indices)
+{
+    const __m128i c = _mm_loadu_si128((const __m128i *)clip);
+    const __m128i c2 = _mm_add_epi32(c, _mm_srli_si128(c, 8));
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = _mm_setr_epi32(SDL_MIN_SINT32 / 2, SDL_MIN_SINT32 / 2, SDL_MIN_SINT32, SDL_MIN_SINT32);
+    const __m128i hi = _mm_set1_epi32(SDL_MAX_SINT32 / 2);
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        const __m128i r = _mm_loadu_si128((const __m128i *)&rects[i]);
+        int ok;
+
+        indices[n] = i;
+
+        // Rects that could overflow 32-bit math take the scalar path
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi32(r, lo), _mm_cmplt_epi32(r, hi))) != 0xFFFF) {
+            n += SDL_RectsIntersect(&rects[i], clip);
+            continue;
+        }
+
+        const __m128i r2 = _mm_add_epi32(r, _mm_srli_si128(r, 8));
+        const __m128i mins = _mm_unpacklo_epi64(r, c);   // x, y, clip x, clip y
+        const __m128i maxs = _mm_unpacklo_epi64(c2, r2); // clip x2, clip y2, x2, y2
+        ok = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(maxs, mins)));
+        ok |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(r, zero))) << 4; // w > 0, h > 0
+        n += ((ok & 0xCF) == 0xCF);
+    }
+    return n;
+}
+#endif
+
+#ifdef SDL_SSE_INTRINSICS
+static int SDL_TARGETING("sse") GetIntersectingRectsFloatSSE(const SDL_FRect *rects, int count, const SDL_FRect *clip, int *indices)
+{
+    const __m128 c = _mm_loadu_ps(&clip->x);
+    const __m128 c2 = _mm_add_ps(c, _mm_movehl_ps(c, c));
+    const __m128 zero = _mm_setzero_ps();
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        const __m128 r = _mm_loadu_ps(&rects[i].x);
+        const __m128 r2 = _mm_add_ps(r, _mm_movehl_ps(r, r));
+        const __m128 mins = _mm_movelh_ps(r, c);   // x, y, clip x, clip y
+        const __m128 maxs = _mm_movelh_ps(c2, r2); // clip x2, clip y2, x2, y2
+        int ok = _mm_movemask_ps(_mm_cmpge_ps(maxs, mins));
+        ok |= _mm_movemask_ps(_mm_cmpge_ps(r, zero)) << 4; // w >= 0, h >= 0
+
+        indices[n] = i;
+        n += ((ok & 0xCF) == 0xCF);
+    }
+    return n;
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static int GetIntersectingRectsFloatNEON(const SDL_FRect *rects, int count, const SDL_FRect *clip, int *indices)
+{
+    const float32x4_t c = vld1q_f32(&clip->x);
+    const float32x2_t c2 = vadd_f32(vget_low_f32(c), vget_high_f32(c));
+    const float32x2_t zero = vdup_n_f32(0.0f);
+    int i, n = 0;
+
+    for (i = 0; i < count; ++i) {
+        const float32x4_t r = vld1q_f32(&rects[i].x);
+        const float32x2_t r2 = vadd_f32(vget_low_f32(r), vget_high_f32(r));
+        uint32x2_t ok = vcge_f32(c2, vget_low_f32(r));     // clip x2 >= x, clip y2 >= y
+        ok = vand_u32(ok, vcge_f32(r2, vget_low_f32(c)));  // x2 >= clip x, y2 >= clip y
+        ok = vand_u32(ok, vcge_f32(vget_high_f32(r), zero)); // w >= 0, h >= 0
+
+        indices[n] = i;
+        n += (vget_lane_u32(ok, 0) & vget_lane_u32(ok, 1)) & 1;
+    }
+    return n;
+}
+#endif
+
+static int GetIntersectingRectsSIMD(const SDL_Rect *rects, int count, const SDL_Rect *clip, int *indices, int *processed)
+{
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        *processed = count;
+        return GetIntersectingRectsSSE2(rects, count, clip, indices);
+    }
+#endif
+    *processed = 0;
+    return 0;
+}
+
+static int GetIntersectingRectsFloatSIMD(const SDL_FRect *rects, int count, const SDL_FRect *clip, int *indices, int *processed)
+{
+#ifdef SDL_SSE_INTRINSICS
+    if (SDL_HasSSE()) {
+        *processed = count;
+        return GetIntersectingRectsFloatSSE(rects, count, clip, indices);
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        *processed = count;
+        return GetIntersectingRectsFloatNEON(rects, count, clip, indices);
+    }
+#endif
+    *processed = 0;
+    return 0;
+}
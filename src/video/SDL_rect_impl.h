@@ -450,6 +450,65 @@ bool SDL_INTERSECTRECTANDLINE(const RECTTYPE *rect, SCALARTYPE *X1, SCALARTYPE *
     return true;
 }
 
+// SDL_HASINTERSECTION() without the parameter checks, using wider math instead of the overflow check
+static bool SDL_RECTSINTERSECT(const RECTTYPE *A, const RECTTYPE *B)
+{
+    BIGSCALARTYPE Amin, Amax, Bmin, Bmax;
+
+    if (SDL_RECTEMPTY(A)) {
+        return false;
+    }
+
+    Amin = A->x;
+    Amax = Amin + A->w;
+    Bmin = B->x;
+    Bmax = Bmin + B->w;
+    if ((SDL_min(Amax, Bmax) - ENCLOSEPOINTS_EPSILON) < SDL_max(Amin, Bmin)) {
+        return false;
+    }
+
+    Amin = A->y;
+    Amax = Amin + A->h;
+    Bmin = B->y;
+    Bmax = Bmin + B->h;
+    if ((SDL_min(Amax, Bmax) - ENCLOSEPOINTS_EPSILON) < SDL_max(Amin, Bmin)) {
+        return false;
+    }
+    return true;
+}
+
+int SDL_GETINTERSECTINGRECTS(const RECTTYPE *rects, int count, const RECTTYPE *clip, int *indices)
+{
+    int i = 0;
+    int n = 0;
+
+    if (!rects && count > 0) {
+        SDL_InvalidParamError("rects");
+        return -1;
+    } else if (count < 0) {
+        SDL_InvalidParamError("count");
+        return -1;
+    } else if (!clip) {
+        SDL_InvalidParamError("clip");
+        return -1;
+    } else if (!indices) {
+        SDL_InvalidParamError("indices");
+        return -1;
+    } else if (SDL_RECT_CAN_OVERFLOW(clip)) {
+        SDL_SetError("Potential rect math overflow");
+        return -1;
+    } else if (SDL_RECTEMPTY(clip)) {
+        return 0;
+    }
+
+    n = GETINTERSECTINGRECTS_SIMD(rects, count, clip, indices, &i);
+    for (; i < count; ++i) {
+        indices[n] = i;
+        n += SDL_RECTSINTERSECT(&rects[i], clip);
+    }
+    return n;
+}
+
 #undef RECTTYPE
 #undef POINTTYPE
 #undef SCALARTYPE
@@ -463,3 +522,6 @@ bool SDL_INTERSECTRECTANDLINE(const RECTTYPE *rect, SCALARTYPE *X1, SCALARTYPE *
 #undef SDL_UNIONRECT
 #undef SDL_ENCLOSEPOINTS
 #undef SDL_INTERSECTRECTANDLINE
+#undef SDL_RECTSINTERSECT
+#undef SDL_GETINTERSECTINGRECTS
+#undef GETINTERSECTINGRECTS_SIMD
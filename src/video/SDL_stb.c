@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_stb_c.h"
+#include "../thread/SDL_jobs_c.h"
 
 
 // We currently only support JPEG, but we could add other image formats if we wanted
@@ -56,6 +57,7 @@
 #define STBI_NO_ZLIB
 #define STBI_NO_STDIO
 #define STBI_ASSERT SDL_assert
+#define STBI_PARSE_ENTROPY_CODED_DATA SDL_STB_ParseEntropyCodedData
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
@@ -63,7 +65,209 @@
 #endif
 
 #ifdef SDL_HAVE_STB
-static bool SDL_ConvertPixels_MJPG_to_NV12(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch)
+// Baseline JPEG images with restart markers, which is what most MJPG cameras send,
+// can have their restart intervals decoded in parallel when SDL_HINT_SURFACE_PARALLEL_BLIT is enabled
+#define SDL_STB_PARALLEL_MIN_PIXELS     (512 * 512)
+#define SDL_STB_PARALLEL_MAX_JOBS       16
+
+typedef struct SDL_STBRestartJob
+{
+    stbi__jpeg *z;                  // private copy of the decoder state
+    const stbi_uc *const *starts;   // start of the entropy coded data for each interval
+    const stbi_uc *const *ends;     // end of the entropy coded data for each interval
+    int first;
+    int count;
+    int num_mcus;
+    bool result;
+} SDL_STBRestartJob;
+
+// Find the entropy coded data of each restart interval in the scan, and the marker that follows the scan
+static bool SDL_STB_FindRestartIntervals(const stbi_uc *data, const stbi_uc *end, const stbi_uc **starts, const stbi_uc **ends, int num_intervals, const stbi_uc **marker)
+{
+    const stbi_uc *p = data;
+    int found = 0;
+
+    starts[0] = data;
+    while (p < end) {
+        const stbi_uc *ff;
+
+        if (*p != 0xff) {
+            ++p;
+            continue;
+        }
+
+        // Skip fill bytes, then see what kind of marker this is
+        ff = p++;
+        while (p < end && *p == 0xff) {
+            ++p;
+        }
+        if (p == end) {
+            break;
+        }
+        if (*p == 0x00) {
+            // A stuffed zero byte in the entropy coded data
+            ++p;
+            continue;
+        }
+
+        ends[found++] = ff;
+        if (found == num_intervals || !STBI__RESTART(*p) || (*p & 7) != ((found - 1) & 7)) {
+            if (found != num_intervals) {
+                return false;
+            }
+            *marker = p;
+            return true;
+        }
+        starts[found] = ++p;
+    }
+    return false;
+}
+
+static bool SDL_STB_DecodeRestartInterval(stbi__jpeg *z, int mcu, int num_mcus)
+{
+    STBI_SIMD_ALIGN(short, data[64]);
+    const int last = SDL_min(mcu + z->restart_interval, num_mcus);
+
+    stbi__jpeg_reset(z);
+
+    if (z->scan_n == 1) {
+        // Non-interleaved data, every block is an MCU
+        const int n = z->order[0];
+        const int w = (z->img_comp[n].x + 7) >> 3;
+        const int ha = z->img_comp[n].ha;
+
+        for (; mcu < last; ++mcu) {
+            const int i = mcu % w;
+            const int j = mcu / w;
+            if (!stbi__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) {
+                return false;
+            }
+            z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * j * 8 + i * 8, z->img_comp[n].w2, data);
+        }
+    } else {
+        for (; mcu < last; ++mcu) {
+            const int i = mcu % z->img_mcu_x;
+            const int j = mcu / z->img_mcu_x;
+            int k, x, y;
+
+            for (k = 0; k < z->scan_n; ++k) {
+                const int n = z->order[k];
+                const int ha = z->img_comp[n].ha;
+                for (y = 0; y < z->img_comp[n].v; ++y) {
+                    for (x = 0; x < z->img_comp[n].h; ++x) {
+                        const int x2 = (i * z->img_comp[n].h + x) * 8;
+                        const int y2 = (j * z->img_comp[n].v + y) * 8;
+                        if (!stbi__jpeg_decode_block(z, data, z->huff_dc + z->img_comp[n].hd, z->huff_ac + ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) {
+                            return false;
+                        }
+                        z->idct_block_kernel(z->img_comp[n].data + z->img_comp[n].w2 * y2 + x2, z->img_comp[n].w2, data);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void SDLCALL SDL_STB_RunRestartJob(void *userdata)
+{
+    SDL_STBRestartJob *job = (SDL_STBRestartJob *)userdata;
+    stbi__jpeg *z = job->z;
+    stbi__context s;
+    int i;
+
+    job->result = true;
+    for (i = job->first; i < job->first + job->count; ++i) {
+        stbi__start_mem(&s, job->starts[i], (int)(job->ends[i] - job->starts[i]));
+        z->s = &s;
+        if (!SDL_STB_DecodeRestartInterval(z, i * z->restart_interval, job->num_mcus)) {
+            job->result = false;
+            break;
+        }
+    }
+}
+
+static int SDL_STB_ParseEntropyCodedData(stbi__jpeg *z)
+{
+    SDL_STBRestartJob jobs[SDL_STB_PARALLEL_MAX_JOBS];
+    void *userdata[SDL_STB_PARALLEL_MAX_JOBS];
+    stbi__context *s = z->s;
+    const stbi_uc **starts = NULL;
+    const stbi_uc *marker = NULL;
+    stbi__jpeg *copies = NULL;
+    int num_mcus, num_intervals, num_jobs, i;
+    bool result = true;
+
+    if (z->progressive || !z->restart_interval || s->read_from_callbacks ||
+        (Sint64)s->img_x * s->img_y < SDL_STB_PARALLEL_MIN_PIXELS ||
+        !SDL_GetHintBoolean(SDL_HINT_SURFACE_PARALLEL_BLIT, false)) {
+        return stbi__parse_entropy_coded_data(z);
+    }
+
+    if (z->scan_n == 1) {
+        const int n = z->order[0];
+        num_mcus = ((z->img_comp[n].x + 7) >> 3) * ((z->img_comp[n].y + 7) >> 3);
+    } else {
+        num_mcus = z->img_mcu_x * z->img_mcu_y;
+    }
+    num_intervals = (num_mcus + z->restart_interval - 1) / z->restart_interval;
+    num_jobs = SDL_min(SDL_GetNumLogicalCPUCores(), num_intervals);
+    num_jobs = SDL_min(num_jobs, SDL_STB_PARALLEL_MAX_JOBS);
+    if (num_jobs < 2) {
+        return stbi__parse_entropy_coded_data(z);
+    }
+
+    // The intervals can only be handed out if they all have their restart markers where we expect them
+    starts = (const stbi_uc **)SDL_malloc(2 * num_intervals * sizeof(*starts));
+    if (!starts ||
+        !SDL_STB_FindRestartIntervals(s->img_buffer, s->img_buffer_end, starts, starts + num_intervals, num_intervals, &marker)) {
+        SDL_free(starts);
+        return stbi__parse_entropy_coded_data(z);
+    }
+
+    copies = (stbi__jpeg *)SDL_malloc(num_jobs * sizeof(*copies));
+    if (!copies) {
+        SDL_free(starts);
+        return stbi__parse_entropy_coded_data(z);
+    }
+
+    for (i = 0; i < num_jobs; ++i) {
+        SDL_STBRestartJob *job = &jobs[i];
+        const int first = (int)((Sint64)num_intervals * i / num_jobs);
+
+        copies[i] = *z;
+        job->z = &copies[i];
+        job->starts = starts;
+        job->ends = starts + num_intervals;
+        job->first = first;
+        job->count = (int)((Sint64)num_intervals * (i + 1) / num_jobs) - first;
+        job->num_mcus = num_mcus;
+        userdata[i] = job;
+    }
+    SDL_RunJobsAndWait(SDL_STB_RunRestartJob, userdata, num_jobs);
+
+    // The first job runs on this thread, so any error it hit is already set
+    for (i = 0; i < num_jobs; ++i) {
+        if (!jobs[i].result) {
+            if (i > 0) {
+                SDL_SetError("JPEG decoding failed on a job thread");
+            }
+            result = false;
+            break;
+        }
+    }
+    SDL_free(copies);
+    SDL_free(starts);
+
+    // Leave the stream just past the marker that ended the scan, as the serial decoder does
+    stbi__jpeg_reset(z);
+    z->marker = *marker;
+    s->img_buffer = (stbi_uc *)marker + 1;
+    return result;
+}
+
+// Decode straight into the planes of a 4:2:0 YUV format, skipping the RGB conversion
+static bool SDL_ConvertPixels_MJPG_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch)
 {
     int w = 0, h = 0, format = 0;
     stbi__context s;
@@ -75,14 +279,40 @@ static bool SDL_ConvertPixels_MJPG_to_NV12(int width, int height, const void *sr
     ri.channel_order = STBI_ORDER_RGB;
     ri.num_channels = 0;
 
-    stbi__nv12 nv12;
-    nv12.w = width;
-    nv12.h = height;
-    nv12.pitch = dst_pitch;
-    nv12.y = (stbi_uc *)dst;
-    nv12.uv = nv12.y + (nv12.h * nv12.pitch);
+    stbi__yuv yuv;
+    yuv.w = width;
+    yuv.h = height;
+    yuv.y_pitch = dst_pitch;
+    yuv.y = (stbi_uc *)dst;
+    switch (dst_format) {
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        yuv.uv_pitch = dst_pitch;
+        yuv.uv_step = 2;
+        yuv.u = yuv.y + ((size_t)height * dst_pitch);
+        yuv.v = yuv.u + 1;
+        if (dst_format == SDL_PIXELFORMAT_NV21) {
+            yuv.v = yuv.u;
+            yuv.u = yuv.v + 1;
+        }
+        break;
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_YV12:
+        yuv.uv_pitch = (dst_pitch + 1) / 2;
+        yuv.uv_step = 1;
+        yuv.u = yuv.y + ((size_t)height * dst_pitch);
+        yuv.v = yuv.u + ((size_t)((height + 1) / 2) * yuv.uv_pitch);
+        if (dst_format == SDL_PIXELFORMAT_YV12) {
+            stbi_uc *v = yuv.u;
+            yuv.u = yuv.v;
+            yuv.v = v;
+        }
+        break;
+    default:
+        return SDL_SetError("Unsupported YUV format: %s", SDL_GetPixelFormatName(dst_format));
+    }
 
-    void *pixels = stbi__jpeg_load(&s, &w, &h, &format, 4, &nv12, &ri);
+    void *pixels = stbi__jpeg_load(&s, &w, &h, &format, 4, &yuv, &ri);
     if (!pixels) {
         return false;
     }
@@ -95,8 +325,31 @@ bool SDL_ConvertPixels_STB(int width, int height,
                            SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
 {
 #ifdef SDL_HAVE_STB
-    if (src_format == SDL_PIXELFORMAT_MJPG && dst_format == SDL_PIXELFORMAT_NV12) {
-        return SDL_ConvertPixels_MJPG_to_NV12(width, height, src, src_pitch, dst, dst_pitch);
+    if (src_format == SDL_PIXELFORMAT_MJPG) {
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_NV12:
+        case SDL_PIXELFORMAT_NV21:
+        case SDL_PIXELFORMAT_IYUV:
+        case SDL_PIXELFORMAT_YV12:
+            return SDL_ConvertPixels_MJPG_to_YUV(width, height, src, src_pitch, dst_format, dst, dst_pitch);
+        case SDL_PIXELFORMAT_YUY2:
+        case SDL_PIXELFORMAT_UYVY:
+        case SDL_PIXELFORMAT_YVYU:
+        {
+            // Go through NV12 so the chroma never has to round trip through RGB
+            const int nv12_pitch = (width + 1) & ~1;
+            Uint8 *nv12 = (Uint8 *)SDL_malloc((size_t)nv12_pitch * (height + (height + 1) / 2));
+            if (!nv12) {
+                return false;
+            }
+            bool result = SDL_ConvertPixels_MJPG_to_YUV(width, height, src, src_pitch, SDL_PIXELFORMAT_NV12, nv12, nv12_pitch) &&
+                          SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_NV12, dst_colorspace, 0, nv12, nv12_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+            SDL_free(nv12);
+            return result;
+        }
+        default:
+            break;
+        }
     }
 
     bool result;
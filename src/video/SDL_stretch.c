@@ -24,6 +24,38 @@
 
 static bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
 static bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+static bool SDL_StretchSurfaceUncheckedFiltered(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode);
+
+static bool SDL_IsFilteredScaleMode(SDL_ScaleMode scaleMode)
+{
+    switch (scaleMode) {
+    case SDL_SCALEMODE_BICUBIC:
+    case SDL_SCALEMODE_LANCZOS:
+    case SDL_SCALEMODE_BOX:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool SDL_CanStretchSurfaceLinear(SDL_PixelFormat format)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format)) {
+        return false;
+    }
+
+    switch (SDL_BYTESPERPIXEL(format)) {
+    case 4:
+        return format != SDL_PIXELFORMAT_ARGB2101010;
+    case 3:
+        return true;
+    case 2:
+    case 1:
+        return SDL_ISPIXELFORMAT_PACKED(format);
+    default:
+        return false;
+    }
+}
 
 bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
 {
@@ -51,8 +83,11 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         return result;
     }
 
-    if (SDL_ISPIXELFORMAT_FOURCC(src->format)) {
+    if (SDL_ISPIXELFORMAT_FOURCC(src->format) ||
+        (SDL_IsFilteredScaleMode(scaleMode) && !SDL_ISPIXELFORMAT_INDEXED(src->format) && !SDL_CanStretchSurfaceFiltered(src->format))) {
         // Slow!
+        const SDL_PixelFormat tmp_format = SDL_ISPIXELFORMAT_ALPHA(src->format) ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_XRGB8888;
+
         if (!dstrect) {
             full_dst.x = 0;
             full_dst.y = 0;
@@ -61,8 +96,8 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
             dstrect = &full_dst;
         }
 
-        SDL_Surface *src_tmp = SDL_ConvertSurface(src, SDL_PIXELFORMAT_XRGB8888);
-        SDL_Surface *dst_tmp = SDL_CreateSurface(dstrect->w, dstrect->h, SDL_PIXELFORMAT_XRGB8888);
+        SDL_Surface *src_tmp = SDL_ConvertSurface(src, tmp_format);
+        SDL_Surface *dst_tmp = SDL_CreateSurface(dstrect->w, dstrect->h, tmp_format);
         if (src_tmp && dst_tmp) {
             result = SDL_StretchSurface(src_tmp, srcrect, dst_tmp, NULL, scaleMode);
             if (result) {
@@ -80,16 +115,16 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
         return result;
     }
 
-    if (scaleMode != SDL_SCALEMODE_NEAREST && scaleMode != SDL_SCALEMODE_LINEAR) {
+    if (scaleMode != SDL_SCALEMODE_NEAREST && scaleMode != SDL_SCALEMODE_LINEAR && !SDL_IsFilteredScaleMode(scaleMode)) {
         return SDL_InvalidParamError("scaleMode");
     }
 
-    if (scaleMode != SDL_SCALEMODE_NEAREST) {
-        scaleMode = SDL_SCALEMODE_LINEAR;
-    }
-
     if (scaleMode == SDL_SCALEMODE_LINEAR) {
-        if (SDL_BYTESPERPIXEL(src->format) != 4 || src->format == SDL_PIXELFORMAT_ARGB2101010) {
+        if (!SDL_CanStretchSurfaceLinear(src->format)) {
+            return SDL_SetError("Wrong format");
+        }
+    } else if (scaleMode != SDL_SCALEMODE_NEAREST) {
+        if (!SDL_CanStretchSurfaceFiltered(src->format)) {
             return SDL_SetError("Wrong format");
         }
     }
@@ -153,8 +188,10 @@ bool SDL_StretchSurface(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *
 
     if (scaleMode == SDL_SCALEMODE_NEAREST) {
         result = SDL_StretchSurfaceUncheckedNearest(src, srcrect, dst, dstrect);
-    } else {
+    } else if (scaleMode == SDL_SCALEMODE_LINEAR) {
         result = SDL_StretchSurfaceUncheckedLinear(src, srcrect, dst, dstrect);
+    } else {
+        result = SDL_StretchSurfaceUncheckedFiltered(src, srcrect, dst, dstrect, scaleMode);
     }
 
     // We need to unlock the surfaces if they're locked
@@ -561,7 +598,142 @@ static bool SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, in
     }
     return true;
 }
-#endif
+
+#if defined(SDL_SSE2_INTRINSICS) && defined(SDL_AVX2_INTRINSICS)
+
+static SDL_INLINE int hasAVX2(void)
+{
+    static int val = -1;
+    if (val != -1) {
+        return val;
+    }
+    val = SDL_HasAVX2();
+    return val;
+}
+
+// Weights for the horizontal interpolation of one pixel, as used by _mm_madd_epi16()
+#define FRAC_W_PAIR(f) ((int)(((Uint32)(f) << 16) | (Uint32)(FRAC_ONE - (f))))
+
+static bool SDL_TARGETING("avx2") scale_mat_AVX2(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+{
+    BILINEAR___START
+
+    for (i = 0; i < dst_h; i++) {
+        int nb_block4;
+        __m128i v_frac_h0;
+        __m128i v_frac_h1;
+        __m128i zero;
+        __m256i v_frac_h0_256;
+        __m256i v_frac_h1_256;
+        __m256i zero_256;
+
+        BILINEAR___HEIGHT
+
+        nb_block4 = middle / 4;
+
+        v_frac_h0 = _mm_set1_epi16((short)frac_h0);
+        v_frac_h1 = _mm_set1_epi16((short)frac_h1);
+        zero = _mm_setzero_si128();
+        v_frac_h0_256 = _mm256_set1_epi16((short)frac_h0);
+        v_frac_h1_256 = _mm256_set1_epi16((short)frac_h1);
+        zero_256 = _mm256_setzero_si256();
+
+        while (left_pad_w--) {
+            INTERPOL_BILINEAR_SSE(src_h0, src_h1, FRAC_ZERO, v_frac_h0, v_frac_h1, dst, zero);
+            dst += 1;
+        }
+
+        while (nb_block4--) {
+            int index_w_0, frac_w_0;
+            int index_w_1, frac_w_1;
+            int index_w_2, frac_w_2;
+            int index_w_3, frac_w_3;
+
+            __m256i x_0, x_1; /* Pixels pairs of the 4 dst pixels, in rows 0 and 1 */
+            __m256i v_frac_w_02, v_frac_w_13, k02, k13, e0;
+
+            index_w_0 = 4 * SRC_INDEX(fp_sum_w);
+            frac_w_0 = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+            index_w_1 = 4 * SRC_INDEX(fp_sum_w);
+            frac_w_1 = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+            index_w_2 = 4 * SRC_INDEX(fp_sum_w);
+            frac_w_2 = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+            index_w_3 = 4 * SRC_INDEX(fp_sum_w);
+            frac_w_3 = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+
+            // Load the pixel pairs, pixels j0 and j1 in the low lane, j2 and j3 in the high lane
+            x_0 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h0 + index_w_0)),
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h0 + index_w_1)))),
+                                          _mm_unpacklo_epi64(
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h0 + index_w_2)),
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h0 + index_w_3))),
+                                          1);
+            x_1 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi64(
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h1 + index_w_0)),
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h1 + index_w_1)))),
+                                          _mm_unpacklo_epi64(
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h1 + index_w_2)),
+                                              _mm_loadl_epi64((const __m128i *)((const Uint8 *)src_h1 + index_w_3))),
+                                          1);
+
+            // Interpolation vertical, k02 holds j0 and j2, k13 holds j1 and j3
+            k02 = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(x_0, zero_256), v_frac_h1_256),
+                                   _mm256_mullo_epi16(_mm256_unpacklo_epi8(x_1, zero_256), v_frac_h0_256));
+            k13 = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(x_0, zero_256), v_frac_h1_256),
+                                   _mm256_mullo_epi16(_mm256_unpackhi_epi8(x_1, zero_256), v_frac_h0_256));
+
+            // Interpolation horizontal
+            v_frac_w_02 = _mm256_setr_epi32(FRAC_W_PAIR(frac_w_0), FRAC_W_PAIR(frac_w_0), FRAC_W_PAIR(frac_w_0), FRAC_W_PAIR(frac_w_0),
+                                             FRAC_W_PAIR(frac_w_2), FRAC_W_PAIR(frac_w_2), FRAC_W_PAIR(frac_w_2), FRAC_W_PAIR(frac_w_2));
+            v_frac_w_13 = _mm256_setr_epi32(FRAC_W_PAIR(frac_w_1), FRAC_W_PAIR(frac_w_1), FRAC_W_PAIR(frac_w_1), FRAC_W_PAIR(frac_w_1),
+                                             FRAC_W_PAIR(frac_w_3), FRAC_W_PAIR(frac_w_3), FRAC_W_PAIR(frac_w_3), FRAC_W_PAIR(frac_w_3));
+            k02 = _mm256_madd_epi16(_mm256_unpacklo_epi16(k02, _mm256_srli_si256(k02, 8)), v_frac_w_02);
+            k13 = _mm256_madd_epi16(_mm256_unpacklo_epi16(k13, _mm256_srli_si256(k13, 8)), v_frac_w_13);
+
+            // Store 4 pixels
+            e0 = _mm256_packs_epi32(_mm256_srli_epi32(k02, PRECISION * 2), _mm256_srli_epi32(k13, PRECISION * 2));
+            e0 = _mm256_packus_epi16(e0, e0);
+            e0 = _mm256_permute4x64_epi64(e0, 0x08);
+            _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(e0));
+            dst += 4;
+        }
+
+        // Last points
+        middle &= 0x3;
+        while (middle--) {
+            const Uint32 *s_00_01;
+            const Uint32 *s_10_11;
+            int index_w = 4 * SRC_INDEX(fp_sum_w);
+            int frac_w = FRAC(fp_sum_w);
+            fp_sum_w += fp_step_w;
+            s_00_01 = (const Uint32 *)((const Uint8 *)src_h0 + index_w);
+            s_10_11 = (const Uint32 *)((const Uint8 *)src_h1 + index_w);
+            INTERPOL_BILINEAR_SSE(s_00_01, s_10_11, frac_w, v_frac_h0, v_frac_h1, dst, zero);
+            dst += 1;
+        }
+
+        while (right_pad_w--) {
+            int index_w = 4 * (src_w - 2);
+            const Uint32 *s_00_01 = (const Uint32 *)((const Uint8 *)src_h0 + index_w);
+            const Uint32 *s_10_11 = (const Uint32 *)((const Uint8 *)src_h1 + index_w);
+            INTERPOL_BILINEAR_SSE(s_00_01, s_10_11, FRAC_ONE, v_frac_h0, v_frac_h1, dst, zero);
+            dst += 1;
+        }
+        dst = (Uint32 *)((Uint8 *)dst + dst_gap);
+    }
+    return true;
+}
+
+#undef FRAC_W_PAIR
+
+#endif // SDL_AVX2_INTRINSICS
+
+#endif // SDL_SSE2_INTRINSICS
 
 #ifdef SDL_NEON_INTRINSICS
 
@@ -825,6 +997,165 @@ static bool scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitc
 }
 #endif
 
+/* Bilinear scaling of 8, 16 and 24-bit formats, without converting the whole surface to 32-bit first.
+   Each pair of source pixels is widened to 4*uint8, interpolated with the 32-bit kernels, and narrowed back. */
+
+static SDL_INLINE Uint32 widen_pixel(const Uint8 *s, int bpp, const SDL_PixelFormatDetails *fmt)
+{
+    Uint32 p;
+
+    if (bpp == 3) {
+        return (Uint32)s[0] | ((Uint32)s[1] << 8) | ((Uint32)s[2] << 16);
+    }
+
+    p = (bpp == 2) ? *(const Uint16 *)s : *s;
+    return (Uint32)SDL_expand_byte[fmt->Rbits][(p & fmt->Rmask) >> fmt->Rshift] |
+           ((Uint32)SDL_expand_byte[fmt->Gbits][(p & fmt->Gmask) >> fmt->Gshift] << 8) |
+           ((Uint32)SDL_expand_byte[fmt->Bbits][(p & fmt->Bmask) >> fmt->Bshift] << 16) |
+           ((Uint32)SDL_expand_byte[fmt->Abits][(p & fmt->Amask) >> fmt->Ashift] << 24);
+}
+
+static SDL_INLINE void narrow_pixel(Uint32 c, Uint8 *d, int bpp, const SDL_PixelFormatDetails *fmt)
+{
+    Uint32 p;
+
+    if (bpp == 3) {
+        d[0] = (Uint8)c;
+        d[1] = (Uint8)(c >> 8);
+        d[2] = (Uint8)(c >> 16);
+        return;
+    }
+
+    // Truncate like the blitters do when converting from 32-bit
+    p = (((c & 0xFF) >> (8 - fmt->Rbits)) << fmt->Rshift) |
+        ((((c >> 8) & 0xFF) >> (8 - fmt->Gbits)) << fmt->Gshift) |
+        ((((c >> 16) & 0xFF) >> (8 - fmt->Bbits)) << fmt->Bshift) |
+        (((c >> 24) >> (8 - fmt->Abits)) << fmt->Ashift);
+    if (bpp == 2) {
+        *(Uint16 *)d = (Uint16)p;
+    } else {
+        *d = (Uint8)p;
+    }
+}
+
+static SDL_INLINE void load_pixel_pairs(const Uint32 *src_h0, const Uint32 *src_h1, int index_w, int src_w, int bpp, const SDL_PixelFormatDetails *fmt, Uint32 *x_00_01, Uint32 *x_10_11)
+{
+    const Uint8 *s0, *s1;
+    int next;
+
+    if (index_w < 0) { // 1 pixel wide source
+        index_w = 0;
+    }
+    next = (index_w + 1 < src_w) ? bpp : 0;
+    s0 = (const Uint8 *)src_h0 + index_w * bpp;
+    s1 = (const Uint8 *)src_h1 + index_w * bpp;
+
+    x_00_01[0] = widen_pixel(s0, bpp, fmt);
+    x_00_01[1] = widen_pixel(s0 + next, bpp, fmt);
+    x_10_11[0] = widen_pixel(s1, bpp, fmt);
+    x_10_11[1] = widen_pixel(s1 + next, bpp, fmt);
+}
+
+#define BILINEAR___PACKED_PIXEL(index_w, frac_w, INTERPOLATE)                               \
+    {                                                                                       \
+        Uint32 x_00_01[2], x_10_11[2], pixel;                                               \
+        load_pixel_pairs(src_h0, src_h1, index_w, src_w, bpp, fmt, x_00_01, x_10_11);       \
+        INTERPOLATE(x_00_01, x_10_11, frac_w, &pixel);                                      \
+        narrow_pixel(pixel, (Uint8 *)dst, bpp, fmt);                                        \
+        dst = (Uint32 *)((Uint8 *)dst + bpp);                                               \
+    }
+
+#define BILINEAR___PACKED_WIDTH(INTERPOLATE)                                                \
+    while (left_pad_w--) {                                                                  \
+        BILINEAR___PACKED_PIXEL(0, FRAC_ZERO, INTERPOLATE)                                  \
+    }                                                                                       \
+    while (middle--) {                                                                      \
+        int index_w = SRC_INDEX(fp_sum_w);                                                  \
+        int frac_w = FRAC(fp_sum_w);                                                        \
+        fp_sum_w += fp_step_w;                                                              \
+        BILINEAR___PACKED_PIXEL(index_w, frac_w, INTERPOLATE)                               \
+    }                                                                                       \
+    while (right_pad_w--) {                                                                 \
+        BILINEAR___PACKED_PIXEL(src_w - 2, FRAC_ONE, INTERPOLATE)                           \
+    }                                                                                       \
+    dst = (Uint32 *)((Uint8 *)dst + dst_gap);
+
+#define INTERPOL_PACKED(s0, s1, frac_w, dst) INTERPOL_BILINEAR(s0, s1, frac_w, frac_h0, frac_h1, dst)
+
+static bool scale_mat_packed(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int bpp, const SDL_PixelFormatDetails *fmt)
+{
+    BILINEAR___START
+
+    dst_gap = dst_pitch - bpp * dst_w;
+
+    for (i = 0; i < dst_h; i++) {
+
+        BILINEAR___HEIGHT
+
+        BILINEAR___PACKED_WIDTH(INTERPOL_PACKED)
+    }
+    return true;
+}
+
+#undef INTERPOL_PACKED
+
+#ifdef SDL_SSE2_INTRINSICS
+
+#define INTERPOL_PACKED_SSE(s0, s1, frac_w, dst) INTERPOL_BILINEAR_SSE(s0, s1, frac_w, v_frac_h0, v_frac_h1, dst, zero)
+
+static bool SDL_TARGETING("sse2") scale_mat_packed_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int bpp, const SDL_PixelFormatDetails *fmt)
+{
+    BILINEAR___START
+
+    dst_gap = dst_pitch - bpp * dst_w;
+
+    for (i = 0; i < dst_h; i++) {
+        __m128i v_frac_h0;
+        __m128i v_frac_h1;
+        __m128i zero;
+
+        BILINEAR___HEIGHT
+
+        v_frac_h0 = _mm_set1_epi16((short)frac_h0);
+        v_frac_h1 = _mm_set1_epi16((short)frac_h1);
+        zero = _mm_setzero_si128();
+
+        BILINEAR___PACKED_WIDTH(INTERPOL_PACKED_SSE)
+    }
+    return true;
+}
+
+#undef INTERPOL_PACKED_SSE
+
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+
+#define INTERPOL_PACKED_NEON(s0, s1, frac_w, dst) INTERPOL_BILINEAR_NEON(s0, s1, frac_w, v_frac_h0, v_frac_h1, dst)
+
+static bool scale_mat_packed_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int bpp, const SDL_PixelFormatDetails *fmt)
+{
+    BILINEAR___START
+
+    dst_gap = dst_pitch - bpp * dst_w;
+
+    for (i = 0; i < dst_h; i++) {
+        uint8x8_t v_frac_h0, v_frac_h1;
+
+        BILINEAR___HEIGHT
+
+        v_frac_h0 = vmov_n_u8(frac_h0);
+        v_frac_h1 = vmov_n_u8(frac_h1);
+
+        BILINEAR___PACKED_WIDTH(INTERPOL_PACKED_NEON)
+    }
+    return true;
+}
+
+#undef INTERPOL_PACKED_NEON
+
+#endif
+
 bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect)
 {
     bool result = false;
@@ -834,8 +1165,28 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     int dst_h = dstrect->h;
     int src_pitch = s->pitch;
     int dst_pitch = d->pitch;
-    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    int bpp = SDL_BYTESPERPIXEL(d->format);
+    Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
+
+    if (bpp != 4) {
+#ifdef SDL_NEON_INTRINSICS
+        if (!result && hasNEON()) {
+            result = scale_mat_packed_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, bpp, s->fmt);
+        }
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+        if (!result && hasSSE2()) {
+            result = scale_mat_packed_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, bpp, s->fmt);
+        }
+#endif
+
+        if (!result) {
+            result = scale_mat_packed(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, bpp, s->fmt);
+        }
+        return result;
+    }
 
 #ifdef SDL_NEON_INTRINSICS
     if (!result && hasNEON()) {
@@ -843,6 +1194,12 @@ bool SDL_StretchSurfaceUncheckedLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     }
 #endif
 
+#if defined(SDL_SSE2_INTRINSICS) && defined(SDL_AVX2_INTRINSICS)
+    if (!result && hasAVX2()) {
+        result = scale_mat_AVX2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+    }
+#endif
+
 #ifdef SDL_SSE2_INTRINSICS
     if (!result && hasSSE2()) {
         result = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
@@ -976,3 +1333,497 @@ bool SDL_StretchSurfaceUncheckedNearest(SDL_Surface *s, const SDL_Rect *srcrect,
         return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
     }
 }
+
+/* Filtered scaling of 32-bit formats with 8-bit channels.
+   The image is resampled horizontally into a temporary buffer and then vertically,
+   each destination pixel being a weighted sum of a run of source pixels.
+   When downscaling, the filter is widened to cover all the source pixels it replaces.
+   Weights are 14-bit fixed point, so the sums fit in 32-bit and SSE2/NEON can use 16-bit multiplies. */
+
+#define FILTER_PRECISION 14
+#define FILTER_ONE       (1 << FILTER_PRECISION)
+#define FILTER_ROUND     (1 << (FILTER_PRECISION - 1))
+
+// The number of weight tables kept around for repeated scales of the same size
+#define FILTER_CACHE_SIZE 8
+
+typedef struct SDL_StretchFilter
+{
+    SDL_ScaleMode scaleMode;
+    int src_size;
+    int dst_size;
+    int taps;        // weights per destination pixel
+    int *start;      // first source pixel of each destination pixel
+    Sint16 *weights; // taps weights per destination pixel, summing to FILTER_ONE
+    SDL_AtomicInt refcount;
+} SDL_StretchFilter;
+
+static SDL_SpinLock SDL_stretch_filter_lock;
+static SDL_StretchFilter *SDL_stretch_filter_cache[FILTER_CACHE_SIZE];
+static int SDL_stretch_filter_next;
+
+static double filter_box(double x)
+{
+    if (x > -0.5 && x <= 0.5) {
+        return 1.0;
+    }
+    return 0.0;
+}
+
+static double filter_bicubic(double x)
+{
+    // Catmull-Rom spline, a = -0.5
+    const double a = -0.5;
+
+    x = SDL_fabs(x);
+    if (x < 1.0) {
+        return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+    } else if (x < 2.0) {
+        return (((x - 5.0) * x + 8.0) * x - 4.0) * a;
+    }
+    return 0.0;
+}
+
+static double filter_sinc(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+    x *= SDL_PI_D;
+    return SDL_sin(x) / x;
+}
+
+static double filter_lanczos(double x)
+{
+    if (x > -3.0 && x < 3.0) {
+        return filter_sinc(x) * filter_sinc(x / 3.0);
+    }
+    return 0.0;
+}
+
+static void DestroyStretchFilter(SDL_StretchFilter *filter)
+{
+    if (filter && SDL_AtomicDecRef(&filter->refcount)) {
+        SDL_free(filter->start);
+        SDL_free(filter->weights);
+        SDL_free(filter);
+    }
+}
+
+static SDL_StretchFilter *CreateStretchFilter(SDL_ScaleMode scaleMode, int src_size, int dst_size)
+{
+    double (*func)(double);
+    double support, scale, filterscale;
+    double *values;
+    SDL_StretchFilter *filter;
+    int i, k;
+
+    switch (scaleMode) {
+    case SDL_SCALEMODE_BICUBIC:
+        func = filter_bicubic;
+        support = 2.0;
+        break;
+    case SDL_SCALEMODE_LANCZOS:
+        func = filter_lanczos;
+        support = 3.0;
+        break;
+    default:
+        func = filter_box;
+        support = 0.5;
+        break;
+    }
+
+    scale = (double)src_size / dst_size;
+    filterscale = SDL_max(scale, 1.0);
+    support *= filterscale;
+
+    filter = (SDL_StretchFilter *)SDL_calloc(1, sizeof(*filter));
+    if (!filter) {
+        return NULL;
+    }
+    filter->scaleMode = scaleMode;
+    filter->src_size = src_size;
+    filter->dst_size = dst_size;
+    filter->taps = SDL_min((int)SDL_ceil(support) * 2 + 1, src_size);
+    filter->start = (int *)SDL_malloc(dst_size * sizeof(*filter->start));
+    filter->weights = (Sint16 *)SDL_calloc((size_t)dst_size * filter->taps, sizeof(*filter->weights));
+    values = (double *)SDL_malloc(filter->taps * sizeof(*values));
+    if (!filter->start || !filter->weights || !values) {
+        SDL_free(filter->start);
+        SDL_free(filter->weights);
+        SDL_free(filter);
+        SDL_free(values);
+        return NULL;
+    }
+    SDL_SetAtomicInt(&filter->refcount, 1);
+
+    for (i = 0; i < dst_size; ++i) {
+        const double center = (i + 0.5) * scale;
+        Sint16 *weights = &filter->weights[i * filter->taps];
+        int first = (int)(center - support + 0.5);
+        int last = (int)(center + support + 0.5);
+        int count, offset, total, biggest;
+        double sum = 0.0;
+
+        first = SDL_max(first, 0);
+        last = SDL_min(last, src_size);
+        count = SDL_min(last - first, filter->taps);
+        for (k = 0; k < count; ++k) {
+            values[k] = func((first + k - center + 0.5) / filterscale);
+            sum += values[k];
+        }
+
+        // Keep the taps inside the source, moving the weights along if the run needs to start earlier
+        offset = 0;
+        if (first + filter->taps > src_size) {
+            offset = first + filter->taps - src_size;
+            first -= offset;
+        }
+        filter->start[i] = first;
+
+        total = 0;
+        biggest = offset;
+        for (k = 0; k < count; ++k) {
+            const double value = (sum != 0.0) ? (values[k] / sum) : (k == 0 ? 1.0 : 0.0);
+            weights[offset + k] = (Sint16)SDL_lround(value * FILTER_ONE);
+            total += weights[offset + k];
+            if (weights[offset + k] > weights[biggest]) {
+                biggest = offset + k;
+            }
+        }
+        // Make sure flat areas stay flat after rounding
+        weights[biggest] += (Sint16)(FILTER_ONE - total);
+    }
+    SDL_free(values);
+
+    return filter;
+}
+
+static SDL_StretchFilter *GetStretchFilter(SDL_ScaleMode scaleMode, int src_size, int dst_size)
+{
+    SDL_StretchFilter *filter = NULL;
+    int i;
+
+    SDL_LockSpinlock(&SDL_stretch_filter_lock);
+    for (i = 0; i < FILTER_CACHE_SIZE; ++i) {
+        SDL_StretchFilter *cached = SDL_stretch_filter_cache[i];
+        if (cached && cached->scaleMode == scaleMode && cached->src_size == src_size && cached->dst_size == dst_size) {
+            SDL_AtomicIncRef(&cached->refcount);
+            filter = cached;
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_stretch_filter_lock);
+
+    if (filter) {
+        return filter;
+    }
+
+    filter = CreateStretchFilter(scaleMode, src_size, dst_size);
+    if (!filter) {
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&SDL_stretch_filter_lock);
+    DestroyStretchFilter(SDL_stretch_filter_cache[SDL_stretch_filter_next]);
+    SDL_AtomicIncRef(&filter->refcount);
+    SDL_stretch_filter_cache[SDL_stretch_filter_next] = filter;
+    SDL_stretch_filter_next = (SDL_stretch_filter_next + 1) % FILTER_CACHE_SIZE;
+    SDL_UnlockSpinlock(&SDL_stretch_filter_lock);
+
+    return filter;
+}
+
+void SDL_QuitStretch(void)
+{
+    int i;
+
+    SDL_LockSpinlock(&SDL_stretch_filter_lock);
+    for (i = 0; i < FILTER_CACHE_SIZE; ++i) {
+        DestroyStretchFilter(SDL_stretch_filter_cache[i]);
+        SDL_stretch_filter_cache[i] = NULL;
+    }
+    SDL_stretch_filter_next = 0;
+    SDL_UnlockSpinlock(&SDL_stretch_filter_lock);
+}
+
+static SDL_INLINE Uint32 filter_clamp(int value)
+{
+    value >>= FILTER_PRECISION;
+    if (value < 0) {
+        return 0;
+    } else if (value > 255) {
+        return 255;
+    }
+    return (Uint32)value;
+}
+
+static void filter_horizontal(const Uint32 *src, int src_h, int src_pitch, Uint32 *dst, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    int x, y, k;
+
+    for (y = 0; y < src_h; ++y) {
+        const Sint16 *weights = filter->weights;
+        for (x = 0; x < filter->dst_size; ++x) {
+            const Uint8 *s = (const Uint8 *)&src[filter->start[x]];
+            int c0 = FILTER_ROUND, c1 = FILTER_ROUND, c2 = FILTER_ROUND, c3 = FILTER_ROUND;
+            for (k = 0; k < filter->taps; ++k) {
+                c0 += s[0] * weights[k];
+                c1 += s[1] * weights[k];
+                c2 += s[2] * weights[k];
+                c3 += s[3] * weights[k];
+                s += 4;
+            }
+            ((Uint8 *)&dst[x])[0] = (Uint8)filter_clamp(c0);
+            ((Uint8 *)&dst[x])[1] = (Uint8)filter_clamp(c1);
+            ((Uint8 *)&dst[x])[2] = (Uint8)filter_clamp(c2);
+            ((Uint8 *)&dst[x])[3] = (Uint8)filter_clamp(c3);
+            weights += filter->taps;
+        }
+        src = (const Uint32 *)((const Uint8 *)src + src_pitch);
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+
+static void filter_vertical(const Uint32 *src, int src_pitch, Uint32 *dst, int dst_w, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    int x, y, k;
+
+    for (y = 0; y < filter->dst_size; ++y) {
+        const Sint16 *weights = &filter->weights[y * filter->taps];
+        const Uint8 *first = (const Uint8 *)src + filter->start[y] * src_pitch;
+        for (x = 0; x < dst_w; ++x) {
+            const Uint8 *s = first + x * 4;
+            int c0 = FILTER_ROUND, c1 = FILTER_ROUND, c2 = FILTER_ROUND, c3 = FILTER_ROUND;
+            for (k = 0; k < filter->taps; ++k) {
+                c0 += s[0] * weights[k];
+                c1 += s[1] * weights[k];
+                c2 += s[2] * weights[k];
+                c3 += s[3] * weights[k];
+                s += src_pitch;
+            }
+            ((Uint8 *)&dst[x])[0] = (Uint8)filter_clamp(c0);
+            ((Uint8 *)&dst[x])[1] = (Uint8)filter_clamp(c1);
+            ((Uint8 *)&dst[x])[2] = (Uint8)filter_clamp(c2);
+            ((Uint8 *)&dst[x])[3] = (Uint8)filter_clamp(c3);
+        }
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+static SDL_INLINE __m128i SDL_TARGETING("sse2") filter_weight_pair_SSE(const Sint16 *weights, int k, int taps)
+{
+    const Uint16 w0 = (Uint16)weights[k];
+    const Uint16 w1 = (k + 1 < taps) ? (Uint16)weights[k + 1] : 0;
+    return _mm_set1_epi32((int)(((Uint32)w1 << 16) | w0));
+}
+
+static void SDL_TARGETING("sse2") filter_horizontal_SSE(const Uint32 *src, int src_h, int src_pitch, Uint32 *dst, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(FILTER_ROUND);
+    int x, y, k;
+
+    for (y = 0; y < src_h; ++y) {
+        const Sint16 *weights = filter->weights;
+        for (x = 0; x < filter->dst_size; ++x) {
+            const Uint32 *s = &src[filter->start[x]];
+            __m128i sum = round;
+            // Two source pixels at a time, with their channels interleaved to match the pair of weights
+            for (k = 0; k + 1 < filter->taps; k += 2) {
+                const __m128i pixels = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&s[k]), zero);
+                const __m128i pairs = _mm_unpacklo_epi16(pixels, _mm_srli_si128(pixels, 8));
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, filter_weight_pair_SSE(weights, k, filter->taps)));
+            }
+            if (k < filter->taps) {
+                const __m128i pixels = _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)s[k]), zero);
+                const __m128i pairs = _mm_unpacklo_epi16(pixels, zero);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, filter_weight_pair_SSE(weights, k, filter->taps)));
+            }
+            sum = _mm_srai_epi32(sum, FILTER_PRECISION);
+            sum = _mm_packs_epi32(sum, sum);
+            dst[x] = (Uint32)_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+            weights += filter->taps;
+        }
+        src = (const Uint32 *)((const Uint8 *)src + src_pitch);
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+
+static void SDL_TARGETING("sse2") filter_vertical_SSE(const Uint32 *src, int src_pitch, Uint32 *dst, int dst_w, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi32(FILTER_ROUND);
+    int x, y, k;
+
+    for (y = 0; y < filter->dst_size; ++y) {
+        const Sint16 *weights = &filter->weights[y * filter->taps];
+        const Uint8 *first = (const Uint8 *)src + filter->start[y] * src_pitch;
+        // Four destination pixels at a time, two source rows at a time
+        for (x = 0; x + 4 <= dst_w; x += 4) {
+            const Uint8 *s = first + x * 4;
+            __m128i sum0 = round, sum1 = round, sum2 = round, sum3 = round;
+            for (k = 0; k < filter->taps; k += 2) {
+                const __m128i weight = filter_weight_pair_SSE(weights, k, filter->taps);
+                const __m128i row0 = _mm_loadu_si128((const __m128i *)s);
+                const __m128i row1 = (k + 1 < filter->taps) ? _mm_loadu_si128((const __m128i *)(s + src_pitch)) : zero;
+                const __m128i lo = _mm_unpacklo_epi8(row0, row1);
+                const __m128i hi = _mm_unpackhi_epi8(row0, row1);
+                sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), weight));
+                sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), weight));
+                sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), weight));
+                sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), weight));
+                s += 2 * src_pitch;
+            }
+            sum0 = _mm_packs_epi32(_mm_srai_epi32(sum0, FILTER_PRECISION), _mm_srai_epi32(sum1, FILTER_PRECISION));
+            sum2 = _mm_packs_epi32(_mm_srai_epi32(sum2, FILTER_PRECISION), _mm_srai_epi32(sum3, FILTER_PRECISION));
+            _mm_storeu_si128((__m128i *)&dst[x], _mm_packus_epi16(sum0, sum2));
+        }
+        for (; x < dst_w; ++x) {
+            const Uint8 *s = first + x * 4;
+            __m128i sum = round;
+            for (k = 0; k < filter->taps; k += 2) {
+                const __m128i row0 = _mm_cvtsi32_si128(*(const int *)s);
+                const __m128i row1 = (k + 1 < filter->taps) ? _mm_cvtsi32_si128(*(const int *)(s + src_pitch)) : zero;
+                const __m128i pairs = _mm_unpacklo_epi8(_mm_unpacklo_epi8(row0, row1), zero);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(pairs, filter_weight_pair_SSE(weights, k, filter->taps)));
+                s += 2 * src_pitch;
+            }
+            sum = _mm_srai_epi32(sum, FILTER_PRECISION);
+            sum = _mm_packs_epi32(sum, sum);
+            dst[x] = (Uint32)_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+        }
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+static SDL_INLINE int16x4_t filter_widen_pixel_NEON(Uint32 pixel)
+{
+    return vget_low_s16(vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(pixel)))));
+}
+
+static SDL_INLINE Uint32 filter_narrow_pixel_NEON(int32x4_t sum)
+{
+    const int16x4_t narrow = vqmovn_s32(vshrq_n_s32(sum, FILTER_PRECISION));
+    return vget_lane_u32(vreinterpret_u32_u8(vqmovun_s16(vcombine_s16(narrow, narrow))), 0);
+}
+
+static void filter_horizontal_NEON(const Uint32 *src, int src_h, int src_pitch, Uint32 *dst, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    int x, y, k;
+
+    for (y = 0; y < src_h; ++y) {
+        const Sint16 *weights = filter->weights;
+        for (x = 0; x < filter->dst_size; ++x) {
+            const Uint32 *s = &src[filter->start[x]];
+            int32x4_t sum = vdupq_n_s32(FILTER_ROUND);
+            for (k = 0; k < filter->taps; ++k) {
+                sum = vmlal_n_s16(sum, filter_widen_pixel_NEON(s[k]), weights[k]);
+            }
+            dst[x] = filter_narrow_pixel_NEON(sum);
+            weights += filter->taps;
+        }
+        src = (const Uint32 *)((const Uint8 *)src + src_pitch);
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+
+static void filter_vertical_NEON(const Uint32 *src, int src_pitch, Uint32 *dst, int dst_w, int dst_pitch, const SDL_StretchFilter *filter)
+{
+    int x, y, k;
+
+    for (y = 0; y < filter->dst_size; ++y) {
+        const Sint16 *weights = &filter->weights[y * filter->taps];
+        const Uint8 *first = (const Uint8 *)src + filter->start[y] * src_pitch;
+        // Four destination pixels at a time
+        for (x = 0; x + 4 <= dst_w; x += 4) {
+            const Uint8 *s = first + x * 4;
+            int32x4_t sum0 = vdupq_n_s32(FILTER_ROUND);
+            int32x4_t sum1 = sum0, sum2 = sum0, sum3 = sum0;
+            int16x8_t narrow0, narrow1;
+            for (k = 0; k < filter->taps; ++k) {
+                const uint8x16_t row = vld1q_u8(s);
+                const int16x8_t lo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(row)));
+                const int16x8_t hi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(row)));
+                sum0 = vmlal_n_s16(sum0, vget_low_s16(lo), weights[k]);
+                sum1 = vmlal_n_s16(sum1, vget_high_s16(lo), weights[k]);
+                sum2 = vmlal_n_s16(sum2, vget_low_s16(hi), weights[k]);
+                sum3 = vmlal_n_s16(sum3, vget_high_s16(hi), weights[k]);
+                s += src_pitch;
+            }
+            narrow0 = vcombine_s16(vqmovn_s32(vshrq_n_s32(sum0, FILTER_PRECISION)), vqmovn_s32(vshrq_n_s32(sum1, FILTER_PRECISION)));
+            narrow1 = vcombine_s16(vqmovn_s32(vshrq_n_s32(sum2, FILTER_PRECISION)), vqmovn_s32(vshrq_n_s32(sum3, FILTER_PRECISION)));
+            vst1q_u8((Uint8 *)&dst[x], vcombine_u8(vqmovun_s16(narrow0), vqmovun_s16(narrow1)));
+        }
+        for (; x < dst_w; ++x) {
+            const Uint8 *s = first + x * 4;
+            int32x4_t sum = vdupq_n_s32(FILTER_ROUND);
+            for (k = 0; k < filter->taps; ++k) {
+                sum = vmlal_n_s16(sum, filter_widen_pixel_NEON(*(const Uint32 *)s), weights[k]);
+                s += src_pitch;
+            }
+            dst[x] = filter_narrow_pixel_NEON(sum);
+        }
+        dst = (Uint32 *)((Uint8 *)dst + dst_pitch);
+    }
+}
+#endif
+
+bool SDL_CanStretchSurfaceFiltered(SDL_PixelFormat format)
+{
+    if (SDL_ISPIXELFORMAT_FOURCC(format) || SDL_ISPIXELFORMAT_INDEXED(format) || SDL_ISPIXELFORMAT_10BIT(format)) {
+        return false;
+    }
+    return SDL_BYTESPERPIXEL(format) == 4;
+}
+
+static bool SDL_StretchSurfaceUncheckedFiltered(SDL_Surface *s, const SDL_Rect *srcrect, SDL_Surface *d, const SDL_Rect *dstrect, SDL_ScaleMode scaleMode)
+{
+    int src_w = srcrect->w;
+    int src_h = srcrect->h;
+    int dst_w = dstrect->w;
+    int dst_h = dstrect->h;
+    int src_pitch = s->pitch;
+    int dst_pitch = d->pitch;
+    int tmp_pitch = dst_w * 4;
+    const Uint32 *src = (const Uint32 *)((const Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    SDL_StretchFilter *filter_w;
+    SDL_StretchFilter *filter_h;
+    Uint32 *tmp;
+
+    filter_w = GetStretchFilter(scaleMode, src_w, dst_w);
+    filter_h = GetStretchFilter(scaleMode, src_h, dst_h);
+    tmp = (Uint32 *)SDL_malloc((size_t)src_h * tmp_pitch);
+    if (!filter_w || !filter_h || !tmp) {
+        DestroyStretchFilter(filter_w);
+        DestroyStretchFilter(filter_h);
+        SDL_free(tmp);
+        return false;
+    }
+
+#ifdef SDL_NEON_INTRINSICS
+    if (hasNEON()) {
+        filter_horizontal_NEON(src, src_h, src_pitch, tmp, tmp_pitch, filter_w);
+        filter_vertical_NEON(tmp, tmp_pitch, dst, dst_w, dst_pitch, filter_h);
+    } else
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (hasSSE2()) {
+        filter_horizontal_SSE(src, src_h, src_pitch, tmp, tmp_pitch, filter_w);
+        filter_vertical_SSE(tmp, tmp_pitch, dst, dst_w, dst_pitch, filter_h);
+    } else
+#endif
+    {
+        filter_horizontal(src, src_h, src_pitch, tmp, tmp_pitch, filter_w);
+        filter_vertical(tmp, tmp_pitch, dst, dst_w, dst_pitch, filter_h);
+    }
+
+    SDL_free(tmp);
+    DestroyStretchFilter(filter_w);
+    DestroyStretchFilter(filter_h);
+    return true;
+}
@@ -26,6 +26,8 @@
 #include "SDL_pixels_c.h"
 #include "SDL_stb_c.h"
 #include "SDL_yuv_c.h"
+#include "../SDL_memoryusage_c.h"
+#include "../SDL_properties_c.h"
 #include "../render/SDL_sysrender.h"
 
 #include "SDL_surface_c.h"
@@ -225,16 +227,24 @@ SDL_Surface *SDL_CreateSurface(int width, int height, SDL_PixelFormat format)
     }
 
     if (surface->w && surface->h && format != SDL_PIXELFORMAT_MJPG) {
+        bool pooled;
+
         surface->flags &= ~SDL_SURFACE_PREALLOCATED;
-        surface->pixels = SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+        surface->pixels = SDL_AllocSurfacePixels(size, &pooled);
         if (!surface->pixels) {
             SDL_DestroySurface(surface);
             return NULL;
         }
-        surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+        if (pooled) {
+            surface->internal_flags |= SDL_INTERNAL_SURFACE_POOLED;
+        } else {
+            surface->flags |= SDL_SURFACE_SIMD_ALIGNED;
+        }
 
         // This is important for bitmaps
         SDL_memset(surface->pixels, 0, size);
+
+        SDL_TrackMemoryObject(surface, SDL_MEMORY_OBJECT_SURFACE, size, &surface->props, NULL);
     }
     return surface;
 }
@@ -322,6 +332,10 @@ float SDL_GetDefaultSDRWhitePoint(SDL_Colorspace colorspace)
     return SDL_GetSurfaceSDRWhitePoint(NULL, colorspace);
 }
 
+// These are checked every time an HDR surface is blitted
+static SDL_PropertyKey SDL_surface_SDR_white_point_key = SDL_PROPERTY_KEY(SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT);
+static SDL_PropertyKey SDL_surface_HDR_headroom_key = SDL_PROPERTY_KEY(SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT);
+
 float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspace)
 {
     SDL_TransferCharacteristics transfer = SDL_COLORSPACETRANSFER(colorspace);
@@ -345,7 +359,7 @@ float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspac
             const float DEFAULT_PQ_SDR_WHITE_POINT = 203.0f;
             default_value = DEFAULT_PQ_SDR_WHITE_POINT;
         }
-        return SDL_GetFloatProperty(props, SDL_PROP_SURFACE_SDR_WHITE_POINT_FLOAT, default_value);
+        return SDL_GetFloatPropertyByKey(props, &SDL_surface_SDR_white_point_key, default_value);
     }
     return 1.0f;
 }
@@ -369,7 +383,7 @@ float SDL_GetSurfaceHDRHeadroom(SDL_Surface *surface, SDL_Colorspace colorspace)
         } else {
             props = 0;
         }
-        return SDL_GetFloatProperty(props, SDL_PROP_SURFACE_HDR_HEADROOM_FLOAT, default_value);
+        return SDL_GetFloatPropertyByKey(props, &SDL_surface_HDR_headroom_key, default_value);
     }
     return 1.0f;
 }
@@ -450,6 +464,86 @@ SDL_Palette *SDL_GetSurfacePalette(SDL_Surface *surface)
     return surface->palette;
 }
 
+/* Scaling an image is expensive, and cursors and icons ask for the same
+   scales over and over, so keep the last few results around. Each one
+   remembers which image it was made from and the pixels_version of both,
+   so it's regenerated if either is changed through SDL. */
+#define SDL_SURFACE_IMAGE_CACHE_SIZE 4
+
+typedef struct SDL_SurfaceImageCacheEntry
+{
+    SDL_Surface *source; // Either the surface or one of its images, which the surface holds a reference to
+    Uint32 source_version;
+    SDL_Surface *scaled;
+    Uint32 scaled_version; // The caller may have drawn on the copy it was given
+} SDL_SurfaceImageCacheEntry;
+
+struct SDL_SurfaceImageCache
+{
+    SDL_SurfaceImageCacheEntry entries[SDL_SURFACE_IMAGE_CACHE_SIZE];
+    int next;
+};
+
+static void SDL_FlushSurfaceImageCache(SDL_Surface *surface)
+{
+    struct SDL_SurfaceImageCache *cache = surface->image_cache;
+
+    if (cache) {
+        for (int i = 0; i < SDL_arraysize(cache->entries); ++i) {
+            SDL_DestroySurface(cache->entries[i].scaled);
+        }
+        SDL_free(cache);
+        surface->image_cache = NULL;
+    }
+}
+
+static SDL_Surface *SDL_GetCachedSurfaceImage(SDL_Surface *surface, SDL_Surface *source, int w, int h)
+{
+    struct SDL_SurfaceImageCache *cache = surface->image_cache;
+
+    if (cache) {
+        for (int i = 0; i < SDL_arraysize(cache->entries); ++i) {
+            SDL_SurfaceImageCacheEntry *entry = &cache->entries[i];
+            if (entry->scaled && entry->source == source && entry->scaled->w == w && entry->scaled->h == h) {
+                if (entry->source_version == source->pixels_version && entry->scaled_version == entry->scaled->pixels_version) {
+                    ++entry->scaled->refcount;
+                    return entry->scaled;
+                }
+                // The image changed since it was scaled
+                SDL_DestroySurface(entry->scaled);
+                entry->scaled = NULL;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void SDL_CacheSurfaceImage(SDL_Surface *surface, SDL_Surface *source, SDL_Surface *scaled)
+{
+    struct SDL_SurfaceImageCache *cache = surface->image_cache;
+    SDL_SurfaceImageCacheEntry *entry;
+
+    if (!cache) {
+        cache = (struct SDL_SurfaceImageCache *)SDL_calloc(1, sizeof(*cache));
+        if (!cache) {
+            // Not fatal, the next call will just scale again
+            SDL_ClearError();
+            return;
+        }
+        surface->image_cache = cache;
+    }
+
+    entry = &cache->entries[cache->next];
+    cache->next = (cache->next + 1) % SDL_arraysize(cache->entries);
+
+    SDL_DestroySurface(entry->scaled);
+    entry->source = source;
+    entry->source_version = source->pixels_version;
+    entry->scaled = scaled;
+    entry->scaled_version = scaled->pixels_version;
+    ++scaled->refcount;
+}
+
 bool SDL_AddSurfaceAlternateImage(SDL_Surface *surface, SDL_Surface *image)
 {
     if (!SDL_SurfaceValid(surface)) {
@@ -468,6 +562,9 @@ bool SDL_AddSurfaceAlternateImage(SDL_Surface *surface, SDL_Surface *image)
     surface->images = images;
     ++surface->num_images;
     ++image->refcount;
+
+    // The closest image for a scale may have changed
+    SDL_FlushSurfaceImageCache(surface);
     return true;
 }
 
@@ -557,9 +654,14 @@ SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale)
         return closest;
     }
 
+    SDL_Surface *scaled = SDL_GetCachedSurfaceImage(surface, closest, desired_w, desired_h);
+    if (scaled) {
+        return scaled;
+    }
+
     // We need to scale the image to the correct size. To maintain good image quality, downscaling
     // is done in steps, never reducing the width and height by more than half each time.
-    SDL_Surface *scaled = closest;
+    scaled = closest;
     do {
         int next_scaled_w = SDL_max(desired_w, (scaled->w + 1) / 2);
         int next_scaled_h = SDL_max(desired_h, (scaled->h + 1) / 2);
@@ -575,6 +677,8 @@ SDL_Surface *SDL_GetSurfaceImage(SDL_Surface *surface, float display_scale)
         }
     } while (scaled->w != desired_w || scaled->h != desired_h);
 
+    SDL_CacheSurfaceImage(surface, closest, scaled);
+
     return scaled;
 }
 
@@ -584,6 +688,8 @@ void SDL_RemoveSurfaceAlternateImages(SDL_Surface *surface)
         return;
     }
 
+    SDL_FlushSurfaceImageCache(surface);
+
     if (surface->num_images > 0) {
         for (int i = 0; i < surface->num_images; ++i) {
             SDL_DestroySurface(surface->images[i]);
@@ -1009,6 +1115,7 @@ bool SDL_BlitSurfaceUnchecked(SDL_Surface *src, const SDL_Rect *srcrect,
     if (!SDL_ValidateMap(src, dst)) {
         return false;
     }
+    SDL_MarkSurfaceModified(dst);
     return src->map.blit(src, srcrect, dst, dstrect);
 }
 
@@ -1107,7 +1214,10 @@ bool SDL_BlitSurfaceScaled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surfac
     } else if ((src->flags & SDL_SURFACE_LOCKED) || (dst->flags & SDL_SURFACE_LOCKED)) {
         return SDL_SetError("Surfaces must not be locked during blit");
     } else if (scaleMode != SDL_SCALEMODE_NEAREST &&
-               scaleMode != SDL_SCALEMODE_LINEAR) {
+               scaleMode != SDL_SCALEMODE_LINEAR &&
+               scaleMode != SDL_SCALEMODE_BICUBIC &&
+               scaleMode != SDL_SCALEMODE_LANCZOS &&
+               scaleMode != SDL_SCALEMODE_BOX) {
         return SDL_InvalidParamError("scaleMode");
     }
 
@@ -1268,6 +1378,8 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
         return SDL_SetError("Size too large for scaling");
     }
 
+    SDL_MarkSurfaceModified(dst);
+
     if (!(src->map.info.flags & SDL_COPY_NEAREST)) {
         src->map.info.flags |= SDL_COPY_NEAREST;
         SDL_InvalidateMap(&src->map);
@@ -1294,11 +1406,9 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
     } else {
         if (!(src->map.info.flags & complex_copy_flags) &&
             src->format == dst->format &&
-            !SDL_ISPIXELFORMAT_INDEXED(src->format) &&
-            SDL_BYTESPERPIXEL(src->format) == 4 &&
-            src->format != SDL_PIXELFORMAT_ARGB2101010) {
+            (scaleMode == SDL_SCALEMODE_LINEAR ? SDL_CanStretchSurfaceLinear(src->format) : SDL_CanStretchSurfaceFiltered(src->format))) {
             // fast path
-            return SDL_StretchSurface(src, srcrect, dst, dstrect, SDL_SCALEMODE_LINEAR);
+            return SDL_StretchSurface(src, srcrect, dst, dstrect, scaleMode);
         } else if (SDL_BITSPERPIXEL(src->format) < 8) {
             // Scaling bitmap not yet supported, convert to RGBA for blit
             bool result = false;
@@ -1357,7 +1467,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
             if (is_complex_copy_flags || src->format != dst->format) {
                 SDL_Rect tmprect;
                 SDL_Surface *tmp2 = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
-                SDL_StretchSurface(src, &srcrect2, tmp2, NULL, SDL_SCALEMODE_LINEAR);
+                SDL_StretchSurface(src, &srcrect2, tmp2, NULL, scaleMode);
 
                 SDL_SetSurfaceColorMod(tmp2, r, g, b);
                 SDL_SetSurfaceAlphaMod(tmp2, alpha);
@@ -1370,7 +1480,7 @@ bool SDL_BlitSurfaceUncheckedScaled(SDL_Surface *src, const SDL_Rect *srcrect, S
                 result = SDL_BlitSurfaceUnchecked(tmp2, &tmprect, dst, dstrect);
                 SDL_DestroySurface(tmp2);
             } else {
-                result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, SDL_SCALEMODE_LINEAR);
+                result = SDL_StretchSurface(src, &srcrect2, dst, dstrect, scaleMode);
             }
 
             SDL_DestroySurface(tmp1);
@@ -1484,6 +1594,63 @@ bool SDL_BlitSurfaceTiled(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface
     return true;
 }
 
+/*
+ * Scale a rectangle of a surface into a new surface of the same format. The
+ * new surface gets the palette, colorkey, blend mode and modulation of the
+ * original, which are not applied while scaling.
+ */
+static SDL_Surface *SDL_ScaleSurfaceRect(SDL_Surface *surface, const SDL_Rect *srcrect, int width, int height, SDL_ScaleMode scaleMode)
+{
+    SDL_Surface *convert;
+    Uint32 copy_flags;
+    SDL_Color copy_color;
+    bool rc;
+
+    // Create a new surface with the desired size
+    convert = SDL_CreateSurface(width, height, surface->format);
+    if (!convert) {
+        return NULL;
+    }
+    SDL_SetSurfacePalette(convert, surface->palette);
+    SDL_SetSurfaceColorspace(convert, surface->colorspace);
+
+    // Save the original copy flags
+    copy_flags = surface->map.info.flags;
+    copy_color.r = surface->map.info.r;
+    copy_color.g = surface->map.info.g;
+    copy_color.b = surface->map.info.b;
+    copy_color.a = surface->map.info.a;
+    surface->map.info.r = 0xFF;
+    surface->map.info.g = 0xFF;
+    surface->map.info.b = 0xFF;
+    surface->map.info.a = 0xFF;
+    surface->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    SDL_InvalidateMap(&surface->map);
+
+    rc = SDL_BlitSurfaceScaled(surface, srcrect, convert, NULL, scaleMode);
+
+    // Clean up the original surface, and update converted surface
+    convert->map.info.r = copy_color.r;
+    convert->map.info.g = copy_color.g;
+    convert->map.info.b = copy_color.b;
+    convert->map.info.a = copy_color.a;
+    convert->map.info.colorkey = surface->map.info.colorkey;
+    convert->map.info.flags = (copy_flags & ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    surface->map.info.r = copy_color.r;
+    surface->map.info.g = copy_color.g;
+    surface->map.info.b = copy_color.b;
+    surface->map.info.a = copy_color.a;
+    surface->map.info.flags = copy_flags;
+    SDL_InvalidateMap(&surface->map);
+
+    // SDL_BlitSurfaceScaled failed, and so the conversion
+    if (!rc) {
+        SDL_DestroySurface(convert);
+        return NULL;
+    }
+    return convert;
+}
+
 bool SDL_BlitSurfaceTiledWithScale(SDL_Surface *src, const SDL_Rect *srcrect, float scale, SDL_ScaleMode scaleMode, SDL_Surface *dst, const SDL_Rect *dstrect)
 {
     SDL_Rect r_src, r_dst;
@@ -1553,6 +1720,19 @@ bool SDL_BlitSurfaceTiledWithScale(SDL_Surface *src, const SDL_Rect *srcrect, fl
     int remaining_src_h = (int)(remaining_dst_h / scale);
     SDL_Rect curr_src, curr_dst;
 
+    /* If the tile is drawn more than once, scale it once up front and tile
+       that, so that all the full tiles are plain copies. */
+    if (scale != 1.0f && tile_width > 0 && tile_height > 0 &&
+        (rows + (remaining_dst_h > 0)) * (cols + (remaining_dst_w > 0)) > 1 &&
+        !SDL_ISPIXELFORMAT_FOURCC(src->format)) {
+        SDL_Surface *tile = SDL_ScaleSurfaceRect(src, &r_src, tile_width, tile_height, scaleMode);
+        if (tile) {
+            bool result = SDL_BlitSurfaceTiled(tile, NULL, dst, &r_dst);
+            SDL_DestroySurface(tile);
+            return result;
+        }
+    }
+
     SDL_copyp(&curr_src, &r_src);
     curr_dst.y = r_dst.y;
     curr_dst.w = tile_width;
@@ -1735,6 +1915,172 @@ bool SDL_BlitSurface9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_wi
     return true;
 }
 
+struct SDL_Prepared9Grid
+{
+    SDL_Surface *src;
+    SDL_Rect srcrect;
+    int left_width;
+    int right_width;
+    int top_height;
+    int bottom_height;
+    float scale;
+    SDL_ScaleMode scaleMode;
+
+    // The grid drawn at the size of the last destination rectangle
+    SDL_Surface *panel;
+};
+
+SDL_Prepared9Grid *SDL_Prepare9Grid(SDL_Surface *src, const SDL_Rect *srcrect, int left_width, int right_width, int top_height, int bottom_height, float scale, SDL_ScaleMode scaleMode)
+{
+    SDL_Prepared9Grid *grid;
+
+    if (!SDL_SurfaceValid(src)) {
+        SDL_InvalidParamError("src");
+        return NULL;
+    }
+    if (SDL_ISPIXELFORMAT_FOURCC(src->format)) {
+        SDL_SetError("Unsupported pixel format");
+        return NULL;
+    }
+
+    grid = (SDL_Prepared9Grid *)SDL_calloc(1, sizeof(*grid));
+    if (!grid) {
+        return NULL;
+    }
+
+    if (srcrect) {
+        grid->srcrect = *srcrect;
+    } else {
+        grid->srcrect.w = src->w;
+        grid->srcrect.h = src->h;
+    }
+    grid->left_width = left_width;
+    grid->right_width = right_width;
+    grid->top_height = top_height;
+    grid->bottom_height = bottom_height;
+    grid->scale = scale;
+    grid->scaleMode = scaleMode;
+
+    // Keep the source alive as long as the grid
+    grid->src = src;
+    ++src->refcount;
+
+    return grid;
+}
+
+static bool SDL_UpdatePrepared9GridPanel(SDL_Prepared9Grid *grid, int w, int h)
+{
+    SDL_Surface *src = grid->src;
+    SDL_Surface *panel = grid->panel;
+    Uint32 copy_flags;
+    SDL_Color copy_color;
+    bool rc;
+
+    if (panel && panel->w == w && panel->h == h) {
+        return true;
+    }
+
+    SDL_DestroySurface(panel);
+    grid->panel = NULL;
+
+    panel = SDL_CreateSurface(w, h, src->format);
+    if (!panel) {
+        return false;
+    }
+    SDL_SetSurfacePalette(panel, src->palette);
+    SDL_SetSurfaceColorspace(panel, src->colorspace);
+
+    // Draw the grid with the source copy flags disabled, they're applied when the panel is blitted
+    copy_flags = src->map.info.flags;
+    copy_color.r = src->map.info.r;
+    copy_color.g = src->map.info.g;
+    copy_color.b = src->map.info.b;
+    copy_color.a = src->map.info.a;
+    src->map.info.r = 0xFF;
+    src->map.info.g = 0xFF;
+    src->map.info.b = 0xFF;
+    src->map.info.a = 0xFF;
+    src->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
+    SDL_InvalidateMap(&src->map);
+
+    rc = SDL_BlitSurface9Grid(src, &grid->srcrect, grid->left_width, grid->right_width, grid->top_height, grid->bottom_height, grid->scale, grid->scaleMode, panel, NULL);
+
+    src->map.info.r = copy_color.r;
+    src->map.info.g = copy_color.g;
+    src->map.info.b = copy_color.b;
+    src->map.info.a = copy_color.a;
+    src->map.info.flags = copy_flags;
+    SDL_InvalidateMap(&src->map);
+
+    if (!rc) {
+        SDL_DestroySurface(panel);
+        return false;
+    }
+    grid->panel = panel;
+    return true;
+}
+
+bool SDL_BlitPrepared9Grid(SDL_Prepared9Grid *grid, SDL_Surface *dst, const SDL_Rect *dstrect)
+{
+    SDL_Surface *src, *panel;
+    SDL_Rect full_dst;
+    Uint32 flags;
+
+    if (!grid) {
+        return SDL_InvalidParamError("grid");
+    } else if (!SDL_SurfaceValid(dst)) {
+        return SDL_InvalidParamError("dst");
+    }
+    src = grid->src;
+
+    if (!dstrect) {
+        full_dst.x = 0;
+        full_dst.y = 0;
+        full_dst.w = dst->w;
+        full_dst.h = dst->h;
+        dstrect = &full_dst;
+    }
+    if (dstrect->w <= 0 || dstrect->h <= 0) {
+        return true;
+    }
+
+    if (!SDL_UpdatePrepared9GridPanel(grid, dstrect->w, dstrect->h)) {
+        return false;
+    }
+    panel = grid->panel;
+
+    // Pick up any changes to the blend mode, modulation and colorkey of the source
+    flags = (src->map.info.flags & (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY));
+    if ((panel->map.info.flags & (SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY)) != flags ||
+        panel->map.info.r != src->map.info.r ||
+        panel->map.info.g != src->map.info.g ||
+        panel->map.info.b != src->map.info.b ||
+        panel->map.info.a != src->map.info.a ||
+        panel->map.info.colorkey != src->map.info.colorkey) {
+        panel->map.info.flags = (panel->map.info.flags & ~(SDL_COPY_MODULATE_MASK | SDL_COPY_BLEND_MASK | SDL_COPY_COLORKEY)) | flags;
+        panel->map.info.r = src->map.info.r;
+        panel->map.info.g = src->map.info.g;
+        panel->map.info.b = src->map.info.b;
+        panel->map.info.a = src->map.info.a;
+        panel->map.info.colorkey = src->map.info.colorkey;
+        SDL_InvalidateMap(&panel->map);
+    }
+
+    full_dst = *dstrect;
+    return SDL_BlitSurface(panel, NULL, dst, &full_dst);
+}
+
+void SDL_DestroyPrepared9Grid(SDL_Prepared9Grid *grid)
+{
+    if (!grid) {
+        return;
+    }
+
+    SDL_DestroySurface(grid->panel);
+    SDL_DestroySurface(grid->src);
+    SDL_free(grid);
+}
+
 /*
  * Lock a surface to directly access the pixels
  */
@@ -1755,6 +2101,9 @@ bool SDL_LockSurface(SDL_Surface *surface)
 #endif
     }
 
+    // The application may write to the pixels while they're locked
+    SDL_MarkSurfaceModified(surface);
+
     // Increment the surface lock count, for recursive locks
     ++surface->locked;
     surface->flags |= SDL_SURFACE_LOCKED;
@@ -1865,6 +2214,8 @@ bool SDL_FlipSurface(SDL_Surface *surface, SDL_FlipMode flip)
         return true;
     }
 
+    SDL_MarkSurfaceModified(surface);
+
     switch (flip) {
     case SDL_FLIP_HORIZONTAL:
         return SDL_FlipSurfaceHorizontal(surface);
@@ -2172,11 +2523,6 @@ SDL_Surface *SDL_DuplicateSurface(SDL_Surface *surface)
 
 SDL_Surface *SDL_ScaleSurface(SDL_Surface *surface, int width, int height, SDL_ScaleMode scaleMode)
 {
-    SDL_Surface *convert = NULL;
-    Uint32 copy_flags;
-    SDL_Color copy_color;
-    bool rc;
-
     if (!SDL_SurfaceValid(surface)) {
         SDL_InvalidParamError("surface");
         goto error;
@@ -2201,54 +2547,9 @@ SDL_Surface *SDL_ScaleSurface(SDL_Surface *surface, int width, int height, SDL_S
         return result;
     }
 
-    // Create a new surface with the desired size
-    convert = SDL_CreateSurface(width, height, surface->format);
-    if (!convert) {
-        goto error;
-    }
-    SDL_SetSurfacePalette(convert, surface->palette);
-    SDL_SetSurfaceColorspace(convert, surface->colorspace);
-
-    // Save the original copy flags
-    copy_flags = surface->map.info.flags;
-    copy_color.r = surface->map.info.r;
-    copy_color.g = surface->map.info.g;
-    copy_color.b = surface->map.info.b;
-    copy_color.a = surface->map.info.a;
-    surface->map.info.r = 0xFF;
-    surface->map.info.g = 0xFF;
-    surface->map.info.b = 0xFF;
-    surface->map.info.a = 0xFF;
-    surface->map.info.flags = (copy_flags & (SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
-    SDL_InvalidateMap(&surface->map);
-
-    rc = SDL_BlitSurfaceScaled(surface, NULL, convert, NULL, scaleMode);
-
-    // Clean up the original surface, and update converted surface
-    convert->map.info.r = copy_color.r;
-    convert->map.info.g = copy_color.g;
-    convert->map.info.b = copy_color.b;
-    convert->map.info.a = copy_color.a;
-    convert->map.info.flags = (copy_flags & ~(SDL_COPY_RLE_COLORKEY | SDL_COPY_RLE_ALPHAKEY));
-    surface->map.info.r = copy_color.r;
-    surface->map.info.g = copy_color.g;
-    surface->map.info.b = copy_color.b;
-    surface->map.info.a = copy_color.a;
-    surface->map.info.flags = copy_flags;
-    SDL_InvalidateMap(&surface->map);
-
-    // SDL_BlitSurfaceScaled failed, and so the conversion
-    if (!rc) {
-        goto error;
-    }
-
-    // We're ready to go!
-    return convert;
+    return SDL_ScaleSurfaceRect(surface, NULL, width, height, scaleMode);
 
 error:
-    if (convert) {
-        SDL_DestroySurface(convert);
-    }
     return NULL;
 }
 
@@ -2474,6 +2775,223 @@ static void SDL_PremultiplyAlpha_AXYZ128(int width, int height, const void *src,
     }
 }
 
+#ifdef SDL_SSE4_1_INTRINSICS
+// Multiply each 16-bit lane by its alpha and divide by 255, rounding down like the scalar code
+static SDL_INLINE __m128i SDL_TARGETING("sse4.1") PremultiplyAlpha16SSE41(__m128i c, __m128i a)
+{
+    return _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(c, a), _mm_set1_epi16((short)0x8081)), 7);
+}
+
+static void SDL_TARGETING("sse4.1") SDL_PremultiplyAlpha_8888_SSE41(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    // Copy the alpha byte of each pixel into the 16-bit lanes of all its channels
+    const char b = (char)(alpha_shift / 8);
+    const __m128i alpha_lo = _mm_set_epi8(-1, b + 4, -1, b + 4, -1, b + 4, -1, b + 4, -1, b, -1, b, -1, b, -1, b);
+    const __m128i alpha_hi = _mm_set_epi8(-1, b + 12, -1, b + 12, -1, b + 12, -1, b + 12, -1, b + 8, -1, b + 8, -1, b + 8, -1, b + 8);
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m128i zero = _mm_setzero_si128();
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            const __m128i px = _mm_loadu_si128((const __m128i *)(src_px + i));
+            const __m128i lo = PremultiplyAlpha16SSE41(_mm_unpacklo_epi8(px, zero), _mm_shuffle_epi8(px, alpha_lo));
+            const __m128i hi = PremultiplyAlpha16SSE41(_mm_unpackhi_epi8(px, zero), _mm_shuffle_epi8(px, alpha_hi));
+            _mm_storeu_si128((__m128i *)(dst_px + i), _mm_blendv_epi8(_mm_packus_epi16(lo, hi), px, amask));
+        }
+        if (i < width) {
+            if (alpha_shift == 24) {
+                SDL_PremultiplyAlpha_AXYZ8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            } else {
+                SDL_PremultiplyAlpha_XYZA8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            }
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+#endif // SDL_SSE4_1_INTRINSICS
+
+#ifdef SDL_AVX2_INTRINSICS
+static SDL_INLINE __m256i SDL_TARGETING("avx2") PremultiplyAlpha16AVX2(__m256i c, __m256i a)
+{
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16((short)0x8081)), 7);
+}
+
+static void SDL_TARGETING("avx2") SDL_PremultiplyAlpha_8888_AVX2(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const char b = (char)(alpha_shift / 8);
+    const __m256i alpha_lo = _mm256_set_epi8(
+        -1, b + 4, -1, b + 4, -1, b + 4, -1, b + 4, -1, b, -1, b, -1, b, -1, b,
+        -1, b + 4, -1, b + 4, -1, b + 4, -1, b + 4, -1, b, -1, b, -1, b, -1, b);
+    const __m256i alpha_hi = _mm256_set_epi8(
+        -1, b + 12, -1, b + 12, -1, b + 12, -1, b + 12, -1, b + 8, -1, b + 8, -1, b + 8, -1, b + 8,
+        -1, b + 12, -1, b + 12, -1, b + 12, -1, b + 12, -1, b + 8, -1, b + 8, -1, b + 8, -1, b + 8);
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << alpha_shift));
+    const __m256i zero = _mm256_setzero_si256();
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 8 <= width; i += 8) {
+            const __m256i px = _mm256_loadu_si256((const __m256i *)(src_px + i));
+            const __m256i lo = PremultiplyAlpha16AVX2(_mm256_unpacklo_epi8(px, zero), _mm256_shuffle_epi8(px, alpha_lo));
+            const __m256i hi = PremultiplyAlpha16AVX2(_mm256_unpackhi_epi8(px, zero), _mm256_shuffle_epi8(px, alpha_hi));
+            _mm256_storeu_si256((__m256i *)(dst_px + i), _mm256_blendv_epi8(_mm256_packus_epi16(lo, hi), px, amask));
+        }
+        if (i < width) {
+            if (alpha_shift == 24) {
+                SDL_PremultiplyAlpha_AXYZ8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            } else {
+                SDL_PremultiplyAlpha_XYZA8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            }
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+#endif // SDL_AVX2_INTRINSICS
+
+#ifdef SDL_NEON_INTRINSICS
+// (x + (x >> 8) + 1) >> 8 is x / 255 rounded down for any product of two bytes
+static SDL_INLINE uint8x8_t PremultiplyAlpha8NEON(uint8x8_t c, uint8x8_t a)
+{
+    const uint16x8_t x = vmull_u8(c, a);
+    return vshrn_n_u16(vaddq_u16(vsraq_n_u16(x, x, 8), vdupq_n_u16(1)), 8);
+}
+
+static void SDL_PremultiplyAlpha_8888_NEON(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const uint32x4_t amask = vdupq_n_u32(0xFFu << alpha_shift);
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        int i = 0;
+
+        for (; i + 4 <= width; i += 4) {
+            const uint32x4_t px = vld1q_u32(src_px + i);
+            // Copy the alpha of each pixel into all four of its bytes
+            const uint32x4_t a32 = (alpha_shift == 24) ? vshrq_n_u32(px, 24) : vandq_u32(px, amask);
+            const uint8x16_t a = vreinterpretq_u8_u32(vmulq_n_u32(a32, 0x01010101));
+            const uint8x16_t c = vreinterpretq_u8_u32(px);
+            const uint8x16_t result = vcombine_u8(PremultiplyAlpha8NEON(vget_low_u8(c), vget_low_u8(a)),
+                                                  PremultiplyAlpha8NEON(vget_high_u8(c), vget_high_u8(a)));
+            vst1q_u32(dst_px + i, vbslq_u32(amask, px, vreinterpretq_u32_u8(result)));
+        }
+        if (i < width) {
+            if (alpha_shift == 24) {
+                SDL_PremultiplyAlpha_AXYZ8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            } else {
+                SDL_PremultiplyAlpha_XYZA8888(width - i, 1, src_px + i, 0, dst_px + i, 0);
+            }
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+#endif // SDL_NEON_INTRINSICS
+
+// Premultiply 8888 pixels with the alpha in the given bit position, using the fastest kernel available
+static void SDL_PremultiplyAlpha_8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_PremultiplyAlpha_8888_AVX2(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (SDL_HasSSE41()) {
+        SDL_PremultiplyAlpha_8888_SSE41(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SDL_PremultiplyAlpha_8888_NEON(width, height, src, src_pitch, dst, dst_pitch, alpha_shift);
+        return;
+    }
+#endif
+    if (alpha_shift == 24) {
+        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
+    } else {
+        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
+    }
+}
+
+/*
+ * Premultiplying sRGB pixels in linear space only depends on each color byte and the alpha,
+ * so the round trip through linear float is done once for every pair and kept in a table.
+ */
+static SDL_InitState SDL_premultiply_linear_init;
+static Uint8 SDL_premultiply_linear_table[256][256];
+
+static void InitPremultiplyLinearTable(void)
+{
+    int a, c;
+
+    if (!SDL_ShouldInit(&SDL_premultiply_linear_init)) {
+        return;
+    }
+
+    for (c = 0; c < 256; ++c) {
+        const float linear = SDL_sRGBtoLinear((float)c / 255.0f);
+
+        for (a = 0; a < 256; ++a) {
+            const float v = SDL_sRGBfromLinear(linear * ((float)a / 255.0f));
+            SDL_premultiply_linear_table[a][c] = (Uint8)SDL_roundf(SDL_clamp(v, 0.0f, 1.0f) * 255.0f);
+        }
+    }
+    SDL_SetInitialized(&SDL_premultiply_linear_init, true);
+}
+
+static void SDL_PremultiplyAlphaLinear_8888(int width, int height, const void *src, int src_pitch, void *dst, int dst_pitch, int alpha_shift)
+{
+    const int shift0 = (alpha_shift + 8) & 31;
+    const int shift1 = (alpha_shift + 16) & 31;
+    const int shift2 = (alpha_shift + 24) & 31;
+    int c;
+
+    InitPremultiplyLinearTable();
+
+    while (height--) {
+        const Uint32 *src_px = (const Uint32 *)src;
+        Uint32 *dst_px = (Uint32 *)dst;
+        for (c = width; c; --c) {
+            const Uint32 srcpixel = *src_px++;
+            const Uint32 srcA = (srcpixel >> alpha_shift) & 0xFF;
+            const Uint8 *table = SDL_premultiply_linear_table[srcA];
+
+            *dst_px++ = (srcA << alpha_shift) |
+                        ((Uint32)table[(srcpixel >> shift0) & 0xFF] << shift0) |
+                        ((Uint32)table[(srcpixel >> shift1) & 0xFF] << shift1) |
+                        ((Uint32)table[(srcpixel >> shift2) & 0xFF] << shift2);
+        }
+        src = (const Uint8 *)src + src_pitch;
+        dst = (Uint8 *)dst + dst_pitch;
+    }
+}
+
+static int GetPremultiplyAlphaShift(SDL_PixelFormat format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return 24;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
 static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch, SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch, bool linear)
 {
     SDL_Surface *convert = NULL;
@@ -2496,6 +3014,13 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
         return SDL_InvalidParamError("dst_pitch");
     }
 
+    // 8888 sRGB pixels can be premultiplied in linear space without going through a float format
+    if (linear && src_format == dst_format && GetPremultiplyAlphaShift(src_format) >= 0 &&
+        src_colorspace == SDL_COLORSPACE_SRGB && dst_colorspace == SDL_COLORSPACE_SRGB) {
+        SDL_PremultiplyAlphaLinear_8888(width, height, src, src_pitch, dst, dst_pitch, GetPremultiplyAlphaShift(src_format));
+        return true;
+    }
+
     // Use a high precision format if we're converting to linear colorspace or using high precision pixel formats
     if (linear ||
         SDL_ISPIXELFORMAT_10BIT(src_format) || SDL_BITSPERPIXEL(src_format) > 32 ||
@@ -2548,11 +3073,9 @@ static bool SDL_PremultiplyAlphaPixelsAndColorspace(int width, int height, SDL_P
     switch (format) {
     case SDL_PIXELFORMAT_ARGB8888:
     case SDL_PIXELFORMAT_ABGR8888:
-        SDL_PremultiplyAlpha_AXYZ8888(width, height, src, src_pitch, dst, dst_pitch);
-        break;
     case SDL_PIXELFORMAT_RGBA8888:
     case SDL_PIXELFORMAT_BGRA8888:
-        SDL_PremultiplyAlpha_XYZA8888(width, height, src, src_pitch, dst, dst_pitch);
+        SDL_PremultiplyAlpha_8888(width, height, src, src_pitch, dst, dst_pitch, GetPremultiplyAlphaShift(format));
         break;
     case SDL_PIXELFORMAT_ARGB128_FLOAT:
     case SDL_PIXELFORMAT_ABGR128_FLOAT:
@@ -2597,6 +3120,8 @@ bool SDL_PremultiplySurfaceAlpha(SDL_Surface *surface, bool linear)
 
     colorspace = surface->colorspace;
 
+    SDL_MarkSurfaceModified(surface);
+
     return SDL_PremultiplyAlphaPixelsAndColorspace(surface->w, surface->h, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, surface->format, colorspace, surface->props, surface->pixels, surface->pitch, linear);
 }
 
@@ -2609,6 +3134,8 @@ bool SDL_ClearSurface(SDL_Surface *surface, float r, float g, float b, float a)
         return SDL_InvalidParamError("surface");
     }
 
+    SDL_MarkSurfaceModified(surface);
+
     SDL_GetSurfaceClipRect(surface, &clip_rect);
     SDL_SetSurfaceClipRect(surface, NULL);
 
@@ -2879,6 +3406,8 @@ bool SDL_WriteSurfacePixel(SDL_Surface *surface, int x, int y, Uint8 r, Uint8 g,
         return SDL_InvalidParamError("y");
     }
 
+    SDL_MarkSurfaceModified(surface);
+
     bytes_per_pixel = SDL_BYTESPERPIXEL(surface->format);
 
     if (SDL_MUSTLOCK(surface)) {
@@ -2932,6 +3461,8 @@ bool SDL_WriteSurfacePixelFloat(SDL_Surface *surface, int x, int y, float r, flo
         return SDL_InvalidParamError("y");
     }
 
+    SDL_MarkSurfaceModified(surface);
+
     if (SDL_BYTESPERPIXEL(surface->format) <= sizeof(Uint32) && !SDL_ISPIXELFORMAT_FOURCC(surface->format)) {
         Uint8 r8, g8, b8, a8;
 
@@ -2996,6 +3527,7 @@ void SDL_DestroySurface(SDL_Surface *surface)
 
     SDL_RemoveSurfaceAlternateImages(surface);
 
+    SDL_UntrackMemoryObject(surface);
     SDL_DestroyProperties(surface->props);
 
     SDL_InvalidateMap(&surface->map);
@@ -3012,6 +3544,9 @@ void SDL_DestroySurface(SDL_Surface *surface)
 
     if (surface->flags & SDL_SURFACE_PREALLOCATED) {
         // Don't free
+    } else if (surface->internal_flags & SDL_INTERNAL_SURFACE_POOLED) {
+        // Return to the pool
+        SDL_FreePooledSurfacePixels(surface->pixels);
     } else if (surface->flags & SDL_SURFACE_SIMD_ALIGNED) {
         // Free aligned
         SDL_aligned_free(surface->pixels);
@@ -33,6 +33,7 @@ typedef Uint32 SDL_SurfaceDataFlags;
 #define SDL_INTERNAL_SURFACE_DONTFREE   0x00000001u /**< Surface is referenced internally */
 #define SDL_INTERNAL_SURFACE_STACK      0x00000002u /**< Surface is allocated on the stack */
 #define SDL_INTERNAL_SURFACE_RLEACCEL   0x00000004u /**< Surface is RLE encoded */
+#define SDL_INTERNAL_SURFACE_POOLED     0x00000008u /**< Surface pixels come from the surface pool */
 
 // Surface internal data definition
 struct SDL_Surface
@@ -70,6 +71,12 @@ struct SDL_Surface
     int num_images;
     SDL_Surface **images;
 
+    /** Scaled copies of the images, reused by SDL_GetSurfaceImage() */
+    struct SDL_SurfaceImageCache *image_cache;
+
+    /** Incremented whenever SDL may have modified the pixels */
+    Uint32 pixels_version;
+
     /** information needed for surfaces requiring locks */
     int locked;
 
@@ -80,10 +87,19 @@ struct SDL_Surface
     SDL_BlitMap map;
 };
 
+// Call this after changing a surface's pixels, so scaled copies of it are regenerated
+#define SDL_MarkSurfaceModified(surface) (++(surface)->pixels_version)
+
 // Surface functions
 extern bool SDL_SurfaceValid(SDL_Surface *surface);
 extern void SDL_UpdateSurfaceLockFlag(SDL_Surface *surface);
 extern bool SDL_CalculateSurfaceSize(SDL_PixelFormat format, int width, int height, size_t *size, size_t *pitch, bool minimalPitch);
+extern bool SDL_CanStretchSurfaceLinear(SDL_PixelFormat format);
+extern bool SDL_CanStretchSurfaceFiltered(SDL_PixelFormat format);
+extern void SDL_QuitStretch(void);
+extern void *SDL_AllocSurfacePixels(size_t size, bool *pooled);
+extern void SDL_FreePooledSurfacePixels(void *pixels);
+extern void SDL_QuitSurfacePool(void);
 extern float SDL_GetDefaultSDRWhitePoint(SDL_Colorspace colorspace);
 extern float SDL_GetSurfaceSDRWhitePoint(SDL_Surface *surface, SDL_Colorspace colorspace);
 extern float SDL_GetDefaultHDRHeadroom(SDL_Colorspace colorspace);
@@ -0,0 +1,316 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_surface_c.h"
+
+/* Pooled surface pixel memory
+
+   Buffers are rounded up to one of four sizes per power of two, so at most a
+   quarter of a buffer is wasted, and freed buffers are kept per size for the
+   next surface of a similar size. A few recently freed buffers are kept on
+   the thread that freed them, which is usually the thread that creates the
+   next temporary surface, so that round trip doesn't take the shared lock.
+
+   Each buffer starts with a header, one SIMD alignment in size so the pixels
+   stay aligned, recording its bucket and linking it into the free lists.
+*/
+
+#define SURFACE_POOL_MIN_SIZE        4096                // 2^12
+#define SURFACE_POOL_MAX_SIZE        (64 * 1024 * 1024)  // 2^26, larger buffers are allocated directly
+#define SURFACE_POOL_NUM_BUCKETS     (1 + (26 - 12) * 4) // MIN_SIZE, then four buckets per power of two up to MAX_SIZE
+#define SURFACE_POOL_MAX_CACHED      (64 * 1024 * 1024)  // freed bytes kept in the shared lists
+#define SURFACE_POOL_THREAD_BLOCKS   4                   // freed buffers kept on each thread
+#define SURFACE_POOL_THREAD_MAX_SIZE (4 * 1024 * 1024)   // larger buffers skip the thread caches
+
+typedef struct SDL_SurfacePoolBlock
+{
+    struct SDL_SurfacePoolBlock *next;
+    int bucket;
+} SDL_SurfacePoolBlock;
+
+typedef struct SDL_SurfacePoolThreadCache
+{
+    SDL_SurfacePoolBlock *blocks[SURFACE_POOL_THREAD_BLOCKS];
+    int num_blocks;
+    Uint64 allocations;
+    Uint64 hits;
+    Uint64 bytes_cached;
+    struct SDL_SurfacePoolThreadCache *next;
+} SDL_SurfacePoolThreadCache;
+
+static SDL_SpinLock SDL_surface_pool_lock;
+static SDL_TLSID SDL_surface_pool_tls;
+static SDL_SurfacePoolBlock *SDL_surface_pool_free[SURFACE_POOL_NUM_BUCKETS];
+static SDL_SurfacePoolThreadCache *SDL_surface_pool_threads;
+static Uint64 SDL_surface_pool_allocations;
+static Uint64 SDL_surface_pool_hits;
+static Uint64 SDL_surface_pool_bytes_allocated;
+static Uint64 SDL_surface_pool_bytes_allocated_high_water;
+static Uint64 SDL_surface_pool_bytes_cached;
+
+static int GetSurfacePoolBucket(size_t size)
+{
+    int octave;
+
+    if (size <= SURFACE_POOL_MIN_SIZE) {
+        return 0;
+    }
+
+    // (size - 1) >> octave is 4 to 7, giving the quarter of the power of two it falls in
+    --size;
+    octave = SDL_MostSignificantBitIndex32((Uint32)size) - 2;
+    return 1 + (octave - 10) * 4 + (int)(size >> octave) - 4;
+}
+
+static size_t GetSurfacePoolBucketSize(int bucket)
+{
+    int octave, quarter;
+
+    if (bucket == 0) {
+        return SURFACE_POOL_MIN_SIZE;
+    }
+    octave = 10 + (bucket - 1) / 4;
+    quarter = 4 + (bucket - 1) % 4;
+    return (size_t)(quarter + 1) << octave;
+}
+
+static SDL_INLINE size_t GetSurfacePoolHeaderSize(void)
+{
+    return SDL_max(SDL_GetSIMDAlignment(), sizeof(SDL_SurfacePoolBlock));
+}
+
+static SDL_INLINE SDL_SurfacePoolBlock *GetSurfacePoolBlock(void *pixels)
+{
+    return (SDL_SurfacePoolBlock *)((Uint8 *)pixels - GetSurfacePoolHeaderSize());
+}
+
+static SDL_INLINE void *GetSurfacePoolPixels(SDL_SurfacePoolBlock *block)
+{
+    return (Uint8 *)block + GetSurfacePoolHeaderSize();
+}
+
+// Frees a block that is no longer tracked by any list, called with the lock held
+static void FreeSurfacePoolBlock(SDL_SurfacePoolBlock *block)
+{
+    SDL_surface_pool_bytes_allocated -= GetSurfacePoolBucketSize(block->bucket);
+    SDL_aligned_free(block);
+}
+
+static void CleanupSurfacePoolThreadCache(void *data)
+{
+    SDL_SurfacePoolThreadCache *cache = (SDL_SurfacePoolThreadCache *)data;
+    SDL_SurfacePoolThreadCache **prev;
+    int i;
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    for (i = 0; i < cache->num_blocks; ++i) {
+        FreeSurfacePoolBlock(cache->blocks[i]);
+    }
+
+    // Keep the statistics of the thread around
+    SDL_surface_pool_allocations += cache->allocations;
+    SDL_surface_pool_hits += cache->hits;
+
+    for (prev = &SDL_surface_pool_threads; *prev; prev = &(*prev)->next) {
+        if (*prev == cache) {
+            *prev = cache->next;
+            break;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    SDL_free(cache);
+}
+
+static SDL_SurfacePoolThreadCache *GetSurfacePoolThreadCache(void)
+{
+    SDL_SurfacePoolThreadCache *cache = (SDL_SurfacePoolThreadCache *)SDL_GetTLS(&SDL_surface_pool_tls);
+    if (!cache) {
+        cache = (SDL_SurfacePoolThreadCache *)SDL_calloc(1, sizeof(*cache));
+        if (!cache) {
+            return NULL;
+        }
+        if (!SDL_SetTLS(&SDL_surface_pool_tls, cache, CleanupSurfacePoolThreadCache)) {
+            SDL_free(cache);
+            return NULL;
+        }
+
+        SDL_LockSpinlock(&SDL_surface_pool_lock);
+        cache->next = SDL_surface_pool_threads;
+        SDL_surface_pool_threads = cache;
+        SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+    }
+    return cache;
+}
+
+void *SDL_AllocSurfacePixels(size_t size, bool *pooled)
+{
+    SDL_SurfacePoolThreadCache *cache;
+    SDL_SurfacePoolBlock *block = NULL;
+    size_t bucket_size;
+    int bucket;
+    int i;
+
+    *pooled = false;
+    if (size > SURFACE_POOL_MAX_SIZE || !SDL_GetHintBoolean(SDL_HINT_SURFACE_POOL, false)) {
+        return SDL_aligned_alloc(SDL_GetSIMDAlignment(), size);
+    }
+
+    bucket = GetSurfacePoolBucket(size);
+    bucket_size = GetSurfacePoolBucketSize(bucket);
+
+    cache = GetSurfacePoolThreadCache();
+    if (cache) {
+        ++cache->allocations;
+        for (i = cache->num_blocks; i--; ) {
+            if (cache->blocks[i]->bucket == bucket) {
+                block = cache->blocks[i];
+                --cache->num_blocks;
+                SDL_memmove(&cache->blocks[i], &cache->blocks[i + 1], (cache->num_blocks - i) * sizeof(cache->blocks[0]));
+                cache->bytes_cached -= bucket_size;
+                ++cache->hits;
+                *pooled = true;
+                return GetSurfacePoolPixels(block);
+            }
+        }
+    }
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    if (!cache) {
+        ++SDL_surface_pool_allocations;
+    }
+    block = SDL_surface_pool_free[bucket];
+    if (block) {
+        SDL_surface_pool_free[bucket] = block->next;
+        SDL_surface_pool_bytes_cached -= bucket_size;
+        if (cache) {
+            ++cache->hits;
+        } else {
+            ++SDL_surface_pool_hits;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    if (!block) {
+        block = (SDL_SurfacePoolBlock *)SDL_aligned_alloc(SDL_GetSIMDAlignment(), GetSurfacePoolHeaderSize() + bucket_size);
+        if (!block) {
+            return NULL;
+        }
+        block->bucket = bucket;
+
+        SDL_LockSpinlock(&SDL_surface_pool_lock);
+        SDL_surface_pool_bytes_allocated += bucket_size;
+        if (SDL_surface_pool_bytes_allocated > SDL_surface_pool_bytes_allocated_high_water) {
+            SDL_surface_pool_bytes_allocated_high_water = SDL_surface_pool_bytes_allocated;
+        }
+        SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+    }
+    block->next = NULL;
+
+    *pooled = true;
+    return GetSurfacePoolPixels(block);
+}
+
+void SDL_FreePooledSurfacePixels(void *pixels)
+{
+    SDL_SurfacePoolBlock *block = GetSurfacePoolBlock(pixels);
+    const size_t bucket_size = GetSurfacePoolBucketSize(block->bucket);
+    SDL_SurfacePoolThreadCache *cache;
+
+    if (bucket_size <= SURFACE_POOL_THREAD_MAX_SIZE) {
+        cache = GetSurfacePoolThreadCache();
+        if (cache) {
+            if (cache->num_blocks == SURFACE_POOL_THREAD_BLOCKS) {
+                // Move the oldest buffer to the shared lists to make room
+                SDL_SurfacePoolBlock *oldest = cache->blocks[0];
+                SDL_memmove(&cache->blocks[0], &cache->blocks[1], (SURFACE_POOL_THREAD_BLOCKS - 1) * sizeof(cache->blocks[0]));
+                cache->blocks[SURFACE_POOL_THREAD_BLOCKS - 1] = block;
+                cache->bytes_cached += bucket_size - GetSurfacePoolBucketSize(oldest->bucket);
+                block = oldest;
+            } else {
+                cache->blocks[cache->num_blocks++] = block;
+                cache->bytes_cached += bucket_size;
+                return;
+            }
+        }
+    }
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    if (SDL_surface_pool_bytes_cached + GetSurfacePoolBucketSize(block->bucket) <= SURFACE_POOL_MAX_CACHED) {
+        block->next = SDL_surface_pool_free[block->bucket];
+        SDL_surface_pool_free[block->bucket] = block;
+        SDL_surface_pool_bytes_cached += GetSurfacePoolBucketSize(block->bucket);
+    } else {
+        FreeSurfacePoolBlock(block);
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+}
+
+bool SDL_GetSurfacePoolStats(SDL_SurfacePoolStats *stats)
+{
+    SDL_SurfacePoolThreadCache *cache;
+
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    stats->allocations = SDL_surface_pool_allocations;
+    stats->hits = SDL_surface_pool_hits;
+    stats->bytes_allocated = SDL_surface_pool_bytes_allocated;
+    stats->bytes_allocated_high_water = SDL_surface_pool_bytes_allocated_high_water;
+    stats->bytes_cached = SDL_surface_pool_bytes_cached;
+    for (cache = SDL_surface_pool_threads; cache; cache = cache->next) {
+        stats->allocations += cache->allocations;
+        stats->hits += cache->hits;
+        stats->bytes_cached += cache->bytes_cached;
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+
+    return true;
+}
+
+void SDL_QuitSurfacePool(void)
+{
+    SDL_SurfacePoolThreadCache *cache;
+    int i;
+
+    SDL_LockSpinlock(&SDL_surface_pool_lock);
+    for (i = 0; i < SURFACE_POOL_NUM_BUCKETS; ++i) {
+        while (SDL_surface_pool_free[i]) {
+            SDL_SurfacePoolBlock *block = SDL_surface_pool_free[i];
+            SDL_surface_pool_free[i] = block->next;
+            FreeSurfacePoolBlock(block);
+        }
+    }
+    SDL_surface_pool_bytes_cached = 0;
+
+    // The thread caches themselves are freed as their threads clean up
+    for (cache = SDL_surface_pool_threads; cache; cache = cache->next) {
+        for (i = 0; i < cache->num_blocks; ++i) {
+            FreeSurfacePoolBlock(cache->blocks[i]);
+        }
+        cache->num_blocks = 0;
+        cache->bytes_cached = 0;
+    }
+    SDL_UnlockSpinlock(&SDL_surface_pool_lock);
+}
@@ -98,6 +98,10 @@ struct SDL_Window
 
     SDL_Surface *surface;
     bool surface_valid;
+    bool surface_resized;        // The surface was reallocated for a resize since the last update
+    bool surface_resize_pending; // A resize is waiting for the next update, see SDL_HINT_FRAMEBUFFER_RESIZE_COALESCE
+    int framebuffer_w;           // The allocated size of the framebuffer, if it came from SDL_GetWindowFramebufferAllocSize()
+    int framebuffer_h;
 
     bool is_hiding;
     bool restore_on_show; // Child was hidden recursively by the parent, restore when shown.
@@ -123,6 +127,11 @@ struct SDL_Window
     SDL_HitTest hit_test;
     void *hit_test_data;
 
+    SDL_OffscreenFrameCallback offscreen_frame_callback;
+    void *offscreen_frame_callback_data;
+
+    SDL_PresentationFeedback presentation;
+
     SDL_PropertiesID props;
 
     int num_renderers;
@@ -373,6 +382,8 @@ struct SDL_VideoDevice
     bool (*SetClipboardData)(SDL_VideoDevice *_this);
     void *(*GetClipboardData)(SDL_VideoDevice *_this, const char *mime_type, size_t *size);
     bool (*HasClipboardData)(SDL_VideoDevice *_this, const char *mime_type);
+    // Optional, streams clipboard data instead of going through GetClipboardData
+    SDL_IOStream *(*OpenClipboardDataIO)(SDL_VideoDevice *_this, const char *mime_type);
     /* If you implement *ClipboardData, you don't need to implement *ClipboardText */
     bool (*SetClipboardText)(SDL_VideoDevice *_this, const char *text);
     char *(*GetClipboardText)(SDL_VideoDevice *_this);
@@ -581,6 +592,7 @@ extern void SDL_OnWindowResized(SDL_Window *window);
 extern void SDL_CheckWindowPixelSizeChanged(SDL_Window *window);
 extern void SDL_OnWindowPixelSizeChanged(SDL_Window *window);
 extern void SDL_OnWindowLiveResizeUpdate(SDL_Window *window);
+extern void SDL_OnWindowPresented(SDL_Window *window, Uint64 present_ns, Uint64 refresh_ns, Uint64 missed_vblanks);
 extern void SDL_OnWindowMinimized(SDL_Window *window);
 extern void SDL_OnWindowMaximized(SDL_Window *window);
 extern void SDL_OnWindowRestored(SDL_Window *window);
@@ -595,6 +607,11 @@ extern SDL_Window *SDL_GetToplevelForKeyboardFocus(void);
 
 extern bool SDL_ShouldAllowTopmost(void);
 
+/* Framebuffer backends that can present a surface smaller than their buffer
+   call this instead of SDL_GetWindowSizeInPixels() to size the buffer, so it
+   can be reused for later sizes that fit. */
+extern void SDL_GetWindowFramebufferAllocSize(SDL_Window *window, int *w, int *h);
+
 extern void SDL_ToggleDragAndDropSupport(void);
 
 extern void SDL_UpdateDesktopBounds(void);
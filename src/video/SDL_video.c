@@ -33,6 +33,7 @@
 #include "../events/SDL_events_c.h"
 #include "../SDL_hints_c.h"
 #include "../SDL_properties_c.h"
+#include "../stdlib/SDL_sysstdlib.h"
 #include "../timer/SDL_timer_c.h"
 #include "../camera/SDL_camera_c.h"
 #include "../render/SDL_sysrender.h"
@@ -266,6 +267,8 @@ static void SDL_UpdateWindowHierarchy(SDL_Window *window, SDL_Window *parent)
 
 #define SDL_PROP_WINDOW_TEXTUREDATA_POINTER "SDL.internal.window.texturedata"
 
+static SDL_PropertyKey SDL_window_texturedata_key = SDL_PROPERTY_KEY(SDL_PROP_WINDOW_TEXTUREDATA_POINTER);
+
 typedef struct
 {
     SDL_Renderer *renderer;
@@ -273,8 +276,52 @@ typedef struct
     void *pixels;
     int pitch;
     int bytes_per_pixel;
+    bool texture_pixels; // pixels is the texture's own staging memory, unlocking a rect uploads it
 } SDL_WindowTextureData;
 
+typedef enum
+{
+    SDL_FRAMEBUFFER_PRECISION_8BIT,
+    SDL_FRAMEBUFFER_PRECISION_10BIT,
+    SDL_FRAMEBUFFER_PRECISION_FLOAT
+} SDL_FramebufferPrecision;
+
+static SDL_FramebufferPrecision SDL_GetFramebufferPrecision(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_FRAMEBUFFER_PRECISION);
+
+    if (hint) {
+        if (SDL_strcasecmp(hint, "10bit") == 0) {
+            return SDL_FRAMEBUFFER_PRECISION_10BIT;
+        } else if (SDL_strcasecmp(hint, "float") == 0) {
+            return SDL_FRAMEBUFFER_PRECISION_FLOAT;
+        }
+    }
+    return SDL_FRAMEBUFFER_PRECISION_8BIT;
+}
+
+static SDL_Renderer *SDL_CreateWindowTextureRenderer(SDL_Window *window, const char *name, SDL_FramebufferPrecision precision)
+{
+    SDL_Renderer *renderer;
+    SDL_PropertiesID props;
+
+    if (precision == SDL_FRAMEBUFFER_PRECISION_8BIT) {
+        return SDL_CreateRenderer(window, name);
+    }
+
+    // Render in linear space so values outside the SDR range reach an HDR display
+    props = SDL_CreateProperties();
+    if (!props) {
+        return NULL;
+    }
+    SDL_SetPointerProperty(props, SDL_PROP_RENDERER_CREATE_WINDOW_POINTER, window);
+    SDL_SetStringProperty(props, SDL_PROP_RENDERER_CREATE_NAME_STRING, name);
+    SDL_SetNumberProperty(props, SDL_PROP_RENDERER_CREATE_OUTPUT_COLORSPACE_NUMBER, SDL_COLORSPACE_SRGB_LINEAR);
+    renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    return renderer;
+}
+
 static Uint32 SDL_DefaultGraphicsBackends(SDL_VideoDevice *_this)
 {
 #if (defined(SDL_VIDEO_OPENGL) && defined(SDL_PLATFORM_MACOS)) || (defined(SDL_PLATFORM_IOS) && !TARGET_OS_MACCATALYST)
@@ -305,20 +352,23 @@ static void SDLCALL SDL_CleanupWindowTextureData(void *userdata, void *value)
     if (data->renderer) {
         SDL_DestroyRenderer(data->renderer);
     }
-    SDL_free(data->pixels);
+    if (!data->texture_pixels) {
+        SDL_free(data->pixels);
+    }
     SDL_free(data);
 }
 
 static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format, void **pixels, int *pitch)
 {
     SDL_PropertiesID props = SDL_GetWindowProperties(window);
-    SDL_WindowTextureData *data = (SDL_WindowTextureData *)SDL_GetPointerProperty(props, SDL_PROP_WINDOW_TEXTUREDATA_POINTER, NULL);
+    SDL_WindowTextureData *data = (SDL_WindowTextureData *)SDL_GetPointerPropertyByKey(props, &SDL_window_texturedata_key, NULL);
     const bool transparent = (window->flags & SDL_WINDOW_TRANSPARENT) ? true : false;
+    const SDL_FramebufferPrecision precision = SDL_GetFramebufferPrecision();
     int i;
     int w, h;
     const SDL_PixelFormat *texture_formats;
 
-    SDL_GetWindowSizeInPixels(window, &w, &h);
+    SDL_GetWindowFramebufferAllocSize(window, &w, &h);
 
     if (!data) {
         SDL_Renderer *renderer = NULL;
@@ -368,7 +418,7 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
 
         // Check to see if there's a specific driver requested
         if (render_driver) {
-            renderer = SDL_CreateRenderer(window, render_driver);
+            renderer = SDL_CreateWindowTextureRenderer(window, render_driver, precision);
             SDL_free(render_driver_copy);
             if (!renderer) {
                 // The error for this specific renderer has already been set
@@ -380,7 +430,7 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
             for (i = 0; i < total; ++i) {
                 const char *name = SDL_GetRenderDriver(i);
                 if (name && SDL_strcmp(name, SDL_SOFTWARE_RENDERER) != 0) {
-                    renderer = SDL_CreateRenderer(window, name);
+                    renderer = SDL_CreateWindowTextureRenderer(window, name, precision);
                     if (renderer) {
                         break; // this will work.
                     }
@@ -399,7 +449,7 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
             SDL_DestroyRenderer(renderer);
             return false;
         }
-        if (!SDL_SetPointerPropertyWithCleanup(props, SDL_PROP_WINDOW_TEXTUREDATA_POINTER, data, SDL_CleanupWindowTextureData, NULL)) {
+        if (!SDL_SetPointerPropertyWithCleanupByKey(props, &SDL_window_texturedata_key, data, SDL_CleanupWindowTextureData, NULL)) {
             SDL_DestroyRenderer(renderer);
             return false;
         }
@@ -417,13 +467,36 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
         SDL_DestroyTexture(data->texture);
         data->texture = NULL;
     }
-    SDL_free(data->pixels);
+    if (!data->texture_pixels) {
+        SDL_free(data->pixels);
+    }
     data->pixels = NULL;
+    data->texture_pixels = false;
 
     // Find the first format with or without an alpha channel
-    *format = texture_formats[0];
+    *format = SDL_PIXELFORMAT_UNKNOWN;
+
+    // Prefer a high precision format if one was requested and the renderer has one
+    if (precision != SDL_FRAMEBUFFER_PRECISION_8BIT) {
+        for (i = 0; texture_formats[i] != SDL_PIXELFORMAT_UNKNOWN; ++i) {
+            SDL_PixelFormat texture_format = texture_formats[i];
+            bool match;
+            if (SDL_ISPIXELFORMAT_FOURCC(texture_format)) {
+                continue;
+            }
+            if (precision == SDL_FRAMEBUFFER_PRECISION_10BIT) {
+                match = SDL_ISPIXELFORMAT_10BIT(texture_format) && transparent == SDL_ISPIXELFORMAT_ALPHA(texture_format);
+            } else {
+                match = SDL_ISPIXELFORMAT_FLOAT(texture_format);
+            }
+            if (match) {
+                *format = texture_format;
+                break;
+            }
+        }
+    }
 
-    for (i = 0; texture_formats[i] != SDL_PIXELFORMAT_UNKNOWN; ++i) {
+    for (i = 0; *format == SDL_PIXELFORMAT_UNKNOWN && texture_formats[i] != SDL_PIXELFORMAT_UNKNOWN; ++i) {
         SDL_PixelFormat texture_format = texture_formats[i];
         if (!SDL_ISPIXELFORMAT_FOURCC(texture_format) &&
             !SDL_ISPIXELFORMAT_10BIT(texture_format) &&
@@ -433,6 +506,9 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
             break;
         }
     }
+    if (*format == SDL_PIXELFORMAT_UNKNOWN) {
+        *format = texture_formats[0];
+    }
 
     data->texture = SDL_CreateTexture(data->renderer, *format,
                                       SDL_TEXTUREACCESS_STREAMING,
@@ -446,7 +522,21 @@ static bool SDL_CreateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window,
     data->bytes_per_pixel = SDL_BYTESPERPIXEL(*format);
     data->pitch = (((w * data->bytes_per_pixel) + 3) & ~3);
 
-    {
+    /* If the renderer keeps a persistent staging copy of streaming textures,
+       let the application draw straight into it. Updates then only have to
+       lock and unlock the dirty rects, which uploads them without a copy. */
+    if (data->renderer->persistent_texture_lock && !data->texture->native) {
+        void *texture_pixels;
+        int texture_pitch;
+        if (SDL_LockTexture(data->texture, NULL, &texture_pixels, &texture_pitch)) {
+            SDL_UnlockTexture(data->texture);
+            data->pixels = texture_pixels;
+            data->pitch = texture_pitch;
+            data->texture_pixels = true;
+        }
+    }
+
+    if (!data->pixels) {
         // Make static analysis happy about potential SDL_malloc(0) calls.
         const size_t allocsize = (size_t)h * data->pitch;
         data->pixels = SDL_malloc((allocsize > 0) ? allocsize : 1);
@@ -468,7 +558,7 @@ bool SDL_SetWindowTextureVSync(SDL_VideoDevice *_this, SDL_Window *window, int v
 {
     SDL_WindowTextureData *data;
 
-    data = (SDL_WindowTextureData *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_TEXTUREDATA_POINTER, NULL);
+    data = (SDL_WindowTextureData *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_texturedata_key, NULL);
     if (!data) {
         return false;
     }
@@ -482,7 +572,7 @@ static bool SDL_GetWindowTextureVSync(SDL_VideoDevice *_this, SDL_Window *window
 {
     SDL_WindowTextureData *data;
 
-    data = (SDL_WindowTextureData *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_TEXTUREDATA_POINTER, NULL);
+    data = (SDL_WindowTextureData *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_texturedata_key, NULL);
     if (!data) {
         return false;
     }
@@ -492,30 +582,74 @@ static bool SDL_GetWindowTextureVSync(SDL_VideoDevice *_this, SDL_Window *window
     return SDL_GetRenderVSync(data->renderer, vsync);
 }
 
+static bool SDL_UploadWindowTextureRect(SDL_WindowTextureData *data, const SDL_Rect *rect)
+{
+    if (data->texture_pixels) {
+        void *pixels;
+        int pitch;
+
+        // The pixels are already in the texture's staging memory, unlocking uploads them
+        if (!SDL_LockTexture(data->texture, rect, &pixels, &pitch)) {
+            return false;
+        }
+        SDL_UnlockTexture(data->texture);
+        return true;
+    } else {
+        const void *src = (const void *)((Uint8 *)data->pixels +
+                                         rect->y * data->pitch +
+                                         rect->x * data->bytes_per_pixel);
+        return SDL_UpdateTexture(data->texture, rect, src, data->pitch);
+    }
+}
+
 static bool SDL_UpdateWindowTexture(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
 {
     SDL_WindowTextureData *data;
     SDL_Rect rect;
-    void *src;
     int w, h;
 
     SDL_GetWindowSizeInPixels(window, &w, &h);
 
-    data = (SDL_WindowTextureData *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), SDL_PROP_WINDOW_TEXTUREDATA_POINTER, NULL);
+    data = (SDL_WindowTextureData *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_window_texturedata_key, NULL);
     if (!data || !data->texture) {
         return SDL_SetError("No window texture data");
     }
 
-    // Update a single rect that contains subrects for best DMA performance
     if (SDL_GetSpanEnclosingRect(w, h, numrects, rects, &rect)) {
-        src = (void *)((Uint8 *)data->pixels +
-                       rect.y * data->pitch +
-                       rect.x * data->bytes_per_pixel);
-        if (!SDL_UpdateTexture(data->texture, &rect, src, data->pitch)) {
-            return false;
+        const SDL_Rect bounds = { 0, 0, w, h };
+        SDL_Rect clipped;
+        Sint64 dirty_area = 0;
+        int i;
+
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_GetRectIntersection(&rects[i], &bounds, &clipped)) {
+                dirty_area += (Sint64)clipped.w * clipped.h;
+            }
         }
 
-        if (!SDL_RenderTexture(data->renderer, data->texture, NULL, NULL)) {
+        if (numrects > 1 && dirty_area * 2 < (Sint64)rect.w * rect.h) {
+            // The rects are scattered, upload just those instead of every row between them
+            for (i = 0; i < numrects; ++i) {
+                if (SDL_GetRectIntersection(&rects[i], &bounds, &clipped)) {
+                    if (!SDL_UploadWindowTextureRect(data, &clipped)) {
+                        return false;
+                    }
+                }
+            }
+        } else {
+            // Update a single rect that contains subrects for best DMA performance
+            if (!SDL_UploadWindowTextureRect(data, &rect)) {
+                return false;
+            }
+        }
+
+        // The texture may be larger than the window after a resize, only show the surface's part of it
+        if (window->surface) {
+            const SDL_FRect srcrect = { 0.0f, 0.0f, (float)window->surface->w, (float)window->surface->h };
+            if (!SDL_RenderTexture(data->renderer, data->texture, &srcrect, NULL)) {
+                return false;
+            }
+        } else if (!SDL_RenderTexture(data->renderer, data->texture, NULL, NULL)) {
             return false;
         }
 
@@ -2337,7 +2471,7 @@ static SDL_WindowFlags SDL_GetWindowFlagProperties(SDL_PropertiesID props)
     return flags;
 }
 
-SDL_Window *SDL_CreateWindowWithProperties(SDL_PropertiesID props)
+static SDL_Window *SDL_CreateWindowWithPropertiesInternal(SDL_PropertiesID props)
 {
     SDL_Window *window;
     const char *title = SDL_GetStringProperty(props, SDL_PROP_WINDOW_CREATE_TITLE_STRING, NULL);
@@ -2558,6 +2692,14 @@ SDL_Window *SDL_CreateWindowWithProperties(SDL_PropertiesID props)
     return window;
 }
 
+SDL_Window *SDL_CreateWindowWithProperties(SDL_PropertiesID props)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_VIDEO);
+    SDL_Window *result = SDL_CreateWindowWithPropertiesInternal(props);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 SDL_Window *SDL_CreateWindow(const char *title, int w, int h, SDL_WindowFlags flags)
 {
     SDL_Window *window;
@@ -3467,6 +3609,9 @@ static bool ShouldAttemptTextureFramebuffer(void)
         } else {
             attempt_texture_framebuffer = true;
         }
+    } else if (SDL_GetFramebufferPrecision() != SDL_FRAMEBUFFER_PRECISION_8BIT) {
+        // Native window framebuffers are 8 bits per channel, only a texture framebuffer can do better
+        attempt_texture_framebuffer = true;
     } else {
         // Check for platform specific defaults
 #ifdef SDL_PLATFORM_LINUX
@@ -3486,10 +3631,31 @@ static bool ShouldAttemptTextureFramebuffer(void)
 #ifdef SDL_PLATFORM_EMSCRIPTEN
         attempt_texture_framebuffer = false;
 #endif
+        // Nothing ever shows an offscreen texture, and frames can only be saved or exported from the surface.
+        if (SDL_strcmp(_this->name, "offscreen") == 0) {
+            attempt_texture_framebuffer = false;
+        }
     }
     return attempt_texture_framebuffer;
 }
 
+void SDL_GetWindowFramebufferAllocSize(SDL_Window *window, int *w, int *h)
+{
+    SDL_GetWindowSizeInPixels(window, w, h);
+
+    // The first surface gets its exact size, only resizes round up
+    if (window->surface_resized && *w > 0 && *h > 0) {
+        const char *hint = SDL_GetHint(SDL_HINT_FRAMEBUFFER_RESIZE_BUCKET);
+        const int bucket = hint ? SDL_atoi(hint) : 256;
+        if (bucket > 1) {
+            *w = ((*w + bucket - 1) / bucket) * bucket;
+            *h = ((*h + bucket - 1) / bucket) * bucket;
+        }
+    }
+    window->framebuffer_w = *w;
+    window->framebuffer_h = *h;
+}
+
 static SDL_Surface *SDL_CreateWindowFramebuffer(SDL_Window *window)
 {
     SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;
@@ -3500,6 +3666,10 @@ static SDL_Surface *SDL_CreateWindowFramebuffer(SDL_Window *window)
 
     SDL_GetWindowSizeInPixels(window, &w, &h);
 
+    // Only backends that call SDL_GetWindowFramebufferAllocSize() can have their framebuffer reused
+    window->framebuffer_w = 0;
+    window->framebuffer_h = 0;
+
     /* This will switch the video backend from using a software surface to
        using a GPU texture through the 2D render API, if we think this would
        be more efficient. This only checks once, on demand. */
@@ -3558,13 +3728,30 @@ SDL_Surface *SDL_GetWindowSurface(SDL_Window *window)
     CHECK_WINDOW_MAGIC(window, NULL);
 
     if (!window->surface_valid) {
+        SDL_Surface *reused = NULL;
+
         if (window->surface) {
+            int w, h;
+
+            /* If the new size still fits in the framebuffer and uses a good part
+               of it, keep drawing into the same memory instead of reallocating. */
+            SDL_GetWindowSizeInPixels(window, &w, &h);
+            if (w > 0 && h > 0 && w <= window->framebuffer_w && h <= window->framebuffer_h &&
+                (Sint64)w * h * 2 >= (Sint64)window->framebuffer_w * window->framebuffer_h) {
+                reused = SDL_CreateSurfaceFrom(w, h, window->surface->format, window->surface->pixels, window->surface->pitch);
+            }
+
             window->surface->internal_flags &= ~SDL_INTERNAL_SURFACE_DONTFREE;
             SDL_DestroySurface(window->surface);
             window->surface = NULL;
+            window->surface_resized = true;
         }
 
-        window->surface = SDL_CreateWindowFramebuffer(window);
+        if (reused) {
+            window->surface = reused;
+        } else {
+            window->surface = SDL_CreateWindowFramebuffer(window);
+        }
         if (window->surface) {
             window->surface_valid = true;
             window->surface->internal_flags |= SDL_INTERNAL_SURFACE_DONTFREE;
@@ -3606,7 +3793,7 @@ bool SDL_UpdateWindowSurface(SDL_Window *window)
     return SDL_UpdateWindowSurfaceRects(window, &full_rect, 1);
 }
 
-bool SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects,
+static bool SDL_UpdateWindowSurfaceRectsInternal(SDL_Window *window, const SDL_Rect *rects,
                                  int numrects)
 {
     CHECK_WINDOW_MAGIC(window, false);
@@ -3617,9 +3804,46 @@ bool SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects,
 
     SDL_assert(_this->checked_texture_framebuffer); // we should have done this before we had a valid surface.
 
+    // A frame is done, the next resize can reallocate the surface again
+    window->surface_resized = false;
+    if (window->surface_resize_pending) {
+        const SDL_Rect bounds = { 0, 0, window->surface->w, window->surface->h };
+        bool isstack;
+        SDL_Rect *clipped;
+        int numclipped = 0;
+        bool result;
+        int i;
+
+        window->surface_resize_pending = false;
+        window->surface_valid = false;
+
+        // The window may have grown past the surface, don't let the backend read beyond it
+        clipped = SDL_small_alloc(SDL_Rect, numrects > 0 ? numrects : 1, &isstack);
+        if (!clipped) {
+            return false;
+        }
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_GetRectIntersection(&rects[i], &bounds, &clipped[numclipped])) {
+                ++numclipped;
+            }
+        }
+        result = _this->UpdateWindowFramebuffer(_this, window, clipped, numclipped);
+        SDL_small_free(clipped, isstack);
+        return result;
+    }
+
     return _this->UpdateWindowFramebuffer(_this, window, rects, numrects);
 }
 
+bool SDL_UpdateWindowSurfaceRects(SDL_Window *window, const SDL_Rect *rects,
+                                 int numrects)
+{
+    const int memory_tag = SDL_PushMemoryTag(SDL_MEMORY_TAG_VIDEO);
+    bool result = SDL_UpdateWindowSurfaceRectsInternal(window, rects, numrects);
+    SDL_PopMemoryTag(memory_tag);
+    return result;
+}
+
 bool SDL_DestroyWindowSurface(SDL_Window *window)
 {
     CHECK_WINDOW_MAGIC(window, false);
@@ -3630,6 +3854,10 @@ bool SDL_DestroyWindowSurface(SDL_Window *window)
         window->surface = NULL;
         window->surface_valid = false;
     }
+    window->surface_resized = false;
+    window->surface_resize_pending = false;
+    window->framebuffer_w = 0;
+    window->framebuffer_h = 0;
 
     if (_this->checked_texture_framebuffer) { // never checked? No framebuffer to destroy. Don't risk calling the wrong implementation.
         if (_this->DestroyWindowFramebuffer) {
@@ -3639,6 +3867,45 @@ bool SDL_DestroyWindowSurface(SDL_Window *window)
     return true;
 }
 
+bool SDL_SetOffscreenFrameCallback(SDL_Window *window, SDL_OffscreenFrameCallback callback, void *userdata)
+{
+    CHECK_WINDOW_MAGIC(window, false);
+
+    if (SDL_strcmp(_this->name, "offscreen") != 0) {
+        return SDL_Unsupported();
+    }
+
+    window->offscreen_frame_callback = callback;
+    window->offscreen_frame_callback_data = userdata;
+
+    return true;
+}
+
+void SDL_OnWindowPresented(SDL_Window *window, Uint64 present_ns, Uint64 refresh_ns, Uint64 missed_vblanks)
+{
+    ++window->presentation.frames;
+    window->presentation.present_ns = present_ns;
+    window->presentation.refresh_ns = refresh_ns;
+    window->presentation.missed_vblanks += missed_vblanks;
+}
+
+bool SDL_GetWindowPresentationFeedback(SDL_Window *window, SDL_PresentationFeedback *feedback)
+{
+    CHECK_WINDOW_MAGIC(window, false);
+
+    if (!feedback) {
+        return SDL_InvalidParamError("feedback");
+    }
+
+    if (window->presentation.frames == 0) {
+        SDL_zerop(feedback);
+        return SDL_SetError("No presentation feedback available for this window");
+    }
+
+    SDL_copyp(feedback, &window->presentation);
+    return true;
+}
+
 bool SDL_SetWindowOpacity(SDL_Window *window, float opacity)
 {
     bool result;
@@ -4074,6 +4341,12 @@ void SDL_CheckWindowPixelSizeChanged(SDL_Window *window)
 
 void SDL_OnWindowPixelSizeChanged(SDL_Window *window)
 {
+    if (window->surface_valid && window->surface_resized &&
+        SDL_GetHintBoolean(SDL_HINT_FRAMEBUFFER_RESIZE_COALESCE, false)) {
+        // Already reallocated for a resize this frame, pick this one up after the next update
+        window->surface_resize_pending = true;
+        return;
+    }
     window->surface_valid = false;
 }
 
@@ -5846,9 +6119,11 @@ bool SDL_ShowSimpleMessageBox(SDL_MessageBoxFlags flags, const char *title, cons
 #endif
 }
 
+static SDL_CachedHint SDL_allow_topmost_hint = SDL_CACHED_HINT(SDL_HINT_WINDOW_ALLOW_TOPMOST, true);
+
 bool SDL_ShouldAllowTopmost(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_WINDOW_ALLOW_TOPMOST, true);
+    return SDL_GetCachedHintBoolean(&SDL_allow_topmost_hint);
 }
 
 bool SDL_ShowWindowSystemMenu(SDL_Window *window, int x, int y)
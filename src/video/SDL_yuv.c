@@ -24,6 +24,7 @@
 #include "SDL_yuv_c.h"
 
 #include "yuv2rgb/yuv_rgb.h"
+#include "../thread/SDL_jobs_c.h"
 
 
 #ifdef SDL_HAVE_YUV
@@ -302,7 +303,210 @@ static bool GetYUVPlanes(int width, int height, SDL_PixelFormat format, const vo
     return true;
 }
 
+// Large conversions are split into bands of rows when SDL_HINT_SURFACE_PARALLEL_BLIT is enabled
+#define SDL_YUV_PARALLEL_MIN_PIXELS     (512 * 512)
+#define SDL_YUV_PARALLEL_MIN_BAND_ROWS  64
+#define SDL_YUV_PARALLEL_MAX_BANDS      16
+
+// Intermediate RGB buffers only hold a strip of rows about this size, rather than the whole image
+#define SDL_YUV_STRIP_BYTES             (256 * 1024)
+
+// Move the plane pointers down to the given row, which has to be even for 2x2 subsampled formats
+static void OffsetYUVPlanes(SDL_PixelFormat format, int row, const Uint8 **y, const Uint8 **u, const Uint8 **v, Uint32 y_stride, Uint32 uv_stride)
+{
+    const int uv_row = IsPlanar2x2Format(format) ? (row / 2) : row;
+
+    SDL_assert(!IsPlanar2x2Format(format) || (row % 2) == 0);
+
+    *y += (size_t)row * y_stride;
+    *u += (size_t)uv_row * uv_stride;
+    *v += (size_t)uv_row * uv_stride;
+}
+
+static int GetYUVStripRows(int width)
+{
+    const int rows = SDL_YUV_STRIP_BYTES / SDL_max(width * (int)sizeof(Uint32), 1);
+
+    // Keep strips on chroma row boundaries
+    return SDL_max(rows & ~1, 2);
+}
+
+static int GetYUVParallelBands(int width, int height)
+{
+    int num_bands;
+
+    if ((Sint64)width * height < SDL_YUV_PARALLEL_MIN_PIXELS) {
+        return 1;
+    }
+    if (!SDL_GetHintBoolean(SDL_HINT_SURFACE_PARALLEL_BLIT, false)) {
+        return 1;
+    }
+
+    num_bands = SDL_min(SDL_GetNumLogicalCPUCores(), height / SDL_YUV_PARALLEL_MIN_BAND_ROWS);
+    num_bands = SDL_min(num_bands, SDL_YUV_PARALLEL_MAX_BANDS);
+    return SDL_max(num_bands, 1);
+}
+
+// The first row of the given band, rounded down to a chroma row boundary
+static int GetYUVBandRow(int height, int band, int num_bands)
+{
+    return (int)(((Sint64)height * band / num_bands) & ~1);
+}
+
+typedef struct SDL_YUVConversionBand
+{
+    int width;
+    int height;
+    SDL_PixelFormat src_format;
+    SDL_Colorspace src_colorspace;
+    SDL_PropertiesID src_properties;
+    SDL_PixelFormat dst_format;
+    SDL_Colorspace dst_colorspace;
+    SDL_PropertiesID dst_properties;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    Uint8 *rgb;
+    int rgb_pitch;
+    YCbCrType yuv_type;
+    bool result;
+} SDL_YUVConversionBand;
+
+// Run the bands on the job threads, returning whether they all succeeded
+static bool RunYUVConversionBands(SDL_JobFunction callback, SDL_YUVConversionBand *bands, int num_bands)
+{
+    void *userdata[SDL_YUV_PARALLEL_MAX_BANDS];
+    int i;
+
+    for (i = 0; i < num_bands; ++i) {
+        userdata[i] = &bands[i];
+    }
+    SDL_RunJobsAndWait(callback, userdata, num_bands);
+
+    // The first band runs on this thread, so any error it hit is already set
+    if (!bands[0].result) {
+        return false;
+    }
+    for (i = 1; i < num_bands; ++i) {
+        if (!bands[i].result) {
+            return SDL_SetError("YUV conversion failed on a job thread");
+        }
+    }
+    return true;
+}
+
 #ifdef SDL_SSE2_INTRINSICS
+#ifdef SDL_AVX2_INTRINSICS
+static bool yuv_rgb_avx2(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasAVX2()) {
+        return false;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_avx2(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+#endif
+
 static bool SDL_TARGETING("sse2") yuv_rgb_sse(
     SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
     Uint32 width, Uint32 height,
@@ -314,6 +518,12 @@ static bool SDL_TARGETING("sse2") yuv_rgb_sse(
         return false;
     }
 
+#ifdef SDL_AVX2_INTRINSICS
+    if (yuv_rgb_avx2(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type)) {
+        return true;
+    }
+#endif
+
     if (src_format == SDL_PIXELFORMAT_YV12 ||
         src_format == SDL_PIXELFORMAT_IYUV) {
 
@@ -421,6 +631,125 @@ static bool yuv_rgb_sse(
 }
 #endif
 
+#ifdef SDL_NEON_INTRINSICS
+static bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    if (!SDL_HasNEON()) {
+        return false;
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YV12 ||
+        src_format == SDL_PIXELFORMAT_IYUV) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv420_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv420_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv420_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv420_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv420_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv420_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuv422_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuv422_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuv422_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuv422_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuv422_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuv422_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+
+    if (src_format == SDL_PIXELFORMAT_NV12 ||
+        src_format == SDL_PIXELFORMAT_NV21) {
+
+        switch (dst_format) {
+        case SDL_PIXELFORMAT_RGB565:
+            yuvnv12_rgb565_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGB24:
+            yuvnv12_rgb24_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_RGBX8888:
+        case SDL_PIXELFORMAT_RGBA8888:
+            yuvnv12_rgba_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_BGRX8888:
+        case SDL_PIXELFORMAT_BGRA8888:
+            yuvnv12_bgra_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XRGB8888:
+        case SDL_PIXELFORMAT_ARGB8888:
+            yuvnv12_argb_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        case SDL_PIXELFORMAT_XBGR8888:
+        case SDL_PIXELFORMAT_ABGR8888:
+            yuvnv12_abgr_neon(width, height, y, u, v, y_stride, uv_stride, rgb, rgb_stride, yuv_type);
+            return true;
+        default:
+            break;
+        }
+    }
+    return false;
+}
+#else
+static bool yuv_rgb_neon(
+    SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
+    Uint32 width, Uint32 height,
+    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+    Uint8 *rgb, Uint32 rgb_stride,
+    YCbCrType yuv_type)
+{
+    return false;
+}
+#endif
+
 #ifdef SDL_LSX_INTRINSICS
 static bool yuv_rgb_lsx(
     SDL_PixelFormat src_format, SDL_PixelFormat dst_format,
@@ -586,20 +915,53 @@ static bool yuv_rgb_std(
     return false;
 }
 
-bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
-                                  SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
-                                  SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+static bool SDL_ConvertPixels_YUVPlanes_to_RGB(int width, int height,
+                                             SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties,
+                                             const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+                                             SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch);
+
+// Convert through an intermediate RGB format, a strip of rows at a time
+static bool SDL_ConvertPixels_YUVPlanes_to_RGB_Strips(int width, int height,
+                                                    SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties,
+                                                    const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+                                                    SDL_PixelFormat tmp_format, SDL_Colorspace tmp_colorspace, SDL_PropertiesID tmp_properties,
+                                                    SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
 {
-    const Uint8 *y = NULL;
-    const Uint8 *u = NULL;
-    const Uint8 *v = NULL;
-    Uint32 y_stride = 0;
-    Uint32 uv_stride = 0;
-
-    if (!GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride)) {
+    const int strip_rows = SDL_min(GetYUVStripRows(width), height);
+    const int tmp_pitch = (width * sizeof(Uint32));
+    bool result = true;
+    void *tmp;
+    int row;
+
+    tmp = SDL_malloc((size_t)tmp_pitch * strip_rows);
+    if (!tmp) {
         return false;
     }
 
+    for (row = 0; row < height && result; row += strip_rows) {
+        const int rows = SDL_min(strip_rows, height - row);
+        const Uint8 *strip_y = y;
+        const Uint8 *strip_u = u;
+        const Uint8 *strip_v = v;
+
+        OffsetYUVPlanes(src_format, row, &strip_y, &strip_u, &strip_v, y_stride, uv_stride);
+
+        // convert src/src_format to tmp/tmp_format
+        result = SDL_ConvertPixels_YUVPlanes_to_RGB(width, rows, src_format, src_colorspace, src_properties, strip_y, strip_u, strip_v, y_stride, uv_stride, tmp_format, tmp_colorspace, tmp_properties, tmp, tmp_pitch);
+        if (result) {
+            // convert tmp/tmp_format to dst/RGB
+            result = SDL_ConvertPixelsAndColorspace(width, rows, tmp_format, tmp_colorspace, tmp_properties, tmp, tmp_pitch, dst_format, dst_colorspace, dst_properties, (Uint8 *)dst + (size_t)row * dst_pitch, dst_pitch);
+        }
+    }
+    SDL_free(tmp);
+    return result;
+}
+
+static bool SDL_ConvertPixels_YUVPlanes_to_RGB(int width, int height,
+                                             SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties,
+                                             const Uint8 *y, const Uint8 *u, const Uint8 *v, Uint32 y_stride, Uint32 uv_stride,
+                                             SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
     if (SDL_COLORSPACEPRIMARIES(src_colorspace) == SDL_COLORSPACEPRIMARIES(dst_colorspace)) {
         YCbCrType yuv_type = YCBCR_601_LIMITED;
 
@@ -611,6 +973,10 @@ bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
             return true;
         }
 
+        if (yuv_rgb_neon(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+            return true;
+        }
+
         if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
             return true;
         }
@@ -622,52 +988,76 @@ bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
 
     // No fast path for the RGB format, instead convert using an intermediate buffer
     if (src_format == SDL_PIXELFORMAT_P010 && dst_format != SDL_PIXELFORMAT_XBGR2101010) {
-        bool result;
-        void *tmp;
-        int tmp_pitch = (width * sizeof(Uint32));
-
-        tmp = SDL_malloc((size_t)tmp_pitch * height);
-        if (!tmp) {
-            return false;
-        }
-
-        // convert src/src_format to tmp/XBGR2101010
-        result = SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src_colorspace, src_properties, src, src_pitch, SDL_PIXELFORMAT_XBGR2101010, src_colorspace, src_properties, tmp, tmp_pitch);
-        if (!result) {
-            SDL_free(tmp);
-            return false;
-        }
-
-        // convert tmp/XBGR2101010 to dst/RGB
-        result = SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_XBGR2101010, src_colorspace, src_properties, tmp, tmp_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-        SDL_free(tmp);
-        return result;
+        return SDL_ConvertPixels_YUVPlanes_to_RGB_Strips(width, height, src_format, src_colorspace, src_properties, y, u, v, y_stride, uv_stride,
+                                                         SDL_PIXELFORMAT_XBGR2101010, src_colorspace, src_properties,
+                                                         dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
     }
 
     if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
-        bool result;
-        void *tmp;
-        int tmp_pitch = (width * sizeof(Uint32));
+        return SDL_ConvertPixels_YUVPlanes_to_RGB_Strips(width, height, src_format, src_colorspace, src_properties, y, u, v, y_stride, uv_stride,
+                                                         SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0,
+                                                         dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
 
-        tmp = SDL_malloc((size_t)tmp_pitch * height);
-        if (!tmp) {
-            return false;
-        }
+    return SDL_SetError("Unsupported YUV conversion");
+}
 
-        // convert src/src_format to tmp/ARGB8888
-        result = SDL_ConvertPixels_YUV_to_RGB(width, height, src_format, src_colorspace, src_properties, src, src_pitch, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0, tmp, tmp_pitch);
-        if (!result) {
-            SDL_free(tmp);
-            return false;
-        }
+static void SDLCALL SDL_ConvertYUVToRGBBand(void *userdata)
+{
+    SDL_YUVConversionBand *band = (SDL_YUVConversionBand *)userdata;
 
-        // convert tmp/ARGB8888 to dst/RGB
-        result = SDL_ConvertPixelsAndColorspace(width, height, SDL_PIXELFORMAT_ARGB8888, SDL_COLORSPACE_SRGB, 0, tmp, tmp_pitch, dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
-        SDL_free(tmp);
-        return result;
+    band->result = SDL_ConvertPixels_YUVPlanes_to_RGB(band->width, band->height,
+                                                      band->src_format, band->src_colorspace, band->src_properties,
+                                                      band->y, band->u, band->v, band->y_stride, band->uv_stride,
+                                                      band->dst_format, band->dst_colorspace, band->dst_properties, band->rgb, band->rgb_pitch);
+}
+
+bool SDL_ConvertPixels_YUV_to_RGB(int width, int height,
+                                  SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                  SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    SDL_YUVConversionBand bands[SDL_YUV_PARALLEL_MAX_BANDS];
+    int num_bands;
+    int i;
+
+    if (!GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride)) {
+        return false;
     }
 
-    return SDL_SetError("Unsupported YUV conversion");
+    num_bands = GetYUVParallelBands(width, height);
+    if (num_bands < 2) {
+        return SDL_ConvertPixels_YUVPlanes_to_RGB(width, height, src_format, src_colorspace, src_properties, y, u, v, y_stride, uv_stride,
+                                                  dst_format, dst_colorspace, dst_properties, dst, dst_pitch);
+    }
+
+    for (i = 0; i < num_bands; ++i) {
+        const int row = GetYUVBandRow(height, i, num_bands);
+        SDL_YUVConversionBand *band = &bands[i];
+
+        SDL_zerop(band);
+        band->width = width;
+        band->height = ((i + 1) < num_bands ? GetYUVBandRow(height, i + 1, num_bands) : height) - row;
+        band->src_format = src_format;
+        band->src_colorspace = src_colorspace;
+        band->src_properties = src_properties;
+        band->dst_format = dst_format;
+        band->dst_colorspace = dst_colorspace;
+        band->dst_properties = dst_properties;
+        band->y = y;
+        band->u = u;
+        band->v = v;
+        band->y_stride = y_stride;
+        band->uv_stride = uv_stride;
+        OffsetYUVPlanes(src_format, row, &band->y, &band->u, &band->v, y_stride, uv_stride);
+        band->rgb = (Uint8 *)dst + (size_t)row * dst_pitch;
+        band->rgb_pitch = dst_pitch;
+    }
+    return RunYUVConversionBands(SDL_ConvertYUVToRGBBand, bands, num_bands);
 }
 
 struct RGB2YUVFactors
@@ -716,7 +1106,8 @@ static struct RGB2YUVFactors RGB2YUVFactorTables[] = {
     },
 };
 
-static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format,
+                                              Uint8 *plane_y, Uint8 *plane_u, Uint8 *plane_v, Uint32 y_stride, Uint32 uv_stride, YCbCrType yuv_type)
 {
     const int src_pitch_x_2 = src_pitch * 2;
     const int height_half = height / 2;
@@ -783,19 +1174,10 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     {
         const Uint8 *curr_row, *next_row;
 
-        Uint8 *plane_y;
-        Uint8 *plane_u;
-        Uint8 *plane_v;
         Uint8 *plane_interleaved_uv;
-        Uint32 y_stride, uv_stride, y_skip, uv_skip;
-
-        if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                          (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
-                          &y_stride, &uv_stride)) {
-            return false;
-        }
+        Uint32 y_skip, uv_skip;
 
-        plane_interleaved_uv = (plane_y + height * y_stride);
+        plane_interleaved_uv = (dst_format == SDL_PIXELFORMAT_NV21) ? plane_v : plane_u;
         y_skip = (y_stride - width);
 
         curr_row = (const Uint8 *)src;
@@ -916,14 +1298,15 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     case SDL_PIXELFORMAT_YVYU:
     {
         const Uint8 *curr_row = (const Uint8 *)src;
-        Uint8 *plane = (Uint8 *)dst;
+        // The packed layouts start with either Y or U
+        Uint8 *plane = SDL_min(plane_y, plane_u);
         const int row_size = (4 * ((width + 1) / 2));
         int plane_skip;
 
-        if (dst_pitch < row_size) {
+        if ((int)y_stride < row_size) {
             return SDL_SetError("Destination pitch is too small, expected at least %d", row_size);
         }
-        plane_skip = (dst_pitch - row_size);
+        plane_skip = ((int)y_stride - row_size);
 
         // Write YUV plane, packed
         if (dst_format == SDL_PIXELFORMAT_YUY2) {
@@ -1007,7 +1390,8 @@ static bool SDL_ConvertPixels_XRGB8888_to_YUV(int width, int height, const void
     return true;
 }
 
-static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const void *src, int src_pitch, SDL_PixelFormat dst_format, void *dst, int dst_pitch, YCbCrType yuv_type)
+static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const void *src, int src_pitch,
+                                                  Uint8 *dst_y, Uint8 *dst_uv, Uint32 y_stride, Uint32 uv_stride, YCbCrType yuv_type)
 {
     const int src_pitch_x_2 = src_pitch * 2;
     const int height_half = height / 2;
@@ -1053,22 +1437,13 @@ static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const v
 
     const Uint8 *curr_row, *next_row;
 
-    Uint16 *plane_y;
-    Uint16 *plane_u;
-    Uint16 *plane_v;
-    Uint16 *plane_interleaved_uv;
-    Uint32 y_stride, uv_stride, y_skip, uv_skip;
-
-    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch,
-                      (const Uint8 **)&plane_y, (const Uint8 **)&plane_u, (const Uint8 **)&plane_v,
-                      &y_stride, &uv_stride)) {
-        return false;
-    }
+    Uint16 *plane_y = (Uint16 *)dst_y;
+    Uint16 *plane_interleaved_uv = (Uint16 *)dst_uv;
+    Uint32 y_skip, uv_skip;
 
     y_stride /= sizeof(Uint16);
     uv_stride /= sizeof(Uint16);
 
-    plane_interleaved_uv = (plane_y + height * y_stride);
     y_skip = (y_stride - width);
 
     curr_row = (const Uint8 *)src;
@@ -1129,29 +1504,54 @@ static bool SDL_ConvertPixels_XBGR2101010_to_P010(int width, int height, const v
     return true;
 }
 
-bool SDL_ConvertPixels_RGB_to_YUV(int width, int height,
-                                  SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
-                                  SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+// Convert through an intermediate RGB format, a strip of rows at a time
+static bool SDL_ConvertPixels_RGB_to_YUVPlanes_Strips(int width, int height,
+                                                    SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                                    SDL_PixelFormat tmp_format, SDL_Colorspace tmp_colorspace, SDL_PropertiesID tmp_properties,
+                                                    SDL_PixelFormat dst_format, Uint8 *y, Uint8 *u, Uint8 *v, Uint32 y_stride, Uint32 uv_stride, YCbCrType yuv_type)
 {
-    YCbCrType yuv_type = YCBCR_601_LIMITED;
-
-    if (!GetYUVConversionType(dst_colorspace, &yuv_type)) {
+    const int strip_rows = SDL_min(GetYUVStripRows(width), height);
+    const int tmp_pitch = (width * sizeof(Uint32));
+    bool result = true;
+    void *tmp;
+    int row;
+
+    tmp = SDL_malloc((size_t)tmp_pitch * strip_rows);
+    if (!tmp) {
         return false;
     }
 
-#if 0 // Doesn't handle odd widths
-    // RGB24 to FOURCC
-    if (src_format == SDL_PIXELFORMAT_RGB24) {
-        Uint8 *y;
-        Uint8 *u;
-        Uint8 *v;
-        Uint32 y_stride;
-        Uint32 uv_stride;
+    for (row = 0; row < height && result; row += strip_rows) {
+        const int rows = SDL_min(strip_rows, height - row);
+        const Uint8 *strip_y = y;
+        const Uint8 *strip_u = u;
+        const Uint8 *strip_v = v;
 
-        if (GetYUVPlanes(width, height, dst_format, dst, dst_pitch, (const Uint8 **)&y, (const Uint8 **)&u, (const Uint8 **)&v, &y_stride, &uv_stride) < 0) {
-            return false;
+        OffsetYUVPlanes(dst_format, row, &strip_y, &strip_u, &strip_v, y_stride, uv_stride);
+
+        // convert src/src_format to tmp/tmp_format
+        result = SDL_ConvertPixelsAndColorspace(width, rows, src_format, src_colorspace, src_properties, (const Uint8 *)src + (size_t)row * src_pitch, src_pitch, tmp_format, tmp_colorspace, tmp_properties, tmp, tmp_pitch);
+        if (result) {
+            // convert tmp/tmp_format to dst/FOURCC
+            if (tmp_format == SDL_PIXELFORMAT_XBGR2101010) {
+                result = SDL_ConvertPixels_XBGR2101010_to_P010(width, rows, tmp, tmp_pitch, (Uint8 *)strip_y, (Uint8 *)strip_u, y_stride, uv_stride, yuv_type);
+            } else {
+                result = SDL_ConvertPixels_XRGB8888_to_YUV(width, rows, tmp, tmp_pitch, dst_format, (Uint8 *)strip_y, (Uint8 *)strip_u, (Uint8 *)strip_v, y_stride, uv_stride, yuv_type);
+            }
         }
+    }
+    SDL_free(tmp);
+    return result;
+}
 
+static bool SDL_ConvertPixels_RGB_to_YUVPlanes(int width, int height,
+                                             SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                             SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties,
+                                             Uint8 *y, Uint8 *u, Uint8 *v, Uint32 y_stride, Uint32 uv_stride, YCbCrType yuv_type)
+{
+#if 0 // Doesn't handle odd widths
+    // RGB24 to FOURCC
+    if (src_format == SDL_PIXELFORMAT_RGB24) {
         rgb24_yuv420_std(width, height, src, src_pitch, y, u, v, y_stride, uv_stride, yuv_type);
         return true;
     }
@@ -1160,61 +1560,90 @@ bool SDL_ConvertPixels_RGB_to_YUV(int width, int height,
     // ARGB8888 to FOURCC
     if ((src_format == SDL_PIXELFORMAT_ARGB8888 || src_format == SDL_PIXELFORMAT_XRGB8888) &&
         SDL_COLORSPACEPRIMARIES(src_colorspace) == SDL_COLORSPACEPRIMARIES(dst_colorspace)) {
-        return SDL_ConvertPixels_XRGB8888_to_YUV(width, height, src, src_pitch, dst_format, dst, dst_pitch, yuv_type);
+        return SDL_ConvertPixels_XRGB8888_to_YUV(width, height, src, src_pitch, dst_format, y, u, v, y_stride, uv_stride, yuv_type);
     }
 
     if (dst_format == SDL_PIXELFORMAT_P010) {
         if (src_format == SDL_PIXELFORMAT_XBGR2101010 &&
             SDL_COLORSPACEPRIMARIES(src_colorspace) == SDL_COLORSPACEPRIMARIES(dst_colorspace)) {
-            return SDL_ConvertPixels_XBGR2101010_to_P010(width, height, src, src_pitch, dst_format, dst, dst_pitch, yuv_type);
+            return SDL_ConvertPixels_XBGR2101010_to_P010(width, height, src, src_pitch, y, u, y_stride, uv_stride, yuv_type);
         }
 
         // We currently only support converting from XBGR2101010 to P010
-        bool result;
-        void *tmp;
-        int tmp_pitch = (width * sizeof(Uint32));
-
-        tmp = SDL_malloc((size_t)tmp_pitch * height);
-        if (!tmp) {
-            return false;
-        }
-
-        // convert src/src_format to tmp/XBGR2101010
-        result = SDL_ConvertPixelsAndColorspace(width, height, src_format, src_colorspace, src_properties, src, src_pitch, SDL_PIXELFORMAT_XBGR2101010, dst_colorspace, dst_properties, tmp, tmp_pitch);
-        if (!result) {
-            SDL_free(tmp);
-            return false;
-        }
-
-        // convert tmp/XBGR2101010 to dst/P010
-        result = SDL_ConvertPixels_XBGR2101010_to_P010(width, height, tmp, tmp_pitch, dst_format, dst, dst_pitch, yuv_type);
-        SDL_free(tmp);
-        return result;
+        return SDL_ConvertPixels_RGB_to_YUVPlanes_Strips(width, height, src_format, src_colorspace, src_properties, src, src_pitch,
+                                                         SDL_PIXELFORMAT_XBGR2101010, dst_colorspace, dst_properties,
+                                                         dst_format, y, u, v, y_stride, uv_stride, yuv_type);
     }
 
     // not ARGB8888 to FOURCC : need an intermediate conversion
-    {
-        bool result;
-        void *tmp;
-        int tmp_pitch = (width * sizeof(Uint32));
+    return SDL_ConvertPixels_RGB_to_YUVPlanes_Strips(width, height, src_format, src_colorspace, src_properties, src, src_pitch,
+                                                     SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 0,
+                                                     dst_format, y, u, v, y_stride, uv_stride, yuv_type);
+}
 
-        tmp = SDL_malloc((size_t)tmp_pitch * height);
-        if (!tmp) {
-            return false;
-        }
+static void SDLCALL SDL_ConvertRGBToYUVBand(void *userdata)
+{
+    SDL_YUVConversionBand *band = (SDL_YUVConversionBand *)userdata;
 
-        // convert src/src_format to tmp/XRGB8888
-        result = SDL_ConvertPixelsAndColorspace(width, height, src_format, src_colorspace, src_properties, src, src_pitch, SDL_PIXELFORMAT_XRGB8888, SDL_COLORSPACE_SRGB, 0, tmp, tmp_pitch);
-        if (!result) {
-            SDL_free(tmp);
-            return false;
-        }
+    band->result = SDL_ConvertPixels_RGB_to_YUVPlanes(band->width, band->height,
+                                                      band->src_format, band->src_colorspace, band->src_properties, band->rgb, band->rgb_pitch,
+                                                      band->dst_format, band->dst_colorspace, band->dst_properties,
+                                                      (Uint8 *)band->y, (Uint8 *)band->u, (Uint8 *)band->v, band->y_stride, band->uv_stride, band->yuv_type);
+}
 
-        // convert tmp/XRGB8888 to dst/FOURCC
-        result = SDL_ConvertPixels_XRGB8888_to_YUV(width, height, tmp, tmp_pitch, dst_format, dst, dst_pitch, yuv_type);
-        SDL_free(tmp);
-        return result;
+bool SDL_ConvertPixels_RGB_to_YUV(int width, int height,
+                                  SDL_PixelFormat src_format, SDL_Colorspace src_colorspace, SDL_PropertiesID src_properties, const void *src, int src_pitch,
+                                  SDL_PixelFormat dst_format, SDL_Colorspace dst_colorspace, SDL_PropertiesID dst_properties, void *dst, int dst_pitch)
+{
+    YCbCrType yuv_type = YCBCR_601_LIMITED;
+    const Uint8 *y = NULL;
+    const Uint8 *u = NULL;
+    const Uint8 *v = NULL;
+    Uint32 y_stride = 0;
+    Uint32 uv_stride = 0;
+    SDL_YUVConversionBand bands[SDL_YUV_PARALLEL_MAX_BANDS];
+    int num_bands;
+    int i;
+
+    if (!GetYUVConversionType(dst_colorspace, &yuv_type)) {
+        return false;
     }
+
+    if (!GetYUVPlanes(width, height, dst_format, dst, dst_pitch, &y, &u, &v, &y_stride, &uv_stride)) {
+        return false;
+    }
+
+    num_bands = GetYUVParallelBands(width, height);
+    if (num_bands < 2) {
+        return SDL_ConvertPixels_RGB_to_YUVPlanes(width, height, src_format, src_colorspace, src_properties, src, src_pitch,
+                                                  dst_format, dst_colorspace, dst_properties,
+                                                  (Uint8 *)y, (Uint8 *)u, (Uint8 *)v, y_stride, uv_stride, yuv_type);
+    }
+
+    for (i = 0; i < num_bands; ++i) {
+        const int row = GetYUVBandRow(height, i, num_bands);
+        SDL_YUVConversionBand *band = &bands[i];
+
+        SDL_zerop(band);
+        band->width = width;
+        band->height = ((i + 1) < num_bands ? GetYUVBandRow(height, i + 1, num_bands) : height) - row;
+        band->src_format = src_format;
+        band->src_colorspace = src_colorspace;
+        band->src_properties = src_properties;
+        band->dst_format = dst_format;
+        band->dst_colorspace = dst_colorspace;
+        band->dst_properties = dst_properties;
+        band->y = y;
+        band->u = u;
+        band->v = v;
+        band->y_stride = y_stride;
+        band->uv_stride = uv_stride;
+        OffsetYUVPlanes(dst_format, row, &band->y, &band->u, &band->v, y_stride, uv_stride);
+        band->rgb = (Uint8 *)src + (size_t)row * src_pitch;
+        band->rgb_pitch = src_pitch;
+        band->yuv_type = yuv_type;
+    }
+    return RunYUVConversionBands(SDL_ConvertRGBToYUVBand, bands, num_bands);
 }
 
 static bool SDL_ConvertPixels_YUV_to_YUV_Copy(int width, int height, SDL_PixelFormat format, const void *src, int src_pitch, void *dst, int dst_pitch)
@@ -361,9 +361,24 @@ bool Cocoa_AddDisplay(CGDirectDisplayID display, bool send_event)
 
     viddisplay.desktop_mode = mode;
     viddisplay.internal = displaydata;
-    const bool retval = SDL_AddVideoDisplay(&viddisplay, send_event);
+    const SDL_DisplayID displayID = SDL_AddVideoDisplay(&viddisplay, send_event);
     SDL_free(viddisplay.name);
-    return retval;
+    if (!displayID) {
+        return false;
+    }
+
+    if (@available(macOS 12.0, *)) {
+        NSScreen *screen = GetNSScreenForDisplayID(display);
+        if (screen) {
+            /* ProMotion and adaptive sync displays report a refresh interval
+               range; macOS drives them at variable rates on its own. */
+            const bool vrr = (screen.minimumRefreshInterval < screen.maximumRefreshInterval);
+            SDL_PropertiesID props = SDL_GetDisplayProperties(displayID);
+            SDL_SetBooleanProperty(props, SDL_PROP_DISPLAY_VRR_CAPABLE_BOOLEAN, vrr);
+            SDL_SetBooleanProperty(props, SDL_PROP_DISPLAY_VRR_ENABLED_BOOLEAN, vrr);
+        }
+    }
+    return true;
 }
 
 static void Cocoa_DisplayReconfigurationCallback(CGDirectDisplayID displayid, CGDisplayChangeSummaryFlags flags, void *userInfo)
@@ -29,6 +29,7 @@
 #include "../../events/SDL_mouse_c.h"
 #include "../../events/SDL_touch_c.h"
 #include "../../events/SDL_windowevents_c.h"
+#include "../../SDL_hints_c.h"
 #include "../SDL_sysvideo.h"
 
 #include "SDL_cocoamouse.h"
@@ -545,10 +546,11 @@ static void ScheduleContextUpdates(SDL_CocoaWindowData *data)
 #endif // SDL_VIDEO_OPENGL
 }
 
-// !!! FIXME: this should use a hint callback.
+static SDL_CachedHint Cocoa_ctrl_click_emulate_right_click_hint = SDL_CACHED_HINT(SDL_HINT_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK, false);
+
 static bool GetHintCtrlClickEmulateRightClick(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_MAC_CTRL_CLICK_EMULATE_RIGHT_CLICK, false);
+    return SDL_GetCachedHintBoolean(&Cocoa_ctrl_click_emulate_right_click_hint);
 }
 
 static NSUInteger GetWindowWindowedStyle(SDL_Window *window)
@@ -28,6 +28,8 @@
 
 #define DUMMY_SURFACE "SDL.internal.window.surface"
 
+static SDL_PropertyKey SDL_dummy_surface_key = SDL_PROPERTY_KEY(DUMMY_SURFACE);
+
 
 bool SDL_DUMMY_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format, void **pixels, int *pitch)
 {
@@ -55,7 +57,7 @@ bool SDL_DUMMY_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *windo
     static int frame_number;
     SDL_Surface *surface;
 
-    surface = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), DUMMY_SURFACE, NULL);
+    surface = (SDL_Surface *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_dummy_surface_key, NULL);
     if (!surface) {
         return SDL_SetError("Couldn't find dummy surface for window");
     }
@@ -83,6 +83,71 @@ bool KMSDRM_GLES_SetSwapInterval(SDL_VideoDevice *_this, int interval)
     return true;
 }
 
+/* Present with non-blocking atomic commits. Unlike the legacy path, we hand
+   the frame to EGL before waiting on the previous flip, so the GPU can render
+   into a third buffer while the last commit is still waiting for vblank. */
+static bool KMSDRM_GLES_SwapWindowAtomic(SDL_VideoDevice *_this, SDL_Window *window)
+{
+    SDL_WindowData *windata = window->internal;
+    KMSDRM_FBInfo *fb_info;
+    struct gbm_bo *bo;
+
+    if (!(_this->egl_data->eglSwapBuffers(_this->egl_data->egl_display,
+                                          windata->egl_surface))) {
+        return SDL_SetError("eglSwapBuffers failed");
+    }
+
+    bo = KMSDRM_gbm_surface_lock_front_buffer(windata->gs);
+    if (!bo) {
+        return SDL_SetError("Could not lock front buffer on GBM surface");
+    }
+
+    fb_info = KMSDRM_FBFromBO(_this, bo);
+    if (!fb_info) {
+        KMSDRM_gbm_surface_release_buffer(windata->gs, bo);
+        return SDL_SetError("Could not get a framebuffer");
+    }
+
+    if (!windata->bo) {
+        /* On the first swap, set the connector, mode and plane in a single
+           blocking commit, like drmModeSetCrtc() does on the legacy path. */
+        if (!KMSDRM_AtomicCommit(_this, window, fb_info, DRM_MODE_ATOMIC_ALLOW_MODESET)) {
+            KMSDRM_gbm_surface_release_buffer(windata->gs, bo);
+            return false;
+        }
+        windata->bo = bo;
+        return true;
+    }
+
+    /* Only one commit can be in flight per CRTC: wait for the previous one,
+       after which the buffer it replaced on screen can go back to GBM. */
+    if (!KMSDRM_WaitPageflip(_this, windata)) {
+        KMSDRM_gbm_surface_release_buffer(windata->gs, bo);
+        return SDL_SetError("Wait for previous pageflip failed");
+    }
+
+    if (windata->next_bo) {
+        KMSDRM_gbm_surface_release_buffer(windata->gs, windata->bo);
+        windata->bo = windata->next_bo;
+        windata->next_bo = NULL;
+    }
+
+    if (!KMSDRM_AtomicCommit(_this, window, fb_info, DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT)) {
+        KMSDRM_gbm_surface_release_buffer(windata->gs, bo);
+        return false;
+    }
+    windata->next_bo = bo;
+
+    // Same as the legacy path: SDL_VIDEO_DOUBLE_BUFFER=1 trades throughput for lag.
+    if (windata->double_buffer) {
+        if (!KMSDRM_WaitPageflip(_this, windata)) {
+            return SDL_SetError("Immediate wait for previous pageflip failed");
+        }
+    }
+
+    return true;
+}
+
 bool KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
 {
     SDL_WindowData *windata = window->internal;
@@ -107,6 +172,13 @@ bool KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
         KMSDRM_CreateSurfaces(_this, window);
     }
 
+    /* Atomic commits can't tear, so unthrottled swaps still go through
+       the legacy async pageflip when the hardware has it. */
+    if (viddata->atomic_support &&
+        !(_this->egl_data->egl_swapinterval == 0 && viddata->async_pageflip_support)) {
+        return KMSDRM_GLES_SwapWindowAtomic(_this, window);
+    }
+
     /* Wait for confirmation that the next front buffer has been flipped, at which
        point the previous front buffer can be released */
     if (!KMSDRM_WaitPageflip(_this, windata)) {
@@ -171,10 +243,11 @@ bool KMSDRM_GLES_SwapWindow(SDL_VideoDevice *_this, SDL_Window *window)
         }
 
         ret = KMSDRM_drmModePageFlip(viddata->drm_fd, dispdata->crtc->crtc_id,
-                                     fb_info->fb_id, flip_flags, &windata->waiting_for_flip);
+                                     fb_info->fb_id, flip_flags, windata);
 
         if (ret == 0) {
             windata->waiting_for_flip = true;
+            windata->flip_submit_ns = SDL_GetTicksNS();
         } else {
             SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "Could not queue pageflip: %d", ret);
         }
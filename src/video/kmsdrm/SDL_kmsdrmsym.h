@@ -105,6 +105,19 @@ SDL_KMSDRM_SYM(int,drmModeSetPlane,(int fd, uint32_t plane_id, uint32_t crtc_id,
                                     uint32_t src_w, uint32_t src_h))
 // Planes stuff ends.
 
+// Atomic modesetting stuff.
+SDL_KMSDRM_SYM_OPT(drmModeAtomicReqPtr,drmModeAtomicAlloc,(void))
+SDL_KMSDRM_SYM_OPT(void,drmModeAtomicFree,(drmModeAtomicReqPtr req))
+SDL_KMSDRM_SYM_OPT(int,drmModeAtomicAddProperty,(drmModeAtomicReqPtr req,
+                                                 uint32_t object_id, uint32_t property_id,
+                                                 uint64_t value))
+SDL_KMSDRM_SYM_OPT(int,drmModeAtomicCommit,(int fd, drmModeAtomicReqPtr req,
+                                            uint32_t flags, void *user_data))
+SDL_KMSDRM_SYM_OPT(int,drmModeCreatePropertyBlob,(int fd, const void *data, size_t size,
+                                                  uint32_t *id))
+SDL_KMSDRM_SYM_OPT(int,drmModeDestroyPropertyBlob,(int fd, uint32_t id))
+// Atomic modesetting stuff ends.
+
 SDL_KMSDRM_MODULE(GBM)
 SDL_KMSDRM_SYM(int,gbm_device_is_format_supported,(struct gbm_device *gbm,
                                                    uint32_t format, uint32_t usage))
@@ -53,6 +53,7 @@
 #include <sys/param.h>
 #include <sys/stat.h>
 #include <sys/utsname.h>
+#include <time.h>
 
 #ifdef SDL_PLATFORM_OPENBSD
 static bool moderndri = false;
@@ -425,7 +426,46 @@ KMSDRM_FBInfo *KMSDRM_FBFromBO(SDL_VideoDevice *_this, struct gbm_bo *bo)
 
 static void KMSDRM_FlipHandler(int fd, unsigned int frame, unsigned int sec, unsigned int usec, void *data)
 {
-    *((bool *)data) = false;
+    SDL_WindowData *windata = (SDL_WindowData *)data;
+    SDL_Window *window = windata->window;
+    SDL_DisplayData *dispdata;
+    const Uint64 flip_ns = (Uint64)sec * SDL_NS_PER_SECOND + SDL_US_TO_NS((Uint64)usec);
+    Uint64 present_ns = SDL_GetTicksNS();
+    Uint64 submit_ns = windata->flip_submit_ns;
+    Uint64 refresh_ns = 0;
+    Uint64 missed = 0;
+    struct timespec now;
+
+    windata->waiting_for_flip = false;
+
+    if (!window) {
+        return;
+    }
+
+    // Event timestamps are CLOCK_MONOTONIC; move them into SDL_GetTicksNS() time.
+    if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+        const Uint64 now_ns = (Uint64)now.tv_sec * SDL_NS_PER_SECOND + (Uint64)now.tv_nsec;
+        if (now_ns > flip_ns && present_ns > (now_ns - flip_ns)) {
+            present_ns -= (now_ns - flip_ns);
+        }
+    }
+
+    dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    if (dispdata && dispdata->mode.clock) {
+        refresh_ns = ((Uint64)dispdata->mode.htotal * dispdata->mode.vtotal * 1000000) / dispdata->mode.clock;
+    }
+
+    /* If the flip was queued before the vblank right after the previous one,
+       the app was keeping up and any extra vblanks in between were missed. */
+    if (windata->last_flip_ns && refresh_ns && frame - windata->last_flip_sequence > 1 &&
+        submit_ns < windata->last_flip_ns + refresh_ns) {
+        missed = frame - windata->last_flip_sequence - 1;
+    }
+
+    windata->last_flip_sequence = frame;
+    windata->last_flip_ns = present_ns;
+
+    SDL_OnWindowPresented(window, present_ns, refresh_ns, missed);
 }
 
 bool KMSDRM_WaitPageflip(SDL_VideoDevice *_this, SDL_WindowData *windata)
@@ -573,6 +613,14 @@ static void KMSDRM_DeinitDisplays(SDL_VideoDevice *_this)
                 dispdata->connector = NULL;
             }
 
+            // Free the atomic mode blob
+            if (dispdata && dispdata->mode_blob_id) {
+                if (viddata->drm_fd >= 0) {
+                    KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, dispdata->mode_blob_id);
+                }
+                dispdata->mode_blob_id = 0;
+            }
+
             // Free CRTC
             if (dispdata && dispdata->crtc) {
                 KMSDRM_drmModeFreeCrtc(dispdata->crtc);
@@ -793,6 +841,208 @@ static int KMSDRM_CrtcGetOrientation(uint32_t drm_fd, uint32_t crtc_id)
     return orientation;
 }
 
+static uint32_t KMSDRM_GetObjectPropId(uint32_t drm_fd, uint32_t object_id,
+                                       uint32_t object_type, char const *name)
+{
+    uint32_t prop_id;
+    drmModeObjectPropertiesPtr props = KMSDRM_drmModeObjectGetProperties(drm_fd,
+                                                                         object_id,
+                                                                         object_type);
+
+    if (!props) {
+        return 0;
+    }
+
+    prop_id = KMSDRM_CrtcGetPropId(drm_fd, props, name);
+
+    KMSDRM_drmModeFreeObjectProperties(props);
+
+    return prop_id;
+}
+
+static bool KMSDRM_PlaneIsPrimary(uint32_t drm_fd, uint32_t plane_id)
+{
+    drmModeObjectPropertiesPtr props;
+    bool primary = false;
+    uint32_t i;
+
+    props = KMSDRM_drmModeObjectGetProperties(drm_fd, plane_id, DRM_MODE_OBJECT_PLANE);
+    if (!props) {
+        return false;
+    }
+
+    for (i = 0; i < props->count_props; ++i) {
+        drmModePropertyPtr drm_prop = KMSDRM_drmModeGetProperty(drm_fd, props->props[i]);
+
+        if (!drm_prop) {
+            continue;
+        }
+
+        if (SDL_strcmp(drm_prop->name, "type") == 0) {
+            primary = (props->prop_values[i] == DRM_PLANE_TYPE_PRIMARY);
+        }
+
+        KMSDRM_drmModeFreeProperty(drm_prop);
+    }
+
+    KMSDRM_drmModeFreeObjectProperties(props);
+
+    return primary;
+}
+
+/* Find the primary plane of the display's CRTC and the property IDs
+   we need to build atomic commits for it. */
+static bool KMSDRM_InitAtomicPlane(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
+{
+    SDL_VideoData *viddata = _this->internal;
+    drmModeRes *resources;
+    drmModePlaneRes *plane_resources;
+    uint32_t crtc_id = dispdata->crtc->crtc_id;
+    int crtc_index = -1;
+    uint32_t i;
+
+    resources = KMSDRM_drmModeGetResources(viddata->drm_fd);
+    if (!resources) {
+        return SDL_SetError("drmModeGetResources(%d) failed", viddata->drm_fd);
+    }
+
+    for (i = 0; i < (uint32_t)resources->count_crtcs; i++) {
+        if (resources->crtcs[i] == crtc_id) {
+            crtc_index = (int)i;
+            break;
+        }
+    }
+
+    KMSDRM_drmModeFreeResources(resources);
+
+    if (crtc_index < 0) {
+        return SDL_SetError("Couldn't find the index of CRTC %u", crtc_id);
+    }
+
+    plane_resources = KMSDRM_drmModeGetPlaneResources(viddata->drm_fd);
+    if (!plane_resources) {
+        return SDL_SetError("drmModeGetPlaneResources(%d) failed", viddata->drm_fd);
+    }
+
+    for (i = 0; !dispdata->plane_id && i < plane_resources->count_planes; i++) {
+        drmModePlane *plane = KMSDRM_drmModeGetPlane(viddata->drm_fd, plane_resources->planes[i]);
+
+        if (!plane) {
+            continue;
+        }
+
+        if ((plane->possible_crtcs & (1 << crtc_index)) &&
+            KMSDRM_PlaneIsPrimary(viddata->drm_fd, plane->plane_id)) {
+            dispdata->plane_id = plane->plane_id;
+        }
+
+        KMSDRM_drmModeFreePlane(plane);
+    }
+
+    KMSDRM_drmModeFreePlaneResources(plane_resources);
+
+    if (!dispdata->plane_id) {
+        return SDL_SetError("No primary plane found for CRTC %u", crtc_id);
+    }
+
+    dispdata->conn_prop_crtc_id = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->connector->connector_id, DRM_MODE_OBJECT_CONNECTOR, "CRTC_ID");
+    dispdata->crtc_prop_mode_id = KMSDRM_GetObjectPropId(viddata->drm_fd, crtc_id, DRM_MODE_OBJECT_CRTC, "MODE_ID");
+    dispdata->crtc_prop_active = KMSDRM_GetObjectPropId(viddata->drm_fd, crtc_id, DRM_MODE_OBJECT_CRTC, "ACTIVE");
+    dispdata->plane_prop_fb_id = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "FB_ID");
+    dispdata->plane_prop_crtc_id = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_ID");
+    dispdata->plane_prop_src_x = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "SRC_X");
+    dispdata->plane_prop_src_y = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "SRC_Y");
+    dispdata->plane_prop_src_w = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "SRC_W");
+    dispdata->plane_prop_src_h = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "SRC_H");
+    dispdata->plane_prop_crtc_x = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_X");
+    dispdata->plane_prop_crtc_y = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_Y");
+    dispdata->plane_prop_crtc_w = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_W");
+    dispdata->plane_prop_crtc_h = KMSDRM_GetObjectPropId(viddata->drm_fd, dispdata->plane_id, DRM_MODE_OBJECT_PLANE, "CRTC_H");
+
+    if (!dispdata->conn_prop_crtc_id || !dispdata->crtc_prop_mode_id || !dispdata->crtc_prop_active ||
+        !dispdata->plane_prop_fb_id || !dispdata->plane_prop_crtc_id) {
+        dispdata->plane_id = 0;
+        return SDL_SetError("Missing atomic modesetting properties for CRTC %u", crtc_id);
+    }
+
+    SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Using primary plane %u for atomic commits on CRTC %u",
+                 dispdata->plane_id, crtc_id);
+
+    return true;
+}
+
+/* Present fb_info on the window's display with a single atomic commit.
+   Pass DRM_MODE_ATOMIC_ALLOW_MODESET to also set the connector and video mode,
+   and DRM_MODE_PAGE_FLIP_EVENT to get windata->waiting_for_flip cleared by
+   KMSDRM_WaitPageflip() once the commit reaches the screen. */
+bool KMSDRM_AtomicCommit(SDL_VideoDevice *_this, SDL_Window *window, KMSDRM_FBInfo *fb_info, uint32_t flags)
+{
+    SDL_VideoData *viddata = _this->internal;
+    SDL_WindowData *windata = window->internal;
+    SDL_DisplayData *dispdata = SDL_GetDisplayDriverDataForWindow(window);
+    uint32_t crtc_id = dispdata->crtc->crtc_id;
+    uint32_t w = dispdata->mode.hdisplay;
+    uint32_t h = dispdata->mode.vdisplay;
+    drmModeAtomicReqPtr req;
+    int err = 0;
+    int ret;
+
+    if (!dispdata->plane_id && !KMSDRM_InitAtomicPlane(_this, dispdata)) {
+        return false;
+    }
+
+    if (flags & DRM_MODE_ATOMIC_ALLOW_MODESET) {
+        if (dispdata->mode_blob_id) {
+            KMSDRM_drmModeDestroyPropertyBlob(viddata->drm_fd, dispdata->mode_blob_id);
+            dispdata->mode_blob_id = 0;
+        }
+        if (KMSDRM_drmModeCreatePropertyBlob(viddata->drm_fd, &dispdata->mode, sizeof(dispdata->mode), &dispdata->mode_blob_id) != 0) {
+            return SDL_SetError("Could not create mode property blob");
+        }
+    }
+
+    req = KMSDRM_drmModeAtomicAlloc();
+    if (!req) {
+        return SDL_OutOfMemory();
+    }
+
+    if (flags & DRM_MODE_ATOMIC_ALLOW_MODESET) {
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->connector->connector_id, dispdata->conn_prop_crtc_id, crtc_id) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, crtc_id, dispdata->crtc_prop_mode_id, dispdata->mode_blob_id) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, crtc_id, dispdata->crtc_prop_active, 1) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_crtc_id, crtc_id) < 0;
+        // Plane source coordinates are 16.16 fixed point.
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_src_x, 0) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_src_y, 0) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_src_w, (uint64_t)w << 16) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_src_h, (uint64_t)h << 16) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_crtc_x, 0) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_crtc_y, 0) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_crtc_w, w) < 0;
+        err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_crtc_h, h) < 0;
+    }
+    err |= KMSDRM_drmModeAtomicAddProperty(req, dispdata->plane_id, dispdata->plane_prop_fb_id, fb_info->fb_id) < 0;
+
+    if (err) {
+        KMSDRM_drmModeAtomicFree(req);
+        return SDL_SetError("Could not build atomic commit");
+    }
+
+    ret = KMSDRM_drmModeAtomicCommit(viddata->drm_fd, req, flags, windata);
+    KMSDRM_drmModeAtomicFree(req);
+
+    if (ret) {
+        return SDL_SetError("Atomic commit failed: %s", strerror(-ret));
+    }
+
+    if (flags & DRM_MODE_PAGE_FLIP_EVENT) {
+        windata->waiting_for_flip = true;
+        windata->flip_submit_ns = SDL_GetTicksNS();
+    }
+
+    return true;
+}
+
 /* Gets a DRM connector, builds an SDL_Display with it, and adds it to the
    list of SDL Displays in _this->displays[]  */
 static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connector, drmModeRes *resources)
@@ -808,6 +1058,7 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     SDL_PropertiesID display_properties;
     char name_fmt[64];
     int orientation;
+    bool vrr_capable;
     int mode_index;
     int i, j;
     int ret = 0;
@@ -964,7 +1215,8 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     // save previous vrr state
     dispdata->saved_vrr = KMSDRM_CrtcGetVrr(viddata->drm_fd, crtc->crtc_id);
     // try to enable vrr
-    if (KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE")) {
+    vrr_capable = KMSDRM_ConnectorCheckVrrCapable(viddata->drm_fd, connector->connector_id, "VRR_CAPABLE");
+    if (vrr_capable) {
         SDL_LogDebug(SDL_LOG_CATEGORY_VIDEO, "Enabling VRR");
         KMSDRM_CrtcSetVrr(viddata->drm_fd, crtc->crtc_id, true);
     }
@@ -1013,6 +1265,8 @@ static void KMSDRM_AddDisplay(SDL_VideoDevice *_this, drmModeConnector *connecto
     orientation = KMSDRM_CrtcGetOrientation(viddata->drm_fd, crtc->crtc_id);
     display_properties = SDL_GetDisplayProperties(display_id);
     SDL_SetNumberProperty(display_properties, SDL_PROP_DISPLAY_KMSDRM_PANEL_ORIENTATION_NUMBER, orientation);
+    SDL_SetBooleanProperty(display_properties, SDL_PROP_DISPLAY_VRR_CAPABLE_BOOLEAN, vrr_capable);
+    SDL_SetBooleanProperty(display_properties, SDL_PROP_DISPLAY_VRR_ENABLED_BOOLEAN, vrr_capable && KMSDRM_CrtcGetVrr(viddata->drm_fd, crtc->crtc_id));
 
 cleanup:
     if (encoder) {
@@ -1197,6 +1451,21 @@ static bool KMSDRM_GBMInit(SDL_VideoDevice *_this, SDL_DisplayData *dispdata)
     // Set the FD as current DRM master.
     KMSDRM_drmSetMaster(viddata->drm_fd);
 
+    /* Atomic modesetting is opt-in. The atomic client cap implies universal
+       planes, which we need to see the primary plane in the first place. */
+    viddata->atomic_support = false;
+    if (SDL_GetHintBoolean(SDL_HINT_KMSDRM_ATOMIC, false)) {
+        if (KMSDRM_drmModeAtomicAlloc && KMSDRM_drmModeAtomicFree &&
+            KMSDRM_drmModeAtomicAddProperty && KMSDRM_drmModeAtomicCommit &&
+            KMSDRM_drmModeCreatePropertyBlob && KMSDRM_drmModeDestroyPropertyBlob &&
+            KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_UNIVERSAL_PLANES, 1) == 0 &&
+            KMSDRM_drmSetClientCap(viddata->drm_fd, DRM_CLIENT_CAP_ATOMIC, 1) == 0) {
+            viddata->atomic_support = true;
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_VIDEO, "Atomic modesetting not available, using legacy modesetting.");
+        }
+    }
+
     // Create the GBM device.
     viddata->gbm_dev = KMSDRM_gbm_create_device(viddata->drm_fd);
     if (!viddata->gbm_dev) {
@@ -1242,6 +1511,12 @@ static void KMSDRM_DestroySurfaces(SDL_VideoDevice *_this, SDL_Window *window)
     /**********************************************/
     // KMSDRM_WaitPageflip(_this, windata);
 
+    /* Non-blocking atomic commits may still be in flight, though, and the
+       CRTC can't be reconfigured until they land. */
+    if (viddata->atomic_support) {
+        KMSDRM_WaitPageflip(_this, windata);
+    }
+
     /************************************************************************/
     // Restore the original CRTC configuration: configure the crtc with the
     // original video mode and make it point to the original TTY buffer.
@@ -1655,6 +1930,7 @@ bool KMSDRM_CreateWindow(SDL_VideoDevice *_this, SDL_Window *window, SDL_Propert
 
     // Setup driver data for this window
     windata->viddata = viddata;
+    windata->window = window;
     window->internal = windata;
 
     // Do we want a double buffering scheme to get low video lag?
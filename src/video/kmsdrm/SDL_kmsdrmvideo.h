@@ -53,6 +53,10 @@
 #define DRM_MODE_OBJECT_CRTC        0xcccccccc
 #endif
 
+#ifndef DRM_MODE_OBJECT_PLANE
+#define DRM_MODE_OBJECT_PLANE       0xeeeeeeee
+#endif
+
 #ifndef DRM_CAP_ASYNC_PAGE_FLIP
 #define DRM_CAP_ASYNC_PAGE_FLIP 7
 #endif
@@ -65,6 +69,23 @@
 #define DRM_CAP_CURSOR_HEIGHT   9
 #endif
 
+#ifndef DRM_CLIENT_CAP_UNIVERSAL_PLANES
+#define DRM_CLIENT_CAP_UNIVERSAL_PLANES 2
+#endif
+
+#ifndef DRM_CLIENT_CAP_ATOMIC
+#define DRM_CLIENT_CAP_ATOMIC   3
+#endif
+
+#ifndef DRM_MODE_ATOMIC_NONBLOCK
+#define DRM_MODE_ATOMIC_NONBLOCK        0x0200
+#define DRM_MODE_ATOMIC_ALLOW_MODESET   0x0400
+#endif
+
+#ifndef DRM_PLANE_TYPE_PRIMARY
+#define DRM_PLANE_TYPE_PRIMARY  1
+#endif
+
 #ifndef GBM_FORMAT_ARGB8888
 #define GBM_FORMAT_ARGB8888  ((uint32_t)('A') | ((uint32_t)('R') << 8) | ((uint32_t)('2') << 16) | ((uint32_t)('4') << 24))
 #define GBM_BO_USE_CURSOR   (1 << 1)
@@ -83,6 +104,7 @@ struct SDL_VideoData
     bool video_init;             // Has VideoInit succeeded?
     bool vulkan_mode;            // Are we in Vulkan mode? One VK window is enough to be.
     bool async_pageflip_support; // Does the hardware support async. pageflips?
+    bool atomic_support;         // Are we presenting with atomic commits?
 
     SDL_Window **windows;
     int max_windows;
@@ -119,11 +141,25 @@ struct SDL_DisplayData
     uint64_t cursor_w, cursor_h;
 
     bool default_cursor_init;
+
+    /* Atomic modesetting: the primary plane we present on, the blob holding
+       the mode we set, and the property IDs we need to build commits. These
+       are looked up on the first atomic commit for this display. */
+    uint32_t plane_id;
+    uint32_t mode_blob_id;
+    uint32_t conn_prop_crtc_id;
+    uint32_t crtc_prop_mode_id;
+    uint32_t crtc_prop_active;
+    uint32_t plane_prop_fb_id;
+    uint32_t plane_prop_crtc_id;
+    uint32_t plane_prop_src_x, plane_prop_src_y, plane_prop_src_w, plane_prop_src_h;
+    uint32_t plane_prop_crtc_x, plane_prop_crtc_y, plane_prop_crtc_w, plane_prop_crtc_h;
 };
 
 struct SDL_WindowData
 {
     SDL_VideoData *viddata;
+    SDL_Window *window;
     /* SDL internals expect EGL surface to be here, and in KMSDRM the GBM surface is
        what supports the EGL surface on the driver side, so all these surfaces and buffers
        are expected to be here, in the struct pointed by SDL_Window internal pointer:
@@ -135,6 +171,11 @@ struct SDL_WindowData
     bool waiting_for_flip;
     bool double_buffer;
 
+    // Presentation feedback, from the pageflip events.
+    Uint64 flip_submit_ns;
+    Uint64 last_flip_ns;
+    unsigned int last_flip_sequence;
+
     EGLSurface egl_surface;
     bool egl_surface_dirty;
 };
@@ -150,6 +191,7 @@ extern bool KMSDRM_CreateSurfaces(SDL_VideoDevice *_this, SDL_Window *window);
 extern KMSDRM_FBInfo *KMSDRM_FBFromBO(SDL_VideoDevice *_this, struct gbm_bo *bo);
 extern KMSDRM_FBInfo *KMSDRM_FBFromBO2(SDL_VideoDevice *_this, struct gbm_bo *bo, int w, int h);
 extern bool KMSDRM_WaitPageflip(SDL_VideoDevice *_this, SDL_WindowData *windata);
+extern bool KMSDRM_AtomicCommit(SDL_VideoDevice *_this, SDL_Window *window, KMSDRM_FBInfo *fb_info, uint32_t flags);
 
 /****************************************************************************/
 // SDL_VideoDevice functions declaration
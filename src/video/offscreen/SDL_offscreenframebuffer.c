@@ -28,6 +28,8 @@
 
 #define OFFSCREEN_SURFACE "SDL.internal.window.surface"
 
+static SDL_PropertyKey SDL_offscreen_surface_key = SDL_PROPERTY_KEY(OFFSCREEN_SURFACE);
+
 
 bool SDL_OFFSCREEN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format, void **pixels, int *pitch)
 {
@@ -56,11 +58,16 @@ bool SDL_OFFSCREEN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *w
     static int frame_number;
     SDL_Surface *surface;
 
-    surface = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(window), OFFSCREEN_SURFACE, NULL);
+    surface = (SDL_Surface *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(window), &SDL_offscreen_surface_key, NULL);
     if (!surface) {
         return SDL_SetError("Couldn't find offscreen surface for window");
     }
 
+    // Hand the frame straight to the app, if it's listening
+    if (window->offscreen_frame_callback) {
+        window->offscreen_frame_callback(window->offscreen_frame_callback_data, window, surface, rects, numrects);
+    }
+
     // Send the data to the display
     if (SDL_GetHintBoolean(SDL_HINT_VIDEO_OFFSCREEN_SAVE_FRAMES, false)) {
         char file[128];
@@ -969,10 +969,13 @@ typedef struct
 {
     int w;
     int h;
-    int pitch;
+    int y_pitch;
+    int uv_pitch;
+    int uv_step;  /* 2 for interleaved chroma (NV12/NV21), 1 for separate planes */
     stbi_uc *y;
-    stbi_uc *uv;
-} stbi__nv12;
+    stbi_uc *u;
+    stbi_uc *v;
+} stbi__yuv;
 
 typedef struct
 {
@@ -983,7 +986,7 @@ typedef struct
 
 #ifndef STBI_NO_JPEG
 static int      stbi__jpeg_test(stbi__context *s);
-static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__nv12 *nv12, stbi__result_info *ri);
+static void    *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__yuv *yuv, stbi__result_info *ri);
 #if 0 /* not used in SDL */
 static int      stbi__jpeg_info(stbi__context *s, int *x, int *y, int *comp);
 #endif
@@ -3566,6 +3569,12 @@ static stbi_uc stbi__skip_jpeg_junk_at_end(stbi__jpeg *j)
    return STBI__MARKER_none;
 }
 
+#ifdef STBI_PARSE_ENTROPY_CODED_DATA /* SDL change: let SDL decode restart intervals in parallel */
+static int STBI_PARSE_ENTROPY_CODED_DATA(stbi__jpeg *z);
+#else
+#define STBI_PARSE_ENTROPY_CODED_DATA stbi__parse_entropy_coded_data
+#endif /**/
+
 // decode image to YCbCr format
 static int stbi__decode_jpeg_image(stbi__jpeg *j)
 {
@@ -3580,7 +3589,7 @@ static int stbi__decode_jpeg_image(stbi__jpeg *j)
    while (!stbi__EOI(m)) {
       if (stbi__SOS(m)) {
          if (!stbi__process_scan_header(j)) return 0;
-         if (!stbi__parse_entropy_coded_data(j)) return 0;
+         if (!STBI_PARSE_ENTROPY_CODED_DATA(j)) return 0;
          if (j->marker == STBI__MARKER_none ) {
          j->marker = stbi__skip_jpeg_junk_at_end(j);
             // if we reach eof without hitting a marker, stbi__get_marker() below will fail and we'll eventually return 0
@@ -4022,49 +4031,57 @@ static stbi_uc stbi__blinn_8x8(stbi_uc x, stbi_uc y)
    return (stbi_uc) ((t + (t >>8)) >> 8);
 }
 
-static stbi_uc *output_jpeg_nv12(stbi__jpeg *z, stbi__nv12 *nv12)
+/* SDL change: write the decoded YCbCr planes straight out as 4:2:0 YUV */
+static stbi_uc *output_jpeg_yuv(stbi__jpeg *z, stbi__yuv *yuv)
 {
    unsigned int i,j;
+   int k;
+   const unsigned int uv_w = (z->s->img_x + 1) / 2;
+   const unsigned int uv_h = (z->s->img_y + 1) / 2;
 
-   // Copy the Y plane
-   if (nv12->pitch == (int)z->s->img_x) {
-      memcpy(nv12->y, z->img_comp[0].data, z->s->img_y * z->s->img_x);
+   // Copy the Y plane, the component rows are padded out to whole MCUs
+   if (yuv->y_pitch == (int)z->s->img_x && z->img_comp[0].w2 == (int)z->s->img_x) {
+      memcpy(yuv->y, z->img_comp[0].data, z->s->img_y * z->s->img_x);
    } else {
       for (i=0; i < z->s->img_y; ++i) {
-         memcpy(nv12->y + i * nv12->pitch, z->img_comp[0].data + i * z->s->img_x, z->s->img_x);
+         memcpy(yuv->y + i * yuv->y_pitch, z->img_comp[0].data + i * z->img_comp[0].w2, z->s->img_x);
       }
    }
 
    if (z->s->img_n == 3) {
-      // NV12: U and V are interleaved, each subsampled by 2
-      const int nv12_hs = 2;
-      const int nv12_vs = 2;
-      const int u_hs = (z->img_h_max / z->img_comp[1].h);
-      const int u_vs = (z->img_v_max / z->img_comp[1].v);
-      const int v_hs = (z->img_h_max / z->img_comp[2].h);
-      const int v_vs = (z->img_v_max / z->img_comp[2].v);
-      for (i=0; i < (z->s->img_y + 1) / 2; ++i) {
-         stbi_uc *src_u = z->img_comp[1].data + i * (1 + (nv12_vs - u_vs)) * z->img_comp[1].x;
-         stbi_uc *src_v = z->img_comp[2].data + i * (1 + (nv12_vs - v_vs)) * z->img_comp[2].x;
-         stbi_uc *dst = nv12->uv + i * nv12->pitch;
-         for (j=0; j < (z->s->img_x + 1) / 2; ++j) {
-            *dst++ = *src_u;
-            src_u += 1 + (nv12_hs - u_hs);
-            *dst++ = *src_v;
-            src_v += 1 + (nv12_hs - v_hs);
+      // Take the chroma sample covering the top left of each 2x2 block of pixels
+      for (k=1; k <= 2; ++k) {
+         const int hs = z->img_h_max / z->img_comp[k].h;
+         const int vs = z->img_v_max / z->img_comp[k].v;
+         stbi_uc *plane = (k == 1) ? yuv->u : yuv->v;
+         for (i=0; i < uv_h; ++i) {
+            const stbi_uc *src = z->img_comp[k].data + ((2 * i) / vs) * z->img_comp[k].w2;
+            stbi_uc *dst = plane + i * yuv->uv_pitch;
+            if (hs == 2 && yuv->uv_step == 1) {
+               memcpy(dst, src, uv_w);
+            } else if (hs == 2) {
+               for (j=0; j < uv_w; ++j) dst[j * 2] = src[j];
+            } else {
+               for (j=0; j < uv_w; ++j) dst[j * yuv->uv_step] = src[(2 * j) / hs];
+            }
          }
       }
    } else {
       // Grayscale
-      for (i=0; i < (z->s->img_y + 1) / 2; ++i) {
-         memset(nv12->uv + i * nv12->pitch, 0x80808080, ((z->s->img_x + 1) / 2) * 2);
+      for (i=0; i < uv_h; ++i) {
+         stbi_uc *dst_u = yuv->u + i * yuv->uv_pitch;
+         stbi_uc *dst_v = yuv->v + i * yuv->uv_pitch;
+         for (j=0; j < uv_w; ++j) {
+            dst_u[j * yuv->uv_step] = 0x80;
+            dst_v[j * yuv->uv_step] = 0x80;
+         }
       }
    }
 
-   return nv12->y;
+   return yuv->y;
 }
 
-static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp, stbi__nv12 *nv12)
+static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp, int req_comp, stbi__yuv *yuv)
 {
    int n, decode_n, is_rgb;
    z->s->img_n = 0; // make stbi__cleanup_jpeg safe
@@ -4098,18 +4115,18 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
 
       stbi__resample res_comp[4];
 
-      if (nv12) {
-         if (nv12->w != (int)z->s->img_x || nv12->h != (int)z->s->img_y) {
+      if (yuv) {
+         if (yuv->w != (int)z->s->img_x || yuv->h != (int)z->s->img_y) {
              stbi__cleanup_jpeg(z);
              return stbi__errpuc("badsize", "Unexpected size");
          }
 
-         if (is_rgb) {
+         if (is_rgb || z->s->img_n == 4) {
              stbi__cleanup_jpeg(z);
-             return stbi__errpuc("rgbtonv12", "Can't convert RGB to NV12");
+             return stbi__errpuc("rgbtoyuv", "Can't convert RGB to YUV");
          }
 
-         output = output_jpeg_nv12(z, nv12);
+         output = output_jpeg_yuv(z, yuv);
       } else {
          for (k=0; k < decode_n; ++k) {
             stbi__resample *r = &res_comp[k];
@@ -4241,7 +4258,7 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
    }
 }
 
-static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__nv12 *nv12, stbi__result_info *ri)
+static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__yuv *yuv, stbi__result_info *ri)
 {
    unsigned char* result;
    stbi__jpeg* j = (stbi__jpeg*) stbi__malloc(sizeof(stbi__jpeg));
@@ -4250,7 +4267,7 @@ static void *stbi__jpeg_load(stbi__context *s, int *x, int *y, int *comp, int re
    STBI_NOTUSED(ri);
    j->s = s;
    stbi__setup_jpeg(j);
-   result = load_jpeg_image(j, x,y,comp,req_comp,nv12);
+   result = load_jpeg_image(j, x,y,comp,req_comp,yuv);
    STBI_FREE(j);
    return result;
 }
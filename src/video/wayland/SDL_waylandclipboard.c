@@ -72,6 +72,24 @@ void *Wayland_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, si
     return buffer;
 }
 
+SDL_IOStream *Wayland_OpenClipboardDataIO(SDL_VideoDevice *_this, const char *mime_type)
+{
+    SDL_VideoData *video_data = _this->internal;
+    SDL_WaylandDataDevice *data_device = NULL;
+
+    if (video_data->input && video_data->input->data_device) {
+        data_device = video_data->input->data_device;
+        if (data_device->selection_source) {
+            return SDL_OpenInternalClipboardDataIO(_this, mime_type);
+        } else if (Wayland_data_offer_has_mime(data_device->selection_offer, mime_type)) {
+            return Wayland_data_offer_open_io(data_device->selection_offer, mime_type);
+        }
+    }
+
+    SDL_SetError("No clipboard data available for %s", mime_type);
+    return NULL;
+}
+
 bool Wayland_HasClipboardData(SDL_VideoDevice *_this, const char *mime_type)
 {
     SDL_VideoData *video_data = _this->internal;
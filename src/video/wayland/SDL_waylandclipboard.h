@@ -27,6 +27,7 @@ extern const char **Wayland_GetTextMimeTypes(SDL_VideoDevice *_this, size_t *num
 extern bool Wayland_SetClipboardData(SDL_VideoDevice *_this);
 extern void *Wayland_GetClipboardData(SDL_VideoDevice *_this, const char *mime_type, size_t *length);
 extern bool Wayland_HasClipboardData(SDL_VideoDevice *_this, const char *mime_type);
+extern SDL_IOStream *Wayland_OpenClipboardDataIO(SDL_VideoDevice *_this, const char *mime_type);
 extern bool Wayland_SetPrimarySelectionText(SDL_VideoDevice *_this, const char *text);
 extern char *Wayland_GetPrimarySelectionText(SDL_VideoDevice *_this);
 extern bool Wayland_HasPrimarySelectionText(SDL_VideoDevice *_this);
@@ -23,6 +23,7 @@
 
 #ifdef SDL_VIDEO_DRIVER_WAYLAND
 
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
@@ -429,6 +430,83 @@ void *Wayland_data_offer_receive(SDL_WaylandDataOffer *offer,
     return buffer;
 }
 
+static size_t SDLCALL Wayland_pipe_io_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    const int fd = (int)(intptr_t)userdata;
+    ssize_t bytes_read;
+    int ready;
+
+    ready = SDL_IOReady(fd, SDL_IOR_READ, PIPE_TIMEOUT_NS);
+    if (ready == 0) {
+        // The source client hasn't written anything yet, let the caller try again later
+        *status = SDL_IO_STATUS_NOT_READY;
+        return 0;
+    } else if (ready < 0) {
+        SDL_SetError("Pipe select error");
+        *status = SDL_IO_STATUS_ERROR;
+        return 0;
+    }
+
+    bytes_read = read(fd, ptr, size);
+    if (bytes_read < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            *status = SDL_IO_STATUS_NOT_READY;
+        } else {
+            SDL_SetError("Pipe read error");
+            *status = SDL_IO_STATUS_ERROR;
+        }
+        return 0;
+    } else if (bytes_read == 0) {
+        *status = SDL_IO_STATUS_EOF;
+    }
+    return (size_t)bytes_read;
+}
+
+static bool SDLCALL Wayland_pipe_io_close(void *userdata)
+{
+    close((int)(intptr_t)userdata);
+    return true;
+}
+
+SDL_IOStream *Wayland_data_offer_open_io(SDL_WaylandDataOffer *offer,
+                                         const char *mime_type)
+{
+    SDL_WaylandDataDevice *data_device = NULL;
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *io;
+    int pipefd[2];
+
+    if (!offer) {
+        SDL_SetError("Invalid data offer");
+        return NULL;
+    }
+    data_device = offer->data_device;
+    if (!data_device) {
+        SDL_SetError("Data device not initialized");
+        return NULL;
+    } else if (pipe2(pipefd, O_CLOEXEC | O_NONBLOCK) == -1) {
+        SDL_SetError("Could not read pipe");
+        return NULL;
+    }
+
+    wl_data_offer_receive(offer->offer, mime_type, pipefd[1]);
+    WAYLAND_wl_display_flush(data_device->video_data->display);
+    close(pipefd[1]);
+
+    // The read end of the pipe is handed to the stream, so the data never has to be buffered here
+    SDL_INIT_INTERFACE(&iface);
+    iface.read = Wayland_pipe_io_read;
+    iface.close = Wayland_pipe_io_close;
+    io = SDL_OpenIO(&iface, (void *)(intptr_t)pipefd[0]);
+    if (!io) {
+        close(pipefd[0]);
+    }
+    SDL_LogTrace(SDL_LOG_CATEGORY_INPUT,
+                 ". In Wayland_data_offer_open_io for '%s', stream at %p",
+                 mime_type, io);
+    return io;
+}
+
 void *Wayland_primary_selection_offer_receive(SDL_WaylandPrimarySelectionOffer *offer,
                                               const char *mime_type, size_t *length)
 {
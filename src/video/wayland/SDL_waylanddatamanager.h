@@ -130,6 +130,8 @@ extern void Wayland_primary_selection_source_destroy(SDL_WaylandPrimarySelection
 extern void *Wayland_data_offer_receive(SDL_WaylandDataOffer *offer,
                                         const char *mime_type,
                                         size_t *length);
+extern SDL_IOStream *Wayland_data_offer_open_io(SDL_WaylandDataOffer *offer,
+                                                const char *mime_type);
 extern void *Wayland_primary_selection_offer_receive(SDL_WaylandPrimarySelectionOffer *offer,
                                                      const char *mime_type,
                                                      size_t *length);
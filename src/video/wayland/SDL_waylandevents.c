@@ -27,6 +27,7 @@
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_scancode_tables_c.h"
 #include "../../events/SDL_keysym_to_keycode_c.h"
+#include "../../SDL_hints_c.h"
 #include "../../core/linux/SDL_system_theme.h"
 #include "../SDL_sysvideo.h"
 
@@ -373,7 +374,9 @@ static int dispatch_queued_events(SDL_VideoData *viddata)
     }
 #endif
 
+    SDL_LockMutex(viddata->input_lock);
     rc = WAYLAND_wl_display_dispatch_pending(viddata->display);
+    SDL_UnlockMutex(viddata->input_lock);
     return rc >= 0 ? 1 : rc;
 }
 
@@ -489,7 +492,9 @@ void Wayland_PumpEvents(SDL_VideoDevice *_this)
     }
 
     // Dispatch any pre-existing pending events or new events we may have read
+    SDL_LockMutex(d->input_lock);
     err = WAYLAND_wl_display_dispatch_pending(d->display);
+    SDL_UnlockMutex(d->input_lock);
 
     if (input && keyboard_repeat_is_set(&input->keyboard_repeat)) {
         const Uint64 elapsed = SDL_GetTicksNS() - input->keyboard_repeat.sdl_press_time_ns;
@@ -695,6 +700,8 @@ static bool ProcessHitTest(SDL_WindowData *window_data,
     return false;
 }
 
+static SDL_CachedHint Wayland_focus_clickthrough_hint = SDL_CACHED_HINT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+
 static void pointer_handle_button_common(struct SDL_WaylandInput *input, uint32_t serial,
                                          uint32_t time, uint32_t button, uint32_t state_w)
 {
@@ -744,7 +751,7 @@ static void pointer_handle_button_common(struct SDL_WaylandInput *input, uint32_
         if (window->last_focus_event_time_ns) {
             if (state == WL_POINTER_BUTTON_STATE_PRESSED &&
                 (SDL_GetTicksNS() - window->last_focus_event_time_ns) < WAYLAND_FOCUS_CLICK_TIMEOUT_NS) {
-                ignore_click = !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+                ignore_click = !SDL_GetCachedHintBoolean(&Wayland_focus_clickthrough_hint);
             }
 
             window->last_focus_event_time_ns = 0;
@@ -1016,7 +1023,7 @@ static void relative_pointer_handle_relative_motion(void *data,
     // Relative pointer event times are in microsecond granularity.
     const Uint64 timestamp = Wayland_GetEventTimestamp(SDL_US_TO_NS(((Uint64)time_hi << 32) | (Uint64)time_lo));
 
-    if (input->pointer_focus && d->relative_mouse_mode) {
+    if (window && d->relative_mouse_mode) {
         double dx;
         double dy;
         if (!SDL_GetMouse()->enable_relative_system_scale) {
@@ -1962,13 +1969,88 @@ void Wayland_input_init_relative_pointer(SDL_VideoData *d)
     }
 
     if (input->pointer && !input->relative_pointer) {
-        input->relative_pointer = zwp_relative_pointer_manager_v1_get_relative_pointer(input->display->relative_pointer_manager, input->pointer);
+        if (d->input_queue) {
+            // Objects created through a wrapper inherit its queue, so the input thread dispatches this one.
+            struct zwp_relative_pointer_manager_v1 *manager_wrapper = WAYLAND_wl_proxy_create_wrapper(d->relative_pointer_manager);
+            if (manager_wrapper) {
+                WAYLAND_wl_proxy_set_queue((struct wl_proxy *)manager_wrapper, d->input_queue);
+                input->relative_pointer = zwp_relative_pointer_manager_v1_get_relative_pointer(manager_wrapper, input->pointer);
+                WAYLAND_wl_proxy_wrapper_destroy(manager_wrapper);
+            }
+        }
+        if (!input->relative_pointer) {
+            input->relative_pointer = zwp_relative_pointer_manager_v1_get_relative_pointer(d->relative_pointer_manager, input->pointer);
+        }
         zwp_relative_pointer_v1_add_listener(input->relative_pointer,
                                              &relative_pointer_listener,
                                              input);
     }
 }
 
+static bool Wayland_DispatchInputQueue(SDL_VideoData *d)
+{
+    int rc;
+
+    SDL_LockMutex(d->input_lock);
+    rc = WAYLAND_wl_display_dispatch_queue_pending(d->display, d->input_queue);
+    SDL_UnlockMutex(d->input_lock);
+
+    return rc >= 0;
+}
+
+static int SDLCALL Wayland_InputThread(void *data)
+{
+    SDL_VideoData *d = data;
+    const int fd = WAYLAND_wl_display_get_fd(d->display);
+
+    SDL_SetCurrentThreadPriority(SDL_THREAD_PRIORITY_HIGH);
+
+    while (!SDL_GetAtomicInt(&d->input_thread_quit)) {
+        /* wl_display_prepare_read_queue() fails while the input queue has pending events, so dispatch those first.
+         * Reading sorts everything else onto the default queue for the main thread to dispatch when it pumps.
+         */
+        while (WAYLAND_wl_display_prepare_read_queue(d->display, d->input_queue) != 0) {
+            if (!Wayland_DispatchInputQueue(d)) {
+                return 0;
+            }
+        }
+
+        // Wake up regularly to check if we're being asked to quit.
+        if (SDL_IOReady(fd, SDL_IOR_READ, SDL_MS_TO_NS(10)) > 0) {
+            if (WAYLAND_wl_display_read_events(d->display) < 0) {
+                return 0;
+            }
+        } else {
+            WAYLAND_wl_display_cancel_read(d->display);
+        }
+
+        if (!Wayland_DispatchInputQueue(d)) {
+            return 0;
+        }
+    }
+    return 0;
+}
+
+bool Wayland_StartInputThread(SDL_VideoData *d)
+{
+    if (!d->input_queue) {
+        return true;
+    }
+
+    SDL_SetAtomicInt(&d->input_thread_quit, 0);
+    d->input_thread = SDL_CreateThread(Wayland_InputThread, "SDLWaylandInput", d);
+    return d->input_thread != NULL;
+}
+
+void Wayland_StopInputThread(SDL_VideoData *d)
+{
+    if (d->input_thread) {
+        SDL_SetAtomicInt(&d->input_thread_quit, 1);
+        SDL_WaitThread(d->input_thread, NULL);
+        d->input_thread = NULL;
+    }
+}
+
 static void seat_handle_capabilities(void *data, struct wl_seat *seat,
                                      enum wl_seat_capability caps)
 {
@@ -1990,8 +2072,10 @@ static void seat_handle_capabilities(void *data, struct wl_seat *seat,
         SDL_AddMouse(input->pointer_id, WAYLAND_DEFAULT_POINTER_NAME, !input->display->initializing);
     } else if (!(caps & WL_SEAT_CAPABILITY_POINTER) && input->pointer) {
         if (input->relative_pointer) {
+            SDL_LockMutex(input->display->input_lock);
             zwp_relative_pointer_v1_destroy(input->relative_pointer);
             input->relative_pointer = NULL;
+            SDL_UnlockMutex(input->display->input_lock);
         }
         if (input->cursor_shape) {
             wp_cursor_shape_device_v1_destroy(input->cursor_shape);
@@ -0,0 +1,226 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "SDL_internal.h"
+
+#ifdef SDL_VIDEO_DRIVER_WAYLAND
+
+#include "../SDL_sysvideo.h"
+#include "SDL_waylandframebuffer.h"
+#include "SDL_waylandvideo.h"
+#include "SDL_waylandwindow.h"
+
+static void Wayland_AddFramebufferDamage(SDL_Rect *damage, const SDL_Rect *rect)
+{
+    if (SDL_RectEmpty(damage)) {
+        *damage = *rect;
+    } else {
+        SDL_GetRectUnion(damage, rect, damage);
+    }
+}
+
+/* Find an SHM buffer the compositor isn't reading from. Buffers are only
+   allocated as needed, so a compositor that releases promptly keeps us at one
+   or two; if all of them are still busy, give the compositor a chance to
+   release one before falling back to the oldest. */
+static struct Wayland_FramebufferBuffer *Wayland_AcquireFramebufferBuffer(SDL_WindowData *wind, struct Wayland_Framebuffer *fb)
+{
+    struct Wayland_FramebufferBuffer *oldest = NULL;
+    int i;
+
+    for (i = 0; i < fb->num_buffers; ++i) {
+        if (!fb->buffers[i].shm.busy) {
+            return &fb->buffers[i];
+        }
+    }
+
+    if (fb->num_buffers < WAYLAND_FRAMEBUFFER_MAX_BUFFERS) {
+        struct Wayland_FramebufferBuffer *buffer = &fb->buffers[fb->num_buffers];
+
+        if (Wayland_AllocSHMBufferFormat(fb->width, fb->height, fb->shm_format, &buffer->shm)) {
+            // A new buffer has none of the framebuffer contents yet.
+            buffer->damage.x = 0;
+            buffer->damage.y = 0;
+            buffer->damage.w = fb->width;
+            buffer->damage.h = fb->height;
+            buffer->frame = 0;
+            ++fb->num_buffers;
+            return buffer;
+        }
+        if (fb->num_buffers == 0) {
+            return NULL;
+        }
+    }
+
+    WAYLAND_wl_display_roundtrip(wind->waylandData->display);
+
+    for (i = 0; i < fb->num_buffers; ++i) {
+        if (!fb->buffers[i].shm.busy) {
+            return &fb->buffers[i];
+        }
+        if (!oldest || fb->buffers[i].frame < oldest->frame) {
+            oldest = &fb->buffers[i];
+        }
+    }
+
+    return oldest;
+}
+
+void Wayland_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
+{
+    SDL_WindowData *wind = window->internal;
+    struct Wayland_Framebuffer *fb = wind->framebuffer;
+    int i;
+
+    if (!fb) {
+        return;
+    }
+
+    /* Don't attach a NULL buffer here: this is also called on resize, and that
+       would unmap the window until the next update. */
+    for (i = 0; i < fb->num_buffers; ++i) {
+        Wayland_ReleaseSHMBuffer(&fb->buffers[i].shm);
+    }
+
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+    wind->framebuffer = NULL;
+}
+
+bool Wayland_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format, void **pixels, int *pitch)
+{
+    SDL_WindowData *wind = window->internal;
+    struct Wayland_Framebuffer *fb;
+    int w, h;
+
+    // Free the old framebuffer surface
+    Wayland_DestroyWindowFramebuffer(_this, window);
+
+    SDL_GetWindowSizeInPixels(window, &w, &h);
+    if (w <= 0 || h <= 0) {
+        return SDL_SetError("Window has no size");
+    }
+
+    fb = (struct Wayland_Framebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return false;
+    }
+
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = w * 4;
+    fb->pixels = SDL_calloc(h, fb->pitch);
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return false;
+    }
+
+    // Unless the window asked for transparency, don't let stray alpha bits through.
+    if (window->flags & SDL_WINDOW_TRANSPARENT) {
+        fb->shm_format = WL_SHM_FORMAT_ARGB8888;
+        *format = SDL_PIXELFORMAT_ARGB8888;
+    } else {
+        fb->shm_format = WL_SHM_FORMAT_XRGB8888;
+        *format = SDL_PIXELFORMAT_XRGB8888;
+    }
+    *pixels = fb->pixels;
+    *pitch = fb->pitch;
+
+    wind->framebuffer = fb;
+
+    return true;
+}
+
+bool Wayland_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, const SDL_Rect *rects, int numrects)
+{
+    SDL_WindowData *wind = window->internal;
+    struct Wayland_Framebuffer *fb = wind->framebuffer;
+    struct Wayland_FramebufferBuffer *buffer;
+    const SDL_Rect bounds = { 0, 0, fb ? fb->width : 0, fb ? fb->height : 0 };
+    const bool use_damage_buffer = wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION;
+    SDL_Rect frame_damage = { 0, 0, 0, 0 };
+    SDL_Rect rect;
+    int i, y;
+
+    if (!fb) {
+        return SDL_SetError("Window has no framebuffer");
+    }
+
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            Wayland_AddFramebufferDamage(&frame_damage, &rect);
+        }
+    }
+
+    if (SDL_RectEmpty(&frame_damage)) {
+        return true;
+    }
+
+    // Every buffer that isn't drawn into this frame now lags behind by this much more.
+    for (i = 0; i < fb->num_buffers; ++i) {
+        Wayland_AddFramebufferDamage(&fb->buffers[i].damage, &frame_damage);
+    }
+
+    // Same as GL swaps: committing to a hidden window would stall or be a protocol error.
+    if (wind->shell_surface_status != WAYLAND_SHELL_SURFACE_STATUS_SHOWN &&
+        wind->shell_surface_status != WAYLAND_SHELL_SURFACE_STATUS_WAITING_FOR_FRAME) {
+        return true;
+    }
+
+    buffer = Wayland_AcquireFramebufferBuffer(wind, fb);
+    if (!buffer) {
+        return false;
+    }
+
+    // Bring the buffer up to date by copying only what changed since it was last used.
+    rect = buffer->damage;
+    for (y = rect.y; y < rect.y + rect.h; ++y) {
+        const Uint8 *src = (const Uint8 *)fb->pixels + y * fb->pitch + rect.x * 4;
+        Uint8 *dst = (Uint8 *)buffer->shm.shm_data + y * fb->pitch + rect.x * 4;
+        SDL_memcpy(dst, src, rect.w * 4);
+    }
+    SDL_zero(buffer->damage);
+
+    buffer->shm.busy = true;
+    buffer->frame = ++fb->frame_count;
+
+    wl_surface_attach(wind->surface, buffer->shm.wl_buffer, 0, 0);
+
+    /* The compositor already has the previous frame, so only this frame's
+       rects are damaged. Surface-local damage would have to account for
+       buffer scale and viewports, so damage everything on old compositors. */
+    if (use_damage_buffer) {
+        for (i = 0; i < numrects; ++i) {
+            if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+                wl_surface_damage_buffer(wind->surface, rect.x, rect.y, rect.w, rect.h);
+            }
+        }
+    } else {
+        wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+    }
+
+    wl_surface_commit(wind->surface);
+    WAYLAND_wl_display_flush(wind->waylandData->display);
+
+    return true;
+}
+
+#endif // SDL_VIDEO_DRIVER_WAYLAND
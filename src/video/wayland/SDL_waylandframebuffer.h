@@ -0,0 +1,64 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_waylandframebuffer_h_
+#define SDL_waylandframebuffer_h_
+
+#include "SDL_internal.h"
+
+#include "SDL_waylandshmbuffer.h"
+
+// The most SHM buffers a window framebuffer will cycle through.
+#define WAYLAND_FRAMEBUFFER_MAX_BUFFERS 3
+
+struct Wayland_FramebufferBuffer
+{
+    struct Wayland_SHMBuffer shm;
+
+    // Everything that changed in the framebuffer since this buffer was last drawn into.
+    SDL_Rect damage;
+
+    // The frame this buffer was last committed on, to find the oldest one.
+    Uint64 frame;
+};
+
+struct Wayland_Framebuffer
+{
+    // The app draws here; damaged areas are copied into a free SHM buffer on update.
+    void *pixels;
+    int pitch;
+    int width;
+    int height;
+    Uint32 shm_format;
+
+    struct Wayland_FramebufferBuffer buffers[WAYLAND_FRAMEBUFFER_MAX_BUFFERS];
+    int num_buffers;
+    Uint64 frame_count;
+};
+
+extern bool Wayland_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window,
+                                            SDL_PixelFormat *format,
+                                            void **pixels, int *pitch);
+extern bool Wayland_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window,
+                                            const SDL_Rect *rects, int numrects);
+extern void Wayland_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window);
+
+#endif // SDL_waylandframebuffer_h_
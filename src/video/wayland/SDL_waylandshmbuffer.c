@@ -107,7 +107,9 @@ static int CreateTempFD(off_t size)
 
 static void buffer_handle_release(void *data, struct wl_buffer *wl_buffer)
 {
-    // NOP
+    struct Wayland_SHMBuffer *shmBuffer = (struct Wayland_SHMBuffer *)data;
+
+    shmBuffer->busy = false;
 }
 
 static struct wl_buffer_listener buffer_listener = {
@@ -115,11 +117,15 @@ static struct wl_buffer_listener buffer_listener = {
 };
 
 bool Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shmBuffer)
+{
+    return Wayland_AllocSHMBufferFormat(width, height, WL_SHM_FORMAT_ARGB8888, shmBuffer);
+}
+
+bool Wayland_AllocSHMBufferFormat(int width, int height, Uint32 format, struct Wayland_SHMBuffer *shmBuffer)
 {
     SDL_VideoDevice *vd = SDL_GetVideoDevice();
     SDL_VideoData *data = vd->internal;
     struct wl_shm_pool *shm_pool;
-    const Uint32 SHM_FMT = WL_SHM_FORMAT_ARGB8888;
 
     if (!shmBuffer) {
         return SDL_InvalidParamError("shmBuffer");
@@ -143,7 +149,8 @@ bool Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shm
     SDL_assert(shmBuffer->shm_data != NULL);
 
     shm_pool = wl_shm_create_pool(data->shm, shm_fd, shmBuffer->shm_data_size);
-    shmBuffer->wl_buffer = wl_shm_pool_create_buffer(shm_pool, 0, width, height, stride, SHM_FMT);
+    shmBuffer->wl_buffer = wl_shm_pool_create_buffer(shm_pool, 0, width, height, stride, format);
+    shmBuffer->busy = false;
     wl_buffer_add_listener(shmBuffer->wl_buffer, &buffer_listener, shmBuffer);
 
     wl_shm_pool_destroy(shm_pool);
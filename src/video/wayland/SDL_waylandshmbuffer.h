@@ -29,10 +29,15 @@ struct Wayland_SHMBuffer
     struct wl_buffer *wl_buffer;
     void *shm_data;
     int shm_data_size;
+
+    // Set when the buffer is committed, cleared when the compositor releases it.
+    bool busy;
 };
 
 // Allocates an SHM buffer with the format WL_SHM_FORMAT_ARGB8888
 extern bool Wayland_AllocSHMBuffer(int width, int height, struct Wayland_SHMBuffer *shmBuffer);
+// Allocates an SHM buffer with a 32-bit wl_shm format
+extern bool Wayland_AllocSHMBufferFormat(int width, int height, Uint32 format, struct Wayland_SHMBuffer *shmBuffer);
 extern void Wayland_ReleaseSHMBuffer(struct Wayland_SHMBuffer *shmBuffer);
 
 #endif
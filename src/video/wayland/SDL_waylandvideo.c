@@ -29,6 +29,7 @@
 #include "SDL_waylandclipboard.h"
 #include "SDL_waylandcolor.h"
 #include "SDL_waylandevents_c.h"
+#include "SDL_waylandframebuffer.h"
 #include "SDL_waylandkeyboard.h"
 #include "SDL_waylandmessagebox.h"
 #include "SDL_waylandmouse.h"
@@ -611,6 +612,9 @@ static SDL_VideoDevice *Wayland_CreateDevice(bool require_preferred_protocols)
 #endif
 
     device->CreateSDLWindow = Wayland_CreateWindow;
+    device->CreateWindowFramebuffer = Wayland_CreateWindowFramebuffer;
+    device->UpdateWindowFramebuffer = Wayland_UpdateWindowFramebuffer;
+    device->DestroyWindowFramebuffer = Wayland_DestroyWindowFramebuffer;
     device->ShowWindow = Wayland_ShowWindow;
     device->HideWindow = Wayland_HideWindow;
     device->RaiseWindow = Wayland_RaiseWindow;
@@ -653,6 +657,7 @@ static SDL_VideoDevice *Wayland_CreateDevice(bool require_preferred_protocols)
     device->SetClipboardData = Wayland_SetClipboardData;
     device->GetClipboardData = Wayland_GetClipboardData;
     device->HasClipboardData = Wayland_HasClipboardData;
+    device->OpenClipboardDataIO = Wayland_OpenClipboardDataIO;
     device->StartTextInput = Wayland_StartTextInput;
     device->StopTextInput = Wayland_StopTextInput;
     device->UpdateTextInputArea = Wayland_UpdateTextInputArea;
@@ -1401,6 +1406,13 @@ bool Wayland_VideoInit(SDL_VideoDevice *_this)
         return SDL_SetError("Failed to create XKB context");
     }
 
+    if (SDL_GetHintBoolean(SDL_HINT_VIDEO_WAYLAND_INPUT_THREAD, false)) {
+        data->input_lock = SDL_CreateMutex();
+        if (data->input_lock) {
+            data->input_queue = WAYLAND_wl_display_create_queue(data->display);
+        }
+    }
+
     data->registry = wl_display_get_registry(data->display);
     if (!data->registry) {
         return SDL_SetError("Failed to get the Wayland registry");
@@ -1445,6 +1457,10 @@ bool Wayland_VideoInit(SDL_VideoDevice *_this)
 
     data->initializing = false;
 
+    if (!Wayland_StartInputThread(data)) {
+        SDL_LogError(SDL_LOG_CATEGORY_VIDEO, "wayland: Failed to start the input thread, relative pointer events will be read when pumping events");
+    }
+
     return true;
 }
 
@@ -1483,6 +1499,8 @@ static void Wayland_VideoCleanup(SDL_VideoDevice *_this)
     SDL_VideoData *data = _this->internal;
     int i;
 
+    Wayland_StopInputThread(data);
+
     Wayland_FiniMouse(data);
 
     for (i = _this->num_displays - 1; i >= 0; --i) {
@@ -1624,6 +1642,16 @@ static void Wayland_VideoCleanup(SDL_VideoDevice *_this)
         wl_registry_destroy(data->registry);
         data->registry = NULL;
     }
+
+    if (data->input_queue) {
+        WAYLAND_wl_event_queue_destroy(data->input_queue);
+        data->input_queue = NULL;
+    }
+
+    if (data->input_lock) {
+        SDL_DestroyMutex(data->input_lock);
+        data->input_lock = NULL;
+    }
 }
 
 bool Wayland_VideoReconnect(SDL_VideoDevice *_this)
@@ -88,6 +88,13 @@ struct SDL_VideoData
 
     struct xkb_context *xkb_context;
     struct SDL_WaylandInput *input;
+
+    // Optional thread that reads the display connection and dispatches relative pointer events
+    struct wl_event_queue *input_queue;
+    SDL_Mutex *input_lock; // held while input handlers run on either thread, and while windows are destroyed
+    SDL_Thread *input_thread;
+    SDL_AtomicInt input_thread_quit;
+
     SDL_DisplayData **output_list;
     int output_count;
     int output_max;
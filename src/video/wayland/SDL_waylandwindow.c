@@ -683,11 +683,15 @@ static void surface_frame_done(void *data, struct wl_callback *cb, uint32_t time
     /* XXX: This is needed to work around an Nvidia egl-wayland bug due to buffer coordinates
      *      being used with wl_surface_damage, which causes part of the output to not be
      *      updated when using a viewport with an output region larger than the source region.
+     *
+     *      SHM framebuffers report their own damage, so leave them alone.
      */
-    if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
-        wl_surface_damage_buffer(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
-    } else {
-        wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+    if (!wind->framebuffer) {
+        if (wl_compositor_get_version(wind->waylandData->compositor) >= WL_SURFACE_DAMAGE_BUFFER_SINCE_VERSION) {
+            wl_surface_damage_buffer(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+        } else {
+            wl_surface_damage(wind->surface, 0, 0, SDL_MAX_SINT32, SDL_MAX_SINT32);
+        }
     }
 
     wind->drop_interactive_resizes = false;
@@ -3065,6 +3069,9 @@ void Wayland_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
     SDL_WindowData *wind = window->internal;
 
     if (data && wind) {
+        // Don't let the input thread run handlers that might still be looking at this window.
+        SDL_LockMutex(data->input_lock);
+
         /* Roundtrip before destroying the window to make sure that it has received input leave events, so that
          * no internal structures are left pointing to the destroyed window.
          */
@@ -3141,6 +3148,8 @@ void Wayland_DestroyWindow(SDL_VideoDevice *_this, SDL_Window *window)
 
         SDL_free(wind);
         WAYLAND_wl_display_flush(data->display);
+
+        SDL_UnlockMutex(data->input_lock);
     }
     window->internal = NULL;
 }
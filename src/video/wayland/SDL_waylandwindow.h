@@ -126,6 +126,8 @@ struct SDL_WindowData
     char *app_id;
     double scale_factor;
 
+    struct Wayland_Framebuffer *framebuffer;
+
     struct Wayland_SHMBuffer *icon_buffers;
     int icon_buffer_count;
 
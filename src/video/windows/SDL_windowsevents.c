@@ -25,6 +25,7 @@
 #include "SDL_windowsvideo.h"
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_touch_c.h"
+#include "../../SDL_hints_c.h"
 #include "../../events/scancodes_windows.h"
 #include "../../main/SDL_main_callbacks.h"
 #include "../../core/windows/SDL_hid.h"
@@ -229,10 +230,12 @@ static SDL_Scancode WindowsScanCodeToSDLScanCode(LPARAM lParam, WPARAM wParam, U
 }
 
 #if !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+static SDL_CachedHint WIN_focus_clickthrough_hint = SDL_CACHED_HINT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+
 static bool WIN_ShouldIgnoreFocusClick(SDL_WindowData *data)
 {
     return !SDL_WINDOW_IS_POPUP(data->window) &&
-           !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+           !SDL_GetCachedHintBoolean(&WIN_focus_clickthrough_hint);
 }
 
 static void WIN_CheckWParamMouseButton(Uint64 timestamp, bool bwParamMousePressed, Uint32 mouseFlags, bool bSwapButtons, SDL_WindowData *data, Uint8 button, SDL_MouseID mouseID)
@@ -425,9 +428,11 @@ static void WIN_UpdateFocus(SDL_Window *window, bool expect_focus, DWORD pos)
 }
 #endif // !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
 
+static SDL_CachedHint WIN_close_on_alt_f4_hint = SDL_CACHED_HINT(SDL_HINT_WINDOWS_CLOSE_ON_ALT_F4, true);
+
 static bool ShouldGenerateWindowCloseOnAltF4(void)
 {
-    return SDL_GetHintBoolean(SDL_HINT_WINDOWS_CLOSE_ON_ALT_F4, true);
+    return SDL_GetCachedHintBoolean(&WIN_close_on_alt_f4_hint);
 }
 
 static bool ShouldClearWindowOnEraseBackground(SDL_WindowData *data)
@@ -22,8 +22,258 @@
 
 #if defined(SDL_VIDEO_DRIVER_WINDOWS) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
 
+#define COBJMACROS
 #include "SDL_windowsvideo.h"
 
+#ifdef HAVE_D3D11_H
+#include <d3d11.h>
+#include <dxgi1_2.h>
+
+static const GUID SDL_IID_IDXGIDevice = { 0x54ec77fa, 0x1377, 0x44e6, { 0x8c, 0x32, 0x88, 0xfd, 0x5f, 0x44, 0xc8, 0x4c } };
+static const GUID SDL_IID_IDXGIFactory2 = { 0x50c83a1c, 0xe072, 0x4c48, { 0x87, 0xb0, 0x36, 0x30, 0xfa, 0x36, 0xa6, 0xd0 } };
+static const GUID SDL_IID_ID3D11Texture2D = { 0x6f15aaf2, 0xd208, 0x4e89, { 0x9a, 0xb4, 0x48, 0x95, 0x35, 0xd3, 0x4f, 0x9c } };
+
+/* The app draws into system memory as usual, and each update copies just the
+   updated rects into the swapchain's back buffer and presents them as dirty
+   rects. With FLIP_SEQUENTIAL, DXGI carries the rest of the previous frame
+   over to the new back buffer for us. */
+typedef struct WIN_FlipFramebuffer
+{
+    SDL_SharedObject *d3d11_dll;
+    ID3D11Device *device;
+    ID3D11DeviceContext *context;
+    IDXGISwapChain1 *swapchain;
+    ID3D11Texture2D *backbuffer;
+    void *pixels;
+    int pitch;
+    int width;
+    int height;
+    bool presented;
+    UINT last_present_count;
+} WIN_FlipFramebuffer;
+
+static void WIN_DestroyFlipFramebuffer(WIN_FlipFramebuffer *fb)
+{
+    if (fb->backbuffer) {
+        ID3D11Texture2D_Release(fb->backbuffer);
+    }
+    if (fb->swapchain) {
+        IDXGISwapChain1_Release(fb->swapchain);
+    }
+    if (fb->context) {
+        ID3D11DeviceContext_Release(fb->context);
+    }
+    if (fb->device) {
+        ID3D11Device_Release(fb->device);
+    }
+    if (fb->d3d11_dll) {
+        SDL_UnloadObject(fb->d3d11_dll);
+    }
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+}
+
+static WIN_FlipFramebuffer *WIN_CreateFlipFramebuffer(SDL_WindowData *data, int w, int h)
+{
+    PFN_D3D11_CREATE_DEVICE D3D11CreateDeviceFunc;
+    DXGI_SWAP_CHAIN_DESC1 desc;
+    IDXGIDevice *dxgi_device = NULL;
+    IDXGIAdapter *dxgi_adapter = NULL;
+    IDXGIFactory2 *dxgi_factory = NULL;
+    WIN_FlipFramebuffer *fb;
+    HRESULT result;
+
+    fb = (WIN_FlipFramebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return NULL;
+    }
+
+    fb->width = w;
+    fb->height = h;
+    fb->pitch = w * 4;
+    fb->pixels = SDL_calloc(h, fb->pitch);
+    if (!fb->pixels) {
+        goto error;
+    }
+
+    fb->d3d11_dll = SDL_LoadObject("d3d11.dll");
+    if (!fb->d3d11_dll) {
+        goto error;
+    }
+
+    D3D11CreateDeviceFunc = (PFN_D3D11_CREATE_DEVICE)SDL_LoadFunction(fb->d3d11_dll, "D3D11CreateDevice");
+    if (!D3D11CreateDeviceFunc) {
+        goto error;
+    }
+
+    result = D3D11CreateDeviceFunc(NULL, D3D_DRIVER_TYPE_HARDWARE, NULL, D3D11_CREATE_DEVICE_BGRA_SUPPORT,
+                                   NULL, 0, D3D11_SDK_VERSION, &fb->device, NULL, &fb->context);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT("D3D11CreateDevice", result);
+        goto error;
+    }
+
+    // Use the factory that made the device's adapter, so the swapchain matches it.
+    result = ID3D11Device_QueryInterface(fb->device, &SDL_IID_IDXGIDevice, (void **)&dxgi_device);
+    if (SUCCEEDED(result)) {
+        result = IDXGIDevice_GetAdapter(dxgi_device, &dxgi_adapter);
+    }
+    if (SUCCEEDED(result)) {
+        result = IDXGIAdapter_GetParent(dxgi_adapter, &SDL_IID_IDXGIFactory2, (void **)&dxgi_factory);
+    }
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT("IDXGIAdapter::GetParent", result);
+        goto error;
+    }
+
+    SDL_zero(desc);
+    desc.Width = w;
+    desc.Height = h;
+    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM; // SDL_PIXELFORMAT_XRGB8888 in memory order
+    desc.SampleDesc.Count = 1;
+    desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+    desc.BufferCount = 2;
+    desc.Scaling = DXGI_SCALING_NONE;
+    desc.SwapEffect = DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL; // Keeps the previous frame's contents, which dirty rects rely on.
+    desc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
+
+    result = IDXGIFactory2_CreateSwapChainForHwnd(dxgi_factory, (IUnknown *)fb->device, data->hwnd, &desc, NULL, NULL, &fb->swapchain);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT("IDXGIFactory2::CreateSwapChainForHwnd", result);
+        goto error;
+    }
+
+    // SDL handles fullscreen itself
+    IDXGIFactory2_MakeWindowAssociation(dxgi_factory, data->hwnd, DXGI_MWA_NO_WINDOW_CHANGES);
+
+    // With flip-model swapchains, buffer 0 always refers to the current back buffer.
+    result = IDXGISwapChain1_GetBuffer(fb->swapchain, 0, &SDL_IID_ID3D11Texture2D, (void **)&fb->backbuffer);
+    if (FAILED(result)) {
+        WIN_SetErrorFromHRESULT("IDXGISwapChain1::GetBuffer", result);
+        goto error;
+    }
+
+    IDXGIFactory2_Release(dxgi_factory);
+    IDXGIAdapter_Release(dxgi_adapter);
+    IDXGIDevice_Release(dxgi_device);
+
+    return fb;
+
+error:
+    if (dxgi_factory) {
+        IDXGIFactory2_Release(dxgi_factory);
+    }
+    if (dxgi_adapter) {
+        IDXGIAdapter_Release(dxgi_adapter);
+    }
+    if (dxgi_device) {
+        IDXGIDevice_Release(dxgi_device);
+    }
+    WIN_DestroyFlipFramebuffer(fb);
+    return NULL;
+}
+
+// Report the last frame DXGI says reached the screen, if it's new.
+static void WIN_UpdateFlipFramebufferFeedback(SDL_Window *window, WIN_FlipFramebuffer *fb)
+{
+    const SDL_DisplayMode *mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    DXGI_FRAME_STATISTICS stats;
+    LARGE_INTEGER now, frequency;
+    Uint64 present_ns = SDL_GetTicksNS();
+    Uint64 refresh_ns = 0;
+
+    if (FAILED(IDXGISwapChain1_GetFrameStatistics(fb->swapchain, &stats)) ||
+        stats.PresentCount == fb->last_present_count) {
+        return;
+    }
+    fb->last_present_count = stats.PresentCount;
+
+    // SyncQPCTime is when the frame was shown, in QueryPerformanceCounter() time.
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    if (now.QuadPart > stats.SyncQPCTime.QuadPart && frequency.QuadPart > 0) {
+        const Uint64 age_ns = ((Uint64)(now.QuadPart - stats.SyncQPCTime.QuadPart) * SDL_NS_PER_SECOND) / (Uint64)frequency.QuadPart;
+        if (present_ns > age_ns) {
+            present_ns -= age_ns;
+        }
+    }
+
+    if (mode && mode->refresh_rate_numerator > 0) {
+        refresh_ns = ((Uint64)mode->refresh_rate_denominator * SDL_NS_PER_SECOND) / (Uint64)mode->refresh_rate_numerator;
+    }
+
+    // Presents aren't tied to vblanks here, so there's no meaningful missed vblank count.
+    SDL_OnWindowPresented(window, present_ns, refresh_ns, 0);
+}
+
+static bool WIN_UpdateFlipFramebuffer(SDL_Window *window, WIN_FlipFramebuffer *fb, const SDL_Rect *rects, int numrects)
+{
+    const SDL_Rect bounds = { 0, 0, fb->width, fb->height };
+    DXGI_PRESENT_PARAMETERS params;
+    bool isstack;
+    RECT *dirty;
+    SDL_Rect rect;
+    UINT numdirty = 0;
+    HRESULT result;
+    int i;
+
+    dirty = SDL_small_alloc(RECT, numrects > 0 ? numrects : 1, &isstack);
+    if (!dirty) {
+        return false;
+    }
+
+    // The first frame has nothing to carry over, so upload and present all of it.
+    if (!fb->presented) {
+        ID3D11DeviceContext_UpdateSubresource(fb->context, (ID3D11Resource *)fb->backbuffer, 0, NULL, fb->pixels, fb->pitch, 0);
+    } else {
+        for (i = 0; i < numrects; ++i) {
+            D3D11_BOX box;
+
+            if (!SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+                continue;
+            }
+
+            box.left = rect.x;
+            box.top = rect.y;
+            box.front = 0;
+            box.right = rect.x + rect.w;
+            box.bottom = rect.y + rect.h;
+            box.back = 1;
+            ID3D11DeviceContext_UpdateSubresource(fb->context, (ID3D11Resource *)fb->backbuffer, 0, &box,
+                                                  (const Uint8 *)fb->pixels + rect.y * fb->pitch + rect.x * 4, fb->pitch, 0);
+
+            dirty[numdirty].left = rect.x;
+            dirty[numdirty].top = rect.y;
+            dirty[numdirty].right = rect.x + rect.w;
+            dirty[numdirty].bottom = rect.y + rect.h;
+            ++numdirty;
+        }
+
+        if (numdirty == 0) {
+            SDL_small_free(dirty, isstack);
+            return true;
+        }
+    }
+
+    SDL_zero(params);
+    params.DirtyRectsCount = fb->presented ? numdirty : 0;
+    params.pDirtyRects = fb->presented ? dirty : NULL;
+
+    // Don't block on vblank, DWM composes flip-model presents without tearing.
+    result = IDXGISwapChain1_Present1(fb->swapchain, 0, 0, &params);
+    SDL_small_free(dirty, isstack);
+
+    if (FAILED(result)) {
+        return WIN_SetErrorFromHRESULT("IDXGISwapChain1::Present1", result);
+    }
+    fb->presented = true;
+
+    WIN_UpdateFlipFramebufferFeedback(window, fb);
+
+    return true;
+}
+#endif // HAVE_D3D11_H
+
 bool WIN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format, void **pixels, int *pitch)
 {
     SDL_WindowData *data = window->internal;
@@ -38,10 +288,32 @@ bool WIN_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL
     // Free the old framebuffer surface
     if (data->mdc) {
         DeleteDC(data->mdc);
+        data->mdc = NULL;
     }
     if (data->hbm) {
         DeleteObject(data->hbm);
+        data->hbm = NULL;
+    }
+#ifdef HAVE_D3D11_H
+    if (data->flip_framebuffer) {
+        WIN_DestroyFlipFramebuffer(data->flip_framebuffer);
+        data->flip_framebuffer = NULL;
+    }
+
+    if (SDL_GetHintBoolean(SDL_HINT_WINDOWS_FRAMEBUFFER_FLIP_MODEL, false) && w > 0 && h > 0) {
+        data->flip_framebuffer = WIN_CreateFlipFramebuffer(data, w, h);
+        if (data->flip_framebuffer) {
+            *format = SDL_PIXELFORMAT_XRGB8888;
+            *pixels = data->flip_framebuffer->pixels;
+            *pitch = data->flip_framebuffer->pitch;
+            return true;
+        }
+        // Fall back to GDI
     }
+#endif
+
+    // BitBlt() only copies the updated rects, so the DIB can be larger than the window
+    SDL_GetWindowFramebufferAllocSize(window, &w, &h);
 
     // Find out the format of the screen
     size = sizeof(BITMAPINFOHEADER) + 256 * sizeof(RGBQUAD);
@@ -103,6 +375,12 @@ bool WIN_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, con
     SDL_WindowData *data = window->internal;
     int i;
 
+#ifdef HAVE_D3D11_H
+    if (data->flip_framebuffer) {
+        return WIN_UpdateFlipFramebuffer(window, data->flip_framebuffer, rects, numrects);
+    }
+#endif
+
     for (i = 0; i < numrects; ++i) {
         BitBlt(data->hdc, rects[i].x, rects[i].y, rects[i].w, rects[i].h,
                data->mdc, rects[i].x, rects[i].y, SRCCOPY);
@@ -127,6 +405,12 @@ void WIN_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
         DeleteObject(data->hbm);
         data->hbm = NULL;
     }
+#ifdef HAVE_D3D11_H
+    if (data->flip_framebuffer) {
+        WIN_DestroyFlipFramebuffer(data->flip_framebuffer);
+        data->flip_framebuffer = NULL;
+    }
+#endif
 }
 
 #endif // SDL_VIDEO_DRIVER_WINDOWS
@@ -29,6 +29,7 @@
 #include <limits.h> // For INT_MAX
 
 #include "SDL_x11video.h"
+#include "SDL_x11framebuffer.h"
 #include "SDL_x11pen.h"
 #include "SDL_x11touch.h"
 #include "SDL_x11xinput2.h"
@@ -40,6 +41,7 @@
 #include "../../events/SDL_events_c.h"
 #include "../../events/SDL_mouse_c.h"
 #include "../../events/SDL_touch_c.h"
+#include "../../SDL_hints_c.h"
 #include "../../core/linux/SDL_system_theme.h"
 #include "../SDL_sysvideo.h"
 
@@ -1013,6 +1015,8 @@ void X11_HandleKeyEvent(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_
     }
 }
 
+static SDL_CachedHint X11_focus_clickthrough_hint = SDL_CACHED_HINT(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+
 void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, SDL_MouseID mouseID, int button, float x, float y, unsigned long time)
 {
     SDL_Window *window = windowdata->window;
@@ -1047,7 +1051,7 @@ void X11_HandleButtonPress(SDL_VideoDevice *_this, SDL_WindowData *windowdata, S
         if (windowdata->last_focus_event_time) {
             const int X11_FOCUS_CLICK_TIMEOUT = 10;
             if (SDL_GetTicks() < (windowdata->last_focus_event_time + X11_FOCUS_CLICK_TIMEOUT)) {
-                ignore_click = !SDL_GetHintBoolean(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, false);
+                ignore_click = !SDL_GetCachedHintBoolean(&X11_focus_clickthrough_hint);
             }
             windowdata->last_focus_event_time = 0;
         }
@@ -1185,6 +1189,13 @@ static void X11_DispatchEvent(SDL_VideoDevice *_this, XEvent *xevent)
     }
 #endif
 
+#ifndef NO_SHARED_MEMORY
+    if (videodata->shm_event_base && (xevent->type == (videodata->shm_event_base + ShmCompletion))) {
+        X11_HandleShmCompletion(_this, (XShmCompletionEvent *)xevent);
+        return;
+    }
+#endif
+
 #ifdef DEBUG_XEVENTS
     SDL_Log("X11 event type = %d display = %p window = 0x%lx",
            xevent->type, xevent->xany.display, xevent->xany.window);
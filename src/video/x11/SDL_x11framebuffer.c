@@ -46,6 +46,180 @@ static bool have_mitshm(Display *dpy)
     return X11_XShmQueryExtension(dpy) ? SDL_X11_HAVE_SHM : false;
 }
 
+static XImage *X11_CreateShmImage(Display *display, Visual *visual, int depth,
+                                  XShmSegmentInfo *shminfo, int w, int h, int pitch)
+{
+    XImage *ximage;
+
+    shminfo->shmid = shmget(IPC_PRIVATE, (size_t)h * pitch, IPC_CREAT | 0777);
+    if (shminfo->shmid < 0) {
+        return NULL;
+    }
+    shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
+    shminfo->readOnly = False;
+    if (shminfo->shmaddr == (char *)-1) {
+        shmctl(shminfo->shmid, IPC_RMID, NULL);
+        return NULL;
+    }
+
+    shm_error = False;
+    X_handler = X11_XSetErrorHandler(shm_errhandler);
+    X11_XShmAttach(display, shminfo);
+    X11_XSync(display, False);
+    X11_XSetErrorHandler(X_handler);
+    shmctl(shminfo->shmid, IPC_RMID, NULL);
+    if (shm_error) {
+        shmdt(shminfo->shmaddr);
+        return NULL;
+    }
+
+    ximage = X11_XShmCreateImage(display, visual, depth, ZPixmap,
+                                 shminfo->shmaddr, shminfo, w, h);
+    if (!ximage) {
+        X11_XShmDetach(display, shminfo);
+        X11_XSync(display, False);
+        shmdt(shminfo->shmaddr);
+        return NULL;
+    }
+    ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
+    return ximage;
+}
+
+static void X11_DestroyShmImage(Display *display, XShmSegmentInfo *shminfo, XImage *ximage)
+{
+    XDestroyImage(ximage);
+    X11_XShmDetach(display, shminfo);
+    X11_XSync(display, False);
+    shmdt(shminfo->shmaddr);
+}
+
+static void X11_DestroyAsyncFramebuffer(Display *display, struct X11_Framebuffer *fb)
+{
+    int i;
+
+    for (i = 0; i < X11_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        if (fb->buffers[i].ximage) {
+            X11_DestroyShmImage(display, &fb->buffers[i].shminfo, fb->buffers[i].ximage);
+        }
+    }
+    SDL_free(fb->pixels);
+    SDL_free(fb);
+}
+
+static bool X11_CreateAsyncFramebuffer(SDL_WindowData *data, const XVisualInfo *vinfo, int w, int h, int pitch)
+{
+    Display *display = data->videodata->display;
+    struct X11_Framebuffer *fb;
+    int i;
+
+    fb = (struct X11_Framebuffer *)SDL_calloc(1, sizeof(*fb));
+    if (!fb) {
+        return false;
+    }
+    fb->pitch = pitch;
+    fb->pixels = SDL_calloc(h, pitch);
+    if (!fb->pixels) {
+        SDL_free(fb);
+        return false;
+    }
+
+    for (i = 0; i < X11_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        struct X11_FramebufferBuffer *buffer = &fb->buffers[i];
+
+        buffer->ximage = X11_CreateShmImage(display, data->visual, vinfo->depth, &buffer->shminfo, w, h, pitch);
+        if (!buffer->ximage) {
+            X11_DestroyAsyncFramebuffer(display, fb);
+            return false;
+        }
+    }
+
+    data->videodata->shm_event_base = X11_XShmGetEventBase(display);
+    data->async_framebuffer = fb;
+    return true;
+}
+
+static Bool X11_IsShmCompletionForWindow(Display *display, XEvent *event, XPointer arg)
+{
+    const SDL_WindowData *data = (const SDL_WindowData *)arg;
+
+    return (event->type == (data->videodata->shm_event_base + ShmCompletion)) &&
+           (((XShmCompletionEvent *)event)->drawable == data->xwindow);
+}
+
+void X11_HandleShmCompletion(SDL_VideoDevice *_this, const XShmCompletionEvent *event)
+{
+    SDL_WindowData *data = X11_FindWindow(_this, event->drawable);
+    int i;
+
+    if (!data || !data->async_framebuffer) {
+        // The framebuffer was destroyed while the server was still drawing it
+        return;
+    }
+
+    for (i = 0; i < X11_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        if (data->async_framebuffer->buffers[i].shminfo.shmseg == event->shmseg) {
+            data->async_framebuffer->buffers[i].busy = false;
+        }
+    }
+}
+
+static void X11_UpdateAsyncFramebuffer(SDL_VideoDevice *_this, SDL_WindowData *data, const SDL_Rect *rects, int numrects,
+                                       int window_w, int window_h)
+{
+    Display *display = data->videodata->display;
+    struct X11_Framebuffer *fb = data->async_framebuffer;
+    struct X11_FramebufferBuffer *buffer;
+    const SDL_Rect bounds = { 0, 0, window_w, window_h };
+    SDL_Rect frame_damage = { 0, 0, 0, 0 };
+    SDL_Rect rect;
+    const Uint8 *src;
+    Uint8 *dst;
+    int i, last_rect = -1;
+
+    for (i = 0; i < numrects; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            SDL_GetRectUnion(&frame_damage, &rect, &frame_damage);
+            last_rect = i;
+        }
+    }
+    if (last_rect < 0) {
+        return;
+    }
+
+    for (i = 0; i < X11_FRAMEBUFFER_NUM_BUFFERS; ++i) {
+        SDL_GetRectUnion(&fb->buffers[i].damage, &frame_damage, &fb->buffers[i].damage);
+    }
+
+    // Only block if the server hasn't finished reading the segment we're about to reuse
+    buffer = &fb->buffers[fb->next_buffer];
+    while (buffer->busy) {
+        XEvent event;
+        X11_XIfEvent(display, &event, X11_IsShmCompletionForWindow, (XPointer)data);
+        X11_HandleShmCompletion(_this, (XShmCompletionEvent *)&event);
+    }
+    fb->next_buffer = (fb->next_buffer + 1) % X11_FRAMEBUFFER_NUM_BUFFERS;
+
+    // Bring the segment up to date with everything drawn since it was last used
+    src = (const Uint8 *)fb->pixels + buffer->damage.y * fb->pitch + buffer->damage.x * buffer->ximage->bits_per_pixel / 8;
+    dst = (Uint8 *)buffer->ximage->data + buffer->damage.y * buffer->ximage->bytes_per_line + buffer->damage.x * buffer->ximage->bits_per_pixel / 8;
+    for (i = 0; i < buffer->damage.h; ++i) {
+        SDL_memcpy(dst, src, (size_t)buffer->damage.w * buffer->ximage->bits_per_pixel / 8);
+        src += fb->pitch;
+        dst += buffer->ximage->bytes_per_line;
+    }
+    SDL_zero(buffer->damage);
+
+    /* Requests are processed in order, so a completion event on the last
+       put means the server is done with the whole segment. */
+    for (i = 0; i <= last_rect; ++i) {
+        if (SDL_GetRectIntersection(&rects[i], &bounds, &rect)) {
+            X11_XShmPutImage(display, data->xwindow, data->gc, buffer->ximage,
+                             rect.x, rect.y, rect.x, rect.y, rect.w, rect.h, (i == last_rect) ? True : False);
+        }
+    }
+    buffer->busy = true;
+}
+
 #endif // !NO_SHARED_MEMORY
 
 bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL_PixelFormat *format,
@@ -57,7 +231,8 @@ bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL
     XVisualInfo vinfo;
     int w, h;
 
-    SDL_GetWindowSizeInPixels(window, &w, &h);
+    // Updates put just the updated rects, so the image can be larger than the window
+    SDL_GetWindowFramebufferAllocSize(window, &w, &h);
 
     // Free the old framebuffer surface
     X11_DestroyWindowFramebuffer(_this, window);
@@ -85,44 +260,18 @@ bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, SDL
     // Create the actual image
 #ifndef NO_SHARED_MEMORY
     if (have_mitshm(display)) {
-        XShmSegmentInfo *shminfo = &data->shminfo;
-
-        shminfo->shmid = shmget(IPC_PRIVATE, (size_t)h * (*pitch), IPC_CREAT | 0777);
-        if (shminfo->shmid >= 0) {
-            shminfo->shmaddr = (char *)shmat(shminfo->shmid, 0, 0);
-            shminfo->readOnly = False;
-            if (shminfo->shmaddr != (char *)-1) {
-                shm_error = False;
-                X_handler = X11_XSetErrorHandler(shm_errhandler);
-                X11_XShmAttach(display, shminfo);
-                X11_XSync(display, False);
-                X11_XSetErrorHandler(X_handler);
-                if (shm_error) {
-                    shmdt(shminfo->shmaddr);
-                }
-            } else {
-                shm_error = True;
-            }
-            shmctl(shminfo->shmid, IPC_RMID, NULL);
-        } else {
-            shm_error = True;
+        if (SDL_GetHintBoolean(SDL_HINT_VIDEO_X11_FRAMEBUFFER_ASYNC, false) &&
+            X11_CreateAsyncFramebuffer(data, &vinfo, w, h, *pitch)) {
+            *pixels = data->async_framebuffer->pixels;
+            return true;
         }
-        if (!shm_error) {
-            data->ximage = X11_XShmCreateImage(display, data->visual,
-                                               vinfo.depth, ZPixmap,
-                                               shminfo->shmaddr, shminfo,
-                                               w, h);
-            if (!data->ximage) {
-                X11_XShmDetach(display, shminfo);
-                X11_XSync(display, False);
-                shmdt(shminfo->shmaddr);
-            } else {
-                // Done!
-                data->ximage->byte_order = (SDL_BYTEORDER == SDL_BIG_ENDIAN) ? MSBFirst : LSBFirst;
-                data->use_mitshm = true;
-                *pixels = shminfo->shmaddr;
-                return true;
-            }
+
+        data->ximage = X11_CreateShmImage(display, data->visual, vinfo.depth, &data->shminfo, w, h, *pitch);
+        if (data->ximage) {
+            // Done!
+            data->use_mitshm = true;
+            *pixels = data->shminfo.shmaddr;
+            return true;
         }
     }
 #endif // not NO_SHARED_MEMORY
@@ -155,7 +304,9 @@ bool X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, con
     SDL_GetWindowSizeInPixels(window, &window_w, &window_h);
 
 #ifndef NO_SHARED_MEMORY
-    if (data->use_mitshm) {
+    if (data->async_framebuffer) {
+        X11_UpdateAsyncFramebuffer(_this, data, rects, numrects, window_w, window_h);
+    } else if (data->use_mitshm) {
         for (i = 0; i < numrects; ++i) {
             x = rects[i].x;
             y = rects[i].y;
@@ -221,6 +372,13 @@ bool X11_UpdateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window, con
     X11_HandlePresent(data->window);
 #endif /* SDL_VIDEO_DRIVER_X11_XSYNC */
 
+#ifndef NO_SHARED_MEMORY
+    if (data->async_framebuffer) {
+        X11_XFlush(display);
+        return true;
+    }
+#endif // !NO_SHARED_MEMORY
+
     X11_XSync(display, False);
 
     return true;
@@ -238,17 +396,23 @@ void X11_DestroyWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window)
 
     display = data->videodata->display;
 
-    if (data->ximage) {
-        XDestroyImage(data->ximage);
+#ifndef NO_SHARED_MEMORY
+    if (data->async_framebuffer) {
+        X11_DestroyAsyncFramebuffer(display, data->async_framebuffer);
+        data->async_framebuffer = NULL;
+    }
+#endif // !NO_SHARED_MEMORY
 
+    if (data->ximage) {
 #ifndef NO_SHARED_MEMORY
         if (data->use_mitshm) {
-            X11_XShmDetach(display, &data->shminfo);
-            X11_XSync(display, False);
-            shmdt(data->shminfo.shmaddr);
+            X11_DestroyShmImage(display, &data->shminfo, data->ximage);
             data->use_mitshm = false;
-        }
+        } else
 #endif // !NO_SHARED_MEMORY
+        {
+            XDestroyImage(data->ximage);
+        }
 
         data->ximage = NULL;
     }
@@ -24,6 +24,37 @@
 
 #include "SDL_internal.h"
 
+#ifndef NO_SHARED_MEMORY
+
+// The MIT-SHM segments an asynchronous window framebuffer alternates between.
+#define X11_FRAMEBUFFER_NUM_BUFFERS 2
+
+struct X11_FramebufferBuffer
+{
+    XShmSegmentInfo shminfo;
+    XImage *ximage;
+
+    // Waiting for the server's ShmCompletion event before it can be reused.
+    bool busy;
+
+    // Everything that changed in the framebuffer since this buffer was last drawn into.
+    SDL_Rect damage;
+};
+
+struct X11_Framebuffer
+{
+    // The app draws here; damaged areas are copied into a free segment on update.
+    void *pixels;
+    int pitch;
+
+    struct X11_FramebufferBuffer buffers[X11_FRAMEBUFFER_NUM_BUFFERS];
+    int next_buffer;
+};
+
+extern void X11_HandleShmCompletion(SDL_VideoDevice *_this, const XShmCompletionEvent *event);
+
+#endif // !NO_SHARED_MEMORY
+
 extern bool X11_CreateWindowFramebuffer(SDL_VideoDevice *_this, SDL_Window *window,
                                         SDL_PixelFormat *format,
                                         void **pixels, int *pitch);
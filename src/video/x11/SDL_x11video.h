@@ -141,6 +141,7 @@ struct SDL_VideoData
     bool xinput_hierarchy_changed;
 
     int xrandr_event_base;
+    int shm_event_base;
     struct
     {
 #ifdef SDL_VIDEO_DRIVER_X11_HAS_XKBLOOKUPKEYSYM
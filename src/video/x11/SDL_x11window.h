@@ -50,6 +50,7 @@ struct SDL_WindowData
     // MIT shared memory extension information
     bool use_mitshm;
     XShmSegmentInfo shminfo;
+    struct X11_Framebuffer *async_framebuffer;
 #endif
     XImage *ximage;
     GC gc;
@@ -0,0 +1,120 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+#include "SDL_internal.h"
+
+#ifdef SDL_HAVE_YUV
+#include "yuv_rgb_internal.h"
+
+#ifdef SDL_NEON_INTRINSICS
+
+#define NEON_FUNCTION_NAME	yuv420_rgb565_neon
+#define STD_FUNCTION_NAME	yuv420_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgb24_neon
+#define STD_FUNCTION_NAME	yuv420_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_rgba_neon
+#define STD_FUNCTION_NAME	yuv420_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_bgra_neon
+#define STD_FUNCTION_NAME	yuv420_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_argb_neon
+#define STD_FUNCTION_NAME	yuv420_argb_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv420_abgr_neon
+#define STD_FUNCTION_NAME	yuv420_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_420
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb565_neon
+#define STD_FUNCTION_NAME	yuv422_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgb24_neon
+#define STD_FUNCTION_NAME	yuv422_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_rgba_neon
+#define STD_FUNCTION_NAME	yuv422_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_bgra_neon
+#define STD_FUNCTION_NAME	yuv422_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_argb_neon
+#define STD_FUNCTION_NAME	yuv422_argb_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuv422_abgr_neon
+#define STD_FUNCTION_NAME	yuv422_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_422
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb565_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb565_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB565
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgb24_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgb24_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGB24
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_rgba_neon
+#define STD_FUNCTION_NAME	yuvnv12_rgba_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_RGBA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_bgra_neon
+#define STD_FUNCTION_NAME	yuvnv12_bgra_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_BGRA
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_argb_neon
+#define STD_FUNCTION_NAME	yuvnv12_argb_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ARGB
+#include "yuv_rgb_neon_func.h"
+
+#define NEON_FUNCTION_NAME	yuvnv12_abgr_neon
+#define STD_FUNCTION_NAME	yuvnv12_abgr_std
+#define YUV_FORMAT			YUV_FORMAT_NV12
+#define RGB_FORMAT			RGB_FORMAT_ABGR
+#include "yuv_rgb_neon_func.h"
+
+#endif // SDL_NEON_INTRINSICS
+
+#endif // SDL_HAVE_YUV
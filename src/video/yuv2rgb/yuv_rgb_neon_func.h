@@ -0,0 +1,351 @@
+// Copyright 2016 Adrien Descamps
+// Distributed under BSD 3-Clause License
+
+/* You need to define the following macros before including this file:
+	NEON_FUNCTION_NAME
+	STD_FUNCTION_NAME
+	YUV_FORMAT
+	RGB_FORMAT
+*/
+
+/* This follows the SSE2 algorithm, with the same 16-bit arithmetic, so both give the same results.
+ * The structured loads and stores do the packed format (de)interleaving.
+ */
+
+#define UV2RGB_16(U,V,R1,G1,B1,R2,G2,B2) \
+{ \
+	int16x8x2_t dup; \
+	r_tmp = vmulq_n_s16(V, param->v_r_factor); \
+	g_tmp = vmlaq_n_s16(vmulq_n_s16(U, param->u_g_factor), V, param->v_g_factor); \
+	b_tmp = vmulq_n_s16(U, param->u_b_factor); \
+	dup = vzipq_s16(r_tmp, r_tmp); R1 = dup.val[0]; R2 = dup.val[1]; \
+	dup = vzipq_s16(g_tmp, g_tmp); G1 = dup.val[0]; G2 = dup.val[1]; \
+	dup = vzipq_s16(b_tmp, b_tmp); B1 = dup.val[0]; B2 = dup.val[1]; \
+}
+
+#define ADD_Y2RGB_16(Y1,Y2,R1,G1,B1,R2,G2,B2) \
+	Y1 = vmulq_n_s16(vsubq_s16(Y1, vdupq_n_s16(param->y_shift)), param->y_factor); \
+	Y2 = vmulq_n_s16(vsubq_s16(Y2, vdupq_n_s16(param->y_shift)), param->y_factor); \
+	\
+	R1 = vshrq_n_s16(vaddq_s16(R1, Y1), PRECISION); \
+	G1 = vshrq_n_s16(vaddq_s16(G1, Y1), PRECISION); \
+	B1 = vshrq_n_s16(vaddq_s16(B1, Y1), PRECISION); \
+	R2 = vshrq_n_s16(vaddq_s16(R2, Y2), PRECISION); \
+	G2 = vshrq_n_s16(vaddq_s16(G2, Y2), PRECISION); \
+	B2 = vshrq_n_s16(vaddq_s16(B2, Y2), PRECISION); \
+
+#define PACK_8(X1, X2) vcombine_u8(vqmovun_s16(X1), vqmovun_s16(X2))
+
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+
+#define SAVE_PIXELS_16(rgb_ptr, R, G, B) \
+{ \
+	uint16x8_t rgb1, rgb2; \
+	rgb1 = vshll_n_u8(vget_low_u8(R), 8); \
+	rgb1 = vsriq_n_u16(rgb1, vshll_n_u8(vget_low_u8(G), 8), 5); \
+	rgb1 = vsriq_n_u16(rgb1, vshll_n_u8(vget_low_u8(B), 8), 11); \
+	rgb2 = vshll_n_u8(vget_high_u8(R), 8); \
+	rgb2 = vsriq_n_u16(rgb2, vshll_n_u8(vget_high_u8(G), 8), 5); \
+	rgb2 = vsriq_n_u16(rgb2, vshll_n_u8(vget_high_u8(B), 8), 11); \
+	vst1q_u16((uint16_t *)(rgb_ptr), rgb1); \
+	vst1q_u16((uint16_t *)(rgb_ptr + 16), rgb2); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+
+#define SAVE_PIXELS_16(rgb_ptr, R, G, B) \
+{ \
+	uint8x16x3_t rgb; \
+	rgb.val[0] = R; \
+	rgb.val[1] = G; \
+	rgb.val[2] = B; \
+	vst3q_u8(rgb_ptr, rgb); \
+}
+
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+
+/* The 32-bit formats are packed words, so these are the bytes from lowest to highest address */
+#if RGB_FORMAT == RGB_FORMAT_RGBA
+#define STORE_ORDER(R, G, B, A) A, B, G, R
+#elif RGB_FORMAT == RGB_FORMAT_BGRA
+#define STORE_ORDER(R, G, B, A) A, R, G, B
+#elif RGB_FORMAT == RGB_FORMAT_ARGB
+#define STORE_ORDER(R, G, B, A) B, G, R, A
+#elif RGB_FORMAT == RGB_FORMAT_ABGR
+#define STORE_ORDER(R, G, B, A) R, G, B, A
+#endif
+
+#define STORE_RGBA(rgb_ptr, C0, C1, C2, C3) \
+{ \
+	uint8x16x4_t rgb; \
+	rgb.val[0] = C0; \
+	rgb.val[1] = C1; \
+	rgb.val[2] = C2; \
+	rgb.val[3] = C3; \
+	vst4q_u8(rgb_ptr, rgb); \
+}
+
+#define STORE_RGBA_EXPAND(rgb_ptr, ORDER) STORE_RGBA(rgb_ptr, ORDER)
+
+#define SAVE_PIXELS_16(rgb_ptr, R, G, B) \
+	STORE_RGBA_EXPAND(rgb_ptr, STORE_ORDER(R, G, B, vdupq_n_u8(0xFF))) \
+
+#else
+#error SAVE_PIXELS_16 unimplemented
+#endif
+
+#define SAVE_LINE1 \
+	SAVE_PIXELS_16(rgb_ptr1, r_8_11, g_8_11, b_8_11) \
+	SAVE_PIXELS_16(rgb_ptr1+16*rgb_pixel_stride, r_8_12, g_8_12, b_8_12) \
+
+#define SAVE_LINE2 \
+	SAVE_PIXELS_16(rgb_ptr2, r_8_21, g_8_21, b_8_21) \
+	SAVE_PIXELS_16(rgb_ptr2+16*rgb_pixel_stride, r_8_22, g_8_22, b_8_22) \
+
+#if YUV_FORMAT == YUV_FORMAT_420
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV	\
+	u = vld1q_u8(u_ptr); \
+	v = vld1q_u8(v_ptr); \
+
+#elif YUV_FORMAT == YUV_FORMAT_422
+
+#define READ_Y(y_ptr) \
+	y = vld2q_u8(y_ptr).val[0]; \
+
+#define READ_UV	\
+	u = vld4q_u8(u_ptr).val[0]; \
+	v = vld4q_u8(v_ptr).val[0]; \
+
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+
+#define READ_Y(y_ptr) \
+	y = vld1q_u8(y_ptr); \
+
+#define READ_UV	\
+	u = vld2q_u8(u_ptr).val[0]; \
+	v = vld2q_u8(v_ptr).val[0]; \
+
+#else
+#error READ_UV unimplemented
+#endif
+
+#define YUV2RGB_32 \
+	int16x8_t r_tmp, g_tmp, b_tmp; \
+	int16x8_t r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2; \
+	int16x8_t r_uv_16_1, g_uv_16_1, b_uv_16_1, r_uv_16_2, g_uv_16_2, b_uv_16_2; \
+	int16x8_t y_16_1, y_16_2; \
+	int16x8_t u_16, v_16; \
+	uint8x16_t y, u, v; \
+	uint8x16_t r_8_11, g_8_11, b_8_11, r_8_21, g_8_21, b_8_21; \
+	uint8x16_t r_8_12, g_8_12, b_8_12, r_8_22, g_8_22, b_8_22; \
+	\
+	READ_UV \
+	\
+	/* process first 16 pixels of first line */\
+	u_16 = vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(u), vdup_n_u8(128))); \
+	v_16 = vreinterpretq_s16_u16(vsubl_u8(vget_low_u8(v), vdup_n_u8(128))); \
+	\
+	UV2RGB_16(u_16, v_16, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	r_uv_16_1=r_16_1; g_uv_16_1=g_16_1; b_uv_16_1=b_16_1; \
+	r_uv_16_2=r_16_2; g_uv_16_2=g_16_2; b_uv_16_2=b_16_2; \
+	\
+	READ_Y(y_ptr1) \
+	y_16_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	y_16_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	\
+	ADD_Y2RGB_16(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_11 = PACK_8(r_16_1, r_16_2); \
+	g_8_11 = PACK_8(g_16_1, g_16_2); \
+	b_8_11 = PACK_8(b_16_1, b_16_2); \
+	\
+	/* process first 16 pixels of second line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr2) \
+	y_16_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	y_16_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	\
+	ADD_Y2RGB_16(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_21 = PACK_8(r_16_1, r_16_2); \
+	g_8_21 = PACK_8(g_16_1, g_16_2); \
+	b_8_21 = PACK_8(b_16_1, b_16_2); \
+	\
+	/* process last 16 pixels of first line */\
+	u_16 = vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(u), vdup_n_u8(128))); \
+	v_16 = vreinterpretq_s16_u16(vsubl_u8(vget_high_u8(v), vdup_n_u8(128))); \
+	\
+	UV2RGB_16(u_16, v_16, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	r_uv_16_1=r_16_1; g_uv_16_1=g_16_1; b_uv_16_1=b_16_1; \
+	r_uv_16_2=r_16_2; g_uv_16_2=g_16_2; b_uv_16_2=b_16_2; \
+	\
+	READ_Y(y_ptr1+16*y_pixel_stride) \
+	y_16_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	y_16_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	\
+	ADD_Y2RGB_16(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_12 = PACK_8(r_16_1, r_16_2); \
+	g_8_12 = PACK_8(g_16_1, g_16_2); \
+	b_8_12 = PACK_8(b_16_1, b_16_2); \
+	\
+	/* process last 16 pixels of second line */\
+	r_16_1=r_uv_16_1; g_16_1=g_uv_16_1; b_16_1=b_uv_16_1; \
+	r_16_2=r_uv_16_2; g_16_2=g_uv_16_2; b_16_2=b_uv_16_2; \
+	\
+	READ_Y(y_ptr2+16*y_pixel_stride) \
+	y_16_1 = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y))); \
+	y_16_2 = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y))); \
+	\
+	ADD_Y2RGB_16(y_16_1, y_16_2, r_16_1, g_16_1, b_16_1, r_16_2, g_16_2, b_16_2) \
+	\
+	r_8_22 = PACK_8(r_16_1, r_16_2); \
+	g_8_22 = PACK_8(g_16_1, g_16_2); \
+	b_8_22 = PACK_8(b_16_1, b_16_2); \
+	\
+
+
+void NEON_FUNCTION_NAME(uint32_t width, uint32_t height,
+	const uint8_t *Y, const uint8_t *U, const uint8_t *V, uint32_t Y_stride, uint32_t UV_stride,
+	uint8_t *RGB, uint32_t RGB_stride,
+	YCbCrType yuv_type)
+{
+	const YUV2RGBParam *const param = &(YUV2RGB[yuv_type]);
+#if YUV_FORMAT == YUV_FORMAT_420
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 1;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#elif YUV_FORMAT == YUV_FORMAT_422
+	const int y_pixel_stride = 2;
+	const int uv_pixel_stride = 4;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 1;
+#elif YUV_FORMAT == YUV_FORMAT_NV12
+	const int y_pixel_stride = 1;
+	const int uv_pixel_stride = 2;
+	const int uv_x_sample_interval = 2;
+	const int uv_y_sample_interval = 2;
+#endif
+#if RGB_FORMAT == RGB_FORMAT_RGB565
+	const int rgb_pixel_stride = 2;
+#elif RGB_FORMAT == RGB_FORMAT_RGB24
+	const int rgb_pixel_stride = 3;
+#elif RGB_FORMAT == RGB_FORMAT_RGBA || RGB_FORMAT == RGB_FORMAT_BGRA || \
+      RGB_FORMAT == RGB_FORMAT_ARGB || RGB_FORMAT == RGB_FORMAT_ABGR
+	const int rgb_pixel_stride = 4;
+#else
+#error Unknown RGB pixel size
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_NV12
+	/* READ_UV reads one byte past the last pixel, like the SSE2 version */
+	const int fix_read_nv12 = ((width & 31) == 0);
+#else
+	const int fix_read_nv12 = 0;
+#endif
+
+#if YUV_FORMAT == YUV_FORMAT_422
+	/* Avoid invalid read on last line */
+	const int fix_read_422 = 1;
+#else
+	const int fix_read_422 = 0;
+#endif
+
+
+	if (width >= 32) {
+		uint32_t xpos, ypos;
+		for(ypos=0; ypos<(height-(uv_y_sample_interval-1)) - fix_read_422; ypos+=uv_y_sample_interval)
+		{
+			const uint8_t *y_ptr1=Y+ypos*Y_stride,
+				*y_ptr2=Y+(ypos+1)*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr1=RGB+ypos*RGB_stride,
+				*rgb_ptr2=RGB+(ypos+1)*RGB_stride;
+
+			for(xpos=0; xpos<(width-31) - fix_read_nv12; xpos+=32)
+			{
+				YUV2RGB_32
+				{
+					SAVE_LINE1
+					if (uv_y_sample_interval > 1)
+					{
+						SAVE_LINE2
+					}
+				}
+
+				y_ptr1+=32*y_pixel_stride;
+				y_ptr2+=32*y_pixel_stride;
+				u_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				v_ptr+=32*uv_pixel_stride/uv_x_sample_interval;
+				rgb_ptr1+=32*rgb_pixel_stride;
+				rgb_ptr2+=32*rgb_pixel_stride;
+			}
+		}
+
+		if (fix_read_422) {
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+			ypos += uv_y_sample_interval;
+		}
+
+		/* Catch the last line, if needed */
+		if (uv_y_sample_interval == 2 && ypos == (height-1))
+		{
+			const uint8_t *y_ptr=Y+ypos*Y_stride,
+				*u_ptr=U+(ypos/uv_y_sample_interval)*UV_stride,
+				*v_ptr=V+(ypos/uv_y_sample_interval)*UV_stride;
+
+			uint8_t *rgb_ptr=RGB+ypos*RGB_stride;
+
+			STD_FUNCTION_NAME(width, 1, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+
+	/* Catch the right column, if needed */
+	{
+		uint32_t converted = (width & ~31);
+		if (fix_read_nv12) {
+			converted -= 32;
+		}
+		if (converted != width)
+		{
+			const uint8_t *y_ptr=Y+converted*y_pixel_stride,
+				*u_ptr=U+converted*uv_pixel_stride/uv_x_sample_interval,
+				*v_ptr=V+converted*uv_pixel_stride/uv_x_sample_interval;
+
+			uint8_t *rgb_ptr=RGB+converted*rgb_pixel_stride;
+
+			STD_FUNCTION_NAME(width-converted, height, y_ptr, u_ptr, v_ptr, Y_stride, UV_stride, rgb_ptr, RGB_stride, yuv_type);
+		}
+	}
+}
+
+#undef NEON_FUNCTION_NAME
+#undef STD_FUNCTION_NAME
+#undef YUV_FORMAT
+#undef RGB_FORMAT
+#undef UV2RGB_16
+#undef ADD_Y2RGB_16
+#undef PACK_8
+#undef STORE_ORDER
+#undef STORE_RGBA
+#undef STORE_RGBA_EXPAND
+#undef SAVE_PIXELS_16
+#undef SAVE_LINE1
+#undef SAVE_LINE2
+#undef READ_Y
+#undef READ_UV
+#undef YUV2RGB_32